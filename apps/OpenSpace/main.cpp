@@ -206,6 +206,11 @@ LONG WINAPI generateMiniDump(EXCEPTION_POINTERS* exceptionPointers) {
         LERROR("Dumpfile created unsuccessfully");
     }
 
+    // Asynchronous logs might still have messages waiting to be written
+    if (ghoul::logging::LogManager::isInitialized()) {
+        LogMgr.flushLogs();
+    }
+
     return EXCEPTION_EXECUTE_HANDLER;
 }
 #endif // WIN32
@@ -1206,6 +1211,32 @@ int main(int argc, char* argv[]) {
         "Specifies whether the Launcher should be shown at startup or not. This value "
         "overrides the value specified in the `openspace.cfg` and the settings."
     ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+        commandlineArguments.benchmarkFrames, "--benchmark", "",
+        "Runs OpenSpace in the automated benchmark mode for the provided number of "
+        "frames. After the profile has been loaded, the optional session recording and "
+        "script are started, the CPU time of each frame stage, the GPU times, and the "
+        "memory usage of every frame are measured and written to a JSON file, and the "
+        "application exits. This option implies `--bypassLauncher`."
+    ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<std::string>>(
+        commandlineArguments.benchmarkRecording, "--benchmarkRecording", "",
+        "The session recording that is played back during the benchmark."
+    ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<std::string>>(
+        commandlineArguments.benchmarkScript, "--benchmarkScript", "",
+        "A Lua script file that is executed at the start of the benchmark."
+    ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<std::string>>(
+        commandlineArguments.benchmarkOutput, "--benchmarkOutput", "",
+        "The JSON file to which the benchmark results are written. The default is "
+        "`${LOGS}/benchmark.json`."
+    ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<double>>(
+        commandlineArguments.benchmarkDeltaTime, "--benchmarkDeltaTime", "",
+        "The fixed amount of simulation time in seconds that passes in every frame of "
+        "the benchmark. The default is 1/60 of a second."
+    ));
 
     // setCommandLine returns a reference to the vector that will be filled later
     const std::vector<std::string>& sgctArguments = parser.setCommandLine(
@@ -1319,6 +1350,30 @@ int main(int argc, char* argv[]) {
         if (commandlineArguments.bypassLauncher.has_value()) {
             global::configuration->bypassLauncher = *commandlineArguments.bypassLauncher;
         }
+        if (commandlineArguments.benchmarkFrames.has_value()) {
+            if (*commandlineArguments.benchmarkFrames <= 0) {
+                throw ghoul::RuntimeError(
+                    "The number of benchmark frames must be a positive number"
+                );
+            }
+
+            Configuration::Benchmark benchmark;
+            benchmark.nFrames = *commandlineArguments.benchmarkFrames;
+            if (commandlineArguments.benchmarkRecording.has_value()) {
+                benchmark.sessionRecording = *commandlineArguments.benchmarkRecording;
+            }
+            if (commandlineArguments.benchmarkScript.has_value()) {
+                benchmark.script = *commandlineArguments.benchmarkScript;
+            }
+            if (commandlineArguments.benchmarkOutput.has_value()) {
+                benchmark.output = *commandlineArguments.benchmarkOutput;
+            }
+            if (commandlineArguments.benchmarkDeltaTime.has_value()) {
+                benchmark.deltaTime = *commandlineArguments.benchmarkDeltaTime;
+            }
+            global::configuration->benchmark = std::move(benchmark);
+            global::configuration->bypassLauncher = true;
+        }
 
         // Determining SGCT configuration file
         LDEBUG("SGCT Configuration file: " + global::configuration->windowConfiguration);
@@ -23,28 +23,276 @@
  ****************************************************************************************/
 
 #include <openspace/engine/configuration.h>
+#include <openspace/engine/globals.h>
 #include <openspace/engine/moduleengine.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/settings.h>
 #include <openspace/engine/windowdelegate.h>
-#include <openspace/engine/configuration.h>
+#include <openspace/scene/assetmanager.h>
+#include <openspace/scene/profile.h>
 #include <openspace/util/factorymanager.h>
-#include <openspace/engine/globals.h>
 #include <openspace/util/progressbar.h>
 #include <openspace/util/resourcesynchronization.h>
 #include <openspace/util/task.h>
 #include <openspace/util/taskloader.h>
+#include <ghoul/cmdparser/commandlineparser.h>
+#include <ghoul/cmdparser/multiplecommand.h>
+#include <ghoul/cmdparser/singlecommand.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/format.h>
 #include <ghoul/ghoul.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/logging/consolelog.h>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "Sync";
+
+    // The number of synchronizations that are running at the same time unless the
+    // `--jobs` argument is provided
+    constexpr int DefaultJobs = 4;
+
+    struct Arguments {
+        std::vector<std::string> profiles;
+        std::optional<int> jobs;
+        std::optional<bool> isDryRun;
+    };
+
+    std::filesystem::path resolveProfile(const std::string& profile) {
+        if (std::filesystem::is_regular_file(profile)) {
+            return profile;
+        }
+
+        // Same lookup as in the engine; user profiles take priority over the built-in
+        const std::filesystem::path userCandidate = absPath(
+            std::format("${{USER_PROFILES}}/{}.profile", profile)
+        );
+        if (std::filesystem::is_regular_file(userCandidate)) {
+            return userCandidate;
+        }
+        const std::filesystem::path profileCandidate = absPath(
+            std::format("${{PROFILES}}/{}.profile", profile)
+        );
+        if (std::filesystem::is_regular_file(profileCandidate)) {
+            return profileCandidate;
+        }
+        throw ghoul::RuntimeError(std::format(
+            "Could not load profile '{}': File does not exist", profile
+        ));
+    }
+
+    bool isSynchronizedOnDisk(const openspace::ResourceSynchronization& sync) {
+        std::filesystem::path path = sync.directory();
+        path.replace_extension("ossync");
+        return std::filesystem::is_regular_file(path);
+    }
+
+    uint64_t bytesOnDisk(const std::filesystem::path& directory) {
+        if (!std::filesystem::is_directory(directory)) {
+            return 0;
+        }
+
+        uint64_t res = 0;
+        namespace fs = std::filesystem;
+        for (const fs::directory_entry& e : fs::recursive_directory_iterator(directory)) {
+            if (e.is_regular_file()) {
+                res += e.file_size();
+            }
+        }
+        return res;
+    }
+
+    std::string formatBytes(uint64_t bytes) {
+        constexpr double MB = 1024.0 * 1024.0;
+        return std::format("{:.1f} MB", static_cast<double>(bytes) / MB);
+    }
+
+    // The previous behavior if no profile is specified: all tasks in the
+    // `full_sync.task` file are run one after another
+    int performSyncTasks() {
+        using namespace openspace;
+
+        TaskLoader taskLoader;
+        std::filesystem::path t = absPath("${TASKS}/full_sync.task");
+        std::vector<std::unique_ptr<Task>> tasks = taskLoader.tasksFromFile(t.string());
+
+        for (size_t i = 0; i < tasks.size(); i++) {
+            Task& task = *tasks[i].get();
+            LINFO(std::format(
+                "Synchronizing scene {} out of {}: {}",
+                i + 1, tasks.size(), task.description()
+            ));
+            ProgressBar progressBar(100);
+            task.perform([&progressBar](float progress) {
+                progressBar.print(static_cast<int>(progress * 100.f));
+            });
+        }
+        std::cout << "Done synchronizing" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    // Loads all assets of the provided profiles without starting any of their
+    // synchronizations and returns the combined list of synchronizations. As the
+    // AssetManager deduplicates synchronizations, each resource is contained only once
+    std::vector<openspace::ResourceSynchronization*> collectSynchronizations(
+                                                 const std::vector<std::string>& profiles)
+    {
+        using namespace openspace;
+
+        AssetManager& assetManager = global::openSpaceEngine->assetManager();
+        assetManager.setAutomaticSynchronization(false);
+        for (const std::string& p : profiles) {
+            const std::filesystem::path path = resolveProfile(p);
+            LINFO(std::format("Loading profile '{}'", path));
+            const Profile profile = Profile(path);
+            for (const std::string& asset : profile.assets) {
+                assetManager.add(asset);
+            }
+        }
+        // A single update is enough to load all queued assets and everything they
+        // require. It must not be called again afterwards as the assets would then be
+        // initialized once their synchronizations have finished
+        assetManager.update();
+
+        return assetManager.allSynchronizations();
+    }
 
-int main(int, char**) {
+    int printDryRun(const std::vector<openspace::ResourceSynchronization*>& syncs) {
+        size_t nSynchronized = 0;
+        uint64_t nBytesOnDisk = 0;
+        for (const openspace::ResourceSynchronization* s : syncs) {
+            const bool isSynced = isSynchronizedOnDisk(*s);
+            const uint64_t nBytes = bytesOnDisk(s->directory());
+            std::cout << std::format(
+                "{} {} ({}): {}\n",
+                isSynced ? "[x]" : "[ ]", s->name(), s->identifier(), formatBytes(nBytes)
+            );
+            nSynchronized += isSynced ? 1 : 0;
+            nBytesOnDisk += nBytes;
+        }
+
+        // The remote size of a synchronization is only reported once its download has
+        // started, so only the bytes that are already present can be summed up here
+        std::cout << std::format(
+            "{} synchronizations, {} already synchronized, {} to download\n"
+            "Total bytes on disk: {} ({} bytes)\n",
+            syncs.size(), nSynchronized, syncs.size() - nSynchronized,
+            formatBytes(nBytesOnDisk), nBytesOnDisk
+        );
+        return EXIT_SUCCESS;
+    }
+
+    int synchronize(const std::vector<openspace::ResourceSynchronization*>& syncs,
+                    int nJobs)
+    {
+        using namespace openspace;
+        using namespace std::chrono_literals;
+
+        LINFO(std::format(
+            "Synchronizing {} resources with {} parallel jobs", syncs.size(), nJobs
+        ));
+        const auto start = std::chrono::steady_clock::now();
+
+        std::deque<ResourceSynchronization*> queued = { syncs.begin(), syncs.end() };
+        std::vector<ResourceSynchronization*> running;
+        size_t nFinished = 0;
+        ProgressBar progressBar(static_cast<int>(syncs.size()));
+        while (!queued.empty() || !running.empty()) {
+            while (!queued.empty() && running.size() < static_cast<size_t>(nJobs)) {
+                ResourceSynchronization* s = queued.front();
+                queued.pop_front();
+                s->start();
+                running.push_back(s);
+            }
+
+            nFinished += std::erase_if(
+                running,
+                [](const ResourceSynchronization* s) { return !s->isSyncing(); }
+            );
+            progressBar.print(static_cast<int>(nFinished));
+
+            if (!running.empty()) {
+                std::this_thread::sleep_for(100ms);
+            }
+        }
+
+        // Verification report
+        const auto end = std::chrono::steady_clock::now();
+        std::vector<const ResourceSynchronization*> failed;
+        uint64_t nBytes = 0;
+        for (const ResourceSynchronization* s : syncs) {
+            if (!s->isResolved()) {
+                failed.push_back(s);
+            }
+            nBytes += s->nSynchronizedBytes();
+        }
+
+        std::cout << std::format(
+            "\n{} of {} synchronizations resolved, {} failed. "
+            "Downloaded {} in {:.1f} s\n",
+            syncs.size() - failed.size(), syncs.size(), failed.size(),
+            formatBytes(nBytes), std::chrono::duration<double>(end - start).count()
+        );
+        for (const ResourceSynchronization* s : failed) {
+            std::cout << std::format(
+                "  Failed: {} ({}) in '{}'\n", s->name(), s->identifier(), s->directory()
+            );
+        }
+        return failed.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
     using namespace openspace;
 
     ghoul::initialize();
 
+    ghoul::cmdparser::CommandlineParser parser(
+        std::string(argv[0]),
+        ghoul::cmdparser::CommandlineParser::AllowUnknownCommands::No
+    );
+
+    Arguments arguments;
+    parser.addCommand(std::make_unique<ghoul::cmdparser::MultipleCommand<std::string>>(
+        arguments.profiles, "--profile", "-p",
+        "A profile whose resources should be synchronized. This can either be the name "
+        "of a built-in or user profile or a path to a profile file and can be provided "
+        "multiple times. If no profile is provided, the `full_sync.task` file is run "
+        "instead."
+    ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+        arguments.jobs, "--jobs", "-j",
+        "The maximum number of synchronizations that are downloaded at the same time. "
+        "The default is 4."
+    ));
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommandZeroArguments>(
+        arguments.isDryRun, "--dry-run", "-n",
+        "Only lists the synchronizations of the profiles, which of them are already "
+        "present, and the number of bytes on disk without downloading anything."
+    ));
+    parser.setCommandLine({ argv, argv + argc });
+
+    try {
+        const bool showHelp = parser.execute();
+        if (showHelp) {
+            std::cout << parser.helpText();
+            return EXIT_SUCCESS;
+        }
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LFATALC(e.component, e.message);
+        return EXIT_FAILURE;
+    }
+
+    const int nJobs = arguments.jobs.value_or(DefaultJobs);
+    if (nJobs <= 0) {
+        LFATAL("The number of jobs must be positive");
+        return EXIT_FAILURE;
+    }
+
     std::filesystem::path configFile = findConfiguration();
     std::filesystem::path settings = findSettings();
     *global::configuration = loadConfigurationFromFile(
@@ -54,26 +302,20 @@ int main(int, char**) {
     );
     global::openSpaceEngine->initialize();
 
-
-    TaskLoader taskLoader;
-    std::filesystem::path t = absPath("${TASKS}/full_sync.task");
-    std::vector<std::unique_ptr<Task>> tasks = taskLoader.tasksFromFile(t.string());
-
-    for (size_t i = 0; i < tasks.size(); i++) {
-        Task& task = *tasks[i].get();
-        LINFOC(
-            "Sync",
-            std::format(
-                "Synchronizing scene {} out of {}: {}",
-                i + 1, tasks.size(), task.description()
-            )
-        );
-        ProgressBar progressBar(100);
-        task.perform([&progressBar](float progress) {
-            progressBar.print(static_cast<int>(progress * 100.f));
-        });
+    if (arguments.profiles.empty()) {
+        return performSyncTasks();
     }
-    std::cout << "Done synchronizing" << std::endl;
 
-    return 0;
+    try {
+        const std::vector<ResourceSynchronization*> syncs =
+            collectSynchronizations(arguments.profiles);
+        if (arguments.isDryRun.value_or(false)) {
+            return printDryRun(syncs);
+        }
+        return synchronize(syncs, nJobs);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LFATALC(e.component, e.message);
+        return EXIT_FAILURE;
+    }
 };
@@ -22,8 +22,14 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <ghoul/glm.h>
 
 #include <ghoul/ghoul.h>
@@ -63,7 +69,69 @@ namespace {
     const std::string _loggerCat = "TaskRunner Main";
 }
 
-void performTasks(const std::string& path) {
+struct ScheduledTask {
+    openspace::Task* task = nullptr;
+    std::string name;
+    // Indices of the tasks that depend on this task
+    std::vector<size_t> dependents;
+    // Number of dependencies that have not been performed yet
+    int remainingDependencies = 0;
+    bool isDone = false;
+};
+
+std::vector<ScheduledTask>
+scheduleTasks(const std::vector<std::unique_ptr<openspace::Task>>& tasks)
+{
+    using namespace openspace;
+
+    std::vector<ScheduledTask> scheduled;
+    std::map<std::string, size_t, std::less<>> identifiers;
+    for (const std::unique_ptr<Task>& task : tasks) {
+        if (!task) {
+            // The creation of the task failed, which has already been reported
+            continue;
+        }
+
+        ScheduledTask t;
+        t.task = task.get();
+        t.name = task->identifier().empty() ?
+            std::format("#{}", scheduled.size() + 1) :
+            task->identifier();
+        if (!task->identifier().empty()) {
+            const bool inserted = identifiers.emplace(
+                task->identifier(),
+                scheduled.size()
+            ).second;
+            if (!inserted) {
+                LWARNING(std::format(
+                    "Duplicate task identifier '{}'. Dependencies will refer to the "
+                    "first task with that identifier", task->identifier()
+                ));
+            }
+        }
+        scheduled.push_back(std::move(t));
+    }
+
+    for (size_t i = 0; i < scheduled.size(); i++) {
+        for (const std::string& dependency : scheduled[i].task->dependencies()) {
+            auto it = identifiers.find(dependency);
+            if (it == identifiers.end()) {
+                LERROR(std::format(
+                    "Task '{}' depends on unknown task '{}' and will not be performed",
+                    scheduled[i].name, dependency
+                ));
+                // This dependency can never be fulfilled
+                scheduled[i].remainingDependencies++;
+                continue;
+            }
+            scheduled[it->second].dependents.push_back(i);
+            scheduled[i].remainingDependencies++;
+        }
+    }
+    return scheduled;
+}
+
+void performTasks(const std::string& path, int nThreads) {
     using namespace openspace;
 
     TaskLoader taskLoader;
@@ -77,16 +145,101 @@ void performTasks(const std::string& path) {
         LINFO(std::format("Task queue has {} items", tasks.size()));
     }
 
-    for (size_t i = 0; i < tasks.size(); i++) {
-        Task& task = *tasks[i].get();
-        LINFO(std::format(
-            "Performing task {} out of {}: {}", i + 1, tasks.size(), task.description()
-        ));
-        ProgressBar progressBar(100);
-        auto onProgress = [&progressBar](float progress) {
-            progressBar.print(static_cast<int>(progress * 100.f));
-        };
-        task.perform(onProgress);
+    std::vector<ScheduledTask> scheduled = scheduleTasks(tasks);
+
+    // Tasks without any dependencies are ready from the start and are performed in the
+    // order in which they appear in the task file
+    std::deque<size_t> ready;
+    for (size_t i = 0; i < scheduled.size(); i++) {
+        if (scheduled[i].remainingDependencies == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable readyChanged;
+    int nRunning = 0;
+    size_t nPerformed = 0;
+
+    auto worker = [&]() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            readyChanged.wait(lock, [&]() { return !ready.empty() || nRunning == 0; });
+            if (ready.empty()) {
+                // Nothing is running that could make further tasks ready
+                readyChanged.notify_all();
+                return;
+            }
+
+            ScheduledTask& t = scheduled[ready.front()];
+            ready.pop_front();
+            nRunning++;
+            nPerformed++;
+            LINFO(std::format(
+                "Performing task {} out of {}: {}",
+                nPerformed, scheduled.size(), t.task->description()
+            ));
+            lock.unlock();
+
+            bool success = true;
+            try {
+                if (nThreads == 1) {
+                    ProgressBar progressBar(100);
+                    auto onProgress = [&progressBar](float progress) {
+                        progressBar.print(static_cast<int>(progress * 100.f));
+                    };
+                    t.task->perform(onProgress);
+                }
+                else {
+                    // A progress bar per task would overwrite each other, so the
+                    // progress is logged in steps of 10% instead
+                    int reported = 0;
+                    auto onProgress = [&t, &reported](float progress) {
+                        const int p = static_cast<int>(progress * 10.f) * 10;
+                        if (p > reported) {
+                            reported = p;
+                            LINFO(std::format("Task '{}': {}%", t.name, p));
+                        }
+                    };
+                    t.task->perform(onProgress);
+                }
+            }
+            catch (const std::exception& e) {
+                LERROR(std::format("Task '{}' failed: {}", t.name, e.what()));
+                success = false;
+            }
+
+            lock.lock();
+            nRunning--;
+            t.isDone = success;
+            if (success) {
+                for (size_t dependent : t.dependents) {
+                    scheduled[dependent].remainingDependencies--;
+                    if (scheduled[dependent].remainingDependencies == 0) {
+                        ready.push_back(dependent);
+                    }
+                }
+            }
+            readyChanged.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < nThreads; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& w : workers) {
+        w.join();
+    }
+
+    for (const ScheduledTask& t : scheduled) {
+        if (!t.isDone && t.remainingDependencies > 0) {
+            LERROR(std::format(
+                "Task '{}' was not performed as its dependencies were not fulfilled",
+                t.name
+            ));
+        }
     }
     std::cout << "Done performing tasks" << std::endl;
 }
@@ -152,13 +305,30 @@ int main(int argc, char** argv) {
         )
     );
 
+    std::optional<int> threads;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+            threads,
+            "--threads",
+            "-j",
+            "The number of tasks that can be performed concurrently. Tasks are only "
+            "performed concurrently if they do not depend on each other. Passing 0 uses "
+            "one thread per hardware thread. Defaults to 1"
+        )
+    );
+
     commandlineParser.setCommandLine({ argv, argv + argc });
     commandlineParser.execute();
 
     //FileSys.setCurrentDirectory(launchDirectory);
 
+    int nThreads = threads.value_or(1);
+    if (nThreads <= 0) {
+        nThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+
     if (tasksPath.has_value()) {
-        performTasks(*tasksPath);
+        performTasks(*tasksPath, nThreads);
         return 0;
     }
 
@@ -170,7 +340,7 @@ int main(int argc, char** argv) {
     std::cout << "TASK > ";
     std::string t;
     while (std::cin >> t) {
-        performTasks(t);
+        performTasks(t, nThreads);
         std::cout << "TASK > ";
     }
 
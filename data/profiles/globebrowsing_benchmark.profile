@@ -0,0 +1,44 @@
+{
+  "assets": [
+    "base_blank",
+    "util/globebrowsing_benchmark"
+  ],
+  "camera": {
+    "aim": "",
+    "anchor": "GlobeBrowsingBenchmark",
+    "frame": "",
+    "position": {
+      "x": 30000000.0,
+      "y": 0.0,
+      "z": 0.0
+    },
+    "type": "setNavigationState",
+    "up": {
+      "x": 0.0,
+      "y": 0.0,
+      "z": 1.0
+    },
+    "yaw": 0.0
+  },
+  "delta_times": [
+    1.0
+  ],
+  "mark_nodes": [],
+  "meta": {
+    "author": "OpenSpace Team",
+    "description": "Runs a benchmark of the globe rendering along a fixed camera path over a globe that only uses local datasets. The results are written to 'user/benchmarks/globebrowsing.json' and OpenSpace shuts down once the benchmark is finished.",
+    "license": "MIT License",
+    "name": "Globe Browsing Benchmark",
+    "url": "https://www.openspaceproject.com",
+    "version": "1.0"
+  },
+  "time": {
+    "is_paused": true,
+    "type": "absolute",
+    "value": "2024-01-01T12:00:00"
+  },
+  "version": {
+    "major": 1,
+    "minor": 4
+  }
+}
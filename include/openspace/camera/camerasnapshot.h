@@ -0,0 +1,87 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___CAMERASNAPSHOT___H__
+#define __OPENSPACE_CORE___CAMERASNAPSHOT___H__
+
+#include <ghoul/glm.h>
+#include <array>
+
+namespace openspace {
+
+class Camera;
+class SceneGraphNode;
+
+/**
+ * An immutable copy of the state of a Camera with all derived values already computed.
+ * A snapshot is created once per frame and viewport and is passed to the renderables as
+ * part of the RenderData. In contrast to the Camera, whose accessors lazily update their
+ * cached values, reading from a snapshot does not require any checks or locks and can be
+ * done from any number of threads at the same time.
+ */
+struct CameraSnapshot {
+    CameraSnapshot() = default;
+
+    /**
+     * Creates a snapshot of the current state of the \p camera, including the SGCT
+     * matrices of the viewport that is currently being rendered.
+     */
+    explicit CameraSnapshot(const Camera& camera);
+
+    glm::dvec3 position = glm::dvec3(0.0);
+    glm::dvec3 eyePosition = glm::dvec3(0.0);
+    glm::dvec3 viewDirectionWorldSpace = glm::dvec3(0.0, 0.0, -1.0);
+    glm::dvec3 lookUpVectorWorldSpace = glm::dvec3(0.0, 1.0, 0.0);
+    glm::dquat rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+
+    glm::dmat4 viewRotationMatrix = glm::dmat4(1.0);
+    glm::dmat4 viewScaleMatrix = glm::dmat4(1.0);
+    glm::dmat4 combinedViewMatrix = glm::dmat4(1.0);
+
+    glm::mat4 sceneMatrix = glm::mat4(1.f);
+    glm::mat4 viewMatrix = glm::mat4(1.f);
+    glm::mat4 projectionMatrix = glm::mat4(1.f);
+    glm::mat4 viewProjectionMatrix = glm::mat4(1.f);
+
+    /// The projection matrix multiplied with the combined view matrix in double precision
+    glm::dmat4 combinedViewProjectionMatrix = glm::dmat4(1.0);
+
+    /// The left, right, bottom, and top planes of the view frustum in world space. Each
+    /// plane is stored as its normal, pointing into the frustum, and its distance to the
+    /// origin. The near and far planes are not included as the far plane is too far away
+    /// to matter and the side planes already exclude everything behind the camera
+    std::array<glm::dvec4, 4> frustumPlanes = {};
+
+    float maxFov = 0.f;
+    float sinMaxFov = 0.f;
+    float cosMaxFov = 1.f;
+    float scaling = 1.f;
+    float atmosphereDimmingFactor = 1.f;
+
+    SceneGraphNode* parent = nullptr;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___CAMERASNAPSHOT___H__
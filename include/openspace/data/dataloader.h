@@ -29,7 +29,12 @@
 #include <ghoul/glm.h>
 #include <ghoul/misc/boolean.h>
 #include <ghoul/misc/csvreader.h>
+#include <array>
+#include <cstdint>
 #include <filesystem>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -60,17 +65,147 @@ struct Dataset {
     int textureDataIndex = -1;
     int orientationDataIndex = -1;
 
+    /// A single row of the dataset that is used to add new points to the dataset
     struct Entry {
         glm::vec3 position = glm::vec3(0.f);
         std::vector<float> data;
         std::optional<std::string> comment;
     };
-    std::vector<Entry> entries;
+
+    /// A non-owning view of a single row of the dataset. The view is only valid as long
+    /// as the dataset is not modified
+    struct EntryView {
+        struct Values {
+            float operator[](size_t index) const;
+            size_t size() const;
+            bool empty() const;
+
+            const std::vector<std::vector<float>>* columns = nullptr;
+            size_t row = 0;
+        };
+
+        const glm::vec3& position;
+        Values data;
+        const std::optional<std::string>& comment;
+    };
+
+    /**
+     * The storage for all points in the dataset. The positions and each of the data
+     * values are stored in separate contiguous arrays, so that accessing a single column
+     * for all points does not have to touch the rest of the data. The comments are
+     * stored separately as they are only used when creating labels. For compatibility,
+     * the rows can be accessed through EntryView objects.
+     */
+    class Entries {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = EntryView;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator(const Entries* entries, size_t row);
+
+            EntryView operator*() const;
+            Iterator& operator++();
+            Iterator operator++(int);
+            bool operator==(const Iterator& rhs) const = default;
+
+        private:
+            const Entries* _entries = nullptr;
+            size_t _row = 0;
+
+            friend class Entries;
+        };
+
+        /**
+         * Adds the \p entry as a new row to the end of the dataset. If the entry has
+         * more data values than the previous rows, the previous rows are padded with NaN
+         * values for the new columns, and vice versa.
+         */
+        void push_back(const Entry& entry);
+        void push_back(Entry&& entry);
+
+        /**
+         * Adds all rows of \p other to the end of this dataset. Data columns that only
+         * exist in one of the two datasets are padded with NaN values.
+         */
+        void append(Entries&& other);
+
+        /**
+         * Removes the row that the iterator \p it points to.
+         */
+        void erase(Iterator it);
+
+        void reserve(size_t nEntries);
+        void clear();
+        void shrink_to_fit();
+
+        /**
+         * Resizes the dataset to contain \p nEntries rows with \p nValues data values
+         * each. New positions are initialized to 0 and new data values to NaN.
+         */
+        void resize(size_t nEntries, size_t nValues);
+
+        size_t size() const;
+        bool empty() const;
+
+        /// Returns the number of data values that are stored for each row
+        size_t nValues() const;
+
+        EntryView operator[](size_t row) const;
+        Iterator begin() const;
+        Iterator end() const;
+
+        const std::vector<glm::vec3>& positions() const;
+        std::vector<glm::vec3>& positions();
+
+        /// Returns all values of the data column with index \p valueIndex
+        const std::vector<float>& column(size_t valueIndex) const;
+        std::vector<float>& column(size_t valueIndex);
+
+        const std::optional<std::string>& comment(size_t row) const;
+        void setComment(size_t row, std::optional<std::string> comment);
+
+    private:
+        void addRow(const glm::vec3& position, const std::vector<float>& data,
+            std::optional<std::string> comment);
+
+        std::vector<glm::vec3> _positions;
+        std::vector<std::vector<float>> _columns;
+
+        /// This vector is only allocated once the first row with a comment is added
+        std::vector<std::optional<std::string>> _comments;
+    };
+    Entries entries;
 
     /// This variable can be used to get an understanding of the world scale size of
     /// the dataset
     float maxPositionComponent = 0.f;
 
+    /// Summary statistics of a single data column. Missing (NaN) values are ignored
+    struct ColumnStatistics {
+        static constexpr int NHistogramBins = 32;
+
+        /// The smallest and largest value in the column. If there are no valid values,
+        /// these are the largest and smallest representable value, respectively
+        float min = std::numeric_limits<float>::max();
+        float max = -std::numeric_limits<float>::max();
+        float mean = 0.f;
+        /// The number of values in the column that are not NaN
+        uint64_t nValidValues = 0;
+        /// The number of values that fall into each of the equally sized bins that span
+        /// the range [min, max]
+        std::array<uint32_t, NHistogramBins> histogram = {};
+    };
+    /// The statistics for each of the data columns in the #entries. These are computed
+    /// once when the dataset is loaded and stored in the cache file
+    std::vector<ColumnStatistics> statistics;
+
+    /// Recomputes the #statistics for all data columns. Has to be called whenever the
+    /// values in the #entries are changed
+    void computeStatistics();
+
     bool isEmpty() const;
 
     int index(std::string_view variableName) const;
@@ -109,6 +244,23 @@ namespace data {
     Dataset loadFileWithCache(std::filesystem::path path,
         std::optional<DataMapping> specs = std::nullopt);
 
+    /**
+     * Returns a dataset that is shared between all callers that request the same file
+     * with the same data mapping and caching behavior. The dataset is only loaded (using
+     * #loadFileWithCache or #loadFile, depending on \p useCache) the first time it is
+     * requested and stays in memory for as long as any of the returned pointers are
+     * alive. Concurrent requests for the same dataset wait for the first load to finish
+     * rather than loading the file again.
+     *
+     * \param path The path to the dataset file that should be loaded
+     * \param specs The data mapping that is used to interpret the file
+     * \param useCache Whether the cached version of the dataset should be used
+     * \return The shared, read-only dataset
+     * \throw ghoul::RuntimeError If the file could not be loaded
+     */
+    std::shared_ptr<const Dataset> loadSharedFile(std::filesystem::path path,
+        std::optional<DataMapping> specs = std::nullopt, bool useCache = true);
+
 } // namespace data
 
 namespace label {
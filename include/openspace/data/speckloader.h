@@ -27,6 +27,7 @@
 
 #include <openspace/data/dataloader.h>
 #include <filesystem>
+#include <functional>
 #include <optional>
 
 namespace openspace::dataloader::speck {
@@ -34,6 +35,21 @@ namespace openspace::dataloader::speck {
 Dataset loadSpeckFile(std::filesystem::path path,
     std::optional<DataMapping> specs = std::nullopt);
 
+/**
+ * Reads the SPECK file at \p path in chunks of at most \p chunkSize data lines, so that
+ * the entire dataset never has to be held in memory at once. Once the header has been
+ * read, \p onHeader is called with a dataset that contains the header information, but
+ * no entries, and the number of lines in the data section, which is an upper bound for
+ * the number of points. Afterwards, \p onChunk is called with the entries of each chunk
+ * in the order in which they appear in the file. Reading stops early if either of the
+ * callbacks returns `false`.
+ *
+ * \throw ghoul::RuntimeError If the file could not be opened or parsed
+ */
+void streamSpeckFile(std::filesystem::path path, std::optional<DataMapping> specs,
+    size_t chunkSize, const std::function<bool(const Dataset&, size_t)>& onHeader,
+    const std::function<bool(Dataset::Entries)>& onChunk);
+
 Labelset loadLabelFile(std::filesystem::path path);
 
 ColorMap loadCmapFile(std::filesystem::path path);
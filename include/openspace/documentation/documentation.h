@@ -28,6 +28,7 @@
 #include <ghoul/misc/boolean.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/stringconversion.h>
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <vector>
@@ -268,6 +269,20 @@ struct Documentation {
 TestResult testSpecification(const Documentation& documentation,
     const ghoul::Dictionary& dictionary);
 
+/**
+ * This method tests whether a provided ghoul::Dictionary \p dictionary adheres to the
+ * list of \p entries. It behaves the same as testing against a Documentation that
+ * consists of these \p entries, but it does not require them to be copied into a
+ * Documentation first. This is useful for nested tables, whose entries are stored in
+ * their TableVerifier.
+ *
+ * \param entries The entries that the \p dictionary is tested against
+ * \param dictionary The ghoul::Dictionary that is to be tested against the \p entries
+ * \return A TestResult that contains the results of the specification testing
+ */
+TestResult testSpecification(const std::vector<DocumentationEntry>& entries,
+    const ghoul::Dictionary& dictionary);
+
 /**
  * This method tests whether a provided ghoul::Dictionary \p dictionary adheres to the
  * specification \p documentation. If the \p dictionary does not adhere to the
@@ -287,6 +302,29 @@ TestResult testSpecification(const Documentation& documentation,
 void testSpecificationAndThrow(const Documentation& documentation,
     const ghoul::Dictionary& dictionary, std::string component);
 
+/**
+ * Enables the verification snapshot and loads the dictionaries that passed
+ * #testSpecification in a previous run from the provided \p file. The snapshot is only
+ * used if it was saved with the same \p version, which has to change whenever any of the
+ * Documentation%s might have changed. While the snapshot is enabled, a dictionary that
+ * has passed before is not tested again against the same Documentation. As the snapshot
+ * is keyed by the contents of the dictionary, changing an asset only causes the changed
+ * dictionaries to be tested again. Please note that verifiers that depend on the state of
+ * the file system, such as the existence of files, are not reevaluated for these
+ * dictionaries.
+ *
+ * \param file The file from which the snapshot is loaded and to which it is saved
+ * \param version The version of the application that is using the snapshot
+ */
+void loadVerificationSnapshot(std::filesystem::path file, std::string version);
+
+/**
+ * Saves all dictionaries that have passed a test without any warnings since the snapshot
+ * was enabled by #loadVerificationSnapshot. Dictionaries that were not tested in this run
+ * are not retained. If the snapshot is not enabled, this function does nothing.
+ */
+void saveVerificationSnapshot();
+
 } // namespace openspace::documentation
 
 // Make the overload for std::to_string available for the Offense::Reason for easier
@@ -29,6 +29,10 @@
 #include <openspace/json.h>
 #include <openspace/properties/propertyowner.h>
 #include <ghoul/misc/exception.h>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace openspace::documentation {
 
@@ -74,7 +78,17 @@ public:
      *
      * \return A list of all registered Documentation%s
      */
-    std::vector<Documentation> documentations() const;
+    const std::vector<Documentation>& documentations() const;
+
+    /**
+     * Returns the registered Documentation with the provided \p id or `nullptr` if no
+     * such Documentation exists. The returned pointer is invalidated by the next call to
+     * #addDocumentation.
+     *
+     * \param id The identifier of the Documentation that is requested
+     * \return The Documentation with the \p id or `nullptr`
+     */
+    const Documentation* documentation(std::string_view id) const;
 
     static void initialize();
     static void deinitialize();
@@ -102,6 +116,8 @@ public:
 private:
     /// The list of all Documentation%s that are stored by the DocumentationEngine
     std::vector<Documentation> _documentations;
+    /// The index into #_documentations for each Documentation with an identifier
+    std::map<std::string, size_t, std::less<>> _documentationIndices;
 
     static DocumentationEngine* _instance;
 };
@@ -31,6 +31,7 @@
 #include <ghoul/misc/dictionary.h>
 #include <filesystem>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -110,8 +111,10 @@ struct Configuration {
 
     std::string onScreenTextScaling = "window";
     bool usePerProfileCache = false;
+    bool useVerificationSnapshot = false;
 
     bool isRenderingOnMasterDisabled = false;
+    bool useDeltaSynchronization = false;
     glm::vec3 globalRotation = glm::vec3(0.0);
     glm::vec3 screenSpaceRotation = glm::vec3(0.0);
     glm::vec3 masterRotation = glm::vec3(0.0);
@@ -156,6 +159,21 @@ struct Configuration {
     // Values not read from the openspace.cfg file
     std::string sgctConfigNameInitialized;
 
+    /// Settings for the automated benchmark mode that is enabled from the commandline
+    struct Benchmark {
+        /// The number of frames that are measured before the application exits
+        int nFrames = 0;
+        /// The session recording that is played back while measuring
+        std::string sessionRecording;
+        /// A Lua script file that is executed once the profile has finished loading
+        std::string script;
+        /// The JSON file into which the per-frame measurements are written
+        std::string output = "${LOGS}/benchmark.json";
+        /// The fixed amount of simulation time in seconds that passes every frame
+        double deltaTime = 1.0 / 60.0;
+    };
+    std::optional<Benchmark> benchmark;
+
     static documentation::Documentation Documentation();
     ghoul::lua::LuaState state;
 };
@@ -26,18 +26,34 @@
 #define __OPENSPACE_CORE___DOWNLOADMANAGER___H__
 
 #include <ghoul/misc/boolean.h>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
 #include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace ghoul::filesystem { class File; }
 
 namespace openspace {
 
-// Multithreaded
+/**
+ * Downloads files from URLs either on the calling thread or asynchronously. Asynchronous
+ * file downloads are queued and executed by a fixed number of worker threads, each of
+ * which keeps its connections alive between downloads. Downloads are started in the
+ * order of their priority, and no more than a maximum number of downloads are run
+ * against the same host at the same time.
+ *
+ * Files are first downloaded into a partial file next to the destination, which is
+ * renamed once the download has finished. If a partial file from an earlier, interrupted
+ * download exists, the download is resumed using an HTTP range request.
+ */
 class DownloadManager {
 public:
     struct FileFuture {
@@ -65,12 +81,27 @@ public:
         size_t size = 0;
         std::string format;
         bool corrupted = false;
+        /// The value of the `ETag` header of the response, if there was one
+        std::string etag;
+        /// The value of the `Last-Modified` header of the response, if there was one
+        std::string lastModified;
+        /// `true` if the server answered a conditional request with `304 Not Modified`,
+        /// in which case the buffer is empty
+        bool isNotModified = false;
     };
 
     BooleanType(UseMultipleThreads);
     BooleanType(OverrideFile);
     BooleanType(FailOnError);
 
+    enum class Priority {
+        Low = 0,
+        Normal,
+        High
+    };
+
+    static constexpr int DefaultMaxConnections = 8;
+    static constexpr int DefaultMaxConnectionsPerHost = 4;
 
     using DownloadProgressCallback = std::function<void(const FileFuture&)>;
     using DownloadFinishedCallback = std::function<void(const FileFuture&)>;
@@ -89,7 +120,10 @@ public:
         return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
     }
 
-    DownloadManager(UseMultipleThreads useMultipleThreads = UseMultipleThreads::Yes);
+    DownloadManager(UseMultipleThreads useMultipleThreads = UseMultipleThreads::Yes,
+        int maxConnections = DefaultMaxConnections,
+        int maxConnectionsPerHost = DefaultMaxConnectionsPerHost);
+    ~DownloadManager();
 
     //downloadFile
     // url - specifies the target of the download
@@ -99,22 +133,62 @@ public:
     // timeout_secs - timeout in seconds before giving up on download (0 = no timeout)
     // finishedCallback - callback when download finished (happens on different thread)
     // progressCallback - callback for status during (happens on different thread)
+    // priority - downloads with a higher priority are started before lower ones
     std::shared_ptr<FileFuture> downloadFile(const std::string& url,
         const std::filesystem::path& file,
         OverrideFile overrideFile = OverrideFile::Yes,
         FailOnError failOnError = FailOnError::No, unsigned int timeout_secs = 0,
         DownloadFinishedCallback finishedCallback = DownloadFinishedCallback(),
-        DownloadProgressCallback progressCallback = DownloadProgressCallback()) const;
+        DownloadProgressCallback progressCallback = DownloadProgressCallback(),
+        Priority priority = Priority::Normal);
 
+    //fetchFile
+    // url - specifies the target of the download
+    // successCallback - callback when download finished (happens on different thread)
+    // errorCallback - callback when download failed (happens on different thread)
+    // headers - additional request headers, for example `If-None-Match: <etag>` to make
+    //           a conditional request
     std::future<MemoryFile> fetchFile(const std::string& url,
         SuccessCallback successCallback = SuccessCallback(),
-        ErrorCallback errorCallback = ErrorCallback());
+        ErrorCallback errorCallback = ErrorCallback(),
+        std::vector<std::string> headers = std::vector<std::string>());
 
     void fileExtension(const std::string& url,
         RequestFinishedCallback finishedCallback = RequestFinishedCallback()) const;
 
 private:
+    struct Job {
+        std::string url;
+        std::string host;
+        std::filesystem::path file;
+        FailOnError failOnError;
+        unsigned int timeout;
+        DownloadFinishedCallback finishedCallback;
+        DownloadProgressCallback progressCallback;
+        std::shared_ptr<FileFuture> future;
+        Priority priority;
+        /// Keeps the order of submission for jobs with the same priority
+        uint64_t sequence;
+    };
+
+    void workerLoop();
+
+    /// Removes and returns the next job that can be started without exceeding the
+    /// per-host limit. Has to be called while holding `_mutex`
+    std::optional<Job> popNextJob();
+
+    void performDownload(void* curl, Job& job) const;
+
     bool _useMultithreadedDownload;
+    int _maxConnectionsPerHost;
+
+    std::vector<std::thread> _workers;
+    std::vector<Job> _queue;
+    std::map<std::string, int> _activeConnectionsPerHost;
+    uint64_t _nextSequence = 0;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::atomic_bool _shouldStop = false;
 };
 
 } // namespace openspace
@@ -0,0 +1,107 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMESTATISTICS___H__
+#define __OPENSPACE_CORE___FRAMESTATISTICS___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/boolproperty.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+
+namespace openspace {
+
+/**
+ * Collects per-frame timing information for the stages of a frame on this node. The
+ * stages are measured around the SGCT callbacks so that a slow frame in a cluster can be
+ * attributed to the master's pre-synchronization, the size of the synchronization
+ * payload, the rendering on a node, or the time spent waiting on the swap barrier. Each
+ * stage can be entered multiple times per frame (for example rendering of multiple
+ * viewports), in which case the durations are accumulated.
+ *
+ * If requested, one line per frame is written to a CSV file in the log folder, one file
+ * per cluster node, so that the files of different nodes can be compared frame by frame.
+ */
+class FrameStatistics : public properties::PropertyOwner {
+public:
+    enum class Stage {
+        PreSynchronization = 0,
+        Encode,
+        Decode,
+        PostSynchronizationPreDraw,
+        Render,
+        SwapWait
+    };
+    static constexpr int NStages = 6;
+
+    struct Frame {
+        uint64_t frameNumber = 0;
+        /// The duration of each stage in milliseconds, indexed by `Stage`
+        std::array<double, NStages> durations = {};
+        /// The number of bytes that were encoded (master) or decoded (clients)
+        uint64_t syncBytes = 0;
+    };
+
+    FrameStatistics();
+    ~FrameStatistics() override;
+
+    void beginStage(Stage stage);
+    void endStage(Stage stage);
+    void setSyncBytes(uint64_t bytes);
+
+    /**
+     * Finishes the frame that is currently being measured and starts a new one. This has
+     * to be called once per frame before any of the stages are measured.
+     */
+    void finishFrame();
+
+    /// Returns the measurements of the last finished frame
+    const Frame& lastFrame() const;
+
+    /// Returns an exponentially smoothed average of the recent frames
+    const Frame& averageFrame() const;
+
+    static std::string_view nameForStage(Stage stage);
+
+private:
+    void writeFrame(const Frame& frame);
+
+    properties::BoolProperty _logToFile;
+
+    std::array<std::chrono::steady_clock::time_point, NStages> _stageBegin;
+    std::array<bool, NStages> _isStageActive = {};
+    Frame _currentFrame;
+    Frame _lastFrame;
+    Frame _averageFrame;
+
+    std::ofstream _logFile;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMESTATISTICS___H__
@@ -48,6 +48,7 @@ class RaycasterManager;
 class RenderEngine;
 class ScreenSpaceRenderable;
 class SyncEngine;
+class ThreadPool;
 class TimeManager;
 class VersionChecker;
 struct WindowDelegate;
@@ -85,6 +86,7 @@ inline RaycasterManager* raycasterManager;
 inline RenderEngine* renderEngine;
 inline std::vector<std::unique_ptr<ScreenSpaceRenderable>>* screenSpaceRenderables;
 inline SyncEngine* syncEngine;
+inline ThreadPool* threadPool;
 inline TimeManager* timeManager;
 inline VersionChecker* versionChecker;
 inline WindowDelegate* windowDelegate;
@@ -42,6 +42,8 @@ namespace documentation { struct Documentation; }
  * respectively with both also require the `FileName` value for the location at which the
  * logfile should be created. Both logs can be customized using the `Append`,
  * `TimeStamping`, `DateStamping`, `CategoryStamping`, and `LogLevelStamping` values.
+ * If the `Asynchronous` value is `true`, the log is wrapped in an AsyncLog that writes
+ * the messages on a background thread.
  *
  * \param dictionary The dictionary from which the ghoul::logging::Log should be created
  * \return The created ghoul::logging::Log
@@ -51,6 +53,7 @@ namespace documentation { struct Documentation; }
  *
  * \see ghoul::logging::TextLog
  * \see ghoul::logging::HTMLLog
+ * \see AsyncLog
  */
 std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictionary);
 
@@ -0,0 +1,146 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___MEMORYTRACKER___H__
+#define __OPENSPACE_CORE___MEMORYTRACKER___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/doubleproperty.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace openspace {
+
+/**
+ * Keeps track of the memory that renderables and other components allocate for their GPU
+ * buffers, textures, and large CPU-side data. Contrary to OpenSpaceEngine::ramInUse and
+ * OpenSpaceEngine::vramInUse, which only report the totals of the process, the tracked
+ * memory is attributed to the scene graph node and the module that allocated it.
+ *
+ * Each allocation is registered through an Allocation object that is resized whenever
+ * the underlying memory changes and that unregisters itself when it is destroyed. The
+ * totals per node and per module are exposed as read-only properties that are refreshed
+ * once per frame in #update. Registering and resizing allocations is thread-safe.
+ */
+class MemoryTracker : public properties::PropertyOwner {
+public:
+    enum class Type {
+        Ram = 0,
+        Vram
+    };
+
+    /// The number of bytes that are used in system memory and in video memory
+    struct Usage {
+        uint64_t ram = 0;
+        uint64_t vram = 0;
+    };
+
+    /**
+     * A single block of memory that is tracked while this object is alive. An empty
+     * \p node denotes memory that is shared between scene graph nodes, which is only
+     * attributed to the module.
+     */
+    class Allocation {
+    public:
+        Allocation() = default;
+        Allocation(std::string node, std::string module, Type type);
+        Allocation(Allocation&& other) noexcept;
+        Allocation& operator=(Allocation&& other) noexcept;
+        Allocation(const Allocation&) = delete;
+        Allocation& operator=(const Allocation&) = delete;
+        ~Allocation();
+
+        /// Sets the number of bytes that are currently used by this allocation
+        void setSize(uint64_t bytes);
+
+    private:
+        MemoryTracker* _tracker = nullptr;
+        int _id = -1;
+    };
+
+    MemoryTracker();
+
+    /**
+     * Updates the properties and the Tracy plots from the registered allocations. This
+     * function has to be called once per frame from the main thread.
+     */
+    void update();
+
+    Usage total() const;
+    std::map<std::string, Usage> usagePerNode() const;
+    std::map<std::string, Usage> usagePerModule() const;
+
+private:
+    struct Entry {
+        std::string node;
+        std::string module;
+        Type type = Type::Ram;
+        uint64_t bytes = 0;
+    };
+
+    /// The read-only properties that show the usage of one node or one module
+    struct UsageProperties : public properties::PropertyOwner {
+        explicit UsageProperties(const std::string& identifier);
+
+        properties::DoubleProperty ram;
+        properties::DoubleProperty vram;
+    };
+    using PropertyMap = std::map<std::string, std::unique_ptr<UsageProperties>>;
+
+    int add(std::string node, std::string module, Type type);
+    void setSize(int id, uint64_t bytes);
+    void remove(int id);
+
+    /**
+     * Creates, updates, and removes the entries of the \p properties owned by the
+     * \p parent so that they match the \p usage.
+     */
+    static void updateProperties(const std::map<std::string, Usage>& usage,
+        properties::PropertyOwner& parent, PropertyMap& properties);
+
+    mutable std::mutex _mutex;
+    std::unordered_map<int, Entry> _allocations;
+    int _nextId = 0;
+
+    properties::DoubleProperty _totalRam;
+    properties::DoubleProperty _totalVram;
+    properties::PropertyOwner _nodes;
+    properties::PropertyOwner _modules;
+    PropertyMap _nodeProperties;
+    PropertyMap _moduleProperties;
+
+    // Tracy only stores the pointer to the name of a plot, so the names have to outlive
+    // the plots
+    std::set<std::string> _plotNames;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___MEMORYTRACKER___H__
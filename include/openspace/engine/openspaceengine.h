@@ -25,12 +25,15 @@
 #ifndef __OPENSPACE_CORE___OPENSPACEENGINE___H__
 #define __OPENSPACE_CORE___OPENSPACEENGINE___H__
 
+#include <openspace/engine/framestatistics.h>
 #include <openspace/engine/globalscallbacks.h>
+#include <openspace/engine/memorytracker.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/propertyowner.h>
 #include <openspace/properties/property.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/scene/profile.h>
 #include <openspace/util/keys.h>
@@ -40,7 +43,9 @@
 #include <ghoul/glm.h>
 #include <future>
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace openspace {
@@ -71,6 +76,11 @@ struct CommandlineArguments {
     std::optional<std::string> profile;
     std::optional<std::string> propertyVisibility;
     std::optional<bool> bypassLauncher;
+    std::optional<int> benchmarkFrames;
+    std::optional<std::string> benchmarkRecording;
+    std::optional<std::string> benchmarkScript;
+    std::optional<std::string> benchmarkOutput;
+    std::optional<double> benchmarkDeltaTime;
 };
 
 class OpenSpaceEngine : public properties::PropertyOwner {
@@ -113,7 +123,7 @@ public:
     void touchExitCallback(TouchInput input);
     void handleDragDrop(std::filesystem::path file);
     std::vector<std::byte> encode();
-    void decode(std::vector<std::byte> data);
+    void decode(std::span<const std::byte> data);
 
     properties::Property::Visibility visibility() const;
     void toggleShutdownMode();
@@ -137,6 +147,13 @@ public:
     uint64_t ramInUse() const;
     uint64_t vramInUse() const;
 
+    /// Returns the timing measurements of the recent frames on this node
+    const FrameStatistics& frameStatistics() const;
+
+    /// Returns the tracker with which the memory of renderables and components is
+    /// registered
+    MemoryTracker& memoryTracker();
+
     /**
      * Returns the Lua library that contains all Lua functions available to affect the
      * application.
@@ -149,10 +166,28 @@ private:
 
     void runGlobalCustomizationScripts();
 
+    /// Starts the session recording and script of the benchmark mode
+    void startBenchmark();
+
+    /**
+     * Stores the measurements of the last finished frame and, once the requested number
+     * of frames has been measured, writes the results and terminates the application.
+     */
+    void recordBenchmarkFrame();
+
+    void writeBenchmarkResults() const;
+
     properties::BoolProperty _printEvents;
     properties::OptionProperty _visibility;
     properties::FloatProperty _fadeOnEnableDuration;
     properties::BoolProperty _disableAllMouseInputs;
+    properties::IntProperty _temporaryMemoryUsage;
+    properties::IntProperty _temporaryMemoryHighWaterMark;
+
+    FrameStatistics _frameStatistics;
+    // Declared before the scene so that the allocations of the renderables are
+    // unregistered before the tracker is destroyed
+    MemoryTracker _memoryTracker;
 
     std::unique_ptr<Scene> _scene;
     std::unique_ptr<AssetManager> _assetManager;
@@ -165,6 +200,15 @@ private:
 
     ShutdownInformation _shutdown;
 
+    struct BenchmarkSample {
+        FrameStatistics::Frame frame;
+        /// The GPU time in milliseconds of each measured section, in order
+        std::vector<std::pair<std::string, float>> gpuTimes;
+        uint64_t ram = 0;
+        uint64_t vram = 0;
+    };
+    std::vector<BenchmarkSample> _benchmarkSamples;
+
     // The first frame might take some more time in the update loop, so we need to know to
     // disable the synchronization; otherwise a hardware sync will kill us after 1 minute
     bool _isRenderingFirstFrame = true;
@@ -29,6 +29,7 @@
 
 #include <ghoul/misc/boolean.h>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace openspace {
@@ -60,7 +61,23 @@ public:
      * Decodes the `SyncBuffer` into the added Syncables. This method is only called on
      * the SGCT client nodes.
      */
-    void decodeSyncables(std::vector<std::byte> data);
+    void decodeSyncables(std::span<const std::byte> data);
+
+    /**
+     * Enables or disables the delta encoding of the synchronization payload. If enabled,
+     * only the Syncables whose encoded state differs from the previous frame are
+     * transmitted and the receiving nodes reuse their last known state for the others.
+     * A full keyframe is sent every #KeyframeInterval frames, after the list of
+     * Syncables changed, or when explicitly requested through #requestKeyframe. This
+     * setting has to be the same on all nodes of the cluster.
+     */
+    void setDeltaEncoding(bool enabled);
+
+    /**
+     * Forces the next call to #encodeSyncables to produce a full keyframe containing the
+     * state of all Syncables. This is only meaningful if delta encoding is enabled.
+     */
+    void requestKeyframe();
 
     /**
      * Invokes the presync method of all added Syncables.
@@ -97,11 +114,30 @@ public:
     void removeSyncables(const std::vector<Syncable*>& syncables);
 
 private:
+    /// The number of frames after which a full keyframe is sent in delta encoding mode
+    static constexpr int KeyframeInterval = 120;
+
+    std::vector<std::byte> encodeDelta();
+    void decodeDelta(std::span<const std::byte> data);
+    void invalidateDeltaState();
+
     /// Vector of Syncables. The vectors ensures consistent encode/decode order.
     std::vector<Syncable*> _syncables;
 
     /// Databuffer used in encoding/decoding
     SyncBuffer _syncBuffer;
+
+    bool _useDeltaEncoding = false;
+    bool _isKeyframeRequested = true;
+    int _framesSinceKeyframe = 0;
+
+    /// Last encoded (master) or decoded (client) state of each Syncable, in the same
+    /// order as `_syncables`
+    std::vector<std::vector<std::byte>> _deltaState;
+    bool _isAwaitingKeyframe = true;
+
+    /// Scratch buffer used to encode and decode a single Syncable in delta mode
+    SyncBuffer _syncableBuffer;
 };
 
 } // namespace openspace
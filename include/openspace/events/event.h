@@ -106,6 +106,17 @@ Event::Type fromString(std::string_view str);
 
 ghoul::Dictionary toParameter(const Event& e);
 
+/**
+ * Returns the identifier of the scene graph node that is stored in the `Node` parameter
+ * of the provided event, or an empty string if the event does not have such a parameter.
+ * This is the same value that #toParameter would return for the `Node` key, but it can be
+ * accessed without creating the full parameter dictionary.
+ *
+ * \param e The event whose node identifier should be returned
+ * \return The identifier of the node stored in the event or an empty string
+ */
+std::string_view nodeParameter(const Event& e);
+
 void logAllEvents(const Event* e);
 
 //
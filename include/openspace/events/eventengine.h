@@ -28,7 +28,8 @@
 #include <openspace/events/event.h>
 #include <openspace/scripting/lualibrary.h>
 #include <ghoul/misc/memorypool.h>
-#include <unordered_map>
+#include <array>
+#include <vector>
 
 namespace openspace {
 
@@ -44,6 +45,10 @@ public:
         bool isEnabled = true;
         std::string action;
         std::optional<ghoul::Dictionary> filter;
+
+        /// If the `filter` contains a `Node` value, this is its hash, which is used to
+        /// reject events for other nodes before the full filter has to be checked
+        std::optional<size_t> nodeFilterHash;
     };
 
     struct TopicInfo {
@@ -51,6 +56,11 @@ public:
         ScriptCallback callback;
     };
 
+    /// The registered actions, indexed by the value of their event type
+    using EventActions = std::array<
+        std::vector<ActionInfo>, static_cast<size_t>(events::Event::Type::Last)
+    >;
+
     /**
      * This function returns the first event stored in the EventEngine, or `nullptr` if
      * no event exists. To navigate the full list of events, you can access the returned
@@ -141,10 +151,9 @@ public:
     /**
      * Returns the list of all registered actions, grouped by their event type.
      *
-     * \return The unordered map of all registered actions
+     * \return The registered actions, indexed by the value of their event type
      */
-    const std::unordered_map<events::Event::Type, std::vector<ActionInfo>>&
-        eventActions() const;
+    const EventActions& eventActions() const;
 
     /**
      * Enables the event identified by the \p identifier. If the event is already enabled,
@@ -185,11 +194,14 @@ private:
     events::Event* _lastEvent = nullptr;
 
     /// The type is duplicated in the ActionInfo as well, but we want it in the ActionInfo
-    /// to be able to return them to a caller and we want it in this unordered_map to make
-    /// the lookup really fast. So having this extra wasted memory is probably worth it
-    std::unordered_map<events::Event::Type, std::vector<ActionInfo>> _eventActions;
-
-    std::unordered_map<events::Event::Type, std::vector<TopicInfo>> _eventTopics;
+    /// to be able to return them to a caller and we want it as the index into this array
+    /// to make the lookup really fast. So having this extra wasted memory is probably
+    /// worth it
+    EventActions _eventActions;
+
+    std::array<
+        std::vector<TopicInfo>, static_cast<size_t>(events::Event::Type::Last)
+    > _eventTopics;
 
     static uint32_t nextRegisteredEventId;
 
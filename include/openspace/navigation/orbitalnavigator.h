@@ -227,6 +227,7 @@ private:
     properties::FloatProperty _staticViewScaleExponent;
 
     properties::BoolProperty _constantVelocityFlight;
+    properties::BoolProperty _approximateSurfaceQueries;
 
     properties::FloatProperty _retargetInterpolationTime;
     properties::FloatProperty _stereoInterpolationTime;
@@ -256,6 +257,13 @@ private:
     std::optional<glm::dquat> _previousAnchorNodeRotation;
     std::optional<glm::dvec3> _previousAimNodePosition;
 
+    // Distance the camera moved in the previous frame and its height above the surface of
+    // the anchor at the end of that frame. Used to detect fast motion
+    double _previousCameraStep = 0.0;
+    double _previousCameraAltitude = 0.0;
+    // Direction tolerance passed to the surface position queries in the current frame
+    double _surfaceQueryTolerance = 0.0;
+
     double _currentCameraToSurfaceDistance = 0.0;
     bool _directlySetStereoDistance = false;
 
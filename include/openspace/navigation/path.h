@@ -91,6 +91,13 @@ public:
      */
     CameraPose traversePath(double dt, float speedScale = 1.f);
 
+    /**
+     * Compute the camera position that would be reached by traversing the path for
+     * another \p dt seconds with the provided \p speedScale, without advancing the path.
+     * This can be used to prepare for where the camera is going to be in the near future.
+     */
+    glm::dvec3 predictedPosition(double dt, float speedScale = 1.f) const;
+
     /**
      * Function that can be used to permaturely quit a path, for example when skipping
      * to the end.
@@ -35,6 +35,7 @@
 #include <openspace/properties/scalar/floatproperty.h>
 #include <ghoul/glm.h>
 #include <memory>
+#include <optional>
 
 namespace openspace {
     class Camera;
@@ -68,6 +69,12 @@ public:
 
     float estimatedRemainingTimeInPath() const;
 
+    /**
+     * Returns the position the camera will have in \p dt seconds if a path is currently
+     * being played, or `std::nullopt` if there is no path or if it is paused.
+     */
+    std::optional<glm::dvec3> predictedCameraPosition(double dt) const;
+
     void updateCamera(double deltaTime);
     void createPath(const ghoul::Dictionary& dictionary);
     void clearPath();
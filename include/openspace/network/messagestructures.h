@@ -30,6 +30,8 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/stringhelper.h>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -42,7 +44,8 @@ namespace openspace::datamessagestructures {
 enum class Type : uint32_t {
     CameraData = 0,
     TimelineData,
-    ScriptData
+    ScriptData,
+    CompactCameraData
 };
 
 struct CameraKeyframe {
@@ -251,6 +254,146 @@ struct CameraKeyframe {
     }
 };
 
+/**
+ * A camera keyframe for the parallel connection that is smaller than the CameraKeyframe.
+ * The rotation is quantized to three 16 bit components, of which the fourth one can be
+ * reconstructed, and the focus node is only included if it is not empty. The receiver
+ * keeps using the last focus node that it has received otherwise.
+ */
+struct CompactCameraKeyframe {
+    CompactCameraKeyframe() = default;
+    CompactCameraKeyframe(const std::vector<char>& buffer) {
+        deserialize(buffer);
+    }
+
+    glm::dvec3 _position = glm::dvec3(0.0);
+    glm::dquat _rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+    bool _followNodeRotation = false;
+    // Empty if the focus node has not changed since the last keyframe
+    std::string _focusNode;
+    float _scale = 0.f;
+
+    double _timestamp = 0.0;
+
+    void serialize(std::vector<char>& buffer) const {
+        uint8_t flags = 0;
+        if (_followNodeRotation) {
+            flags |= FollowNodeRotationFlag;
+        }
+        if (!_focusNode.empty()) {
+            flags |= FocusNodeFlag;
+        }
+        buffer.push_back(static_cast<char>(flags));
+
+        buffer.insert(
+            buffer.end(),
+            reinterpret_cast<const char*>(&_position),
+            reinterpret_cast<const char*>(&_position) + sizeof(_position)
+        );
+
+        // Only the three smallest components are stored, as the largest one follows
+        // from the unit length. The sign of the quaternion is chosen so that the largest
+        // component is positive
+        int largest = 0;
+        for (int i = 1; i < 4; i++) {
+            if (std::abs(_rotation[i]) > std::abs(_rotation[largest])) {
+                largest = i;
+            }
+        }
+        const double sign = _rotation[largest] < 0.0 ? -1.0 : 1.0;
+        buffer.push_back(static_cast<char>(largest));
+        for (int i = 0; i < 4; i++) {
+            if (i == largest) {
+                continue;
+            }
+            const double v = std::clamp(sign * _rotation[i] * Sqrt2, -1.0, 1.0);
+            const int16_t q = static_cast<int16_t>(std::round(v * 32767.0));
+            buffer.insert(
+                buffer.end(),
+                reinterpret_cast<const char*>(&q),
+                reinterpret_cast<const char*>(&q) + sizeof(q)
+            );
+        }
+
+        if (!_focusNode.empty()) {
+            const uint32_t nodeNameLength = static_cast<uint32_t>(_focusNode.size());
+            buffer.insert(
+                buffer.end(),
+                reinterpret_cast<const char*>(&nodeNameLength),
+                reinterpret_cast<const char*>(&nodeNameLength) + sizeof(uint32_t)
+            );
+            buffer.insert(
+                buffer.end(),
+                _focusNode.data(),
+                _focusNode.data() + nodeNameLength
+            );
+        }
+
+        buffer.insert(
+            buffer.end(),
+            reinterpret_cast<const char*>(&_scale),
+            reinterpret_cast<const char*>(&_scale) + sizeof(_scale)
+        );
+        buffer.insert(
+            buffer.end(),
+            reinterpret_cast<const char*>(&_timestamp),
+            reinterpret_cast<const char*>(&_timestamp) + sizeof(_timestamp)
+        );
+    }
+
+    size_t deserialize(const std::vector<char>& buffer, size_t offset = 0) {
+        const uint8_t flags = static_cast<uint8_t>(buffer[offset]);
+        offset += sizeof(uint8_t);
+        _followNodeRotation = (flags & FollowNodeRotationFlag) != 0;
+
+        std::memcpy(glm::value_ptr(_position), buffer.data() + offset, sizeof(_position));
+        offset += sizeof(_position);
+
+        const int largest = static_cast<int>(buffer[offset]);
+        offset += sizeof(uint8_t);
+        double sumSquares = 0.0;
+        for (int i = 0; i < 4; i++) {
+            if (i == largest) {
+                continue;
+            }
+            int16_t q = 0;
+            std::memcpy(&q, buffer.data() + offset, sizeof(q));
+            offset += sizeof(q);
+            _rotation[i] = static_cast<double>(q) / 32767.0 / Sqrt2;
+            sumSquares += _rotation[i] * _rotation[i];
+        }
+        _rotation[largest] = std::sqrt(std::max(1.0 - sumSquares, 0.0));
+
+        if (flags & FocusNodeFlag) {
+            uint32_t nodeNameLength = 0;
+            std::memcpy(&nodeNameLength, buffer.data() + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            _focusNode = std::string(
+                buffer.data() + offset,
+                buffer.data() + offset + nodeNameLength
+            );
+            offset += nodeNameLength;
+        }
+        else {
+            _focusNode.clear();
+        }
+
+        std::memcpy(&_scale, buffer.data() + offset, sizeof(_scale));
+        offset += sizeof(_scale);
+        std::memcpy(&_timestamp, buffer.data() + offset, sizeof(_timestamp));
+        offset += sizeof(_timestamp);
+
+        return offset;
+    }
+
+private:
+    static constexpr uint8_t FollowNodeRotationFlag = 1 << 0;
+    static constexpr uint8_t FocusNodeFlag = 1 << 1;
+
+    // The three smallest components of a unit quaternion are at most 1 / sqrt(2)
+    static constexpr double Sqrt2 = 1.4142135623730951;
+};
+
 struct TimeKeyframe {
     TimeKeyframe() = default;
     TimeKeyframe(const std::vector<char>& buffer) {
@@ -28,6 +28,7 @@
 #include <openspace/network/messagestructures.h>
 #include <ghoul/io/socket/tcpsocket.h>
 #include <ghoul/misc/exception.h>
+#include <span>
 #include <vector>
 
 namespace openspace {
@@ -61,11 +62,12 @@ public:
 
     struct DataMessage {
         DataMessage() = default;
-        DataMessage(datamessagestructures::Type t, double time, std::vector<char> c);
+        DataMessage(datamessagestructures::Type t, double time, std::span<const char> c);
 
         datamessagestructures::Type type;
         double timestamp;
-        std::vector<char> content;
+        /// Non-owning view of the payload; the data has to outlive the message
+        std::span<const char> content;
     };
 
     class ConnectionLostError : public ghoul::RuntimeError {
@@ -86,10 +88,17 @@ public:
     ParallelConnection::Message receiveMessage();
 
     // Gonna do some UTF-like magic once we reach 255 to introduce a second byte or so
-    static constexpr uint8_t ProtocolVersion = 7;
+    static constexpr uint8_t ProtocolVersion = 8;
 
 private:
+    /// Clears the send buffer and writes the message header into it
+    void beginMessage(MessageType type, uint32_t contentSize);
+    void appendToMessage(const void* data, size_t size);
+
     std::unique_ptr<ghoul::io::TcpSocket> _socket;
+    /// Reused for every outgoing message so that sending does not allocate once the
+    /// buffer has grown to its working size. Messages are only sent from the main thread
+    std::vector<char> _sendBuffer;
     bool _shouldDisconnect = false;
 };
 
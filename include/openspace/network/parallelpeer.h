@@ -29,13 +29,16 @@
 
 #include <openspace/network/messagestructures.h>
 #include <openspace/network/parallelconnection.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/stringproperty.h>
+#include <openspace/util/spscqueue.h>
 #include <openspace/util/timemanager.h>
 #include <ghoul/designpattern/event.h>
 #include <atomic>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -87,6 +90,12 @@ private:
     void nConnectionsMessageReceived(const std::vector<char>& message);
 
     void sendCameraKeyframe();
+
+    /**
+     * Sends the camera keyframe \p kf as a compact keyframe, which only includes the
+     * focus node if it has changed or has not been sent for a while.
+     */
+    void sendCompactCameraKeyframe(const datamessagestructures::CameraKeyframe& kf);
     void sendTimeTimeline();
 
     void setStatus(ParallelConnection::Status status);
@@ -108,10 +117,20 @@ private:
     properties::FloatProperty _bufferTime;
     properties::FloatProperty _timeKeyframeInterval;
     properties::FloatProperty _cameraKeyframeInterval;
+    properties::BoolProperty _adaptiveCameraKeyframes;
 
     double _lastTimeKeyframeTimestamp = 0.0;
     double _lastCameraKeyframeTimestamp = 0.0;
 
+    // The state of the adaptive camera keyframes on the host
+    std::optional<datamessagestructures::CameraKeyframe> _lastSentCameraKeyframe;
+    std::optional<datamessagestructures::CameraKeyframe> _skippedCameraKeyframe;
+    double _lastFocusNodeTimestamp = 0.0;
+    bool _isCameraMovingFast = false;
+
+    // The focus node of the last compact camera keyframe that contained one
+    std::string _receivedFocusNode;
+
     std::atomic_bool _shouldDisconnect = false;
 
     std::atomic<size_t> _nConnections = 0;
@@ -120,8 +139,9 @@ private:
 
     std::string _hostName;
 
-    std::deque<ParallelConnection::Message> _receiveBuffer;
-    std::mutex _receiveBufferMutex;
+    // Messages are pushed by the receive thread and handled by the main thread, so
+    // neither thread has to wait while the other one is using the buffer
+    SpscQueue<ParallelConnection::Message> _receiveBuffer;
 
     std::atomic<bool> _timeJumped;
     std::atomic<bool> _timeTimelineChanged;
@@ -133,6 +153,8 @@ private:
     std::shared_ptr<ghoul::Event<>> _connectionEvent;
 
     ParallelConnection _connection;
+    /// Serialization buffer for outgoing data messages that is reused between sends
+    std::vector<char> _sendBuffer;
 
     TimeManager::CallbackHandle _timeJumpCallback = -1;
     TimeManager::CallbackHandle _timeTimelineChangeCallback = -1;
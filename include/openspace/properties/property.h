@@ -286,6 +286,43 @@ public:
      */
     void removeOnDelete(OnDeleteHandle handle);
 
+    /**
+     * Starts a batch of property changes on the current thread. While at least one batch
+     * is active, the onChange callbacks of Propertys whose values change are not invoked
+     * immediately. Instead, each changed Property is remembered once and its callbacks
+     * are invoked when the outermost batch is closed by #endChangeBatch. Batches can be
+     * nested.
+     */
+    static void beginChangeBatch();
+
+    /**
+     * Ends the innermost batch of property changes on the current thread. If this was the
+     * outermost batch, the deferred onChange callbacks of all Propertys that changed
+     * during the batch are invoked in the order in which the Propertys first changed.
+     *
+     * \pre There must be an active batch on the current thread
+     */
+    static void endChangeBatch();
+
+    /**
+     * Returns the number of batches of property changes that are currently active on the
+     * current thread.
+     *
+     * \return The number of active batches on the current thread
+     */
+    static int changeBatchDepth();
+
+    /**
+     * A helper that starts a batch of property changes when it is created and ends it
+     * when it is destroyed.
+     */
+    struct ChangeBatch {
+        ChangeBatch() { beginChangeBatch(); }
+        ~ChangeBatch() { endChangeBatch(); }
+        ChangeBatch(const ChangeBatch&) = delete;
+        ChangeBatch& operator=(const ChangeBatch&) = delete;
+    };
+
     /**
      * This method returns the unique identifier of this Property.
      *
@@ -509,7 +546,8 @@ public:
 protected:
     /**
      * This method must be called by all subclasses whenever the encapsulated value has
-     * changed and potential listeners need to be informed.
+     * changed and potential listeners need to be informed. If a batch of property changes
+     * is active, the listeners are informed when the batch ends instead.
      */
     void notifyChangeListeners();
 
@@ -539,6 +577,11 @@ protected:
 
 private:
     void notifyDeleteListeners();
+    void invokeChangeListeners();
+
+    /// Is `true` if this Property changed during the current batch of property changes
+    /// and its listeners have not yet been informed
+    bool _hasPendingNotification = false;
 
     OnChangeHandle _currentHandleValue = 0;
 
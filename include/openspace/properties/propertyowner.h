@@ -27,6 +27,8 @@
 
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace openspace::properties {
@@ -44,7 +46,8 @@ class Property;
  * be accessed using the Property::properties method or the Property::property method,
  * providing an URI for the location of the property. If the URI contains separators
  * (`.`), the first name before the separator will be used as a subOwner's name and the
- * search will proceed recursively.
+ * search will proceed recursively. The direct properties and sub-owners are indexed by
+ * their identifiers, so resolving a URI only takes one hash lookup per level.
  */
 class PropertyOwner {
 public:
@@ -79,8 +82,10 @@ public:
      * Sets the identifier for this PropertyOwner. If the PropertyOwner does not have an
      * owner itself, the identifier must be globally unique. If the PropertyOwner has an
      * owner, the identifier must be unique to the owner (including the owner's
-     * properties). No uniqueness check will be preformed here, but rather in the
-     * PropertyOwner::addProperty and PropertyOwner::addPropertySubOwner methods).
+     * properties). If the PropertyOwner already has an owner and another sub-owner or
+     * property of that owner uses the \p identifier, an error is logged and the
+     * identifier is not changed. Otherwise, the uniqueness check is performed in the
+     * PropertyOwner::addProperty and PropertyOwner::addPropertySubOwner methods.
      *
      * \param identifier The identifier of this PropertyOwner. It must not contain any
      *        `.`s or whitespaces
@@ -150,7 +155,7 @@ public:
      * \return If the Property cannot be found, `nullptr` is returned, otherwise the
      *         pointer to the Property is returned
      */
-    Property* property(const std::string& uri) const;
+    Property* property(std::string_view uri) const;
 
     /**
      * Retrieves a PropertyOwner identified by \p uri from this PropertyOwner. If \p uri
@@ -164,7 +169,7 @@ public:
      * \return If the PropertyOwner cannot be found, `nullptr` is returned, otherwise the
      *         pointer to the PropertyOwner is returned
      */
-    PropertyOwner* propertyOwner(const std::string& uri) const;
+    PropertyOwner* propertyOwner(std::string_view uri) const;
 
     /**
      * Returns a uri for this PropertyOwner. This is created by looking up all the owners
@@ -184,7 +189,7 @@ public:
      *
      * \return `true` if the \p uri refers to a Property; `false` otherwise
      */
-    bool hasProperty(const std::string& uri) const;
+    bool hasProperty(std::string_view uri) const;
 
     /**
      * This method checks if a Property exists in this PropertyOwner.
@@ -214,7 +219,7 @@ public:
      * \param identifier The identifier of the sub-owner that should be returned
      * \return The PropertyOwner with the given \p identifier, or `nullptr`
      */
-    PropertyOwner* propertySubOwner(const std::string& identifier) const;
+    PropertyOwner* propertySubOwner(std::string_view identifier) const;
 
     /**
      * Returns `true` if this PropertyOwner owns a sub-owner with the provided
@@ -224,7 +229,7 @@ public:
      * \return `true` if this PropertyOwner owns a sub-owner with the provided
      *         \p identifier; returns `false` otherwise
      */
-    bool hasPropertySubOwner(const std::string& identifier) const;
+    bool hasPropertySubOwner(std::string_view identifier) const;
 
     /**
      * This method converts a provided \p groupID, used by the Propertys, into a
@@ -317,7 +322,29 @@ public:
      */
     void removeTag(const std::string& tag);
 
+    /**
+     * Returns a counter that is incremented whenever any PropertyOwner changes in a way
+     * that can change the result of a URI or tag search, that is when a Property or
+     * sub-owner is added or removed, when an identifier or a tag changes, or when a
+     * PropertyOwner is destroyed. Callers that cache search results can compare this
+     * value to determine whether their results are still valid.
+     *
+     * \return The current structure generation of all PropertyOwners
+     */
+    static uint64_t structureGeneration();
+
 protected:
+    /// Hash that allows the identifier maps to be searched with `std::string_view`s
+    struct IdentifierHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const {
+            return std::hash<std::string_view>()(s);
+        }
+    };
+    template <typename T>
+    using IdentifierMap =
+        std::unordered_map<std::string, T*, IdentifierHash, std::equal_to<>>;
+
     /// The unique identifier of this PropertyOwner
     std::string _identifier;
     /// The user-facing GUI name for this PropertyOwner
@@ -333,6 +360,10 @@ protected:
     std::vector<Property*> _properties;
     /// A list of all sub-owners
     std::vector<PropertyOwner*> _subOwners;
+    /// The registered Property's indexed by their identifier
+    IdentifierMap<Property> _propertyIndex;
+    /// The sub-owners indexed by their identifier
+    IdentifierMap<PropertyOwner> _subOwnerIndex;
     /// The associations between group identifiers of Property's and human-readable names
     std::map<std::string, std::string> _groupNames;
     /// Collection of string tag(s) assigned to this property
@@ -69,6 +69,22 @@ public:
      * helper file) which should be a prefix to all symbols defined by the helper
      */
     virtual std::filesystem::path helperPath() const = 0;
+
+    /**
+     * Enables or disables the temporal reprojection of this deferredcaster. If it is
+     * enabled, the deferredcaster is only evaluated for half of the pixels in a
+     * checkerboard pattern that alternates between frames. The other pixels are
+     * reprojected from the result of the previous frame, unless the G-buffer shows that
+     * they were occluded or outside the view in that frame, in which case they are
+     * evaluated as well.
+     */
+    void setTemporalReprojection(bool enabled);
+
+    bool hasTemporalReprojection() const;
+
+private:
+    /// Whether the renderer reuses the result of the previous frame for half the pixels
+    bool _hasTemporalReprojection = false;
 };
 
 } // namespace openspace
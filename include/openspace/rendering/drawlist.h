@@ -0,0 +1,118 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___DRAWLIST___H__
+#define __OPENSPACE_CORE___DRAWLIST___H__
+
+#include <ghoul/opengl/ghoul_gl.h>
+#include <functional>
+#include <vector>
+
+namespace ghoul::opengl { class ProgramObject; }
+
+namespace openspace {
+
+/**
+ * A lightweight description of a single draw call together with the OpenGL state that it
+ * requires. Packets are collected in a DrawList and executed later in an order that
+ * minimizes the number of state changes.
+ */
+struct DrawPacket {
+    enum class BlendMode {
+        Disabled = 0,
+        /// Blending with `GL_SRC_ALPHA` and `GL_ONE_MINUS_SRC_ALPHA`
+        Normal,
+        /// Blending with `GL_SRC_ALPHA` and `GL_ONE`
+        Additive
+    };
+
+    enum class DepthMode {
+        Disabled = 0,
+        /// Depth testing is enabled, but the depth buffer is not written to
+        Test,
+        /// Depth testing is enabled and the depth buffer is written to
+        TestAndWrite
+    };
+
+    /// The program that is used for this draw call. Must not be `nullptr`
+    ghoul::opengl::ProgramObject* program = nullptr;
+
+    /// The vertex array object that contains the geometry
+    GLuint vao = 0;
+
+    BlendMode blendMode = BlendMode::Disabled;
+    DepthMode depthMode = DepthMode::TestAndWrite;
+    float lineWidth = 1.f;
+    bool lineSmooth = false;
+    /// Whether the point size is written by the program (`GL_PROGRAM_POINT_SIZE`)
+    bool programPointSize = false;
+
+    /// The primitive type that is drawn
+    GLenum mode = GL_TRIANGLES;
+    /// The first vertex or, for indexed draws, the offset in bytes into the index buffer
+    GLint first = 0;
+    /// The number of vertices or indices that are drawn
+    GLsizei count = 0;
+    /// The type of the indices in the element buffer of the `vao`. If this is `GL_NONE`,
+    /// `glDrawArrays` is used, otherwise `glDrawElements`
+    GLenum indexType = GL_NONE;
+
+    /// Sets the uniforms that are specific to this draw call. The program is already
+    /// active when this function is called
+    std::function<void(ghoul::opengl::ProgramObject&)> setUniforms;
+};
+
+/**
+ * Collects DrawPackets during one render bin. When the list is executed, the packets
+ * are sorted by program, blend mode, depth mode, and vertex array object so that each of
+ * these only has to be changed when it actually differs from the previous packet.
+ * Afterwards, the blend, depth, line, and point size state are reset to their default
+ * values.
+ */
+class DrawList {
+public:
+    /**
+     * Adds the \p packet to the list of draw calls.
+     *
+     * \pre packet.program must not be `nullptr`
+     */
+    void submit(DrawPacket packet);
+
+    /**
+     * Sorts and executes all submitted packets and clears the list afterwards.
+     */
+    void execute();
+
+    /**
+     * Returns the number of packets that are currently waiting to be executed.
+     */
+    size_t size() const;
+
+private:
+    std::vector<DrawPacket> _packets;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___DRAWLIST___H__
@@ -0,0 +1,103 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___ECLIPSESHADOWS___H__
+#define __OPENSPACE_CORE___ECLIPSESHADOWS___H__
+
+#include <ghoul/glm.h>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace openspace {
+
+/**
+ * The EclipseShadows compute the eclipse shadows that light sources and shadow casters
+ * throw onto spherical receivers, such as globes and their atmospheres. The world space
+ * positions and scales of the sources and casters are looked up only once for each
+ * point in time and are shared by all receivers, so that the SPICE and scene graph
+ * lookups are not repeated for every globe, atmosphere, and render pass in a frame.
+ */
+class EclipseShadows {
+public:
+    /// The name and the radius of a light source or a shadow caster
+    using Body = std::pair<std::string, double>;
+
+    /// The shadow that a caster throws onto a receiver, in world coordinates (meters)
+    struct Shadow {
+        double umbra = 0.0;
+        double penumbra = 0.0;
+        double radiusSource = 0.0;
+        double radiusCaster = 0.0;
+        glm::dvec3 sourceCasterVec = glm::dvec3(0.0);
+        glm::dvec3 casterPositionVec = glm::dvec3(0.0);
+        bool isShadowing = false;
+    };
+
+    /**
+     * Returns the position of the SPICE \p target relative to the solar system
+     * barycenter in the galactic frame at the provided \p time in meters.
+     */
+    const glm::dvec3& position(const std::string& target, double time);
+
+    /**
+     * Calculates the shadow that the \p caster throws onto a spherical receiver when it
+     * is illuminated by the \p source. The names are both the SPICE names and the scene
+     * graph node identifiers of the source and caster, whose radii are scaled by the
+     * scale of their scene graph nodes. The receiver is only considered to be in shadow
+     * if the caster is closer to the \p sunPosition than the receiver.
+     *
+     * \param source The name and radius of the light source
+     * \param caster The name and radius of the shadow caster
+     * \param receiverPosition The world position of the receiver
+     * \param receiverRadius The radius of the receiver in meters
+     * \param sunPosition The world position of the Sun
+     * \param time The time in J2000 seconds for which the shadow is calculated
+     * \return The shadow, or `std::nullopt` if the source or caster is not a scene graph
+     *         node
+     */
+    std::optional<Shadow> shadow(const Body& source, const Body& caster,
+        const glm::dvec3& receiverPosition, double receiverRadius,
+        const glm::dvec3& sunPosition, double time);
+
+private:
+    /// Clears all cached values if the \p time differs from the time they are valid for
+    void setTime(double time);
+
+    /**
+     * Returns the scale of the radius of the scene graph node with the provided \p name
+     * or `std::nullopt` if there is no such node.
+     */
+    std::optional<double> radiusScale(const std::string& name);
+
+    double _time = 0.0;
+    bool _hasTime = false;
+    std::map<std::string, glm::dvec3, std::less<>> _positions;
+    std::map<std::string, std::optional<double>, std::less<>> _radiusScales;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___ECLIPSESHADOWS___H__
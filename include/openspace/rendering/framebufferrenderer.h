@@ -27,11 +27,14 @@
 
 #include <openspace/rendering/raycasterlistener.h>
 #include <openspace/rendering/deferredcasterlistener.h>
+#include <openspace/rendering/drawlist.h>
 
 #include <ghoul/glm.h>
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <array>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -51,6 +54,7 @@ struct DeferredcastData;
 struct DeferredcasterTask;
 struct RaycastData;
 struct RaycasterTask;
+struct RenderData;
 class Scene;
 struct UpdateStructures;
 
@@ -152,6 +156,8 @@ public:
     void updateHDRAndFiltering();
     void updateFXAA();
     void updateDownscaledVolume();
+    void updateTemporalReprojection();
+    void updateOrderIndependentTransparency();
 
     void setResolution(glm::ivec2 res);
     void setHDRExposure(float hdrExposure);
@@ -159,13 +165,49 @@ public:
     void setHueValueSaturation(float hue, float value, float saturation);
 
     void enableFXAA(bool enable);
+    void setUseDrawLists(bool enable);
     void setDisableHDR(bool disable);
 
+    /**
+     * Selects whether the color and normal buffers use half precision floating point
+     * values instead of single precision ones. Changing this value reallocates all
+     * buffers in the next frame.
+     */
+    void setCompactFormats(bool enable);
+
+    /**
+     * Enables or disables the dynamic resolution. If it is enabled, the scene is
+     * rendered with a fraction of the resolution that is adjusted every frame so that the
+     * GPU time of the frame approaches the target frame time. The image is upscaled to
+     * the full resolution when the tone mapping is applied.
+     */
+    void enableDynamicResolution(bool enable);
+
+    /**
+     * Sets the GPU frame time in milliseconds that the dynamic resolution aims for.
+     */
+    void setTargetFrameTime(float milliseconds);
+
+    /**
+     * Sets the lowest and highest fraction of the full resolution that the dynamic
+     * resolution can use for the scene.
+     */
+    void setDynamicResolutionBounds(float minScale, float maxScale);
+
     void update();
     void performRaycasterTasks(const std::vector<RaycasterTask>& tasks,
         const glm::ivec4& viewport);
     void performDeferredTasks(const std::vector<DeferredcasterTask>& tasks,
         const glm::ivec4& viewport);
+
+    /**
+     * Renders the \p tasks into the weighted blended order-independent transparency
+     * buffers and composites the result onto the currently used color texture. The
+     * buffers are only created the first time that this function is called, so there is
+     * no cost for scenes in which no renderable uses order-independent transparency.
+     */
+    void performOrderIndependentTransparencyTasks(
+        const std::vector<std::function<void()>>& tasks);
     void render(Scene* scene, Camera* camera, float blackoutFactor);
 
     /**
@@ -188,32 +230,164 @@ private:
         std::unique_ptr<ghoul::opengl::ProgramObject>
     >;
 
+    /**
+     * The state of the adaptive resolution of a raycaster that has a target raycast
+     * time. The scale is adjusted based on the GPU time of earlier frames, which is
+     * measured with timer queries. For a few frames after the scale has changed while
+     * the camera is still, the raycast result is blended with the previous frames so that
+     * the change in resolution is not visible as a pop.
+     */
+    struct AdaptiveResolution {
+        // Two queries are used alternately so that the result of the older one is
+        // available without stalling
+        std::array<GLuint, 2> queries = { 0, 0 };
+        std::array<bool, 2> isQueryIssued = { false, false };
+        unsigned int queryIndex = 0;
+        // The last measured GPU time of the raycasting in milliseconds
+        float gpuTime = 0.f;
+
+        float scale = 1.f;
+        glm::dmat4 viewProjection = glm::dmat4(0.0);
+        int nStillFrames = 0;
+        int nFramesSinceSwitch = 0;
+
+        GLuint historyFramebuffer = 0;
+        std::array<GLuint, 2> historyTextures = { 0, 0 };
+        unsigned int historyIndex = 0;
+        glm::ivec2 historySize = glm::ivec2(0);
+        bool hasHistory = false;
+    };
+
+    /**
+     * The state of the temporal reprojection of a deferredcaster. The result of each
+     * frame and the G-buffer positions are kept, so that the pixels that are not
+     * evaluated in the next frame can be reprojected from them. The reprojected pixels
+     * are marked in a depth buffer, which lets the depth test reject them before the
+     * deferredcaster's fragment shader runs.
+     */
+    struct TemporalReprojection {
+        // Contains the output of the deferredcaster and the depth mask
+        GLuint framebuffer = 0;
+        GLuint maskDepthbuffer = 0;
+
+        GLuint historyFramebuffer = 0;
+        GLuint historyColorTexture = 0;
+        GLuint historyPositionTexture = 0;
+        glm::ivec2 historySize = glm::ivec2(0);
+        glm::ivec4 historyViewport = glm::ivec4(0);
+        glm::dmat4 viewMatrix = glm::dmat4(1.0);
+        glm::mat4 projectionMatrix = glm::mat4(1.f);
+        bool hasHistory = false;
+
+        // Selects which half of the checkerboard is reprojected
+        unsigned int parity = 0;
+    };
+
+    /**
+     * The state of the dynamic resolution of the scene. The GPU time of each frame is
+     * measured with timestamp queries, as time elapsed queries cannot be nested with the
+     * ones that are used for the adaptive resolution of the raycasters.
+     */
+    struct DynamicResolution {
+        bool isEnabled = false;
+        float targetFrameTime = 16.6f;
+        float minScale = 0.5f;
+        float maxScale = 1.f;
+
+        // The begin and end timestamps of two frames that are used alternately so that
+        // the result of the older frame is available without stalling
+        std::array<GLuint, 4> queries = { 0, 0, 0, 0 };
+        std::array<bool, 2> isQueryIssued = { false, false };
+        unsigned int queryIndex = 0;
+        // The last measured GPU time of a frame in milliseconds
+        float gpuTime = 0.f;
+
+        float scale = 1.f;
+    };
+
+    /**
+     * Updates the dynamic resolution with the GPU time of an earlier frame and returns
+     * the fraction of the resolution that the scene is rendered with in this frame.
+     */
+    float updateDynamicScale();
+
     void resolveMSAA(float blackoutFactor);
-    void applyTMO(float blackoutFactor, const glm::ivec4& viewport);
+    void applyTMO(float blackoutFactor, const glm::ivec4& viewport, float renderScale);
     void applyFXAA(const glm::ivec4& viewport);
-    void updateDownscaleTextures() const;
     void updateExitVolumeTextures();
-    void writeDownscaledVolume(const glm::ivec4& viewport);
+
+    /**
+     * Composites the volume in \p colorTexture onto the G-buffer. The color and depth
+     * have been rendered into the lower left part of their textures that is given by
+     * \p colorScale and \p depthScale, respectively.
+     */
+    void writeDownscaledVolume(const glm::ivec4& viewport, GLuint colorTexture,
+        float colorScale, float depthScale);
+
+    /**
+     * Updates the adaptive resolution \p state with the GPU time of an earlier frame and
+     * the camera movement and returns the scale to use for the current frame.
+     */
+    float updateAdaptiveScale(AdaptiveResolution& state,
+        const VolumeRaycaster& raycaster, const RenderData& data);
+
+    /**
+     * Blends the volume that has just been rendered with \p scale into the next history
+     * texture of the \p state and returns that texture.
+     */
+    GLuint accumulateVolume(AdaptiveResolution& state, float scale,
+        const glm::ivec4& viewport);
+    void releaseAdaptiveResolution(AdaptiveResolution& state);
+
+    /**
+     * Binds the framebuffer of the temporal reprojection \p state with the ping-pong
+     * color texture \p target and writes the pixels that can be reprojected from the
+     * previous frame into it. Afterwards, the depth test only passes for the pixels that
+     * still have to be evaluated.
+     */
+    void reprojectDeferredcast(TemporalReprojection& state, GLuint target,
+        const RenderData& data, const glm::ivec4& viewport);
+
+    /**
+     * Stores the result of the deferredcaster together with the G-buffer positions as
+     * the history of the temporal reprojection \p state and binds the ping-pong
+     * framebuffer again.
+     */
+    void storeDeferredcastHistory(TemporalReprojection& state, const RenderData& data,
+        const glm::ivec4& viewport);
+    void releaseTemporalReprojection(TemporalReprojection& state);
+    void updateOrderIndependentTransparencyTextures();
 
     std::map<VolumeRaycaster*, RaycastData> _raycastData;
     RaycasterProgObjMap _exitPrograms;
     RaycasterProgObjMap _raycastPrograms;
     RaycasterProgObjMap _insideRaycastPrograms;
+    std::map<VolumeRaycaster*, AdaptiveResolution> _adaptiveResolutions;
 
     std::map<Deferredcaster*, DeferredcastData> _deferredcastData;
     DeferredcasterProgObjMap _deferredcastPrograms;
+    std::map<Deferredcaster*, TemporalReprojection> _temporalReprojections;
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _hdrFilteringProgram;
     std::unique_ptr<ghoul::opengl::ProgramObject> _tmoProgram;
     std::unique_ptr<ghoul::opengl::ProgramObject> _fxaaProgram;
     std::unique_ptr<ghoul::opengl::ProgramObject> _downscaledVolumeProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> _accumulateVolumeProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> _reprojectDeferredProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> _transparencyResolveProgram;
 
     UniformCache(hdrFeedingTexture, blackoutFactor, hdrExposure, gamma,
-        Hue, Saturation, Value, Viewport, Resolution) _hdrUniformCache;
+        Hue, Saturation, Value, Viewport, Resolution, RenderScale) _hdrUniformCache;
     UniformCache(renderedTexture, inverseScreenSize, Viewport,
         Resolution) _fxaaUniformCache;
     UniformCache(downscaledRenderedVolume, downscaledRenderedVolumeDepth, viewport,
-        resolution) _writeDownscaledVolumeUniformCache;
+        resolution, colorScale, depthScale) _writeDownscaledVolumeUniformCache;
+    UniformCache(currentVolume, previousVolume, currentScale, weight, viewport,
+        resolution) _accumulateVolumeUniformCache;
+    UniformCache(mainPositionTexture, previousColorTexture, previousPositionTexture,
+        currentToPrevious, previousProjection, inverseProjection, parity, viewport,
+        resolution) _reprojectDeferredUniformCache;
+    UniformCache(accumulationTexture, revealageTexture) _transparencyUniformCache;
 
     GLint _defaultFBO = 0;
     GLuint _screenQuad = 0;
@@ -244,9 +418,16 @@ private:
         GLuint framebuffer;
         GLuint colorTexture;
         GLuint depthbuffer;
-        float currentDownscaleFactor  = 1.f;
     } _downscaleVolumeRendering;
 
+    // Weighted blended order-independent transparency. The framebuffer uses the depth
+    // texture of the G-buffer, so that the transparent objects are occluded correctly
+    struct {
+        GLuint framebuffer = 0;
+        GLuint accumulationTexture = 0;
+        GLuint revealageTexture = 0;
+    } _transparencyBuffers;
+
     unsigned int _pingPongIndex = 0u;
 
     bool _dirtyDeferredcastData;
@@ -256,7 +437,11 @@ private:
     glm::ivec2 _resolution = glm::ivec2(0);
     int _nAaSamples;
     bool _enableFXAA = true;
+    bool _useDrawLists = false;
+    DrawList _drawList;
     bool _disableHDR = false;
+    bool _useCompactFormats = false;
+    DynamicResolution _dynamicResolution;
 
     float _hdrExposure = 3.7f;
     float _gamma = 0.95f;
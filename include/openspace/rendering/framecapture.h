@@ -0,0 +1,124 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMECAPTURE___H__
+#define __OPENSPACE_CORE___FRAMECAPTURE___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/optionproperty.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
+#include <openspace/properties/stringproperty.h>
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The FrameCapture reads back rendered frames without stalling the rendering. Each
+ * capture is read into one of a ring of pixel buffer objects and a fence is inserted
+ * after the read. The buffer is only mapped after the fence has been signaled, which
+ * usually happens a frame or two later, and the copied pixels are encoded on the global
+ * ThreadPool. Instead of writing image files, the frames can also be written as raw
+ * RGBA data to the standard input of an external video encoder.
+ *
+ * The capture reads the back buffer of the window that is current at the end of the
+ * frame, so it always contains the final, warped image of that window. While the
+ * capture is disabled, screenshots are taken by the windowing framework instead.
+ */
+class FrameCapture : public properties::PropertyOwner {
+public:
+    /// The number of pixel buffer objects in the ring
+    static constexpr int NumberOfBuffers = 4;
+
+    FrameCapture();
+
+    /**
+     * Waits for all outstanding captures to be encoded, closes the video encoder, and
+     * destroys the pixel buffer objects.
+     */
+    void deinitializeGL();
+
+    bool isEnabled() const;
+
+    /**
+     * Requests that the current frame is captured and stored at the provided \p path.
+     * The extension of \p path is replaced with the one of the selected format. The
+     * frame is read back the next time #nextFrame is called.
+     */
+    void capture(std::filesystem::path path);
+
+    /**
+     * Reads back the frame if a capture has been requested and hands all previous
+     * captures whose fence has been signaled to the encoder. This function has to be
+     * called once at the end of each frame after everything has been rendered.
+     */
+    void nextFrame();
+
+private:
+    struct Buffer {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        glm::ivec2 size = glm::ivec2(0);
+        std::filesystem::path path;
+    };
+
+    /// Issues the read of the back buffer into the next buffer of the ring
+    void readFrame(std::filesystem::path path);
+
+    /**
+     * Hands the pixels of the \p buffer to the encoder. If \p wait is `true`, this
+     * function blocks until the fence of the buffer is signaled, otherwise `false` is
+     * returned if the read has not finished yet.
+     */
+    bool finishFrame(Buffer& buffer, bool wait);
+
+    /// Writes the \p pixels to the video encoder process, starting it if necessary
+    void writeToEncoder(const std::vector<std::byte>& pixels, const glm::ivec2& size);
+    void closeEncoder();
+
+    std::array<Buffer, NumberOfBuffers> _buffers;
+    int _nextBuffer = 0;
+    std::optional<std::filesystem::path> _requestedCapture;
+    std::vector<std::future<void>> _encodings;
+
+    FILE* _encoder = nullptr;
+    glm::ivec2 _encoderSize = glm::ivec2(0);
+
+    properties::BoolProperty _isEnabled;
+    properties::OptionProperty _format;
+    properties::IntProperty _jpegQuality;
+    properties::StringProperty _videoEncoderCommand;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMECAPTURE___H__
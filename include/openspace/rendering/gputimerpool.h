@@ -0,0 +1,140 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___GPUTIMERPOOL___H__
+#define __OPENSPACE_CORE___GPUTIMERPOOL___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/floatproperty.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The GpuTimerPool measures the time that the GPU spends on named sections of a frame,
+ * such as the passes of the FramebufferRenderer or the rendering of individual scene
+ * graph nodes. Each section is bracketed by a pair of timestamp queries taken from a
+ * pool that grows as needed. Since timestamps do not have to be nested like elapsed time
+ * queries, sections can overlap each other and other timer queries that are active in
+ * the same frame. The results of a frame are only read back #Latency frames later so
+ * that the measurement never stalls the pipeline. If a section with the same name is
+ * measured multiple times in a frame, for example a node that renders in multiple
+ * render bins, the times are added.
+ */
+class GpuTimerPool : public properties::PropertyOwner {
+public:
+    /// The number of frames between recording a section and reading back its result
+    static constexpr int Latency = 3;
+
+    struct Timing {
+        std::string name;
+        float time = 0.f; // in ms
+    };
+
+    /// A helper that measures the section with the provided name during its lifetime
+    class Scope {
+    public:
+        Scope(GpuTimerPool& pool, std::string_view name);
+        ~Scope();
+
+    private:
+        GpuTimerPool& _pool;
+        int _section = -1;
+    };
+
+    GpuTimerPool();
+
+    void deinitializeGL();
+
+    bool isEnabled() const;
+
+    /**
+     * Reads back the results of the oldest recorded frame and starts the recording of a
+     * new frame. This function has to be called exactly once at the end of each frame.
+     */
+    void nextFrame();
+
+    /**
+     * Starts the measurement of the section with the provided \p name and returns the
+     * handle that has to be passed to #end. If the timing is disabled, no queries are
+     * issued and `-1` is returned.
+     */
+    int begin(std::string_view name);
+
+    /**
+     * Finishes the measurement of the \p section that was returned by #begin. Passing
+     * `-1` is a no-op.
+     */
+    void end(int section);
+
+    /**
+     * Returns the GPU time in milliseconds of the section with the provided \p name in
+     * the latest frame whose results are available, or `-1` if that section was not
+     * measured in that frame.
+     */
+    float time(std::string_view name) const;
+
+    /**
+     * Returns the GPU times of all sections of the latest frame whose results are
+     * available.
+     */
+    std::vector<Timing> timings() const;
+
+private:
+    struct Section {
+        std::string name;
+        int beginQuery = 0;
+        int endQuery = 0;
+    };
+
+    struct Frame {
+        std::vector<GLuint> queries;
+        int nUsedQueries = 0;
+        std::vector<Section> sections;
+    };
+
+    /**
+     * Returns the index of the next unused query of the current frame, creating the
+     * query if necessary.
+     */
+    int nextQuery();
+
+    std::array<Frame, Latency> _frames;
+    int _currentFrame = 0;
+    std::map<std::string, float, std::less<>> _times;
+
+    properties::BoolProperty _isEnabled;
+    properties::FloatProperty _frameTime;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___GPUTIMERPOOL___H__
@@ -0,0 +1,72 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___LABELDENSITYGRID___H__
+#define __OPENSPACE_CORE___LABELDENSITYGRID___H__
+
+#include <ghoul/glm.h>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A coarse grid over the screen that is used to limit the number of labels that are
+ * drawn in each region of the screen, so that dense label sets do not turn into an
+ * unreadable clutter. The labels should be tested in the order of their priority, for
+ * example from near to far, as the first labels in a region are the ones that are kept.
+ */
+class LabelDensityGrid {
+public:
+    /// The width and height of each of the regions in pixels
+    static constexpr int RegionSize = 64;
+
+    /**
+     * Clears the grid for a new frame.
+     *
+     * \param resolution The resolution of the rendering in pixels
+     * \param maxLabelsPerRegion The maximum number of labels that are accepted in each
+     *        region. A value of 0 means that the number of labels is not limited
+     */
+    void reset(const glm::ivec2& resolution, int maxLabelsPerRegion);
+
+    /**
+     * Tests whether a label at the provided position should be drawn and, if so, counts
+     * it towards the limit of its region. Labels that are behind the camera or outside
+     * the screen are always accepted, as they are not taking up any space on screen.
+     *
+     * \param clipPosition The position of the label in clip space
+     * \return `true` if the label should be drawn, `false` if its region is full
+     */
+    bool tryAdd(const glm::dvec4& clipPosition);
+
+private:
+    glm::ivec2 _resolution = glm::ivec2(0);
+    glm::ivec2 _nRegions = glm::ivec2(0);
+    int _maxLabelsPerRegion = 0;
+    std::vector<int> _counts;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___LABELDENSITYGRID___H__
@@ -31,13 +31,17 @@
 #include <openspace/data/dataloader.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/ivec2property.h>
 #include <openspace/properties/vector/vec3property.h>
+#include <openspace/rendering/labeldensitygrid.h>
 #include <openspace/util/distanceconversion.h>
 #include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
 #include <filesystem>
 
 namespace ghoul::fontrendering { class Font; }
+namespace ghoul::opengl { class ProgramObject; }
 
 namespace openspace {
 struct RenderData;
@@ -55,6 +59,12 @@ public:
 
     void initialize();
 
+    /**
+     * Frees the GPU resources that are used for the batched rendering of the labels.
+     * Has to be called while the OpenGL context is still available
+     */
+    void deinitializeGL();
+
     /**
      * Create the labels from an already loaded dataset. That dataset should have a
      * comment per point to be used for the labels.
@@ -79,6 +89,16 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    void renderBatched(const RenderData& data,
+        const glm::dmat4& modelViewProjectionMatrix, const glm::vec3& orthoRight,
+        const glm::vec3& orthoUp, float fadeInVariable);
+
+    /// Builds the glyph quads for all enabled labels and uploads them to the GPU
+    void updateBatchedData();
+
+    /// Rebuilds the octree over the positions of all enabled labels
+    void updateOctree();
+
     std::filesystem::path _labelFile;
     DistanceUnit _unit = DistanceUnit::Parsec;
     dataloader::Labelset _labelset;
@@ -97,6 +117,36 @@ private:
     properties::FloatProperty _fontSize;
     properties::IVec2Property _minMaxSize;
     properties::BoolProperty _faceCamera;
+    properties::BoolProperty _useBatchedRendering;
+
+    // Set whenever the labels or the font change and the glyph quads need to be rebuilt
+    bool _batchIsDirty = true;
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    GLsizei _nGlyphs = 0;
+
+    // Shared between all labels components, similar to the font that is used
+    static ghoul::opengl::ProgramObject* _batchedProgram;
+
+    struct OctreeNode {
+        glm::vec3 boundsMin = glm::vec3(0.f);
+        glm::vec3 boundsMax = glm::vec3(0.f);
+        /// The index of the first of the eight children, or -1 if this is a leaf
+        int firstChild = -1;
+        /// The range in `_octreeLabels` of the labels that are inside this node
+        uint32_t firstLabel = 0;
+        uint32_t nLabels = 0;
+    };
+    // Set whenever the labels change and the octree needs to be rebuilt
+    bool _octreeIsDirty = true;
+    std::vector<OctreeNode> _octree;
+    /// Indices into the labelset, ordered such that the labels of each node are adjacent
+    std::vector<uint32_t> _octreeLabels;
+    /// The transformed and scaled positions for each of the labels in the labelset
+    std::vector<glm::vec3> _labelPositions;
+
+    properties::IntProperty _maxLabelsPerRegion;
+    LabelDensityGrid _densityGrid;
 };
 
 } // namespace openspace
@@ -31,6 +31,8 @@
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -98,6 +100,28 @@ private:
 
     void renderLogMessages() const;
 
+    /**
+     * Updates or adds the item while #_itemsMutex is held and returns whether anything
+     * about the item has changed.
+     */
+    bool updateItemLocked(const std::string& itemIdentifier, const std::string& itemName,
+        ItemStatus newStatus, ProgressInfo progressInfo);
+
+    /// Wakes up the loop in #exec, which is waiting for something on screen to change
+    void notifyChange();
+
+    /**
+     * Returns whether something was changed since the last call. If \p block is `true`,
+     * this function waits until a change happens or until the next frame is due.
+     */
+    bool waitForChange(bool block);
+
+    /**
+     * Renders a new frame if something has changed since the last frame and the frame
+     * rate cap allows for it, or if nothing has been rendered for a while.
+     */
+    void renderIfNeeded(bool hasChanged);
+
     bool _showMessage = true;
     bool _showNodeNames = true;
     bool _showLog = true;
@@ -130,6 +154,15 @@ private:
     };
     std::vector<Item> _items;
     std::mutex _itemsMutex;
+    /// Finished items are faded out, which requires a continuous redraw
+    bool _hasFadingItems = false;
+
+    std::mutex _changeMutex;
+    std::condition_variable _changeCondition;
+    bool _hasChanged = false;
+    /// A change that was not rendered yet because of the frame rate cap
+    bool _hasPendingChange = true;
+    std::chrono::steady_clock::time_point _lastFrameTime;
 
     bool _shouldAbortLoading = false;
 
@@ -32,6 +32,7 @@
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/util/keys.h>
+#include <openspace/util/prefixtrie.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <memory>
@@ -43,6 +44,8 @@ namespace ghoul::opengl { class ProgramObject; }
 
 namespace openspace {
 
+namespace events { struct Event; }
+
 class LuaConsole : public properties::PropertyOwner {
 public:
     LuaConsole();
@@ -54,6 +57,15 @@ public:
     bool keyboardCallback(Key key, KeyModifier modifier, KeyAction action);
     void charCallback(unsigned int codepoint, KeyModifier modifier);
 
+    /**
+     * Updates the index of property URIs that is used for the autocompletion with the
+     * changes to the property tree that are described by the events in the list that
+     * starts with \p e.
+     *
+     * \param e The first event of the list of events of the current frame
+     */
+    void handleEvents(const events::Event* e);
+
     void update();
     void render();
     float currentHeight() const;
@@ -64,6 +76,9 @@ private:
     void parallelConnectionChanged(const ParallelConnection::Status& status);
     void addToCommand(const std::string& c);
 
+    /// Adds the URIs of all properties in the subtree of the \p owner to the index
+    void indexProperties(const properties::PropertyOwner& owner);
+
     properties::BoolProperty _isVisible;
     properties::BoolProperty _shouldBeSynchronized;
     properties::BoolProperty _shouldSendToRemote;
@@ -86,6 +101,9 @@ private:
         std::string initialValue;
     } _autoCompleteInfo;
 
+    /// All property URIs that can be autocompleted when entering a string
+    PrefixTrie _propertyIndex;
+
     float _currentHeight = 0.f;
     float _targetHeight = 0.f;
     float _fullHeight = 0.f;
@@ -28,6 +28,7 @@
 #include <openspace/properties/propertyowner.h>
 #include <openspace/rendering/fadeable.h>
 
+#include <openspace/engine/memorytracker.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
@@ -35,6 +36,7 @@
 #include <openspace/scene/scenegraphnode.h>
 #include <ghoul/misc/managedmemoryuniqueptr.h>
 #include <string_view>
+#include <unordered_map>
 
 namespace ghoul { class Dictionary; }
 namespace ghoul::opengl {
@@ -52,11 +54,50 @@ struct UpdateData;
 
 namespace documentation { struct Documentation; }
 
+/**
+ * Describes in which frames a Renderable needs its update function to be called. The
+ * values other than `Always` can be combined, in which case the Renderable is updated
+ * in every frame in which at least one of the conditions is fulfilled. Independent of
+ * the policy, a Renderable can always wake itself up with Renderable::requestUpdate.
+ */
+enum class UpdatePolicy : uint8_t {
+    /// The Renderable is updated in every frame
+    Always = 0,
+    /// The Renderable is updated while it is visible, that is while it is enabled, not
+    /// faded out, and was not culled in the previous frame
+    WhenVisible = 0x01,
+    /// The Renderable is updated whenever the simulation time has changed since its last
+    /// update
+    OnTimeChange = 0x02,
+    /// The Renderable is updated whenever any of its properties, including the ones of
+    /// its subowners, has changed since its last update
+    OnPropertyChange = 0x04
+};
+
+constexpr bool hasUpdatePolicy(UpdatePolicy lhs, UpdatePolicy rhs) {
+    return static_cast<std::underlying_type_t<UpdatePolicy>>(lhs) &
+        static_cast<std::underlying_type_t<UpdatePolicy>>(rhs);
+}
+
+constexpr UpdatePolicy operator|(UpdatePolicy lhs, UpdatePolicy rhs) {
+    return static_cast<UpdatePolicy>(
+        static_cast<std::underlying_type_t<UpdatePolicy>>(lhs) |
+        static_cast<std::underlying_type_t<UpdatePolicy>>(rhs)
+    );
+}
+
 // Unfortunately we can't move this struct into the Renderable until
 // https://bugs.llvm.org/show_bug.cgi?id=36684 is fixed
 struct RenderableSettings {
     bool automaticallyUpdateRenderBin = true;
     bool shouldUpdateIfDisabled = false;
+    // If this is 'true', the Renderable's update function does not issue any OpenGL calls
+    // or access shared state and can thus be called on a worker thread when the scene is
+    // updated in parallel
+    bool supportsParallelUpdate = false;
+    // Determines in which frames the update function is called. Renderables that leave
+    // this at 'Always' are updated in every frame as long as they are enabled
+    UpdatePolicy updatePolicy = UpdatePolicy::Always;
 };
 
 class Renderable : public properties::PropertyOwner, public Fadeable {
@@ -75,7 +116,7 @@ public:
 
     Renderable(const ghoul::Dictionary& dictionary,
         RenderableSettings settings = RenderableSettings());
-    virtual ~Renderable() override = default;
+    virtual ~Renderable() override;
 
     virtual void initialize();
     virtual void initializeGL();
@@ -85,6 +126,20 @@ public:
     virtual bool isReady() const = 0;
     bool isEnabled() const;
     bool shouldUpdateIfDisabled() const noexcept;
+    bool supportsParallelUpdate() const noexcept;
+    UpdatePolicy updatePolicy() const noexcept;
+
+    /**
+     * Returns whether the update function has to be called in the current frame based on
+     * the UpdatePolicy of this Renderable. When this function returns `true`, all pending
+     * wake-ups are consumed, so it should only be called directly before calling update.
+     *
+     * \param data The UpdateData with which the Renderable would be updated
+     * \param wasRendered Whether the Renderable was drawn in the previous frame. A
+     *        Renderable that was not drawn was either culled or not visible
+     * \return `true` if the update function should be called in this frame
+     */
+    bool needsUpdate(const UpdateData& data, bool wasRendered);
 
     double boundingSphere() const noexcept;
     double interactionSphere() const noexcept;
@@ -127,6 +182,13 @@ protected:
 
     void setRenderBinFromOpacity();
 
+    /**
+     * Makes sure that the update function is called in the next frame regardless of the
+     * UpdatePolicy. This can be used to wake up a Renderable that is waiting for
+     * something the policy cannot observe, for example the result of a background task.
+     */
+    void requestUpdate();
+
     /**
      * Returns the full opacity constructed from the _opacity and _fade property values.
      */
@@ -134,6 +196,14 @@ protected:
 
     SceneGraphNode* parent() const noexcept;
 
+    /**
+     * Registers a new allocation with the MemoryTracker that is attributed to the scene
+     * graph node of this renderable and the provided \p module. The allocation starts
+     * out empty and has to be sized with MemoryTracker::Allocation::setSize.
+     */
+    MemoryTracker::Allocation trackedAllocation(std::string module,
+        MemoryTracker::Type type) const;
+
     bool automaticallyUpdatesRenderBin() const noexcept;
     bool hasOverrideRenderBin() const noexcept;
 
@@ -210,14 +280,27 @@ protected:
 
 private:
     void registerUpdateRenderBinFromOpacity();
+    void watchPropertyChanges();
 
     double _boundingSphere = 0.0;
     double _interactionSphere = 0.0;
     SceneGraphNode* _parent = nullptr;
     const bool _shouldUpdateIfDisabled = false;
+    const bool _supportsParallelUpdate = false;
+    const UpdatePolicy _updatePolicy = UpdatePolicy::Always;
     bool _automaticallyUpdateRenderBin = true;
     bool _hasOverrideRenderBin = false;
 
+    // State that is used to decide whether the update function has to be called
+    bool _hasPendingUpdate = true;
+    std::optional<double> _lastUpdateTime;
+    uint64_t _watchedStructureGeneration = 0;
+    struct PropertyWatch {
+        properties::Property::OnChangeHandle onChange;
+        properties::Property::OnDeleteHandle onDelete;
+    };
+    std::unordered_map<properties::Property*, PropertyWatch> _watchedProperties;
+
     // We only want the SceneGraphNode to be able manipulate the parent, so we don't want
     // to provide a set method for this. Otherwise, anyone might mess around with our
     // parentage and that's no bueno
@@ -35,9 +35,16 @@
 #include <openspace/properties/vector/vec3property.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/properties/triggerproperty.h>
+#include <openspace/rendering/eclipseshadows.h>
 #include <openspace/rendering/framebufferrenderer.h>
+#include <openspace/rendering/framecapture.h>
+#include <openspace/rendering/gputimerpool.h>
+#include <openspace/rendering/uploadscheduler.h>
 #include <chrono>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace ghoul {
     namespace fontrendering { class Font; }
@@ -80,6 +87,24 @@ public:
 
     ghoul::opengl::OpenGLStateCache& openglStateCache();
 
+    /**
+     * Returns the UploadScheduler that should be used by components to stagger their
+     * texture uploads across multiple frames.
+     */
+    UploadScheduler& uploadScheduler();
+
+    /**
+     * Returns the GpuTimerPool that measures the GPU time of the render passes and of
+     * the individual scene graph nodes.
+     */
+    GpuTimerPool& gpuTimerPool();
+
+    /**
+     * Returns the EclipseShadows that share the shadow caster lookups between all globes
+     * and atmospheres that are rendered in a frame.
+     */
+    EclipseShadows& eclipseShadows();
+
     void updateShaderPrograms();
     void updateRenderer();
     void updateScreenSpaceRenderables();
@@ -111,6 +136,24 @@ public:
         const std::filesystem::path& fsPath, const std::filesystem::path& csPath,
         ghoul::Dictionary data = ghoul::Dictionary());
 
+    /**
+     * Builds a program from the provided shader files in the same way as
+     * `ghoul::opengl::ProgramObject::Build`, but keeps the binary of the linked program
+     * in memory and in the cache directory. If a program with the same preprocessed
+     * sources has been linked by the same graphics driver before, in this or in a
+     * previous session, the stored binary is used instead of compiling and linking the
+     * shaders again. This is also used by #buildRenderProgram.
+     */
+    std::unique_ptr<ghoul::opengl::ProgramObject> buildCachedProgram(
+        const std::string& name, const std::filesystem::path& vsPath,
+        const std::filesystem::path& fsPath,
+        ghoul::Dictionary data = ghoul::Dictionary());
+
+    std::unique_ptr<ghoul::opengl::ProgramObject> buildCachedProgram(
+        const std::string& name, const std::filesystem::path& vsPath,
+        const std::filesystem::path& fsPath, const std::filesystem::path& gsPath,
+        ghoul::Dictionary data = ghoul::Dictionary());
+
     void removeRenderProgram(ghoul::opengl::ProgramObject* program);
 
     /**
@@ -177,6 +220,10 @@ private:
     ScreenLog* _log = nullptr;
 
     ghoul::opengl::OpenGLStateCache* _openglStateCache = nullptr;
+    UploadScheduler _uploadScheduler;
+    GpuTimerPool _gpuTimerPool;
+    FrameCapture _frameCapture;
+    EclipseShadows _eclipseShadows;
 
     properties::BoolProperty _showOverlayOnClients;
     properties::BoolProperty _showLog;
@@ -193,6 +240,13 @@ private:
     properties::BoolProperty _applyBlackoutToMaster;
 
     properties::BoolProperty _enableFXAA;
+    properties::BoolProperty _useDrawLists;
+    properties::BoolProperty _compactFramebufferFormats;
+
+    properties::BoolProperty _dynamicResolution;
+    properties::FloatProperty _targetFrameTime;
+    properties::FloatProperty _dynamicResolutionMinScale;
+    properties::FloatProperty _dynamicResolutionMaxScale;
 
     properties::BoolProperty _disableHDRPipeline;
     properties::FloatProperty _hdrExposure;
@@ -215,6 +269,14 @@ private:
 
     std::vector<ghoul::opengl::ProgramObject*> _programs;
 
+    struct ProgramBinary {
+        unsigned int format = 0;
+        std::vector<std::byte> data;
+    };
+    /// The program binaries created in this session, keyed by their preprocessed shader
+    /// sources and graphics driver
+    std::unordered_map<std::string, ProgramBinary> _programBinaries;
+
     std::shared_ptr<ghoul::fontrendering::Font> _fontCameraInfo;
     std::shared_ptr<ghoul::fontrendering::Font> _fontVersionInfo;
     std::shared_ptr<ghoul::fontrendering::Font> _fontShutdown;
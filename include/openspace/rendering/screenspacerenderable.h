@@ -70,6 +70,20 @@ public:
     };
     virtual void render(const RenderData& renderData);
 
+    /**
+     * Starts a batch of screen space renderables that are rendered consecutively. Within
+     * a batch, renderables that use the default #render function and share the same
+     * program only activate the program and set the per-frame uniforms once. The batch
+     * has to be finished with a call to #endBatch before any other rendering happens.
+     */
+    static void beginBatch();
+
+    /**
+     * Finishes the batch that was started with #beginBatch and restores the OpenGL
+     * state.
+     */
+    static void endBatch();
+
     virtual bool initialize();
     virtual bool initializeGL();
     virtual bool deinitialize();
@@ -0,0 +1,81 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___SHAREDGEOMETRY___H__
+#define __OPENSPACE_CORE___SHAREDGEOMETRY___H__
+
+#include <ghoul/opengl/ghoul_gl.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace openspace {
+
+/**
+ * The OpenGL objects of a piece of geometry, a vertex array object together with its
+ * vertex and index buffers. The objects are created in the constructor and deleted in the
+ * destructor, so an object of this type must only be created and destroyed while an
+ * OpenGL context is active.
+ */
+struct GeometryBuffers {
+    GeometryBuffers();
+    ~GeometryBuffers();
+
+    GeometryBuffers(const GeometryBuffers&) = delete;
+    GeometryBuffers& operator=(const GeometryBuffers&) = delete;
+
+    GLuint vao = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+
+    /// The number of vertices, or indices if an index buffer is used, that are drawn
+    GLsizei count = 0;
+};
+
+/**
+ * Returns the geometry with the provided \p key, which is shared between everyone that
+ * requests the same key. If no geometry with the key exists, it is created by calling
+ * \p create. The geometry is destroyed as soon as the last reference to it is released.
+ *
+ * The key has to contain the type of geometry and every parameter that influences the
+ * contents of the buffers. To make it possible to share the geometry between objects of
+ * different sizes, the geometry should be created with normalized parameters, for example
+ * with a radius of 1, and be scaled to its actual size through the model matrix.
+ *
+ * This function must only be called from the main thread.
+ *
+ * \param key The key that uniquely identifies the geometry
+ * \param create The function that creates the geometry if it does not exist yet
+ * \return The shared geometry that belongs to the \p key
+ */
+template <typename T>
+std::shared_ptr<T> requestSharedGeometry(const std::string& key,
+    const std::function<std::unique_ptr<T>()>& create);
+
+} // namespace openspace
+
+#include "sharedgeometry.inl"
+
+#endif // __OPENSPACE_CORE___SHAREDGEOMETRY___H__
@@ -0,0 +1,50 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+namespace openspace {
+
+template <typename T>
+std::shared_ptr<T> requestSharedGeometry(const std::string& key,
+                                       const std::function<std::unique_ptr<T>()>& create)
+{
+    // Only weak references are kept so that the geometry is destroyed as soon as the
+    // last renderable that uses it has been deinitialized
+    static std::map<std::string, std::weak_ptr<T>> Geometries;
+
+    auto it = Geometries.find(key);
+    if (it != Geometries.end()) {
+        std::shared_ptr<T> geometry = it->second.lock();
+        if (geometry) {
+            return geometry;
+        }
+    }
+
+    std::erase_if(Geometries, [](const auto& p) { return p.second.expired(); });
+
+    std::shared_ptr<T> geometry = create();
+    Geometries[key] = geometry;
+    return geometry;
+}
+
+} // namespace openspace
@@ -27,12 +27,23 @@
 
 #include <ghoul/opengl/texture.h>
 #include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
 
 namespace ghoul::filesystem { class File; }
 namespace ghoul::opengl {class Texture; }
 
 namespace openspace {
 
+/**
+ * Loads a texture from a file and keeps it up to date if the file changes. Two
+ * dimensional images are decoded on a worker thread and are uploaded in #update once they
+ * are available. Until then, #texture returns a fully transparent placeholder texture, so
+ * that renderables can bind the texture right away and simply draw nothing. Textures
+ * that are loaded from the same file with the same settings are shared between all
+ * components.
+ */
 class TextureComponent {
 public:
     // nDimensions must be 1, 2, 3
@@ -41,6 +52,13 @@ public:
     const ghoul::opengl::Texture* texture() const;
     ghoul::opengl::Texture* texture();
 
+    /**
+     * Returns `true` if the texture that was requested by the last call to #loadFromFile
+     * has been loaded and uploaded, or `false` if #texture still returns a placeholder or
+     * the previously loaded texture.
+     */
+    bool isReady() const;
+
     void setFilterMode(ghoul::opengl::Texture::FilterMode filterMode);
     void setWrapping(ghoul::opengl::Texture::WrappingMode wrapping);
     void setShouldWatchFileForChanges(bool value);
@@ -49,7 +67,8 @@ public:
     void bind();
     void uploadToGpu();
 
-    // Loads a texture from a file on disk
+    // Loads a texture from a file on disk. Two dimensional images are decoded
+    // asynchronously and are only available after a later call to #update
     void loadFromFile(const std::filesystem::path& path);
 
     // Function to call in a renderable's update function to make sure
@@ -57,8 +76,28 @@ public:
     void update();
 
 private:
+    struct DecodedImage;
+    using DecodingFuture = std::shared_future<std::shared_ptr<const DecodedImage>>;
+
+    /// Decodes the image on disk, returns `nullptr` if the file could not be decoded
+    static std::shared_ptr<const DecodedImage> decodeImage(std::filesystem::path path);
+
+    /// The images that are currently decoded, indexed by their absolute path
+    static std::map<std::filesystem::path, DecodingFuture>& decodings();
+
+    void watchFile(const std::filesystem::path& path);
+    void loadFromFileSynchronously(const std::filesystem::path& path);
+    void finishDecoding();
+    void createPlaceholder();
+
     std::unique_ptr<ghoul::filesystem::File> _textureFile;
-    std::unique_ptr<ghoul::opengl::Texture> _texture;
+    std::shared_ptr<ghoul::opengl::Texture> _texture;
+
+    /// The decoding of the image that was requested last. This might be shared with
+    /// other components that requested the same file
+    DecodingFuture _decoding;
+    /// The absolute path of the file that was requested last
+    std::filesystem::path _path;
 
     ghoul::opengl::Texture::FilterMode _filterMode =
         ghoul::opengl::Texture::FilterMode::LinearMipMap;
@@ -70,6 +109,7 @@ private:
 
     bool _fileIsDirty = false;
     bool _textureIsDirty = false;
+    bool _isPlaceholder = false;
 
     const int _nDimensions;
 };
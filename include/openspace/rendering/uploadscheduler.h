@@ -0,0 +1,178 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___UPLOADSCHEDULER___H__
+#define __OPENSPACE_CORE___UPLOADSCHEDULER___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+/**
+ * The UploadScheduler is responsible for distributing texture uploads across multiple
+ * frames. Components that have a large number of uploads that are not time critical,
+ * such as the tiles of globes, should check whether there is remaining budget using the
+ * #hasBudget function before performing an upload and postpone the upload to a later
+ * frame otherwise. The budget is defined by a maximum number of bytes and a maximum
+ * time that can be spent uploading in a single frame. The first upload in each frame is
+ * always permitted to guarantee progress.
+ *
+ * If the OpenGL context supports it, the data is copied into a ring of persistently
+ * mapped pixel buffer objects from which the texture is updated. This way, the driver
+ * can transfer the data asynchronously without the CPU needing to wait for the GPU.
+ */
+class UploadScheduler : public properties::PropertyOwner {
+public:
+    UploadScheduler();
+
+    void initializeGL();
+    void deinitializeGL();
+
+    /**
+     * Resets the budget for the next frame. This function has to be called exactly once
+     * at the end of each frame.
+     */
+    void resetBudget();
+
+    /**
+     * Returns `true` if another upload can be performed in the current frame without
+     * exceeding the budget.
+     */
+    bool hasBudget() const;
+
+    /**
+     * Returns the total number of bytes that have been uploaded through this scheduler
+     * since the application started.
+     */
+    uint64_t totalUploadedBytes() const;
+
+    /**
+     * Uploads the pixel data of the \p texture to the already existing texture on the
+     * GPU. This function has the same effect as calling
+     * `ghoul::opengl::Texture::reUploadTexture`, but uses the pixel buffer ring if
+     * possible and records the number of uploaded bytes for the budget.
+     *
+     * \param texture The texture whose pixel data should be uploaded
+     *
+     * \pre \p texture must have pixel data
+     */
+    void uploadTexture(ghoul::opengl::Texture& texture);
+
+    /**
+     * Uploads block compressed data to all mip levels of the \p texture, whose storage
+     * must already have been allocated with the \p internalFormat. The \p data contains
+     * the mip levels one after another, starting with the full resolution level, with
+     * the sizes in bytes provided in \p levelSizes. As with #uploadTexture, the pixel
+     * buffer ring is used if possible and the number of bytes is recorded for the
+     * budget.
+     *
+     * \param texture The texture into which the compressed data is uploaded
+     * \param internalFormat The compressed OpenGL format of the \p data
+     * \param data The compressed data of all mip levels
+     * \param levelSizes The number of bytes of each mip level in the \p data
+     *
+     * \pre \p data must not be `nullptr`
+     * \pre \p levelSizes must not be empty
+     */
+    void uploadCompressedTexture(ghoul::opengl::Texture& texture, GLenum internalFormat,
+        const std::byte* data, const std::vector<size_t>& levelSizes);
+
+    /**
+     * Uploads the \p data of \p depth consecutive slices, starting at slice \p zOffset,
+     * into the already existing storage of the three-dimensional \p texture. This makes
+     * it possible to upload large volumes in pieces over multiple frames. As with
+     * #uploadTexture, the pixel buffer ring is used if possible and the number of bytes
+     * is recorded for the budget.
+     *
+     * \param texture The 3D texture into which the slices are uploaded
+     * \param zOffset The index of the first slice that is uploaded
+     * \param depth The number of slices that are uploaded
+     * \param data The pixel data of the slices in the format and data type of the
+     *        \p texture
+     * \param size The number of bytes in \p data
+     *
+     * \pre \p data must not be `nullptr`
+     * \pre \p zOffset + \p depth must not be larger than the depth of the \p texture
+     */
+    void uploadTextureSlices(ghoul::opengl::Texture& texture, unsigned int zOffset,
+        unsigned int depth, const std::byte* data, size_t size);
+
+    /**
+     * Executes the \p upload function, which uploads data to the GPU in a way that is
+     * not covered by the other functions, for example when a library creates its own
+     * buffers, and records the upload for the budget. As the scheduler can't know how
+     * much data the function uploads, the approximate number of bytes has to be
+     * provided by the caller.
+     *
+     * \param upload The function that performs the upload
+     * \param size The approximate number of bytes that are uploaded by \p upload
+     */
+    void uploadExternal(const std::function<void()>& upload, size_t size);
+
+private:
+    static constexpr int NSegments = 4;
+
+    struct Segment {
+        GLuint pbo = 0;
+        void* mappedData = nullptr;
+        GLsync fence = nullptr;
+    };
+
+    /**
+     * Returns the next segment of the pixel buffer ring after the GPU has finished
+     * reading from it, or `nullptr` if the ring is not used or if \p size does not fit
+     * into a single segment.
+     */
+    Segment* acquireSegment(size_t size);
+    std::array<Segment, NSegments> _ring;
+    int _nextSegment = 0;
+    bool _isUsingPersistentMapping = false;
+
+    int _nUploadsThisFrame = 0;
+    size_t _nBytesThisFrame = 0;
+    uint64_t _nTotalBytes = 0;
+    std::chrono::nanoseconds _timeThisFrame = std::chrono::nanoseconds(0);
+
+    properties::IntProperty _byteBudget;
+    properties::FloatProperty _timeBudget;
+    properties::IntProperty _ringSegmentSize;
+    properties::IntProperty _uploadedBytes;
+    properties::IntProperty _nUploads;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___UPLOADSCHEDULER___H__
@@ -136,12 +136,27 @@ public:
 
     float downscaleRender() const;
 
+    /**
+     * Sets the GPU time in milliseconds that the raycasting of this volume should take
+     * per frame. If the time is larger than 0, the renderer measures the raycasting time
+     * and adapts the resolution of the volume between a quarter and the full resolution
+     * to meet it, in which case the fixed downscale factor is not used. While the camera
+     * is still, the resolution is refined towards the full resolution regardless of the
+     * time. A value of 0 disables the adaptive resolution.
+     */
+    void setTargetRaycastTime(float milliseconds);
+
+    float targetRaycastTime() const;
+
 private:
     /// Maximum number of integration steps to be executed by the volume integrator
     int _rayCastMaxSteps = 1000;
 
     /// Enable and set the downscale rendering of the volume. Used to improve performance
     float _downscaleRenderConst = 1.f;
+
+    /// The GPU time in milliseconds that the adaptive resolution aims for, or 0
+    float _targetRaycastTime = 0.f;
 };
 
 } // namespace openspace
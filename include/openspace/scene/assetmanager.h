@@ -27,9 +27,13 @@
 
 #include <ghoul/lua/luastate.h>
 #include <filesystem>
+#include <future>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <list>
+#include <vector>
 
 namespace openspace {
 
@@ -44,7 +48,10 @@ class ResourceSynchronization;
  * where first the intent of an action is registered, which is then executed in the next
  * call to the #update function.
  *
- * All assets are loading through the same Lua state.
+ * All assets are loading through the same Lua state. Before the queued assets are loaded,
+ * their files and the files of all assets they require are read and compiled on the
+ * global ThreadPool, so that only the execution of the compiled chunks has to happen
+ * serially in the shared Lua state.
  */
 class AssetManager {
 public:
@@ -83,6 +90,18 @@ public:
      */
     void update();
 
+    /**
+     * Sets whether the root assets that are loaded in the #update function should start
+     * their ResourceSynchronizations right away, which is the default. If this is
+     * disabled, the assets are only loaded and the synchronizations can be retrieved
+     * through #allSynchronizations and started by the caller instead, for example to
+     * limit the number of simultaneous downloads. As the assets never become
+     * synchronized in that case, they are never initialized either.
+     *
+     * \param enabled Whether synchronizations are started automatically
+     */
+    void setAutomaticSynchronization(bool enabled);
+
     static scripting::LuaLibrary luaLibrary();
 
     /**
@@ -102,6 +121,7 @@ public:
     std::vector<const Asset*> rootAssets() const;
 
     std::vector<const ResourceSynchronization*> allSynchronizations() const;
+    std::vector<ResourceSynchronization*> allSynchronizations();
 
     /**
      * Returns whether the provided \p asset has been loaded directly by the user or
@@ -180,6 +200,31 @@ private:
     std::filesystem::path generateAssetPath(const std::filesystem::path& baseDirectory,
         const std::string& assetPath) const;
 
+    /// The contents of an asset file that were read and compiled ahead of time
+    struct PrefetchedAsset {
+        std::string source;
+        /// The compiled chunk or an empty string if the source failed to compile
+        std::string bytecode;
+    };
+
+    /**
+     * Reads and compiles the asset file at the provided \p path on the global ThreadPool
+     * unless that has already been requested. Once the file has been read, all assets
+     * that it requires with a literal path are prefetched as well.
+     */
+    void prefetchAsset(std::filesystem::path path);
+
+    /**
+     * Returns the prefetched contents of the asset file at the provided \p path and
+     * removes them from the list of prefetched assets. If the prefetch has not been
+     * started or has not finished yet, `std::nullopt` is returned and the caller has to
+     * load the file itself instead of waiting.
+     */
+    std::optional<PrefetchedAsset> takePrefetchedAsset(const std::filesystem::path& path);
+
+    /// Waits until all prefetches, including the ones they started, have finished
+    void waitForPrefetches();
+
     //
     // Assets
     //
@@ -220,6 +265,9 @@ private:
     /// call
     std::vector<SyncItem*> _unfinishedSynchronizations;
 
+    /// Whether newly loaded root assets start their synchronizations in #update
+    bool _automaticSynchronization = true;
+
     //
     // Other values
     //
@@ -235,6 +283,11 @@ private:
     std::unordered_map<Asset*, std::vector<int>> _onDeinitializeFunctionRefs;
 
     int _assetsTableRef = 0;
+
+    /// Protects the #_prefetchedAssets, which are also accessed from the worker threads
+    std::mutex _prefetchMutex;
+    std::unordered_map<std::string, std::shared_future<PrefetchedAsset>>
+        _prefetchedAssets;
 };
 
 } // namespace openspace
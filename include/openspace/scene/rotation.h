@@ -49,9 +49,26 @@ public:
     virtual bool initialize();
 
     const glm::dmat3& matrix() const;
+
+    /**
+     * Returns whether the matrix has changed during the last call to the #update
+     * function. The value is `false` if the matrix is the same as in the previous update
+     * or if no update took place.
+     */
+    bool hasChanged() const;
+
     virtual glm::dmat3 matrix(const UpdateData& time) const = 0;
     virtual void update(const UpdateData& data);
 
+    /**
+     * Returns whether the matrix of this Rotation can be evaluated on a worker thread
+     * concurrently with other scene graph nodes. This is only the case if the
+     * implementation does not access any unsynchronized shared state, such as a Lua
+     * state, in its update step. The SpiceManager serializes its accesses and can be
+     * used. The default is `false`.
+     */
+    virtual bool supportsParallelUpdate() const;
+
     static documentation::Documentation Documentation();
 
 protected:
@@ -59,6 +76,7 @@ protected:
 
 private:
     bool _needsUpdate = true;
+    bool _hasChanged = false;
     double _cachedTime = -std::numeric_limits<double>::max();
     glm::dmat3 _cachedMatrix = glm::dmat3(1.0);
 };
@@ -49,9 +49,26 @@ public:
     virtual bool initialize();
 
     glm::dvec3 scaleValue() const;
+
+    /**
+     * Returns whether the scale value has changed during the last call to the #update
+     * function. The value is `false` if the scale is the same as in the previous update
+     * or if no update took place.
+     */
+    bool hasChanged() const;
+
     virtual glm::dvec3 scaleValue(const UpdateData& data) const = 0;
     virtual void update(const UpdateData& data);
 
+    /**
+     * Returns whether the scale value of this Scale can be evaluated on a worker thread
+     * concurrently with other scene graph nodes. This is only the case if the
+     * implementation does not access any unsynchronized shared state, such as a Lua
+     * state, in its update step. The SpiceManager serializes its accesses and can be
+     * used. The default is `false`.
+     */
+    virtual bool supportsParallelUpdate() const;
+
     static documentation::Documentation Documentation();
 
 protected:
@@ -59,6 +76,7 @@ protected:
 
 private:
     bool _needsUpdate = true;
+    bool _hasChanged = false;
     double _cachedTime = -std::numeric_limits<double>::max();
     glm::dvec3 _cachedScale = glm::dvec3(1.0);
 };
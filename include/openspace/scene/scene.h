@@ -27,6 +27,7 @@
 
 #include <openspace/properties/propertyowner.h>
 
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/scene/profile.h>
 #include <openspace/scene/scenegraphnode.h>
 #include <openspace/scripting/scriptengine.h>
@@ -34,7 +35,9 @@
 #include <ghoul/misc/easing.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/memorypool.h>
+#include <array>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <set>
 #include <unordered_map>
@@ -58,6 +61,8 @@ enum class PropertyValueType {
 using ProfilePropertyLua = std::variant<bool, float, std::string, ghoul::lua::nil_t>;
 
 class SceneInitializer;
+class ThreadPool;
+struct CameraSnapshot;
 
 // Notifications:
 // SceneGraphFinishedLoading
@@ -103,10 +108,43 @@ public:
     Camera* camera() const;
 
     /**
-     * Updates all SceneGraphNodes relative positions.
+     * Updates all SceneGraphNodes relative positions. If the parallel update is enabled,
+     * all nodes of the same dependency level that support it are updated concurrently on
+     * a pool of worker threads.
      */
     void update(const UpdateData& data);
 
+    /**
+     * If the pipelined update is enabled, starts computing the world transforms of all
+     * SceneGraphNodes for the UpdateData of the last #update on a worker thread. These
+     * transforms are used starting with the next frame, which means that the rendering
+     * of the current frame can overlap with this computation at the expense of one frame
+     * of latency for all transforms. Only nodes whose transformations support a parallel
+     * update, and whose parent and dependencies do so as well, are part of this step;
+     * all other nodes are updated in #update as before. Note that such a node still
+     * inherits the one frame of latency from a parent that is part of this step, as its
+     * world transform is computed from the parent's transform. This function has to be
+     * called after everything that might change the scene in the current frame has
+     * happened and #finishPipelinedUpdate has to be called before anything changes it
+     * again.
+     */
+    void startPipelinedUpdate();
+
+    /**
+     * Waits for the computation that was started in #startPipelinedUpdate to finish. It
+     * is safe to call this function if no computation is running.
+     */
+    void finishPipelinedUpdate();
+
+    /**
+     * Tests the bounding spheres of all SceneGraphNodes against the view frustum of the
+     * \p camera and determines which nodes have to be rendered into each render bin.
+     * Subsequent calls to #render in the same frame only visit those nodes. This has to
+     * be called again for every camera that is rendered and does nothing if frustum
+     * culling is disabled.
+     */
+    void cullNodes(const CameraSnapshot& camera);
+
     /**
      * Render visible SceneGraphNodes using the provided camera.
      */
@@ -168,6 +206,14 @@ public:
      */
     bool isInitializing() const;
 
+    /**
+     * Calls `initializeGL` on all scene graph nodes whose initialization has finished
+     * since the last call to this function. This is called as part of #update, but can
+     * also be called while the scene is still initializing to overlap the OpenGL
+     * initialization of some nodes with the initialization of the remaining ones.
+     */
+    void initializeGLOfInitializedNodes();
+
     /**
      * Adds an interpolation request for the passed \p prop that will run for
      * \p durationSeconds seconds. Every time the #updateInterpolations method is called
@@ -226,7 +272,9 @@ public:
      * Sets a property using the 'properties' contents of a profile. The function will
      * loop through each setProperty command. A property may be set to a bool, float, or
      * string value (which must be converted because a Profile stores all values as
-     * strings).
+     * strings). The URIs of all commands are matched against the property tree in a
+     * single pass and if multiple commands set the same property, only the last one is
+     * applied to it.
      *
      * \param p The Profile to be read.
      */
@@ -234,14 +282,17 @@ public:
 
     /**
      * Searches for any properties that match the regex propertyString, and returns
-     * the results in a vector.
+     * the results in a vector. The results of wildcard and tag searches are cached until
+     * the property tree changes, so repeated searches for the same pattern are cheap.
      *
      * \param propertyString The regex string that is intended to match one or more
      *        properties in the currently-available properties
+     * \param groupName If this is not empty, only properties that have an owner with
+     *        this tag are matched
      * \return Vector of Property objs containing property names that matched the regex
      */
     std::vector<properties::Property*> propertiesMatchingRegex(
-        std::string_view propertyString);
+        std::string_view propertyString, const std::string& groupName = "");
 
     /**
      * Returns a list of all unique tags that are used in the currently loaded scene.
@@ -326,16 +377,49 @@ private:
     void updateNodeRegistry();
     void sortTopologically();
 
+    /**
+     * Updates the \p nodes, potentially using the worker threads. All nodes in the list
+     * must only depend on nodes that have already been updated in this frame.
+     */
+    void updateLevel(const std::vector<SceneGraphNode*>& nodes, const UpdateData& data);
+
     std::unique_ptr<Camera> _camera;
     std::vector<SceneGraphNode*> _topologicallySortedNodes;
     std::vector<SceneGraphNode*> _circularNodes;
+    // The topologically sorted nodes grouped by the length of the longest path to the
+    // root node. All nodes in a level only depend on nodes in lower levels
+    std::vector<std::vector<SceneGraphNode*>> _dependencyLevels;
     std::unordered_map<std::string, SceneGraphNode*> _nodesByIdentifier;
     bool _dirtyNodeRegistry = false;
     SceneGraphNode _rootNode;
     std::unique_ptr<SceneInitializer> _initializer;
+
+    properties::BoolProperty _parallelUpdate;
+    std::unique_ptr<ThreadPool> _updateThreadPool;
+
+    properties::BoolProperty _pipelinedUpdate;
+    // The nodes, in topological order, whose transforms are computed in the pipelined
+    // update. The parent and all dependencies of each node are part of this list as well
+    std::vector<SceneGraphNode*> _pipelinedNodes;
+    std::unique_ptr<UpdateData> _pipelinedUpdateData;
+    std::future<void> _pipelinedUpdateResult;
+
+    properties::BoolProperty _frustumCulling;
+    // The nodes that passed the last culling step for each render bin, indexed by the
+    // position of the bin's bit in the Renderable::RenderBin mask
+    std::array<std::vector<SceneGraphNode*>, 6> _renderBinNodes;
+    bool _hasRenderBinNodes = false;
     std::string _profilePropertyName;
     bool _valueIsTable = false;
 
+    // Results of previous propertiesMatchingRegex searches, keyed by the pattern. The
+    // cache is cleared whenever the structure generation of the property tree changes
+    static constexpr size_t MaxPropertyMatchCacheSize = 4096;
+    std::mutex _propertyMatchCacheMutex;
+    uint64_t _propertyMatchCacheGeneration = 0;
+    std::unordered_map<std::string, std::vector<properties::Property*>>
+        _propertyMatchCache;
+
     std::mutex _programUpdateLock;
     std::set<ghoul::opengl::ProgramObject*> _programsToUpdate;
     std::vector<std::unique_ptr<ghoul::opengl::ProgramObject>> _programs;
@@ -349,6 +433,7 @@ private:
         ghoul::EasingFunc<float> easingFunction;
         bool isExpired = false;
     };
+    /// Interpolations that were added at the same time are kept next to each other
     std::vector<PropertyInterpolationInfo> _propertyInterpolationInfos;
 
     ghoul::MemoryPool<4096> _memoryPool;
@@ -35,10 +35,12 @@
 #include <ghoul/glm.h>
 #include <ghoul/misc/boolean.h>
 #include <ghoul/misc/managedmemoryuniqueptr.h>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -73,13 +75,20 @@ public:
     };
 
     BooleanType(UpdateScene);
+    BooleanType(CreateDefaultTransform);
 
     static constexpr std::string_view KeyIdentifier = "Identifier";
     static constexpr std::string_view KeyParentName = "Parent";
     static constexpr std::string_view KeyDependencies = "Dependencies";
     static constexpr std::string_view KeyTag = "Tag";
 
-    SceneGraphNode();
+    /**
+     * Creates an empty SceneGraphNode. If \p createDefaultTransform is `Yes`, the node
+     * receives a static translation, rotation, and scale. Otherwise, the transform
+     * components have to be set before the node is used.
+     */
+    explicit SceneGraphNode(
+        CreateDefaultTransform createDefaultTransform = CreateDefaultTransform::Yes);
     virtual ~SceneGraphNode() override;
 
     static ghoul::mm_unique_ptr<SceneGraphNode> createFromDictionary(
@@ -90,9 +99,62 @@ public:
     void deinitialize();
     void deinitializeGL();
 
+    /**
+     * Updates the world transform of this node and then its Renderable. This is the same
+     * as calling #updateTransform, #publishTransform, and #updateRenderable in order.
+     */
     void update(const UpdateData& data);
+
+    /**
+     * Computes the world transform and the time frame state of this node for \p data
+     * without changing any of the values that are visible from the outside, which only
+     * happens in #publishTransform. The parent and dependencies of this node must have
+     * been passed to this function for the same \p data before.
+     */
+    void updateTransform(const UpdateData& data);
+
+    /**
+     * Returns `true` if #updateTransform has computed a new world transform since the
+     * last call to #publishTransform.
+     */
+    bool hasCurrentTransform() const;
+
+    /**
+     * Makes the world transform that was last computed by #updateTransform the one that
+     * is returned by the accessors of this node and used for rendering.
+     */
+    void publishTransform();
+
+    /**
+     * Updates the Renderable of this node, if there is one, based on the world transform
+     * that was last published.
+     */
+    void updateRenderable(const UpdateData& data);
+
+    /**
+     * Returns whether this node can be updated on a worker thread, that is if all of its
+     * transformation components and its Renderable (if present) report that their update
+     * steps are safe to be executed concurrently with other nodes.
+     */
+    bool supportsParallelUpdate() const;
+
+    /**
+     * Returns whether all transformation components of this node report that their update
+     * steps are safe to be executed concurrently with other nodes.
+     */
+    bool supportsParallelTransformUpdate() const;
     void render(const RenderData& data, RendererTasks& tasks);
 
+    /**
+     * Returns the render bins, as a bitmask of Renderable::RenderBin values, that this
+     * node would render into in the current frame for a camera whose view frustum is
+     * described by the four side planes \p frustumPlanes in world space. The planes'
+     * normals have to be normalized and point into the frustum. A node that would not
+     * render anything or whose bounding sphere lies entirely outside of the frustum
+     * returns 0. Nodes that do not have a bounding sphere are never culled.
+     */
+    int visibleRenderBins(const std::array<glm::dvec4, 4>& frustumPlanes) const;
+
     void attachChild(ghoul::mm_unique_ptr<SceneGraphNode> child);
     ghoul::mm_unique_ptr<SceneGraphNode> detachChild(SceneGraphNode& child);
     void clearChildren();
@@ -103,8 +165,16 @@ public:
     void clearDependencies();
     void setDependencies(const std::vector<SceneGraphNode*>& dependencies);
 
+    /**
+     * Returns the SurfacePositionHandle for the provided \p targetModelSpace position.
+     * The most recent result is cached until the next call to #update, so repeated
+     * queries for the same position within a frame only reach into the renderable once.
+     * If \p directionTolerance is larger than 0, the most recent result, even from a
+     * previous frame, is also returned for a target whose direction from the center of
+     * this node differs by less than that angle (in radians).
+     */
     SurfacePositionHandle calculateSurfacePositionHandle(
-        const glm::dvec3& targetModelSpace) const;
+        const glm::dvec3& targetModelSpace, double directionTolerance = 0.0) const;
 
     const std::vector<SceneGraphNode*>& dependencies() const;
     const std::vector<SceneGraphNode*>& dependentNodes() const;
@@ -122,6 +192,13 @@ public:
     glm::dvec3 worldScale() const;
     bool isTimeFrameActive(const Time& time) const;
 
+    /**
+     * Returns whether the time frames of this node, its parent, and its dependencies
+     * were active at the simulation time of the last #update. This is cheaper than
+     * evaluating the time frames for a specific time.
+     */
+    bool isTimeFrameActive() const;
+
     SceneGraphNode* parent() const;
     std::vector<SceneGraphNode*> children() const;
 
@@ -192,6 +269,19 @@ private:
 
     ghoul::mm_unique_ptr<TimeFrame> _timeFrame;
 
+    // The world transform as computed by updateTransform. It is only used for the
+    // computations of this node and its children until it is published to the cached
+    // values below, which are the ones used everywhere else
+    struct WorldTransform {
+        glm::dvec3 position = glm::dvec3(0.0);
+        glm::dmat3 rotation = glm::dmat3(1.0);
+        glm::dvec3 scale = glm::dvec3(1.0);
+        glm::dmat4 modelTransform = glm::dmat4(1.0);
+        bool isTimeFrameActive = true;
+        bool isCurrent = false;
+    };
+    WorldTransform _nextWorldTransform;
+
     // Cached transform data
     glm::dvec3 _worldPositionCached = glm::dvec3(0.0);
     glm::dmat3 _worldRotationCached = glm::dmat3(1.0);
@@ -199,6 +289,19 @@ private:
 
     glm::dmat4 _modelTransformCached = glm::dmat4(1.0);
 
+    // If this is 'true', the cached world transform has to be recomputed in the next
+    // update regardless of whether the transformation components have changed, for
+    // example after the node was attached to a new parent
+    bool _isWorldTransformDirty = true;
+    /// Whether the time frames were active at the time of the last update
+    bool _isTimeFrameActive = true;
+    // Is 'true' if the cached world transform was changed in the last update. Children
+    // use this to determine whether they have to recompute their own world transform
+    bool _hasWorldTransformChanged = true;
+    // Is 'true' if the renderable was drawn since the last update. This is used by the
+    // renderable's UpdatePolicy to skip updates while it is culled
+    bool _wasRenderedSinceUpdate = true;
+
     properties::DoubleProperty _boundingSphere;
     properties::DoubleProperty _evaluatedBoundingSphere;
     properties::DoubleProperty _interactionSphere;
@@ -218,8 +321,24 @@ private:
     std::chrono::high_resolution_clock::time_point _lastScreenSpaceUpdateTime;
 
     properties::BoolProperty _showDebugSphere;
+    properties::FloatProperty _gpuTime;
     static ghoul::opengl::ProgramObject* _debugSphereProgram;
 
+    // The most recently computed surface position handle. Access is guarded by the mutex
+    // as globe-attached transformations query other nodes during parallel updates
+    struct SurfaceHandleCache {
+        glm::dvec3 target = glm::dvec3(0.0);
+        glm::dvec3 direction = glm::dvec3(0.0);
+        // The components of the SurfacePositionHandle, which is only forward declared
+        glm::dvec3 centerToReferenceSurface = glm::dvec3(0.0);
+        glm::dvec3 referenceSurfaceOutDirection = glm::dvec3(0.0);
+        double heightToSurface = 0.0;
+        // 'false' if the node has been updated since the handle was computed
+        bool isCurrent = true;
+    };
+    mutable std::optional<SurfaceHandleCache> _surfaceHandleCache;
+    mutable std::mutex _surfaceHandleCacheMutex;
+
     std::optional<double> _overrideBoundingSphere;
     std::optional<double> _overrideInteractionSphere;
 
@@ -25,7 +25,8 @@
 #ifndef __OPENSPACE_CORE___SCENEINITIALIZER___H__
 #define __OPENSPACE_CORE___SCENEINITIALIZER___H__
 
-#include <openspace/util/threadpool.h>
+#include <condition_variable>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -51,9 +52,18 @@ private:
     std::vector<SceneGraphNode*> _initializedNodes;
 };
 
+/**
+ * Initializes the scene graph nodes on the shared global thread pool. Each node is added
+ * to the list returned by #takeInitializedNodes as soon as its initialization has
+ * finished, so that the OpenGL initialization of the nodes that are done can overlap
+ * with the initialization of the remaining nodes.
+ */
 class MultiThreadedSceneInitializer final : public SceneInitializer {
 public:
-    MultiThreadedSceneInitializer(unsigned int nThreads);
+    /**
+     * Waits for all nodes whose initialization has already started to finish.
+     */
+    ~MultiThreadedSceneInitializer() override;
 
     void initializeNode(SceneGraphNode* node) override;
     std::vector<SceneGraphNode*> takeInitializedNodes() override;
@@ -62,8 +72,8 @@ public:
 private:
     std::vector<SceneGraphNode*> _initializedNodes;
     std::unordered_set<SceneGraphNode*> _initializingNodes;
-    ThreadPool _threadPool;
     mutable std::mutex _mutex;
+    std::condition_variable _initializingNodesEmpty;
 };
 
 } // namespace openspace
@@ -29,6 +29,8 @@
 
 #include <ghoul/glm.h>
 #include <ghoul/misc/managedmemoryuniqueptr.h>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace ghoul { class Dictionary; }
@@ -41,6 +43,18 @@ namespace documentation { struct Documentation; }
 
 class TimeFrame : public properties::PropertyOwner {
 public:
+    /**
+     * Whether a time frame is active at a specific time, together with the range of
+     * times around it in which it is known to stay the same.
+     */
+    struct Activity {
+        bool isActive = false;
+        /// The earliest time at which the activity is known to be the same (inclusive)
+        double validFrom = 0.0;
+        /// The earliest time at which the activity might change (exclusive)
+        double validUntil = 0.0;
+    };
+
     static ghoul::mm_unique_ptr<TimeFrame> createFromDictionary(
         const ghoul::Dictionary& dictionary);
 
@@ -51,7 +65,45 @@ public:
 
     virtual bool isActive(const Time& time) const = 0;
 
+    /**
+     * Returns whether this time frame is active at the provided \p time together with
+     * the range of times in which this stays the same. The default implementation calls
+     * #isActive and returns an empty range, which means that the result is not known to
+     * be valid for any other time. Subclasses that know when they change should override
+     * this function.
+     *
+     * \param time The time, in seconds past the J2000 epoch, that should be tested
+     * \return The activity at the provided \p time
+     */
+    virtual Activity activity(double time) const;
+
+    /**
+     * Returns the same value as #isActive, but caches the result of #activity, so that
+     * this only requires a comparison as long as \p time is in the same range as the
+     * last time this function was called. This function must not be called concurrently
+     * for the same object.
+     *
+     * \param time The time that should be tested
+     * \return `true` if this time frame is active at the provided \p time
+     */
+    bool isActiveCached(const Time& time) const;
+
     static documentation::Documentation Documentation();
+
+protected:
+    /**
+     * Invalidates the cached activity of all time frames. Has to be called whenever a
+     * property of a time frame changes that influences the result of #isActive, which
+     * also includes time frames that are contained in other time frames.
+     */
+    static void invalidateCaches();
+
+private:
+    /// Incremented every time the cached activity of all time frames becomes invalid
+    static std::atomic<uint64_t> _cacheGeneration;
+
+    mutable Activity _cachedActivity;
+    mutable uint64_t _cachedGeneration = 0;
 };
 
 }  // namespace openspace
@@ -29,7 +29,10 @@
 
 #include <ghoul/glm.h>
 #include <ghoul/misc/managedmemoryuniqueptr.h>
+#include <filesystem>
 #include <functional>
+#include <span>
+#include <vector>
 
 namespace ghoul { class Dictionary; }
 
@@ -51,8 +54,62 @@ public:
     virtual void update(const UpdateData& data);
     glm::dvec3 position() const;
 
+    /**
+     * Returns whether the position has changed during the last call to the #update
+     * function. The value is `false` if the position is the same as in the previous
+     * update or if no update took place.
+     */
+    bool hasChanged() const;
+
     virtual glm::dvec3 position(const UpdateData& data) const = 0;
 
+    /**
+     * Computes the positions of this Translation for all of the provided \p times and
+     * writes them into \p result. This is equivalent to calling #position once for each
+     * time, but subclasses can override it to share work between the samples, which is
+     * useful for components such as trails that sample a large number of times at once.
+     *
+     * \param times The times, in seconds past J2000, for which to compute the positions
+     * \param result The computed positions in the same order as the \p times
+     *
+     * \pre \p result must have the same size as \p times
+     */
+    virtual void positions(std::span<const double> times,
+        std::span<glm::dvec3> result) const;
+
+    /// A function with the same behavior as #positions
+    using PositionsFunction =
+        std::function<void(std::span<const double>, std::span<glm::dvec3>)>;
+
+    /**
+     * Returns a function that computes the same positions as #positions, but from a
+     * snapshot of the current parameters of this Translation. The returned function does
+     * not access this object and can be called from a worker thread while this
+     * Translation is evaluated and changed on the main thread. Parameter changes that
+     * happen after this call do not affect the function. The default implementation
+     * returns an empty function, which means that this Translation can only be evaluated
+     * on the main thread.
+     */
+    virtual PositionsFunction positionsSnapshot() const;
+
+    /**
+     * Returns the files from which the positions of this Translation are computed.
+     * Components that cache positions across runs, such as trails, use the sizes and
+     * modification times of these files to detect changes to the data. The default
+     * implementation returns no files.
+     */
+    virtual std::vector<std::filesystem::path> sourceFiles() const;
+
+    /**
+     * Returns whether the position of this Translation can be evaluated on a worker
+     * thread concurrently with other scene graph nodes. This is only the case if the
+     * implementation does not access any unsynchronized shared state, such as a Lua
+     * state, in its update step. The SpiceManager serializes its accesses and can be
+     * used. The default is `false`. Note that this does not mean that the same instance
+     * can be evaluated from multiple threads at once; see #positionsSnapshot for that.
+     */
+    virtual bool supportsParallelUpdate() const;
+
     // Registers a callback that gets called when a significant change has been made that
     // invalidates potentially stored points, for example in trails
     void onParameterChange(std::function<void()> callback);
@@ -65,6 +122,7 @@ protected:
 
 private:
     bool _needsUpdate = true;
+    bool _hasChanged = false;
     double _cachedTime = -std::numeric_limits<double>::max();
     glm::dvec3 _cachedPosition = glm::dvec3(0.0);
     std::function<void()> _onParameterChangeCallback;
@@ -27,13 +27,17 @@
 
 #include <openspace/util/syncable.h>
 #include <openspace/scripting/lualibrary.h>
+#include <openspace/util/prefixtrie.h>
 #include <ghoul/lua/luastate.h>
 #include <ghoul/misc/boolean.h>
 #include <filesystem>
+#include <list>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <functional>
+#include <string_view>
+#include <unordered_map>
 
 namespace openspace { class SyncBuffer; }
 
@@ -118,6 +122,14 @@ public:
     std::vector<std::string> allLuaFunctions() const;
     const std::vector<LuaLibrary>& allLuaLibraries() const;
 
+    /**
+     * Returns an index of the full names of all Lua functions that are returned by
+     * #allLuaFunctions. The index is updated whenever a library is added or registered,
+     * which makes it possible to look up functions by their prefix without having to
+     * step through all of the libraries.
+     */
+    const PrefixTrie& luaFunctionIndex() const;
+
 private:
     BooleanType(Replace);
 
@@ -132,8 +144,23 @@ private:
 
     bool runScript(const Script& script);
 
+    /**
+     * Executes the provided \p code in the internal Lua state. Short scripts are only
+     * compiled the first time they are executed and the compiled chunk is then kept in
+     * the Lua registry to be reused until it is evicted as the least recently used one.
+     *
+     * \param code The Lua script that should be executed
+     *
+     * \throw LuaRuntimeException If the script could not be compiled or executed
+     */
+    void runCompiledScript(const std::string& code);
+
+    /// Releases all of the compiled chunks that are stored in the Lua registry
+    void clearCompiledScripts();
+
     ghoul::lua::LuaState _state;
     std::vector<LuaLibrary> _registeredLibraries;
+    PrefixTrie _luaFunctionIndex;
 
     std::queue<Script> _incomingScripts;
 
@@ -158,6 +185,14 @@ private:
     };
     std::vector<RepeatedScriptInfo> _repeatedScripts;
 
+    // Compiled chunks of recently executed scripts as pairs of script text and registry
+    // reference, ordered from the most to the least recently used one
+    static constexpr size_t MaxCompiledScripts = 256;
+    static constexpr size_t MaxCompiledScriptLength = 4096;
+    using CompiledScripts = std::list<std::pair<std::string, int>>;
+    CompiledScripts _compiledScripts;
+    std::unordered_map<std::string_view, CompiledScripts::iterator> _compiledScriptIndex;
+
     // Logging variables
     bool _logFileExists = false;
     bool _logScripts = true;
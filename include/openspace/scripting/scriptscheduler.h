@@ -35,6 +35,7 @@
 #include <optional>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ghoul { class Dictionary; }
@@ -46,7 +47,9 @@ struct LuaLibrary;
 
 /**
  * Maintains an ordered list of `ScheduledScript`s and provides a simple interface for
- * retrieveing scheduled scripts.
+ * retrieveing scheduled scripts. The times of the scripts are stored separately in a
+ * sorted list, so that finding the scripts that were passed by a time change is a binary
+ * search independent of the size of the jump.
  */
 class ScriptScheduler : public properties::PropertyOwner {
 public:
@@ -125,11 +128,25 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /**
+     * Rebuilds the list of script times after scripts were added or removed and updates
+     * the current index to be consistent with the current time.
+     */
+    void updateTimes();
+
+    /**
+     * Moves the current time to \p newTime and returns the current index before and
+     * after the move. The scripts between these indices were passed over.
+     */
+    std::pair<size_t, size_t> advanceTo(double newTime);
+
     properties::BoolProperty _enabled;
     properties::BoolProperty _shouldRunAllTimeJump;
     std::vector<ScheduledScript> _scripts;
+    /// The times of all scripts in `_scripts`, in the same order
+    std::vector<double> _times;
 
-    int _currentIndex = 0;
+    size_t _currentIndex = 0;
     double _currentTime = 0;
 };
 
@@ -0,0 +1,142 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___ASYNCLOG___H__
+#define __OPENSPACE_CORE___ASYNCLOG___H__
+
+#include <ghoul/logging/log.h>
+
+#include <openspace/util/mpmcqueue.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace openspace {
+
+/**
+ * The AsyncLog is an implementation of the ghoul::logging::Log interface that wraps
+ * another Log and moves its writing onto a background thread. Incoming messages are
+ * copied into a lock-free ring buffer from whichever thread logs them and are written to
+ * the wrapped Log by the background thread, so that threads that log never wait for the
+ * file IO of, for example, a ghoul::logging::TextLog or a ghoul::logging::HTMLLog.
+ *
+ * If messages arrive faster than they can be written and the ring buffer is full, the
+ * OverflowPolicy determines whether the logging thread waits for space or whether the
+ * message is dropped. The number of dropped messages is written to the wrapped Log once
+ * the background thread has caught up.
+ *
+ * As the wrapped Log is only called from the background thread, any time stamps that it
+ * adds to the messages are the time at which the message was written, which usually is
+ * within milliseconds of the time at which it was logged.
+ */
+class AsyncLog : public ghoul::logging::Log {
+public:
+    /// Just a shortcut for the LogLevel access
+    using LogLevel = ghoul::logging::LogLevel;
+
+    /// Determines what happens to a message that is logged while the ring buffer is full
+    enum class OverflowPolicy {
+        /// The logging thread waits until the background thread has made space
+        Block = 0,
+        /// The message is discarded and counted
+        Drop
+    };
+
+    /**
+     * Creates an AsyncLog that writes all messages to the provided \p log on a
+     * background thread.
+     *
+     * \param log The Log that the messages are written to
+     * \param capacity The number of messages that can wait to be written. The capacity
+     *        is rounded up to the next power of two
+     * \param overflowPolicy Determines what happens to a message if \p capacity messages
+     *        are already waiting to be written
+     *
+     * \pre \p log must not be `nullptr`
+     */
+    AsyncLog(std::unique_ptr<ghoul::logging::Log> log, size_t capacity = 8192,
+        OverflowPolicy overflowPolicy = OverflowPolicy::Block);
+
+    /**
+     * Writes all messages that are still waiting, flushes the wrapped Log, and stops the
+     * background thread.
+     */
+    ~AsyncLog() override;
+
+    /**
+     * Queues the message to be written by the background thread. Messages below the log
+     * level of the wrapped Log are discarded right away.
+     *
+     * \param level The ghoul::logging::LogLevel of the incoming log message
+     * \param category The category of the log message
+     * \param message The actual log message that was transmitted
+     */
+    void log(LogLevel level, std::string_view category,
+        std::string_view message) override;
+
+    /**
+     * Waits until all messages that were logged before this call have been written and
+     * the wrapped Log has been flushed. As this blocks the calling thread, the
+     * `ImmediateFlush` option of the ghoul::logging::LogManager effectively makes this
+     * Log synchronous again.
+     */
+    void flush() override;
+
+    /// Returns the number of messages that were dropped because the buffer was full
+    uint64_t nDroppedMessages() const;
+
+private:
+    struct Entry {
+        LogLevel level;
+        std::string category;
+        std::string message;
+    };
+
+    /// The function that is executed on the background thread
+    void writeMessages();
+
+    std::unique_ptr<ghoul::logging::Log> _log;
+    MpmcQueue<Entry> _queue;
+    const OverflowPolicy _overflowPolicy;
+
+    /// The number of messages that have been added to the queue
+    std::atomic<uint64_t> _nQueued = 0;
+    /// The number of messages that have been written and flushed to the wrapped Log
+    std::atomic<uint64_t> _nWritten = 0;
+    /// The number of messages that were dropped and not yet reported
+    std::atomic<uint64_t> _nUnreportedDrops = 0;
+    std::atomic<uint64_t> _nDropped = 0;
+
+    /// Incremented to wake up the background thread, which waits for this to change
+    std::atomic<uint32_t> _wakeUp = 0;
+    std::atomic_bool _shouldStop = false;
+    std::thread _writerThread;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___ASYNCLOG___H__
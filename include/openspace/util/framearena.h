@@ -0,0 +1,111 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMEARENA___H__
+#define __OPENSPACE_CORE___FRAMEARENA___H__
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A bump allocator that is used for memory that only has to live for the duration of a
+ * single frame. Allocations are served linearly from a list of blocks and individual
+ * deallocations are ignored; all memory is reclaimed at once by calling #reset at the
+ * end of the frame. If a frame requires more memory than the arena currently holds, new
+ * blocks are added and are coalesced into a single block on the next #reset so that the
+ * following frames can be served without further system allocations.
+ *
+ * The arena keeps track of the peak number of bytes used in a frame, which can be used
+ * to determine a suitable initial size for a particular installation.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    /**
+     * Creates a new arena whose initial block has a size of \p blockSize bytes.
+     *
+     * \pre blockSize must be bigger than 0
+     */
+    explicit FrameArena(size_t blockSize);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Releases all allocations that were made since the last call to this function. All
+     * pointers that were handed out by this arena are invalid afterwards.
+     */
+    void reset();
+
+    /**
+     * Returns the number of bytes that have been allocated since the last #reset.
+     */
+    size_t usedBytes() const;
+
+    /**
+     * Returns the number of bytes that were used in the frame that ended with the last
+     * call to #reset.
+     */
+    size_t lastFrameUsage() const;
+
+    /**
+     * Returns the largest number of bytes that were used in any frame so far.
+     */
+    size_t highWaterMark() const;
+
+    /**
+     * Returns the number of bytes that the arena can hand out before having to grow.
+     */
+    size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size = 0;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    const size_t _blockSize;
+
+    std::vector<Block> _blocks;
+    size_t _currentBlock = 0;
+    size_t _offset = 0;
+
+    size_t _usedBytes = 0;
+    size_t _lastFrameUsage = 0;
+    size_t _highWaterMark = 0;
+
+    mutable std::mutex _mutex;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMEARENA___H__
@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_CORE___HISTOGRAM___H__
 #define __OPENSPACE_CORE___HISTOGRAM___H__
 
+#include <span>
 #include <vector>
 
 namespace openspace {
@@ -52,6 +53,17 @@ public:
      * \return Returns `true` if succesful insertion, otherwise return `false`
      */
     bool add(float value, float repeat = 1.f);
+
+    /**
+     * Enters all \p values into the histogram, which gives the same result as calling
+     * #add for each of the values individually. The bins are computed in blocks so that
+     * the computation can be vectorized and large inputs are split between multiple
+     * threads that each fill a separate histogram which are merged at the end.
+     *
+     * \param values The values to insert into the histogram
+     * \return The number of values that were inside the range of the histogram
+     */
+    int add(std::span<const float> values);
     bool add(const Histogram& histogram);
     bool addRectangle(float lowBin, float highBin, float value);
 
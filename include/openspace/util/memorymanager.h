@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_CORE___MEMORYMANAGER___H__
 #define __OPENSPACE_CORE___MEMORYMANAGER___H__
 
+#include <openspace/util/framearena.h>
 #include <ghoul/misc/memorypool.h>
 
 namespace openspace {
@@ -33,9 +34,14 @@ class MemoryManager {
 public:
     ghoul::MemoryPool<8 * 1024 * 1024> PersistentMemory;
 
-    // This should be replaced with a std::pmr::memory_resource wrapper around our own
-    // Memory pool so that we can get a high-water mark out of it
-    ghoul::MemoryPool<100 * 4096, false, true> TemporaryMemory;
+    // Storage for the SceneGraphNodes and their transform and time frame components.
+    // These are kept apart from the much larger renderables so that the parts of the
+    // scene that are touched in every Scene::update lie close together in memory
+    ghoul::MemoryPool<4 * 1024 * 1024> SceneGraphMemory;
+
+    // Frame-based storage that is reset at the end of every frame in
+    // OpenSpaceEngine::postDraw
+    FrameArena TemporaryMemory { 100 * 4096 };
 };
 
 } // namespace openspace
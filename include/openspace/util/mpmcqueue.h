@@ -0,0 +1,111 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___MPMCQUEUE___H__
+#define __OPENSPACE_CORE___MPMCQUEUE___H__
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Templated bounded queue that is safe to use without locking from any number of threads
+ * that push items and any number of threads that pop items. The items are stored in a
+ * ring buffer whose cells carry a sequence number that tells the producers and consumers
+ * whether a cell is ready to be written or read, so a thread only ever has to wait for
+ * the atomic increment of the shared read or write position. This is used to hand the
+ * results of worker threads to the main thread, which can drain all available results in
+ * one call without contending with the workers.
+ */
+template <typename T>
+class MpmcQueue {
+public:
+    /**
+     * \param capacity The maximum number of items that can be stored in the queue at the
+     *        same time. The capacity is rounded up to the next power of two
+     */
+    explicit MpmcQueue(size_t capacity);
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * Adds the \p item to the end of the queue, unless the queue is full.
+     *
+     * \param item The item that is added to the queue
+     * \return `true` if the item was added, `false` if the queue was full
+     */
+    bool tryPush(T item);
+
+    /**
+     * Removes the first item from the queue and returns it, or returns `std::nullopt` if
+     * the queue is empty.
+     *
+     * \return The first item of the queue or `std::nullopt` if the queue is empty
+     */
+    std::optional<T> tryPop();
+
+    /**
+     * Removes all items that are currently in the queue and appends them to \p items in
+     * the order in which they were pushed. Items that are pushed while this function is
+     * running might or might not be part of the result.
+     *
+     * \param items The list to which the removed items are appended
+     * \return The number of items that were removed from the queue
+     */
+    size_t popAll(std::vector<T>& items);
+
+    /**
+     * Returns the number of items in the queue. If other threads are pushing or popping
+     * at the same time, the returned value is only a snapshot that might already be out
+     * of date.
+     */
+    size_t size() const;
+
+    bool empty() const;
+
+    size_t capacity() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::optional<T> value;
+    };
+
+    std::vector<Cell> _cells;
+    const size_t _mask;
+
+    // The positions are modified by different threads, so they are kept in separate cache
+    // lines to avoid false sharing
+    alignas(64) std::atomic<size_t> _pushPosition = 0;
+    alignas(64) std::atomic<size_t> _popPosition = 0;
+};
+
+} // namespace openspace
+
+#include "mpmcqueue.inl"
+
+#endif // __OPENSPACE_CORE___MPMCQUEUE___H__
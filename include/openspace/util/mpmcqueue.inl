@@ -0,0 +1,150 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace openspace {
+
+template <typename T>
+MpmcQueue<T>::MpmcQueue(size_t capacity)
+    : _cells(std::bit_ceil(std::max<size_t>(capacity, 2)))
+    , _mask(_cells.size() - 1)
+{
+    // A cell at index `i` is free to be written for the push position `i` and will be
+    // ready to be read for the pop position `i` once its sequence number is `i + 1`
+    for (size_t i = 0; i < _cells.size(); i++) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool MpmcQueue<T>::tryPush(T item) {
+    size_t position = _pushPosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+        cell = &_cells[position & _mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff =
+            static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (diff == 0) {
+            // The cell is free, try to claim it
+            if (_pushPosition.compare_exchange_weak(
+                    position,
+                    position + 1,
+                    std::memory_order_relaxed
+                ))
+            {
+                break;
+            }
+            // Another producer claimed the cell, `position` has been updated by the
+            // compare exchange
+        }
+        else if (diff < 0) {
+            // The cell still contains the item from the previous round, so it is full
+            return false;
+        }
+        else {
+            // Another producer has already written this cell
+            position = _pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value = std::move(item);
+    // The release makes sure that the consumer sees the value once it sees the sequence
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::optional<T> MpmcQueue<T>::tryPop() {
+    size_t position = _popPosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+        cell = &_cells[position & _mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff =
+            static_cast<std::ptrdiff_t>(sequence) -
+            static_cast<std::ptrdiff_t>(position + 1);
+        if (diff == 0) {
+            // The cell has been written, try to claim it
+            if (_popPosition.compare_exchange_weak(
+                    position,
+                    position + 1,
+                    std::memory_order_relaxed
+                ))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The cell has not been written yet, so the queue is empty
+            return std::nullopt;
+        }
+        else {
+            // Another consumer has already read this cell
+            position = _popPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<T> value = std::move(cell->value);
+    cell->value.reset();
+    // Mark the cell as free for the producer of the next round through the ring buffer
+    cell->sequence.store(position + _mask + 1, std::memory_order_release);
+    return value;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::popAll(std::vector<T>& items) {
+    size_t nItems = 0;
+    std::optional<T> item = tryPop();
+    while (item) {
+        items.push_back(std::move(*item));
+        nItems++;
+        item = tryPop();
+    }
+    return nItems;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::size() const {
+    // The pop position never overtakes the push position. Reading it first guarantees
+    // that the difference can not underflow even if items are popped in between
+    const size_t popPosition = _popPosition.load(std::memory_order_acquire);
+    const size_t pushPosition = _pushPosition.load(std::memory_order_acquire);
+    return pushPosition - popPosition;
+}
+
+template <typename T>
+bool MpmcQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+size_t MpmcQueue<T>::capacity() const {
+    return _cells.size();
+}
+
+} // namespace openspace
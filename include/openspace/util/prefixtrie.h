@@ -0,0 +1,139 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___PREFIXTRIE___H__
+#define __OPENSPACE_CORE___PREFIXTRIE___H__
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A set of strings that is stored as a radix tree, in which common prefixes of the
+ * strings are only stored once. This makes it fast to find all strings that start with a
+ * specific prefix, which is used for the autocompletion of Lua functions and property
+ * URIs, and it is compact for large sets of strings that share long prefixes.
+ */
+class PrefixTrie {
+public:
+    /**
+     * Adds the \p word to the trie. Adding a word that is already part of the trie does
+     * nothing.
+     *
+     * \param word The word that is added
+     */
+    void insert(std::string_view word);
+
+    /**
+     * Removes the \p word from the trie, if it is part of the trie. Other words for which
+     * the \p word is a prefix are kept.
+     *
+     * \param word The word that is removed
+     * \return `true` if the \p word was part of the trie, `false` otherwise
+     */
+    bool remove(std::string_view word);
+
+    /**
+     * Removes all words that start with the \p prefix, including the \p prefix itself if
+     * it is a word of the trie.
+     *
+     * \param prefix The prefix of all words that are removed
+     * \return The number of words that were removed
+     */
+    size_t removePrefix(std::string_view prefix);
+
+    /**
+     * Returns whether the \p word is part of the trie.
+     *
+     * \param word The word that is looked for
+     * \return `true` if the \p word is part of the trie, `false` otherwise
+     */
+    bool contains(std::string_view word) const;
+
+    /**
+     * Returns the completions of the \p prefix, which are all words that start with the
+     * \p prefix when compared without regard to case. Each word is only completed up to
+     * and including the first \p separator that follows the \p prefix, and words that
+     * result in the same completion are only returned once. The completions are returned
+     * in lexicographical order.
+     *
+     * \param prefix The beginning of the words that are completed
+     * \param separator The character after which the completions of the words end. If
+     *        this is `'\0'`, the words are completed in their entirety
+     * \return The sorted list of completions
+     */
+    std::vector<std::string> completions(std::string_view prefix,
+        char separator = '\0') const;
+
+    /**
+     * Returns the number of words in the trie.
+     */
+    size_t size() const;
+
+    /**
+     * Returns whether there are no words in the trie.
+     */
+    bool empty() const;
+
+    /**
+     * Removes all words from the trie.
+     */
+    void clear();
+
+private:
+    struct Node {
+        /// The part of the words that is added by this node to the one of its parent
+        std::string label;
+        /// The children of this node, sorted by the first character of their label
+        std::vector<std::unique_ptr<Node>> children;
+        /// Whether the path to this node forms a word in the trie
+        bool isWord = false;
+    };
+
+    /// Returns the first child of the \p node whose label does not start before the
+    /// \p character
+    static std::vector<std::unique_ptr<Node>>::iterator findChild(Node& node,
+        char character);
+
+    /// Removes the nodes at the end of the \p path that are no longer needed, either
+    /// because they have no children or because they could be merged with their only
+    /// child. The \p path starts at the root of the trie
+    static void compact(std::vector<Node*>& path);
+
+    /// Returns the number of words in the subtree starting at the \p node
+    static size_t nWords(const Node& node);
+
+    static void collectCompletions(const Node& node, std::string& word,
+        std::string_view prefix, char separator, std::vector<std::string>& result);
+
+    Node _root;
+    size_t _size = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___PREFIXTRIE___H__
@@ -25,7 +25,11 @@
 #ifndef __OPENSPACE_CORE___SPICEMANAGER___H__
 #define __OPENSPACE_CORE___SPICEMANAGER___H__
 
+#include <openspace/properties/propertyowner.h>
+
 #include <openspace/engine/globals.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/util/memorymanager.h>
 #include <ghoul/format.h>
 #include <ghoul/glm.h>
@@ -35,7 +39,10 @@
 #include <array>
 #include <filesystem>
 #include <map>
+#include <mutex>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <set>
 
@@ -62,7 +69,7 @@ namespace scripting { struct LuaLibrary; }
 
 void throwSpiceError(const std::string& errorMessage);
 
-class SpiceManager {
+class SpiceManager : public properties::PropertyOwner {
 public:
     BooleanType(UseException);
 
@@ -579,6 +586,7 @@ public:
         static_assert(N != 0, "Format must not be empty");
         ghoul_assert(N >= bufferSize - 1, "Buffer size too small");
 
+        std::lock_guard lock(_mutex);
         timout_c(ephemerisTime, format, bufferSize, outBuf);
         if (failed_c()) {
             throwSpiceError(std::format(
@@ -676,6 +684,34 @@ public:
         const std::string& observer, const std::string& referenceFrame,
         AberrationCorrection aberrationCorrection, double ephemerisTime) const;
 
+    /**
+     * Computes the \p positions of a \p target body relative to an \p observer for all of
+     * the provided \p ephemerisTimes. The result is the same as calling #targetPosition
+     * for each time, but the NAIF IDs and the SPK coverage of the bodies are only
+     * resolved once if both bodies have coverage for the entire time range. The
+     * positions are not stored in the ephemeris cache.
+     *
+     * \param target The target body name or the target body's NAIF ID
+     * \param observer The observing body name or the observing body's NAIF ID
+     * \param referenceFrame The reference frame of the output position vectors
+     * \param aberrationCorrection The aberration correction used for the position
+     *        calculation
+     * \param ephemerisTimes The times at which the positions are to be queried
+     * \param positions The positions of the \p target relative to the \p observer in the
+     *        order of the \p ephemerisTimes
+     *
+     * \throw SpiceException In the same cases as #targetPosition
+     * \pre \p target must not be empty
+     * \pre \p observer must not be empty
+     * \pre \p referenceFrame must not be empty
+     * \pre \p positions must have the same size as \p ephemerisTimes
+     *
+     * \see http://naif.jpl.nasa.gov/pub/naif/toolkit_docs/C/cspice/spkezp_c.html
+     */
+    void targetPositions(const std::string& target, const std::string& observer,
+        const std::string& referenceFrame, AberrationCorrection aberrationCorrection,
+        std::span<const double> ephemerisTimes, std::span<glm::dvec3> positions) const;
+
     /**
      * This method returns the transformation matrix that defines the transformation from
      * the reference frame \p from to the reference frame \p to. As both reference frames
@@ -1029,6 +1065,52 @@ public:
      */
     UseException exceptionHandling() const;
 
+    /**
+     * Informs the SpiceManager about the simulation time of the current frame. Results of
+     * #targetPosition, #frameTransformationMatrix, and #positionTransformMatrix requests
+     * for exactly this time are cached until the simulation time changes, as the same
+     * requests are usually made by multiple components in each frame. Requests for any
+     * other time are not cached. This function also updates the cache statistics shown
+     * in the properties for the previous frame.
+     *
+     * \param ephemerisTime The simulation time of the current frame
+     */
+    void updateEphemerisCache(double ephemerisTime);
+
+    /**
+     * Removes all cached positions and transformation matrices. This has to be called
+     * whenever the loaded kernels change.
+     */
+    void clearEphemerisCache();
+
+    /**
+     * Registers a request for the geometric position of the \p target relative to the
+     * \p observer in the \p referenceFrame. All registered requests are evaluated
+     * together in #updateEphemerisCache and stored in the ephemeris cache, from which
+     * the #targetPosition function serves them for the rest of the frame. The position
+     * of each body relative to the solar system barycenter is computed only once per
+     * frame and reference frame, regardless of how many requests share the body as a
+     * target or an observer. Requests for which either body does not have SPK coverage
+     * are not precomputed and are computed by #targetPosition as usual.
+     *
+     * \param target The target body name or the target body's NAIF ID
+     * \param observer The observing body name or the observing body's NAIF ID
+     * \param referenceFrame The reference frame of the position
+     * \return A handle that has to be passed to #unregisterPositionRequest
+     *
+     * \pre \p target must not be empty
+     * \pre \p observer must not be empty
+     * \pre \p referenceFrame must not be empty
+     */
+    int registerPositionRequest(std::string target, std::string observer,
+        std::string referenceFrame);
+
+    /**
+     * Removes the position request with the provided \p handle that was previously
+     * returned by #registerPositionRequest.
+     */
+    void unregisterPositionRequest(int handle);
+
     static scripting::LuaLibrary luaLibrary();
 
 private:
@@ -1055,7 +1137,38 @@ private:
     /**
      * Default destructor that resets the SPICE settings.
      */
-    ~SpiceManager();
+    ~SpiceManager() override;
+
+    /**
+     * Computes the position of the \p target relative to the \p observer without using
+     * the ephemeris cache. See #targetPosition for a description of the parameters.
+     */
+    glm::dvec3 computeTargetPosition(const std::string& target,
+        const std::string& observer, const std::string& referenceFrame,
+        AberrationCorrection aberrationCorrection, double ephemerisTime,
+        double& lightTime) const;
+
+    /**
+     * Computes the transformation matrix between the \p from and \p to reference frames
+     * without using the ephemeris cache. See #frameTransformationMatrix for a
+     * description of the parameters.
+     */
+    glm::dmat3 computeFrameTransformationMatrix(const std::string& from,
+        const std::string& to, double ephemerisTime) const;
+
+    /**
+     * Computes the transformation matrix between the \p sourceFrame and the
+     * \p destinationFrame without using the ephemeris cache. See
+     * #positionTransformMatrix for a description of the parameters.
+     */
+    glm::dmat3 computePositionTransformMatrix(const std::string& sourceFrame,
+        const std::string& destinationFrame, double ephemerisTime) const;
+
+    /**
+     * Returns `true` if requests for the \p ephemerisTime can be served from or stored
+     * in the ephemeris cache.
+     */
+    bool isCacheable(double ephemerisTime) const;
 
     /**
      * Function to find and store the intervals covered by a ck file, this is done
@@ -1137,6 +1250,12 @@ private:
     glm::dmat3 getEstimatedTransformMatrix(const std::string& fromFrame,
         const std::string& toFrame, double time) const;
 
+    /**
+     * Evaluates all requests registered through #registerPositionRequest for the
+     * \p ephemerisTime and stores the results in the ephemeris cache.
+     */
+    void evaluatePositionRequests(double ephemerisTime);
+
     /**
      * Loads pre defined leap seconds time kernel (naif00012.tls).
      */
@@ -1163,6 +1282,39 @@ private:
     /// The last assigned kernel-id, used to determine the next free kernel id
     KernelHandle _lastAssignedKernel = KernelHandle(0);
 
+    struct CachedPosition {
+        glm::dvec3 position = glm::dvec3(0.0);
+        double lightTime = 0.0;
+    };
+
+    /// The simulation time for which the ephemeris cache contains values
+    double _cacheEphemerisTime = -std::numeric_limits<double>::max();
+    /// Cached results of the #targetPosition function for the current frame
+    mutable std::unordered_map<std::string, CachedPosition> _positionCache;
+    /// Cached results of the transform matrix functions for the current frame
+    mutable std::unordered_map<std::string, glm::dmat3> _matrixCache;
+    /// Reused buffer to build the key for the cache lookups without allocations
+    mutable std::string _cacheKey;
+
+    /// Serializes all accesses to CSPICE and to the state of the SpiceManager, as CSPICE
+    /// is not thread-safe. The mutex is recursive as the public functions call each other
+    mutable std::recursive_mutex _mutex;
+
+    struct PositionRequest {
+        std::string target;
+        std::string observer;
+        std::string referenceFrame;
+    };
+    /// The position requests that are evaluated together for every frame
+    std::map<int, PositionRequest> _positionRequests;
+    int _nextPositionRequest = 0;
+    mutable int _nCacheHits = 0;
+    mutable int _nCacheMisses = 0;
+
+    properties::BoolProperty _useEphemerisCache;
+    properties::IntProperty _cacheHits;
+    properties::IntProperty _cacheMisses;
+
     static SpiceManager* _instance;
 };
 
@@ -0,0 +1,80 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___SPSCQUEUE___H__
+#define __OPENSPACE_CORE___SPSCQUEUE___H__
+
+#include <atomic>
+#include <optional>
+
+namespace openspace {
+
+/**
+ * Templated unbounded queue that is safe to use without locking as long as there is only
+ * a single thread that pushes items and a single other thread that pops items. This is
+ * used for data that arrives on a network thread and is consumed by the main thread, so
+ * that neither thread ever has to wait for the other one.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    SpscQueue();
+    ~SpscQueue();
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Adds the \p item to the end of the queue. This function must only be called from
+     * the producer thread.
+     *
+     * \param item The item that is added to the queue
+     */
+    void push(T item);
+
+    /**
+     * Removes the first item from the queue and returns it, or returns `std::nullopt` if
+     * the queue is empty. This function must only be called from the consumer thread.
+     *
+     * \return The first item of the queue or `std::nullopt` if the queue is empty
+     */
+    std::optional<T> pop();
+
+private:
+    struct Node {
+        std::optional<T> value;
+        std::atomic<Node*> next = nullptr;
+    };
+
+    /// The node before the first item in the queue, only accessed by the consumer
+    Node* _head = nullptr;
+    /// The last node in the queue, only accessed by the producer
+    Node* _tail = nullptr;
+};
+
+} // namespace openspace
+
+#include "spscqueue.inl"
+
+#endif // __OPENSPACE_CORE___SPSCQUEUE___H__
@@ -0,0 +1,66 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+namespace openspace {
+
+template <typename T>
+SpscQueue<T>::SpscQueue()
+    : _head(new Node)
+    , _tail(_head)
+{}
+
+template <typename T>
+SpscQueue<T>::~SpscQueue() {
+    while (_head) {
+        Node* next = _head->next.load(std::memory_order_relaxed);
+        delete _head;
+        _head = next;
+    }
+}
+
+template <typename T>
+void SpscQueue<T>::push(T item) {
+    Node* node = new Node;
+    node->value = std::move(item);
+    // The release makes sure that the consumer sees the value once it sees the node
+    _tail->next.store(node, std::memory_order_release);
+    _tail = node;
+}
+
+template <typename T>
+std::optional<T> SpscQueue<T>::pop() {
+    Node* next = _head->next.load(std::memory_order_acquire);
+    if (!next) {
+        return std::nullopt;
+    }
+
+    // The first node with a value becomes the new empty head node
+    std::optional<T> value = std::move(next->value);
+    next->value.reset();
+    delete _head;
+    _head = next;
+    return value;
+}
+
+} // namespace openspace
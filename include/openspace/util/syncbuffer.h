@@ -27,6 +27,7 @@
 
 #include <ghoul/glm.h>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,8 @@ public:
     ~SyncBuffer() = default;
 
     void encode(const std::string& s);
+    void encode(std::span<const std::byte> data);
+    void encode(const std::vector<std::byte>& data);
 
     template <typename T>
     void encode(const T& v);
@@ -49,6 +52,14 @@ public:
     T decode();
 
     void decode(std::string& s);
+
+    /**
+     * Decodes a block of bytes that was previously encoded with the
+     * `encode(const std::vector<std::byte>&)` overload.
+     *
+     * \throw RuntimeError If the stored length of the block exceeds the remaining data
+     */
+    void decode(std::vector<std::byte>& data);
     void decode(glm::quat& value);
     void decode(glm::dquat& value);
     void decode(glm::vec3& value);
@@ -59,10 +70,26 @@ public:
 
     void reset();
 
-    void setData(std::vector<std::byte> data);
+    /**
+     * Replaces the content of the buffer with a copy of \p data, which reuses the memory
+     * that the buffer has already allocated.
+     */
+    void setData(std::span<const std::byte> data);
     std::vector<std::byte> data();
 
+    /**
+     * Returns the data that has been encoded since the last reset without copying it.
+     * The span is only valid until the buffer is modified next.
+     */
+    std::span<const std::byte> encodedData() const;
+
 private:
+    /**
+     * Grows the buffer so that \p size more bytes can be encoded. The size is at least
+     * doubled so that encoding many small values does not reallocate every time.
+     */
+    void ensureEncodeCapacity(size_t size);
+
     size_t _n;
     size_t _encodeOffset = 0;
     size_t _decodeOffset = 0;
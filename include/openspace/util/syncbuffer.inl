@@ -31,12 +31,7 @@ namespace openspace {
 template <typename T>
 void SyncBuffer::encode(const T& v) {
     const size_t size = sizeof(T);
-
-    size_t anticpatedBufferSize = _encodeOffset + size;
-    if (anticpatedBufferSize >= _n) {
-        _dataStream.resize(anticpatedBufferSize);
-    }
-
+    ensureEncodeCapacity(size);
     std::memcpy(_dataStream.data() + _encodeOffset, &v, size);
     _encodeOffset += size;
 }
@@ -44,7 +39,7 @@ void SyncBuffer::encode(const T& v) {
 template <typename T>
 T SyncBuffer::decode() {
     const size_t size = sizeof(T);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _dataStream.size(), "Buffer overrun");
     T value;
     std::memcpy(&value, _dataStream.data() + _decodeOffset, size);
     _decodeOffset += size;
@@ -54,7 +49,7 @@ T SyncBuffer::decode() {
 template <typename T>
 void SyncBuffer::decode(T& value) {
     const size_t size = sizeof(T);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _dataStream.size(), "Buffer overrun");
     std::memcpy(&value, _dataStream.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
@@ -27,6 +27,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace ghoul { class Dictionary; }
 
@@ -42,11 +44,27 @@ public:
     virtual void perform(const ProgressCallback& onProgress) = 0;
     virtual std::string description() = 0;
 
+    /**
+     * Returns the identifier by which other tasks can depend on this task. The identifier
+     * is empty if none was specified.
+     */
+    const std::string& identifier() const;
+
+    /**
+     * Returns the identifiers of all tasks that have to be finished before this task can
+     * be performed.
+     */
+    const std::vector<std::string>& dependencies() const;
+
     static std::unique_ptr<Task> createFromDictionary(
         const ghoul::Dictionary& dictionary
     );
 
     static documentation::Documentation documentation();
+
+private:
+    std::string _identifier;
+    std::vector<std::string> _dependencies;
 };
 
 } // namespace openspace
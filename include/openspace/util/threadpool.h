@@ -25,52 +25,135 @@
 #ifndef __OPENSPACE_CORE___THREAD_POOL___H__
 #define __OPENSPACE_CORE___THREAD_POOL___H__
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
-// Implementation based on http://progsch.net/wordpress/?p=81
-
 namespace openspace {
 
-class ThreadPool;
-
-class Worker {
-public:
-    Worker(ThreadPool& p);
-    void operator()();
-
-private:
-    ThreadPool& pool;
-};
-
+/**
+ * A pool of worker threads that execute tasks asynchronously. Each worker owns a queue
+ * of tasks for every Priority level. Tasks that are enqueued from one of the pool's own
+ * worker threads are placed in that worker's queue, all other tasks are distributed
+ * among the workers in a round-robin fashion. A worker that runs out of tasks steals
+ * work from the other workers' queues before going to sleep. Tasks with a higher
+ * priority are always preferred over tasks with a lower priority, regardless of whose
+ * queue they are in.
+ *
+ * Tasks that are submitted through #submit return a `std::future` for the result of the
+ * task. Exceptions that are thrown by such a task are stored in the future. Tasks that
+ * are added through #enqueue must not throw.
+ */
 class ThreadPool {
 public:
-    ThreadPool(size_t numThreads);
+    enum class Priority {
+        Low = 0,
+        Normal,
+        High
+    };
+
+    /**
+     * Creates a new ThreadPool with \p numThreads worker threads.
+     *
+     * \pre numThreads must be bigger than 0
+     */
+    explicit ThreadPool(size_t numThreads);
+
+    /**
+     * Creates a new ThreadPool with the same number of threads as \p toCopy. The tasks
+     * of \p toCopy are not copied.
+     */
     ThreadPool(const ThreadPool& toCopy);
+
+    /**
+     * Stops all worker threads and waits for the currently running tasks to finish.
+     * Tasks that have not been started yet are discarded.
+     */
     ~ThreadPool();
 
-    void enqueue(std::function<void()> f);
+    /**
+     * Returns the number of worker threads that should be used for a pool that is shared
+     * by the entire application, which leaves one hardware thread for the main thread.
+     */
+    static size_t defaultNumberOfThreads();
+
+    /**
+     * Adds the task \p f with the provided \p priority to the pool.
+     */
+    void enqueue(std::function<void()> f, Priority priority = Priority::Normal);
+
+    /**
+     * Adds the task \p f with the provided \p priority to the pool and returns a future
+     * that contains the return value of \p f or the exception that it threw.
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& f,
+        Priority priority = Priority::Normal);
+
+    /**
+     * Adds the task \p f with the provided \p priority to the pool. After \p f has
+     * finished successfully, \p continuation is enqueued with the same priority and is
+     * called with the return value of \p f, or without any arguments if \p f does not
+     * return a value. The returned future contains the return value of the continuation
+     * or the exception that was thrown by either \p f or \p continuation.
+     */
+    template <typename F, typename C>
+    auto submit(F&& f, C&& continuation, Priority priority = Priority::Normal);
+
+    /**
+     * Removes all tasks that have not been started yet.
+     */
     void clearTasks();
 
+    /**
+     * Returns `true` if there are tasks that are either waiting to be executed or are
+     * currently being executed.
+     */
     bool hasOutstandingTasks() const;
 
+    /**
+     * Returns the number of worker threads in this pool.
+     */
+    size_t numberOfThreads() const;
+
 private:
-    friend class Worker;
+    static constexpr size_t NumPriorities = 3;
 
-    std::vector<std::thread> workers;
+    struct Queue {
+        std::array<std::deque<std::function<void()>>, NumPriorities> tasks;
+        std::mutex mutex;
+    };
 
-    std::deque<std::function<void()>> tasks;
+    void workerLoop(size_t index);
+    bool popTask(size_t index, std::function<void()>& task);
 
-    std::mutex queue_mutex;
-    std::condition_variable condition;
+    template <typename R, typename F>
+    static void fulfill(std::promise<R>& promise, F& f);
 
-    bool stop;
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::atomic<size_t> _nextQueue = 0;
+
+    /// The number of tasks that are in one of the queues
+    std::atomic<int> _nQueuedTasks = 0;
+    /// The number of tasks that are either queued or running
+    std::atomic<int> _nUnfinishedTasks = 0;
+
+    std::mutex _sleepMutex;
+    std::condition_variable _condition;
+    std::atomic_bool _stop = false;
 };
 
 } // namespace openspace
 
+#include "threadpool.inl"
+
 #endif // __OPENSPACE_CORE___THREAD_POOL___H__
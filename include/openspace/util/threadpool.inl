@@ -0,0 +1,112 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <exception>
+#include <utility>
+
+namespace openspace {
+
+namespace detail {
+    template <typename C, typename T>
+    struct ContinuationResult {
+        using type = std::invoke_result_t<std::decay_t<C>, T>;
+    };
+
+    template <typename C>
+    struct ContinuationResult<C, void> {
+        using type = std::invoke_result_t<std::decay_t<C>>;
+    };
+} // namespace detail
+
+template <typename R, typename F>
+void ThreadPool::fulfill(std::promise<R>& promise, F& f) {
+    try {
+        if constexpr (std::is_void_v<R>) {
+            f();
+            promise.set_value();
+        }
+        else {
+            promise.set_value(f());
+        }
+    }
+    catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+template <typename F>
+std::future<std::invoke_result_t<std::decay_t<F>>> ThreadPool::submit(F&& f,
+                                                                     Priority priority)
+{
+    using R = std::invoke_result_t<std::decay_t<F>>;
+
+    // std::function requires a copyable callable, so the promise is shared
+    auto promise = std::make_shared<std::promise<R>>();
+    std::future<R> future = promise->get_future();
+    enqueue(
+        [promise, f = std::forward<F>(f)]() mutable { fulfill(*promise, f); },
+        priority
+    );
+    return future;
+}
+
+template <typename F, typename C>
+auto ThreadPool::submit(F&& f, C&& continuation, Priority priority) {
+    using T = std::invoke_result_t<std::decay_t<F>>;
+    using R = typename detail::ContinuationResult<C, T>::type;
+
+    auto promise = std::make_shared<std::promise<R>>();
+    std::future<R> future = promise->get_future();
+    enqueue(
+        [this, promise, priority, f = std::forward<F>(f),
+         c = std::forward<C>(continuation)]() mutable
+        {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    f();
+                    enqueue(
+                        [promise, c = std::move(c)]() mutable { fulfill(*promise, c); },
+                        priority
+                    );
+                }
+                else {
+                    enqueue(
+                        [promise, c = std::move(c), v = f()]() mutable {
+                            auto call = [&c, &v]() { return c(std::move(v)); };
+                            fulfill(*promise, call);
+                        },
+                        priority
+                    );
+                }
+            }
+            catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        },
+        priority
+    );
+    return future;
+}
+
+} // namespace openspace
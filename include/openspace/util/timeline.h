@@ -28,6 +28,8 @@
 #include <algorithm>
 #include <deque>
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 namespace openspace {
 
@@ -56,7 +58,9 @@ struct Keyframe : public KeyframeBase {
 };
 
 /**
- * Templated class for timelines.
+ * Templated class for timelines. The keyframes are kept sorted by their timestamp, so all
+ * lookups are binary searches, and keyframes that are added in chronological order are
+ * appended without a search.
  */
 template <typename T>
 class Timeline {
@@ -65,6 +69,17 @@ public:
 
     void addKeyframe(double time, const T& data);
     void addKeyframe(double time, T&& data);
+
+    /**
+     * Adds all of the provided \p keyframes, which are pairs of timestamp and data, to
+     * the timeline. The keyframes do not have to be sorted. The result is the same as if
+     * the keyframes were added one by one in the provided order, but the timeline is only
+     * reordered once.
+     *
+     * \param keyframes The keyframes that are added to the timeline
+     */
+    void addKeyframes(std::vector<std::pair<double, T>> keyframes);
+
     void clearKeyframes();
     void removeKeyframe(size_t id);
     void removeKeyframesBefore(double timestamp, bool inclusive = false);
@@ -78,6 +93,8 @@ public:
     const std::deque<Keyframe<T>>& keyframes() const;
 
 private:
+    void insertKeyframe(Keyframe<T> keyframe);
+
     size_t _nextKeyframeId = 1;
     std::deque<Keyframe<T>> _keyframes;
 };
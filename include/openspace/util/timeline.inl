@@ -31,8 +31,14 @@ Keyframe<T>::Keyframe(size_t i, double t, T d)
 {}
 
 template <typename T>
-void Timeline<T>::addKeyframe(double timestamp, T&& data) {
-    Keyframe<T> keyframe(++_nextKeyframeId, timestamp, std::move(data));
+void Timeline<T>::insertKeyframe(Keyframe<T> keyframe) {
+    // Keyframes usually arrive in chronological order, in which case they can be appended
+    // without having to search for their position
+    if (_keyframes.empty() || _keyframes.back().timestamp <= keyframe.timestamp) {
+        _keyframes.push_back(std::move(keyframe));
+        return;
+    }
+
     const auto iter = std::upper_bound(
         _keyframes.cbegin(),
         _keyframes.cend(),
@@ -42,16 +48,37 @@ void Timeline<T>::addKeyframe(double timestamp, T&& data) {
     _keyframes.insert(iter, std::move(keyframe));
 }
 
+template <typename T>
+void Timeline<T>::addKeyframe(double timestamp, T&& data) {
+    insertKeyframe(Keyframe<T>(++_nextKeyframeId, timestamp, std::move(data)));
+}
+
 template <typename T>
 void Timeline<T>::addKeyframe(double timestamp, const T& data) {
-    Keyframe<T> keyframe(++_nextKeyframeId, timestamp, data);
-    const auto iter = std::upper_bound(
-        _keyframes.cbegin(),
-        _keyframes.cend(),
-        keyframe,
+    insertKeyframe(Keyframe<T>(++_nextKeyframeId, timestamp, data));
+}
+
+template <typename T>
+void Timeline<T>::addKeyframes(std::vector<std::pair<double, T>> keyframes) {
+    using Diff = typename std::deque<Keyframe<T>>::difference_type;
+    const Diff nExisting = static_cast<Diff>(_keyframes.size());
+    for (std::pair<double, T>& kf : keyframes) {
+        _keyframes.emplace_back(++_nextKeyframeId, kf.first, std::move(kf.second));
+    }
+
+    // Both sorting steps are stable, so keyframes with the same timestamp end up in the
+    // same order as if they were added one after another
+    std::stable_sort(
+        _keyframes.begin() + nExisting,
+        _keyframes.end(),
+        &compareKeyframeTimes
+    );
+    std::inplace_merge(
+        _keyframes.begin(),
+        _keyframes.begin() + nExisting,
+        _keyframes.end(),
         &compareKeyframeTimes
     );
-    _keyframes.insert(iter, std::move(keyframe));
 }
 
 template <typename T>
@@ -151,14 +178,15 @@ void Timeline<T>::clearKeyframes() {
 
 template <typename T>
 void Timeline<T>::removeKeyframe(size_t id) {
-    _keyframes.erase(
-        std::remove_if(
-            _keyframes.begin(),
-            _keyframes.end(),
-            [id] (const Keyframe<T>& keyframe) { return keyframe.id == id; }
-        ),
-        _keyframes.end()
+    // The identifiers are unique, so we can stop at the first match
+    const auto it = std::find_if(
+        _keyframes.begin(),
+        _keyframes.end(),
+        [id] (const Keyframe<T>& keyframe) { return keyframe.id == id; }
     );
+    if (it != _keyframes.end()) {
+        _keyframes.erase(it);
+    }
 }
 
 template <typename T>
@@ -26,11 +26,15 @@
 #define __OPENSPACE_CORE___UPDATESTRUCTURES___H__
 
 #include <openspace/camera/camera.h>
+#include <openspace/camera/camerasnapshot.h>
 #include <openspace/util/time.h>
+#include <functional>
+#include <vector>
 
 namespace openspace {
 
 class Deferredcaster;
+class DrawList;
 class VolumeRaycaster;
 
 struct InitializeData {};
@@ -49,6 +53,9 @@ struct UpdateData {
 
 struct RenderData {
     const Camera& camera;
+    /// The precomputed state of the #camera for the current frame and viewport, which
+    /// should be preferred over the camera's accessors
+    const CameraSnapshot& cameraSnapshot;
     const Time time;
     int8_t renderBinMask = -1;
     TransformData modelTransform;
@@ -67,6 +74,17 @@ struct DeferredcasterTask {
 struct RendererTasks {
     std::vector<RaycasterTask> raycasterTasks;
     std::vector<DeferredcasterTask> deferredcasterTasks;
+
+    /// If this is not `nullptr`, renderables can submit their draw calls to this list
+    /// instead of issuing them immediately. The list is executed at the end of each
+    /// render bin
+    DrawList* drawList = nullptr;
+
+    /// Renderables that use weighted blended order-independent transparency add their
+    /// draw calls here instead of issuing them immediately. They are executed after the
+    /// PostDeferredTransparent render bin with the transparency buffers bound, and the
+    /// result is then composited onto the scene
+    std::vector<std::function<void()>> orderIndependentTransparencyTasks;
 };
 
 struct RaycastData {
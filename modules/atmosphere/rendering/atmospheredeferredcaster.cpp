@@ -60,12 +60,14 @@
 #include <openspace/query/query.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
-#include <openspace/util/spicemanager.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/openglstatecache.h>
+#include <array>
 #include <cmath>
 #include <fstream>
+#include <limits>
 
 namespace {
     constexpr std::string_view _loggerCat = "AtmosphereDeferredcaster";
@@ -73,6 +75,26 @@ namespace {
     constexpr float ATM_EPS = 2000.f;
     constexpr float KM_TO_M = 1000.f;
 
+    // This needs to be increased whenever the precalculation shaders or the layout of
+    // the cached tables change
+    constexpr int8_t CurrentCacheVersion = 1;
+
+    std::vector<float> readTexture(GLenum target, GLuint texture, GLenum format,
+                                   size_t nValues)
+    {
+        std::vector<float> values(nValues);
+        glBindTexture(target, texture);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTexImage(target, 0, format, GL_FLOAT, values.data());
+        return values;
+    }
+
+    template <typename T>
+    bool readValue(std::ifstream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return file.good();
+    }
+
     template <GLenum colorBufferAttachment = GL_COLOR_ATTACHMENT0>
     void saveTextureFile(const std::filesystem::path& fileName, const glm::ivec2& size) {
         std::ofstream ppmFile(fileName);
@@ -220,6 +242,48 @@ namespace {
 
 namespace openspace {
 
+struct AtmosphereDeferredcaster::Calculation {
+    CalculationStage stage = CalculationStage::Transmittance;
+    int scatteringOrder = 2;
+    int layer = 0;
+
+    // The new tables. They replace the ones that are used for rendering once the whole
+    // calculation has finished
+    GLuint transmittanceTable = 0;
+    GLuint irradianceTable = 0;
+    GLuint inScatteringTable = 0;
+
+    GLuint deltaETable = 0;
+    GLuint deltaSRayleighTable = 0;
+    GLuint deltaSMieTable = 0;
+    GLuint deltaJTable = 0;
+
+    GLuint framebuffer = 0;
+    GLuint quadVao = 0;
+    GLuint quadVbo = 0;
+
+    std::unique_ptr<ghoul::opengl::ProgramObject> transmittanceProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> irradianceProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> inScatteringProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> deltaEProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> deltaSProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> deltaJProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> irradianceSupTermsProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> inScatteringSupTermsProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> irradianceFinalProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> deltaSSupTermsProgram;
+
+    std::filesystem::path cacheFile;
+
+    // The GPU time of the steps in a frame is measured with two queries that are used
+    // alternately, so that the result of the older one is available without stalling
+    std::array<GLuint, 2> queries = { 0, 0 };
+    std::array<int, 2> nQueriedSteps = { 0, 0 };
+    unsigned int queryIndex = 0;
+    // The last measured GPU time of a single step in milliseconds
+    float stepTime = 0.f;
+};
+
 AtmosphereDeferredcaster::AtmosphereDeferredcaster(float textureScale,
                                        std::vector<ShadowConfiguration> shadowConfigArray,
                                                               bool saveCalculatedTextures)
@@ -239,6 +303,8 @@ AtmosphereDeferredcaster::AtmosphereDeferredcaster(float textureScale,
     _shadowDataArrayCache.reserve(_shadowConfArray.size());
 }
 
+AtmosphereDeferredcaster::~AtmosphereDeferredcaster() = default;
+
 void AtmosphereDeferredcaster::initialize() {
     ZoneScoped;
 
@@ -251,12 +317,53 @@ void AtmosphereDeferredcaster::initialize() {
 void AtmosphereDeferredcaster::deinitialize() {
     ZoneScoped;
 
+    releaseCalculation();
     glDeleteTextures(1, &_transmittanceTableTexture);
     glDeleteTextures(1, &_irradianceTableTexture);
     glDeleteTextures(1, &_inScatteringTableTexture);
 }
 
-void AtmosphereDeferredcaster::update(const UpdateData&) {}
+void AtmosphereDeferredcaster::update(const UpdateData&) {
+    if (!_calculation) {
+        return;
+    }
+    ZoneScoped;
+
+    Calculation& c = *_calculation;
+    if (c.queries[0] == 0) {
+        glGenQueries(2, c.queries.data());
+    }
+
+    // The query that is reused in this frame was issued two frames ago, so its result is
+    // usually available by now. If it is not, the last measurement is used instead
+    const GLuint query = c.queries[c.queryIndex];
+    if (c.nQueriedSteps[c.queryIndex] > 0) {
+        GLuint isAvailable = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable) {
+            GLuint64 nanoseconds = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+            c.stepTime = static_cast<float>(nanoseconds) / 1e6f /
+                static_cast<float>(c.nQueriedSteps[c.queryIndex]);
+        }
+    }
+
+    // Until the first measurement is available, a single step is done per frame
+    int nSteps = 1;
+    if (c.stepTime > 0.f) {
+        nSteps = std::max(static_cast<int>(_calculationBudget / c.stepTime), 1);
+    }
+    c.nQueriedSteps[c.queryIndex] = nSteps;
+
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    const bool isFinished = advanceCalculation(nSteps);
+    glEndQuery(GL_TIME_ELAPSED);
+    c.queryIndex = 1 - c.queryIndex;
+
+    if (isFinished) {
+        finishCalculation();
+    }
+}
 
 float AtmosphereDeferredcaster::eclipseShadow(const glm::dvec3& position) {
     // This code is copied from the atmosphere deferred fragment shader
@@ -265,7 +372,7 @@ float AtmosphereDeferredcaster::eclipseShadow(const glm::dvec3& position) {
         return 1.f;
     }
 
-    const ShadowRenderingStruct& shadow = _shadowDataArrayCache.front();
+    const EclipseShadows::Shadow& shadow = _shadowDataArrayCache.front();
     const glm::dvec3 positionToCaster = shadow.casterPositionVec - position;
     const glm::dvec3 sourceToCaster = shadow.sourceCasterVec; // Normalized
     const glm::dvec3 casterShadow =
@@ -391,95 +498,33 @@ void AtmosphereDeferredcaster::preRaycast(const RenderData& data, const Deferred
         // Sun Position in Object Space
         program.setUniform(_uniformCache.sunDirectionObj, glm::normalize(sunPosObj));
 
-        // Shadow calculations..
+        // Shadow calculations. The positions of the sources and casters are shared with
+        // all other atmospheres and globes that are rendered at the same time
+        EclipseShadows& eclipseShadows = global::renderEngine->eclipseShadows();
         _shadowDataArrayCache.clear();
         for (ShadowConfiguration& shadowConf : _shadowConfArray) {
-            // TO REMEMBER: all distances and lengths in world coordinates are in
-            // meters!!! We need to move this to view space...
-            double lt = 0.0;
-            glm::dvec3 sourcePos = SpiceManager::ref().targetPosition(
-                shadowConf.source.first,
-                "SSB",
-                "GALACTIC",
-                {},
-                data.time.j2000Seconds(),
-                lt
-            );
-            sourcePos *= KM_TO_M; // converting to meters
-            glm::dvec3 casterPos = SpiceManager::ref().targetPosition(
-                shadowConf.caster.first,
-                "SSB",
-                "GALACTIC",
-                {},
-                data.time.j2000Seconds(),
-                lt
+            const std::optional<EclipseShadows::Shadow> shadow = eclipseShadows.shadow(
+                shadowConf.source,
+                shadowConf.caster,
+                data.modelTransform.translation,
+                _atmospherePlanetRadius * KM_TO_M,
+                sunPosWorld,
+                data.time.j2000Seconds()
             );
-            casterPos *= KM_TO_M; // converting to meters
-
-            SceneGraphNode* sourceNode = sceneGraphNode(shadowConf.source.first);
-            if (!sourceNode) {
+            if (!shadow.has_value()) {
                 if (!shadowConf.printedSourceError) {
-                    LERROR("Invalid scenegraph node for the shadow's receiver");
+                    LERROR("Invalid scenegraph node for the shadow's source or caster");
                     shadowConf.printedSourceError = true;
-                }
-                return;
-            }
-            SceneGraphNode* casterNode = sceneGraphNode(shadowConf.caster.first);
-            if (!casterNode) {
-                if (!shadowConf.printedCasterError) {
-                    LERROR("Invalid scenegraph node for the shadow's caster");
                     shadowConf.printedCasterError = true;
                 }
                 return;
             }
-
-            const double sourceScale = std::max(glm::compMax(sourceNode->scale()), 1.0);
-            const double casterScale = std::max(glm::compMax(casterNode->scale()), 1.0);
-            const double actualSourceRadius = shadowConf.source.second * sourceScale;
-            const double actualCasterRadius = shadowConf.caster.second * casterScale;
-            // First we determine if the caster is shadowing the current planet
-            // (all calculations in World Coordinates):
-            const glm::dvec3 planetCasterVec =
-                casterPos - data.modelTransform.translation;
-            const glm::dvec3 sourceCasterVec = casterPos - sourcePos;
-            const double scLength = glm::length(sourceCasterVec);
-            const glm::dvec3 planetCasterProj =
-                (glm::dot(planetCasterVec, sourceCasterVec) / (scLength * scLength)) *
-                sourceCasterVec;
-            const double dTest = glm::length(planetCasterVec - planetCasterProj);
-            const double xpTest = actualCasterRadius * scLength /
-                (actualSourceRadius + actualCasterRadius);
-            const double rpTest = actualCasterRadius *
-                (glm::length(planetCasterProj) + xpTest) / xpTest;
-
-            const double casterDistSun = glm::length(casterPos - sunPosWorld);
-            const double planetDistSun = glm::length(
-                data.modelTransform.translation - sunPosWorld
-            );
-
-            ShadowRenderingStruct shadow;
-            shadow.isShadowing = false;
-
-            if (((dTest - rpTest) < (_atmospherePlanetRadius * KM_TO_M)) &&
-                (casterDistSun < planetDistSun))
-            {
-                // The current caster is shadowing the current planet
-                shadow.isShadowing = true;
-                shadow.radiusSource = actualSourceRadius;
-                shadow.radiusCaster = actualCasterRadius;
-                shadow.sourceCasterVec = glm::normalize(sourceCasterVec);
-                shadow.penumbra = xpTest;
-                shadow.umbra =
-                    shadow.radiusCaster * scLength /
-                    (shadow.radiusSource - shadow.radiusCaster);
-                shadow.casterPositionVec = casterPos;
-            }
-            _shadowDataArrayCache.push_back(shadow);
+            _shadowDataArrayCache.push_back(*shadow);
         }
 
         // _uniformNameBuffer[0..15] = "shadowDataArray["
         unsigned int counter = 0;
-        for (const ShadowRenderingStruct& sd : _shadowDataArrayCache) {
+        for (const EclipseShadows::Shadow& sd : _shadowDataArrayCache) {
             // Add the counter
             char* bf = std::format_to(_uniformNameBuffer + 16, "{}", counter);
 
@@ -600,27 +645,22 @@ void AtmosphereDeferredcaster::calculateTransmittance() {
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _transmittanceTableTexture,
+        _calculation->transmittanceTable,
         0
     );
     glViewport(0, 0, _transmittanceTableSize.x, _transmittanceTableSize.y);
-    using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
-        "Transmittance Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/transmittance_calc_fs.glsl")
-    );
-    program->activate();
-    program->setUniform("Rg", _atmospherePlanetRadius);
-    program->setUniform("Rt", _atmosphereRadius);
-    program->setUniform("HR", _rayleighHeightScale);
-    program->setUniform("betaRayleigh", _rayleighScatteringCoeff);
-    program->setUniform("HM", _mieHeightScale);
-    program->setUniform("betaMieExtinction", _mieExtinctionCoeff);
-    program->setUniform("TRANSMITTANCE", _transmittanceTableSize);
-    program->setUniform("ozoneLayerEnabled", _ozoneEnabled);
-    program->setUniform("HO", _ozoneHeightScale);
-    program->setUniform("betaOzoneExtinction", _ozoneExtinctionCoeff);
+    ghoul::opengl::ProgramObject& program = *_calculation->transmittanceProgram;
+    program.activate();
+    program.setUniform("Rg", _atmospherePlanetRadius);
+    program.setUniform("Rt", _atmosphereRadius);
+    program.setUniform("HR", _rayleighHeightScale);
+    program.setUniform("betaRayleigh", _rayleighScatteringCoeff);
+    program.setUniform("HM", _mieHeightScale);
+    program.setUniform("betaMieExtinction", _mieExtinctionCoeff);
+    program.setUniform("TRANSMITTANCE", _transmittanceTableSize);
+    program.setUniform("ozoneLayerEnabled", _ozoneEnabled);
+    program.setUniform("HO", _ozoneHeightScale);
+    program.setUniform("betaOzoneExtinction", _ozoneExtinctionCoeff);
 
     constexpr glm::vec4 Black = glm::vec4(0.f, 0.f, 0.f, 0.f);
     glClearBufferfv(GL_COLOR, 0, glm::value_ptr(Black));
@@ -628,78 +668,78 @@ void AtmosphereDeferredcaster::calculateTransmittance() {
     if (_saveCalculationTextures) {
         saveTextureFile("transmittance_texture.ppm", _transmittanceTableSize);
     }
-    program->deactivate();
+    program.deactivate();
 }
 
-GLuint AtmosphereDeferredcaster::calculateDeltaE() {
+void AtmosphereDeferredcaster::calculateDeltaE() {
     ZoneScoped;
 
-    const GLuint deltaE = createTexture(_deltaETableSize, "DeltaE");
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, deltaE, 0);
-    glViewport(0, 0, _deltaETableSize.x, _deltaETableSize.y);
-    using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
-        "Irradiance Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/irradiance_calc_fs.glsl")
+    glFramebufferTexture(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        _calculation->deltaETable,
+        0
     );
-    program->activate();
+    glViewport(0, 0, _deltaETableSize.x, _deltaETableSize.y);
+    ghoul::opengl::ProgramObject& program = *_calculation->irradianceProgram;
+    program.activate();
     ghoul::opengl::TextureUnit unit;
     unit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
-    program->setUniform("transmittanceTexture", unit);
-    program->setUniform("Rg", _atmospherePlanetRadius);
-    program->setUniform("Rt", _atmosphereRadius);
-    program->setUniform("OTHER_TEXTURES", _deltaETableSize);
+    glBindTexture(GL_TEXTURE_2D, _calculation->transmittanceTable);
+    program.setUniform("transmittanceTexture", unit);
+    program.setUniform("Rg", _atmospherePlanetRadius);
+    program.setUniform("Rt", _atmosphereRadius);
+    program.setUniform("OTHER_TEXTURES", _deltaETableSize);
     glClear(GL_COLOR_BUFFER_BIT);
     glDrawArrays(GL_TRIANGLES, 0, 6);
     if (_saveCalculationTextures) {
         saveTextureFile("deltaE_table_texture.ppm", _deltaETableSize);
     }
-    program->deactivate();
-    return deltaE;
+    program.deactivate();
 }
 
-std::pair<GLuint, GLuint> AtmosphereDeferredcaster::calculateDeltaS() {
+void AtmosphereDeferredcaster::calculateDeltaS(int layer) {
     ZoneScoped;
 
-    const GLuint deltaSRayleigh = createTexture(_textureSize, "DeltaS Rayleigh", 3);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, deltaSRayleigh, 0);
-    const GLuint deltaSMie = createTexture(_textureSize, "DeltaS Mie", 3);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, deltaSMie, 0);
+    glFramebufferTexture(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        _calculation->deltaSRayleighTable,
+        0
+    );
+    glFramebufferTexture(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT1,
+        _calculation->deltaSMieTable,
+        0
+    );
     std::array<GLenum, 2> colorBuffers = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
     glDrawBuffers(2, colorBuffers.data());
     glViewport(0, 0, _textureSize.x, _textureSize.y);
-    using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
-        "InScattering Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/inScattering_calc_fs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
-    );
-    program->activate();
+    ghoul::opengl::ProgramObject& program = *_calculation->inScatteringProgram;
+    program.activate();
     ghoul::opengl::TextureUnit unit;
     unit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
-    program->setUniform("transmittanceTexture", unit);
-    program->setUniform("Rg", _atmospherePlanetRadius);
-    program->setUniform("Rt", _atmosphereRadius);
-    program->setUniform("HR", _rayleighHeightScale);
-    program->setUniform("betaRayleigh", _rayleighScatteringCoeff);
-    program->setUniform("HM", _mieHeightScale);
-    program->setUniform("betaMieScattering", _mieScatteringCoeff);
-    program->setUniform("SAMPLES_MU_S", _muSSamples);
-    program->setUniform("SAMPLES_NU", _nuSamples);
-    program->setUniform("SAMPLES_MU", _muSamples);
-    program->setUniform("ozoneLayerEnabled", _ozoneEnabled);
-    program->setUniform("HO", _ozoneHeightScale);
-    glClear(GL_COLOR_BUFFER_BIT);
-    for (int layer = 0; layer < _rSamples; ++layer) {
-        program->setUniform("layer", layer);
-        step3DTexture(*program, layer);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindTexture(GL_TEXTURE_2D, _calculation->transmittanceTable);
+    program.setUniform("transmittanceTexture", unit);
+    program.setUniform("Rg", _atmospherePlanetRadius);
+    program.setUniform("Rt", _atmosphereRadius);
+    program.setUniform("HR", _rayleighHeightScale);
+    program.setUniform("betaRayleigh", _rayleighScatteringCoeff);
+    program.setUniform("HM", _mieHeightScale);
+    program.setUniform("betaMieScattering", _mieScatteringCoeff);
+    program.setUniform("SAMPLES_MU_S", _muSSamples);
+    program.setUniform("SAMPLES_NU", _nuSamples);
+    program.setUniform("SAMPLES_MU", _muSamples);
+    program.setUniform("ozoneLayerEnabled", _ozoneEnabled);
+    program.setUniform("HO", _ozoneHeightScale);
+    if (layer == 0) {
+        glClear(GL_COLOR_BUFFER_BIT);
     }
-    if (_saveCalculationTextures) {
+    program.setUniform("layer", layer);
+    step3DTexture(program, layer);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (_saveCalculationTextures && layer == _rSamples - 1) {
         saveTextureFile("deltaS_rayleigh_texture.ppm", glm::ivec2(_textureSize));
         saveTextureFile<GL_COLOR_ATTACHMENT1>(
             "deltaS_mie_texture.ppm",
@@ -710,8 +750,7 @@ std::pair<GLuint, GLuint> AtmosphereDeferredcaster::calculateDeltaS() {
     const std::array<GLenum, 1> drawBuffers = { GL_COLOR_ATTACHMENT0 };
     glDrawBuffers(1, drawBuffers.data());
 
-    program->deactivate();
-    return { deltaSRayleigh, deltaSMie };
+    program.deactivate();
 }
 
 void AtmosphereDeferredcaster::calculateIrradiance() {
@@ -720,102 +759,91 @@ void AtmosphereDeferredcaster::calculateIrradiance() {
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _irradianceTableTexture,
+        _calculation->irradianceTable,
         0
     );
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
 
     glViewport(0, 0, _deltaETableSize.x, _deltaETableSize.y);
-    using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
-        "DeltaE Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/deltaE_calc_fs.glsl")
-    );
-    program->activate();
+    ghoul::opengl::ProgramObject& program = *_calculation->deltaEProgram;
+    program.activate();
     glClear(GL_COLOR_BUFFER_BIT);
     glDrawArrays(GL_TRIANGLES, 0, 6);
     if (_saveCalculationTextures) {
         saveTextureFile("irradiance_texture.ppm", _deltaETableSize);
     }
-    program->deactivate();
+    program.deactivate();
 }
 
-void AtmosphereDeferredcaster::calculateInscattering(GLuint deltaSRayleigh,
-                                                     GLuint deltaSMie)
-{
+void AtmosphereDeferredcaster::calculateInscattering(int layer) {
     ZoneScoped;
 
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _inScatteringTableTexture,
+        _calculation->inScatteringTable,
         0
     );
     glViewport(0, 0, _textureSize.x, _textureSize.y);
-    using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
-        "deltaSCalcProgram",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/deltaS_calc_fs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
-    );
-    program->activate();
+    ghoul::opengl::ProgramObject& program = *_calculation->deltaSProgram;
+    program.activate();
 
     ghoul::opengl::TextureUnit deltaSRayleighUnit;
     deltaSRayleighUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSRayleigh);
-    program->setUniform("deltaSRTexture", deltaSRayleighUnit);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSRayleighTable);
+    program.setUniform("deltaSRTexture", deltaSRayleighUnit);
 
     ghoul::opengl::TextureUnit deltaSMieUnit;
     deltaSMieUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSMie);
-    program->setUniform("deltaSMTexture", deltaSMieUnit);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSMieTable);
+    program.setUniform("deltaSMTexture", deltaSMieUnit);
 
-    program->setUniform("SAMPLES_MU_S", _muSSamples);
-    program->setUniform("SAMPLES_NU", _nuSamples);
-    program->setUniform("SAMPLES_MU", _muSamples);
-    program->setUniform("SAMPLES_R", _rSamples);
-    glClear(GL_COLOR_BUFFER_BIT);
-    for (int layer = 0; layer < _rSamples; ++layer) {
-        program->setUniform("layer", layer);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    program.setUniform("SAMPLES_MU_S", _muSSamples);
+    program.setUniform("SAMPLES_NU", _nuSamples);
+    program.setUniform("SAMPLES_MU", _muSamples);
+    program.setUniform("SAMPLES_R", _rSamples);
+    if (layer == 0) {
+        glClear(GL_COLOR_BUFFER_BIT);
     }
-    if (_saveCalculationTextures) {
+    program.setUniform("layer", layer);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (_saveCalculationTextures && layer == _rSamples - 1) {
         saveTextureFile("S_texture.ppm", glm::ivec2(_textureSize));
     }
-    program->deactivate();
+    program.deactivate();
 }
 
-void AtmosphereDeferredcaster::calculateDeltaJ(int scatteringOrder,
-                                               ghoul::opengl::ProgramObject& program,
-                                               GLuint deltaJ, GLuint deltaE,
-                                               GLuint deltaSRayleigh, GLuint deltaSMie)
-{
+void AtmosphereDeferredcaster::calculateDeltaJ(int scatteringOrder, int layer) {
     ZoneScoped;
 
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, deltaJ, 0);
+    glFramebufferTexture(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        _calculation->deltaJTable,
+        0
+    );
     glViewport(0, 0, _textureSize.x, _textureSize.y);
+    ghoul::opengl::ProgramObject& program = *_calculation->deltaJProgram;
     program.activate();
 
     ghoul::opengl::TextureUnit transmittanceUnit;
     transmittanceUnit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glBindTexture(GL_TEXTURE_2D, _calculation->transmittanceTable);
     program.setUniform("transmittanceTexture", transmittanceUnit);
 
     ghoul::opengl::TextureUnit deltaEUnit;
     deltaEUnit.activate();
-    glBindTexture(GL_TEXTURE_2D, deltaE);
+    glBindTexture(GL_TEXTURE_2D, _calculation->deltaETable);
     program.setUniform("deltaETexture", deltaEUnit);
 
     ghoul::opengl::TextureUnit deltaSRayleighUnit;
     deltaSRayleighUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSRayleigh);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSRayleighTable);
     program.setUniform("deltaSRTexture", deltaSRayleighUnit);
 
     ghoul::opengl::TextureUnit deltaSMieUnit;
     deltaSMieUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSMie);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSMieTable);
     program.setUniform("deltaSMTexture", deltaSMieUnit);
 
     program.setUniform("firstIteration", (scatteringOrder == 2) ? 1 : 0);
@@ -831,12 +859,10 @@ void AtmosphereDeferredcaster::calculateDeltaJ(int scatteringOrder,
     program.setUniform("SAMPLES_NU", _nuSamples);
     program.setUniform("SAMPLES_MU", _muSamples);
     program.setUniform("SAMPLES_R", _rSamples);
-    for (int layer = 0; layer < _rSamples; ++layer) {
-        program.setUniform("layer", layer);
-        step3DTexture(program, layer);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-    }
-    if (_saveCalculationTextures) {
+    program.setUniform("layer", layer);
+    step3DTexture(program, layer);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (_saveCalculationTextures && layer == _rSamples - 1) {
         saveTextureFile(
             std::format("deltaJ_texture-scattering_order-{}.ppm", scatteringOrder),
             glm::ivec2(_textureSize)
@@ -845,25 +871,27 @@ void AtmosphereDeferredcaster::calculateDeltaJ(int scatteringOrder,
     program.deactivate();
 }
 
-void AtmosphereDeferredcaster::calculateDeltaE(int scatteringOrder,
-                                               ghoul::opengl::ProgramObject& program,
-                                               GLuint deltaE, GLuint deltaSRayleigh,
-                                               GLuint deltaSMie)
-{
+void AtmosphereDeferredcaster::calculateDeltaE(int scatteringOrder) {
     ZoneScoped;
 
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, deltaE, 0);
+    glFramebufferTexture(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        _calculation->deltaETable,
+        0
+    );
     glViewport(0, 0, _deltaETableSize.x, _deltaETableSize.y);
+    ghoul::opengl::ProgramObject& program = *_calculation->irradianceSupTermsProgram;
     program.activate();
 
     ghoul::opengl::TextureUnit deltaSRayleighUnit;
     deltaSRayleighUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSRayleigh);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSRayleighTable);
     program.setUniform("deltaSRTexture", deltaSRayleighUnit);
 
     ghoul::opengl::TextureUnit deltaSMieUnit;
     deltaSMieUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSMie);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSMieTable);
     program.setUniform("deltaSMTexture", deltaSMieUnit);
 
     program.setUniform("firstIteration", (scatteringOrder == 2) ? 1 : 0);
@@ -885,24 +913,27 @@ void AtmosphereDeferredcaster::calculateDeltaE(int scatteringOrder,
     program.deactivate();
 }
 
-void AtmosphereDeferredcaster::calculateDeltaS(int scatteringOrder,
-                                               ghoul::opengl::ProgramObject& program,
-                                               GLuint deltaSRayleigh, GLuint deltaJ)
-{
+void AtmosphereDeferredcaster::calculateDeltaS(int scatteringOrder, int layer) {
     ZoneScoped;
 
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, deltaSRayleigh, 0);
+    glFramebufferTexture(
+        GL_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        _calculation->deltaSRayleighTable,
+        0
+    );
     glViewport(0, 0, _textureSize.x, _textureSize.y);
+    ghoul::opengl::ProgramObject& program = *_calculation->inScatteringSupTermsProgram;
     program.activate();
 
     ghoul::opengl::TextureUnit transmittanceUnit;
     transmittanceUnit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glBindTexture(GL_TEXTURE_2D, _calculation->transmittanceTable);
     program.setUniform("transmittanceTexture", transmittanceUnit);
 
     ghoul::opengl::TextureUnit deltaJUnit;
     deltaJUnit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaJ);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaJTable);
     program.setUniform("deltaJTexture", deltaJUnit);
 
     program.setUniform("Rg", _atmospherePlanetRadius);
@@ -911,12 +942,10 @@ void AtmosphereDeferredcaster::calculateDeltaS(int scatteringOrder,
     program.setUniform("SAMPLES_NU", _nuSamples);
     program.setUniform("SAMPLES_MU", _muSamples);
     program.setUniform("SAMPLES_R", _rSamples);
-    for (int layer = 0; layer < _rSamples; ++layer) {
-        program.setUniform("layer", layer);
-        step3DTexture(program, layer);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-    }
-    if (_saveCalculationTextures) {
+    program.setUniform("layer", layer);
+    step3DTexture(program, layer);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (_saveCalculationTextures && layer == _rSamples - 1) {
         saveTextureFile(
             std::format("deltaS_texture-scattering_order-{}.ppm", scatteringOrder),
             glm::ivec2(_textureSize)
@@ -925,24 +954,22 @@ void AtmosphereDeferredcaster::calculateDeltaS(int scatteringOrder,
     program.deactivate();
 }
 
-void AtmosphereDeferredcaster::calculateIrradiance(int scatteringOrder,
-                                                   ghoul::opengl::ProgramObject& program,
-                                                   GLuint deltaE)
-{
+void AtmosphereDeferredcaster::calculateIrradiance(int scatteringOrder) {
     ZoneScoped;
 
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _irradianceTableTexture,
+        _calculation->irradianceTable,
         0
     );
     glViewport(0, 0, _deltaETableSize.x, _deltaETableSize.y);
+    ghoul::opengl::ProgramObject& program = *_calculation->irradianceFinalProgram;
     program.activate();
 
     ghoul::opengl::TextureUnit unit;
     unit.activate();
-    glBindTexture(GL_TEXTURE_2D, deltaE);
+    glBindTexture(GL_TEXTURE_2D, _calculation->deltaETable);
     program.setUniform("deltaETexture", unit);
     program.setUniform("OTHER_TEXTURES", _deltaETableSize);
 
@@ -956,35 +983,30 @@ void AtmosphereDeferredcaster::calculateIrradiance(int scatteringOrder,
     program.deactivate();
 }
 
-void AtmosphereDeferredcaster::calculateInscattering(int scatteringOrder,
-                                                    ghoul::opengl::ProgramObject& program,
-                                                                    GLuint deltaSRayleigh)
-
-{
+void AtmosphereDeferredcaster::calculateInscattering(int scatteringOrder, int layer) {
     ZoneScoped;
 
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _inScatteringTableTexture,
+        _calculation->inScatteringTable,
         0
     );
     glViewport(0, 0, _textureSize.x, _textureSize.y);
+    ghoul::opengl::ProgramObject& program = *_calculation->deltaSSupTermsProgram;
     program.activate();
 
     ghoul::opengl::TextureUnit unit;
     unit.activate();
-    glBindTexture(GL_TEXTURE_3D, deltaSRayleigh);
+    glBindTexture(GL_TEXTURE_3D, _calculation->deltaSRayleighTable);
     program.setUniform("deltaSTexture", unit);
     program.setUniform("SAMPLES_MU_S", _muSSamples);
     program.setUniform("SAMPLES_NU", _nuSamples);
     program.setUniform("SAMPLES_MU", _muSamples);
     program.setUniform("SAMPLES_R", _rSamples);
-    for (int layer = 0; layer < _rSamples; ++layer) {
-        program.setUniform("layer", layer);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-    }
-    if (_saveCalculationTextures) {
+    program.setUniform("layer", layer);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    if (_saveCalculationTextures && layer == _rSamples - 1) {
         saveTextureFile(
             std::format("inscatteringTable_order-{}.ppm", scatteringOrder),
             glm::ivec2(_textureSize)
@@ -996,58 +1018,117 @@ void AtmosphereDeferredcaster::calculateInscattering(int scatteringOrder,
 void AtmosphereDeferredcaster::calculateAtmosphereParameters() {
     ZoneScoped;
 
-    using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> deltaJProgram = ProgramObject::Build(
+    if (!beginCalculation()) {
+        return;
+    }
+    advanceCalculation(std::numeric_limits<int>::max());
+    finishCalculation();
+}
+
+void AtmosphereDeferredcaster::beginAtmosphereCalculation(float gpuBudget) {
+    ZoneScoped;
+
+    ghoul_assert(gpuBudget > 0.f, "GPU budget must be positive");
+    _calculationBudget = gpuBudget;
+    beginCalculation();
+}
+
+bool AtmosphereDeferredcaster::beginCalculation() {
+    ZoneScoped;
+
+    // A calculation that is still in progress used the previous parameters
+    releaseCalculation();
+
+    // The textures are only saved as images when they are calculated, so the cache is not
+    // used in that case
+    const std::filesystem::path cacheFile = tablesCacheFile();
+    if (!_saveCalculationTextures && !cacheFile.empty() && loadCachedTables(cacheFile)) {
+        LDEBUG(std::format("Loaded atmosphere tables from '{}'", cacheFile));
+        return false;
+    }
+
+    _calculation = std::make_unique<Calculation>();
+    Calculation& c = *_calculation;
+    c.cacheFile = cacheFile;
+
+    c.transmittanceTable = createTexture(_transmittanceTableSize, "Transmittance");
+    c.irradianceTable = createTexture(_irradianceTableSize, "Irradiance");
+    c.inScatteringTable = createTexture(_textureSize, "InScattering", 4);
+    c.deltaETable = createTexture(_deltaETableSize, "DeltaE");
+    c.deltaSRayleighTable = createTexture(_textureSize, "DeltaS Rayleigh", 3);
+    c.deltaSMieTable = createTexture(_textureSize, "DeltaS Mie", 3);
+    c.deltaJTable = createTexture(_textureSize, "DeltaJ", 3);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindTexture(GL_TEXTURE_3D, 0);
+
+    const std::filesystem::path vs =
+        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl");
+    const std::filesystem::path gs =
+        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl");
+    c.transmittanceProgram = global::renderEngine->buildCachedProgram(
+        "Transmittance Program",
+        vs,
+        absPath("${MODULE_ATMOSPHERE}/shaders/transmittance_calc_fs.glsl")
+    );
+    c.irradianceProgram = global::renderEngine->buildCachedProgram(
+        "Irradiance Program",
+        vs,
+        absPath("${MODULE_ATMOSPHERE}/shaders/irradiance_calc_fs.glsl")
+    );
+    c.inScatteringProgram = global::renderEngine->buildCachedProgram(
+        "InScattering Program",
+        vs,
+        absPath("${MODULE_ATMOSPHERE}/shaders/inScattering_calc_fs.glsl"),
+        gs
+    );
+    c.deltaEProgram = global::renderEngine->buildCachedProgram(
+        "DeltaE Program",
+        vs,
+        absPath("${MODULE_ATMOSPHERE}/shaders/deltaE_calc_fs.glsl")
+    );
+    c.deltaSProgram = global::renderEngine->buildCachedProgram(
+        "deltaSCalcProgram",
+        vs,
+        absPath("${MODULE_ATMOSPHERE}/shaders/deltaS_calc_fs.glsl"),
+        gs
+    );
+    c.deltaJProgram = global::renderEngine->buildCachedProgram(
         "DeltaJ Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
+        vs,
         absPath("${MODULE_ATMOSPHERE}/shaders/deltaJ_calc_fs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
+        gs
     );
-    std::unique_ptr<ProgramObject> irradianceSupTermsProgram = ProgramObject::Build(
+    c.irradianceSupTermsProgram = global::renderEngine->buildCachedProgram(
         "IrradianceSupTerms Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
+        vs,
         absPath("${MODULE_ATMOSPHERE}/shaders/irradiance_sup_calc_fs.glsl")
     );
-    std::unique_ptr<ProgramObject> inScatteringSupTermsProgram = ProgramObject::Build(
+    c.inScatteringSupTermsProgram = global::renderEngine->buildCachedProgram(
         "InScatteringSupTerms Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
+        vs,
         absPath("${MODULE_ATMOSPHERE}/shaders/inScattering_sup_calc_fs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
+        gs
     );
-    std::unique_ptr<ProgramObject> irradianceFinalProgram = ProgramObject::Build(
+    c.irradianceFinalProgram = global::renderEngine->buildCachedProgram(
         "IrradianceEFinal Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
+        vs,
         absPath("${MODULE_ATMOSPHERE}/shaders/irradiance_final_fs.glsl")
     );
-    std::unique_ptr<ProgramObject> deltaSSupTermsProgram = ProgramObject::Build(
+    c.deltaSSupTermsProgram = global::renderEngine->buildCachedProgram(
         "DeltaSSUPTerms Program",
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
+        vs,
         absPath("${MODULE_ATMOSPHERE}/shaders/deltaS_sup_calc_fs.glsl"),
-        absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
+        gs
     );
 
-
-    // Saves current FBO first
-    GLint defaultFBO = 0;
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &defaultFBO);
-
-    std::array<GLint, 4> viewport;
-    global::renderEngine->openglStateCache().viewport(viewport.data());
-
     // Creates the FBO for the calculations
-    GLuint calcFBO = 0;
-    glGenFramebuffers(1, &calcFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, calcFBO);
-    std::array<GLenum, 1> drawBuffers = { GL_COLOR_ATTACHMENT0 };
-    glDrawBuffers(1, drawBuffers.data());
+    glGenFramebuffers(1, &c.framebuffer);
 
     // Prepare for rendering/calculations
-    GLuint quadVao = 0;
-    glGenVertexArrays(1, &quadVao);
-    glBindVertexArray(quadVao);
-    GLuint quadVbo = 0;
-    glGenBuffers(1, &quadVbo);
-    glBindBuffer(GL_ARRAY_BUFFER, quadVbo);
+    glGenVertexArrays(1, &c.quadVao);
+    glBindVertexArray(c.quadVao);
+    glGenBuffers(1, &c.quadVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, c.quadVbo);
 
     constexpr std::array<GLfloat, 12> VertexData = {
         // x     y
@@ -1062,95 +1143,328 @@ void AtmosphereDeferredcaster::calculateAtmosphereParameters() {
     glBufferData(GL_ARRAY_BUFFER, sizeof(VertexData), VertexData.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+    glBindVertexArray(0);
 
-    // Execute Calculations
     LDEBUG("Starting precalculations for scattering effects");
+    return true;
+}
+
+void AtmosphereDeferredcaster::performCalculationStep() {
+    Calculation& c = *_calculation;
+
+    // See Precomputed Atmosphere Scattering from Bruneton et al. paper, algorithm 4.1.
+    // A step is a single pass over a 2D table or a single layer of a 3D table
+    bool is3D = false;
+    switch (c.stage) {
+        case CalculationStage::Transmittance:
+            calculateTransmittance();
+            break;
+        case CalculationStage::DeltaE:
+            // line 2 in algorithm 4.1
+            calculateDeltaE();
+            break;
+        case CalculationStage::DeltaS:
+            // line 3 in algorithm 4.1
+            calculateDeltaS(c.layer);
+            is3D = true;
+            break;
+        case CalculationStage::Irradiance:
+            // line 4 in algorithm 4.1
+            calculateIrradiance();
+            break;
+        case CalculationStage::Inscattering:
+            // line 5 in algorithm 4.1
+            calculateInscattering(c.layer);
+            is3D = true;
+            break;
+        case CalculationStage::DeltaJOrder:
+            // line 7 in algorithm 4.1
+            calculateDeltaJ(c.scatteringOrder, c.layer);
+            is3D = true;
+            break;
+        case CalculationStage::DeltaEOrder:
+            // line 8 in algorithm 4.1
+            calculateDeltaE(c.scatteringOrder);
+            break;
+        case CalculationStage::DeltaSOrder:
+            // line 9 in algorithm 4.1
+            calculateDeltaS(c.scatteringOrder, c.layer);
+            is3D = true;
+            break;
+        case CalculationStage::IrradianceOrder:
+            // line 10 in algorithm 4.1
+            glEnable(GL_BLEND);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+            calculateIrradiance(c.scatteringOrder);
+            glDisable(GL_BLEND);
+            break;
+        case CalculationStage::InscatteringOrder:
+            // line 11 in algorithm 4.1
+            glEnable(GL_BLEND);
+            glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+            glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+            calculateInscattering(c.scatteringOrder, c.layer);
+            glDisable(GL_BLEND);
+            is3D = true;
+            break;
+        case CalculationStage::Done:
+            return;
+    }
+
+    if (is3D && c.layer < _rSamples - 1) {
+        c.layer++;
+        return;
+    }
+    c.layer = 0;
+
+    if (c.stage != CalculationStage::InscatteringOrder) {
+        c.stage = static_cast<CalculationStage>(static_cast<int>(c.stage) + 1);
+    }
+    else if (c.scatteringOrder < 4) {
+        // loop in line 6 in algorithm 4.1
+        c.scatteringOrder++;
+        c.stage = CalculationStage::DeltaJOrder;
+    }
+    else {
+        c.stage = CalculationStage::Done;
+    }
+}
+
+bool AtmosphereDeferredcaster::advanceCalculation(int nSteps) {
+    ZoneScoped;
+
+    // Saves current FBO first
+    GLint defaultFBO = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &defaultFBO);
+
+    std::array<GLint, 4> viewport;
+    global::renderEngine->openglStateCache().viewport(viewport.data());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, _calculation->framebuffer);
+    std::array<GLenum, 1> drawBuffers = { GL_COLOR_ATTACHMENT0 };
+    glDrawBuffers(1, drawBuffers.data());
+    glBindVertexArray(_calculation->quadVao);
     glDisable(GL_BLEND);
 
-    // See Precomputed Atmosphere Scattering from Bruneton et al. paper, algorithm 4.1:
-    calculateTransmittance();
+    for (int i = 0; i < nSteps && _calculation->stage != CalculationStage::Done; i++) {
+        performCalculationStep();
+    }
 
-    // line 2 in algorithm 4.1
-    const GLuint deltaETable = calculateDeltaE();
+    // Restores system state
+    global::renderEngine->openglStateCache().resetBlendState();
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFBO);
+    global::renderEngine->openglStateCache().setViewportState(viewport.data());
+    glBindVertexArray(0);
 
-    // line 3 in algorithm 4.1
-    auto [deltaSRayleighTable, deltaSMieTable] = calculateDeltaS();
+    return _calculation->stage == CalculationStage::Done;
+}
 
-    // line 4 in algorithm 4.1
-    calculateIrradiance();
+void AtmosphereDeferredcaster::finishCalculation() {
+    ZoneScoped;
 
-    // line 5 in algorithm 4.1
-    calculateInscattering(deltaSRayleighTable, deltaSMieTable);
+    // The new tables replace the ones that have been used for rendering so far
+    std::swap(_transmittanceTableTexture, _calculation->transmittanceTable);
+    std::swap(_irradianceTableTexture, _calculation->irradianceTable);
+    std::swap(_inScatteringTableTexture, _calculation->inScatteringTable);
+    const std::filesystem::path cacheFile = _calculation->cacheFile;
+    releaseCalculation();
 
-    const GLuint deltaJTable = createTexture(_textureSize, "DeltaJ", 3);
+    LDEBUG("Ended precalculations for Atmosphere effects");
 
-    // loop in line 6 in algorithm 4.1
-    for (int scatteringOrder = 2; scatteringOrder <= 4; ++scatteringOrder) {
-        // line 7 in algorithm 4.1
-        calculateDeltaJ(
-            scatteringOrder,
-            *deltaJProgram,
-            deltaJTable,
-            deltaETable,
-            deltaSRayleighTable,
-            deltaSMieTable
-        );
+    if (!cacheFile.empty()) {
+        saveCachedTables(cacheFile);
+    }
+}
 
-        // line 8 in algorithm 4.1
-        calculateDeltaE(
-            scatteringOrder,
-            *irradianceSupTermsProgram,
-            deltaETable,
-            deltaSRayleighTable,
-            deltaSMieTable
-        );
+void AtmosphereDeferredcaster::releaseCalculation() {
+    if (!_calculation) {
+        return;
+    }
 
-        // line 9 in algorithm 4.1
-        calculateDeltaS(
-            scatteringOrder,
-            *inScatteringSupTermsProgram,
-            deltaSRayleighTable,
-            deltaJTable
-        );
+    Calculation& c = *_calculation;
+    glDeleteTextures(1, &c.transmittanceTable);
+    glDeleteTextures(1, &c.irradianceTable);
+    glDeleteTextures(1, &c.inScatteringTable);
+    glDeleteTextures(1, &c.deltaETable);
+    glDeleteTextures(1, &c.deltaSRayleighTable);
+    glDeleteTextures(1, &c.deltaSMieTable);
+    glDeleteTextures(1, &c.deltaJTable);
+    glDeleteFramebuffers(1, &c.framebuffer);
+    glDeleteBuffers(1, &c.quadVbo);
+    glDeleteVertexArrays(1, &c.quadVao);
+    if (c.queries[0] != 0) {
+        glDeleteQueries(2, c.queries.data());
+    }
+    _calculation = nullptr;
+}
 
-        glEnable(GL_BLEND);
-        glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+std::filesystem::path AtmosphereDeferredcaster::tablesCacheFile() const {
+    if (!FileSys.cacheManager()) {
+        return std::filesystem::path();
+    }
 
-        // line 10 in algorithm 4.1
-        calculateIrradiance(
-            scatteringOrder,
-            *irradianceFinalProgram,
-            deltaETable
-        );
+    std::string parameters = std::format(
+        "{}|{}|{}|{}|{}|{}|{}|{}|{}|{}",
+        _atmosphereRadius, _atmospherePlanetRadius, _averageGroundReflectance,
+        _groundRadianceEmission, _rayleighHeightScale, _ozoneEnabled, _ozoneHeightScale,
+        _mieHeightScale, _miePhaseConstant, _sunRadianceIntensity
+    );
+    const std::array<glm::vec3, 4> coefficients = {
+        _rayleighScatteringCoeff, _ozoneExtinctionCoeff, _mieScatteringCoeff,
+        _mieExtinctionCoeff
+    };
+    for (const glm::vec3& c : coefficients) {
+        parameters += std::format("|{}|{}|{}", c.x, c.y, c.z);
+    }
+    parameters += std::format(
+        "|{}|{}|{}|{}|{}|{}|{}",
+        _transmittanceTableSize.x, _transmittanceTableSize.y, _irradianceTableSize.x,
+        _irradianceTableSize.y, _textureSize.x, _textureSize.y, _textureSize.z
+    );
 
-        // line 11 in algorithm 4.1
-        calculateInscattering(
-            scatteringOrder,
-            *deltaSSupTermsProgram,
-            deltaSRayleighTable
-        );
+    return FileSys.cacheManager()->cachedFilename(
+        std::filesystem::path("atmospheretables.bin"),
+        std::format("AtmosphereTables|{}", std::hash<std::string>{}(parameters))
+    );
+}
 
-        glDisable(GL_BLEND);
+bool AtmosphereDeferredcaster::loadCachedTables(const std::filesystem::path& cacheFile) {
+    ZoneScoped;
+
+    std::ifstream file(cacheFile, std::ios::binary);
+    if (!file.good()) {
+        return false;
     }
 
-    // Restores OpenGL blending state
-    global::renderEngine->openglStateCache().resetBlendState();
+    int8_t version = 0;
+    glm::ivec2 transmittanceSize = glm::ivec2(0);
+    glm::ivec2 irradianceSize = glm::ivec2(0);
+    glm::ivec3 inScatteringSize = glm::ivec3(0);
+    const bool hasHeader = readValue(file, version) &&
+        readValue(file, transmittanceSize) && readValue(file, irradianceSize) &&
+        readValue(file, inScatteringSize);
+    if (!hasHeader || version != CurrentCacheVersion ||
+        transmittanceSize != _transmittanceTableSize ||
+        irradianceSize != _irradianceTableSize || inScatteringSize != _textureSize)
+    {
+        LINFO(std::format("Atmosphere cache '{}' is outdated", cacheFile));
+        return false;
+    }
 
-    glDeleteTextures(1, &deltaETable);
-    glDeleteTextures(1, &deltaSRayleighTable);
-    glDeleteTextures(1, &deltaSMieTable);
-    glDeleteTextures(1, &deltaJTable);
+    const size_t nTransmittance = 3 * static_cast<size_t>(transmittanceSize.x) *
+        transmittanceSize.y;
+    const size_t nIrradiance = 3 * static_cast<size_t>(irradianceSize.x) *
+        irradianceSize.y;
+    const size_t nInScattering = 4 * static_cast<size_t>(inScatteringSize.x) *
+        inScatteringSize.y * inScatteringSize.z;
+
+    std::vector<float> values(nTransmittance + nIrradiance + nInScattering);
+    file.read(
+        reinterpret_cast<char*>(values.data()),
+        values.size() * sizeof(float)
+    );
+    if (!file.good()) {
+        LWARNING(std::format("Atmosphere cache '{}' is incomplete", cacheFile));
+        return false;
+    }
 
-    // Restores system state
-    glBindFramebuffer(GL_FRAMEBUFFER, defaultFBO);
-    global::renderEngine->openglStateCache().setViewportState(viewport.data());
-    glDeleteBuffers(1, &quadVbo);
-    glDeleteVertexArrays(1, &quadVao);
-    glDeleteFramebuffers(1, &calcFBO);
-    glBindVertexArray(0);
+    // Stopped using a buffer object for GL_PIXEL_UNPACK_BUFFER
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-    LDEBUG("Ended precalculations for Atmosphere effects");
+    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        transmittanceSize.x,
+        transmittanceSize.y,
+        GL_RGB,
+        GL_FLOAT,
+        values.data()
+    );
+
+    glBindTexture(GL_TEXTURE_2D, _irradianceTableTexture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        irradianceSize.x,
+        irradianceSize.y,
+        GL_RGB,
+        GL_FLOAT,
+        values.data() + nTransmittance
+    );
+
+    glBindTexture(GL_TEXTURE_3D, _inScatteringTableTexture);
+    glTexSubImage3D(
+        GL_TEXTURE_3D,
+        0,
+        0,
+        0,
+        0,
+        inScatteringSize.x,
+        inScatteringSize.y,
+        inScatteringSize.z,
+        GL_RGBA,
+        GL_FLOAT,
+        values.data() + nTransmittance + nIrradiance
+    );
+    glBindTexture(GL_TEXTURE_3D, 0);
+
+    return true;
+}
+
+void AtmosphereDeferredcaster::saveCachedTables(
+                                            const std::filesystem::path& cacheFile) const
+{
+    ZoneScoped;
+
+    const std::vector<float> transmittance = readTexture(
+        GL_TEXTURE_2D,
+        _transmittanceTableTexture,
+        GL_RGB,
+        3 * static_cast<size_t>(_transmittanceTableSize.x) * _transmittanceTableSize.y
+    );
+    const std::vector<float> irradiance = readTexture(
+        GL_TEXTURE_2D,
+        _irradianceTableTexture,
+        GL_RGB,
+        3 * static_cast<size_t>(_irradianceTableSize.x) * _irradianceTableSize.y
+    );
+    const std::vector<float> inScattering = readTexture(
+        GL_TEXTURE_3D,
+        _inScatteringTableTexture,
+        GL_RGBA,
+        4 * static_cast<size_t>(_textureSize.x) * _textureSize.y * _textureSize.z
+    );
+    glBindTexture(GL_TEXTURE_3D, 0);
+
+    std::ofstream file(cacheFile, std::ios::binary);
+    if (!file.good()) {
+        LWARNING(std::format("Could not write atmosphere cache '{}'", cacheFile));
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(&CurrentCacheVersion), sizeof(int8_t));
+    file.write(
+        reinterpret_cast<const char*>(&_transmittanceTableSize),
+        sizeof(glm::ivec2)
+    );
+    file.write(reinterpret_cast<const char*>(&_irradianceTableSize), sizeof(glm::ivec2));
+    file.write(reinterpret_cast<const char*>(&_textureSize), sizeof(glm::ivec3));
+    auto writeValues = [&file](const std::vector<float>& values) {
+        file.write(
+            reinterpret_cast<const char*>(values.data()),
+            values.size() * sizeof(float)
+        );
+    };
+    writeValues(transmittance);
+    writeValues(irradiance);
+    writeValues(inScattering);
 }
 
 void AtmosphereDeferredcaster::step3DTexture(ghoul::opengl::ProgramObject& prg,
@@ -28,9 +28,12 @@
 #include <openspace/rendering/deferredcaster.h>
 
 #include <modules/atmosphere/rendering/renderableatmosphere.h>
+#include <openspace/rendering/eclipseshadows.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,21 +48,11 @@ struct RenderData;
 struct DeferredcastData;
 struct ShadowConfiguration;
 
-struct ShadowRenderingStruct {
-    double umbra = 0.0;
-    double penumbra = 0.0;
-    double radiusSource = 0.0;
-    double radiusCaster = 0.0;
-    glm::dvec3 sourceCasterVec = glm::dvec3(0.0);
-    glm::dvec3 casterPositionVec = glm::dvec3(0.0);
-    bool isShadowing = false;
-};
-
 class AtmosphereDeferredcaster : public Deferredcaster {
 public:
     AtmosphereDeferredcaster(float textureScale,
         std::vector<ShadowConfiguration> shadowConfigArray, bool saveCalculatedTextures);
-    ~AtmosphereDeferredcaster() override = default;
+    ~AtmosphereDeferredcaster() override;
 
     void initialize();
     void deinitialize();
@@ -77,8 +70,20 @@ public:
     void update(const UpdateData&) override;
     float eclipseShadow(const glm::dvec3& position);
 
+    /**
+     * Calculates the transmittance, irradiance, and inscattering tables for the current
+     * parameters in a single go.
+     */
     void calculateAtmosphereParameters();
 
+    /**
+     * Starts to calculate the transmittance, irradiance, and inscattering tables for the
+     * current parameters. The calculation is split into steps, which are performed in
+     * the following calls to #update so that they take about \p gpuBudget milliseconds
+     * of GPU time per frame. The previous tables are used until all steps are done.
+     */
+    void beginAtmosphereCalculation(float gpuBudget);
+
     void setModelTransform(glm::dmat4 transform);
     void setOpacity(float opacity);
 
@@ -93,26 +98,68 @@ public:
     void setHardShadows(bool enabled);
 
 private:
+    // The passes of the precalculation in the order in which they are performed. The
+    // passes with an order are repeated for each scattering order
+    enum class CalculationStage {
+        Transmittance = 0,
+        DeltaE,
+        DeltaS,
+        Irradiance,
+        Inscattering,
+        DeltaJOrder,
+        DeltaEOrder,
+        DeltaSOrder,
+        IrradianceOrder,
+        InscatteringOrder,
+        Done
+    };
+    struct Calculation;
+
     void step3DTexture(ghoul::opengl::ProgramObject& prg, int layer) const;
 
+    // Each of these functions renders one pass of the precalculation, or a single
+    // \p layer of it for the passes that write into a 3D texture
     void calculateTransmittance();
-    GLuint calculateDeltaE();
-    std::pair<GLuint, GLuint> calculateDeltaS();
+    void calculateDeltaE();
+    void calculateDeltaS(int layer);
     void calculateIrradiance();
-    void calculateInscattering(GLuint deltaSRayleigh, GLuint deltaSMie);
-    void calculateDeltaJ(int scatteringOrder,
-        ghoul::opengl::ProgramObject& program, GLuint deltaJ, GLuint deltaE,
-        GLuint deltaSRayleigh, GLuint deltaSMie);
-    void calculateDeltaE(int scatteringOrder,
-        ghoul::opengl::ProgramObject& program, GLuint deltaE, GLuint deltaSRayleigh,
-        GLuint deltaSMie);
-    void calculateDeltaS(int scatteringOrder,
-        ghoul::opengl::ProgramObject& program, GLuint deltaSRayleigh, GLuint deltaJ);
-    void calculateIrradiance(int scatteringOrder,
-        ghoul::opengl::ProgramObject& program, GLuint deltaE);
-    void calculateInscattering(int scatteringOrder,
-        ghoul::opengl::ProgramObject& program, GLuint deltaSRayleigh);
-
+    void calculateInscattering(int layer);
+    void calculateDeltaJ(int scatteringOrder, int layer);
+    void calculateDeltaE(int scatteringOrder);
+    void calculateDeltaS(int scatteringOrder, int layer);
+    void calculateIrradiance(int scatteringOrder);
+    void calculateInscattering(int scatteringOrder, int layer);
+
+    /**
+     * Creates the textures and programs for a new calculation and returns whether it
+     * needs to be performed. This is not the case if the tables were loaded from the
+     * cache instead.
+     */
+    bool beginCalculation();
+    void performCalculationStep();
+
+    /**
+     * Performs up to \p nSteps steps of the current calculation and returns whether it
+     * has finished.
+     */
+    bool advanceCalculation(int nSteps);
+    void finishCalculation();
+    void releaseCalculation();
+
+    /**
+     * Returns the path of the cache file for the transmittance, irradiance, and
+     * inscattering tables. The path depends on all parameters that the precalculation
+     * uses, so that the tables are calculated again whenever one of them changes.
+     */
+    std::filesystem::path tablesCacheFile() const;
+
+    /**
+     * Loads the tables from the \p cacheFile into the textures and returns whether that
+     * was successful. It fails if there is no such file, or if the file was written by
+     * a different version or with different texture sizes.
+     */
+    bool loadCachedTables(const std::filesystem::path& cacheFile);
+    void saveCachedTables(const std::filesystem::path& cacheFile) const;
 
     UniformCache(cullAtmosphere, opacity, Rg, Rt, groundRadianceEmission, HR,
         betaRayleigh, HM, betaMieExtinction, mieG, sunRadiance, ozoneLayerEnabled, HO,
@@ -130,6 +177,9 @@ private:
     GLuint _irradianceTableTexture = 0;
     GLuint _inScatteringTableTexture = 0;
 
+    std::unique_ptr<Calculation> _calculation;
+    float _calculationBudget = 0.f;
+
     // Atmosphere Data
     bool _ozoneEnabled = false;
     bool _sunFollowingCameraEnabled = false;
@@ -165,7 +215,7 @@ private:
 
     // Eclipse Shadows
     std::vector<ShadowConfiguration> _shadowConfArray;
-    std::vector<ShadowRenderingStruct> _shadowDataArrayCache;
+    std::vector<EclipseShadows::Shadow> _shadowDataArrayCache;
     bool _hardShadowsEnabled = false;
 
     // Atmosphere Debugging
@@ -185,6 +185,27 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo CalculationBudgetInfo = {
+        "CalculationBudget",
+        "Calculation Budget",
+        "The GPU time in milliseconds per frame that is spent on calculating the "
+        "atmosphere tables again after a parameter has changed. The previous tables are "
+        "used until the calculation is finished. If this value is 0, the tables are "
+        "calculated in a single frame instead.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TemporalReprojectionInfo = {
+        "TemporalReprojection",
+        "Temporal Reprojection",
+        "If enabled, the atmosphere is only calculated for half of the pixels in each "
+        "frame, alternating in a checkerboard pattern. The other pixels are reprojected "
+        "from the previous frame where possible. This halves the cost of the atmosphere "
+        "for most pixels, but fast changes such as moving objects in front of the "
+        "atmosphere can lag behind by one frame.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(RenderableAtmosphere)]] Parameters {
         struct ShadowGroup {
             // Individual light sources.
@@ -276,6 +297,12 @@ namespace {
 
         // [[codegen::verbatim(LightSourceNodeInfo.description)]]
         std::optional<std::string> lightSourceNode;
+
+        // [[codegen::verbatim(CalculationBudgetInfo.description)]]
+        std::optional<float> calculationBudget [[codegen::greaterequal(0.0)]];
+
+        // [[codegen::verbatim(TemporalReprojectionInfo.description)]]
+        std::optional<bool> temporalReprojection;
     };
 #include "renderableatmosphere_codegen.cpp"
 
@@ -318,6 +345,8 @@ RenderableAtmosphere::RenderableAtmosphere(const ghoul::Dictionary& dictionary)
     , _hardShadowsEnabled(EclipseHardShadowsInfo, false)
     , _sunAngularSize(SunAngularSize, 0.3f, 0.f, 180.f)
     , _lightSourceNodeName(LightSourceNodeInfo)
+    , _calculationBudget(CalculationBudgetInfo, 2.f, 0.f, 50.f)
+    , _temporalReprojection(TemporalReprojectionInfo, false)
     , _atmosphereDimmingHeight(AtmosphereDimmingHeightInfo, 0.7f, 0.f, 1.f)
     , _atmosphereDimmingSunsetAngle(
         SunsetAngleInfo,
@@ -466,6 +495,12 @@ RenderableAtmosphere::RenderableAtmosphere(const ghoul::Dictionary& dictionary)
     });
     _lightSourceNodeName = p.lightSourceNode.value_or("");
     addProperty(_lightSourceNodeName);
+
+    _calculationBudget = p.calculationBudget.value_or(_calculationBudget);
+    addProperty(_calculationBudget);
+
+    _temporalReprojection = p.temporalReprojection.value_or(_temporalReprojection);
+    addProperty(_temporalReprojection);
 }
 
 void RenderableAtmosphere::deinitializeGL() {
@@ -510,13 +545,19 @@ void RenderableAtmosphere::update(const UpdateData& data) {
         _deferredCasterNeedsUpdate = false;
     }
     if (_deferredCasterNeedsCalculation) {
-        _deferredcaster->calculateAtmosphereParameters();
+        if (_calculationBudget > 0.f) {
+            _deferredcaster->beginAtmosphereCalculation(_calculationBudget);
+        }
+        else {
+            _deferredcaster->calculateAtmosphereParameters();
+        }
         _deferredCasterNeedsCalculation = false;
     }
 
     glm::dmat4 modelTransform = computeModelTransformMatrix(data.modelTransform);
     _deferredcaster->setModelTransform(std::move(modelTransform));
     _deferredcaster->setOpacity(opacity());
+    _deferredcaster->setTemporalReprojection(_temporalReprojection);
     _deferredcaster->update(data);
     setDimmingCoefficient(computeModelTransformMatrix(data.modelTransform));
 }
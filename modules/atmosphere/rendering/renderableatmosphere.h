@@ -99,6 +99,8 @@ private:
     properties::FloatProperty _sunAngularSize;
     SceneGraphNode* _lightSourceNode = nullptr;
     properties::StringProperty _lightSourceNodeName;
+    properties::FloatProperty _calculationBudget;
+    properties::BoolProperty _temporalReprojection;
 
     // Atmosphere dimming
     properties::FloatProperty _atmosphereDimmingHeight;
@@ -29,6 +29,7 @@
 #include <modules/base/dashboard/dashboarditemdistance.h>
 #include <modules/base/dashboard/dashboarditemelapsedtime.h>
 #include <modules/base/dashboard/dashboarditemframerate.h>
+#include <modules/base/dashboard/dashboarditemframestatistics.h>
 #include <modules/base/dashboard/dashboarditeminputstate.h>
 #include <modules/base/dashboard/dashboarditemmission.h>
 #include <modules/base/dashboard/dashboarditemparallelconnection.h>
@@ -92,6 +93,7 @@ namespace openspace {
 
 ghoul::opengl::ProgramObjectManager BaseModule::ProgramObjectManager;
 ghoul::opengl::TextureManager BaseModule::TextureManager;
+OnlineImageCache BaseModule::OnlineImages;
 
 BaseModule::BaseModule() : OpenSpaceModule(BaseModule::Name) {}
 
@@ -116,6 +118,9 @@ void BaseModule::internalInitialize(const ghoul::Dictionary&) {
     fDashboard->registerClass<DashboardItemDistance>("DashboardItemDistance");
     fDashboard->registerClass<DashboardItemElapsedTime>("DashboardItemElapsedTime");
     fDashboard->registerClass<DashboardItemFramerate>("DashboardItemFramerate");
+    fDashboard->registerClass<DashboardItemFrameStatistics>(
+        "DashboardItemFrameStatistics"
+    );
     fDashboard->registerClass<DashboardItemInputState>("DashboardItemInputState");
     fDashboard->registerClass<DashboardItemMission>("DashboardItemMission");
     fDashboard->registerClass<DashboardItemParallelConnection>(
@@ -211,6 +216,7 @@ void BaseModule::internalInitialize(const ghoul::Dictionary&) {
 void BaseModule::internalDeinitializeGL() {
     ProgramObjectManager.releaseAll(ghoul::opengl::ProgramObjectManager::Warnings::Yes);
     TextureManager.releaseAll(ghoul::opengl::TextureManager::Warnings::Yes);
+    OnlineImages.deinitialize();
 }
 
 std::vector<documentation::Documentation> BaseModule::documentations() const {
@@ -219,6 +225,7 @@ std::vector<documentation::Documentation> BaseModule::documentations() const {
         DashboardItemDate::Documentation(),
         DashboardItemDistance::Documentation(),
         DashboardItemFramerate::Documentation(),
+        DashboardItemFrameStatistics::Documentation(),
         DashboardItemMission::Documentation(),
         DashboardItemParallelConnection::Documentation(),
         DashboardItemPropertyValue::Documentation(),
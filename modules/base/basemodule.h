@@ -27,6 +27,7 @@
 
 #include <openspace/util/openspacemodule.h>
 
+#include <modules/base/rendering/onlineimagecache.h>
 #include <ghoul/opengl/programobjectmanager.h>
 #include <ghoul/opengl/texturemanager.h>
 
@@ -44,6 +45,7 @@ public:
 
     static ghoul::opengl::ProgramObjectManager ProgramObjectManager;
     static ghoul::opengl::TextureManager TextureManager;
+    static OnlineImageCache OnlineImages;
 
 protected:
     void internalInitialize(const ghoul::Dictionary&) override;
@@ -0,0 +1,120 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/dashboard/dashboarditemframestatistics.h>
+
+#include <openspace/documentation/documentation.h>
+#include <openspace/documentation/verifier.h>
+#include <openspace/engine/framestatistics.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/engine/windowdelegate.h>
+#include <ghoul/font/font.h>
+#include <ghoul/font/fontmanager.h>
+#include <ghoul/font/fontrenderer.h>
+#include <ghoul/misc/profiling.h>
+
+namespace {
+    constexpr openspace::properties::Property::PropertyInfo UseAverageInfo = {
+        "UseAverage",
+        "Use Average",
+        "If this value is enabled, the displayed timings are a smoothed average over the "
+        "recent frames. If it is disabled, the timings of the last frame are shown.",
+        openspace::properties::Property::Visibility::User
+    };
+
+    // This `DashboardItem` shows how long each stage of the last frames took on this
+    // node, together with the size of the synchronization payload. On a cluster, every
+    // node renders its own values, which makes it possible to see which node is the one
+    // that is holding back the swap barrier
+    struct [[codegen::Dictionary(DashboardItemFrameStatistics)]] Parameters {
+        // [[codegen::verbatim(UseAverageInfo.description)]]
+        std::optional<bool> useAverage;
+    };
+#include "dashboarditemframestatistics_codegen.cpp"
+} // namespace
+
+namespace openspace {
+
+documentation::Documentation DashboardItemFrameStatistics::Documentation() {
+    return codegen::doc<Parameters>(
+        "base_dashboarditem_framestatistics",
+        DashboardTextItem::Documentation()
+    );
+}
+
+DashboardItemFrameStatistics::DashboardItemFrameStatistics(
+                                                      const ghoul::Dictionary& dictionary)
+    : DashboardTextItem(dictionary)
+    , _useAverage(UseAverageInfo, true)
+{
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    _useAverage = p.useAverage.value_or(_useAverage);
+    addProperty(_useAverage);
+}
+
+void DashboardItemFrameStatistics::render(glm::vec2& penPosition) {
+    ZoneScoped;
+
+    const std::string t = text();
+    const glm::vec2 bbox = _font->boundingBox(t);
+    penPosition.y -= bbox.y;
+    RenderFont(*_font, penPosition, t);
+}
+
+glm::vec2 DashboardItemFrameStatistics::size() const {
+    ZoneScoped;
+
+    return _font->boundingBox(text());
+}
+
+std::string DashboardItemFrameStatistics::text() const {
+    using Stage = FrameStatistics::Stage;
+
+    const FrameStatistics& stats = global::openSpaceEngine->frameStatistics();
+    const FrameStatistics::Frame& f =
+        _useAverage ? stats.averageFrame() : stats.lastFrame();
+    auto ms = [&f](Stage stage) { return f.durations[static_cast<int>(stage)]; };
+
+    const bool isMaster = global::windowDelegate->isMaster();
+    return std::format(
+        "Node {}{}\n"
+        "Pre-sync:    {:6.2f} ms\n"
+        "{}:      {:6.2f} ms ({} bytes)\n"
+        "Pre-draw:    {:6.2f} ms\n"
+        "Render:      {:6.2f} ms\n"
+        "Swap wait:   {:6.2f} ms",
+        global::windowDelegate->currentNode(), isMaster ? " (master)" : "",
+        ms(Stage::PreSynchronization),
+        isMaster ? "Encode" : "Decode",
+        ms(isMaster ? Stage::Encode : Stage::Decode),
+        f.syncBytes,
+        ms(Stage::PostSynchronizationPreDraw),
+        ms(Stage::Render),
+        ms(Stage::SwapWait)
+    );
+}
+
+} // namespace openspace
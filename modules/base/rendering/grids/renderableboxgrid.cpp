@@ -137,22 +137,15 @@ void RenderableBoxGrid::initializeGL() {
             );
         }
     );
-
-    glGenVertexArrays(1, &_vaoID);
-    glGenBuffers(1, &_vBufferID);
-
-    glBindVertexArray(_vaoID);
-    glBindBuffer(GL_ARRAY_BUFFER, _vBufferID);
-    glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
 }
 
 void RenderableBoxGrid::deinitializeGL() {
-    glDeleteVertexArrays(1, &_vaoID);
-    _vaoID = 0;
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
 
-    glDeleteBuffers(1, &_vBufferID);
-    _vBufferID = 0;
+    _geometry = nullptr;
+    _gridIsDirty = true;
 
     BaseModule::ProgramObjectManager.release(
         "GridProgram",
@@ -169,8 +162,10 @@ void RenderableBoxGrid::render(const RenderData& data, RendererTasks&) {
     auto [modelTransform, modelViewTransform, modelViewProjectionTransform] =
         calcAllTransforms(data);
 
-    _gridProgram->setUniform("modelViewTransform", modelViewTransform);
-    _gridProgram->setUniform("MVPTransform", modelViewProjectionTransform);
+    // The shared geometry is a unit cube, but the labels are placed in model space
+    const glm::dmat4 gridScale = glm::scale(glm::dmat4(1.0), glm::dvec3(_size.value()));
+    _gridProgram->setUniform("modelViewTransform", modelViewTransform * gridScale);
+    _gridProgram->setUniform("MVPTransform", modelViewProjectionTransform * gridScale);
     _gridProgram->setUniform("opacity", opacity());
     _gridProgram->setUniform("gridColor", _color);
 
@@ -185,8 +180,8 @@ void RenderableBoxGrid::render(const RenderData& data, RendererTasks&) {
     glEnable(GL_LINE_SMOOTH);
     glDepthMask(false);
 
-    glBindVertexArray(_vaoID);
-    glDrawArrays(_mode, 0, static_cast<GLsizei>(_varray.size()));
+    glBindVertexArray(_geometry->vao);
+    glDrawArrays(_mode, 0, _geometry->count);
     glBindVertexArray(0);
 
     _gridProgram->deactivate();
@@ -224,75 +219,89 @@ void RenderableBoxGrid::render(const RenderData& data, RendererTasks&) {
 
 void RenderableBoxGrid::update(const UpdateData&) {
     if (_gridIsDirty) {
-        const glm::vec3 llf = -_size.value() / 2.f;
-        const glm::vec3 urb =  _size.value() / 2.f;
-
-        //     7
-        //      --------------------  6
-        //     /                   /
-        //    /|                  /|
-        // 4 / |                 / |
-        //  x-------------------x  |
-        //  |  |                |5 |
-        //  |  |                |  |
-        //  |  |                |  |
-        //  | 3/----------------|--/ 2
-        //  | /                 | /
-        //  |/                  |/
-        //  x-------------------x
-        // 0                     1
-        //
-        //
-        //  For Line strip:
-        //  0 -> 1 -> 2 -> 3 -> 0 -> 4 -> 5 -> 6 -> 7 -> 4 -> 5(d) -> 1 -> 2(d) -> 6
-        //  -> 7(d) -> 3
-
-        const glm::vec3 v0 = glm::vec3(llf.x, llf.y, llf.z);
-        const glm::vec3 v1 = glm::vec3(urb.x, llf.y, llf.z);
-        const glm::vec3 v2 = glm::vec3(urb.x, urb.y, llf.z);
-        const glm::vec3 v3 = glm::vec3(llf.x, urb.y, llf.z);
-        const glm::vec3 v4 = glm::vec3(llf.x, llf.y, urb.z);
-        const glm::vec3 v5 = glm::vec3(urb.x, llf.y, urb.z);
-        const glm::vec3 v6 = glm::vec3(urb.x, urb.y, urb.z);
-        const glm::vec3 v7 = glm::vec3(llf.x, urb.y, urb.z);
-
-        _varray.clear();
-        _varray.reserve(16);
-
-        // First add the bounds
-        _varray.push_back({ v0.x, v0.y, v0.z });
-        _varray.push_back({ v1.x, v1.y, v1.z });
-        _varray.push_back({ v2.x, v2.y, v2.z });
-        _varray.push_back({ v3.x, v3.y, v3.z });
-        _varray.push_back({ v0.x, v0.y, v0.z });
-        _varray.push_back({ v4.x, v4.y, v4.z });
-        _varray.push_back({ v5.x, v5.y, v5.z });
-        _varray.push_back({ v6.x, v6.y, v6.z });
-        _varray.push_back({ v7.x, v7.y, v7.z });
-        _varray.push_back({ v4.x, v4.y, v4.z });
-        _varray.push_back({ v5.x, v5.y, v5.z });
-        _varray.push_back({ v1.x, v1.y, v1.z });
-        _varray.push_back({ v2.x, v2.y, v2.z });
-        _varray.push_back({ v6.x, v6.y, v6.z });
-        _varray.push_back({ v7.x, v7.y, v7.z });
-        _varray.push_back({ v3.x, v3.y, v3.z });
-
-        setBoundingSphere(glm::length(glm::dvec3(urb)));
-
-        glBindVertexArray(_vaoID);
-        glBindBuffer(GL_ARRAY_BUFFER, _vBufferID);
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            _varray.size() * sizeof(Vertex),
-            _varray.data(),
-            GL_STATIC_DRAW
+        // The geometry is a unit cube that is scaled to the size of the grid in the model
+        // matrix, so the same geometry is shared by all box grids
+        _geometry = requestSharedGeometry<GeometryBuffers>(
+            "BoxGrid",
+            []() { return createGeometry(); }
         );
-
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
-        glBindVertexArray(0);
+        setBoundingSphere(glm::length(glm::dvec3(_size.value()) / 2.0));
 
         _gridIsDirty = false;
     }
 }
 
+std::unique_ptr<GeometryBuffers> RenderableBoxGrid::createGeometry() {
+    const glm::vec3 llf = glm::vec3(-0.5f);
+    const glm::vec3 urb = glm::vec3(0.5f);
+
+    //     7
+    //      --------------------  6
+    //     /                   /
+    //    /|                  /|
+    // 4 / |                 / |
+    //  x-------------------x  |
+    //  |  |                |5 |
+    //  |  |                |  |
+    //  |  |                |  |
+    //  | 3/----------------|--/ 2
+    //  | /                 | /
+    //  |/                  |/
+    //  x-------------------x
+    // 0                     1
+    //
+    //
+    //  For Line strip:
+    //  0 -> 1 -> 2 -> 3 -> 0 -> 4 -> 5 -> 6 -> 7 -> 4 -> 5(d) -> 1 -> 2(d) -> 6
+    //  -> 7(d) -> 3
+
+    const glm::vec3 v0 = glm::vec3(llf.x, llf.y, llf.z);
+    const glm::vec3 v1 = glm::vec3(urb.x, llf.y, llf.z);
+    const glm::vec3 v2 = glm::vec3(urb.x, urb.y, llf.z);
+    const glm::vec3 v3 = glm::vec3(llf.x, urb.y, llf.z);
+    const glm::vec3 v4 = glm::vec3(llf.x, llf.y, urb.z);
+    const glm::vec3 v5 = glm::vec3(urb.x, llf.y, urb.z);
+    const glm::vec3 v6 = glm::vec3(urb.x, urb.y, urb.z);
+    const glm::vec3 v7 = glm::vec3(llf.x, urb.y, urb.z);
+
+    std::vector<Vertex> varray;
+    varray.reserve(16);
+
+    // First add the bounds
+    varray.push_back({ v0.x, v0.y, v0.z });
+    varray.push_back({ v1.x, v1.y, v1.z });
+    varray.push_back({ v2.x, v2.y, v2.z });
+    varray.push_back({ v3.x, v3.y, v3.z });
+    varray.push_back({ v0.x, v0.y, v0.z });
+    varray.push_back({ v4.x, v4.y, v4.z });
+    varray.push_back({ v5.x, v5.y, v5.z });
+    varray.push_back({ v6.x, v6.y, v6.z });
+    varray.push_back({ v7.x, v7.y, v7.z });
+    varray.push_back({ v4.x, v4.y, v4.z });
+    varray.push_back({ v5.x, v5.y, v5.z });
+    varray.push_back({ v1.x, v1.y, v1.z });
+    varray.push_back({ v2.x, v2.y, v2.z });
+    varray.push_back({ v6.x, v6.y, v6.z });
+    varray.push_back({ v7.x, v7.y, v7.z });
+    varray.push_back({ v3.x, v3.y, v3.z });
+
+    auto geometry = std::make_unique<GeometryBuffers>();
+    geometry->count = static_cast<GLsizei>(varray.size());
+
+    glBindVertexArray(geometry->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, geometry->vertexBuffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        varray.size() * sizeof(Vertex),
+        varray.data(),
+        GL_STATIC_DRAW
+    );
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+    glBindVertexArray(0);
+
+    return geometry;
+}
+
 } // namespace openspace
@@ -30,6 +30,7 @@
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <openspace/rendering/labelscomponent.h>
+#include <openspace/rendering/sharedgeometry.h>
 #include <ghoul/opengl/ghoul_gl.h>
 
 namespace ghoul::opengl {
@@ -60,6 +61,8 @@ protected:
         float location[3];
     };
 
+    static std::unique_ptr<GeometryBuffers> createGeometry();
+
     ghoul::opengl::ProgramObject* _gridProgram = nullptr;
 
     properties::Vec3Property _color;
@@ -68,11 +71,10 @@ protected:
 
     bool _gridIsDirty = true;
 
-    GLuint _vaoID = 0;
-    GLuint _vBufferID = 0;
+    /// The unit cube geometry that is shared with all other box grids
+    std::shared_ptr<GeometryBuffers> _geometry;
 
     GLenum _mode = GL_LINE_STRIP;
-    std::vector<Vertex> _varray;
 
     // Labels
     bool _hasLabels = false;
@@ -28,6 +28,7 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/openspaceengine.h>
+#include <openspace/rendering/drawlist.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -218,6 +219,10 @@ void RenderableGrid::initializeGL() {
 }
 
 void RenderableGrid::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     glDeleteVertexArrays(1, &_vaoID);
     _vaoID = 0;
     glDeleteVertexArrays(1, &_highlightVaoID);
@@ -237,34 +242,11 @@ void RenderableGrid::deinitializeGL() {
     _gridProgram = nullptr;
 }
 
-void RenderableGrid::render(const RenderData& data, RendererTasks&) {
+void RenderableGrid::renderGrid(const glm::dmat4& modelViewTransform,
+                                const glm::dmat4& modelViewProjectionMatrix)
+{
     _gridProgram->activate();
 
-    const glm::dmat4 modelTransform = calcModelTransform(data);
-    const glm::dmat4 modelViewTransform = calcModelViewTransform(data, modelTransform);
-
-    const glm::dmat4 projectionMatrix = data.camera.projectionMatrix();
-
-    const glm::dmat4 modelViewProjectionMatrix = projectionMatrix * modelViewTransform;
-
-    const glm::vec3 lookup = data.camera.lookUpVectorWorldSpace();
-    const glm::vec3 viewDirection = data.camera.viewDirectionWorldSpace();
-    glm::vec3 right = glm::cross(viewDirection, lookup);
-    const glm::vec3 up = glm::cross(right, viewDirection);
-
-    const glm::mat4 worldToModelTransform = glm::inverse(modelTransform);
-    glm::vec3 orthoRight = glm::normalize(
-        glm::vec3(worldToModelTransform * glm::vec4(right, 0.0))
-    );
-
-    if (orthoRight == glm::vec3(0.0)) {
-        const glm::vec3 otherVector = glm::vec3(lookup.y, lookup.x, lookup.z);
-        right = glm::cross(viewDirection, otherVector);
-        orthoRight = glm::normalize(
-            glm::vec3(worldToModelTransform * glm::vec4(right, 0.0))
-        );
-    }
-
     _gridProgram->setUniform("modelViewTransform", modelViewTransform);
     _gridProgram->setUniform("MVPTransform", modelViewProjectionMatrix);
     _gridProgram->setUniform("opacity", opacity());
@@ -302,6 +284,76 @@ void RenderableGrid::render(const RenderData& data, RendererTasks&) {
     global::renderEngine->openglStateCache().resetBlendState();
     global::renderEngine->openglStateCache().resetLineState();
     global::renderEngine->openglStateCache().resetDepthState();
+}
+
+void RenderableGrid::render(const RenderData& data, RendererTasks& rendererTask) {
+    const glm::dmat4 modelTransform = calcModelTransform(data);
+    const glm::dmat4 modelViewTransform = calcModelViewTransform(data, modelTransform);
+
+    const glm::dmat4 projectionMatrix = data.camera.projectionMatrix();
+
+    const glm::dmat4 modelViewProjectionMatrix = projectionMatrix * modelViewTransform;
+
+    const glm::vec3 lookup = data.camera.lookUpVectorWorldSpace();
+    const glm::vec3 viewDirection = data.camera.viewDirectionWorldSpace();
+    glm::vec3 right = glm::cross(viewDirection, lookup);
+    const glm::vec3 up = glm::cross(right, viewDirection);
+
+    const glm::mat4 worldToModelTransform = glm::inverse(modelTransform);
+    glm::vec3 orthoRight = glm::normalize(
+        glm::vec3(worldToModelTransform * glm::vec4(right, 0.0))
+    );
+
+    if (orthoRight == glm::vec3(0.0)) {
+        const glm::vec3 otherVector = glm::vec3(lookup.y, lookup.x, lookup.z);
+        right = glm::cross(viewDirection, otherVector);
+        orthoRight = glm::normalize(
+            glm::vec3(worldToModelTransform * glm::vec4(right, 0.0))
+        );
+    }
+
+    if (rendererTask.drawList) {
+        // The uniforms are captured by value as the packets are executed at the end of
+        // the render bin
+        const float opac = opacity();
+        auto uniforms = [modelViewTransform, modelViewProjectionMatrix, opac](
+                                                                         glm::vec3 color)
+        {
+            return [modelViewTransform, modelViewProjectionMatrix, opac, color](
+                                                         ghoul::opengl::ProgramObject& p)
+            {
+                p.setUniform("modelViewTransform", modelViewTransform);
+                p.setUniform("MVPTransform", modelViewProjectionMatrix);
+                p.setUniform("opacity", opac);
+                p.setUniform("gridColor", color);
+            };
+        };
+
+        DrawPacket minor;
+        minor.program = _gridProgram;
+        minor.vao = _vaoID;
+        minor.blendMode = DrawPacket::BlendMode::Normal;
+        minor.lineWidth = _lineWidth;
+        minor.lineSmooth = true;
+        minor.mode = _mode;
+        minor.count = static_cast<GLsizei>(_varray.size());
+        minor.setUniforms = uniforms(_color);
+        rendererTask.drawList->submit(std::move(minor));
+
+        DrawPacket major;
+        major.program = _gridProgram;
+        major.vao = _highlightVaoID;
+        major.blendMode = DrawPacket::BlendMode::Normal;
+        major.lineWidth = _highlightLineWidth;
+        major.lineSmooth = true;
+        major.mode = _mode;
+        major.count = static_cast<GLsizei>(_highlightArray.size());
+        major.setUniforms = uniforms(_highlightColor);
+        rendererTask.drawList->submit(std::move(major));
+    }
+    else {
+        renderGrid(modelViewTransform, modelViewProjectionMatrix);
+    }
 
     // Draw labels
     if (_hasLabels && _labels->enabled()) {
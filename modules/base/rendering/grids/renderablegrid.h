@@ -56,6 +56,9 @@ public:
     static documentation::Documentation Documentation();
 
 protected:
+    void renderGrid(const glm::dmat4& modelViewTransform,
+        const glm::dmat4& modelViewProjectionMatrix);
+
     struct Vertex {
         double location[3];
     };
@@ -181,6 +181,10 @@ void RenderableRadialGrid::initializeGL() {
 }
 
 void RenderableRadialGrid::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     BaseModule::ProgramObjectManager.release(
         "GridProgram",
         [](ghoul::opengl::ProgramObject* p) {
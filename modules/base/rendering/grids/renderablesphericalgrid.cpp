@@ -148,27 +148,15 @@ void RenderableSphericalGrid::initializeGL() {
             );
         }
     );
-
-    glGenVertexArrays(1, &_vaoID);
-    glGenBuffers(1, &_vBufferID);
-    glGenBuffers(1, &_iBufferID);
-
-    glBindVertexArray(_vaoID);
-    glBindBuffer(GL_ARRAY_BUFFER, _vBufferID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iBufferID);
-    glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
 }
 
 void RenderableSphericalGrid::deinitializeGL() {
-    glDeleteVertexArrays(1, &_vaoID);
-    _vaoID = 0;
-
-    glDeleteBuffers(1, &_vBufferID);
-    _vBufferID = 0;
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
 
-    glDeleteBuffers(1, &_iBufferID);
-    _iBufferID = 0;
+    _geometry = nullptr;
+    _gridIsDirty = true;
 
     BaseModule::ProgramObjectManager.release(
         "GridProgram",
@@ -201,9 +189,8 @@ void RenderableSphericalGrid::render(const RenderData& data, RendererTasks&) {
     glEnable(GL_LINE_SMOOTH);
     glDepthMask(false);
 
-    glBindVertexArray(_vaoID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iBufferID);
-    glDrawElements(_mode, _isize, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(_geometry->vao);
+    glDrawElements(_mode, _geometry->count, GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
 
     _gridProgram->deactivate();
@@ -244,20 +231,29 @@ void RenderableSphericalGrid::update(const UpdateData&) {
         return;
     }
 
-    _isize = 6 * _segments * _segments;
-    _vsize = (_segments + 1) * (_segments + 1);
-    _varray.resize(_vsize);
-    constexpr Vertex v = { 0.f, 0.f, 0.f };
-    std::fill(_varray.begin(), _varray.end(), v);
-    _iarray.resize(_isize);
-    std::fill(_iarray.begin(), _iarray.end(), 0);
+    // The grid always has a radius of 1, so all grids with the same number of segments
+    // share the same geometry
+    const int segments = _segments;
+    _geometry = requestSharedGeometry<GeometryBuffers>(
+        std::format("SphericalGrid|{}", segments),
+        [segments]() { return createGeometry(segments); }
+    );
+
+    _gridIsDirty = false;
+}
+
+std::unique_ptr<GeometryBuffers> RenderableSphericalGrid::createGeometry(int segments) {
+    const unsigned int isize = 6 * segments * segments;
+    const unsigned int vsize = (segments + 1) * (segments + 1);
+    std::vector<Vertex> varray = std::vector<Vertex>(vsize, { 0.f, 0.f, 0.f });
+    std::vector<int> iarray = std::vector<int>(isize, 0);
 
     int nr = 0;
-    const float fsegments = static_cast<float>(_segments);
+    const float fsegments = static_cast<float>(segments);
 
-    for (int nSegment = 0; nSegment <= _segments; ++nSegment) {
+    for (int nSegment = 0; nSegment <= segments; ++nSegment) {
         // define an extra vertex around the y-axis due to texture mapping
-        for (int j = 0; j <= _segments; j++) {
+        for (int j = 0; j <= segments; j++) {
             const float fi = static_cast<float>(nSegment);
             const float fj = static_cast<float>(j);
 
@@ -271,11 +267,6 @@ void RenderableSphericalGrid::update(const UpdateData&) {
             const float y = std::cos(theta);                  // up
             const float z = std::cos(phi) * std::sin(theta);  //
 
-            glm::vec3 normal = glm::vec3(x, y, z);
-            if (x != 0.f || y != 0.f || z != 0.f) {
-                normal = glm::normalize(normal);
-            }
-
             glm::vec4 tmp(x, y, z, 1.f);
             const glm::mat4 rot = glm::rotate(
                 glm::mat4(1.f),
@@ -285,44 +276,49 @@ void RenderableSphericalGrid::update(const UpdateData&) {
             tmp = glm::vec4(glm::dmat4(rot) * glm::dvec4(tmp));
 
             for (int i = 0; i < 3; i++) {
-                _varray[nr].location[i] = tmp[i];
+                varray[nr].location[i] = tmp[i];
             }
             ++nr;
         }
     }
     nr = 0;
     // define indices for all triangles
-    for (int i = 1; i <= _segments; i++) {
-        for (int j = 0; j < _segments; j++) {
-            const int t = _segments + 1;
-            _iarray[nr] = t * (i - 1) + j + 0; ++nr;
-            _iarray[nr] = t * (i + 0) + j + 0; ++nr;
-            _iarray[nr] = t * (i + 0) + j + 1; ++nr;
-            _iarray[nr] = t * (i - 1) + j + 1; ++nr;
-            _iarray[nr] = t * (i - 1) + j + 0; ++nr;
+    for (int i = 1; i <= segments; i++) {
+        for (int j = 0; j < segments; j++) {
+            const int t = segments + 1;
+            iarray[nr] = t * (i - 1) + j + 0; ++nr;
+            iarray[nr] = t * (i + 0) + j + 0; ++nr;
+            iarray[nr] = t * (i + 0) + j + 1; ++nr;
+            iarray[nr] = t * (i - 1) + j + 1; ++nr;
+            iarray[nr] = t * (i - 1) + j + 0; ++nr;
         }
     }
 
-    glBindVertexArray(_vaoID);
-    glBindBuffer(GL_ARRAY_BUFFER, _vBufferID);
+    auto geometry = std::make_unique<GeometryBuffers>();
+    geometry->count = static_cast<GLsizei>(isize);
+
+    glBindVertexArray(geometry->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, geometry->vertexBuffer);
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vsize * sizeof(Vertex),
-        _varray.data(),
+        vsize * sizeof(Vertex),
+        varray.data(),
         GL_STATIC_DRAW
     );
 
+    glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iBufferID);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry->indexBuffer);
     glBufferData(
         GL_ELEMENT_ARRAY_BUFFER,
-        _isize * sizeof(int),
-        _iarray.data(),
+        isize * sizeof(int),
+        iarray.data(),
         GL_STATIC_DRAW
     );
+    glBindVertexArray(0);
 
-    _gridIsDirty = false;
+    return geometry;
 }
 
 } // namespace openspace
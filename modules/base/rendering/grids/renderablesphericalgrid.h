@@ -31,6 +31,7 @@
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <openspace/rendering/labelscomponent.h>
+#include <openspace/rendering/sharedgeometry.h>
 #include <ghoul/opengl/ghoul_gl.h>
 
 namespace ghoul::opengl { class ProgramObject; }
@@ -60,6 +61,8 @@ protected:
         float location[3];
     };
 
+    static std::unique_ptr<GeometryBuffers> createGeometry(int segments);
+
     ghoul::opengl::ProgramObject* _gridProgram;
 
     properties::Vec3Property _color;
@@ -68,15 +71,10 @@ protected:
 
     bool _gridIsDirty = true;
 
-    GLuint _vaoID = 0;
-    GLuint _vBufferID = 0;
-    GLuint _iBufferID = 0;
+    /// The geometry is shared with all other spherical grids with the same segments
+    std::shared_ptr<GeometryBuffers> _geometry;
 
     GLenum _mode = GL_LINES;
-    unsigned int _isize = 0;
-    unsigned int _vsize = 0;
-    std::vector<Vertex> _varray;
-    std::vector<int> _iarray;
 
     // Labels
     bool _hasLabels = false;
@@ -0,0 +1,334 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/imagesequenceprefetcher.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/format.h>
+#include <ghoul/io/texture/texturereader.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <chrono>
+#include <stb_image.h>
+
+namespace {
+    constexpr std::string_view _loggerCat = "ImageSequencePrefetcher";
+
+    // The number of decoded images that are uploaded per frame in addition to the
+    // active image, so that the uploads of a prefetched batch are spread over frames
+    constexpr int MaxUploadsPerFrame = 2;
+} // namespace
+
+namespace openspace {
+
+ImageSequencePrefetcher::ImageSequencePrefetcher(int nPrefetch, int capacity)
+    : _nPrefetch(nPrefetch)
+    , _capacity(capacity)
+{
+    ghoul_assert(nPrefetch >= 0, "nPrefetch must be non-negative");
+    ghoul_assert(capacity > nPrefetch, "capacity must be bigger than nPrefetch");
+}
+
+ImageSequencePrefetcher::~ImageSequencePrefetcher() = default;
+
+void ImageSequencePrefetcher::setImages(std::vector<std::filesystem::path> files,
+                                        std::vector<double> startTimes)
+{
+    ghoul_assert(files.size() == startTimes.size(), "Each file needs a start time");
+    ghoul_assert(
+        std::is_sorted(startTimes.begin(), startTimes.end()),
+        "startTimes must be sorted"
+    );
+
+    clear();
+    _files = std::move(files);
+    _startTimes = std::move(startTimes);
+}
+
+void ImageSequencePrefetcher::update(double currentTime, double timeStep) {
+    if (_files.empty()) {
+        return;
+    }
+
+    const std::vector<int> indices = upcomingIndices(currentTime, timeStep);
+    const int activeIndex = indices.front();
+    finishDecodings(activeIndex);
+
+    // Decodings of images that are no longer coming up are dropped. Tasks that have
+    // already started run to completion, but their result is discarded
+    std::erase_if(
+        _decodings,
+        [&indices](const auto& decoding) {
+            return std::find(indices.begin(), indices.end(), decoding.first) ==
+                   indices.end();
+        }
+    );
+
+    for (const int index : indices) {
+        if (_textures.contains(index) || _decodings.contains(index) ||
+            _failedImages.contains(index))
+        {
+            continue;
+        }
+
+        std::filesystem::path path = _files[index];
+        if (global::threadPool) {
+            _decodings[index] = global::threadPool->submit(
+                [path]() { return decodeImage(path); },
+                ThreadPool::Priority::Low
+            );
+        }
+        else {
+            _decodings[index] = std::async(
+                std::launch::deferred,
+                [path]() { return decodeImage(path); }
+            );
+        }
+    }
+
+    evictTextures(indices, activeIndex);
+}
+
+ghoul::opengl::Texture* ImageSequencePrefetcher::texture(int index) const {
+    if (_textures.empty()) {
+        return nullptr;
+    }
+
+    const auto next = _textures.lower_bound(index);
+    if (next == _textures.end()) {
+        return std::prev(next)->second.get();
+    }
+    if (next->first == index || next == _textures.begin()) {
+        return next->second.get();
+    }
+
+    // The requested image is not resident, so the closest image is used instead
+    const auto previous = std::prev(next);
+    return (index - previous->first <= next->first - index) ?
+        previous->second.get() :
+        next->second.get();
+}
+
+void ImageSequencePrefetcher::clear() {
+    _textures.clear();
+    _decodings.clear();
+    _failedImages.clear();
+}
+
+int ImageSequencePrefetcher::indexForTime(double time) const {
+    const auto it = std::upper_bound(_startTimes.begin(), _startTimes.end(), time);
+    if (it == _startTimes.begin()) {
+        return 0;
+    }
+    return static_cast<int>(std::distance(_startTimes.begin(), it)) - 1;
+}
+
+std::vector<int> ImageSequencePrefetcher::upcomingIndices(double currentTime,
+                                                          double timeStep) const
+{
+    const int nImages = static_cast<int>(_files.size());
+    const int direction = timeStep < 0.0 ? -1 : 1;
+
+    std::vector<int> indices = { indexForTime(currentTime) };
+    for (int i = 1; i <= _nPrefetch; i++) {
+        // The image that will be active i frames from now. When the sequence is moving
+        // quickly, the images in between would not be shown for a full frame and are
+        // skipped. When it is moving slowly, the next images are used instead so that
+        // the prefetching is always _nPrefetch images ahead
+        int index = indexForTime(currentTime + i * timeStep);
+        if ((index - indices.back()) * direction <= 0) {
+            index = indices.back() + direction;
+        }
+        if (index < 0 || index >= nImages) {
+            break;
+        }
+        indices.push_back(index);
+    }
+    return indices;
+}
+
+void ImageSequencePrefetcher::finishDecodings(int activeIndex) {
+    using namespace std::chrono_literals;
+
+    int nUploads = 0;
+    auto it = _decodings.begin();
+    while (it != _decodings.end()) {
+        // The active image is uploaded as soon as it is available, all others have to
+        // wait for a frame that has not reached the upload budget yet
+        const bool isActive = it->first == activeIndex;
+        if ((!isActive && nUploads >= MaxUploadsPerFrame) ||
+            it->second.wait_for(0s) == std::future_status::timeout)
+        {
+            it++;
+            continue;
+        }
+
+        std::unique_ptr<DecodedImage> image;
+        try {
+            image = it->second.get();
+        }
+        catch (const std::exception& e) {
+            LWARNING(std::format(
+                "Failed to decode image '{}': {}", _files[it->first], e.what()
+            ));
+        }
+
+        std::unique_ptr<ghoul::opengl::Texture> t = createTexture(
+            it->first,
+            std::move(image)
+        );
+        if (t) {
+            _textures[it->first] = std::move(t);
+        }
+        else {
+            _failedImages.insert(it->first);
+        }
+        if (!isActive) {
+            nUploads++;
+        }
+        it = _decodings.erase(it);
+    }
+}
+
+void ImageSequencePrefetcher::evictTextures(const std::vector<int>& keep,
+                                            int activeIndex)
+{
+    while (static_cast<int>(_textures.size()) > _capacity) {
+        // Release the texture farthest away from the active image that is not coming up
+        auto farthest = _textures.end();
+        for (auto it = _textures.begin(); it != _textures.end(); it++) {
+            if (std::find(keep.begin(), keep.end(), it->first) != keep.end()) {
+                continue;
+            }
+            const int distance = std::abs(it->first - activeIndex);
+            if (farthest == _textures.end() ||
+                distance > std::abs(farthest->first - activeIndex))
+            {
+                farthest = it;
+            }
+        }
+        if (farthest == _textures.end()) {
+            break;
+        }
+        _textures.erase(farthest);
+    }
+}
+
+std::unique_ptr<ghoul::opengl::Texture> ImageSequencePrefetcher::createTexture(
+                                                                                int index,
+                                              std::unique_ptr<DecodedImage> image) const
+{
+    using namespace ghoul::opengl;
+
+    const std::filesystem::path& path = _files[index];
+    if (!image) {
+        // Fall back to the synchronous loading, which supports more file formats and
+        // reports a proper error if the file can not be read at all
+        std::unique_ptr<Texture> texture;
+        try {
+            texture = ghoul::io::TextureReader::ref().loadTexture(path, 2);
+        }
+        catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
+            LERRORC(e.component, e.message);
+            return nullptr;
+        }
+        if (!texture) {
+            return nullptr;
+        }
+        texture->uploadTexture();
+        texture->setFilter(Texture::FilterMode::Linear);
+        texture->purgeFromRAM();
+        return texture;
+    }
+
+    Texture::Format format = Texture::Format::RGBA;
+    GLenum internalFormat = GL_RGBA;
+    switch (image->nChannels) {
+        case 1:
+            format = Texture::Format::Red;
+            internalFormat = GL_RED;
+            break;
+        case 2:
+            format = Texture::Format::RG;
+            internalFormat = GL_RG;
+            break;
+        case 3:
+            format = Texture::Format::RGB;
+            internalFormat = GL_RGB;
+            break;
+        default:
+            break;
+    }
+
+    auto texture = std::make_unique<Texture>(
+        glm::uvec3(image->size, 1),
+        GL_TEXTURE_2D,
+        format,
+        internalFormat,
+        GL_UNSIGNED_BYTE,
+        Texture::FilterMode::Linear,
+        Texture::WrappingMode::Repeat,
+        Texture::AllocateData::No,
+        Texture::TakeOwnership::No
+    );
+    // The rows of RGB images don't need to start on 4-byte boundaries
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // The pixels are owned by the decoded image, which is discarded after the upload
+    texture->setPixelData(image->pixels.data(), Texture::TakeOwnership::No);
+    texture->uploadTexture();
+    texture->setPixelData(nullptr, Texture::TakeOwnership::No);
+    LDEBUG(std::format("Loaded image '{}'", path));
+    return texture;
+}
+
+std::unique_ptr<ImageSequencePrefetcher::DecodedImage>
+ImageSequencePrefetcher::decodeImage(std::filesystem::path path)
+{
+    // Match the orientation of the images that are loaded through the TextureReader.
+    // The thread-local version is used as other threads might be decoding images too
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    int width = 0;
+    int height = 0;
+    int nChannels = 0;
+    stbi_uc* data = stbi_load(path.string().c_str(), &width, &height, &nChannels, 0);
+    if (!data) {
+        // Not necessarily an error, as the TextureReader supports more file formats
+        return nullptr;
+    }
+
+    auto image = std::make_unique<DecodedImage>();
+    image->size = glm::uvec2(width, height);
+    image->nChannels = nChannels;
+    const size_t nBytes =
+        static_cast<size_t>(width) * static_cast<size_t>(height) * nChannels;
+    image->pixels.assign(data, data + nBytes);
+    stbi_image_free(data);
+    return image;
+}
+
+} // namespace openspace
@@ -0,0 +1,136 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___IMAGESEQUENCEPREFETCHER___H__
+#define __OPENSPACE_MODULE_BASE___IMAGESEQUENCEPREFETCHER___H__
+
+#include <ghoul/glm.h>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+/**
+ * Keeps the textures of a time-varying sequence of images resident around the current
+ * time. Every image has a start time at which it becomes active. Based on the current
+ * time and the amount of time that passes each frame, the next images that will become
+ * active are decoded on the global thread pool ahead of time and are uploaded on the
+ * main thread once they are ready. Images that would only be active for less than a
+ * frame are skipped when the sequence is played back quickly.
+ *
+ * At most `capacity` textures are kept resident at the same time; the textures farthest
+ * away from the active image are released first. If the active image is not resident
+ * yet, the resident image closest to it is used instead, so that the rendering never
+ * has to wait for an image to be loaded.
+ *
+ * All functions of this class have to be called from the main thread.
+ */
+class ImageSequencePrefetcher {
+public:
+    /**
+     * Creates a prefetcher that decodes up to \p nPrefetch images ahead of the active
+     * image and that keeps up to \p capacity textures resident.
+     *
+     * \pre nPrefetch must be non-negative
+     * \pre capacity must be bigger than \p nPrefetch
+     */
+    explicit ImageSequencePrefetcher(int nPrefetch = 8, int capacity = 16);
+    ~ImageSequencePrefetcher();
+
+    /**
+     * Sets the images of the sequence. The \p startTimes has to be sorted and contain
+     * the time at which each of the \p files becomes active. All textures and pending
+     * decodings of a previous sequence are discarded.
+     */
+    void setImages(std::vector<std::filesystem::path> files,
+        std::vector<double> startTimes);
+
+    /**
+     * Starts decoding the images that will become active next and uploads the images
+     * that have finished decoding. Has to be called once per frame with an OpenGL
+     * context being current.
+     *
+     * \param currentTime The current time in the same unit as the start times
+     * \param timeStep The amount of time that has passed since the previous frame. The
+     *        sign of the value determines in which direction images are prefetched
+     */
+    void update(double currentTime, double timeStep);
+
+    /**
+     * Returns the texture for the image with the provided \p index, or the resident
+     * texture closest to it if that image has not been loaded yet. Returns `nullptr` if
+     * no texture is resident at all.
+     */
+    ghoul::opengl::Texture* texture(int index) const;
+
+    /**
+     * Releases all textures, for example when the owning renderable is disabled or
+     * before the OpenGL context is destroyed. Pending decodings are discarded.
+     */
+    void clear();
+
+private:
+    struct DecodedImage {
+        std::vector<unsigned char> pixels;
+        glm::uvec2 size = glm::uvec2(0);
+        int nChannels = 0;
+    };
+
+    /// Decodes the image on disk, returns `nullptr` if the file could not be decoded
+    static std::unique_ptr<DecodedImage> decodeImage(std::filesystem::path path);
+
+    /// Returns the index of the image that is active at \p time
+    int indexForTime(double time) const;
+
+    /// Returns the indices of the active image and the images that will follow it
+    std::vector<int> upcomingIndices(double currentTime, double timeStep) const;
+
+    void finishDecodings(int activeIndex);
+    void evictTextures(const std::vector<int>& keep, int activeIndex);
+    std::unique_ptr<ghoul::opengl::Texture> createTexture(int index,
+        std::unique_ptr<DecodedImage> image) const;
+
+    std::vector<std::filesystem::path> _files;
+    std::vector<double> _startTimes;
+
+    /// The resident textures, indexed by the index of their image
+    std::map<int, std::unique_ptr<ghoul::opengl::Texture>> _textures;
+    /// The images that are currently decoded on the thread pool
+    std::map<int, std::future<std::unique_ptr<DecodedImage>>> _decodings;
+    /// The images that could not be loaded, which are not requested again
+    std::set<int> _failedImages;
+
+    int _nPrefetch = 0;
+    int _capacity = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___IMAGESEQUENCEPREFETCHER___H__
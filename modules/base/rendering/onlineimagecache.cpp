@@ -0,0 +1,259 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/onlineimagecache.h>
+
+#include <openspace/engine/globals.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/format.h>
+#include <ghoul/io/texture/texturereader.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/opengl/texture.h>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+
+namespace {
+    constexpr std::string_view _loggerCat = "OnlineImageCache";
+
+    // Extension of the file that contains the metadata of an image on disk
+    constexpr std::string_view MetadataExtension = ".meta";
+
+    // Information about an image on disk that comes from the response that delivered it
+    struct Metadata {
+        std::string url;
+        std::string etag;
+        std::string lastModified;
+        std::string format;
+    };
+
+    std::filesystem::path withExtension(std::filesystem::path path,
+                                        std::string_view extension)
+    {
+        path += extension;
+        return path;
+    }
+
+    std::optional<Metadata> readMetadata(const std::filesystem::path& cachePath) {
+        std::ifstream file = std::ifstream(withExtension(cachePath, MetadataExtension));
+        if (!file.good()) {
+            return std::nullopt;
+        }
+
+        Metadata metadata;
+        std::getline(file, metadata.url);
+        std::getline(file, metadata.etag);
+        std::getline(file, metadata.lastModified);
+        std::getline(file, metadata.format);
+        if (file.fail() || metadata.format.empty()) {
+            return std::nullopt;
+        }
+        return metadata;
+    }
+
+    // Called on the download thread
+    void writeCachedImage(const std::filesystem::path& cachePath, const std::string& url,
+                          const openspace::DownloadManager::MemoryFile& file)
+    {
+        if (file.isNotModified || file.format.empty()) {
+            return;
+        }
+
+        // The image is written before the metadata, so that a metadata file never
+        // refers to an incomplete image
+        const std::filesystem::path image = withExtension(cachePath, "." + file.format);
+        {
+            std::ofstream out = std::ofstream(image, std::ofstream::binary);
+            out.write(file.buffer, static_cast<std::streamsize>(file.size));
+            if (!out.good()) {
+                LWARNING(std::format("Could not write cached image '{}'", image));
+                return;
+            }
+        }
+
+        std::ofstream out = std::ofstream(withExtension(cachePath, MetadataExtension));
+        out << url << '\n'
+            << file.etag << '\n'
+            << file.lastModified << '\n'
+            << file.format << '\n';
+    }
+} // namespace
+
+namespace openspace {
+
+OnlineImageCache::Image OnlineImageCache::image(const std::string& url) {
+    auto it = _entries.find(url);
+    if (it == _entries.end()) {
+        it = _entries.emplace(url, Entry()).first;
+    }
+    Entry& entry = it->second;
+
+    std::shared_ptr<ghoul::opengl::Texture> texture = entry.texture.lock();
+    if (texture) {
+        return { .texture = std::move(texture), .hasFailed = false };
+    }
+
+    if (!entry.download.valid()) {
+        entry.download = startDownload(url);
+    }
+    if (!DownloadManager::futureReady(entry.download)) {
+        return { .texture = nullptr, .hasFailed = false };
+    }
+
+    DownloadManager::MemoryFile file = entry.download.get();
+    texture = loadTexture(url, file);
+    free(file.buffer);
+
+    if (!texture) {
+        // The next request for this URL will try again
+        _entries.erase(it);
+        return { .texture = nullptr, .hasFailed = true };
+    }
+
+    entry.texture = texture;
+    return { .texture = std::move(texture), .hasFailed = false };
+}
+
+void OnlineImageCache::deinitialize() {
+    // Downloads that are still running have to finish before their entries go away
+    for (std::pair<const std::string, Entry>& p : _entries) {
+        if (p.second.download.valid()) {
+            DownloadManager::MemoryFile file = p.second.download.get();
+            free(file.buffer);
+        }
+    }
+    _entries.clear();
+}
+
+std::future<DownloadManager::MemoryFile> OnlineImageCache::startDownload(
+                                                                   const std::string& url)
+{
+    const std::filesystem::path path = cachePath(url);
+
+    // If we have a copy of the image, we only want to download it again if it has changed
+    std::vector<std::string> headers;
+    const std::optional<Metadata> metadata = readMetadata(path);
+    if (metadata.has_value() && metadata->url == url &&
+        std::filesystem::is_regular_file(withExtension(path, "." + metadata->format)))
+    {
+        if (!metadata->etag.empty()) {
+            headers.push_back(std::format("If-None-Match: {}", metadata->etag));
+        }
+        if (!metadata->lastModified.empty()) {
+            headers.push_back(
+                std::format("If-Modified-Since: {}", metadata->lastModified)
+            );
+        }
+    }
+
+    return global::downloadManager->fetchFile(
+        url,
+        [path, url](const DownloadManager::MemoryFile& file) {
+            LDEBUG(std::format("Download to memory finished for image '{}'", url));
+            writeCachedImage(path, url, file);
+        },
+        [url](const std::string& err) {
+            LDEBUG(std::format("Download to memory failed for image '{}': {}", url, err));
+        },
+        std::move(headers)
+    );
+}
+
+std::shared_ptr<ghoul::opengl::Texture> OnlineImageCache::loadTexture(
+                                                                   const std::string& url,
+                                                  const DownloadManager::MemoryFile& file)
+{
+    using namespace ghoul::opengl;
+
+    std::unique_ptr<Texture> texture;
+    try {
+        if (!file.corrupted && !file.isNotModified) {
+            texture = ghoul::io::TextureReader::ref().loadTexture(
+                reinterpret_cast<void*>(file.buffer),
+                file.size,
+                2,
+                file.format
+            );
+        }
+        else {
+            // Either the image has not changed since it was downloaded, or the server
+            // could not be reached. In both cases the copy on disk is used, if it exists
+            const std::filesystem::path path = cachePath(url);
+            const std::optional<Metadata> metadata = readMetadata(path);
+            const std::filesystem::path image =
+                metadata.has_value() && metadata->url == url ?
+                withExtension(path, "." + metadata->format) :
+                std::filesystem::path();
+
+            if (image.empty() || !std::filesystem::is_regular_file(image)) {
+                LERROR(std::format("Error loading image from URL '{}'", url));
+                return nullptr;
+            }
+            if (file.corrupted) {
+                LWARNING(std::format(
+                    "Could not download image from URL '{}', using the cached copy", url
+                ));
+            }
+            texture = ghoul::io::TextureReader::ref().loadTexture(image, 2);
+        }
+    }
+    catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
+        LERRORC(e.component, e.message);
+        return nullptr;
+    }
+
+    if (!texture) {
+        return nullptr;
+    }
+
+    // Images don't need to start on 4-byte boundaries, for example if the image is only
+    // RGB
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (texture->format() == Texture::Format::Red) {
+        texture->setSwizzleMask({ GL_RED, GL_RED, GL_RED, GL_ONE });
+    }
+
+    texture->uploadTexture();
+    texture->setFilter(Texture::FilterMode::LinearMipMap);
+    texture->purgeFromRAM();
+    return texture;
+}
+
+std::filesystem::path OnlineImageCache::cachePath(const std::string& url) {
+    if (_directory.empty()) {
+        _directory = absPath("${CACHE}/onlineimages");
+        std::filesystem::create_directories(_directory);
+    }
+
+    // 64-bit FNV-1a, which, unlike std::hash, is stable between runs and platforms
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : url) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ULL;
+    }
+    return _directory / std::format("{:016x}", hash);
+}
+
+} // namespace openspace
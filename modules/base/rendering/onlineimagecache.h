@@ -0,0 +1,97 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___ONLINEIMAGECACHE___H__
+#define __OPENSPACE_MODULE_BASE___ONLINEIMAGECACHE___H__
+
+#include <openspace/engine/downloadmanager.h>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+/**
+ * A cache for images that are loaded from a URL, which is shared by all renderables that
+ * display online images. Downloaded images are stored on disk together with the `ETag`
+ * and `Last-Modified` headers of the response. The next time the same URL is requested,
+ * possibly in a later session, these are sent as a conditional request and the copy on
+ * disk is used if the server reports that the image has not changed, or if the server
+ * cannot be reached at all.
+ *
+ * The texture of an image is shared by everyone requesting the same URL for as long as
+ * at least one of them keeps the texture alive, so that the image is neither downloaded
+ * nor decoded more than once.
+ *
+ * All functions of this class have to be called from the main thread.
+ */
+class OnlineImageCache {
+public:
+    struct Image {
+        /// The uploaded texture, or `nullptr` if the image is still loading or has failed
+        std::shared_ptr<ghoul::opengl::Texture> texture;
+        /// `true` if the image could neither be downloaded nor be loaded from the disk
+        bool hasFailed = false;
+    };
+
+    /**
+     * Returns the image for the provided \p url. The first call for a URL starts loading
+     * the image, and this function has to be called repeatedly, for example in an update
+     * function, until it either returns a texture or reports that the loading has failed.
+     *
+     * \param url The URL of the image that is requested
+     * \return The state of the image with the provided \p url
+     */
+    Image image(const std::string& url);
+
+    /**
+     * Releases all textures that are held by the cache. Has to be called before the
+     * OpenGL context is destroyed.
+     */
+    void deinitialize();
+
+private:
+    struct Entry {
+        std::future<DownloadManager::MemoryFile> download;
+        std::weak_ptr<ghoul::opengl::Texture> texture;
+    };
+
+    std::future<DownloadManager::MemoryFile> startDownload(const std::string& url);
+    std::shared_ptr<ghoul::opengl::Texture> loadTexture(const std::string& url,
+        const DownloadManager::MemoryFile& file);
+
+    /// Returns the path, without extension, at which the image for the \p url is cached
+    std::filesystem::path cachePath(const std::string& url);
+
+    std::map<std::string, Entry> _entries;
+    std::filesystem::path _directory;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___ONLINEIMAGECACHE___H__
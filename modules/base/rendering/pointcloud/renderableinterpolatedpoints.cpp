@@ -35,6 +35,8 @@
 #include <ghoul/misc/interpolator.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
+#include <ghoul/misc/profiling.h>
+#include <chrono>
 #include <optional>
 
 namespace {
@@ -254,6 +256,11 @@ RenderableInterpolatedPoints::RenderableInterpolatedPoints(
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
+    // The level of detail octree only knows about the positions of a single time step,
+    // so it can't be used while interpolating between them
+    _levelOfDetail.enabled = false;
+    _levelOfDetail.enabled.setReadOnly(true);
+
     addPropertySubOwner(_interpolation);
 
     if (p.interpolation.has_value()) {
@@ -269,20 +276,11 @@ RenderableInterpolatedPoints::RenderableInterpolatedPoints(
     }
 
     _interpolation.value.onChange([this]() {
-        bool passedAKnot =
-            glm::ceil(_interpolation.value) != glm::ceil(_prevInterpolationValue);
-
-        if (passedAKnot) {
-            _dataIsDirty = true;
-        }
+        // Used to decide which time step to load next
+        _isInterpolatingForward = _interpolation.value >= _prevInterpolationValue;
         _prevInterpolationValue = _interpolation.value;
     });
 
-    _interpolation.useSpline.onChange([this]() {
-        _dataIsDirty = true;
-        _shouldReinitializeBufferdata = true;
-    });
-
     _nObjectsInDataset = static_cast<unsigned int>(p.numberOfObjects);
 
     if (_skipFirstDataPoint) {
@@ -292,6 +290,14 @@ RenderableInterpolatedPoints::RenderableInterpolatedPoints(
         );
         _skipFirstDataPoint = false;
     }
+
+    if (_streamData) {
+        LWARNING(
+            "Found setting to stream the data in asset. This is not supported for "
+            "interpolated point clouds. Ignoring"
+        );
+        _streamData = false;
+    }
 }
 
 void RenderableInterpolatedPoints::initialize() {
@@ -330,8 +336,6 @@ void RenderableInterpolatedPoints::initializeShadersAndGlExtras() {
             );
         }
     );
-
-    initializeBufferData();
 }
 
 void RenderableInterpolatedPoints::deinitializeShaders() {
@@ -352,137 +356,250 @@ void RenderableInterpolatedPoints::setExtraUniforms() {
     _program->setUniform("useSpline", useSplineInterpolation());
 }
 
-void RenderableInterpolatedPoints::preUpdate() {
-    if (_shouldReinitializeBufferdata) {
-        initializeBufferData();
-        _shouldReinitializeBufferdata = false;
+void RenderableInterpolatedPoints::deinitializeGL() {
+    for (std::pair<const unsigned int, TimeStep>& step : _timeSteps) {
+        glDeleteBuffers(1, &step.second.buffer);
     }
-}
+    _timeSteps.clear();
 
-int RenderableInterpolatedPoints::nAttributesPerPoint() const {
-    int n = RenderablePointCloud::nAttributesPerPoint();
+    RenderablePointCloud::deinitializeGL();
+}
 
-    // Always at least three extra position values (xyz)
-    n += 3;
-    if (useSplineInterpolation()) {
-        // Use two more positions (xyz)
-        n += 2 * 3;
-    }
-    if (useOrientationData()) {
-        // Use one more orientation quaternion (wxyz)
-        n += 4;
+void RenderableInterpolatedPoints::preUpdate() {
+    // If the data is dirty, the time steps are updated once the buffers are recreated
+    if (!_dataIsDirty) {
+        updateTimeSteps();
     }
-    // And potentially some more color and size data
-    n += hasColorData() ? 1 : 0;
-    n += hasSizeData() ? 1 : 0;
-
-    return n;
 }
 
 bool RenderableInterpolatedPoints::useSplineInterpolation() const {
     return _interpolation.useSpline && _interpolation.nSteps > 1;
 }
 
-void RenderableInterpolatedPoints::addPositionDataForPoint(unsigned int index,
-                                                           std::vector<float>& result,
-                                                           double& maxRadius) const
+RenderableInterpolatedPoints::StepData RenderableInterpolatedPoints::createStepData(
+                                  std::shared_ptr<const dataloader::Dataset> dataset,
+                                  std::shared_ptr<const std::vector<unsigned int>> order,
+                                  StepLayout layout, unsigned int step,
+                                  unsigned int nObjects) const
 {
-    using namespace dataloader;
-    auto [firstIndex, secondIndex] = interpolationIndices(index);
+    ZoneScoped;
+
+    StepData result;
+    result.values.reserve(order->size() * layout.nValues);
+    for (const unsigned int object : *order) {
+        const size_t index = static_cast<size_t>(step) * nObjects + object;
+        const dataloader::Dataset::EntryView e = dataset->entries[index];
+
+        const glm::dvec3 position = transformedPosition(e);
+        result.maxRadius = std::max(result.maxRadius, glm::length(position));
+        result.values.push_back(static_cast<float>(position.x));
+        result.values.push_back(static_cast<float>(position.y));
+        result.values.push_back(static_cast<float>(position.z));
+
+        if (layout.colorIndex != -1) {
+            result.values.push_back(dataset->entries.column(layout.colorIndex)[index]);
+        }
+        if (layout.sizeIndex != -1) {
+            // @TODO: Consider more detailed control over the scaling. Currently the
+            // value is multiplied with the value as is. Should have similar mapping
+            // properties as the color mapping
+            const float value = dataset->entries.column(layout.sizeIndex)[index];
+            result.values.push_back(layout.sizeMultiplier * value);
+        }
+        if (layout.useOrientation) {
+            const glm::quat q = orientationQuaternion(e);
+            result.values.push_back(q.x);
+            result.values.push_back(q.y);
+            result.values.push_back(q.z);
+            result.values.push_back(q.w);
+        }
+    }
+    return result;
+}
+
+void RenderableInterpolatedPoints::requestTimeStep(unsigned int step) {
+    if (_timeSteps.contains(step)) {
+        return;
+    }
 
-    const Dataset::Entry& e0 = _dataset.entries[firstIndex];
-    const Dataset::Entry& e1 = _dataset.entries[secondIndex];
+    TimeStep& timeStep = _timeSteps[step];
+    timeStep.data = std::async(
+        std::launch::async,
+        [this, dataset = _dataset, order = _objectOrder, layout = _stepLayout, step,
+         nObjects = _nObjectsInDataset]()
+        {
+            return createStepData(dataset, order, layout, step, nObjects);
+        }
+    );
+}
 
-    glm::dvec3 position0 = transformedPosition(e0);
-    glm::dvec3 position1 = transformedPosition(e1);
+void RenderableInterpolatedPoints::uploadTimeStep(TimeStep& timeStep) {
+    ZoneScopedN("Upload time step");
+    TracyGpuZone("Upload time step");
 
-    const double r = glm::max(glm::length(position0), glm::length(position1));
-    maxRadius = glm::max(maxRadius, r);
+    const StepData data = timeStep.data.get();
 
-    for (int j = 0; j < 3; ++j) {
-        result.push_back(static_cast<float>(position0[j]));
-    }
+    glGenBuffers(1, &timeStep.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, timeStep.buffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        data.values.size() * sizeof(float),
+        data.values.data(),
+        GL_STATIC_DRAW
+    );
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Includes all time steps that have been loaded so far, so that the points are not
+    // culled while they are moving between the steps
+    _maxRadius = std::max(_maxRadius, data.maxRadius);
+    setBoundingSphere(_maxRadius);
+}
 
-    for (int j = 0; j < 3; ++j) {
-        result.push_back(static_cast<float>(position1[j]));
+void RenderableInterpolatedPoints::updateTimeSteps() {
+    if (!_hasDataFile || _dataset->entries.empty() || !_objectOrder) {
+        return;
     }
 
-    if (useSplineInterpolation()) {
-        // Compute the extra positions, before and after the other ones. But make sure
-        // we do not overflow the allowed bound for the current interpolation step
-        int beforeIndex = glm::max(static_cast<int>(firstIndex - _nDataPoints), 0);
-        int maxT = static_cast<int>(_interpolation.value.maxValue() - 1.f);
-        int maxAllowedindex = maxT * _nDataPoints + index;
-        int afterIndex = glm::min(
-            static_cast<int>(secondIndex + _nDataPoints),
-            maxAllowedindex
-        );
+    const unsigned int lastStep = _interpolation.nSteps - 1;
+    const unsigned int lower = static_cast<unsigned int>(computeCurrentLowerValue());
+    const unsigned int upper = static_cast<unsigned int>(computeCurrentUpperValue());
+    const bool useSpline = useSplineInterpolation();
+
+    // The spline also needs the steps before and after the interpolated ones. These are
+    // clamped to the ends of the dataset
+    const std::array<unsigned int, 4> steps = {
+        lower > 0 ? lower - 1 : 0,
+        lower,
+        upper,
+        std::min(upper + 1, lastStep)
+    };
 
-        const Dataset::Entry& e00 = _dataset.entries[beforeIndex];
-        const Dataset::Entry& e11 = _dataset.entries[afterIndex];
-        glm::dvec3 positionBefore = transformedPosition(e00);
-        glm::dvec3 positionAfter = transformedPosition(e11);
+    // The step that comes after the ones that are needed in the direction in which the
+    // value is changing is loaded in the background, so that it is available by the time
+    // the interpolation reaches it
+    const unsigned int nextStep = _isInterpolatingForward ?
+        std::min(useSpline ? steps[3] + 1 : upper + 1, lastStep) :
+        (useSpline ? (steps[0] > 0 ? steps[0] - 1 : 0) : steps[0]);
+
+    auto isBound = [&](unsigned int step) {
+        const bool isInterpolated = step == lower || step == upper;
+        const bool isSplineStep = useSpline && (step == steps[0] || step == steps[3]);
+        return isInterpolated || isSplineStep;
+    };
+    auto isUsed = [&](unsigned int step) { return isBound(step) || step == nextStep; };
 
-        for (int j = 0; j < 3; ++j) {
-            result.push_back(static_cast<float>(positionBefore[j]));
+    // The steps that are interpolated right now have to be available, so if they were
+    // not loaded in advance we have to wait for them
+    for (const unsigned int step : steps) {
+        if (isBound(step)) {
+            requestTimeStep(step);
+        }
+    }
+    requestTimeStep(nextStep);
+
+    for (auto it = _timeSteps.begin(); it != _timeSteps.end();) {
+        TimeStep& timeStep = it->second;
+        if (timeStep.data.valid()) {
+            const bool isReady =
+                timeStep.data.wait_for(std::chrono::seconds(0)) ==
+                std::future_status::ready;
+            if (isBound(it->first) || isReady) {
+                uploadTimeStep(timeStep);
+            }
         }
 
-        for (int j = 0; j < 3; ++j) {
-            result.push_back(static_cast<float>(positionAfter[j]));
+        // Unused steps are removed, unless they are still being created, as that would
+        // block until they are done
+        if (!isUsed(it->first) && !timeStep.data.valid()) {
+            glDeleteBuffers(1, &timeStep.buffer);
+            it = _timeSteps.erase(it);
         }
+        else {
+            it++;
+        }
+    }
+
+    const std::array<unsigned int, 4> boundSteps = useSpline ?
+        steps :
+        std::array<unsigned int, 4>{ lower, lower, upper, upper };
+    if (boundSteps != _boundSteps || useSpline != _isSplineBound) {
+        bindTimeSteps(boundSteps, useSpline);
     }
 }
 
-void RenderableInterpolatedPoints::addColorAndSizeDataForPoint(unsigned int index,
-                                                        std::vector<float>& result) const
+void RenderableInterpolatedPoints::bindTimeSteps(const std::array<unsigned int, 4>& steps,
+                                                 bool useSpline)
 {
-    using namespace dataloader;
-    auto [firstIndex, secondIndex] = interpolationIndices(index);
-    const Dataset::Entry& e0 = _dataset.entries[firstIndex];
-    const Dataset::Entry& e1 = _dataset.entries[secondIndex];
+    const int nValues = _stepLayout.nValues;
+    auto bindStep = [this, nValues](unsigned int step, std::string_view suffix,
+                                    bool onlyPosition)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, _timeSteps.at(step).buffer);
+
+        int offset = bufferVertexAttribute(
+            std::format("in_position{}", suffix),
+            3,
+            nValues,
+            0
+        );
+        if (onlyPosition) {
+            return;
+        }
+        if (_stepLayout.colorIndex != -1) {
+            offset = bufferVertexAttribute(
+                std::format("in_colorParameter{}", suffix),
+                1,
+                nValues,
+                offset
+            );
+        }
+        if (_stepLayout.sizeIndex != -1) {
+            offset = bufferVertexAttribute(
+                std::format("in_scalingParameter{}", suffix),
+                1,
+                nValues,
+                offset
+            );
+        }
+        if (_stepLayout.useOrientation) {
+            bufferVertexAttribute(
+                std::format("in_orientation{}", suffix),
+                4,
+                nValues,
+                offset
+            );
+        }
+    };
 
-    if (hasColorData()) {
-        const int colorParamIndex = currentColorParameterIndex();
-        result.push_back(e0.data[colorParamIndex]);
-        result.push_back(e1.data[colorParamIndex]);
+    // Switching between the time steps only changes which buffers the attributes are
+    // read from. The interpolation itself happens in the vertex shader
+    glBindVertexArray(_vao);
+    bindStep(steps[1], "0", false);
+    bindStep(steps[2], "1", false);
+    if (useSpline) {
+        bindStep(steps[0], "_before", true);
+        bindStep(steps[3], "_after", true);
+    }
+    else {
+        glDisableVertexAttribArray(_program->attributeLocation("in_position_before"));
+        glDisableVertexAttribArray(_program->attributeLocation("in_position_after"));
     }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    if (hasSizeData()) {
-        const int sizeParamIndex = currentSizeParameterIndex();
-        // @TODO: Consider more detailed control over the scaling. Currently the value
-        // is multiplied with the value as is. Should have similar mapping properties
-        // as the color mapping
+    _boundSteps = steps;
+    _isSplineBound = useSpline;
+}
 
-        // Convert to diameter if data is given as radius
-        float multiplier = _sizeSettings.sizeMapping->isRadius ? 2.f : 1.f;
-        result.push_back(multiplier * e0.data[sizeParamIndex]);
-        result.push_back(multiplier * e1.data[sizeParamIndex]);
+void RenderableInterpolatedPoints::updateBufferData() {
+    if (!_hasDataFile || _dataset->entries.empty()) {
+        return;
     }
-}
 
-void RenderableInterpolatedPoints::addOrientationDataForPoint(unsigned int index,
-                                                        std::vector<float>& result) const
-{
-    using namespace dataloader;
-    auto [firstIndex, secondIndex] = interpolationIndices(index);
-    const Dataset::Entry& e0 = _dataset.entries[firstIndex];
-    const Dataset::Entry& e1 = _dataset.entries[secondIndex];
-
-    glm::quat q0 = orientationQuaternion(e0);
-    glm::quat q1 = orientationQuaternion(e1);
-
-    result.push_back(q0.x);
-    result.push_back(q0.y);
-    result.push_back(q0.z);
-    result.push_back(q0.w);
-
-    result.push_back(q1.x);
-    result.push_back(q1.y);
-    result.push_back(q1.z);
-    result.push_back(q1.w);
-}
+    ZoneScopedN("Data dirty");
+    TracyGpuZone("Data dirty");
+    LDEBUG("Regenerating data");
 
-void RenderableInterpolatedPoints::initializeBufferData() {
     if (_vao == 0) {
         glGenVertexArrays(1, &_vao);
         LDEBUG(std::format("Generating Vertex Array id '{}'", _vao));
@@ -492,65 +609,70 @@ void RenderableInterpolatedPoints::initializeBufferData() {
         LDEBUG(std::format("Generating Vertex Buffer Object id '{}'", _vbo));
     }
 
-    const int attibsPerPoint = nAttributesPerPoint();
-    const unsigned int bufferSize = attibsPerPoint * _nDataPoints * sizeof(float);
-
-    // Allocate the memory for the buffer (we will want to upload the data quite often)
-    glBindVertexArray(_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(GL_ARRAY_BUFFER, bufferSize, nullptr, GL_DYNAMIC_DRAW);
-
-    int offset = 0;
-
-    offset = bufferVertexAttribute("in_position0", 3, attibsPerPoint, offset);
-    offset = bufferVertexAttribute("in_position1", 3, attibsPerPoint, offset);
-
-    if (useSplineInterpolation()) {
-        offset = bufferVertexAttribute("in_position_before", 3, attibsPerPoint, offset);
-        offset = bufferVertexAttribute("in_position_after", 3, attibsPerPoint, offset);
+    // The values that a time step contains might have changed, so all of them have to
+    // be recreated
+    for (std::pair<const unsigned int, TimeStep>& step : _timeSteps) {
+        glDeleteBuffers(1, &step.second.buffer);
     }
+    _timeSteps.clear();
+    _boundSteps = { 0, 0, 0, 0 };
+    _maxRadius = 0.0;
+
+    // The objects are sorted by the texture array they are rendered with, and every time
+    // step stores them in the same order
+    auto order = std::make_shared<std::vector<unsigned int>>();
+    order->reserve(_nDataPoints);
+    const std::vector<std::vector<unsigned int>> arrays = pointsPerTextureArray();
+    for (size_t i = 0; i < arrays.size(); i++) {
+        if (!_textureArrays.empty()) {
+            _textureArrays[i].nPoints = static_cast<int>(arrays[i].size());
+            _textureArrays[i].startOffset = static_cast<GLint>(order->size());
+        }
+        order->insert(order->end(), arrays[i].begin(), arrays[i].end());
+    }
+    _objectOrder = order;
 
+    _stepLayout = StepLayout();
+    _stepLayout.nValues = 3;
     if (hasColorData()) {
-        offset = bufferVertexAttribute("in_colorParameter0", 1, attibsPerPoint, offset);
-        offset = bufferVertexAttribute("in_colorParameter1", 1, attibsPerPoint, offset);
+        _stepLayout.colorIndex = currentColorParameterIndex();
+        _stepLayout.nValues += 1;
     }
-
     if (hasSizeData()) {
-        offset = bufferVertexAttribute("in_scalingParameter0", 1, attibsPerPoint, offset);
-        offset = bufferVertexAttribute("in_scalingParameter1", 1, attibsPerPoint, offset);
+        _stepLayout.sizeIndex = currentSizeParameterIndex();
+        // Convert to diameter if data is given as radius
+        _stepLayout.sizeMultiplier = _sizeSettings.sizeMapping->isRadius ? 2.f : 1.f;
+        _stepLayout.nValues += 1;
     }
-
     if (useOrientationData()) {
-        offset = bufferVertexAttribute("in_orientation0", 4, attibsPerPoint, offset);
-        offset = bufferVertexAttribute("in_orientation1", 4, attibsPerPoint, offset);
-    }
-
-    if (_hasSpriteTexture) {
-        offset = bufferVertexAttribute("in_textureLayer", 1, attibsPerPoint, offset);
+        _stepLayout.useOrientation = true;
+        _stepLayout.nValues += 4;
     }
 
-    glBindVertexArray(0);
-}
-
-void RenderableInterpolatedPoints::updateBufferData() {
-    if (!_hasDataFile || _dataset.entries.empty()) {
-        return;
-    }
-
-    ZoneScopedN("Data dirty");
-    TracyGpuZone("Data dirty");
-    LDEBUG("Regenerating data");
-
-    // Regenerate data and update buffer
-    std::vector<float> slice = createDataSlice();
-
+    // The texture layer is the same for all time steps, so it is stored separately
     glBindVertexArray(_vao);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, slice.size() * sizeof(float), slice.data());
-
+    if (_hasSpriteTexture) {
+        std::vector<float> layers;
+        layers.reserve(order->size());
+        for (const unsigned int object : *order) {
+            layers.push_back(static_cast<float>(textureLocation(object).layer));
+        }
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            layers.size() * sizeof(float),
+            layers.data(),
+            GL_STATIC_DRAW
+        );
+        bufferVertexAttribute("in_textureLayer", 1, 1, 0);
+    }
     glBindVertexArray(0);
 
     _dataIsDirty = false;
+
+    // Force the attributes to be bound to the new buffers
+    _isSplineBound = !useSplineInterpolation();
+    updateTimeSteps();
 }
 
 bool RenderableInterpolatedPoints::isAtKnot() const {
@@ -578,18 +700,4 @@ float RenderableInterpolatedPoints::computeCurrentUpperValue() const {
     return t1;
 }
 
-std::pair<size_t, size_t>
-RenderableInterpolatedPoints::interpolationIndices(unsigned int index) const
-{
-    float t0 = computeCurrentLowerValue();
-    float t1 = computeCurrentUpperValue();
-    unsigned int t0Index = static_cast<unsigned int>(t0);
-    unsigned int t1Index = static_cast<unsigned int>(t1);
-
-    size_t lower = size_t(t0Index * _nDataPoints + index);
-    size_t upper = size_t(t1Index * _nDataPoints + index);
-
-    return { lower, upper };
-}
-
 } // namespace openspace
@@ -31,6 +31,10 @@
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/scalar/uintproperty.h>
 #include <openspace/properties/triggerproperty.h>
+#include <array>
+#include <future>
+#include <map>
+#include <memory>
 
 namespace ghoul::opengl { class Texture; }
 
@@ -56,43 +60,60 @@ protected:
     void setExtraUniforms() override;
     void preUpdate() override;
 
-    int nAttributesPerPoint() const override;
+    void deinitializeGL() override;
 
     bool useSplineInterpolation() const;
 
+    void updateBufferData() override;
+
+private:
+    bool isAtKnot() const;
+    float computeCurrentLowerValue() const;
+    float computeCurrentUpperValue() const;
+
+    /// The layout of the values that are stored for each point in a time step buffer
+    struct StepLayout {
+        int colorIndex = -1;
+        int sizeIndex = -1;
+        float sizeMultiplier = 1.f;
+        bool useOrientation = false;
+        int nValues = 0;
+    };
+
+    struct StepData {
+        std::vector<float> values;
+        double maxRadius = 0.0;
+    };
+
     /**
-     * Create the rendering data for the positions for the point with the given index
-     * and append that to the result. Compared to the base class, this class may require
-     * 2-4 positions, depending on if spline interpolation is used or not.
-     *
-     * The values are computed based on the current interpolation value.
-     *
-     * Also, compute the maxRadius to use for setting the bounding sphere.
+     * A time step that is resident on the GPU. While the data is being created in the
+     * background, the `data` future is valid and the `buffer` has not been created yet.
      */
-    void addPositionDataForPoint(unsigned int index, std::vector<float>& result,
-        double& maxRadius) const override;
+    struct TimeStep {
+        GLuint buffer = 0;
+        std::future<StepData> data;
+    };
 
     /**
-     * Create the rendering data for the color and size data for the point with the given
-     * index and append that to the result. Compared to the base class, this class require
-     * 2 values per data value, to use for interpolation.
-     *
-     * The values are computed based on the current interpolation value.
+     * Create the values for all points in the given time step, in the order given by
+     * \p order. This function is executed on a worker thread, so everything that it
+     * needs is passed in rather than being read from the member variables.
      */
-    void addColorAndSizeDataForPoint(unsigned int index,
-        std::vector<float>& result) const override;
-
-    void addOrientationDataForPoint(unsigned int index,
-        std::vector<float>& result) const override;
+    StepData createStepData(std::shared_ptr<const dataloader::Dataset> dataset,
+        std::shared_ptr<const std::vector<unsigned int>> order, StepLayout layout,
+        unsigned int step, unsigned int nObjects) const;
 
-    void initializeBufferData();
-    void updateBufferData() override;
+    /// Start creating the data for the time step \p step, if it doesn't exist already
+    void requestTimeStep(unsigned int step);
+    void uploadTimeStep(TimeStep& timeStep);
 
-private:
-    bool isAtKnot() const;
-    float computeCurrentLowerValue() const;
-    float computeCurrentUpperValue() const;
-    std::pair<size_t, size_t> interpolationIndices(unsigned int index) const;
+    /**
+     * Make sure that the time steps that are needed for the current interpolation value
+     * are on the GPU, start loading the step that will be needed next, and remove the
+     * steps that are no longer used.
+     */
+    void updateTimeSteps();
+    void bindTimeSteps(const std::array<unsigned int, 4>& steps, bool useSpline);
 
     struct Interpolation : public properties::PropertyOwner {
         Interpolation();
@@ -112,7 +133,16 @@ private:
     Interpolation _interpolation;
 
     float _prevInterpolationValue = 0.f;
-    bool _shouldReinitializeBufferdata = false;
+    bool _isInterpolatingForward = true;
+
+    std::map<unsigned int, TimeStep> _timeSteps;
+    std::shared_ptr<const std::vector<unsigned int>> _objectOrder;
+    StepLayout _stepLayout;
+    double _maxRadius = 0.0;
+
+    /// The steps (before, lower, upper, after) that the vertex attributes are bound to
+    std::array<unsigned int, 4> _boundSteps = { 0, 0, 0, 0 };
+    bool _isSplineBound = false;
 
     unsigned int _nObjectsInDataset = 0;
 };
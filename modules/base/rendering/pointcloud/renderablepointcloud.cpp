@@ -25,9 +25,11 @@
 #include <modules/base/rendering/pointcloud/renderablepointcloud.h>
 
 #include <modules/base/basemodule.h>
+#include <openspace/data/speckloader.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/windowdelegate.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/rendering/renderengine.h>
 #include <ghoul/filesystem/file.h>
@@ -36,8 +38,10 @@
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/crc32.h>
+#include <ghoul/misc/exception.h>
 #include <ghoul/misc/templatefactory.h>
 #include <ghoul/misc/profiling.h>
+#include <ghoul/misc/stringhelper.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
@@ -46,6 +50,7 @@
 #include <glm/gtx/string_cast.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/vector_angle.hpp>
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
@@ -53,11 +58,33 @@
 #include <fstream>
 #include <locale>
 #include <optional>
+#include <random>
 #include <string>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderablePointCloud";
 
+    // The number of points that are uploaded to the GPU per frame when streaming data
+    constexpr size_t StreamChunkSize = 1 << 18;
+
+    // The maximum number of loaded chunks that are waiting to be uploaded. The loading
+    // thread pauses once this many are waiting, so that the positions of the entire
+    // dataset are never held in memory at once
+    constexpr size_t MaxQueuedStreamChunks = 4;
+
+    // Returns a copy of the dataset without its first point. The loaded dataset may be
+    // shared with other renderables, so it cannot be modified in place
+    std::shared_ptr<const openspace::dataloader::Dataset> withoutFirstPoint(
+                                  const openspace::dataloader::Dataset& dataset)
+    {
+        auto result = std::make_shared<openspace::dataloader::Dataset>(dataset);
+        if (!result->entries.empty()) {
+            result->entries.erase(result->entries.begin());
+            result->computeStatistics();
+        }
+        return result;
+    }
+
     enum RenderOption {
         ViewDirection = 0,
         PositionNormal,
@@ -175,6 +202,62 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo EnableLevelOfDetailInfo = {
+        "Enabled",
+        "Enabled",
+        "If true, the points are sorted into an octree and each cell of the octree only "
+        "stores a representative subset of the points in it. Cells that are far away, "
+        "or outside of the view, are then rendered with fewer points, or not at all, so "
+        "that the full detail is only drawn close to the camera.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PointsPerCellInfo = {
+        "PointsPerCell",
+        "Points per Cell",
+        "The maximum number of representative points that every cell of the level of "
+        "detail octree stores. The remaining points of the cell are distributed to its "
+        "children. Changing this value rebuilds the octree.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo RefinementThresholdInfo = {
+        "RefinementThreshold",
+        "Refinement Threshold",
+        "The size in pixels that a cell of the level of detail octree has to cover on "
+        "the screen before the points of its children are rendered as well. Smaller "
+        "values render more points.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The maximum depth of the level of detail octree. All points that remain in a cell
+    // at this depth are stored in that cell, which prevents endless subdivision for
+    // points that share the same position
+    constexpr int MaxLodDepth = 21;
+
+    // Returns true if the axis-aligned box with the provided center and half size is
+    // completely on the outside of one of the planes of the view frustum
+    bool isOutsideFrustum(const glm::dmat4& modelViewProjection, const glm::dvec3& center,
+                          double halfSize)
+    {
+        std::array<int, 6> nOutside = {};
+        for (int i = 0; i < 8; i++) {
+            const glm::dvec3 corner = center + halfSize * glm::dvec3(
+                (i & 1) ? 1.0 : -1.0,
+                (i & 2) ? 1.0 : -1.0,
+                (i & 4) ? 1.0 : -1.0
+            );
+            const glm::dvec4 clip = modelViewProjection * glm::dvec4(corner, 1.0);
+            nOutside[0] += clip.x < -clip.w;
+            nOutside[1] += clip.x > clip.w;
+            nOutside[2] += clip.y < -clip.w;
+            nOutside[3] += clip.y > clip.w;
+            nOutside[4] += clip.z < -clip.w;
+            nOutside[5] += clip.z > clip.w;
+        }
+        return std::find(nOutside.begin(), nOutside.end(), 8) != nOutside.end();
+    }
+
     constexpr openspace::properties::Property::PropertyInfo UseAdditiveBlendingInfo = {
         "UseAdditiveBlending",
         "Use Additive Blending",
@@ -186,6 +269,18 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo
+        UseOrderIndependentTransparencyInfo =
+    {
+        "UseOrderIndependentTransparency",
+        "Use Order-Independent Transparency",
+        "If true, the points are rendered with weighted blended order-independent "
+        "transparency. This gives a correct looking result for overlapping transparent "
+        "points without having to sort them, at the cost of an additional pass in the "
+        "renderer. If this is enabled, the additive blending setting is ignored.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo UseOrientationDataInfo = {
         "UseOrientationData",
         "Use Orientation Data",
@@ -346,6 +441,16 @@ namespace {
         // changes to the color map.
         std::optional<bool> useCaching;
 
+        // If true, the dataset is loaded in a background thread and the points are
+        // uploaded to the GPU in chunks as they become available, rather than blocking
+        // until the entire dataset is loaded. This gives faster feedback for very large
+        // datasets. Streaming is only used if the data file is a SPECK file, the points
+        // are not color mapped or size mapped, use a single texture, and no labels are
+        // created from the dataset. Otherwise, the dataset is loaded as usual. The
+        // streamed dataset is only kept on the GPU, and it is loaded again if any of the
+        // settings are changed that require the buffer to be regenerated.
+        std::optional<bool> streamData;
+
         // A dictionary specifying details on how to load the dataset. Updating the data
         // mapping will lead to a new cached version of the dataset.
         std::optional<ghoul::Dictionary> dataMapping
@@ -392,6 +497,9 @@ namespace {
         // [[codegen::verbatim(UseAdditiveBlendingInfo.description)]]
         std::optional<bool> useAdditiveBlending;
 
+        // [[codegen::verbatim(UseOrderIndependentTransparencyInfo.description)]]
+        std::optional<bool> useOrderIndependentTransparency;
+
         // If true, skip the first data point in the loaded dataset.
         std::optional<bool> skipFirstDataPoint;
 
@@ -480,6 +588,21 @@ namespace {
         // origin of the dataset.
         std::optional<Fading> fading;
 
+        struct LevelOfDetail {
+            // [[codegen::verbatim(EnableLevelOfDetailInfo.description)]]
+            std::optional<bool> enabled;
+
+            // [[codegen::verbatim(PointsPerCellInfo.description)]]
+            std::optional<int> pointsPerCell [[codegen::greater(0)]];
+
+            // [[codegen::verbatim(RefinementThresholdInfo.description)]]
+            std::optional<float> refinementThreshold [[codegen::greater(0.f)]];
+        };
+        // Settings related to rendering a decimated set of points for parts of the
+        // dataset that are far away from the camera. Intended for very large datasets.
+        // Not supported while the dataset is being streamed.
+        std::optional<LevelOfDetail> levelOfDetail;
+
         // Transformation matrix to be applied to the position of each object.
         std::optional<glm::dmat4x4> transformationMatrix;
     };
@@ -629,12 +752,36 @@ RenderablePointCloud::Fading::Fading(const ghoul::Dictionary& dictionary)
     addProperty(invert);
 }
 
+RenderablePointCloud::LevelOfDetail::LevelOfDetail(const ghoul::Dictionary& dictionary)
+    : properties::PropertyOwner({ "LevelOfDetail", "Level of Detail", "" })
+    , enabled(EnableLevelOfDetailInfo, false)
+    , pointsPerCell(PointsPerCellInfo, 2048, 1, 1 << 20)
+    , refinementThreshold(RefinementThresholdInfo, 256.f, 1.f, 4096.f)
+{
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    if (p.levelOfDetail.has_value()) {
+        const Parameters::LevelOfDetail l = *p.levelOfDetail;
+        enabled = l.enabled.value_or(true);
+        pointsPerCell = l.pointsPerCell.value_or(pointsPerCell);
+        refinementThreshold = l.refinementThreshold.value_or(refinementThreshold);
+    }
+
+    addProperty(enabled);
+    addProperty(pointsPerCell);
+    addProperty(refinementThreshold);
+}
+
 RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
-    : Renderable(dictionary)
+    : Renderable(dictionary, {
+        .updatePolicy = UpdatePolicy::WhenVisible | UpdatePolicy::OnPropertyChange
+    })
     , _sizeSettings(dictionary)
     , _colorSettings(dictionary)
     , _fading(dictionary)
+    , _levelOfDetail(dictionary)
     , _useAdditiveBlending(UseAdditiveBlendingInfo, true)
+    , _useOrderIndependentTransparency(UseOrderIndependentTransparencyInfo, false)
     , _useRotation(UseOrientationDataInfo, false)
     , _drawElements(DrawElementsInfo, true)
     , _renderOption(
@@ -681,6 +828,11 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
     _useAdditiveBlending = p.useAdditiveBlending.value_or(_useAdditiveBlending);
     addProperty(_useAdditiveBlending);
 
+    _useOrderIndependentTransparency = p.useOrderIndependentTransparency.value_or(
+        _useOrderIndependentTransparency
+    );
+    addProperty(_useOrderIndependentTransparency);
+
     if (p.unit.has_value()) {
         _unit = codegen::map<DistanceUnit>(*p.unit);
     }
@@ -745,6 +897,16 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
         addPropertySubOwner(_fading);
     }
 
+    if (p.levelOfDetail.has_value()) {
+        // The points have to be sorted into the octree before it can be used
+        _levelOfDetail.enabled.onChange([this]() { _dataIsDirty = true; });
+        _levelOfDetail.pointsPerCell.onChange([this]() {
+            _lodOctreesAreDirty = true;
+            _dataIsDirty = true;
+        });
+        addPropertySubOwner(_levelOfDetail);
+    }
+
     if (p.coloring.has_value() && (*p.coloring).colorMapping.has_value()) {
         _hasColorMapFile = true;
 
@@ -754,7 +916,7 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
 
         _colorSettings.colorMapping->setRangeFromData.onChange([this]() {
             int parameterIndex = currentColorParameterIndex();
-            _colorSettings.colorMapping->valueRange = _dataset.findValueRange(
+            _colorSettings.colorMapping->valueRange = _dataset->findValueRange(
                 parameterIndex
             );
         });
@@ -768,6 +930,7 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
     }
 
     _useCaching = p.useCaching.value_or(_useCaching);
+    _streamData = p.streamData.value_or(_streamData);
 
     _skipFirstDataPoint = p.skipFirstDataPoint.value_or(_skipFirstDataPoint);
 
@@ -820,25 +983,45 @@ void RenderablePointCloud::initialize() {
             break;
     }
 
-    if (_hasDataFile) {
-        if (_useCaching) {
-            _dataset = dataloader::data::loadFileWithCache(_dataFile, _dataMapping);
+    if (_hasDataFile && _streamData) {
+        if (canStreamData()) {
+            // The buffer will be filled as the chunks are loaded, so there is nothing to
+            // generate until then
+            _streaming.isActive = true;
+            _streaming.isFinished = false;
+            _streaming.shouldStop = false;
+            _streaming.nTotalPoints = std::nullopt;
+            _streaming.hasFailed = false;
+            _streaming.maxRadius = 0.0;
+            _streaming.maxPositionComponent = 0.0;
+            _streaming.needsDataset = false;
+            _nDataPoints = 0;
+            _dataIsDirty = false;
+
+            // The loading thread must not access any of the properties, so the values
+            // that are needed to transform the positions are copied here
+            const double unitMeter = toMeter(_unit);
+            const glm::dmat4 transform = _transformationMatrix;
+            _streaming.task = std::async(
+                std::launch::async,
+                [this, unitMeter, transform]() { loadStreamedData(unitMeter, transform); }
+            );
         }
         else {
-            _dataset = dataloader::data::loadFile(_dataFile, _dataMapping);
-        }
-
-        if (_skipFirstDataPoint) {
-            _dataset.entries.erase(_dataset.entries.begin());
+            LWARNING(std::format(
+                "Streaming of '{}' is not supported with the current settings, loading "
+                "the dataset as a whole", _dataFile
+            ));
         }
+    }
 
-        _nDataPoints = static_cast<unsigned int>(_dataset.entries.size());
-        _hasOrientationData = _dataset.orientationDataIndex >= 0;
+    if (_hasDataFile && !_streaming.isActive) {
+        loadDataset();
 
         // If no scale exponent was specified, compute one that will at least show the
         // points based on the scale of the positions in the dataset
         if (_shouldComputeScaleExponent) {
-            double dist = _dataset.maxPositionComponent * toMeter(_unit);
+            double dist = _dataset->maxPositionComponent * toMeter(_unit);
             if (dist > 0.0) {
                 float exponent = static_cast<float>(std::log10(dist));
                 // Reduce the actually used exponent a little bit, as just using the
@@ -849,12 +1032,12 @@ void RenderablePointCloud::initialize() {
     }
 
     if (_hasDataFile && _hasColorMapFile) {
-        _colorSettings.colorMapping->initialize(_dataset, _useCaching);
+        _colorSettings.colorMapping->initialize(*_dataset, _useCaching);
     }
 
     if (_hasLabels) {
         if (_createLabelsFromDataset) {
-            _labels->loadLabelsFromDataset(_dataset, _unit);
+            _labels->loadLabelsFromDataset(*_dataset, _unit);
         }
         _labels->initialize();
     }
@@ -866,6 +1049,7 @@ void RenderablePointCloud::initializeGL() {
     initializeShadersAndGlExtras();
 
     ghoul::opengl::updateUniformLocations(*_program, _uniformCache);
+    _vboMemory = trackedAllocation("Base", MemoryTracker::Type::Vram);
 
     if (_hasSpriteTexture) {
         switch (_textureMode) {
@@ -884,11 +1068,31 @@ void RenderablePointCloud::initializeGL() {
     }
 }
 
+void RenderablePointCloud::deinitialize() {
+    if (_streaming.task.valid()) {
+        {
+            // The flag has to be set while holding the lock, or the loading thread
+            // could miss the notification between checking the flag and waiting
+            std::lock_guard lock(_streaming.mutex);
+            _streaming.shouldStop = true;
+        }
+        _streaming.hasSpace.notify_all();
+        _streaming.task.wait();
+    }
+    _streaming.isActive = false;
+}
+
 void RenderablePointCloud::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
+    _vboMemory = MemoryTracker::Allocation();
     glDeleteVertexArrays(1, &_vao);
     _vao = 0;
+    _streaming.isAllocated = false;
 
     deinitializeShaders();
 
@@ -939,7 +1143,7 @@ void RenderablePointCloud::initializeSingleTexture() {
 }
 
 void RenderablePointCloud::initializeMultiTextures() {
-    for (const dataloader::Dataset::Texture& tex : _dataset.textures) {
+    for (const dataloader::Dataset::Texture& tex : _dataset->textures) {
         std::filesystem::path path = _texturesDirectory / tex.file;
 
         if (!std::filesystem::is_regular_file(path)) {
@@ -961,6 +1165,7 @@ void RenderablePointCloud::clearTextureDataStructures() {
     // Unload texture arrays from GPU memory
     for (const TextureArrayInfo& arrayInfo : _textureArrays) {
         glDeleteTextures(1, &arrayInfo.renderId);
+        glDeleteTextures(1, &arrayInfo.layerInfoId);
     }
     _textureArrays.clear();
     _textureIndexToArrayMap.clear();
@@ -1015,13 +1220,11 @@ void RenderablePointCloud::initAndAllocateTextureArray(unsigned int textureId,
                                                        size_t nLayers,
                                                        bool useAlpha)
 {
-    float w = static_cast<float>(resolution.x);
-    float h = static_cast<float>(resolution.y);
-    glm::vec2 aspectScale = w > h ? glm::vec2(1.f, h / w) : glm::vec2(w / h, 1.f);
-
     _textureArrays.push_back({
         .renderId = textureId,
-        .aspectRatioScale = aspectScale
+        .resolution = resolution,
+        .useAlpha = useAlpha,
+        .layerInfo = std::vector<glm::vec4>(nLayers, glm::vec4(1.f))
     });
 
     gl::GLenum internalFormat = internalGlFormat(useAlpha);
@@ -1056,6 +1259,45 @@ void RenderablePointCloud::fillAndUploadTextureLayer(unsigned int arrayIndex,
                                                      bool useAlpha,
                                                      const void* pixelData)
 {
+    TextureArrayInfo& arrayInfo = _textureArrays[arrayIndex];
+
+    float w = static_cast<float>(resolution.x);
+    float h = static_cast<float>(resolution.y);
+    glm::vec2 aspectScale = w > h ? glm::vec2(1.f, h / w) : glm::vec2(w / h, 1.f);
+    glm::vec2 texCoordScale = glm::vec2(resolution) / glm::vec2(arrayInfo.resolution);
+    arrayInfo.layerInfo[layer] = glm::vec4(texCoordScale, aspectScale);
+
+    // A texture that is smaller than the array, or that lacks the alpha channel of the
+    // array, is copied into a full layer first. This clears the padding around it and
+    // avoids partial updates of compressed layers, which have to be block aligned
+    std::vector<GLubyte> paddedData;
+    if (resolution != arrayInfo.resolution || useAlpha != arrayInfo.useAlpha) {
+        const size_t nChannels = useAlpha ? 4 : 3;
+        const size_t nArrayChannels = arrayInfo.useAlpha ? 4 : 3;
+        const GLubyte* data = static_cast<const GLubyte*>(pixelData);
+
+        paddedData.resize(
+            static_cast<size_t>(arrayInfo.resolution.x) * arrayInfo.resolution.y *
+            nArrayChannels,
+            0
+        );
+        for (size_t y = 0; y < resolution.y; y++) {
+            for (size_t x = 0; x < resolution.x; x++) {
+                const GLubyte* src = data + (y * resolution.x + x) * nChannels;
+                GLubyte* dst =
+                    &paddedData[(y * arrayInfo.resolution.x + x) * nArrayChannels];
+                std::copy(src, src + nChannels, dst);
+                if (nArrayChannels > nChannels) {
+                    dst[3] = 255;
+                }
+            }
+        }
+
+        resolution = arrayInfo.resolution;
+        useAlpha = arrayInfo.useAlpha;
+        pixelData = paddedData.data();
+    }
+
     gl::GLenum format = gl::GLenum(glFormat(useAlpha));
 
     glTexSubImage3D(
@@ -1080,32 +1322,82 @@ void RenderablePointCloud::fillAndUploadTextureLayer(unsigned int arrayIndex,
     };
 }
 
+void RenderablePointCloud::uploadTextureLayerInfo(unsigned int arrayIndex) {
+    TextureArrayInfo& arrayInfo = _textureArrays[arrayIndex];
+
+    if (arrayInfo.layerInfoId == 0) {
+        glGenTextures(1, &arrayInfo.layerInfoId);
+    }
+    glBindTexture(GL_TEXTURE_1D, arrayInfo.layerInfoId);
+    glTexImage1D(
+        GL_TEXTURE_1D,
+        0,
+        GL_RGBA32F,
+        static_cast<gl::GLsizei>(arrayInfo.layerInfo.size()),
+        0,
+        GL_RGBA,
+        GL_FLOAT,
+        arrayInfo.layerInfo.data()
+    );
+    // The values are read with texelFetch, so no filtering should be applied
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_1D, 0);
+}
+
 void RenderablePointCloud::generateArrayTextures() {
+    if (_textures.empty()) {
+        return;
+    }
+
+    // All textures are placed in one texture array that is big enough to fit the
+    // largest of them, so that the points can be rendered with a single draw call. If
+    // any of the textures use the alpha channel, all of them will
     using Entry = std::pair<const TextureFormat, std::vector<size_t>>;
-    unsigned int arrayIndex = 0;
+    glm::uvec2 res = glm::uvec2(0);
+    bool useAlpha = false;
     for (const Entry& e : _textureMapByFormat) {
-        glm::uvec2 res = e.first.resolution;
-        bool useAlpha = e.first.useAlpha;
-        std::vector<size_t> textureListIndices = e.second;
-        size_t nLayers = textureListIndices.size();
+        res = glm::max(res, e.first.resolution);
+        useAlpha |= e.first.useAlpha;
+    }
+    size_t nLayers = _textures.size();
 
-        // Generate an array texture storage
-        unsigned int id = 0;
-        glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+    if (_textureMapByFormat.size() > 1) {
+        LDEBUG(std::format(
+            "Combining {} textures with {} different formats into one {}x{} texture "
+            "array", nLayers, _textureMapByFormat.size(), res.x, res.y
+        ));
+    }
 
-        initAndAllocateTextureArray(id, res, nLayers, useAlpha);
+    int nMaxTextureLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &nMaxTextureLayers);
+    if (static_cast<int>(nLayers) > nMaxTextureLayers) {
+        LERROR(std::format(
+            "Too many layers bound in the same texture array. Found {} textures. Max "
+            "supported is {}", nLayers, nMaxTextureLayers
+        ));
+        // @TODO: Should we split the array up? Do we think this will ever become
+        // a problem?
+    }
+
+    // Generate an array texture storage
+    unsigned int id = 0;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, id);
 
-        // Fill that storage with the data from the individual textures
-        unsigned int layer = 0;
-        for (const size_t& i : textureListIndices) {
+    initAndAllocateTextureArray(id, res, nLayers, useAlpha);
+
+    // Fill that storage with the data from the individual textures
+    unsigned int layer = 0;
+    for (const Entry& e : _textureMapByFormat) {
+        for (const size_t& i : e.second) {
             ghoul::opengl::Texture* texture = _textures[i].get();
             fillAndUploadTextureLayer(
-                arrayIndex,
+                0,
                 layer,
                 i,
-                res,
-                useAlpha,
+                e.first.resolution,
+                e.first.useAlpha,
                 texture->pixelData()
             );
             layer++;
@@ -1114,23 +1406,11 @@ void RenderablePointCloud::generateArrayTextures() {
             // the textures need updating, we will reload them from file
             texture->purgeFromRAM();
         }
+    }
 
-        int nMaxTextureLayers = 0;
-        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &nMaxTextureLayers);
-        if (static_cast<int>(layer) > nMaxTextureLayers) {
-            LERROR(std::format(
-                "Too many layers bound in the same texture array. Found {} textures with "
-                "resolution {}x{} pixels. Max supported is {}.",
-                layer, res.x, res.y, nMaxTextureLayers
-            ));
-            // @TODO: Should we split the array up? Do we think this will ever become
-            // a problem?
-        }
-
-        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
-        arrayIndex++;
-    }
+    uploadTextureLayerInfo(0);
 }
 
 float RenderablePointCloud::computeDistanceFadeValue(const RenderData& data) const {
@@ -1169,24 +1449,35 @@ void RenderablePointCloud::renderPoints(const RenderData& data,
                                         const glm::dvec3& orthoUp,
                                         float fadeInVariable)
 {
-    if (!_hasDataFile || _dataset.entries.empty()) {
+    // A streamed dataset is not kept in memory, but the points are in the buffer
+    const bool hasStreamedPoints = _streaming.isActive || _streaming.needsDataset;
+    if (!_hasDataFile || (_dataset->entries.empty() && !hasStreamedPoints)) {
         return;
     }
 
-    glEnablei(GL_BLEND, 0);
+    // With order-independent transparency, the renderer has already set up the blending
+    // for its transparency buffers
+    if (!_useOrderIndependentTransparency) {
+        glEnablei(GL_BLEND, 0);
 
-    if (_useAdditiveBlending) {
-        glDepthMask(false);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    }
-    else {
-        // Normal blending, with transparency
-        glDepthMask(true);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        if (_useAdditiveBlending) {
+            glDepthMask(false);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        }
+        else {
+            // Normal blending, with transparency
+            glDepthMask(true);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
     }
 
     _program->activate();
 
+    _program->setUniform(
+        _uniformCache.useOrderIndependentTransparency,
+        _useOrderIndependentTransparency
+    );
+
     _program->setUniform(_uniformCache.cameraPosition, data.camera.positionVec3());
     _program->setUniform(
         _uniformCache.cameraLookUp,
@@ -1294,40 +1585,74 @@ void RenderablePointCloud::renderPoints(const RenderData& data,
 
     ghoul::opengl::TextureUnit spriteTextureUnit;
     _program->setUniform(_uniformCache.spriteTexture, spriteTextureUnit);
+    ghoul::opengl::TextureUnit spriteLayerInfoUnit;
+    _program->setUniform(_uniformCache.spriteLayerInfo, spriteLayerInfoUnit);
 
     setExtraUniforms();
 
+    // With the level of detail, only the cells of the octree that are visible and big
+    // enough on the screen are drawn. Their points are contiguous in the buffer, so each
+    // octree results in a list of ranges that are drawn in a single call
+    const bool useLevelOfDetail = _levelOfDetail.enabled && !_lodOctrees.empty();
+    const glm::dmat4 modelViewProjection = glm::dmat4(data.camera.projectionMatrix()) *
+        data.camera.combinedViewMatrix() * modelMatrix;
+    const glm::dvec3 cameraPosition = glm::dvec3(
+        glm::inverse(modelMatrix) * glm::dvec4(data.camera.positionVec3(), 1.0)
+    );
+    const double pixelsPerUnit = data.camera.projectionMatrix()[1][1] *
+        global::windowDelegate->currentDrawBufferResolution().y / 2.0;
+
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+    auto drawPoints = [&](size_t octreeIndex, GLint first, GLsizei count) {
+        if (!useLevelOfDetail || octreeIndex >= _lodOctrees.size()) {
+            glDrawArrays(GL_POINTS, first, count);
+            return;
+        }
+
+        firsts.clear();
+        counts.clear();
+        collectLodRanges(
+            _lodOctrees[octreeIndex],
+            first,
+            modelViewProjection,
+            cameraPosition,
+            pixelsPerUnit,
+            firsts,
+            counts
+        );
+        glMultiDrawArrays(
+            GL_POINTS,
+            firsts.data(),
+            counts.data(),
+            static_cast<GLsizei>(firsts.size())
+        );
+    };
+
     glBindVertexArray(_vao);
 
+    // All textures share the same texture array, and the layer that each point uses is
+    // stored in the vertex data. So all points are drawn at once
     if (useTexture && !_textureArrays.empty()) {
+        const TextureArrayInfo& arrayInfo = _textureArrays.front();
         spriteTextureUnit.activate();
-        for (const TextureArrayInfo& arrayInfo : _textureArrays) {
-            _program->setUniform(
-                _uniformCache.aspectRatioScale,
-                arrayInfo.aspectRatioScale
-            );
-            glBindTexture(GL_TEXTURE_2D_ARRAY, arrayInfo.renderId);
-            glDrawArrays(
-                GL_POINTS,
-                arrayInfo.startOffset,
-                static_cast<GLsizei>(arrayInfo.nPoints)
-            );
-        }
-        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-    }
-    else {
-        _program->setUniform(_uniformCache.aspectRatioScale, glm::vec2(1.f));
-        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_nDataPoints));
+        glBindTexture(GL_TEXTURE_2D_ARRAY, arrayInfo.renderId);
+        spriteLayerInfoUnit.activate();
+        glBindTexture(GL_TEXTURE_1D, arrayInfo.layerInfoId);
     }
+    drawPoints(0, 0, static_cast<GLsizei>(_nDataPoints));
 
     glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_1D, 0);
+    spriteTextureUnit.activate();
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     _program->deactivate();
 
     global::renderEngine->openglStateCache().resetBlendState();
     global::renderEngine->openglStateCache().resetDepthState();
 }
 
-void RenderablePointCloud::render(const RenderData& data, RendererTasks&) {
+void RenderablePointCloud::render(const RenderData& data, RendererTasks& rendererTask) {
     float fadeInVar = computeDistanceFadeValue(data);
 
     if (fadeInVar < 0.01f) {
@@ -1351,7 +1676,15 @@ void RenderablePointCloud::render(const RenderData& data, RendererTasks&) {
     }
     glm::dvec3 orthoUp = glm::normalize(glm::cross(cameraViewDirectionWorld, orthoRight));
 
-    if (_hasDataFile && _drawElements) {
+    if (_hasDataFile && _drawElements && _useOrderIndependentTransparency) {
+        // The points are drawn once the renderer has bound its transparency buffers
+        rendererTask.orderIndependentTransparencyTasks.push_back(
+            [this, data, modelMatrix, orthoRight, orthoUp, fadeInVar]() {
+                renderPoints(data, modelMatrix, orthoRight, orthoUp, fadeInVar);
+            }
+        );
+    }
+    else if (_hasDataFile && _drawElements) {
         renderPoints(data, modelMatrix, orthoRight, orthoUp, fadeInVar);
     }
 
@@ -1370,21 +1703,33 @@ void RenderablePointCloud::update(const UpdateData&) {
 
     preUpdate();
 
-    if (_hasColorMapFile) {
-        _colorSettings.colorMapping->update(_dataset, _useCaching);
+    if (_hasColorMapFile && !_streaming.isActive) {
+        _colorSettings.colorMapping->update(*_dataset, _useCaching);
     }
 
     if (_spriteTextureIsDirty) {
         updateSpriteTexture();
     }
 
-    if (_dataIsDirty) {
+    if (_streaming.isActive) {
+        updateStreamedData();
+    }
+
+    // Any changes that require regenerating the buffer during the streaming are applied
+    // once the full dataset is available
+    if (_dataIsDirty && !_streaming.isActive) {
+        if (_streaming.needsDataset) {
+            // The streamed dataset was not kept in memory, so it has to be loaded now
+            // that all of the data is required to regenerate the buffer
+            loadDataset();
+            _streaming.needsDataset = false;
+        }
         updateBufferData();
     }
 }
 
 glm::dvec3 RenderablePointCloud::transformedPosition(
-                                                const dataloader::Dataset::Entry& e) const
+                                            const dataloader::Dataset::EntryView& e) const
 {
     const double unitMeter = toMeter(_unit);
     glm::dvec4 position = glm::dvec4(glm::dvec3(e.position) * unitMeter, 1.0);
@@ -1392,9 +1737,9 @@ glm::dvec3 RenderablePointCloud::transformedPosition(
 }
 
 glm::quat RenderablePointCloud::orientationQuaternion(
-                                                const dataloader::Dataset::Entry& e) const
+                                            const dataloader::Dataset::EntryView& e) const
 {
-    const int orientationDataIndex = _dataset.orientationDataIndex;
+    const int orientationDataIndex = _dataset->orientationDataIndex;
 
     const glm::vec3 u = glm::normalize(glm::vec3(
         _transformationMatrix *
@@ -1459,7 +1804,7 @@ int RenderablePointCloud::bufferVertexAttribute(const std::string& name, GLint n
 }
 
 void RenderablePointCloud::updateBufferData() {
-    if (!_hasDataFile || _dataset.entries.empty()) {
+    if (!_hasDataFile || _dataset->entries.empty()) {
         return;
     }
 
@@ -1483,6 +1828,7 @@ void RenderablePointCloud::updateBufferData() {
     glBindVertexArray(_vao);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), slice.data(), GL_STATIC_DRAW);
+    _vboMemory.setSize(size * sizeof(float));
 
     const int attibsPerPoint = nAttributesPerPoint();
     int offset = 0;
@@ -1510,6 +1856,230 @@ void RenderablePointCloud::updateBufferData() {
     _dataIsDirty = false;
 }
 
+bool RenderablePointCloud::canStreamData() const {
+    // Only SPECK files can be read in chunks, the other formats are always read as a
+    // whole
+    const std::string extension = ghoul::toLowerCase(_dataFile.extension().string());
+    return extension == ".speck" && _textureMode == TextureInputMode::Single &&
+        !_hasColorMapFile && !_hasDatavarSize && !_createLabelsFromDataset;
+}
+
+void RenderablePointCloud::loadDataset() {
+    _dataset = dataloader::data::loadSharedFile(_dataFile, _dataMapping, _useCaching);
+
+    if (_skipFirstDataPoint) {
+        _dataset = withoutFirstPoint(*_dataset);
+    }
+
+    _nDataPoints = static_cast<unsigned int>(_dataset->entries.size());
+    _hasOrientationData = _dataset->orientationDataIndex >= 0;
+}
+
+void RenderablePointCloud::loadStreamedData(double unitMeter,
+                                            const glm::dmat4& transformationMatrix)
+{
+    ZoneScoped;
+
+    auto onHeader = [this](const dataloader::Dataset& header, size_t nLines) {
+        std::lock_guard lock(_streaming.mutex);
+        _streaming.nTotalPoints = static_cast<unsigned int>(nLines);
+        _streaming.hasOrientationData = header.orientationDataIndex >= 0;
+        return !_streaming.shouldStop;
+    };
+
+    bool isFirstChunk = true;
+    auto onChunk = [&](dataloader::Dataset::Entries entries) {
+        const std::vector<glm::vec3>& positions = entries.positions();
+        // The first point of the file is in the first chunk that contains any points
+        const size_t first = (_skipFirstDataPoint && isFirstChunk) ? 1 : 0;
+        if (!positions.empty()) {
+            isFirstChunk = false;
+        }
+
+        StreamingState::Chunk chunk;
+        chunk.positions.reserve(3 * positions.size());
+        for (size_t i = first; i < positions.size(); i++) {
+            const glm::vec3 p = positions[i];
+            chunk.maxPositionComponent = std::max(
+                chunk.maxPositionComponent,
+                static_cast<double>(glm::compMax(glm::abs(p)))
+            );
+
+            const glm::dvec3 position = glm::dvec3(
+                transformationMatrix * glm::dvec4(glm::dvec3(p) * unitMeter, 1.0)
+            );
+            chunk.positions.push_back(static_cast<float>(position.x));
+            chunk.positions.push_back(static_cast<float>(position.y));
+            chunk.positions.push_back(static_cast<float>(position.z));
+            chunk.maxRadius = std::max(chunk.maxRadius, glm::length(position));
+        }
+
+        // Wait until the main thread has caught up with the upload, or until the loading
+        // is cancelled
+        std::unique_lock lock(_streaming.mutex);
+        _streaming.hasSpace.wait(lock, [this]() {
+            return _streaming.chunks.size() < MaxQueuedStreamChunks ||
+                _streaming.shouldStop;
+        });
+        if (_streaming.shouldStop) {
+            return false;
+        }
+        _streaming.chunks.push_back(std::move(chunk));
+        return true;
+    };
+
+    bool hasFailed = false;
+    try {
+        dataloader::speck::streamSpeckFile(
+            _dataFile,
+            _dataMapping,
+            StreamChunkSize,
+            onHeader,
+            onChunk
+        );
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        hasFailed = true;
+    }
+
+    std::lock_guard lock(_streaming.mutex);
+    _streaming.hasFailed = hasFailed;
+    _streaming.isFinished = true;
+}
+
+void RenderablePointCloud::updateStreamedData() {
+    ZoneScoped;
+
+    std::optional<unsigned int> nTotalPoints;
+    std::optional<StreamingState::Chunk> chunk;
+    bool isFinished = false;
+    bool hasOrientationData = false;
+    bool hasFailed = false;
+    {
+        std::lock_guard lock(_streaming.mutex);
+        nTotalPoints = _streaming.nTotalPoints;
+        if (!_streaming.chunks.empty()) {
+            chunk = std::move(_streaming.chunks.front());
+            _streaming.chunks.pop_front();
+        }
+        isFinished = _streaming.isFinished && _streaming.chunks.empty();
+        hasOrientationData = _streaming.hasOrientationData;
+        hasFailed = _streaming.hasFailed;
+    }
+    if (chunk.has_value()) {
+        _streaming.hasSpace.notify_one();
+    }
+
+    if (nTotalPoints.has_value() && *nTotalPoints > 0 && !_streaming.isAllocated) {
+        TracyGpuZone("Allocate streaming buffer");
+
+        if (_vao == 0) {
+            glGenVertexArrays(1, &_vao);
+        }
+        if (_vbo == 0) {
+            glGenBuffers(1, &_vbo);
+        }
+
+        // No color, size, or orientation data is used while streaming, so the only
+        // attributes are the position and the texture layer
+        _streaming.nAttributesPerPoint = nAttributesPerPoint();
+        const int attribsPerPoint = _streaming.nAttributesPerPoint;
+
+        glBindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            *nTotalPoints * attribsPerPoint * sizeof(float),
+            nullptr,
+            GL_STATIC_DRAW
+        );
+        _vboMemory.setSize(*nTotalPoints * attribsPerPoint * sizeof(float));
+
+        int offset = bufferVertexAttribute("in_position", 3, attribsPerPoint, 0);
+        if (_hasSpriteTexture) {
+            offset = bufferVertexAttribute("in_textureLayer", 1, attribsPerPoint, offset);
+        }
+
+        glBindVertexArray(0);
+        _streaming.isAllocated = true;
+    }
+
+    if (chunk.has_value() && _streaming.isAllocated) {
+        TracyGpuZone("Upload streamed chunk");
+
+        const int attribsPerPoint = _streaming.nAttributesPerPoint;
+        const size_t nPoints = chunk->positions.size() / 3;
+
+        std::vector<float> data;
+        if (attribsPerPoint == 3) {
+            data = std::move(chunk->positions);
+        }
+        else {
+            // Interleave the positions with the (single) texture layer
+            data.resize(nPoints * attribsPerPoint, 0.f);
+            for (size_t i = 0; i < nPoints; i++) {
+                std::copy_n(&chunk->positions[3 * i], 3, &data[i * attribsPerPoint]);
+            }
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferSubData(
+            GL_ARRAY_BUFFER,
+            _nDataPoints.value() * attribsPerPoint * sizeof(float),
+            data.size() * sizeof(float),
+            data.data()
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        _nDataPoints = _nDataPoints.value() + static_cast<unsigned int>(nPoints);
+        if (!_textureArrays.empty()) {
+            _textureArrays.front().nPoints = _nDataPoints;
+            _textureArrays.front().startOffset = 0;
+        }
+
+        _streaming.maxRadius = std::max(_streaming.maxRadius, chunk->maxRadius);
+        setBoundingSphere(_streaming.maxRadius);
+
+        // The scale of the dataset is only known once all of it has been read, so the
+        // computed scale exponent is refined as the points come in
+        if (_shouldComputeScaleExponent &&
+            chunk->maxPositionComponent > _streaming.maxPositionComponent)
+        {
+            _streaming.maxPositionComponent = chunk->maxPositionComponent;
+            const double dist = _streaming.maxPositionComponent * toMeter(_unit);
+            if (dist > 0.0) {
+                float exponent = static_cast<float>(std::log10(dist));
+                _sizeSettings.scaleExponent = 0.9f * exponent;
+            }
+        }
+    }
+
+    if (!isFinished) {
+        return;
+    }
+
+    _streaming.task.wait();
+    _streaming.isActive = false;
+
+    if (hasFailed) {
+        // The error has already been logged
+        return;
+    }
+
+    // Only the GPU copy of the points is kept. The dataset is loaded once it is needed
+    // to regenerate the buffer
+    _streaming.needsDataset = true;
+    _hasOrientationData = hasOrientationData;
+    LDEBUG(std::format("Finished streaming {} points", _nDataPoints.value()));
+
+    // The streamed buffer does not contain the orientation data, so if that is used, or
+    // any other attributes have changed in the meantime, the buffer has to be recreated
+    if (nAttributesPerPoint() != _streaming.nAttributesPerPoint) {
+        _dataIsDirty = true;
+    }
+}
+
 void RenderablePointCloud::updateSpriteTexture() {
     bool shouldUpdate = _hasSpriteTexture && _spriteTextureIsDirty;
 
@@ -1522,8 +2092,11 @@ void RenderablePointCloud::updateSpriteTexture() {
 
     clearTextureDataStructures();
 
-    // We also have to update the dataset, to update the texture array offsets
+    // We also have to update the dataset, to update the texture array offsets. As the
+    // points might be assigned to other texture arrays, the octrees of the level of
+    // detail have to be rebuilt as well
     _dataIsDirty = true;
+    _lodOctreesAreDirty = true;
 
     // Always set the is-dirty flag, even if the loading fails, as to not try to reload
     // the texture without the input file being changed
@@ -1559,7 +2132,7 @@ int RenderablePointCloud::currentColorParameterIndex() const {
         return -1;
     }
 
-    return _dataset.index(property.option().description);
+    return _dataset->index(property.option().description);
 }
 
 int RenderablePointCloud::currentSizeParameterIndex() const {
@@ -1570,7 +2143,7 @@ int RenderablePointCloud::currentSizeParameterIndex() const {
         return -1;
     }
 
-    return _dataset.index(property.option().description);
+    return _dataset->index(property.option().description);
 }
 
 bool RenderablePointCloud::hasColorData() const {
@@ -1585,7 +2158,7 @@ bool RenderablePointCloud::hasSizeData() const {
 
 bool RenderablePointCloud::hasMultiTextureData() const {
     // What datavar is the texture, if any
-    const int textureIdIndex = _dataset.textureDataIndex;
+    const int textureIdIndex = _dataset->textureDataIndex;
     return _hasSpriteTexture && textureIdIndex >= 0;
 }
 
@@ -1597,7 +2170,7 @@ void RenderablePointCloud::addPositionDataForPoint(unsigned int index,
                                                    std::vector<float>& result,
                                                    double& maxRadius) const
 {
-    const dataloader::Dataset::Entry& e = _dataset.entries[index];
+    const dataloader::Dataset::EntryView e = _dataset->entries[index];
     glm::dvec3 position = transformedPosition(e);
     const double r = glm::length(position);
 
@@ -1612,11 +2185,9 @@ void RenderablePointCloud::addPositionDataForPoint(unsigned int index,
 void RenderablePointCloud::addColorAndSizeDataForPoint(unsigned int index,
                                                        std::vector<float>& result) const
 {
-    const dataloader::Dataset::Entry& e = _dataset.entries[index];
-
     if (hasColorData()) {
         const int colorParamIndex = currentColorParameterIndex();
-        result.push_back(e.data[colorParamIndex]);
+        result.push_back(_dataset->entries.column(colorParamIndex)[index]);
     }
 
     if (hasSizeData()) {
@@ -1627,14 +2198,14 @@ void RenderablePointCloud::addColorAndSizeDataForPoint(unsigned int index,
 
         // Convert to diameter if data is given as radius
         float multiplier = _sizeSettings.sizeMapping->isRadius ? 2.f : 1.f;
-        result.push_back(multiplier * e.data[sizeParamIndex]);
+        result.push_back(multiplier * _dataset->entries.column(sizeParamIndex)[index]);
     }
 }
 
 void RenderablePointCloud::addOrientationDataForPoint(unsigned int index,
                                                       std::vector<float>& result) const
 {
-    const dataloader::Dataset::Entry& e = _dataset.entries[index];
+    const dataloader::Dataset::EntryView e = _dataset->entries[index];
     glm::quat q = orientationQuaternion(e);
 
     result.push_back(q.x);
@@ -1643,10 +2214,56 @@ void RenderablePointCloud::addOrientationDataForPoint(unsigned int index,
     result.push_back(q.w);
 }
 
+RenderablePointCloud::TextureId
+RenderablePointCloud::textureLocation(unsigned int index)
+{
+    const bool useMultiTexture = (_textureMode == TextureInputMode::Multi) &&
+        hasMultiTextureData();
+    if (!useMultiTexture) {
+        // Default texture layer for single texture is zero
+        return TextureId{ 0, 0 };
+    }
+
+    const std::vector<float>& textureIndices =
+        _dataset->entries.column(_dataset->textureDataIndex);
+    int texId = static_cast<int>(textureIndices[index]);
+    size_t texIndex = _indexInDataToTextureIndex[texId];
+    return _textureIndexToArrayMap[texIndex];
+}
+
+std::vector<std::vector<unsigned int>> RenderablePointCloud::pointsPerTextureArray() {
+    // Sort the points by the texture array they belong to, since each of these will
+    // correspond to a separate draw call. We need at least one array
+    std::vector<std::vector<unsigned int>> result(
+        std::max<size_t>(_textureArrays.size(), 1)
+    );
+    for (unsigned int i = 0; i < _nDataPoints; i++) {
+        result[textureLocation(i).arrayId].push_back(i);
+    }
+
+    // With the level of detail, the points are stored in the order of the octree that is
+    // built for each texture array. The octrees only depend on the positions, so they
+    // are kept when only other attributes of the points change
+    if (_levelOfDetail.enabled) {
+        if (_lodOctreesAreDirty || _lodOctrees.size() != result.size()) {
+            LDEBUG("Building level of detail octree");
+            _lodOctrees.clear();
+            for (const std::vector<unsigned int>& points : result) {
+                _lodOctrees.push_back(buildLodOctree(points));
+            }
+            _lodOctreesAreDirty = false;
+        }
+        for (size_t i = 0; i < result.size(); i++) {
+            result[i] = _lodOctrees[i].pointOrder;
+        }
+    }
+    return result;
+}
+
 std::vector<float> RenderablePointCloud::createDataSlice() {
     ZoneScoped;
 
-    if (_dataset.entries.empty()) {
+    if (_dataset->entries.empty()) {
         return std::vector<float>();
     }
 
@@ -1660,41 +2277,29 @@ std::vector<float> RenderablePointCloud::createDataSlice() {
 
     // Reserve enough space for all points in each for now
     for (std::vector<float>& subres : subResults) {
-        subres.reserve(nAttributesPerPoint() * _dataset.entries.size());
+        subres.reserve(nAttributesPerPoint() * _dataset->entries.size());
     }
 
-    for (unsigned int i = 0; i < _nDataPoints; i++) {
-        const dataloader::Dataset::Entry& e = _dataset.entries[i];
-
-        unsigned int subresultIndex = 0;
-        // Default texture layer for single texture is zero
-        float textureLayer = 0.f;
-
-        bool useMultiTexture = (_textureMode == TextureInputMode::Multi) &&
-            hasMultiTextureData();
-
-        if (useMultiTexture) {
-            int texId = static_cast<int>(e.data[_dataset.textureDataIndex]);
-            size_t texIndex = _indexInDataToTextureIndex[texId];
-            textureLayer = static_cast<float>(
-                _textureIndexToArrayMap[texIndex].layer
-            );
-            subresultIndex = _textureIndexToArrayMap[texIndex].arrayId;
-        }
+    const std::vector<std::vector<unsigned int>> subPoints = pointsPerTextureArray();
 
+    for (size_t subresultIndex = 0; subresultIndex < subPoints.size(); subresultIndex++) {
         std::vector<float>& subArrayToUse = subResults[subresultIndex];
 
-        // Add position, color and size data (subclasses may compute these differently)
-        addPositionDataForPoint(i, subArrayToUse, maxRadius);
-        addColorAndSizeDataForPoint(i, subArrayToUse);
+        for (const unsigned int i : subPoints[subresultIndex]) {
+            // Add position, color and size data (subclasses may compute these
+            // differently)
+            addPositionDataForPoint(i, subArrayToUse, maxRadius);
+            addColorAndSizeDataForPoint(i, subArrayToUse);
 
-        if (useOrientationData()) {
-            addOrientationDataForPoint(i, subArrayToUse);
-        }
+            if (useOrientationData()) {
+                addOrientationDataForPoint(i, subArrayToUse);
+            }
 
-        // Texture layer
-        if (_hasSpriteTexture) {
-            subArrayToUse.push_back(static_cast<float>(textureLayer));
+            // Texture layer
+            if (_hasSpriteTexture) {
+                const float textureLayer = static_cast<float>(textureLocation(i).layer);
+                subArrayToUse.push_back(textureLayer);
+            }
         }
     }
 
@@ -1704,7 +2309,7 @@ std::vector<float> RenderablePointCloud::createDataSlice() {
 
     // Combine subresults, which should be in same order as texture arrays
     std::vector<float> result;
-    result.reserve(nAttributesPerPoint() * _dataset.entries.size());
+    result.reserve(nAttributesPerPoint() * _dataset->entries.size());
     size_t vertexCount = 0;
     for (size_t i = 0; i < subResults.size(); ++i) {
         result.insert(result.end(), subResults[i].begin(), subResults[i].end());
@@ -1721,6 +2326,160 @@ std::vector<float> RenderablePointCloud::createDataSlice() {
     return result;
 }
 
+RenderablePointCloud::LodOctree RenderablePointCloud::buildLodOctree(
+                                           const std::vector<unsigned int>& points) const
+{
+    ZoneScoped;
+
+    LodOctree octree;
+    if (points.empty()) {
+        return octree;
+    }
+
+    std::vector<LodPoint> lodPoints;
+    lodPoints.reserve(points.size());
+    glm::vec3 minPosition = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 maxPosition = glm::vec3(-std::numeric_limits<float>::max());
+    for (const unsigned int index : points) {
+        const glm::vec3 position = transformedPosition(_dataset->entries[index]);
+        minPosition = glm::min(minPosition, position);
+        maxPosition = glm::max(maxPosition, position);
+        lodPoints.push_back({ position, index });
+    }
+
+    // Shuffle the points with a fixed seed, so that the first points of every cell are a
+    // uniformly distributed subset of all points in that cell, and so that the octree is
+    // the same every time it is built
+    std::shuffle(lodPoints.begin(), lodPoints.end(), std::mt19937(0));
+
+    const glm::vec3 extent = (maxPosition - minPosition) / 2.f;
+    const float halfSize = std::max(std::max({ extent.x, extent.y, extent.z }), 1.f);
+
+    octree.pointOrder.reserve(points.size());
+    std::vector<LodPoint> scratch = std::vector<LodPoint>(lodPoints.size());
+    const glm::vec3 center = (minPosition + maxPosition) / 2.f;
+    buildLodCell(octree, lodPoints, scratch, center, halfSize, 0);
+    return octree;
+}
+
+int RenderablePointCloud::buildLodCell(LodOctree& octree, std::span<LodPoint> points,
+                                       std::span<LodPoint> scratch, glm::vec3 center,
+                                       float halfSize, int depth) const
+{
+    const int cellIndex = static_cast<int>(octree.cells.size());
+    const size_t maxPoints = std::max(_levelOfDetail.pointsPerCell.value(), 1u);
+    const size_t nOwnPoints =
+        depth == MaxLodDepth ? points.size() : std::min(points.size(), maxPoints);
+
+    LodCell cell;
+    cell.center = center;
+    cell.halfSize = halfSize;
+    cell.first = static_cast<GLint>(octree.pointOrder.size());
+    cell.count = static_cast<GLsizei>(nOwnPoints);
+    cell.children.fill(-1);
+    octree.cells.push_back(cell);
+    for (const LodPoint& point : points.first(nOwnPoints)) {
+        octree.pointOrder.push_back(point.index);
+    }
+
+    // Distribute the remaining points to the octants, while keeping them in their
+    // shuffled order, so that the first points of each child are representative as well
+    std::span<LodPoint> remaining = points.subspan(nOwnPoints);
+    auto octant = [&center](const glm::vec3& p) {
+        return (p.x >= center.x ? 1 : 0) | (p.y >= center.y ? 2 : 0) |
+            (p.z >= center.z ? 4 : 0);
+    };
+    std::array<size_t, 9> octantStart = {};
+    for (const LodPoint& point : remaining) {
+        octantStart[octant(point.position) + 1]++;
+    }
+    for (size_t i = 1; i < octantStart.size(); i++) {
+        octantStart[i] += octantStart[i - 1];
+    }
+    std::array<size_t, 8> octantEnd;
+    std::copy(octantStart.begin(), octantStart.end() - 1, octantEnd.begin());
+    for (const LodPoint& point : remaining) {
+        scratch[octantEnd[octant(point.position)]++] = point;
+    }
+    std::copy(scratch.begin(), scratch.begin() + remaining.size(), remaining.begin());
+
+    for (int i = 0; i < 8; i++) {
+        const size_t nPoints = octantStart[i + 1] - octantStart[i];
+        if (nPoints == 0) {
+            continue;
+        }
+
+        const glm::vec3 childCenter = center + halfSize / 2.f * glm::vec3(
+            (i & 1) ? 1.f : -1.f,
+            (i & 2) ? 1.f : -1.f,
+            (i & 4) ? 1.f : -1.f
+        );
+        const int child = buildLodCell(
+            octree,
+            remaining.subspan(octantStart[i], nPoints),
+            scratch,
+            childCenter,
+            halfSize / 2.f,
+            depth + 1
+        );
+        octree.cells[cellIndex].children[i] = child;
+    }
+    return cellIndex;
+}
+
+void RenderablePointCloud::collectLodRanges(const LodOctree& octree, GLint offset,
+                                            const glm::dmat4& modelViewProjection,
+                                            const glm::dvec3& cameraPosition,
+                                            double pixelsPerUnit,
+                                            std::vector<GLint>& firsts,
+                                            std::vector<GLsizei>& counts) const
+{
+    if (octree.cells.empty()) {
+        return;
+    }
+
+    const double threshold = _levelOfDetail.refinementThreshold;
+    std::vector<int> cellsToVisit = { 0 };
+    while (!cellsToVisit.empty()) {
+        const LodCell& cell = octree.cells[cellsToVisit.back()];
+        cellsToVisit.pop_back();
+
+        if (isOutsideFrustum(modelViewProjection, cell.center, cell.halfSize)) {
+            continue;
+        }
+
+        // Refine the cell if its bounding sphere covers enough pixels on the screen, or
+        // if the camera is inside of it
+        const double radius = glm::sqrt(3.0) * cell.halfSize;
+        const double distance =
+            glm::distance(glm::dvec3(cell.center), cameraPosition) - radius;
+        const bool refine =
+            distance <= 0.0 || 2.0 * radius / distance * pixelsPerUnit > threshold;
+
+        if (refine) {
+            // The children are visited in order, so that the points of a fully refined
+            // subtree end up in consecutive ranges
+            for (int i = 7; i >= 0; i--) {
+                if (cell.children[i] != -1) {
+                    cellsToVisit.push_back(cell.children[i]);
+                }
+            }
+        }
+        if (cell.count == 0) {
+            continue;
+        }
+
+        const GLint first = offset + cell.first;
+        if (!firsts.empty() && firsts.back() + counts.back() == first) {
+            // Ranges that are next to each other in the buffer are merged
+            counts.back() += cell.count;
+        }
+        else {
+            firsts.push_back(first);
+            counts.push_back(cell.count);
+        }
+    }
+}
 
 gl::GLenum RenderablePointCloud::internalGlFormat(bool useAlpha) const {
     if (useAlpha) {
@@ -42,8 +42,17 @@
 #include <openspace/util/distanceconversion.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 
 namespace ghoul::opengl {
     class ProgramObject;
@@ -76,6 +85,7 @@ public:
 
     void initialize() override;
     void initializeGL() override;
+    void deinitialize() override;
     void deinitializeGL() override;
 
     bool isReady() const override;
@@ -97,8 +107,8 @@ protected:
     virtual void setExtraUniforms();
     virtual void preUpdate();
 
-    glm::dvec3 transformedPosition(const dataloader::Dataset::Entry& e) const;
-    glm::quat orientationQuaternion(const dataloader::Dataset::Entry& e) const;
+    glm::dvec3 transformedPosition(const dataloader::Dataset::EntryView& e) const;
+    glm::quat orientationQuaternion(const dataloader::Dataset::EntryView& e) const;
 
     virtual int nAttributesPerPoint() const;
 
@@ -131,8 +141,92 @@ protected:
     virtual void addOrientationDataForPoint(unsigned int index,
         std::vector<float>& result) const;
 
+    struct TextureId {
+        unsigned int arrayId;
+        unsigned int layer;
+    };
+
+    /// Returns the texture array and the layer in that array that is used by the point
+    /// with the provided \p index
+    TextureId textureLocation(unsigned int index);
+
+    /**
+     * Returns the indices of the points that are rendered with each of the texture
+     * arrays, in the order in which they are stored in the vertex buffer. There is
+     * always at least one list of points, even if no texture arrays are used.
+     */
+    std::vector<std::vector<unsigned int>> pointsPerTextureArray();
+
     std::vector<float> createDataSlice();
 
+    /// A point that is sorted into an octree for the level of detail
+    struct LodPoint {
+        glm::vec3 position;
+        unsigned int index;
+    };
+
+    /// A cell of an octree for the level of detail. The points of a cell are stored
+    /// contiguously in the vertex buffer, followed by the points of its descendants
+    struct LodCell {
+        glm::vec3 center;
+        float halfSize = 0.f;
+        GLint first = 0;
+        GLsizei count = 0;
+        std::array<int, 8> children;
+    };
+
+    struct LodOctree {
+        std::vector<LodCell> cells;
+        /// The indices of the points in the dataset in the order of the octree cells
+        std::vector<unsigned int> pointOrder;
+    };
+
+    /**
+     * Builds the octree for the level of detail from the points with the provided
+     * indices in the dataset. Each cell stores a random subset of at most
+     * `PointsPerCell` of its points and distributes the rest to its children.
+     */
+    LodOctree buildLodOctree(const std::vector<unsigned int>& points) const;
+
+    /// Recursive helper of #buildLodOctree that adds the cell containing the \p points
+    /// and all of its descendants to the \p octree and returns the index of the cell
+    int buildLodCell(LodOctree& octree, std::span<LodPoint> points,
+        std::span<LodPoint> scratch, glm::vec3 center, float halfSize, int depth) const;
+
+    /**
+     * Adds the ranges of points in the vertex buffer that should be drawn for the
+     * \p octree to \p firsts and \p counts. Cells outside of the view frustum are
+     * skipped and the children of a cell are only drawn if the cell covers more than
+     * the refinement threshold on the screen. The \p offset is the position of the first
+     * point of the octree in the vertex buffer.
+     */
+    void collectLodRanges(const LodOctree& octree, GLint offset,
+        const glm::dmat4& modelViewProjection, const glm::dvec3& cameraPosition,
+        double pixelsPerUnit, std::vector<GLint>& firsts,
+        std::vector<GLsizei>& counts) const;
+
+    /**
+     * Returns whether the current settings allow the dataset to be streamed to the GPU
+     * in chunks while it is being loaded. This is only possible when the rendering does
+     * not depend on the dataset as a whole, i.e. no color mapping, size mapping,
+     * multiple textures, or labels created from the dataset.
+     */
+    bool canStreamData() const;
+
+    /// Loads the dataset from the data file and updates the number of points
+    void loadDataset();
+
+    /**
+     * Reads the dataset in chunks and transforms the positions of each chunk using the
+     * \p unitMeter and \p transformationMatrix, which are copied before the loading
+     * starts. This is run in a background thread when streaming is enabled and stops
+     * between two chunks if the streaming is cancelled.
+     */
+    void loadStreamedData(double unitMeter, const glm::dmat4& transformationMatrix);
+
+    /// Uploads the next available chunk of streamed data to the GPU, if there is one
+    void updateStreamedData();
+
     /**
      * A function that subclasses could override to initialize their own textures to
      * use for rendering, when the `_textureMode` is set to Other
@@ -147,9 +241,22 @@ protected:
     void initAndAllocateTextureArray(unsigned int textureId,
         glm::uvec2 resolution, size_t nLayers, bool useAlpha);
 
-    void fillAndUploadTextureLayer(unsigned int arrayindex, unsigned int layer,
+    /**
+     * Upload the \p pixelData of a texture with the given \p resolution to a layer of
+     * the texture array with index \p arrayIndex. Textures that are smaller than the
+     * array are placed in the corner of the layer, and the part of the layer that they
+     * cover is stored so that it can be used for the texture lookup when rendering.
+     */
+    void fillAndUploadTextureLayer(unsigned int arrayIndex, unsigned int layer,
         size_t textureIndex, glm::uvec2 resolution, bool useAlpha, const void* pixelData);
 
+    /**
+     * Upload the texture coordinate and aspect ratio scale of each layer in the texture
+     * array with index \p arrayIndex, so that they can be looked up in the shader.
+     * Should be called after all layers have been filled.
+     */
+    void uploadTextureLayerInfo(unsigned int arrayIndex);
+
     void generateArrayTextures();
 
     float computeDistanceFadeValue(const RenderData& data) const;
@@ -203,7 +310,21 @@ protected:
     };
     Fading _fading;
 
+    struct LevelOfDetail : properties::PropertyOwner {
+        explicit LevelOfDetail(const ghoul::Dictionary& dictionary);
+        properties::BoolProperty enabled;
+        properties::UIntProperty pointsPerCell;
+        properties::FloatProperty refinementThreshold;
+    };
+    LevelOfDetail _levelOfDetail;
+
+    /// One octree per texture array, as these are drawn separately. The octrees are
+    /// kept until the positions or the texture arrays of the points change
+    std::vector<LodOctree> _lodOctrees;
+    bool _lodOctreesAreDirty = true;
+
     properties::BoolProperty _useAdditiveBlending;
+    properties::BoolProperty _useOrderIndependentTransparency;
     properties::BoolProperty _useRotation;
 
     properties::BoolProperty _drawElements;
@@ -233,7 +354,8 @@ protected:
         cmapRangeMin, cmapRangeMax, nanColor, useNanColor, hideOutsideRange,
         enableMaxSizeControl, aboveRangeColor, useAboveRangeColor, belowRangeColor,
         useBelowRangeColor, hasDvarScaling, dvarScaleFactor, enableOutline, outlineColor,
-        outlineWeight, outlineStyle, useCmapOutline, aspectRatioScale, useOrientationData
+        outlineWeight, outlineStyle, useCmapOutline, spriteLayerInfo, useOrientationData,
+        useOrderIndependentTransparency
     ) _uniformCache;
 
     std::filesystem::path _dataFile;
@@ -244,16 +366,53 @@ protected:
     bool _shouldComputeScaleExponent = false;
     bool _createLabelsFromDataset = false;
     bool _skipFirstDataPoint = false;
+    bool _streamData = false;
 
-    dataloader::Dataset _dataset;
+    // The dataset might be shared with other renderables that load the same file
+    std::shared_ptr<const dataloader::Dataset> _dataset =
+        std::make_shared<const dataloader::Dataset>();
     dataloader::DataMapping _dataMapping;
 
+    struct StreamingState {
+        struct Chunk {
+            // Transformed positions, three values per point
+            std::vector<float> positions;
+            double maxRadius = 0.0;
+            // The largest absolute position component before the transformation
+            double maxPositionComponent = 0.0;
+        };
+
+        std::future<void> task;
+        std::atomic_bool shouldStop = false;
+
+        // These are written by the loading thread and protected by the mutex
+        std::mutex mutex;
+        // Signalled when a chunk was uploaded or the loading is cancelled
+        std::condition_variable hasSpace;
+        std::optional<unsigned int> nTotalPoints;
+        bool hasOrientationData = false;
+        std::deque<Chunk> chunks;
+        bool hasFailed = false;
+        bool isFinished = false;
+
+        // These are only accessed from the main thread
+        bool isActive = false;
+        bool isAllocated = false;
+        int nAttributesPerPoint = 0;
+        double maxRadius = 0.0;
+        double maxPositionComponent = 0.0;
+        // Set once the streaming has finished, as the dataset is not kept in memory
+        bool needsDataset = false;
+    };
+    StreamingState _streaming;
+
     std::unique_ptr<LabelsComponent> _labels;
 
     glm::dmat4 _transformationMatrix = glm::dmat4(1.0);
 
     GLuint _vao = 0;
     GLuint _vbo = 0;
+    MemoryTracker::Allocation _vboMemory;
 
     // List of (unique) loaded textures. The other maps refer to the index in this vector
     std::vector<std::unique_ptr<ghoul::opengl::Texture>> _textures;
@@ -262,24 +421,24 @@ protected:
     // Texture index in dataset to index in vector of textures
     std::unordered_map<int, size_t> _indexInDataToTextureIndex;
 
-    // Resolution/format to index in textures vector (used to generate one texture
-    // array per unique format)
+    // Resolution/format to index in textures vector
     std::unordered_map<TextureFormat, std::vector<size_t>, TextureFormatHash>
         _textureMapByFormat;
 
-    // One per resolution above
+    // All textures are combined into a single texture array, so that all points can be
+    // drawn with one draw call regardless of their texture
     struct TextureArrayInfo {
         GLuint renderId;
+        GLuint layerInfoId = 0;
+        glm::uvec2 resolution = glm::uvec2(0);
+        bool useAlpha = false;
         GLint startOffset = -1;
         int nPoints = -1;
-        glm::vec2 aspectRatioScale = glm::vec2(1.f);
+        // Texture coordinate scale (xy) and aspect ratio scale (zw) for each layer
+        std::vector<glm::vec4> layerInfo;
     };
     std::vector<TextureArrayInfo> _textureArrays;
 
-    struct TextureId {
-        unsigned int arrayId;
-        unsigned int layer;
-    };
     std::unordered_map<size_t, TextureId> _textureIndexToArrayMap;
 };
 
@@ -25,6 +25,8 @@
 #include <modules/base/rendering/pointcloud/renderablepolygoncloud.h>
 
 #include <openspace/documentation/documentation.h>
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
@@ -146,6 +148,10 @@ void RenderablePolygonCloud::initializeCustomTexture() {
     fillAndUploadTextureLayer(0, 0, 0, glm::uvec2(TexSize), useAlpha, pixelData.data());
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
+    // The polygon is rendered through the same sprite texture path as the other point
+    // clouds, so it needs the layer information as well
+    uploadTextureLayerInfo(0);
+
     _textureIsInitialized = true;
 }
 
@@ -203,7 +209,7 @@ void RenderablePolygonCloud::renderToTexture(GLuint textureToRenderTo,
 
 void RenderablePolygonCloud::renderPolygonGeometry(GLuint vao) {
     std::unique_ptr<ghoul::opengl::ProgramObject> program =
-        ghoul::opengl::ProgramObject::Build(
+        global::renderEngine->buildCachedProgram(
             "RenderablePointCloud_Polygon",
             absPath("${MODULE_BASE}/shaders/polygon_vs.glsl"),
             absPath("${MODULE_BASE}/shaders/polygon_fs.glsl"),
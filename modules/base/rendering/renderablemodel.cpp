@@ -47,6 +47,10 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <optional>
 
 namespace {
@@ -160,6 +164,15 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo LevelOfDetailInfo = {
+        "LevelOfDetail",
+        "Level of Detail",
+        "The index of the level of detail that is currently rendered. 0 is the full "
+        "resolution model provided in the GeometryFile, higher values are the levels "
+        "provided in the LevelsOfDetail list in order.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     constexpr openspace::properties::Property::PropertyInfo BlendingOptionInfo = {
         "BlendingOption",
         "Blending Options",
@@ -249,6 +262,20 @@ namespace {
         // [[codegen::verbatim(BlendingOptionInfo.description)]]
         std::optional<std::string> blendingOption;
 
+        struct LevelOfDetail {
+            // The simplified model file that is rendered for this level of detail
+            std::filesystem::path geometryFile;
+
+            // The size of the model on screen in pixels below which this level of
+            // detail is used instead of any level with a larger screen size
+            float maxScreenSize [[codegen::greater(0.0)]];
+        };
+        // A list of simplified versions of the model that are rendered instead of the
+        // full geometry when the model only covers few pixels on the screen. The most
+        // simplified level that is still detailed enough for the current screen size is
+        // chosen. Levels of detail are not supported for models with animations.
+        std::optional<std::vector<LevelOfDetail>> levelsOfDetail;
+
         // The path to a vertex shader program to use instead of the default shader.
         std::optional<std::filesystem::path> vertexShader;
 
@@ -256,10 +283,88 @@ namespace {
         std::optional<std::filesystem::path> fragmentShader;
     };
 #include "renderablemodel_codegen.cpp"
+
+    // Returns a key that identifies the contents of the model file, so that identical
+    // files in different locations, such as separately synchronized copies of the same
+    // spacecraft model, share their geometry
+    std::string contentKey(const std::filesystem::path& file, bool forceRenderInvisible) {
+        std::ifstream stream(file, std::ifstream::binary);
+        const std::string content = std::string(
+            std::istreambuf_iterator<char>(stream),
+            std::istreambuf_iterator<char>()
+        );
+        return std::format(
+            "{}|{}|{}",
+            std::hash<std::string>()(content), content.size(), forceRenderInvisible
+        );
+    }
 } // namespace
 
 namespace openspace {
 
+struct RenderableModel::SharedGeometry {
+    ~SharedGeometry() {
+        // The last user releases the geometry in deinitializeGL, so the OpenGL context is
+        // current whenever the geometry was uploaded
+        if (isUploaded) {
+            geometry->deinitialize();
+        }
+    }
+
+    std::unique_ptr<ghoul::modelgeometry::ModelGeometry> geometry;
+    size_t fileSize = 0;
+    bool isUploaded = false;
+};
+
+std::shared_ptr<RenderableModel::SharedGeometry> RenderableModel::loadGeometry(
+                                                        const std::filesystem::path& file,
+                                                                bool forceRenderInvisible,
+                                                              bool notifyInvisibleDropped)
+{
+    ZoneScoped;
+
+    // Non-animated geometries are shared between all RenderableModels that load the same
+    // file contents. Animated geometries store their animation state and can't be shared.
+    // Each key has its own mutex, so different files are loaded concurrently by the
+    // scene initialization threads while a second user of the same file waits for the
+    // first one to finish loading
+    struct Slot {
+        std::mutex mutex;
+        std::weak_ptr<SharedGeometry> geometry;
+    };
+    static std::mutex SlotsMutex;
+    static std::map<std::string, std::shared_ptr<Slot>> Slots;
+
+    std::shared_ptr<Slot> slot;
+    {
+        const std::string key = contentKey(file, forceRenderInvisible);
+        const std::lock_guard lock(SlotsMutex);
+        std::shared_ptr<Slot>& s = Slots[key];
+        if (!s) {
+            s = std::make_shared<Slot>();
+        }
+        slot = s;
+    }
+
+    const std::lock_guard lock(slot->mutex);
+    if (std::shared_ptr<SharedGeometry> geometry = slot->geometry.lock();  geometry) {
+        return geometry;
+    }
+
+    auto res = std::make_shared<SharedGeometry>();
+    res->geometry = ghoul::io::ModelReader::ref().loadModel(
+        file,
+        ghoul::io::ModelReader::ForceRenderInvisible(forceRenderInvisible),
+        ghoul::io::ModelReader::NotifyInvisibleDropped(notifyInvisibleDropped)
+    );
+    res->geometry->calculateBoundingRadius();
+    res->fileSize = std::filesystem::file_size(file);
+    if (!res->geometry->hasAnimation()) {
+        slot->geometry = res;
+    }
+    return res;
+}
+
 documentation::Documentation RenderableModel::Documentation() {
     return codegen::doc<Parameters>("base_renderable_model");
 }
@@ -287,6 +392,7 @@ RenderableModel::RenderableModel(const ghoul::Dictionary& dictionary)
     , _modelScale(ModelScaleInfo, 1.0, std::numeric_limits<double>::epsilon(), 4e+27)
     , _rotationVec(RotationVecInfo, glm::dvec3(0.0), glm::dvec3(0.0), glm::dvec3(360.0))
     , _enableDepthTest(EnableDepthTestInfo, true)
+    , _levelOfDetail(LevelOfDetailInfo, 0, 0, 0)
     , _blendingFuncOption(
         BlendingOptionInfo,
         properties::OptionProperty::DisplayType::Dropdown
@@ -417,6 +523,24 @@ RenderableModel::RenderableModel(const ghoul::Dictionary& dictionary)
     _enableDepthTest = p.enableDepthTest.value_or(_enableDepthTest);
     _enableFaceCulling = p.enableFaceCulling.value_or(_enableFaceCulling);
 
+    if (p.levelsOfDetail.has_value()) {
+        for (const Parameters::LevelOfDetail& lod : *p.levelsOfDetail) {
+            std::filesystem::path file = absPath(lod.geometryFile);
+            if (!std::filesystem::exists(file)) {
+                throw ghoul::RuntimeError(std::format(
+                    "Cannot find level of detail model file '{}'", file
+                ));
+            }
+            _levelsOfDetail.push_back({
+                .file = std::move(file),
+                .maxScreenSize = lod.maxScreenSize
+            });
+        }
+        _levelOfDetail.setMaxValue(static_cast<int>(_levelsOfDetail.size()));
+    }
+    _levelOfDetail.setReadOnly(true);
+    addProperty(_levelOfDetail);
+
     if (p.vertexShader.has_value()) {
         _vertexShaderPath = p.vertexShader->string();
     }
@@ -521,19 +645,31 @@ void RenderableModel::initialize() {
     for (const std::unique_ptr<LightSource>& ls : _lightSources) {
         ls->initialize();
     }
+
+    // Load the model on the initialization thread. The geometry is uploaded to the GPU
+    // in a later frame when the upload scheduler has budget for it
+    _sharedGeometry = loadGeometry(_file, _forceRenderInvisible, _notifyInvisibleDropped);
+    _geometry = _sharedGeometry->geometry.get();
+    _modelHasAnimation = _geometry->hasAnimation();
+
+    if (_modelHasAnimation && !_levelsOfDetail.empty()) {
+        LWARNING(std::format(
+            "Levels of detail are not supported for the animated model '{}'", _file
+        ));
+        _levelsOfDetail.clear();
+    }
+    for (LevelOfDetail& lod : _levelsOfDetail) {
+        lod.geometry = loadGeometry(
+            lod.file,
+            _forceRenderInvisible,
+            _notifyInvisibleDropped
+        );
+    }
 }
 
 void RenderableModel::initializeGL() {
     ZoneScoped;
 
-    // Load model
-    _geometry = ghoul::io::ModelReader::ref().loadModel(
-        _file,
-        ghoul::io::ModelReader::ForceRenderInvisible(_forceRenderInvisible),
-        ghoul::io::ModelReader::NotifyInvisibleDropped(_notifyInvisibleDropped)
-    );
-    _modelHasAnimation = _geometry->hasAnimation();
-
     // @TODO (abock, 2023-06-03) Leaving this here to address issue #2731. The
     // _modelHasAnimation has not been set to true in the constructor causing the
     // `enableAnimation` function not to be called
@@ -693,9 +829,6 @@ void RenderableModel::initializeGL() {
     }
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    // Initialize geometry
-    _geometry->initialize();
-    _geometry->calculateBoundingRadius();
     setBoundingSphere(_geometry->boundingRadius() * _modelScale);
 
     // Set Interaction sphere size to be 10% of the bounding sphere
@@ -703,8 +836,12 @@ void RenderableModel::initializeGL() {
 }
 
 void RenderableModel::deinitializeGL() {
-    _geometry->deinitialize();
-    _geometry.reset();
+    _geometry = nullptr;
+    _sharedGeometry = nullptr;
+    for (LevelOfDetail& lod : _levelsOfDetail) {
+        lod.geometry = nullptr;
+    }
+    _isGeometryUploaded = false;
 
     glDeleteFramebuffers(1, &_framebuffer);
 
@@ -738,6 +875,10 @@ void RenderableModel::deinitializeGL() {
 }
 
 void RenderableModel::render(const RenderData& data, RendererTasks&) {
+    if (!_isGeometryUploaded) {
+        return;
+    }
+
     const double distanceToCamera = glm::distance(
         data.camera.positionVec3(),
         data.modelTransform.translation
@@ -759,6 +900,24 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
         return;
     }
 
+    // The ratio is the approximate size of the model on screen in pixels. Pick the most
+    // simplified level of detail whose screen size is still larger than that
+    const float screenSize = static_cast<float>(maxDistance / distanceToCamera);
+    ghoul::modelgeometry::ModelGeometry* geometry = _geometry;
+    int levelOfDetail = 0;
+    float bestScreenSize = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < _levelsOfDetail.size(); i++) {
+        const LevelOfDetail& lod = _levelsOfDetail[i];
+        if (screenSize < lod.maxScreenSize && lod.maxScreenSize < bestScreenSize) {
+            geometry = lod.geometry->geometry.get();
+            levelOfDetail = static_cast<int>(i) + 1;
+            bestScreenSize = lod.maxScreenSize;
+        }
+    }
+    if (levelOfDetail != _levelOfDetail) {
+        _levelOfDetail = levelOfDetail;
+    }
+
     _program->activate();
 
     // Model transform and view transform needs to be in double precision
@@ -863,7 +1022,7 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
             _program->setUniform(_uniformCache.opacity, 1.f);
         }
 
-        _geometry->render(*_program);
+        geometry->render(*_program);
     }
     else {
         // Prepare framebuffer
@@ -925,7 +1084,7 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
 
         // Render Pass 1
         // Render all parts of the model into the new framebuffer without opacity
-        _geometry->render(*_program);
+        geometry->render(*_program);
         _program->deactivate();
 
         // Render pass 2
@@ -1006,6 +1165,13 @@ void RenderableModel::update(const UpdateData& data) {
         ghoul::opengl::updateUniformLocations(*_quadProgram, _uniformOpacityCache);
     }
 
+    if (!_isGeometryUploaded) {
+        _isGeometryUploaded = uploadGeometries();
+        if (!_isGeometryUploaded) {
+            return;
+        }
+    }
+
     if (!hasOverrideRenderBin()) {
         // Only render two pass if the model is in any way transparent
         const float o = opacity();
@@ -1087,4 +1253,33 @@ void RenderableModel::update(const UpdateData& data) {
     }
 }
 
+bool RenderableModel::uploadGeometries() {
+    UploadScheduler& scheduler = global::renderEngine->uploadScheduler();
+    auto upload = [&scheduler](SharedGeometry& shared) {
+        if (shared.isUploaded) {
+            return true;
+        }
+        if (!scheduler.hasBudget()) {
+            return false;
+        }
+        // The file size is used as the estimate for the uploaded number of bytes
+        scheduler.uploadExternal(
+            [&shared]() { shared.geometry->initialize(); },
+            shared.fileSize
+        );
+        shared.isUploaded = true;
+        return true;
+    };
+
+    if (!upload(*_sharedGeometry)) {
+        return false;
+    }
+    for (const LevelOfDetail& lod : _levelsOfDetail) {
+        if (!upload(*lod.geometry)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace openspace
@@ -32,11 +32,13 @@
 #include <openspace/properties/matrix/mat3property.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <ghoul/misc/managedmemoryuniqueptr.h>
 #include <ghoul/io/model/modelreader.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <memory>
+#include <vector>
 
 namespace ghoul::opengl {
     class ProgramObject;
@@ -70,6 +72,19 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /// A model geometry that is shared between all models that load the same file
+    struct SharedGeometry;
+
+    static std::shared_ptr<SharedGeometry> loadGeometry(const std::filesystem::path& file,
+        bool forceRenderInvisible, bool notifyInvisibleDropped);
+
+    /**
+     * Uploads the geometry and all levels of detail that have not been uploaded yet as
+     * long as the upload scheduler has budget left in this frame. Returns `true` if all
+     * geometries have been uploaded.
+     */
+    bool uploadGeometries();
+
     enum class AnimationMode {
         Once = 0,
         LoopFromStart,
@@ -78,8 +93,18 @@ private:
         BounceInfinitely
     };
 
+    struct LevelOfDetail {
+        std::filesystem::path file;
+        float maxScreenSize = 0.f;
+        std::shared_ptr<SharedGeometry> geometry;
+    };
+
     std::filesystem::path _file;
-    std::unique_ptr<ghoul::modelgeometry::ModelGeometry> _geometry;
+    std::shared_ptr<SharedGeometry> _sharedGeometry;
+    /// Shortcut to the geometry in the _sharedGeometry
+    ghoul::modelgeometry::ModelGeometry* _geometry = nullptr;
+    std::vector<LevelOfDetail> _levelsOfDetail;
+    bool _isGeometryUploaded = false;
     bool _invertModelScale = false;
     bool _forceRenderInvisible = false;
     bool _notifyInvisibleDropped = true;
@@ -101,6 +126,7 @@ private:
     properties::Vec3Property _rotationVec;
 
     properties::BoolProperty _enableDepthTest;
+    properties::IntProperty _levelOfDetail;
     properties::OptionProperty _blendingFuncOption;
 
     std::string _vertexShaderPath;
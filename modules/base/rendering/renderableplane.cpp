@@ -240,6 +240,7 @@ void RenderablePlane::render(const RenderData& data, RendererTasks&) {
     _shader->setUniform(_uniformCache.opacity, opacity());
 
     _shader->setUniform(_uniformCache.mirrorBackside, _mirrorBackside);
+    _shader->setUniform(_uniformCache.flipTexture, isTextureFlipped());
 
     const glm::dvec3 objPosWorld = glm::dvec3(
         glm::translate(
@@ -303,6 +304,10 @@ void RenderablePlane::bindTexture() {}
 
 void RenderablePlane::unbindTexture() {}
 
+bool RenderablePlane::isTextureFlipped() const {
+    return false;
+}
+
 void RenderablePlane::update(const UpdateData&) {
     ZoneScoped;
 
@@ -66,6 +66,8 @@ public:
 protected:
     virtual void bindTexture();
     virtual void unbindTexture();
+    /// Returns `true` if the bound texture is stored top-down and has to be flipped
+    virtual bool isTextureFlipped() const;
     void createPlane();
 
     properties::OptionProperty _blendMode;
@@ -84,7 +86,7 @@ private:
     bool _planeIsDirty = false;
 
     UniformCache(modelViewProjection, modelViewTransform, colorTexture, opacity,
-        mirrorBackside, multiplyColor) _uniformCache;
+        mirrorBackside, flipTexture, multiplyColor) _uniformCache;
 };
 
 } // namespace openspace
@@ -24,12 +24,11 @@
 
 #include <modules/base/rendering/renderableplaneimageonline.h>
 
+#include <modules/base/basemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
-#include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
 
@@ -119,95 +118,39 @@ void RenderablePlaneImageOnline::update(const UpdateData& data) {
         return;
     }
 
-    if (!_imageFuture.valid()) {
-        std::future<DownloadManager::MemoryFile> future = downloadImageToMemory(
-            _texturePath
-        );
-        if (future.valid()) {
-            _imageFuture = std::move(future);
-        }
+    OnlineImageCache::Image image = BaseModule::OnlineImages.image(_texturePath);
+    if (image.hasFailed) {
+        _textureIsDirty = false;
+        return;
+    }
+    if (!image.texture) {
+        return;
     }
 
-    if (_imageFuture.valid() && DownloadManager::futureReady(_imageFuture)) {
-        const DownloadManager::MemoryFile imageFile = _imageFuture.get();
-
-        if (imageFile.corrupted) {
-            LERRORC(
-                "ScreenSpaceImageOnline",
-                std::format("Error loading image from URL '{}'", _texturePath.value())
-            );
-            return;
-        }
+    _texture = std::move(image.texture);
+    _textureIsDirty = false;
 
-        try {
-            std::unique_ptr<ghoul::opengl::Texture> texture =
-                ghoul::io::TextureReader::ref().loadTexture(
-                    reinterpret_cast<void*>(imageFile.buffer),
-                    imageFile.size,
-                    2,
-                    imageFile.format
-                );
-
-            if (texture) {
-                // Images don't need to start on 4-byte boundaries, for example if the
-                // image is only RGB
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-                texture->uploadTexture();
-                texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-                texture->purgeFromRAM();
-
-                _texture = std::move(texture);
-                _textureIsDirty = false;
-
-                if (!_autoScale) {
-                    return;
-                }
-
-                // Shape the plane based on the aspect ration of the image
-                const glm::vec2 textureDim = glm::vec2(_texture->dimensions());
-                if (_textureDimensions != textureDim) {
-                    const float aspectRatio = textureDim.x / textureDim.y;
-                    const float planeAspectRatio = _size.value().x / _size.value().y;
-
-                    if (std::abs(planeAspectRatio - aspectRatio) >
-                        std::numeric_limits<float>::epsilon())
-                    {
-                        _size =
-                            aspectRatio > 0.f ?
-                            glm::vec2(_size.value().x * aspectRatio, _size.value().y) :
-                            glm::vec2(_size.value().x, _size.value().y * aspectRatio);
-                    }
-
-                    _textureDimensions = textureDim;
-                }
-            }
-        }
-        catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
-            _textureIsDirty = false;
-            LERRORC(e.component, e.message);
-        }
+    if (!_autoScale) {
+        return;
     }
-}
 
-std::future<DownloadManager::MemoryFile>
-RenderablePlaneImageOnline::downloadImageToMemory(const std::string& url)
-{
-    return global::downloadManager->fetchFile(
-        url,
-        [url](const DownloadManager::MemoryFile&) {
-            LDEBUGC(
-                "ScreenSpaceImageOnline",
-                "Download to memory finished for screen space image"
-            );
-        },
-        [url](const std::string& err) {
-            LDEBUGC(
-                "ScreenSpaceImageOnline",
-                "Download to memory failer for screen space image: " + err
-            );
+    // Shape the plane based on the aspect ration of the image
+    const glm::vec2 textureDim = glm::vec2(_texture->dimensions());
+    if (_textureDimensions != textureDim) {
+        const float aspectRatio = textureDim.x / textureDim.y;
+        const float planeAspectRatio = _size.value().x / _size.value().y;
+
+        if (std::abs(planeAspectRatio - aspectRatio) >
+            std::numeric_limits<float>::epsilon())
+        {
+            _size =
+                aspectRatio > 0.f ?
+                glm::vec2(_size.value().x * aspectRatio, _size.value().y) :
+                glm::vec2(_size.value().x, _size.value().y * aspectRatio);
         }
-    );
+
+        _textureDimensions = textureDim;
+    }
 }
 
 } // namespace openspace
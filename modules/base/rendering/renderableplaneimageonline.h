@@ -27,7 +27,8 @@
 
 #include <modules/base/rendering/renderableplane.h>
 
-#include <openspace/engine/downloadmanager.h>
+#include <openspace/properties/stringproperty.h>
+#include <memory>
 
 namespace ghoul::filesystem { class File; }
 namespace ghoul::opengl { class Texture; }
@@ -53,13 +54,10 @@ protected:
     virtual void bindTexture() override;
 
 private:
-    std::future<DownloadManager::MemoryFile> downloadImageToMemory(
-        const std::string& url);
-
     properties::StringProperty _texturePath;
 
-    std::future<DownloadManager::MemoryFile> _imageFuture;
-    std::unique_ptr<ghoul::opengl::Texture> _texture;
+    /// The texture is shared with all other renderables that show the same image
+    std::shared_ptr<ghoul::opengl::Texture> _texture;
     glm::vec2 _textureDimensions = glm::vec2(0.f);
     bool _textureIsDirty = false;
 };
@@ -24,7 +24,6 @@
 
 #include <modules/base/rendering/renderableplanetimevaryingimage.h>
 
-#include <modules/base/basemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
@@ -33,7 +32,6 @@
 #include <openspace/scene/scene.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
 #include <optional>
 
@@ -53,8 +51,9 @@ namespace {
         // [[codegen::verbatim(SourceFolderInfo.description)]]
         std::string sourceFolder;
 
-        // If set to `true` the images are only loaded when it is about to be shown
-        // instead of preloading them
+        // If set to `true` the loaded images are released while the plane is disabled
+        // instead of being kept in memory. Independent of this setting, images are
+        // only loaded shortly before they are shown
         std::optional<bool> lazyLoading;
     };
 #include "renderableplanetimevaryingimage_codegen.cpp"
@@ -94,7 +93,7 @@ RenderablePlaneTimeVaryingImage::RenderablePlaneTimeVaryingImage(
                 _textureIsDirty = true;
             }
             else {
-                BaseModule::TextureManager.release(_texture);
+                _prefetcher.clear();
                 _texture = nullptr;
             }
         });
@@ -109,25 +108,14 @@ void RenderablePlaneTimeVaryingImage::initialize() {
     }
     extractTriggerTimesFromFileNames();
     computeSequenceEndTime();
-}
-
-void RenderablePlaneTimeVaryingImage::initializeGL() {
-    RenderablePlane::initializeGL();
 
-    _textureFiles.resize(_sourceFiles.size());
-    for (size_t i = 0; i < _sourceFiles.size(); i++) {
-        _textureFiles[i] = ghoul::io::TextureReader::ref().loadTexture(
-            absPath(_sourceFiles[i]),
-            2
-        );
-        _textureFiles[i]->setInternalFormat(GL_COMPRESSED_RGBA);
-        _textureFiles[i]->uploadTexture();
-        _textureFiles[i]->setFilter(ghoul::opengl::Texture::FilterMode::Linear);
-        _textureFiles[i]->purgeFromRAM();
-    }
-    if (!_isLoadingLazily) {
-        _texture = loadTexture();
+    // The images are only loaded once they are about to be shown
+    std::vector<std::filesystem::path> paths;
+    paths.reserve(_sourceFiles.size());
+    for (const std::filesystem::path& file : _sourceFiles) {
+        paths.push_back(absPath(file));
     }
+    _prefetcher.setImages(std::move(paths), _startTimes);
 }
 
 bool RenderablePlaneTimeVaryingImage::extractMandatoryInfoFromDictionary() {
@@ -157,9 +145,8 @@ bool RenderablePlaneTimeVaryingImage::extractMandatoryInfoFromDictionary() {
 }
 
 void RenderablePlaneTimeVaryingImage::deinitializeGL() {
-    BaseModule::TextureManager.release(_texture);
-
-    _textureFiles.clear();
+    _texture = nullptr;
+    _prefetcher.clear();
     RenderablePlane::deinitializeGL();
 }
 
@@ -176,7 +163,6 @@ void RenderablePlaneTimeVaryingImage::update(const UpdateData& data) {
     if (!_enabled || _startTimes.empty()) {
         return;
     }
-    bool needsUpdate = false;
     const double currentTime = data.time.j2000Seconds();
     const bool isInInterval = (currentTime >= _startTimes[0]) &&
                               (currentTime < _sequenceEndTime);
@@ -191,19 +177,19 @@ void RenderablePlaneTimeVaryingImage::update(const UpdateData& data) {
             (nextIdx < _sourceFiles.size() && currentTime >= _startTimes[nextIdx]))
         {
             _activeTriggerTimeIndex = updateActiveTriggerTimeIndex(currentTime);
-            needsUpdate = true;
         } // else we're still in same state as previous frame (no changes needed)
     }
     else {
         // not in interval => set everything to false
         _activeTriggerTimeIndex = -1;
-        needsUpdate = false;
     }
 
-    if (needsUpdate || _textureIsDirty) {
-        _texture = loadTexture();
-        _textureIsDirty = false;
-    }
+    // The texture is updated every frame, as the prefetcher might only have had a
+    // neighboring image available in a previous frame
+    const double timeStep = currentTime - data.previousFrameTime.j2000Seconds();
+    _prefetcher.update(currentTime, timeStep);
+    _texture = loadTexture();
+    _textureIsDirty = false;
 }
 
 void RenderablePlaneTimeVaryingImage::render(const RenderData& data, RendererTasks& t) {
@@ -266,7 +252,7 @@ void RenderablePlaneTimeVaryingImage::computeSequenceEndTime() {
 ghoul::opengl::Texture* RenderablePlaneTimeVaryingImage::loadTexture() const {
     ghoul::opengl::Texture* texture = nullptr;
     if (_activeTriggerTimeIndex != -1) {
-        texture = _textureFiles[_activeTriggerTimeIndex].get();
+        texture = _prefetcher.texture(_activeTriggerTimeIndex);
     }
     return texture;
 }
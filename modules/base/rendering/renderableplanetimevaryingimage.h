@@ -27,6 +27,7 @@
 
 #include <modules/base/rendering/renderableplane.h>
 
+#include <modules/base/rendering/imagesequenceprefetcher.h>
 #include <filesystem>
 
 namespace ghoul::filesystem { class File; }
@@ -44,7 +45,6 @@ public:
     RenderablePlaneTimeVaryingImage(const ghoul::Dictionary& dictionary);
 
     void initialize() override;
-    void initializeGL() override;
     void deinitializeGL() override;
 
     void update(const UpdateData& data) override;
@@ -68,8 +68,8 @@ private:
     std::vector<double> _startTimes;
     int _activeTriggerTimeIndex = 0;
     properties::StringProperty _sourceFolder;
+    ImageSequencePrefetcher _prefetcher;
     ghoul::opengl::Texture* _texture = nullptr;
-    std::vector<std::unique_ptr<ghoul::opengl::Texture>> _textureFiles;
     bool _isLoadingLazily = false;
     bool _textureIsDirty = false;
 };
@@ -29,6 +29,7 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/rendering/renderengine.h>
+#include <openspace/rendering/sharedgeometry.h>
 #include <openspace/util/sphere.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -100,6 +101,19 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    // All spheres with the same number of segments share the same geometry, which has a
+    // radius of 1 and is scaled to the actual size in the model matrix
+    std::shared_ptr<openspace::Sphere> requestSphere(int segments) {
+        return openspace::requestSharedGeometry<openspace::Sphere>(
+            std::format("Sphere|{}", segments),
+            [segments]() {
+                auto sphere = std::make_unique<openspace::Sphere>(1.f, segments);
+                sphere->initialize();
+                return sphere;
+            }
+        );
+    }
+
     struct [[codegen::Dictionary(RenderableSphere)]] Parameters {
         // [[codegen::verbatim(SizeInfo.description)]]
         std::optional<float> size [[codegen::greater(0.f)]];
@@ -154,8 +168,8 @@ RenderableSphere::RenderableSphere(const ghoul::Dictionary& dictionary)
     _size = p.size.value_or(_size);
     _size.setExponent(15.f);
     _size.onChange([this]() {
+        // The sphere geometry has a radius of 1 and is scaled in the model matrix
         setBoundingSphere(_size);
-        _sphereIsDirty = true;
     });
     addProperty(_size);
 
@@ -195,8 +209,7 @@ bool RenderableSphere::isReady() const {
 }
 
 void RenderableSphere::initializeGL() {
-    _sphere = std::make_unique<Sphere>(_size, _segments);
-    _sphere->initialize();
+    _sphere = requestSphere(_segments);
 
     _shader = BaseModule::ProgramObjectManager.request(
         "Sphere",
@@ -233,8 +246,12 @@ void RenderableSphere::render(const RenderData& data, RendererTasks&) {
     _shader->activate();
     _shader->setIgnoreUniformLocationError(IgnoreError::Yes);
 
+    // The shared sphere geometry has a radius of 1
     auto [modelTransform, modelViewTransform, modelViewProjectionTransform] =
-        calcAllTransforms(data);
+        calcAllTransforms(
+            data,
+            { .scale = data.modelTransform.scale * static_cast<double>(_size) }
+        );
     const glm::dmat3 modelRotation = glm::dmat3(data.modelTransform.rotation);
 
     _shader->setUniform(_uniformCache.modelViewTransform, glm::mat4(modelViewTransform));
@@ -311,6 +328,7 @@ void RenderableSphere::render(const RenderData& data, RendererTasks&) {
 
     _shader->setUniform(_uniformCache.opacity, adjustedOpacity);
     _shader->setUniform(_uniformCache.mirrorTexture, _mirrorTexture.value());
+    _shader->setUniform(_uniformCache.flipTexture, isTextureFlipped());
 
     ghoul::opengl::TextureUnit unit;
     unit.activate();
@@ -358,8 +376,7 @@ void RenderableSphere::update(const UpdateData&) {
     }
 
     if (_sphereIsDirty) {
-        _sphere = std::make_unique<Sphere>(_size, _segments);
-        _sphere->initialize();
+        _sphere = requestSphere(_segments);
         _sphereIsDirty = false;
     }
 }
@@ -368,4 +385,8 @@ void RenderableSphere::unbindTexture() {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+bool RenderableSphere::isTextureFlipped() const {
+    return false;
+}
+
 } // namespace openspace
@@ -57,6 +57,8 @@ public:
 protected:
     virtual void bindTexture() = 0;
     virtual void unbindTexture();
+    /// Returns `true` if the bound texture is stored top-down and has to be flipped
+    virtual bool isTextureFlipped() const;
 
     properties::FloatProperty _size;
     properties::IntProperty _segments;
@@ -71,11 +73,12 @@ protected:
 private:
     ghoul::opengl::ProgramObject* _shader = nullptr;
 
-    std::unique_ptr<Sphere> _sphere;
+    /// The geometry is shared with all other spheres that have the same segments
+    std::shared_ptr<Sphere> _sphere;
     bool _sphereIsDirty = false;
 
     UniformCache(opacity, modelViewProjection, modelViewTransform, modelViewRotation,
-        colorTexture, mirrorTexture) _uniformCache;
+        colorTexture, mirrorTexture, flipTexture) _uniformCache;
 };
 
 } // namespace openspace
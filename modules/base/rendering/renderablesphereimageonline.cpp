@@ -24,12 +24,12 @@
 
 #include <modules/base/rendering/renderablesphereimageonline.h>
 
+#include <modules/base/basemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/util/sphere.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/opengl/texture.h>
 
 namespace {
@@ -41,28 +41,6 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
-    std::future<openspace::DownloadManager::MemoryFile> downloadImageToMemory(
-                                                                   const std::string& url)
-    {
-        using namespace openspace;
-
-        return global::downloadManager->fetchFile(
-            url,
-            [url](const DownloadManager::MemoryFile&) {
-                LDEBUGC(
-                    "RenderableSphereImageOnline",
-                    std::format("Download to memory finished for image '{}'", url)
-                );
-            },
-            [url](const std::string& err) {
-                LDEBUGC(
-                    "RenderableSphereImageOnline",
-                    std::format("Download to memory failed for image '{}': {}", url, err)
-                );
-            }
-        );
-    }
-
     // A RenderableSphereImageOnline can be used to show an image from an online source
     // (as a URL) on a sphere in the OpenSpace scene. The image should be provided in an
     // equirectangular projection, if it is a map that is draped over the sphere.
@@ -109,52 +87,14 @@ void RenderableSphereImageOnline::update(const UpdateData& data) {
         return;
     }
 
-    if (!_imageFuture.valid()) {
-        std::future<DownloadManager::MemoryFile> future = downloadImageToMemory(
-            _textureUrl
-        );
-        if (future.valid()) {
-            _imageFuture = std::move(future);
-        }
+    OnlineImageCache::Image image = BaseModule::OnlineImages.image(_textureUrl);
+    if (image.hasFailed) {
+        _textureIsDirty = false;
+        return;
     }
-
-    if (_imageFuture.valid() && DownloadManager::futureReady(_imageFuture)) {
-        const DownloadManager::MemoryFile imageFile = _imageFuture.get();
-
-        if (imageFile.corrupted) {
-            LERRORC(
-                "RenderableSphereImageOnline",
-                std::format("Error loading image from URL '{}'", _textureUrl.value())
-            );
-            return;
-        }
-
-        try {
-            std::unique_ptr<ghoul::opengl::Texture> texture =
-                ghoul::io::TextureReader::ref().loadTexture(
-                    reinterpret_cast<void*>(imageFile.buffer),
-                    imageFile.size,
-                    2,
-                    imageFile.format
-                );
-
-            if (texture) {
-                // Images don't need to start on 4-byte boundaries, for example if the
-                // image is only RGB
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-                texture->uploadTexture();
-                texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-                texture->purgeFromRAM();
-
-                _texture = std::move(texture);
-                _textureIsDirty = false;
-            }
-        }
-        catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
-            _textureIsDirty = false;
-            LERRORC(e.component, e.message);
-        }
+    if (image.texture) {
+        _texture = std::move(image.texture);
+        _textureIsDirty = false;
     }
 }
 
@@ -27,7 +27,8 @@
 
 #include <modules/base/rendering/renderablesphere.h>
 
-#include <openspace/engine/downloadmanager.h>
+#include <openspace/properties/stringproperty.h>
+#include <memory>
 
 namespace ghoul::opengl { class Texture; }
 
@@ -57,8 +58,8 @@ protected:
 private:
     properties::StringProperty _textureUrl;
 
-    std::future<DownloadManager::MemoryFile> _imageFuture;
-    std::unique_ptr<ghoul::opengl::Texture> _texture;
+    /// The texture is shared with all other renderables that show the same image
+    std::shared_ptr<ghoul::opengl::Texture> _texture;
     bool _textureIsDirty = true;
 };
 
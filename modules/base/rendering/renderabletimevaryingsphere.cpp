@@ -29,7 +29,6 @@
 #include <openspace/util/sphere.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/misc/crc32.h>
 #include <ghoul/opengl/texture.h>
 
@@ -82,7 +81,9 @@ RenderableTimeVaryingSphere::RenderableTimeVaryingSphere(
 }
 
 bool RenderableTimeVaryingSphere::isReady() const {
-    return RenderableSphere::isReady() && _texture;
+    // The textures are loaded while the renderable is updated, so the renderable has to
+    // be ready before the first image has been loaded
+    return RenderableSphere::isReady();
 }
 
 void RenderableTimeVaryingSphere::initializeGL() {
@@ -90,11 +91,11 @@ void RenderableTimeVaryingSphere::initializeGL() {
 
     extractMandatoryInfoFromSourceFolder();
     computeSequenceEndTime();
-    loadTexture();
 }
 
 void RenderableTimeVaryingSphere::deinitializeGL() {
     _texture = nullptr;
+    _prefetcher.clear();
     _files.clear();
 
     RenderableSphere::deinitializeGL();
@@ -119,15 +120,7 @@ void RenderableTimeVaryingSphere::extractMandatoryInfoFromSourceFolder() {
         }
         std::filesystem::path filePath = e.path();
         const double time = extractTriggerTimeFromFileName(filePath);
-        std::unique_ptr<ghoul::opengl::Texture> t =
-            ghoul::io::TextureReader::ref().loadTexture(filePath, 2);
-
-        t->setInternalFormat(GL_COMPRESSED_RGBA);
-        t->uploadTexture();
-        t->setFilter(ghoul::opengl::Texture::FilterMode::Linear);
-        t->purgeFromRAM();
-
-        _files.push_back({ std::move(filePath), time, std::move(t) });
+        _files.push_back({ std::move(filePath), time });
     }
 
     std::sort(
@@ -143,6 +136,17 @@ void RenderableTimeVaryingSphere::extractMandatoryInfoFromSourceFolder() {
             "Source folder for RenderableTimeVaryingSphere contains no files"
         );
     }
+
+    // The images are only loaded once they are about to be shown
+    std::vector<std::filesystem::path> paths;
+    std::vector<double> times;
+    paths.reserve(_files.size());
+    times.reserve(_files.size());
+    for (const FileData& file : _files) {
+        paths.push_back(file.path);
+        times.push_back(file.time);
+    }
+    _prefetcher.setImages(std::move(paths), std::move(times));
 }
 
 void RenderableTimeVaryingSphere::update(const UpdateData& data) {
@@ -160,17 +164,18 @@ void RenderableTimeVaryingSphere::update(const UpdateData& data) {
             (nextIdx < _files.size() && currentTime >= _files[nextIdx].time))
         {
             updateActiveTriggerTimeIndex(currentTime);
-            _textureIsDirty = true;
         } // else {we're still in same state as previous frame (no changes needed)}
     }
     else {
         // not in interval => set everything to false
         _activeTriggerTimeIndex = 0;
     }
-    if (_textureIsDirty) {
-        loadTexture();
-        _textureIsDirty = false;
-    }
+
+    // The texture is updated every frame, as the prefetcher might only have had a
+    // neighboring image available in a previous frame
+    const double timeStep = currentTime - data.previousFrameTime.j2000Seconds();
+    _prefetcher.update(currentTime, timeStep);
+    loadTexture();
 }
 
 void RenderableTimeVaryingSphere::bindTexture() {
@@ -217,7 +222,7 @@ void RenderableTimeVaryingSphere::computeSequenceEndTime() {
 
 void RenderableTimeVaryingSphere::loadTexture() {
     if (_activeTriggerTimeIndex != -1) {
-        _texture = _files[_activeTriggerTimeIndex].texture.get();
+        _texture = _prefetcher.texture(_activeTriggerTimeIndex);
     }
 }
 
@@ -27,6 +27,7 @@
 
 #include <modules/base/rendering/renderablesphere.h>
 
+#include <modules/base/rendering/imagesequenceprefetcher.h>
 #include <filesystem>
 
 namespace ghoul::opengl { class Texture; }
@@ -58,7 +59,6 @@ private:
     struct FileData {
         std::filesystem::path path;
         double time;
-        std::unique_ptr<ghoul::opengl::Texture> texture;
     };
     void loadTexture();
     void extractMandatoryInfoFromSourceFolder();
@@ -71,8 +71,8 @@ private:
     int _activeTriggerTimeIndex = 0;
 
     properties::StringProperty _textureSourcePath;
+    ImageSequencePrefetcher _prefetcher;
     ghoul::opengl::Texture* _texture = nullptr;
-    bool _textureIsDirty = false;
 };
 
 } // namespace openspace
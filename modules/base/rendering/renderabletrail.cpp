@@ -28,6 +28,7 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <openspace/rendering/drawlist.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/translation.h>
 #include <openspace/util/updatestructures.h>
@@ -70,6 +71,12 @@ namespace {
         { "Points+Lines", RenderingModeLinesPoints }
     };
 
+    // Fragile! Keep in sync with fragment shader
+    enum RenderPhase {
+        RenderPhaseLines = 0,
+        RenderPhasePoints
+    };
+
     constexpr openspace::properties::Property::PropertyInfo LineColorInfo = {
         "Color",
         "Color",
@@ -212,7 +219,9 @@ RenderableTrail::Appearance::Appearance()
 }
 
 RenderableTrail::RenderableTrail(const ghoul::Dictionary& dictionary)
-    : Renderable(dictionary)
+    : Renderable(dictionary, {
+        .updatePolicy = UpdatePolicy::WhenVisible | UpdatePolicy::OnPropertyChange
+    })
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -294,83 +303,142 @@ bool RenderableTrail::isReady() const {
     return _programObject != nullptr;
 }
 
-void RenderableTrail::internalRender(bool renderLines, bool renderPoints,
-                                     const RenderData& data,
-                                     const glm::dmat4& modelTransform,
-                                     RenderInformation& info, int nVertices,
-                                     int ringOffset, bool useSplitRenderMode,
-                                     int numberOfUniqueVertices, int floatingOffset)
-{
-    ZoneScoped;
+void RenderableTrail::setUniforms(const FrameUniforms& uniforms) {
+    _programObject->setUniform(_uniformCache.opacity, uniforms.opacity);
+    _programObject->setUniform(
+        _uniformCache.projectionTransform,
+        uniforms.projectionTransform
+    );
+    _programObject->setUniform(_uniformCache.color, uniforms.color);
+    _programObject->setUniform(_uniformCache.useLineFade, uniforms.useLineFade);
+    if (uniforms.useLineFade) {
+        _programObject->setUniform(_uniformCache.lineLength, uniforms.lineLength);
+        _programObject->setUniform(_uniformCache.lineFadeAmount, uniforms.lineFadeAmount);
+    }
+    _programObject->setUniform(_uniformCache.pointSize, uniforms.pointSize);
+#if !defined(__APPLE__)
+    _programObject->setUniform(_uniformCache.viewport, uniforms.viewport);
+    _programObject->setUniform(_uniformCache.lineWidth, uniforms.lineWidth);
+#endif // !defined(__APPLE__)
+}
 
+void RenderableTrail::setUniforms(const PartUniforms& uniforms) {
     // We pass in the model view transformation matrix as double in order to maintain
     // high precision for vertices; especially for the trails, a high vertex precision
     // is necessary as they are usually far away from their reference
-    const glm::dmat4 modelViewTransform = calcModelViewTransform(data, modelTransform);
     _programObject->setUniform(
         _uniformCache.modelViewTransform,
-        modelViewTransform * info._localTransform
+        uniforms.modelViewTransform
     );
 
-    const int sorting = [](RenderInformation::VertexSorting s) {
-        switch (s) {
-            case RenderInformation::VertexSorting::NewestFirst: return 0;
-            case RenderInformation::VertexSorting::OldestFirst: return 1;
-            case RenderInformation::VertexSorting::NoSorting:   return 2;
-            default:                                  throw ghoul::MissingCaseException();
-        }
-    }(info.sorting);
-
     // The vertex sorting method is used to tweak the fading along the trajectory
-    _programObject->setUniform(_uniformCache.vertexSortingMethod, sorting);
+    _programObject->setUniform(
+        _uniformCache.vertexSortingMethod,
+        uniforms.vertexSortingMethod
+    );
 
     // This value is subtracted from the vertex id in the case of a potential ring
     // buffer (as used in RenderableTrailOrbit) to keep the first vertex at its
     // brightest
-    _programObject->setUniform(_uniformCache.idOffset, ringOffset);
-
-    _programObject->setUniform(_uniformCache.nVertices, nVertices);
-    _programObject->setUniform(_uniformCache.floatingOffset, floatingOffset);
-    _programObject->setUniform(_uniformCache.useSplitRenderMode, useSplitRenderMode);
-    _programObject->setUniform(_uniformCache.numberOfUniqueVertices,
-        numberOfUniqueVertices);
+    _programObject->setUniform(_uniformCache.idOffset, uniforms.idOffset);
 
-#if !defined(__APPLE__)
-    std::array<GLint, 4> viewport;
-    global::renderEngine->openglStateCache().viewport(viewport.data());
+    _programObject->setUniform(_uniformCache.nVertices, uniforms.nVertices);
+    _programObject->setUniform(_uniformCache.floatingOffset, uniforms.floatingOffset);
     _programObject->setUniform(
-        _uniformCache.viewport,
-        static_cast<float>(viewport[0]),
-        static_cast<float>(viewport[1]),
-        static_cast<float>(viewport[2]),
-        static_cast<float>(viewport[3])
+        _uniformCache.useSplitRenderMode,
+        uniforms.useSplitRenderMode
     );
     _programObject->setUniform(
-        _uniformCache.lineWidth,
-        std::ceil((2.f * 1.f + _appearance.lineWidth) * std::sqrt(2.f))
+        _uniformCache.numberOfUniqueVertices,
+        uniforms.numberOfUniqueVertices
     );
-#endif // !defined(__APPLE__)
 
-    if (renderPoints) {
-        // The stride parameter determines the distance between larger points and
-        // smaller ones
-        _programObject->setUniform(_uniformCache.stride, info.stride);
-        _programObject->setUniform(_uniformCache.pointSize, _appearance.pointSize);
+    // The stride parameter determines the distance between larger points and smaller
+    // ones
+    _programObject->setUniform(_uniformCache.stride, uniforms.stride);
+    _programObject->setUniform(_uniformCache.renderPhase, uniforms.renderPhase);
+}
+
+void RenderableTrail::internalRender(bool renderLines, bool renderPoints,
+                                     const RenderData& data,
+                                     const glm::dmat4& modelTransform,
+                                     const FrameUniforms& frameUniforms,
+                                     DrawList* drawList, RenderInformation& info,
+                                     int nVertices, int ringOffset,
+                                     bool useSplitRenderMode, int numberOfUniqueVertices,
+                                     int floatingOffset)
+{
+    ZoneScoped;
+
+    PartUniforms part;
+    part.modelViewTransform =
+        calcModelViewTransform(data, modelTransform) * info._localTransform;
+    part.vertexSortingMethod = [](RenderInformation::VertexSorting s) {
+        switch (s) {
+            case RenderInformation::VertexSorting::NewestFirst: return 0;
+            case RenderInformation::VertexSorting::OldestFirst: return 1;
+            case RenderInformation::VertexSorting::NoSorting:   return 2;
+            default:                                  throw ghoul::MissingCaseException();
+        }
+    }(info.sorting);
+    part.idOffset = ringOffset;
+    part.nVertices = nVertices;
+    part.stride = info.stride;
+    part.floatingOffset = floatingOffset;
+    part.useSplitRenderMode = useSplitRenderMode;
+    part.numberOfUniqueVertices = numberOfUniqueVertices;
+
+    // Subclasses of this renderer might be using the index array or might now be so we
+    // check if there is data available and if there isn't, we use the glDrawArrays draw
+    // call; otherwise the glDrawElements
+    const bool isIndexed = info._iBufferID != 0;
+
+    if (drawList) {
+        // All trails share the same program, blend and depth state, so the DrawList
+        // executes the draw calls of all trails in the render bin without switching the
+        // program. The uniforms are captured by value as the packets are executed at the
+        // end of the render bin
+        auto submit = [&](GLenum mode, RenderPhase phase) {
+            PartUniforms uniforms = part;
+            uniforms.renderPhase = phase;
+
+            DrawPacket packet;
+            packet.program = _programObject;
+            packet.vao = info._vaoID;
+            packet.blendMode = DrawPacket::BlendMode::Additive;
+            packet.depthMode = DrawPacket::DepthMode::Test;
+            packet.lineWidth = frameUniforms.lineWidth;
+            packet.programPointSize = (mode == GL_POINTS);
+            packet.mode = mode;
+            packet.first = isIndexed ?
+                static_cast<GLint>(info.first * sizeof(unsigned int)) :
+                info.first;
+            packet.count = info.count;
+            packet.indexType = isIndexed ? GL_UNSIGNED_INT : GL_NONE;
+            packet.setUniforms = [this, frameUniforms, uniforms](
+                                                         ghoul::opengl::ProgramObject&)
+            {
+                setUniforms(frameUniforms);
+                setUniforms(uniforms);
+            };
+            drawList->submit(std::move(packet));
+        };
+
+        if (renderLines) {
+            submit(GL_LINE_STRIP, RenderPhaseLines);
+        }
+        if (renderPoints) {
+            submit(GL_POINTS, RenderPhasePoints);
+        }
+        return;
     }
 
-    // Fragile! Keep in sync with fragment shader
-    enum RenderPhase {
-        RenderPhaseLines = 0,
-        RenderPhasePoints
-    };
+    setUniforms(part);
 
     glBindVertexArray(info._vaoID);
     if (renderLines) {
         _programObject->setUniform(_uniformCache.renderPhase, RenderPhaseLines);
-        // Subclasses of this renderer might be using the index array or might now be
-        // so we check if there is data available and if there isn't, we use the
-        // glDrawArrays draw call; otherwise the glDrawElements
-        if (info._iBufferID == 0) {
+        if (!isIndexed) {
             glDrawArrays(
                 GL_LINE_STRIP,
                 info.first,
@@ -387,11 +455,8 @@ void RenderableTrail::internalRender(bool renderLines, bool renderPoints,
         }
     }
     if (renderPoints) {
-        // Subclasses of this renderer might be using the index array or might now be
-        // so we check if there is data available and if there isn't, we use the
-        // glDrawArrays draw call; otherwise the glDrawElements
         _programObject->setUniform(_uniformCache.renderPhase, RenderPhasePoints);
-        if (info._iBufferID == 0) {
+        if (!isIndexed) {
             glDrawArrays(GL_POINTS, info.first, info.count);
         }
         else {
@@ -405,51 +470,57 @@ void RenderableTrail::internalRender(bool renderLines, bool renderPoints,
     }
 }
 
-void RenderableTrail::render(const RenderData& data, RendererTasks&) {
+void RenderableTrail::render(const RenderData& data, RendererTasks& rendererTask) {
     ZoneScoped;
 
-    _programObject->activate();
-    _programObject->setUniform(_uniformCache.opacity, opacity());
-
     const glm::dmat4 modelTransform = calcModelTransform(data);
 
-    _programObject->setUniform(
-        _uniformCache.projectionTransform,
-        data.camera.projectionMatrix()
-    );
-
-    _programObject->setUniform(_uniformCache.color, _appearance.lineColor);
-    _programObject->setUniform(_uniformCache.useLineFade, _appearance.useLineFade);
+    FrameUniforms frame;
+    frame.opacity = opacity();
+    frame.projectionTransform = data.camera.projectionMatrix();
+    frame.color = _appearance.lineColor;
+    frame.useLineFade = _appearance.useLineFade;
     if (_appearance.useLineFade) {
         const float startPoint = 1.f - _appearance.lineLength;
         const float remainingRange = 1.f - startPoint;
         const float delta = remainingRange * _appearance.lineFadeAmount;
         const float endPoint = std::min(startPoint + delta, 1.f);
-        _programObject->setUniform(_uniformCache.lineLength, startPoint);
-        _programObject->setUniform(_uniformCache.lineFadeAmount, endPoint);
+        frame.lineLength = startPoint;
+        frame.lineFadeAmount = endPoint;
     }
+    frame.pointSize = _appearance.pointSize;
+#ifdef __APPLE__
+    frame.lineWidth = 1.f;
+#else
+    std::array<GLint, 4> viewport;
+    global::renderEngine->openglStateCache().viewport(viewport.data());
+    frame.viewport = glm::vec4(viewport[0], viewport[1], viewport[2], viewport[3]);
+    frame.lineWidth = std::ceil((2.f * 1.f + _appearance.lineWidth) * std::sqrt(2.f));
+#endif
 
     /*glm::ivec2 resolution = global::renderEngine.renderingResolution();
     _programObject->setUniform(_uniformCache.resolution, resolution);*/
 
-    glDepthMask(false);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-
     const bool renderLines = (_appearance.renderingModes == RenderingModeLines) ||
                              (_appearance.renderingModes == RenderingModeLinesPoints);
 
     const bool renderPoints = (_appearance.renderingModes == RenderingModePoints) ||
                               (_appearance.renderingModes == RenderingModeLinesPoints);
 
-    if (renderLines) {
-#ifdef __APPLE__
-        glLineWidth(1);
-#else
-        glLineWidth(std::ceil((2.f * 1.f + _appearance.lineWidth) * std::sqrt(2.f)));
-#endif
-    }
-    if (renderPoints) {
-        glEnable(GL_PROGRAM_POINT_SIZE);
+    DrawList* drawList = rendererTask.drawList;
+    if (!drawList) {
+        _programObject->activate();
+        setUniforms(frame);
+
+        glDepthMask(false);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+        if (renderLines) {
+            glLineWidth(frame.lineWidth);
+        }
+        if (renderPoints) {
+            glEnable(GL_PROGRAM_POINT_SIZE);
+        }
     }
 
     // The combined size of vertices; -1 because we duplicate the penultimate point
@@ -485,6 +556,8 @@ void RenderableTrail::render(const RenderData& data, RendererTasks&) {
             renderPoints,
             data,
             modelTransform,
+            frame,
+            drawList,
             _primaryRenderInformation,
             _primaryRenderInformation.count,
             _primaryRenderInformation.first,
@@ -498,6 +571,8 @@ void RenderableTrail::render(const RenderData& data, RendererTasks&) {
             renderPoints,
             data,
             modelTransform,
+            frame,
+            drawList,
             _floatingRenderInformation,
             _floatingRenderInformation.count,
             _floatingRenderInformation.first,
@@ -512,6 +587,8 @@ void RenderableTrail::render(const RenderData& data, RendererTasks&) {
             renderPoints,
             data,
             modelTransform,
+            frame,
+            drawList,
             _secondaryRenderInformation,
             _secondaryRenderInformation.count,
             _secondaryRenderInformation.first,
@@ -528,6 +605,8 @@ void RenderableTrail::render(const RenderData& data, RendererTasks&) {
             renderPoints,
             data,
             modelTransform,
+            frame,
+            drawList,
             _primaryRenderInformation,
             totalNumber,
             primaryOffset
@@ -541,6 +620,8 @@ void RenderableTrail::render(const RenderData& data, RendererTasks&) {
                 renderPoints,
                 data,
                 modelTransform,
+                frame,
+                drawList,
                 _floatingRenderInformation,
                 totalNumber,
                 // -1 because we duplicate the penultimate point between the vertices
@@ -549,8 +630,9 @@ void RenderableTrail::render(const RenderData& data, RendererTasks&) {
         }
     }
 
-
-
+    if (drawList) {
+        return;
+    }
 
     if (renderPoints) {
         glDisable(GL_PROGRAM_POINT_SIZE);
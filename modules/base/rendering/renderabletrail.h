@@ -48,6 +48,7 @@ namespace openspace {
 
 namespace documentation { struct Documentation; }
 
+class DrawList;
 class Translation;
 
 /**
@@ -181,13 +182,48 @@ protected:
     int _numberOfUniqueVertices = 0;
 
 private:
+    /// The uniforms that are shared between all parts of the trail in a frame
+    struct FrameUniforms {
+        float opacity = 1.f;
+        glm::dmat4 projectionTransform = glm::dmat4(1.0);
+        glm::vec3 color = glm::vec3(1.f);
+        bool useLineFade = false;
+        float lineLength = 0.f;
+        float lineFadeAmount = 0.f;
+        int pointSize = 1;
+        glm::vec4 viewport = glm::vec4(0.f);
+        float lineWidth = 1.f;
+    };
+
+    /// The uniforms that are specific to one of the RenderInformation parts
+    struct PartUniforms {
+        glm::dmat4 modelViewTransform = glm::dmat4(1.0);
+        int vertexSortingMethod = 0;
+        int idOffset = 0;
+        int nVertices = 0;
+        int stride = 1;
+        int floatingOffset = 0;
+        bool useSplitRenderMode = false;
+        int numberOfUniqueVertices = 0;
+        int renderPhase = 0;
+    };
+
+    /**
+     * Renders one of the RenderInformation parts. If \p drawList is not `nullptr`, the
+     * draw calls are submitted to it instead, so that all trails of a render bin are
+     * drawn in sequence with the shared program only being activated once.
+     */
     void internalRender(bool renderLines, bool renderPoints,
         const RenderData& data,
         const glm::dmat4& modelTransform,
+        const FrameUniforms& frameUniforms, DrawList* drawList,
         RenderInformation& info, int nVertices, int ringOffset,
         bool useSplitRenderMode = false, int numberOfUniqueVertices = 0,
         int floatingOffset = 0);
 
+    void setUniforms(const FrameUniforms& uniforms);
+    void setUniforms(const PartUniforms& uniforms);
+
    Appearance _appearance;
 
     /// Program object used to render the data stored in RenderInformation
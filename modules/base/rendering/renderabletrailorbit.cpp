@@ -360,16 +360,19 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
             return { false, true, UpdateReport::All };
         }
 
+        // Compute all new permanent points at once
+        _sampleTimes.resize(nNewPoints);
+        for (uint64_t i = 0; i < nNewPoints; i++) {
+            _sampleTimes[i] = _lastPointTime + (i + 1) * secondsPerPoint;
+        }
+        _samplePositions.resize(nNewPoints);
+        _translation->positions(_sampleTimes, _samplePositions);
+
         for (int i = 0; i < nNewPoints; i++) {
             _lastPointTime += secondsPerPoint;
 
-            // Get the new permanent point and write it into the (previously) floating
-            // location
-            const glm::vec3 p = _translation->position({
-                {},
-                Time(_lastPointTime),
-                Time(0.0)
-            });
+            // Write the new permanent point into the (previously) floating location
+            const glm::vec3 p = _samplePositions[i];
             _vertexArray[_primaryRenderInformation.first] = { p.x, p.y, p.z };
 
             // Move the current pointer back one step to be used as the new floating
@@ -400,16 +403,19 @@ RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
             return { false, true, UpdateReport::All };
         }
 
+        // Compute all new permanent points at once
+        _sampleTimes.resize(nNewPoints);
+        for (int i = 0; i < nNewPoints; i++) {
+            _sampleTimes[i] = _firstPointTime - (i + 1) * secondsPerPoint;
+        }
+        _samplePositions.resize(nNewPoints);
+        _translation->positions(_sampleTimes, _samplePositions);
+
         for (int i = 0; i < nNewPoints; i++) {
             _firstPointTime -= secondsPerPoint;
 
-            // Get the new permanent point and write it into the (previously) floating
-            // location
-            const glm::vec3 p = _translation->position({
-                {},
-                Time(_firstPointTime),
-                Time(0.0)
-            });
+            // Write the new permanent point into the (previously) floating location
+            const glm::vec3 p = _samplePositions[i];
             _vertexArray[_primaryRenderInformation.first] = { p.x, p.y, p.z };
 
             // if we are on the upper bounds of the array, we start at 0
@@ -451,12 +457,18 @@ void RenderableTrailOrbit::fullSweep(double time) {
     const double periodSeconds = _period * duration_cast<seconds>(hours(24)).count();
     const double secondsPerPoint = periodSeconds / (_resolution - 1);
     // starting at 1 because the first position is a floating current one
+    _sampleTimes.resize(_resolution - 1);
     for (int i = 1; i < _resolution; i++) {
-        const glm::vec3 p = _translation->position({ {}, Time(time), Time(0.0) });
-        _vertexArray[i] = { p.x, p.y, p.z };
-
+        _sampleTimes[i - 1] = time;
         time -= secondsPerPoint;
     }
+    _samplePositions.resize(_sampleTimes.size());
+    _translation->positions(_sampleTimes, _samplePositions);
+
+    for (int i = 1; i < _resolution; i++) {
+        const glm::vec3 p = _samplePositions[i - 1];
+        _vertexArray[i] = { p.x, p.y, p.z };
+    }
 
     _primaryRenderInformation.first = 0;
     _primaryRenderInformation.count = _resolution;
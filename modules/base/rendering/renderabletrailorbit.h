@@ -29,6 +29,7 @@
 
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
+#include <vector>
 
 namespace openspace {
 
@@ -110,6 +111,10 @@ private:
     double _lastPointTime = 0.0;
     /// The time stamp of when the last valid trail was generated.
     double _previousTime = 0.0;
+
+    /// Scratch storage for the times and positions that are sampled in one batch
+    std::vector<double> _sampleTimes;
+    std::vector<glm::dvec3> _samplePositions;
 };
 
 } // namespace openspace
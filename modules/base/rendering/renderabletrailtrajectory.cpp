@@ -30,6 +30,12 @@
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/timeconversion.h>
 #include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
 #include <optional>
 
 // This class creates the entire trajectory at once and keeps it in memory the entire
@@ -45,6 +51,10 @@
 // _endTime. This buffer is updated every frame.
 
 namespace {
+    constexpr std::string_view _loggerCat = "RenderableTrailTrajectory";
+
+    constexpr int8_t TrajectoryCacheVersion = 1;
+
     constexpr openspace::properties::Property::PropertyInfo StartTimeInfo = {
         "StartTime",
         "Start Time",
@@ -109,6 +119,16 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseCacheInfo = {
+        "UseCache",
+        "Use Cache",
+        "If enabled, the sampled positions of the trail are stored on disk and are "
+        "reused when the same trail is shown again, as long as neither its settings, the "
+        "settings of the translation, nor the files the translation reads from have "
+        "changed.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo AccurateTrailPositionsInfo = {
         "AccurateTrailPositions",
         "Number of Accurate Trail Points",
@@ -147,6 +167,9 @@ namespace {
 
         // [[codegen::verbatim(AccurateTrailPositionsInfo.description)]]
         std::optional<int> accurateTrailPositions;
+
+        // [[codegen::verbatim(UseCacheInfo.description)]]
+        std::optional<bool> useCache;
     };
 #include "renderabletrailtrajectory_codegen.cpp"
 } // namespace
@@ -164,14 +187,13 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     : RenderableTrail(dictionary)
     , _sweepChunkSize(SweepChunkSizeInfo, 200, 50, 5000)
     , _enableSweepChunking(EnableSweepChunkingInfo, false)
+    , _useCache(UseCacheInfo, true)
     , _startTime(StartTimeInfo)
     , _endTime(EndTimeInfo)
     , _sampleInterval(SampleIntervalInfo, 2.0, 2.0, 1e6)
     , _timeStampSubsamplingFactor(TimeSubSampleInfo, 1, 1, 1000000000)
     , _renderFullTrail(RenderFullPathInfo, false)
     , _numberOfReplacementPoints(AccurateTrailPositionsInfo, 100, 0, 1000)
-    , _maxVertex(glm::vec3(-std::numeric_limits<float>::max()))
-    , _minVertex(glm::vec3(std::numeric_limits<float>::max()))
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -214,6 +236,9 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     _sweepChunkSize = p.sweepChunkSize.value_or(_sweepChunkSize);
     addProperty(_sweepChunkSize);
 
+    _useCache = p.useCache.value_or(_useCache);
+    addProperty(_useCache);
+
     // We store the vertices with ascending temporal order
     _primaryRenderInformation.sorting = RenderInformation::VertexSorting::OldestFirst;
     _secondaryRenderInformation.sorting = RenderInformation::VertexSorting::OldestFirst;
@@ -240,6 +265,12 @@ void RenderableTrailTrajectory::initializeGL() {
 }
 
 void RenderableTrailTrajectory::deinitializeGL() {
+    // The worker thread accesses the SpiceManager and the cache, so it has to finish
+    // before the application can shut down
+    if (_sweepResult.valid()) {
+        _sweepResult.wait();
+    }
+
     glDeleteVertexArrays(1, &_primaryRenderInformation._vaoID);
     glDeleteBuffers(1, &_primaryRenderInformation._vBufferID);
 
@@ -251,117 +282,315 @@ void RenderableTrailTrajectory::deinitializeGL() {
 
 void RenderableTrailTrajectory::reset() {
     _needsFullSweep = true;
-    _sweepIteration = 0;
-    _maxVertex = glm::vec3(-std::numeric_limits<float>::max());
-    _minVertex = glm::vec3(std::numeric_limits<float>::max());
 }
 
-void RenderableTrailTrajectory::update(const UpdateData& data) {
-    if (_needsFullSweep) {
+std::string RenderableTrailTrajectory::cacheKey(const TrajectoryData& data) const {
+    // The key has to change whenever anything changes that influences the positions of
+    // the trajectory, which are the settings of the translation, the sampled times, and
+    // the files that the translation and the loaded SPICE kernels read from
+    std::string key = std::format(
+        "{}|{}|{}|{}|{}",
+        _translation->type(), data.start, data.end, data.interval, data.nVertices
+    );
+    std::function<void(const properties::PropertyOwner&)> addOwner =
+        [&key, &addOwner](const properties::PropertyOwner& owner)
+        {
+            for (const properties::Property* property : owner.properties()) {
+                key += std::format(
+                    "|{}={}", property->identifier(), property->stringValue()
+                );
+            }
+            for (const properties::PropertyOwner* subOwner : owner.propertySubOwners()) {
+                addOwner(*subOwner);
+            }
+        };
+    addOwner(*_translation);
+    for (const std::filesystem::path& file : _translation->sourceFiles()) {
+        std::error_code timeEc;
+        const auto writeTime = std::filesystem::last_write_time(file, timeEc);
+        std::error_code sizeEc;
+        const uintmax_t size = std::filesystem::file_size(file, sizeEc);
+        key += std::format(
+            "|{}@{}#{}",
+            file,
+            timeEc ? 0 : writeTime.time_since_epoch().count(),
+            sizeEc ? 0 : size
+        );
+    }
+    for (const std::filesystem::path& kernel : SpiceManager::ref().loadedKernels()) {
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(kernel, ec);
+        key += std::format(
+            "|{}@{}", kernel, ec ? 0 : writeTime.time_since_epoch().count()
+        );
+    }
+    return key;
+}
 
-        if (_sweepIteration == 0) {
-            // Max number of vertices
-            constexpr unsigned int maxNumberOfVertices = 1000000;
+bool RenderableTrailTrajectory::loadCachedTrajectory(const std::filesystem::path& file,
+                                                     const std::string& key,
+                                                     TrajectoryData& data)
+{
+    std::ifstream f = std::ifstream(file, std::ios::binary);
+    if (!f.good()) {
+        return false;
+    }
 
-            // Convert the start and end time from string representations to J2000 seconds
-            _start = SpiceManager::ref().ephemerisTimeFromDate(_startTime);
-            _end = SpiceManager::ref().ephemerisTimeFromDate(_endTime);
-            const double timespan = _end - _start;
+    int8_t version = 0;
+    f.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    if (version != TrajectoryCacheVersion) {
+        return false;
+    }
 
-            _totalSampleInterval = _sampleInterval / _timeStampSubsamplingFactor;
+    // The full key is stored alongside the data to guard against hash collisions
+    uint64_t keySize = 0;
+    f.read(reinterpret_cast<char*>(&keySize), sizeof(uint64_t));
+    if (keySize != key.size()) {
+        return false;
+    }
+    std::string storedKey;
+    storedKey.resize(keySize);
+    f.read(storedKey.data(), keySize);
+    if (storedKey != key) {
+        return false;
+    }
 
-            // Cap _numberOfVertices in order to prevent overflow and extreme performance
-            // degredation/RAM usage
-            _numberOfVertices = std::min(
-                static_cast<unsigned int>(std::ceil(timespan / _totalSampleInterval)),
-                maxNumberOfVertices
-            );
+    uint64_t size = 0;
+    f.read(reinterpret_cast<char*>(&size), sizeof(uint64_t));
+    if (size != data.nVertices + 1) {
+        return false;
+    }
+    data.times.resize(size);
+    f.read(reinterpret_cast<char*>(data.times.data()), size * sizeof(double));
+    data.dVertices.resize(size);
+    f.read(
+        reinterpret_cast<char*>(data.dVertices.data()),
+        size * sizeof(TrailVBOLayout<double>)
+    );
+    if (!f.good()) {
+        return false;
+    }
 
-            // We need to recalcuate the _totalSampleInterval if _numberOfVertices eqals
-            // maxNumberOfVertices. If we don't do this the position for each vertex
-            // will not be correct for the number of vertices we are doing along the trail
-            _totalSampleInterval = (_numberOfVertices == maxNumberOfVertices) ?
-                (timespan / _numberOfVertices) : _totalSampleInterval;
-
-            // Make space for the vertices
-            _vertexArray.clear();
-            _dVertexArray.clear();
-            _timeVector.clear();
-            _vertexArray.resize(_numberOfVertices + 1);
-            _dVertexArray.resize(_numberOfVertices + 1);
-            _timeVector.resize(_numberOfVertices + 1);
-        }
+    data.vertices.resize(size);
+    for (size_t i = 0; i < size; i++) {
+        const TrailVBOLayout<double>& dp = data.dVertices[i];
+        data.vertices[i] = {
+            static_cast<float>(dp.x),
+            static_cast<float>(dp.y),
+            static_cast<float>(dp.z)
+        };
+        data.maxVertex = glm::max(data.maxVertex, glm::dvec3(dp.x, dp.y, dp.z));
+        data.minVertex = glm::min(data.minVertex, glm::dvec3(dp.x, dp.y, dp.z));
+    }
+    return true;
+}
 
-        // Calculate sweeping range for this iteration
-        const unsigned int startIndex = _sweepIteration * _sweepChunkSize;
-        const unsigned int nextIndex = (_sweepIteration + 1) * _sweepChunkSize;
-        unsigned int stopIndex = std::min(nextIndex, _numberOfVertices);
+void RenderableTrailTrajectory::saveCachedTrajectory(const std::filesystem::path& file,
+                                                     const std::string& key,
+                                                     const TrajectoryData& data)
+{
+    std::ofstream f = std::ofstream(file, std::ios::binary);
+    if (!f.good()) {
+        LWARNING(std::format("Could not write trajectory cache to '{}'", file));
+        return;
+    }
 
-        // If iterative calculations are disabled
-        if (!_enableSweepChunking) {
-            stopIndex = _numberOfVertices;
-        }
+    f.write(reinterpret_cast<const char*>(&TrajectoryCacheVersion), sizeof(int8_t));
+    const uint64_t keySize = key.size();
+    f.write(reinterpret_cast<const char*>(&keySize), sizeof(uint64_t));
+    f.write(key.data(), keySize);
+    const uint64_t size = data.times.size();
+    f.write(reinterpret_cast<const char*>(&size), sizeof(uint64_t));
+    f.write(reinterpret_cast<const char*>(data.times.data()), size * sizeof(double));
+    f.write(
+        reinterpret_cast<const char*>(data.dVertices.data()),
+        size * sizeof(TrailVBOLayout<double>)
+    );
+}
 
-        // Calculate all vertex positions
-        for (unsigned int i = startIndex; i < stopIndex; i++) {
-            const glm::dvec3 dp = _translation->position({
-                {},
-                Time(_start + i * _totalSampleInterval),
-                Time(0.0)
-            });
-            const glm::vec3 p(dp.x, dp.y, dp.z);
-            _vertexArray[i] = { p.x, p.y, p.z };
-            _timeVector[i] = Time(_start + i * _totalSampleInterval).j2000Seconds();
-            _dVertexArray[i] = {dp.x, dp.y, dp.z};
-
-            // Set max and min vertex for bounding sphere calculations
-            _maxVertex = glm::max(_maxVertex, dp);
-            _minVertex = glm::min(_minVertex, dp);
-        }
-        ++_sweepIteration;
-
-        // Full sweep is complete here.
-        // Adds the last point in time to the _vertexArray so that we
-        // ensure that points for _start and _end always exists
-        if (stopIndex == _numberOfVertices) {
-            const glm::dvec3 dp = _translation->position({
-                {},
-                Time(_end),
-                Time(0.0)
-                });
-            const glm::vec3 p(dp.x, dp.y, dp.z);
-            _vertexArray[stopIndex] = { p.x, p.y, p.z };
-            _timeVector[stopIndex] = Time(_end).j2000Seconds();
-            _dVertexArray[stopIndex] = { dp.x, dp.y, dp.z };
-
-            _sweepIteration = 0;
-            setBoundingSphere(glm::distance(_maxVertex, _minVertex) / 2.0);
-        }
-        else {
-            // Early return as we don't need to render if we are still
-            // doing full sweep calculations
-            return;
-        }
+void RenderableTrailTrajectory::sampleTrajectory(
+                                         const Translation::PositionsFunction& positions,
+                                                                     TrajectoryData& data,
+                                                 unsigned int first, unsigned int last)
+{
+    ghoul_assert(last <= data.nVertices + 1, "Sample range out of bounds");
+
+    // The last point is always placed at the end time so that points for the start and
+    // the end always exist
+    std::vector<double> times = std::vector<double>(last - first);
+    for (unsigned int i = first; i < last; i++) {
+        times[i - first] = (i == data.nVertices) ?
+            Time(data.end).j2000Seconds() :
+            Time(data.start + i * data.interval).j2000Seconds();
+    }
+    std::vector<glm::dvec3> result = std::vector<glm::dvec3>(times.size());
+    positions(times, result);
+
+    for (unsigned int i = first; i < last; i++) {
+        const glm::dvec3& dp = result[i - first];
+        data.vertices[i] = {
+            static_cast<float>(dp.x),
+            static_cast<float>(dp.y),
+            static_cast<float>(dp.z)
+        };
+        data.dVertices[i] = { dp.x, dp.y, dp.z };
+        data.times[i] = times[i - first];
+
+        // Set max and min vertex for bounding sphere calculations
+        data.maxVertex = glm::max(data.maxVertex, dp);
+        data.minVertex = glm::min(data.minVertex, dp);
+    }
+}
 
-        // Upload vertices to the GPU
-        glBindVertexArray(_primaryRenderInformation._vaoID);
-        glBindBuffer(GL_ARRAY_BUFFER, _primaryRenderInformation._vBufferID);
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            _vertexArray.size() * sizeof(TrailVBOLayout<float>),
-            _vertexArray.data(),
-            GL_STATIC_DRAW
+void RenderableTrailTrajectory::startSweep() {
+    // Max number of vertices
+    constexpr unsigned int maxNumberOfVertices = 1000000;
+
+    TrajectoryData data;
+
+    // Convert the start and end time from string representations to J2000 seconds
+    data.start = SpiceManager::ref().ephemerisTimeFromDate(_startTime);
+    data.end = SpiceManager::ref().ephemerisTimeFromDate(_endTime);
+    const double timespan = data.end - data.start;
+    data.interval = _sampleInterval / _timeStampSubsamplingFactor;
+
+    // Cap the number of vertices in order to prevent overflow and extreme performance
+    // degredation/RAM usage
+    data.nVertices = std::min(
+        static_cast<unsigned int>(std::ceil(timespan / data.interval)),
+        maxNumberOfVertices
+    );
+
+    // We need to recalcuate the interval if the number of vertices eqals
+    // maxNumberOfVertices. If we don't do this the position for each vertex will not be
+    // correct for the number of vertices we are doing along the trail
+    data.interval = (data.nVertices == maxNumberOfVertices) ?
+        (timespan / data.nVertices) : data.interval;
+
+    const std::string key = cacheKey(data);
+    const std::filesystem::path cacheFile = FileSys.cacheManager()->cachedFilename(
+        "RenderableTrailTrajectory",
+        std::format("Trajectory|{}", std::hash<std::string>{}(key))
+    );
+    const bool useCache = _useCache;
+    if (useCache && loadCachedTrajectory(cacheFile, key, data)) {
+        applySweep(std::move(data));
+        return;
+    }
+
+    // Make space for the vertices
+    data.vertices.resize(data.nVertices + 1);
+    data.dVertices.resize(data.nVertices + 1);
+    data.times.resize(data.nVertices + 1);
+
+    Translation::PositionsFunction snapshot = _translation->positionsSnapshot();
+    if (snapshot) {
+        // The translation provides a snapshot of its parameters that does not access the
+        // translation itself, so the entire sweep happens on a worker thread while the
+        // previous trail is still being shown. Changes to the translation's parameters
+        // during the sweep do not affect the snapshot, but reset the trail, which
+        // discards the result and starts a new sweep with the new parameters
+        _sweepResult = std::async(
+            std::launch::async,
+            [snapshot = std::move(snapshot), data = std::move(data), key, cacheFile,
+             useCache]() mutable
+            {
+                sampleTrajectory(snapshot, data, 0, data.nVertices + 1);
+                if (useCache) {
+                    saveCachedTrajectory(cacheFile, key, data);
+                }
+                return std::move(data);
+            }
         );
+    }
+    else {
+        // Otherwise the sweep is performed on the main thread, potentially split up into
+        // chunks over multiple frames
+        _sweepData = std::move(data);
+        _sweepCacheKey = key;
+        _sweepCacheFile = cacheFile;
+        _sweepIndex = 0;
+        _isSweeping = true;
+    }
+}
 
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+void RenderableTrailTrajectory::applySweep(TrajectoryData data) {
+    _start = data.start;
+    _end = data.end;
+    _vertexArray = std::move(data.vertices);
+    _dVertexArray = std::move(data.dVertices);
+    _timeVector = std::move(data.times);
+    setBoundingSphere(glm::distance(data.maxVertex, data.minVertex) / 2.0);
+
+    // Upload vertices to the GPU
+    glBindVertexArray(_primaryRenderInformation._vaoID);
+    glBindBuffer(GL_ARRAY_BUFFER, _primaryRenderInformation._vBufferID);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        _vertexArray.size() * sizeof(TrailVBOLayout<float>),
+        _vertexArray.data(),
+        GL_STATIC_DRAW
+    );
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glBindVertexArray(0);
+
+    // We clear the indexArray just in case. The base class will take care not to use
+    // it if it is empty
+    _indexArray.clear();
+    _subsamplingIsDirty = true;
+}
 
-        // We clear the indexArray just in case. The base class will take care not to use
-        // it if it is empty
-        _indexArray.clear();
+void RenderableTrailTrajectory::update(const UpdateData& data) {
+    using namespace std::chrono_literals;
+    if (_sweepResult.valid() && _sweepResult.wait_for(0s) == std::future_status::ready)
+    {
+        TrajectoryData result = _sweepResult.get();
+        // If the trail was reset while the sweep was running, the result is already
+        // outdated and a new sweep is started below instead
+        if (!_needsFullSweep) {
+            applySweep(std::move(result));
+        }
+    }
 
-        _subsamplingIsDirty = true;
+    if (_needsFullSweep && !_sweepResult.valid()) {
         _needsFullSweep = false;
+        _isSweeping = false;
+        startSweep();
+    }
+
+    if (_isSweeping) {
+        // Calculate sweeping range for this iteration
+        const unsigned int nTotal = _sweepData.nVertices + 1;
+        const unsigned int stopIndex = _enableSweepChunking ?
+            std::min(_sweepIndex + static_cast<unsigned int>(_sweepChunkSize), nTotal) :
+            nTotal;
+
+        sampleTrajectory(
+            [this](std::span<const double> times, std::span<glm::dvec3> result) {
+                _translation->positions(times, result);
+            },
+            _sweepData,
+            _sweepIndex,
+            stopIndex
+        );
+        _sweepIndex = stopIndex;
+
+        // Full sweep is complete here
+        if (_sweepIndex == nTotal) {
+            if (_useCache) {
+                saveCachedTrajectory(_sweepCacheFile, _sweepCacheKey, _sweepData);
+            }
+            applySweep(std::move(_sweepData));
+            _sweepData = TrajectoryData();
+            _isSweeping = false;
+        }
+    }
+
+    if (_timeVector.empty()) {
+        // Nothing to show until the first sweep has finished
+        return;
     }
 
     // This has to be done every update step;
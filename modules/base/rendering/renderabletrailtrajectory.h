@@ -32,6 +32,11 @@
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <array>
+#include <filesystem>
+#include <future>
+#include <limits>
+#include <string>
+#include <vector>
 
 namespace openspace {
 
@@ -47,6 +52,11 @@ namespace documentation { struct Documentation; }
  * trail in the future. If _renderFullTrail is false, the current position of the object
  * has to be updated constantly to make the trail connect to the object that has the
  * trail.
+ *
+ * The sampled trajectory is stored in the cache, keyed by the settings of the
+ * translation, the sampled time range, and the loaded SPICE kernels. If the translation
+ * supports being evaluated concurrently, the trajectory is sampled on a worker thread and
+ * the previous trail is shown until the new one is available.
  */
 class RenderableTrailTrajectory : public RenderableTrail {
 public:
@@ -60,16 +70,63 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /// The sampled positions and times of the full trajectory, together with the
+    /// parameters that were used to sample it
+    struct TrajectoryData {
+        double start = 0.0;
+        double end = 0.0;
+        double interval = 0.0;
+        unsigned int nVertices = 0;
+
+        std::vector<TrailVBOLayout<float>> vertices;
+        std::vector<TrailVBOLayout<double>> dVertices;
+        std::vector<double> times;
+
+        glm::dvec3 maxVertex = glm::dvec3(-std::numeric_limits<double>::max());
+        glm::dvec3 minVertex = glm::dvec3(std::numeric_limits<double>::max());
+    };
 
     /**
-     * Reset some variables to default state.
+     * Requests a new full sweep of the trajectory the next time the trail is updated.
      */
     void reset();
 
+    /**
+     * Determines the sampling parameters from the current property values and either
+     * loads the trajectory from the cache or starts sampling it.
+     */
+    void startSweep();
+
+    /**
+     * Replaces the currently shown trajectory with the provided \p data and uploads its
+     * vertices to the GPU.
+     */
+    void applySweep(TrajectoryData data);
+
+    /**
+     * Returns the key that identifies the trajectory described by the sampling parameters
+     * of \p data in the cache.
+     */
+    std::string cacheKey(const TrajectoryData& data) const;
+
+    /**
+     * Samples the positions with the indices in the range [\p first, \p last) of the
+     * trajectory described by \p data using the \p positions function.
+     */
+    static void sampleTrajectory(const Translation::PositionsFunction& positions,
+        TrajectoryData& data, unsigned int first, unsigned int last);
+
+    static bool loadCachedTrajectory(const std::filesystem::path& file,
+        const std::string& key, TrajectoryData& data);
+    static void saveCachedTrajectory(const std::filesystem::path& file,
+        const std::string& key, const TrajectoryData& data);
+
     /// The number of vertices that we calculate during each frame of the full sweep pass
     properties::IntProperty _sweepChunkSize;
     /// Enables or disables iterative vertex calculations during a full sweep
     properties::BoolProperty _enableSweepChunking;
+    /// Enables or disables storing the sampled positions on disk
+    properties::BoolProperty _useCache;
 
     /// The start time of the trail
     properties::StringProperty _startTime;
@@ -97,18 +154,18 @@ private:
     /// The conversion of the _endTime into the internal time format
     double _end = 0.0;
 
-    /// Tracks sweep iteration, is used to calculate which vertices to work on per frame
-    int _sweepIteration = 0;
-
-    /// How many points do we need to compute given the distance between the
-    /// start and end date and the desired sample interval
-    unsigned int _numberOfVertices = 0;
-
-    double _totalSampleInterval = 0.0;
-
-    /// Max and min vertex used to calculate the bounding sphere
-    glm::dvec3 _maxVertex;
-    glm::dvec3 _minVertex;
+    /// The result of a sweep that is running on a worker thread
+    std::future<TrajectoryData> _sweepResult;
+
+    /// Whether a sweep is currently performed on the main thread
+    bool _isSweeping = false;
+    /// The trajectory that is currently sampled on the main thread
+    TrajectoryData _sweepData;
+    /// The index of the next vertex that is sampled on the main thread
+    unsigned int _sweepIndex = 0;
+    /// The cache key and file for the trajectory sampled on the main thread
+    std::string _sweepCacheKey;
+    std::filesystem::path _sweepCacheFile;
 
     /// Contains all timestamps corresponding to the positions in _vertexArray
     std::vector<double> _timeVector;
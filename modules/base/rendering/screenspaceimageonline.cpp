@@ -24,20 +24,16 @@
 
 #include <modules/base/rendering/screenspaceimageonline.h>
 
+#include <modules/base/basemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
-#include <openspace/engine/downloadmanager.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
-#include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/programobject.h>
 #include <optional>
 
 namespace {
-    constexpr std::string_view _loggerCat = "ScreenSpaceImageOnline";
-
     constexpr openspace::properties::Property::PropertyInfo TextureInfo = {
         "URL",
         "Image URL",
@@ -90,75 +86,20 @@ bool ScreenSpaceImageOnline::deinitializeGL() {
 }
 
 void ScreenSpaceImageOnline::update() {
-    if (_textureIsDirty) {
-        if (!_imageFuture.valid()) {
-            std::future<DownloadManager::MemoryFile> future = downloadImageToMemory(
-                _texturePath
-            );
-            if (future.valid()) {
-                _imageFuture = std::move(future);
-            }
-        }
-
-        if (_imageFuture.valid() && DownloadManager::futureReady(_imageFuture)) {
-            const DownloadManager::MemoryFile imageFile = _imageFuture.get();
-
-            if (imageFile.corrupted) {
-                LERROR(std::format(
-                    "Error loading image from URL '{}'", _texturePath.value()
-                ));
-                return;
-            }
-
-            try {
-                std::unique_ptr<ghoul::opengl::Texture> texture =
-                    ghoul::io::TextureReader::ref().loadTexture(
-                        reinterpret_cast<void*>(imageFile.buffer),
-                        imageFile.size,
-                        2,
-                        imageFile.format
-                    );
-
-                if (texture) {
-                    // Images don't need to start on 4-byte boundaries, for example if the
-                    // image is only RGB
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-                    if (texture->format() == ghoul::opengl::Texture::Format::Red) {
-                        texture->setSwizzleMask({ GL_RED, GL_RED, GL_RED, GL_ONE });
-                    }
-
-                    texture->uploadTexture();
-                    texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-                    texture->purgeFromRAM();
-
-                    _texture = std::move(texture);
-                    _objectSize = _texture->dimensions();
-                    _textureIsDirty = false;
-                }
-            }
-            catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
-                _textureIsDirty = false;
-                LERRORC(e.component, e.message);
-            }
-        }
+    if (!_textureIsDirty) {
+        return;
     }
-}
 
-std::future<DownloadManager::MemoryFile> ScreenSpaceImageOnline::downloadImageToMemory(
-                                                                   const std::string& url)
-{
-    return global::downloadManager->fetchFile(
-        url,
-        [url](const DownloadManager::MemoryFile&) {
-            LDEBUG("Download to memory finished for screen space image");
-        },
-        [url](const std::string& err) {
-            LDEBUG(std::format(
-                "Download to memory failed for screen space image: {}", err
-            ));
-        }
-    );
+    OnlineImageCache::Image image = BaseModule::OnlineImages.image(_texturePath);
+    if (image.hasFailed) {
+        _textureIsDirty = false;
+        return;
+    }
+    if (image.texture) {
+        _texture = std::move(image.texture);
+        _objectSize = _texture->dimensions();
+        _textureIsDirty = false;
+    }
 }
 
 void ScreenSpaceImageOnline::bindTexture() {
@@ -27,8 +27,8 @@
 
 #include <openspace/rendering/screenspacerenderable.h>
 
-#include <openspace/engine/downloadmanager.h>
 #include <openspace/properties/stringproperty.h>
+#include <memory>
 
 namespace ghoul::opengl { class Texture; }
 
@@ -50,16 +50,13 @@ public:
 protected:
     bool _downloadImage = false;
     bool _textureIsDirty;
-    std::future<DownloadManager::MemoryFile> _imageFuture;
     properties::StringProperty _texturePath;
 
 private:
     void bindTexture() override;
 
-    std::future<DownloadManager::MemoryFile> downloadImageToMemory(
-        const std::string& url);
-
-    std::unique_ptr<ghoul::opengl::Texture> _texture;
+    /// The texture is shared with all other renderables that show the same image
+    std::shared_ptr<ghoul::opengl::Texture> _texture;
 };
 
 } // namespace openspace
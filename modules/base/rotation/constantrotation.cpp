@@ -80,6 +80,10 @@ ConstantRotation::ConstantRotation(const ghoul::Dictionary& dictionary)
     addProperty(_rotationRate);
 }
 
+bool ConstantRotation::supportsParallelUpdate() const {
+    return true;
+}
+
 glm::dmat3 ConstantRotation::matrix(const UpdateData& data) const {
     if (data.time.j2000Seconds() == data.previousFrameTime.j2000Seconds()) {
         return glm::dmat3();
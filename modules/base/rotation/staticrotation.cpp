@@ -119,6 +119,10 @@ StaticRotation::StaticRotation(const ghoul::Dictionary& dictionary) : StaticRota
     _type = "StaticRotation";
 }
 
+bool StaticRotation::supportsParallelUpdate() const {
+    return true;
+}
+
 glm::dmat3 StaticRotation::matrix(const UpdateData&) const {
     if (_matrixIsDirty) {
         _cachedMatrix = glm::mat3_cast(glm::quat(_eulerRotation.value()));
@@ -62,6 +62,10 @@ TimelineRotation::TimelineRotation(const ghoul::Dictionary& dictionary)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
+    // The keyframes are sorted by their time strings rather than their times, so they
+    // are added all at once to only sort the timeline once
+    std::vector<std::pair<double, ghoul::mm_unique_ptr<Rotation>>> keyframes;
+    keyframes.reserve(p.keyframes.size());
     for (const std::pair<const std::string, ghoul::Dictionary>& kf : p.keyframes) {
         const double t = Time::convertTime(kf.first);
 
@@ -69,9 +73,10 @@ TimelineRotation::TimelineRotation(const ghoul::Dictionary& dictionary)
             kf.second
         );
         if (rotation) {
-            _timeline.addKeyframe(t, std::move(rotation));
+            keyframes.emplace_back(t, std::move(rotation));
         }
     }
+    _timeline.addKeyframes(std::move(keyframes));
 
     _shouldInterpolate = p.shouldInterpolate.value_or(_shouldInterpolate);
     addProperty(_shouldInterpolate);
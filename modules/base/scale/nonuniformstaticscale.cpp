@@ -69,6 +69,10 @@ NonUniformStaticScale::NonUniformStaticScale(const ghoul::Dictionary& dictionary
     addProperty(_scaleValue);
 }
 
+bool NonUniformStaticScale::supportsParallelUpdate() const {
+    return true;
+}
+
 glm::dvec3 NonUniformStaticScale::scaleValue(const UpdateData&) const {
     return _scaleValue;
 }
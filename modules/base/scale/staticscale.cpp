@@ -71,6 +71,10 @@ StaticScale::StaticScale()
     _type = "StaticScale";
 }
 
+bool StaticScale::supportsParallelUpdate() const {
+    return true;
+}
+
 glm::dvec3 StaticScale::scaleValue(const UpdateData&) const {
     return glm::dvec3(_scaleValue);
 }
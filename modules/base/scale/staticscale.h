@@ -38,6 +38,7 @@ public:
     StaticScale();
     StaticScale(const ghoul::Dictionary& dictionary);
     glm::dvec3 scaleValue(const UpdateData& data) const override;
+    bool supportsParallelUpdate() const override;
 
     static documentation::Documentation Documentation();
 
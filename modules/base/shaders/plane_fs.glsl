@@ -32,20 +32,23 @@ in vec2 vs_st;
 uniform sampler2D colorTexture;
 uniform float opacity = 1.0;
 uniform bool mirrorBackside = true;
+uniform bool flipTexture = false;
 uniform vec3 multiplyColor;
 
 
 Fragment getFragment() {
+  vec2 st = flipTexture ? vec2(vs_st.s, 1.0 - vs_st.t) : vs_st;
+
   Fragment frag;
   if (gl_FrontFacing) {
-    frag.color = texture(colorTexture, vs_st);
+    frag.color = texture(colorTexture, st);
   }
   else {
     if (mirrorBackside) {
-      frag.color = texture(colorTexture, vec2(1.0 - vs_st.s, vs_st.t));
+      frag.color = texture(colorTexture, vec2(1.0 - st.s, st.t));
     }
     else {
-      frag.color = texture(colorTexture, vs_st);
+      frag.color = texture(colorTexture, st);
     }
   }
 
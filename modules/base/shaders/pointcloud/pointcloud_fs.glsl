@@ -29,6 +29,7 @@ flat in float vs_screenSpaceDepth;
 flat in vec4 vs_positionViewSpace;
 in vec2 texCoord;
 flat in int layer;
+flat in vec2 layerTexCoordScale;
 
 uniform float opacity;
 uniform vec3 color;
@@ -113,7 +114,15 @@ Fragment getFragment() {
 
   vec4 textureColor = vec4(1.0);
   if (hasSpriteTexture) {
-    fullColor *= texture(spriteTexture, vec3(texCoord, layer));
+    // Smaller sprites only cover a part of the layer. Stay half a texel inside of that
+    // region so that the linear filtering doesn't pick up the padding around them
+    vec2 halfTexel = 0.5 / vec2(textureSize(spriteTexture, 0).xy);
+    vec2 spriteCoord = clamp(
+      texCoord * layerTexCoordScale,
+      halfTexel,
+      layerTexCoordScale - halfTexel
+    );
+    fullColor *= texture(spriteTexture, vec3(spriteCoord, layer));
   }
 
   // Border
@@ -36,6 +36,7 @@ layout(triangle_strip, max_vertices = 4) out;
 flat out float gs_colorParameter;
 out vec2 texCoord;
 flat out int layer;
+flat out vec2 layerTexCoordScale;
 flat out float vs_screenSpaceDepth;
 flat out vec4 vs_positionViewSpace;
 
@@ -63,7 +64,10 @@ uniform vec3 cameraLookUp;
 // The max size is an angle, in degrees, for the diameter
 uniform float maxAngularSize;
 
-uniform vec2 aspectRatioScale;
+// The sprites of all layers share one texture array. Each texel holds the texture
+// coordinate scale (xy) and aspect ratio scale (zw) of the corresponding layer
+uniform bool hasSpriteTexture;
+uniform sampler1D spriteLayerInfo;
 
 const vec2 corners[4] = vec2[4](
   vec2(0.0, 0.0),
@@ -98,6 +102,14 @@ void main() {
   layer = int(textureLayer[0]);
   gs_colorParameter = colorParameter[0];
 
+  vec2 aspectRatioScale = vec2(1.0);
+  layerTexCoordScale = vec2(1.0);
+  if (hasSpriteTexture) {
+    vec4 layerInfo = texelFetch(spriteLayerInfo, layer, 0);
+    layerTexCoordScale = layerInfo.xy;
+    aspectRatioScale = layerInfo.zw;
+  }
+
   dvec4 dpos = modelMatrix * dvec4(dvec3(pos.xyz), 1.0);
 
   float scaleMultiply = pow(10.0, scaleExponent);
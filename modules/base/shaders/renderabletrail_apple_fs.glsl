@@ -32,7 +32,7 @@ uniform vec3 color;
 uniform int renderPhase;
 uniform float opacity = 1.0;
 
-// Fragile! Keep in sync with RenderableTrail::render::RenderPhase
+// Fragile! Keep in sync with the RenderPhase enum in renderabletrail.cpp
 #define RenderPhaseLines 0
 #define RenderPhasePoints 1
 
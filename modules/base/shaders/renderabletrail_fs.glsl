@@ -35,7 +35,7 @@ uniform float opacity = 1.0;
 uniform float lineWidth;
 uniform vec4 viewport;
 
-// Fragile! Keep in sync with RenderableTrail::render::RenderPhase
+// Fragile! Keep in sync with the RenderPhase enum in renderabletrail.cpp
 const int RenderPhaseLines = 0;
 const int RenderPhasePoints = 1;
 
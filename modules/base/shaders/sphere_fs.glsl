@@ -32,6 +32,7 @@ in float vs_screenSpaceDepth;
 uniform sampler2D colorTexture;
 uniform float opacity;
 uniform bool mirrorTexture;
+uniform bool flipTexture = false;
 
 
 Fragment getFragment() {
@@ -41,6 +42,9 @@ Fragment getFragment() {
   if (mirrorTexture) {
     texCoord.x = 1.0 - texCoord.x;
   }
+  if (flipTexture) {
+    texCoord.y = 1.0 - texCoord.y;
+  }
 
   frag.color = texture(colorTexture, texCoord);
   frag.color.a *= opacity;
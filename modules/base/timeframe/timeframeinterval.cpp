@@ -28,6 +28,7 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
+#include <limits>
 #include <optional>
 
 namespace {
@@ -85,15 +86,39 @@ bool TimeFrameInterval::isActive(const Time& time) const {
     return true;
 }
 
+TimeFrame::Activity TimeFrameInterval::activity(double time) const {
+    constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+    // The activity only changes at the start and the end, so it stays the same until
+    // the next of these is crossed
+    const double start = _start;
+    const double end = _end;
+    if (_hasStart && time < start) {
+        return { .isActive = false, .validFrom = -Infinity, .validUntil = start };
+    }
+    if (_hasEnd && time >= end) {
+        return { .isActive = false, .validFrom = end, .validUntil = Infinity };
+    }
+    return {
+        .isActive = true,
+        .validFrom = _hasStart ? start : -Infinity,
+        .validUntil = _hasEnd ? end : Infinity
+    };
+}
+
 TimeFrameInterval::TimeFrameInterval()
     : _hasStart(HasStartInfo, false)
     , _start(StartInfo, 0, 0, 1E9)
     , _hasEnd(HasEndInfo, false)
     , _end(EndInfo, 0, 0, 1E9)
 {
+    _hasStart.onChange([]() { invalidateCaches(); });
     addProperty(_hasStart);
+    _start.onChange([]() { invalidateCaches(); });
     addProperty(_start);
+    _hasEnd.onChange([]() { invalidateCaches(); });
     addProperty(_hasEnd);
+    _end.onChange([]() { invalidateCaches(); });
     addProperty(_end);
 }
 
@@ -116,7 +141,9 @@ TimeFrameInterval::TimeFrameInterval(const ghoul::Dictionary& dictionary)
         }
     }
     _hasStart = p.start.has_value();
+    _hasStart.onChange([]() { invalidateCaches(); });
     addProperty(_hasStart);
+    _start.onChange([]() { invalidateCaches(); });
     addProperty(_start);
 
     if (p.end.has_value()) {
@@ -130,7 +157,9 @@ TimeFrameInterval::TimeFrameInterval(const ghoul::Dictionary& dictionary)
         }
     }
     _hasEnd = p.end.has_value();
+    _hasEnd.onChange([]() { invalidateCaches(); });
     addProperty(_hasEnd);
+    _end.onChange([]() { invalidateCaches(); });
     addProperty(_end);
 }
 
@@ -41,6 +41,7 @@ public:
     TimeFrameInterval();
     TimeFrameInterval(const ghoul::Dictionary& dictionary);
     bool isActive(const Time&) const override;
+    Activity activity(double time) const override;
 
     static documentation::Documentation Documentation();
 
@@ -29,6 +29,8 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
+#include <algorithm>
+#include <limits>
 
 namespace {
     constexpr openspace::properties::Property::PropertyInfo TimeFramesInfo = {
@@ -69,6 +71,24 @@ bool TimeFrameUnion::isActive(const Time& time) const {
     return false;
 }
 
+TimeFrame::Activity TimeFrameUnion::activity(double time) const {
+    constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+    // The union can only change when any of the contained time frames changes
+    Activity result = {
+        .isActive = false,
+        .validFrom = -Infinity,
+        .validUntil = Infinity
+    };
+    for (const ghoul::mm_unique_ptr<TimeFrame>& tf : _timeFrames) {
+        const Activity a = tf->activity(time);
+        result.isActive |= a.isActive;
+        result.validFrom = std::max(result.validFrom, a.validFrom);
+        result.validUntil = std::min(result.validUntil, a.validUntil);
+    }
+    return result;
+}
+
 TimeFrameUnion::TimeFrameUnion(const ghoul::Dictionary& dictionary) {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -38,6 +38,7 @@ public:
     TimeFrameUnion() = default;
     TimeFrameUnion(const ghoul::Dictionary& dictionary);
     bool isActive(const Time&) const override;
+    Activity activity(double time) const override;
 
     static documentation::Documentation Documentation();
 
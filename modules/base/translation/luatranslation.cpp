@@ -80,6 +80,10 @@ LuaTranslation::LuaTranslation(const ghoul::Dictionary& dictionary)
     _luaScriptFile = p.script.string();
 }
 
+std::vector<std::filesystem::path> LuaTranslation::sourceFiles() const {
+    return { absPath(_luaScriptFile.value()) };
+}
+
 glm::dvec3 LuaTranslation::position(const UpdateData& data) const {
     ghoul::lua::runScriptFile(_state, _luaScriptFile.value());
 
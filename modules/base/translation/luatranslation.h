@@ -43,6 +43,8 @@ public:
 
     glm::dvec3 position(const UpdateData& data) const override;
 
+    std::vector<std::filesystem::path> sourceFiles() const override;
+
     static documentation::Documentation Documentation();
 
 private:
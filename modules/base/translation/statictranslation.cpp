@@ -72,6 +72,10 @@ StaticTranslation::StaticTranslation(const ghoul::Dictionary& dictionary)
     _type = "StaticTranslation";
 }
 
+bool StaticTranslation::supportsParallelUpdate() const {
+    return true;
+}
+
 glm::dvec3 StaticTranslation::position(const UpdateData&) const {
     return _position;
 }
@@ -41,6 +41,7 @@ public:
     StaticTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    bool supportsParallelUpdate() const override;
     static documentation::Documentation Documentation();
 
 private:
@@ -62,15 +62,20 @@ TimelineTranslation::TimelineTranslation(const ghoul::Dictionary& dictionary)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
+    // The keyframes are sorted by their time strings rather than their times, so they
+    // are added all at once to only sort the timeline once
+    std::vector<std::pair<double, ghoul::mm_unique_ptr<Translation>>> keyframes;
+    keyframes.reserve(p.keyframes.size());
     for (const std::pair<const std::string, ghoul::Dictionary>& kf : p.keyframes) {
         const double t = Time::convertTime(kf.first);
 
         ghoul::mm_unique_ptr<Translation> translation =
             Translation::createFromDictionary(kf.second);
         if (translation) {
-            _timeline.addKeyframe(t, std::move(translation));
+            keyframes.emplace_back(t, std::move(translation));
         }
     }
+    _timeline.addKeyframes(std::move(keyframes));
 
     _shouldInterpolate = p.shouldInterpolate.value_or(_shouldInterpolate);
     addProperty(_shouldInterpolate);
@@ -24,7 +24,9 @@
 
 #include <modules/cefwebgui/include/guirenderhandler.h>
 
+#include <openspace/engine/globals.h>
 #include <openspace/engine/globalscallbacks.h>
+#include <openspace/rendering/renderengine.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/programobject.h>
@@ -41,7 +43,7 @@ GUIRenderHandler::GUIRenderHandler() {
     ghoul::Dictionary define;
     define.setValue("useAcceleratedRendering", _acceleratedRendering);
 
-    _programObject = ghoul::opengl::ProgramObject::Build(
+    _programObject = global::renderEngine->buildCachedProgram(
         "WebGUICEFProgram",
         absPath("${MODULE_CEFWEBGUI}/shaders/gui_vs.glsl"),
         absPath("${MODULE_CEFWEBGUI}/shaders/gui_fs.glsl"),
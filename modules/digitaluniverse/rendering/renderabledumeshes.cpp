@@ -298,12 +298,10 @@ void RenderableDUMeshes::initializeGL() {
 }
 
 void RenderableDUMeshes::deinitializeGL() {
-    for (const std::pair<const int, RenderingMesh>& pair : _renderingMeshesMap) {
-        for (int i = 0; i < pair.second.numU; i++) {
-            glDeleteVertexArrays(1, &pair.second.vaoArray[i]);
-            glDeleteBuffers(1, &pair.second.vboArray[i]);
-        }
-    }
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
 
     DigitalUniverseModule::ProgramObjectManager.release(
         "RenderableDUMeshes",
@@ -329,27 +327,25 @@ void RenderableDUMeshes::renderMeshes(const RenderData&,
     _program->setUniform(_uniformCache.projectionTransform, projectionMatrix);
     _program->setUniform(_uniformCache.alphaValue, opacity());
 
-    for (const std::pair<const int, RenderingMesh>& pair : _renderingMeshesMap) {
-        _program->setUniform(_uniformCache.color, _meshColorMap[pair.second.colorIndex]);
-        for (size_t i = 0; i < pair.second.vaoArray.size(); i++) {
-            glBindVertexArray(pair.second.vaoArray[i]);
-            switch (pair.second.style) {
-                case Solid:
-                    break;
-                case Wire:
-                    glLineWidth(_lineWidth);
-                    glDrawArrays(GL_LINE_STRIP, 0, pair.second.numV);
-                    global::renderEngine->openglStateCache().resetLineState();
-                    break;
-                case Point:
-                    glDrawArrays(GL_POINTS, 0, pair.second.numV);
-                    break;
-                default:
-                    break;
-            }
-        }
+    glBindVertexArray(_vao);
+    if (!_lineStrips.first.empty()) {
+        glLineWidth(_lineWidth);
+        glMultiDrawArrays(
+            GL_LINE_STRIP,
+            _lineStrips.first.data(),
+            _lineStrips.count.data(),
+            static_cast<GLsizei>(_lineStrips.first.size())
+        );
+        global::renderEngine->openglStateCache().resetLineState();
+    }
+    if (!_points.first.empty()) {
+        glMultiDrawArrays(
+            GL_POINTS,
+            _points.first.data(),
+            _points.count.data(),
+            static_cast<GLsizei>(_points.first.size())
+        );
     }
-
     glBindVertexArray(0);
     _program->deactivate();
 
@@ -616,123 +612,103 @@ void RenderableDUMeshes::createMeshes() {
     if (!(_dataIsDirty && _hasSpeckFile)) {
         return;
     }
-    LDEBUG("Creating planes");
-
-    for (std::pair<const int, RenderingMesh>& p : _renderingMeshesMap) {
-        for (int i = 0; i < p.second.numU; i++) {
-            GLuint vao = 0;
-            glGenVertexArrays(1, &vao);
-            p.second.vaoArray.push_back(vao);
-
-            GLuint vbo = 0;
-            glGenBuffers(1, &vbo);
-            p.second.vboArray.push_back(vbo);
-
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //glBufferData(GL_ARRAY_BUFFER, it->second.numV * sizeof(GLfloat),
-            glBufferData(
-                GL_ARRAY_BUFFER,
-                p.second.vertices.size() * sizeof(GLfloat),
-                p.second.vertices.data(),
-                GL_STATIC_DRAW
-            );
-            // in_position
-            glEnableVertexAttribArray(0);
-            // (2022-03-23, emmbr) This code was actually never used. We only read three
-            // values per line and did not handle any texture cooridnates, even if there
-            // would have been some in the file
-            //// U and V may not be given by the user
-            //if (p.second.vertices.size() / (p.second.numU * p.second.numV) > 3) {
-            //    glVertexAttribPointer(
-            //        0,
-            //        3,
-            //        GL_FLOAT,
-            //        GL_FALSE,
-            //        sizeof(GLfloat) * 5,
-            //        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * i * p.second.numV)
-            //    );
-
-            //    // texture coords
-            //    glEnableVertexAttribArray(1);
-            //    glVertexAttribPointer(
-            //        1,
-            //        2,
-            //        GL_FLOAT,
-            //        GL_FALSE,
-            //        sizeof(GLfloat) * 7,
-            //        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i * p.second.numV)
-            //    );
-            //}
-            //else { // no U and V:
-                glVertexAttribPointer(
-                    0,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    0,
-                    reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i * p.second.numV)
-                );
-            //}
+    LDEBUG("Creating meshes");
+
+    // Interleaved vertex layout: position (3 floats) followed by color (3 floats)
+    constexpr int VertexSize = 6;
+
+    std::vector<GLfloat> vertexData;
+    _lineStrips = DrawList();
+    _points = DrawList();
+
+    auto addVertex = [&vertexData](const std::vector<GLfloat>& vertices, int index,
+                                   const glm::vec3& color)
+    {
+        vertexData.push_back(vertices[3 * index]);
+        vertexData.push_back(vertices[3 * index + 1]);
+        vertexData.push_back(vertices[3 * index + 2]);
+        vertexData.push_back(color.r);
+        vertexData.push_back(color.g);
+        vertexData.push_back(color.b);
+    };
+
+    for (const std::pair<const int, RenderingMesh>& p : _renderingMeshesMap) {
+        const RenderingMesh& mesh = p.second;
+        if (mesh.style != Wire && mesh.style != Point) {
+            // Solid meshes have never been rendered
+            continue;
         }
 
-        // Grid: we need columns
-        if (p.second.numU > 1) {
-            for (int i = 0; i < p.second.numV; i++) {
-                GLuint cvao = 0;
-                glGenVertexArrays(1, &cvao);
-                p.second.vaoArray.push_back(cvao);
-
-                GLuint cvbo = 0;
-                glGenBuffers(1, &cvbo);
-                p.second.vboArray.push_back(cvbo);
-
-                glBindVertexArray(cvao);
-                glBindBuffer(GL_ARRAY_BUFFER, cvbo);
-                glBufferData(
-                    GL_ARRAY_BUFFER,
-                    p.second.vertices.size() * sizeof(GLfloat),
-                    p.second.vertices.data(),
-                    GL_STATIC_DRAW
-                );
-                // in_position
-                glEnableVertexAttribArray(0);
-                // U and V may not be given by the user
-                if (p.second.vertices.size() / (p.second.numU * p.second.numV) > 3) {
-                    glVertexAttribPointer(
-                        0,
-                        3,
-                        GL_FLOAT,
-                        GL_FALSE,
-                        p.second.numV * sizeof(GLfloat) * 5,
-                        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * i)
-                    );
-
-                    // texture coords
-                    glEnableVertexAttribArray(1);
-                    glVertexAttribPointer(
-                        1,
-                        2,
-                        GL_FLOAT,
-                        GL_FALSE,
-                        p.second.numV * sizeof(GLfloat) * 7,
-                        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i)
-                    );
-                }
-                else { // no U and V:
-                    glVertexAttribPointer(
-                        0,
-                        3,
-                        GL_FLOAT,
-                        GL_FALSE,
-                        p.second.numV * sizeof(GLfloat) * 3,
-                        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i)
-                    );
+        const int numU = mesh.numU;
+        const int numV = mesh.numV;
+        if (static_cast<int>(mesh.vertices.size()) < 3 * numU * numV) {
+            LWARNING(std::format(
+                "Mesh {} has fewer vertices than specified by its dimensions", p.first
+            ));
+            continue;
+        }
+
+        const glm::vec3 color = _meshColorMap[mesh.colorIndex];
+        DrawList& list = mesh.style == Wire ? _lineStrips : _points;
+
+        // Rows
+        for (int i = 0; i < numU; i++) {
+            list.first.push_back(static_cast<GLint>(vertexData.size() / VertexSize));
+            list.count.push_back(numV);
+            for (int j = 0; j < numV; j++) {
+                addVertex(mesh.vertices, i * numV + j, color);
+            }
+        }
+
+        // Grid: we need columns. These do not add any new points, so they are only
+        // needed when the grid is rendered as lines
+        if (mesh.style == Wire && numU > 1) {
+            for (int j = 0; j < numV; j++) {
+                list.first.push_back(static_cast<GLint>(vertexData.size() / VertexSize));
+                list.count.push_back(numU);
+                for (int i = 0; i < numU; i++) {
+                    addVertex(mesh.vertices, i * numV + j, color);
                 }
             }
         }
     }
 
+    if (_vao == 0) {
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vbo);
+    }
+
+    glBindVertexArray(_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        vertexData.size() * sizeof(GLfloat),
+        vertexData.data(),
+        GL_STATIC_DRAW
+    );
+
+    // in_position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        VertexSize * sizeof(GLfloat),
+        nullptr
+    );
+
+    // in_color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        VertexSize * sizeof(GLfloat),
+        reinterpret_cast<GLvoid*>(3 * sizeof(GLfloat))
+    );
+
     glBindVertexArray(0);
 
     _dataIsDirty = false;
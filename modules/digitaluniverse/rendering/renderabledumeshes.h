@@ -39,6 +39,7 @@
 #include <ghoul/opengl/uniformcache.h>
 #include <filesystem>
 #include <unordered_map>
+#include <vector>
 
 namespace ghoul::filesystem { class File; }
 namespace ghoul::fontrendering { class Font; }
@@ -90,11 +91,15 @@ private:
         int numU;
         int numV;
         MeshType style;
-        std::vector<GLuint> vaoArray;
-        std::vector<GLuint> vboArray;
         std::vector<GLfloat> vertices;
     };
 
+    /// Start vertex and vertex count for each strip in a glMultiDrawArrays call
+    struct DrawList {
+        std::vector<GLint> first;
+        std::vector<GLsizei> count;
+    };
+
     void createMeshes();
     void renderMeshes(const RenderData& data, const glm::dmat4& modelViewMatrix,
         const glm::dmat4& projectionMatrix);
@@ -121,8 +126,7 @@ private:
     properties::OptionProperty _renderOption;
 
     ghoul::opengl::ProgramObject* _program = nullptr;
-    UniformCache(modelViewTransform, projectionTransform, alphaValue,
-        color) _uniformCache;
+    UniformCache(modelViewTransform, projectionTransform, alphaValue) _uniformCache;
     std::shared_ptr<ghoul::fontrendering::Font> _font = nullptr;
 
     std::filesystem::path _speckFile;
@@ -135,6 +139,13 @@ private:
 
     std::unordered_map<int, glm::vec3> _meshColorMap;
     std::unordered_map<int, RenderingMesh> _renderingMeshesMap;
+
+    // All meshes are packed into a single vertex buffer with interleaved positions and
+    // colors so that each primitive type can be rendered with a single draw call
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    DrawList _lineStrips;
+    DrawList _points;
 };
 } // namespace openspace
 
@@ -24,10 +24,10 @@
 
 #include "fragment.glsl"
 
+in vec3 vs_color;
 in float vs_screenSpaceDepth;
 in vec4 vs_positionViewSpace;
 
-uniform vec3 color;
 uniform float alphaValue;
 
 
@@ -38,7 +38,7 @@ Fragment getFragment() {
     discard;
   }
 
-  frag.color = vec4(color, alphaValue);
+  frag.color = vec4(vs_color, alphaValue);
   frag.depth = vs_screenSpaceDepth;
 
   // JCC: Need to change the position to camera space
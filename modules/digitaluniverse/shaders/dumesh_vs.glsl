@@ -26,8 +26,10 @@
 
 #include "PowerScaling/powerScaling_vs.hglsl"
 
-in vec3 in_position;
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_color;
 
+out vec3 vs_color;
 out float vs_screenSpaceDepth;
 out vec4 vs_positionViewSpace;
 
@@ -40,6 +42,7 @@ void main() {
   vec4 positionClipSpace   = vec4(projectionTransform * positionViewSpace);
   vec4 positionScreenSpace = vec4(z_normalization(positionClipSpace));
 
+  vs_color = in_color;
   vs_screenSpaceDepth  = positionScreenSpace.w;
   vs_positionViewSpace = vec4(positionViewSpace);
 
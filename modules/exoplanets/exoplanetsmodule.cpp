@@ -44,6 +44,8 @@
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/misc/stringhelper.h>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -265,6 +267,7 @@ ExoplanetsModule::ExoplanetsModule()
                 f, _exoplanetsDataFolder.identifier()
             ));
         }
+        _lookUpTable = std::nullopt;
     });
     addProperty(_exoplanetsDataFolder);
 
@@ -330,6 +333,40 @@ std::filesystem::path ExoplanetsModule::lookUpTablePath() const {
     );
 }
 
+const ExoplanetsModule::LookUpTable& ExoplanetsModule::lookUpTable() const {
+    if (_lookUpTable.has_value()) {
+        return *_lookUpTable;
+    }
+
+    const std::filesystem::path lutPath = lookUpTablePath();
+    std::ifstream lut(lutPath);
+    if (!lut.good()) {
+        throw ghoul::RuntimeError(std::format(
+            "Failed to open exoplanets look-up table '{}'", lutPath
+        ));
+    }
+
+    LookUpTable table;
+    std::string line;
+    while (ghoul::getline(lut, line)) {
+        std::istringstream ss(line);
+        std::string name;
+        ghoul::getline(ss, name, ',');
+        std::string location;
+        ghoul::getline(ss, location);
+        if (name.size() < 2 || location.empty()) {
+            continue;
+        }
+
+        // The last two characters specify the planet component of the host star
+        std::string host = name.substr(0, name.size() - 2);
+        table[std::move(host)].push_back({ std::move(name), std::stol(location) });
+    }
+
+    _lookUpTable = std::move(table);
+    return *_lookUpTable;
+}
+
 std::filesystem::path ExoplanetsModule::teffToBvConversionFilePath() const {
     ghoul_assert(hasDataFiles(), "Data files not loaded");
 
@@ -33,6 +33,11 @@
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace openspace {
 
@@ -40,12 +45,27 @@ class ExoplanetsModule : public OpenSpaceModule {
 public:
     constexpr static const char* Name = "Exoplanets";
 
+    /// The location of a single planet's data entry in the binary data file
+    struct PlanetLocation {
+        std::string name;
+        long location = 0;
+    };
+    /// Maps the name of each host star to the planets in its system
+    using LookUpTable = std::map<std::string, std::vector<PlanetLocation>, std::less<>>;
+
     ExoplanetsModule();
     ~ExoplanetsModule() override = default;
 
     bool hasDataFiles() const;
     std::filesystem::path exoplanetsDataPath() const;
     std::filesystem::path lookUpTablePath() const;
+
+    /**
+     * Returns the contents of the look-up table file, grouped by host star. The file is
+     * only read the first time this function is called after the data folder has been
+     * changed.
+     */
+    const LookUpTable& lookUpTable() const;
     std::filesystem::path teffToBvConversionFilePath() const;
     std::filesystem::path bvColormapPath() const;
     std::filesystem::path starTexturePath() const;
@@ -85,6 +105,8 @@ protected:
     properties::BoolProperty _useOptimisticZone;
 
     properties::FloatProperty _habitableZoneOpacity;
+
+    mutable std::optional<LookUpTable> _lookUpTable;
 };
 
 } // namespace openspace
@@ -37,6 +37,17 @@ namespace {
 
 constexpr std::string_view _loggerCat = "ExoplanetsModule";
 
+const openspace::ExoplanetsModule::LookUpTable& lookUpTable(
+                                           const openspace::ExoplanetsModule& module)
+{
+    try {
+        return module.lookUpTable();
+    }
+    catch (const ghoul::RuntimeError& e) {
+        throw ghoul::lua::LuaError(e.message);
+    }
+}
+
 openspace::exoplanets::ExoplanetSystem findSystemInData(std::string_view starName) {
     using namespace openspace;
     using namespace exoplanets;
@@ -51,37 +62,24 @@ openspace::exoplanets::ExoplanetSystem findSystemInData(std::string_view starNam
         ));
     }
 
-    const std::filesystem::path lutPath = module->lookUpTablePath();
-    std::ifstream lut(absPath(lutPath));
-    if (!lut.good()) {
-        throw ghoul::lua::LuaError(std::format(
-            "Failed to open exoplanets look-up table '{}'", lutPath
-        ));
-    }
-
     ExoplanetSystem system;
 
-    // 1. search lut for the starname and return the corresponding location
-    // 2. go to that location in the data file
+    // 1. look up the planets of the star and their locations in the data file
+    // 2. go to each location in the data file
     // 3. read sizeof(exoplanet) bytes into an exoplanet object.
-    ExoplanetDataEntry p;
-    std::string line;
-    while (ghoul::getline(lut, line)) {
-        std::istringstream ss(line);
-        std::string name;
-        ghoul::getline(ss, name, ',');
-
-        if (name.substr(0, name.length() - 2) != starName) {
-            continue;
-        }
-
-        std::string location_s;
-        ghoul::getline(ss, location_s);
-        long location = std::stol(location_s.c_str());
+    const ExoplanetsModule::LookUpTable& lut = lookUpTable(*module);
+    auto it = lut.find(starName);
+    if (it == lut.end()) {
+        system.starName = starName;
+        return system;
+    }
 
-        data.seekg(location);
+    ExoplanetDataEntry p;
+    for (const ExoplanetsModule::PlanetLocation& planet : it->second) {
+        data.seekg(planet.location);
         data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
 
+        std::string name = planet.name;
         sanitizeNameString(name);
 
         if (!hasSufficientData(p)) {
@@ -109,57 +107,33 @@ std::vector<std::string> hostStarsWithSufficientData() {
         throw ghoul::lua::LuaError("No data path was configured for the exoplanets");
     }
 
-    const std::filesystem::path lutPath = module->lookUpTablePath();
-    std::ifstream lookupTableFile(absPath(lutPath));
-    if (!lookupTableFile.good()) {
-        throw ghoul::lua::LuaError(std::format(
-            "Failed to open lookup table file '{}'", lutPath
-        ));
-    }
-
     const std::filesystem::path binPath = module->exoplanetsDataPath();
     std::ifstream data(absPath(binPath), std::ios::in | std::ios::binary);
     if (!data.good()) {
         throw ghoul::lua::LuaError(std::format("Failed to open data file '{}'", binPath));
     }
 
-    std::vector<std::string> names;
-    std::string line;
+    const ExoplanetsModule::LookUpTable& lut = lookUpTable(*module);
 
-    // Read number of lines
-    int nExoplanets = 0;
-    while (ghoul::getline(lookupTableFile, line)) {
-        ++nExoplanets;
-    }
-    lookupTableFile.clear();
-    lookupTableFile.seekg(0);
-    names.reserve(nExoplanets);
+    std::vector<std::string> names;
+    names.reserve(lut.size());
 
     ExoplanetDataEntry p;
-    while (ghoul::getline(lookupTableFile, line)) {
-        std::stringstream ss(line);
-        std::string name;
-        ghoul::getline(ss, name, ',');
-        // Remove the last two characters, that specify the planet
-        name = name.substr(0, name.size() - 2);
-
+    for (const auto& [host, planets] : lut) {
         // Don't want to list systems where there is not enough data to visualize.
         // So, test if there is before adding the name to the list.
-        std::string location_s;
-        ghoul::getline(ss, location_s);
-        long location = std::stol(location_s.c_str());
-
-        data.seekg(location);
-        data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
-
-        if (hasSufficientData(p)) {
-            names.push_back(name);
+        for (const ExoplanetsModule::PlanetLocation& planet : planets) {
+            data.seekg(planet.location);
+            data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
+
+            if (hasSufficientData(p)) {
+                names.push_back(host);
+                break;
+            }
         }
     }
 
-    // For easier read, sort by names and remove duplicates
-    std::sort(names.begin(), names.end());
-    names.erase(std::unique(names.begin(), names.end()), names.end());
+    // The look-up table is sorted by host name and each host is only added once
     return names;
 }
 
@@ -284,8 +258,10 @@ listOfExoplanetsDeprecated()
         ExoplanetsDataPreparationTask::readFirstDataRow(inputDataFile);
 
     const ExoplanetsModule* module = global::moduleEngine->module<ExoplanetsModule>();
-    const std::filesystem::path
-        teffBvConversionPath = module->teffToBvConversionFilePath();
+    const ExoplanetsDataPreparationTask::TeffToBvTable teffToBv =
+        ExoplanetsDataPreparationTask::readTeffToBvTable(
+            module->teffToBvConversionFilePath()
+        );
 
     std::map<std::string, ExoplanetSystem> hostNameToSystemDataMap;
 
@@ -297,8 +273,8 @@ listOfExoplanetsDeprecated()
         PlanetData planetData = ExoplanetsDataPreparationTask::parseDataRow(
             row,
             columnNames,
-            "",
-            module->teffToBvConversionFilePath()
+            ExoplanetsDataPreparationTask::StarPositions(),
+            teffToBv
         );
 
         if (!hasSufficientData(planetData.dataEntry)) {
@@ -34,9 +34,13 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/misc/stringhelper.h>
+#include <algorithm>
+#include <atomic>
 #include <charconv>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "ExoplanetsDataPreparationTask";
@@ -144,33 +148,43 @@ void ExoplanetsDataPreparationTask::perform(
     // later access
     const std::vector<std::string> columnNames = readFirstDataRow(inputDataFile);
 
-    // Read total number of items
-    int total = 0;
+    // Read all rows so that they can be parsed in parallel
+    std::vector<std::string> rows;
     std::string row;
     while (ghoul::getline(inputDataFile, row)) {
-        ++total;
+        rows.push_back(std::move(row));
     }
-    inputDataFile.clear();
-    inputDataFile.seekg(0);
-
-    // The reading is restarted, so we need to read past the first line,
-    // containing the data names, again
-    readFirstDataRow(inputDataFile);
+    const size_t total = rows.size();
 
     LINFO(std::format("Loading {} exoplanets", total));
 
-    int exoplanetCount = 0;
-    while (ghoul::getline(inputDataFile, row)) {
-        ++exoplanetCount;
-        progressCallback(static_cast<float>(exoplanetCount) / static_cast<float>(total));
-
-        PlanetData planetData = parseDataRow(
-            row,
-            columnNames,
-            _inputSpeckPath,
-            _teffToBvFilePath
-        );
+    // The star positions and the color conversion are read once, instead of searching
+    // through the files for every row
+    const StarPositions starPositions = readStarPositions(_inputSpeckPath);
+    const TeffToBvTable teffToBv = readTeffToBvTable(_teffToBvFilePath);
+
+    std::vector<PlanetData> planets = std::vector<PlanetData>(total);
+    std::atomic_size_t nParsed = 0;
+    const size_t nThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<std::future<void>> futures;
+    futures.reserve(nThreads);
+    for (size_t t = 0; t < nThreads; t++) {
+        futures.push_back(std::async(std::launch::async, [&, t]() {
+            for (size_t i = t; i < total; i += nThreads) {
+                planets[i] = parseDataRow(rows[i], columnNames, starPositions, teffToBv);
+                nParsed++;
+            }
+        }));
+    }
+    for (std::future<void>& f : futures) {
+        using namespace std::chrono_literals;
+        while (f.wait_for(100ms) != std::future_status::ready) {
+            progressCallback(static_cast<float>(nParsed) / static_cast<float>(total));
+        }
+    }
 
+    // The output is written in the order of the input file
+    for (PlanetData& planetData : planets) {
         // Create look-up table
         const long pos = static_cast<long>(binFile.tellp());
         const std::string planetName = planetData.host + " " + planetData.component;
@@ -214,6 +228,20 @@ ExoplanetsDataPreparationTask::parseDataRow(const std::string& row,
                                             const std::vector<std::string>& columnNames,
                                           const std::filesystem::path& positionSourceFile,
                                     const std::filesystem::path& bvFromTeffConversionFile)
+{
+    return parseDataRow(
+        row,
+        columnNames,
+        readStarPositions(positionSourceFile),
+        readTeffToBvTable(bvFromTeffConversionFile)
+    );
+}
+
+ExoplanetsDataPreparationTask::PlanetData
+ExoplanetsDataPreparationTask::parseDataRow(const std::string& row,
+                                            const std::vector<std::string>& columnNames,
+                                                  const StarPositions& starPositions,
+                                                       const TeffToBvTable& teffToBv)
 {
     auto readFloatData = [](const std::string& str) -> float {
 #ifdef WIN32
@@ -354,7 +382,7 @@ ExoplanetsDataPreparationTask::parseDataRow(const std::string& row,
         // Star - name and position
         else if (column == "hostname") {
             starName = readStringData(data);
-            glm::vec3 position = starPosition(starName, positionSourceFile);
+            glm::vec3 position = starPosition(starName, starPositions);
             p.positionX = position[0];
             p.positionY = position[1];
             p.positionZ = position[2];
@@ -382,7 +410,7 @@ ExoplanetsDataPreparationTask::parseDataRow(const std::string& row,
         // (B-V color index computed from star's effective temperature)
         else if (column == "st_teff") {
             p.teff = readFloatData(data);
-            p.bmv = bvFromTeff(p.teff, bvFromTeffConversionFile);
+            p.bmv = bvFromTeff(p.teff, teffToBv);
         }
         else if (column == "st_tefferr1") {
             p.teffUpper = readFloatData(data);
@@ -442,14 +470,14 @@ ExoplanetsDataPreparationTask::parseDataRow(const std::string& row,
     };
 }
 
-glm::vec3 ExoplanetsDataPreparationTask::starPosition(const std::string& starName,
-                                                  const std::filesystem::path& sourceFile)
+ExoplanetsDataPreparationTask::StarPositions
+ExoplanetsDataPreparationTask::readStarPositions(const std::filesystem::path& sourceFile)
 {
-    glm::vec3 position = glm::vec3(std::numeric_limits<float>::quiet_NaN());
+    StarPositions positions;
 
     if (sourceFile.empty()) {
-        // No file specified => return NaN position
-        return position;
+        // No file specified => no positions
+        return positions;
     }
 
     std::ifstream exoplanetsFile(sourceFile);
@@ -475,42 +503,35 @@ glm::vec3 ExoplanetsDataPreparationTask::starPosition(const std::string& starNam
         ghoul::getline(linestream, name);
         name.erase(0, 1);
 
+        glm::vec3 position;
         std::string coord;
-        if (name == starName) {
-            std::stringstream dataStream(data);
-            ghoul::getline(dataStream, coord, ' ');
-            position[0] = std::stof(coord, nullptr);
-            ghoul::getline(dataStream, coord, ' ');
-            position[1] = std::stof(coord, nullptr);
-            ghoul::getline(dataStream, coord, ' ');
-            position[2] = std::stof(coord, nullptr);
-            break;
-        }
+        std::stringstream dataStream(data);
+        ghoul::getline(dataStream, coord, ' ');
+        position[0] = std::stof(coord, nullptr);
+        ghoul::getline(dataStream, coord, ' ');
+        position[1] = std::stof(coord, nullptr);
+        ghoul::getline(dataStream, coord, ' ');
+        position[2] = std::stof(coord, nullptr);
+
+        // Only the first occurrence of a name is used, same as when searching the file
+        positions.emplace(std::move(name), position);
     }
 
-    return position;
+    return positions;
 }
 
-float ExoplanetsDataPreparationTask::bvFromTeff(float teff,
+ExoplanetsDataPreparationTask::TeffToBvTable
+ExoplanetsDataPreparationTask::readTeffToBvTable(
                                               const std::filesystem::path& conversionFile)
 {
-    if (std::isnan(teff)) {
-        return std::numeric_limits<float>::quiet_NaN();
-    }
+    TeffToBvTable table;
 
     std::ifstream teffToBvFile(conversionFile);
     if (!teffToBvFile.good()) {
         LERROR(std::format("Failed to open file '{}'", conversionFile));
-        return std::numeric_limits<float>::quiet_NaN();
+        return table;
     }
 
-    // Find the line in the file that most closely corresponds to the specified teff,
-    // and finally interpolate the value
-    float bv = 0.f;
-    float bvUpper = 0.f;
-    float bvLower = 0.f;
-    float teffLower = 0.f;
-    float teffUpper = 0.f;
     std::string row;
     while (ghoul::getline(teffToBvFile, row)) {
         std::istringstream lineStream(row);
@@ -519,28 +540,48 @@ float ExoplanetsDataPreparationTask::bvFromTeff(float teff,
         std::string bvString;
         ghoul::getline(lineStream, bvString);
 
-        const float teffCurrent = std::stof(teffString, nullptr);
-        const float bvCurrent = std::stof(bvString, nullptr);
+        table.emplace_back(std::stof(teffString, nullptr), std::stof(bvString, nullptr));
+    }
+    return table;
+}
 
-        if (teff > teffCurrent) {
-            teffLower = teffCurrent;
-            bvLower = bvCurrent;
-        }
-        else {
-            teffUpper = teffCurrent;
-            bvUpper = bvCurrent;
-            if (bvLower == 0.f) {
-                bv = 2.f;
-            }
-            else {
-                const float bvDiff = (bvUpper - bvLower);
-                const float teffDiff = (teffUpper - teffLower);
-                bv = ((bvDiff * (teff - teffLower)) / teffDiff) + bvLower;
-            }
-            break;
-        }
+glm::vec3 ExoplanetsDataPreparationTask::starPosition(const std::string& starName,
+                                                     const StarPositions& starPositions)
+{
+    auto it = starPositions.find(starName);
+    return it != starPositions.end() ?
+        it->second :
+        glm::vec3(std::numeric_limits<float>::quiet_NaN());
+}
+
+float ExoplanetsDataPreparationTask::bvFromTeff(float teff, const TeffToBvTable& teffToBv)
+{
+    if (std::isnan(teff) || teffToBv.empty()) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    // Find the line in the table that most closely corresponds to the specified teff,
+    // and finally interpolate the value
+    auto upper = std::find_if(
+        teffToBv.begin(),
+        teffToBv.end(),
+        [teff](const std::pair<float, float>& entry) { return teff <= entry.first; }
+    );
+    if (upper == teffToBv.end()) {
+        return 0.f;
     }
-    return bv;
+
+    const auto [teffLower, bvLower] = upper == teffToBv.begin() ?
+        std::pair<float, float>(0.f, 0.f) :
+        *std::prev(upper);
+    const auto [teffUpper, bvUpper] = *upper;
+    if (bvLower == 0.f) {
+        return 2.f;
+    }
+
+    const float bvDiff = (bvUpper - bvLower);
+    const float teffDiff = (teffUpper - teffLower);
+    return ((bvDiff * (teff - teffLower)) / teffDiff) + bvLower;
 }
 
 } // namespace openspace::exoplanets
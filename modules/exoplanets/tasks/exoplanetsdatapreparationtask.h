@@ -31,6 +31,9 @@
 #include <openspace/properties/vector/vec3property.h>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace openspace::exoplanets {
 
@@ -43,6 +46,12 @@ public:
         ExoplanetDataEntry dataEntry;
     };
 
+    /// Maps the names of stars to their positions in galactic XYZ
+    using StarPositions = std::unordered_map<std::string, glm::vec3>;
+
+    /// Pairs of effective temperature and the corresponding B-V color index
+    using TeffToBvTable = std::vector<std::pair<float, float>>;
+
     ExoplanetsDataPreparationTask(const ghoul::Dictionary& dictionary);
     std::string description() override;
     void perform(const Task::ProgressCallback& progressCallback) override;
@@ -81,6 +90,41 @@ public:
         const std::filesystem::path& positionSourceFile,
         const std::filesystem::path& bvFromTeffConversionFile);
 
+    /**
+     * Parse a row in the CSV file of exoplanets, using star positions and a B-V
+     * conversion table that have already been loaded with #readStarPositions and
+     * #readTeffToBvTable. This function does not access any files and can be called
+     * concurrently for multiple rows.
+     *
+     * \param row The row to parse, given as a string
+     * \param columnNames The list of column names in the file, from the CSV header
+     * \param starPositions The star positions to use for the host star. If the host star
+     *        is not part of these positions, the position from the CSV data is used
+     * \param teffToBv The table used to convert the effective temperature to B-V
+     * \return An object containing the parsed information
+     */
+    static PlanetData parseDataRow(const std::string& row,
+        const std::vector<std::string>& columnNames, const StarPositions& starPositions,
+        const TeffToBvTable& teffToBv);
+
+    /**
+     * Reads the positions of all stars in the provided SPECK file, identified by the
+     * name given in the comment of each line. If the \p sourceFile is empty, the result
+     * is empty.
+     *
+     * \param sourceFile The SPECK file to read
+     * \return The star positions, given in galactic XYZ
+     */
+    static StarPositions readStarPositions(const std::filesystem::path& sourceFile);
+
+    /**
+     * Reads a conversion file where each line has the format 'teff,bv'.
+     *
+     * \param conversionFile The file to read
+     * \return The pairs of effective temperature and B-V value in the file order
+     */
+    static TeffToBvTable readTeffToBvTable(const std::filesystem::path& conversionFile);
+
 private:
     std::filesystem::path _inputDataPath;
     std::filesystem::path _inputSpeckPath;
@@ -89,18 +133,18 @@ private:
     std::filesystem::path _teffToBvFilePath;
 
     /**
-     * Try to find the star position from an input speck file. If not found, the
-     * returned position will contain NaN values.
+     * Try to find the star position in the positions read from an input speck file. If
+     * not found, the returned position will contain NaN values.
      *
-     * \param starName The name of the star to look for in the file
-     * \param sourceFile The name of the file in which to look
+     * \param starName The name of the star to look for
+     * \param starPositions The positions in which to look
      * \return The resulting star position, given in galactix XYZ
      */
     static glm::vec3 starPosition(const std::string& starName,
-        const std::filesystem::path& sourceFile);
+        const StarPositions& starPositions);
 
-    // Compute b-v color from teff value using a conversion file
-    static float bvFromTeff(float teff, const std::filesystem::path& conversionFile);
+    // Compute b-v color from teff value using a conversion table
+    static float bvFromTeff(float teff, const TeffToBvTable& teffToBv);
 };
 
 } // namespace openspace::exoplanets
@@ -40,15 +40,21 @@
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <map>
 #include <optional>
+#include <span>
 #include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderableFieldlinesSequence";
 
+    // The number of worker threads that load the states for 'runtime-states'
+    constexpr size_t NumberOfLoaderThreads = 2;
+
     constexpr openspace::properties::Property::PropertyInfo ColorMethodInfo = {
         "ColorMethod",
         "Color Method",
@@ -220,6 +226,10 @@ namespace {
         // Set to true if you are streaming data during runtime
         std::optional<bool> loadAtRuntime;
 
+        // The number of states that are loaded ahead of time in the direction of the
+        // playback if 'LoadAtRuntime' is enabled. Defaults to 6
+        std::optional<int> prefetchedStates [[codegen::greater(0)]];
+
         // [[codegen::verbatim(ColorUniformInfo.description)]]
         std::optional<glm::vec4> color [[codegen::color()]];
 
@@ -473,6 +483,9 @@ RenderableFieldlinesSequence::RenderableFieldlinesSequence(
         LWARNING("Load at run time is only supported for osfls file type");
         _loadingStatesDynamically = false;
     }
+    // Additional slots are needed for the states that are still being loaded by the
+    // worker threads when they are no longer requested
+    _prefetchedStates.resize(p.prefetchedStates.value_or(6) + NumberOfLoaderThreads);
 
     if (p.maskingRanges.has_value()) {
         _maskingRanges = *p.maskingRanges;
@@ -548,10 +561,20 @@ void RenderableFieldlinesSequence::initializeGL() {
     setModelDependentConstants();
     setupProperties();
 
+    // The buffers are sized to the largest state so that switching between states never
+    // has to reallocate them. For 'runtime-states' only the headers of the files are read
+    size_t maxPoints = 0;
+    if (_loadingStatesDynamically) {
+        for (const std::string& file : _sourceFiles) {
+            maxPoints = std::max(maxPoints, FieldlinesState::vertexCountFromOsfls(file));
+        }
+    }
+    for (const FieldlinesState& state : _states) {
+        maxPoints = std::max(maxPoints, state.vertexPositions().size());
+    }
+
     glGenVertexArrays(1, &_vertexArrayObject);
-    glGenBuffers(1, &_vertexPositionBuffer);
-    glGenBuffers(1, &_vertexColorBuffer);
-    glGenBuffers(1, &_vertexMaskingBuffer);
+    allocateBuffers(maxPoints);
 
     // Needed for additive blending
     setRenderBin(Renderable::RenderBin::Overlay);
@@ -585,7 +608,7 @@ bool RenderableFieldlinesSequence::loadJsonStatesIntoRAM() {
 bool RenderableFieldlinesSequence::prepareForOsflsStreaming() {
     extractTriggerTimesFromFileNames();
     FieldlinesState newState;
-    if (!newState.loadStateFromOsfls(_sourceFiles[0])) {
+    if (!newState.mapStateFromOsfls(_sourceFiles[0])) {
         LERROR("The provided .osfls files seem to be corrupt");
         return false;
     }
@@ -596,13 +619,178 @@ bool RenderableFieldlinesSequence::prepareForOsflsStreaming() {
         _loadingStatesDynamically = false;
     }
     _activeStateIndex = 0;
+    _loadedStateIndex = 0;
+    if (_loadingStatesDynamically) {
+        startLoaderThreads();
+    }
+    return true;
+}
+
+void RenderableFieldlinesSequence::startLoaderThreads() {
+    _shouldStopLoading = false;
+    for (size_t i = 0; i < NumberOfLoaderThreads; i++) {
+        _loaderThreads.emplace_back([this]() { loadRequestedStates(); });
+    }
+}
+
+void RenderableFieldlinesSequence::stopLoaderThreads() {
+    {
+        const std::lock_guard lock(_loadMutex);
+        _shouldStopLoading = true;
+    }
+    _loadCondition.notify_all();
+    for (std::thread& thread : _loaderThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    _loaderThreads.clear();
+}
+
+void RenderableFieldlinesSequence::loadRequestedStates() {
+    auto isPrefetched = [this](int index) {
+        return std::any_of(
+            _prefetchedStates.begin(),
+            _prefetchedStates.end(),
+            [index](const PrefetchedState& s) { return s.index == index; }
+        );
+    };
+    auto isRequested = [this](int index) {
+        return std::find(_requestedStates.begin(), _requestedStates.end(), index) !=
+            _requestedStates.end();
+    };
+    auto nextMissingState = [this, &isPrefetched]() {
+        return std::find_if(
+            _requestedStates.begin(),
+            _requestedStates.end(),
+            [&isPrefetched](int index) { return !isPrefetched(index); }
+        );
+    };
+    // Slots that hold a state that is no longer requested are reused
+    auto freeSlot = [this, &isRequested]() {
+        return std::find_if(
+            _prefetchedStates.begin(),
+            _prefetchedStates.end(),
+            [&isRequested](const PrefetchedState& s) {
+                return !s.isLoading && (s.index == -1 || !isRequested(s.index));
+            }
+        );
+    };
+
+    while (true) {
+        PrefetchedState* slot = nullptr;
+        {
+            std::unique_lock lock(_loadMutex);
+            _loadCondition.wait(
+                lock,
+                [&]() {
+                    return _shouldStopLoading ||
+                        (nextMissingState() != _requestedStates.end() &&
+                        freeSlot() != _prefetchedStates.end());
+                }
+            );
+            if (_shouldStopLoading) {
+                return;
+            }
+
+            slot = &*freeSlot();
+            slot->index = *nextMissingState();
+            slot->isLoading = true;
+        }
+
+        // The slot is not accessed by the main thread or the other workers while it is
+        // being loaded, so the state can be loaded without holding the lock
+        FieldlinesState state;
+        const bool success = state.mapStateFromOsfls(_sourceFiles[slot->index]);
+
+        {
+            const std::lock_guard lock(_loadMutex);
+            slot->isLoading = false;
+            if (success) {
+                slot->state = std::move(state);
+            }
+            else {
+                // The state is no longer requested so that it is not loaded over and over
+                LWARNING(std::format(
+                    "Failed to load state from '{}'", _sourceFiles[slot->index]
+                ));
+                std::erase(_requestedStates, slot->index);
+                slot->index = -1;
+            }
+        }
+        // Another worker might be waiting for a free slot
+        _loadCondition.notify_all();
+    }
+}
+
+void RenderableFieldlinesSequence::requestStates(double currentTime, double frameDelta) {
+    const bool isForward = frameDelta >= 0.0;
+    if (_activeTriggerTimeIndex == _requestedStateIndex &&
+        isForward == _requestedForward)
+    {
+        return;
+    }
+    _requestedStateIndex = _activeTriggerTimeIndex;
+    _requestedForward = isForward;
+
+    // If the time advances by more than one state per frame, the states in between are
+    // never shown, so the prefetching follows the speed of the playback instead
+    const double stateDuration =
+        (_startTimes.back() - _startTimes.front()) / static_cast<double>(_nStates - 1);
+    const double step =
+        std::max(std::abs(frameDelta), stateDuration) * (isForward ? 1.0 : -1.0);
+    const size_t nRequested = _prefetchedStates.size() - NumberOfLoaderThreads;
+
+    std::vector<int> requested;
+    requested.reserve(nRequested);
+    requested.push_back(_activeTriggerTimeIndex);
+    double time = currentTime;
+    while (requested.size() < nRequested) {
+        time += step;
+        if (time < _startTimes.front() || time >= _sequenceEndTime) {
+            break;
+        }
+        auto it = std::upper_bound(_startTimes.begin(), _startTimes.end(), time);
+        const int index = static_cast<int>(std::distance(_startTimes.begin(), it)) - 1;
+        if (index != requested.back()) {
+            requested.push_back(index);
+        }
+    }
+
+    {
+        const std::lock_guard lock(_loadMutex);
+        _requestedStates = std::move(requested);
+    }
+    _loadCondition.notify_all();
+}
+
+bool RenderableFieldlinesSequence::swapInPrefetchedState(int index) {
+    {
+        const std::lock_guard lock(_loadMutex);
+        auto it = std::find_if(
+            _prefetchedStates.begin(),
+            _prefetchedStates.end(),
+            [index](const PrefetchedState& s) { return s.index == index && !s.isLoading; }
+        );
+        if (it == _prefetchedStates.end()) {
+            return false;
+        }
+
+        // The previously rendered state is kept, as it might be needed again when the
+        // user steps back in time
+        std::swap(_states[0], it->state);
+        it->index = _loadedStateIndex;
+        _loadedStateIndex = index;
+    }
+    // The previous state might no longer be requested, which frees up its slot
+    _loadCondition.notify_all();
     return true;
 }
 
 void RenderableFieldlinesSequence::loadOsflsStatesIntoRAM() {
     for (const std::string& filePath : _sourceFiles) {
         FieldlinesState newState;
-        if (newState.loadStateFromOsfls(filePath)) {
+        if (newState.mapStateFromOsfls(filePath)) {
             addStateToSequence(newState);
             if (!_outputFolderPath.empty()) {
                 newState.saveStateToJson(
@@ -817,11 +1005,35 @@ bool RenderableFieldlinesSequence::getStatesFromCdfFiles() {
         return false;
     }
 
-    for (const std::string& cdfPath : _sourceFiles) {
+    // Opening a file is bound by the disk while tracing its lines is bound by the
+    // processor, so the next file is opened in the background while the current one is
+    // traced
+    auto loadFile = [this](size_t i) {
+        return std::async(
+            std::launch::async,
+            &fls::loadCdfFile,
+            _sourceFiles[i],
+            _tracingVariable
+        );
+    };
+    std::future<std::shared_ptr<ccmc::Kameleon>> nextFile;
+    if (!_sourceFiles.empty()) {
+        nextFile = loadFile(0);
+    }
+
+    for (size_t i = 0; i < _sourceFiles.size(); i++) {
+        const std::shared_ptr<ccmc::Kameleon> kameleon = nextFile.get();
+        if (i + 1 < _sourceFiles.size()) {
+            nextFile = loadFile(i + 1);
+        }
+        if (!kameleon) {
+            continue;
+        }
+
         FieldlinesState newState;
         bool isSuccessful = fls::convertCdfToFieldlinesState(
             newState,
-            cdfPath,
+            kameleon.get(),
             seedsPerFiles,
             _manualTimeOffset,
             _tracingVariable,
@@ -952,15 +1164,8 @@ void RenderableFieldlinesSequence::deinitializeGL() {
         _shaderProgram = nullptr;
     }
 
-    // Stall main thread until thread that's loading states is done
-    bool printedWarning = false;
-    while (_isLoadingStateFromDisk) {
-        if (!printedWarning) {
-            LWARNING("Trying to destroy class when an active thread is still using it");
-            printedWarning = true;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
-    }
+    // Stall main thread until the threads that are loading states are done
+    stopLoaderThreads();
 }
 
 bool RenderableFieldlinesSequence::isReady() const {
@@ -1054,9 +1259,6 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
     if (_shaderProgram->isDirty()) {
         _shaderProgram->rebuildFromFile();
     }
-    // True if new 'runtime-state' must be loaded from disk.
-    // False => the previous frame's state should still be shown
-    bool mustLoadNewStateFromDisk = false;
     // True if new 'in-RAM-state'  must be loaded.
     // False => the previous frame's state should still be shown
     bool needUpdate = false;
@@ -1077,14 +1279,29 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
         {
             updateActiveTriggerTimeIndex(currentTime);
 
-            if (_loadingStatesDynamically) {
-                mustLoadNewStateFromDisk = true;
-            }
-            else {
+            if (!_loadingStatesDynamically) {
                 needUpdate = true;
                 _activeStateIndex = _activeTriggerTimeIndex;
             }
         } // else {we're still in same state as previous frame (no changes needed)}
+
+        if (_loadingStatesDynamically) {
+            requestStates(
+                currentTime,
+                currentTime - data.previousFrameTime.j2000Seconds()
+            );
+
+            // Until the active state has been loaded, the previous state is still shown
+            if (_activeTriggerTimeIndex != _loadedStateIndex) {
+                swapInPrefetchedState(_activeTriggerTimeIndex);
+            }
+            if (_loadedStateIndex == _activeTriggerTimeIndex &&
+                _uploadedStateIndex != _loadedStateIndex)
+            {
+                needUpdate = true;
+                _uploadedStateIndex = _loadedStateIndex;
+            }
+        }
     }
     // if only one state
     else if (_nStates == 1) {
@@ -1104,27 +1321,10 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
     else {
         // Not in interval => set everything to false
         _activeTriggerTimeIndex = -1;
-        mustLoadNewStateFromDisk = false;
         needUpdate = false;
     }
 
-    if (mustLoadNewStateFromDisk) {
-        if (!_isLoadingStateFromDisk && !_newStateIsReady) {
-            _isLoadingStateFromDisk = true;
-            mustLoadNewStateFromDisk  = false;
-            std::string filePath = _sourceFiles[_activeTriggerTimeIndex];
-            std::thread readBinaryThread([this, f = std::move(filePath)]() {
-                readNewState(f);
-            });
-            readBinaryThread.detach();
-        }
-    }
-
-    if (needUpdate || _newStateIsReady) {
-        if (_loadingStatesDynamically) {
-            _states[0] = std::move(*_newState);
-        }
-
+    if (needUpdate) {
         updateVertexPositionBuffer();
 
         if (_states[_activeStateIndex].nExtraQuantities() > 0) {
@@ -1134,7 +1334,6 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
 
         // Everything is set and ready for rendering
         needUpdate = false;
-        _newStateIsReady = false;
     }
 
     if (_colorMethod == 1) { //By quantity
@@ -1171,35 +1370,60 @@ void RenderableFieldlinesSequence::updateActiveTriggerTimeIndex(double currentTi
     }
 }
 
-// Reading state from disk. Must be thread safe
-void RenderableFieldlinesSequence::readNewState(const std::string& filePath) {
-    _newState = std::make_unique<FieldlinesState>();
-    if (_newState->loadStateFromOsfls(filePath)) {
-        _newStateIsReady = true;
-    }
-    _isLoadingStateFromDisk = false;
-}
-
 // Unbind buffers and arrays
 void unbindGL() {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void RenderableFieldlinesSequence::updateVertexPositionBuffer() {
-    if (_activeStateIndex == -1) { return; }
-    glBindVertexArray(_vertexArrayObject);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
+void RenderableFieldlinesSequence::allocateBuffers(size_t nPoints) {
+    if (_vertexPositionBuffer != 0) {
+        glDeleteBuffers(1, &_vertexPositionBuffer);
+        glDeleteBuffers(1, &_vertexColorBuffer);
+        glDeleteBuffers(1, &_vertexMaskingBuffer);
+    }
+    _bufferCapacity = nPoints;
 
-    const std::vector<glm::vec3>& vertPos = _states[_activeStateIndex].vertexPositions();
+    // Buffers with immutable storage must not be empty
+    const GLsizeiptr n = std::max(static_cast<GLsizeiptr>(nPoints), GLsizeiptr(1));
 
-    glBufferData(
+    glGenBuffers(1, &_vertexPositionBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
+    glBufferStorage(
         GL_ARRAY_BUFFER,
-        vertPos.size() * sizeof(glm::vec3),
-        vertPos.data(),
-        GL_STATIC_DRAW
+        n * sizeof(glm::vec3),
+        nullptr,
+        GL_DYNAMIC_STORAGE_BIT
     );
 
+    glGenBuffers(1, &_vertexColorBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexColorBuffer);
+    glBufferStorage(GL_ARRAY_BUFFER, n * sizeof(float), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    glGenBuffers(1, &_vertexMaskingBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexMaskingBuffer);
+    glBufferStorage(GL_ARRAY_BUFFER, n * sizeof(float), nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderableFieldlinesSequence::updateVertexPositionBuffer() {
+    if (_activeStateIndex == -1) { return; }
+
+    const std::span<const glm::vec3> vertPos =
+        _states[_activeStateIndex].vertexPositions();
+    if (vertPos.size() > _bufferCapacity) {
+        // Only happens if a file of a 'runtime-state' changed after its header was read
+        LWARNING("State is larger than the vertex buffers, which are reallocated");
+        allocateBuffers(vertPos.size());
+        _shouldUpdateColorBuffer = true;
+        _shouldUpdateMaskingBuffer = true;
+    }
+
+    glBindVertexArray(_vertexArrayObject);
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertPos.size_bytes(), vertPos.data());
+
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
 
@@ -1212,18 +1436,13 @@ void RenderableFieldlinesSequence::updateVertexColorBuffer() {
     glBindBuffer(GL_ARRAY_BUFFER, _vertexColorBuffer);
 
     bool isSuccessful;
-    const std::vector<float>& quantities = _states[_activeStateIndex].extraQuantity(
+    const std::span<const float> quantities = _states[_activeStateIndex].extraQuantity(
         _colorQuantity,
         isSuccessful
     );
 
-    if (isSuccessful) {
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            quantities.size() * sizeof(float),
-            quantities.data(),
-            GL_STATIC_DRAW
-        );
+    if (isSuccessful && quantities.size() <= _bufferCapacity) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, quantities.size_bytes(), quantities.data());
 
         glEnableVertexAttribArray(1);
         glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 0, 0);
@@ -1238,18 +1457,13 @@ void RenderableFieldlinesSequence::updateVertexMaskingBuffer() {
     glBindBuffer(GL_ARRAY_BUFFER, _vertexMaskingBuffer);
 
     bool isSuccessful;
-    const std::vector<float>& maskings = _states[_activeStateIndex].extraQuantity(
+    const std::span<const float> maskings = _states[_activeStateIndex].extraQuantity(
         _maskingQuantity,
         isSuccessful
     );
 
-    if (isSuccessful) {
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            maskings.size() * sizeof(float),
-            maskings.data(),
-            GL_STATIC_DRAW
-        );
+    if (isSuccessful && maskings.size() <= _bufferCapacity) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, maskings.size_bytes(), maskings.data());
 
         glEnableVertexAttribArray(2);
         glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, 0);
@@ -35,7 +35,9 @@
 #include <openspace/properties/vector/vec2property.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/rendering/transferfunction.h>
-#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace openspace {
 
@@ -65,8 +67,36 @@ private:
     void setupProperties();
     bool prepareForOsflsStreaming();
 
-    void readNewState(const std::string& filePath);
+
+    /// Starts the worker threads that load the requested states from disk
+    void startLoaderThreads();
+    /// Stops the worker threads after they have finished their current state
+    void stopLoaderThreads();
+    /// Loop of each worker thread that loads the requested states
+    void loadRequestedStates();
+
+    /**
+     * Requests the states that will be shown next, starting with the state at
+     * \p currentTime and following the direction and speed of the playback, which is
+     * given by the change in time \p frameDelta since the previous frame.
+     */
+    void requestStates(double currentTime, double frameDelta);
+
+    /**
+     * Swaps the prefetched state with the provided trigger time \p index into the state
+     * that is rendered. The previously rendered state stays in the prefetched states.
+     *
+     * \return `true` if the state was loaded and has been swapped in
+     */
+    bool swapInPrefetchedState(int index);
     void updateActiveTriggerTimeIndex(double currentTime);
+
+    /**
+     * Creates the vertex buffers with immutable storage that fits \p nPoints vertex
+     * points, replacing any buffers that were created before. The states are then
+     * uploaded into the buffers without the storage having to be reallocated.
+     */
+    void allocateBuffers(size_t nPoints);
     void updateVertexPositionBuffer();
     void updateVertexColorBuffer();
     void updateVertexMaskingBuffer();
@@ -93,15 +123,9 @@ private:
     // optional except when using json input
     std::string _modelStr;
 
-    // Used for 'runtime-states'. True when loading a new state from disk on another
-    // thread.
-    std::atomic_bool _isLoadingStateFromDisk = false;
     // False => states are stored in RAM (using 'in-RAM-states'), True => states are
     // loaded from disk during runtime (using 'runtime-states')
     bool _loadingStatesDynamically  = false;
-    // Used for 'runtime-states'. True when finished loading a new state from disk on
-    // another thread.
-    std::atomic_bool _newStateIsReady = false;
     // True when new state is loaded or user change which quantity to color the lines by
     bool _shouldUpdateColorBuffer   = false;
     // True when new state is loaded or user change which quantity used for masking out
@@ -138,10 +162,36 @@ private:
     GLuint _vertexMaskingBuffer = 0;
     // OpenGL Vertex Buffer Object containing the vertex positions
     GLuint _vertexPositionBuffer = 0;
+    // The number of vertex points that fit into each of the vertex buffers, which is the
+    // number of points of the largest state in the sequence
+    size_t _bufferCapacity = 0;
+
+    /// A state that is loaded or being loaded by the worker threads for 'runtime-states'
+    struct PrefetchedState {
+        /// The trigger time index of the state, or -1 if this slot is empty
+        int index = -1;
+        /// If this is true, a worker thread is currently loading into this slot
+        bool isLoading = false;
+        FieldlinesState state;
+    };
+
+    // Used for 'runtime-states'. The fixed set of slots holding the prefetched states
+    std::vector<PrefetchedState> _prefetchedStates;
+    // Used for 'runtime-states'. The trigger time indices of the states that should be
+    // loaded, ordered by decreasing priority
+    std::vector<int> _requestedStates;
+    // The active state and the playback direction for which the states were requested
+    int _requestedStateIndex = -1;
+    bool _requestedForward = true;
+    // Used for 'runtime-states'. The trigger time index of the state in _states[0]
+    int _loadedStateIndex = -1;
+    // Used for 'runtime-states'. The trigger time index of the state in the buffers
+    int _uploadedStateIndex = -1;
+    bool _shouldStopLoading = false;
+    std::mutex _loadMutex;
+    std::condition_variable _loadCondition;
+    std::vector<std::thread> _loaderThreads;
 
-    // The Lua-Modfile-Dictionary used during initialization
-    // Used for 'runtime-states' when switching out current state to a new state
-    std::unique_ptr<FieldlinesState> _newState;
     std::unique_ptr<ghoul::opengl::ProgramObject> _shaderProgram;
     // Transfer function used to color lines when _pColorMethod is set to BY_QUANTITY
     std::unique_ptr<TransferFunction> _transferFunction;
@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/fieldlinessequence/tasks/osflsconversiontask.h>
+
+#include <modules/fieldlinessequence/util/fieldlinesstate.h>
+#include <openspace/documentation/documentation.h>
+#include <openspace/documentation/verifier.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    constexpr std::string_view _loggerCat = "OsflsConversionTask";
+
+    struct [[codegen::Dictionary(OsflsConversionTask)]] Parameters {
+        // The folder containing the .osfls files that should be converted
+        std::filesystem::path inputFolder [[codegen::directory()]];
+
+        // The folder to which the converted .osfls files are written. The folder is
+        // created if it does not exist. Files in this folder with the same name as one
+        // of the converted files are overwritten
+        std::string outputFolder [[codegen::annotation("A valid folder path")]];
+    };
+#include "osflsconversiontask_codegen.cpp"
+} // namespace
+
+namespace openspace {
+
+documentation::Documentation OsflsConversionTask::Documentation() {
+    return codegen::doc<Parameters>("fieldlinessequence_osflsconversiontask");
+}
+
+OsflsConversionTask::OsflsConversionTask(const ghoul::Dictionary& dictionary) {
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+    _inputFolder = absPath(p.inputFolder);
+    _outputFolder = absPath(p.outputFolder);
+}
+
+std::string OsflsConversionTask::description() {
+    return std::format(
+        "Convert the .osfls files in '{}' to the current file format and write them to "
+        "'{}'",
+        _inputFolder, _outputFolder
+    );
+}
+
+void OsflsConversionTask::perform(const Task::ProgressCallback& progressCallback) {
+    std::vector<std::filesystem::path> files;
+    for (const std::filesystem::directory_entry& e :
+         std::filesystem::directory_iterator(_inputFolder))
+    {
+        if (e.is_regular_file() && e.path().extension() == ".osfls") {
+            files.push_back(e.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::filesystem::create_directories(_outputFolder);
+    // The state is saved to a file whose name is based on its trigger time, appended to
+    // the provided path
+    const std::string outputPath = (_outputFolder / "").string();
+
+    for (size_t i = 0; i < files.size(); i++) {
+        FieldlinesState state;
+        if (state.loadStateFromOsfls(files[i].string())) {
+            state.saveStateToOsfls(outputPath);
+        }
+        else {
+            LWARNING(std::format("Failed to convert '{}'", files[i]));
+        }
+        progressCallback(static_cast<float>(i + 1) / static_cast<float>(files.size()));
+    }
+}
+
+} // namespace openspace
@@ -25,16 +25,65 @@
 #include <modules/fieldlinessequence/util/fieldlinesstate.h>
 
 #include <openspace/json.h>
+#include <openspace/util/memorymappedfile.h>
 #include <openspace/util/time.h>
 #include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 
 namespace {
     constexpr std::string_view _loggerCat = "FieldlinesState";
-    constexpr int CurrentVersion = 0;
+    constexpr int CurrentVersion = 1;
     using json = nlohmann::json;
+
+    // Every section of a version 1 file starts at a multiple of this many bytes, which
+    // makes it possible to use the sections directly from a memory mapped file
+    constexpr uint64_t SectionAlignment = 64;
+
+    // The fixed size header at the beginning of a version 1 file. The version number has
+    // to be first as it is shared with all previous versions
+    struct HeaderV1 {
+        int32_t version = 1;
+        int32_t model = 0;
+        double triggerTime = 0.0;
+        uint32_t isMorphable = 0;
+        uint32_t reserved = 0;
+        uint64_t nLines = 0;
+        uint64_t nPoints = 0;
+        uint64_t nExtras = 0;
+        uint64_t lineStartOffset = 0;
+        uint64_t lineCountOffset = 0;
+        uint64_t positionsOffset = 0;
+        uint64_t extrasOffset = 0;
+        // The distance in bytes between the beginning of two consecutive extra quantities
+        uint64_t extrasStride = 0;
+        uint64_t namesOffset = 0;
+        uint64_t namesSize = 0;
+    };
+    static_assert(sizeof(HeaderV1) == 104, "Header must not contain implicit padding");
+
+    constexpr uint64_t alignSection(uint64_t offset) {
+        return (offset + SectionAlignment - 1) / SectionAlignment * SectionAlignment;
+    }
+
+    // Splits the null-separated names of the extra quantities
+    std::vector<std::string> splitNames(std::string_view allNames, size_t nNames) {
+        std::vector<std::string> names;
+        names.reserve(nNames);
+        size_t offset = 0;
+        for (size_t i = 0; i < nNames; i++) {
+            const size_t end = std::min(allNames.find('\0', offset), allNames.size());
+            names.emplace_back(allNames.substr(offset, end - offset));
+            offset = std::min(end + 1, allNames.size());
+        }
+        return names;
+    }
 } // namespace
 
 namespace openspace {
@@ -45,6 +94,8 @@ namespace openspace {
  * expected to be in degrees. scale is an optional scaling factor.
  */
 void FieldlinesState::convertLatLonToCartesian(float scale) {
+    ghoul_assert(!_mapped, "A memory mapped state cannot be modified");
+
     for (glm::vec3& p : _vertexPositions) {
         const float r = p.x * scale;
         const float lat = glm::radians(p.y);
@@ -56,6 +107,8 @@ void FieldlinesState::convertLatLonToCartesian(float scale) {
 }
 
 void FieldlinesState::scalePositions(float scale) {
+    ghoul_assert(!_mapped, "A memory mapped state cannot be modified");
+
     for (glm::vec3& p : _vertexPositions) {
         p *= scale;
     }
@@ -73,12 +126,36 @@ bool FieldlinesState::loadStateFromOsfls(const std::string& pathToOsflsFile) {
 
     switch (binFileVersion) {
         case 0:
-            // No need to put everything in this scope now, as only version 0 exists!
             break;
+        case 1:
+        {
+            // Version 1 files are laid out to be mapped, so the easiest way to read one
+            // is to map it and copy the sections out of the mapping
+            ifs.close();
+            if (!mapStateFromOsfls(pathToOsflsFile)) {
+                return false;
+            }
+            const MappedSections mapped = std::move(*_mapped);
+            _mapped = std::nullopt;
+
+            _lineStart.assign(mapped.lineStart.begin(), mapped.lineStart.end());
+            _lineCount.assign(mapped.lineCount.begin(), mapped.lineCount.end());
+            _vertexPositions.assign(
+                mapped.vertexPositions.begin(),
+                mapped.vertexPositions.end()
+            );
+            _extraQuantities.clear();
+            _extraQuantities.reserve(mapped.extraQuantities.size());
+            for (std::span<const float> quantity : mapped.extraQuantities) {
+                _extraQuantities.emplace_back(quantity.begin(), quantity.end());
+            }
+            return true;
+        }
         default:
             LERROR("VERSION OF BINARY FILE WAS NOT RECOGNIZED");
             return false;
     }
+    _mapped = std::nullopt;
 
     // Define tmp variables to store meta data in
     size_t nLines;
@@ -117,22 +194,144 @@ bool FieldlinesState::loadStateFromOsfls(const std::string& pathToOsflsFile) {
 
     // Read all extra quantities' names. Stored as multiple c-strings
     std::string allNamesInOne;
-    std::vector<char> buffer(byteSizeAllNames);
-    ifs.read(buffer.data(), byteSizeAllNames);
-    allNamesInOne.assign(buffer.data(), byteSizeAllNames);
-
-    size_t offset = 0;
-    for (size_t i = 0; i < nExtras; i++) {
-        auto endOfVarName = allNamesInOne.find('\0', offset);
-        endOfVarName -= offset;
-        const std::string varName = allNamesInOne.substr(offset, endOfVarName);
-        offset += varName.size() + 1;
-        _extraQuantityNames[i] = varName;
+    allNamesInOne.resize(byteSizeAllNames);
+    ifs.read(allNamesInOne.data(), byteSizeAllNames);
+    _extraQuantityNames = splitNames(allNamesInOne, nExtras);
+
+    return true;
+}
+
+bool FieldlinesState::mapStateFromOsfls(const std::string& pathToOsflsFile) {
+    std::shared_ptr<const MemoryMappedFile> file;
+    try {
+        file = std::make_shared<const MemoryMappedFile>(pathToOsflsFile);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(e.message);
+        return false;
+    }
+
+    const std::byte* data = file->data();
+    const size_t size = file->size();
+    int32_t version = -1;
+    if (size >= sizeof(int32_t)) {
+        std::memcpy(&version, data, sizeof(int32_t));
+    }
+
+    if (version == 0) {
+        // The sections in version 0 files are not aligned, so they have to be read
+        return loadStateFromOsfls(pathToOsflsFile);
+    }
+    if (version != 1 || size < sizeof(HeaderV1)) {
+        LERROR(std::format("Unrecognized or corrupt .osfls file '{}'", pathToOsflsFile));
+        return false;
+    }
+
+    HeaderV1 header;
+    std::memcpy(&header, data, sizeof(HeaderV1));
+
+    // Checks that a section of 'count' elements of size 'elementSize' that starts at
+    // 'offset' is aligned and lies fully within the file
+    auto isValidSection = [size](uint64_t offset, uint64_t count, uint64_t elementSize) {
+        return offset % SectionAlignment == 0 && offset <= size &&
+               count <= (size - offset) / elementSize;
+    };
+    bool isValid =
+        isValidSection(header.lineStartOffset, header.nLines, sizeof(GLint)) &&
+        isValidSection(header.lineCountOffset, header.nLines, sizeof(GLsizei)) &&
+        isValidSection(header.positionsOffset, header.nPoints, sizeof(glm::vec3)) &&
+        isValidSection(header.namesOffset, header.namesSize, 1) &&
+        header.extrasStride % SectionAlignment == 0 &&
+        header.nExtras <= size;
+    for (uint64_t i = 0; isValid && i < header.nExtras; i++) {
+        isValid = isValidSection(
+            header.extrasOffset + i * header.extrasStride,
+            header.nPoints,
+            sizeof(float)
+        );
+    }
+    if (!isValid) {
+        LERROR(std::format("Corrupt .osfls file '{}'", pathToOsflsFile));
+        return false;
+    }
+
+    MappedSections mapped;
+    mapped.lineStart = std::span(
+        reinterpret_cast<const GLint*>(data + header.lineStartOffset),
+        header.nLines
+    );
+    mapped.lineCount = std::span(
+        reinterpret_cast<const GLsizei*>(data + header.lineCountOffset),
+        header.nLines
+    );
+    mapped.vertexPositions = std::span(
+        reinterpret_cast<const glm::vec3*>(data + header.positionsOffset),
+        header.nPoints
+    );
+    mapped.extraQuantities.reserve(header.nExtras);
+    for (uint64_t i = 0; i < header.nExtras; i++) {
+        mapped.extraQuantities.emplace_back(
+            reinterpret_cast<const float*>(
+                data + header.extrasOffset + i * header.extrasStride
+            ),
+            header.nPoints
+        );
     }
+    mapped.file = std::move(file);
+
+    _triggerTime = header.triggerTime;
+    _model = static_cast<fls::Model>(header.model);
+    _isMorphable = header.isMorphable != 0;
+    _extraQuantityNames = splitNames(
+        std::string_view(
+            reinterpret_cast<const char*>(data + header.namesOffset),
+            header.namesSize
+        ),
+        header.nExtras
+    );
 
+    // The data is owned by the mapping from now on
+    _lineStart = std::vector<GLint>();
+    _lineCount = std::vector<GLsizei>();
+    _vertexPositions = std::vector<glm::vec3>();
+    _extraQuantities = std::vector<std::vector<float>>();
+    _mapped = std::move(mapped);
     return true;
 }
 
+size_t FieldlinesState::vertexCountFromOsfls(const std::string& pathToOsflsFile) {
+    std::ifstream ifs(pathToOsflsFile, std::ifstream::binary);
+    if (!ifs.is_open()) {
+        return 0;
+    }
+
+    int32_t version = -1;
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(int32_t));
+
+    uint64_t nPoints = 0;
+    switch (version) {
+        case 0:
+            // Skip the trigger time, model, morphable flag, and number of lines
+            ifs.seekg(
+                sizeof(double) + sizeof(int32_t) + sizeof(bool) + sizeof(uint64_t),
+                std::ios::cur
+            );
+            ifs.read(reinterpret_cast<char*>(&nPoints), sizeof(uint64_t));
+            break;
+        case 1:
+        {
+            HeaderV1 header;
+            ifs.seekg(0);
+            ifs.read(reinterpret_cast<char*>(&header), sizeof(HeaderV1));
+            nPoints = header.nPoints;
+            break;
+        }
+        default:
+            return 0;
+    }
+    return ifs.good() ? static_cast<size_t>(nPoints) : 0;
+}
+
 bool FieldlinesState::loadStateFromJson(const std::string& pathToJsonFile,
                                         fls::Model Model, float coordToMeters)
 {
@@ -219,28 +418,24 @@ bool FieldlinesState::loadStateFromJson(const std::string& pathToJsonFile,
 /**
  * \param absPath must be the path to the file (incl. filename but excl. extension!)
  * Directory must exist! File is created (or overwritten if already existing).
- * File is structured like this: (for version 0)
- *  0. int                    - version number of binary state file! (in case something
- *                              needs to be altered in the future, then increase
- *                              CurrentVersion)
- *  1. double                 - _triggerTime
- *  2. int                    - _model
- *  3. bool                   - _isMorphable
- *  4. size_t                 - Number of lines in the state  == _lineStart.size()
- *                                                            == _lineCount.size()
- *  5. size_t                 - Total number of vertex points == _vertexPositions.size()
- *                                                           == _extraQuantities[i].size()
- *  6. size_t                 - Number of extra quantites     == _extraQuantities.size()
- *                                                           == _extraQuantityNames.size()
- *  7. site_t                 - Number of total bytes that ALL _extraQuantityNames
- *                              consists of (Each such name is stored as a c_str which
- *                              means it ends with the null char '\0' )
- *  7. std::vector<GLint>     - _lineStart
- *  8. std::vector<GLsizei>   - _lineCount
- *  9. std::vector<glm::vec3> - _vertexPositions
- * 10. std::vector<float>     - _extraQuantities
- * 11. array of c_str         - Strings naming the extra quantities (elements of
+ * File is structured like this: (for version 1)
+ *  0. HeaderV1               - Fixed size header containing the version number, the
+ *                              _triggerTime, the _model, whether the state _isMorphable,
+ *                              the number of lines, vertex points and extra quantities,
+ *                              as well as the byte offset of each of the sections below
+ *  1. std::vector<GLint>     - _lineStart
+ *  2. std::vector<GLsizei>   - _lineCount
+ *  3. std::vector<glm::vec3> - _vertexPositions
+ *  4. std::vector<float>     - _extraQuantities, each one starting at a multiple of the
+ *                              section alignment
+ *  5. array of c_str         - Strings naming the extra quantities (elements of
  *                              _extraQuantityNames). Each string ends with null char '\0'
+ *
+ * Each section starts at a multiple of SectionAlignment bytes and the space in between
+ * is filled with zeros. This makes it possible to map the file into memory and upload
+ * the sections to the GPU without having to parse or copy them first.
+ * Version 0 files stored the same sections one after another without any alignment
+ * after a header of variable size and can still be read by #loadStateFromOsfls
  */
 void FieldlinesState::saveStateToOsfls(const std::string& absPath) {
     // ------------------------------- Create the file ------------------------------- //
@@ -264,37 +459,62 @@ void FieldlinesState::saveStateToOsfls(const std::string& absPath) {
         allExtraQuantityNamesInOne += str + '\0'; // Add null char '\0' for easier reading
     }
 
-    const size_t nLines = _lineStart.size();
-    const size_t nPoints = _vertexPositions.size();
-    const size_t nExtras = _extraQuantities.size();
-    const size_t nStringBytes = allExtraQuantityNamesInOne.size();
+    const std::span<const GLint> lineStarts = lineStart();
+    const std::span<const GLsizei> lineCounts = lineCount();
+    const std::span<const glm::vec3> positions = vertexPositions();
+
+    // ------------------------ Compute the layout of the file ------------------------ //
+    HeaderV1 header;
+    header.version = CurrentVersion;
+    header.model = static_cast<int32_t>(_model);
+    header.triggerTime = _triggerTime;
+    header.isMorphable = _isMorphable ? 1 : 0;
+    header.nLines = lineStarts.size();
+    header.nPoints = positions.size();
+    header.nExtras = nExtraQuantities();
+    header.lineStartOffset = alignSection(sizeof(HeaderV1));
+    header.lineCountOffset =
+        alignSection(header.lineStartOffset + header.nLines * sizeof(GLint));
+    header.positionsOffset =
+        alignSection(header.lineCountOffset + header.nLines * sizeof(GLsizei));
+    header.extrasOffset =
+        alignSection(header.positionsOffset + header.nPoints * sizeof(glm::vec3));
+    header.extrasStride = alignSection(header.nPoints * sizeof(float));
+    header.namesOffset = header.extrasOffset + header.nExtras * header.extrasStride;
+    header.namesSize = allExtraQuantityNamesInOne.size();
 
     //----------------------------- WRITE EVERYTHING TO FILE -----------------------------
-    // VERSION OF BINARY FIELDLINES STATE FILE - IN CASE STRUCTURE CHANGES IN THE FUTURE
-    ofs.write(reinterpret_cast<const char*>(&CurrentVersion), sizeof(int));
-
-    //-------------------- WRITE META DATA FOR STATE --------------------------------
-    ofs.write(reinterpret_cast<const char*>(&_triggerTime), sizeof(_triggerTime));
-    ofs.write(reinterpret_cast<const char*>(&_model), sizeof(int32_t));
-    ofs.write(reinterpret_cast<const char*>(&_isMorphable), sizeof(bool));
-
-    ofs.write(reinterpret_cast<const char*>(&nLines), sizeof(uint64_t));
-    ofs.write(reinterpret_cast<const char*>(&nPoints), sizeof(uint64_t));
-    ofs.write(reinterpret_cast<const char*>(&nExtras), sizeof(uint64_t));
-    ofs.write(reinterpret_cast<const char*>(&nStringBytes), sizeof(uint64_t));
-
-    //---------------------- WRITE ALL ARRAYS OF DATA --------------------------------
-    ofs.write(reinterpret_cast<char*>(_lineStart.data()), sizeof(int32_t) * nLines);
-    ofs.write(reinterpret_cast<char*>(_lineCount.data()), sizeof(uint32_t) * nLines);
-    ofs.write(
-        reinterpret_cast<char*>(_vertexPositions.data()),
-        3 * sizeof(float) * nPoints
-    );
-    // Write the data for each vector in _extraQuantities
-    for (std::vector<float>& vec : _extraQuantities) {
-        ofs.write(reinterpret_cast<char*>(vec.data()), sizeof(float) * nPoints);
+    uint64_t nBytesWritten = 0;
+    // Writes the data at the provided offset, padding with zeros up to that point
+    auto writeSection = [&ofs, &nBytesWritten](uint64_t offset, const void* data,
+                                               uint64_t nBytes)
+    {
+        constexpr std::array<char, SectionAlignment> Zeros = {};
+        ghoul_assert(offset >= nBytesWritten, "Sections must be written in order");
+        ghoul_assert(offset - nBytesWritten < SectionAlignment, "Invalid padding");
+        ofs.write(Zeros.data(), offset - nBytesWritten);
+        ofs.write(reinterpret_cast<const char*>(data), nBytes);
+        nBytesWritten = offset + nBytes;
+    };
+
+    writeSection(0, &header, sizeof(HeaderV1));
+    writeSection(header.lineStartOffset, lineStarts.data(), lineStarts.size_bytes());
+    writeSection(header.lineCountOffset, lineCounts.data(), lineCounts.size_bytes());
+    writeSection(header.positionsOffset, positions.data(), positions.size_bytes());
+    for (uint64_t i = 0; i < header.nExtras; i++) {
+        bool isSuccessful = false;
+        const std::span<const float> quantity = extraQuantity(i, isSuccessful);
+        writeSection(
+            header.extrasOffset + i * header.extrasStride,
+            quantity.data(),
+            quantity.size_bytes()
+        );
     }
-    ofs.write(allExtraQuantityNamesInOne.c_str(), nStringBytes);
+    writeSection(
+        header.namesOffset,
+        allExtraQuantityNamesInOne.data(),
+        header.namesSize
+    );
 }
 
 // TODO: This should probably be rewritten, but this is the way the files were structured
@@ -341,19 +561,27 @@ void FieldlinesState::saveStateToJson(const std::string& absPath) {
     json jFile;
 
     std::string_view timeStr = Time(_triggerTime).ISO8601();
-    const size_t nLines = _lineStart.size();
-    // const size_t nPoints      = _vertexPositions.size();
-    const size_t nExtras = _extraQuantities.size();
+    const std::span<const GLsizei> lineCounts = lineCount();
+    const std::span<const glm::vec3> positions = vertexPositions();
+    const size_t nLines = lineCounts.size();
+    const size_t nExtras = nExtraQuantities();
+
+    std::vector<std::span<const float>> extras;
+    extras.reserve(nExtras);
+    for (size_t extraIndex = 0; extraIndex < nExtras; ++extraIndex) {
+        bool isSuccessful = false;
+        extras.push_back(extraQuantity(extraIndex, isSuccessful));
+    }
 
     size_t pointIndex = 0;
     for (size_t lineIndex = 0; lineIndex < nLines; ++lineIndex) {
         json jData = json::array();
-        for (GLsizei i = 0; i < _lineCount[lineIndex]; i++, ++pointIndex) {
-            const glm::vec3 pos = _vertexPositions[pointIndex];
+        for (GLsizei i = 0; i < lineCounts[lineIndex]; i++, ++pointIndex) {
+            const glm::vec3 pos = positions[pointIndex];
             json jDataElement = { pos.x, pos.y, pos.z };
 
-            for (size_t extraIndex = 0; extraIndex < nExtras; ++extraIndex) {
-                jDataElement.push_back(_extraQuantities[extraIndex][pointIndex]);
+            for (std::span<const float> extra : extras) {
+                jDataElement.push_back(extra[pointIndex]);
             }
             jData.push_back(jDataElement);
         }
@@ -383,11 +611,15 @@ void FieldlinesState::setTriggerTime(double t) {
 }
 
 // Returns one of the extra quantity vectors, _extraQuantities[index].
-// If index is out of scope an empty vector is returned and the referenced bool is false.
-std::vector<float> FieldlinesState::extraQuantity(size_t index, bool& isSuccessful) const
+// If index is out of scope an empty span is returned and the referenced bool is false.
+std::span<const float> FieldlinesState::extraQuantity(size_t index,
+                                                      bool& isSuccessful) const
 {
-    if (index < _extraQuantities.size()) {
+    if (index < nExtraQuantities()) {
         isSuccessful = true;
+        if (_mapped) {
+            return _mapped->extraQuantities[index];
+        }
         return _extraQuantities[index];
     }
     else {
@@ -401,6 +633,8 @@ std::vector<float> FieldlinesState::extraQuantity(size_t index, bool& isSuccessf
 // _lineStart & _lineCount accordingly.
 
 void FieldlinesState::addLine(std::vector<glm::vec3>& line) {
+    ghoul_assert(!_mapped, "A memory mapped state cannot be modified");
+
     const size_t nNewPoints = line.size();
     const size_t nOldPoints = _vertexPositions.size();
     _lineStart.push_back(static_cast<GLint>(nOldPoints));
@@ -415,28 +649,28 @@ void FieldlinesState::addLine(std::vector<glm::vec3>& line) {
 }
 
 void FieldlinesState::appendToExtra(size_t idx, float val) {
+    ghoul_assert(!_mapped, "A memory mapped state cannot be modified");
+
     _extraQuantities[idx].push_back(val);
 }
 
 void FieldlinesState::setExtraQuantityNames(std::vector<std::string> names) {
+    ghoul_assert(!_mapped, "A memory mapped state cannot be modified");
+
     _extraQuantityNames = std::move(names);
     _extraQuantities.resize(_extraQuantityNames.size());
 }
 
-const std::vector<std::vector<float>>& FieldlinesState::extraQuantities() const {
-    return _extraQuantities;
-}
-
 const std::vector<std::string>& FieldlinesState::extraQuantityNames() const {
     return _extraQuantityNames;
 }
 
-const std::vector<GLsizei>& FieldlinesState::lineCount() const {
-    return _lineCount;
+std::span<const GLsizei> FieldlinesState::lineCount() const {
+    return _mapped ? _mapped->lineCount : std::span<const GLsizei>(_lineCount);
 }
 
-const std::vector<GLint>& FieldlinesState::lineStart() const {
-    return _lineStart;
+std::span<const GLint> FieldlinesState::lineStart() const {
+    return _mapped ? _mapped->lineStart : std::span<const GLint>(_lineStart);
 }
 
 fls::Model FieldlinesState::FieldlinesState::model() const {
@@ -444,15 +678,17 @@ fls::Model FieldlinesState::FieldlinesState::model() const {
 }
 
 size_t FieldlinesState::nExtraQuantities() const {
-    return _extraQuantities.size();
+    return _mapped ? _mapped->extraQuantities.size() : _extraQuantities.size();
 }
 
 double FieldlinesState::triggerTime() const {
     return _triggerTime;
 }
 
-const std::vector<glm::vec3>& FieldlinesState::vertexPositions() const {
-    return _vertexPositions;
+std::span<const glm::vec3> FieldlinesState::vertexPositions() const {
+    return _mapped ?
+        _mapped->vertexPositions :
+        std::span<const glm::vec3>(_vertexPositions);
 }
 
 } // namespace openspace
@@ -28,11 +28,16 @@
 #include <modules/fieldlinessequence/util/commons.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace openspace {
 
+class MemoryMappedFile;
+
 class FieldlinesState {
 public:
     void convertLatLonToCartesian(float scale = 1.f);
@@ -41,22 +46,41 @@ public:
     bool loadStateFromOsfls(const std::string& pathToOsflsFile);
     void saveStateToOsfls(const std::string& pathToOsflsFile);
 
+    /**
+     * Maps the .osfls file at \p pathToOsflsFile into memory instead of reading it. For
+     * files of version 1 or later, the lines, positions, and extra quantities returned by
+     * this state point directly into the mapped file, which is kept alive for as long as
+     * this state or any of its copies exist. Files of older versions are loaded the same
+     * way as with #loadStateFromOsfls. A mapped state cannot be modified.
+     *
+     * \return `true` if the state was mapped or loaded successfully
+     */
+    bool mapStateFromOsfls(const std::string& pathToOsflsFile);
+
+    /**
+     * Returns the total number of vertex points of the state stored in the .osfls file at
+     * \p pathToOsflsFile. Only the header of the file is read, which makes this cheap
+     * enough to call for every file of a sequence.
+     *
+     * \return The number of vertex points, or 0 if the file could not be read
+     */
+    static size_t vertexCountFromOsfls(const std::string& pathToOsflsFile);
+
     bool loadStateFromJson(const std::string& pathToJsonFile, fls::Model model,
         float coordToMeters);
     void saveStateToJson(const std::string& pathToJsonFile);
 
-    const std::vector<std::vector<float>>& extraQuantities() const;
     const std::vector<std::string>& extraQuantityNames() const;
-    const std::vector<GLsizei>& lineCount() const;
-    const std::vector<GLint>& lineStart() const;
+    std::span<const GLsizei> lineCount() const;
+    std::span<const GLint> lineStart() const;
 
     fls::Model model() const;
     size_t nExtraQuantities() const;
     double triggerTime() const;
-    const std::vector<glm::vec3>& vertexPositions() const;
+    std::span<const glm::vec3> vertexPositions() const;
 
     // Special getter. Returns extraQuantities[index].
-    std::vector<float> extraQuantity(size_t index, bool& isSuccesful) const;
+    std::span<const float> extraQuantity(size_t index, bool& isSuccesful) const;
 
     void setModel(fls::Model m);
     void setTriggerTime(double t);
@@ -66,6 +90,15 @@ public:
     void appendToExtra(size_t idx, float val);
 
 private:
+    /// The sections of a memory mapped .osfls file that this state refers to
+    struct MappedSections {
+        std::shared_ptr<const MemoryMappedFile> file;
+        std::span<const GLint> lineStart;
+        std::span<const GLsizei> lineCount;
+        std::span<const glm::vec3> vertexPositions;
+        std::vector<std::span<const float>> extraQuantities;
+    };
+
     bool _isMorphable = false;
     double _triggerTime = -1.0;
     fls::Model _model;
@@ -75,6 +108,10 @@ private:
     std::vector<GLsizei> _lineCount;
     std::vector<GLint> _lineStart;
     std::vector<glm::vec3> _vertexPositions;
+
+    // Only has a value if the state was mapped from a file, in which case the vectors
+    // above, except for the extra quantity names, are empty
+    std::optional<MappedSections> _mapped;
 };
 
 } // namespace openspace
@@ -29,7 +29,10 @@
 #include <openspace/util/spicemanager.h>
 #include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #ifdef OPENSPACE_MODULE_KAMELEON_ENABLED
 
@@ -57,6 +60,31 @@ namespace {
     constexpr std::string_view JParallelB  = "Current: mag(J||B)";
     // [nPa]/[amu/cm^3] * ToKelvin => Temperature in Kelvin
     constexpr float ToKelvin = 72429735.6984f;
+
+    // Calls 'func' for every index in [0, n) from a number of threads. The indices are
+    // handed out one at a time, as the time it takes to trace a line varies greatly
+    template <typename Func>
+    void parallelFor(size_t n, const Func& func) {
+        const size_t nThreads = std::clamp<size_t>(
+            std::thread::hardware_concurrency(),
+            1,
+            std::max<size_t>(n, 1)
+        );
+
+        std::atomic<size_t> next = 0;
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads);
+        for (size_t i = 0; i < nThreads; i++) {
+            threads.emplace_back([n, &next, &func]() {
+                for (size_t idx = next++; idx < n; idx = next++) {
+                    func(idx);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
 } // namespace
 
 namespace openspace::fls {
@@ -81,18 +109,37 @@ bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfP
                                  const std::string& tracingVar,
                                  std::vector<std::string>& extraVars,
                                  std::vector<std::string>& extraMagVars)
+{
+    const std::shared_ptr<ccmc::Kameleon> kameleon = loadCdfFile(cdfPath, tracingVar);
+    if (!kameleon) {
+        return false;
+    }
+
+    return convertCdfToFieldlinesState(
+        state,
+        kameleon.get(),
+        seedMap,
+        manualTimeOffset,
+        tracingVar,
+        extraVars,
+        extraMagVars
+    );
+}
+
+bool convertCdfToFieldlinesState(FieldlinesState& state, ccmc::Kameleon* kameleon,
+                                 const std::unordered_map<std::string,
+                                 std::vector<glm::vec3>>& seedMap,
+                                 double manualTimeOffset,
+                                 const std::string& tracingVar,
+                                 std::vector<std::string>& extraVars,
+                                 std::vector<std::string>& extraMagVars)
 {
 #ifndef OPENSPACE_MODULE_KAMELEON_ENABLED
     LERROR("CDF inputs provided but Kameleon module is deactivated");
     return false;
 #else // OPENSPACE_MODULE_KAMELEON_ENABLED
-    // Create Kameleon object and open CDF file!
-    std::unique_ptr<ccmc::Kameleon> kameleon = kameleonHelper::createKameleonObject(
-        cdfPath
-    );
-
     state.setModel(fls::stringToModel(kameleon->getModelName()));
-    double cdfDoubleTime = kameleonHelper::getTime(kameleon.get(), manualTimeOffset);
+    double cdfDoubleTime = kameleonHelper::getTime(kameleon, manualTimeOffset);
     state.setTriggerTime(cdfDoubleTime);
 
     // get time as string.
@@ -102,12 +149,12 @@ bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfP
 
     // use time as string for picking seedpoints from seedm
     std::vector<glm::vec3> seedPoints = seedMap.at(cdfStringTime);
-    bool success = addLinesToState(kameleon.get(), seedPoints, tracingVar, state);
+    bool success = addLinesToState(kameleon, seedPoints, tracingVar, state);
     if (success) {
         // The line points are in their RAW format (unscaled & maybe spherical)
         // Before we scale to meters (and maybe cartesian) we must extract
         // the extraQuantites, as the iterpolator needs the unaltered positions
-        addExtraQuantities(kameleon.get(), extraVars, extraMagVars, state);
+        addExtraQuantities(kameleon, extraVars, extraMagVars, state);
         switch (state.model()) {
             case fls::Model::Batsrus:
                 state.scalePositions(fls::ReToMeter);
@@ -126,6 +173,29 @@ bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfP
 #endif // OPENSPACE_MODULE_KAMELEON_ENABLED
 }
 
+std::shared_ptr<ccmc::Kameleon> loadCdfFile(const std::string& cdfPath,
+                                            const std::string& tracingVar)
+{
+#ifndef OPENSPACE_MODULE_KAMELEON_ENABLED
+    LERROR("CDF inputs provided but Kameleon module is deactivated");
+    return nullptr;
+#else // OPENSPACE_MODULE_KAMELEON_ENABLED
+    // Create Kameleon object and open CDF file!
+    std::shared_ptr<ccmc::Kameleon> kameleon = kameleonHelper::createKameleonObject(
+        cdfPath
+    );
+    if (!kameleon) {
+        return nullptr;
+    }
+
+    if (!kameleon->loadVariable(tracingVar)) {
+        LERROR("Failed to load tracing variable: " + tracingVar);
+        return nullptr;
+    }
+    return kameleon;
+#endif // OPENSPACE_MODULE_KAMELEON_ENABLED
+}
+
 #ifdef OPENSPACE_MODULE_KAMELEON_ENABLED
 /**
  * Traces and adds line vertices to state.
@@ -154,22 +224,26 @@ bool addLinesToState(ccmc::Kameleon* kameleon, const std::vector<glm::vec3>& see
     }
 
     // ---------------------------- LOAD TRACING VARIABLE ---------------------------- //
+    // The variable has to be loaded before the tracing threads start, as loading it
+    // lazily from multiple threads at once is not safe
     if (!kameleon->loadVariable(tracingVar)) {
         LERROR("Failed to load tracing variable: " + tracingVar);
         return false;
     }
 
-    bool success = false;
     LINFO("Tracing field lines");
-    // LOOP THROUGH THE SEED POINTS, TRACE LINES, CONVERT POINTS TO glm::vec3 AND STORE //
-    for (const glm::vec3& seed : seedPoints) {
+    // TRACE THE LINES OF ALL SEED POINTS IN PARALLEL AND CONVERT POINTS TO glm::vec3 //
+    std::vector<std::vector<glm::vec3>> lines(seedPoints.size());
+    parallelFor(seedPoints.size(), [&](size_t i) {
         //--------------------------------------------------------------------------//
         // We have to create a new tracer (or actually a new interpolator) for each //
-        // new line, otherwise some issues occur                                    //
+        // new line, otherwise some issues occur. This also means that no two       //
+        // threads ever share an interpolator                                       //
         //--------------------------------------------------------------------------//
         auto interpolator = std::make_unique<ccmc::KameleonInterpolator>(kameleon->model);
         ccmc::Tracer tracer(kameleon, interpolator.get());
         tracer.setInnerBoundary(innerBoundaryLimit); // TODO specify in Lua?
+        const glm::vec3& seed = seedPoints[i];
         ccmc::Fieldline ccmcFieldline = tracer.bidirectionalTrace(
             tracingVar,
             seed.x,
@@ -178,15 +252,18 @@ bool addLinesToState(ccmc::Kameleon* kameleon, const std::vector<glm::vec3>& see
         );
         const std::vector<ccmc::Point3f>& positions = ccmcFieldline.getPositions();
 
-        const size_t nLinePoints = positions.size();
-
-        std::vector<glm::vec3> vertices;
-        vertices.reserve(nLinePoints);
+        std::vector<glm::vec3>& vertices = lines[i];
+        vertices.reserve(positions.size());
         for (const ccmc::Point3f& p : positions) {
             vertices.emplace_back(p.component1, p.component2, p.component3);
         }
+    });
+
+    // STORE THE LINES IN THE ORDER OF THEIR SEED POINTS //
+    bool success = false;
+    for (std::vector<glm::vec3>& vertices : lines) {
+        success |= !vertices.empty();
         state.addLine(vertices);
-        success |= (nLinePoints > 0);
     }
 
     return success;
@@ -26,10 +26,13 @@
 #define __OPENSPACE_MODULE_FIELDLINESSEQUENCE___KAMELEONFIELDLINEHELPER___H__
 
 #include <ghoul/glm.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+namespace ccmc { class Kameleon; }
+
 namespace openspace {
 
 class FieldlinesState;
@@ -58,6 +61,29 @@ bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfP
     double manualTimeOffset, const std::string& tracingVar,
     std::vector<std::string>& extraVars, std::vector<std::string>& extraMagVars);
 
+/**
+ * Same as the function above, but with a \p kameleon object that has been opened with
+ * #loadCdfFile instead of the path to the .cdf file.
+ */
+bool convertCdfToFieldlinesState(FieldlinesState& state, ccmc::Kameleon* kameleon,
+    const std::unordered_map<std::string, std::vector<glm::vec3>>& seedMap,
+    double manualTimeOffset, const std::string& tracingVar,
+    std::vector<std::string>& extraVars, std::vector<std::string>& extraMagVars);
+
+/**
+ * Opens the provided cdf file and loads the \p tracingVar from it, which is the part of
+ * #convertCdfToFieldlinesState that is bound by the disk rather than the processor. This
+ * function can be called on a separate thread to load the next file of a sequence while
+ * the field lines of the current file are traced.
+ *
+ * \param cdfPath `std::string` of the absolute path to a .cdf file
+ * \param tracingVar Which quantity that lines will be traced from
+ * \return `nullptr` if the file or the variable fail to load or if the kameleon module
+ *         is deactivated
+ */
+std::shared_ptr<ccmc::Kameleon> loadCdfFile(const std::string& cdfPath,
+    const std::string& tracingVar);
+
 } // namespace fls
 } // namespace openspace
 
@@ -25,16 +25,122 @@
 #include <modules/gaia/rendering/octreemanager.h>
 
 #include <modules/gaia/rendering/octreeculler.h>
+#include <openspace/engine/globals.h>
 #include <openspace/util/distanceconstants.h>
+#include <openspace/util/memorymanager.h>
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/format.h>
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "OctreeManager";
 
+    // The number of threads that read the node files while streaming the Octree
+    constexpr size_t NumIOThreads = 4;
+
+    // Copies a value of type T at the offset in the mapped file and advances the offset
+    // past it. Values beyond the end of the file are read as zero, like a failed read
+    template <typename T>
+    T readValue(const openspace::MemoryMappedFile& file, size_t& offset) {
+        T value = T();
+        if (offset + sizeof(T) <= file.size()) {
+            std::memcpy(&value, file.data() + offset, sizeof(T));
+        }
+        offset += sizeof(T);
+        return value;
+    }
+
+    // Assigns the data of nStars stars at the offset in the mapped file to the target,
+    // where the positions, colors, and velocities of the stars are stored one after
+    // another. The data is referenced in place if it is aligned for floats and copied
+    // into the vectors of the target otherwise. Returns false if the file is too small
+    template <typename T>
+    bool assignStarData(T& target,
+                        std::shared_ptr<const openspace::MemoryMappedFile> file,
+                        size_t offset, size_t nPos, size_t nCol, size_t nVel)
+    {
+        const size_t nBytes = (nPos + nCol + nVel) * sizeof(float);
+        if (offset + nBytes > file->size()) {
+            return false;
+        }
+
+        const std::byte* first = file->data() + offset;
+        if (reinterpret_cast<uintptr_t>(first) % alignof(float) == 0) {
+            const float* values = reinterpret_cast<const float*>(first);
+            target.mappedPosData = std::span<const float>(values, nPos);
+            target.mappedColData = std::span<const float>(values + nPos, nCol);
+            target.mappedVelData = std::span<const float>(values + nPos + nCol, nVel);
+            target.mappedFile = std::move(file);
+        }
+        else {
+            auto copy = [&first](std::vector<float>& v, size_t n) {
+                v.resize(n);
+                std::memcpy(v.data(), first, n * sizeof(float));
+                first += n * sizeof(float);
+            };
+            copy(target.posData, nPos);
+            copy(target.colData, nCol);
+            copy(target.velData, nVel);
+        }
+        return true;
+    }
+
+    // Reads one value from every page of the values, so that the pages are loaded from
+    // disk on the calling thread rather than when the values are used for the first time
+    void prefaultPages(std::span<const float> values) {
+        constexpr size_t ValuesPerPage = 4096 / sizeof(float);
+        volatile float sink = 0.f;
+        for (size_t i = 0; i < values.size(); i += ValuesPerPage) {
+            sink = values[i];
+        }
+    }
+
+    openspace::OctreeManager::ChunkDataMap createChunkDataMap() {
+#if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
+        return openspace::OctreeManager::ChunkDataMap();
+#else
+        return openspace::OctreeManager::ChunkDataMap(
+            &openspace::global::memoryManager->TemporaryMemory
+        );
+#endif
+    }
+
+    void mergeChunkData(openspace::OctreeManager::ChunkDataMap& target,
+                        openspace::OctreeManager::ChunkDataMap&& source)
+    {
+        // Existing keys in the target take precedence over the ones in the source
+        target.insert(
+            std::make_move_iterator(source.begin()),
+            std::make_move_iterator(source.end())
+        );
+    }
+
+    /**
+     * Counts the number of leaf and inner nodes in the subtree starting at \p node.
+     */
+    void countNodes(const openspace::OctreeManager::OctreeNode& node, size_t& nLeaves,
+                    size_t& nInner)
+    {
+        if (node.isLeaf) {
+            nLeaves++;
+            return;
+        }
+
+        nInner++;
+        for (const std::shared_ptr<openspace::OctreeManager::OctreeNode>& child :
+             node.children)
+        {
+            countNodes(*child, nLeaves, nInner);
+        }
+    }
+
     /**
      * \return the correct index of child node. Maps [1,1,1] to 0 and [-1,-1,-1] to 7
      */
@@ -64,6 +170,12 @@ void OctreeManager::initOctree(long long cpuRamBudget, int maxDist, int maxStars
     }
 
     LDEBUG("Initializing new Octree");
+    // Discard all nodes that are still being read for the previous Octree
+    _generation++;
+    _nodesInFlight.clear();
+    if (_ioThreadPool) {
+        _ioThreadPool->clearTasks();
+    }
     _root = std::make_shared<OctreeNode>();
     _root->octreePositionIndex = 8;
 
@@ -141,6 +253,27 @@ void OctreeManager::insert(const std::vector<float>& starValues) {
     insertInNode(*_root->children[index], starValues);
 }
 
+size_t OctreeManager::branchIndex(float posX, float posY, float posZ) {
+    return childIndex(posX, posY, posZ);
+}
+
+void OctreeManager::swapBranch(size_t branchIndex, OctreeManager& other) {
+    size_t nLeaves = 0;
+    size_t nInner = 0;
+    countNodes(*_root->children[branchIndex], nLeaves, nInner);
+    size_t nOtherLeaves = 0;
+    size_t nOtherInner = 0;
+    countNodes(*other._root->children[branchIndex], nOtherLeaves, nOtherInner);
+
+    std::swap(_root->children[branchIndex], other._root->children[branchIndex]);
+
+    _numLeafNodes = _numLeafNodes - nLeaves + nOtherLeaves;
+    _numInnerNodes = _numInnerNodes - nInner + nOtherInner;
+    other._numLeafNodes = other._numLeafNodes - nOtherLeaves + nLeaves;
+    other._numInnerNodes = other._numInnerNodes - nOtherInner + nInner;
+    _totalDepth = std::max(_totalDepth, other._totalDepth);
+}
+
 void OctreeManager::sliceLodData(size_t branchIndex) {
     if (branchIndex != 8) {
         sliceNodeLodCache(*_root->children[branchIndex]);
@@ -178,18 +311,14 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
             // Fetch first layer of children
             fetchChildrenNodes(*_root, 0);
 
+            // The files are read on the IO threads, so requesting all descendants here
+            // only walks the structure of the Octree
             for (const std::shared_ptr<OctreeNode>& child : _root->children) {
                 // Check so branch doesn't have a single layer
                 if (child->isLeaf) {
                     continue;
                 }
-
-                // Use multithreading to load files and detach thread from main execution
-                // so it can execute independently. Thread will be destroyed when
-                // finished
-                std::thread([this, n = child]() {
-                    fetchChildrenNodes(*n, -1);
-                }).detach();
+                fetchChildrenNodes(*child, -1);
             }
             _parentNodeOfCamera = 0;
         }
@@ -297,16 +426,14 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
         const long long bytesToTenthOfRam = tenthOfRamBudget - _cpuRamBudget;
         size_t nNodesToRemove = static_cast<size_t>(bytesToTenthOfRam / chunkSizeInBytes);
         std::vector<unsigned long long> nodesToRemove;
-        while (nNodesToRemove > 0) {
+        while (nNodesToRemove > 0 && !_leastRecentlyFetchedNodes.empty()) {
             // Dequeue nodes that were least recently fetched by findAndFetchNeighborNode
             nodesToRemove.push_back(_leastRecentlyFetchedNodes.front());
             _leastRecentlyFetchedNodes.pop();
             nNodesToRemove--;
         }
-        // Use asynchronous removal.
-        if (!nodesToRemove.empty()) {
-            std::thread(&OctreeManager::removeNodesFromRam, this, nodesToRemove).detach();
-        }
+        // The memory of the removed nodes is released on the IO threads
+        removeNodesFromRam(nodesToRemove);
     }
 }
 
@@ -397,28 +524,30 @@ void OctreeManager::findAndFetchNeighborNode(unsigned long long firstParentId, i
     std::shared_ptr<OctreeNode> node = _root;
     while (!indexStack.empty() && !node->children[indexStack.top()]->isLeaf) {
         node = node->children[indexStack.top()];
-        node->hasLoadedDescendant = true;
         indexStack.pop();
     }
 
-    // Fetch all children nodes from found parent. Use multithreading to load files
-    // asynchronously! Detach thread from main execution so it can execute independently.
-    // Thread will then be destroyed when it has finished
-    std::thread([this, node, additionalLevelsToFetch]() {
-        fetchChildrenNodes(*node, additionalLevelsToFetch);
-    }).detach();
+    // Fetch all children nodes from found parent. The files are read asynchronously on
+    // the IO threads and the `hasLoadedDescendant` flags along the way are updated once
+    // the data has arrived
+    fetchChildrenNodes(*node, additionalLevelsToFetch);
 }
 
-std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4& mvp,
-                                                              const glm::vec2& screenSize,
-                                                              int& deltaStars,
-                                                              gaia::RenderMode mode,
-                                                              float lodPixelThreshold)
+OctreeManager::ChunkDataMap OctreeManager::traverseData(const glm::dmat4& mvp,
+                                                        const glm::vec2& screenSize,
+                                                        int& deltaStars,
+                                                        gaia::RenderMode mode,
+                                                        float lodPixelThreshold)
 {
-    std::map<int, std::vector<float>> renderData;
+    ChunkDataMap renderData = createChunkDataMap();
     bool innerRebuild = false;
     _minTotalPixelsLod = lodPixelThreshold;
 
+    // Hand over the data of the nodes that have been read since the last render call
+    if (_streamOctree) {
+        processLoadedNodes();
+    }
+
     // Reclaim indices from previous render call
     for (auto removedKey = _removedKeysInPrevCall.rbegin();
          removedKey != _removedKeysInPrevCall.rend(); ++removedKey) {
@@ -469,11 +598,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
     if (totalPixels < _minTotalPixelsLod * 2) {
         // Remove LOD from first layer of children
         for (const std::shared_ptr<OctreeNode>& child : _root->children) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *child,
-                deltaStars
-            );
-            renderData.insert(tmpData.begin(), tmpData.end());
+            mergeChunkData(renderData, removeNodeFromCache(*child, deltaStars));
         }
         return renderData;
     }
@@ -483,7 +608,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
             continue;
         }
 
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
+        ChunkDataMap tmpData = checkNodeIntersection(
             *_root->children[i],
             mvp,
             screenSize,
@@ -499,20 +624,17 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
 
         // Observe that if there exists identical keys in renderData then those values in
         // tmpData will be ignored! Thus we store the removed keys until next render call
-        renderData.insert(tmpData.begin(), tmpData.end());
+        mergeChunkData(renderData, std::move(tmpData));
     }
 
     if (_rebuildBuffer) {
         if (_useVBO) {
             // We need to overwrite bigger indices that had data before! No need for SSBO
-            std::map<int, std::vector<float>> idxToRemove;
-            for (const int idx : _removedKeysInPrevCall) {
-                idxToRemove[idx] = std::vector<float>();
-            }
-
             // This will only insert indices that doesn't already exist in map
             // (i.e. > biggestIdx)
-            renderData.insert(idxToRemove.begin(), idxToRemove.end());
+            for (const int idx : _removedKeysInPrevCall) {
+                renderData.try_emplace(idx);
+            }
         }
         if (innerRebuild) {
             deltaStars = 0;
@@ -583,9 +705,12 @@ void OctreeManager::writeNodeToFile(std::ofstream& outFileStream, const OctreeNo
 
     // Write node data if specified
     if (writeData) {
-        std::vector<float> nodeData = node.posData;
-        nodeData.insert(nodeData.end(), node.colData.begin(), node.colData.end());
-        nodeData.insert(nodeData.end(), node.velData.begin(), node.velData.end());
+        const std::span<const float> pos = node.positions();
+        const std::span<const float> col = node.colors();
+        const std::span<const float> vel = node.velocities();
+        std::vector<float> nodeData(pos.begin(), pos.end());
+        nodeData.insert(nodeData.end(), col.begin(), col.end());
+        nodeData.insert(nodeData.end(), vel.begin(), vel.end());
         int32_t nDataSize = static_cast<int32_t>(nodeData.size());
         const size_t nBytes = nDataSize * sizeof(float);
 
@@ -603,8 +728,8 @@ void OctreeManager::writeNodeToFile(std::ofstream& outFileStream, const OctreeNo
     }
 }
 
-int OctreeManager::readFromFile(std::ifstream& inFileStream, bool readData,
-                                const std::filesystem::path& folderPath)
+int OctreeManager::readFromFile(std::shared_ptr<const MemoryMappedFile> file,
+                                bool readData, const std::filesystem::path& folderPath)
 {
     int nStarsRead = 0;
     const int oldMaxdist = static_cast<int>(MAX_DIST);
@@ -615,10 +740,10 @@ int OctreeManager::readFromFile(std::ifstream& inFileStream, bool readData,
         _streamFolderPath = folderPath;
     }
 
-    _valuesPerStar = 0;
-    inFileStream.read(reinterpret_cast<char*>(&_valuesPerStar), sizeof(int32_t));
-    inFileStream.read(reinterpret_cast<char*>(&MAX_STARS_PER_NODE), sizeof(int32_t));
-    inFileStream.read(reinterpret_cast<char*>(&MAX_DIST), sizeof(int32_t));
+    size_t offset = 0;
+    _valuesPerStar = readValue<int32_t>(*file, offset);
+    MAX_STARS_PER_NODE = readValue<int32_t>(*file, offset);
+    MAX_DIST = readValue<int32_t>(*file, offset);
 
     LDEBUG(std::format(
         "Max stars per node in read Octree: {} - Radius of root layer: {}",
@@ -647,42 +772,39 @@ int OctreeManager::readFromFile(std::ifstream& inFileStream, bool readData,
 
     // Use the same technique to construct octree from file
     for (const std::shared_ptr<OctreeNode>& child : _root->children) {
-        nStarsRead += readNodeFromFile(inFileStream, *child, readData);
+        nStarsRead += readNodeFromFile(file, offset, *child, readData);
     }
     return nStarsRead;
 }
 
-int OctreeManager::readNodeFromFile(std::ifstream& inFileStream, OctreeNode& node,
-                                    bool readData)
+int OctreeManager::readNodeFromFile(const std::shared_ptr<const MemoryMappedFile>& file,
+                                    size_t& offset, OctreeNode& node, bool readData)
 {
     // Read node structure.
-    bool isLeaf = false;
-    int32_t numStars = 0;
-
-    inFileStream.read(reinterpret_cast<char*>(&isLeaf), sizeof(bool));
-    inFileStream.read(reinterpret_cast<char*>(&numStars), sizeof(int32_t));
+    const bool isLeaf = readValue<uint8_t>(*file, offset) != 0;
+    int32_t numStars = readValue<int32_t>(*file, offset);
 
     node.isLeaf = isLeaf;
     node.numStars = numStars;
 
     // Read node data if specified.
     if (readData) {
-        int32_t nDataSize = 0;
-        inFileStream.read(reinterpret_cast<char*>(&nDataSize), sizeof(int32_t));
+        const int32_t nDataSize = readValue<int32_t>(*file, offset);
 
         if (nDataSize > 0) {
-            std::vector<float> fetchedData(nDataSize, 0.f);
-            const size_t nBytes = nDataSize * sizeof(float);
-
-            inFileStream.read(reinterpret_cast<char*>(fetchedData.data()), nBytes);
-
-            const int starsInNode = static_cast<int>(nDataSize / _valuesPerStar);
-            const auto posEnd = fetchedData.begin() + (starsInNode * POS_SIZE);
-            const auto colEnd = posEnd + (starsInNode * COL_SIZE);
-            const auto velEnd = colEnd + (starsInNode * VEL_SIZE);
-            node.posData = std::vector<float>(fetchedData.begin(), posEnd);
-            node.colData = std::vector<float>(posEnd, colEnd);
-            node.velData = std::vector<float>(colEnd, velEnd);
+            const size_t starsInNode = nDataSize / _valuesPerStar;
+            const bool success = assignStarData(
+                node,
+                file,
+                offset,
+                starsInNode * POS_SIZE,
+                starsInNode * COL_SIZE,
+                starsInNode * VEL_SIZE
+            );
+            if (!success) {
+                LERROR("Octree file ended before the data of all nodes was read");
+            }
+            offset += nDataSize * sizeof(float);
         }
     }
 
@@ -691,7 +813,7 @@ int OctreeManager::readNodeFromFile(std::ifstream& inFileStream, OctreeNode& nod
         numStars = 0;
         createNodeChildren(node);
         for (const std::shared_ptr<OctreeNode>& child : node.children) {
-            numStars += readNodeFromFile(inFileStream, *child, readData);
+            numStars += readNodeFromFile(file, offset, *child, readData);
         }
     }
 
@@ -772,69 +894,138 @@ void OctreeManager::writeNodeToMultipleFiles(const std::string& outFilePrefix,
 void OctreeManager::fetchChildrenNodes(OctreeNode& parentNode,
                                        int additionalLevelsToFetch)
 {
-    // Lock node to make sure nobody else are trying to load the same children
-    const std::lock_guard lock(parentNode.loadingLock);
-
     for (const std::shared_ptr<OctreeNode>& child : parentNode.children) {
-        // Fetch node data if we're streaming and it doesn't exist in RAM yet.
-        // (As long as there is any RAM budget left and node actually has any data!)
-        if (!child->isLoaded && (child->numStars > 0) &&
-            _cpuRamBudget > static_cast<long long>(child->numStars
-                                                  * (POS_SIZE + COL_SIZE + VEL_SIZE) * 4))
-        {
-            fetchNodeDataFromFile(*child);
-        }
+        // Fetch node data if we're streaming and it doesn't exist in RAM yet
+        requestNodeData(*child);
 
         // Fetch all Children's Children if recursive is set to true
         if (additionalLevelsToFetch != 0 && !child->isLeaf) {
-            fetchChildrenNodes(*child, --additionalLevelsToFetch);
+            fetchChildrenNodes(*child, additionalLevelsToFetch - 1);
         }
     }
 }
 
-void OctreeManager::fetchNodeDataFromFile(OctreeNode& node) {
+void OctreeManager::requestNodeData(OctreeNode& node, ThreadPool::Priority priority,
+                                    long long budgetHeadroom)
+{
+    // Octree knows if we have any data in this node = it exists
+    if (node.isLoaded || node.numStars == 0 ||
+        _nodesInFlight.contains(node.octreePositionIndex))
+    {
+        return;
+    }
+
+    // Reserve the memory right away, so that the requests that are in flight can't
+    // exceed the RAM budget together
+    const long long nBytes = static_cast<long long>(
+        node.numStars * _valuesPerStar * sizeof(float)
+    );
+    if (_cpuRamBudget - budgetHeadroom <= nBytes) {
+        return;
+    }
+    _cpuRamBudget -= nBytes;
+    _nodesInFlight.insert(node.octreePositionIndex);
+
+    if (!_ioThreadPool) {
+        _ioThreadPool = std::make_unique<ThreadPool>(NumIOThreads);
+    }
+
     // Remove root ID ("8") from index before loading file
     std::string posId = std::to_string(node.octreePositionIndex);
     posId.erase(posId.begin());
-
-    const std::string inFilePath = std::format(
+    std::string inFilePath = std::format(
         "{}{}{}", _streamFolderPath, posId, BINARY_SUFFIX
     );
-    std::ifstream inFileStream(inFilePath, std::ifstream::binary);
-    // LINFO("Fetch node data file: " + inFilePath);
 
-    if (inFileStream.good()) {
-        // Read node data
-        int32_t nDataSize = 0;
+    LoadedNode loaded = {
+        .node = &node,
+        .octreePositionIndex = node.octreePositionIndex,
+        .generation = _generation
+    };
+    _ioThreadPool->enqueue(
+        [this, loaded = std::move(loaded), path = std::move(inFilePath)]() mutable {
+            std::shared_ptr<const MemoryMappedFile> file;
+            try {
+                file = std::make_shared<const MemoryMappedFile>(path);
+            }
+            catch (const ghoul::RuntimeError&) {
+                LERROR("Error opening node data file: " + path);
+            }
+
+            if (file) {
+                // Read node data
+                size_t offset = 0;
+                const int32_t nDataSize = readValue<int32_t>(*file, offset);
+
+                // The positions, colors, and velocities of all stars are stored one
+                // after another, so they can be referenced straight from the mapping.
+                // The pages are touched here so that they are not read from disk on the
+                // render thread when the node is uploaded
+                const size_t starsInNode = nDataSize / _valuesPerStar;
+                loaded.success = assignStarData(
+                    loaded,
+                    std::move(file),
+                    offset,
+                    starsInNode * POS_SIZE,
+                    starsInNode * COL_SIZE,
+                    starsInNode * VEL_SIZE
+                );
+                prefaultPages(loaded.mappedPosData);
+                prefaultPages(loaded.mappedColData);
+                prefaultPages(loaded.mappedVelData);
+                if (!loaded.success) {
+                    LERROR("Node data file is too small: " + path);
+                }
+            }
 
-        // Octree knows if we have any data in this node = it exists
-        // Otherwise don't call this function!
-        inFileStream.read(reinterpret_cast<char*>(&nDataSize), sizeof(int32_t));
+            const std::lock_guard lock(_loadedNodesMutex);
+            _loadedNodes.push_back(std::move(loaded));
+        },
+        priority
+    );
+}
 
-        std::vector<float> readData(nDataSize, 0.f);
-        const int nBytes = nDataSize * sizeof(float);
-        if (nDataSize > 0) {
-            inFileStream.read(reinterpret_cast<char*>(readData.data()), nBytes);
+void OctreeManager::processLoadedNodes() {
+    std::vector<LoadedNode> loadedNodes;
+    {
+        const std::lock_guard lock(_loadedNodesMutex);
+        std::swap(loadedNodes, _loadedNodes);
+    }
+
+    for (LoadedNode& loaded : loadedNodes) {
+        // The node belongs to an Octree that has been replaced in the meantime
+        if (loaded.generation != _generation) {
+            continue;
+        }
+        _nodesInFlight.erase(loaded.octreePositionIndex);
+
+        OctreeNode& node = *loaded.node;
+        if (!loaded.success) {
+            // Give back the budget that was reserved for the node
+            _cpuRamBudget += static_cast<long long>(
+                node.numStars * _valuesPerStar * sizeof(float)
+            );
+            continue;
         }
 
-        const int starsInNode = static_cast<int>(nDataSize / _valuesPerStar);
-        const auto posEnd = readData.begin() + (starsInNode * POS_SIZE);
-        const auto colEnd = posEnd + (starsInNode * COL_SIZE);
-        const auto velEnd = colEnd + (starsInNode * VEL_SIZE);
-        node.posData = std::vector<float>(readData.begin(), posEnd);
-        node.colData = std::vector<float>(posEnd, colEnd);
-        node.velData = std::vector<float>(colEnd, velEnd);
+        {
+            // Make sure nobody is checking the isLoaded flag while the data is swapped in
+            const std::lock_guard lock(node.loadingLock);
+            node.posData = std::move(loaded.posData);
+            node.colData = std::move(loaded.colData);
+            node.velData = std::move(loaded.velData);
+            node.mappedFile = std::move(loaded.mappedFile);
+            node.mappedPosData = loaded.mappedPosData;
+            node.mappedColData = loaded.mappedColData;
+            node.mappedVelData = loaded.mappedVelData;
+            node.isLoaded = true;
+        }
 
-        // Keep track of nodes that are loaded and update CPU RAM budget
-        node.isLoaded = true;
+        // Keep track of nodes that are loaded
         if (!_datasetFitInMemory) {
-            const std::lock_guard g(_leastRecentlyFetchedNodesMutex);
             _leastRecentlyFetchedNodes.push(node.octreePositionIndex);
+            updateLoadedDescendants(node.octreePositionIndex);
         }
-        _cpuRamBudget -= nBytes;
-    }
-    else {
-        LERROR("Error opening node data file: " + inFilePath);
     }
 }
 
@@ -844,6 +1035,7 @@ void OctreeManager::removeNodesFromRam(
     // LINFO("Removed " + std::to_string(nodesToRemove.size()) + " nodes from RAM");
 
     for (unsigned long long nodePosIndex : nodesToRemove) {
+        const unsigned long long octreePositionIndex = nodePosIndex;
         std::stack<int> indexStack;
         while (nodePosIndex != 8) {
             const int nodeIndex = nodePosIndex % 10;
@@ -853,66 +1045,84 @@ void OctreeManager::removeNodesFromRam(
 
         // Traverse to node and remove it.
         std::shared_ptr<OctreeNode> node = _root;
-        std::vector<std::shared_ptr<OctreeNode>> ancestors;
         while (!indexStack.empty()) {
-            ancestors.push_back(node);
             node = node->children[indexStack.top()];
             indexStack.pop();
         }
         removeNode(*node);
 
-        propagateUnloadedNodes(ancestors);
+        updateLoadedDescendants(octreePositionIndex);
     }
 }
 
 void OctreeManager::removeNode(OctreeNode& node) {
-    // Lock node to make sure nobody else is trying to access it while removing
-    const std::lock_guard lock(node.loadingLock);
+    // The same node can be in the queue of least recently fetched nodes more than once
+    if (!node.isLoaded) {
+        return;
+    }
 
-    const int nBytes = static_cast<int>(
-        node.numStars * _valuesPerStar * sizeof(node.posData[0])
+    const long long nBytes = static_cast<long long>(
+        node.numStars * _valuesPerStar * sizeof(float)
     );
-    // Keep track of which nodes that are loaded and update CPU RAM budget
-    node.isLoaded = false;
+
+    // The vectors and the mapped file are moved out of the node while it is locked, but
+    // their memory is released, or the file unmapped, on one of the IO threads
+    auto data = std::make_shared<std::array<std::vector<float>, 3>>();
+    std::shared_ptr<const MemoryMappedFile> mappedFile;
+    {
+        // Lock node to make sure nobody else is trying to access it while removing
+        const std::lock_guard lock(node.loadingLock);
+
+        // Keep track of which nodes that are loaded and update CPU RAM budget
+        node.isLoaded = false;
+        (*data)[0] = std::move(node.posData);
+        (*data)[1] = std::move(node.colData);
+        (*data)[2] = std::move(node.velData);
+        mappedFile = std::move(node.mappedFile);
+        node.mappedPosData = std::span<const float>();
+        node.mappedColData = std::span<const float>();
+        node.mappedVelData = std::span<const float>();
+    }
     _cpuRamBudget += nBytes;
 
-    // Clear data
-    node.posData.clear();
-    node.posData.shrink_to_fit();
-    node.colData.clear();
-    node.colData.shrink_to_fit();
-    node.velData.clear();
-    node.velData.shrink_to_fit();
+    if (_ioThreadPool) {
+        _ioThreadPool->enqueue(
+            [data, mappedFile]() mutable {
+                data = nullptr;
+                mappedFile = nullptr;
+            },
+            ThreadPool::Priority::Low
+        );
+    }
 }
 
-void OctreeManager::propagateUnloadedNodes(
-                                   std::vector<std::shared_ptr<OctreeNode>> ancestorNodes)
-{
-    std::shared_ptr<OctreeNode> parentNode = ancestorNodes.back();
-    while (parentNode->octreePositionIndex != 8) {
-        // Check if any children of inner node is still loaded, or has loaded descendants
-        if (parentNode->children[0]->isLoaded || parentNode->children[1]->isLoaded ||
-            parentNode->children[2]->isLoaded || parentNode->children[3]->isLoaded ||
-            parentNode->children[4]->isLoaded || parentNode->children[5]->isLoaded ||
-            parentNode->children[6]->isLoaded || parentNode->children[7]->isLoaded ||
-            parentNode->children[0]->hasLoadedDescendant ||
-            parentNode->children[1]->hasLoadedDescendant ||
-            parentNode->children[2]->hasLoadedDescendant ||
-            parentNode->children[3]->hasLoadedDescendant ||
-            parentNode->children[4]->hasLoadedDescendant ||
-            parentNode->children[5]->hasLoadedDescendant ||
-            parentNode->children[6]->hasLoadedDescendant ||
-            parentNode->children[7]->hasLoadedDescendant)
-        {
-            return;
-        }
-        // Else all children has been unloaded and we can update parent flag
-        parentNode->hasLoadedDescendant = false;
-        // LINFO("Removed ancestor: " + std::to_string(parentNode->octreePositionIndex));
+void OctreeManager::updateLoadedDescendants(unsigned long long octreePositionIndex) {
+    std::stack<int> indexStack;
+    while (octreePositionIndex != 8) {
+        indexStack.push(octreePositionIndex % 10);
+        octreePositionIndex /= 10;
+    }
+
+    // Collect all ancestors of the node, excluding the root
+    std::vector<OctreeNode*> ancestors;
+    OctreeNode* node = _root.get();
+    while (indexStack.size() > 1) {
+        node = node->children[indexStack.top()].get();
+        ancestors.push_back(node);
+        indexStack.pop();
+    }
 
-        // Propagate change upwards
-        ancestorNodes.pop_back();
-        parentNode = ancestorNodes.back();
+    // Propagate the change upwards, starting with the parent of the node
+    for (auto it = ancestors.rbegin(); it != ancestors.rend(); it++) {
+        OctreeNode& parentNode = **it;
+        parentNode.hasLoadedDescendant = std::all_of(
+            parentNode.children.begin(),
+            parentNode.children.end(),
+            [](const std::shared_ptr<OctreeNode>& child) {
+                return child->numStars == 0 || child->isLoaded ||
+                    child->hasLoadedDescendant;
+            }
+        );
     }
 }
 
@@ -1090,7 +1300,7 @@ std::string OctreeManager::printStarsPerNode(const OctreeNode& node,
         return str + " - [Leaf] \n";
     }
     else {
-        str += std::format("LOD: {} - [Parent]\n", node.posData.size() / POS_SIZE);
+        str += std::format("LOD: {} - [Parent]\n", node.positions().size() / POS_SIZE);
         for (int i = 0; i < 8; i++) {
             auto pref = prefix + "->" + std::to_string(i);
             str += printStarsPerNode(*node.children[i], pref);
@@ -1099,13 +1309,13 @@ std::string OctreeManager::printStarsPerNode(const OctreeNode& node,
     }
 }
 
-std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNode& node,
-                                                                    const glm::dmat4& mvp,
+OctreeManager::ChunkDataMap OctreeManager::checkNodeIntersection(OctreeNode& node,
+                                                                  const glm::dmat4& mvp,
                                                               const glm::vec2& screenSize,
-                                                                          int& deltaStars,
-                                                                    gaia::RenderMode mode)
+                                                                  int& deltaStars,
+                                                                  gaia::RenderMode mode)
 {
-    std::map<int, std::vector<float>> fetchedData;
+    ChunkDataMap fetchedData = createChunkDataMap();
 
     // Calculate the corners of the node
     std::vector<glm::dvec4> corners(8);
@@ -1140,11 +1350,28 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
         return fetchedData;
     }
 
+    // Visible nodes that aren't in RAM are requested with a higher priority than the
+    // nodes around the camera. Part of the budget is kept free for the latter, so that
+    // the nodes in view can't fill up the RAM on their own
+    const bool streamNodes = _streamOctree && !_datasetFitInMemory;
+    const long long budgetHeadroom = _maxCpuRamBudget / 10;
+    if (streamNodes && !node.isLoaded) {
+        requestNodeData(node, ThreadPool::Priority::High, budgetHeadroom);
+    }
+
     // Take care of inner nodes.
     if (!(node.isLeaf)) {
         const glm::vec2 nodeSize = _culler->getNodeSizeInPixels(corners, mvp, screenSize);
         const float totalPixels = nodeSize.x * nodeSize.y;
 
+        // The LOD data of a big inner node is only rendered while the data of its
+        // children is still on its way
+        if (streamNodes && node.isLoaded && totalPixels >= _minTotalPixelsLod) {
+            for (const std::shared_ptr<OctreeNode>& child : node.children) {
+                requestNodeData(*child, ThreadPool::Priority::High, budgetHeadroom);
+            }
+        }
+
         // Check if we should return any LOD cache data. If we're streaming a big dataset
         // from files and inner node is visible and loaded, then it should be rendered
         // (as long as it doesn't have loaded children because then we should traverse to
@@ -1162,19 +1389,12 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
 
                 // We're in an inner node, remove indices from potential children in cache
                 for (const std::shared_ptr<OctreeNode>& child : node.children) {
-                    std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                        *child,
-                        deltaStars
-                    );
-                    fetchedData.insert(tmpData.begin(), tmpData.end());
+                    mergeChunkData(fetchedData, removeNodeFromCache(*child, deltaStars));
                 }
 
-                // Insert data and adjust stars added in this frame.
-                fetchedData[node.bufferIndex] = constructInsertData(
-                    node,
-                    mode,
-                    deltaStars
-                );
+                // Insert node and adjust stars added in this frame.
+                fetchedData[node.bufferIndex] = &node;
+                deltaStars += static_cast<int>(node.numStars);
             }
             return fetchedData;
         }
@@ -1188,12 +1408,9 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
                 return fetchedData;
             }
 
-            // Insert data and adjust stars added in this frame.
-            fetchedData[node.bufferIndex] = constructInsertData(
-                node,
-                mode,
-                deltaStars
-            );
+            // Insert node and adjust stars added in this frame.
+            fetchedData[node.bufferIndex] = &node;
+            deltaStars += static_cast<int>(node.numStars);
         }
         return fetchedData;
     }
@@ -1206,23 +1423,19 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
     for (const std::shared_ptr<OctreeNode>& child : node.children) {
         // Observe that if there exists identical keys in fetchedData then those values in
         // tmpData will be ignored! Thus we store the removed keys until next render call
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
-            *child,
-            mvp,
-            screenSize,
-            deltaStars,
-            mode
+        mergeChunkData(
+            fetchedData,
+            checkNodeIntersection(*child, mvp, screenSize, deltaStars, mode)
         );
-        fetchedData.insert(tmpData.begin(), tmpData.end());
     }
     return fetchedData;
 }
 
-std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode& node,
-                                                                     int& deltaStars,
-                                                                     bool recursive)
+OctreeManager::ChunkDataMap OctreeManager::removeNodeFromCache(OctreeNode& node,
+                                                                int& deltaStars,
+                                                                bool recursive)
 {
-    std::map<int, std::vector<float>> keysToRemove;
+    ChunkDataMap keysToRemove = createChunkDataMap();
 
     // If we're in rebuilding mode then there is no need to remove any nodes
 
@@ -1233,7 +1446,7 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
         _removedKeysInPrevCall.insert(node.bufferIndex);
 
         // Insert dummy node at offset index that should be removed from render
-        keysToRemove[node.bufferIndex] = std::vector<float>();
+        keysToRemove[node.bufferIndex] = nullptr;
 
         // Reset index and adjust stars removed this frame
         node.bufferIndex = DEFAULT_INDEX;
@@ -1243,11 +1456,7 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
     // Check children recursively if we're in an inner node
     if (!(node.isLeaf) && recursive) {
         for (const std::shared_ptr<OctreeNode>& child : node.children) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *child,
-                deltaStars
-            );
-            keysToRemove.insert(tmpData.begin(), tmpData.end());
+            mergeChunkData(keysToRemove, removeNodeFromCache(*child, deltaStars));
         }
     }
     return keysToRemove;
@@ -1276,6 +1485,10 @@ void OctreeManager::clearNodeData(OctreeNode& node) {
     node.posData.clear();
     node.colData.clear();
     node.velData.clear();
+    node.mappedFile = nullptr;
+    node.mappedPosData = std::span<const float>();
+    node.mappedColData = std::span<const float>();
+    node.mappedVelData = std::span<const float>();
 
     // Clear magnitudes as well
     //std::vector<std::pair<float, size_t>>().swap(node->magOrder);
@@ -1368,17 +1581,20 @@ std::vector<float> OctreeManager::constructInsertData(const OctreeNode& node,
 
     // Fill chunk by appending zeroes to data so we overwrite possible earlier values
     // And more importantly so our attribute pointers knows where to read
-    auto insertData = std::vector<float>(node.posData.begin(), node.posData.end());
+    const std::span<const float> pos = node.positions();
+    auto insertData = std::vector<float>(pos.begin(), pos.end());
     if (_useVBO) {
         insertData.resize(POS_SIZE * MAX_STARS_PER_NODE, 0.f);
     }
     if (mode != gaia::RenderMode::Static) {
-        insertData.insert(insertData.end(), node.colData.begin(), node.colData.end());
+        const std::span<const float> col = node.colors();
+        insertData.insert(insertData.end(), col.begin(), col.end());
         if (_useVBO) {
             insertData.resize((POS_SIZE + COL_SIZE) * MAX_STARS_PER_NODE, 0.f);
         }
         if (mode == gaia::RenderMode::Motion) {
-            insertData.insert(insertData.end(), node.velData.begin(), node.velData.end());
+            const std::span<const float> vel = node.velocities();
+            insertData.insert(insertData.end(), vel.begin(), vel.end());
             if (_useVBO) {
                 insertData.resize(
                     (POS_SIZE + COL_SIZE + VEL_SIZE) * MAX_STARS_PER_NODE, 0.f
@@ -26,18 +26,23 @@
 #define __OPENSPACE_MODULE_GAIA___OCTREEMANAGER___H__
 
 #include <modules/gaia/rendering/gaiaoptions.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <array>
 #include <filesystem>
 #include <map>
+#include <memory_resource>
 #include <mutex>
 #include <queue>
+#include <span>
 #include <stack>
+#include <unordered_set>
 #include <vector>
 
 namespace openspace {
 
+class MemoryMappedFile;
 class OctreeCuller;
 
 class OctreeManager {
@@ -59,8 +64,50 @@ public:
         std::mutex loadingLock;
         int bufferIndex;
         unsigned long long octreePositionIndex;
+
+        // If the star data was read from a memory-mapped file, it is referenced in place
+        // instead of being copied into posData, colData, and velData. The node keeps the
+        // file mapped for as long as it references the data
+        std::shared_ptr<const MemoryMappedFile> mappedFile;
+        std::span<const float> mappedPosData;
+        std::span<const float> mappedColData;
+        std::span<const float> mappedVelData;
+
+        /**
+         * \return The positions of all stars in the node, regardless of whether they are
+         *         owned by the node or referenced from a mapped file
+         */
+        std::span<const float> positions() const {
+            return mappedFile ? mappedPosData : std::span<const float>(posData);
+        }
+
+        /**
+         * \return The colors of all stars in the node, regardless of whether they are
+         *         owned by the node or referenced from a mapped file
+         */
+        std::span<const float> colors() const {
+            return mappedFile ? mappedColData : std::span<const float>(colData);
+        }
+
+        /**
+         * \return The velocities of all stars in the node, regardless of whether they
+         *         are owned by the node or referenced from a mapped file
+         */
+        std::span<const float> velocities() const {
+            return mappedFile ? mappedVelData : std::span<const float>(velData);
+        }
     };
 
+    // Maps the index of a chunk in the streaming buffer to the node whose data should be
+    // written into it. A `nullptr` marks a chunk that is no longer in use
+#if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
+    using ChunkDataMap = std::map<int, const OctreeNode*>;
+#else
+    // The map is only used for a single frame, so its nodes are allocated from the
+    // frame-based temporary memory
+    using ChunkDataMap = std::pmr::map<int, const OctreeNode*>;
+#endif
+
     OctreeManager() = default;
     ~OctreeManager() = default;
 
@@ -84,6 +131,19 @@ public:
      */
     void insert(const std::vector<float>& starValues);
 
+    /**
+     * \return The index of the child of the root node, i.e. the branch, that a star with
+     *         the provided position is inserted into
+     */
+    static size_t branchIndex(float posX, float posY, float posZ);
+
+    /**
+     * Swaps the branch with index \p branchIndex between this Octree and \p other, so
+     * that both trees stay valid. Used to merge branches that have been constructed
+     * independently of each other into a single Octree.
+     */
+    void swapBranch(size_t branchIndex, OctreeManager& other);
+
     /**
      * Slices LOD data so only the MAX_STARS_PER_NODE brightest stars are stored in inner
      * nodes. If \p branchIndex is defined then only that branch will be sliced. Calls
@@ -110,12 +170,13 @@ public:
 
     /**
      * Builds render data structure by traversing the Octree and checking for intersection
-     * with view frustum. Every vector in map contains data for one node. The
-     * corresponding integer key is the index where chunk should be inserted into
-     * streaming buffer. Calls #checkNodeIntersection for every branch. \p deltaStars
+     * with view frustum. Every entry in the map points to the node whose data should be
+     * written into the streaming buffer at the chunk index of the key. The data is not
+     * copied, so the nodes are only valid until the next call. Calls
+     * #checkNodeIntersection for every branch. \p deltaStars
      * keeps track of how many stars that were added/removed this render call.
      */
-    std::map<int, std::vector<float>> traverseData(const glm::dmat4& mvp,
+    ChunkDataMap traverseData(const glm::dmat4& mvp,
         const glm::vec2& screenSize, int& deltaStars, gaia::RenderMode mode,
         float lodPixelThreshold);
 
@@ -142,15 +203,17 @@ public:
     void writeToFile(std::ofstream& outFileStream, bool writeData);
 
     /**
-     * Read a constructed Octree from a file.
+     * Read a constructed Octree from a memory-mapped file. If the full data is read, the
+     * nodes reference their star data in place whenever it is suitably aligned within
+     * the file and copy it otherwise.
      *
-     * \param inFileStream the stream from which the octree should be loaded
+     * \param file the mapped file from which the octree should be loaded
      * \param readData defines if full data or only structure should be read.
      *        Calls `readNodeFromFile()` which recursively reads all nodes
      * \param folderPath the path to the folder where the binary files are located
      * \return the total number of (distinct) stars read
      */
-    int readFromFile(std::ifstream& inFileStream, bool readData,
+    int readFromFile(std::shared_ptr<const MemoryMappedFile> file, bool readData,
         const std::filesystem::path& folderPath = std::filesystem::path());
 
     /**
@@ -250,9 +313,8 @@ private:
      *        call
      * \param mode the render mode that should be used
      */
-    std::map<int, std::vector<float>> checkNodeIntersection(OctreeNode& node,
-        const glm::dmat4& mvp, const glm::vec2& screenSize, int& deltaStars,
-        gaia::RenderMode mode);
+    ChunkDataMap checkNodeIntersection(OctreeNode& node, const glm::dmat4& mvp,
+        const glm::vec2& screenSize, int& deltaStars, gaia::RenderMode mode);
 
     /**
      * Checks if specified node existed in cache, and removes it if that's the case.
@@ -263,8 +325,8 @@ private:
      * \param deltaStars keeps track of how many stars that were removed.
      * \param recursive defines if decentents should be removed as well
      */
-    std::map<int, std::vector<float>> removeNodeFromCache(OctreeNode& node,
-        int& deltaStars, bool recursive = true);
+    ChunkDataMap removeNodeFromCache(OctreeNode& node, int& deltaStars,
+        bool recursive = true);
 
     /**
      * Get data in node and its descendants regardless if they are visible or not.
@@ -314,12 +376,15 @@ private:
     /**
      * Read a node from file and its potential children.
      *
-     * \param inFileStream the stream from which the node will be read
+     * \param file the mapped file from which the node will be read
+     * \param offset the position of the node in the file, which is advanced past the
+     *        node and its descendants
      * \param node the file will be read into this node
      * \param readData defines if full data or only structure should be read
      * \return accumulated sum of all read stars in node and its descendants.
      */
-    int readNodeFromFile(std::ifstream& inFileStream, OctreeNode& node, bool readData);
+    int readNodeFromFile(const std::shared_ptr<const MemoryMappedFile>& file,
+        size_t& offset, OctreeNode& node, bool readData);
 
     /**
      * Write node data to a file.
@@ -348,28 +413,40 @@ private:
         int additionalLevelsToFetch);
 
     /**
-     * Fetches data from all children of the \p parentNode, as long as it's not already
-     * fetched, it exists and it can fit in RAM.
+     * Requests the data of all children of the \p parentNode, as long as it's not
+     * already fetched, it exists and it can fit in RAM.
      *
      * \param parentNode the node whose children should be fetched
      * \param additionalLevelsToFetch determines how many levels of descendants to fetch.
      *        If it is set to 0 no additional level will be fetched. If it is set to a
      *        negative value then all descendants will be fetched recursively. Calls
-     *        #fetchNodeDataFromFile for every child that passes the tests
+     *        #requestNodeData for every child
      */
     void fetchChildrenNodes(OctreeNode& parentNode, int additionalLevelsToFetch);
 
     /**
-     * Fetches data for specified node from file.
-     * OBS! Only call if node file exists (i.e. node has any data, node->numStars > 0)
-     * and is not already loaded.
+     * Requests the data of the \p node to be read from its file on one of the IO threads.
+     * Nothing happens if the node doesn't have any data, is already loaded or requested,
+     * or if it doesn't fit in the RAM budget. The budget for the node is reserved right
+     * away and the data is handed to the node in #processLoadedNodes. Requests with a
+     * higher \p priority are read first. If \p budgetHeadroom is specified, the node is
+     * only requested if at least that many bytes of the budget remain afterwards.
+     */
+    void requestNodeData(OctreeNode& node,
+        ThreadPool::Priority priority = ThreadPool::Priority::Normal,
+        long long budgetHeadroom = 0);
+
+    /**
+     * Hands the data of all nodes that finished loading on the IO threads to their nodes
+     * and updates the `hasLoadedDescendant` flags of their ancestors. Has to be called
+     * from the thread that traverses the Octree.
      */
-    void fetchNodeDataFromFile(OctreeNode& node);
+    void processLoadedNodes();
 
     /**
-    * Loops though all nodes in \p nodesToRemove and clears them from RAM. Also checks if
-    * any ancestor should change the `hasLoadedDescendant` flag by calling
-    * #propagateUnloadedNodes() with all ancestors.
+    * Loops though all nodes in \p nodesToRemove and clears them from RAM. Also updates
+    * the `hasLoadedDescendant` flag of all their ancestors by calling
+    * #updateLoadedDescendants.
     *
     * \param nodesToRemove list of the nodes that should be deleted
     */
@@ -377,25 +454,46 @@ private:
 
     /**
      * Removes data in specified node from main memory and updates RAM budget and flags
-     * accordingly.
+     * accordingly. The memory itself is released on one of the IO threads.
      */
     void removeNode(OctreeNode& node);
 
     /**
-     * Loops through \p ancestorNodes backwards and checks if parent node has any
-     * loaded descendants left. If not, then flag `hasLoadedDescendant` will be
-     * set to false for that parent node and next parent in line will be checked.
-     *
-     * \param ancestorNodes the list of ancestors that should be checked
+     * Updates the `hasLoadedDescendant` flags of all ancestors of the node with the
+     * \p octreePositionIndex, starting with its parent. An inner node only has loaded
+     * descendants once all of its children that contain stars are either loaded or have
+     * loaded descendants themselves, so that the LOD data of the inner node is rendered
+     * until the data of all of its children has arrived.
      */
-    void propagateUnloadedNodes(std::vector<std::shared_ptr<OctreeNode>> ancestorNodes);
+    void updateLoadedDescendants(unsigned long long octreePositionIndex);
 
     std::shared_ptr<OctreeNode> _root;
     std::unique_ptr<OctreeCuller> _culler;
     std::stack<int> _freeSpotsInBuffer;
     std::set<int> _removedKeysInPrevCall;
     std::queue<unsigned long long> _leastRecentlyFetchedNodes;
-    std::mutex _leastRecentlyFetchedNodesMutex;
+
+    /// The data of a node that was read from its file on one of the IO threads
+    struct LoadedNode {
+        OctreeNode* node = nullptr;
+        unsigned long long octreePositionIndex = 0;
+        std::vector<float> posData;
+        std::vector<float> colData;
+        std::vector<float> velData;
+        std::shared_ptr<const MemoryMappedFile> mappedFile;
+        std::span<const float> mappedPosData;
+        std::span<const float> mappedColData;
+        std::span<const float> mappedVelData;
+        bool success = false;
+        int generation = 0;
+    };
+    /// The position indices of all nodes whose data is currently being read
+    std::unordered_set<unsigned long long> _nodesInFlight;
+    std::vector<LoadedNode> _loadedNodes;
+    std::mutex _loadedNodesMutex;
+    /// Incremented whenever the Octree is rebuilt, so that nodes that are loaded for a
+    /// previous Octree are discarded
+    int _generation = 0;
 
     size_t _totalDepth = 0;
     size_t _numLeafNodes = 0;
@@ -415,6 +513,10 @@ private:
     std::filesystem::path _streamFolderPath;
     size_t _traversedBranchesInRenderCall = 0;
 
+    // The IO threads are declared last so that they are stopped before any of the data
+    // they are writing to is destroyed
+    std::unique_ptr<ThreadPool> _ioThreadPool;
+
 }; // class OctreeManager
 
 }  // namespace openspace
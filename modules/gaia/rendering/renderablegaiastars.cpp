@@ -34,18 +34,26 @@
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/util/distanceconversion.h>
+#include <openspace/util/memorymappedfile.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/format.h>
 #include <ghoul/io/texture/texturereader.h>
+#include <ghoul/misc/exception.h>
 #include <ghoul/misc/templatefactory.h>
 #include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/shaderobject.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <array>
-#include <fstream>
 #include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderableGaiaStars";
@@ -54,6 +62,104 @@ namespace {
     constexpr size_t ColorSize = 2;
     constexpr size_t VelocitySize = 3;
 
+    // The maximum time we are willing to wait for the GPU to finish reading from the
+    // streaming buffers before we overwrite parts of them
+    constexpr GLuint64 FenceTimeout = 1'000'000'000; // 1s in nanoseconds
+
+    using OctreeNode = openspace::OctreeManager::OctreeNode;
+
+    // The number of invocations in a work group of the culling compute shader. Keep in
+    // sync with gaia_cull_cs.glsl
+    constexpr int CullWorkGroupSize = 64;
+
+    /**
+     * Returns the position, color, and velocity values of the \p node in the order in
+     * which they are stored in a chunk. Values that are not used by the render \p mode,
+     * or all values if there is no \p node, are left empty.
+     */
+    std::array<std::span<const float>, 3> nodeValues(const OctreeNode* node,
+                                                     openspace::gaia::RenderMode mode)
+    {
+        std::array<std::span<const float>, 3> values;
+        if (!node) {
+            return values;
+        }
+
+        values[0] = node->positions();
+        if (mode != openspace::gaia::RenderMode::Static) {
+            values[1] = node->colors();
+        }
+        if (mode == openspace::gaia::RenderMode::Motion) {
+            values[2] = node->velocities();
+        }
+        return values;
+    }
+
+    /**
+     * Creates a buffer with immutable storage of \p size bytes that stays mapped for
+     * writing for its entire lifetime. As the storage can't be respecified, a previously
+     * existing \p buffer is deleted first.
+     */
+    template <typename T = float>
+    T* createMappedBuffer(GLuint& buffer, GLenum target, long long size) {
+        if (buffer != 0) {
+            glDeleteBuffers(1, &buffer);
+        }
+        glGenBuffers(1, &buffer);
+        glBindBuffer(target, buffer);
+
+        constexpr GLbitfield Flags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        const GLsizeiptr s = std::max(static_cast<GLsizeiptr>(size), GLsizeiptr(1));
+        glBufferStorage(target, s, nullptr, Flags);
+        void* data = glMapBufferRange(target, 0, s, Flags);
+        glBindBuffer(target, 0);
+        return static_cast<T*>(data);
+    }
+
+    template <typename T>
+    void deleteMappedBuffer(GLuint& buffer, T*& mappedData) {
+        // Deleting the buffer also unmaps it
+        if (buffer != 0) {
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+        mappedData = nullptr;
+    }
+
+    /**
+     * Copies the \p values into the chunk and fills the remainder with zeros, so that
+     * possible earlier values are overwritten and the attribute pointers know where to
+     * read.
+     */
+    void writeChunk(float* chunk, size_t chunkSize, std::span<const float> values) {
+        const size_t n = std::min(values.size(), chunkSize);
+        std::copy_n(values.begin(), n, chunk);
+        std::fill(chunk + n, chunk + chunkSize, 0.f);
+    }
+
+    /**
+     * Same as writeChunk, but for the buffer that is bound to GL_ARRAY_BUFFER. The
+     * \p zeros have to be at least as big as the chunk.
+     */
+    void uploadChunk(int chunkIndex, size_t chunkSize, std::span<const float> values,
+                     std::span<const float> zeros)
+    {
+        const size_t n = std::min(values.size(), chunkSize);
+        const GLintptr offset = chunkIndex * chunkSize * sizeof(GLfloat);
+        if (n > 0) {
+            glBufferSubData(GL_ARRAY_BUFFER, offset, n * sizeof(GLfloat), values.data());
+        }
+        if (n < chunkSize) {
+            glBufferSubData(
+                GL_ARRAY_BUFFER,
+                offset + n * sizeof(GLfloat),
+                (chunkSize - n) * sizeof(GLfloat),
+                zeros.data()
+            );
+        }
+    }
+
     constexpr openspace::properties::Property::PropertyInfo FilePathInfo = {
         "File",
         "File Path",
@@ -331,6 +437,28 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo GpuCullingInfo = {
+        "GpuCulling",
+        "GPU Culling",
+        "If enabled, the chunks in the streaming buffer are culled against the view "
+        "frustum in a compute shader and only the stars of the visible chunks are drawn. "
+        "The octree is then only traversed on the CPU to decide which nodes are kept in "
+        "the buffer, see 'ResidencyUpdateInterval'. This is only used with the VBO "
+        "shader options and requires OpenGL 4.4.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ResidencyUpdateIntervalInfo =
+    {
+        "ResidencyUpdateInterval",
+        "Residency Update Interval",
+        "The number of frames between two traversals of the octree on the CPU if GPU "
+        "culling is used. The octree is traversed earlier if the culling finds a "
+        "visible node that should be replaced by its children. A value of 1 traverses "
+        "the octree every frame.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     struct [[codegen::Dictionary(RenderableGaiaStars)]] Parameters {
         // [[codegen::verbatim(FilePathInfo.description)]]
         std::string file;
@@ -437,6 +565,12 @@ namespace {
 
         // [codegen::verbatim(ReportGlErrorsInfo.description)]]
         std::optional<bool> reportGlErrors;
+
+        // [[codegen::verbatim(GpuCullingInfo.description)]]
+        std::optional<bool> gpuCulling;
+
+        // [[codegen::verbatim(ResidencyUpdateIntervalInfo.description)]]
+        std::optional<int> residencyUpdateInterval [[codegen::inrange(1, 60)]];
     };
 #include "renderablegaiastars_codegen.cpp"
 }  // namespace
@@ -484,6 +618,8 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     , _maxGpuMemoryPercent(MaxGpuMemoryPercentInfo, 0.45f, 0.f, 1.f)
     , _maxCpuMemoryPercent(MaxCpuMemoryPercentInfo, 0.5f, 0.f, 1.f)
     , _reportGlErrors(ReportGlErrorsInfo, false)
+    , _gpuCulling(GpuCullingInfo, true)
+    , _residencyUpdateInterval(ResidencyUpdateIntervalInfo, 4, 1, 60)
     , _accumulatedIndices(1, 0)
 {
     using File = ghoul::filesystem::File;
@@ -584,6 +720,7 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     _maxGpuMemoryPercent.onChange([this]() {
         if (_ssboData != 0) {
             glDeleteBuffers(1, &_ssboData);
+            _mappedSsboData = nullptr;
             glGenBuffers(1, &_ssboData);
             LDEBUG(std::format(
                 "Re-generating Data Shader Storage Buffer Object id '{}'", _ssboData
@@ -661,6 +798,13 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     _reportGlErrors = p.reportGlErrors.value_or(_reportGlErrors);
     addProperty(_reportGlErrors);
 
+    _gpuCulling = p.gpuCulling.value_or(_gpuCulling);
+    addProperty(_gpuCulling);
+
+    _residencyUpdateInterval =
+        p.residencyUpdateInterval.value_or(_residencyUpdateInterval);
+    addProperty(_residencyUpdateInterval);
+
     // Add a read-only property for the number of rendered stars per frame.
     _nRenderedStars.setReadOnly(true);
     addProperty(_nRenderedStars);
@@ -680,6 +824,9 @@ void RenderableGaiaStars::initializeGL() {
     //using IgnoreError = ghoul::opengl::ProgramObject::IgnoreError;
     //_program->setIgnoreUniformLocationError(IgnoreError::Yes);
 
+    _streamingMemory = trackedAllocation("Gaia", MemoryTracker::Type::Vram);
+    _octreeMemory = trackedAllocation("Gaia", MemoryTracker::Type::Ram);
+
     // Add common properties to menu.
     addProperty(_colorTexturePath);
     addProperty(_luminosityMultiplier);
@@ -687,11 +834,51 @@ void RenderableGaiaStars::initializeGL() {
     addProperty(_lodPixelThreshold);
     addProperty(_maxGpuMemoryPercent);
 
+    // Persistently mapped buffers were introduced in OpenGL 4.4
+    using Version = ghoul::systemcapabilities::Version;
+    constexpr Version PersistentMappingVersion = { .major = 4, .minor = 4, .release = 0 };
+    _isUsingPersistentMapping = OpenGLCap.openGLVersion() >= PersistentMappingVersion;
+
+#ifndef __APPLE__
+    // The culling compute shader reads the chunk bounds from a mapped buffer
+    if (_isUsingPersistentMapping) {
+        using namespace ghoul::opengl;
+        _programCull = std::make_unique<ProgramObject>("GaiaCull");
+        _programCull->attachObject(std::make_unique<ShaderObject>(
+            ShaderObject::ShaderType::Compute,
+            absPath("${MODULE_GAIA}/shaders/gaia_cull_cs.glsl"),
+            "GaiaCull Compute"
+        ));
+        _programCull->compileShaderObjects();
+        _programCull->linkProgramObject();
+
+        _uniformCacheCull.nodeToClip = _programCull->uniformLocation("nodeToClip");
+        _uniformCacheCull.screenSize = _programCull->uniformLocation("screenSize");
+        _uniformCacheCull.nChunks = _programCull->uniformLocation("nChunks");
+        _uniformCacheCull.maxStarsPerNode =
+            _programCull->uniformLocation("maxStarsPerNode");
+        _uniformCacheCull.lodPixelThreshold =
+            _programCull->uniformLocation("lodPixelThreshold");
+
+        // The refinement request is written by the GPU and read back by the CPU
+        constexpr GLbitfield Flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT |
+            GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &_ssboRefinement);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _ssboRefinement);
+        glBufferStorage(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), nullptr, Flags);
+        _mappedRefinement = static_cast<GLuint*>(
+            glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), Flags)
+        );
+        *_mappedRefinement = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+#endif // !__APPLE__
+
     // Construct shader program depending on user-defined shader option.
     const int option = _shaderOption;
     switch (option) {
         case gaia::ShaderOption::PointSSBO:
-            _program = ghoul::opengl::ProgramObject::Build(
+            _program = global::renderEngine->buildCachedProgram(
                 "GaiaStar",
                 absPath("${MODULE_GAIA}/shaders/gaia_ssbo_vs.glsl"),
                 absPath("${MODULE_GAIA}/shaders/gaia_point_fs.glsl"),
@@ -718,7 +905,7 @@ void RenderableGaiaStars::initializeGL() {
             addProperty(_tmPointPixelWeightThreshold);
             break;
         case gaia::ShaderOption::PointVBO:
-            _program = ghoul::opengl::ProgramObject::Build(
+            _program = global::renderEngine->buildCachedProgram(
                 "GaiaStar",
                 absPath("${MODULE_GAIA}/shaders/gaia_vbo_vs.glsl"),
                 absPath("${MODULE_GAIA}/shaders/gaia_point_fs.glsl"),
@@ -741,7 +928,7 @@ void RenderableGaiaStars::initializeGL() {
             addProperty(_tmPointPixelWeightThreshold);
             break;
         case gaia::ShaderOption::BillboardSSBO:
-            _program = ghoul::opengl::ProgramObject::Build(
+            _program = global::renderEngine->buildCachedProgram(
                 "GaiaStar",
                 absPath("${MODULE_GAIA}/shaders/gaia_ssbo_vs.glsl"),
                 absPath("${MODULE_GAIA}/shaders/gaia_billboard_fs.glsl"),
@@ -799,7 +986,7 @@ void RenderableGaiaStars::initializeGL() {
             addProperty(_closeUpBoostDist);
             break;
         case gaia::ShaderOption::BillboardVBO:
-            _program = ghoul::opengl::ProgramObject::Build(
+            _program = global::renderEngine->buildCachedProgram(
                 "GaiaStar",
                 absPath("${MODULE_GAIA}/shaders/gaia_vbo_vs.glsl"),
                 absPath("${MODULE_GAIA}/shaders/gaia_billboard_fs.glsl"),
@@ -892,6 +1079,30 @@ void RenderableGaiaStars::initializeGL() {
 }
 
 void RenderableGaiaStars::deinitializeGL() {
+    _streamingMemory = MemoryTracker::Allocation();
+    _octreeMemory = MemoryTracker::Allocation();
+
+    if (_bufferFence) {
+        glDeleteSync(_bufferFence);
+        _bufferFence = nullptr;
+    }
+    _mappedPos = nullptr;
+    _mappedCol = nullptr;
+    _mappedVel = nullptr;
+    _mappedSsboData = nullptr;
+
+    if (_cullFence) {
+        glDeleteSync(_cullFence);
+        _cullFence = nullptr;
+    }
+    deleteMappedBuffer(_ssboChunkBounds, _mappedChunkBounds);
+    deleteMappedBuffer(_ssboRefinement, _mappedRefinement);
+    if (_indirectBuffer != 0) {
+        glDeleteBuffers(1, &_indirectBuffer);
+        _indirectBuffer = 0;
+    }
+    _programCull = nullptr;
+
     if (_vboPos != 0) {
         glDeleteBuffers(1, &_vboPos);
         _vboPos = 0;
@@ -979,16 +1190,44 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         _cpuRamBudgetProperty = static_cast<float>(_octreeManager.cpuRamBudget());
     }
 
+    // With GPU culling the chunks outside of the view are never drawn, so the Octree only
+    // has to be traversed to update which nodes are stored in the buffer. This is done
+    // in an interval, or earlier if the culling has found a node that is too coarse
+    const bool useGpuCulling = _gpuCulling && _programCull && _mappedChunkBounds;
+    bool shouldTraverse = true;
+    if (useGpuCulling) {
+        if (_cullFence) {
+            const GLenum status = glClientWaitSync(_cullFence, 0, 0);
+            if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+                glDeleteSync(_cullFence);
+                _cullFence = nullptr;
+                _gpuRequestedRefinement |= (*_mappedRefinement != 0);
+                *_mappedRefinement = 0;
+            }
+        }
+
+        _nFramesSinceTraversal++;
+        shouldTraverse = _gpuRequestedRefinement ||
+                         _nFramesSinceTraversal >= _residencyUpdateInterval;
+    }
+    if (shouldTraverse) {
+        _nFramesSinceTraversal = 0;
+        _gpuRequestedRefinement = false;
+    }
+
     // Traverse Octree and build a map with new nodes to render, uses mvp matrix to decide
     const int renderOption = _renderMode;
+    const gaia::RenderMode renderMode = gaia::RenderMode(renderOption);
     int deltaStars = 0;
-    const std::map<int, std::vector<float>> updateData = _octreeManager.traverseData(
-        modelViewProjMat,
-        screenSize,
-        deltaStars,
-        gaia::RenderMode(renderOption),
-        _lodPixelThreshold
-    );
+    const OctreeManager::ChunkDataMap updateData = shouldTraverse ?
+        _octreeManager.traverseData(
+            modelViewProjMat,
+            screenSize,
+            deltaStars,
+            renderMode,
+            _lodPixelThreshold
+        ) :
+        OctreeManager::ChunkDataMap();
 
     // Update number of rendered stars.
     _nStarsToRender += deltaStars;
@@ -1001,6 +1240,14 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
     const int maxStarsPerNode = static_cast<int>(_octreeManager.maxStarsPerNode());
     const int valuesPerStar = static_cast<int>(_nRenderValuesPerStar);
 
+    // Make sure that the GPU has finished rendering the previous frame before we write
+    // into the persistently mapped buffers, as some of the chunks might be overwritten
+    if (_bufferFence && !updateData.empty()) {
+        glClientWaitSync(_bufferFence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+        glDeleteSync(_bufferFence);
+        _bufferFence = nullptr;
+    }
+
     // Switch rendering technique depending on user-defined shader option.
     const int shaderOption = _shaderOption;
     if (shaderOption == gaia::ShaderOption::BillboardSSBO ||
@@ -1015,7 +1262,7 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         _accumulatedIndices.resize(nChunksToRender + 1, lastValue);
 
         // Update vector with accumulated indices.
-        for (const auto& [offset, subData] : updateData) {
+        for (const auto& [offset, node] : updateData) {
             if (offset >= _accumulatedIndices.size() - 1) {
                 // @TODO(2023-03-08, alebo) We want to redo the whole rendering pipeline
                 // anyway, so right now we just bail out early if we get an invalid index
@@ -1023,9 +1270,8 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
                 continue;
             }
 
-            const int newValue =
-                static_cast<int>(subData.size() / _nRenderValuesPerStar) +
-                    _accumulatedIndices[offset];
+            const int nStars = node ? static_cast<int>(node->numStars) : 0;
+            const int newValue = nStars + _accumulatedIndices[offset];
             const int changeInValue = newValue - _accumulatedIndices[offset + 1];
             _accumulatedIndices[offset + 1] = newValue;
             // Propagate change.
@@ -1050,28 +1296,51 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
             GL_STREAM_DRAW
         );
 
-        // Use orphaning strategy for data SSBO.
-        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _ssboData);
+        // Update SSBO with one insert per chunk/node. The key in map holds the offset
+        // index. We don't need to fill chunk with zeros for SSBOs!
+        if (_mappedSsboData) {
+            const size_t nChunksInBuffer =
+                _maxStreamingBudgetInBytes / (_chunkSize * sizeof(GLfloat));
+            for (const auto& [offset, node] : updateData) {
+                if (!node || static_cast<size_t>(offset) >= nChunksInBuffer) {
+                    continue;
+                }
 
-        glBufferData(
-            GL_SHADER_STORAGE_BUFFER,
-            _maxStreamingBudgetInBytes,
-            nullptr,
-            GL_STREAM_DRAW
-        );
+                float* chunk = _mappedSsboData + offset * _chunkSize;
+                for (std::span<const float> values : nodeValues(node, renderMode)) {
+                    chunk = std::copy(values.begin(), values.end(), chunk);
+                }
+            }
+        }
+        else {
+            // Use orphaning strategy for data SSBO.
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, _ssboData);
 
-        // Update SSBO with one insert per chunk/node.
-        // The key in map holds the offset index.
-        for (const auto& [offset, subData] : updateData) {
-            // We don't need to fill chunk with zeros for SSBOs!
-            // Just check if we have any values to update.
-            if (!subData.empty()) {
-                glBufferSubData(
-                    GL_SHADER_STORAGE_BUFFER,
-                    offset * _chunkSize * sizeof(GLfloat),
-                    subData.size() * sizeof(GLfloat),
-                    subData.data()
-                );
+            glBufferData(
+                GL_SHADER_STORAGE_BUFFER,
+                _maxStreamingBudgetInBytes,
+                nullptr,
+                GL_STREAM_DRAW
+            );
+
+            for (const auto& [offset, node] : updateData) {
+                if (!node) {
+                    continue;
+                }
+
+                GLintptr chunkOffset = offset * _chunkSize * sizeof(GLfloat);
+                for (std::span<const float> values : nodeValues(node, renderMode)) {
+                    if (values.empty()) {
+                        continue;
+                    }
+                    glBufferSubData(
+                        GL_SHADER_STORAGE_BUFFER,
+                        chunkOffset,
+                        values.size_bytes(),
+                        values.data()
+                    );
+                    chunkOffset += values.size_bytes();
+                }
             }
         }
 
@@ -1082,79 +1351,101 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         //---------------------- RENDER WITH VBO -----------------------------
         // Update VBOs with new nodes.
         // This will overwrite old data that's not visible anymore as well.
-        glBindVertexArray(_vao);
-
-        // Always update Position VBO.
-        glBindBuffer(GL_ARRAY_BUFFER, _vboPos);
-        const float posMemoryShare =
-            static_cast<float>(PositionSize) / _nRenderValuesPerStar;
         const size_t posChunkSize = maxStarsPerNode * PositionSize;
-        const long long posStreamingBudget = static_cast<long long>(
-            _maxStreamingBudgetInBytes * posMemoryShare
-        );
+        const size_t colChunkSize = maxStarsPerNode * ColorSize;
+        const size_t velChunkSize = maxStarsPerNode * VelocitySize;
+
+        if (_isUsingPersistentMapping) {
+            // Update the mapped buffers with one insert per chunk/node. The key in map
+            // holds the offset index. Removed nodes will clear their chunk
+            const size_t nChunksInBuffer =
+                _maxStreamingBudgetInBytes / (_chunkSize * sizeof(GLfloat));
+            for (const auto& [offset, node] : updateData) {
+                if (static_cast<size_t>(offset) >= nChunksInBuffer) {
+                    continue;
+                }
 
-        // Use buffer orphaning to update a subset of total data.
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            posStreamingBudget,
-            nullptr,
-            GL_STREAM_DRAW
-        );
+                const auto [pos, col, vel] = nodeValues(node, renderMode);
+                writeChunk(_mappedPos + offset * posChunkSize, posChunkSize, pos);
+                if (_mappedCol) {
+                    writeChunk(_mappedCol + offset * colChunkSize, colChunkSize, col);
+                }
+                if (_mappedVel) {
+                    writeChunk(_mappedVel + offset * velChunkSize, velChunkSize, vel);
+                }
 
-        // Update buffer with one insert per chunk/node.
-        //The key in map holds the offset index.
-        for (const auto& [offset, subData] : updateData) {
-            // Fill chunk by appending zeroes so we overwrite possible earlier values.
-            // Only required when removing nodes because chunks are filled up in octree
-            // fetch on add.
-            std::vector<float> vectorData(subData.begin(), subData.end());
-            vectorData.resize(posChunkSize, 0.f);
-            glBufferSubData(
-                GL_ARRAY_BUFFER,
-                offset * posChunkSize * sizeof(GLfloat),
-                posChunkSize * sizeof(GLfloat),
-                vectorData.data()
-            );
+                if (_mappedChunkBounds) {
+                    ChunkBounds bounds;
+                    if (node) {
+                        bounds.origin = glm::vec3(
+                            node->originX,
+                            node->originY,
+                            node->originZ
+                        );
+                        bounds.halfDimension = node->halfDimension;
+                        bounds.nStars = static_cast<GLuint>(
+                            std::min(node->numStars, _octreeManager.maxStarsPerNode())
+                        );
+                        bounds.isLeaf = node->isLeaf ? 1 : 0;
+                    }
+                    _mappedChunkBounds[offset] = bounds;
+                }
+            }
         }
+        else {
+            glBindVertexArray(_vao);
 
-        // Update Color VBO if render option is 'Color' or 'Motion'.
-        if (renderOption != gaia::RenderMode::Static) {
-            glBindBuffer(GL_ARRAY_BUFFER, _vboCol);
-            const float colMemoryShare =
-                static_cast<float>(ColorSize) / _nRenderValuesPerStar;
-            const size_t colChunkSize = maxStarsPerNode * ColorSize;
-            const long long colStreamingBudget = static_cast<long long>(
-                _maxStreamingBudgetInBytes * colMemoryShare
+            // Always update Position VBO.
+            glBindBuffer(GL_ARRAY_BUFFER, _vboPos);
+            const float posMemoryShare =
+                static_cast<float>(PositionSize) / _nRenderValuesPerStar;
+            const long long posStreamingBudget = static_cast<long long>(
+                _maxStreamingBudgetInBytes * posMemoryShare
             );
 
             // Use buffer orphaning to update a subset of total data.
             glBufferData(
                 GL_ARRAY_BUFFER,
-                colStreamingBudget,
+                posStreamingBudget,
                 nullptr,
                 GL_STREAM_DRAW
             );
 
             // Update buffer with one insert per chunk/node.
-            //The key in map holds the offset index.
-            for (const auto& [offset, subData] : updateData) {
-                // Fill chunk by appending zeroes so we overwrite possible earlier values.
-                std::vector<float> vectorData(subData.begin(), subData.end());
-                vectorData.resize(posChunkSize + colChunkSize, 0.f);
-                glBufferSubData(
+            // The key in map holds the offset index.
+            for (const auto& [offset, node] : updateData) {
+                const std::span<const float> pos = nodeValues(node, renderMode)[0];
+                uploadChunk(offset, posChunkSize, pos, _zeroChunk);
+            }
+
+            // Update Color VBO if render option is 'Color' or 'Motion'.
+            if (renderOption != gaia::RenderMode::Static) {
+                glBindBuffer(GL_ARRAY_BUFFER, _vboCol);
+                const float colMemoryShare =
+                    static_cast<float>(ColorSize) / _nRenderValuesPerStar;
+                const long long colStreamingBudget = static_cast<long long>(
+                    _maxStreamingBudgetInBytes * colMemoryShare
+                );
+
+                // Use buffer orphaning to update a subset of total data.
+                glBufferData(
                     GL_ARRAY_BUFFER,
-                    offset * colChunkSize * sizeof(GLfloat),
-                    colChunkSize * sizeof(GLfloat),
-                    vectorData.data() + posChunkSize
+                    colStreamingBudget,
+                    nullptr,
+                    GL_STREAM_DRAW
                 );
+
+                for (const auto& [offset, node] : updateData) {
+                    const std::span<const float> col = nodeValues(node, renderMode)[1];
+                    uploadChunk(offset, colChunkSize, col, _zeroChunk);
+                }
             }
 
             // Update Velocity VBO if specified.
             if (renderOption == gaia::RenderMode::Motion) {
                 glBindBuffer(GL_ARRAY_BUFFER, _vboVel);
-                const float velMemoryShare = static_cast<float>(VelocitySize) /
-                                       _nRenderValuesPerStar;
-                const size_t velChunkSize = maxStarsPerNode * VelocitySize;
+                const float velMemoryShare =
+                    static_cast<float>(VelocitySize) / _nRenderValuesPerStar;
                 const long long velStreamingBudget = static_cast<long long>(
                     _maxStreamingBudgetInBytes * velMemoryShare
                 );
@@ -1167,28 +1458,23 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
                     GL_STREAM_DRAW
                 );
 
-                // Update buffer with one insert per chunk/node.
-                //The key in map holds the offset index.
-                for (const auto& [offset, subData] : updateData) {
-                    // Fill chunk by appending zeroes.
-                    std::vector<float> vectorData(subData.begin(), subData.end());
-                    vectorData.resize(_chunkSize, 0.f);
-                    glBufferSubData(
-                        GL_ARRAY_BUFFER,
-                        offset * velChunkSize * sizeof(GLfloat),
-                        velChunkSize * sizeof(GLfloat),
-                        vectorData.data() + posChunkSize + colChunkSize
-                    );
+                for (const auto& [offset, node] : updateData) {
+                    const std::span<const float> vel = nodeValues(node, renderMode)[2];
+                    uploadChunk(offset, velChunkSize, vel, _zeroChunk);
                 }
             }
-        }
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glBindVertexArray(0);
+        }
     }
 
     checkGlErrors("After buffer updates");
 
+    if (useGpuCulling) {
+        cullChunksOnGpu(modelViewProjMat, screenSize, nChunksToRender);
+    }
+
     // Activate shader program and send uniforms.
     glBlendFunc(GL_SRC_ALPHA, GL_ONE);
     glDepthMask(false);
@@ -1300,8 +1586,24 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         glBindVertexArray(_vaoEmpty);
     }
 
-    glDrawArrays(GL_POINTS, 0, nShaderCalls);
+    if (useGpuCulling) {
+        // One draw command per chunk, the culled chunks don't have any instances
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBuffer);
+        glMultiDrawArraysIndirect(GL_POINTS, nullptr, nChunksToRender, 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+    else {
+        glDrawArrays(GL_POINTS, 0, nShaderCalls);
+    }
     glBindVertexArray(0);
+
+    // Signal when the GPU is done reading from the mapped buffers
+    if (_isUsingPersistentMapping) {
+        if (_bufferFence) {
+            glDeleteSync(_bufferFence);
+        }
+        _bufferFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
     //glDisable(GL_PROGRAM_POINT_SIZE);
     _program->deactivate();
 
@@ -1372,6 +1674,68 @@ void RenderableGaiaStars::checkGlErrors(const std::string& identifier) const {
     }
 }
 
+void RenderableGaiaStars::cullChunksOnGpu(const glm::dmat4& modelViewProjMat,
+                                          const glm::vec2& screenSize,
+                                          int nChunksToRender)
+{
+    if (nChunksToRender == 0) {
+        return;
+    }
+
+    // The bounds of the nodes are stored in kiloParsec
+    const glm::dmat4 nodeToClip = glm::scale(
+        modelViewProjMat,
+        glm::dvec3(1000.0 * distanceconstants::Parsec)
+    );
+
+    _programCull->activate();
+    _programCull->setUniform(_uniformCacheCull.nodeToClip, glm::mat4(nodeToClip));
+    _programCull->setUniform(_uniformCacheCull.screenSize, screenSize);
+    _programCull->setUniform(_uniformCacheCull.nChunks, nChunksToRender);
+    _programCull->setUniform(
+        _uniformCacheCull.maxStarsPerNode,
+        static_cast<int>(_octreeManager.maxStarsPerNode())
+    );
+    _programCull->setUniform(_uniformCacheCull.lodPixelThreshold, _lodPixelThreshold);
+
+    using Binding = ghoul::opengl::BufferBinding<
+        ghoul::opengl::bufferbinding::Buffer::ShaderStorage
+    >;
+    Binding boundsBinding;
+    glBindBufferBase(
+        GL_SHADER_STORAGE_BUFFER,
+        boundsBinding.bindingNumber(),
+        _ssboChunkBounds
+    );
+    _programCull->setSsboBinding("ssbo_chunk_bounds", boundsBinding.bindingNumber());
+
+    Binding commandsBinding;
+    glBindBufferBase(
+        GL_SHADER_STORAGE_BUFFER,
+        commandsBinding.bindingNumber(),
+        _indirectBuffer
+    );
+    _programCull->setSsboBinding("ssbo_draw_commands", commandsBinding.bindingNumber());
+
+    Binding refinementBinding;
+    glBindBufferBase(
+        GL_SHADER_STORAGE_BUFFER,
+        refinementBinding.bindingNumber(),
+        _ssboRefinement
+    );
+    _programCull->setSsboBinding("ssbo_refinement", refinementBinding.bindingNumber());
+
+    const GLuint nGroups = (nChunksToRender + CullWorkGroupSize - 1) / CullWorkGroupSize;
+    glDispatchCompute(nGroups, 1, 1);
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    _programCull->deactivate();
+
+    // Only one read back of the refinement request is in flight at any time
+    if (!_cullFence) {
+        _cullFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
 void RenderableGaiaStars::update(const UpdateData&) {
     const int shaderOption = _shaderOption;
     const int renderOption = _renderMode;
@@ -1381,6 +1745,11 @@ void RenderableGaiaStars::update(const UpdateData&) {
         return;
     }
 
+    // The octree manager counts its remaining budget down while loading star data
+    _octreeMemory.setSize(static_cast<uint64_t>(
+        std::max(_cpuRamBudgetInBytes - _octreeManager.cpuRamBudget(), 0LL)
+    ));
+
     if (_dataIsDirty) {
         LDEBUG("Regenerating data");
         // Reload data file. This may reconstruct the Octree as well.
@@ -1398,7 +1767,7 @@ void RenderableGaiaStars::update(const UpdateData&) {
             case gaia::ShaderOption::PointSSBO: {
 #ifndef __APPLE__
                 std::unique_ptr<ghoul::opengl::ProgramObject> program =
-                    ghoul::opengl::ProgramObject::Build(
+                    global::renderEngine->buildCachedProgram(
                         "GaiaStar",
                         absPath("${MODULE_GAIA}/shaders/gaia_ssbo_vs.glsl"),
                         absPath("${MODULE_GAIA}/shaders/gaia_point_fs.glsl"),
@@ -1461,7 +1830,7 @@ void RenderableGaiaStars::update(const UpdateData&) {
             }
             case gaia::ShaderOption::PointVBO: {
                 std::unique_ptr<ghoul::opengl::ProgramObject> program =
-                    ghoul::opengl::ProgramObject::Build(
+                    global::renderEngine->buildCachedProgram(
                         "GaiaStar",
                         absPath("${MODULE_GAIA}/shaders/gaia_vbo_vs.glsl"),
                         absPath("${MODULE_GAIA}/shaders/gaia_point_fs.glsl"),
@@ -1503,7 +1872,7 @@ void RenderableGaiaStars::update(const UpdateData&) {
     #ifndef __APPLE__
                 std::unique_ptr<ghoul::opengl::ProgramObject> program;
                 if (shaderOption == gaia::ShaderOption::BillboardSSBO) {
-                    program = ghoul::opengl::ProgramObject::Build(
+                    program = global::renderEngine->buildCachedProgram(
                         "GaiaStar",
                         absPath("${MODULE_GAIA}/shaders/gaia_ssbo_vs.glsl"),
                         absPath("${MODULE_GAIA}/shaders/gaia_billboard_fs.glsl"),
@@ -1586,7 +1955,7 @@ void RenderableGaiaStars::update(const UpdateData&) {
             }
             case gaia::ShaderOption::BillboardVBO: {
                 std::unique_ptr<ghoul::opengl::ProgramObject> program =
-                    ghoul::opengl::ProgramObject::Build(
+                    global::renderEngine->buildCachedProgram(
                         "GaiaStar",
                         absPath("${MODULE_GAIA}/shaders/gaia_vbo_vs.glsl"),
                         absPath("${MODULE_GAIA}/shaders/gaia_billboard_fs.glsl"),
@@ -1745,6 +2114,8 @@ void RenderableGaiaStars::update(const UpdateData&) {
             "Chunk size: {} - Max streaming budget (bytes): {} - Max nodes in stream: {}",
             _chunkSize, _maxStreamingBudgetInBytes, maxNodesInStream
         ));
+        // The streaming buffers of either render mode are sized to this budget
+        _streamingMemory.setSize(static_cast<uint64_t>(_maxStreamingBudgetInBytes));
 
         // ------------------ RENDER WITH SSBO -----------------------
         if (shaderOption == gaia::ShaderOption::BillboardSSBO ||
@@ -1774,7 +2145,18 @@ void RenderableGaiaStars::update(const UpdateData&) {
                     "Generating Index Shader Storage Buffer Object id '{}'", _ssboIdx
                 ));
             }
-            if (_ssboData == 0) {
+            if (_isUsingPersistentMapping) {
+                _mappedSsboData = createMappedBuffer(
+                    _ssboData,
+                    GL_SHADER_STORAGE_BUFFER,
+                    _maxStreamingBudgetInBytes
+                );
+                LDEBUG(std::format(
+                    "Generating mapped Data Shader Storage Buffer Object id '{}'",
+                    _ssboData
+                ));
+            }
+            else if (_ssboData == 0) {
                 glGenBuffers(1, &_ssboData);
                 LDEBUG(std::format(
                     "Generating Data Shader Storage Buffer Object id '{}'", _ssboData
@@ -1810,7 +2192,14 @@ void RenderableGaiaStars::update(const UpdateData&) {
 
             glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-            // Deallocate VBO Buffers if any existed.
+            // Deallocate VBO Buffers if any existed. Immutable buffers can't be resized,
+            // so they are deleted instead
+            if (_isUsingPersistentMapping) {
+                deleteMappedBuffer(_vboPos, _mappedPos);
+                deleteMappedBuffer(_vboCol, _mappedCol);
+                deleteMappedBuffer(_vboVel, _mappedVel);
+                deleteMappedBuffer(_ssboChunkBounds, _mappedChunkBounds);
+            }
             if (_vboPos != 0) {
                 glBindBuffer(GL_ARRAY_BUFFER, _vboPos);
                 glBufferData(
@@ -1858,23 +2247,88 @@ void RenderableGaiaStars::update(const UpdateData&) {
                 glGenVertexArrays(1, &_vao);
                 LDEBUG(std::format("Generating Vertex Array id '{}'", _vao));
             }
-            if (_vboPos == 0) {
-                glGenBuffers(1, &_vboPos);
-                LDEBUG(std::format(
-                    "Generating Position Vertex Buffer Object id '{}'", _vboPos
-                ));
-            }
-            if (_vboCol == 0) {
-                glGenBuffers(1, &_vboCol);
+            if (_isUsingPersistentMapping) {
+                // Only the attributes that are used by the render mode get a buffer
+                const long long valuesInStream =
+                    maxNodesInStream * _octreeManager.maxStarsPerNode();
+                _mappedPos = createMappedBuffer(
+                    _vboPos,
+                    GL_ARRAY_BUFFER,
+                    valuesInStream * PositionSize * sizeof(GLfloat)
+                );
+                if (renderOption != gaia::RenderMode::Static) {
+                    _mappedCol = createMappedBuffer(
+                        _vboCol,
+                        GL_ARRAY_BUFFER,
+                        valuesInStream * ColorSize * sizeof(GLfloat)
+                    );
+                }
+                else {
+                    deleteMappedBuffer(_vboCol, _mappedCol);
+                }
+                if (renderOption == gaia::RenderMode::Motion) {
+                    _mappedVel = createMappedBuffer(
+                        _vboVel,
+                        GL_ARRAY_BUFFER,
+                        valuesInStream * VelocitySize * sizeof(GLfloat)
+                    );
+                }
+                else {
+                    deleteMappedBuffer(_vboVel, _mappedVel);
+                }
                 LDEBUG(std::format(
-                    "Generating Color Vertex Buffer Object id '{}'", _vboCol
+                    "Generating mapped Vertex Buffer Objects ids '{}', '{}', '{}'",
+                    _vboPos, _vboCol, _vboVel
                 ));
+
+                // The bounds of the chunks and the draw commands for the GPU culling
+                _mappedChunkBounds = createMappedBuffer<ChunkBounds>(
+                    _ssboChunkBounds,
+                    GL_SHADER_STORAGE_BUFFER,
+                    maxNodesInStream * sizeof(ChunkBounds)
+                );
+                if (_mappedChunkBounds) {
+                    std::fill_n(_mappedChunkBounds, maxNodesInStream, ChunkBounds());
+                }
+
+                if (_indirectBuffer == 0) {
+                    glGenBuffers(1, &_indirectBuffer);
+                }
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBuffer);
+                glBufferData(
+                    GL_DRAW_INDIRECT_BUFFER,
+                    maxNodesInStream * 4 * sizeof(GLuint),
+                    nullptr,
+                    GL_DYNAMIC_COPY
+                );
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
             }
-            if (_vboVel == 0) {
-                glGenBuffers(1, &_vboVel);
-                LDEBUG(std::format(
-                    "Generating Velocity Vertex Buffer Object id '{}'", _vboVel
-                ));
+            else {
+                if (_vboPos == 0) {
+                    glGenBuffers(1, &_vboPos);
+                    LDEBUG(std::format(
+                        "Generating Position Vertex Buffer Object id '{}'", _vboPos
+                    ));
+                }
+                if (_vboCol == 0) {
+                    glGenBuffers(1, &_vboCol);
+                    LDEBUG(std::format(
+                        "Generating Color Vertex Buffer Object id '{}'", _vboCol
+                    ));
+                }
+                if (_vboVel == 0) {
+                    glGenBuffers(1, &_vboVel);
+                    LDEBUG(std::format(
+                        "Generating Velocity Vertex Buffer Object id '{}'", _vboVel
+                    ));
+                }
+
+                // Used to overwrite the remainder of the chunks when uploading nodes
+                _zeroChunk.assign(
+                    _octreeManager.maxStarsPerNode() *
+                        std::max(PositionSize, VelocitySize),
+                    0.f
+                );
             }
 
             // Bind our different VBOs to our vertex array layout.
@@ -1982,6 +2436,9 @@ void RenderableGaiaStars::update(const UpdateData&) {
                     GL_STREAM_DRAW
                 );
             }
+            if (_isUsingPersistentMapping) {
+                deleteMappedBuffer(_ssboData, _mappedSsboData);
+            }
             if (_ssboData != 0) {
                 glBindBuffer(GL_SHADER_STORAGE_BUFFER, _ssboData);
                 glBufferData(
@@ -2258,61 +2715,71 @@ int RenderableGaiaStars::readSpeckFile(const std::filesystem::path& filePath) {
 }
 
 int RenderableGaiaStars::readBinaryRawFile(const std::filesystem::path& filePath) {
-    std::vector<float> fullData;
-    int nReadStars = 0;
-
-    std::ifstream fileStream(filePath, std::ifstream::binary);
-    if (fileStream.good()) {
-        int32_t nValues = 0;
-        int32_t nReadValuesPerStar = 0;
-        const int renderValues = 8;
-        fileStream.read(reinterpret_cast<char*>(&nValues), sizeof(int32_t));
-        fileStream.read(reinterpret_cast<char*>(&nReadValuesPerStar), sizeof(int32_t));
-
-        fullData.resize(nValues);
-        fileStream.read(
-            reinterpret_cast<char*>(fullData.data()),
-            nValues * sizeof(fullData[0])
-        );
-
-        // Insert stars into octree.
-        for (size_t i = 0; i < fullData.size(); i += nReadValuesPerStar) {
-            auto first = fullData.begin() + i;
-            auto last = fullData.begin() + i + renderValues;
-            const std::vector<float> starValues(first, last);
-
-            _octreeManager.insert(starValues);
-        }
-        _octreeManager.sliceLodData();
-
-        nReadStars = nValues / nReadValuesPerStar;
-        fileStream.close();
+    std::optional<MemoryMappedFile> file;
+    try {
+        file.emplace(filePath);
     }
-    else {
+    catch (const ghoul::RuntimeError&) {
         LERROR(std::format(
             "Error opening file '{}' for loading raw binary file", filePath
         ));
-        return nReadStars;
+        return 0;
     }
-    return nReadStars;
-}
 
-int RenderableGaiaStars::readBinaryOctreeFile(const std::filesystem::path& filePath) {
-    int nReadStars = 0;
+    constexpr size_t HeaderSize = 2 * sizeof(int32_t);
+    if (file->size() < HeaderSize) {
+        LERROR(std::format("Raw binary file '{}' is too small", filePath));
+        return 0;
+    }
+    int32_t nValues = 0;
+    int32_t nReadValuesPerStar = 0;
+    const int renderValues = 8;
+    std::memcpy(&nValues, file->data(), sizeof(int32_t));
+    std::memcpy(&nReadValuesPerStar, file->data() + sizeof(int32_t), sizeof(int32_t));
+    if (nReadValuesPerStar < renderValues) {
+        LERROR(std::format("Raw binary file '{}' has too few values per star", filePath));
+        return 0;
+    }
 
-    std::ifstream fileStream(filePath, std::ifstream::binary);
-    if (fileStream.good()) {
-        nReadStars = _octreeManager.readFromFile(fileStream, true);
+    // The stars are read straight from the mapping instead of being copied into a
+    // buffer that can hold the entire file first
+    const size_t nAvailableValues = (file->size() - HeaderSize) / sizeof(float);
+    const size_t nStars =
+        std::min(static_cast<size_t>(nValues), nAvailableValues) / nReadValuesPerStar;
+    const std::span<const float> fullData(
+        reinterpret_cast<const float*>(file->data() + HeaderSize),
+        nStars * nReadValuesPerStar
+    );
 
-        fileStream.close();
+    // Insert stars into octree.
+    std::vector<float> starValues(renderValues);
+    for (size_t i = 0; i < fullData.size(); i += nReadValuesPerStar) {
+        auto first = fullData.begin() + i;
+        auto last = fullData.begin() + i + renderValues;
+        starValues.assign(first, last);
+
+        _octreeManager.insert(starValues);
     }
-    else {
+    _octreeManager.sliceLodData();
+
+    return static_cast<int>(nStars);
+}
+
+int RenderableGaiaStars::readBinaryOctreeFile(const std::filesystem::path& filePath) {
+    std::shared_ptr<const MemoryMappedFile> file;
+    try {
+        file = std::make_shared<const MemoryMappedFile>(filePath);
+    }
+    catch (const ghoul::RuntimeError&) {
         LERROR(std::format(
             "Error opening file '{}' for loading binary Octree file", filePath
         ));
-        return nReadStars;
+        return 0;
     }
-    return nReadStars;
+
+    // The nodes reference their data in the mapping whenever possible, so the file
+    // stays mapped for as long as the Octree is alive
+    return _octreeManager.readFromFile(std::move(file), true);
 }
 
 int RenderableGaiaStars::readBinaryOctreeStructureFile(
@@ -2320,16 +2787,18 @@ int RenderableGaiaStars::readBinaryOctreeStructureFile(
 {
     std::filesystem::path indexFile = folderPath / "index.bin";
 
-    std::ifstream fileStream = std::ifstream(indexFile, std::ifstream::binary);
-    if (!fileStream.good()) {
+    std::shared_ptr<const MemoryMappedFile> file;
+    try {
+        file = std::make_shared<const MemoryMappedFile>(indexFile);
+    }
+    catch (const ghoul::RuntimeError&) {
         LERROR(std::format(
             "Error opening file '{}' for loading binary Octree file", indexFile
         ));
         return 0;
     }
 
-    const int nReadStars = _octreeManager.readFromFile(fileStream, false, folderPath);
-    return nReadStars;
+    return _octreeManager.readFromFile(std::move(file), false, folderPath);
 }
 
 } // namespace openspace
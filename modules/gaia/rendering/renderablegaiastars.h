@@ -115,6 +115,27 @@ private:
      */
     void checkGlErrors(const std::string& identifier) const;
 
+    /**
+     * Runs the compute shader that culls the chunks in the streaming buffer against the
+     * view frustum and writes one indirect draw command per chunk. The shader also
+     * detects if a visible inner node should be refined, which is read back during one
+     * of the following frames.
+     */
+    void cullChunksOnGpu(const glm::dmat4& modelViewProjMat, const glm::vec2& screenSize,
+        int nChunksToRender);
+
+    // The bounds of the node that is stored in a chunk of the streaming buffer. Keep in
+    // sync with gaia_cull_cs.glsl
+    struct ChunkBounds {
+        glm::vec3 origin = glm::vec3(0.f);
+        float halfDimension = 0.f;
+        GLuint nStars = 0;
+        GLuint isLeaf = 0;
+        GLuint padding0 = 0;
+        GLuint padding1 = 0;
+    };
+    static_assert(sizeof(ChunkBounds) == 32, "Has to match the layout in the shader");
+
     properties::StringProperty _filePath;
     std::unique_ptr<ghoul::filesystem::File> _dataFile;
     bool _dataIsDirty = true;
@@ -165,6 +186,8 @@ private:
     properties::FloatProperty _maxCpuMemoryPercent;
 
     properties::BoolProperty _reportGlErrors;
+    properties::BoolProperty _gpuCulling;
+    properties::IntProperty _residencyUpdateInterval;
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _program;
     UniformCache(model, view, cameraPos, cameraLookUp, viewScaling, projection,
@@ -181,6 +204,10 @@ private:
         projection) _uniformCacheTM;
     std::unique_ptr<ghoul::opengl::Texture> _fboTexture;
 
+    std::unique_ptr<ghoul::opengl::ProgramObject> _programCull;
+    UniformCache(nodeToClip, screenSize, nChunks, maxStarsPerNode,
+        lodPixelThreshold) _uniformCacheCull;
+
     OctreeManager _octreeManager;
     std::unique_ptr<ghoul::opengl::BufferBinding<
         ghoul::opengl::bufferbinding::Buffer::ShaderStorage>> _ssboIdxBinding;
@@ -198,6 +225,8 @@ private:
     long long _gpuMemoryBudgetInBytes = 0;
     long long _maxStreamingBudgetInBytes = 0;
     size_t _chunkSize = 0;
+    MemoryTracker::Allocation _streamingMemory;
+    MemoryTracker::Allocation _octreeMemory;
 
     GLuint _vao = 0;
     GLuint _vaoEmpty = 0;
@@ -206,6 +235,29 @@ private:
     GLuint _vboVel = 0;
     GLuint _ssboIdx = 0;
     GLuint _ssboData = 0;
+
+    // If the OpenGL version supports it, the streaming buffers are persistently mapped
+    // and the node data is written directly into these pointers
+    bool _isUsingPersistentMapping = false;
+    float* _mappedPos = nullptr;
+    float* _mappedCol = nullptr;
+    float* _mappedVel = nullptr;
+    float* _mappedSsboData = nullptr;
+    // Signals when the GPU has finished the last draw call that read from the buffers
+    GLsync _bufferFence = nullptr;
+    // Used to clear the remainder of the chunks if the buffers are not mapped
+    std::vector<float> _zeroChunk;
+
+    // Buffers used by the GPU culling
+    GLuint _ssboChunkBounds = 0;
+    ChunkBounds* _mappedChunkBounds = nullptr;
+    GLuint _indirectBuffer = 0;
+    GLuint _ssboRefinement = 0;
+    GLuint* _mappedRefinement = nullptr;
+    // Signals when the last culling pass has written the refinement request
+    GLsync _cullFence = nullptr;
+    bool _gpuRequestedRefinement = false;
+    int _nFramesSinceTraversal = 0;
     GLuint _vaoQuad = 0;
     GLuint _vboQuad = 0;
     GLuint _fbo = 0;
@@ -0,0 +1,112 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#version __CONTEXT__
+
+layout(local_size_x = 64) in;
+
+// Keep in sync with renderablegaiastars.h:ChunkBounds
+struct ChunkBounds {
+  vec3 origin;
+  float halfDimension;
+  uint nStars;
+  uint isLeaf;
+  uint padding0;
+  uint padding1;
+};
+
+struct DrawArraysCommand {
+  uint count;
+  uint instanceCount;
+  uint first;
+  uint baseInstance;
+};
+
+layout (std430) readonly buffer ssbo_chunk_bounds {
+  ChunkBounds chunks[];
+};
+
+layout (std430) writeonly buffer ssbo_draw_commands {
+  DrawArraysCommand commands[];
+};
+
+layout (std430) buffer ssbo_refinement {
+  uint needsRefinement;
+};
+
+// Transforms the node bounds, which are in kiloParsec, into clipping space
+uniform mat4 nodeToClip;
+uniform vec2 screenSize;
+uniform int nChunks;
+uniform int maxStarsPerNode;
+uniform float lodPixelThreshold;
+
+
+void main() {
+  int index = int(gl_GlobalInvocationID.x);
+  if (index >= nChunks) {
+    return;
+  }
+
+  ChunkBounds chunk = chunks[index];
+  DrawArraysCommand command;
+  // Only the stars in the chunk are drawn, the padding at the end is skipped
+  command.count = chunk.nStars;
+  command.instanceCount = 0u;
+  command.first = uint(index * maxStarsPerNode);
+  command.baseInstance = 0u;
+
+  if (chunk.nStars > 0u) {
+    // Same test as in OctreeCuller: Create a bounding box in normalized device
+    // coordinates from the corners of the node and intersect it with the view
+    vec3 boundsMin = vec3(1e38);
+    vec3 boundsMax = vec3(-1e38);
+    for (int i = 0; i < 8; i++) {
+      vec3 direction = vec3(
+        (i % 2 == 0) ? 1.0 : -1.0,
+        (i % 4 < 2) ? 1.0 : -1.0,
+        (i < 4) ? 1.0 : -1.0
+      );
+      vec4 corner = nodeToClip * vec4(chunk.origin + chunk.halfDimension * direction, 1.0);
+      vec3 ndc = corner.xyz / abs(corner.w);
+      boundsMin = min(boundsMin, ndc);
+      boundsMax = max(boundsMax, ndc);
+    }
+
+    bool isVisible = all(lessThanEqual(boundsMin, vec3(1.0, 1.0, 100.0))) &&
+                     all(lessThanEqual(vec3(-1.0, -1.0, 0.0), boundsMax));
+    if (isVisible) {
+      command.instanceCount = 1u;
+
+      // An inner node that has grown too big on screen should be replaced by its
+      // children, which the CPU does when it traverses the octree the next time
+      vec2 size = abs(boundsMax.xy - boundsMin.xy) / 2.0 * screenSize;
+      if (chunk.isLeaf == 0u && size.x * size.y >= lodPixelThreshold) {
+        atomicOr(needsRefinement, 1u);
+      }
+    }
+  }
+
+  commands[index] = command;
+}
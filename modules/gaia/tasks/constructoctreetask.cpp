@@ -30,13 +30,46 @@
 #include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "ConstructOctreeTask";
 
+    // The number of stars that are read from a file in one go
+    constexpr size_t BlockSize = 1 << 16;
+
+    // The maximum number of stars in a segment of an input file that is binned by a
+    // single task of the parallel construction
+    constexpr size_t SegmentSize = 1 << 22;
+
+    // The number of stars per branch that a binning task collects before it appends
+    // them to the temporary file of that branch
+    constexpr size_t FlushSize = 1 << 17;
+
+    // Estimate for how many bytes of memory the Octree needs per byte of star data. The
+    // values are split into separate vectors in the nodes and the brightest stars of
+    // each inner node are duplicated into its LOD cache
+    constexpr long long MemoryPerStarDataByte = 3;
+
+    std::vector<std::filesystem::path> inputFiles(const std::filesystem::path& folder) {
+        std::vector<std::filesystem::path> files;
+        if (std::filesystem::is_directory(folder)) {
+            namespace fs = std::filesystem;
+            for (const fs::directory_entry& e : fs::directory_iterator(folder)) {
+                if (e.is_regular_file()) {
+                    files.push_back(e.path());
+                }
+            }
+        }
+        return files;
+    }
+
     struct [[codegen::Dictionary(ConstructOctreeTask)]] Parameters {
         // If SingleFileInput is set to true then this specifies the path to a single BIN
         // file containing a full dataset. Otherwise this specifies the path to a folder
@@ -59,6 +92,26 @@ namespace {
         // folder and output multiple files for the Octree
         std::optional<bool> singleFileInput;
 
+        // If true then the Octree is constructed out-of-core on multiple threads. First,
+        // the stars that pass all filters are binned by branch into temporary files.
+        // Then each branch is constructed and written independently, before the
+        // structure of all branches is merged into a single index file. The output is
+        // always written as multiple files, regardless of SingleFileInput
+        std::optional<bool> parallelConstruction;
+
+        // Defines how many threads to use for the parallel construction. If not defined,
+        // all but one of the hardware threads are used
+        std::optional<int> threadsToUse [[codegen::greaterequal(1)]];
+
+        // The maximum amount of memory in GB that the parallel construction may use for
+        // branches that are constructed at the same time. Branches that would exceed the
+        // budget wait until other branches are done. The default is 48 GB
+        std::optional<int> memoryBudget [[codegen::greaterequal(1)]];
+
+        // The folder in which the parallel construction stores the binned star data. If
+        // not defined, a 'tmp' folder inside the output folder is used
+        std::optional<std::string> temporaryFolder;
+
         // If defined then only stars with Position X values between [min, max] will be
         // inserted into Octree (if min is set to 0.0 it is read as -Inf, if max is set to
         // 0.0 it is read as +Inf). If min = max then all values equal min|max will be
@@ -216,6 +269,12 @@ ConstructOctreeTask::ConstructOctreeTask(const ghoul::Dictionary& dictionary) {
     _maxDist = p.maxDist.value_or(_maxDist);
     _maxStarsPerNode = p.maxStarsPerNode.value_or(_maxStarsPerNode);
     _singleFileInput = p.singleFileInput.value_or(_singleFileInput);
+    _parallelConstruction = p.parallelConstruction.value_or(_parallelConstruction);
+    _threadsToUse = p.threadsToUse.value_or(static_cast<int>(_threadsToUse));
+    _memoryBudgetInGB = p.memoryBudget.value_or(_memoryBudgetInGB);
+    _temporaryFolder = p.temporaryFolder.has_value() ?
+        absPath(*p.temporaryFolder) :
+        _outFileOrFolderPath / "tmp";
 
     _octreeManager = std::make_shared<OctreeManager>();
     _indexOctreeManager = std::make_shared<OctreeManager>();
@@ -304,7 +363,10 @@ std::string ConstructOctreeTask::description() {
 void ConstructOctreeTask::perform(const Task::ProgressCallback& onProgress) {
     onProgress(0.f);
 
-    if (_singleFileInput) {
+    if (_parallelConstruction) {
+        constructOctreeInParallel(onProgress);
+    }
+    else if (_singleFileInput) {
         constructOctreeFromSingleFile(onProgress);
     }
     else {
@@ -453,15 +515,7 @@ void ConstructOctreeTask::constructOctreeFromFolder(
     //int starsOutside2000 = 0;
     //int starsOutside5000 = 0;
 
-    std::vector<std::filesystem::path> allInputFiles;
-    if (std::filesystem::is_directory(_inFileOrFolderPath)) {
-        namespace fs = std::filesystem;
-        for (const fs::directory_entry& e : fs::directory_iterator(_inFileOrFolderPath)) {
-            if (!e.is_regular_file()) {
-                allInputFiles.push_back(e.path());
-            }
-        }
-    }
+    std::vector<std::filesystem::path> allInputFiles = inputFiles(_inFileOrFolderPath);
 
     std::vector<float> filterValues;
     auto writeThreads = std::vector<std::thread>(8);
@@ -590,6 +644,279 @@ void ConstructOctreeTask::constructOctreeFromFolder(
     //    " - 2000kPc is " + std::to_string(starsOutside2000) + "\n" +
     //    " - 5000kPc is " + std::to_string(starsOutside5000));
 
+    writeIndexFile();
+
+    // Make sure all threads are done.
+    for (int i = 0; i < 8; i++) {
+        writeThreads[i].join();
+    }
+}
+
+void ConstructOctreeTask::constructOctreeInParallel(
+                                           const Task::ProgressCallback& progressCallback)
+{
+    LINFO(std::format(
+        "Constructing octree in parallel with {} threads and a memory budget of {} GB",
+        _threadsToUse, _memoryBudgetInGB
+    ));
+    ThreadPool threadPool(_threadsToUse);
+
+    std::filesystem::create_directories(_temporaryFolder);
+    std::array<std::filesystem::path, 8> branchFiles;
+    for (size_t i = 0; i < 8; i++) {
+        branchFiles[i] = _temporaryFolder / std::format("branch{}.bin", i);
+    }
+
+    // Phase 1: Bin all stars by their branch
+    const std::array<size_t, 8> nStarsInBranch = binStarsByBranch(
+        threadPool,
+        branchFiles
+    );
+    progressCallback(0.5f);
+
+    // Phase 2: Construct and write the branches independently of each other. The budget
+    // limits how many of the branches are kept in memory at the same time
+    const long long memoryBudget =
+        static_cast<long long>(_memoryBudgetInGB) * 1024 * 1024 * 1024;
+    std::mutex budgetMutex;
+    std::condition_variable budgetChanged;
+    long long usedMemory = 0;
+
+    std::array<std::future<std::unique_ptr<OctreeManager>>, 8> branches;
+    for (size_t i = 0; i < 8; i++) {
+        const long long nBytes = nStarsInBranch[i] * RENDER_VALUES * sizeof(float);
+        const long long memory = std::min(nBytes * MemoryPerStarDataByte, memoryBudget);
+
+        branches[i] = threadPool.submit([&, i, memory]() {
+            {
+                std::unique_lock lock(budgetMutex);
+                budgetChanged.wait(
+                    lock,
+                    [&]() { return usedMemory + memory <= memoryBudget; }
+                );
+                usedMemory += memory;
+            }
+
+            std::unique_ptr<OctreeManager> branch = constructBranch(i, branchFiles[i]);
+
+            {
+                const std::lock_guard lock(budgetMutex);
+                usedMemory -= memory;
+            }
+            budgetChanged.notify_all();
+            return branch;
+        });
+    }
+
+    // Merge the structure of all branches into a single Octree
+    _indexOctreeManager->initOctree(0, _maxDist, _maxStarsPerNode);
+    for (size_t i = 0; i < 8; i++) {
+        const std::unique_ptr<OctreeManager> branch = branches[i].get();
+        _indexOctreeManager->swapBranch(i, *branch);
+        progressCallback(0.5f + 0.5f * (i + 1) / 8.f);
+    }
+    std::filesystem::remove(_temporaryFolder);
+
+    size_t nStars = 0;
+    for (const size_t n : nStarsInBranch) {
+        nStars += n;
+    }
+    LINFO(std::format(
+        "A total of {} stars were distributed into {} total nodes",
+        nStars, _indexOctreeManager->totalNodes()
+    ));
+
+    writeIndexFile();
+}
+
+std::array<size_t, 8> ConstructOctreeTask::binStarsByBranch(ThreadPool& threadPool,
+                                  const std::array<std::filesystem::path, 8>& branchFiles)
+{
+    // A range of stars in one of the input files that is read by a single task
+    struct Segment {
+        std::filesystem::path file;
+        std::streamoff offset = 0;
+        size_t nStars = 0;
+        int32_t nValuesPerStar = 0;
+    };
+    std::vector<Segment> segments;
+
+    auto addSegments = [&segments](const std::filesystem::path& file,
+                                   std::streamoff offset, size_t nStars,
+                                   int32_t nValuesPerStar)
+    {
+        const std::streamoff starSize = nValuesPerStar * sizeof(float);
+        for (size_t first = 0; first < nStars; first += SegmentSize) {
+            segments.push_back({
+                .file = file,
+                .offset = offset + static_cast<std::streamoff>(first) * starSize,
+                .nStars = std::min(SegmentSize, nStars - first),
+                .nValuesPerStar = nValuesPerStar
+            });
+        }
+    };
+
+    // The single file starts with the total number of values, the files in a folder
+    // contain stars until the end of the file
+    const std::vector<std::filesystem::path> files = _singleFileInput ?
+        std::vector<std::filesystem::path>{ _inFileOrFolderPath } :
+        inputFiles(_inFileOrFolderPath);
+    for (const std::filesystem::path& file : files) {
+        std::ifstream inFileStream(file, std::ifstream::binary);
+        if (!inFileStream.good()) {
+            LERROR(std::format(
+                "Error opening file '{}' for loading preprocessed file", file
+            ));
+            continue;
+        }
+
+        int32_t nValues = 0;
+        int32_t nValuesPerStar = 0;
+        if (_singleFileInput) {
+            inFileStream.read(reinterpret_cast<char*>(&nValues), sizeof(int32_t));
+        }
+        inFileStream.read(reinterpret_cast<char*>(&nValuesPerStar), sizeof(int32_t));
+        if (nValuesPerStar <= 0) {
+            LERROR(std::format("Invalid number of values per star in '{}'", file));
+            continue;
+        }
+
+        const std::streamoff offset = inFileStream.tellg();
+        const size_t nStars = _singleFileInput ?
+            nValues / nValuesPerStar :
+            (std::filesystem::file_size(file) - offset) /
+                (nValuesPerStar * sizeof(float));
+        addSegments(file, offset, nStars, nValuesPerStar);
+    }
+    LINFO(std::format("Binning stars from {} files by branch", files.size()));
+
+    // The tasks collect the stars of each branch locally and append them to the shared
+    // files whenever the buffer is full
+    std::array<std::ofstream, 8> branchStreams;
+    std::array<std::mutex, 8> branchMutexes;
+    std::array<size_t, 8> nStarsInBranch = {};
+    for (size_t i = 0; i < 8; i++) {
+        branchStreams[i].open(branchFiles[i], std::ofstream::binary);
+    }
+    std::atomic<size_t> nFilteredStars = 0;
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(segments.size());
+    for (const Segment& segment : segments) {
+        tasks.push_back(threadPool.submit([&, segment]() {
+            std::array<std::vector<float>, 8> buffers;
+            auto flush = [&](size_t branch) {
+                std::vector<float>& buffer = buffers[branch];
+                const std::lock_guard lock(branchMutexes[branch]);
+                branchStreams[branch].write(
+                    reinterpret_cast<const char*>(buffer.data()),
+                    buffer.size() * sizeof(float)
+                );
+                nStarsInBranch[branch] += buffer.size() / RENDER_VALUES;
+                buffer.clear();
+            };
+
+            std::ifstream inFileStream(segment.file, std::ifstream::binary);
+            inFileStream.seekg(segment.offset);
+
+            std::vector<float> block;
+            size_t nRemaining = segment.nStars;
+            while (nRemaining > 0 && inFileStream.good()) {
+                const size_t nStars = std::min(nRemaining, BlockSize);
+                block.resize(nStars * segment.nValuesPerStar);
+                inFileStream.read(
+                    reinterpret_cast<char*>(block.data()),
+                    block.size() * sizeof(float)
+                );
+                const size_t nRead =
+                    inFileStream.gcount() / (segment.nValuesPerStar * sizeof(float));
+
+                for (size_t i = 0; i < nRead; i++) {
+                    const std::span<const float> star(
+                        block.data() + i * segment.nValuesPerStar,
+                        segment.nValuesPerStar
+                    );
+                    if (checkAllFilters(star)) {
+                        nFilteredStars++;
+                        continue;
+                    }
+
+                    const size_t branch =
+                        OctreeManager::branchIndex(star[0], star[1], star[2]);
+                    std::vector<float>& buffer = buffers[branch];
+                    buffer.insert(
+                        buffer.end(),
+                        star.begin(),
+                        star.begin() + RENDER_VALUES
+                    );
+                    if (buffer.size() >= FlushSize * RENDER_VALUES) {
+                        flush(branch);
+                    }
+                }
+                nRemaining -= nStars;
+            }
+
+            for (size_t branch = 0; branch < 8; branch++) {
+                flush(branch);
+            }
+        }));
+    }
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+
+    for (std::ofstream& stream : branchStreams) {
+        stream.close();
+    }
+    LINFO(std::format("{} stars were filtered", nFilteredStars.load()));
+    return nStarsInBranch;
+}
+
+std::unique_ptr<OctreeManager> ConstructOctreeTask::constructBranch(size_t branchIndex,
+                                                 const std::filesystem::path& branchFile)
+{
+    auto branch = std::make_unique<OctreeManager>();
+    branch->initOctree(0, _maxDist, _maxStarsPerNode);
+
+    std::ifstream inFileStream(branchFile, std::ifstream::binary);
+    if (!inFileStream.good()) {
+        LERROR(std::format("Error opening temporary file '{}'", branchFile));
+        return branch;
+    }
+
+    std::vector<float> block(BlockSize * RENDER_VALUES);
+    std::vector<float> renderValues(RENDER_VALUES);
+    while (true) {
+        inFileStream.read(
+            reinterpret_cast<char*>(block.data()),
+            block.size() * sizeof(float)
+        );
+        const size_t nRead = inFileStream.gcount() / (RENDER_VALUES * sizeof(float));
+        if (nRead == 0) {
+            break;
+        }
+
+        for (size_t i = 0; i < nRead; i++) {
+            const auto first = block.begin() + i * RENDER_VALUES;
+            renderValues.assign(first, first + RENDER_VALUES);
+            branch->insert(renderValues);
+        }
+    }
+    inFileStream.close();
+    std::filesystem::remove(branchFile);
+
+    // Slice LOD data and write the branch to files. This also clears the star data of
+    // the branch, so that only the structure is kept in memory
+    branch->sliceLodData(branchIndex);
+    LINFO(std::format(
+        "Writing branch {} with {} leaf nodes and {} inner nodes to octree files",
+        branchIndex, branch->numLeafNodes(), branch->numInnerNodes()
+    ));
+    branch->writeToMultipleFiles(_outFileOrFolderPath, branchIndex);
+    return branch;
+}
+
+void ConstructOctreeTask::writeIndexFile() {
     // Write index file of Octree structure.
     std::filesystem::path indexFileOutPath = _outFileOrFolderPath / "index.bin";
     std::ofstream outFileStream = std::ofstream(indexFileOutPath, std::ofstream::binary);
@@ -604,14 +931,9 @@ void ConstructOctreeTask::constructOctreeFromFolder(
             "Error opening file '{}' as index output file", indexFileOutPath
         ));
     }
-
-    // Make sure all threads are done.
-    for (int i = 0; i < 8; i++) {
-        writeThreads[i].join();
-    }
 }
 
-bool ConstructOctreeTask::checkAllFilters(const std::vector<float>& filterValues) {
+bool ConstructOctreeTask::checkAllFilters(std::span<const float> filterValues) {
     // Return true if star is caught in any filter.
     return (_filterPosX && filterStar(_posX, filterValues[0])) ||
         (_filterPosY && filterStar(_posY, filterValues[1])) ||
@@ -29,7 +29,10 @@
 
 #include <modules/gaia/rendering/octreeculler.h>
 #include <modules/gaia/rendering/octreemanager.h>
+#include <openspace/util/threadpool.h>
+#include <array>
 #include <filesystem>
+#include <span>
 
 namespace openspace {
 
@@ -62,6 +65,38 @@ private:
      */
     void constructOctreeFromFolder(const Task::ProgressCallback& progressCallback);
 
+    /**
+     * Constructs the octree from either a single file or all files in a folder in two
+     * phases, using #_threadsToUse threads. First all stars that pass the filters are
+     * binned by branch into temporary files, after which each branch is constructed and
+     * written to separate files independently. The number of branches that are kept in
+     * memory at the same time is limited by #_memoryBudgetInGB. Stores the merged octree
+     * structure in a binary index file.
+     */
+    void constructOctreeInParallel(const Task::ProgressCallback& progressCallback);
+
+    /**
+     * Reads all input stars in parallel and appends the render values of the stars that
+     * passed all filters to the file in \p branchFiles that belongs to their branch.
+     *
+     * \return The number of stars that were written into each of the files
+     */
+    std::array<size_t, 8> binStarsByBranch(ThreadPool& threadPool,
+        const std::array<std::filesystem::path, 8>& branchFiles);
+
+    /**
+     * Constructs the branch with index \p branchIndex from the stars in \p branchFile,
+     * which is deleted afterwards, and writes the branch to files. The star data is
+     * cleared afterwards, so that the returned octree only contains the structure.
+     */
+    std::unique_ptr<OctreeManager> constructBranch(size_t branchIndex,
+        const std::filesystem::path& branchFile);
+
+    /**
+     * Writes the structure of the index octree to the index file in the output folder.
+     */
+    void writeIndexFile();
+
     /**
      * Checks all defined filter ranges and returns true if any of the corresponding
      * \p filterValues are outside of the defined range.
@@ -70,7 +105,7 @@ private:
      *
      * \return `false` if value should be inserted into Octree
      */
-    bool checkAllFilters(const std::vector<float>& filterValues);
+    bool checkAllFilters(std::span<const float> filterValues);
 
     /**
      * \p range contains ]min, max[ and \p filterValue corresponding value in star. Star
@@ -86,6 +121,10 @@ private:
     int _maxDist = 0;
     int _maxStarsPerNode = 0;
     bool _singleFileInput = false;
+    bool _parallelConstruction = false;
+    size_t _threadsToUse = ThreadPool::defaultNumberOfThreads();
+    int _memoryBudgetInGB = 48;
+    std::filesystem::path _temporaryFolder;
 
     std::shared_ptr<OctreeManager> _octreeManager;
     std::shared_ptr<OctreeManager> _indexOctreeManager;
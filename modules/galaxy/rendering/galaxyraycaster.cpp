@@ -116,11 +116,15 @@ void GalaxyRaycaster::preRaycast(const RaycastData& data,
     const std::string emissionMultiplyUniformName = "emissionMultiply" +
                                                     std::to_string(data.id);
 
+    const std::string levelOfDetailUniformName = "levelOfDetail" +
+                                                 std::to_string(data.id);
+
     program.setUniform(volumeAspectUniformName, _aspect);
     program.setUniform(stepSizeUniformName, _stepSize);
     program.setUniform(opacityCoefficientUniformName, _opacityCoefficient);
     program.setUniform(absorptionMultiplyUniformName, _absorptionMultiply);
     program.setUniform(emissionMultiplyUniformName, _emissionMultiply);
+    program.setUniform(levelOfDetailUniformName, _levelOfDetail);
 
     _textureUnit = std::make_unique<ghoul::opengl::TextureUnit>();
     _textureUnit->activate();
@@ -187,4 +191,8 @@ void GalaxyRaycaster::setStepSize(float stepSize) {
     _stepSize = stepSize;
 }
 
+void GalaxyRaycaster::setLevelOfDetail(float level) {
+    _levelOfDetail = level;
+}
+
 } // namespace openspace
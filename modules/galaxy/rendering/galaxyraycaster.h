@@ -75,6 +75,12 @@ public:
     void setAbsorptionMultiplier(float absorptionMultiply);
     void setEmissionMultiplier(float emissionMultiply);
 
+    /**
+     * Sets the (fractional) mip level of the volume texture that is sampled. The step
+     * size is scaled with the voxel size of the level.
+     */
+    void setLevelOfDetail(float level);
+
 private:
     glm::dmat4 modelViewTransform(const RenderData& data);
 
@@ -86,6 +92,7 @@ private:
     float _opacityCoefficient = 0.f;
     float _absorptionMultiply = 0.f;
     float _emissionMultiply = 0.f;
+    float _levelOfDetail = 0.f;
     ghoul::opengl::Texture& _texture;
     std::unique_ptr<ghoul::opengl::TextureUnit> _textureUnit;
     std::filesystem::path _raycastingShader;
@@ -51,11 +51,23 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/component_wise.hpp>
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <optional>
+#include <random>
 
 namespace {
-    constexpr int8_t CurrentCacheVersion = 1;
+    constexpr int8_t CurrentCacheVersion = 2;
+
+    // Each level of detail of the stars contains half of the stars of the previous level,
+    // down to this minimum number of stars
+    constexpr uint64_t MinStarsPerLevel = 1000;
+
+    // The number of stars per covered pixel above which a coarser level of detail is used
+    constexpr float StarsPerPixel = 2.f;
 
     constexpr std::string_view _loggerCat = "RenderableGalaxy";
 
@@ -139,6 +151,16 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo TargetRaycastTimeInfo = {
+        "TargetRaycastTime",
+        "Target Raycast Time",
+        "The GPU time in milliseconds that the volume rendering should take per frame. "
+        "If this value is larger than 0, the resolution of the volume is adapted to meet "
+        "it, lowering the resolution while the camera moves and refining it while the "
+        "camera is still, and the downscale factor is not used.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo NumberOfRayCastingStepsInfo =
     {
         "Steps",
@@ -147,6 +169,26 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveLevelOfDetailInfo = {
+        "AdaptiveLevelOfDetail",
+        "Adaptive Level of Detail",
+        "If this value is enabled, the resolution of the volume and the number of stars "
+        "are reduced based on the size of the galaxy on screen. The volume is sampled "
+        "from a coarser mip level with correspondingly larger steps and fewer, but "
+        "brighter, stars are drawn, which keeps the appearance of the galaxy while "
+        "reducing the rendering cost when the galaxy is far away.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LevelOfDetailBiasInfo = {
+        "LevelOfDetailBias",
+        "Level of Detail Bias",
+        "An offset that is added to the mip level of the volume that is chosen by the "
+        "adaptive level of detail. Positive values lower the resolution even further, "
+        "negative values keep a higher resolution than necessary.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     struct [[codegen::Dictionary(RenderableGalaxy)]] Parameters {
         // [[codegen::verbatim(VolumeRenderingEnabledInfo.description)]]
         std::optional<bool> volumeRenderingEnabled;
@@ -177,6 +219,12 @@ namespace {
         // [[codegen::verbatim(RotationInfo.description)]]
         std::optional<glm::vec3> rotation;
 
+        // [[codegen::verbatim(AdaptiveLevelOfDetailInfo.description)]]
+        std::optional<bool> adaptiveLevelOfDetail;
+
+        // [[codegen::verbatim(LevelOfDetailBiasInfo.description)]]
+        std::optional<float> levelOfDetailBias;
+
         struct Volume {
             std::filesystem::path filename;
             glm::ivec3 dimensions;
@@ -187,6 +235,9 @@ namespace {
 
             // [[codegen::verbatim(DownscaleVolumeRenderingInfo.description)]]
             std::optional<float> downscale;
+
+            // [[codegen::verbatim(TargetRaycastTimeInfo.description)]]
+            std::optional<float> targetRaycastTime [[codegen::greaterequal(0)]];
         };
         Volume volume;
 
@@ -204,7 +255,8 @@ namespace {
 
     void saveCachedFile(const std::filesystem::path& file,
                         const std::vector<glm::vec3>& positions,
-                        const std::vector<glm::vec3>& colors, int64_t nPoints,
+                        const std::vector<glm::vec3>& colors,
+                        const std::vector<uint64_t>& levels, int64_t nPoints,
                         float pointsRatio)
     {
         std::ofstream fileStream(file, std::ofstream::binary);
@@ -232,6 +284,23 @@ namespace {
             reinterpret_cast<const char*>(colors.data()),
             colors.size() * sizeof(glm::vec3)
         );
+        uint64_t nLevels = levels.size();
+        fileStream.write(reinterpret_cast<const char*>(&nLevels), sizeof(uint64_t));
+        fileStream.write(
+            reinterpret_cast<const char*>(levels.data()),
+            levels.size() * sizeof(uint64_t)
+        );
+    }
+
+    // Returns the number of stars in each level of detail. As the stars are stored in a
+    // random order, each level is a prefix of the star list that contains an unbiased
+    // subset of the stars of the previous level
+    std::vector<uint64_t> pointLevels(uint64_t nPoints) {
+        std::vector<uint64_t> levels = { nPoints };
+        while (levels.back() / 2 >= MinStarsPerLevel) {
+            levels.push_back(levels.back() / 2);
+        }
+        return levels;
     }
 
     float safeLength(const glm::vec3& vector) {
@@ -267,7 +336,10 @@ RenderableGalaxy::RenderableGalaxy(const ghoul::Dictionary& dictionary)
         glm::vec3(glm::two_pi<float>())
     )
     , _downScaleVolumeRendering(DownscaleVolumeRenderingInfo, 1.f, 0.1f, 1.f)
+    , _targetRaycastTime(TargetRaycastTimeInfo, 0.f, 0.f, 100.f)
     , _numberOfRayCastingSteps(NumberOfRayCastingStepsInfo, 1000.f, 1.f, 1000.f)
+    , _adaptiveLevelOfDetail(AdaptiveLevelOfDetailInfo, true)
+    , _levelOfDetailBias(LevelOfDetailBiasInfo, 0.f, -4.f, 4.f)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -288,12 +360,15 @@ RenderableGalaxy::RenderableGalaxy(const ghoul::Dictionary& dictionary)
     }
 
     _rotation = p.rotation.value_or(_rotation);
+    _adaptiveLevelOfDetail = p.adaptiveLevelOfDetail.value_or(_adaptiveLevelOfDetail);
+    _levelOfDetailBias = p.levelOfDetailBias.value_or(_levelOfDetailBias);
 
     _volumeFilename = p.volume.filename;
     _volumeDimensions = p.volume.dimensions;
     _volumeSize = p.volume.size;
     _numberOfRayCastingSteps = p.volume.steps.value_or(_numberOfRayCastingSteps);
     _downScaleVolumeRendering = p.volume.downscale.value_or(_downScaleVolumeRendering);
+    _targetRaycastTime = p.volume.targetRaycastTime.value_or(_targetRaycastTime);
 
     _pointsFilename = p.points.filename;
     _enabledPointsRatio = p.points.enabledPointsRatio.value_or(_enabledPointsRatio);
@@ -323,7 +398,10 @@ RenderableGalaxy::RenderableGalaxy(const ghoul::Dictionary& dictionary)
     addProperty(_rotation);
     _downScaleVolumeRendering.setVisibility(properties::Property::Visibility::Developer);
     addProperty(_downScaleVolumeRendering);
+    addProperty(_targetRaycastTime);
     addProperty(_numberOfRayCastingSteps);
+    addProperty(_adaptiveLevelOfDetail);
+    addProperty(_levelOfDetailBias);
 
     // Use max component instead of length, to avoid problems with taking square
     // of huge value
@@ -357,16 +435,19 @@ void RenderableGalaxy::initialize() {
         if (res.success) {
             _pointPositionsCache = std::move(res.positions);
             _pointColorsCache = std::move(res.color);
+            _pointLevels = std::move(res.levels);
         }
         else {
             FileSys.cacheManager()->removeCacheFile(_pointsFilename);
             Result resPoint = loadPointFile();
             _pointPositionsCache = std::move(resPoint.positions);
             _pointColorsCache = std::move(resPoint.color);
+            _pointLevels = std::move(resPoint.levels);
             saveCachedFile(
                 cachedPointsFile,
                 _pointPositionsCache,
                 _pointColorsCache,
+                _pointLevels,
                 _nPoints,
                 _enabledPointsRatio
             );
@@ -377,10 +458,12 @@ void RenderableGalaxy::initialize() {
         ghoul_assert(res.success, "Point file loading failed");
         _pointPositionsCache = std::move(res.positions);
         _pointColorsCache = std::move(res.color);
+        _pointLevels = std::move(res.levels);
         saveCachedFile(
             cachedPointsFile,
             _pointPositionsCache,
             _pointColorsCache,
+            _pointLevels,
             _nPoints,
             _enabledPointsRatio
         );
@@ -409,6 +492,11 @@ void RenderableGalaxy::initializeGL() {
 
     _texture->setDimensions(_volume->dimensions());
     _texture->uploadTexture();
+    // The mip levels are used by the adaptive level of detail of the volume rendering
+    _texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
+    _maxMipLevel = std::floor(std::log2(static_cast<float>(
+        glm::compMax(_volumeDimensions)
+    )));
 
     if (_raycastingShader.empty()) {
         _raycaster = std::make_unique<GalaxyRaycaster>(*_texture);
@@ -532,6 +620,7 @@ void RenderableGalaxy::update(const UpdateData& data) {
     _pointTransform = transform;
 
     _raycaster->setDownscaleRender(_downScaleVolumeRendering);
+    _raycaster->setTargetRaycastTime(_targetRaycastTime);
     _raycaster->setMaxSteps(static_cast<int>(_numberOfRayCastingSteps));
     _raycaster->setStepSize(_stepSize);
     _raycaster->setAspect(_aspect);
@@ -542,15 +631,36 @@ void RenderableGalaxy::update(const UpdateData& data) {
 }
 
 void RenderableGalaxy::render(const RenderData& data, RendererTasks& tasks) {
+    const glm::vec3 position = data.camera.positionVec3();
+    const float length = safeLength(position);
+    const float maxDim = glm::compMax(_volumeSize);
+
+    // The approximate number of pixels that the galaxy covers vertically on screen, which
+    // determines the level of detail of both the volume and the stars. Inside the galaxy
+    // it always covers the whole screen, so the full resolution is used
+    float pixelSize = std::numeric_limits<float>::max();
+    if (_adaptiveLevelOfDetail && length > maxDim) {
+        const float resolution =
+            static_cast<float>(global::renderEngine->renderingResolution().y);
+        const float cotHalfFov = data.camera.projectionMatrix()[1][1];
+        pixelSize = maxDim / length * cotHalfFov * 0.5f * resolution;
+    }
+
     // Render the volume
     if (_raycaster && _volumeRenderingEnabled) {
         const RaycasterTask task { _raycaster.get(), data };
 
-        const glm::vec3 position = data.camera.positionVec3();
-        const float length = safeLength(position);
-        const glm::vec3 galaxySize = _volumeSize;
-
-        const float maxDim = glm::compMax(galaxySize);
+        // Choose the mip level whose voxels are about the size of a pixel
+        float levelOfDetail = 0.f;
+        if (_adaptiveLevelOfDetail && length > maxDim) {
+            const float nVoxels = static_cast<float>(glm::compMax(_volumeDimensions));
+            levelOfDetail = std::clamp(
+                std::log2(nVoxels / std::max(pixelSize, 1.f)) + _levelOfDetailBias,
+                0.f,
+                _maxMipLevel
+            );
+        }
+        _raycaster->setLevelOfDetail(levelOfDetail);
 
         const float lowerRampStart = maxDim * 0.01f;
         const float lowerRampEnd = maxDim * 0.1f;
@@ -588,10 +698,25 @@ void RenderableGalaxy::render(const RenderData& data, RendererTasks& tasks) {
         }
     }
 
-    if (!_starRenderingEnabled || _opacityCoefficient <= 0.f) {
+    if (!_starRenderingEnabled || _opacityCoefficient <= 0.f || _pointLevels.empty()) {
         return;
     }
 
+    // Use the coarsest level that still has enough stars to cover the pixels of the
+    // galaxy. Each star of a coarser level stands in for the skipped stars of the finer
+    // levels, so it is made brighter accordingly to keep the overall brightness
+    const float nPixels = pixelSize * pixelSize;
+    size_t level = 0;
+    while (level + 1 < _pointLevels.size() &&
+           static_cast<float>(_pointLevels[level + 1]) * _enabledPointsRatio >=
+           nPixels * StarsPerPixel)
+    {
+        level++;
+    }
+    _nPointsToDraw = static_cast<GLsizei>(_pointLevels[level] * _enabledPointsRatio);
+    _pointBrightnessScale =
+        static_cast<float>(_pointLevels[0]) / static_cast<float>(_pointLevels[level]);
+
     if (_starRenderingMethod == 1) {
         if (_billboardsProgram) {
             renderBillboards(data);
@@ -642,9 +767,13 @@ void RenderableGalaxy::renderPoints(const RenderData& data) {
         _uniformCachePoints.opacityCoefficient,
         _opacityCoefficient
     );
+    _pointsProgram->setUniform(
+        _uniformCachePoints.brightnessScale,
+        _pointBrightnessScale
+    );
 
     glBindVertexArray(_pointsVao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_nPoints * _enabledPointsRatio));
+    glDrawArrays(GL_POINTS, 0, _nPointsToDraw);
     glBindVertexArray(0);
 
     _pointsProgram->deactivate();
@@ -697,9 +826,13 @@ void RenderableGalaxy::renderBillboards(const RenderData& data) {
     psfUnit.activate();
     _pointSpreadFunctionTexture->bind();
     _billboardsProgram->setUniform(_uniformCacheBillboards.psfTexture, psfUnit);
+    _billboardsProgram->setUniform(
+        _uniformCacheBillboards.brightnessScale,
+        _pointBrightnessScale
+    );
 
     glBindVertexArray(_pointsVao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_nPoints * _enabledPointsRatio));
+    glDrawArrays(GL_POINTS, 0, _nPointsToDraw);
     glBindVertexArray(0);
 
     _billboardsProgram->deactivate();
@@ -751,10 +884,22 @@ RenderableGalaxy::Result RenderableGalaxy::loadPointFile() {
         pointColors.emplace_back(r, g, b);
     }
 
+    // Bring the stars into a random order so that every prefix of the list, and thus
+    // every level of detail, is an unbiased subset of the stars. The fixed seed keeps the
+    // order the same between runs
+    std::vector<size_t> order(pointPositions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(1337));
+
     Result res;
     res.success = true;
-    res.positions = std::move(pointPositions);
-    res.color = std::move(pointColors);
+    res.positions.reserve(order.size());
+    res.color.reserve(order.size());
+    for (const size_t i : order) {
+        res.positions.push_back(pointPositions[i]);
+        res.color.push_back(pointColors[i]);
+    }
+    res.levels = pointLevels(res.positions.size());
     return res;
 }
 
@@ -766,14 +911,14 @@ RenderableGalaxy::Result RenderableGalaxy::loadCachedFile(
     std::ifstream fileStream = std::ifstream(file, std::ifstream::binary);
     if (!fileStream.good()) {
         LERROR(std::format("Error opening file '{}' for loading cache file", file));
-        return { false, {}, {} };
+        return { false, {}, {}, {} };
     }
 
     int8_t cacheVersion = 0;
     fileStream.read(reinterpret_cast<char*>(&cacheVersion), sizeof(int8_t));
     if (cacheVersion != CurrentCacheVersion) {
         LINFO(std::format("Removing cache file '{}' as the version changed", file));
-        return { false, {}, {} };
+        return { false, {}, {}, {} };
     }
 
     int64_t nPoints = 0;
@@ -799,10 +944,17 @@ RenderableGalaxy::Result RenderableGalaxy::loadCachedFile(
     colors.resize(nColors);
     fileStream.read(reinterpret_cast<char*>(colors.data()), nColors * sizeof(glm::vec3));
 
+    uint64_t nLevels = 0;
+    fileStream.read(reinterpret_cast<char*>(&nLevels), sizeof(uint64_t));
+    std::vector<uint64_t> levels;
+    levels.resize(nLevels);
+    fileStream.read(reinterpret_cast<char*>(levels.data()), nLevels * sizeof(uint64_t));
+
     Result result;
     result.success = true;
     result.positions = std::move(positions);
     result.color = std::move(colors);
+    result.levels = std::move(levels);
     return result;
 }
 
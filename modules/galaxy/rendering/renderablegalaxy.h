@@ -65,6 +65,8 @@ private:
         bool success;
         std::vector<glm::vec3> positions;
         std::vector<glm::vec3> color;
+        /// The number of stars in each level of detail, starting with the finest level
+        std::vector<uint64_t> levels;
     };
     Result loadPointFile();
     Result loadCachedFile(const std::filesystem::path& file);
@@ -80,7 +82,10 @@ private:
     properties::FloatProperty _enabledPointsRatio;
     properties::Vec3Property _rotation;
     properties::FloatProperty _downScaleVolumeRendering;
+    properties::FloatProperty _targetRaycastTime;
     properties::FloatProperty _numberOfRayCastingSteps;
+    properties::BoolProperty _adaptiveLevelOfDetail;
+    properties::FloatProperty _levelOfDetailBias;
 
     std::unique_ptr<ghoul::opengl::Texture> _pointSpreadFunctionTexture;
     std::unique_ptr<ghoul::filesystem::File> _pointSpreadFunctionFile;
@@ -97,20 +102,26 @@ private:
     glm::mat4 _pointTransform = glm::mat4(1.f);
     glm::vec3 _aspect = glm::vec3(0.f);
     float _opacityCoefficient = 0.f;
+    float _maxMipLevel = 0.f;
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _pointsProgram;
     std::unique_ptr<ghoul::opengl::ProgramObject> _billboardsProgram;
     UniformCache(
-        modelMatrix, viewProjectionMatrix, eyePosition, opacityCoefficient
+        modelMatrix, viewProjectionMatrix, eyePosition, opacityCoefficient,
+        brightnessScale
     ) _uniformCachePoints;
     UniformCache(
-        modelMatrix, viewProjectionMatrix, cameraUp, eyePosition, psfTexture
+        modelMatrix, viewProjectionMatrix, cameraUp, eyePosition, psfTexture,
+        brightnessScale
     ) _uniformCacheBillboards;
     std::vector<float> _pointsData;
     size_t _nPoints = 0;
     GLuint _pointsVao = 0;
     GLuint _positionVbo = 0;
     GLuint _colorVbo = 0;
+    std::vector<uint64_t> _pointLevels;
+    GLsizei _nPointsToDraw = 0;
+    float _pointBrightnessScale = 1.f;
 
     std::vector<glm::vec3> _pointPositionsCache;
     std::vector<glm::vec3> _pointColorsCache;
@@ -30,11 +30,13 @@ flat in vec3 ge_color;
 flat in float ge_screenSpaceDepth;
 
 uniform sampler2D psfTexture;
+// Compensates for the stars that are skipped when a coarser level of detail is drawn
+uniform float brightnessScale;
 
 
 Fragment getFragment() {
   vec4 textureColor = texture(psfTexture, 0.5 * psfCoords + 0.5);
-  vec4 fullColor = vec4(ge_color * textureColor.a, textureColor.a);
+  vec4 fullColor = vec4(ge_color * textureColor.a * brightnessScale, textureColor.a);
   if (fullColor.a == 0) {
     discard;
   }
@@ -28,12 +28,16 @@ uniform float opacityCoefficient#{id} = 1.0;
 uniform float absorptionMultiply#{id} = 50.0;
 uniform float emissionMultiply#{id} = 1500.0;
 uniform sampler3D galaxyTexture#{id};
+// The mip level of the volume that is sampled. The step size grows with the voxel size
+// of the level so that the volume is still sampled about once per voxel
+uniform float levelOfDetail#{id} = 0.0;
 
 void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
                  inout vec3 accumulatedAlpha, inout float stepSize)
 {
   vec3 aspect = aspect#{id};
-  stepSize = maxStepSize#{id} / length(dir / aspect);
+  float stepScale = exp2(levelOfDetail#{id});
+  stepSize = maxStepSize#{id} * stepScale / length(dir / aspect);
 
   // Early ray termination on black parts of the data
   vec3 normalizedPos = samplePos * 2.0 - 1.0;
@@ -41,7 +45,7 @@ void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
     return;
   }
 
-  vec4 sampledColor = texture(galaxyTexture#{id}, samplePos.xyz);
+  vec4 sampledColor = textureLod(galaxyTexture#{id}, samplePos.xyz, levelOfDetail#{id});
 
   // Source textures currently are square-rooted to avoid dithering in the shadows.
   // So square them back
@@ -64,10 +68,14 @@ void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
   accumulatedColor.rgb +=
     sampledColor.rgb * stepSize * emissionMultiply#{id} * opacityCoefficient#{id};
 
+  // The alpha of a sample is corrected for the step size, so that fewer but longer steps
+  // on a coarser level accumulate the same opacity as the full resolution
+  vec3 sampleAlpha = clamp(sampledColor.rgb * opacityCoefficient#{id}, 0.0, 1.0);
+  sampleAlpha = vec3(1.0) - pow(vec3(1.0) - sampleAlpha, vec3(stepScale));
   vec3 oneMinusFrontAlpha = vec3(1.0) - accumulatedAlpha;
-  accumulatedAlpha += oneMinusFrontAlpha * sampledColor.rgb  * opacityCoefficient#{id};
+  accumulatedAlpha += oneMinusFrontAlpha * sampleAlpha;
 }
 
 float stepSize#{id}(vec3 samplePos, vec3 dir) {
-  return maxStepSize#{id} * length(dir * 1.0 / aspect#{id});
+  return maxStepSize#{id} * exp2(levelOfDetail#{id}) * length(dir * 1.0 / aspect#{id});
 }
@@ -31,6 +31,8 @@ in float vs_screenSpaceDepth;
 in float vs_starBrightness;
 
 uniform float opacityCoefficient;
+// Compensates for the stars that are skipped when a coarser level of detail is drawn
+uniform float brightnessScale;
 
 
 Fragment getFragment() {
@@ -43,7 +45,8 @@ Fragment getFragment() {
   // moves further away.  Otherwise they would occlude the main milkway image even though
   // they themselves nolonger have any color contribution left
   vec4 fullColor = vec4(
-    vs_color * extinction * vs_starBrightness * multipliedOpacityCoefficient,
+    vs_color * extinction * vs_starBrightness * multipliedOpacityCoefficient *
+      brightnessScale,
     vs_starBrightness
   );
   frag.color = fullColor;
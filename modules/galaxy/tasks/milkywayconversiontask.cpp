@@ -24,13 +24,49 @@
 
 #include <modules/galaxy/tasks/milkywayconversiontask.h>
 
-#include <modules/volume/textureslicevolumereader.h>
-#include <modules/volume/rawvolumewriter.h>
 #include <modules/volume/volumesampler.h>
 #include <openspace/documentation/documentation.h>
+#include <ghoul/format.h>
+#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <thread>
+#include <utility>
 
 namespace {
+    using Voxel = glm::tvec4<GLfloat>;
+
+    // The input slices that are needed to resample the current batch of output slices.
+    // It provides the interface that the VolumeSampler expects and, contrary to the
+    // TextureSliceVolumeReader, can be sampled from multiple threads at the same time as
+    // it never modifies its slices while sampling
+    struct SliceWindow {
+        using VoxelType = Voxel;
+
+        VoxelType get(const glm::ivec3& coordinates) const {
+            const ghoul::opengl::Texture& slice = *slices[coordinates.z];
+            return slice.texel<VoxelType>(glm::uvec2(coordinates.x, coordinates.y));
+        }
+
+        glm::ivec3 dimensions() const {
+            return dims;
+        }
+
+        glm::ivec3 dims = glm::ivec3(0);
+        // Indexed by the slice number, only the slices of the window are loaded
+        std::vector<std::shared_ptr<ghoul::opengl::Texture>> slices;
+    };
+
+    std::shared_ptr<ghoul::opengl::Texture> loadSlice(const std::string& path) {
+        return ghoul::io::TextureReader::ref().loadTexture(path, 2);
+    }
+
     struct [[codegen::Dictionary(MilkywayConversionTask)]] Parameters {
         std::string inFilenamePrefix;
         std::string inFilenameSuffix;
@@ -38,12 +74,17 @@ namespace {
         int inNSlices;
         std::string outFilename;
         glm::ivec3 outDimensions;
+
+        // The number of threads that load and resample the slices. If this value is 0
+        // or not specified, one thread per hardware thread is used. The number of input
+        // slices that are kept in memory grows with the number of threads
+        std::optional<int> nThreads [[codegen::greaterequal(0)]];
     };
 #include "milkywayconversiontask_codegen.cpp"
 } // namespace
 
 namespace openspace {
-    
+
 documentation::Documentation MilkywayConversionTask::Documentation() {
     return codegen::doc<Parameters>("galaxy_milkywayconversiontask");
 }
@@ -56,6 +97,10 @@ MilkywayConversionTask::MilkywayConversionTask(const ghoul::Dictionary& dictiona
     _inNSlices = p.inNSlices;
     _outFilename = p.outFilename;
     _outDimensions = p.outDimensions;
+    _nThreads = p.nThreads.value_or(_nThreads);
+    if (_nThreads == 0) {
+        _nThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
 }
 
 std::string MilkywayConversionTask::description() {
@@ -72,27 +117,96 @@ void MilkywayConversionTask::perform(const Task::ProgressCallback& onProgress) {
         );
     }
 
-    TextureSliceVolumeReader<glm::tvec4<GLfloat>> sliceReader(filenames, _inNSlices, 10);
-    sliceReader.initialize();
-
-    RawVolumeWriter<glm::tvec4<GLfloat>> rawWriter(_outFilename);
-    rawWriter.setDimensions(_outDimensions);
+    SliceWindow window;
+    window.slices.resize(filenames.size());
+    window.slices[0] = loadSlice(filenames[0]);
+    window.dims = glm::ivec3(
+        glm::ivec2(window.slices[0]->dimensions()),
+        static_cast<int>(filenames.size())
+    );
 
-    const glm::vec3 resolutionRatio = static_cast<glm::vec3>(sliceReader.dimensions()) /
-                                      static_cast<glm::vec3>(rawWriter.dimensions());
+    const glm::ivec3 outDims = _outDimensions;
+    const glm::vec3 resolutionRatio =
+        static_cast<glm::vec3>(window.dims) / static_cast<glm::vec3>(outDims);
+    const VolumeSampler<SliceWindow> sampler(&window, resolutionRatio);
 
-    const VolumeSampler<TextureSliceVolumeReader<glm::tvec4<GLfloat>>> sampler(
-        &sliceReader,
-        resolutionRatio
-    );
-    auto sampleFunction = [resolutionRatio, sampler](const glm::ivec3& outCoord) {
-        const glm::vec3 inCoord =
-            ((glm::vec3(outCoord) + glm::vec3(0.5f)) * resolutionRatio) - glm::vec3(0.5f);
-        const glm::tvec4<GLfloat> value = sampler.sample(inCoord);
-        return value;
+    // The (inclusive) range of input slices that the sampler reads for an output slice.
+    // This is a conservative estimate of the filter footprint used in the VolumeSampler
+    const int margin = static_cast<int>(std::ceil(resolutionRatio.z / 2.f));
+    auto inputRange = [&](int outZ) {
+        const float inZ = (static_cast<float>(outZ) + 0.5f) * resolutionRatio.z - 0.5f;
+        const int z = static_cast<int>(std::floor(inZ));
+        return std::pair(
+            std::clamp(z - margin, 0, window.dims.z - 1),
+            std::clamp(z + margin + 1, 0, window.dims.z - 1)
+        );
     };
 
-    rawWriter.write(sampleFunction, onProgress);
+    std::ofstream file = std::ofstream(_outFilename, std::ios::binary);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(
+            std::format("Could not create file '{}'", _outFilename)
+        );
+    }
+
+    // Each thread resamples one output slice per batch, so only the input slices of the
+    // current batch and one batch of output slices are kept in memory at any time
+    const size_t sliceSize = static_cast<size_t>(outDims.x) * outDims.y;
+    std::vector<Voxel> buffer(sliceSize * _nThreads);
+
+    for (int first = 0; first < outDims.z; first += _nThreads) {
+        const int last = std::min(first + _nThreads, outDims.z) - 1;
+        const int low = inputRange(first).first;
+        const int high = inputRange(last).second;
+
+        // The batches advance monotonically, so the slices before the window are never
+        // needed again
+        for (int z = 0; z < low; z++) {
+            window.slices[z] = nullptr;
+        }
+
+        std::vector<int> missing;
+        for (int z = low; z <= high; z++) {
+            if (!window.slices[z]) {
+                missing.push_back(z);
+            }
+        }
+        std::vector<std::future<void>> loads;
+        for (int t = 0; t < std::min(_nThreads, static_cast<int>(missing.size())); t++) {
+            loads.push_back(std::async(std::launch::async, [&, t]() {
+                for (size_t i = t; i < missing.size(); i += _nThreads) {
+                    window.slices[missing[i]] = loadSlice(filenames[missing[i]]);
+                }
+            }));
+        }
+        for (std::future<void>& load : loads) {
+            load.get();
+        }
+
+        std::vector<std::future<void>> jobs;
+        for (int z = first; z <= last; z++) {
+            jobs.push_back(std::async(std::launch::async, [&, z]() {
+                Voxel* out = buffer.data() + (z - first) * sliceSize;
+                for (int y = 0; y < outDims.y; y++) {
+                    for (int x = 0; x < outDims.x; x++) {
+                        const glm::vec3 inCoord =
+                            (glm::vec3(x, y, z) + glm::vec3(0.5f)) * resolutionRatio -
+                            glm::vec3(0.5f);
+                        out[y * outDims.x + x] = sampler.sample(inCoord);
+                    }
+                }
+            }));
+        }
+        for (std::future<void>& job : jobs) {
+            job.get();
+        }
+
+        file.write(
+            reinterpret_cast<const char*>(buffer.data()),
+            (last - first + 1) * sliceSize * sizeof(Voxel)
+        );
+        onProgress(static_cast<float>(last + 1) / static_cast<float>(outDims.z));
+    }
 }
 
 } // namespace openspace
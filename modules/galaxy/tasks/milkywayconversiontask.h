@@ -36,7 +36,10 @@ namespace documentation { struct Documentation; }
 
 /**
  * Converts a set of exr image slices to a raw volume with floating point RGBA data (32
- * bit per channel).
+ * bit per channel). The output volume is resampled in batches of slices that are
+ * distributed over multiple threads and written to disk as soon as a batch is finished,
+ * so that only the input slices that are needed for the current batch are kept in
+ * memory.
  */
 class MilkywayConversionTask : public Task {
 public:
@@ -54,6 +57,7 @@ private:
     size_t _inNSlices = 0;
     std::string _outFilename;
     glm::ivec3 _outDimensions = glm::ivec3(0);
+    int _nThreads = 0;
 };
 
 } // namespace openspace
@@ -25,20 +25,65 @@
 #include <modules/galaxy/tasks/milkywaypointsconversiontask.h>
 
 #include <openspace/documentation/documentation.h>
-
+#include <ghoul/format.h>
+#include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cstdlib>
 #include <fstream>
-#include <iostream>
+#include <future>
+#include <thread>
 #include <vector>
 
-namespace openspace {
+namespace {
+    constexpr int ValuesPerPoint = 7;
+
+    // The number of points that are read, converted, and written at a time
+    constexpr int64_t BatchSize = 1 << 20;
+
+    // Parses the seven values of a single point from the \p line into \p values and
+    // returns whether the line contained seven valid values
+    bool parsePoint(const std::string& line, float* values) {
+        const char* p = line.c_str();
+        for (int i = 0; i < ValuesPerPoint; i++) {
+            char* end = nullptr;
+            values[i] = std::strtof(p, &end);
+            if (end == p) {
+                return false;
+            }
+            p = end;
+        }
+        return true;
+    }
+
+    struct [[codegen::Dictionary(MilkywayPointsConversionTask)]] Parameters {
+        // The ASCII file that contains the number of points followed by one point per
+        // line
+        std::string inFilename;
+
+        // The binary file that is created
+        std::string outFilename;
 
-/*MilkywayPointsConversionTask::MilkywayPointsConversionTask(
-    const std::string& inFilename,
-    const std::string& outFilename)
-    : _inFilename(inFilename)
-    , _outFilename(outFilename) {}*/
+        // The number of threads that parse the points. If this value is 0 or not
+        // specified, one thread per hardware thread is used
+        std::optional<int> nThreads [[codegen::greaterequal(0)]];
+    };
+#include "milkywaypointsconversiontask_codegen.cpp"
+} // namespace
+
+namespace openspace {
 
-MilkywayPointsConversionTask::MilkywayPointsConversionTask(const ghoul::Dictionary&) {}
+MilkywayPointsConversionTask::MilkywayPointsConversionTask(
+                                                      const ghoul::Dictionary& dictionary)
+{
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+    _inFilename = p.inFilename;
+    _outFilename = p.outFilename;
+    _nThreads = p.nThreads.value_or(_nThreads);
+    if (_nThreads == 0) {
+        _nThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+}
 
 std::string MilkywayPointsConversionTask::description() {
     return std::string();
@@ -46,55 +91,74 @@ std::string MilkywayPointsConversionTask::description() {
 
 void MilkywayPointsConversionTask::perform(const Task::ProgressCallback& progressCallback)
 {
-    std::ifstream in(_inFilename, std::ios::in);
-    std::ofstream out(_outFilename, std::ios::out | std::ios::binary);
+    std::ifstream in = std::ifstream(_inFilename, std::ios::in);
+    if (!in.good()) {
+        throw ghoul::RuntimeError(std::format("Could not open file '{}'", _inFilename));
+    }
+    std::ofstream out = std::ofstream(_outFilename, std::ios::out | std::ios::binary);
+    if (!out.good()) {
+        throw ghoul::RuntimeError(
+            std::format("Could not create file '{}'", _outFilename)
+        );
+    }
 
     std::string format;
     int64_t nPoints = 0;
     in >> format >> nPoints;
+    // Skip the remainder of the header line
+    std::string line;
+    std::getline(in, line);
 
-    const size_t nFloats = nPoints * 7;
-
-    std::vector<float> pointData(nFloats);
-
-    float x = 0.f;
-    float y = 0.f;
-    float z = 0.f;
-    float r = 0.f;
-    float g = 0.f;
-    float b = 0.f;
-    float a = 0.f;
-
-    for (int64_t i = 0; i < nPoints; i++) {
-        in >> x >> y >> z >> r >> g >> b >> a;
-        if (in.good()) {
-            pointData[i * 7 + 0] = x;
-            pointData[i * 7 + 1] = y;
-            pointData[i * 7 + 2] = z;
-            pointData[i * 7 + 3] = r;
-            pointData[i * 7 + 4] = g;
-            pointData[i * 7 + 5] = b;
-            pointData[i * 7 + 6] = a;
-            progressCallback(static_cast<float>(i + 1) / nPoints);
-        }
-        else {
-            std::cout << "Failed to convert point data";
-            return;
+    out.write(reinterpret_cast<char*>(&nPoints), sizeof(int64_t));
+
+    // The points are converted in batches so that the memory usage does not depend on
+    // the size of the dataset. Reading the lines is sequential, but parsing them is
+    // distributed over the threads
+    std::vector<std::string> lines;
+    std::vector<float> pointData;
+    for (int64_t first = 0; first < nPoints; first += BatchSize) {
+        const int64_t nBatch = std::min(BatchSize, nPoints - first);
+
+        lines.resize(nBatch);
+        for (int64_t i = 0; i < nBatch; i++) {
+            if (!std::getline(in, lines[i])) {
+                throw ghoul::RuntimeError(std::format(
+                    "Failed to convert point data. Expected {} points, found {}",
+                    nPoints, first + i
+                ));
+            }
         }
-    }
 
-    out.write(reinterpret_cast<char*>(&nPoints), sizeof(int64_t));
-    out.write(reinterpret_cast<char*>(pointData.data()), nFloats * sizeof(float));
+        pointData.resize(nBatch * ValuesPerPoint);
+        std::vector<std::future<bool>> workers;
+        for (int t = 0; t < _nThreads; t++) {
+            workers.push_back(std::async(std::launch::async, [&, t]() {
+                for (int64_t i = t; i < nBatch; i += _nThreads) {
+                    if (!parsePoint(lines[i], &pointData[i * ValuesPerPoint])) {
+                        return false;
+                    }
+                }
+                return true;
+            }));
+        }
+        bool success = true;
+        for (std::future<bool>& worker : workers) {
+            success &= worker.get();
+        }
+        if (!success) {
+            throw ghoul::RuntimeError("Failed to convert point data");
+        }
 
-    in.close();
-    out.close();
+        out.write(
+            reinterpret_cast<char*>(pointData.data()),
+            pointData.size() * sizeof(float)
+        );
+        progressCallback(static_cast<float>(first + nBatch) / nPoints);
+    }
 }
 
 documentation::Documentation MilkywayPointsConversionTask::Documentation() {
-    return {
-        "MilkywayPointsConversionTask",
-        "galaxy_milkywaypointsconversiontask"
-    };
+    return codegen::doc<Parameters>("galaxy_milkywaypointsconversiontask");
 }
 
 } // namespace openspace
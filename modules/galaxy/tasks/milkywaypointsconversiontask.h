@@ -39,7 +39,9 @@ namespace documentation { struct Documentation; }
  * int64_t n
  * (float x, float y, float z, float r, float g, float b) * n
  * ```
- * to a binary (floating point) representation with the same layout.
+ * to a binary (floating point) representation with the same layout. The points are
+ * converted in batches whose parsing is distributed over multiple threads and that are
+ * written to disk as soon as they are finished.
  */
 class MilkywayPointsConversionTask : public Task {
 public:
@@ -54,6 +56,7 @@ public:
 private:
     std::string _inFilename;
     std::string _outFilename;
+    int _nThreads = 0;
 };
 
 } // namespace openspace
@@ -31,15 +31,18 @@
 #include <modules/globebrowsing/src/geojson/geojsoncomponent.h>
 #include <modules/globebrowsing/src/geojson/geojsonmanager.h>
 #include <modules/globebrowsing/src/geojson/geojsonproperties.h>
+#include <modules/globebrowsing/src/globebrowsingbenchmark.h>
 #include <modules/globebrowsing/src/globelabelscomponent.h>
 #include <modules/globebrowsing/src/globetranslation.h>
 #include <modules/globebrowsing/src/globerotation.h>
 #include <modules/globebrowsing/src/layer.h>
 #include <modules/globebrowsing/src/layeradjustment.h>
 #include <modules/globebrowsing/src/layergroup.h>
+#include <modules/globebrowsing/src/disktilecache.h>
 #include <modules/globebrowsing/src/layermanager.h>
 #include <modules/globebrowsing/src/memoryawaretilecache.h>
 #include <modules/globebrowsing/src/renderableglobe.h>
+#include <modules/globebrowsing/src/tileioscheduler.h>
 #include <modules/globebrowsing/src/tileprovider/defaulttileprovider.h>
 #include <modules/globebrowsing/src/tileprovider/imagesequencetileprovider.h>
 #include <modules/globebrowsing/src/tileprovider/singleimagetileprovider.h>
@@ -74,6 +77,7 @@
 #include <ghoul/misc/templatefactory.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
+#include <thread>
 #include <vector>
 
 #include <gdal.h>
@@ -123,6 +127,45 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo DiskTileCacheEnabledInfo = {
+        "DiskTileCacheEnabled",
+        "Disk Tile Cache Enabled",
+        "Determines whether tiles that are loaded through the network are stored in a "
+        "compressed form on disk, so that they do not have to be requested again after "
+        "restarting.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DiskTileCacheLocationInfo = {
+        "DiskTileCacheLocation",
+        "Disk Tile Cache Location",
+        "The location of the root folder for the disk tile cache. Changing this value "
+        "does not move a disk tile cache that is already in use.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DiskTileCacheSizeInfo = {
+        "DiskTileCacheSize",
+        "Disk Tile Cache Size",
+        "The maximum size of the disk tile cache in MB. If the cache grows larger, the "
+        "least recently used tiles are removed.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TileIOThreadsInfo = {
+        "TileIOThreads",
+        "Tile IO Threads",
+        "The number of threads that are used to load the tiles of all layers on all "
+        "globes. The tiles that cover the largest area on the screen are loaded first, "
+        "regardless of which globe they belong to. This value can only be set at "
+        "startup.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    // The maximum number of tiles that each tile provider can have waiting to be loaded.
+    // If more tiles are requested, the provider's oldest requests are dropped
+    constexpr size_t TileIOQueueSize = 10;
+
     openspace::GlobeBrowsingModule::Capabilities
     parseSubDatasets(char** subDatasets, int nSubdatasets)
     {
@@ -191,6 +234,18 @@ namespace {
 
         // [[codegen::verbatim(MRFCacheLocationInfo.description)]]
         std::optional<std::string> mrfCacheLocation [[codegen::key("MRFCacheLocation")]];
+
+        // [[codegen::verbatim(DiskTileCacheEnabledInfo.description)]]
+        std::optional<bool> diskTileCacheEnabled;
+
+        // [[codegen::verbatim(DiskTileCacheLocationInfo.description)]]
+        std::optional<std::string> diskTileCacheLocation;
+
+        // [[codegen::verbatim(DiskTileCacheSizeInfo.description)]]
+        std::optional<int> diskTileCacheSize [[codegen::greater(0)]];
+
+        // [[codegen::verbatim(TileIOThreadsInfo.description)]]
+        std::optional<int> tileIOThreads [[codegen::greater(0)]];
     };
 #include "globebrowsingmodule_codegen.cpp"
 } // namespace
@@ -207,6 +262,15 @@ GlobeBrowsingModule::GlobeBrowsingModule()
     , _defaultGeoPointTexturePath(DefaultGeoPointTextureInfo)
     , _mrfCacheEnabled(MRFCacheEnabledInfo, false)
     , _mrfCacheLocation(MRFCacheLocationInfo, "${BASE}/cache_mrf")
+    , _diskTileCacheEnabled(DiskTileCacheEnabledInfo, false)
+    , _diskTileCacheLocation(DiskTileCacheLocationInfo, "${BASE}/cache_tiles")
+    , _diskTileCacheSizeMB(DiskTileCacheSizeInfo, 4096, 1, 1024 * 1024)
+    , _tileIOThreads(
+        TileIOThreadsInfo,
+        std::max(4u, std::thread::hardware_concurrency()),
+        1,
+        256
+    )
 {
     addProperty(_tileCacheSizeMB);
 
@@ -214,6 +278,13 @@ GlobeBrowsingModule::GlobeBrowsingModule()
 
     addProperty(_mrfCacheEnabled);
     addProperty(_mrfCacheLocation);
+
+    addProperty(_diskTileCacheEnabled);
+    addProperty(_diskTileCacheLocation);
+    addProperty(_diskTileCacheSizeMB);
+
+    _tileIOThreads.setReadOnly(true);
+    addProperty(_tileIOThreads);
 }
 
 void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
@@ -249,6 +320,24 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
     _mrfCacheEnabled = p.mrfCacheEnabled.value_or(_mrfCacheEnabled);
     _mrfCacheLocation = p.mrfCacheLocation.value_or(_mrfCacheLocation);
 
+    _diskTileCacheEnabled = p.diskTileCacheEnabled.value_or(_diskTileCacheEnabled);
+    _diskTileCacheLocation = p.diskTileCacheLocation.value_or(_diskTileCacheLocation);
+    if (p.diskTileCacheSize.has_value()) {
+        _diskTileCacheSizeMB = static_cast<unsigned int>(*p.diskTileCacheSize);
+    }
+    _diskTileCacheEnabled.onChange([this]() { initializeDiskTileCache(); });
+    _diskTileCacheSizeMB.onChange([this]() {
+        if (_diskTileCache) {
+            _diskTileCache->setMaximumSize(_diskTileCacheSizeMB * 1024ULL * 1024ULL);
+        }
+    });
+
+    if (p.tileIOThreads.has_value()) {
+        _tileIOThreads = static_cast<unsigned int>(*p.tileIOThreads);
+    }
+    _tileIOScheduler = std::make_unique<TileIOScheduler>(_tileIOThreads, TileIOQueueSize);
+    _benchmark = std::make_unique<GlobeBrowsingBenchmark>();
+
     // Initialize
     global::callback::initializeGL->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
@@ -256,6 +345,8 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
         _tileCache = std::make_unique<cache::MemoryAwareTileCache>(_tileCacheSizeMB);
         addPropertySubOwner(_tileCache.get());
 
+        initializeDiskTileCache();
+
         TileProvider::initializeDefaultTile();
 
         // Convert from MB to Bytes
@@ -276,13 +367,22 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
     global::callback::render->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
 
+        _tileCache->uploadPendingTiles();
         _tileCache->update();
     });
 
+    global::callback::postDraw->emplace_back([this]() {
+        ZoneScopedN("GlobeBrowsingModule");
+
+        _benchmark->postDraw();
+    });
+
     // Deinitialize
-    global::callback::deinitialize->emplace_back([]() {
+    global::callback::deinitialize->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
 
+        // Waits for the pending tiles to be written to disk
+        _diskTileCache = nullptr;
         GdalWrapper::destroy();
     });
 
@@ -330,6 +430,31 @@ globebrowsing::cache::MemoryAwareTileCache* GlobeBrowsingModule::tileCache() {
     return _tileCache.get();
 }
 
+globebrowsing::cache::DiskTileCache* GlobeBrowsingModule::diskTileCache() {
+    return _diskTileCacheEnabled ? _diskTileCache.get() : nullptr;
+}
+
+globebrowsing::TileIOScheduler* GlobeBrowsingModule::tileIOScheduler() {
+    return _tileIOScheduler.get();
+}
+
+globebrowsing::GlobeBrowsingBenchmark* GlobeBrowsingModule::benchmark() {
+    return _benchmark.get();
+}
+
+void GlobeBrowsingModule::initializeDiskTileCache() {
+    // The cache is never destroyed before shutdown even if it is disabled, as tile load
+    // jobs that are currently running might still be using it
+    if (!_diskTileCacheEnabled || _diskTileCache) {
+        return;
+    }
+
+    _diskTileCache = std::make_unique<globebrowsing::cache::DiskTileCache>(
+        absPath(_diskTileCacheLocation.value()),
+        _diskTileCacheSizeMB * 1024ULL * 1024ULL
+    );
+}
+
 std::vector<documentation::Documentation> GlobeBrowsingModule::documentations() const {
     return {
         globebrowsing::Layer::Documentation(),
@@ -348,6 +473,7 @@ std::vector<documentation::Documentation> GlobeBrowsingModule::documentations()
         globebrowsing::TileProviderByLevel::Documentation(),
         globebrowsing::GeoJsonComponent::Documentation(),
         globebrowsing::GeoJsonProperties::Documentation(),
+        globebrowsing::GlobeBrowsingBenchmark::Documentation(),
         GlobeLabelsComponent::Documentation(),
         RingsComponent::Documentation(),
         ShadowComponent::Documentation()
@@ -685,6 +811,8 @@ scripting::LuaLibrary GlobeBrowsingModule::luaLibrary() const {
             codegen::lua::AddGeoJson,
             codegen::lua::DeleteGeoJson,
             codegen::lua::AddGeoJsonFromFile,
+            codegen::lua::StartBenchmark,
+            codegen::lua::StopBenchmark
         },
         .scripts = {
             absPath("${MODULE_GLOBEBROWSING}/scripts/layer_support.lua"),
@@ -35,12 +35,17 @@
 #include <optional>
 
 namespace openspace::globebrowsing {
+    class GlobeBrowsingBenchmark;
     class RenderableGlobe;
+    class TileIOScheduler;
     struct TileIndex;
     struct Geodetic2;
     struct Geodetic3;
 
-    namespace cache { class MemoryAwareTileCache; }
+    namespace cache {
+        class DiskTileCache;
+        class MemoryAwareTileCache;
+    } // namespace cache
 } // namespace openspace::globebrowsing
 
 namespace openspace {
@@ -69,6 +74,19 @@ public:
         bool useHeightMap = false) const;
 
     globebrowsing::cache::MemoryAwareTileCache* tileCache();
+
+    /**
+     * Returns the persistent cache of tiles on disk, or `nullptr` if the disk tile cache
+     * is disabled.
+     */
+    globebrowsing::cache::DiskTileCache* diskTileCache();
+
+    /**
+     * Returns the threads that load the tiles of all tile providers.
+     */
+    globebrowsing::TileIOScheduler* tileIOScheduler();
+
+    globebrowsing::GlobeBrowsingBenchmark* benchmark();
     scripting::LuaLibrary luaLibrary() const override;
     std::vector<documentation::Documentation> documentations() const override;
     static documentation::Documentation Documentation();
@@ -115,13 +133,22 @@ private:
     void goToGeodetic3(const globebrowsing::RenderableGlobe& globe,
         globebrowsing::Geodetic3 geo3);
 
+    void initializeDiskTileCache();
+
     properties::UIntProperty _tileCacheSizeMB;
 
     properties::StringProperty _defaultGeoPointTexturePath;
     properties::BoolProperty _mrfCacheEnabled;
     properties::StringProperty _mrfCacheLocation;
+    properties::BoolProperty _diskTileCacheEnabled;
+    properties::StringProperty _diskTileCacheLocation;
+    properties::UIntProperty _diskTileCacheSizeMB;
+    properties::UIntProperty _tileIOThreads;
 
     std::unique_ptr<globebrowsing::cache::MemoryAwareTileCache> _tileCache;
+    std::unique_ptr<globebrowsing::cache::DiskTileCache> _diskTileCache;
+    std::unique_ptr<globebrowsing::TileIOScheduler> _tileIOScheduler;
+    std::unique_ptr<globebrowsing::GlobeBrowsingBenchmark> _benchmark;
 
     // name -> capabilities
     std::map<std::string, std::future<Capabilities>> _inFlightCapabilitiesMap;
@@ -855,6 +855,43 @@ geoPositionForCameraDeprecated(bool useEyePosition = false)
     globe->geoJsonManager().addGeoJsonLayer(d);
 }
 
+/**
+ * Starts a benchmark in which the camera flies along a list of waypoints while the frame
+ * times, tile loading latencies, tile cache hit rate, uploaded bytes, and number of
+ * rendered chunks are measured. The results are written to a JSON file once the last
+ * waypoint has been reached. A benchmark that is already running is stopped without
+ * writing its results.
+ *
+ * \param benchmark The settings for the benchmark. See
+ *                  [this page](#globebrowsing_benchmark) for details on what fields and
+ *                  settings the dictionary may contain
+ */
+[[codegen::luawrap]] void startBenchmark(ghoul::Dictionary benchmark) {
+    using namespace openspace;
+
+    try {
+        global::moduleEngine->module<GlobeBrowsingModule>()->benchmark()->start(
+            benchmark
+        );
+    }
+    catch (const ghoul::RuntimeError& e) {
+        throw ghoul::lua::LuaError(
+            std::format("Unable to start benchmark: {}", e.what())
+        );
+    }
+}
+
+/**
+ * Stops the benchmark that is currently running, if there is one.
+ *
+ * \param writeResults If this value is `true`, the results of the frames that have been
+ *                     measured so far are written to the output file of the benchmark
+ */
+[[codegen::luawrap]] void stopBenchmark(bool writeResults = false) {
+    using namespace openspace;
+    global::moduleEngine->module<GlobeBrowsingModule>()->benchmark()->stop(writeResults);
+}
+
 #include "globebrowsingmodule_lua_codegen.cpp"
 
 } // namespace
@@ -0,0 +1,115 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef CHUNKDATA_HGLSL
+#define CHUNKDATA_HGLSL
+
+#include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
+
+#if USE_MULTI_DRAW_INDIRECT
+
+// When all chunks are rendered with a single multi-draw call, the values that would
+// otherwise be set as uniforms for each chunk are read from shader storage buffers
+// instead. The including shader has to define CHUNK_INDEX as the index of the chunk that
+// is currently rendered
+
+#define CHUNK_TILES_PER_LAYER 3
+#define CHUNK_TILES_PER_CHUNK #{chunkTilesPerChunk}
+
+// Keep in sync with RenderableGlobe::GPUChunkData
+struct ChunkData {
+  vec4 p00;
+  vec4 p10;
+  vec4 p01;
+  vec4 p11;
+  vec4 patchNormalCameraSpace;
+  vec2 minLatLon;
+  vec2 lonLatScalingFactor;
+  float skirtLength;
+  int chunkLevel;
+  float deltaTheta0;
+  float deltaTheta1;
+  float deltaPhi0;
+  float deltaPhi1;
+};
+
+// Keep in sync with GPULayerGroup::ChunkTileData
+struct ChunkTileData {
+  uvec2 textureHandle;
+  vec2 uvOffset;
+  vec2 uvScale;
+};
+
+layout(std430) readonly buffer ChunkDataBuffer {
+  ChunkData chunks[];
+};
+
+// CHUNK_TILES_PER_LAYER entries for each active layer of all layer groups, in the order
+// of the layer groups
+layout(std430) readonly buffer ChunkTileBuffer {
+  ChunkTileData chunkTiles[];
+};
+
+#define p00 (chunks[CHUNK_INDEX].p00.xyz)
+#define p10 (chunks[CHUNK_INDEX].p10.xyz)
+#define p01 (chunks[CHUNK_INDEX].p01.xyz)
+#define p11 (chunks[CHUNK_INDEX].p11.xyz)
+#define patchNormalCameraSpace (chunks[CHUNK_INDEX].patchNormalCameraSpace.xyz)
+#define minLatLon (chunks[CHUNK_INDEX].minLatLon)
+#define lonLatScalingFactor (chunks[CHUNK_INDEX].lonLatScalingFactor)
+#define skirtLength (chunks[CHUNK_INDEX].skirtLength)
+#define chunkLevel (chunks[CHUNK_INDEX].chunkLevel)
+#define deltaTheta0 (chunks[CHUNK_INDEX].deltaTheta0)
+#define deltaTheta1 (chunks[CHUNK_INDEX].deltaTheta1)
+#define deltaPhi0 (chunks[CHUNK_INDEX].deltaPhi0)
+#define deltaPhi1 (chunks[CHUNK_INDEX].deltaPhi1)
+
+ChunkTile chunkTileData(int index) {
+  ChunkTileData data = chunkTiles[CHUNK_INDEX * CHUNK_TILES_PER_CHUNK + index];
+
+  ChunkTile result;
+  result.textureSampler = sampler2D(data.textureHandle);
+  result.uvTransform.uvOffset = data.uvOffset;
+  result.uvTransform.uvScale = data.uvScale;
+  return result;
+}
+
+// layer := The index of the layer counted over the active layers of all layer groups
+ChunkTilePile chunkTilePileData(int layer) {
+  ChunkTilePile pile;
+  pile.chunkTile0 = chunkTileData(layer * CHUNK_TILES_PER_LAYER);
+  pile.chunkTile1 = chunkTileData(layer * CHUNK_TILES_PER_LAYER + 1);
+  pile.chunkTile2 = chunkTileData(layer * CHUNK_TILES_PER_LAYER + 2);
+  return pile;
+}
+
+#define CHUNK_TILE_PILE(layers, index, offset) chunkTilePileData((offset) + (index))
+
+#else // USE_MULTI_DRAW_INDIRECT
+
+#define CHUNK_TILE_PILE(layers, index, offset) layers[index].pile
+
+#endif // USE_MULTI_DRAW_INDIRECT
+
+#endif // CHUNKDATA_HGLSL
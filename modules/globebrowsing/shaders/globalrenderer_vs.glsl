@@ -23,9 +23,21 @@
  ****************************************************************************************/
 
 #version __CONTEXT__
+#ifdef GL_ARB_bindless_texture
+#extension GL_ARB_bindless_texture : enable
+#endif // GL_ARB_bindless_texture
 
 #include "PowerScaling/powerScaling_vs.hglsl"
 #include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
+
+#if USE_MULTI_DRAW_INDIRECT
+// All chunks are rendered with a single draw call, so the index of the chunk is passed as
+// a per-instance attribute by SkirtedGrid::drawMultiIndirectUsingActiveProgram
+layout(location = 2) in int in_chunkIndex;
+flat out int fs_chunkIndex;
+#define CHUNK_INDEX in_chunkIndex
+#endif // USE_MULTI_DRAW_INDIRECT
+
 #include <${MODULE_GLOBEBROWSING}/shaders/texturetilemapping.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/tileheight.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/tilevertexskirt.glsl>
@@ -60,13 +72,15 @@ uniform mat4 modelViewProjectionTransform;
 uniform mat4 modelViewTransform;
 uniform vec3 radiiSquared;
 
+#if !USE_MULTI_DRAW_INDIRECT
 uniform vec2 minLatLon;
 uniform vec2 lonLatScalingFactor;
+uniform int chunkLevel;
+#endif // !USE_MULTI_DRAW_INDIRECT
+
 uniform vec3 cameraPosition;
 uniform float chunkMinHeight;
-
 uniform float distanceScaleFactor;
-uniform int chunkLevel;
 
 struct PositionNormalPair {
   vec3 position;
@@ -130,6 +144,9 @@ void main() {
 
   // Write output
   fs_uv = in_uv;
+#if USE_MULTI_DRAW_INDIRECT
+  fs_chunkIndex = in_chunkIndex;
+#endif // USE_MULTI_DRAW_INDIRECT
   fs_position = z_normalization(positionClippingSpace);
   gl_Position = fs_position;
   ellipsoidNormalCameraSpace = mat3(modelViewTransform) * pair.normal;
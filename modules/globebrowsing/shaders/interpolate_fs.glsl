@@ -29,6 +29,7 @@ in vec2 texCoord;
 uniform sampler2D prevTexture;
 uniform sampler2D nextTexture;
 uniform sampler1D colormapTexture;
+uniform bool useColormap;
 uniform float blendFactor;
 
 
@@ -39,6 +40,11 @@ Fragment getFragment() {
   vec4 mixedTexture = mix(texel0, texel1, blendFactor);
 
   Fragment frag;
+  if (!useColormap) {
+    frag.color = mixedTexture;
+    return frag;
+  }
+
   if (mixedTexture.r > 0.999) {
     frag.color = texture(colormapTexture, mixedTexture.r - 0.01);
   }
@@ -23,9 +23,21 @@
  ****************************************************************************************/
 
 #version __CONTEXT__
+#ifdef GL_ARB_bindless_texture
+#extension GL_ARB_bindless_texture : enable
+#endif // GL_ARB_bindless_texture
 
 #include "PowerScaling/powerScaling_vs.hglsl"
 #include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
+
+#if USE_MULTI_DRAW_INDIRECT
+// All chunks are rendered with a single draw call, so the index of the chunk is passed as
+// a per-instance attribute by SkirtedGrid::drawMultiIndirectUsingActiveProgram
+layout(location = 2) in int in_chunkIndex;
+flat out int fs_chunkIndex;
+#define CHUNK_INDEX in_chunkIndex
+#endif // USE_MULTI_DRAW_INDIRECT
+
 #include <${MODULE_GLOBEBROWSING}/shaders/texturetilemapping.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/tileheight.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/tilevertexskirt.glsl>
@@ -57,15 +69,19 @@ uniform dmat4 inverseViewTransform;
 #endif // SHADOW_MAPPING_ENABLED
 
 uniform mat4 projectionTransform;
+
+#if !USE_MULTI_DRAW_INDIRECT
 // Input points in camera space
 uniform vec3 p00;
 uniform vec3 p10;
 uniform vec3 p01;
 uniform vec3 p11;
 uniform vec3 patchNormalCameraSpace;
+uniform int chunkLevel;
+#endif // !USE_MULTI_DRAW_INDIRECT
+
 uniform float chunkMinHeight;
 uniform float distanceScaleFactor;
-uniform int chunkLevel;
 
 
 vec3 bilinearInterpolation(vec2 uv) {
@@ -114,6 +130,9 @@ void main() {
 
   // Write output
   fs_uv = in_uv;
+#if USE_MULTI_DRAW_INDIRECT
+  fs_chunkIndex = in_chunkIndex;
+#endif // USE_MULTI_DRAW_INDIRECT
   fs_position = z_normalization(positionClippingSpace);
   gl_Position = fs_position;
   ellipsoidNormalCameraSpace = patchNormalCameraSpace;
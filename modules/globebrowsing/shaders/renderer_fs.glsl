@@ -25,6 +25,12 @@
 #include "fragment.glsl"
 
 #include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
+
+#if USE_MULTI_DRAW_INDIRECT
+flat in int fs_chunkIndex;
+#define CHUNK_INDEX fs_chunkIndex
+#endif // USE_MULTI_DRAW_INDIRECT
+
 #include <${MODULE_GLOBEBROWSING}/shaders/texturetilemapping.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/tileheight.glsl>
 #include "PowerScaling/powerScaling_fs.hglsl"
@@ -232,7 +238,10 @@ Fragment getFragment() {
   frag.color += 0.0001 * calculateDebugColor(fs_uv, fs_position, vertexResolution);
   #if USE_HEIGHTMAP
     frag.color.r = min(frag.color.r, 0.8);
-    frag.color.r += tileResolution(fs_uv, HeightLayers[0].pile.chunkTile0) > 0.9 ? 1 : 0;
+    frag.color.r += tileResolution(
+      fs_uv,
+      CHUNK_TILE_PILE(HeightLayers, 0, #{chunkLayerOffsetHeightLayers}).chunkTile0
+    ) > 0.9 ? 1 : 0;
   #endif // USE_HEIGHTMAP
 #endif // SHOW_HEIGHT_RESOLUTION
 
@@ -40,6 +40,8 @@ uniform vec3 sunPosition;
 uniform float nightFactor;
 uniform float zFightingPercentage;
 uniform float opacity;
+uniform bool useBakedShadow;
+uniform sampler2D bakedShadowTexture;
 
 
 Fragment getFragment() {
@@ -76,7 +78,10 @@ Fragment getFragment() {
 
   // shadow == 1.0 means it is not in shadow
   float shadow = 1.0;
-  if (shadowCoords.z >= 0) {
+  if (useBakedShadow) {
+    shadow = texture(bakedShadowTexture, vs_st).r;
+  }
+  else if (shadowCoords.z >= 0) {
     vec4 normalizedShadowCoords = shadowCoords;
     normalizedShadowCoords.z = normalizeFloat(zFightingPercentage * normalizedShadowCoords.w);
     normalizedShadowCoords.xy = normalizedShadowCoords.xy / normalizedShadowCoords.w;
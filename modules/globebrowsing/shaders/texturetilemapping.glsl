@@ -27,6 +27,7 @@
 
 #include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/blending.glsl>
+#include <${MODULE_GLOBEBROWSING}/shaders/chunkdata.glsl>
 
 // First layer type from LayerShaderManager is height map
 #define NUMLAYERS_HEIGHTMAP #{lastLayerIndexHeightLayers} + 1
@@ -113,19 +114,21 @@ vec2 tileUVToTextureSamplePosition(ChunkTile chunkTile, vec2 tileUV)
   return chunkTile.uvTransform.uvOffset + chunkTile.uvTransform.uvScale * tileUV;
 }
 
+vec4 getTexVal(ChunkTile chunkTile, vec2 uv) {
+#if USE_MULTI_DRAW_INDIRECT
+  // Chunk tiles without a texture don't have a handle and must not be sampled
+  if (uvec2(chunkTile.textureSampler) == uvec2(0)) {
+    return vec4(0.0);
+  }
+#endif // USE_MULTI_DRAW_INDIRECT
+
+  return texture(chunkTile.textureSampler, tileUVToTextureSamplePosition(chunkTile, uv));
+}
+
 vec4 getTexVal(ChunkTilePile chunkTilePile, vec3 w, vec2 uv) {
-  vec4 v1 = texture(
-    chunkTilePile.chunkTile0.textureSampler,
-    tileUVToTextureSamplePosition(chunkTilePile.chunkTile0, uv)
-  );
-  vec4 v2 = texture(
-    chunkTilePile.chunkTile1.textureSampler,
-    tileUVToTextureSamplePosition(chunkTilePile.chunkTile1, uv)
-  );
-  vec4 v3 = texture(
-    chunkTilePile.chunkTile2.textureSampler,
-    tileUVToTextureSamplePosition(chunkTilePile.chunkTile2, uv)
-  );
+  vec4 v1 = getTexVal(chunkTilePile.chunkTile0, uv);
+  vec4 v2 = getTexVal(chunkTilePile.chunkTile1, uv);
+  vec4 v3 = getTexVal(chunkTilePile.chunkTile2, uv);
 
   return w.x * v1 + w.y * v2 + w.z * v3;
 }
@@ -138,32 +141,34 @@ vec4 getSample#{layerGroup}#{i}(vec2 uv, vec3 levelWeights,
 {
   vec4 c = vec4(0.0, 0.0, 0.0, 1.0);
 
+#define LayerPile CHUNK_TILE_PILE(#{layerGroup}, #{i}, #{chunkLayerOffset#{layerGroup}})
     // All tile layers are the same. Sample from texture
 #if (#{#{layerGroup}#{i}LayerType} == 0) // DefaultTileProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 1) // SingleImageProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 2) // ImageSequenceTileProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 3) // SizeReferenceTileProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 4) // TemporalTileProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 5) // TileIndexTileProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 6) // TileProviderByDate
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 7) // TileProviderByIndex
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 8) // TileProviderByLevel
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 9) // SolidColor
   c.rgb = #{layerGroup}[#{i}].color;
 #elif (#{#{layerGroup}#{i}LayerType} == 10) // SpoutImageProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #elif (#{#{layerGroup}#{i}LayerType} == 11) // VideoTileProvider
-  c = getTexVal(#{layerGroup}[#{i}].pile, levelWeights, uv);
+  c = getTexVal(LayerPile, levelWeights, uv);
 #endif
+#undef LayerPile
 
   return c;
 }
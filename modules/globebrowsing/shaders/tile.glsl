@@ -25,6 +25,14 @@
 #ifndef TEXTURETILE_HGLSL
 #define TEXTURETILE_HGLSL
 
+#define USE_BINDLESS_TEXTURES #{useBindlessTextures}
+#define USE_MULTI_DRAW_INDIRECT #{useMultiDrawIndirect}
+
+#if USE_BINDLESS_TEXTURES
+// All following samplers can be set either through a texture unit or a texture handle
+layout(bindless_sampler) uniform;
+#endif // USE_BINDLESS_TEXTURES
+
 struct TileDepthTransform {
   float depthScale;
   float depthOffset;
@@ -27,6 +27,7 @@
 
 #include "PowerScaling/powerScaling_vs.hglsl"
 #include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
+#include <${MODULE_GLOBEBROWSING}/shaders/chunkdata.glsl>
 
 #ifndef USE_HEIGHTMAP
 #define USE_HEIGHTMAP #{useAccurateNormals}
@@ -42,10 +43,12 @@ uniform float heightScale;
 #endif // USE_HEIGHTMAP
 
 #if USE_ACCURATE_NORMALS && USE_HEIGHTMAP
+#if !USE_MULTI_DRAW_INDIRECT
 uniform float deltaTheta0;
 uniform float deltaTheta1;
 uniform float deltaPhi0;
 uniform float deltaPhi1;
+#endif // !USE_MULTI_DRAW_INDIRECT
 uniform float tileDelta;
 #endif // USE_ACCURATE_NORMALS && USE_HEIGHTMAP
 
@@ -26,9 +26,13 @@
 #define TILE_VERTEX_SKIRT_HGLSL
 
 #include "PowerScaling/powerScaling_vs.hglsl"
+#include <${MODULE_GLOBEBROWSING}/shaders/chunkdata.glsl>
 
 uniform int xSegments;
+
+#if !USE_MULTI_DRAW_INDIRECT
 uniform float skirtLength;
+#endif // !USE_MULTI_DRAW_INDIRECT
 
 bool tileVertexIsSkirtVertex() {
   int vertexIDx = gl_VertexID % (xSegments + 3);
@@ -24,6 +24,8 @@
 
 #include <modules/globebrowsing/src/asynctiledataprovider.h>
 
+#include <modules/globebrowsing/globebrowsingmodule.h>
+#include <modules/globebrowsing/src/disktilecache.h>
 #include <modules/globebrowsing/src/memoryawaretilecache.h>
 #include <modules/globebrowsing/src/rawtiledatareader.h>
 #include <modules/globebrowsing/src/tileloadjob.h>
@@ -32,21 +34,51 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <filesystem>
 
 namespace openspace::globebrowsing {
 
 namespace {
     constexpr std::string_view _loggerCat = "AsyncTileDataProvider";
+
+    // The jobs that read tiles from remote datasets spend most of their time waiting
+    // for the server to respond, so we allow more of them to run at the same time to keep
+    // several requests in flight instead of queuing all of them behind a single slow one
+    constexpr size_t NRemoteDatasetThreads = 4;
+
+    // Local raster files can be read faster than the tiles can be decompressed, so we
+    // only use the disk cache for datasets that are accessed through the network. These
+    // are either GDAL service descriptions (inline or as a file) or URLs
+    bool isRemoteDataset(const std::string& path) {
+        if (path.starts_with('<') || path.starts_with("/vsicurl") ||
+            path.find("://") != std::string::npos)
+        {
+            return true;
+        }
+
+        const std::filesystem::path extension = std::filesystem::path(path).extension();
+        return extension == ".wms" || extension == ".xml";
+    }
 } // namespace
 
 AsyncTileDataProvider::AsyncTileDataProvider(std::string name,
                                     std::unique_ptr<RawTileDataReader> rawTileDataReader)
     : _name(std::move(name))
     , _rawTileDataReader(std::move(rawTileDataReader))
-    , _concurrentJobManager(LRUThreadPool<TileIndex::TileHashKey>(1, 10))
+    , _concurrentJobManager(
+        *global::moduleEngine->module<GlobeBrowsingModule>()->tileIOScheduler(),
+        isRemoteDataset(_rawTileDataReader->datasetFilePath()) ?
+            NRemoteDatasetThreads :
+            1
+    )
 {
     ZoneScoped;
 
+    const std::string& path = _rawTileDataReader->datasetFilePath();
+    _useDiskTileCache = isRemoteDataset(path);
+    _datasetHash = std::hash<std::string>{}(path) ^
+        (_rawTileDataReader->textureInitData().hashKey * 0x9E3779B97F4A7C15ULL);
+
     performReset(ResetRawTileDataReader::No);
 }
 
@@ -58,7 +90,15 @@ bool AsyncTileDataProvider::enqueueTileIO(const TileIndex& tileIndex) {
     ZoneScoped;
 
     if (_resetMode == ResetMode::ShouldNotReset && satisfiesEnqueueCriteria(tileIndex)) {
-        auto job = std::make_unique<TileLoadJob>(*_rawTileDataReader, tileIndex);
+        cache::DiskTileCache* diskTileCache = _useDiskTileCache ?
+            global::moduleEngine->module<GlobeBrowsingModule>()->diskTileCache() :
+            nullptr;
+        auto job = std::make_unique<TileLoadJob>(
+            *_rawTileDataReader,
+            tileIndex,
+            diskTileCache,
+            _datasetHash
+        );
         _concurrentJobManager.enqueueJob(std::move(job), tileIndex.hashKey());
         _enqueuedTileRequests.insert(tileIndex.hashKey());
         return true;
@@ -66,11 +106,47 @@ bool AsyncTileDataProvider::enqueueTileIO(const TileIndex& tileIndex) {
     return false;
 }
 
-void AsyncTileDataProvider::clearTiles() {
-    std::optional<RawTile> finishedJob = popFinishedRawTile();
-    while (finishedJob) {
-        finishedJob = popFinishedRawTile();
+bool AsyncTileDataProvider::prefetchTileIO(const TileIndex& tileIndex) {
+    ZoneScoped;
+
+    const TileIndex::TileHashKey key = tileIndex.hashKey();
+    if (_resetMode != ResetMode::ShouldNotReset || _enqueuedTileRequests.contains(key)) {
+        return false;
+    }
+
+    cache::DiskTileCache* diskTileCache = _useDiskTileCache ?
+        global::moduleEngine->module<GlobeBrowsingModule>()->diskTileCache() :
+        nullptr;
+    auto job = std::make_unique<TileLoadJob>(
+        *_rawTileDataReader,
+        tileIndex,
+        diskTileCache,
+        _datasetHash
+    );
+    if (_concurrentJobManager.enqueueLowPriorityJob(std::move(job), key)) {
+        _enqueuedTileRequests.insert(key);
+        return true;
     }
+    return false;
+}
+
+void AsyncTileDataProvider::updatePriorities(
+                                   const std::function<float(const TileIndex&)>& priority)
+{
+    ZoneScoped;
+
+    std::unordered_map<TileIndex::TileHashKey, float> priorities;
+    if (priority) {
+        priorities.reserve(_enqueuedTileRequests.size());
+        for (const TileIndex::TileHashKey key : _enqueuedTileRequests) {
+            priorities[key] = priority(TileIndex(key));
+        }
+    }
+    _concurrentJobManager.setPriorities(std::move(priorities));
+}
+
+void AsyncTileDataProvider::clearTiles() {
+    popFinishedRawTiles();
 }
 
 std::optional<RawTile> AsyncTileDataProvider::popFinishedRawTile() {
@@ -94,6 +170,27 @@ std::optional<RawTile> AsyncTileDataProvider::popFinishedRawTile() {
     }
 }
 
+std::vector<RawTile> AsyncTileDataProvider::popFinishedRawTiles() {
+    ZoneScoped;
+
+    std::vector<std::shared_ptr<Job<RawTile>>> jobs =
+        _concurrentJobManager.popFinishedJobs();
+
+    std::vector<RawTile> tiles;
+    tiles.reserve(jobs.size());
+    for (const std::shared_ptr<Job<RawTile>>& job : jobs) {
+        // Now the tile load job loses the ownership of the data pointer
+        RawTile product = job->product();
+        // No longer enqueued. Remove from set of enqueued tiles
+        _enqueuedTileRequests.erase(product.tileIndex.hashKey());
+        if (product.error != RawTile::ReadError::None) {
+            continue;
+        }
+        tiles.push_back(std::move(product));
+    }
+    return tiles;
+}
+
 bool AsyncTileDataProvider::satisfiesEnqueueCriteria(const TileIndex& tileIndex) {
     ZoneScoped;
 
@@ -29,9 +29,11 @@
 #include <modules/globebrowsing/src/rawtiledatareader.h>
 #include <modules/globebrowsing/src/tileindex.h>
 #include <ghoul/misc/boolean.h>
+#include <functional>
 #include <map>
 #include <optional>
 #include <set>
+#include <vector>
 
 namespace openspace::globebrowsing {
 
@@ -56,11 +58,32 @@ public:
      */
     bool enqueueTileIO(const TileIndex& tileIndex);
 
+    /**
+     * Creates a job which asynchronously loads a raw tile that is expected to be needed
+     * soon. The job is enqueued with the lowest priority and is ignored if the queue is
+     * already full. Unlike #enqueueTileIO, an already enqueued job for the same tile is
+     * not bumped.
+     */
+    bool prefetchTileIO(const TileIndex& tileIndex);
+
+    /**
+     * Updates the priorities of all tiles that are waiting to be loaded. Tiles with a
+     * higher priority are loaded first. If \p priority is empty, the most recently
+     * requested tiles are loaded first instead.
+     */
+    void updatePriorities(const std::function<float(const TileIndex&)>& priority);
+
     /**
      * Get one finished job.
      */
     std::optional<RawTile> popFinishedRawTile();
 
+    /**
+     * Get all jobs that have been finished so far. Tiles that could not be read are
+     * discarded.
+     */
+    std::vector<RawTile> popFinishedRawTiles();
+
     void update();
     void reset();
     void prepareToBeDeleted();
@@ -103,6 +126,11 @@ private:
     /// The reader used for asynchronous reading
     std::unique_ptr<RawTileDataReader> _rawTileDataReader;
 
+    /// Whether the tiles of this provider should be stored in the disk tile cache
+    bool _useDiskTileCache = false;
+    /// Identifies the dataset in the disk tile cache
+    uint64_t _datasetHash = 0;
+
     PrioritizingConcurrentJobManager<RawTile, TileIndex::TileHashKey>
         _concurrentJobManager;
 
@@ -26,6 +26,7 @@
 #define __OPENSPACE_MODULE_GLOBEBROWSING__BASICTYPES___H__
 
 #include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
 #include <array>
 #include <memory>
 #include <optional>
@@ -139,6 +140,9 @@ public:
     ghoul::opengl::Texture* texture = nullptr;
     std::optional<TileMetaData> metaData = std::nullopt;
     Status status = Status::Unavailable;
+    /// The resident bindless handle of the `texture`, or 0 if the texture has to be bound
+    /// to a texture unit instead
+    GLuint64 bindlessHandle = 0;
 };
 
 
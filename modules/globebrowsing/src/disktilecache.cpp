@@ -0,0 +1,417 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/disktilecache.h>
+
+#include <modules/globebrowsing/src/rawtile.h>
+#include <modules/globebrowsing/src/tiletextureinitdata.h>
+#include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning (push)
+// CPL throws warning about missing DLL interface
+#pragma warning (disable : 4251)
+#endif // _MSC_VER
+
+#include <cpl_conv.h>
+
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif // _MSC_VER
+
+namespace {
+    constexpr std::string_view _loggerCat = "DiskTileCache";
+    constexpr int8_t CurrentCacheVersion = 1;
+
+    constexpr std::string_view TileExtension = ".tile";
+    constexpr std::string_view TemporaryExtension = ".tmp";
+
+    // If the writer thread falls behind by more than this many tiles, new tiles are not
+    // cached to prevent the pending requests from using an unbounded amount of memory
+    constexpr size_t MaxPendingRequests = 512;
+
+    // The zlib compression level used for the tiles. The compression happens on the
+    // background thread, so we can afford a better compression than the fastest one
+    constexpr int CompressionLevel = 6;
+
+    template <typename T>
+    void writeValue(std::ofstream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void readValue(std::ifstream& stream, T& value) {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+} // namespace
+
+namespace openspace::globebrowsing::cache {
+
+DiskTileCache::DiskTileCache(std::filesystem::path location, uint64_t maximumSize)
+    : _location(std::move(location))
+    , _maximumSize(maximumSize)
+{
+    _writerThread = std::thread([this]() { processRequests(); });
+}
+
+DiskTileCache::~DiskTileCache() {
+    {
+        const std::lock_guard lock(_requestMutex);
+        _shouldStop = true;
+    }
+    _requestCondition.notify_one();
+    if (_writerThread.joinable()) {
+        _writerThread.join();
+    }
+}
+
+std::filesystem::path DiskTileCache::tilePath(const DiskTileKey& key) const {
+    return _location / std::format("{:016x}", key.datasetHash) /
+        std::to_string(key.tileIndex.level) /
+        std::format("{}_{}{}", key.tileIndex.x, key.tileIndex.y, TileExtension);
+}
+
+std::optional<RawTile> DiskTileCache::get(const DiskTileKey& key,
+                                          const TileTextureInitData& initData)
+{
+    ZoneScoped;
+
+    std::filesystem::path path = tilePath(key);
+    {
+        // Checking the index first means that we don't have to touch the disk at all
+        // for tiles that are not cached
+        const std::lock_guard lock(_entryMutex);
+        if (!_isIndexed) {
+            return std::nullopt;
+        }
+        const auto it = _entryMap.find(path.string());
+        if (it == _entryMap.end()) {
+            return std::nullopt;
+        }
+        _entries.splice(_entries.begin(), _entries, it->second);
+    }
+
+    std::ifstream file = std::ifstream(path, std::ifstream::binary);
+    if (!file.good()) {
+        return std::nullopt;
+    }
+
+    int8_t version = 0;
+    readValue(file, version);
+    if (version != CurrentCacheVersion) {
+        return std::nullopt;
+    }
+
+    uint64_t nBytes = 0;
+    readValue(file, nBytes);
+    if (nBytes != initData.totalNumBytes) {
+        return std::nullopt;
+    }
+
+    RawTile tile;
+    readValue(file, tile.tileMetaData.maxValues);
+    readValue(file, tile.tileMetaData.minValues);
+    readValue(file, tile.tileMetaData.hasMissingData);
+    readValue(file, tile.tileMetaData.nValues);
+
+    uint8_t isCompressed = 0;
+    readValue(file, isCompressed);
+    uint64_t nStoredBytes = 0;
+    readValue(file, nStoredBytes);
+
+    tile.imageData = std::unique_ptr<std::byte[]>(new std::byte[nBytes]);
+    if (isCompressed) {
+        std::vector<std::byte> compressed = std::vector<std::byte>(nStoredBytes);
+        file.read(reinterpret_cast<char*>(compressed.data()), nStoredBytes);
+        if (!file.good()) {
+            return std::nullopt;
+        }
+
+        size_t nInflatedBytes = 0;
+        void* res = CPLZLibInflate(
+            compressed.data(),
+            compressed.size(),
+            tile.imageData.get(),
+            nBytes,
+            &nInflatedBytes
+        );
+        if (!res || nInflatedBytes != nBytes) {
+            return std::nullopt;
+        }
+    }
+    else {
+        if (nStoredBytes != nBytes) {
+            return std::nullopt;
+        }
+        file.read(reinterpret_cast<char*>(tile.imageData.get()), nBytes);
+        if (!file.good()) {
+            return std::nullopt;
+        }
+    }
+
+    tile.textureInitData = initData;
+    tile.tileIndex = key.tileIndex;
+    tile.error = RawTile::ReadError::None;
+
+    // Update the modification time of the file so that the usage order is preserved
+    // when the index is rebuilt on the next startup
+    {
+        const std::lock_guard lock(_requestMutex);
+        if (_requests.size() < MaxPendingRequests) {
+            WriteRequest request;
+            request.path = std::move(path);
+            _requests.push_back(std::move(request));
+        }
+    }
+    _requestCondition.notify_one();
+
+    return tile;
+}
+
+void DiskTileCache::put(const DiskTileKey& key, const RawTile& tile) {
+    ZoneScoped;
+
+    ghoul_assert(tile.textureInitData.has_value(), "Tile must have texture init data");
+
+    if (!tile.imageData) {
+        return;
+    }
+
+    WriteRequest request;
+    request.path = tilePath(key);
+    request.nBytes = tile.textureInitData->totalNumBytes;
+    request.tileMetaData = tile.tileMetaData;
+
+    {
+        const std::lock_guard lock(_requestMutex);
+        if (_requests.size() >= MaxPendingRequests) {
+            return;
+        }
+
+        request.imageData = std::unique_ptr<std::byte[]>(new std::byte[request.nBytes]);
+        std::memcpy(request.imageData.get(), tile.imageData.get(), request.nBytes);
+        _requests.push_back(std::move(request));
+    }
+    _requestCondition.notify_one();
+}
+
+void DiskTileCache::setMaximumSize(uint64_t maximumSize) {
+    const std::lock_guard lock(_entryMutex);
+    _maximumSize = maximumSize;
+    evict();
+}
+
+void DiskTileCache::processRequests() {
+    buildIndex();
+
+    while (true) {
+        WriteRequest request;
+        {
+            std::unique_lock lock(_requestMutex);
+            _requestCondition.wait(
+                lock,
+                [this]() { return _shouldStop || !_requests.empty(); }
+            );
+
+            // The pending tiles are written before stopping so that they are not lost
+            if (_requests.empty()) {
+                return;
+            }
+            request = std::move(_requests.front());
+            _requests.pop_front();
+        }
+
+        write(request);
+    }
+}
+
+void DiskTileCache::buildIndex() {
+    ZoneScoped;
+
+    struct File {
+        std::filesystem::path path;
+        uint64_t size;
+        std::filesystem::file_time_type lastWrite;
+    };
+    std::vector<File> files;
+
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (fs::is_directory(_location, ec)) {
+        try {
+            const fs::recursive_directory_iterator it = fs::recursive_directory_iterator(
+                _location
+            );
+            for (const fs::directory_entry& e : it) {
+                if (!e.is_regular_file(ec)) {
+                    continue;
+                }
+
+                const fs::path& p = e.path();
+                if (p.extension() == TemporaryExtension) {
+                    // Left over from a write that was interrupted
+                    fs::remove(p, ec);
+                }
+                else if (p.extension() == TileExtension) {
+                    files.push_back({ p, e.file_size(ec), e.last_write_time(ec) });
+                }
+            }
+        }
+        catch (const fs::filesystem_error& e) {
+            LWARNING(std::format(
+                "Error reading the tile cache in '{}': {}", _location, e.what()
+            ));
+        }
+    }
+
+    std::sort(
+        files.begin(),
+        files.end(),
+        [](const File& lhs, const File& rhs) { return lhs.lastWrite > rhs.lastWrite; }
+    );
+
+    const std::lock_guard lock(_entryMutex);
+    for (File& f : files) {
+        _totalSize += f.size;
+        _entries.push_back({ .path = std::move(f.path), .size = f.size });
+        _entryMap[_entries.back().path.string()] = std::prev(_entries.end());
+    }
+    _isIndexed = true;
+    LINFO(std::format(
+        "Found {} cached tiles using {} MB in '{}'",
+        _entries.size(), _totalSize / (1024 * 1024), _location
+    ));
+    evict();
+}
+
+void DiskTileCache::write(const WriteRequest& request) {
+    ZoneScoped;
+
+    std::error_code ec;
+    if (!request.imageData) {
+        std::filesystem::last_write_time(
+            request.path,
+            std::filesystem::file_time_type::clock::now(),
+            ec
+        );
+        return;
+    }
+
+    // If the compressed data would be larger than the uncompressed data, we store the
+    // uncompressed data instead
+    std::vector<std::byte> compressed = std::vector<std::byte>(request.nBytes);
+    size_t nCompressedBytes = 0;
+    const bool isCompressed = CPLZLibDeflate(
+        request.imageData.get(),
+        request.nBytes,
+        CompressionLevel,
+        compressed.data(),
+        compressed.size(),
+        &nCompressedBytes
+    ) != nullptr;
+
+    std::filesystem::create_directories(request.path.parent_path(), ec);
+    if (ec) {
+        LWARNING(std::format(
+            "Failed to create cache folder '{}': {}",
+            request.path.parent_path(), ec.message()
+        ));
+        return;
+    }
+
+    // We write to a temporary file first so that a tile load job never sees a partially
+    // written file
+    std::filesystem::path tmp = request.path;
+    tmp += TemporaryExtension;
+    uint64_t size = 0;
+    {
+        std::ofstream file = std::ofstream(tmp, std::ofstream::binary);
+        writeValue(file, CurrentCacheVersion);
+        writeValue(file, static_cast<uint64_t>(request.nBytes));
+        writeValue(file, request.tileMetaData.maxValues);
+        writeValue(file, request.tileMetaData.minValues);
+        writeValue(file, request.tileMetaData.hasMissingData);
+        writeValue(file, request.tileMetaData.nValues);
+        writeValue(file, static_cast<uint8_t>(isCompressed ? 1 : 0));
+        if (isCompressed) {
+            writeValue(file, static_cast<uint64_t>(nCompressedBytes));
+            file.write(
+                reinterpret_cast<const char*>(compressed.data()),
+                nCompressedBytes
+            );
+        }
+        else {
+            writeValue(file, static_cast<uint64_t>(request.nBytes));
+            file.write(
+                reinterpret_cast<const char*>(request.imageData.get()),
+                request.nBytes
+            );
+        }
+
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+        size = static_cast<uint64_t>(file.tellp());
+    }
+
+    std::filesystem::rename(tmp, request.path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+
+    const std::lock_guard lock(_entryMutex);
+    const std::string key = request.path.string();
+    const auto it = _entryMap.find(key);
+    if (it != _entryMap.end()) {
+        _totalSize -= it->second->size;
+        _entries.erase(it->second);
+    }
+    _entries.push_front({ .path = request.path, .size = size });
+    _entryMap[key] = _entries.begin();
+    _totalSize += size;
+    evict();
+}
+
+void DiskTileCache::evict() {
+    // This function has to be called with the _entryMutex locked
+    while (_totalSize > _maximumSize && !_entries.empty()) {
+        const Entry& entry = _entries.back();
+        std::error_code ec;
+        std::filesystem::remove(entry.path, ec);
+        _totalSize -= entry.size;
+        _entryMap.erase(entry.path.string());
+        _entries.pop_back();
+    }
+}
+
+} // namespace openspace::globebrowsing::cache
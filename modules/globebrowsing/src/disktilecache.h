@@ -0,0 +1,137 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___DISK_TILE_CACHE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___DISK_TILE_CACHE___H__
+
+#include <modules/globebrowsing/src/basictypes.h>
+#include <modules/globebrowsing/src/tileindex.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace openspace::globebrowsing {
+    struct RawTile;
+    class TileTextureInitData;
+} // namespace openspace::globebrowsing
+
+namespace openspace::globebrowsing::cache {
+
+/**
+ * Identifies a tile that is stored on disk. Contrary to the `ProviderTileKey`, whose
+ * provider identifier is only valid for a single run, the dataset is identified by a hash
+ * of the dataset source and the texture format so that the key stays the same between
+ * runs.
+ */
+struct DiskTileKey {
+    TileIndex tileIndex;
+    uint64_t datasetHash;
+};
+
+/**
+ * A persistent cache of decoded tiles that sits below the `AsyncTileDataProvider` and
+ * stores the tiles compressed on disk. Reading from the cache is thread-safe and is done
+ * by the tile loading threads, whereas the compression and writing of new tiles is done
+ * on a separate background thread. When the total size of the cached files exceeds the
+ * maximum size, the least recently used tiles are removed.
+ */
+class DiskTileCache {
+public:
+    /**
+     * \param location The root folder in which all cached tiles are stored
+     * \param maximumSize The maximum number of bytes that the cached tiles can use
+     */
+    DiskTileCache(std::filesystem::path location, uint64_t maximumSize);
+    ~DiskTileCache();
+
+    /**
+     * Reads the tile for the provided \p key from disk if it exists in the cache.
+     *
+     * \param key The key of the tile that should be loaded
+     * \param initData The texture format of the tile that should be loaded. A cached tile
+     *        with a different size is treated as a cache miss
+     * \return The loaded tile or `std::nullopt` if the tile is not in the cache
+     */
+    std::optional<RawTile> get(const DiskTileKey& key,
+        const TileTextureInitData& initData);
+
+    /**
+     * Enqueues the provided \p tile to be written to disk by the background thread. The
+     * image data is copied, so \p tile can be used freely after this call returns.
+     */
+    void put(const DiskTileKey& key, const RawTile& tile);
+
+    void setMaximumSize(uint64_t maximumSize);
+
+private:
+    struct Entry {
+        std::filesystem::path path;
+        uint64_t size = 0;
+    };
+
+    struct WriteRequest {
+        std::filesystem::path path;
+        /// If this is empty, the request only updates the modification time of the file
+        std::unique_ptr<std::byte[]> imageData;
+        size_t nBytes = 0;
+        TileMetaData tileMetaData;
+    };
+
+    std::filesystem::path tilePath(const DiskTileKey& key) const;
+
+    /// Loop of the background thread that indexes the cache and writes new tiles
+    void processRequests();
+    void buildIndex();
+    void write(const WriteRequest& request);
+    void evict();
+
+    const std::filesystem::path _location;
+
+    /// The cached files ordered from most recently to least recently used
+    std::list<Entry> _entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> _entryMap;
+    uint64_t _totalSize = 0;
+    uint64_t _maximumSize;
+    bool _isIndexed = false;
+    std::mutex _entryMutex;
+
+    std::deque<WriteRequest> _requests;
+    bool _shouldStop = false;
+    std::mutex _requestMutex;
+    std::condition_variable _requestCondition;
+
+    std::thread _writerThread;
+};
+
+} // namespace openspace::globebrowsing::cache
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___DISK_TILE_CACHE___H__
@@ -117,6 +117,13 @@ GdalWrapper::GdalWrapper(size_t maximumCacheSize, size_t maximumMaximumCacheSize
     CPLSetConfigOption("GDAL_HTTP_TIMEOUT", "3"); // 3 seconds
     CPLSetConfigOption("CURLOPT_TIMEOUT", "3"); // 3 seconds
 
+    // Remote tiles are read by multiple threads at the same time. Keeping connections
+    // alive and multiplexing the requests over HTTP/2, where the server supports it,
+    // avoids a new connection and TLS handshake for every tile
+    CPLSetConfigOption("GDAL_HTTP_VERSION", "2TLS");
+    CPLSetConfigOption("GDAL_HTTP_MULTIPLEX", "YES");
+    CPLSetConfigOption("GDAL_HTTP_TCP_KEEPALIVE", "YES");
+
     setGdalProxyConfiguration();
     CPLSetErrorHandler(gdalErrorHandler);
 
@@ -39,12 +39,15 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <optional>
+#include <utility>
 
 namespace geos_nlohmann = nlohmann;
 #include <geos/geom/Geometry.h>
@@ -55,6 +58,8 @@ namespace geos_nlohmann = nlohmann;
 namespace {
     constexpr std::string_view _loggerCat = "GeoJsonComponent";
 
+    constexpr int8_t CurrentCacheVersion = 1;
+
     constexpr std::string_view KeyIdentifier = "Identifier";
     constexpr std::string_view KeyName = "Name";
     constexpr std::string_view KeyDesc = "Description";
@@ -245,6 +250,115 @@ namespace {
 
 namespace openspace::globebrowsing {
 
+namespace {
+    using FeatureGeometry = std::vector<GlobeGeometryFeature::RenderFeatureData>;
+
+    bool loadCachedGeometry(const std::filesystem::path& file, size_t nFeatures,
+                            std::vector<FeatureGeometry>& result)
+    {
+        std::ifstream fileStream(file, std::ifstream::binary);
+        if (!fileStream.good()) {
+            LERROR(std::format("Error opening file '{}' for loading cache file", file));
+            return false;
+        }
+
+        int8_t version = 0;
+        fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+        if (version != CurrentCacheVersion) {
+            LINFO("The format of the cached file has changed: deleting old cache");
+            fileStream.close();
+            if (std::filesystem::is_regular_file(file)) {
+                std::filesystem::remove(file);
+            }
+            return false;
+        }
+
+        uint64_t nCachedFeatures = 0;
+        fileStream.read(reinterpret_cast<char*>(&nCachedFeatures), sizeof(uint64_t));
+        if (nCachedFeatures != nFeatures) {
+            return false;
+        }
+
+        result.resize(nFeatures);
+        for (FeatureGeometry& geometry : result) {
+            uint64_t nRenderFeatures = 0;
+            fileStream.read(reinterpret_cast<char*>(&nRenderFeatures), sizeof(uint64_t));
+            geometry.resize(nRenderFeatures);
+
+            for (GlobeGeometryFeature::RenderFeatureData& data : geometry) {
+                int32_t type = 0;
+                fileStream.read(reinterpret_cast<char*>(&type), sizeof(int32_t));
+                data.type = static_cast<GlobeGeometryFeature::RenderType>(type);
+
+                uint8_t isExtrusion = 0;
+                fileStream.read(reinterpret_cast<char*>(&isExtrusion), sizeof(uint8_t));
+                data.isExtrusionFeature = (isExtrusion != 0);
+
+                uint64_t nVertices = 0;
+                fileStream.read(reinterpret_cast<char*>(&nVertices), sizeof(uint64_t));
+                if (!fileStream.good()) {
+                    return false;
+                }
+                data.vertices.resize(nVertices);
+                fileStream.read(
+                    reinterpret_cast<char*>(data.vertices.data()),
+                    nVertices * sizeof(GlobeGeometryFeature::Vertex)
+                );
+            }
+        }
+
+        return fileStream.good();
+    }
+
+    bool saveCachedGeometry(const std::filesystem::path& file,
+                            const std::vector<FeatureGeometry>& geometries)
+    {
+        std::ofstream fileStream = std::ofstream(file, std::ofstream::binary);
+        if (!fileStream.good()) {
+            LERROR(std::format("Error opening file '{}' for save cache file", file));
+            return false;
+        }
+        fileStream.write(
+            reinterpret_cast<const char*>(&CurrentCacheVersion),
+            sizeof(int8_t)
+        );
+
+        const uint64_t nFeatures = geometries.size();
+        fileStream.write(reinterpret_cast<const char*>(&nFeatures), sizeof(uint64_t));
+
+        for (const FeatureGeometry& geometry : geometries) {
+            const uint64_t nRenderFeatures = geometry.size();
+            fileStream.write(
+                reinterpret_cast<const char*>(&nRenderFeatures),
+                sizeof(uint64_t)
+            );
+
+            for (const GlobeGeometryFeature::RenderFeatureData& data : geometry) {
+                const int32_t type = static_cast<int32_t>(data.type);
+                fileStream.write(reinterpret_cast<const char*>(&type), sizeof(int32_t));
+
+                const uint8_t isExtrusion = data.isExtrusionFeature ? 1 : 0;
+                fileStream.write(
+                    reinterpret_cast<const char*>(&isExtrusion),
+                    sizeof(uint8_t)
+                );
+
+                const uint64_t nVertices = data.vertices.size();
+                fileStream.write(
+                    reinterpret_cast<const char*>(&nVertices),
+                    sizeof(uint64_t)
+                );
+                fileStream.write(
+                    reinterpret_cast<const char*>(data.vertices.data()),
+                    nVertices * sizeof(GlobeGeometryFeature::Vertex)
+                );
+            }
+        }
+
+        return fileStream.good();
+    }
+} // namespace
+
 documentation::Documentation GeoJsonComponent::Documentation() {
     return codegen::doc<Parameters>("globebrowsing_geojsoncomponent");
 }
@@ -484,6 +598,12 @@ void GeoJsonComponent::initializeGL() {
 }
 
 void GeoJsonComponent::deinitializeGL() {
+    // Wait for a potentially running geometry job, its result is no longer needed
+    if (_geometryJob.valid()) {
+        _geometryJob.wait();
+    }
+    _geometryJob = {};
+
     for (GlobeGeometryFeature& g : _geometryFeatures) {
         g.deinitializeGL();
     }
@@ -566,7 +686,33 @@ void GeoJsonComponent::update() {
         return;
     }
 
-    const glm::vec3 offsets = glm::vec3(_latLongOffset.value(), _heightOffset);
+    if (_dataIsDirty || _heightOffsetIsDirty) {
+        const glm::vec3 offsets = glm::vec3(_latLongOffset.value(), _heightOffset);
+        for (GlobeGeometryFeature& g : _geometryFeatures) {
+            g.setOffsets(offsets);
+        }
+    }
+
+    // Swap in the geometry once the worker thread has finished creating it. The old
+    // vertex buffers are used for rendering until then
+    using namespace std::chrono_literals;
+    if (_geometryJob.valid() && _geometryJob.wait_for(0s) == std::future_status::ready) {
+        std::vector<std::vector<GlobeGeometryFeature::RenderFeatureData>> geometries =
+            _geometryJob.get();
+
+        // The features might have been reloaded while the job was running
+        if (geometries.size() == _geometryFeatures.size()) {
+            for (size_t i = 0; i < _geometryFeatures.size(); i++) {
+                _geometryFeatures[i].setGeometry(std::move(geometries[i]));
+            }
+        }
+    }
+
+    // Changes that happen while a job is running are picked up by the next job
+    if (_dataIsDirty && !_geometryJob.valid()) {
+        startGeometryJob();
+        _dataIsDirty = false;
+    }
 
     for (size_t i = 0; i < _geometryFeatures.size(); i++) {
         if (!_features[i]->enabled) {
@@ -574,19 +720,72 @@ void GeoJsonComponent::update() {
         }
         GlobeGeometryFeature& g = _geometryFeatures[i];
 
-        if (_dataIsDirty || _heightOffsetIsDirty) {
-            g.setOffsets(offsets);
-        }
-
         if (_textureIsDirty) {
             g.updateTexture();
         }
 
-        g.update(_dataIsDirty, _preventUpdatesFromHeightMap);
+        g.update(_preventUpdatesFromHeightMap);
     }
 
     _textureIsDirty = false;
-    _dataIsDirty = false;
+}
+
+void GeoJsonComponent::startGeometryJob() {
+    ZoneScoped;
+
+    // The inputs are copied here as the features may change on the main thread while
+    // the geometry is created
+    std::vector<GlobeGeometryFeature::GeometryInput> inputs;
+    inputs.reserve(_geometryFeatures.size());
+    for (const GlobeGeometryFeature& g : _geometryFeatures) {
+        inputs.push_back(g.geometryInput());
+    }
+
+    // The cache has to be invalidated whenever any of the settings that affect the
+    // tessellation, or the file itself, change
+    const glm::dvec3 radii = _globeNode.ellipsoid().radii();
+    std::string settings = std::format(
+        "{}|{}|{}|{}|{}", _ignoreHeightsFromFile, radii.x, radii.y, radii.z,
+        std::filesystem::last_write_time(_geoJsonFile.value()).time_since_epoch().count()
+    );
+    for (const GlobeGeometryFeature::GeometryInput& input : inputs) {
+        settings += std::format(
+            "|{}|{}|{}|{}|{}|{}", static_cast<int>(input.type), input.offsets.x,
+            input.offsets.y, input.offsets.z, input.tessellate, input.tessellationStepSize
+        );
+    }
+    std::filesystem::path cachedFile = FileSys.cacheManager()->cachedFilename(
+        _geoJsonFile.value(),
+        std::format(
+            "GeoJsonComponent|{}|{}", identifier(), std::hash<std::string>{}(settings)
+        )
+    );
+
+    _geometryJob = std::async(
+        std::launch::async,
+        [inputs = std::move(inputs), cachedFile = std::move(cachedFile),
+         &globe = std::as_const(_globeNode)]()
+        {
+            ZoneScopedN("GeoJson geometry job");
+
+            std::vector<std::vector<GlobeGeometryFeature::RenderFeatureData>> result;
+            if (std::filesystem::is_regular_file(cachedFile)) {
+                const bool hasCache =
+                    loadCachedGeometry(cachedFile, inputs.size(), result);
+                if (hasCache) {
+                    return result;
+                }
+                result.clear();
+            }
+
+            result.reserve(inputs.size());
+            for (const GlobeGeometryFeature::GeometryInput& input : inputs) {
+                result.push_back(GlobeGeometryFeature::createGeometry(input, globe));
+            }
+            saveCachedGeometry(cachedFile, result);
+            return result;
+        }
+    );
 }
 
 void GeoJsonComponent::readFile() {
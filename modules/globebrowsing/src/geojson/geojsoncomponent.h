@@ -42,6 +42,7 @@
 #include <openspace/rendering/helper.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/glm.h>
+#include <future>
 #include <optional>
 #include <vector>
 
@@ -117,7 +118,16 @@ private:
 
     void triggerDeletion() const;
 
+    /**
+     * Starts the creation of the geometry for all features on a worker thread. The
+     * result is loaded from the cache if the same file has been tessellated with the
+     * same settings before, and is otherwise written to the cache once it is computed.
+     */
+    void startGeometryJob();
+
     std::vector<GlobeGeometryFeature> _geometryFeatures;
+    std::future<std::vector<std::vector<GlobeGeometryFeature::RenderFeatureData>>>
+        _geometryJob;
 
     properties::BoolProperty _enabled;
     properties::StringProperty _geoJsonFile;
@@ -37,6 +37,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
 #include <geos/util/GEOSException.h>
@@ -54,6 +55,236 @@ namespace {
 
 namespace openspace::globebrowsing {
 
+namespace {
+    using GeometryInput = GlobeGeometryFeature::GeometryInput;
+    using GeometryType = GlobeGeometryFeature::GeometryType;
+    using RenderFeatureData = GlobeGeometryFeature::RenderFeatureData;
+    using RenderType = GlobeGeometryFeature::RenderType;
+    using Vertex = GlobeGeometryFeature::Vertex;
+
+    // Create the vertex information for any line parts of the feature. Returns the
+    // resulting vertex positions, so we can use them for extrusion
+    std::vector<std::vector<glm::vec3>> createLineGeometry(const GeometryInput& input,
+                                                           const RenderableGlobe& globe,
+                                                  std::vector<RenderFeatureData>& result)
+    {
+        std::vector<std::vector<glm::vec3>> resultPositions;
+        resultPositions.reserve(input.geoCoordinates.size());
+        for (const std::vector<Geodetic3>& coordinates : input.geoCoordinates) {
+            std::vector<Vertex> vertices;
+            std::vector<glm::vec3> positions;
+            // TODO: this is not correct anymore
+            vertices.reserve(coordinates.size() * 3);
+            // TODO: this is not correct anymore
+            positions.reserve(coordinates.size() * 3);
+
+            glm::dvec3 lastPos = glm::dvec3(0.0);
+            double lastHeightValue = 0.0;
+
+            bool isFirst = true;
+            for (const Geodetic3& geodetic : coordinates) {
+                const glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
+                    geodetic,
+                    globe,
+                    input.offsets.x,
+                    input.offsets.y
+                );
+
+                const auto addLinePos = [&vertices, &positions](const glm::vec3& pos) {
+                    vertices.push_back({ pos.x, pos.y, pos.z, 0.f, 0.f, 0.f });
+                    positions.push_back(pos);
+                };
+
+                if (isFirst) {
+                    lastPos = v;
+                    lastHeightValue = geodetic.height;
+                    isFirst = false;
+                    addLinePos(glm::vec3(v));
+                    continue;
+                }
+
+                if (input.tessellate) {
+                    // Tessellate.
+                    // But first, determine the step size for the tessellation (larger
+                    // features will not be tesselated)
+                    const float stepSize = input.tessellationStepSize;
+
+                    std::vector<geometryhelper::PosHeightPair> subdividedPositions =
+                        geometryhelper::subdivideLine(
+                            lastPos,
+                            v,
+                            lastHeightValue,
+                            geodetic.height,
+                            stepSize
+                        );
+
+                    // Don't add the first position. Has been added as last in
+                    // previous step
+                    for (size_t si = 1; si < subdividedPositions.size(); ++si) {
+                        const geometryhelper::PosHeightPair& pair =
+                            subdividedPositions[si];
+                        addLinePos(glm::vec3(pair.position));
+                    }
+                }
+                else {
+                    // Just add the line point
+                    addLinePos(glm::vec3(v));
+                }
+
+                lastPos = v;
+                lastHeightValue = geodetic.height;
+            }
+
+            vertices.shrink_to_fit();
+
+            result.push_back({
+                .type = RenderType::Lines,
+                .vertices = std::move(vertices)
+            });
+
+            positions.shrink_to_fit();
+            resultPositions.push_back(std::move(positions));
+        }
+
+        resultPositions.shrink_to_fit();
+        return resultPositions;
+    }
+
+    // Create the vertex information for any point parts of the feature. Also creates the
+    // features for extruded lines for the points
+    void createPointGeometry(const GeometryInput& input, const RenderableGlobe& globe,
+                             std::vector<RenderFeatureData>& result)
+    {
+        if (input.type != GeometryType::Point) {
+            return;
+        }
+
+        for (const std::vector<Geodetic3>& coordinates : input.geoCoordinates) {
+            std::vector<Vertex> vertices;
+            vertices.reserve(coordinates.size());
+
+            std::vector<Vertex> extrudedLineVertices;
+            extrudedLineVertices.reserve(2 * coordinates.size());
+
+            for (const Geodetic3& geodetic : coordinates) {
+                const glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
+                    geodetic,
+                    globe,
+                    input.offsets.x,
+                    input.offsets.y
+                );
+
+                const glm::vec3 vf = static_cast<glm::vec3>(v);
+                // Normal is the out direction
+                const glm::vec3 normal = glm::normalize(vf);
+
+                vertices.push_back({ vf.x, vf.y, vf.z, normal.x, normal.y, normal.z });
+
+                // Lines from center of the globe out to the point
+                extrudedLineVertices.push_back({ 0.f, 0.f, 0.f, 0.f, 0.f, 0.f });
+                extrudedLineVertices.push_back({ vf.x, vf.y, vf.z, 0.f, 0.f, 0.f });
+            }
+
+            vertices.shrink_to_fit();
+            extrudedLineVertices.shrink_to_fit();
+
+            result.push_back({
+                .type = RenderType::Points,
+                .vertices = std::move(vertices)
+            });
+
+            // Create extrusion feature
+            result.push_back({
+                .type = RenderType::Lines,
+                .isExtrusionFeature = true,
+                .vertices = std::move(extrudedLineVertices)
+            });
+        }
+    }
+
+    // Create the triangle geometry for the extruded edges of lines/polygons
+    void createExtrudedGeometry(const std::vector<std::vector<glm::vec3>>& edgeVertices,
+                                std::vector<RenderFeatureData>& result)
+    {
+        if (edgeVertices.empty()) {
+            return;
+        }
+
+        result.push_back({
+            .type = RenderType::Polygon,
+            .isExtrusionFeature = true,
+            .vertices = geometryhelper::createExtrudedGeometryVertices(edgeVertices)
+        });
+    }
+
+    // Create the triangle geometry for the polygon part of the feature (the area
+    // contained by the shape)
+    void createPolygonGeometry(const GeometryInput& input, const RenderableGlobe& globe,
+                               std::vector<RenderFeatureData>& result)
+    {
+        if (input.triangleCoordinates.empty()) {
+            return;
+        }
+
+        std::vector<Vertex> polyVertices;
+
+        // Create polygon vertices from the triangle coordinates
+        int triIndex = 0;
+        std::array<glm::vec3, 3> triPositions;
+        std::array<double, 3> triHeights;
+        for (const Geodetic3& geodetic : input.triangleCoordinates) {
+            const glm::vec3 vert = geometryhelper::computeOffsetedModelCoordinate(
+                geodetic,
+                globe,
+                input.offsets.x,
+                input.offsets.y
+            );
+            triPositions[triIndex] = vert;
+            triHeights[triIndex] = geodetic.height;
+            triIndex++;
+
+            // Once we have a triangle, start subdividing
+            if (triIndex == 3) {
+                triIndex = 0;
+
+                const glm::vec3 v0 = triPositions[0];
+                const glm::vec3 v1 = triPositions[1];
+                const glm::vec3 v2 = triPositions[2];
+
+                const double h0 = triHeights[0];
+                const double h1 = triHeights[1];
+                const double h2 = triHeights[2];
+
+                if (input.tessellate) {
+                    // First determine the step size for the tessellation (larger features
+                    // will not be tesselated)
+                    const float stepSize = input.tessellationStepSize;
+
+                    std::vector<Vertex> verts = geometryhelper::subdivideTriangle(
+                        v0, v1, v2,
+                        h0, h1, h2,
+                        stepSize,
+                        globe
+                    );
+                    polyVertices.insert(polyVertices.end(), verts.begin(), verts.end());
+                }
+                else {
+                    // Just add a triangle consisting of the three vertices
+                    const glm::vec3 n = -glm::normalize(glm::cross(v1 - v0, v2 - v0));
+                    polyVertices.push_back({ v0.x, v0.y, v0.z, n.x, n.y, n.z });
+                    polyVertices.push_back({ v1.x, v1.y, v1.z, n.x, n.y, n.z });
+                    polyVertices.push_back({ v2.x, v2.y, v2.z, n.x, n.y, n.z });
+                }
+            }
+        }
+
+        result.push_back({
+            .type = RenderType::Polygon,
+            .vertices = std::move(polyVertices)
+        });
+    }
+} // namespace
+
 void GlobeGeometryFeature::RenderFeature::initializeBuffers() {
     if (vaoId == 0) {
         glGenVertexArrays(1, &vaoId);
@@ -91,11 +322,7 @@ void GlobeGeometryFeature::initializeGL(ghoul::opengl::ProgramObject* pointsProg
 }
 
 void GlobeGeometryFeature::deinitializeGL() {
-    for (const RenderFeature& r : _renderFeatures) {
-        glDeleteVertexArrays(1, &r.vaoId);
-        glDeleteBuffers(1, &r.vboId);
-    }
-
+    deleteRenderFeatures();
     _pointTexture = nullptr;
 }
 
@@ -508,31 +735,62 @@ bool GlobeGeometryFeature::shouldUpdateDueToHeightMapChange() const {
     return false;
 }
 
-void GlobeGeometryFeature::update(bool dataIsDirty, bool preventHeightUpdates) {
+void GlobeGeometryFeature::update(bool preventHeightUpdates) {
     if (!preventHeightUpdates && shouldUpdateDueToHeightMapChange()) {
         updateHeightsFromHeightMap();
     }
-    else if (dataIsDirty) {
-        updateGeometry();
-    }
 
     if (_pointTexture) {
         _pointTexture->update();
     }
 }
 
-void GlobeGeometryFeature::updateGeometry() {
-    // Update vertex data and compute model coordinates based on globe
-    _renderFeatures.clear();
+GlobeGeometryFeature::GeometryInput GlobeGeometryFeature::geometryInput() const {
+    return {
+        .type = _type,
+        .geoCoordinates = _geoCoordinates,
+        .triangleCoordinates = _triangleCoordinates,
+        .offsets = _offsets,
+        .tessellate = _properties.tessellationEnabled(),
+        .tessellationStepSize = tessellationStepSize()
+    };
+}
+
+std::vector<GlobeGeometryFeature::RenderFeatureData>
+GlobeGeometryFeature::createGeometry(const GeometryInput& input,
+                                     const RenderableGlobe& globe)
+{
+    ZoneScoped;
 
-    if (_type == GeometryType::Point) {
-        createPointGeometry();
+    std::vector<RenderFeatureData> result;
+    if (input.type == GeometryType::Point) {
+        createPointGeometry(input, globe, result);
     }
     else {
-        const std::vector<std::vector<glm::vec3>> edgeVertices = createLineGeometry();
-        createExtrudedGeometry(edgeVertices);
-        createPolygonGeometry();
+        const std::vector<std::vector<glm::vec3>> edgeVertices =
+            createLineGeometry(input, globe, result);
+        createExtrudedGeometry(edgeVertices, result);
+        createPolygonGeometry(input, globe, result);
     }
+    return result;
+}
+
+void GlobeGeometryFeature::setGeometry(std::vector<RenderFeatureData> geometry) {
+    ZoneScoped;
+
+    std::vector<RenderFeature> features;
+    features.reserve(geometry.size());
+    for (const RenderFeatureData& data : geometry) {
+        RenderFeature feature;
+        feature.type = data.type;
+        feature.isExtrusionFeature = data.isExtrusionFeature;
+        feature.nVertices = data.vertices.size();
+        initializeRenderFeature(feature, data.vertices);
+        features.push_back(std::move(feature));
+    }
+
+    deleteRenderFeatures();
+    _renderFeatures = std::move(features);
 
     // Compute new heights - to see if height map changed
     _lastControlHeights = getCurrentReferencePointsHeights();
@@ -551,221 +809,6 @@ void GlobeGeometryFeature::updateHeightsFromHeightMap() {
     _lastHeightUpdateTime = std::chrono::system_clock::now();
 }
 
-std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
-    std::vector<std::vector<glm::vec3>> resultPositions;
-    resultPositions.reserve(_geoCoordinates.size());
-    for (const std::vector<Geodetic3>& coordinates : _geoCoordinates) {
-        std::vector<Vertex> vertices;
-        std::vector<glm::vec3> positions;
-        // TODO: this is not correct anymore
-        vertices.reserve(coordinates.size() * 3);
-        // TODO: this is not correct anymore
-        positions.reserve(coordinates.size() * 3);
-
-        glm::dvec3 lastPos = glm::dvec3(0.0);
-        double lastHeightValue = 0.0;
-
-        bool isFirst = true;
-        for (const Geodetic3& geodetic : coordinates) {
-            const glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
-                geodetic,
-                _globe,
-                _offsets.x,
-                _offsets.y
-            );
-
-            const auto addLinePos = [&vertices, &positions](const glm::vec3& pos) {
-                vertices.push_back({ pos.x, pos.y, pos.z, 0.f, 0.f, 0.f });
-                positions.push_back(pos);
-            };
-
-            if (isFirst) {
-                lastPos = v;
-                lastHeightValue = geodetic.height;
-                isFirst = false;
-                addLinePos(glm::vec3(v));
-                continue;
-            }
-
-            if (_properties.tessellationEnabled()) {
-                // Tessellate.
-                // But first, determine the step size for the tessellation (larger
-                // features will not be tesselated)
-                const float stepSize = tessellationStepSize();
-
-                std::vector<geometryhelper::PosHeightPair> subdividedPositions =
-                    geometryhelper::subdivideLine(
-                        lastPos,
-                        v,
-                        lastHeightValue,
-                        geodetic.height,
-                        stepSize
-                    );
-
-                // Don't add the first position. Has been added as last in previous step
-                for (size_t si = 1; si < subdividedPositions.size(); ++si) {
-                    const geometryhelper::PosHeightPair& pair = subdividedPositions[si];
-                    addLinePos(glm::vec3(pair.position));
-                }
-            }
-            else {
-                // Just add the line point
-                addLinePos(glm::vec3(v));
-            }
-
-            lastPos = v;
-            lastHeightValue = geodetic.height;
-        }
-
-        vertices.shrink_to_fit();
-
-        RenderFeature feature;
-        feature.nVertices = vertices.size();
-        feature.type = RenderType::Lines;
-        initializeRenderFeature(feature, vertices);
-        _renderFeatures.push_back(std::move(feature));
-
-        positions.shrink_to_fit();
-        resultPositions.push_back(std::move(positions));
-    }
-
-    resultPositions.shrink_to_fit();
-    return resultPositions;
-}
-
-void GlobeGeometryFeature::createPointGeometry() {
-    if (_type != GeometryType::Point) {
-        return;
-    }
-
-    for (const std::vector<Geodetic3>& coordinates : _geoCoordinates) {
-        std::vector<Vertex> vertices;
-        vertices.reserve(coordinates.size());
-
-        std::vector<Vertex> extrudedLineVertices;
-        extrudedLineVertices.reserve(2 * coordinates.size());
-
-        for (const Geodetic3& geodetic : coordinates) {
-            const glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
-                geodetic,
-                _globe,
-                _offsets.x,
-                _offsets.y
-            );
-
-            const glm::vec3 vf = static_cast<glm::vec3>(v);
-            // Normal is the out direction
-            const glm::vec3 normal = glm::normalize(vf);
-
-            vertices.push_back({ vf.x, vf.y, vf.z, normal.x, normal.y, normal.z });
-
-            // Lines from center of the globe out to the point
-            extrudedLineVertices.push_back({ 0.f, 0.f, 0.f, 0.f, 0.f, 0.f });
-            extrudedLineVertices.push_back({ vf.x, vf.y, vf.z, 0.f, 0.f, 0.f });
-        }
-
-        vertices.shrink_to_fit();
-        extrudedLineVertices.shrink_to_fit();
-
-        RenderFeature feature;
-        feature.nVertices = vertices.size();
-        feature.type = RenderType::Points;
-        initializeRenderFeature(feature, vertices);
-        _renderFeatures.push_back(std::move(feature));
-
-        // Create extrusion feature
-        RenderFeature extrudeFeature;
-        extrudeFeature.nVertices = extrudedLineVertices.size();
-        extrudeFeature.type = RenderType::Lines;
-        extrudeFeature.isExtrusionFeature = true;
-        initializeRenderFeature(extrudeFeature, extrudedLineVertices);
-        _renderFeatures.push_back(std::move(extrudeFeature));
-    }
-}
-
-void GlobeGeometryFeature::createExtrudedGeometry(
-                                 const std::vector<std::vector<glm::vec3>>& edgeVertices)
-{
-    if (edgeVertices.empty()) {
-        return;
-    }
-
-    const std::vector<Vertex> vertices = geometryhelper::createExtrudedGeometryVertices(
-        edgeVertices
-    );
-
-    RenderFeature feature;
-    feature.type = RenderType::Polygon;
-    feature.nVertices = vertices.size();
-    feature.isExtrusionFeature = true;
-    initializeRenderFeature(feature, vertices);
-    _renderFeatures.push_back(std::move(feature));
-}
-
-void GlobeGeometryFeature::createPolygonGeometry() {
-    if (_triangleCoordinates.empty()) {
-        return;
-    }
-
-    std::vector<Vertex> polyVertices;
-
-    // Create polygon vertices from the triangle coordinates
-    int triIndex = 0;
-    std::array<glm::vec3, 3> triPositions;
-    std::array<double, 3> triHeights;
-    for (const Geodetic3& geodetic : _triangleCoordinates) {
-        const glm::vec3 vert = geometryhelper::computeOffsetedModelCoordinate(
-            geodetic,
-            _globe,
-            _offsets.x,
-            _offsets.y
-        );
-        triPositions[triIndex] = vert;
-        triHeights[triIndex] = geodetic.height;
-        triIndex++;
-
-        // Once we have a triangle, start subdividing
-        if (triIndex == 3) {
-            triIndex = 0;
-
-            const glm::vec3 v0 = triPositions[0];
-            const glm::vec3 v1 = triPositions[1];
-            const glm::vec3 v2 = triPositions[2];
-
-            const double h0 = triHeights[0];
-            const double h1 = triHeights[1];
-            const double h2 = triHeights[2];
-
-            if (_properties.tessellationEnabled()) {
-                // First determine the step size for the tessellation (larger features
-                // will not be tesselated)
-                const float stepSize = tessellationStepSize();
-
-                std::vector<Vertex> verts = geometryhelper::subdivideTriangle(
-                    v0, v1, v2,
-                    h0, h1, h2,
-                    stepSize,
-                    _globe
-                );
-                polyVertices.insert(polyVertices.end(), verts.begin(), verts.end());
-            }
-            else {
-                // Just add a triangle consisting of the three vertices
-                const glm::vec3 n = -glm::normalize(glm::cross(v1 - v0, v2 - v0));
-                polyVertices.push_back({ v0.x, v0.y, v0.z, n.x, n.y, n.z });
-                polyVertices.push_back({ v1.x, v1.y, v1.z, n.x, n.y, n.z });
-                polyVertices.push_back({ v2.x, v2.y, v2.z, n.x, n.y, n.z });
-            }
-        }
-    }
-
-    RenderFeature triFeature;
-    triFeature.type = RenderType::Polygon;
-    triFeature.nVertices = polyVertices.size();
-    initializeRenderFeature(triFeature, polyVertices);
-    _renderFeatures.push_back(std::move(triFeature));
-}
-
 void GlobeGeometryFeature::initializeRenderFeature(RenderFeature& feature,
                                                    const std::vector<Vertex>& vertices)
 {
@@ -781,6 +824,14 @@ void GlobeGeometryFeature::initializeRenderFeature(RenderFeature& feature,
     bufferVertexData(feature, vertices);
 }
 
+void GlobeGeometryFeature::deleteRenderFeatures() {
+    for (const RenderFeature& r : _renderFeatures) {
+        glDeleteVertexArrays(1, &r.vaoId);
+        glDeleteBuffers(1, &r.vboId);
+    }
+    _renderFeatures.clear();
+}
+
 float GlobeGeometryFeature::tessellationStepSize() const {
     float distance = _properties.tessellationDistance();
     const bool shouldDivideDistance = _properties.useTessellationLevel() &&
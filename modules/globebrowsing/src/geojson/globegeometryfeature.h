@@ -107,6 +107,30 @@ public:
         std::vector<float> heights;
     };
 
+    /**
+     * The vertices of a single render feature that have been created, but that have not
+     * yet been uploaded to the GPU.
+     */
+    struct RenderFeatureData {
+        RenderType type = RenderType::Uninitialized;
+        bool isExtrusionFeature = false;
+        std::vector<Vertex> vertices;
+    };
+
+    /**
+     * A copy of all values of a feature that are needed to create its geometry, which
+     * makes it possible to create the geometry on a worker thread while the properties
+     * of the feature keep changing on the main thread.
+     */
+    struct GeometryInput {
+        GeometryType type = GeometryType::Error;
+        std::vector<std::vector<Geodetic3>> geoCoordinates;
+        std::vector<Geodetic3> triangleCoordinates;
+        glm::vec3 offsets = glm::vec3(0.f);
+        bool tessellate = false;
+        float tessellationStepSize = 0.f;
+    };
+
     /**
      * Some extra data that we need for doing the rendering.
      */
@@ -139,45 +163,45 @@ public:
 
     bool shouldUpdateDueToHeightMapChange() const;
 
-    void update(bool dataIsDirty, bool preventHeightUpdates);
-    void updateGeometry();
+    void update(bool preventHeightUpdates);
     void updateHeightsFromHeightMap();
 
-private:
-    void renderPoints(const RenderFeature& feature, const RenderData& renderData,
-        const PointRenderMode& renderMode, float sizeScale) const;
-
-    void renderLines(const RenderFeature& feature) const;
-
-    void renderPolygons(const RenderFeature& feature, bool shouldRenderTwice,
-        int renderPass) const;
-
     /**
-     * Create the vertex information for any line parts of the feature. Returns the
-     * resulting vertex positions, so we can use them for extrusion.
+     * Returns the values that are needed to create the geometry of this feature with its
+     * current settings.
      */
-    std::vector<std::vector<glm::vec3>> createLineGeometry();
+    GeometryInput geometryInput() const;
 
     /**
-     * Create the vertex information for any point parts of the feature. Also creates the
-     * features for extruded lines for the points.
+     * Creates the vertices of all render features that are described by the \p input.
+     * This function only depends on the ellipsoid of the \p globe and does not touch any
+     * OpenGL state, so it can be called from any thread.
      */
-    void createPointGeometry();
+    static std::vector<RenderFeatureData> createGeometry(const GeometryInput& input,
+        const RenderableGlobe& globe);
 
     /**
-     * Create the triangle geometry for the extruded edges of lines/polygons.
+     * Replaces the rendered geometry with the provided \p geometry, which was created by
+     * #createGeometry. The vertex buffers for the new geometry are created before the
+     * old ones are removed, so the previous geometry remains intact until the new one
+     * has been uploaded.
      */
-    void createExtrudedGeometry(const std::vector<std::vector<glm::vec3>>& edgeVertices);
+    void setGeometry(std::vector<RenderFeatureData> geometry);
 
-    /**
-     * Create the triangle geometry for the polygon part of the feature (the area
-     * contained by the shape).
-     */
-    void createPolygonGeometry();
+private:
+    void renderPoints(const RenderFeature& feature, const RenderData& renderData,
+        const PointRenderMode& renderMode, float sizeScale) const;
+
+    void renderLines(const RenderFeature& feature) const;
+
+    void renderPolygons(const RenderFeature& feature, bool shouldRenderTwice,
+        int renderPass) const;
 
     void initializeRenderFeature(RenderFeature& feature,
         const std::vector<Vertex>& vertices);
 
+    void deleteRenderFeatures();
+
     /**
      * Get the distance that shall be used for tessellation, based on the properties.
      */
@@ -82,13 +82,14 @@ std::vector<Geodetic2> geodetic2FromVertexList(const RenderableGlobe& globe,
 std::vector<float> heightMapHeightsFromGeodetic2List(const RenderableGlobe& globe,
                                                      const std::vector<Geodetic2>& list)
 {
-    std::vector<float> res;
-    res.reserve(list.size());
+    // Query all heights in one batch so that positions in the same tile share the lookup
+    // of the height data
+    std::vector<glm::dvec3> positions;
+    positions.reserve(list.size());
     for (const Geodetic2& geo : list) {
-        const float h = static_cast<float>(getHeightToReferenceSurface(geo, globe));
-        res.push_back(h);
+        positions.push_back(globe.ellipsoid().cartesianSurfacePosition(geo));
     }
-    return res;
+    return globe.getHeights(positions);
 }
 
 std::vector<rendering::helper::VertexXYZNormal>
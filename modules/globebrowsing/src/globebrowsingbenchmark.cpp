@@ -0,0 +1,328 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/globebrowsingbenchmark.h>
+
+#include <modules/globebrowsing/globebrowsingmodule.h>
+#include <modules/globebrowsing/src/renderableglobe.h>
+#include <modules/globebrowsing/src/tileioscheduler.h>
+#include <openspace/documentation/documentation.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
+#include <openspace/engine/windowdelegate.h>
+#include <openspace/json.h>
+#include <openspace/navigation/navigationhandler.h>
+#include <openspace/navigation/navigationstate.h>
+#include <openspace/navigation/pathnavigator.h>
+#include <openspace/rendering/renderengine.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace {
+    constexpr std::string_view _loggerCat = "GlobeBrowsingBenchmark";
+
+    // Returns the value at the provided percentile in [0, 100] using the nearest rank
+    // method. The \p values must be sorted
+    template <typename T>
+    T percentile(const std::vector<T>& values, double p) {
+        if (values.empty()) {
+            return T(0);
+        }
+        const double rank = std::ceil(p / 100.0 * static_cast<double>(values.size()));
+        const size_t i = static_cast<size_t>(std::max(rank, 1.0)) - 1;
+        return values[std::min(i, values.size() - 1)];
+    }
+
+    template <typename T>
+    nlohmann::json summary(std::vector<T> values) {
+        std::sort(values.begin(), values.end());
+        const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+        return {
+            { "count", values.size() },
+            { "mean", values.empty() ? 0.0 : sum / static_cast<double>(values.size()) },
+            { "min", values.empty() ? T(0) : values.front() },
+            { "max", values.empty() ? T(0) : values.back() },
+            { "p50", percentile(values, 50.0) },
+            { "p90", percentile(values, 90.0) },
+            { "p95", percentile(values, 95.0) },
+            { "p99", percentile(values, 99.0) }
+        };
+    }
+
+    uint64_t totalUploadedBytes() {
+        return openspace::global::renderEngine->uploadScheduler().totalUploadedBytes();
+    }
+
+    openspace::globebrowsing::cache::MemoryAwareTileCache::ProviderStatistics
+    cacheStatistics()
+    {
+        using namespace openspace;
+        return global::moduleEngine->module<GlobeBrowsingModule>()->tileCache()
+            ->totalStatistics();
+    }
+
+    openspace::globebrowsing::TileIOScheduler& tileIOScheduler() {
+        using namespace openspace;
+        return *global::moduleEngine->module<GlobeBrowsingModule>()->tileIOScheduler();
+    }
+
+    // Settings for a benchmark that measures the performance of the globes while the
+    // camera flies along a fixed path. The camera jumps to the first waypoint, waits
+    // there for the warm-up duration, and then flies to each of the following waypoints
+    // in order. Only the frames of the flight are part of the results. To exclude the
+    // influence of the network, the globes should only use local datasets
+    struct [[codegen::Dictionary(GlobeBrowsingBenchmark)]] Parameters {
+        // The navigation states that the camera visits in order. There have to be at
+        // least two of them
+        std::vector<ghoul::Dictionary> waypoints
+            [[codegen::reference("core_navigation_state")]];
+
+        // The number of seconds that the flight between two consecutive waypoints takes
+        std::optional<double> segmentDuration [[codegen::greater(0.0)]];
+
+        // The number of seconds that the camera stays at the first waypoint before the
+        // measurement starts, which gives the globes time to load their first tiles
+        std::optional<double> warmUp [[codegen::greaterequal(0.0)]];
+
+        // The path of the JSON file to which the results are written
+        std::string output;
+
+        // If this value is `true`, the application is shut down after the results have
+        // been written, which makes it possible to run the benchmark unattended
+        std::optional<bool> quitWhenDone;
+    };
+#include "globebrowsingbenchmark_codegen.cpp"
+} // namespace
+
+namespace openspace::globebrowsing {
+
+documentation::Documentation GlobeBrowsingBenchmark::Documentation() {
+    return codegen::doc<Parameters>("globebrowsing_benchmark");
+}
+
+void GlobeBrowsingBenchmark::start(const ghoul::Dictionary& dictionary) {
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+    if (p.waypoints.size() < 2) {
+        throw ghoul::RuntimeError("A benchmark needs at least two waypoints");
+    }
+
+    stop(false);
+
+    _waypoints = p.waypoints;
+    _segmentDuration = p.segmentDuration.value_or(10.0);
+    _warmUpDuration = p.warmUp.value_or(10.0);
+    _output = absPath(p.output);
+    _quitWhenDone = p.quitWhenDone.value_or(false);
+
+    global::navigationHandler->pathNavigator().abortPath();
+    global::navigationHandler->setNavigationStateNextFrame(
+        interaction::NavigationState(_waypoints.front())
+    );
+    _nextWaypoint = 1;
+    _state = State::WarmUp;
+    _stateStart = std::chrono::steady_clock::now();
+    LINFO(std::format(
+        "Starting benchmark with {} waypoints after a warm-up of {} seconds",
+        _waypoints.size(), _warmUpDuration
+    ));
+}
+
+void GlobeBrowsingBenchmark::stop(bool writeResults) {
+    if (_state == State::Idle) {
+        return;
+    }
+
+    if (_state == State::Running) {
+        tileIOScheduler().setLatencyRecording(false);
+        std::vector<float> latencies = tileIOScheduler().popLatencies();
+        _tileLatencies.insert(_tileLatencies.end(), latencies.begin(), latencies.end());
+
+        if (writeResults) {
+            this->writeResults();
+        }
+        global::navigationHandler->pathNavigator().abortPath();
+    }
+
+    _state = State::Idle;
+    _frames.clear();
+    _tileLatencies.clear();
+}
+
+bool GlobeBrowsingBenchmark::isRunning() const {
+    return _state != State::Idle;
+}
+
+void GlobeBrowsingBenchmark::postDraw() {
+    if (_state == State::Idle) {
+        return;
+    }
+
+    ZoneScoped;
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (_state == State::WarmUp) {
+        const std::chrono::duration<double> dt = now - _stateStart;
+        if (dt.count() < _warmUpDuration) {
+            return;
+        }
+
+        // The measurement starts with the first flight
+        _state = State::Running;
+        _stateStart = now;
+        _lastFrame = now;
+        _lastUploadedBytes = totalUploadedBytes();
+        _startStatistics = cacheStatistics();
+        tileIOScheduler().popLatencies();
+        tileIOScheduler().setLatencyRecording(true);
+        startNextSegment();
+        return;
+    }
+
+    Frame frame;
+    frame.frameTime = std::chrono::duration<float, std::milli>(now - _lastFrame).count();
+    _lastFrame = now;
+
+    const uint64_t uploadedBytes = totalUploadedBytes();
+    frame.nUploadedBytes = uploadedBytes - _lastUploadedBytes;
+    _lastUploadedBytes = uploadedBytes;
+
+    const Scene* scene = global::renderEngine->scene();
+    for (const SceneGraphNode* node : scene->allSceneGraphNodes()) {
+        const RenderableGlobe* globe = dynamic_cast<const RenderableGlobe*>(
+            node->renderable()
+        );
+        if (globe) {
+            frame.nChunks += globe->nRenderedChunks();
+        }
+    }
+    _frames.push_back(frame);
+
+    std::vector<float> latencies = tileIOScheduler().popLatencies();
+    _tileLatencies.insert(_tileLatencies.end(), latencies.begin(), latencies.end());
+
+    if (!global::navigationHandler->pathNavigator().isPlayingPath()) {
+        if (_nextWaypoint < _waypoints.size()) {
+            startNextSegment();
+        }
+        else {
+            LINFO(std::format("Benchmark finished after {} frames", _frames.size()));
+            stop(true);
+            if (_quitWhenDone) {
+                global::windowDelegate->terminate();
+            }
+        }
+    }
+}
+
+void GlobeBrowsingBenchmark::startNextSegment() {
+    ghoul::Dictionary instruction;
+    instruction.setValue("TargetType", std::string("NavigationState"));
+    instruction.setValue("NavigationState", _waypoints[_nextWaypoint]);
+    instruction.setValue("Duration", _segmentDuration);
+    _nextWaypoint++;
+
+    interaction::PathNavigator& navigator = global::navigationHandler->pathNavigator();
+    navigator.createPath(instruction);
+    if (navigator.hasCurrentPath()) {
+        navigator.startPath();
+    }
+}
+
+void GlobeBrowsingBenchmark::writeResults() const {
+    ZoneScoped;
+
+    std::vector<float> frameTimes;
+    std::vector<uint64_t> uploadedBytes;
+    std::vector<int> chunks;
+    frameTimes.reserve(_frames.size());
+    uploadedBytes.reserve(_frames.size());
+    chunks.reserve(_frames.size());
+    for (const Frame& frame : _frames) {
+        frameTimes.push_back(frame.frameTime);
+        uploadedBytes.push_back(frame.nUploadedBytes);
+        chunks.push_back(frame.nChunks);
+    }
+
+    std::vector<float> latencies = _tileLatencies;
+    for (float& latency : latencies) {
+        // Milliseconds are easier to read next to the frame times
+        latency *= 1000.f;
+    }
+
+    const cache::MemoryAwareTileCache::ProviderStatistics statistics = cacheStatistics();
+    const uint64_t nHits = statistics.nHits - _startStatistics.nHits;
+    const uint64_t nMisses = statistics.nMisses - _startStatistics.nMisses;
+    const uint64_t nRequests = nHits + nMisses;
+
+    nlohmann::json result = {
+        { "duration", std::chrono::duration<double>(_lastFrame - _stateStart).count() },
+        { "frames", _frames.size() },
+        { "frameTime", summary(frameTimes) },
+        { "tileLoadLatency", summary(latencies) },
+        {
+            "tileCache",
+            {
+                { "hits", nHits },
+                { "misses", nMisses },
+                {
+                    "hitRate",
+                    nRequests > 0 ?
+                        static_cast<double>(nHits) / static_cast<double>(nRequests) :
+                        0.0
+                },
+                { "evictions", statistics.nEvictions - _startStatistics.nEvictions }
+            }
+        },
+        { "uploadedBytesPerFrame", summary(uploadedBytes) },
+        { "chunks", summary(chunks) },
+        {
+            "perFrame",
+            {
+                { "frameTime", frameTimes },
+                { "uploadedBytes", uploadedBytes },
+                { "chunks", chunks }
+            }
+        }
+    };
+
+    std::filesystem::create_directories(_output.parent_path());
+    std::ofstream file = std::ofstream(_output);
+    if (!file.good()) {
+        LERROR(std::format("Could not write benchmark results to '{}'", _output));
+        return;
+    }
+    file << result.dump(2);
+    LINFO(std::format("Benchmark results written to '{}'", _output));
+}
+
+} // namespace openspace::globebrowsing
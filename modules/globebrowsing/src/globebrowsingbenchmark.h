@@ -0,0 +1,107 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___GLOBEBROWSING_BENCHMARK___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___GLOBEBROWSING_BENCHMARK___H__
+
+#include <modules/globebrowsing/src/memoryawaretilecache.h>
+#include <ghoul/misc/dictionary.h>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+namespace openspace::documentation { struct Documentation; }
+
+namespace openspace::globebrowsing {
+
+/**
+ * Measures the performance of the globes while the camera flies along a fixed list of
+ * waypoints with the PathNavigator, to make it possible to compare the performance of
+ * different versions in a repeatable way. The camera first jumps to the first waypoint
+ * and waits there for a warm-up period before the measurement starts. Then, the frame
+ * times, the latencies of the tile loading, the tile cache hit rate, the number of bytes
+ * uploaded to the GPU, and the number of rendered chunks are recorded for every frame
+ * until the last waypoint is reached. The results are written to a JSON file.
+ */
+class GlobeBrowsingBenchmark {
+public:
+    /**
+     * Starts a new benchmark with the settings in the \p dictionary, which has to be
+     * valid with respect to the #Documentation. A benchmark that is already running is
+     * stopped without writing its results.
+     */
+    void start(const ghoul::Dictionary& dictionary);
+
+    /**
+     * Stops the current benchmark. If \p writeResults is `true`, the results of the
+     * frames that have been recorded so far are written to the output file.
+     */
+    void stop(bool writeResults);
+
+    bool isRunning() const;
+
+    /**
+     * Advances the benchmark and records the statistics of the frame. This function has
+     * to be called exactly once at the end of every frame.
+     */
+    void postDraw();
+
+    static documentation::Documentation Documentation();
+
+private:
+    enum class State {
+        Idle,
+        WarmUp,
+        Running
+    };
+
+    struct Frame {
+        float frameTime = 0.f;
+        uint64_t nUploadedBytes = 0;
+        int nChunks = 0;
+    };
+
+    void startNextSegment();
+    void writeResults() const;
+
+    State _state = State::Idle;
+
+    std::vector<ghoul::Dictionary> _waypoints;
+    size_t _nextWaypoint = 0;
+    double _segmentDuration = 0.0;
+    double _warmUpDuration = 0.0;
+    std::filesystem::path _output;
+    bool _quitWhenDone = false;
+
+    std::chrono::steady_clock::time_point _stateStart;
+    std::chrono::steady_clock::time_point _lastFrame;
+    std::vector<Frame> _frames;
+    std::vector<float> _tileLatencies;
+    uint64_t _lastUploadedBytes = 0;
+    cache::MemoryAwareTileCache::ProviderStatistics _startStatistics;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___GLOBEBROWSING_BENCHMARK___H__
@@ -32,6 +32,7 @@
 #include <openspace/engine/globals.h>
 #include <openspace/engine/moduleengine.h>
 #include <openspace/engine/windowdelegate.h>
+#include <openspace/rendering/renderengine.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -42,11 +43,17 @@
 #include <ghoul/misc/profiling.h>
 #include <ghoul/misc/stringhelper.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <limits>
 #include <locale>
+#include <numeric>
 #include <optional>
+#include <vector>
 
 namespace {
     constexpr std::string_view _loggerCat = "GlobeLabels";
@@ -54,6 +61,10 @@ namespace {
     constexpr double LabelFadeOutLimitAltitudeMeters = 25000.0;
     constexpr float MinOpacityValueConst = 0.009f;
 
+    // Nodes of the quadtree are split until they contain at most this many labels
+    constexpr uint32_t QuadtreeLeafSize = 32;
+    constexpr int QuadtreeMaxDepth = 12;
+
     enum LabelRenderingAlignmentType {
         Horizontally = 0,
         Circularly
@@ -150,7 +161,9 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
-    bool isLabelInFrustum(const glm::dmat4& MVMatrix, const glm::dvec3& position) {
+    bool isLabelInFrustum(const glm::dmat4& MVMatrix, const glm::dvec3& position,
+                          double radius = 1.0)
+    {
         // Frustum Planes
         const glm::dvec3 col1(MVMatrix[0][0], MVMatrix[1][0], MVMatrix[2][0]);
         const glm::dvec3 col2(MVMatrix[0][1], MVMatrix[1][1], MVMatrix[2][1]);
@@ -197,15 +210,23 @@ namespace {
         farNormal *= invMagFar;
         // farDistance *= invMagFar;
 
-        constexpr float Radius = 1.0;
-        const bool res = ((glm::dot(leftNormal, position) + leftDistance) < -Radius) ||
-            ((glm::dot(rightNormal, position) + rightDistance) < -Radius) ||
-            ((glm::dot(bottomNormal, position) + bottomDistance) < -Radius) ||
-            ((glm::dot(topNormal, position) + topDistance) < -Radius) ||
-            ((glm::dot(nearNormal, position) + nearDistance) < -Radius);
+        const bool res = ((glm::dot(leftNormal, position) + leftDistance) < -radius) ||
+            ((glm::dot(rightNormal, position) + rightDistance) < -radius) ||
+            ((glm::dot(bottomNormal, position) + bottomDistance) < -radius) ||
+            ((glm::dot(topNormal, position) + topDistance) < -radius) ||
+            ((glm::dot(nearNormal, position) + nearDistance) < -radius);
         return !res;
     }
 
+    constexpr openspace::properties::Property::PropertyInfo MaxLabelsPerRegionInfo = {
+        "MaxLabelsPerRegion",
+        "Max Labels per Region",
+        "The maximum number of labels that are drawn in each 64 by 64 pixel region of "
+        "the screen. Labels that are closer to the camera are given priority. A value of "
+        "0 means that the number of labels is not limited.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(GlobeLabelsComponent)]] Parameters {
         // The path to the labels file
         std::optional<std::filesystem::path> fileName;
@@ -252,6 +273,9 @@ namespace {
         };
         // [[codegen::verbatim(AlignmentOptionInfo.description)]]
         std::optional<Alignment> alignmentOption;
+
+        // [[codegen::verbatim(MaxLabelsPerRegionInfo.description)]]
+        std::optional<int> maxLabelsPerRegion [[codegen::greaterequal(0)]];
     };
 #include "globelabelscomponent_codegen.cpp"
 } // namespace
@@ -284,6 +308,7 @@ GlobeLabelsComponent::GlobeLabelsComponent()
         AlignmentOptionInfo,
         properties::OptionProperty::DisplayType::Dropdown
     )
+    , _maxLabelsPerRegion(MaxLabelsPerRegionInfo, 0, 0, 100)
 {
     addProperty(_enabled);
     addProperty(_color);
@@ -309,6 +334,8 @@ GlobeLabelsComponent::GlobeLabelsComponent()
     _alignmentOption.addOption(Circularly, "Circularly");
     _alignmentOption = Horizontally;
     addProperty(_alignmentOption);
+
+    addProperty(_maxLabelsPerRegion);
 }
 
 void GlobeLabelsComponent::initialize(const ghoul::Dictionary& dictionary,
@@ -326,6 +353,7 @@ void GlobeLabelsComponent::initialize(const ghoul::Dictionary& dictionary,
     if (!loadSuccess) {
         return;
     }
+    buildQuadtree();
 
     Fadeable::_opacity = p.opacity.value_or(Fadeable::_opacity);
 
@@ -352,6 +380,8 @@ void GlobeLabelsComponent::initialize(const ghoul::Dictionary& dictionary,
         _alignmentOption = codegen::map<LabelRenderingAlignmentType>(*p.alignmentOption);
     }
 
+    _maxLabelsPerRegion = p.maxLabelsPerRegion.value_or(_maxLabelsPerRegion);
+
     initializeFonts();
 }
 
@@ -493,6 +523,127 @@ bool GlobeLabelsComponent::readLabelsFile(const std::filesystem::path& file) {
     }
 }
 
+void GlobeLabelsComponent::buildQuadtree() {
+    ZoneScoped;
+
+    _quadtree.clear();
+    _quadtreeLabels.resize(_labels.labelsArray.size());
+    std::iota(_quadtreeLabels.begin(), _quadtreeLabels.end(), 0);
+    if (_quadtreeLabels.empty()) {
+        return;
+    }
+
+    // The latitude and longitude range that is covered by each node
+    struct Range {
+        glm::vec2 latitude;
+        glm::vec2 longitude;
+        int depth = 0;
+    };
+
+    // The labels files use longitudes in [0, 360], but the chunks in [-180, 180]
+    auto longitude = [this](uint32_t index) {
+        const float lon = _labels.labelsArray[index].longitude;
+        return lon > 180.f ? lon - 360.f : lon;
+    };
+
+    // The nodes are laid out in the same way as the chunks of the globe, with one root
+    // for the western and the eastern hemisphere and the children in `Quad` order, so
+    // that the chunk tree can be traversed alongside the quadtree when rendering
+    const auto eastBegin = std::partition(
+        _quadtreeLabels.begin(),
+        _quadtreeLabels.end(),
+        [&longitude](uint32_t index) { return longitude(index) < 0.f; }
+    );
+    QuadtreeNode westRoot;
+    westRoot.nLabels = static_cast<uint32_t>(eastBegin - _quadtreeLabels.begin());
+    _quadtree.push_back(westRoot);
+    QuadtreeNode eastRoot;
+    eastRoot.firstLabel = westRoot.nLabels;
+    eastRoot.nLabels = static_cast<uint32_t>(_quadtreeLabels.end() - eastBegin);
+    _quadtree.push_back(eastRoot);
+    std::vector<Range> ranges = {
+        { .latitude = glm::vec2(-90.f, 90.f), .longitude = glm::vec2(-180.f, 0.f) },
+        { .latitude = glm::vec2(-90.f, 90.f), .longitude = glm::vec2(0.f, 180.f) }
+    };
+
+    // The nodes are split in breadth-first order, with the new children being appended
+    // to the list of nodes that are still to be processed
+    for (size_t n = 0; n < _quadtree.size(); n++) {
+        const uint32_t firstLabel = _quadtree[n].firstLabel;
+        const uint32_t nLabels = _quadtree[n].nLabels;
+        if (nLabels == 0) {
+            continue;
+        }
+
+        const auto begin = _quadtreeLabels.begin() + firstLabel;
+        const auto end = begin + nLabels;
+
+        // Bounding sphere around the label positions, padded slightly to account for
+        // the float precision of the positions
+        glm::dvec3 center = glm::dvec3(0.0);
+        for (auto it = begin; it != end; it++) {
+            center += glm::dvec3(_labels.labelsArray[*it].geoPosition);
+        }
+        center /= static_cast<double>(nLabels);
+        double radius = 0.0;
+        for (auto it = begin; it != end; it++) {
+            const glm::dvec3 p = glm::dvec3(_labels.labelsArray[*it].geoPosition);
+            radius = std::max(radius, glm::length(p - center));
+        }
+        _quadtree[n].center = center;
+        _quadtree[n].radius = radius + 1.0;
+
+        const Range range = ranges[n];
+        if (nLabels <= QuadtreeLeafSize || range.depth >= QuadtreeMaxDepth) {
+            continue;
+        }
+
+        const float midLatitude = (range.latitude.x + range.latitude.y) / 2.f;
+        const float midLongitude = (range.longitude.x + range.longitude.y) / 2.f;
+        auto quadrant = [&](uint32_t index) {
+            const LabelEntry& e = _labels.labelsArray[index];
+            return (e.latitude < midLatitude ? 2 : 0) |
+                (longitude(index) >= midLongitude ? 1 : 0);
+        };
+        std::sort(
+            begin,
+            end,
+            [&quadrant](uint32_t lhs, uint32_t rhs) {
+                return quadrant(lhs) < quadrant(rhs);
+            }
+        );
+
+        _quadtree[n].firstChild = static_cast<int>(_quadtree.size());
+        auto childBegin = begin;
+        for (int q = 0; q < 4; q++) {
+            const auto childEnd = std::partition_point(
+                childBegin,
+                end,
+                [&quadrant, q](uint32_t index) { return quadrant(index) <= q; }
+            );
+
+            QuadtreeNode child;
+            child.firstLabel =
+                static_cast<uint32_t>(childBegin - _quadtreeLabels.begin());
+            child.nLabels = static_cast<uint32_t>(childEnd - childBegin);
+            _quadtree.push_back(child);
+
+            Range childRange = {
+                .latitude = (q & 2) ?
+                    glm::vec2(range.latitude.x, midLatitude) :
+                    glm::vec2(midLatitude, range.latitude.y),
+                .longitude = (q & 1) ?
+                    glm::vec2(midLongitude, range.longitude.y) :
+                    glm::vec2(range.longitude.x, midLongitude),
+                .depth = range.depth + 1
+            };
+            ranges.push_back(childRange);
+
+            childBegin = childEnd;
+        }
+    }
+}
+
 bool GlobeLabelsComponent::loadCachedFile(const std::filesystem::path& file) {
     std::ifstream fileStream(file, std::ifstream::binary);
     if (!fileStream.good()) {
@@ -626,7 +777,9 @@ void GlobeLabelsComponent::renderLabels(const RenderData& data,
     }
     glm::dvec3 orthoUp = glm::normalize(glm::cross(orthoRight, cameraViewDirectionObj));
 
-    for (const LabelEntry& lEntry : _labels.labelsArray) {
+    _densityGrid.reset(global::renderEngine->renderingResolution(), _maxLabelsPerRegion);
+
+    auto renderLabel = [&](const LabelEntry& lEntry) {
         glm::vec3 position = lEntry.geoPosition;
         const glm::dvec3 locationPositionWorld =
             glm::dvec3(_globe->modelTransform() * glm::dvec4(position, 1.0));
@@ -637,6 +790,10 @@ void GlobeLabelsComponent::renderLabels(const RenderData& data,
             ((distToCamera > (distanceCameraToLabelWorld + _distanceEPS)) &&
             isLabelInFrustum(VP, locationPositionWorld)))
         {
+            if (!_densityGrid.tryAdd(VP * glm::dvec4(locationPositionWorld, 1.0))) {
+                return;
+            }
+
             if (_alignmentOption == Circularly) {
                 const glm::dvec3 labelNormalObj = glm::dvec3(
                     invModelMatrix * glm::dvec4(data.camera.positionVec3(), 1.0)
@@ -691,6 +848,91 @@ void GlobeLabelsComponent::renderLabels(const RenderData& data,
                 labelInfo
             );
         }
+    };
+
+    if (_disableCulling || _quadtree.empty()) {
+        for (const LabelEntry& lEntry : _labels.labelsArray) {
+            renderLabel(lEntry);
+        }
+        return;
+    }
+
+    const glm::dmat4 modelTransform = _globe->modelTransform();
+    const double modelScale = std::max({
+        glm::length(glm::dvec3(modelTransform[0])),
+        glm::length(glm::dvec3(modelTransform[1])),
+        glm::length(glm::dvec3(modelTransform[2]))
+    });
+    const glm::dvec3 cameraPosition = data.camera.positionVec3();
+
+    // If the globe was rendered in this frame, the chunk that covers the same area as a
+    // node is visited alongside it. All labels in a chunk that was culled by the globe
+    // are skipped without any further tests. Below the leaves of the chunk tree the
+    // nodes are tested against the leaf that contains them
+    using globebrowsing::Chunk;
+    const std::optional<std::array<const Chunk*, 2>> chunkTree =
+        _globe->currentChunkTree();
+
+    struct Entry {
+        int node = 0;
+        const Chunk* chunk = nullptr;
+    };
+
+    // Traverse the quadtree from near to far, so that the closest labels get priority in
+    // the density limit
+    auto distanceToNode = [&](int index) {
+        const glm::dvec3 center =
+            glm::dvec3(modelTransform * glm::dvec4(_quadtree[index].center, 1.0));
+        return glm::length(center - cameraPosition);
+    };
+    std::vector<Entry> stack;
+    const int nearRoot = distanceToNode(0) < distanceToNode(1) ? 0 : 1;
+    for (int root : { 1 - nearRoot, nearRoot }) {
+        stack.push_back({ root, chunkTree ? (*chunkTree)[root] : nullptr });
+    }
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        const QuadtreeNode& node = _quadtree[entry.node];
+        stack.pop_back();
+
+        if (node.nLabels == 0 || (entry.chunk && !entry.chunk->isVisible)) {
+            continue;
+        }
+
+        const glm::dvec3 centerWorld =
+            glm::dvec3(modelTransform * glm::dvec4(node.center, 1.0));
+        const double radiusWorld = node.radius * modelScale;
+        const double closestDistance =
+            glm::length(centerWorld - cameraPosition) - radiusWorld;
+
+        // No label in this node can pass the distance test in `renderLabel` if even the
+        // closest point of the bounding sphere is too far away
+        if (closestDistance + _distanceEPS >= distToCamera ||
+            !isLabelInFrustum(VP, centerWorld, radiusWorld + 1.0))
+        {
+            continue;
+        }
+
+        if (node.firstChild != -1) {
+            std::array<std::pair<double, int>, 4> children;
+            for (int i = 0; i < 4; i++) {
+                children[i] = { distanceToNode(node.firstChild + i), i };
+            }
+            // Push the farthest child first, so that the nearest one is visited next
+            std::sort(children.begin(), children.end(), std::greater<>());
+            for (const std::pair<double, int>& child : children) {
+                const Chunk* chunk = entry.chunk;
+                if (chunk && chunk->children[0]) {
+                    chunk = chunk->children[child.second];
+                }
+                stack.push_back({ node.firstChild + child.second, chunk });
+            }
+            continue;
+        }
+
+        for (uint32_t i = 0; i < node.nLabels; i++) {
+            renderLabel(_labels.labelsArray[_quadtreeLabels[node.firstLabel + i]]);
+        }
     }
 }
 
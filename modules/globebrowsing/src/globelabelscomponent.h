@@ -35,6 +35,7 @@
 #include <openspace/properties/vector/ivec2property.h>
 #include <openspace/properties/vector/vec2property.h>
 #include <openspace/properties/vector/vec3property.h>
+#include <openspace/rendering/labeldensitygrid.h>
 #include <ghoul/font/fontrenderer.h>
 #include <ghoul/glm.h>
 
@@ -70,6 +71,9 @@ private:
     void renderLabels(const RenderData& data, const glm::dmat4& modelViewProjectionMatrix,
         float distToCamera, float fadeInVariable);
 
+    /// Builds the quadtree over the latitude and longitude of the loaded labels
+    void buildQuadtree();
+
     // Labels Structures
     struct LabelEntry {
         char feature[256];
@@ -96,9 +100,26 @@ private:
     properties::BoolProperty _disableCulling;
     properties::FloatProperty _distanceEPS;
     properties::OptionProperty _alignmentOption;
+    properties::IntProperty _maxLabelsPerRegion;
 
     Labels _labels;
 
+    struct QuadtreeNode {
+        /// Bounding sphere of the label positions in model space
+        glm::dvec3 center = glm::dvec3(0.0);
+        double radius = 0.0;
+        /// The index of the first of the four children, or -1 if this is a leaf
+        int firstChild = -1;
+        /// The range in `_quadtreeLabels` of the labels that are inside this node
+        uint32_t firstLabel = 0;
+        uint32_t nLabels = 0;
+    };
+    std::vector<QuadtreeNode> _quadtree;
+    /// Indices into the labels, ordered such that the labels of each node are adjacent
+    std::vector<uint32_t> _quadtreeLabels;
+
+    LabelDensityGrid _densityGrid;
+
     // Font
     std::shared_ptr<ghoul::fontrendering::Font> _font;
 
@@ -30,6 +30,30 @@
 #include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/texture.h>
 
+namespace {
+    bool isTileLayer(openspace::globebrowsing::layers::Layer::ID type) {
+        using namespace openspace::globebrowsing::layers;
+        switch (type) {
+            // Intentional fall through. Same for all tile layers
+            case Layer::ID::DefaultTileProvider:
+            case Layer::ID::SingleImageProvider:
+            case Layer::ID::SpoutImageProvider:
+            case Layer::ID::VideoTileProvider:
+            case Layer::ID::ImageSequenceTileProvider:
+            case Layer::ID::SizeReferenceTileProvider:
+            case Layer::ID::TemporalTileProvider:
+            case Layer::ID::TileIndexTileProvider:
+            case Layer::ID::TileProviderByDate:
+            case Layer::ID::TileProviderByIndex:
+            case Layer::ID::TileProviderByLevel:
+                return true;
+            case Layer::ID::SolidColor:
+                return false;
+        }
+        return false;
+    }
+} // namespace
+
 namespace openspace::globebrowsing {
 
 void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
@@ -37,11 +61,51 @@ void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
 {
     ZoneScoped;
 
+    setLayerValues(program, layerGroup);
+
+    const std::vector<Layer*>& activeLayers = layerGroup.activeLayers();
+    for (unsigned int i = 0; i < activeLayers.size(); i++) {
+        const Layer& al = *activeLayers[i];
+        if (!isTileLayer(al.type())) {
+            continue;
+        }
+
+        const ChunkTilePile& ctp = al.chunkTilePile(tileIndex, layerGroup.pileSize());
+        for (size_t j = 0; j < _gpuActiveLayers[i].gpuChunkTiles.size(); j++) {
+            GPULayer::GPUChunkTile& t = _gpuActiveLayers[i].gpuChunkTiles[j];
+            ghoul_assert(ctp[j].has_value(), "Wrong ChunkTiles number in pile");
+            const ChunkTile& ct = *ctp[j];
+
+            if (_useBindlessTextures && ct.tile.bindlessHandle != 0) {
+                // The program is active while the chunks are rendered
+                glUniformHandleui64ARB(t.uniformCache.texture, ct.tile.bindlessHandle);
+            }
+            else {
+                t.texUnit.activate();
+                if (ct.tile.texture) {
+                    ct.tile.texture->bind();
+                }
+                program.setUniform(t.uniformCache.texture, t.texUnit);
+            }
+
+            program.setUniform(t.uniformCache.uvOffset, ct.uvTransform.uvOffset);
+            program.setUniform(t.uniformCache.uvScale, ct.uvTransform.uvScale);
+        }
+    }
+}
+
+void GPULayerGroup::setLayerValues(ghoul::opengl::ProgramObject& program,
+                                   const LayerGroup& layerGroup)
+{
+    ZoneScoped;
+
     ghoul_assert(
         layerGroup.activeLayers().size() == _gpuActiveLayers.size(),
         "GPU and CPU active layers must have same size"
     );
 
+    _residentTextureHandles.clear();
+
     const std::vector<Layer*>& activeLayers = layerGroup.activeLayers();
     for (unsigned int i = 0; i < activeLayers.size(); i++) {
         const GPULayer& gal = _gpuActiveLayers[i];
@@ -64,42 +128,8 @@ void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
             );
         }
 
-        switch (al.type()) {
-            // Intentional fall through. Same for all tile layers
-            case layers::Layer::ID::DefaultTileProvider:
-            case layers::Layer::ID::SingleImageProvider:
-            case layers::Layer::ID::SpoutImageProvider:
-            case layers::Layer::ID::VideoTileProvider:
-            case layers::Layer::ID::ImageSequenceTileProvider:
-            case layers::Layer::ID::SizeReferenceTileProvider:
-            case layers::Layer::ID::TemporalTileProvider:
-            case layers::Layer::ID::TileIndexTileProvider:
-            case layers::Layer::ID::TileProviderByDate:
-            case layers::Layer::ID::TileProviderByIndex:
-            case layers::Layer::ID::TileProviderByLevel: {
-                const ChunkTilePile& ctp = al.chunkTilePile(
-                    tileIndex,
-                    layerGroup.pileSize()
-                );
-                for (size_t j = 0; j < _gpuActiveLayers[i].gpuChunkTiles.size(); j++) {
-                    GPULayer::GPUChunkTile& t = _gpuActiveLayers[i].gpuChunkTiles[j];
-                    ghoul_assert(ctp[j].has_value(), "Wrong ChunkTiles number in pile");
-                    const ChunkTile& ct = *ctp[j];
-
-                    t.texUnit.activate();
-                    if (ct.tile.texture) {
-                        ct.tile.texture->bind();
-                    }
-                    program.setUniform(t.uniformCache.texture, t.texUnit);
-
-                    program.setUniform(t.uniformCache.uvOffset, ct.uvTransform.uvOffset);
-                    program.setUniform(t.uniformCache.uvScale, ct.uvTransform.uvScale);
-                }
-                break;
-            }
-            case layers::Layer::ID::SolidColor:
-                program.setUniform(galuc.color, al.solidColor());
-                break;
+        if (al.type() == layers::Layer::ID::SolidColor) {
+            program.setUniform(galuc.color, al.solidColor());
         }
 
         if (gal.isHeightLayer) {
@@ -109,7 +139,57 @@ void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
     }
 }
 
-void GPULayerGroup::bind(ghoul::opengl::ProgramObject& p, const LayerGroup& layerGroup) {
+void GPULayerGroup::appendChunkTiles(const LayerGroup& layerGroup,
+                                     const TileIndex& tileIndex,
+                                     std::vector<ChunkTileData>& chunkTiles)
+{
+    ZoneScoped;
+
+    const std::vector<Layer*>& activeLayers = layerGroup.activeLayers();
+    for (const Layer* al : activeLayers) {
+        const size_t first = chunkTiles.size();
+        chunkTiles.resize(first + ChunkTilesPerLayer);
+        if (!isTileLayer(al->type())) {
+            continue;
+        }
+
+        const ChunkTilePile& ctp = al->chunkTilePile(tileIndex, layerGroup.pileSize());
+        for (int j = 0; j < layerGroup.pileSize(); j++) {
+            ghoul_assert(ctp[j].has_value(), "Wrong ChunkTiles number in pile");
+            const ChunkTile& ct = *ctp[j];
+            ChunkTileData& data = chunkTiles[first + j];
+
+            if (ct.tile.bindlessHandle != 0) {
+                data.textureHandle = ct.tile.bindlessHandle;
+            }
+            else if (ct.tile.texture) {
+                // Textures that are not owned by the tile cache, for example of single
+                // image layers, don't have a handle yet. Requesting the handle of the
+                // same texture repeatedly returns the same handle
+                auto it = _residentTextureHandles.find(ct.tile.texture);
+                if (it == _residentTextureHandles.end()) {
+                    const GLuint64 handle = glGetTextureHandleARB(
+                        static_cast<GLuint>(*ct.tile.texture)
+                    );
+                    if (glIsTextureHandleResidentARB(handle) == GL_FALSE) {
+                        glMakeTextureHandleResidentARB(handle);
+                    }
+                    it = _residentTextureHandles.emplace(ct.tile.texture, handle).first;
+                }
+                data.textureHandle = it->second;
+            }
+
+            data.uvOffset = ct.uvTransform.uvOffset;
+            data.uvScale = ct.uvTransform.uvScale;
+        }
+    }
+}
+
+void GPULayerGroup::bind(ghoul::opengl::ProgramObject& p, const LayerGroup& layerGroup,
+                         bool useBindlessTextures)
+{
+    _useBindlessTextures = useBindlessTextures;
+
     const std::vector<Layer*>& activeLayers = layerGroup.activeLayers();
     _gpuActiveLayers.resize(activeLayers.size());
     const int pileSize = layerGroup.pileSize();
@@ -25,13 +25,19 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___GPULAYERGROUP___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___GPULAYERGROUP___H__
 
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-namespace ghoul::opengl { class ProgramObject; }
+namespace ghoul::opengl {
+    class ProgramObject;
+    class Texture;
+} // namespace ghoul::opengl
 
 namespace openspace::globebrowsing {
 
@@ -49,6 +55,20 @@ struct TileIndex;
  */
 class GPULayerGroup {
 public:
+    /// The number of chunk tiles that are stored for each layer by #appendChunkTiles
+    static constexpr int ChunkTilesPerLayer = 3;
+
+    /**
+     * The GPU representation of a single chunk tile when the chunk tiles of many chunks
+     * are stored in a shader storage buffer. Keep in sync with `ChunkTileData` in
+     * shaders/chunkdata.glsl
+     */
+    struct ChunkTileData {
+        GLuint64 textureHandle = 0;
+        glm::vec2 uvOffset = glm::vec2(0.f);
+        glm::vec2 uvScale = glm::vec2(0.f);
+    };
+
     /**
      * Sets the value of `LayerGroup` to its corresponding GPU struct. OBS! Users must
      * ensure bind has been called before setting using this method.
@@ -56,12 +76,34 @@ public:
     void setValue(ghoul::opengl::ProgramObject& programObject,
         const LayerGroup& layerGroup, const TileIndex& tileIndex);
 
+    /**
+     * Sets only the values of the `LayerGroup` that do not depend on the rendered chunk,
+     * such as the layer settings. This is used instead of #setValue when the chunk tiles
+     * of all chunks are provided through #appendChunkTiles instead.
+     */
+    void setLayerValues(ghoul::opengl::ProgramObject& programObject,
+        const LayerGroup& layerGroup);
+
+    /**
+     * Appends #ChunkTilesPerLayer entries for every active layer of the \p layerGroup to
+     * \p chunkTiles, containing the chunk tiles to use for the chunk with the provided
+     * \p tileIndex. Unused entries, for example for solid color layers or if level
+     * blending is disabled, and tiles without a texture have a texture handle of 0.
+     * Tiles whose textures are not already resident get a bindless handle that is made
+     * resident. This requires support for the GL_ARB_bindless_texture extension.
+     */
+    void appendChunkTiles(const LayerGroup& layerGroup, const TileIndex& tileIndex,
+        std::vector<ChunkTileData>& chunkTiles);
+
     /**
      * Binds this object with GLSL variables with identifiers starting with nameBase
      * within the provided shader program. After this method has been called, users may
-     * invoke setValue.
+     * invoke setValue. If \p useBindlessTextures is `true`, the program must have been
+     * compiled with bindless samplers and tiles that have a bindless handle are passed to
+     * the program through their handle instead of being bound to a texture unit.
      */
-    void bind(ghoul::opengl::ProgramObject& programObject, const LayerGroup& layerGroup);
+    void bind(ghoul::opengl::ProgramObject& programObject, const LayerGroup& layerGroup,
+        bool useBindlessTextures = false);
 
     /**
     * Deactivates any `TextureUnit`s assigned by this object. This method should be called
@@ -84,6 +126,10 @@ private:
     };
 
     std::vector<GPULayer> _gpuActiveLayers;
+    bool _useBindlessTextures = false;
+
+    /// Handles of the textures without own bindless handle, reset by #setLayerValues
+    std::unordered_map<const ghoul::opengl::Texture*, GLuint64> _residentTextureHandles;
 };
 
 } // namespace openspace::globebrowsing
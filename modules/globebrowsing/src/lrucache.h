@@ -25,21 +25,29 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___LRU_CACHE___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___LRU_CACHE___H__
 
-#include <list>
-#include <unordered_map>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace openspace::globebrowsing::cache {
 
 /**
- * Templated class implementing a Least-Recently-Used Cache. `KeyType` needs to be an
- * enumerable type.
+ * Templated class implementing a Least-Recently-Used Cache. `KeyType` needs to be
+ * equality comparable and hashable by `HasherType`.
+ *
+ * All items are stored in a contiguous array and are linked into the usage order through
+ * indices into that array. The keys are looked up through an open-addressed hash table
+ * with linear probing. Removed items are kept on a free list and are reused by the next
+ * insertion, so once the cache has reached its working size, none of the operations
+ * allocate memory. The storage only grows when more items than ever before are stored at
+ * the same time, which can be avoided by calling #reserve.
  */
 template <typename KeyType, typename ValueType, typename HasherType>
 class LRUCache {
 public:
     using Item = std::pair<KeyType, ValueType>;
-    using Items = std::list<Item>;
 
     /**
      * \param size This is the maximum size of the cache given in number of cached items
@@ -47,6 +55,14 @@ public:
     LRUCache(size_t size);
 
     void put(KeyType key, ValueType value);
+
+    /**
+     * Puts the value at the back of the queue, making it the first candidate to be
+     * removed. Nothing happens if the key already exists or if the cache is full.
+     *
+     * \return `true` if the value was added to the cache
+     */
+    bool putLRU(KeyType key, ValueType value);
     std::vector<Item> putAndFetchPopped(KeyType key, ValueType value);
     void clear();
     bool exist(const KeyType& key) const;
@@ -69,17 +85,71 @@ public:
      * Pops the back of the queue.
      */
     Item popLRU();
+
+    /**
+     * Pops the item whose key has the largest value according to the \p priority
+     * function. If multiple items have the same priority, the one closest to the front
+     * of the queue is popped.
+     */
+    template <typename Priority>
+    Item popHighestPriority(const Priority& priority);
+
+    /**
+     * Pops the least recently used item whose key fulfills the \p predicate.
+     *
+     * \return The popped item or `std::nullopt` if no key fulfills the \p predicate
+     */
+    template <typename Predicate>
+    std::optional<Item> popLRUIf(const Predicate& predicate);
     size_t size() const;
     size_t maximumCacheSize() const;
 
+    /**
+     * Preallocates the storage for \p nItems items, so that no allocations happen until
+     * more than \p nItems items are stored in the cache at the same time.
+     */
+    void reserve(size_t nItems);
+
 private:
+    using Index = uint32_t;
+    static constexpr Index Invalid = std::numeric_limits<Index>::max();
+
+    struct Node {
+        Item item;
+        size_t hash = 0;
+        /// The neighbor closer to the front of the queue, or the next free node
+        Index prev = Invalid;
+        Index next = Invalid;
+    };
+
+    /// Returns the slot in the hash table containing the \p key, or `Invalid`
+    Index findSlot(const KeyType& key, size_t hash) const;
+    void insertIntoTable(Index node);
+    void eraseFromTable(Index slot);
+    void growTableIfNeeded();
+    void rehash(size_t nSlots);
+
+    Index allocateNode(KeyType key, ValueType value, size_t hash);
+    Item releaseNode(Index node);
+
+    void linkFront(Index node);
+    void linkBack(Index node);
+    void unlink(Index node);
+
     void putWithoutCleaning(KeyType key, ValueType value);
     void clean();
 
     std::vector<Item> cleanAndFetchPopped();
 
-    Items _itemList;
-    std::unordered_map<KeyType, typename Items::const_iterator, HasherType> _itemMap;
+    std::vector<Node> _nodes;
+    /// Open-addressed hash table of indices into `_nodes`. The size is a power of two
+    std::vector<Index> _slots;
+    HasherType _hasher;
+
+    Index _front = Invalid;
+    Index _back = Invalid;
+    Index _freeList = Invalid;
+    size_t _size = 0;
 
     size_t _maximumCacheSize;
 };
@@ -24,6 +24,7 @@
 
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
 
 namespace openspace::globebrowsing::cache {
 
@@ -34,8 +35,14 @@ LRUCache<KeyType, ValueType, HasherType>::LRUCache(size_t size)
 
 template<typename KeyType, typename ValueType, typename HasherType>
 void LRUCache<KeyType, ValueType, HasherType>::clear() {
-    _itemList.clear();
-    _itemMap.clear();
+    // Clearing the vectors keeps their capacity, so refilling the cache up to its
+    // previous size does not allocate
+    _nodes.clear();
+    std::fill(_slots.begin(), _slots.end(), Invalid);
+    _front = Invalid;
+    _back = Invalid;
+    _freeList = Invalid;
+    _size = 0;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
@@ -44,6 +51,18 @@ void LRUCache<KeyType, ValueType, HasherType>::put(KeyType key, ValueType value)
     clean();
 }
 
+template<typename KeyType, typename ValueType, typename HasherType>
+bool LRUCache<KeyType, ValueType, HasherType>::putLRU(KeyType key, ValueType value) {
+    if (_size >= _maximumCacheSize || exist(key)) {
+        return false;
+    }
+
+    const size_t hash = _hasher(key);
+    const Index node = allocateNode(std::move(key), std::move(value), hash);
+    linkBack(node);
+    return true;
+}
+
 template<typename KeyType, typename ValueType, typename HasherType>
 std::vector<std::pair<KeyType, ValueType>>
 LRUCache<KeyType, ValueType, HasherType>::putAndFetchPopped(KeyType key, ValueType value)
@@ -54,76 +73,89 @@ LRUCache<KeyType, ValueType, HasherType>::putAndFetchPopped(KeyType key, ValueTy
 
 template<typename KeyType, typename ValueType, typename HasherType>
 bool LRUCache<KeyType, ValueType, HasherType>::exist(const KeyType& key) const {
-    return (_itemMap.count(key) > 0);
+    return findSlot(key, _hasher(key)) != Invalid;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 bool LRUCache<KeyType, ValueType, HasherType>::touch(const KeyType& key) {
     ZoneScoped;
 
-    const auto it = _itemMap.find(key);
-    if (it != _itemMap.end()) {
-        // @TODO (abock, 2020-08-14) Instead of removing the iterator from the previous
-        // position and then readding it at the front, it might make more sense to move
-        // them around?  That would prevent the dynamic memoray allocation that is
-        // happening here
-
-        // Found in cache
-        ValueType value = it->second->second;
-        // Remove from current position
-        _itemList.erase(it->second);
-        _itemMap.erase(it);
-        // Bump to front
-        _itemList.emplace_front(key, value);
-        _itemMap.emplace(key, _itemList.begin());
-
-        return true;
-    }
-    else {
+    const Index slot = findSlot(key, _hasher(key));
+    if (slot == Invalid) {
         return false;
     }
+
+    // Bump to front
+    const Index node = _slots[slot];
+    unlink(node);
+    linkFront(node);
+    return true;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 bool LRUCache<KeyType, ValueType, HasherType>::isEmpty() const {
-    return (_itemMap.size() == 0);
+    return _size == 0;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 ValueType LRUCache<KeyType, ValueType, HasherType>::get(const KeyType& key) {
-    const auto it = _itemMap.find(key);
-    // Move list iterator pointing to value
-    _itemList.splice(_itemList.begin(), _itemList, it->second);
-    ValueType res = it->second->second;
-    return res;
+    const Index slot = findSlot(key, _hasher(key));
+    ghoul_assert(slot != Invalid, "Key does not exist in the LRU cache");
+
+    const Index node = _slots[slot];
+    unlink(node);
+    linkFront(node);
+    return _nodes[node].item.second;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 std::pair<KeyType, ValueType> LRUCache<KeyType, ValueType, HasherType>::popMRU() {
-    ghoul_assert(!_itemList.empty(), "Cannot pop LRU cache. Ensure cache is not empty");
+    ghoul_assert(_size > 0, "Cannot pop LRU cache. Ensure cache is not empty");
 
-    auto first_it = _itemList.begin();
-    _itemMap.erase(first_it->first);
-    std::pair<KeyType, ValueType> toReturn = _itemList.front();
-    _itemList.pop_front();
-    return toReturn;
+    return releaseNode(_front);
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 std::pair<KeyType, ValueType> LRUCache<KeyType, ValueType, HasherType>::popLRU() {
-    ghoul_assert(!_itemList.empty(), "Cannot pop LRU cache. Ensure cache is not empty");
+    ghoul_assert(_size > 0, "Cannot pop LRU cache. Ensure cache is not empty");
 
-    auto lastIt = _itemList.end();
-    lastIt--;
-    _itemMap.erase(lastIt->first);
-    std::pair<KeyType, ValueType> toReturn = _itemList.back();
-    _itemList.pop_back();
-    return toReturn;
+    return releaseNode(_back);
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+template<typename Priority>
+std::pair<KeyType, ValueType>
+LRUCache<KeyType, ValueType, HasherType>::popHighestPriority(const Priority& priority) {
+    ghoul_assert(_size > 0, "Cannot pop LRU cache. Ensure cache is not empty");
+
+    Index best = _front;
+    float bestPriority = priority(_nodes[best].item.first);
+    for (Index i = _nodes[best].next; i != Invalid; i = _nodes[i].next) {
+        const float p = priority(_nodes[i].item.first);
+        if (p > bestPriority) {
+            best = i;
+            bestPriority = p;
+        }
+    }
+
+    return releaseNode(best);
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+template<typename Predicate>
+std::optional<std::pair<KeyType, ValueType>>
+LRUCache<KeyType, ValueType, HasherType>::popLRUIf(const Predicate& predicate) {
+    for (Index i = _back; i != Invalid; i = _nodes[i].prev) {
+        if (predicate(_nodes[i].item.first)) {
+            return releaseNode(i);
+        }
+    }
+    return std::nullopt;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 size_t LRUCache<KeyType, ValueType, HasherType>::size() const {
-    return _itemMap.size();
+    return _size;
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
@@ -131,26 +163,207 @@ size_t LRUCache<KeyType, ValueType, HasherType>::maximumCacheSize() const {
     return _maximumCacheSize;
 }
 
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::reserve(size_t nItems) {
+    ghoul_assert(nItems < Invalid, "Too many items requested");
+
+    _nodes.reserve(nItems);
+
+    size_t nSlots = std::max<size_t>(_slots.size(), 16);
+    while (nItems * 4 > nSlots * 3) {
+        nSlots *= 2;
+    }
+    if (nSlots > _slots.size()) {
+        rehash(nSlots);
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+typename LRUCache<KeyType, ValueType, HasherType>::Index
+LRUCache<KeyType, ValueType, HasherType>::findSlot(const KeyType& key,
+                                                   size_t hash) const
+{
+    if (_slots.empty()) {
+        return Invalid;
+    }
+
+    const size_t mask = _slots.size() - 1;
+    // The table is never full, so the probing is guaranteed to hit an empty slot
+    for (size_t i = hash & mask; _slots[i] != Invalid; i = (i + 1) & mask) {
+        const Node& n = _nodes[_slots[i]];
+        if (n.hash == hash && n.item.first == key) {
+            return static_cast<Index>(i);
+        }
+    }
+    return Invalid;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::insertIntoTable(Index node) {
+    const size_t mask = _slots.size() - 1;
+    size_t i = _nodes[node].hash & mask;
+    while (_slots[i] != Invalid) {
+        i = (i + 1) & mask;
+    }
+    _slots[i] = node;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::eraseFromTable(Index slot) {
+    // Backward shift deletion: close the gap by moving up all following entries of the
+    // probe sequence that would otherwise no longer be reachable from their home slot.
+    // That way the table never contains any tombstones
+    const size_t mask = _slots.size() - 1;
+    size_t hole = slot;
+    size_t i = slot;
+    while (true) {
+        i = (i + 1) & mask;
+        if (_slots[i] == Invalid) {
+            break;
+        }
+
+        const size_t home = _nodes[_slots[i]].hash & mask;
+        const bool isReachable = hole <= i ?
+            (hole < home && home <= i) :
+            (hole < home || home <= i);
+        if (!isReachable) {
+            _slots[hole] = _slots[i];
+            hole = i;
+        }
+    }
+    _slots[hole] = Invalid;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::growTableIfNeeded() {
+    // Keep the load factor at or below 3/4 to keep the probe sequences short
+    if ((_size + 1) * 4 > _slots.size() * 3) {
+        rehash(std::max<size_t>(_slots.size() * 2, 16));
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::rehash(size_t nSlots) {
+    ghoul_assert((nSlots & (nSlots - 1)) == 0, "Number of slots must be a power of 2");
+
+    _slots.assign(nSlots, Invalid);
+    for (Index i = _front; i != Invalid; i = _nodes[i].next) {
+        insertIntoTable(i);
+    }
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+typename LRUCache<KeyType, ValueType, HasherType>::Index
+LRUCache<KeyType, ValueType, HasherType>::allocateNode(KeyType key, ValueType value,
+                                                       size_t hash)
+{
+    growTableIfNeeded();
+
+    Index node = Invalid;
+    if (_freeList != Invalid) {
+        node = _freeList;
+        _freeList = _nodes[node].next;
+        _nodes[node].item = Item(std::move(key), std::move(value));
+        _nodes[node].hash = hash;
+        _nodes[node].next = Invalid;
+    }
+    else {
+        ghoul_assert(_nodes.size() < Invalid, "Too many items in the LRU cache");
+        node = static_cast<Index>(_nodes.size());
+        _nodes.push_back({ Item(std::move(key), std::move(value)), hash });
+    }
+
+    insertIntoTable(node);
+    _size++;
+    return node;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+std::pair<KeyType, ValueType>
+LRUCache<KeyType, ValueType, HasherType>::releaseNode(Index node) {
+    const size_t mask = _slots.size() - 1;
+    size_t slot = _nodes[node].hash & mask;
+    while (_slots[slot] != node) {
+        slot = (slot + 1) & mask;
+    }
+    eraseFromTable(static_cast<Index>(slot));
+    unlink(node);
+
+    Item res = std::move(_nodes[node].item);
+    _nodes[node].next = _freeList;
+    _freeList = node;
+    _size--;
+    return res;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::linkFront(Index node) {
+    _nodes[node].prev = Invalid;
+    _nodes[node].next = _front;
+    if (_front != Invalid) {
+        _nodes[_front].prev = node;
+    }
+    else {
+        _back = node;
+    }
+    _front = node;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::linkBack(Index node) {
+    _nodes[node].prev = _back;
+    _nodes[node].next = Invalid;
+    if (_back != Invalid) {
+        _nodes[_back].next = node;
+    }
+    else {
+        _front = node;
+    }
+    _back = node;
+}
+
+template<typename KeyType, typename ValueType, typename HasherType>
+void LRUCache<KeyType, ValueType, HasherType>::unlink(Index node) {
+    Node& n = _nodes[node];
+    if (n.prev != Invalid) {
+        _nodes[n.prev].next = n.next;
+    }
+    else {
+        _front = n.next;
+    }
+    if (n.next != Invalid) {
+        _nodes[n.next].prev = n.prev;
+    }
+    else {
+        _back = n.prev;
+    }
+    n.prev = Invalid;
+    n.next = Invalid;
+}
+
 template<typename KeyType, typename ValueType, typename HasherType>
 void LRUCache<KeyType, ValueType, HasherType>::putWithoutCleaning(KeyType key,
                                                                   ValueType value)
 {
-    const auto it = _itemMap.find(key);
-    if (it != _itemMap.end()) {
-        _itemList.erase(it->second);
-        _itemMap.erase(it);
+    const size_t hash = _hasher(key);
+    const Index slot = findSlot(key, hash);
+    if (slot != Invalid) {
+        // Reuse the existing node instead of removing and readding it
+        const Index node = _slots[slot];
+        _nodes[node].item.second = std::move(value);
+        unlink(node);
+        linkFront(node);
+    }
+    else {
+        const Index node = allocateNode(std::move(key), std::move(value), hash);
+        linkFront(node);
     }
-    _itemList.emplace_front(key, std::move(value));
-    _itemMap.emplace(std::move(key), _itemList.begin());
 }
 
 template<typename KeyType, typename ValueType, typename HasherType>
 void LRUCache<KeyType, ValueType, HasherType>::clean() {
-    while (_itemMap.size() > _maximumCacheSize) {
-        auto lastIt = _itemList.end();
-        lastIt--;
-        _itemMap.erase(lastIt->first);
-        _itemList.pop_back();
+    while (_size > _maximumCacheSize) {
+        releaseNode(_back);
     }
 }
 
@@ -159,12 +372,8 @@ std::vector<std::pair<KeyType, ValueType>>
 LRUCache<KeyType, ValueType, HasherType>::cleanAndFetchPopped()
 {
     std::vector<std::pair<KeyType, ValueType>> toReturn;
-    while (_itemMap.size() > _maximumCacheSize) {
-        auto lastIt = _itemList.end();
-        lastIt--;
-        _itemMap.erase(lastIt->first);
-        toReturn.push_back(_itemList.back());
-        _itemList.pop_back();
+    while (_size > _maximumCacheSize) {
+        toReturn.push_back(releaseNode(_back));
     }
     return toReturn;
 }
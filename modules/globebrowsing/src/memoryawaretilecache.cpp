@@ -27,9 +27,13 @@
 #include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/layermanager.h>
 #include <modules/globebrowsing/src/rawtile.h>
+#include <modules/globebrowsing/src/tilecompression.h>
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
 #include <numeric>
 
 namespace {
@@ -51,6 +55,15 @@ namespace {
         openspace::properties::Property::Visibility::Developer
     };
 
+    constexpr openspace::properties::Property::PropertyInfo NumPendingUploadsInfo = {
+        "NumberOfPendingUploads",
+        "Number of pending uploads",
+        "This value denotes the number of tiles that have been loaded but that are still "
+        "waiting to be uploaded to the GPU because the upload budget of the previous "
+        "frames has been used up.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     constexpr openspace::properties::Property::PropertyInfo TileCacheSizeInfo = {
         "TileCacheSize",
         "Tile cache size",
@@ -72,6 +85,57 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseBindlessTexturesInfo = {
+        "UseBindlessTextures",
+        "Use Bindless Textures",
+        "If enabled and supported by the graphics driver (GL_ARB_bindless_texture), the "
+        "tile textures are made resident once and are referenced by the globe shaders "
+        "through their handles, removing the need to bind the textures of every chunk "
+        "before rendering it. Changing this value clears the tile cache.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo HitRateInfo = {
+        "HitRate",
+        "Hit rate",
+        "This value denotes the fraction of tile requests during the last second that "
+        "could be served from the tile cache.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo EvictionsPerSecondInfo = {
+        "EvictionsPerSecond",
+        "Evictions per second",
+        "This value denotes the number of tiles per second that were removed from the "
+        "tile cache during the last second to make room for new tiles.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo GroupBudgetInfo = {
+        "Budget",
+        "Budget (MB)",
+        "The maximum amount of GPU memory (in MB) that the tiles of all layers in this "
+        "layer group can use. If the budget is used up, new tiles of this layer group "
+        "replace the least recently used tiles of the same group instead of the tiles of "
+        "other layer groups. A value of 0 means that the layer group is only limited by "
+        "the size of the tile cache.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo GroupAllocatedInfo = {
+        "Allocated",
+        "Allocated (MB)",
+        "This value denotes the amount of GPU memory (in MB) that is currently used by "
+        "the tiles of all layers in this layer group.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr size_t ByteToMegaByte = 1024 * 1024;
+
+    bool isBindlessTextureSupported() {
+        return OpenGLCap.isExtensionSupported("GL_ARB_bindless_texture");
+    }
+
     GLenum toGlTextureFormat(GLenum glType, ghoul::opengl::Texture::Format format) {
         switch (format) {
             case ghoul::opengl::Texture::Format::Red:
@@ -197,9 +261,11 @@ namespace openspace::globebrowsing::cache {
 // TextureContainer
 //
 MemoryAwareTileCache::TextureContainer::TextureContainer(TileTextureInitData initData,
-                                                         size_t numTextures)
+                                                         size_t numTextures,
+                                                         bool useBindlessTextures)
     : _initData(std::move(initData))
     , _numTextures(numTextures)
+    , _useBindlessTextures(useBindlessTextures)
 {
     ZoneScoped;
 
@@ -207,9 +273,23 @@ MemoryAwareTileCache::TextureContainer::TextureContainer(TileTextureInitData ini
     reset();
 }
 
+MemoryAwareTileCache::TextureContainer::~TextureContainer() {
+    releaseBindlessHandles();
+}
+
+void MemoryAwareTileCache::TextureContainer::releaseBindlessHandles() {
+    for (const std::pair<const ghoul::opengl::Texture* const, GLuint64>& p :
+         _bindlessHandles)
+    {
+        glMakeTextureHandleNonResidentARB(p.second);
+    }
+    _bindlessHandles.clear();
+}
+
 void MemoryAwareTileCache::TextureContainer::reset() {
     ZoneScoped;
 
+    releaseBindlessHandles();
     _textures.clear();
     _freeTexture = 0;
 
@@ -225,29 +305,92 @@ void MemoryAwareTileCache::TextureContainer::reset() {
 
         using namespace ghoul::opengl;
 
+        const GLenum internalFormat =
+            _initData.isCompressed ?
+            CompressedTileFormat :
+            toGlTextureFormat(_initData.glType, _initData.ghoulTextureFormat);
+
         std::unique_ptr<Texture> tex = std::make_unique<Texture>(
             _initData.dimensions,
             GL_TEXTURE_2D,
             _initData.ghoulTextureFormat,
-            toGlTextureFormat(_initData.glType, _initData.ghoulTextureFormat),
+            internalFormat,
             _initData.glType,
-            mode,
+            _initData.isCompressed ? Texture::FilterMode::Linear : mode,
             Texture::WrappingMode::ClampToEdge,
             Texture::AllocateData(_initData.shouldAllocateDataOnCPU)
         );
 
         tex->setDataOwnership(Texture::TakeOwnership::Yes);
-        tex->setFilter(mode);
-        tex->uploadTexture();
+        if (_initData.isCompressed) {
+            allocateCompressedStorage(*tex, mode);
+        }
+        else {
+            tex->setFilter(mode);
+            tex->uploadTexture();
+        }
+
+        if (_useBindlessTextures) {
+            // Creating the handle makes the state of the texture immutable, so the
+            // filter mode can not be changed afterwards. The pixel data can still be
+            // updated though
+            const GLuint64 handle = glGetTextureHandleARB(static_cast<GLuint>(*tex));
+            glMakeTextureHandleResidentARB(handle);
+            _bindlessHandles[tex.get()] = handle;
+        }
 
         _textures.push_back(std::move(tex));
     }
 }
 
-void MemoryAwareTileCache::TextureContainer::reset(size_t numTextures) {
+void MemoryAwareTileCache::TextureContainer::allocateCompressedStorage(
+                                                       ghoul::opengl::Texture& texture,
+                                               ghoul::opengl::Texture::FilterMode mode)
+{
+    // The Texture class can neither allocate the storage of compressed textures nor
+    // generate their mipmaps, so the storage for all mip levels is allocated here and
+    // the mip levels are provided by the compressed tile data instead
+    texture.bind();
+    const std::vector<size_t> levelSizes = compressedMipLevelSizes(
+        glm::ivec2(_initData.dimensions)
+    );
+    for (size_t level = 0; level < levelSizes.size(); level++) {
+        glCompressedTexImage2D(
+            GL_TEXTURE_2D,
+            static_cast<GLint>(level),
+            CompressedTileFormat,
+            std::max(_initData.dimensions.x >> level, 1),
+            std::max(_initData.dimensions.y >> level, 1),
+            0,
+            static_cast<GLsizei>(levelSizes[level]),
+            nullptr
+        );
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(
+        GL_TEXTURE_2D,
+        GL_TEXTURE_MAX_LEVEL,
+        static_cast<GLint>(levelSizes.size() - 1)
+    );
+    if (mode == ghoul::opengl::Texture::FilterMode::AnisotropicMipMap) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        GLfloat maxAnisotropy = 1.f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, maxAnisotropy);
+    }
+    else {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
+}
+
+void MemoryAwareTileCache::TextureContainer::reset(size_t numTextures,
+                                                   bool useBindlessTextures)
+{
     ZoneScoped;
 
     _numTextures = numTextures;
+    _useBindlessTextures = useBindlessTextures;
     reset();
 }
 
@@ -268,10 +411,31 @@ MemoryAwareTileCache::TextureContainer::tileTextureInitData() const
     return _initData;
 }
 
+GLuint64 MemoryAwareTileCache::TextureContainer::bindlessHandle(
+                                             const ghoul::opengl::Texture* texture) const
+{
+    const auto it = _bindlessHandles.find(texture);
+    return it != _bindlessHandles.end() ? it->second : 0;
+}
+
 size_t MemoryAwareTileCache::TextureContainer::size() const {
     return _textures.size();
 }
 
+//
+// GroupBudget
+//
+MemoryAwareTileCache::GroupBudget::GroupBudget(const layers::Group& group)
+    : properties::PropertyOwner({ std::string(group.identifier), std::string(group.name)})
+    , budget(GroupBudgetInfo, 0, 0, 16384, 1)
+    , allocated(GroupAllocatedInfo, 0, 0, std::numeric_limits<int>::max())
+{
+    addProperty(budget);
+
+    allocated.setReadOnly(true);
+    addProperty(allocated);
+}
+
 //
 // MemoryAwareTileCache
 //
@@ -281,14 +445,54 @@ MemoryAwareTileCache::MemoryAwareTileCache(int tileCacheSize)
     , _numTextureBytesAllocatedOnCPU(0)
     , _cpuAllocatedTileData(CpuAllocatedDataInfo, tileCacheSize, 128, 16384, 1)
     , _gpuAllocatedTileData(GpuAllocatedDataInfo, tileCacheSize, 128, 16384, 1)
+    , _cpuMemory("", "GlobeBrowsing", MemoryTracker::Type::Ram)
+    , _gpuMemory("", "GlobeBrowsing", MemoryTracker::Type::Vram)
+    , _numPendingUploads(NumPendingUploadsInfo, 0, 0, std::numeric_limits<int>::max())
     , _tileCacheSize(TileCacheSizeInfo, tileCacheSize, 128, 16384, 1)
     , _applyTileCacheSize(ApplyTileCacheInfo)
     , _clearTileCache(ClearTileCacheInfo)
+    , _useBindlessTextures(UseBindlessTexturesInfo, false)
+    , _hitRate(HitRateInfo, 0.f, 0.f, 1.f)
+    , _evictionsPerSecond(
+        EvictionsPerSecondInfo,
+        0.f,
+        0.f,
+        std::numeric_limits<float>::max()
+    )
+    , _budgetsOwner({ "Budgets" })
 {
     ZoneScoped;
 
     createDefaultTextureContainers();
 
+    _hitRate.setReadOnly(true);
+    addProperty(_hitRate);
+
+    _evictionsPerSecond.setReadOnly(true);
+    addProperty(_evictionsPerSecond);
+
+    for (const layers::Group& group : layers::Groups) {
+        ghoul_assert(
+            static_cast<size_t>(group.id) == _groupBudgets.size(),
+            "Layer groups must be ordered by their ID"
+        );
+        std::unique_ptr<GroupBudget> budget = std::make_unique<GroupBudget>(group);
+        _budgetsOwner.addPropertySubOwner(budget.get());
+        _groupBudgets.push_back(std::move(budget));
+    }
+    addPropertySubOwner(_budgetsOwner);
+
+    _useBindlessTextures.onChange([this]() {
+        if (_useBindlessTextures && !isBindlessTextureSupported()) {
+            LWARNING("Bindless textures are not supported by the graphics driver");
+            _useBindlessTextures = false;
+            return;
+        }
+        // The textures have to be recreated to create or release their handles
+        setSizeEstimated(uint64_t(_tileCacheSize) * 1024ul * 1024ul);
+    });
+    addProperty(_useBindlessTextures);
+
     _clearTileCache.onChange([this]() { clear(); });
     addProperty(_clearTileCache);
 
@@ -309,6 +513,9 @@ MemoryAwareTileCache::MemoryAwareTileCache(int tileCacheSize)
     _gpuAllocatedTileData.setReadOnly(true);
     addProperty(_gpuAllocatedTileData);
 
+    _numPendingUploads.setReadOnly(true);
+    addProperty(_numPendingUploads);
+
     _tileCacheSize.setMaxValue(
         static_cast<int>(CpuCap.installedMainMemory() * 0.95)
     );
@@ -326,9 +533,16 @@ void MemoryAwareTileCache::clear() {
         p.second.first->reset();
         p.second.second->clear();
     }
+    _pendingUploads.clear();
+    resetTileUsage();
+    _contentVersion++;
     LINFO("Tile cache cleared");
 }
 
+bool MemoryAwareTileCache::useBindlessTextures() const {
+    return _useBindlessTextures;
+}
+
 void MemoryAwareTileCache::createDefaultTextureContainers() {
     ZoneScoped;
 
@@ -346,10 +560,19 @@ void MemoryAwareTileCache::assureTextureContainerExists(
     const TileTextureInitData::HashKey initDataKey = initData.hashKey;
     if (_textureContainerMap.find(initDataKey) == _textureContainerMap.end()) {
         // For now create 500 textures of this type
+        constexpr size_t NumTextures = 500;
+        auto tileCache = std::make_unique<TileCache>(std::numeric_limits<size_t>::max());
+        // Every cached tile owns one of the textures, so sizing the cache storage after
+        // the texture container avoids allocations while the cache is filling up
+        tileCache->reserve(NumTextures);
         _textureContainerMap.emplace(initDataKey,
             TextureContainerTileCache(
-                std::make_unique<TextureContainer>(initData, 500),
-                std::make_unique<TileCache>(std::numeric_limits<size_t>::max())
+                std::make_unique<TextureContainer>(
+                    initData,
+                    NumTextures,
+                    _useBindlessTextures
+                ),
+                std::move(tileCache)
             )
         );
     }
@@ -368,7 +591,7 @@ void MemoryAwareTileCache::setSizeEstimated(size_t estimatedSize) {
         [](size_t s, const std::pair<const TileTextureInitData::HashKey,
                                      TextureContainerTileCache>& p)
         {
-            return s + p.second.first->tileTextureInitData().totalNumBytes;
+            return s + p.second.first->tileTextureInitData().totalNumBytesOnGPU;
         }
     );
 
@@ -389,9 +612,12 @@ void MemoryAwareTileCache::resetTextureContainerSize(size_t numTexturesPerTextur
     for (std::pair<const TileTextureInitData::HashKey,
         TextureContainerTileCache>& p : _textureContainerMap)
     {
-        p.second.first->reset(numTexturesPerTextureType);
+        p.second.first->reset(numTexturesPerTextureType, _useBindlessTextures);
         p.second.second->clear();
+        p.second.second->reserve(numTexturesPerTextureType);
     }
+    resetTileUsage();
+    _contentVersion++;
 }
 
 bool MemoryAwareTileCache::exist(const ProviderTileKey& key) const {
@@ -419,31 +645,75 @@ Tile MemoryAwareTileCache::get(const ProviderTileKey& key) {
             return p.second.second->exist(key);
         }
     );
+    ProviderStatistics& statistics = _providerStatistics[key.providerID];
     if (it != _textureContainerMap.cend()) {
+        statistics.nHits++;
+        _statisticsWindow.nHits++;
         return it->second.second->get(key);
     }
     else {
+        statistics.nMisses++;
+        _statisticsWindow.nMisses++;
         return Tile();
     }
 }
 
-ghoul::opengl::Texture* MemoryAwareTileCache::texture(const TileTextureInitData& initData)
+ghoul::opengl::Texture* MemoryAwareTileCache::texture(const TileTextureInitData& initData,
+                                                      uint16_t providerID)
 {
     // if this texture type does not exist among the texture containers
     // it needs to be created
     const TileTextureInitData::HashKey initDataKey = initData.hashKey;
     assureTextureContainerExists(initData);
-    // Now we know that the texture container exists,
-    // check if there are any unused textures
-    ghoul::opengl::Texture* texture =
-        _textureContainerMap[initDataKey].first->getTextureIfFree();
-    // Second option. No more textures available. Pop from the LRU cache
-    if (!texture) {
-        const Tile oldTile = _textureContainerMap[initDataKey].second->popLRU().second;
-        // Use the old tile's texture
-        texture = oldTile.texture;
+    TextureContainerTileCache& container = _textureContainerMap[initDataKey];
+    const size_t nBytes = container.first->tileTextureInitData().totalNumBytesOnGPU;
+
+    auto evict = [this, nBytes](const TileCache::Item& item) {
+        removeTileUsage(item.first.providerID, nBytes);
+        _providerStatistics[item.first.providerID].nEvictions++;
+        _statisticsWindow.nEvictions++;
+        return item.second.texture;
+    };
+
+    // First option. If the provider or its layer group has used up its budget, it has
+    // to replace one of its own tiles so that it can't push out the tiles of others
+    const ExceededBudget exceeded = exceededBudget(providerID, nBytes);
+    if (exceeded != ExceededBudget::None) {
+        const ProviderStatistics& requester = _providerStatistics[providerID];
+        std::optional<TileCache::Item> item = container.second->popLRUIf(
+            [this, exceeded, providerID, group = requester.group](
+                                                               const ProviderTileKey& key)
+            {
+                if (exceeded == ExceededBudget::Provider) {
+                    return key.providerID == providerID;
+                }
+                const auto it = _providerStatistics.find(key.providerID);
+                return it != _providerStatistics.end() && it->second.group == group;
+            }
+        );
+        if (item.has_value()) {
+            return evict(*item);
+        }
+    }
+
+    // Second option. Check if there are any unused textures
+    ghoul::opengl::Texture* texture = container.first->getTextureIfFree();
+    if (texture) {
+        return texture;
     }
-    return texture;
+
+    // Third option. No more textures available. Pop from the LRU cache, preferring the
+    // tiles of providers or layer groups that are exceeding their budget
+    std::optional<TileCache::Item> item = container.second->popLRUIf(
+        [this](const ProviderTileKey& key) {
+            return exceededBudget(key.providerID, 0) != ExceededBudget::None;
+        }
+    );
+    if (!item.has_value()) {
+        item = container.second->popLRU();
+    }
+    // Use the old tile's texture
+    return evict(*item);
 }
 
 void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile rawTile) {
@@ -454,10 +724,23 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile rawTile
     }
     else {
         const TileTextureInitData& initData = *rawTile.textureInitData;
-        Texture* tex = texture(initData);
+        Texture* tex = texture(initData, key.providerID);
+        const TileTextureInitData::HashKey initDataKey = initData.hashKey;
+        const GLuint64 handle =
+            _textureContainerMap[initDataKey].first->bindlessHandle(tex);
 
-        // Re-upload texture, either using PBO or by using RAM data
-        if (rawTile.pbo != 0) {
+        // Re-upload texture, either using PBO or by using RAM data. Compressed tiles
+        // contain all of their mip levels and are not kept in RAM after the upload
+        if (initData.isCompressed) {
+            global::renderEngine->uploadScheduler().uploadCompressedTexture(
+                *tex,
+                CompressedTileFormat,
+                rawTile.imageData.get(),
+                compressedMipLevelSizes(glm::ivec2(initData.dimensions))
+            );
+            rawTile.imageData = nullptr;
+        }
+        else if (rawTile.pbo != 0) {
             tex->reUploadTextureFromPBO(rawTile.pbo);
             if (initData.shouldAllocateDataOnCPU) {
                 if (!tex->dataOwnership()) {
@@ -482,7 +765,7 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile rawTile
             const size_t numBytes = rawTile.textureInitData->totalNumBytes;
             ghoul_assert(expectedSize == numBytes, "Pixel data size is incorrect");
             _numTextureBytesAllocatedOnCPU += numBytes - previousExpectedDataSize;
-            tex->reUploadTexture();
+            global::renderEngine->uploadScheduler().uploadTexture(*tex);
         }
         // Hi there, I know someone will be tempted to change this to a Linear filtering
         // mode at some point. This will introduce rendering artifacts when looking at the
@@ -493,10 +776,13 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile rawTile
             ghoul::opengl::Texture::FilterMode::Linear :
             ghoul::opengl::Texture::FilterMode::AnisotropicMipMap;
 
-        tex->setFilter(mode);
-        Tile tile{ tex, std::move(rawTile.tileMetaData), Tile::Status::OK };
-        const TileTextureInitData::HashKey initDataKey = initData.hashKey;
-        _textureContainerMap[initDataKey].second->put(std::move(key), std::move(tile));
+        // Textures with a bindless handle already got their filter mode on creation and
+        // can no longer be changed. Compressed textures already contain their mip levels
+        if (handle == 0 && !initData.isCompressed) {
+            tex->setFilter(mode);
+        }
+        Tile tile{ tex, std::move(rawTile.tileMetaData), Tile::Status::OK, handle };
+        put(key, initDataKey, std::move(tile));
     }
 }
 
@@ -504,17 +790,103 @@ void MemoryAwareTileCache::put(const ProviderTileKey& key,
                                const TileTextureInitData::HashKey& initDataKey,
                                Tile tile)
 {
-    _textureContainerMap[initDataKey].second->put(key, std::move(tile));
+    TextureContainerTileCache& container = _textureContainerMap[initDataKey];
+    if (!container.second->exist(key)) {
+        addTileUsage(
+            key.providerID,
+            container.first->tileTextureInitData().totalNumBytesOnGPU
+        );
+    }
+    container.second->put(key, std::move(tile));
+    _contentVersion++;
+}
+
+void MemoryAwareTileCache::enqueueUpload(ProviderTileKey key, RawTile rawTile) {
+    const uint64_t frame = global::renderEngine->frameNumber();
+    _pendingUploads[key] = PendingUpload{ std::move(rawTile), frame };
+}
+
+bool MemoryAwareTileCache::touchPendingUpload(const ProviderTileKey& key) {
+    const auto it = _pendingUploads.find(key);
+    if (it == _pendingUploads.end()) {
+        return false;
+    }
+
+    it->second.lastRequestFrame = global::renderEngine->frameNumber();
+    return true;
+}
+
+void MemoryAwareTileCache::uploadPendingTiles() {
+    ZoneScoped;
+
+    UploadScheduler& scheduler = global::renderEngine->uploadScheduler();
+    if (_pendingUploads.empty() || !scheduler.hasBudget()) {
+        return;
+    }
+
+    using It = decltype(_pendingUploads)::iterator;
+    std::vector<It> order;
+    order.reserve(_pendingUploads.size());
+    for (It it = _pendingUploads.begin(); it != _pendingUploads.end(); it++) {
+        order.push_back(it);
+    }
+
+    // Tiles of chunks that are currently visible are requested every frame, so the most
+    // recently requested tiles come first. Coarser levels cover a larger area of the
+    // screen and are needed as a fallback for the finer levels, so they come next
+    std::sort(
+        order.begin(),
+        order.end(),
+        [](const It& lhs, const It& rhs) {
+            if (lhs->second.lastRequestFrame != rhs->second.lastRequestFrame) {
+                return lhs->second.lastRequestFrame > rhs->second.lastRequestFrame;
+            }
+            return lhs->first.tileIndex.level < rhs->first.tileIndex.level;
+        }
+    );
+
+    for (const It& it : order) {
+        if (!scheduler.hasBudget()) {
+            break;
+        }
+
+        ghoul_assert(!exist(it->first), "Tile must not be existing in cache");
+        createTileAndPut(it->first, std::move(it->second.rawTile));
+        _pendingUploads.erase(it);
+    }
 }
 
 void MemoryAwareTileCache::update() {
+    _numPendingUploads = static_cast<int>(_pendingUploads.size());
+
     const size_t dataSizeCPU = cpuAllocatedDataSize();
     const size_t dataSizeGPU = gpuAllocatedDataSize();
 
-    const size_t ByteToMegaByte = 1024 * 1024;
-
     _cpuAllocatedTileData = static_cast<int>(dataSizeCPU / ByteToMegaByte);
     _gpuAllocatedTileData = static_cast<int>(dataSizeGPU / ByteToMegaByte);
+    _cpuMemory.setSize(dataSizeCPU);
+    _gpuMemory.setSize(dataSizeGPU);
+
+    for (const std::unique_ptr<GroupBudget>& budget : _groupBudgets) {
+        budget->allocated = static_cast<int>(budget->nBytes / ByteToMegaByte);
+    }
+
+    // The rates are averaged over one second to make them readable
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const double dt =
+        std::chrono::duration<double>(now - _statisticsWindow.start).count();
+    if (dt >= 1.0) {
+        const uint64_t nRequests = _statisticsWindow.nHits + _statisticsWindow.nMisses;
+        _hitRate = nRequests > 0 ?
+            static_cast<float>(_statisticsWindow.nHits) / static_cast<float>(nRequests) :
+            0.f;
+        _evictionsPerSecond = static_cast<float>(_statisticsWindow.nEvictions / dt);
+
+        _statisticsWindow.start = now;
+        _statisticsWindow.nHits = 0;
+        _statisticsWindow.nMisses = 0;
+        _statisticsWindow.nEvictions = 0;
+    }
 }
 
 size_t MemoryAwareTileCache::gpuAllocatedDataSize() const {
@@ -526,7 +898,8 @@ size_t MemoryAwareTileCache::gpuAllocatedDataSize() const {
         TextureContainerTileCache>& p)
         {
             const TextureContainer& textureContainer = *p.second.first;
-            const size_t nBytes = textureContainer.tileTextureInitData().totalNumBytes;
+            const size_t nBytes =
+                textureContainer.tileTextureInitData().totalNumBytesOnGPU;
             return s + nBytes * textureContainer.size();
         }
     );
@@ -552,4 +925,100 @@ size_t MemoryAwareTileCache::cpuAllocatedDataSize() const {
     return dataSize + _numTextureBytesAllocatedOnCPU;
 }
 
+uint64_t MemoryAwareTileCache::contentVersion() const {
+    return _contentVersion;
+}
+
+void MemoryAwareTileCache::setProviderBudget(uint16_t providerID,
+                                             layers::Group::ID group, size_t budget)
+{
+    ProviderStatistics& statistics = _providerStatistics[providerID];
+    if (statistics.group != group) {
+        // Move the memory that is already used by the provider to the new group
+        if (GroupBudget* previous = groupBudget(statistics.group)) {
+            previous->nBytes -= statistics.nBytes;
+        }
+        if (GroupBudget* next = groupBudget(group)) {
+            next->nBytes += statistics.nBytes;
+        }
+        statistics.group = group;
+    }
+    statistics.budget = budget;
+}
+
+MemoryAwareTileCache::ProviderStatistics MemoryAwareTileCache::providerStatistics(
+                                                               uint16_t providerID) const
+{
+    const auto it = _providerStatistics.find(providerID);
+    return it != _providerStatistics.end() ? it->second : ProviderStatistics();
+}
+
+MemoryAwareTileCache::ProviderStatistics MemoryAwareTileCache::totalStatistics() const {
+    ProviderStatistics res;
+    for (const auto& [providerID, statistics] : _providerStatistics) {
+        res.nBytes += statistics.nBytes;
+        res.nHits += statistics.nHits;
+        res.nMisses += statistics.nMisses;
+        res.nEvictions += statistics.nEvictions;
+    }
+    return res;
+}
+
+MemoryAwareTileCache::ExceededBudget MemoryAwareTileCache::exceededBudget(
+                                                                      uint16_t providerID,
+                                                                     size_t nBytes) const
+{
+    const auto it = _providerStatistics.find(providerID);
+    if (it == _providerStatistics.end()) {
+        return ExceededBudget::None;
+    }
+
+    const ProviderStatistics& statistics = it->second;
+    if (statistics.budget > 0 && statistics.nBytes + nBytes > statistics.budget) {
+        return ExceededBudget::Provider;
+    }
+
+    const GroupBudget* budget = groupBudget(statistics.group);
+    if (budget && budget->budget > 0) {
+        const size_t groupBudget = static_cast<size_t>(budget->budget) * ByteToMegaByte;
+        if (budget->nBytes + nBytes > groupBudget) {
+            return ExceededBudget::Group;
+        }
+    }
+    return ExceededBudget::None;
+}
+
+MemoryAwareTileCache::GroupBudget* MemoryAwareTileCache::groupBudget(
+                                                            layers::Group::ID group) const
+{
+    const size_t index = static_cast<size_t>(group);
+    return index < _groupBudgets.size() ? _groupBudgets[index].get() : nullptr;
+}
+
+void MemoryAwareTileCache::addTileUsage(uint16_t providerID, size_t nBytes) {
+    ProviderStatistics& statistics = _providerStatistics[providerID];
+    statistics.nBytes += nBytes;
+    if (GroupBudget* budget = groupBudget(statistics.group)) {
+        budget->nBytes += nBytes;
+    }
+}
+
+void MemoryAwareTileCache::removeTileUsage(uint16_t providerID, size_t nBytes) {
+    ProviderStatistics& statistics = _providerStatistics[providerID];
+    ghoul_assert(statistics.nBytes >= nBytes, "Removing more bytes than were added");
+    statistics.nBytes -= nBytes;
+    if (GroupBudget* budget = groupBudget(statistics.group)) {
+        budget->nBytes -= nBytes;
+    }
+}
+
+void MemoryAwareTileCache::resetTileUsage() {
+    for (std::pair<const uint16_t, ProviderStatistics>& p : _providerStatistics) {
+        p.second.nBytes = 0;
+    }
+    for (const std::unique_ptr<GroupBudget>& budget : _groupBudgets) {
+        budget->nBytes = 0;
+    }
+}
+
 } // namespace openspace::globebrowsing::cache
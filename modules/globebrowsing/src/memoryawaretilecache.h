@@ -25,19 +25,23 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___MEMORY_AWARE_TILE_CACHE___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___MEMORY_AWARE_TILE_CACHE___H__
 
+#include <modules/globebrowsing/src/layergroupid.h>
 #include <modules/globebrowsing/src/lrucache.h>
+#include <modules/globebrowsing/src/rawtile.h>
 #include <modules/globebrowsing/src/tileindex.h>
 #include <modules/globebrowsing/src/tiletextureinitdata.h>
+#include <openspace/engine/memorytracker.h>
 #include <openspace/properties/propertyowner.h>
 #include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/triggerproperty.h>
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace openspace::globebrowsing {
-    struct RawTile;
     class Tile;
 } // namespace openspace::globebrowsing
 
@@ -84,21 +88,98 @@ struct ProviderTileHasher {
 
 class MemoryAwareTileCache : public properties::PropertyOwner {
 public:
+    /**
+     * The memory usage and the cache statistics of the tiles of a single tile provider.
+     */
+    struct ProviderStatistics {
+        layers::Group::ID group = layers::Group::ID::Unknown;
+        /// The maximum number of bytes the tiles of the provider may use, 0 if unlimited
+        size_t budget = 0;
+        /// The number of bytes on the GPU that are used by the tiles of the provider
+        size_t nBytes = 0;
+        uint64_t nHits = 0;
+        uint64_t nMisses = 0;
+        uint64_t nEvictions = 0;
+    };
+
     explicit MemoryAwareTileCache(int tileCacheSize = 1024);
 
     void clear();
+
+    /**
+     * Returns `true` if the textures of the tiles are made resident as bindless textures.
+     * In that case, the `Tile::bindlessHandle` of the tiles created by this cache can be
+     * passed to the shaders directly instead of binding the texture to a texture unit.
+     */
+    bool useBindlessTextures() const;
     void setSizeEstimated(size_t estimatedSize);
     bool exist(const ProviderTileKey& key) const;
     Tile get(const ProviderTileKey& key);
-    ghoul::opengl::Texture* texture(const TileTextureInitData& initData);
+
+    /**
+     * Returns a texture that the tile provider with the \p providerID can use for a new
+     * tile of the type described by \p initData. If the provider or its layer group has
+     * used up its budget, one of its own tiles is replaced. Otherwise, an unused texture
+     * is returned or, if there are none left, the least recently used tile is replaced,
+     * preferring the tiles of providers and layer groups that exceed their budget.
+     */
+    ghoul::opengl::Texture* texture(const TileTextureInitData& initData,
+        uint16_t providerID);
     void createTileAndPut(ProviderTileKey key, RawTile rawTile);
     void put(const ProviderTileKey& key,
         const TileTextureInitData::HashKey& initDataKey, Tile tile);
+
+    /**
+     * Queues the \p rawTile to be uploaded into the cache under the provided \p key the
+     * next time #uploadPendingTiles is called. The pending tiles of all tile providers
+     * share the per-frame upload budget of the UploadScheduler.
+     */
+    void enqueueUpload(ProviderTileKey key, RawTile rawTile);
+
+    /**
+     * Returns `true` if a tile for the \p key is waiting to be uploaded. In that case,
+     * the tile is marked as being requested in the current frame, which gives it a
+     * higher priority for the next upload.
+     */
+    bool touchPendingUpload(const ProviderTileKey& key);
+
+    /**
+     * Uploads the pending tiles until the upload budget of the current frame is used.
+     * Tiles that have been requested in the current frame are uploaded first and, among
+     * those, the tiles on coarser levels are uploaded before the finer levels.
+     */
+    void uploadPendingTiles();
     void update();
 
     size_t gpuAllocatedDataSize() const;
     size_t cpuAllocatedDataSize() const;
 
+    /**
+     * Registers the tile provider with the \p providerID as part of the layer group
+     * \p group and limits the GPU memory used by its tiles to \p budget bytes. A budget
+     * of 0 only limits the tiles of the provider by the budget of its layer group.
+     */
+    void setProviderBudget(uint16_t providerID, layers::Group::ID group, size_t budget);
+
+    /**
+     * Returns the memory usage and the cache statistics for the tile provider with the
+     * \p providerID.
+     */
+    ProviderStatistics providerStatistics(uint16_t providerID) const;
+
+    /**
+     * Returns the sum of the statistics of all tile providers since the application
+     * started. The group and the budget of the returned value are not used.
+     */
+    ProviderStatistics totalStatistics() const;
+
+    /**
+     * Returns a value that changes every time a tile is added to or removed from this
+     * cache. Pointers to the textures of the tiles remain valid for as long as this value
+     * does not change.
+     */
+    uint64_t contentVersion() const;
+
 private:
     /**
      * Owner of texture data used for tiles. Instead of dynamically allocating textures
@@ -109,13 +190,16 @@ private:
         /**
          * \param initData is the description of the texture type
          * \param numTextures is the number of textures to allocate
+         * \param useBindlessTextures whether a resident bindless handle should be
+         *        created for each of the textures
          */
-        TextureContainer(TileTextureInitData initData, size_t numTextures);
+        TextureContainer(TileTextureInitData initData, size_t numTextures,
+            bool useBindlessTextures);
 
-        ~TextureContainer() = default;
+        ~TextureContainer();
 
         void reset();
-        void reset(size_t numTextures);
+        void reset(size_t numTextures, bool useBindlessTextures);
 
         /**
          * \return A pointer to a texture if there is one texture never used before. If
@@ -126,19 +210,59 @@ private:
 
         const TileTextureInitData& tileTextureInitData() const;
 
+        /**
+         * \return the resident bindless handle of the \p texture or 0 if the texture is
+         *         not part of this container or no handles are used
+         */
+        GLuint64 bindlessHandle(const ghoul::opengl::Texture* texture) const;
+
         /**
          * \return the number of textures in this TextureContainer
          */
         size_t size() const;
 
     private:
+        void releaseBindlessHandles();
+        void allocateCompressedStorage(ghoul::opengl::Texture& texture,
+            ghoul::opengl::Texture::FilterMode mode);
+
         std::vector<std::unique_ptr<ghoul::opengl::Texture>> _textures;
+        std::unordered_map<const ghoul::opengl::Texture*, GLuint64> _bindlessHandles;
 
         const TileTextureInitData _initData;
         size_t _freeTexture = 0;
         size_t _numTextures;
+        bool _useBindlessTextures;
+    };
+
+
+    /**
+     * The memory budget and the current memory usage of the tiles of all tile providers
+     * belonging to a single layer group.
+     */
+    struct GroupBudget : public properties::PropertyOwner {
+        explicit GroupBudget(const layers::Group& group);
+
+        properties::IntProperty budget;
+        properties::IntProperty allocated;
+        size_t nBytes = 0;
+    };
+
+    enum class ExceededBudget {
+        None = 0,
+        Provider,
+        Group
     };
 
+    /**
+     * Returns which budget, if any, is exceeded when \p nBytes are added to the memory
+     * used by the tiles of the provider with the \p providerID.
+     */
+    ExceededBudget exceededBudget(uint16_t providerID, size_t nBytes) const;
+    GroupBudget* groupBudget(layers::Group::ID group) const;
+    void addTileUsage(uint16_t providerID, size_t nBytes);
+    void removeTileUsage(uint16_t providerID, size_t nBytes);
+    void resetTileUsage();
 
     void createDefaultTextureContainers();
     void assureTextureContainerExists(const TileTextureInitData& initData);
@@ -154,15 +278,41 @@ private:
         TextureContainerTileCache
     >;
 
+    struct PendingUpload {
+        RawTile rawTile;
+        uint64_t lastRequestFrame = 0;
+    };
+
     TextureContainerMap _textureContainerMap;
+    std::unordered_map<ProviderTileKey, PendingUpload, ProviderTileHasher>
+        _pendingUploads;
     size_t _numTextureBytesAllocatedOnCPU;
+    uint64_t _contentVersion = 0;
+
+    std::unordered_map<uint16_t, ProviderStatistics> _providerStatistics;
+    struct {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        uint64_t nHits = 0;
+        uint64_t nMisses = 0;
+        uint64_t nEvictions = 0;
+    } _statisticsWindow;
 
     // Properties
     properties::IntProperty _cpuAllocatedTileData;
     properties::IntProperty _gpuAllocatedTileData;
+    // The tile cache is shared between all globes and is only attributed to the module
+    MemoryTracker::Allocation _cpuMemory;
+    MemoryTracker::Allocation _gpuMemory;
+    properties::IntProperty _numPendingUploads;
     properties::IntProperty _tileCacheSize;
     properties::TriggerProperty _applyTileCacheSize;
     properties::TriggerProperty _clearTileCache;
+    properties::BoolProperty _useBindlessTextures;
+    properties::FloatProperty _hitRate;
+    properties::FloatProperty _evictionsPerSecond;
+
+    properties::PropertyOwner _budgetsOwner;
+    std::vector<std::unique_ptr<GroupBudget>> _groupBudgets;
 };
 
 } // namespace openspace::globebrowsing::cache
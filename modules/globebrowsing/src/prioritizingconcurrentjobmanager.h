@@ -25,9 +25,13 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___PRIORITIZING_CONCURRENT_JOB_MANAGER___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___PRIORITIZING_CONCURRENT_JOB_MANAGER___H__
 
-#include <modules/globebrowsing/src/lruthreadpool.h>
-#include <openspace/util/concurrentqueue.h>
+#include <modules/globebrowsing/src/tileioscheduler.h>
+#include <openspace/util/mpmcqueue.h>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace openspace { template <typename T> struct Job; }
 
@@ -35,20 +39,43 @@ namespace openspace::globebrowsing {
 
 /**
  * Concurrent job manager which prioritizes which jobs to work on depending on which ones
- * were enqueued latest. The class is templated both on the job type and the key type
- * which is used to identify jobs. In case a job need to be explicitly ended. It can be
- * identified using its key.
+ * were enqueued latest, or by explicit priorities if those are provided. The jobs are
+ * executed by a `TileIOScheduler` that is shared with other job managers. The class is
+ * templated both on the job type and the key type which is used to identify jobs. In case
+ * a job need to be explicitly ended. It can be identified using its key.
  */
 template<typename P, typename KeyType>
 class PrioritizingConcurrentJobManager {
 public:
-    PrioritizingConcurrentJobManager(LRUThreadPool<KeyType> pool);
+    /**
+     * \param scheduler The scheduler that executes the jobs, which has to outlive this
+     *        job manager
+     * \param maxConcurrentJobs The maximum number of jobs of this manager that are
+     *        executed at the same time
+     */
+    PrioritizingConcurrentJobManager(TileIOScheduler& scheduler,
+        size_t maxConcurrentJobs);
+
+    /**
+     * Removes all jobs that have not been started from the scheduler and waits for the
+     * ones that are currently executed.
+     */
+    ~PrioritizingConcurrentJobManager();
 
     /**
      * Enqueues a job which is identified using a given key.
      */
     void enqueueJob(std::shared_ptr<Job<P>> job, KeyType key);
 
+    /**
+     * Enqueues a job with the lowest priority, which is only executed once all other
+     * enqueued jobs have been started. The job is ignored if the queue is full or if a
+     * job with the same key is already enqueued.
+     *
+     * \return `true` if the job was enqueued
+     */
+    bool enqueueLowPriorityJob(std::shared_ptr<Job<P>> job, KeyType key);
+
     /**
      * The keys returned by this function have been popped from the queue and corresponds
      * to jobs that will not be executed and therefore marked as unfinished. Calling this
@@ -68,6 +95,14 @@ public:
      */
     bool touch(KeyType key);
 
+    /**
+     * Replaces the priorities of the enqueued jobs, where a higher value means that the
+     * job is executed earlier. Jobs that are not part of \p priorities have a priority
+     * of 0 and jobs with the same priority are executed in the order in which they were
+     * enqueued, most recent first. An empty map reverts to only using the enqueue order.
+     */
+    void setPriorities(std::unordered_map<KeyType, float> priorities);
+
     /**
      * Clear all enqueued jobs. Can not end jobs that workers are currently handling.
      * Therefore it is not safe to assume that there will be no finished jobs after
@@ -80,13 +115,33 @@ public:
      */
     std::shared_ptr<Job<P>> popFinishedJob();
 
+    /**
+     * Removes all jobs that have been finished so far. The workers can keep finishing
+     * jobs while this function is running without having to wait for it.
+     *
+     * \return All jobs that were finished
+     */
+    std::vector<std::shared_ptr<Job<P>>> popFinishedJobs();
+
     size_t numFinishedJobs() const;
 
 private:
-    ConcurrentQueue<std::shared_ptr<Job<P>>> _finishedJobs;
-    std::mutex _finishedJobsMutex;
-    /// An LRU thread pool is used since the jobs can be bumped and hence prioritized
-    LRUThreadPool<KeyType> _threadPool;
+    /// Called by the workers to hand a job to the thread that pops the finished jobs
+    void pushFinishedJob(std::shared_ptr<Job<P>> job);
+
+    /// The number of finished jobs that can be handed over without taking a lock
+    static constexpr size_t FinishedJobsCapacity = 256;
+
+    MpmcQueue<std::shared_ptr<Job<P>>> _finishedJobs{ FinishedJobsCapacity };
+
+    // If the finished jobs are not popped for a while, for example because the layer is
+    // disabled, the jobs that no longer fit into the queue are stored here instead so
+    // that the workers never have to wait for the consumer
+    std::vector<std::shared_ptr<Job<P>>> _overflowJobs;
+    std::atomic<size_t> _nOverflowJobs = 0;
+    mutable std::mutex _overflowJobsMutex;
+    TileIOScheduler& _scheduler;
+    TileIOScheduler::ClientId _clientId;
 };
 
 } // namespace openspace::globebrowsing
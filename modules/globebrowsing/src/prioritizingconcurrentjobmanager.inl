@@ -23,60 +23,148 @@
  ****************************************************************************************/
 
 #include <ghoul/misc/assert.h>
+#include <iterator>
+#include <thread>
 
 namespace openspace::globebrowsing {
 
 template <typename P, typename KeyType>
 PrioritizingConcurrentJobManager<P, KeyType>::PrioritizingConcurrentJobManager(
-                                                              LRUThreadPool<KeyType> pool)
-    : _threadPool(std::move(pool))
+                                                              TileIOScheduler& scheduler,
+                                                                 size_t maxConcurrentJobs)
+    : _scheduler(scheduler)
+    , _clientId(scheduler.addClient(maxConcurrentJobs))
 {}
 
+template <typename P, typename KeyType>
+PrioritizingConcurrentJobManager<P, KeyType>::~PrioritizingConcurrentJobManager() {
+    // The jobs of this client refer to this object, so none of them must be running
+    // anymore once we return
+    _scheduler.removeClient(_clientId);
+}
+
 template <typename P, typename KeyType>
 void PrioritizingConcurrentJobManager<P, KeyType>::enqueueJob(std::shared_ptr<Job<P>> job,
                                                               KeyType key)
 {
-    _threadPool.enqueue([this, job]() {
+    _scheduler.enqueue(_clientId, static_cast<TileIOScheduler::Key>(key), [this, job]() {
         job->execute();
-        std::lock_guard lock(_finishedJobsMutex);
-        _finishedJobs.push(job);
-    }, key);
+        pushFinishedJob(job);
+    });
+}
+
+template <typename P, typename KeyType>
+bool PrioritizingConcurrentJobManager<P, KeyType>::enqueueLowPriorityJob(
+                                                              std::shared_ptr<Job<P>> job,
+                                                                              KeyType key)
+{
+    return _scheduler.enqueueLowPriority(
+        _clientId,
+        static_cast<TileIOScheduler::Key>(key),
+        [this, job]() {
+            job->execute();
+            pushFinishedJob(job);
+        }
+    );
 }
 
 template <typename P, typename KeyType>
 std::vector<KeyType>
 PrioritizingConcurrentJobManager<P, KeyType>::keysToUnfinishedJobs() {
-    return _threadPool.getUnqueuedTasksKeys();
+    const std::vector<TileIOScheduler::Key> keys = _scheduler.popUnqueuedJobs(_clientId);
+    return std::vector<KeyType>(keys.begin(), keys.end());
 }
 
 template <typename P, typename KeyType>
 std::vector<KeyType>
 PrioritizingConcurrentJobManager<P, KeyType>::keysToEnqueuedJobs() {
-    return _threadPool.getQueuedTasksKeys();
+    using Key = TileIOScheduler::Key;
+    const std::vector<Key> keys = _scheduler.clearEnqueuedJobs(_clientId);
+    return std::vector<KeyType>(keys.begin(), keys.end());
 }
 
 template <typename P, typename KeyType>
 bool PrioritizingConcurrentJobManager<P, KeyType>::touch(KeyType key) {
-    return _threadPool.touch(key);
+    return _scheduler.touch(_clientId, static_cast<TileIOScheduler::Key>(key));
+}
+
+template <typename P, typename KeyType>
+void PrioritizingConcurrentJobManager<P, KeyType>::setPriorities(
+                                            std::unordered_map<KeyType, float> priorities)
+{
+    std::unordered_map<TileIOScheduler::Key, float> p;
+    p.reserve(priorities.size());
+    for (const auto& [key, priority] : priorities) {
+        p[static_cast<TileIOScheduler::Key>(key)] = priority;
+    }
+    _scheduler.setPriorities(_clientId, std::move(p));
 }
 
 template <typename P, typename KeyType>
 void PrioritizingConcurrentJobManager<P, KeyType>::clearEnqueuedJobs() {
-    _threadPool.clearEnqueuedTasks();
+    _scheduler.clearEnqueuedJobs(_clientId);
 }
 
 template <typename P, typename KeyType>
 std::shared_ptr<Job<P>> PrioritizingConcurrentJobManager<P, KeyType>::popFinishedJob() {
-    ghoul_assert(!_finishedJobs.empty(), "There is no finished job to pop");
+    ghoul_assert(numFinishedJobs() > 0, "There is no finished job to pop");
 
-    std::lock_guard lock(_finishedJobsMutex);
-    std::shared_ptr<Job<P>> result = _finishedJobs.pop();
-    return result;
+    while (true) {
+        std::optional<std::shared_ptr<Job<P>>> job = _finishedJobs.tryPop();
+        if (job) {
+            return std::move(*job);
+        }
+
+        {
+            std::lock_guard lock(_overflowJobsMutex);
+            if (!_overflowJobs.empty()) {
+                std::shared_ptr<Job<P>> result = std::move(_overflowJobs.back());
+                _overflowJobs.pop_back();
+                _nOverflowJobs = _overflowJobs.size();
+                return result;
+            }
+        }
+
+        // A worker has claimed a place in the queue, which is counted as a finished job,
+        // but has not finished writing the job into it yet
+        std::this_thread::yield();
+    }
+}
+
+template <typename P, typename KeyType>
+std::vector<std::shared_ptr<Job<P>>>
+PrioritizingConcurrentJobManager<P, KeyType>::popFinishedJobs()
+{
+    std::vector<std::shared_ptr<Job<P>>> jobs;
+    _finishedJobs.popAll(jobs);
+
+    if (_nOverflowJobs > 0) {
+        std::lock_guard lock(_overflowJobsMutex);
+        jobs.insert(
+            jobs.end(),
+            std::make_move_iterator(_overflowJobs.begin()),
+            std::make_move_iterator(_overflowJobs.end())
+        );
+        _overflowJobs.clear();
+        _nOverflowJobs = 0;
+    }
+    return jobs;
 }
 
 template <typename P, typename KeyType>
 size_t PrioritizingConcurrentJobManager<P, KeyType>::numFinishedJobs() const {
-    return _finishedJobs.size();
+    return _finishedJobs.size() + _nOverflowJobs;
+}
+
+template <typename P, typename KeyType>
+void PrioritizingConcurrentJobManager<P, KeyType>::pushFinishedJob(
+                                                              std::shared_ptr<Job<P>> job)
+{
+    if (!_finishedJobs.tryPush(job)) {
+        std::lock_guard lock(_overflowJobsMutex);
+        _overflowJobs.push_back(std::move(job));
+        _nOverflowJobs = _overflowJobs.size();
+    }
 }
 
 } // namespace openspace::globebrowsing
@@ -54,7 +54,17 @@
 #include <algorithm>
 #include <fstream>
 #include <filesystem>
+#include <limits>
 #include <system_error>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLOBEBROWSING_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define GLOBEBROWSING_SIMD_NEON
+#include <arm_neon.h>
+#endif
 
 namespace openspace::globebrowsing {
 
@@ -68,30 +78,6 @@ enum class Side {
     Bottom
 };
 
-float interpretFloat(GLenum glType, const std::byte* src) {
-    switch (glType) {
-        case GL_UNSIGNED_BYTE:
-            return static_cast<float>(*reinterpret_cast<const GLubyte*>(src));
-        case GL_UNSIGNED_SHORT:
-            return static_cast<float>(*reinterpret_cast<const GLushort*>(src));
-        case GL_SHORT:
-            return static_cast<float>(*reinterpret_cast<const GLshort*>(src));
-        case GL_UNSIGNED_INT:
-            return static_cast<float>(*reinterpret_cast<const GLuint*>(src));
-        case GL_INT:
-            return static_cast<float>(*reinterpret_cast<const GLint*>(src));
-        case GL_HALF_FLOAT:
-            return static_cast<float>(*reinterpret_cast<const GLhalf*>(src));
-        case GL_FLOAT:
-            return static_cast<float>(*reinterpret_cast<const GLfloat*>(src));
-        case GL_DOUBLE:
-            return static_cast<float>(*reinterpret_cast<const GLdouble*>(src));
-        default:
-            ghoul_assert(false, "Unknown data type");
-            throw ghoul::MissingCaseException();
-    }
-}
-
 GDALDataType toGDALDataType(GLenum glType) {
     switch (glType) {
         case GL_UNSIGNED_BYTE:
@@ -219,6 +205,248 @@ PixelRegion highestResPixelRegion(const GeodeticPatch& geodeticPatch,
     return region;
 }
 
+#if defined(GLOBEBROWSING_SIMD_SSE2)
+using FloatVec = __m128;
+using MaskVec = __m128;
+
+FloatVec splat(float v) {
+    return _mm_set1_ps(v);
+}
+
+FloatVec loadAsFloat(const GLfloat* src) {
+    return _mm_loadu_ps(src);
+}
+
+FloatVec loadAsFloat(const GLushort* src) {
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, _mm_setzero_si128()));
+}
+
+FloatVec loadAsFloat(const GLshort* src) {
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    // Moving each value into the upper half of a 32-bit lane and shifting it back
+    // extends the sign
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+}
+
+void store(GLfloat* dst, FloatVec v) {
+    _mm_storeu_ps(dst, v);
+}
+
+MaskVec isValid(FloatVec v, FloatVec noDataValue) {
+    // NaN is the only value that is unordered with respect to itself
+    return _mm_andnot_ps(_mm_cmpeq_ps(v, noDataValue), _mm_cmpord_ps(v, v));
+}
+
+MaskVec emptyMask() {
+    return _mm_setzero_ps();
+}
+
+MaskVec addInvalid(MaskVec invalid, MaskVec valid) {
+    const MaskVec allSet = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    return _mm_or_ps(invalid, _mm_xor_ps(valid, allSet));
+}
+
+FloatVec select(MaskVec mask, FloatVec a, FloatVec b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+FloatVec minimum(FloatVec a, FloatVec b) {
+    return _mm_min_ps(a, b);
+}
+
+FloatVec maximum(FloatVec a, FloatVec b) {
+    return _mm_max_ps(a, b);
+}
+
+std::array<float, 4> lanes(FloatVec v) {
+    std::array<float, 4> res;
+    _mm_storeu_ps(res.data(), v);
+    return res;
+}
+
+std::array<bool, 4> maskLanes(MaskVec m) {
+    const int bits = _mm_movemask_ps(m);
+    return { (bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0, (bits & 8) != 0 };
+}
+#elif defined(GLOBEBROWSING_SIMD_NEON)
+using FloatVec = float32x4_t;
+using MaskVec = uint32x4_t;
+
+FloatVec splat(float v) {
+    return vdupq_n_f32(v);
+}
+
+FloatVec loadAsFloat(const GLfloat* src) {
+    return vld1q_f32(src);
+}
+
+FloatVec loadAsFloat(const GLushort* src) {
+    return vcvtq_f32_u32(vmovl_u16(vld1_u16(src)));
+}
+
+FloatVec loadAsFloat(const GLshort* src) {
+    return vcvtq_f32_s32(vmovl_s16(vld1_s16(src)));
+}
+
+void store(GLfloat* dst, FloatVec v) {
+    vst1q_f32(dst, v);
+}
+
+MaskVec isValid(FloatVec v, FloatVec noDataValue) {
+    // NaN is the only value that does not compare equal to itself
+    return vbicq_u32(vceqq_f32(v, v), vceqq_f32(v, noDataValue));
+}
+
+MaskVec emptyMask() {
+    return vdupq_n_u32(0);
+}
+
+MaskVec addInvalid(MaskVec invalid, MaskVec valid) {
+    return vorrq_u32(invalid, vmvnq_u32(valid));
+}
+
+FloatVec select(MaskVec mask, FloatVec a, FloatVec b) {
+    return vbslq_f32(mask, a, b);
+}
+
+FloatVec minimum(FloatVec a, FloatVec b) {
+    return vminq_f32(a, b);
+}
+
+FloatVec maximum(FloatVec a, FloatVec b) {
+    return vmaxq_f32(a, b);
+}
+
+std::array<float, 4> lanes(FloatVec v) {
+    std::array<float, 4> res;
+    vst1q_f32(res.data(), v);
+    return res;
+}
+
+std::array<bool, 4> maskLanes(MaskVec m) {
+    std::array<uint32_t, 4> bits;
+    vst1q_u32(bits.data(), m);
+    return { bits[0] != 0, bits[1] != 0, bits[2] != 0, bits[3] != 0 };
+}
+#endif
+
+/**
+ * Scans the \p nValues interleaved values of a tile with \p NRasters rasters, four
+ * values at a time, and returns the number of values that have been processed. The
+ * remaining values have to be handled by `scanValues`. As four is a multiple of the
+ * number of rasters, each lane of the vectors always contains the same raster. Returns 0
+ * if there is no vectorized implementation for the data type or the number of rasters.
+ */
+template <typename T, int NRasters>
+size_t scanValuesVectorized([[maybe_unused]] T* values, [[maybe_unused]] size_t nValues,
+                            [[maybe_unused]] float noDataValue,
+                            [[maybe_unused]] TileMetaData& metaData)
+{
+#if defined(GLOBEBROWSING_SIMD_SSE2) || defined(GLOBEBROWSING_SIMD_NEON)
+    constexpr bool IsSupportedType = std::is_same_v<T, GLfloat> ||
+        std::is_same_v<T, GLushort> || std::is_same_v<T, GLshort>;
+    if constexpr (IsSupportedType && NRasters != 3) {
+        const FloatVec noData = splat(noDataValue);
+        const FloatVec highest = splat(std::numeric_limits<float>::max());
+        const FloatVec lowest = splat(std::numeric_limits<float>::lowest());
+
+        FloatVec minValues = highest;
+        FloatVec maxValues = lowest;
+        MaskVec invalid = emptyMask();
+
+        size_t i = 0;
+        for (; i + 4 <= nValues; i += 4) {
+            const FloatVec v = loadAsFloat(values + i);
+            const MaskVec valid = isValid(v, noData);
+            invalid = addInvalid(invalid, valid);
+            minValues = minimum(minValues, select(valid, v, highest));
+            maxValues = maximum(maxValues, select(valid, v, lowest));
+            if constexpr (std::is_same_v<T, GLfloat>) {
+                store(values + i, select(valid, v, lowest));
+            }
+        }
+
+        const std::array<float, 4> mins = lanes(minValues);
+        const std::array<float, 4> maxs = lanes(maxValues);
+        const std::array<bool, 4> missing = maskLanes(invalid);
+        for (int lane = 0; lane < 4; lane++) {
+            const int raster = lane % NRasters;
+            metaData.minValues[raster] = std::min(metaData.minValues[raster], mins[lane]);
+            metaData.maxValues[raster] = std::max(metaData.maxValues[raster], maxs[lane]);
+            metaData.hasMissingData[raster] =
+                metaData.hasMissingData[raster] || missing[lane];
+        }
+        return i;
+    }
+#endif // GLOBEBROWSING_SIMD_SSE2 || GLOBEBROWSING_SIMD_NEON
+    return 0;
+}
+
+/**
+ * Scans the interleaved values in the range [\p begin, \p end) of a tile with
+ * \p NRasters rasters. The minimum and maximum of all values that are neither NaN nor
+ * the \p noDataValue are accumulated, as is whether any of them are missing. Missing
+ * floating point values are overwritten with the lowest representable value.
+ */
+template <typename T, int NRasters>
+void scanValues(T* values, size_t begin, size_t end, float noDataValue,
+                TileMetaData& metaData)
+{
+    for (size_t i = begin; i < end; i += NRasters) {
+        for (int raster = 0; raster < NRasters; raster++) {
+            const float v = static_cast<float>(values[i + raster]);
+            if (v != noDataValue && v == v) {
+                metaData.maxValues[raster] = std::max(v, metaData.maxValues[raster]);
+                metaData.minValues[raster] = std::min(v, metaData.minValues[raster]);
+            }
+            else {
+                metaData.hasMissingData[raster] = true;
+                if constexpr (std::is_floating_point_v<T>) {
+                    values[i + raster] = std::numeric_limits<T>::lowest();
+                }
+            }
+        }
+    }
+}
+
+template <typename T, int NRasters>
+void scanTileValues(std::byte* data, size_t nValues, float noDataValue,
+                    TileMetaData& metaData)
+{
+    T* values = reinterpret_cast<T*>(data);
+    const size_t nProcessed = scanValuesVectorized<T, NRasters>(
+        values,
+        nValues,
+        noDataValue,
+        metaData
+    );
+    scanValues<T, NRasters>(values, nProcessed, nValues, noDataValue, metaData);
+}
+
+template <typename T>
+void scanTileValues(std::byte* data, size_t nValues, size_t nRasters, float noDataValue,
+                    TileMetaData& metaData)
+{
+    switch (nRasters) {
+        case 1:
+            scanTileValues<T, 1>(data, nValues, noDataValue, metaData);
+            break;
+        case 2:
+            scanTileValues<T, 2>(data, nValues, noDataValue, metaData);
+            break;
+        case 3:
+            scanTileValues<T, 3>(data, nValues, noDataValue, metaData);
+            break;
+        case 4:
+            scanTileValues<T, 4>(data, nValues, noDataValue, metaData);
+            break;
+        default:
+            ghoul_assert(false, "Unexpected number of rasters");
+            throw ghoul::MissingCaseException();
+    }
+}
+
 RawTile::ReadError postProcessErrorCheck(const RawTile& rawTile,
                                          [[maybe_unused]] size_t nRasters,
                                          float noDataValue)
@@ -257,10 +485,7 @@ RawTileDataReader::RawTileDataReader(std::string filePath,
 
 RawTileDataReader::~RawTileDataReader() {
     const std::lock_guard lockGuard(_datasetLock);
-    if (_dataset) {
-        GDALClose(_dataset);
-        _dataset = nullptr;
-    }
+    closeDatasets();
 }
 
 std::optional<std::string> RawTileDataReader::mrfCache() {
@@ -403,6 +628,8 @@ void RawTileDataReader::initialize() {
             ));
         }
     }
+    _datasetContent = content;
+    _freeDatasets = { _dataset };
 
     // Assume all raster bands have the same data type
     _rasterCount = _dataset->GetRasterCount();
@@ -455,14 +682,59 @@ void RawTileDataReader::initialize() {
 void RawTileDataReader::reset() {
     const std::lock_guard lockGuard(_datasetLock);
     _maxChunkLevel = -1;
+    closeDatasets();
+    initialize();
+}
+
+void RawTileDataReader::closeDatasets() {
+    for (GDALDataset* dataset : _additionalDatasets) {
+        GDALClose(dataset);
+    }
+    _additionalDatasets.clear();
+    _freeDatasets.clear();
+
     if (_dataset) {
         GDALClose(_dataset);
         _dataset = nullptr;
     }
-    initialize();
 }
 
-RawTile::ReadError RawTileDataReader::rasterRead(int rasterBand,
+GDALDataset* RawTileDataReader::acquireDataset() const {
+    {
+        const std::lock_guard lockGuard(_datasetLock);
+        if (!_freeDatasets.empty()) {
+            GDALDataset* dataset = _freeDatasets.back();
+            _freeDatasets.pop_back();
+            return dataset;
+        }
+    }
+
+    // All handles are currently used by other threads, so we open another one. This is
+    // done without holding the lock as opening a remote dataset might have to contact
+    // the server, which would otherwise block all other reads in the meantime
+    ZoneScopedN("GDALOpen");
+    GDALDataset* dataset = static_cast<GDALDataset*>(
+        GDALOpen(_datasetContent.c_str(), GA_ReadOnly)
+    );
+    if (!dataset) {
+        LWARNING(std::format(
+            "Failed to open additional handle to dataset '{}'. GDAL error: {}",
+            _datasetFilePath, CPLGetLastErrorMsg()
+        ));
+        return nullptr;
+    }
+
+    const std::lock_guard lockGuard(_datasetLock);
+    _additionalDatasets.push_back(dataset);
+    return dataset;
+}
+
+void RawTileDataReader::releaseDataset(GDALDataset* dataset) const {
+    const std::lock_guard lockGuard(_datasetLock);
+    _freeDatasets.push_back(dataset);
+}
+
+RawTile::ReadError RawTileDataReader::rasterRead(GDALDataset& dataset, int rasterBand,
                                                  const IODescription& io,
                                                  char* dataDestination) const
 {
@@ -489,7 +761,7 @@ RawTile::ReadError RawTileDataReader::rasterRead(int rasterBand,
     dataDest -= io.write.region.start.y * io.write.bytesPerLine;
     dataDest += io.write.region.start.x * _initData.bytesPerPixel;
 
-    GDALRasterBand* gdalRasterBand = _dataset->GetRasterBand(rasterBand);
+    GDALRasterBand* gdalRasterBand = dataset.GetRasterBand(rasterBand);
     CPLErr readError = CE_Failure;
     readError = gdalRasterBand->RasterIO(
         GF_Read,
@@ -516,6 +788,14 @@ RawTile::ReadError RawTileDataReader::rasterRead(int rasterBand,
     }
 }
 
+const std::string& RawTileDataReader::datasetFilePath() const {
+    return _datasetFilePath;
+}
+
+const TileTextureInitData& RawTileDataReader::textureInitData() const {
+    return _initData;
+}
+
 RawTile RawTileDataReader::readTileData(TileIndex tileIndex) const {
     const size_t numBytes = _initData.totalNumBytes;
 
@@ -525,7 +805,15 @@ RawTile RawTileDataReader::readTileData(TileIndex tileIndex) const {
 
     IODescription io = ioDescription(tileIndex);
     RawTile::ReadError worstError = RawTile::ReadError::None;
-    readImageData(io, worstError, reinterpret_cast<char*>(rawTile.imageData.get()));
+    GDALDataset* dataset = acquireDataset();
+    if (dataset) {
+        char* dest = reinterpret_cast<char*>(rawTile.imageData.get());
+        readImageData(*dataset, io, worstError, dest);
+        releaseDataset(dataset);
+    }
+    else {
+        worstError = RawTile::ReadError::Failure;
+    }
 
     rawTile.error = worstError;
     rawTile.tileIndex = std::move(tileIndex);
@@ -542,7 +830,8 @@ RawTile RawTileDataReader::readTileData(TileIndex tileIndex) const {
     return rawTile;
 }
 
-void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& worstError,
+void RawTileDataReader::readImageData(GDALDataset& dataset, IODescription& io,
+                                      RawTile::ReadError& worstError,
                                       char* imageDataDest) const
 {
     // Only read the minimum number of rasters
@@ -551,7 +840,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
     switch (_initData.ghoulTextureFormat) {
         case ghoul::opengl::Texture::Format::Red: {
             char* dest = imageDataDest;
-            const RawTile::ReadError err = rasterRead(1, io, dest);
+            const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
             worstError = std::max(worstError, err);
             break;
         }
@@ -563,7 +852,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
@@ -572,12 +861,12 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum);
-                const RawTile::ReadError err = rasterRead(2, io, dest);
+                const RawTile::ReadError err = rasterRead(dataset, 2, io, dest);
                 worstError = std::max(worstError, err);
             }
             else { // Three or more rasters
@@ -585,7 +874,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(i + 1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, i + 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
@@ -598,7 +887,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
@@ -607,12 +896,12 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum);
-                const RawTile::ReadError err = rasterRead(2, io, dest);
+                const RawTile::ReadError err = rasterRead(dataset, 2, io, dest);
                 worstError = std::max(worstError, err);
             }
             else { // Three or more rasters
@@ -620,14 +909,14 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(3 - i, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 3 - i, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
             if (nReadRasters > 3) { // Alpha channel exists
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum);
-                const RawTile::ReadError err = rasterRead(4, io, dest);
+                const RawTile::ReadError err = rasterRead(dataset, 4, io, dest);
                 worstError = std::max(worstError, err);
             }
             break;
@@ -677,7 +966,7 @@ glm::ivec2 RawTileDataReader::fullPixelSize() const {
 TileMetaData RawTileDataReader::tileMetaData(RawTile& rawTile,
                                              const PixelRegion& region) const
 {
-    const size_t bytesPerLine = _initData.bytesPerPixel * region.numPixels.x;
+    ZoneScoped;
 
     TileMetaData ppData;
     ghoul_assert(_initData.nRasters <= 4, "Unexpected number of rasters");
@@ -687,41 +976,46 @@ TileMetaData RawTileDataReader::tileMetaData(RawTile& rawTile,
     std::fill(ppData.minValues.begin(), ppData.minValues.end(), FLT_MAX);
     std::fill(ppData.hasMissingData.begin(), ppData.hasMissingData.end(), false);
 
-    bool allIsMissing = true;
-    for (int y = 0; y < region.numPixels.y; ++y) {
-        const size_t yi =
-            (static_cast<unsigned long long>(region.numPixels.y) - 1 - y) * bytesPerLine;
-        size_t i = 0;
-        for (int x = 0; x < region.numPixels.x; ++x) {
-            for (size_t raster = 0; raster < _initData.nRasters; ++raster) {
-                const float noDataValue = noDataValueAsFloat();
-                const float val = interpretFloat(
-                    _initData.glType,
-                    &(rawTile.imageData.get()[yi + i])
-                );
-                if (val != noDataValue && val == val) {
-                    ppData.maxValues[raster] = std::max(
-                        val,
-                        ppData.maxValues[raster]
-                    );
-                    ppData.minValues[raster] = std::min(
-                        val,
-                        ppData.minValues[raster]
-                    );
-                    allIsMissing = false;
-                }
-                else {
-                    ppData.hasMissingData[raster] = true;
-                    float& floatToRewrite = reinterpret_cast<float&>(
-                        rawTile.imageData[yi + i]
-                    );
-                    floatToRewrite = -std::numeric_limits<float>::max();
-                }
-                i += _initData.bytesPerDatum;
-            }
-        }
+    // The order in which the values are visited does not matter for the result, so we
+    // make a single pass over the whole buffer in memory order
+    const size_t nValues = static_cast<size_t>(region.numPixels.x) *
+        static_cast<size_t>(region.numPixels.y) * _initData.nRasters;
+    std::byte* data = rawTile.imageData.get();
+    const float noDataValue = noDataValueAsFloat();
+    const size_t nRasters = _initData.nRasters;
+    switch (_initData.glType) {
+        case GL_UNSIGNED_BYTE:
+            scanTileValues<GLubyte>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            scanTileValues<GLushort>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        case GL_SHORT:
+            scanTileValues<GLshort>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        case GL_UNSIGNED_INT:
+            scanTileValues<GLuint>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        case GL_INT:
+            scanTileValues<GLint>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        case GL_FLOAT:
+            scanTileValues<GLfloat>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        case GL_DOUBLE:
+            scanTileValues<GLdouble>(data, nValues, nRasters, noDataValue, ppData);
+            break;
+        default:
+            ghoul_assert(false, "Unknown data type");
+            throw ghoul::MissingCaseException();
     }
 
+    // As long as no valid value has been found, the minimum is larger than the maximum
+    bool allIsMissing = true;
+    for (size_t raster = 0; raster < nRasters; raster++) {
+        allIsMissing &= ppData.minValues[raster] > ppData.maxValues[raster];
+    }
     if (allIsMissing) {
         rawTile.error = RawTile::ReadError::Failure;
     }
@@ -32,6 +32,7 @@
 #include <ghoul/misc/boolean.h>
 #include <string>
 #include <mutex>
+#include <vector>
 #include <gdal.h>
 
 class GDALDataset;
@@ -69,23 +70,41 @@ public:
     const TileDepthTransform& depthTransform() const;
     glm::ivec2 fullPixelSize() const;
 
+    const std::string& datasetFilePath() const;
+    const TileTextureInitData& textureInitData() const;
+
 private:
     std::optional<std::string> mrfCache();
 
     void initialize();
 
-    RawTile::ReadError rasterRead(int rasterBand, const IODescription& io,
-        char* dataDestination) const;
+    RawTile::ReadError rasterRead(GDALDataset& dataset, int rasterBand,
+        const IODescription& io, char* dataDestination) const;
+
+    void readImageData(GDALDataset& dataset, IODescription& io,
+        RawTile::ReadError& worstError, char* imageDataDest) const;
 
-    void readImageData(IODescription& io, RawTile::ReadError& worstError,
-        char* imageDataDest) const;
+    /**
+     * Returns a handle to the dataset that is not used by any other thread, opening a
+     * new handle if all existing ones are in use. The handle has to be returned with
+     * #releaseDataset after the read has finished.
+     */
+    GDALDataset* acquireDataset() const;
+    void releaseDataset(GDALDataset* dataset) const;
+    void closeDatasets();
 
     IODescription ioDescription(const TileIndex& tileIndex) const;
 
     TileMetaData tileMetaData(RawTile& rawTile, const PixelRegion& region) const;
 
     const std::string _datasetFilePath;
+    /// The path that is opened by GDAL, which might point to the MRF cache
+    std::string _datasetContent;
     GDALDataset* _dataset = nullptr;
+    // GDAL datasets must not be accessed from more than one thread at a time, so each
+    // concurrent read uses its own handle to the dataset
+    mutable std::vector<GDALDataset*> _freeDatasets;
+    mutable std::vector<GDALDataset*> _additionalDatasets;
 
     // Dataset parameters
     int _rasterCount;
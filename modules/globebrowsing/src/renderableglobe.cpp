@@ -25,21 +25,26 @@
 #include <modules/globebrowsing/src/renderableglobe.h>
 
 #include <modules/debugging/rendering/debugrenderer.h>
+#include <modules/globebrowsing/globebrowsingmodule.h>
 #include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/gpulayergroup.h>
 #include <modules/globebrowsing/src/layer.h>
 #include <modules/globebrowsing/src/layergroup.h>
+#include <modules/globebrowsing/src/memoryawaretilecache.h>
 #include <modules/globebrowsing/src/tileprovider/tileprovider.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
 #include <openspace/interaction/sessionrecordinghandler.h>
+#include <openspace/navigation/navigationhandler.h>
+#include <openspace/navigation/pathnavigator.h>
 #include <openspace/query/query.h>
+#include <openspace/rendering/eclipseshadows.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scenegraphnode.h>
 #include <openspace/scene/scene.h>
 #include <openspace/util/memorymanager.h>
-#include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -51,8 +56,12 @@
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <numeric>
 #include <queue>
+#include <thread>
 #include <vector>
 
 #if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
@@ -71,17 +80,6 @@ namespace {
     constexpr bool LimitLevelByAvailableData = true;
     constexpr bool PreformHorizonCulling = true;
 
-    // Shadow structure
-    struct ShadowRenderingStruct {
-        double xu = 0.0;
-        double xp = 0.0;
-        double rs = 0.0;
-        double rc = 0.0;
-        glm::dvec3 sourceCasterVec = glm::dvec3(0.0);
-        glm::dvec3 casterPositionVec = glm::dvec3(0.0);
-        bool isShadowing = false;
-    };
-
     const openspace::globebrowsing::AABB3 CullingFrustum{
         glm::vec3(-1.f, -1.f, 0.f),
         glm::vec3( 1.f,  1.f, 1e35f)
@@ -97,8 +95,24 @@ namespace {
     // time being.  --abock  2018-10-30
     constexpr int DefaultSkirtedGridSegments = 64;
     constexpr int UnknownDesiredLevel = -1;
+    // The minimum number of chunks that each thread evaluates when updating the chunk
+    // tree. Smaller trees are not worth the overhead of starting additional threads
+    constexpr size_t MinChunksPerThread = 256;
+
+    // The number of levels, ending at the level predicted for the future camera
+    // position, for which tiles are prefetched
+    constexpr int PrefetchLevelRange = 3;
+    // If the camera moves less than this fraction of its altitude during the prefetch
+    // time, the tiles requested by the chunk tree are good enough
+    constexpr double MinRelativePrefetchMotion = 0.01;
     constexpr int DefaultHeightTileResolution = 512;
 
+    // This is an assumption that the height tile has a resolution of 512 * 512
+    // If it does not it will still produce "correct" normals. If the resolution is
+    // higher the shadows will be softer, if it is lower, pixels will be visible.
+    // Since default is 512 this will most likely work fine.
+    constexpr float TileDelta = 1.f / DefaultHeightTileResolution;
+
     const openspace::globebrowsing::GeodeticPatch Coverage =
         openspace::globebrowsing::GeodeticPatch(0, 0, 90, 180);
 
@@ -268,6 +282,62 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseMultiDrawIndirectInfo = {
+        "UseMultiDrawIndirect",
+        "Use Multi-Draw-Indirect",
+        "If enabled, all chunks that are rendered globally and all chunks that are "
+        "rendered locally are each drawn with a single draw call, instead of one draw "
+        "call per chunk. The per-chunk values are uploaded to shader storage buffers "
+        "instead. This requires the 'UseBindlessTextures' setting of the tile cache to "
+        "be enabled, as well as support for the GL_ARB_multi_draw_indirect and "
+        "GL_ARB_shader_storage_buffer_object extensions.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PrefetchTilesInfo = {
+        "PrefetchTiles",
+        "Prefetch tiles",
+        "If enabled, the position of the camera a short time into the future is "
+        "predicted and the tiles that will be needed at that position are requested "
+        "ahead of time with a low priority. For camera paths, the future position is "
+        "known exactly, otherwise it is extrapolated from the current camera motion.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PrefetchTimeInfo = {
+        "PrefetchTime",
+        "Prefetch time",
+        "The time (in seconds) into the future for which the camera position is "
+        "predicted when prefetching tiles.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ScreenSpaceTilePriorityInfo =
+    {
+        "ScreenSpaceTilePriority",
+        "Screen-space tile priority",
+        "If enabled, the tiles that are waiting to be loaded are prioritized by the "
+        "screen area of the visible chunks that need them, where the coarser tiles that "
+        "fill in for missing finer tiles are more important. If disabled, the most "
+        "recently requested tiles are loaded first.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ShareChunkTreeInfo = {
+        "ShareChunkTreeAcrossViews",
+        "Share chunk tree across views",
+        "If enabled, the chunk tree is only split and merged once per frame, against all "
+        "views (eyes and viewports) that rendered the globe in the previous frame, and "
+        "each view only culls the resulting chunks against its own frustum. If "
+        "disabled, the chunk tree is evaluated again for every view.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    bool isMultiDrawIndirectSupported() {
+        return OpenGLCap.isExtensionSupported("GL_ARB_multi_draw_indirect") &&
+               OpenGLCap.isExtensionSupported("GL_ARB_shader_storage_buffer_object");
+    }
+
     struct [[codegen::Dictionary(RenderableGlobe)]] Parameters {
         // The radii for this planet. If only one value is given, all three radii are
         // set to that value.
@@ -294,6 +364,21 @@ namespace {
         // [[codegen::verbatim(OrenNayarRoughnessInfo.description)]]
         std::optional<float> orenNayarRoughness;
 
+        // [[codegen::verbatim(UseMultiDrawIndirectInfo.description)]]
+        std::optional<bool> useMultiDrawIndirect;
+
+        // [[codegen::verbatim(PrefetchTilesInfo.description)]]
+        std::optional<bool> prefetchTiles;
+
+        // [[codegen::verbatim(PrefetchTimeInfo.description)]]
+        std::optional<float> prefetchTime [[codegen::inrange(0.0, 5.0)]];
+
+        // [[codegen::verbatim(ScreenSpaceTilePriorityInfo.description)]]
+        std::optional<bool> screenSpaceTilePriority;
+
+        // [[codegen::verbatim(ShareChunkTreeInfo.description)]]
+        std::optional<bool> shareChunkTreeAcrossViews;
+
         enum class [[codegen::map(openspace::globebrowsing::layers::Group::ID)]] Group {
             HeightLayers,
             ColorLayers,
@@ -601,6 +686,11 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     , _currentLodScaleFactor(CurrentLodScaleFactorInfo, 15.f, 1.f, 50.f)
     , _orenNayarRoughness(OrenNayarRoughnessInfo, 0.f, 0.f, 1.f)
     , _nActiveLayers(NActiveLayersInfo, 0, 0, OpenGLCap.maxTextureUnits() / 3)
+    , _useMultiDrawIndirect(UseMultiDrawIndirectInfo, false)
+    , _prefetchTiles(PrefetchTilesInfo, true)
+    , _prefetchTime(PrefetchTimeInfo, 0.5f, 0.f, 5.f)
+    , _screenSpaceTilePriority(ScreenSpaceTilePriorityInfo, true)
+    , _shareChunkTree(ShareChunkTreeInfo, true)
     , _debugProperties({
         BoolProperty(ShowChunkEdgeInfo, false),
         BoolProperty(LevelProjectedAreaInfo, true),
@@ -726,6 +816,30 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     _nActiveLayers.setReadOnly(true);
     addProperty(_nActiveLayers);
 
+    _useMultiDrawIndirect = p.useMultiDrawIndirect.value_or(_useMultiDrawIndirect);
+    _useMultiDrawIndirect.onChange([this]() {
+        if (_useMultiDrawIndirect && !isMultiDrawIndirectSupported()) {
+            LWARNING("Multi-draw-indirect rendering is not supported by the driver");
+            _useMultiDrawIndirect = false;
+            return;
+        }
+        _shadersNeedRecompilation = true;
+    });
+    addProperty(_useMultiDrawIndirect);
+
+    _prefetchTiles = p.prefetchTiles.value_or(_prefetchTiles);
+    addProperty(_prefetchTiles);
+
+    _prefetchTime = p.prefetchTime.value_or(_prefetchTime);
+    addProperty(_prefetchTime);
+
+    _screenSpaceTilePriority =
+        p.screenSpaceTilePriority.value_or(_screenSpaceTilePriority);
+    addProperty(_screenSpaceTilePriority);
+
+    _shareChunkTree = p.shareChunkTreeAcrossViews.value_or(_shareChunkTree);
+    addProperty(_shareChunkTree);
+
     _debugPropertyOwner.addProperty(_debugProperties.showChunkEdges);
     _debugPropertyOwner.addProperty(_debugProperties.levelByProjectedAreaElseDistance);
     _debugPropertyOwner.addProperty(_debugProperties.resetTileProviders);
@@ -828,6 +942,13 @@ void RenderableGlobe::deinitializeGL() {
 
     _grid.deinitializeGL();
 
+    glDeleteBuffers(1, &_multiDrawIndirect.chunkDataBuffer);
+    glDeleteBuffers(1, &_multiDrawIndirect.chunkTileBuffer);
+    _multiDrawIndirect.chunkDataBuffer = 0;
+    _multiDrawIndirect.chunkTileBuffer = 0;
+    _multiDrawIndirect.chunkDataBinding = nullptr;
+    _multiDrawIndirect.chunkTileBinding = nullptr;
+
     if (_ringsComponent) {
         _ringsComponent->deinitializeGL();
     }
@@ -856,27 +977,40 @@ void RenderableGlobe::render(const RenderData& data, RendererTasks& rendererTask
     const double distance = res * boundingSphere() / tfov;
 
     if ((distanceToCamera < distance) || (_renderAtDistance)) {
+        if (_prefetchTiles) {
+            prefetchTiles(data);
+        }
+
         try {
             if (_shadowComponent && _shadowComponent->isEnabled()) {
-                // Set matrices and other GL states
-                const RenderData lightRenderData(_shadowComponent->begin(data));
+                const bool drawRings = _ringsComponent &&
+                    _ringsComponent->isEnabled() && _ringsComponent->isVisible();
 
-                glDisable(GL_BLEND);
+                // The lowest bit marks whether the rings are part of the depth map, so
+                // that toggling them also causes the depth map to be rendered again
+                const uint64_t casterVersion = _ringsComponent ?
+                    (_ringsComponent->geometryVersion() << 1) | (drawRings ? 1 : 0) :
+                    0;
 
-                // Render from light source point of view
-                renderChunks(lightRenderData, rendererTask, {}, true);
-                if (_ringsComponent && _ringsComponent->isEnabled() &&
-                    _ringsComponent->isVisible())
-                {
-                    _ringsComponent->draw(
-                        lightRenderData,
-                        RingsComponent::RenderPass::GeometryOnly
-                    );
-                }
+                if (_shadowComponent->prepare(data, casterVersion)) {
+                    // Set matrices and other GL states
+                    const RenderData lightRenderData(_shadowComponent->begin(data));
 
-                glEnable(GL_BLEND);
+                    glDisable(GL_BLEND);
 
-                _shadowComponent->end();
+                    // Render from light source point of view
+                    renderChunks(lightRenderData, rendererTask, {}, true);
+                    if (drawRings) {
+                        _ringsComponent->draw(
+                            lightRenderData,
+                            RingsComponent::RenderPass::GeometryOnly
+                        );
+                    }
+
+                    glEnable(GL_BLEND);
+
+                    _shadowComponent->end();
+                }
 
                 // Render again from original point of view
                 renderChunks(data, rendererTask, _shadowComponent->shadowMapData());
@@ -1057,6 +1191,19 @@ const glm::dmat4& RenderableGlobe::modelTransform() const {
     return _cachedModelTransform;
 }
 
+int RenderableGlobe::nRenderedChunks() const {
+    return _nRenderedChunks;
+}
+
+std::optional<std::array<const Chunk*, 2>> RenderableGlobe::currentChunkTree() const {
+    if (!_chunkTreeUpdatedThisFrame ||
+        _viewFrame != global::renderEngine->frameNumber())
+    {
+        return std::nullopt;
+    }
+    return std::array<const Chunk*, 2>{ &_leftRoot, &_rightRoot };
+}
+
 void RenderableGlobe::invalidateShader() {
     _shadersNeedRecompilation = true;
 }
@@ -1090,6 +1237,11 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         _nLayersIsDirty = false;
     }
 
+    GlobeBrowsingModule* module = global::moduleEngine->module<GlobeBrowsingModule>();
+    if (module->tileCache()->useBindlessTextures() != _isUsingBindlessTextures) {
+        _shadersNeedRecompilation = true;
+    }
+
     if (_shadersNeedRecompilation) {
         recompileShaders();
     }
@@ -1143,7 +1295,8 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         for (size_t i = 0; i < layerGroups.size(); i++) {
             _globalRenderer.gpuLayerGroups[i].bind(
                 *_globalRenderer.program,
-                *layerGroups[i]
+                *layerGroups[i],
+                _isUsingBindlessTextures
             );
         }
 
@@ -1165,7 +1318,8 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         for (size_t i = 0; i < layerGroups.size(); i++) {
             _localRenderer.gpuLayerGroups[i].bind(
                 *_localRenderer.program,
-                *layerGroups[i]
+                *layerGroups[i],
+                _isUsingBindlessTextures
             );
         }
 
@@ -1186,14 +1340,57 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         viewTransform;
     const glm::dmat4 mvp = vp * _cachedModelTransform;
 
-    _allChunksAvailable = true;
-    updateChunkTree(_leftRoot, data, mvp);
-    updateChunkTree(_rightRoot, data, mvp);
-    _chunkCornersDirty = false;
-    _iterationsOfAvailableData =
-        (_allChunksAvailable ? _iterationsOfAvailableData + 1 : 0);
-    _iterationsOfUnavailableData =
-        (_allChunksAvailable ? 0 : _iterationsOfUnavailableData + 1);
+    // In stereo and multi-viewport setups the globe is rendered several times per frame.
+    // Instead of splitting and merging the chunk tree for every view, it is evaluated
+    // once against the frustums of all views of the previous frame and every view then
+    // only culls the resulting chunks against its own frustum
+    const uint64_t frame = global::renderEngine->frameNumber();
+    if (frame != _viewFrame) {
+        std::swap(_previousEyeTransforms, _eyeTransforms);
+        _eyeTransforms.clear();
+        _viewFrame = frame;
+        _chunkTreeUpdatedThisFrame = false;
+    }
+
+    // The transformation that is shared between all views rendering in the same frame is
+    // separated from the eye-dependent part, so that the eyes of the previous frame can
+    // be applied to the current camera
+    const glm::dmat4 eyeTransform =
+        glm::dmat4(data.camera.sgctInternal.projectionMatrix()) *
+        glm::dmat4(data.camera.sgctInternal.viewMatrix());
+    if (!renderGeomOnly) {
+        _eyeTransforms.push_back(eyeTransform);
+    }
+
+    const bool updateTree =
+        !_shareChunkTree || (!renderGeomOnly && !_chunkTreeUpdatedThisFrame);
+    bool cullPerView = _shareChunkTree && _debugProperties.performFrustumCulling;
+    if (updateTree) {
+        _chunkTreeMvps.clear();
+        _chunkTreeMvps.push_back(mvp);
+        if (_shareChunkTree) {
+            const glm::dmat4 sharedTransform =
+                glm::inverse(glm::dmat4(data.camera.sgctInternal.viewMatrix())) *
+                viewTransform * _cachedModelTransform;
+            for (const glm::dmat4& eye : _previousEyeTransforms) {
+                if (eye != eyeTransform) {
+                    _chunkTreeMvps.push_back(eye * sharedTransform);
+                }
+            }
+        }
+        // If the tree was only evaluated against this view, all visible chunks are
+        // already known to be inside its frustum
+        cullPerView = cullPerView && _chunkTreeMvps.size() > 1;
+
+        _allChunksAvailable = true;
+        updateChunkTree(data, _chunkTreeMvps);
+        _chunkCornersDirty = false;
+        _chunkTreeUpdatedThisFrame = true;
+        _iterationsOfAvailableData =
+            (_allChunksAvailable ? _iterationsOfAvailableData + 1 : 0);
+        _iterationsOfUnavailableData =
+            (_allChunksAvailable ? 0 : _iterationsOfUnavailableData + 1);
+    }
 
     //
     // Setting uniforms that don't change between chunks but are view dependent
@@ -1348,18 +1545,69 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         _traversalMemory
     );
 
+    if (cullPerView) {
+        ZoneScopedN("Per-view culling");
+
+        auto isOutside = [&](const Chunk* chunk) {
+            return isCullableByFrustum(*chunk, data, mvp);
+        };
+        auto globalEnd = _globalChunkBuffer.begin() + globalCount;
+        globalCount = static_cast<int>(
+            std::remove_if(_globalChunkBuffer.begin(), globalEnd, isOutside) -
+            _globalChunkBuffer.begin()
+        );
+        auto localEnd = _localChunkBuffer.begin() + localCount;
+        localCount = static_cast<int>(
+            std::remove_if(_localChunkBuffer.begin(), localEnd, isOutside) -
+            _localChunkBuffer.begin()
+        );
+    }
+
+    if (!renderGeomOnly) {
+        updateTilePriorities(data, globalCount, localCount);
+        _nRenderedChunks = globalCount + localCount;
+    }
+
     // Render all chunks that want to be rendered globally
     _globalRenderer.program->activate();
-    for (int i = 0; i < globalCount; i++) {
-        renderChunkGlobally(*_globalChunkBuffer[i], data, shadowData, renderGeomOnly);
+    if (_isUsingMultiDrawIndirect) {
+        renderChunksIndirect(
+            *_globalRenderer.program,
+            _globalRenderer.gpuLayerGroups,
+            _globalChunkBuffer,
+            globalCount,
+            false,
+            data,
+            shadowData,
+            renderGeomOnly
+        );
+    }
+    else {
+        for (int i = 0; i < globalCount; i++) {
+            renderChunkGlobally(*_globalChunkBuffer[i], data, shadowData, renderGeomOnly);
+        }
     }
     _globalRenderer.program->deactivate();
 
 
     // Render all chunks that need to be rendered locally
     _localRenderer.program->activate();
-    for (int i = 0; i < localCount; i++) {
-        renderChunkLocally(*_localChunkBuffer[i], data, shadowData, renderGeomOnly);
+    if (_isUsingMultiDrawIndirect) {
+        renderChunksIndirect(
+            *_localRenderer.program,
+            _localRenderer.gpuLayerGroups,
+            _localChunkBuffer,
+            localCount,
+            true,
+            data,
+            shadowData,
+            renderGeomOnly
+        );
+    }
+    else {
+        for (int i = 0; i < localCount; i++) {
+            renderChunkLocally(*_localChunkBuffer[i], data, shadowData, renderGeomOnly);
+        }
     }
     _localRenderer.program->deactivate();
 
@@ -1623,6 +1871,222 @@ void RenderableGlobe::renderChunkLocally(const Chunk& chunk, const RenderData& d
     }
 }
 
+void RenderableGlobe::renderChunksIndirect(ghoul::opengl::ProgramObject& program,
+                       std::array<GPULayerGroup, LayerManager::NumLayerGroups>& gpuLayers,
+                                     const std::vector<const Chunk*>& chunks, int nChunks,
+                                           bool renderLocally, const RenderData& data,
+                                         const ShadowComponent::ShadowMapData& shadowData,
+                                           bool renderGeomOnly)
+{
+    ZoneScoped;
+    TracyGpuZone("renderChunksIndirect");
+
+    static_assert(
+        sizeof(GPUChunkData) == 128,
+        "GPUChunkData must match the std430 layout of ChunkData in chunkdata.glsl"
+    );
+    static_assert(
+        sizeof(GPULayerGroup::ChunkTileData) == 24,
+        "ChunkTileData must match the std430 layout of ChunkTileData in chunkdata.glsl"
+    );
+
+    if (nChunks == 0) {
+        return;
+    }
+
+    using namespace layers;
+
+    const std::array<LayerGroup*, LayerManager::NumLayerGroups>& layerGroups =
+        _layerManager.layerGroups();
+    for (size_t i = 0; i < layerGroups.size(); i++) {
+        gpuLayers[i].setLayerValues(program, *layerGroups[i]);
+    }
+
+    const bool hasHeightLayer =
+        !_layerManager.layerGroup(Group::ID::HeightLayers).activeLayers().empty();
+    const bool useAccurateNormals = _useAccurateNormals && hasHeightLayer;
+    const glm::dmat4 modelViewTransform =
+        data.camera.combinedViewMatrix() * _cachedModelTransform;
+
+    //
+    // Collect the values that are otherwise set as uniforms for every chunk
+    //
+    std::vector<GPUChunkData>& chunkData = _multiDrawIndirect.chunkData;
+    std::vector<GPULayerGroup::ChunkTileData>& chunkTiles = _multiDrawIndirect.chunkTiles;
+    chunkData.clear();
+    chunkTiles.clear();
+    for (int i = 0; i < nChunks; i++) {
+        const Chunk& chunk = *chunks[i];
+
+        GPUChunkData d;
+        // The length of the skirts is proportional to its size
+        d.skirtLength = static_cast<float>(
+            glm::min(
+                chunk.surfacePatch.halfSize().lat * 1000000,
+                _ellipsoid.minimumRadius()
+            )
+        );
+        d.chunkLevel = chunk.tileIndex.level;
+
+        if (renderLocally) {
+            std::array<glm::vec3, 4> cornersCameraSpace;
+            for (int j = 0; j < 4; j++) {
+                const Geodetic2 corner = chunk.surfacePatch.corner(static_cast<Quad>(j));
+                const glm::dvec3 cornerModelSpace =
+                    _ellipsoid.cartesianSurfacePosition(corner);
+                cornersCameraSpace[j] = glm::vec3(
+                    modelViewTransform * glm::dvec4(cornerModelSpace, 1.0)
+                );
+            }
+            d.p00 = glm::vec4(cornersCameraSpace[Quad::SOUTH_WEST], 1.f);
+            d.p10 = glm::vec4(cornersCameraSpace[Quad::SOUTH_EAST], 1.f);
+            d.p01 = glm::vec4(cornersCameraSpace[Quad::NORTH_WEST], 1.f);
+            d.p11 = glm::vec4(cornersCameraSpace[Quad::NORTH_EAST], 1.f);
+
+            const glm::vec3 patchNormalCameraSpace = glm::normalize(
+                glm::cross(
+                    cornersCameraSpace[Quad::SOUTH_EAST] -
+                        cornersCameraSpace[Quad::SOUTH_WEST],
+                    cornersCameraSpace[Quad::NORTH_EAST] -
+                        cornersCameraSpace[Quad::SOUTH_WEST]
+                )
+            );
+            d.patchNormalCameraSpace = glm::vec4(patchNormalCameraSpace, 0.f);
+        }
+        else {
+            const Geodetic2 swCorner = chunk.surfacePatch.corner(Quad::SOUTH_WEST);
+            const Geodetic2& patchSize = chunk.surfacePatch.size();
+            d.minLatLon = glm::vec2(swCorner.lon, swCorner.lat);
+            d.lonLatScalingFactor = glm::vec2(patchSize.lon, patchSize.lat);
+        }
+
+        if (useAccurateNormals) {
+            const std::array<float, 4> deltas = accurateNormalDeltas(chunk, data);
+            d.deltaTheta0 = deltas[0];
+            d.deltaTheta1 = deltas[1];
+            d.deltaPhi0 = deltas[2];
+            d.deltaPhi1 = deltas[3];
+        }
+
+        chunkData.push_back(d);
+
+        for (size_t j = 0; j < layerGroups.size(); j++) {
+            gpuLayers[j].appendChunkTiles(*layerGroups[j], chunk.tileIndex, chunkTiles);
+        }
+    }
+
+    //
+    // Upload the collected values
+    //
+    using ShaderStorage = ghoul::opengl::bufferbinding::Buffer::ShaderStorage;
+    if (!_multiDrawIndirect.chunkDataBinding) {
+        glGenBuffers(1, &_multiDrawIndirect.chunkDataBuffer);
+        glGenBuffers(1, &_multiDrawIndirect.chunkTileBuffer);
+        _multiDrawIndirect.chunkDataBinding =
+            std::make_unique<ghoul::opengl::BufferBinding<ShaderStorage>>();
+        _multiDrawIndirect.chunkTileBinding =
+            std::make_unique<ghoul::opengl::BufferBinding<ShaderStorage>>();
+    }
+
+    // Orphaning the buffers every time as they are rewritten for every draw
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _multiDrawIndirect.chunkDataBuffer);
+    glBufferData(
+        GL_SHADER_STORAGE_BUFFER,
+        chunkData.size() * sizeof(GPUChunkData),
+        chunkData.data(),
+        GL_STREAM_DRAW
+    );
+    glBindBufferBase(
+        GL_SHADER_STORAGE_BUFFER,
+        _multiDrawIndirect.chunkDataBinding->bindingNumber(),
+        _multiDrawIndirect.chunkDataBuffer
+    );
+    program.setSsboBinding(
+        "ChunkDataBuffer",
+        _multiDrawIndirect.chunkDataBinding->bindingNumber()
+    );
+
+    // Without any tile layers, the chunk tile buffer is not part of the program
+    if (!chunkTiles.empty()) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _multiDrawIndirect.chunkTileBuffer);
+        glBufferData(
+            GL_SHADER_STORAGE_BUFFER,
+            chunkTiles.size() * sizeof(GPULayerGroup::ChunkTileData),
+            chunkTiles.data(),
+            GL_STREAM_DRAW
+        );
+        glBindBufferBase(
+            GL_SHADER_STORAGE_BUFFER,
+            _multiDrawIndirect.chunkTileBinding->bindingNumber(),
+            _multiDrawIndirect.chunkTileBuffer
+        );
+        program.setSsboBinding(
+            "ChunkTileBuffer",
+            _multiDrawIndirect.chunkTileBinding->bindingNumber()
+        );
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    //
+    // Setting the uniforms that are the same for all chunks
+    //
+    if (useAccurateNormals) {
+        program.setUniform("tileDelta", TileDelta);
+    }
+
+    if (renderLocally && hasHeightLayer) {
+        // Apply an extra scaling to the height if the object is scaled
+        program.setUniform(
+            "heightScale",
+            static_cast<float>(
+                glm::compMax(data.modelTransform.scale) * data.camera.scaling()
+            )
+        );
+    }
+
+    if (_eclipseShadowsEnabled && !_ellipsoid.shadowConfigurationArray().empty()) {
+        calculateEclipseShadows(
+            program,
+            data,
+            renderLocally ? ShadowCompType::LOCAL_SHADOW : ShadowCompType::GLOBAL_SHADOW
+        );
+    }
+
+    // Shadow Mapping
+    ghoul::opengl::TextureUnit shadowMapUnit;
+    if (_shadowMappingProperties.shadowMapping && shadowData.shadowDepthTexture != 0) {
+        // Adding the model transformation to the final shadow matrix so we have a
+        // complete transformation from the model coordinates to the clip space of the
+        // light position.
+        program.setUniform(
+            "shadowMatrix",
+            shadowData.shadowMatrix * modelTransform()
+        );
+
+        shadowMapUnit.activate();
+        glBindTexture(GL_TEXTURE_2D, shadowData.shadowDepthTexture);
+
+        program.setUniform("shadowMapTexture", shadowMapUnit);
+        program.setUniform(
+            "zFightingPercentage",
+            _shadowMappingProperties.zFightingPercentage
+        );
+    }
+    else if (_shadowMappingProperties.shadowMapping && _shadowComponent) {
+        shadowMapUnit.activate();
+        glBindTexture(GL_TEXTURE_2D, _shadowComponent->dDepthTexture());
+        program.setUniform("shadowMapTexture", shadowMapUnit);
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    if (!renderGeomOnly) {
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+    }
+
+    _grid.drawMultiIndirectUsingActiveProgram(static_cast<GLsizei>(nChunks));
+}
+
 void RenderableGlobe::debugRenderChunk(const Chunk& chunk, const glm::dmat4& mvp,
                                        bool renderBounds) const
 {
@@ -1669,48 +2133,56 @@ void RenderableGlobe::setCommonUniforms(ghoul::opengl::ProgramObject& programObj
     if (_useAccurateNormals &&
         !_layerManager.layerGroup(Group::ID::HeightLayers).activeLayers().empty())
     {
-        const glm::dvec3 corner00 = _ellipsoid.cartesianSurfacePosition(
-            chunk.surfacePatch.corner(Quad::SOUTH_WEST)
-        );
-        const glm::dvec3 corner10 = _ellipsoid.cartesianSurfacePosition(
-            chunk.surfacePatch.corner(Quad::SOUTH_EAST)
-        );
-        const glm::dvec3 corner01 = _ellipsoid.cartesianSurfacePosition(
-            chunk.surfacePatch.corner(Quad::NORTH_WEST)
-        );
-        const glm::dvec3 corner11 = _ellipsoid.cartesianSurfacePosition(
-            chunk.surfacePatch.corner(Quad::NORTH_EAST)
-        );
-
-        const glm::mat4 modelViewTransform = glm::mat4(
-            data.camera.combinedViewMatrix() * _cachedModelTransform
-        );
-
-        const glm::mat3& modelViewTransformMat3 = glm::mat3(modelViewTransform);
-
-        // This is an assumption that the height tile has a resolution of 512 * 512
-        // If it does not it will still produce "correct" normals. If the resolution is
-        // higher the shadows will be softer, if it is lower, pixels will be visible.
-        // Since default is 512 this will most likely work fine.
-        constexpr float TileDelta = 1.f / DefaultHeightTileResolution;
-        const glm::vec3 deltaTheta0 = modelViewTransformMat3 *
-            (glm::vec3(corner10 - corner00) * TileDelta);
-        const glm::vec3 deltaTheta1 = modelViewTransformMat3 *
-            (glm::vec3(corner11 - corner01) * TileDelta);
-        const glm::vec3 deltaPhi0 = modelViewTransformMat3 *
-            (glm::vec3(corner01 - corner00) * TileDelta);
-        const glm::vec3 deltaPhi1 = modelViewTransformMat3 *
-            (glm::vec3(corner11 - corner10) * TileDelta);
+        const std::array<float, 4> deltas = accurateNormalDeltas(chunk, data);
 
         // Upload uniforms
-        programObject.setUniform("deltaTheta0", glm::length(deltaTheta0));
-        programObject.setUniform("deltaTheta1", glm::length(deltaTheta1));
-        programObject.setUniform("deltaPhi0", glm::length(deltaPhi0));
-        programObject.setUniform("deltaPhi1", glm::length(deltaPhi1));
+        programObject.setUniform("deltaTheta0", deltas[0]);
+        programObject.setUniform("deltaTheta1", deltas[1]);
+        programObject.setUniform("deltaPhi0", deltas[2]);
+        programObject.setUniform("deltaPhi1", deltas[3]);
         programObject.setUniform("tileDelta", TileDelta);
     }
 }
 
+std::array<float, 4> RenderableGlobe::accurateNormalDeltas(const Chunk& chunk,
+                                                           const RenderData& data) const
+{
+    const glm::dvec3 corner00 = _ellipsoid.cartesianSurfacePosition(
+        chunk.surfacePatch.corner(Quad::SOUTH_WEST)
+    );
+    const glm::dvec3 corner10 = _ellipsoid.cartesianSurfacePosition(
+        chunk.surfacePatch.corner(Quad::SOUTH_EAST)
+    );
+    const glm::dvec3 corner01 = _ellipsoid.cartesianSurfacePosition(
+        chunk.surfacePatch.corner(Quad::NORTH_WEST)
+    );
+    const glm::dvec3 corner11 = _ellipsoid.cartesianSurfacePosition(
+        chunk.surfacePatch.corner(Quad::NORTH_EAST)
+    );
+
+    const glm::mat4 modelViewTransform = glm::mat4(
+        data.camera.combinedViewMatrix() * _cachedModelTransform
+    );
+
+    const glm::mat3& modelViewTransformMat3 = glm::mat3(modelViewTransform);
+
+    const glm::vec3 deltaTheta0 = modelViewTransformMat3 *
+        (glm::vec3(corner10 - corner00) * TileDelta);
+    const glm::vec3 deltaTheta1 = modelViewTransformMat3 *
+        (glm::vec3(corner11 - corner01) * TileDelta);
+    const glm::vec3 deltaPhi0 = modelViewTransformMat3 *
+        (glm::vec3(corner01 - corner00) * TileDelta);
+    const glm::vec3 deltaPhi1 = modelViewTransformMat3 *
+        (glm::vec3(corner11 - corner10) * TileDelta);
+
+    return {
+        glm::length(deltaTheta0),
+        glm::length(deltaTheta1),
+        glm::length(deltaPhi0),
+        glm::length(deltaPhi1)
+    };
+}
+
 void RenderableGlobe::recompileShaders() {
     ZoneScoped;
 
@@ -1783,6 +2255,18 @@ void RenderableGlobe::recompileShaders() {
     pairs.emplace_back("showHeightIntensities", "0");
     pairs.emplace_back("defaultHeight", std::to_string(DefaultHeight));
 
+    _isUsingBindlessTextures = global::moduleEngine->module<GlobeBrowsingModule>()
+        ->tileCache()->useBindlessTextures();
+    pairs.emplace_back("useBindlessTextures", std::to_string(_isUsingBindlessTextures));
+
+    // The chunk tiles can only be provided through a buffer as bindless handles
+    _isUsingMultiDrawIndirect = _useMultiDrawIndirect && _isUsingBindlessTextures &&
+                                isMultiDrawIndirectSupported();
+    pairs.emplace_back(
+        "useMultiDrawIndirect",
+        std::to_string(_isUsingMultiDrawIndirect)
+    );
+
     //
     // Create dictionary from layerpreprocessing data
     //
@@ -1865,6 +2349,22 @@ void RenderableGlobe::recompileShaders() {
     }
     shaderDictionary.setValue("layerGroups", layerGroupNames);
 
+    // When rendering with multi-draw-indirect, the chunk tiles of all active layers are
+    // stored consecutively in the order of the layer groups, see
+    // GPULayerGroup::appendChunkTiles
+    int chunkLayerOffset = 0;
+    for (size_t i = 0; i < layers::Groups.size(); i++) {
+        shaderDictionary.setValue(
+            std::format("chunkLayerOffset{}", layers::Groups[i].identifier),
+            chunkLayerOffset
+        );
+        chunkLayerOffset += preprocessingData.layeredTextureInfo[i].lastLayerIdx + 1;
+    }
+    shaderDictionary.setValue(
+        "chunkTilesPerChunk",
+        chunkLayerOffset * GPULayerGroup::ChunkTilesPerLayer
+    );
+
     for (const std::pair<std::string, std::string>& p : preprocessingData.keyValuePairs)
     {
         shaderDictionary.setValue(p.first, p.second);
@@ -1962,27 +2462,209 @@ SurfacePositionHandle RenderableGlobe::calculateSurfacePositionHandle(
     };
 }
 
+void RenderableGlobe::prefetchTiles(const RenderData& data) {
+    ZoneScoped;
+
+    // The globe is rendered more than once per frame when there are multiple viewports,
+    // but the camera only moves once per frame
+    const uint64_t frame = global::renderEngine->frameNumber();
+    if (_prefetch.hasPreviousPosition && frame == _prefetch.lastFrame) {
+        return;
+    }
+
+    // All calculations are done in the model space of the globe, so that the rotation of
+    // the globe underneath the camera is taken into account as well
+    const glm::dvec3 cameraPosition = glm::dvec3(_cachedInverseModelTransform *
+        glm::dvec4(data.camera.positionVec3(), 1.0));
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const double prefetchTime = _prefetchTime;
+
+    // The future camera positions along a camera path are known exactly. For all other
+    // kinds of camera motion, for example interactions, session recordings, or
+    // keyframes, the camera motion of the last frame is extrapolated
+    std::optional<glm::dvec3> predicted =
+        global::navigationHandler->pathNavigator().predictedCameraPosition(prefetchTime);
+    if (predicted.has_value()) {
+        const glm::dvec4 p = glm::dvec4(*predicted, 1.0);
+        predicted = glm::dvec3(_cachedInverseModelTransform * p);
+    }
+    else if (_prefetch.hasPreviousPosition) {
+        const double dt = std::chrono::duration<double>(now - _prefetch.time).count();
+        if (dt > 0.0) {
+            const glm::dvec3 velocity = (cameraPosition - _prefetch.position) / dt;
+            predicted = cameraPosition + velocity * prefetchTime;
+        }
+    }
+
+    _prefetch.position = cameraPosition;
+    _prefetch.time = now;
+    _prefetch.lastFrame = frame;
+    _prefetch.hasPreviousPosition = true;
+
+    if (!predicted.has_value()) {
+        return;
+    }
+
+    const Geodetic2 geodetic = _ellipsoid.cartesianToGeodetic2(*predicted);
+    const glm::dvec3 surface = _ellipsoid.cartesianSurfacePosition(geodetic);
+    const double altitude = std::max(glm::length(*predicted - surface), 1.0);
+    const double motion = glm::length(*predicted - cameraPosition);
+    if (motion < MinRelativePrefetchMotion * altitude) {
+        return;
+    }
+
+    // Same as the level selection in desiredLevelByDistance for the chunk that is
+    // directly underneath the predicted camera position
+    const double scaleFactor = _currentLodScaleFactor * _ellipsoid.minimumRadius();
+    const int level = glm::clamp(
+        static_cast<int>(std::ceil(std::log2(scaleFactor / altitude))),
+        MinSplitDepth,
+        MaxSplitDepth
+    );
+
+    // Prefetch the tile underneath the camera and its neighbors for the last few levels.
+    // Coarser levels are requested first so that they will also be loaded first
+    _prefetch.tileIndices.clear();
+    const int minLevel = std::max(level - PrefetchLevelRange + 1, MinSplitDepth);
+    for (int l = minLevel; l <= level; l++) {
+        const int nTilesX = 1 << l;
+        const int nTilesY = 1 << (l - 1);
+        const double tileSize = glm::two_pi<double>() / nTilesX;
+        const double lon = geodetic.lon + glm::pi<double>();
+        const double lat = glm::half_pi<double>() - geodetic.lat;
+        const int x = glm::clamp(static_cast<int>(lon / tileSize), 0, nTilesX - 1);
+        const int y = glm::clamp(static_cast<int>(lat / tileSize), 0, nTilesY - 1);
+
+        for (int dy = -1; dy <= 1; dy++) {
+            if (y + dy < 0 || y + dy >= nTilesY) {
+                continue;
+            }
+            for (int dx = -1; dx <= 1; dx++) {
+                // The longitude wraps around the antimeridian
+                const int xi = (x + dx + nTilesX) % nTilesX;
+                _prefetch.tileIndices.emplace_back(xi, y + dy, static_cast<uint8_t>(l));
+            }
+        }
+    }
+
+    for (const LayerGroup* layerGroup : _layerManager.layerGroups()) {
+        for (const Layer* layer : layerGroup->activeLayers()) {
+            TileProvider* tileProvider = layer->tileProvider();
+            if (!tileProvider) {
+                continue;
+            }
+
+            for (const TileIndex& tileIndex : _prefetch.tileIndices) {
+                tileProvider->prefetchTile(tileIndex);
+            }
+        }
+    }
+}
+
+void RenderableGlobe::updateTilePriorities(const RenderData& data, int nGlobalChunks,
+                                           int nLocalChunks)
+{
+    ZoneScoped;
+
+    std::function<float(const TileIndex&)> priority;
+    if (_screenSpaceTilePriority) {
+        const glm::dvec3 cameraPosition = glm::dvec3(_cachedInverseModelTransform *
+            glm::dvec4(data.camera.positionVec3(), 1.0));
+        const Geodetic2 cameraGeodetic = _ellipsoid.cartesianToGeodetic2(cameraPosition);
+
+        _tilePriorities.clear();
+        auto addChunk = [&](const Chunk& chunk) {
+            // The squared angular size of the chunk is used as an estimate of the area
+            // it covers on the screen
+            const Geodetic2 closest = chunk.surfacePatch.closestPoint(cameraGeodetic);
+            const double distance = glm::length(
+                _ellipsoid.cartesianSurfacePosition(closest) - cameraPosition
+            );
+            const double size =
+                2.0 * chunk.surfacePatch.halfSize().lat * _ellipsoid.minimumRadius();
+            const double angularSize = size / std::max(distance, 1.0);
+            float p = static_cast<float>(angularSize * angularSize);
+
+            // While the tiles of a chunk are missing, the tiles of its ancestors are
+            // shown instead and they cover a larger area, so each level upwards doubles
+            // the priority. If an ancestor already has a higher priority, all of its own
+            // ancestors do as well, so we can stop early
+            TileIndex tileIndex = chunk.tileIndex;
+            while (true) {
+                const auto [it, inserted] =
+                    _tilePriorities.try_emplace(tileIndex.hashKey(), p);
+                if (!inserted) {
+                    if (it->second >= p) {
+                        break;
+                    }
+                    it->second = p;
+                }
+
+                if (tileIndex.level <= 1) {
+                    break;
+                }
+                tileIndex = TileIndex(
+                    tileIndex.x / 2,
+                    tileIndex.y / 2,
+                    static_cast<uint8_t>(tileIndex.level - 1)
+                );
+                p *= 2.f;
+            }
+        };
+
+        for (int i = 0; i < nGlobalChunks; i++) {
+            addChunk(*_globalChunkBuffer[i]);
+        }
+        for (int i = 0; i < nLocalChunks; i++) {
+            addChunk(*_localChunkBuffer[i]);
+        }
+
+        priority = [this](const TileIndex& tileIndex) {
+            const auto it = _tilePriorities.find(tileIndex.hashKey());
+            return it != _tilePriorities.end() ? it->second : 0.f;
+        };
+    }
+
+    for (const LayerGroup* layerGroup : _layerManager.layerGroups()) {
+        for (const Layer* layer : layerGroup->activeLayers()) {
+            TileProvider* tileProvider = layer->tileProvider();
+            if (tileProvider) {
+                tileProvider->updateTilePriorities(priority);
+            }
+        }
+    }
+}
+
 bool RenderableGlobe::testIfCullable(const Chunk& chunk,
                                      const RenderData& renderData,
                                      const BoundingHeights& heights,
-                                     const glm::dmat4& mvp) const
+                                     const std::vector<glm::dmat4>& mvps) const
 {
     ZoneScoped;
 
-    return (PreformHorizonCulling && isCullableByHorizon(chunk, renderData, heights)) ||
-           (_debugProperties.performFrustumCulling &&
-               isCullableByFrustum(chunk, renderData, mvp));
+    if (PreformHorizonCulling && isCullableByHorizon(chunk, renderData, heights)) {
+        return true;
+    }
+
+    return _debugProperties.performFrustumCulling &&
+        std::all_of(
+            mvps.begin(),
+            mvps.end(),
+            [&](const glm::dmat4& mvp) {
+                return isCullableByFrustum(chunk, renderData, mvp);
+            }
+        );
 }
 
 int RenderableGlobe::desiredLevel(const Chunk& chunk, const RenderData& renderData,
-                                  const BoundingHeights& heights) const
+                                  const BoundingHeights& heights,
+                                  int levelByAvailableData) const
 {
     ZoneScoped;
 
     const int desiredLevel = _debugProperties.levelByProjectedAreaElseDistance ?
         desiredLevelByProjectedArea(chunk, renderData, heights) :
         desiredLevelByDistance(chunk, renderData, heights);
-    const int levelByAvailableData = desiredLevelByAvailableTileData(chunk);
 
     if (LimitLevelByAvailableData && (levelByAvailableData != UnknownDesiredLevel)) {
         const int l = glm::min(desiredLevel, levelByAvailableData);
@@ -1996,6 +2678,91 @@ int RenderableGlobe::desiredLevel(const Chunk& chunk, const RenderData& renderDa
 float RenderableGlobe::getHeight(const glm::dvec3& position) const {
     ZoneScoped;
 
+    std::lock_guard lock(_heightCache.mutex);
+    validateHeightCache();
+    return sampleHeight(position);
+}
+
+std::vector<float> RenderableGlobe::getHeights(
+                                          const std::vector<glm::dvec3>& positions) const
+{
+    ZoneScoped;
+
+    std::vector<float> heights;
+    heights.reserve(positions.size());
+
+    std::lock_guard lock(_heightCache.mutex);
+    validateHeightCache();
+    for (const glm::dvec3& position : positions) {
+        heights.push_back(sampleHeight(position));
+    }
+    return heights;
+}
+
+void RenderableGlobe::validateHeightCache() const {
+    // The tile providers might return different tiles in a new frame and the textures
+    // that the cached tiles point to can be reused for other tiles whenever the tile
+    // cache changes, so in both cases the cached tiles have to be looked up again
+    const uint64_t frame = global::renderEngine->frameNumber();
+    const uint64_t version =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache()
+        ->contentVersion();
+    if (frame != _heightCache.frame || version != _heightCache.tileCacheVersion) {
+        _heightCache.tiles.clear();
+        _heightCache.frame = frame;
+        _heightCache.tileCacheVersion = version;
+    }
+}
+
+const RenderableGlobe::HeightTile& RenderableGlobe::heightTile(
+                                                        const TileIndex& tileIndex) const
+{
+    const TileIndex::TileHashKey key = tileIndex.hashKey();
+    auto it = _heightCache.tiles.find(key);
+    if (it != _heightCache.tiles.end()) {
+        return it->second;
+    }
+
+    ZoneScopedN("Lookup Height Tile");
+
+    HeightTile heightTile;
+
+    // Get the tile providers for the height maps
+    const std::vector<Layer*>& heightMapLayers =
+        _layerManager.layerGroup(layers::Group::ID::HeightLayers).activeLayers();
+
+    for (Layer* layer : heightMapLayers) {
+        TileProvider* tileProvider = layer->tileProvider();
+        if (!tileProvider) {
+            continue;
+        }
+        const ChunkTile chunkTile = tileProvider->chunkTile(tileIndex);
+        const Tile& tile = chunkTile.tile;
+        if (tile.status != Tile::Status::OK || !tile.texture) {
+            heightTile.isComplete = false;
+            break;
+        }
+
+        // Single channel float textures, which is what the height layers use by default,
+        // can be sampled directly instead of having to convert every texel
+        const ghoul::opengl::Texture* texture = tile.texture;
+        const bool isFloat = texture->dataType() == GL_FLOAT &&
+            texture->format() == ghoul::opengl::Texture::Format::Red;
+
+        heightTile.layers.push_back({
+            .layer = layer,
+            .texture = texture,
+            .data = isFloat ? static_cast<const float*>(texture->pixelData()) : nullptr,
+            .uvTransform = chunkTile.uvTransform,
+            .depthTransform = tileProvider->depthTransform(),
+            .noDataValue = tileProvider->noDataValueAsFloat()
+        });
+    }
+
+    return _heightCache.tiles.emplace(key, std::move(heightTile)).first->second;
+}
+
+float RenderableGlobe::sampleHeight(const glm::dvec3& position) const {
     float height = 0;
 
     // Get the uv coordinates to sample from
@@ -2036,31 +2803,15 @@ float RenderableGlobe::getHeight(const glm::dvec3& position) const {
         geoDiffPoint.lat / geoDiffPatch.lat
     );
 
-    // Get the tile providers for the height maps
-    const std::vector<Layer*>& heightMapLayers =
-        _layerManager.layerGroup(layers::Group::ID::HeightLayers).activeLayers();
+    const HeightTile& tile = heightTile(tileIndex);
+    if (!tile.isComplete) {
+        return 0;
+    }
 
-    for (Layer* layer : heightMapLayers) {
-        TileProvider* tileProvider = layer->tileProvider();
-        if (!tileProvider) {
-            continue;
-        }
+    for (const HeightTile::LayerData& layerData : tile.layers) {
         // Transform the uv coordinates to the current tile texture
-        const ChunkTile chunkTile = tileProvider->chunkTile(tileIndex);
-        const Tile& tile = chunkTile.tile;
-        const TileUvTransform& uvTransform = chunkTile.uvTransform;
-        const TileDepthTransform& depthTransform = tileProvider->depthTransform();
-        if (tile.status != Tile::Status::OK) {
-            return 0;
-        }
-
-        ghoul::opengl::Texture* tileTexture = tile.texture;
-        if (!tileTexture) {
-            return 0;
-        }
-
-        const glm::vec2& transformedUv = layer->tileUvToTextureSamplePosition(
-            uvTransform,
+        const glm::vec2& transformedUv = layerData.layer->tileUvToTextureSamplePosition(
+            layerData.uvTransform,
             patchUV
         );
 
@@ -2069,7 +2820,7 @@ float RenderableGlobe::getHeight(const glm::dvec3& position) const {
         // Suggestion: a function in ghoul::opengl::Texture that takes uv coordinates
         // in range [0,1] and uses the set interpolation method and clamping.
 
-        const glm::uvec3 dimensions = tileTexture->dimensions();
+        const glm::uvec3 dimensions = layerData.texture->dimensions();
 
         glm::vec2 samplePos = transformedUv * glm::vec2(dimensions);
         // @TODO (emmbr, 2023-06-14) This 0.5f offset was added as a bandaid for issue
@@ -2098,10 +2849,15 @@ float RenderableGlobe::getHeight(const glm::dvec3& position) const {
             glm::uvec2(dimensions) - glm::uvec2(1)
         );
 
-        const float sample00 = tileTexture->texelAsFloat(samplePos00).x;
-        const float sample10 = tileTexture->texelAsFloat(samplePos10).x;
-        const float sample01 = tileTexture->texelAsFloat(samplePos01).x;
-        const float sample11 = tileTexture->texelAsFloat(samplePos11).x;
+        auto texel = [&layerData, &dimensions](const glm::uvec2& p) {
+            return layerData.data ?
+                layerData.data[p.y * dimensions.x + p.x] :
+                layerData.texture->texelAsFloat(p).x;
+        };
+        const float sample00 = texel(samplePos00);
+        const float sample10 = texel(samplePos10);
+        const float sample01 = texel(samplePos01);
+        const float sample11 = texel(samplePos11);
 
         // In case the texture has NaN or no data values don't use this height map.
         const bool anySampleIsNaN =
@@ -2111,10 +2867,10 @@ float RenderableGlobe::getHeight(const glm::dvec3& position) const {
             std::isnan(sample11);
 
         const bool anySampleIsNoData =
-            sample00 == tileProvider->noDataValueAsFloat() ||
-            sample01 == tileProvider->noDataValueAsFloat() ||
-            sample10 == tileProvider->noDataValueAsFloat() ||
-            sample11 == tileProvider->noDataValueAsFloat();
+            sample00 == layerData.noDataValue ||
+            sample01 == layerData.noDataValue ||
+            sample10 == layerData.noDataValue ||
+            sample11 == layerData.noDataValue;
 
         if (anySampleIsNaN || anySampleIsNoData) {
             continue;
@@ -2134,11 +2890,12 @@ float RenderableGlobe::getHeight(const glm::dvec3& position) const {
         // is smaller than -100000
         if (sample > -100000) {
             // Perform depth transform to get the value in meters
+            const TileDepthTransform& depthTransform = layerData.depthTransform;
             height = depthTransform.offset + depthTransform.scale * sample;
             // Make sure that the height value follows the layer settings.
             // For example if the multiplier is set to a value bigger than one,
             // the sampled height should be modified as well.
-            height = layer->renderSettings().performLayerSettings(height);
+            height = layerData.layer->renderSettings().performLayerSettings(height);
         }
     }
     // Return the result
@@ -2156,112 +2913,37 @@ void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& prog
         !_ellipsoid.shadowConfigurationArray().empty(),
         "Needs to have eclipse shadows enabled"
     );
-    // Shadow calculations..
-    std::vector<ShadowRenderingStruct> shadowDataArray;
+    // The positions of the sources and casters are shared with all other globes and
+    // atmospheres that are rendered at the same time
+    EclipseShadows& eclipseShadows = global::renderEngine->eclipseShadows();
+    const double time = data.time.j2000Seconds();
+    const glm::dvec3& sunPos = eclipseShadows.position("SUN", time);
+
+    std::vector<EclipseShadows::Shadow> shadowDataArray;
     const std::vector<Ellipsoid::ShadowConfiguration>& shadowConfArray =
         _ellipsoid.shadowConfigurationArray();
     shadowDataArray.reserve(shadowConfArray.size());
-    double lt = 0.0;
-    for (const auto& shadowConf : shadowConfArray) {
-        // TO REMEMBER: all distances and lengths in world coordinates are in
-        // meters!!! We need to move this to view space...
-        // Getting source and caster:
-        glm::dvec3 sourcePos = SpiceManager::ref().targetPosition(
-            shadowConf.source.first,
-            "SSB",
-            "GALACTIC",
-            {},
-            data.time.j2000Seconds(),
-            lt
-        );
-        sourcePos *= KM_TO_M; // converting to meters
-        glm::dvec3 casterPos = SpiceManager::ref().targetPosition(
-            shadowConf.caster.first,
-            "SSB",
-            "GALACTIC",
-            {},
-            data.time.j2000Seconds(),
-            lt
+    for (const Ellipsoid::ShadowConfiguration& shadowConf : shadowConfArray) {
+        const std::optional<EclipseShadows::Shadow> shadow = eclipseShadows.shadow(
+            shadowConf.source,
+            shadowConf.caster,
+            data.modelTransform.translation,
+            _ellipsoid.radii().x * KM_TO_M,
+            sunPos,
+            time
         );
-        casterPos *= KM_TO_M; // converting to meters
-
-        const std::string source = shadowConf.source.first;
-        SceneGraphNode* sourceNode =
-            global::renderEngine->scene()->sceneGraphNode(source);
-        const std::string caster = shadowConf.caster.first;
-        SceneGraphNode* casterNode =
-            global::renderEngine->scene()->sceneGraphNode(caster);
-
-        if ((sourceNode == nullptr) || (casterNode == nullptr)) {
+        if (!shadow.has_value()) {
             LERRORC(
                 "Renderableglobe",
                 "Invalid scenegraph node for the shadow's caster or shadow's receiver"
             );
             return;
         }
-
-        const double sourceRadiusScale = std::max(
-            glm::compMax(sourceNode->scale()),
-            1.0
-        );
-
-        const double casterRadiusScale = std::max(
-            glm::compMax(casterNode->scale()),
-            1.0
-        );
-
-        // First we determine if the caster is shadowing the current planet (all
-        // calculations in World Coordinates):
-        const glm::dvec3 planetCasterVec = casterPos - data.modelTransform.translation;
-        const glm::dvec3 sourceCasterVec = casterPos - sourcePos;
-
-        const double sc_length = glm::length(sourceCasterVec);
-        const glm::dvec3 planetCaster_proj =
-            (glm::dot(planetCasterVec, sourceCasterVec) / (sc_length*sc_length)) *
-            sourceCasterVec;
-
-        const double d_test  = glm::length(planetCasterVec - planetCaster_proj);
-        const double xp_test = shadowConf.caster.second * casterRadiusScale *
-                sc_length / (shadowConf.source.second * sourceRadiusScale +
-                             shadowConf.caster.second * casterRadiusScale);
-        const double rp_test = shadowConf.caster.second * casterRadiusScale *
-            (glm::length(planetCaster_proj) + xp_test) / xp_test;
-
-        const glm::dvec3 sunPos = SpiceManager::ref().targetPosition(
-            "SUN",
-            "SSB",
-            "GALACTIC",
-            {},
-            data.time.j2000Seconds(),
-            lt
-        );
-        const double casterDistSun = glm::length(casterPos - sunPos);
-        const double planetDistSun =
-            glm::length(data.modelTransform.translation - sunPos);
-
-        ShadowRenderingStruct shadowData;
-        shadowData.isShadowing = false;
-
-        // Eclipse shadows considers planets and moons as spheres
-        if (((d_test - rp_test) < (_ellipsoid.radii().x * KM_TO_M)) &&
-            (casterDistSun < planetDistSun))
-        {
-            // The current caster is shadowing the current planet
-            shadowData.isShadowing       = true;
-            shadowData.rs                = shadowConf.source.second * sourceRadiusScale;
-            shadowData.rc                = shadowConf.caster.second * casterRadiusScale;
-            shadowData.sourceCasterVec   = glm::normalize(sourceCasterVec);
-            shadowData.xp                = xp_test;
-            shadowData.xu                = shadowData.rc * sc_length /
-                                          (shadowData.rs - shadowData.rc);
-            shadowData.casterPositionVec = casterPos;
-        }
-        shadowDataArray.push_back(shadowData);
+        shadowDataArray.push_back(*shadow);
     }
 
-    const std::string uniformVarName("shadowDataArray[");
     unsigned int counter = 0;
-    for (const ShadowRenderingStruct& sd : shadowDataArray) {
+    for (const EclipseShadows::Shadow& sd : shadowDataArray) {
         constexpr std::string_view NameIsShadowing = "shadowDataArray[{}].isShadowing";
         constexpr std::string_view NameXp = "shadowDataArray[{}].xp";
         constexpr std::string_view NameXu = "shadowDataArray[{}].xu";
@@ -2272,9 +2954,9 @@ void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& prog
         programObject.setUniform(std::format(NameIsShadowing, counter), sd.isShadowing);
 
         if (sd.isShadowing) {
-            programObject.setUniform(std::format(NameXp, counter), sd.xp);
-            programObject.setUniform(std::format(NameXu, counter), sd.xu);
-            programObject.setUniform(std::format(NameRc, counter), sd.rc);
+            programObject.setUniform(std::format(NameXp, counter), sd.penumbra);
+            programObject.setUniform(std::format(NameXu, counter), sd.umbra);
+            programObject.setUniform(std::format(NameRc, counter), sd.radiusCaster);
             programObject.setUniform(
                 std::format(NameSource, counter), sd.sourceCasterVec
             );
@@ -2601,20 +3283,81 @@ void RenderableGlobe::mergeChunkNode(Chunk& cn) {
     cn.children.fill(nullptr);
 }
 
-bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
-                                      const glm::dmat4& mvp)
+void RenderableGlobe::updateChunkTree(const RenderData& data,
+                                      const std::vector<glm::dmat4>& mvps)
 {
     ZoneScoped;
 
+    // Flatten the chunk tree in breadth-first order, so that all chunks of one level are
+    // stored next to each other and are evaluated together
+    _chunkTraversal.clear();
+    _chunkTraversal.push_back(&_leftRoot);
+    _chunkTraversal.push_back(&_rightRoot);
+    for (size_t i = 0; i < _chunkTraversal.size(); i++) {
+        const Chunk& chunk = *_chunkTraversal[i];
+        if (!isLeaf(chunk)) {
+            _chunkTraversal.insert(
+                _chunkTraversal.end(),
+                chunk.children.begin(),
+                chunk.children.end()
+            );
+        }
+    }
+    const size_t nChunks = _chunkTraversal.size();
+
+    // The tile providers are not thread-safe, so everything that depends on the tile
+    // data is gathered on this thread first
+    _chunkEvaluations.resize(nChunks);
+    {
+        ZoneScopedN("Tile data");
+        for (size_t i = 0; i < nChunks; i++) {
+            _chunkEvaluations[i] = prepareChunk(*_chunkTraversal[i]);
+        }
+    }
+
+    // The culling tests and the level selection only read and write the state of a
+    // single chunk, so for large trees they are split across multiple threads
+    auto evaluate = [&](size_t begin, size_t end) {
+        ZoneScopedN("Evaluate chunks");
+        for (size_t i = begin; i < end; i++) {
+            updateChunk(*_chunkTraversal[i], _chunkEvaluations[i], data, mvps);
+        }
+    };
+
+    const size_t nThreads = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u),
+        nChunks / MinChunksPerThread
+    );
+    if (nThreads <= 1) {
+        evaluate(0, nChunks);
+    }
+    else {
+        const size_t blockSize = (nChunks + nThreads - 1) / nThreads;
+        std::vector<std::future<void>> futures;
+        futures.reserve(nThreads - 1);
+        for (size_t begin = blockSize; begin < nChunks; begin += blockSize) {
+            const size_t end = std::min(begin + blockSize, nChunks);
+            futures.push_back(std::async(std::launch::async, evaluate, begin, end));
+        }
+        evaluate(0, blockSize);
+        for (std::future<void>& future : futures) {
+            future.get();
+        }
+    }
+
+    applyChunkTreeChanges(_leftRoot);
+    applyChunkTreeChanges(_rightRoot);
+}
+
+bool RenderableGlobe::applyChunkTreeChanges(Chunk& cn) {
+    ZoneScoped;
+
     // abock:  I tried turning this into a queue and use iteration, rather than recursion
     //         but that made the code harder to understand as the breadth-first traversal
     //         requires parents to be passed through the pipe twice (first to add the
     //         children and then again it self to be processed after the children finish).
     //         In addition, this didn't even improve performance ---  2018-10-04
     if (isLeaf(cn)) {
-        ZoneScopedN("leaf");
-        updateChunk(cn, data, mvp);
-
         if (cn.status == Chunk::Status::WantSplit) {
             splitChunkNode(cn, 1);
         }
@@ -2626,17 +3369,14 @@ bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
         return cn.status == Chunk::Status::WantMerge;
     }
     else {
-        ZoneScopedN("!leaf");
         char requestedMergeMask = 0;
         for (int i = 0; i < 4; i++) {
-            if (updateChunkTree(*cn.children[i], data, mvp)) {
+            if (applyChunkTreeChanges(*cn.children[i])) {
                 requestedMergeMask |= (1 << i);
             }
         }
 
         const bool allChildrenWantsMerge = requestedMergeMask == 0xf;
-        updateChunk(cn, data, mvp);
-
         if (allChildrenWantsMerge && (cn.status != Chunk::Status::WantSplit)) {
             mergeChunkNode(cn);
         }
@@ -2651,9 +3391,7 @@ bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
     }
 }
 
-void RenderableGlobe::updateChunk(Chunk& chunk, const RenderData& data,
-                                  const glm::dmat4& mvp) const
-{
+RenderableGlobe::ChunkEvaluation RenderableGlobe::prepareChunk(Chunk& chunk) const {
     ZoneScoped;
 
     const BoundingHeights& heights = boundingHeightsForChunk(chunk, _layerManager);
@@ -2666,7 +3404,16 @@ void RenderableGlobe::updateChunk(Chunk& chunk, const RenderData& data,
         // The flag gets set to false globally after the updateChunkTree calls
     }
 
-    if (testIfCullable(chunk, data, heights, mvp)) {
+    return { heights, desiredLevelByAvailableTileData(chunk) };
+}
+
+void RenderableGlobe::updateChunk(Chunk& chunk, const ChunkEvaluation& evaluation,
+                                  const RenderData& data,
+                                  const std::vector<glm::dmat4>& mvps) const
+{
+    ZoneScoped;
+
+    if (testIfCullable(chunk, data, evaluation.heights, mvps)) {
         chunk.isVisible = false;
         chunk.status = Chunk::Status::WantMerge;
     }
@@ -2674,7 +3421,12 @@ void RenderableGlobe::updateChunk(Chunk& chunk, const RenderData& data,
         chunk.isVisible = true;
     }
 
-    const int dl = desiredLevel(chunk, data, heights);
+    const int dl = desiredLevel(
+        chunk,
+        data,
+        evaluation.heights,
+        evaluation.levelByAvailableData
+    );
 
     if (dl < chunk.tileIndex.level) {
         chunk.status = Chunk::Status::WantMerge;
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/ellipsoid.h>
 #include <modules/globebrowsing/src/geodeticpatch.h>
 #include <modules/globebrowsing/src/geojson/geojsonmanager.h>
@@ -42,9 +43,17 @@
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <ghoul/misc/memorypool.h>
+#include <ghoul/opengl/bufferbinding.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace openspace::documentation { struct Documentation; }
 
@@ -112,6 +121,20 @@ public:
     SurfacePositionHandle calculateSurfacePositionHandle(
         const glm::dvec3& targetModelSpace) const override;
 
+    /**
+     * Calculates the heights from the surface of the reference ellipsoid to the height
+     * mapped surface for all of the \p positions in a single pass. Positions that fall
+     * into the same tile share the lookup of the height data, so this function should be
+     * preferred over repeated calls to #calculateSurfacePositionHandle when the heights
+     * of many positions are needed in the same frame.
+     *
+     * \param positions The positions that get geodetically projected on the reference
+     *        ellipsoid. The positions must be in Cartesian model space
+     * \return The heights from the reference ellipsoid to the globe surface, in the same
+     *         order as the \p positions
+     */
+    std::vector<float> getHeights(const std::vector<glm::dvec3>& positions) const;
+
     bool renderedWithDesiredData() const override;
 
     const Ellipsoid& ellipsoid() const;
@@ -122,6 +145,19 @@ public:
 
     const glm::dmat4& modelTransform() const;
 
+    /**
+     * Returns the number of chunks that were rendered in the most recent frame, both in
+     * model space and in camera space.
+     */
+    int nRenderedChunks() const;
+
+    /**
+     * Returns the root chunks of the western and the eastern hemisphere if the chunk tree
+     * was updated for the current frame, so that the visibility of its chunks is valid.
+     * Returns `std::nullopt` if the globe was not rendered in the current frame.
+     */
+    std::optional<std::array<const Chunk*, 2>> currentChunkTree() const;
+
     // Will cause the shaders to be recompiled
     void invalidateShader();
 
@@ -132,10 +168,11 @@ private:
      * Test if a specific chunk can safely be culled without affecting the rendered image.
      *
      * Goes through all available `ChunkCuller`s and check if any of them allows culling
-     * of the `Chunk`s in question.
+     * of the `Chunk`s in question. A chunk is only culled by the frustum if it lies
+     * outside of the frustums of all \p mvps.
      */
     bool testIfCullable(const Chunk& chunk, const RenderData& renderData,
-        const BoundingHeights& heights, const glm::dmat4& mvp) const;
+        const BoundingHeights& heights, const std::vector<glm::dmat4>& mvps) const;
 
     /**
      * Gets the desired level which can be used to determine if a chunk should split or
@@ -147,7 +184,7 @@ private:
      * siblings.
      */
     int desiredLevel(const Chunk& chunk, const RenderData& renderData,
-        const BoundingHeights& heights) const;
+        const BoundingHeights& heights, int levelByAvailableData) const;
 
     /**
      * Calculates the height from the surface of the reference ellipsoid to the height
@@ -161,6 +198,38 @@ private:
      */
     float getHeight(const glm::dvec3& position) const;
 
+    /// The height layer data of a single tile index that is used to sample heights
+    struct HeightTile {
+        struct LayerData {
+            Layer* layer = nullptr;
+            const ghoul::opengl::Texture* texture = nullptr;
+            /// Points to the pixel data of `texture` if it can be read directly
+            const float* data = nullptr;
+            TileUvTransform uvTransform;
+            TileDepthTransform depthTransform;
+            float noDataValue = 0.f;
+        };
+        std::vector<LayerData> layers;
+        /// `false` if any of the height layers did not have its tile data available
+        bool isComplete = true;
+    };
+
+    /**
+     * Returns the cached height layer data of the \p tileIndex, which is looked up from
+     * the tile providers the first time it is requested after the content of the tile
+     * cache has changed. The \c _heightCache.mutex has to be locked by the caller.
+     */
+    const HeightTile& heightTile(const TileIndex& tileIndex) const;
+
+    /**
+     * Performs the calculation of #getHeight with the \c _heightCache.mutex already
+     * locked and the cache validated for the current frame.
+     */
+    float sampleHeight(const glm::dvec3& position) const;
+
+    /// Clears the cached height tiles if a new frame has started or the tiles changed
+    void validateHeightCache() const;
+
     void renderChunks(const RenderData& data, RendererTasks& rendererTask,
         const ShadowComponent::ShadowMapData& shadowData = {}, bool renderGeomOnly = false
     );
@@ -192,6 +261,38 @@ private:
         const ShadowComponent::ShadowMapData& shadowData = {}, bool renderGeomOnly = false
     );
 
+    /**
+     * Renders the first \p nChunks chunks in \p chunks using a single call to
+     * `glMultiDrawElementsIndirect` with the provided \p program, which has to be active
+     * and compiled with multi-draw-indirect support. Instead of setting the per-chunk
+     * uniforms before rendering each chunk, the values of all chunks and their chunk
+     * tiles are uploaded to shader storage buffers. If \p renderLocally is `true`, the
+     * chunks are rendered as described in #renderChunkLocally, otherwise as described in
+     * #renderChunkGlobally.
+     */
+    void renderChunksIndirect(ghoul::opengl::ProgramObject& program,
+        std::array<GPULayerGroup, LayerManager::NumLayerGroups>& gpuLayers,
+        const std::vector<const Chunk*>& chunks, int nChunks, bool renderLocally,
+        const RenderData& data, const ShadowComponent::ShadowMapData& shadowData,
+        bool renderGeomOnly);
+
+    /**
+     * Predicts the position of the camera `PrefetchTime` seconds into the future and
+     * requests the tiles that are needed at that position before the chunk tree asks for
+     * them. The tiles are requested with a low priority so that they never delay the
+     * tiles that are needed right now.
+     */
+    void prefetchTiles(const RenderData& data);
+
+    /**
+     * Updates the load priorities of the tiles that are requested by the \p nGlobalChunks
+     * and \p nLocalChunks chunks that are rendered in this frame, based on the area they
+     * cover on screen. The tiles closest to the root have the highest priority as they
+     * are the fallback for all of the finer tiles.
+     */
+    void updateTilePriorities(const RenderData& data, int nGlobalChunks,
+        int nLocalChunks);
+
     void debugRenderChunk(const Chunk& chunk, const glm::dmat4& mvp,
         bool renderBounds) const;
 
@@ -213,12 +314,35 @@ private:
     void setCommonUniforms(ghoul::opengl::ProgramObject& programObject,
         const Chunk& chunk, const RenderData& data);
 
+    /**
+     * Calculates the camera space distances between neighboring height samples along the
+     * edges of the \p chunk that are used to calculate accurate normals. The values are
+     * returned in the order deltaTheta0, deltaTheta1, deltaPhi0, deltaPhi1.
+     */
+    std::array<float, 4> accurateNormalDeltas(const Chunk& chunk,
+        const RenderData& data) const;
+
     void recompileShaders();
 
     void splitChunkNode(Chunk& cn, int depth);
     void mergeChunkNode(Chunk& cn);
-    bool updateChunkTree(Chunk& cn, const RenderData& data, const glm::dmat4& mvp);
-    void updateChunk(Chunk& chunk, const RenderData& data, const glm::dmat4& mvp) const;
+    /// The values of a chunk that depend on the tile data of the layers
+    struct ChunkEvaluation {
+        BoundingHeights heights;
+        int levelByAvailableData;
+    };
+
+    /**
+     * Evaluates all chunks of both hemispheres one tree level after another, splitting
+     * the culling tests and the level selection across threads for large trees, and then
+     * splits and merges the chunks accordingly. A chunk is kept visible as long as it
+     * lies inside the frustum of any of the \p mvps.
+     */
+    void updateChunkTree(const RenderData& data, const std::vector<glm::dmat4>& mvps);
+    bool applyChunkTreeChanges(Chunk& cn);
+    ChunkEvaluation prepareChunk(Chunk& chunk) const;
+    void updateChunk(Chunk& chunk, const ChunkEvaluation& evaluation,
+        const RenderData& data, const std::vector<glm::dmat4>& mvps) const;
     void freeChunkNode(Chunk* n);
 
     static constexpr int MinSplitDepth = 2;
@@ -236,6 +360,11 @@ private:
     properties::FloatProperty _currentLodScaleFactor;
     properties::FloatProperty _orenNayarRoughness;
     properties::IntProperty _nActiveLayers;
+    properties::BoolProperty _useMultiDrawIndirect;
+    properties::BoolProperty _prefetchTiles;
+    properties::FloatProperty _prefetchTime;
+    properties::BoolProperty _screenSpaceTilePriority;
+    properties::BoolProperty _shareChunkTree;
 
     struct {
         properties::BoolProperty showChunkEdges;
@@ -270,6 +399,19 @@ private:
     std::vector<const Chunk*> _globalChunkBuffer;
     std::vector<const Chunk*> _localChunkBuffer;
     std::vector<const Chunk*> _traversalMemory;
+    std::vector<Chunk*> _chunkTraversal;
+    std::vector<ChunkEvaluation> _chunkEvaluations;
+
+    /// The frame number for which `_eyeTransforms` are currently being collected
+    uint64_t _viewFrame = std::numeric_limits<uint64_t>::max();
+    /// Whether the chunk tree was already updated for `_viewFrame`
+    bool _chunkTreeUpdatedThisFrame = false;
+    /// The projection * view offsets of the views that rendered in `_viewFrame`
+    std::vector<glm::dmat4> _eyeTransforms;
+    /// The projection * view offsets of the views that rendered in the previous frame
+    std::vector<glm::dmat4> _previousEyeTransforms;
+    /// The model-view-projection matrices the chunk tree is evaluated against
+    std::vector<glm::dmat4> _chunkTreeMvps;
 
     Chunk _leftRoot;  // Covers all negative longitudes
     Chunk _rightRoot; // Covers all positive longitudes
@@ -292,9 +434,67 @@ private:
         std::array<GPULayerGroup, LayerManager::NumLayerGroups> gpuLayerGroups;
     } _localRenderer;
 
+    /**
+     * The values of a single chunk when all chunks are rendered with a single draw call.
+     * Keep in sync with `ChunkData` in shaders/chunkdata.glsl
+     */
+    struct GPUChunkData {
+        glm::vec4 p00 = glm::vec4(0.f);
+        glm::vec4 p10 = glm::vec4(0.f);
+        glm::vec4 p01 = glm::vec4(0.f);
+        glm::vec4 p11 = glm::vec4(0.f);
+        glm::vec4 patchNormalCameraSpace = glm::vec4(0.f);
+        glm::vec2 minLatLon = glm::vec2(0.f);
+        glm::vec2 lonLatScalingFactor = glm::vec2(0.f);
+        float skirtLength = 0.f;
+        GLint chunkLevel = 0;
+        float deltaTheta0 = 0.f;
+        float deltaTheta1 = 0.f;
+        float deltaPhi0 = 0.f;
+        float deltaPhi1 = 0.f;
+        // The std430 layout rounds the size of the struct up to a multiple of 16 bytes
+        std::array<float, 2> padding = { 0.f, 0.f };
+    };
+
+    struct {
+        GLuint chunkDataBuffer = 0;
+        GLuint chunkTileBuffer = 0;
+        std::unique_ptr<ghoul::opengl::BufferBinding<
+            ghoul::opengl::bufferbinding::Buffer::ShaderStorage>> chunkDataBinding;
+        std::unique_ptr<ghoul::opengl::BufferBinding<
+            ghoul::opengl::bufferbinding::Buffer::ShaderStorage>> chunkTileBinding;
+
+        std::vector<GPUChunkData> chunkData;
+        std::vector<GPULayerGroup::ChunkTileData> chunkTiles;
+    } _multiDrawIndirect;
+
+    struct {
+        /// The position of the camera in model space when the tiles were last prefetched
+        glm::dvec3 position = glm::dvec3(0.0);
+        std::chrono::steady_clock::time_point time;
+        uint64_t lastFrame = 0;
+        bool hasPreviousPosition = false;
+
+        std::vector<TileIndex> tileIndices;
+    } _prefetch;
+
+    /// The load priority of the tiles that are needed by the chunks of the last frame
+    std::unordered_map<TileIndex::TileHashKey, float> _tilePriorities;
+
+    mutable struct {
+        std::mutex mutex;
+        uint64_t frame = std::numeric_limits<uint64_t>::max();
+        uint64_t tileCacheVersion = std::numeric_limits<uint64_t>::max();
+        std::unordered_map<TileIndex::TileHashKey, HeightTile> tiles;
+    } _heightCache;
+
     SceneGraphNode* _lightSourceNode = nullptr;
 
     bool _shadersNeedRecompilation = true;
+    /// Whether the shaders were last compiled with bindless samplers for the tiles
+    bool _isUsingBindlessTextures = false;
+    /// Whether the shaders were last compiled to render all chunks in a single draw call
+    bool _isUsingMultiDrawIndirect = false;
     bool _lodScaleFactorDirty = true;
     bool _chunkCornersDirty = true;
     bool _nLayersIsDirty = true;
@@ -302,6 +502,7 @@ private:
     bool _layerManagerDirty = true;
     size_t _iterationsOfAvailableData = 0;
     size_t _iterationsOfUnavailableData = 0;
+    int _nRenderedChunks = 0;
     Layer* _lastChangedLayer = nullptr;
 
     // Components
@@ -45,14 +45,24 @@
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/io/texture/texturereader.h>
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <cstdlib>
 #include <locale>
+#include <vector>
 
 namespace {
     constexpr std::string_view _loggerCat = "RingsComponent";
 
+    // The number of segments of the coarsest level of the ring mesh. Every following
+    // level has twice the number of segments of the previous level
+    constexpr int MinMeshSegments = 32;
+
+    // The width and height of the texture into which the shadows on the rings are baked
+    constexpr int BakedShadowResolution = 1024;
+
     constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
         "Enabled",
         "Enabled",
@@ -158,6 +168,17 @@ namespace {
         openspace::properties::Property::Visibility::Developer
     };
 
+    constexpr openspace::properties::Property::PropertyInfo BakeShadowsInfo = {
+        "BakeShadows",
+        "Bake Shadows",
+        "If this value is enabled, the shadow that is cast onto the rings is rendered "
+        "into a texture whenever the shadow map changes and is looked up from that "
+        "texture afterwards, rather than being filtered from the shadow map for every "
+        "rendered fragment of the rings. This is faster, but the sharpness of the shadow "
+        "is limited by the resolution of that texture.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(RingsComponent)]] Parameters {
         // [[codegen::verbatim(EnabledInfo.description)]]
         std::optional<bool> enabled;
@@ -200,6 +221,9 @@ namespace {
 
         // [[codegen::verbatim(NumberShadowSamplesInfo.description)]]
         std::optional<int> numberShadowSamples;
+
+        // [[codegen::verbatim(BakeShadowsInfo.description)]]
+        std::optional<bool> bakeShadows;
     };
 #include "ringscomponent_codegen.cpp"
 } // namespace
@@ -225,6 +249,7 @@ RingsComponent::RingsComponent(const ghoul::Dictionary& dictionary)
     , _enabled(EnabledInfo, true)
     , _zFightingPercentage(ZFightingPercentageInfo, 0.95f, 0.000001f, 1.f)
     , _nShadowSamples(NumberShadowSamplesInfo, 2, 1, 7)
+    , _bakeShadows(BakeShadowsInfo, false)
     // @TODO (abock, 2019-12-16) It would be better to not store the dictionary long
     // term and rather extract the values directly here.  This would require a bit of
     // a rewrite in the RenderableGlobe class to not create the RingsComponent in the
@@ -305,6 +330,7 @@ void RingsComponent::initialize() {
 
     _offset = p.offset.value_or(_offset);
     _offset.setViewOption(properties::Property::ViewOptions::MinMaxRange);
+    _offset.onChange([this]() { _planeIsDirty = true; });
     addProperty(_offset);
 
     _nightFactor = p.nightFactor.value_or(_nightFactor);
@@ -315,11 +341,16 @@ void RingsComponent::initialize() {
 
     // Shadow Mapping Quality Controls
     _zFightingPercentage = p.zFightingPercentage.value_or(_zFightingPercentage);
+    _zFightingPercentage.onChange([this]() { _bakedShadowVersion = std::nullopt; });
     addProperty(_zFightingPercentage);
 
     _nShadowSamples = p.numberShadowSamples.value_or(_nShadowSamples);
     _nShadowSamples.onChange([this]() { compileShadowShader(); });
     addProperty(_nShadowSamples);
+
+    _bakeShadows = p.bakeShadows.value_or(_bakeShadows);
+    _bakeShadows.onChange([this]() { _bakedShadowVersion = std::nullopt; });
+    addProperty(_bakeShadows);
 }
 
 bool RingsComponent::isReady() const {
@@ -346,19 +377,24 @@ void RingsComponent::initializeGL() {
         LERROR(e.message);
     }
 
-    glGenVertexArrays(1, &_quad);
+    glGenVertexArrays(1, &_vertexArray);
     glGenBuffers(1, &_vertexPositionBuffer);
 
     createPlane();
 }
 
 void RingsComponent::deinitializeGL() {
-    glDeleteVertexArrays(1, &_quad);
-    _quad = 0;
+    glDeleteVertexArrays(1, &_vertexArray);
+    _vertexArray = 0;
 
     glDeleteBuffers(1, &_vertexPositionBuffer);
     _vertexPositionBuffer = 0;
 
+    glDeleteFramebuffers(1, &_bakedShadowFbo);
+    _bakedShadowFbo = 0;
+    _bakedShadowTexture = nullptr;
+    _bakedShadowVersion = std::nullopt;
+
     _textureFile = nullptr;
     _texture = nullptr;
     _textureFileForwards = nullptr;
@@ -374,11 +410,29 @@ void RingsComponent::deinitializeGL() {
 
     global::renderEngine->removeRenderProgram(_geometryOnlyShader.get());
     _geometryOnlyShader = nullptr;
+
+    global::renderEngine->removeRenderProgram(_shadowBakeShader.get());
+    _shadowBakeShader = nullptr;
 }
 
 void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
                           const ShadowComponent::ShadowMapData& shadowData)
 {
+    const glm::dmat4 modelTransform =
+        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
+        glm::dmat4(data.modelTransform.rotation) *
+        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
+
+    // The baked shadows only have to be rendered again if the depth map changed, which
+    // the shadow component only does if the direction to the light source or the
+    // shadow casters changed by more than its threshold
+    const bool useBakedShadow = renderPass == RenderPass::GeometryAndShading &&
+        _bakeShadows && _shadowBakeShader && shadowData.shadowDepthTexture != 0;
+    if (useBakedShadow && _bakedShadowVersion != shadowData.depthMapVersion) {
+        bakeShadows(modelTransform, shadowData);
+        _bakedShadowVersion = shadowData.depthMapVersion;
+    }
+
     if (renderPass == RenderPass::GeometryAndShading) {
         _shader->activate();
     }
@@ -386,11 +440,6 @@ void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
         _geometryOnlyShader->activate();
     }
 
-    const glm::dmat4 modelTransform =
-        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
-        glm::dmat4(data.modelTransform.rotation) *
-        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
-
     const glm::dmat4 modelViewProjectionTransform =
         glm::dmat4(data.camera.projectionMatrix()) * data.camera.combinedViewMatrix()
         * modelTransform;
@@ -401,6 +450,7 @@ void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
     ghoul::opengl::TextureUnit ringTextureUnlitUnit;
     ghoul::opengl::TextureUnit ringTextureColorUnit;
     ghoul::opengl::TextureUnit ringTextureTransparencyUnit;
+    ghoul::opengl::TextureUnit bakedShadowUnit;
     if (renderPass == RenderPass::GeometryAndShading) {
         if (_isAdvancedTextureEnabled) {
             _shader->setUniform(
@@ -500,6 +550,19 @@ void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
                 shadowMapUnit
             );
 
+            bakedShadowUnit.activate();
+            if (useBakedShadow) {
+                _bakedShadowTexture->bind();
+            }
+            _shader->setUniform(
+                _uniformCacheAdvancedRings.bakedShadowTexture,
+                bakedShadowUnit
+            );
+            _shader->setUniform(
+                _uniformCacheAdvancedRings.useBakedShadow,
+                useBakedShadow
+            );
+
             glEnable(GL_DEPTH_TEST);
             glEnablei(GL_BLEND, 0);
             glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -536,6 +599,13 @@ void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
             shadowMapUnit.activate();
             glBindTexture(GL_TEXTURE_2D, shadowData.shadowDepthTexture);
             _shader->setUniform(_uniformCache.shadowMapTexture, shadowMapUnit);
+
+            bakedShadowUnit.activate();
+            if (useBakedShadow) {
+                _bakedShadowTexture->bind();
+            }
+            _shader->setUniform(_uniformCache.bakedShadowTexture, bakedShadowUnit);
+            _shader->setUniform(_uniformCache.useBakedShadow, useBakedShadow);
         }
 
         glEnable(GL_DEPTH_TEST);
@@ -563,8 +633,13 @@ void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
     glEnable(GL_DEPTH_TEST);
     glDisable(GL_CULL_FACE);
 
-    glBindVertexArray(_quad);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    const int level = meshLevel(data);
+    glBindVertexArray(_vertexArray);
+    glDrawArrays(
+        GL_TRIANGLE_STRIP,
+        _meshLevelOffsets[level],
+        _meshLevelOffsets[level + 1] - _meshLevelOffsets[level]
+    );
 
     glEnable(GL_CULL_FACE);
 
@@ -580,7 +655,9 @@ void RingsComponent::draw(const RenderData& data, RenderPass renderPass,
 void RingsComponent::update(const UpdateData& data) {
     ZoneScoped;
 
-    if (_shader && _shader->isDirty()) {
+    if ((_shader && _shader->isDirty()) ||
+        (_shadowBakeShader && _shadowBakeShader->isDirty()))
+    {
         compileShadowShader();
     }
 
@@ -617,6 +694,8 @@ void RingsComponent::loadTexture() {
     using namespace ghoul::io;
     using namespace ghoul::opengl;
 
+    _geometryVersion++;
+
     if (!_texturePath.value().empty()) {
         std::unique_ptr<Texture> texture = TextureReader::ref().loadTexture(
             absPath(_texturePath),
@@ -761,8 +840,14 @@ void RingsComponent::loadTexture() {
 }
 
 void RingsComponent::createPlane() {
+    _geometryVersion++;
+
     const GLfloat size = _size;
 
+    // The rings are only visible between these radii, given as a fraction of the size
+    const GLfloat innerRadius = std::clamp(_offset.value().x, 0.f, 1.f);
+    const GLfloat outerRadius = std::clamp(_offset.value().y, innerRadius, 1.f);
+
     struct VertexData {
         GLfloat x;
         GLfloat y;
@@ -770,18 +855,42 @@ void RingsComponent::createPlane() {
         GLfloat t;
     };
 
-    const std::array<VertexData, 6> vertices = {
-        VertexData{ -size, -size, 0.f, 0.f },
-        VertexData{  size,  size, 1.f, 1.f },
-        VertexData{ -size,  size, 0.f, 1.f },
-        VertexData{ -size, -size, 0.f, 0.f },
-        VertexData{  size, -size, 1.f, 0.f },
-        VertexData{  size,  size, 1.f, 1.f },
-    };
+    // Every level of detail is a triangle strip around the annulus of the rings. The
+    // outer polygon is circumscribed around the outer edge and the inner polygon is
+    // inscribed into the inner edge of the rings, so that every level covers the entire
+    // rings and the fragment shaders discard the rest, same as for the full plane
+    std::vector<VertexData> vertices;
+    for (int level = 0; level < NMeshLevels; level++) {
+        _meshLevelOffsets[level] = static_cast<GLint>(vertices.size());
+
+        const int nSegments = MinMeshSegments << level;
+        const GLfloat step = glm::two_pi<GLfloat>() / static_cast<GLfloat>(nSegments);
+        const GLfloat outer = outerRadius / std::cos(step / 2.f);
+        for (int i = 0; i <= nSegments; i++) {
+            // The last pair of vertices repeats the first to close the strip exactly
+            const GLfloat angle = step * static_cast<GLfloat>(i % nSegments);
+            const glm::vec2 direction = glm::vec2(std::cos(angle), std::sin(angle));
+            for (const GLfloat radius : { innerRadius, outer }) {
+                const glm::vec2 p = radius * direction;
+                vertices.push_back({
+                    size * p.x,
+                    size * p.y,
+                    0.5f + p.x / 2.f,
+                    0.5f + p.y / 2.f
+                });
+            }
+        }
+    }
+    _meshLevelOffsets[NMeshLevels] = static_cast<GLint>(vertices.size());
 
-    glBindVertexArray(_quad);
+    glBindVertexArray(_vertexArray);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        vertices.size() * sizeof(VertexData),
+        vertices.data(),
+        GL_STATIC_DRAW
+    );
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(
         0,
@@ -840,16 +949,138 @@ void RingsComponent::compileShadowShader() {
 
             ghoul::opengl::updateUniformLocations(*_shader, _uniformCache);
         }
+
+        global::renderEngine->removeRenderProgram(_shadowBakeShader.get());
+        _shadowBakeShader = global::renderEngine->buildRenderProgram(
+            "RingsShadowBakeProgram",
+            absPath("${MODULE_GLOBEBROWSING}/shaders/rings_shadowbake_vs.glsl"),
+            absPath("${MODULE_GLOBEBROWSING}/shaders/rings_shadowbake_fs.glsl"),
+            dict
+        );
+
+        ghoul::opengl::updateUniformLocations(*_shadowBakeShader, _bakeUniformCache);
     }
     catch (const ghoul::RuntimeError& e) {
         LERROR(e.message);
     }
+
+    _bakedShadowVersion = std::nullopt;
+}
+
+int RingsComponent::meshLevel(const RenderData& data) const {
+    const glm::dvec3& scale = data.modelTransform.scale;
+    const double radius = _size * std::max({ scale.x, scale.y, scale.z });
+    const double distance = glm::distance(
+        data.camera.positionVec3(),
+        data.modelTransform.translation
+    );
+    if (distance <= radius) {
+        // The camera is within the rings, so they can cover any part of the screen
+        return NMeshLevels - 1;
+    }
+
+    // Approximation of the radius of the rings on the screen in pixels
+    const double resolution = global::renderEngine->renderingResolution().y;
+    const double projectedRadius =
+        radius / distance * data.camera.projectionMatrix()[1][1] * resolution / 2.0;
+
+    // With n segments, the polygons deviate from the edges of the rings by at most
+    // r * (1 - cos(pi / n)), which is about r * pi^2 / (2 * n^2). Keeping the band of
+    // fragments that are discarded along the edges below half a pixel requires
+    // n >= pi * sqrt(r)
+    const double nSegments = std::max(
+        glm::pi<double>() * std::sqrt(std::max(projectedRadius, 0.0)),
+        static_cast<double>(MinMeshSegments)
+    );
+    const int level = static_cast<int>(std::ceil(std::log2(nSegments / MinMeshSegments)));
+    return std::min(level, NMeshLevels - 1);
+}
+
+void RingsComponent::bakeShadows(const glm::dmat4& modelTransform,
+                                 const ShadowComponent::ShadowMapData& shadowData)
+{
+    ZoneScoped;
+
+    if (!_bakedShadowTexture) {
+        _bakedShadowTexture = std::make_unique<ghoul::opengl::Texture>(
+            glm::uvec3(BakedShadowResolution, BakedShadowResolution, 1),
+            GL_TEXTURE_2D,
+            ghoul::opengl::Texture::Format::Red,
+            GL_R8,
+            GL_UNSIGNED_BYTE,
+            ghoul::opengl::Texture::FilterMode::Linear,
+            ghoul::opengl::Texture::WrappingMode::ClampToEdge,
+            ghoul::opengl::Texture::AllocateData::No,
+            ghoul::opengl::Texture::TakeOwnership::No
+        );
+        _bakedShadowTexture->uploadTexture();
+
+        glGenFramebuffers(1, &_bakedShadowFbo);
+    }
+
+    // Saves current state
+    GLint currentFbo = 0;
+    std::array<GLint, 4> viewport;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &currentFbo);
+    global::renderEngine->openglStateCache().viewport(viewport.data());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, _bakedShadowFbo);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, *_bakedShadowTexture, 0);
+    const GLenum textureBuffers = GL_COLOR_ATTACHMENT0;
+    glDrawBuffers(1, &textureBuffers);
+    glViewport(0, 0, BakedShadowResolution, BakedShadowResolution);
+
+    // Everything that is not covered by the ring mesh is not in shadow
+    glClearColor(1.f, 1.f, 1.f, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+
+    _shadowBakeShader->activate();
+    _shadowBakeShader->setUniform(
+        _bakeUniformCache.shadowMatrix,
+        shadowData.shadowMatrix * modelTransform
+    );
+    _shadowBakeShader->setUniform(
+        _bakeUniformCache.zFightingPercentage,
+        _zFightingPercentage
+    );
+
+    ghoul::opengl::TextureUnit shadowMapUnit;
+    shadowMapUnit.activate();
+    glBindTexture(GL_TEXTURE_2D, shadowData.shadowDepthTexture);
+    _shadowBakeShader->setUniform(_bakeUniformCache.shadowMapTexture, shadowMapUnit);
+
+    // The finest level is used as it covers the fewest texels that are never looked up
+    glBindVertexArray(_vertexArray);
+    glDrawArrays(
+        GL_TRIANGLE_STRIP,
+        _meshLevelOffsets[NMeshLevels - 1],
+        _meshLevelOffsets[NMeshLevels] - _meshLevelOffsets[NMeshLevels - 1]
+    );
+
+    _shadowBakeShader->deactivate();
+
+    // Restores system state
+    glBindFramebuffer(GL_FRAMEBUFFER, currentFbo);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    global::renderEngine->openglStateCache().resetColorState();
+    global::renderEngine->openglStateCache().resetBlendState();
+    global::renderEngine->openglStateCache().resetDepthState();
+    global::renderEngine->openglStateCache().resetPolygonAndClippingState();
+    global::renderEngine->openglStateCache().resetViewportState();
 }
 
 bool RingsComponent::isEnabled() const {
     return _enabled;
 }
 
+uint64_t RingsComponent::geometryVersion() const {
+    return _geometryVersion;
+}
+
 double RingsComponent::size() const {
     return _size;
 }
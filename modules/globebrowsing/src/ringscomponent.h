@@ -38,6 +38,8 @@
 #include <ghoul/glm.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <array>
+#include <optional>
 
 namespace ghoul { class Dictionary; }
 namespace ghoul::filesystem { class File; }
@@ -74,11 +76,35 @@ public:
     bool isEnabled() const;
     double size() const;
 
+    /**
+     * Returns a number that changes every time the rings change in a way that affects the
+     * shadows they cast, which is used to decide when shadow maps have to be updated.
+     */
+    uint64_t geometryVersion() const;
+
 private:
+    /// The number of levels of detail of the ring mesh
+    static constexpr int NMeshLevels = 6;
+
     void loadTexture();
     void createPlane();
     void compileShadowShader();
 
+    /**
+     * Returns the level of detail of the ring mesh that is needed for the rings to be
+     * rendered with \p data. Coarser levels only cause more fragments to be discarded
+     * around the edges of the rings, the rendered image is the same for all levels.
+     */
+    int meshLevel(const RenderData& data) const;
+
+    /**
+     * Renders the shadow that is cast onto the rings from the depth map in \p shadowData
+     * into the baked shadow texture, which covers the ring plane using the same texture
+     * coordinates as the ring mesh.
+     */
+    void bakeShadows(const glm::dmat4& modelTransform,
+        const ShadowComponent::ShadowMapData& shadowData);
+
     properties::StringProperty _texturePath;
     properties::StringProperty _textureFwrdPath;
     properties::StringProperty _textureBckwrdPath;
@@ -92,19 +118,23 @@ private:
     properties::BoolProperty _enabled;
     properties::FloatProperty _zFightingPercentage;
     properties::IntProperty _nShadowSamples;
+    properties::BoolProperty _bakeShadows;
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _shader;
     std::unique_ptr<ghoul::opengl::ProgramObject> _geometryOnlyShader;
+    std::unique_ptr<ghoul::opengl::ProgramObject> _shadowBakeShader;
     UniformCache(modelViewProjectionMatrix, textureOffset, colorFilterValue, nightFactor,
         sunPosition, ringTexture, shadowMatrix, shadowMapTexture, zFightingPercentage,
-        opacity
+        opacity, useBakedShadow, bakedShadowTexture
     ) _uniformCache;
     UniformCache(modelViewProjectionMatrix, textureOffset, colorFilterValue, nightFactor,
         sunPosition, sunPositionObj, camPositionObj, ringTextureFwrd, ringTextureBckwrd,
         ringTextureUnlit, ringTextureColor, ringTextureTransparency, shadowMatrix,
-        shadowMapTexture, zFightingPercentage, opacity
+        shadowMapTexture, zFightingPercentage, opacity, useBakedShadow,
+        bakedShadowTexture
     ) _uniformCacheAdvancedRings;
     UniformCache(modelViewProjectionMatrix, textureOffset, ringTexture) _geomUniformCache;
+    UniformCache(shadowMatrix, shadowMapTexture, zFightingPercentage) _bakeUniformCache;
 
     std::unique_ptr<ghoul::opengl::Texture> _texture;
     std::unique_ptr<ghoul::opengl::Texture> _textureForwards;
@@ -122,9 +152,20 @@ private:
     ghoul::Dictionary _ringsDictionary;
     bool _textureIsDirty = false;
     bool _isAdvancedTextureEnabled = false;
-    GLuint _quad = 0;
+    GLuint _vertexArray = 0;
     GLuint _vertexPositionBuffer = 0;
     bool _planeIsDirty = false;
+    uint64_t _geometryVersion = 0;
+
+    /// The first vertex of each level of the ring mesh, followed by the total number of
+    /// vertices. Each level is a triangle strip that covers the annulus of the rings
+    std::array<GLint, NMeshLevels + 1> _meshLevelOffsets = {};
+
+    std::unique_ptr<ghoul::opengl::Texture> _bakedShadowTexture;
+    GLuint _bakedShadowFbo = 0;
+    /// The version of the shadow depth map that the baked shadow texture was rendered
+    /// from, or std::nullopt if the baked shadow texture has to be rendered again
+    std::optional<uint64_t> _bakedShadowVersion;
 
     glm::vec3 _sunPosition = glm::vec3(0.f);
     glm::vec3 _camPositionObjectSpace = glm::vec3(0.f);
@@ -91,6 +91,34 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo CacheDepthMapInfo = {
+        "CacheDepthMap",
+        "Cache Depth Map",
+        "If enabled, the depth map is only rendered again when the direction to the "
+        "light source or the orientation of the shadow casters changed by more than the "
+        "angular threshold, or when the shadow casting geometry changed. Otherwise the "
+        "depth map of a previous frame is reused.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo AngularThresholdInfo = {
+        "AngularThreshold",
+        "Angular Threshold",
+        "The angle (in degrees) by which the direction to the light source or the "
+        "orientation of the shadow casters has to change before a cached depth map is "
+        "rendered again.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MaxCachedFramesInfo = {
+        "MaximumCachedFrames",
+        "Maximum Cached Frames",
+        "The maximum number of frames for which a cached depth map is reused, so that "
+        "changes in the level of detail of the shadow casters eventually show up in the "
+        "shadows. If this value is 0, the depth map is reused indefinitely.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr std::array<GLfloat, 4> ShadowBorder = { 1.f, 1.f, 1.f, 1.f };
 
     void checkFrameBufferState(const std::string& codePosition) {
@@ -164,6 +192,15 @@ namespace {
 
         // [[codegen::verbatim(DepthMapSizeInfo.description)]]
         std::optional<glm::ivec2> depthMapSize [[codegen::greater({ 1280, 720 })]];
+
+        // [[codegen::verbatim(CacheDepthMapInfo.description)]]
+        std::optional<bool> cacheDepthMap;
+
+        // [[codegen::verbatim(AngularThresholdInfo.description)]]
+        std::optional<float> angularThreshold [[codegen::inrange(0.0, 10.0)]];
+
+        // [[codegen::verbatim(MaxCachedFramesInfo.description)]]
+        std::optional<int> maximumCachedFrames [[codegen::greaterequal(0)]];
     };
 #include "shadowcomponent_codegen.cpp"
 } // namespace
@@ -179,6 +216,9 @@ ShadowComponent::ShadowComponent(const ghoul::Dictionary& dictionary)
     , _saveDepthTexture(SaveDepthTextureInfo)
     , _distanceFraction(DistanceFractionInfo, 20, 1, 10000)
     , _enabled(EnabledInfo, true)
+    , _cacheDepthMap(CacheDepthMapInfo, true)
+    , _angularThreshold(AngularThresholdInfo, 0.05f, 0.f, 10.f)
+    , _maxCachedFrames(MaxCachedFramesInfo, 300, 0, 10000)
 {
     using ghoul::filesystem::File;
 
@@ -188,11 +228,22 @@ ShadowComponent::ShadowComponent(const ghoul::Dictionary& dictionary)
     // this state anyway?
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
+    _enabled.onChange([this]() { _hasValidDepthMap = false; });
     addProperty(_enabled);
 
     _distanceFraction = p.distanceFraction.value_or(_distanceFraction);
+    _distanceFraction.onChange([this]() { _hasValidDepthMap = false; });
     addProperty(_distanceFraction);
 
+    _cacheDepthMap = p.cacheDepthMap.value_or(_cacheDepthMap);
+    addProperty(_cacheDepthMap);
+
+    _angularThreshold = p.angularThreshold.value_or(_angularThreshold);
+    addProperty(_angularThreshold);
+
+    _maxCachedFrames = p.maximumCachedFrames.value_or(_maxCachedFrames);
+    addProperty(_maxCachedFrames);
+
     _saveDepthTexture.onChange([this]() { _executeDepthTextureSave = true; });
 
     if (p.depthMapSize.has_value()) {
@@ -232,7 +283,9 @@ void ShadowComponent::deinitializeGL() {
     glDeleteFramebuffers(1, &_shadowFBO);
 }
 
-RenderData ShadowComponent::begin(const RenderData& data) {
+bool ShadowComponent::prepare(const RenderData& data, uint64_t casterVersion) {
+    ZoneScoped;
+
     const glm::ivec2 renderingResolution = global::renderEngine->renderingResolution();
     if (_dynamicDepthTextureRes && ((_shadowDepthTextureWidth != renderingResolution.x) ||
         (_shadowDepthTextureHeight != renderingResolution.y)))
@@ -240,29 +293,77 @@ RenderData ShadowComponent::begin(const RenderData& data) {
         _shadowDepthTextureWidth = renderingResolution.x * 2;
         _shadowDepthTextureHeight = renderingResolution.y * 2;
         updateDepthTexture();
+        _hasValidDepthMap = false;
     }
 
-    // ===========================================
-    // Builds light's ModelViewProjectionMatrix:
-    // ===========================================
-
     const glm::dvec3 diffVector =
         glm::dvec3(_sunPosition) - data.modelTransform.translation;
     const double originalLightDistance = glm::length(diffVector);
     const glm::dvec3 lightDirection = glm::normalize(diffVector);
 
-    // Percentage of the original light source distance (to avoid artifacts)
-    //double multiplier = originalLightDistance *
-    //    (static_cast<double>(_distanceFraction)/1.0E5);
+    // The light camera inherits the projection and the view offset of the rendering
+    // camera, so a change in any of those also changes the content of the depth map
+    const glm::dmat4 eyeTransform =
+        glm::dmat4(data.camera.sgctInternal.projectionMatrix()) *
+        glm::dmat4(data.camera.sgctInternal.viewMatrix()) *
+        data.camera.viewScaleMatrix();
+
+    // Instead of comparing the angle between the old and new directions against the
+    // threshold, the cosines are compared. For the rotation, this is the cosine of the
+    // angle of the relative rotation between the old and new orientation
+    const double cosThreshold = std::cos(glm::radians(
+        static_cast<double>(_angularThreshold)
+    ));
+    const glm::dmat3 relativeRotation =
+        glm::transpose(_depthMapState.casterRotation) * data.modelTransform.rotation;
+    const double cosRotation =
+        (relativeRotation[0][0] + relativeRotation[1][1] + relativeRotation[2][2] - 1.0) /
+        2.0;
+
+    const bool canReuse =
+        _cacheDepthMap && _hasValidDepthMap &&
+        casterVersion == _depthMapState.casterVersion &&
+        eyeTransform == _depthMapState.eyeTransform &&
+        data.modelTransform.scale == _depthMapState.casterScale &&
+        glm::dot(lightDirection, _depthMapState.lightDirection) >= cosThreshold &&
+        cosRotation >= cosThreshold &&
+        (_maxCachedFrames == 0 || _depthMapState.nCachedFrames < _maxCachedFrames);
+
+    if (canReuse) {
+        _depthMapState.nCachedFrames++;
+    }
+    else {
+        // Percentage of the original light source distance (to avoid artifacts)
+        //double multiplier = originalLightDistance *
+        //    (static_cast<double>(_distanceFraction)/1.0E5);
+
+        const double multiplier = originalLightDistance *
+            (static_cast<double>(_distanceFraction) / 1E17);
+
+        _depthMapState.lightDirection = lightDirection;
+        _depthMapState.lightOffset = diffVector * multiplier;
+        _depthMapState.casterRotation = data.modelTransform.rotation;
+        _depthMapState.casterScale = data.modelTransform.scale;
+        _depthMapState.eyeTransform = eyeTransform;
+        _depthMapState.casterVersion = casterVersion;
+        _depthMapState.nCachedFrames = 0;
+        _hasValidDepthMap = true;
+        _shadowData.depthMapVersion++;
+    }
+
+    // ===========================================
+    // Builds light's ModelViewProjectionMatrix:
+    // ===========================================
 
-    const double multiplier = originalLightDistance *
-        (static_cast<double>(_distanceFraction) / 1E17);
+    // The light camera is always placed relative to the current position of the shadow
+    // caster, so that a cached depth map also stays valid while the caster moves. Only
+    // the direction and distance to the light source are taken from the cached state
 
     // New light source position
     //glm::dvec3 lightPosition = data.modelTransform.translation +
     //    (lightDirection * multiplier);
-    const glm::dvec3 lightPosition = data.modelTransform.translation +
-        (diffVector * multiplier);
+    const glm::dvec3 lightPosition =
+        data.modelTransform.translation + _depthMapState.lightOffset;
 
     //// Light Position
     //glm::dvec3 lightPosition = glm::dvec3(_sunPosition);
@@ -270,7 +371,7 @@ RenderData ShadowComponent::begin(const RenderData& data) {
     //=============== Manually Created Camera Matrix ===================
     //==================================================================
     // camera Z
-    const glm::dvec3 cameraZ = lightDirection;
+    const glm::dvec3 cameraZ = _depthMapState.lightDirection;
 
     // camera X
     const glm::dvec3 upVector = glm::dvec3(0.0, 1.0, 0.0);
@@ -318,6 +419,11 @@ RenderData ShadowComponent::begin(const RenderData& data) {
         ToTextureCoordsMatrix * lightProjectionMatrix *
         _lightCamera->combinedViewMatrix();
 
+    return !canReuse;
+}
+
+RenderData ShadowComponent::begin(const RenderData& data) {
+    ZoneScoped;
 
     // Saves current state
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_currentFBO);
@@ -342,8 +448,10 @@ RenderData ShadowComponent::begin(const RenderData& data) {
     //glPolygonOffset(2.5f, 10.f);
     //checkGLError("begin() -- set values for polygon offset");
 
+    _lightCameraSnapshot = CameraSnapshot(*_lightCamera);
     RenderData lightRenderData{
         *_lightCamera,
+        _lightCameraSnapshot,
         data.time,
         data.renderBinMask,
         data.modelTransform
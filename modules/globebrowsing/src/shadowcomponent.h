@@ -28,6 +28,7 @@
 #include <openspace/properties/propertyowner.h>
 
 #include <openspace/camera/camera.h>
+#include <openspace/camera/camerasnapshot.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
@@ -56,6 +57,8 @@ public:
     struct ShadowMapData {
         glm::dmat4 shadowMatrix = glm::dmat4(1.0);
         GLuint shadowDepthTexture = 0;
+        /// Increases every time the content of the shadow depth map changes
+        uint64_t depthMapVersion = 0;
     };
 
     explicit ShadowComponent(const ghoul::Dictionary& dictionary);
@@ -66,6 +69,16 @@ public:
 
     bool isReady() const;
 
+    /**
+     * Updates the light camera and the shadow matrix for the current frame. Returns
+     * whether the shadow depth map has to be rendered again, or whether the depth map of
+     * a previous frame can be reused since neither the direction to the light source nor
+     * the shadow caster moved by more than the thresholds. The \p casterVersion has to
+     * change whenever the shadow casting geometry changed in a way that is not reflected
+     * by the model transformation of \p data.
+     */
+    bool prepare(const RenderData& data, uint64_t casterVersion);
+
     RenderData begin(const RenderData& data);
     void end();
     void update(const UpdateData& data);
@@ -93,6 +106,9 @@ private:
     properties::TriggerProperty _saveDepthTexture;
     properties::IntProperty _distanceFraction;
     properties::BoolProperty _enabled;
+    properties::BoolProperty _cacheDepthMap;
+    properties::FloatProperty _angularThreshold;
+    properties::IntProperty _maxCachedFrames;
 
     int _shadowDepthTextureHeight = 4096;
     int _shadowDepthTextureWidth = 4096;
@@ -123,6 +139,19 @@ private:
     std::stringstream _serializedCamera;
 
     std::unique_ptr<Camera> _lightCamera;
+    CameraSnapshot _lightCameraSnapshot;
+
+    /// The state for which the current content of the depth map was rendered
+    struct {
+        glm::dvec3 lightDirection = glm::dvec3(0.0);
+        glm::dvec3 lightOffset = glm::dvec3(0.0);
+        glm::dmat3 casterRotation = glm::dmat3(1.0);
+        glm::dvec3 casterScale = glm::dvec3(1.0);
+        glm::dmat4 eyeTransform = glm::dmat4(1.0);
+        uint64_t casterVersion = 0;
+        int nCachedFrames = 0;
+    } _depthMapState;
+    bool _hasValidDepthMap = false;
 
     // DEBUG
     bool _executeDepthTextureSave = false;
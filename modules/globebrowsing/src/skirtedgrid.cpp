@@ -26,6 +26,7 @@
 
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <algorithm>
 
 namespace {
     size_t numElements(int xSegments, int ySegments) {
@@ -103,6 +104,17 @@ namespace {
         return textureCoordinates;
     }
 
+    // The layout is defined by the OpenGL specification of glMultiDrawElementsIndirect
+    struct DrawElementsIndirectCommand {
+        GLuint count = 0;
+        GLuint instanceCount = 0;
+        GLuint firstIndex = 0;
+        GLint baseVertex = 0;
+        GLuint baseInstance = 0;
+    };
+
+    constexpr GLuint DrawIndexAttribute = 2;
+
 } // namespace
 
 namespace openspace::globebrowsing {
@@ -168,7 +180,12 @@ void SkirtedGrid::initializeGL() {
 void SkirtedGrid::deinitializeGL() {
     glDeleteBuffers(1, &_vertexBufferID);
     glDeleteBuffers(1, &_elementBufferID);
+    glDeleteBuffers(1, &_indirectBufferID);
+    glDeleteBuffers(1, &_drawIndexBufferID);
     glDeleteVertexArrays(1, &_vaoID);
+    _indirectBufferID = 0;
+    _drawIndexBufferID = 0;
+    _indirectDrawCapacity = 0;
 }
 
 void SkirtedGrid::drawUsingActiveProgram() const {
@@ -178,4 +195,76 @@ void SkirtedGrid::drawUsingActiveProgram() const {
     glBindVertexArray(0);
 }
 
+void SkirtedGrid::drawMultiIndirectUsingActiveProgram(GLsizei drawCount) {
+    if (drawCount <= 0) {
+        return;
+    }
+
+    ensureIndirectDrawCapacity(drawCount);
+
+    glBindVertexArray(_vaoID);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _elementBufferID);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBufferID);
+    glMultiDrawElementsIndirect(
+        GL_TRIANGLES,
+        GL_UNSIGNED_SHORT,
+        nullptr,
+        drawCount,
+        0
+    );
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void SkirtedGrid::ensureIndirectDrawCapacity(GLsizei drawCount) {
+    if (drawCount <= _indirectDrawCapacity) {
+        return;
+    }
+
+    // Grow geometrically to not reallocate every time a few more chunks are visible
+    _indirectDrawCapacity = std::max(drawCount, 2 * _indirectDrawCapacity);
+
+    // All draws use the same geometry and only differ in their base instance, which
+    // selects the value of the draw index attribute for that draw
+    std::vector<DrawElementsIndirectCommand> commands(_indirectDrawCapacity);
+    std::vector<GLint> drawIndices(_indirectDrawCapacity);
+    for (GLsizei i = 0; i < _indirectDrawCapacity; i++) {
+        commands[i].count = static_cast<GLuint>(_elementSize);
+        commands[i].instanceCount = 1;
+        commands[i].baseInstance = static_cast<GLuint>(i);
+        drawIndices[i] = i;
+    }
+
+    if (_indirectBufferID == 0) {
+        glGenBuffers(1, &_indirectBufferID);
+        glGenBuffers(1, &_drawIndexBufferID);
+    }
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBufferID);
+    glBufferData(
+        GL_DRAW_INDIRECT_BUFFER,
+        commands.size() * sizeof(DrawElementsIndirectCommand),
+        commands.data(),
+        GL_STATIC_DRAW
+    );
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    glBindVertexArray(_vaoID);
+    glBindBuffer(GL_ARRAY_BUFFER, _drawIndexBufferID);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        drawIndices.size() * sizeof(GLint),
+        drawIndices.data(),
+        GL_STATIC_DRAW
+    );
+
+    // Draw index at location 2, advancing once per instance instead of once per vertex
+    glEnableVertexAttribArray(DrawIndexAttribute);
+    glVertexAttribIPointer(DrawIndexAttribute, 1, GL_INT, sizeof(GLint), nullptr);
+    glVertexAttribDivisor(DrawIndexAttribute, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 } // namespace openspace::globebrowsing
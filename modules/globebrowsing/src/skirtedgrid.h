@@ -57,14 +57,33 @@ public:
      */
     void drawUsingActiveProgram() const;
 
+    /**
+     * Draws the grid \p drawCount times with a single call to
+     * `glMultiDrawElementsIndirect` using the current bound program object. In addition
+     * to the attributes described in #drawUsingActiveProgram, each draw receives its
+     * index in the range [0, \p drawCount) through the integer vertex attribute at input
+     * location 2, which the shader program can use to look up per-draw data.
+     */
+    void drawMultiIndirectUsingActiveProgram(GLsizei drawCount);
+
     const int xSegments;
     const int ySegments;
 
 private:
+    /**
+     * Makes sure that the indirect draw commands and the draw index attribute cover at
+     * least \p drawCount draws.
+     */
+    void ensureIndirectDrawCapacity(GLsizei drawCount);
+
     GLuint _vaoID = 0;
     GLuint _vertexBufferID = 0;
     GLuint _elementBufferID = 0;
     const GLsizei _elementSize;
+
+    GLuint _indirectBufferID = 0;
+    GLuint _drawIndexBufferID = 0;
+    GLsizei _indirectDrawCapacity = 0;
 };
 
 } // namespace openspace::globebrowsing
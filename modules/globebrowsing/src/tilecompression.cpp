@@ -0,0 +1,235 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/tilecompression.h>
+
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // Number of bytes of a single 4x4 BC3 block; 8 bytes each for alpha and color
+    constexpr size_t BlockSize = 16;
+
+    using Block = std::array<glm::u8vec4, 16>;
+
+    uint16_t toRgb565(const glm::ivec3& c) {
+        const int r = (c.r * 31 + 127) / 255;
+        const int g = (c.g * 63 + 127) / 255;
+        const int b = (c.b * 31 + 127) / 255;
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    glm::ivec3 fromRgb565(uint16_t c) {
+        const int r = (c >> 11) & 31;
+        const int g = (c >> 5) & 63;
+        const int b = c & 31;
+        return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+    }
+
+    void writeLittleEndian(std::byte* destination, uint64_t value, int nBytes) {
+        for (int i = 0; i < nBytes; i++) {
+            destination[i] = static_cast<std::byte>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void compressAlphaBlock(const Block& block, std::byte* destination) {
+        uint8_t maxAlpha = 0;
+        uint8_t minAlpha = 255;
+        for (const glm::u8vec4& p : block) {
+            maxAlpha = std::max(maxAlpha, p.a);
+            minAlpha = std::min(minAlpha, p.a);
+        }
+
+        // With the first endpoint larger than the second, the six remaining palette
+        // entries are interpolated between them in steps of 1/7
+        uint64_t indices = 0;
+        if (maxAlpha > minAlpha) {
+            const int range = maxAlpha - minAlpha;
+            for (size_t i = 0; i < block.size(); i++) {
+                const int step = ((maxAlpha - block[i].a) * 7 + range / 2) / range;
+                const int index = step == 0 ? 0 : (step == 7 ? 1 : step + 1);
+                indices |= static_cast<uint64_t>(index) << (3 * i);
+            }
+        }
+
+        destination[0] = static_cast<std::byte>(maxAlpha);
+        destination[1] = static_cast<std::byte>(minAlpha);
+        writeLittleEndian(destination + 2, indices, 6);
+    }
+
+    void compressColorBlock(const Block& block, std::byte* destination) {
+        glm::ivec3 minColor = glm::ivec3(255);
+        glm::ivec3 maxColor = glm::ivec3(0);
+        for (const glm::u8vec4& p : block) {
+            minColor = glm::min(minColor, glm::ivec3(p.r, p.g, p.b));
+            maxColor = glm::max(maxColor, glm::ivec3(p.r, p.g, p.b));
+        }
+
+        // Insetting the bounding box slightly reduces the error of the colors that are
+        // interpolated between the two endpoints
+        const glm::ivec3 inset = (maxColor - minColor) / 16;
+        minColor += inset;
+        maxColor -= inset;
+
+        // As every channel of the maximum color is at least as large as the minimum, the
+        // first endpoint is never smaller than the second one, which selects the four
+        // color mode of the block
+        const uint16_t c0 = toRgb565(maxColor);
+        const uint16_t c1 = toRgb565(minColor);
+
+        uint32_t indices = 0;
+        if (c0 != c1) {
+            const glm::ivec3 p0 = fromRgb565(c0);
+            const glm::ivec3 p1 = fromRgb565(c1);
+            const std::array<glm::ivec3, 4> palette = {
+                p0,
+                p1,
+                (2 * p0 + p1) / 3,
+                (p0 + 2 * p1) / 3
+            };
+
+            for (size_t i = 0; i < block.size(); i++) {
+                const glm::ivec3 c = glm::ivec3(block[i].r, block[i].g, block[i].b);
+                uint32_t bestIndex = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+                for (uint32_t j = 0; j < palette.size(); j++) {
+                    const glm::ivec3 d = c - palette[j];
+                    const int distance = d.r * d.r + d.g * d.g + d.b * d.b;
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestIndex = j;
+                    }
+                }
+                indices |= bestIndex << (2 * i);
+            }
+        }
+
+        writeLittleEndian(destination, c0, 2);
+        writeLittleEndian(destination + 2, c1, 2);
+        writeLittleEndian(destination + 4, indices, 4);
+    }
+
+    void compressLevel(const std::vector<glm::u8vec4>& pixels, const glm::ivec2& size,
+                       std::byte* destination)
+    {
+        const int nBlocksX = (size.x + 3) / 4;
+        const int nBlocksY = (size.y + 3) / 4;
+        for (int by = 0; by < nBlocksY; by++) {
+            for (int bx = 0; bx < nBlocksX; bx++) {
+                // Blocks that extend past the edge of the image are padded by repeating
+                // the last row and column
+                Block block;
+                for (int y = 0; y < 4; y++) {
+                    const int py = std::min(by * 4 + y, size.y - 1);
+                    for (int x = 0; x < 4; x++) {
+                        const int px = std::min(bx * 4 + x, size.x - 1);
+                        block[y * 4 + x] = pixels[py * size.x + px];
+                    }
+                }
+
+                compressAlphaBlock(block, destination);
+                compressColorBlock(block, destination + 8);
+                destination += BlockSize;
+            }
+        }
+    }
+
+    std::vector<glm::u8vec4> downsample(const std::vector<glm::u8vec4>& pixels,
+                                        const glm::ivec2& size)
+    {
+        const glm::ivec2 newSize = glm::max(size / 2, glm::ivec2(1));
+        std::vector<glm::u8vec4> result(static_cast<size_t>(newSize.x) * newSize.y);
+        for (int y = 0; y < newSize.y; y++) {
+            const int y0 = std::min(2 * y, size.y - 1);
+            const int y1 = std::min(2 * y + 1, size.y - 1);
+            for (int x = 0; x < newSize.x; x++) {
+                const int x0 = std::min(2 * x, size.x - 1);
+                const int x1 = std::min(2 * x + 1, size.x - 1);
+                const glm::ivec4 sum =
+                    glm::ivec4(pixels[y0 * size.x + x0]) +
+                    glm::ivec4(pixels[y0 * size.x + x1]) +
+                    glm::ivec4(pixels[y1 * size.x + x0]) +
+                    glm::ivec4(pixels[y1 * size.x + x1]);
+                result[y * newSize.x + x] = glm::u8vec4((sum + 2) / 4);
+            }
+        }
+        return result;
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+std::vector<size_t> compressedMipLevelSizes(glm::ivec2 size) {
+    std::vector<size_t> sizes;
+    while (true) {
+        const size_t nBlocks = static_cast<size_t>((size.x + 3) / 4) * ((size.y + 3) / 4);
+        sizes.push_back(nBlocks * BlockSize);
+        if (size.x == 1 && size.y == 1) {
+            break;
+        }
+        size = glm::max(size / 2, glm::ivec2(1));
+    }
+    return sizes;
+}
+
+std::unique_ptr<std::byte[]> compressToBC3(const std::byte* pixels, glm::ivec2 size,
+                                           bool isBGRA)
+{
+    ZoneScoped;
+
+    std::vector<glm::u8vec4> level(static_cast<size_t>(size.x) * size.y);
+    for (size_t i = 0; i < level.size(); i++) {
+        const std::byte* p = pixels + 4 * i;
+        level[i] = glm::u8vec4(
+            static_cast<uint8_t>(isBGRA ? p[2] : p[0]),
+            static_cast<uint8_t>(p[1]),
+            static_cast<uint8_t>(isBGRA ? p[0] : p[2]),
+            static_cast<uint8_t>(p[3])
+        );
+    }
+
+    const std::vector<size_t> levelSizes = compressedMipLevelSizes(size);
+    const size_t totalSize = std::accumulate(levelSizes.begin(), levelSizes.end(), 0ULL);
+    std::unique_ptr<std::byte[]> result = std::make_unique<std::byte[]>(totalSize);
+
+    // Compressed textures can't make use of glGenerateMipmap, so the mip levels are
+    // created here by successively averaging 2x2 pixels of the previous level
+    std::byte* destination = result.get();
+    for (size_t i = 0; i < levelSizes.size(); i++) {
+        compressLevel(level, size, destination);
+        destination += levelSizes[i];
+        if (i + 1 < levelSizes.size()) {
+            level = downsample(level, size);
+            size = glm::max(size / 2, glm::ivec2(1));
+        }
+    }
+
+    return result;
+}
+
+} // namespace openspace::globebrowsing
@@ -22,74 +22,40 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___LRU_THREAD_POOL___H__
-#define __OPENSPACE_MODULE_GLOBEBROWSING___LRU_THREAD_POOL___H__
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___TILE_COMPRESSION___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___TILE_COMPRESSION___H__
 
-#include <modules/globebrowsing/src/lrucache.h>
-#include <condition_variable>
-#include <functional>
-#include <mutex>
-#include <thread>
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
-// Implementation based on http://progsch.net/wordpress/?p=81
-
 namespace openspace::globebrowsing {
 
-template<typename KeyType> class LRUThreadPool;
-
-template<typename KeyType>
-class LRUThreadPoolWorker {
-public:
-    LRUThreadPoolWorker(LRUThreadPool<KeyType>& pool);
-    void operator()();
-
-private:
-    LRUThreadPool<KeyType>& _pool;
-};
+/// The OpenGL internal format that is used for compressed tile textures
+constexpr GLenum CompressedTileFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
 
 /**
- * The `LRUThreadPool` will only enqueue a certain number of tasks. The most recently
- * enqueued task is the one that will be executed first. This class is templated on a key
- * type which used as an identifier to determine wheter or not a task with the given key
- * has been enqueued or not. This means that a task can be enqueued several times. The
- * user must ensure that an enqueued task with a given key should be equal in outcome to a
- * second enqueued task with the same key. This is because a second enqueued task with the
- * same key will simply be bumped and prioritised before other enqueued tasks. The given
- * task will be ignored.
+ * Returns the number of bytes of each mip level of a compressed tile texture of the
+ * provided \p size. The first entry is the full resolution level and the last entry is
+ * the 1x1 level.
  */
-template<typename KeyType>
-class LRUThreadPool {
-public:
-    LRUThreadPool(size_t numThreads, size_t queueSize);
-    LRUThreadPool(const LRUThreadPool& toCopy);
-    ~LRUThreadPool();
-
-    void enqueue(std::function<void()> f, KeyType key);
-    bool touch(KeyType key);
-    std::vector<KeyType> getQueuedTasksKeys();
-    std::vector<KeyType> getUnqueuedTasksKeys();
-    void clearEnqueuedTasks();
-
-private:
-    struct DefaultHasher {
-        unsigned long long operator()(const KeyType& key) const {
-            return static_cast<unsigned long long>(key);
-        }
-    };
-    friend class LRUThreadPoolWorker<KeyType>;
+std::vector<size_t> compressedMipLevelSizes(glm::ivec2 size);
 
-    std::vector<std::thread> _workers;
-    cache::LRUCache<KeyType, std::function<void()>, DefaultHasher> _queuedTasks;
-    std::vector<KeyType> _unqueuedTasks;
-    std::mutex _queueMutex;
-    std::condition_variable _condition;
-
-    bool _stop = false;
-};
+/**
+ * Compresses the 8-bit four channel image \p pixels of the provided \p size into the BC3
+ * (DXT5) block compression format. The result contains the full mip chain of the image,
+ * starting with the full resolution level, with the layout described by
+ * #compressedMipLevelSizes. If \p isBGRA is `true`, the color channels of the input are
+ * in BGRA order, otherwise in RGBA order.
+ *
+ * This function does not use any OpenGL functionality and is safe to call from any
+ * thread.
+ */
+std::unique_ptr<std::byte[]> compressToBC3(const std::byte* pixels, glm::ivec2 size,
+    bool isBGRA);
 
 } // namespace openspace::globebrowsing
 
-#include "lruthreadpool.inl"
-
-#endif // __OPENSPACE_MODULE_GLOBEBROWSING___LRU_THREAD_POOL___H__
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___TILE_COMPRESSION___H__
@@ -0,0 +1,306 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/tileioscheduler.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+
+namespace openspace::globebrowsing {
+
+TileIOScheduler::TileIOScheduler(size_t nThreads, size_t queueSizePerClient)
+    : _queueSizePerClient(queueSizePerClient)
+{
+    ghoul_assert(nThreads > 0, "Need at least one thread");
+    ghoul_assert(queueSizePerClient > 0, "Need room for at least one job per client");
+
+    for (size_t i = 0; i < nThreads; i++) {
+        _workers.emplace_back([this]() { work(); });
+    }
+}
+
+TileIOScheduler::~TileIOScheduler() {
+    {
+        std::unique_lock lock(_mutex);
+        _stop = true;
+    }
+    _taskAvailable.notify_all();
+
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+TileIOScheduler::ClientId TileIOScheduler::addClient(size_t maxConcurrentJobs) {
+    ghoul_assert(maxConcurrentJobs > 0, "Need to allow at least one concurrent job");
+
+    std::unique_lock lock(_mutex);
+    const ClientId id = _nextClientId++;
+    _clients[id].maxConcurrentJobs = maxConcurrentJobs;
+    return id;
+}
+
+void TileIOScheduler::removeClient(ClientId client) {
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    std::erase_if(_tasks, [client](const Task& task) { return task.client == client; });
+    _taskFinished.wait(lock, [this, client]() {
+        return _clients[client].nRunningJobs == 0;
+    });
+    _clients.erase(client);
+}
+
+void TileIOScheduler::enqueue(ClientId client, Key key, std::function<void()> job) {
+    {
+        std::unique_lock lock(_mutex);
+        Client& c = _clients[client];
+
+        const size_t i = findTask(client, key);
+        if (i < _tasks.size()) {
+            // The same job is already waiting, so we only bump it
+            _tasks[i].job = std::move(job);
+            _tasks[i].sequence = ++_sequence;
+            _tasks[i].isLowPriority = false;
+        }
+        else {
+            _tasks.push_back(Task {
+                .client = client,
+                .key = key,
+                .job = std::move(job),
+                .sequence = ++_sequence,
+                .enqueueTime = std::chrono::steady_clock::now()
+            });
+            c.nWaitingJobs++;
+        }
+
+        // Drop the client's oldest waiting jobs if it has too many of them. Low priority
+        // jobs are always dropped before the regular ones
+        while (c.nWaitingJobs > _queueSizePerClient) {
+            auto oldest = _tasks.end();
+            for (auto it = _tasks.begin(); it != _tasks.end(); it++) {
+                if (it->client != client) {
+                    continue;
+                }
+                if (oldest == _tasks.end() ||
+                    (it->isLowPriority && !oldest->isLowPriority) ||
+                    (it->isLowPriority == oldest->isLowPriority &&
+                     it->sequence < oldest->sequence))
+                {
+                    oldest = it;
+                }
+            }
+            ghoul_assert(oldest != _tasks.end(), "Client must have waiting jobs");
+            c.unqueuedJobs.push_back(oldest->key);
+            _tasks.erase(oldest);
+            c.nWaitingJobs--;
+        }
+    }
+
+    _taskAvailable.notify_one();
+}
+
+bool TileIOScheduler::enqueueLowPriority(ClientId client, Key key,
+                                         std::function<void()> job)
+{
+    {
+        std::unique_lock lock(_mutex);
+        Client& c = _clients[client];
+        const bool isFull = c.nWaitingJobs >= _queueSizePerClient;
+        if (isFull || findTask(client, key) < _tasks.size()) {
+            return false;
+        }
+
+        _tasks.push_back(Task {
+            .client = client,
+            .key = key,
+            .job = std::move(job),
+            .sequence = ++_sequence,
+            .isLowPriority = true,
+            .enqueueTime = std::chrono::steady_clock::now()
+        });
+        c.nWaitingJobs++;
+    }
+
+    _taskAvailable.notify_one();
+    return true;
+}
+
+bool TileIOScheduler::touch(ClientId client, Key key) {
+    std::unique_lock lock(_mutex);
+    const size_t i = findTask(client, key);
+    if (i == _tasks.size()) {
+        return false;
+    }
+
+    _tasks[i].sequence = ++_sequence;
+    _tasks[i].isLowPriority = false;
+    return true;
+}
+
+void TileIOScheduler::setPriorities(ClientId client,
+                                    std::unordered_map<Key, float> priorities)
+{
+    std::unique_lock lock(_mutex);
+    _clients[client].priorities = std::move(priorities);
+}
+
+std::vector<TileIOScheduler::Key> TileIOScheduler::popUnqueuedJobs(ClientId client) {
+    std::unique_lock lock(_mutex);
+    std::vector<Key> res;
+    std::swap(res, _clients[client].unqueuedJobs);
+    return res;
+}
+
+std::vector<TileIOScheduler::Key> TileIOScheduler::clearEnqueuedJobs(ClientId client) {
+    std::unique_lock lock(_mutex);
+    std::vector<Key> res;
+    for (const Task& task : _tasks) {
+        if (task.client == client) {
+            res.push_back(task.key);
+        }
+    }
+    std::erase_if(_tasks, [client](const Task& task) { return task.client == client; });
+    _clients[client].nWaitingJobs = 0;
+    return res;
+}
+
+void TileIOScheduler::setLatencyRecording(bool enabled) {
+    std::unique_lock lock(_mutex);
+    _isRecordingLatencies = enabled;
+}
+
+std::vector<float> TileIOScheduler::popLatencies() {
+    std::unique_lock lock(_mutex);
+    std::vector<float> res;
+    std::swap(res, _latencies);
+    return res;
+}
+
+size_t TileIOScheduler::numThreads() const {
+    return _workers.size();
+}
+
+size_t TileIOScheduler::numEnqueuedJobs() const {
+    std::unique_lock lock(_mutex);
+    return _tasks.size();
+}
+
+void TileIOScheduler::work() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(_mutex);
+
+            size_t next = 0;
+            _taskAvailable.wait(lock, [this, &next]() {
+                if (_stop) {
+                    return true;
+                }
+                next = nextTask();
+                return next < _tasks.size();
+            });
+
+            if (_stop) {
+                return;
+            }
+
+            task = std::move(_tasks[next]);
+            _tasks.erase(_tasks.begin() + next);
+            Client& c = _clients[task.client];
+            c.nWaitingJobs--;
+            c.nRunningJobs++;
+        }
+
+        task.job();
+
+        {
+            std::unique_lock lock(_mutex);
+            _clients[task.client].nRunningJobs--;
+            if (_isRecordingLatencies) {
+                const std::chrono::duration<float> latency =
+                    std::chrono::steady_clock::now() - task.enqueueTime;
+                _latencies.push_back(latency.count());
+            }
+        }
+        // The client might have been at its limit of concurrent jobs, so any of the
+        // waiting workers might be able to pick up one of its jobs now
+        _taskAvailable.notify_all();
+        _taskFinished.notify_all();
+    }
+}
+
+size_t TileIOScheduler::nextTask() const {
+    size_t best = _tasks.size();
+    float bestPriority = 0.f;
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        const Task& task = _tasks[i];
+        const Client& client = _clients.at(task.client);
+        if (client.nRunningJobs >= client.maxConcurrentJobs) {
+            continue;
+        }
+
+        const auto it = client.priorities.find(task.key);
+        const float priority = it != client.priorities.end() ? it->second : 0.f;
+        if (best == _tasks.size()) {
+            best = i;
+            bestPriority = priority;
+            continue;
+        }
+
+        const Task& b = _tasks[best];
+        bool isBetter = false;
+        if (task.isLowPriority != b.isLowPriority) {
+            isBetter = !task.isLowPriority;
+        }
+        else if (task.isLowPriority) {
+            // Low priority jobs are executed in the order in which they were enqueued
+            isBetter = task.sequence < b.sequence;
+        }
+        else if (priority != bestPriority) {
+            isBetter = priority > bestPriority;
+        }
+        else {
+            isBetter = task.sequence > b.sequence;
+        }
+
+        if (isBetter) {
+            best = i;
+            bestPriority = priority;
+        }
+    }
+    return best;
+}
+
+size_t TileIOScheduler::findTask(ClientId client, Key key) const {
+    const auto it = std::find_if(
+        _tasks.begin(),
+        _tasks.end(),
+        [client, key](const Task& t) { return t.client == client && t.key == key; }
+    );
+    return std::distance(_tasks.begin(), it);
+}
+
+} // namespace openspace::globebrowsing
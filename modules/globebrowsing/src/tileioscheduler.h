@@ -0,0 +1,177 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___TILE_IO_SCHEDULER___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___TILE_IO_SCHEDULER___H__
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+/**
+ * A fixed number of threads that load the tiles for all tile providers of all globes.
+ * Every provider registers as a client and enqueues its jobs here, so that the number of
+ * threads does not grow with the number of layers and so that the jobs of different
+ * providers and globes compete with each other.
+ *
+ * A job is identified by its client and a key. If a job is enqueued again with the same
+ * key, the already enqueued job is bumped instead. Each client can only have a limited
+ * number of waiting jobs; when more are enqueued, the oldest waiting jobs of that client
+ * are dropped and are reported by #popUnqueuedJobs. The waiting job with the highest
+ * priority is executed first, where jobs with the same priority are executed in the
+ * order in which they were enqueued, most recent first. The priorities are provided per
+ * client through #setPriorities and are compared between all clients, so they should be
+ * expressed in the same unit, for example the area the tile covers on the screen.
+ */
+class TileIOScheduler {
+public:
+    using ClientId = uint32_t;
+    using Key = uint64_t;
+
+    /**
+     * \param nThreads The number of worker threads that execute the jobs
+     * \param queueSizePerClient The maximum number of jobs that each client can have
+     *        waiting at the same time
+     */
+    TileIOScheduler(size_t nThreads, size_t queueSizePerClient);
+    ~TileIOScheduler();
+
+    /**
+     * Registers a new client with the scheduler. At most \p maxConcurrentJobs of the
+     * client's jobs are executed at the same time.
+     */
+    ClientId addClient(size_t maxConcurrentJobs);
+
+    /**
+     * Removes the \p client and all of its waiting jobs. If any of the client's jobs is
+     * currently executed, this function blocks until it has finished.
+     */
+    void removeClient(ClientId client);
+
+    void enqueue(ClientId client, Key key, std::function<void()> job);
+
+    /**
+     * Enqueues a job that is executed after all other waiting jobs. Unlike `enqueue`,
+     * this never pushes other jobs out of the queue, so the job is ignored if the
+     * client's queue is full or if a job with the same key is already waiting.
+     *
+     * \return `true` if the job was enqueued
+     */
+    bool enqueueLowPriority(ClientId client, Key key, std::function<void()> job);
+
+    /**
+     * Bumps the waiting job with the provided \p key as if it had just been enqueued.
+     *
+     * \return `true` if the job was found
+     */
+    bool touch(ClientId client, Key key);
+
+    /**
+     * Replaces the priorities of the \p client's waiting jobs. Jobs whose key is not part
+     * of \p priorities have a priority of 0.
+     */
+    void setPriorities(ClientId client, std::unordered_map<Key, float> priorities);
+
+    /**
+     * Returns the keys of the jobs that have been dropped from the \p client's queue
+     * since the last call of this function. These jobs will never be executed.
+     */
+    std::vector<Key> popUnqueuedJobs(ClientId client);
+
+    /**
+     * Removes all waiting jobs of the \p client and returns their keys. Jobs that are
+     * currently executed are not affected.
+     */
+    std::vector<Key> clearEnqueuedJobs(ClientId client);
+
+    /**
+     * Enables or disables the recording of the latency of each job, which is the time
+     * from when the job was first enqueued until it has finished.
+     */
+    void setLatencyRecording(bool enabled);
+
+    /**
+     * Returns the latencies in seconds of all jobs that finished since the last call of
+     * this function, while the recording was enabled.
+     */
+    std::vector<float> popLatencies();
+
+    size_t numThreads() const;
+    size_t numEnqueuedJobs() const;
+
+private:
+    struct Task {
+        ClientId client = 0;
+        Key key = 0;
+        std::function<void()> job;
+        uint64_t sequence = 0;
+        bool isLowPriority = false;
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
+
+    struct Client {
+        size_t maxConcurrentJobs = 1;
+        size_t nRunningJobs = 0;
+        size_t nWaitingJobs = 0;
+        std::unordered_map<Key, float> priorities;
+        std::vector<Key> unqueuedJobs;
+    };
+
+    void work();
+
+    /// Returns the index of the task that should be executed next, or the number of tasks
+    /// if none of the waiting tasks can be started. Must be called with the lock held
+    size_t nextTask() const;
+
+    /// Returns the index of the client's task with the \p key, or the number of tasks if
+    /// there is no such task. Must be called with the lock held
+    size_t findTask(ClientId client, Key key) const;
+
+    std::vector<std::thread> _workers;
+    std::vector<Task> _tasks;
+    std::unordered_map<ClientId, Client> _clients;
+    const size_t _queueSizePerClient;
+    ClientId _nextClientId = 0;
+    uint64_t _sequence = 0;
+    bool _isRecordingLatencies = false;
+    std::vector<float> _latencies;
+
+    mutable std::mutex _mutex;
+    /// Signals the workers that a task can be started
+    std::condition_variable _taskAvailable;
+    /// Signals `removeClient` that a task has finished
+    std::condition_variable _taskFinished;
+    bool _stop = false;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___TILE_IO_SCHEDULER___H__
@@ -24,12 +24,37 @@
 
 #include <modules/globebrowsing/src/tileloadjob.h>
 
+#include <modules/globebrowsing/src/disktilecache.h>
 #include <modules/globebrowsing/src/rawtiledatareader.h>
+#include <modules/globebrowsing/src/tilecompression.h>
+
+namespace {
+    void compressTile(openspace::globebrowsing::RawTile& tile,
+                      const openspace::globebrowsing::TileTextureInitData& initData)
+    {
+        using namespace openspace::globebrowsing;
+
+        if (!initData.isCompressed || tile.error != RawTile::ReadError::None ||
+            !tile.imageData)
+        {
+            return;
+        }
+
+        tile.imageData = compressToBC3(
+            tile.imageData.get(),
+            glm::ivec2(initData.dimensions),
+            initData.ghoulTextureFormat == ghoul::opengl::Texture::Format::BGRA
+        );
+    }
+} // namespace
 
 namespace openspace::globebrowsing {
 
-TileLoadJob::TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex)
+TileLoadJob::TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex,
+                         cache::DiskTileCache* diskTileCache, uint64_t datasetHash)
     : _rawTileDataReader(rawTileDataReader)
+    , _diskTileCache(diskTileCache)
+    , _datasetHash(datasetHash)
     , _chunkIndex(std::move(tileIndex))
 {}
 
@@ -40,8 +65,37 @@ TileLoadJob::~TileLoadJob() {
 }
 
 void TileLoadJob::execute() {
+    if (_diskTileCache) {
+        const cache::DiskTileKey key = {
+            .tileIndex = _chunkIndex,
+            .datasetHash = _datasetHash
+        };
+        std::optional<RawTile> tile = _diskTileCache->get(
+            key,
+            _rawTileDataReader.textureInitData()
+        );
+        if (tile.has_value()) {
+            _rawTile = std::move(*tile);
+            compressTile(_rawTile, _rawTileDataReader.textureInitData());
+            _hasTile = true;
+            return;
+        }
+    }
+
     _rawTile = _rawTileDataReader.readTileData(_chunkIndex);
     _hasTile = true;
+
+    if (_diskTileCache && _rawTile.error == RawTile::ReadError::None) {
+        const cache::DiskTileKey key = {
+            .tileIndex = _chunkIndex,
+            .datasetHash = _datasetHash
+        };
+        _diskTileCache->put(key, _rawTile);
+    }
+
+    // The disk cache stores the uncompressed data, so the compression has to happen
+    // after the tile has been written to it
+    compressTile(_rawTile, _rawTileDataReader.textureInitData());
 }
 
 RawTile TileLoadJob::product() {
@@ -33,6 +33,7 @@
 namespace openspace::globebrowsing {
 
 class RawTileDataReader;
+namespace cache { class DiskTileCache; }
 
 struct TileLoadJob : public Job<RawTile> {
     /**
@@ -40,8 +41,13 @@ struct TileLoadJob : public Job<RawTile> {
      * data will be released. If `product()` has not been called before the TileLoadJob is
      * finished, the data will be deleted as it has not been exposed outside of this
      * object.
+     *
+     * If a \p diskTileCache is provided, the tile is first looked up in the cache using
+     * the \p datasetHash and only read from the \p rawTileDataReader if it was not found.
+     * Tiles that had to be read are then added to the cache.
      */
-    TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex);
+    TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex,
+        cache::DiskTileCache* diskTileCache = nullptr, uint64_t datasetHash = 0);
 
     /**
      * Destroys the allocated data pointer if it has been allocated and the TileLoadJob
@@ -64,6 +70,8 @@ struct TileLoadJob : public Job<RawTile> {
 
 protected:
     RawTileDataReader& _rawTileDataReader;
+    cache::DiskTileCache* _diskTileCache;
+    const uint64_t _datasetHash;
     RawTile _rawTile;
     const TileIndex _chunkIndex;
     bool _hasTile = false;
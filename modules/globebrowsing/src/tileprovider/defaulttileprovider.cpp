@@ -50,6 +50,25 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo CacheBudgetInfo = {
+        "TileCacheBudget",
+        "Tile Cache Budget (MB)",
+        "The maximum amount of GPU memory (in MB) that the tiles of this tile provider "
+        "can use in the tile cache. If the budget is used up, new tiles replace the "
+        "least recently used tiles of this tile provider instead of the tiles of other "
+        "layers. A value of 0 means that the tile provider is only limited by the budget "
+        "of its layer group.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheMemoryInfo = {
+        "TileCacheMemory",
+        "Tile Cache Memory (MB)",
+        "This value denotes the amount of GPU memory (in MB) that the tiles of this tile "
+        "provider currently use in the tile cache.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     enum class [[codegen::stringify()]] Compression {
         PNG = 0,
         JPEG,
@@ -77,6 +96,16 @@ namespace {
         // Determines if the tiles should be preprocessed before uploading to the GPU
         std::optional<bool> performPreProcessing;
 
+        // If this value is `true`, the tiles are block compressed on the loading threads
+        // before they are uploaded to the GPU. This reduces the GPU memory and upload
+        // bandwidth of each tile to a quarter, allowing more tiles to be resident at the
+        // same time, at the cost of a slight loss in image quality. Compression is not
+        // supported for height layers
+        std::optional<bool> compressTextures;
+
+        // [[codegen::verbatim(CacheBudgetInfo.description)]]
+        std::optional<int> tileCacheBudget [[codegen::greaterequal(0)]];
+
         struct CacheSettings {
             // Specifies whether to use caching or not
             std::optional<bool> enabled;
@@ -116,6 +145,13 @@ documentation::Documentation DefaultTileProvider::Documentation() {
 DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
     : _filePath(FilePathInfo, "")
     , _tilePixelSize(TilePixelSizeInfo, 32, 32, 2048)
+    , _tileCacheBudget(CacheBudgetInfo, 0, 0, 16384, 1)
+    , _tileCacheMemory(
+        CacheMemoryInfo,
+        0.f,
+        0.f,
+        std::numeric_limits<float>::max()
+    )
 {
     ZoneScoped;
 
@@ -137,6 +173,12 @@ DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
     _performPreProcessing = (_layerGroupID == layers::Group::ID::HeightLayers);
     _performPreProcessing = p.performPreProcessing.value_or(_performPreProcessing);
 
+    _compressTextures = p.compressTextures.value_or(_compressTextures);
+    if (_compressTextures && _layerGroupID == layers::Group::ID::HeightLayers) {
+        LWARNING("Texture compression is not supported for height layers");
+        _compressTextures = false;
+    }
+
     // Get the name of the layergroup to which this layer belongs
     auto it = std::find_if(
         layers::Groups.begin(),
@@ -180,13 +222,36 @@ DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
     _cacheProperties.compression = codegen::toString(compression);
 
     TileTextureInitData initData = TileTextureInitData(
-        tileTextureInitData(_layerGroupID, pixelSize)
+        tileTextureInitData(_layerGroupID, pixelSize, _compressTextures)
     );
     _tilePixelSize = initData.dimensions.x;
     initAsyncTileDataReader(std::move(initData), _cacheProperties);
 
     addProperty(_filePath);
     addProperty(_tilePixelSize);
+
+    _tileCacheBudget = p.tileCacheBudget.value_or(_tileCacheBudget);
+    _tileCacheBudget.onChange([this]() {
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache()
+            ->setProviderBudget(
+                uniqueIdentifier,
+                _layerGroupID,
+                static_cast<size_t>(_tileCacheBudget) * 1024 * 1024
+            );
+    });
+    addProperty(_tileCacheBudget);
+
+    _tileCacheMemory.setReadOnly(true);
+    addProperty(_tileCacheMemory);
+}
+
+void DefaultTileProvider::internalInitialize() {
+    // The unique identifier is only assigned when the tile provider is initialized
+    global::moduleEngine->module<GlobeBrowsingModule>()->tileCache()->setProviderBudget(
+        uniqueIdentifier,
+        _layerGroupID,
+        static_cast<size_t>(_tileCacheBudget) * 1024 * 1024
+    );
 }
 
 void DefaultTileProvider::initAsyncTileDataReader(TileTextureInitData initData,
@@ -219,7 +284,7 @@ Tile DefaultTileProvider::tile(const TileIndex& tileIndex) {
     cache::MemoryAwareTileCache* tileCache =
         global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
     Tile tile = tileCache->get(key);
-    if (!tile.texture) {
+    if (!tile.texture && !tileCache->touchPendingUpload(key)) {
         _asyncTextureDataProvider->enqueueTileIO(tileIndex);
     }
 
@@ -243,6 +308,30 @@ Tile::Status DefaultTileProvider::tileStatus(const TileIndex& index) {
     return tileCache->get(key).status;
 }
 
+void DefaultTileProvider::prefetchTile(const TileIndex& tileIndex) {
+    ghoul_assert(_asyncTextureDataProvider, "No data provider");
+    if (tileIndex.level > maxLevel()) {
+        return;
+    }
+
+    const cache::ProviderTileKey key = {
+        .tileIndex = tileIndex,
+        .providerID = uniqueIdentifier
+    };
+    cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+    if (!tileCache->exist(key) && !tileCache->touchPendingUpload(key)) {
+        _asyncTextureDataProvider->prefetchTileIO(tileIndex);
+    }
+}
+
+void DefaultTileProvider::updateTilePriorities(
+                                   const std::function<float(const TileIndex&)>& priority)
+{
+    ghoul_assert(_asyncTextureDataProvider, "No data provider");
+    _asyncTextureDataProvider->updatePriorities(priority);
+}
+
 TileDepthTransform DefaultTileProvider::depthTransform() {
     ghoul_assert(_asyncTextureDataProvider, "No data provider");
     return _asyncTextureDataProvider->rawTileDataReader().depthTransform();
@@ -252,21 +341,28 @@ void DefaultTileProvider::update() {
     ghoul_assert(_asyncTextureDataProvider, "No data provider");
     _asyncTextureDataProvider->update();
 
-    std::optional<RawTile> tile = _asyncTextureDataProvider->popFinishedRawTile();
-    if (tile) {
+    // The finished tiles are not uploaded right away, but are handed to the tile cache
+    // which uploads the pending tiles of all providers in order of their importance
+    // within the per-frame upload budget
+    cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+    std::vector<RawTile> tiles = _asyncTextureDataProvider->popFinishedRawTiles();
+    for (RawTile& tile : tiles) {
         const cache::ProviderTileKey key = {
-            .tileIndex = tile->tileIndex,
+            .tileIndex = tile.tileIndex,
             .providerID = uniqueIdentifier
         };
-        cache::MemoryAwareTileCache* tileCache =
-            global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
         ghoul_assert(!tileCache->exist(key), "Tile must not be existing in cache");
-        tileCache->createTileAndPut(key, std::move(*tile));
+        tileCache->enqueueUpload(key, std::move(tile));
     }
 
+    const cache::MemoryAwareTileCache::ProviderStatistics statistics =
+        tileCache->providerStatistics(uniqueIdentifier);
+    _tileCacheMemory = static_cast<float>(statistics.nBytes) / (1024.f * 1024.f);
+
     if (_asyncTextureDataProvider->shouldBeDeleted()) {
         initAsyncTileDataReader(
-            tileTextureInitData(_layerGroupID, _tilePixelSize),
+            tileTextureInitData(_layerGroupID, _tilePixelSize, _compressTextures),
             _cacheProperties
         );
     }
@@ -28,6 +28,7 @@
 #include <modules/globebrowsing/src/tileprovider/tileprovider.h>
 #include <modules/globebrowsing/src/tilecacheproperties.h>
 #include <modules/globebrowsing/src/asynctiledataprovider.h>
+#include <openspace/properties/scalar/floatproperty.h>
 #include <memory>
 
 namespace openspace::globebrowsing {
@@ -38,6 +39,9 @@ public:
 
     Tile tile(const TileIndex& tileIndex) override final;
     Tile::Status tileStatus(const TileIndex& index) override final;
+    void prefetchTile(const TileIndex& tileIndex) override final;
+    void updateTilePriorities(
+        const std::function<float(const TileIndex&)>& priority) override final;
     TileDepthTransform depthTransform() override final;
     void update() override final;
     void reset() override final;
@@ -48,15 +52,19 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    void internalInitialize() override final;
     void initAsyncTileDataReader(TileTextureInitData initData,
         TileCacheProperties cacheProperties);
 
     properties::StringProperty _filePath;
     properties::IntProperty _tilePixelSize;
+    properties::IntProperty _tileCacheBudget;
+    properties::FloatProperty _tileCacheMemory;
 
     std::unique_ptr<AsyncTileDataProvider> _asyncTextureDataProvider;
     layers::Group::ID _layerGroupID = layers::Group::ID::Unknown;
     bool _performPreProcessing = false;
+    bool _compressTextures = false;
     TileCacheProperties _cacheProperties;
 };
 
@@ -100,6 +100,12 @@ SpoutImageProvider::SpoutImageProvider(
 
 
     spoutReceiver->onUpdateReceiver([this](int width, int height, unsigned int texture) {
+        // The texture that is shared by Spout is stored top-down, so the blit flips it
+        // into the orientation of the copied frames
+        const bool isFlipped = spoutReceiver->isUsingSharedTexture();
+        const int dstY0 = isFlipped ? height : 0;
+        const int dstY1 = isFlipped ? 0 : height;
+
         glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo[0]);
         glFramebufferTexture2D(
             GL_READ_FRAMEBUFFER,
@@ -126,9 +132,9 @@ SpoutImageProvider::SpoutImageProvider(
             width,
             height,
             0,
-            0,
+            dstY0,
             width / 2,
-            height,
+            dstY1,
             GL_COLOR_BUFFER_BIT,
             GL_NEAREST
         );
@@ -145,9 +151,9 @@ SpoutImageProvider::SpoutImageProvider(
             width / 2,
             height,
             0,
-            0,
+            dstY0,
             width / 2,
-            height,
+            dstY1,
             GL_COLOR_BUFFER_BIT,
             GL_NEAREST
         );
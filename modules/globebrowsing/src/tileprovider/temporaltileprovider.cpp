@@ -63,6 +63,36 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo LookAheadStepsInfo = {
+        "LookAheadSteps",
+        "Look-Ahead Steps",
+        "The number of upcoming time steps whose tiles are loaded ahead of time for the "
+        "currently visible parts of the globe. The direction of the upcoming time steps "
+        "follows the sign of the current delta time and nothing is loaded ahead of time "
+        "while the time is paused. A value of 0 disables the look-ahead.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LookAheadBudgetInfo = {
+        "LookAheadBudget",
+        "Look-Ahead Budget (MB)",
+        "The maximum amount of GPU memory (in MB) that the tiles of the upcoming time "
+        "steps can use together. Once the budget is used up, no further upcoming time "
+        "steps are loaded ahead of time; closer time steps are loaded first.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CrossfadeInfo = {
+        "Crossfade",
+        "Crossfade",
+        "If this value is enabled, the tiles of the current time step are blended with "
+        "the tiles of the following time step, depending on how far the time has "
+        "progressed in the current time step. The blending only starts once the tiles of "
+        "both time steps are available. This value has no effect if the tile provider "
+        "uses interpolation.",
+        openspace::properties::Property::Visibility::User
+    };
+
     struct [[codegen::Dictionary(TemporalTileProvider)]] Parameters {
         // [[codegen::verbatim(UseFixedTimeInfo.description)]]
         std::optional<bool> useFixedTime;
@@ -70,6 +100,15 @@ namespace {
         // [[codegen::verbatim(FixedTimeInfo.description)]]
         std::optional<std::string> fixedTime;
 
+        // [[codegen::verbatim(LookAheadStepsInfo.description)]]
+        std::optional<int> lookAheadSteps [[codegen::inrange(0, 16)]];
+
+        // [[codegen::verbatim(LookAheadBudgetInfo.description)]]
+        std::optional<int> lookAheadBudget [[codegen::greaterequal(0)]];
+
+        // [[codegen::verbatim(CrossfadeInfo.description)]]
+        std::optional<bool> crossfade;
+
         enum class Mode {
             Prototyped,
             Folder
@@ -166,6 +205,9 @@ TemporalTileProvider::TemporalTileProvider(const ghoul::Dictionary& dictionary)
     : _initDict(dictionary)
     , _useFixedTime(UseFixedTimeInfo, false)
     , _fixedTime(FixedTimeInfo)
+    , _lookAheadSteps(LookAheadStepsInfo, 0, 0, 16)
+    , _lookAheadBudget(LookAheadBudgetInfo, 256, 0, 16384, 1)
+    , _crossfade(CrossfadeInfo, false)
 {
     ZoneScoped;
 
@@ -192,6 +234,15 @@ TemporalTileProvider::TemporalTileProvider(const ghoul::Dictionary& dictionary)
     _fixedTime.onChange([this]() { _fixedTimeDirty = true; });
     addProperty(_fixedTime);
 
+    _lookAheadSteps = p.lookAheadSteps.value_or(_lookAheadSteps);
+    addProperty(_lookAheadSteps);
+
+    _lookAheadBudget = p.lookAheadBudget.value_or(_lookAheadBudget);
+    addProperty(_lookAheadBudget);
+
+    _crossfade = p.crossfade.value_or(_crossfade);
+    addProperty(_crossfade);
+
     _colormap = p.colormap.value_or(_colormap);
 
     if (p.prototyped.has_value()) {
@@ -215,6 +266,9 @@ TemporalTileProvider::TemporalTileProvider(const ghoul::Dictionary& dictionary)
             );
             _prototyped.timeQuantizer.setResolution(p.prototyped->temporalResolution);
             _prototyped.temporalResolution = p.prototyped->temporalResolution;
+            _prototyped.stepSeconds = _prototyped.timeQuantizer.parseTimeResolutionStr(
+                _prototyped.temporalResolution
+            );
         }
         catch (const ghoul::RuntimeError& e) {
             throw ghoul::RuntimeError(std::format(
@@ -321,6 +375,10 @@ Tile TemporalTileProvider::tile(const TileIndex& tileIndex) {
         update();
     }
 
+    if (_lookAheadSteps > 0 && _requestedTileKeys.insert(tileIndex.hashKey()).second) {
+        _requestedTiles.push_back(tileIndex);
+    }
+
     return _currentTileProvider->tile(tileIndex);
 }
 
@@ -332,6 +390,20 @@ Tile::Status TemporalTileProvider::tileStatus(const TileIndex& index) {
     return _currentTileProvider->tileStatus(index);
 }
 
+void TemporalTileProvider::prefetchTile(const TileIndex& tileIndex) {
+    if (_currentTileProvider) {
+        _currentTileProvider->prefetchTile(tileIndex);
+    }
+}
+
+void TemporalTileProvider::updateTilePriorities(
+                                   const std::function<float(const TileIndex&)>& priority)
+{
+    if (_currentTileProvider) {
+        _currentTileProvider->updateTilePriorities(priority);
+    }
+}
+
 TileDepthTransform TemporalTileProvider::depthTransform() {
     if (!_currentTileProvider) {
         update();
@@ -352,7 +424,13 @@ void TemporalTileProvider::update() {
             }
         }
         else {
-            newCurr = tileProvider(global::timeManager->time());
+            const Time& time = global::timeManager->time();
+            newCurr = tileProvider(time);
+            if (newCurr && _crossfade && !_isInterpolating) {
+                TileProvider* crossfade = crossfadeTileProvider(time);
+                newCurr = crossfade ? crossfade : newCurr;
+            }
+            prefetchUpcomingSteps(time);
         }
     }
     catch (const ghoul::RuntimeError& e) {
@@ -367,6 +445,130 @@ void TemporalTileProvider::update() {
     }
 }
 
+std::vector<double> TemporalTileProvider::stepTimes(const Time& time, bool forward,
+                                                    int nSteps)
+{
+    std::vector<double> res;
+    switch (_mode) {
+        case Mode::Folder: {
+            // Same lookup of the current time step as in the tileProvider function
+            auto it = std::lower_bound(
+                _folder.files.begin(),
+                _folder.files.end(),
+                time.j2000Seconds(),
+                [](const std::pair<double, std::string>& p, double t) {
+                    return p.first < t;
+                }
+            );
+            if (it != _folder.files.begin()) {
+                it -= 1;
+            }
+            const std::ptrdiff_t current = std::distance(_folder.files.begin(), it);
+            const std::ptrdiff_t nFiles = std::ssize(_folder.files);
+
+            res.push_back(it->first);
+            for (int i = 1; i <= nSteps; i++) {
+                const std::ptrdiff_t index = forward ? current + i : current - i;
+                if (index < 0 || index >= nFiles) {
+                    break;
+                }
+                res.push_back(_folder.files[index].first);
+            }
+            break;
+        }
+        case Mode::Prototype: {
+            Time current = time;
+            if (!_prototyped.timeQuantizer.quantize(current, true)) {
+                break;
+            }
+
+            res.push_back(current.j2000Seconds());
+            for (int i = 1; i <= nSteps; i++) {
+                // The length of the time steps is only approximate for monthly or yearly
+                // resolutions, so we quantize a time that is half a step into the
+                // respective time step instead
+                const double offset = forward ? i + 0.5 : -(i - 0.5);
+                Time t = Time(current.j2000Seconds() + offset * _prototyped.stepSeconds);
+                if (!_prototyped.timeQuantizer.quantize(t, false)) {
+                    break;
+                }
+                res.push_back(t.j2000Seconds());
+            }
+            break;
+        }
+        default:
+            throw ghoul::MissingCaseException();
+    }
+    return res;
+}
+
+void TemporalTileProvider::prefetchUpcomingSteps(const Time& time) {
+    ZoneScoped;
+
+    const double deltaTime = global::timeManager->deltaTime();
+    if (_lookAheadSteps == 0 || global::timeManager->isPaused() || deltaTime == 0.0) {
+        _requestedTiles.clear();
+        _requestedTileKeys.clear();
+        return;
+    }
+
+    const std::vector<double> steps = stepTimes(time, deltaTime > 0.0, _lookAheadSteps);
+    const cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+    const size_t budget = static_cast<size_t>(_lookAheadBudget) * 1024 * 1024;
+    size_t usedBytes = 0;
+
+    // The first entry is the current time step which is loaded regardless
+    for (size_t i = 1; i < steps.size(); i++) {
+        DefaultTileProvider* provider = retrieveTileProvider(Time(steps[i]));
+
+        // The tiles that have been loaded for the upcoming steps need to be handed to
+        // the tile cache, which otherwise only happens for the current tile provider
+        provider->update();
+
+        usedBytes += tileCache->providerStatistics(provider->uniqueIdentifier).nBytes;
+        if (usedBytes >= budget) {
+            break;
+        }
+
+        for (const TileIndex& tileIndex : _requestedTiles) {
+            provider->prefetchTile(tileIndex);
+        }
+    }
+
+    _requestedTiles.clear();
+    _requestedTileKeys.clear();
+}
+
+TileProvider* TemporalTileProvider::crossfadeTileProvider(const Time& time) {
+    ZoneScoped;
+
+    const std::vector<double> steps = stepTimes(time, true, 1);
+    if (steps.size() < 2 || steps[1] <= steps[0]) {
+        return nullptr;
+    }
+
+    if (!_crossfadeTileProvider) {
+        _crossfadeTileProvider = std::make_unique<InterpolateTileProvider>(_initDict);
+        _crossfadeTileProvider->initialize();
+        _crossfadeTileProvider->requireBothTiles = false;
+    }
+
+    // The following tile provider is loaded through the InterpolateTileProvider even
+    // without the look-ahead, so that both time steps are resident when blending
+    InterpolateTileProvider& provider = *_crossfadeTileProvider;
+    provider.t1 = retrieveTileProvider(Time(steps[0]));
+    provider.t2 = retrieveTileProvider(Time(steps[1]));
+    provider.before = provider.t1;
+    provider.future = provider.t2;
+    provider.factor = std::clamp(
+        static_cast<float>((time.j2000Seconds() - steps[0]) / (steps[1] - steps[0])),
+        0.f,
+        1.f
+    );
+    return &provider;
+}
+
 void TemporalTileProvider::reset() {
     for (std::pair<const double, DefaultTileProvider>& it : _tileProviderMap) {
         it.second.reset();
@@ -728,6 +930,9 @@ Tile TemporalTileProvider::InterpolateTileProvider::tile(const TileIndex& tileIn
     future->tile(tileIndex);
     const cache::ProviderTileKey key = { tileIndex, uniqueIdentifier };
 
+    if (!requireBothTiles && (!next.texture || factor <= 0.f)) {
+        return prev;
+    }
     if (!prev.texture || !next.texture) {
         return Tile{ nullptr, std::nullopt, Tile::Status::Unavailable };
     }
@@ -754,7 +959,7 @@ Tile TemporalTileProvider::InterpolateTileProvider::tile(const TileIndex& tileIn
     }
     else {
         // Create a texture with the initialization data
-        writeTexture = tileCache->texture(initData);
+        writeTexture = tileCache->texture(initData, key.providerID);
         ourTile = Tile{ writeTexture, std::nullopt, Tile::Status::OK };
         tileCache->put(key, initData.hashKey, ourTile);
     }
@@ -783,11 +988,16 @@ Tile TemporalTileProvider::InterpolateTileProvider::tile(const TileIndex& tileIn
     shaderProgram->activate();
     shaderProgram->setUniform("blendFactor", factor);
 
-    // The texture that will give the color for the interpolated texture
+    // The texture that will give the color for the interpolated texture. The unit is
+    // also assigned without a color map so that the sampler never shares a unit with
+    // the sampler of another type
     ghoul::opengl::TextureUnit colormapUnit;
     colormapUnit.activate();
-    colormap->bind();
+    if (colormap) {
+        colormap->bind();
+    }
     shaderProgram->setUniform("colormapTexture", colormapUnit);
+    shaderProgram->setUniform("useColormap", colormap != nullptr);
 
     ghoul::opengl::TextureUnit prevUnit;
     prevUnit.activate();
@@ -821,6 +1031,9 @@ Tile TemporalTileProvider::InterpolateTileProvider::tile(const TileIndex& tileIn
 Tile::Status TemporalTileProvider::InterpolateTileProvider::tileStatus(
                                                                    const TileIndex& index)
 {
+    if (!requireBothTiles) {
+        return t1->tileStatus(index);
+    }
     return std::min(t1->tileStatus(index), t2->tileStatus(index));
 }
 
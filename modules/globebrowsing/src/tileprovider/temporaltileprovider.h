@@ -29,6 +29,8 @@
 
 #include <modules/globebrowsing/src/tileprovider/defaulttileprovider.h>
 #include <modules/globebrowsing/src/tileprovider/singleimagetileprovider.h>
+#include <unordered_set>
+#include <vector>
 
 namespace openspace::globebrowsing {
 
@@ -49,6 +51,9 @@ public:
 
     Tile tile(const TileIndex& tileIndex) override final;
     Tile::Status tileStatus(const TileIndex& index) override final;
+    void prefetchTile(const TileIndex& tileIndex) override final;
+    void updateTilePriorities(
+        const std::function<float(const TileIndex&)>& priority) override final;
     TileDepthTransform depthTransform() override final;
     void update() override final;
     void reset() override final;
@@ -82,6 +87,9 @@ private:
         TileProvider* t2 = nullptr;
         TileProvider* future = nullptr;
         float factor = 1.f;
+        /// If `false`, the tile of `t1` is returned as long as the tile of `t2` is not
+        /// yet available instead of reporting the tile as unavailable
+        bool requireBothTiles = true;
         GLuint vaoQuad = 0;
         GLuint vboQuad = 0;
         GLuint fbo = 0;
@@ -97,6 +105,26 @@ private:
 
     TileProvider* tileProvider(const Time& time);
 
+    /**
+     * Returns the times of the time step that contains \p time, followed by the times of
+     * up to \p nSteps consecutive time steps in the direction given by \p forward. Time
+     * steps that fall outside of the dataset are not included.
+     */
+    std::vector<double> stepTimes(const Time& time, bool forward, int nSteps);
+
+    /**
+     * Warms the tile providers of the upcoming time steps in the direction of the current
+     * delta time for the tiles that were requested since the last call, until the memory
+     * used by the upcoming tile providers exceeds the look-ahead budget.
+     */
+    void prefetchUpcomingSteps(const Time& time);
+
+    /**
+     * Returns a tile provider that blends the time step that contains \p time with the
+     * following time step, or `nullptr` if there is no following time step.
+     */
+    TileProvider* crossfadeTileProvider(const Time& time);
+
     Mode _mode;
 
     struct {
@@ -107,6 +135,7 @@ private:
         std::string timeFormat;
         TimeQuantizer timeQuantizer;
         std::string prototype;
+        double stepSeconds = 0.0;
     } _prototyped;
 
     struct {
@@ -119,8 +148,15 @@ private:
     ghoul::Dictionary _initDict;
     properties::BoolProperty _useFixedTime;
     properties::StringProperty _fixedTime;
+    properties::IntProperty _lookAheadSteps;
+    properties::IntProperty _lookAheadBudget;
+    properties::BoolProperty _crossfade;
     bool _fixedTimeDirty = true;
 
+    /// The tiles that were requested since the last update, used for the look-ahead
+    std::vector<TileIndex> _requestedTiles;
+    std::unordered_set<TileIndex::TileHashKey> _requestedTileKeys;
+
     TileProvider* _currentTileProvider = nullptr;
     std::unordered_map<double, DefaultTileProvider> _tileProviderMap;
 
@@ -128,6 +164,7 @@ private:
 
     std::string _colormap;
     std::unique_ptr<InterpolateTileProvider> _interpolateTileProvider;
+    std::unique_ptr<InterpolateTileProvider> _crossfadeTileProvider;
 };
 
 } // namespace openspace::globebrowsing
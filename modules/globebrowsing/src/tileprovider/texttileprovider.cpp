@@ -66,7 +66,7 @@ Tile TextTileProvider::renderTile(const TileIndex& tileIndex, const std::string&
     const cache::ProviderTileKey key = { tileIndex, uniqueIdentifier };
     Tile tile = tileCache->get(key);
     if (!tile.texture) {
-        ghoul::opengl::Texture* texture = tileCache->texture(initData);
+        ghoul::opengl::Texture* texture = tileCache->texture(initData, key.providerID);
 
         GLint prevProgram = 0;
         GLint prevFBO = 0;
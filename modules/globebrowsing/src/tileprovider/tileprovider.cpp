@@ -200,6 +200,10 @@ ChunkTile TileProvider::traverseTree(TileIndex tileIndex, int parents, int maxPa
 void TileProvider::internalInitialize() {}
 void TileProvider::internalDeinitialize() {}
 
+void TileProvider::prefetchTile(const TileIndex&) {}
+
+void TileProvider::updateTilePriorities(const std::function<float(const TileIndex&)>&) {}
+
 ChunkTile TileProvider::chunkTile(TileIndex tileIndex, int parents, int maxParents) {
     ZoneScoped;
 
@@ -95,6 +95,23 @@ struct TileProvider : public properties::PropertyOwner {
      */
     virtual Tile::Status tileStatus(const TileIndex& index) = 0;
 
+    /**
+     * Requests the `Tile` for the provided `TileIndex` to be loaded in the background
+     * because it is expected to be needed soon. Prefetched tiles have a lower priority
+     * than the tiles that are requested through the `tile` function and are only loaded
+     * if there is room for them. The default implementation does nothing.
+     */
+    virtual void prefetchTile(const TileIndex& tileIndex);
+
+    /**
+     * Updates the priorities of the tiles that have been requested but that are not
+     * loaded yet. The \p priority function returns the importance of a `TileIndex`,
+     * where higher values are loaded first. An empty function reverts to loading the
+     * most recently requested tiles first. The default implementation does nothing.
+     */
+    virtual void updateTilePriorities(
+        const std::function<float(const TileIndex&)>& priority);
+
     /**
      * Get the associated depth transform for this TileProvider. This is necessary for
      * TileProviders serving height map data, in order to correcly map pixel values to
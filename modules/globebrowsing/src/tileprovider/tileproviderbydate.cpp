@@ -115,6 +115,19 @@ Tile::Status TileProviderByDate::tileStatus(const TileIndex& index) {
         Tile::Status::Unavailable;
 }
 
+void TileProviderByDate::prefetchTile(const TileIndex& tileIndex) {
+    if (_currentTileProvider) {
+        _currentTileProvider->prefetchTile(tileIndex);
+    }
+}
+
+void TileProviderByDate::updateTilePriorities(
+                                   const std::function<float(const TileIndex&)>& priority)
+{
+    if (_currentTileProvider) {
+        _currentTileProvider->updateTilePriorities(priority);
+    }
+}
 
 TileDepthTransform TileProviderByDate::depthTransform() {
     return _currentTileProvider ?
@@ -127,6 +127,25 @@ Tile::Status TileProviderByIndex::tileStatus(const TileIndex& index) {
         _defaultTileProvider->tileStatus(index);
 }
 
+void TileProviderByIndex::prefetchTile(const TileIndex& tileIndex) {
+    const auto it = _providers.find(tileIndex.hashKey());
+    if (it != _providers.end()) {
+        it->second->prefetchTile(tileIndex);
+    }
+    else {
+        _defaultTileProvider->prefetchTile(tileIndex);
+    }
+}
+
+void TileProviderByIndex::updateTilePriorities(
+                                   const std::function<float(const TileIndex&)>& priority)
+{
+    for (const auto& [key, provider] : _providers) {
+        provider->updateTilePriorities(priority);
+    }
+    _defaultTileProvider->updateTilePriorities(priority);
+}
+
 TileDepthTransform TileProviderByIndex::depthTransform() {
     return _defaultTileProvider->depthTransform();
 }
@@ -157,6 +157,21 @@ TileProvider* TileProviderByLevel::levelProvider(int level) const {
     }
 }
 
+void TileProviderByLevel::prefetchTile(const TileIndex& tileIndex) {
+    TileProvider* provider = levelProvider(tileIndex.level);
+    if (provider) {
+        provider->prefetchTile(tileIndex);
+    }
+}
+
+void TileProviderByLevel::updateTilePriorities(
+                                   const std::function<float(const TileIndex&)>& priority)
+{
+    for (const std::unique_ptr<TileProvider>& prov : _levelTileProviders) {
+        prov->updateTilePriorities(priority);
+    }
+}
+
 TileDepthTransform TileProviderByLevel::depthTransform() {
     return { 0.f, 1.f };
 }
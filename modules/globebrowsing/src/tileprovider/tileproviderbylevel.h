@@ -35,6 +35,9 @@ public:
 
     Tile tile(const TileIndex& tileIndex) override final;
     Tile::Status tileStatus(const TileIndex& index) override final;
+    void prefetchTile(const TileIndex& tileIndex) override final;
+    void updateTilePriorities(
+        const std::function<float(const TileIndex&)>& priority) override final;
     TileDepthTransform depthTransform() override final;
     void update() override final;
     void reset() override final;
@@ -24,6 +24,9 @@
 
 #include <modules/globebrowsing/src/tiletextureinitdata.h>
 
+#include <modules/globebrowsing/src/tilecompression.h>
+#include <numeric>
+
 namespace {
 
 size_t numberOfRasters(ghoul::opengl::Texture::Format format) {
@@ -75,7 +78,8 @@ unsigned int uniqueIdForTextureFormat(ghoul::opengl::Texture::Format textureForm
 openspace::globebrowsing::TileTextureInitData::HashKey calculateHashKey(
                                                              const glm::ivec3& dimensions,
                                              const ghoul::opengl::Texture::Format& format,
-                                                                     const GLenum& glType)
+                                                                     const GLenum& glType,
+                                                                        bool isCompressed)
 {
     ghoul_assert(dimensions.x > 0, "Incorrect dimension");
     ghoul_assert(dimensions.y > 0, "Incorrect dimension");
@@ -91,16 +95,24 @@ openspace::globebrowsing::TileTextureInitData::HashKey calculateHashKey(
     res |= dimensions.y << 10;
     res |= static_cast<std::underlying_type_t<GLenum>>(glType) << (10 + 16);
     res |= formatId << (10 + 16 + 4);
+    res |= static_cast<uint64_t>(isCompressed) << 40;
 
     return res;
 }
 
+size_t compressedNumBytes(const glm::ivec2& size) {
+    const std::vector<size_t> sizes = openspace::globebrowsing::compressedMipLevelSizes(
+        size
+    );
+    return std::accumulate(sizes.begin(), sizes.end(), size_t(0));
+}
+
 } // namespace
 
 namespace openspace::globebrowsing {
 
 TileTextureInitData tileTextureInitData(layers::Group::ID id,
-                                        size_t preferredTileSize)
+                                        size_t preferredTileSize, bool compress)
 {
     switch (id) {
         case layers::Group::ID::HeightLayers: {
@@ -119,7 +131,9 @@ TileTextureInitData tileTextureInitData(layers::Group::ID id,
                 tileSize,
                 tileSize,
                 GL_UNSIGNED_BYTE,
-                ghoul::opengl::Texture::Format::BGRA
+                ghoul::opengl::Texture::Format::BGRA,
+                TileTextureInitData::ShouldAllocateDataOnCPU::No,
+                TileTextureInitData::UseCompression(compress)
             );
         }
         case layers::Group::ID::Overlays: {
@@ -128,7 +142,9 @@ TileTextureInitData tileTextureInitData(layers::Group::ID id,
                 tileSize,
                 tileSize,
                 GL_UNSIGNED_BYTE,
-                ghoul::opengl::Texture::Format::BGRA
+                ghoul::opengl::Texture::Format::BGRA,
+                TileTextureInitData::ShouldAllocateDataOnCPU::No,
+                TileTextureInitData::UseCompression(compress)
             );
         }
         case layers::Group::ID::NightLayers: {
@@ -137,7 +153,9 @@ TileTextureInitData tileTextureInitData(layers::Group::ID id,
                 tileSize,
                 tileSize,
                 GL_UNSIGNED_BYTE,
-                ghoul::opengl::Texture::Format::BGRA
+                ghoul::opengl::Texture::Format::BGRA,
+                TileTextureInitData::ShouldAllocateDataOnCPU::No,
+                TileTextureInitData::UseCompression(compress)
             );
         }
         case layers::Group::ID::WaterMasks: {
@@ -146,7 +164,9 @@ TileTextureInitData tileTextureInitData(layers::Group::ID id,
                 tileSize,
                 tileSize,
                 GL_UNSIGNED_BYTE,
-                ghoul::opengl::Texture::Format::BGRA
+                ghoul::opengl::Texture::Format::BGRA,
+                TileTextureInitData::ShouldAllocateDataOnCPU::No,
+                TileTextureInitData::UseCompression(compress)
             );
         }
         default:
@@ -156,7 +176,8 @@ TileTextureInitData tileTextureInitData(layers::Group::ID id,
 
 TileTextureInitData::TileTextureInitData(size_t width, size_t height, GLenum type,
                                          ghoul::opengl::Texture::Format textureFormat,
-                                         ShouldAllocateDataOnCPU allocCpu)
+                                         ShouldAllocateDataOnCPU allocCpu,
+                                         UseCompression compression)
     : dimensions(width, height, 1)
     , glType(type)
     , ghoulTextureFormat(textureFormat)
@@ -166,8 +187,19 @@ TileTextureInitData::TileTextureInitData(size_t width, size_t height, GLenum typ
     , bytesPerLine(bytesPerPixel * width)
     , totalNumBytes(bytesPerLine * height)
     , shouldAllocateDataOnCPU(allocCpu)
-    , hashKey(calculateHashKey(dimensions, ghoulTextureFormat, glType))
-{}
+    , isCompressed(compression)
+    , totalNumBytesOnGPU(
+        isCompressed ?
+            compressedNumBytes(glm::ivec2(width, height)) :
+            totalNumBytes
+    )
+    , hashKey(calculateHashKey(dimensions, ghoulTextureFormat, glType, isCompressed))
+{
+    ghoul_assert(
+        !isCompressed || (glType == GL_UNSIGNED_BYTE && nRasters == 4),
+        "Only 8-bit four channel textures can be compressed"
+    );
+}
 
 TileTextureInitData& TileTextureInitData::operator=(const TileTextureInitData& rhs) {
     if (this == &rhs) {
@@ -40,10 +40,12 @@ class TileTextureInitData {
 public:
     using HashKey = uint64_t;
     BooleanType(ShouldAllocateDataOnCPU);
+    BooleanType(UseCompression);
 
     TileTextureInitData(size_t width, size_t height, GLenum type,
         ghoul::opengl::Texture::Format textureFormat,
-        ShouldAllocateDataOnCPU allocCpu = ShouldAllocateDataOnCPU::No);
+        ShouldAllocateDataOnCPU allocCpu = ShouldAllocateDataOnCPU::No,
+        UseCompression compression = UseCompression::No);
 
     TileTextureInitData(const TileTextureInitData& original) = default;
     TileTextureInitData(TileTextureInitData&& original) = default;
@@ -62,11 +64,20 @@ public:
     const size_t bytesPerLine;
     const size_t totalNumBytes;
     const bool shouldAllocateDataOnCPU;
+    /// If `true`, the tile data is block compressed before it is uploaded to the GPU
+    const bool isCompressed;
+    /// The number of bytes that a texture with this data occupies on the GPU
+    const size_t totalNumBytesOnGPU;
     const HashKey hashKey;
 };
 
+/**
+ * Returns the texture information for tiles of the layer group \p id. If \p compress is
+ * `true`, the tiles are block compressed on the GPU. This is not supported for height
+ * layers, whose texture data is always stored uncompressed.
+ */
 TileTextureInitData tileTextureInitData(layers::Group::ID id,
-    size_t preferredTileSize = 0);
+    size_t preferredTileSize = 0, bool compress = false);
 
 } // namespace openspace::globebrowsing
 
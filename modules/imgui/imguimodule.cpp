@@ -78,6 +78,17 @@ namespace {
         "This value determines the delay in seconds after which the tooltip is shown.",
         openspace::properties::Property::Visibility::Developer
     };
+
+    constexpr openspace::properties::Property::PropertyInfo RefreshIntervalInfo = {
+        "RefreshInterval",
+        "Refresh Interval (in s)",
+        "If this value is larger than 0, the GUI is only rebuilt when there has been "
+        "input or when this number of seconds has passed since it was rebuilt the last "
+        "time. In between, the GUI from the previous rebuild is drawn again, which means "
+        "that displayed values are updated at this interval. If this value is 0, the "
+        "GUI is rebuilt every frame.",
+        openspace::properties::Property::Visibility::Developer
+    };
 } // namespace
 
 namespace openspace {
@@ -96,9 +107,11 @@ ImGUIModule::ImGUIModule()
     , _property("Settings", "Settings")
     , _showHelpText(ShowHelpInfo, true)
     , _helpTextDelay(HelpTextDelayInfo, 1.f, 0.f, 10.f)
+    , _refreshInterval(RefreshIntervalInfo, 0.f, 0.f, 2.f)
 {
     addProperty(_isEnabled);
     addProperty(_isCollapsed);
+    addProperty(_refreshInterval);
 
     for (gui::GuiComponent* comp : _components) {
         addPropertySubOwner(comp);
@@ -291,6 +304,7 @@ void ImGUIModule::internalInitializeGL() {
 
     const int nWindows = global::windowDelegate->nWindows();
     _contexts.resize(nWindows);
+    _retainedStates.resize(nWindows);
 
     for (int i = 0; i < nWindows; i++) {
         _contexts[i] = ImGui::CreateContext();
@@ -382,7 +396,7 @@ void ImGUIModule::internalInitializeGL() {
         comp->initialize();
     }
 
-    _program = ghoul::opengl::ProgramObject::Build(
+    _program = global::renderEngine->buildCachedProgram(
         "GUI",
         absPath("${MODULE_IMGUI}/shaders/gui_vs.glsl"),
         absPath("${MODULE_IMGUI}/shaders/gui_fs.glsl")
@@ -493,55 +507,38 @@ void ImGUIModule::renderFrame(float deltaTime, const glm::vec2& windowSize,
     io.MouseDown[0] = mouseButtonsPressed & (1 << 0);
     io.MouseDown[1] = mouseButtonsPressed & (1 << 1);
 
-    ImGui::NewFrame();
+    // In retained mode the GUI is only rebuilt when there was input, the window changed,
+    // or the refresh interval has passed. Otherwise the draw lists that were recorded in
+    // a previous frame are submitted again
+    RetainedState& state = _retainedStates[iWindow];
+    const double now = global::windowDelegate->applicationTime();
+    const bool isRetained = _refreshInterval > 0.f;
+    const bool needsRecord = !isRetained || state.hasPendingInput ||
+        !ImGui::GetDrawData() || windowSize != state.windowSize ||
+        mousePos != state.mousePosition || mouseButtonsPressed != state.mouseButtons ||
+        now - state.lastRecordTime >= _refreshInterval;
+
+    if (needsRecord) {
+        if (isRetained && state.lastRecordTime >= 0.0) {
+            // ImGui has to know about all of the time that has passed since the last
+            // time the frame was recorded for its animations and tooltip delays
+            const float elapsed = static_cast<float>(now - state.lastRecordTime);
+            io.DeltaTime = std::max(elapsed, deltaTime);
+        }
+        recordFrame();
+
+        state.lastRecordTime = now;
+        state.windowSize = windowSize;
+        state.mousePosition = mousePos;
+        state.mouseButtons = mouseButtonsPressed;
+        state.hasPendingInput = false;
+    }
 
     if (_program->isDirty()) {
         _program->rebuildFromFile();
         ghoul::opengl::updateUniformLocations(*_program, _uniformCache);
     }
 
-   //
-   // Render
-   ImGui::SetNextWindowCollapsed(_isCollapsed);
-
-   ImGui::Begin("OpenSpace GUI", nullptr);
-
-   _isCollapsed = ImGui::IsWindowCollapsed();
-
-   for (gui::GuiComponent* comp : _components) {
-       bool enabled = comp->isEnabled();
-       ImGui::Checkbox(comp->guiName().c_str(), &enabled);
-       comp->setEnabled(enabled);
-   }
-
-#ifdef SHOW_IMGUI_HELPERS
-   ImGui::Checkbox("ImGUI Internals", &_showInternals);
-   if (_showInternals) {
-       ImGui::Begin("Style Editor");
-       ImGui::ShowStyleEditor();
-       ImGui::End();
-
-       ImGui::Begin("Test Window");
-       ImGui::ShowDemoWindow();
-       ImGui::End();
-
-       ImGui::Begin("Metrics Window");
-       ImGui::ShowMetricsWindow();
-       ImGui::End();
-   }
-#endif
-
-   ImGui::End();
-
-
-    for (gui::GuiComponent* comp : _components) {
-        if (comp->isEnabled()) {
-            comp->render();
-        }
-    }
-
-    ImGui::Render();
-
     // Drawing
     ImDrawData* drawData = ImGui::GetDrawData();
 
@@ -556,7 +553,11 @@ void ImGUIModule::renderFrame(float deltaTime, const glm::vec2& windowSize,
     if (fbWidth == 0 || fbHeight == 0) {
         return;
     }
-    drawData->ScaleClipRects(io.DisplayFramebufferScale);
+    if (needsRecord) {
+        // The clip rectangles are scaled in place, so this must only happen once for
+        // each recorded frame
+        drawData->ScaleClipRects(io.DisplayFramebufferScale);
+    }
 
     // Setup render state:
     // alpha-blending enabled, no face culling, no depth testing, scissor enabled
@@ -642,6 +643,58 @@ void ImGUIModule::renderFrame(float deltaTime, const glm::vec2& windowSize,
     glDisable(GL_SCISSOR_TEST);
 }
 
+void ImGUIModule::notifyInput() {
+    for (RetainedState& state : _retainedStates) {
+        state.hasPendingInput = true;
+    }
+}
+
+void ImGUIModule::recordFrame() {
+    ImGui::NewFrame();
+
+   //
+   // Render
+   ImGui::SetNextWindowCollapsed(_isCollapsed);
+
+   ImGui::Begin("OpenSpace GUI", nullptr);
+
+   _isCollapsed = ImGui::IsWindowCollapsed();
+
+   for (gui::GuiComponent* comp : _components) {
+       bool enabled = comp->isEnabled();
+       ImGui::Checkbox(comp->guiName().c_str(), &enabled);
+       comp->setEnabled(enabled);
+   }
+
+#ifdef SHOW_IMGUI_HELPERS
+   ImGui::Checkbox("ImGUI Internals", &_showInternals);
+   if (_showInternals) {
+       ImGui::Begin("Style Editor");
+       ImGui::ShowStyleEditor();
+       ImGui::End();
+
+       ImGui::Begin("Test Window");
+       ImGui::ShowDemoWindow();
+       ImGui::End();
+
+       ImGui::Begin("Metrics Window");
+       ImGui::ShowMetricsWindow();
+       ImGui::End();
+   }
+#endif
+
+   ImGui::End();
+
+
+    for (gui::GuiComponent* comp : _components) {
+        if (comp->isEnabled()) {
+            comp->render();
+        }
+    }
+
+    ImGui::Render();
+}
+
 bool ImGUIModule::mouseButtonCallback(MouseButton, MouseAction) {
     const ImGuiIO& io = ImGui::GetIO();
     const bool consumeEvent = io.WantCaptureMouse;
@@ -649,6 +702,7 @@ bool ImGUIModule::mouseButtonCallback(MouseButton, MouseAction) {
 }
 
 bool ImGUIModule::mouseWheelCallback(double position) {
+    notifyInput();
     ImGuiIO& io = ImGui::GetIO();
     const bool consumeEvent = io.WantCaptureMouse;
     if (consumeEvent) {
@@ -658,6 +712,7 @@ bool ImGUIModule::mouseWheelCallback(double position) {
 }
 
 bool ImGUIModule::keyCallback(Key key, KeyModifier modifier, KeyAction action) {
+    notifyInput();
     const int keyIndex = static_cast<int>(key);
     if (keyIndex < 0) {
         return false;
@@ -698,6 +753,7 @@ bool ImGUIModule::keyCallback(Key key, KeyModifier modifier, KeyAction action) {
 }
 
 bool ImGUIModule::charCallback(unsigned int character, KeyModifier) {
+    notifyInput();
     ImGuiIO& io = ImGui::GetIO();
     const bool consumeEvent = io.WantCaptureKeyboard;
     if (consumeEvent) {
@@ -707,6 +763,7 @@ bool ImGUIModule::charCallback(unsigned int character, KeyModifier) {
 }
 
 bool ImGUIModule::touchDetectedCallback(TouchInput input) {
+    notifyInput();
     ImGuiIO& io = ImGui::GetIO();
     const glm::vec2 windowPos = input.currentWindowCoordinates();
     const bool consumeEvent = io.WantCaptureMouse;
@@ -726,6 +783,7 @@ bool ImGUIModule::touchUpdatedCallback(TouchInput input) {
     if (_validTouchStates.empty()) {
         return false;
     }
+    notifyInput();
     ImGuiIO& io = ImGui::GetIO();
 
     auto it = std::find_if(
@@ -753,6 +811,7 @@ void ImGUIModule::touchExitCallback(TouchInput input) {
     if (_validTouchStates.empty()) {
         return;
     }
+    notifyInput();
 
     const auto found = std::find_if(
         _validTouchStates.cbegin(),
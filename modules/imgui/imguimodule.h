@@ -31,6 +31,7 @@
 #include <modules/imgui/include/guifilepathcomponent.h>
 #include <modules/imgui/include/guigibscomponent.h>
 #include <modules/imgui/include/guiglobebrowsingcomponent.h>
+#include <modules/imgui/include/guigputimingcomponent.h>
 #include <modules/imgui/include/guihelpcomponent.h>
 #include <modules/imgui/include/guijoystickcomponent.h>
 #include <modules/imgui/include/guimemorycomponent.h>
@@ -66,6 +67,10 @@ public:
     void internalDeinitializeGL() override;
 
 private:
+    // Forces the GUI to be rebuilt in the next frame when running in retained mode.
+    // Mouse position and button changes are detected when rendering the frame instead
+    void notifyInput();
+
     bool mouseButtonCallback(MouseButton button, MouseAction action);
     bool mouseWheelCallback(double position);
     bool keyCallback(Key key, KeyModifier modifier, KeyAction action);
@@ -78,6 +83,7 @@ private:
     void renderFrame(float deltaTime, const glm::vec2& windowSize,
         const glm::vec2& dpiScaling, const glm::vec2& mousePos,
         uint32_t mouseButtonsPressed);
+    void recordFrame(); // Rebuilds the GUI and records new draw lists
 
     properties::BoolProperty _isEnabled;
     properties::BoolProperty _isCollapsed;
@@ -92,15 +98,17 @@ private:
     gui::GuiGIBSComponent _gibs;
     gui::GuiMissionComponent _mission;
     gui::GuiMemoryComponent _memoryComponent;
+    gui::GuiGpuTimingComponent _gpuTiming;
     gui::GuiSceneComponent _sceneView;
     gui::GuiFilePathComponent _filePath;
     gui::GuiHelpComponent _help;
 
     properties::BoolProperty _showHelpText;
     properties::FloatProperty _helpTextDelay;
+    properties::FloatProperty _refreshInterval;
 
     // The ordering of this array determines the order of components in the in-game menu
-    static constexpr int nComponents = 13;
+    static constexpr int nComponents = 14;
     std::array<gui::GuiComponent*, nComponents> _components = {
         &_sceneProperty,
         &_property,
@@ -112,6 +120,7 @@ private:
         &_gibs,
         &_mission,
         &_memoryComponent,
+        &_gpuTiming,
         &_sceneView,
         &_filePath,
         &_help
@@ -126,6 +135,17 @@ private:
 
     std::vector<ImGuiContext*> _contexts;
 
+    // Information about the last time the GUI of each window was rebuilt, used to decide
+    // whether the GUI has to be rebuilt in retained mode
+    struct RetainedState {
+        double lastRecordTime = -1.0;
+        glm::vec2 windowSize = glm::vec2(0.f);
+        glm::vec2 mousePosition = glm::vec2(0.f);
+        uint32_t mouseButtons = 0;
+        bool hasPendingInput = true;
+    };
+    std::vector<RetainedState> _retainedStates;
+
     std::vector<TouchInput> _validTouchStates;
 
     std::vector<char> _iniFileBuffer;
@@ -0,0 +1,119 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/imgui/include/guigputimingcomponent.h>
+
+#include <modules/imgui/include/imgui_include.h>
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/gputimerpool.h>
+#include <openspace/rendering/renderengine.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    const ImVec2 Size = ImVec2(400, 500);
+
+    enum Column {
+        Name = 0,
+        Time
+    };
+} // namespace
+
+namespace openspace::gui {
+
+GuiGpuTimingComponent::GuiGpuTimingComponent()
+    : GuiComponent("gpu_timing", "GPU Timing")
+{}
+
+void GuiGpuTimingComponent::render() {
+    ImGui::SetNextWindowCollapsed(_isCollapsed);
+
+    bool v = _isEnabled;
+    ImGui::SetNextWindowSize(Size, ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.5f);
+    ImGui::Begin("GPU Timing", &v);
+    _isEnabled = v;
+    _isCollapsed = ImGui::IsWindowCollapsed();
+
+    const GpuTimerPool& timers = global::renderEngine->gpuTimerPool();
+    if (!timers.isEnabled()) {
+        ImGui::TextWrapped(
+            "%s",
+            "The GPU timing is disabled. It can be enabled with the property "
+            "'RenderEngine.GpuTiming.Enabled'"
+        );
+        ImGui::End();
+        return;
+    }
+
+    std::vector<GpuTimerPool::Timing> timings = timers.timings();
+
+    constexpr ImGuiTableFlags Flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg |
+        ImGuiTableFlags_BordersOuter | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("GpuTimings", 2, Flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_None, 0.f, Column::Name);
+        constexpr ImGuiTableColumnFlags TimeFlags = ImGuiTableColumnFlags_DefaultSort |
+            ImGuiTableColumnFlags_PreferSortDescending;
+        ImGui::TableSetupColumn("Time (ms)", TimeFlags, 0.f, Column::Time);
+        ImGui::TableHeadersRow();
+
+        // The timings change every frame, so they are sorted every frame regardless of
+        // whether the sort specification has changed
+        const ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+        if (specs && specs->SpecsCount > 0) {
+            const ImGuiTableColumnSortSpecs& spec = specs->Specs[0];
+            const bool isAscending = spec.SortDirection == ImGuiSortDirection_Ascending;
+            std::sort(
+                timings.begin(),
+                timings.end(),
+                [&spec, isAscending](const GpuTimerPool::Timing& lhs,
+                                     const GpuTimerPool::Timing& rhs)
+                {
+                    const bool isLess = spec.ColumnUserID == Column::Name ?
+                        lhs.name < rhs.name :
+                        lhs.time < rhs.time;
+                    const bool isGreater = spec.ColumnUserID == Column::Name ?
+                        rhs.name < lhs.name :
+                        rhs.time < lhs.time;
+                    return isAscending ? isLess : isGreater;
+                }
+            );
+        }
+
+        for (const GpuTimerPool::Timing& timing : timings) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", timing.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", timing.time);
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+} // namespace openspace::gui
@@ -76,6 +76,11 @@ void GuiMemoryComponent::render() {
     ImGui::Text("%s", "Persistent Memory Pool");
     renderMemoryPoolInformation(global::memoryManager->PersistentMemory);
 
+    ImGui::Spacing();
+
+    ImGui::Text("%s", "Scene Graph Memory Pool");
+    renderMemoryPoolInformation(global::memoryManager->SceneGraphMemory);
+
     ImGui::End();
 }
 
@@ -27,8 +27,11 @@
 #include <modules/iswa/rendering/iswadatagroup.h>
 #include <modules/iswa/util/dataprocessor.h>
 #include <modules/iswa/util/iswamanager.h>
+#include <openspace/engine/globals.h>
 #include <openspace/rendering/transferfunction.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/filesystem/filesystem.h>
+#include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/stringhelper.h>
 #include <ghoul/opengl/programobject.h>
@@ -114,32 +117,78 @@ DataCygnet::DataCygnet(const ghoul::Dictionary& dictionary)
 
 DataCygnet::~DataCygnet() {}
 
-bool DataCygnet::updateTexture() {
-    const std::vector<float*>& data = textureData();
+void DataCygnet::deinitializeGL() {
+    if (_processingJob.valid()) {
+        // The worker might still be writing into the buffers, so we have to wait for it
+        try {
+            for (float* values : _processingJob.get()) {
+                delete[] values;
+            }
+        }
+        catch (const std::exception&) {}
+    }
+    _backTextures.clear();
+
+    IswaCygnet::deinitializeGL();
+}
+
+void DataCygnet::update(const UpdateData& data) {
+    IswaCygnet::update(data);
+
+    if (!_processingJob.valid() || !DownloadManager::futureReady(_processingJob)) {
+        return;
+    }
+
+    try {
+        uploadTextures(_processingJob.get());
+    }
+    catch (const std::exception& e) {
+        LERROR(std::format("Error processing data for '{}': {}", identifier(), e.what()));
+    }
 
-    if (data.empty()) {
+    if (_hasPendingFilterUpdate) {
+        _hasPendingFilterUpdate = false;
+        if (_autoFilter) {
+            _backgroundValues = _dataProcessor->filterValues();
+        }
+    }
+
+    if (_hasPendingUpdate) {
+        _hasPendingUpdate = false;
+        updateTexture();
+    }
+}
+
+bool DataCygnet::updateTexture() {
+    if (_processingJob.valid()) {
+        // Only one job per cygnet is in flight at a time. The data is processed again
+        // with the latest settings as soon as the current job has finished
+        _hasPendingUpdate = true;
         return false;
     }
 
-    bool texturesReady = false;
-    const std::set<std::string>& selectedOptions = _dataOptions;
-    const std::vector<std::string>& options = _dataOptions.options();
-    std::vector<int> selectedOptionsIndices;
-    for (const std::string& option : selectedOptions) {
-        auto it = std::find(options.begin(), options.end(), option);
-        ghoul_assert(it != options.end(), "Selected option must be in all options");
-        int idx = static_cast<int>(std::distance(options.begin(), it));
-        selectedOptionsIndices.push_back(idx);
+    std::function<std::vector<float*>()> job = textureDataJob();
+    if (!job) {
+        return false;
     }
 
-    for (int option : selectedOptionsIndices) {
+    _processingJob = global::threadPool->submit(std::move(job));
+    return true;
+}
+
+void DataCygnet::uploadTextures(std::vector<float*> data) {
+    _backTextures.resize(_textures.size());
+
+    const int nOptions = static_cast<int>(std::min(data.size(), _textures.size()));
+    for (int option = 0; option < nOptions; option++) {
         float* values = data[option];
         if (!values) {
             continue;
         }
 
-        if (!_textures[option]) {
-            auto texture = std::make_unique<ghoul::opengl::Texture>(
+        std::unique_ptr<ghoul::opengl::Texture>& texture = _backTextures[option];
+        if (!texture) {
+            texture = std::make_unique<ghoul::opengl::Texture>(
                 values,
                 _textureDimensions,
                 GL_TEXTURE_2D,
@@ -152,15 +201,31 @@ bool DataCygnet::updateTexture() {
 
             texture->uploadTexture();
             texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-            _textures[option] = std::move(texture);
         }
         else {
-            _textures[option]->setPixelData(values);
-            _textures[option]->uploadTexture();
+            texture->setPixelData(values);
+            texture->uploadTexture();
         }
-        texturesReady = true;
+        std::swap(_textures[option], texture);
+    }
+
+    // Buffers for options that no longer exist are not owned by any texture
+    for (size_t i = nOptions; i < data.size(); i++) {
+        delete[] data[i];
+    }
+}
+
+std::vector<int> DataCygnet::selectedOptionIndices() const {
+    const std::set<std::string>& selectedOptions = _dataOptions;
+    const std::vector<std::string>& options = _dataOptions.options();
+    std::vector<int> selectedOptionsIndices;
+    for (const std::string& option : selectedOptions) {
+        auto it = std::find(options.begin(), options.end(), option);
+        ghoul_assert(it != options.end(), "Selected option must be in all options");
+        int idx = static_cast<int>(std::distance(options.begin(), it));
+        selectedOptionsIndices.push_back(idx);
     }
-    return texturesReady;
+    return selectedOptionsIndices;
 }
 
 bool DataCygnet::downloadTextureResource(double timestamp) {
@@ -188,7 +253,7 @@ bool DataCygnet::updateTextureResource() {
         return false;
     }
 
-    _dataBuffer = std::string(dataFile.buffer, dataFile.size);
+    _dataBuffer = std::make_shared<const std::string>(dataFile.buffer, dataFile.size);
     delete[] dataFile.buffer;
 
     return true;
@@ -205,14 +270,7 @@ bool DataCygnet::readyToRender() const {
  */
 void DataCygnet::setTextureUniforms() {
     const std::set<std::string>& selectedOptions = _dataOptions;
-    const std::vector<std::string>& options = _dataOptions.options();
-    std::vector<int> selectedOptionsIndices;
-    for (const std::string& option : selectedOptions) {
-        auto it = std::find(options.begin(), options.end(), option);
-        ghoul_assert(it != options.end(), "Selected option must be in all options");
-        int idx = static_cast<int>(std::distance(options.begin(), it));
-        selectedOptionsIndices.push_back(idx);
-    }
+    const std::vector<int> selectedOptionsIndices = selectedOptionIndices();
 
     int activeTextures = std::min(static_cast<int>(selectedOptions.size()), MaxTextures);
     int activeTransferfunctions = std::min(
@@ -328,9 +386,8 @@ void DataCygnet::setPropertyCallbacks() {
     _useHistogram.onChange([this]() {
         _dataProcessor->useHistogram(_useHistogram);
         updateTexture();
-        if (_autoFilter) {
-            _backgroundValues = _dataProcessor->filterValues();
-        }
+        // The filter values are only known once the data has been processed again
+        _hasPendingFilterUpdate = true;
     });
 
     _dataOptions.onChange([this]() {
@@ -31,6 +31,9 @@
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/vector/vec2property.h>
 #include <glm/gtx/std_based_type.hpp>
+#include <functional>
+#include <future>
+#include <memory>
 
 namespace openspace {
 
@@ -46,7 +49,16 @@ public:
     DataCygnet(const ghoul::Dictionary& dictionary);
     ~DataCygnet();
 
+    void deinitializeGL() override;
+    void update(const UpdateData& data) override;
+
 protected:
+    /**
+     * Starts processing the current data on a worker thread. The textures are updated in
+     * a later call to #update once the processing has finished.
+     *
+     * \return `true` if the processing was started
+     */
     bool updateTexture() override;
     void fillOptions(const std::string& source);
 
@@ -79,7 +91,16 @@ protected:
      */
     virtual bool updateTextureResource() override;
 
-    virtual std::vector<float*> textureData() = 0;
+    /// Returns the indices of the currently selected data options
+    std::vector<int> selectedOptionIndices() const;
+
+    /**
+     * Returns a function that creates the buffers for the textures of all data options.
+     * This function is called on the main thread, but the returned function is executed
+     * on a worker thread and must therefore only use values it has captured. If no data
+     * should be processed, an empty function is returned.
+     */
+    virtual std::function<std::vector<float*>()> textureDataJob() = 0;
 
     properties::SelectionProperty _dataOptions;
     properties::StringProperty _transferFunctionsFile;
@@ -90,12 +111,24 @@ protected:
     properties::BoolProperty _autoFilter;
 
     std::shared_ptr<DataProcessor> _dataProcessor;
-    std::string _dataBuffer;
+    std::shared_ptr<const std::string> _dataBuffer;
     glm::size3_t _textureDimensions = glm::size3_t(0);
 
 private:
     bool readyToRender() const override;
     bool downloadTextureResource(double timestamp) override;
+
+    void uploadTextures(std::vector<float*> data);
+
+    std::future<std::vector<float*>> _processingJob;
+    /// Set if the data should be processed again once the current job has finished
+    bool _hasPendingUpdate = false;
+    /// Set if the background values should be taken from the processed data
+    bool _hasPendingFilterUpdate = false;
+
+    // The textures are double-buffered so that the upload never has to wait for the
+    // rendering with the previous texture to finish
+    std::vector<std::unique_ptr<ghoul::opengl::Texture>> _backTextures;
 };
 
 } //namespace openspace
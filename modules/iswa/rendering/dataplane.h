@@ -52,7 +52,7 @@ private:
     bool destroyGeometry() override;
     void renderGeometry() const override;
     void setUniforms() override;
-    std::vector<float*> textureData() override;
+    std::function<std::vector<float*>()> textureDataJob() override;
 
     GLuint _quad;
     GLuint _vertexPositionBuffer;
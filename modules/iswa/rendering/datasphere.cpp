@@ -106,25 +106,30 @@ void DataSphere::renderGeometry() const {
     _sphere->render();
 }
 
-std::vector<float*> DataSphere::textureData() {
+std::function<std::vector<float*>()> DataSphere::textureDataJob() {
     // if the buffer in the datafile is empty, do not proceed
-    if (_dataBuffer.empty()) {
-        return std::vector<float*>();
+    if (!_dataBuffer || _dataBuffer->empty()) {
+        return nullptr;
     }
 
     if (!_dataOptions.options().empty()) { // load options for value selection
-        fillOptions(_dataBuffer);
-        _dataProcessor->addDataValues(_dataBuffer, _dataOptions);
+        fillOptions(*_dataBuffer);
+        _dataProcessor->addDataValues(*_dataBuffer, _dataOptions);
 
         // if this datacygnet has added new values then reload texture
         // for the whole group, including this datacygnet, and return after.
         if (_group) {
             _group->updateGroup();
-            return std::vector<float*>();
+            return nullptr;
         }
     }
     // _textureDimensions = _dataProcessor->setDimensions();
-    return _dataProcessor->processData(_dataBuffer, _dataOptions, _textureDimensions);
+    return [processor = _dataProcessor, data = _dataBuffer,
+            options = _dataOptions.options(), selected = selectedOptionIndices(),
+            dimensions = _textureDimensions]()
+    {
+        return processor->processData(*data, options, selected, dimensions);
+    };
 }
 
 void DataSphere::setUniforms() {
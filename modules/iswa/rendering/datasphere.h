@@ -51,7 +51,7 @@ protected:
     bool destroyGeometry() override;
     void renderGeometry() const override;
     void setUniforms() override;
-    std::vector<float*> textureData() override;
+    std::function<std::vector<float*>()> textureDataJob() override;
 
     std::unique_ptr<Sphere> _sphere;
     float _radius;
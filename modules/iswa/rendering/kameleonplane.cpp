@@ -251,10 +251,16 @@ void KameleonPlane::renderGeometry() const {
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
-std::vector<float*> KameleonPlane::textureData() {
-    DataProcessorKameleon* p = dynamic_cast<DataProcessorKameleon*>(_dataProcessor.get());
-    p->setSlice(_slice);
-    return p->processData(_kwPath, _dataOptions, _dimensions);
+std::function<std::vector<float*>()> KameleonPlane::textureDataJob() {
+    std::shared_ptr<DataProcessorKameleon> p =
+        std::dynamic_pointer_cast<DataProcessorKameleon>(_dataProcessor);
+
+    return [processor = std::move(p), path = _kwPath, options = _dataOptions.options(),
+            selected = selectedOptionIndices(), dimensions = _dimensions,
+            slice = _slice.value()]()
+    {
+        return processor->processData(path, options, selected, dimensions, slice);
+    };
 }
 
 bool KameleonPlane::updateTextureResource() {
@@ -56,7 +56,7 @@ private:
     bool updateTextureResource() override;
     void renderGeometry() const override;
     void setUniforms() override;
-    std::vector<float*> textureData() override;
+    std::function<std::vector<float*>()> textureDataJob() override;
 
     void setDimensions();
 
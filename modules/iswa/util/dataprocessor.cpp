@@ -32,26 +32,32 @@
 namespace openspace {
 
 void DataProcessor::useLog(bool useLog) {
+    std::lock_guard lock(_mutex);
     _useLog = useLog;
 }
 
 void DataProcessor::useHistogram(bool useHistogram) {
+    std::lock_guard lock(_mutex);
     _useHistogram = useHistogram;
 }
 
 void DataProcessor::normValues(glm::vec2 normValues) {
+    std::lock_guard lock(_mutex);
     _normValues = normValues;
 }
 
 glm::size3_t DataProcessor::dimensions() const {
+    std::lock_guard lock(_mutex);
     return _dimensions;
 }
 
 glm::vec2 DataProcessor::filterValues() const {
+    std::lock_guard lock(_mutex);
     return _filterValues;
 }
 
 void DataProcessor::clear() {
+    std::lock_guard lock(_mutex);
     _min.clear();
     _max.clear();
     _sum.clear();
@@ -269,17 +275,16 @@ void DataProcessor::add(const std::vector<std::vector<float>>& optionValues,
             _histograms[i] = std::move(newHist);
         }
 
+        std::vector<float> normalizedValues(numValues);
         for (int j = 0; j < numValues; j++) {
-            _histograms[i]->add(
-                normalizeWithStandardScore(
-                    values[j],
-                    mean,
-                    _standardDeviation[i],
-                    _histNormValues
-                ),
-                1
+            normalizedValues[j] = normalizeWithStandardScore(
+                values[j],
+                mean,
+                _standardDeviation[i],
+                _histNormValues
             );
         }
+        _histograms[i]->add(normalizedValues);
 
         _histograms[i]->generateEqualizer();
     }
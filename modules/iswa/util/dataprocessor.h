@@ -28,6 +28,7 @@
 #include <ghoul/glm.h>
 #include <glm/gtx/std_based_type.hpp>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -49,8 +50,21 @@ public:
     virtual void addDataValues(const std::string& data,
         properties::SelectionProperty& dataOptions) = 0;
 
+    /**
+     * Parses the \p data and returns the normalized values for each of the
+     * \p selectedOptions, ready to be uploaded into a texture. The buffers of options
+     * that are not selected are `nullptr`. The function only uses the passed snapshot of
+     * the options and can therefore be called from a worker thread.
+     *
+     * \param data The data that should be processed
+     * \param options All of the options that are available in the data
+     * \param selectedOptions The indices into \p options that should be processed
+     * \param dimensions The dimensions of the resulting buffers
+     * \return One buffer per option, which is owned by the caller
+     */
     virtual std::vector<float*> processData(const std::string& data,
-        properties::SelectionProperty& dataOptions, glm::size3_t& dimensions) = 0;
+        const std::vector<std::string>& options, const std::vector<int>& selectedOptions,
+        const glm::size3_t& dimensions) = 0;
 
     void useLog(bool useLog);
     void useHistogram(bool useHistogram);
@@ -89,6 +103,10 @@ protected:
     std::set<std::string> _coordinateVariables = { "x", "y", "z", "phi", "theta" };
 
     glm::vec2 _histNormValues = glm::vec2(10.f);
+
+    /// Protects the statistics, as the data is processed on worker threads and shared
+    /// between all cygnets in a group
+    mutable std::mutex _mutex;
 };
 
 } // namespace openspace
@@ -64,6 +64,8 @@ std::vector<std::string> DataProcessorJson::readMetadata(const std::string& data
 void DataProcessorJson::addDataValues(const std::string& data,
                                       properties::SelectionProperty& dataOptions)
 {
+    std::lock_guard lock(_mutex);
+
     int numOptions = static_cast<int>(dataOptions.options().size());
     initializeVectors(numOptions);
 
@@ -98,27 +100,20 @@ void DataProcessorJson::addDataValues(const std::string& data,
 }
 
 std::vector<float*> DataProcessorJson::processData(const std::string& data,
-                                                properties::SelectionProperty& optionProp,
-                                                                 glm::size3_t& dimensions)
+                                                  const std::vector<std::string>& options,
+                                                  const std::vector<int>& selectedOptions,
+                                                           const glm::size3_t& dimensions)
 {
     if (data.empty()) {
         return std::vector<float*>();
     }
+    // Parsing the data does not need access to the shared statistics
     const json& j = json::parse(data);
     json variables = j["variables"];
 
-    const std::set<std::string>& selectedOptions = optionProp;
-    const std::vector<std::string>& options = optionProp.options();
-    std::vector<int> selectedOptionsIndices;
-    for (const std::string& option : selectedOptions) {
-        auto it = std::find(options.begin(), options.end(), option);
-        ghoul_assert(it != options.end(), "Selected option must be in all options");
-        int idx = static_cast<int>(std::distance(options.begin(), it));
-        selectedOptionsIndices.push_back(idx);
-    }
-
+    std::lock_guard lock(_mutex);
     std::vector<float*> dataOptions(options.size(), nullptr);
-    for (int option : selectedOptionsIndices) {
+    for (int option : selectedOptions) {
         // @CLEANUP: This memory is very easy to lose and should be replaced by some
         //           other mechanism (std::vector<float> most likely)
         dataOptions[option] = new float[dimensions.x * dimensions.y] { 0.f };
@@ -139,7 +134,7 @@ std::vector<float*> DataProcessorJson::processData(const std::string& data,
         }
     }
 
-    calculateFilterValues(selectedOptionsIndices);
+    calculateFilterValues(selectedOptions);
     return dataOptions;
 }
 
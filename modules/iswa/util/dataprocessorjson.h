@@ -41,7 +41,8 @@ public:
         properties::SelectionProperty& dataOptions) override;
 
     virtual std::vector<float*> processData(const std::string& data,
-        properties::SelectionProperty& dataOptions, glm::size3_t& dimensions) override;
+        const std::vector<std::string>& options, const std::vector<int>& selectedOptions,
+        const glm::size3_t& dimensions) override;
 };
 
 } // namespace openspace
@@ -42,6 +42,8 @@ DataProcessorKameleon::~DataProcessorKameleon() {}
 std::vector<std::string> DataProcessorKameleon::readMetadata(const std::string& path,
                                                              glm::size3_t&)
 {
+    std::lock_guard lock(_mutex);
+
     if (path.empty()) {
         return std::vector<std::string>();
     }
@@ -68,6 +70,8 @@ std::vector<std::string> DataProcessorKameleon::readMetadata(const std::string&
 void DataProcessorKameleon::addDataValues(const std::string& path,
                                           properties::SelectionProperty& dataOptions)
 {
+    std::lock_guard lock(_mutex);
+
     int numOptions = static_cast<int>(dataOptions.options().size());
     initializeVectors(numOptions);
 
@@ -107,10 +111,30 @@ void DataProcessorKameleon::addDataValues(const std::string& path,
 }
 
 std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
-                                                properties::SelectionProperty& optionProp,
-                                                                 glm::size3_t& dimensions)
+                                                  const std::vector<std::string>& options,
+                                                  const std::vector<int>& selectedOptions,
+                                                           const glm::size3_t& dimensions)
+{
+    std::lock_guard lock(_mutex);
+    return processSlice(path, options, selectedOptions, dimensions);
+}
+
+std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
+                                                  const std::vector<std::string>& options,
+                                                  const std::vector<int>& selectedOptions,
+                                              const glm::size3_t& dimensions, float slice)
 {
-    const int numOptions = static_cast<int>(optionProp.options().size());
+    std::lock_guard lock(_mutex);
+    _slice = slice;
+    return processSlice(path, options, selectedOptions, dimensions);
+}
+
+std::vector<float*> DataProcessorKameleon::processSlice(const std::string& path,
+                                                  const std::vector<std::string>& options,
+                                                  const std::vector<int>& selectedOptions,
+                                                           const glm::size3_t& dimensions)
+{
+    const int numOptions = static_cast<int>(options.size());
 
     if (path.empty()) {
         return std::vector<float*>(numOptions, nullptr);
@@ -120,20 +144,10 @@ std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
         initializeKameleonWrapper(path);
     }
 
-    const std::set<std::string>& selectedOptions = optionProp;
-    const std::vector<std::string>& options = optionProp.options();
-    std::vector<int> selectedOptionsIndices;
-    for (const std::string& option : selectedOptions) {
-        auto it = std::find(options.begin(), options.end(), option);
-        ghoul_assert(it != options.end(), "Selected option must be in all options");
-        int idx = static_cast<int>(std::distance(options.begin(), it));
-        selectedOptionsIndices.push_back(idx);
-    }
-
     const int numValues = static_cast<int>(glm::compMul(dimensions));
 
     std::vector<float*> dataOptions(numOptions, nullptr);
-    for (int option : selectedOptionsIndices) {
+    for (int option : selectedOptions) {
         dataOptions[option] = _kw->uniformSliceValues(
             options[option],
             dimensions,
@@ -146,15 +160,17 @@ std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
         }
     }
 
-    calculateFilterValues(selectedOptionsIndices);
+    calculateFilterValues(selectedOptions);
     return dataOptions;
 }
 
 void DataProcessorKameleon::setSlice(float slice) {
+    std::lock_guard lock(_mutex);
     _slice = slice;
 }
 
 void DataProcessorKameleon::setDimensions(glm::size3_t dimensions) {
+    std::lock_guard lock(_mutex);
     _dimensions = std::move(dimensions);
 }
 
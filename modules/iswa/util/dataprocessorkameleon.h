@@ -43,7 +43,17 @@ public:
         properties::SelectionProperty& dataOptions) override;
 
     virtual std::vector<float*> processData(const std::string& path,
-        properties::SelectionProperty& dataOptions, glm::size3_t& dimensions) override;
+        const std::vector<std::string>& options, const std::vector<int>& selectedOptions,
+        const glm::size3_t& dimensions) override;
+
+    /**
+     * Same as the other processData overload, but sets the slice that is used atomically
+     * with the processing, so that multiple cygnets sharing this processor can process
+     * their slices concurrently.
+     */
+    std::vector<float*> processData(const std::string& path,
+        const std::vector<std::string>& options, const std::vector<int>& selectedOptions,
+        const glm::size3_t& dimensions, float slice);
 
     void setSlice(float slice);
 
@@ -52,6 +62,10 @@ public:
 private:
     void initializeKameleonWrapper(std::string kwPath);
 
+    std::vector<float*> processSlice(const std::string& path,
+        const std::vector<std::string>& options, const std::vector<int>& selectedOptions,
+        const glm::size3_t& dimensions);
+
     std::shared_ptr<KameleonWrapper> _kw;
     std::string _kwPath;
     std::vector<std::string> _loadedVariables;
@@ -84,6 +84,8 @@ std::vector<std::string> DataProcessorText::readMetadata(const std::string& data
 void DataProcessorText::addDataValues(const std::string& data,
                                       properties::SelectionProperty& dataOptions)
 {
+    std::lock_guard lock(_mutex);
+
     int numOptions = static_cast<int>(dataOptions.options().size());
     initializeVectors(numOptions);
 
@@ -140,8 +142,9 @@ void DataProcessorText::addDataValues(const std::string& data,
 }
 
 std::vector<float*> DataProcessorText::processData(const std::string& data,
-                                                   properties::SelectionProperty& options,
-                                                                 glm::size3_t& dimensions)
+                                                  const std::vector<std::string>& options,
+                                                  const std::vector<int>& selectedOptions,
+                                                           const glm::size3_t& dimensions)
 {
     // The update of the selection properties broke this and we don't have the data to
     // actually test whether this update works. So if you are getting a crash around here
@@ -154,22 +157,13 @@ std::vector<float*> DataProcessorText::processData(const std::string& data,
     std::string line;
     std::stringstream memorystream(data);
 
-    const std::set<std::string>& selectedOptions = options.value();
-    const std::vector<std::string>& allOptions = options.options();
-    std::vector<int> selectedOptionsIndices;
-
-    std::vector<float*> dataOptions(options.options().size(), nullptr);
-    for (const std::string& o : selectedOptions) {
-        auto it = std::find(allOptions.begin(), allOptions.end(), o);
-        ghoul_assert(
-            it != allOptions.end(),
-            "Selected option must be in list of all options"
-        );
-        int idx = static_cast<int>(std::distance(allOptions.begin(), it));
-        selectedOptionsIndices.push_back(idx);
+    std::vector<float*> dataOptions(options.size(), nullptr);
+    for (int idx : selectedOptions) {
         dataOptions[idx] = new float[dimensions.x * dimensions.y] { 0.f };
     }
 
+    std::lock_guard lock(_mutex);
+
     int numValues = 0;
     while (ghoul::getline(memorystream, line)) {
         if (!line.empty() && line[0] == '#') {
@@ -186,11 +180,11 @@ std::vector<float*> DataProcessorText::processData(const std::string& data,
             last = (last > 0)? last : lineSize;
 
             const auto it = std::find(
-                selectedOptionsIndices.begin(),
-                selectedOptionsIndices.end(),
+                selectedOptions.begin(),
+                selectedOptions.end(),
                 option
             );
-            if (option >= 0 && it != selectedOptionsIndices.end()) {
+            if (option >= 0 && it != selectedOptions.end()) {
                 const float value = std::stof(line.substr(first, last));
                 dataOptions[option][numValues] = processDataPoint(value, option);
             }
@@ -201,7 +195,7 @@ std::vector<float*> DataProcessorText::processData(const std::string& data,
         numValues++;
     }
 
-    calculateFilterValues(selectedOptionsIndices);
+    calculateFilterValues(selectedOptions);
 
     return dataOptions;
 //#endif
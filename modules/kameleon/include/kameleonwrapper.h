@@ -127,12 +127,15 @@ public:
 private:
     using TraceLine = std::vector<glm::vec3>;
 
-    TraceLine traceCartesianFieldline(const std::string& xVar, const std::string& yVar,
-        const std::string& zVar, const glm::vec3& seedPoint, float stepSize,
-        TraceDirection direction, FieldlineEnd& end) const;
-
-    TraceLine traceLorentzTrajectory(const glm::vec3& seedPoint, float stepsize,
-        float eCharge) const;
+    // The tracing functions are called from multiple threads at once, with an
+    // interpolator that is exclusive to the calling thread
+    TraceLine traceCartesianFieldline(ccmc::Interpolator& interpolator,
+        const std::string& xVar, const std::string& yVar, const std::string& zVar,
+        const glm::vec3& seedPoint, float stepSize, TraceDirection direction,
+        FieldlineEnd& end) const;
+
+    TraceLine traceLorentzTrajectory(ccmc::Interpolator& interpolator,
+        const glm::vec3& seedPoint, float stepsize, float eCharge) const;
 
     GridType gridType(const std::string& x, const std::string& y,
         const std::string& z) const;
@@ -31,7 +31,11 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/stringhelper.h>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <thread>
 
 #ifdef WIN32
 #pragma warning (push)
@@ -54,6 +58,62 @@
 namespace {
     constexpr std::string_view _loggerCat = "KameleonWrapper";
     constexpr float RE_TO_METER = 6371000;
+
+    // Splits the 'nSlices' slices along the z axis of an output grid into contiguous
+    // slabs and calls 'func' with the first and one-past-last slice of each slab. Every
+    // slab is processed on its own thread with an interpolator that is only used by that
+    // thread, as the interpolators keep internal state between calls
+    template <typename Func>
+    void forEachSlab(ccmc::Model* model, size_t nSlices, const Func& func) {
+        const size_t nThreads = std::clamp<size_t>(
+            std::thread::hardware_concurrency(),
+            1,
+            std::max<size_t>(nSlices, 1)
+        );
+
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads);
+        for (size_t i = 0; i < nThreads; i++) {
+            const size_t begin = nSlices * i / nThreads;
+            const size_t end = nSlices * (i + 1) / nThreads;
+            threads.emplace_back([model, begin, end, &func]() {
+                std::unique_ptr<ccmc::Interpolator> interpolator =
+                    std::unique_ptr<ccmc::Interpolator>(model->createNewInterpolator());
+                func(*interpolator, begin, end);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Calls 'func' for the indices of all 'nSeeds' seed points from a number of threads.
+    // Each thread uses its own interpolator, but the indices are handed out one at a time
+    // rather than in slabs, as the time it takes to trace a line varies greatly
+    template <typename Func>
+    void forEachSeedPoint(ccmc::Model* model, size_t nSeeds, const Func& func) {
+        const size_t nThreads = std::clamp<size_t>(
+            std::thread::hardware_concurrency(),
+            1,
+            std::max<size_t>(nSeeds, 1)
+        );
+
+        std::atomic<size_t> next = 0;
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads);
+        for (size_t i = 0; i < nThreads; i++) {
+            threads.emplace_back([model, nSeeds, &next, &func]() {
+                std::unique_ptr<ccmc::Interpolator> interpolator =
+                    std::unique_ptr<ccmc::Interpolator>(model->createNewInterpolator());
+                for (size_t idx = next++; idx < nSeeds; idx = next++) {
+                    func(*interpolator, idx);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
 } // namespace
 
 namespace openspace {
@@ -188,6 +248,10 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
         _model->getVariableAttribute(var, "actual_max").getAttributeFloat();
     LDEBUG(std::format("{} Max: {}", var, varMax));
 
+    // Load the variable up front as the interpolators would otherwise load it lazily
+    // from multiple threads at once
+    _model->loadVariable(var);
+
     // HISTOGRAM
     constexpr int NBins = 200;
     std::vector<int> histogram(NBins, 0);
@@ -201,91 +265,97 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
         return glm::clamp(izerotoone, 0, NBins - 1);
     };
 
-    // ProgressBar pb(static_cast<int>(outDimensions.x));
-    for (size_t x = 0; x < outDimensions.x; ++x) {
-        for (size_t y = 0; y < outDimensions.y; ++y) {
-            for (size_t z = 0; z < outDimensions.z; ++z) {
-                const size_t index = x + y * outDimensions.x +
-                                     z * outDimensions.x * outDimensions.y;
-
-                if (_gridType == GridType::Spherical) {
-                    // Put r in the [0..sqrt(3)] range
-                    const double rNorm = glm::root_three<double>() * x /
-                                         outDimensions.x - 1;
-
-                    // Put theta in the [0..PI] range
-                    const double thetaNorm = glm::pi<double>() * y / outDimensions.y - 1;
-
-                    // Put phi in the [0..2PI] range
-                    const double phiNorm = glm::two_pi<double>() * z /
-                                           outDimensions.z - 1;
-
-                    // Go to physical coordinates before sampling
-                    const double rPh = _min.x + rNorm * (_max.x - _min.x);
-                    const double thetaPh = thetaNorm;
-                    // phi range needs to be mapped to the slightly different model
-                    // range to avoid gaps in the data Subtract a small term to
-                    // avoid rounding errors when comparing to phiMax.
-                    const double phiPh = _min.z + phiNorm /
-                                    glm::two_pi<double>() * (_max.z - _min.z - 0.000001);
-
-                    double value = 0.0;
-                    // See if sample point is inside domain
-                    if (rPh < _min.x || rPh > _max.x || thetaPh < _min.y ||
-                        thetaPh > _max.y || phiPh < _min.z || phiPh > _max.z)
-                    {
-                        if (phiPh > _max.z) {
-                            LWARNING("Warning: There might be a gap in the data");
+    // Each slab writes to a disjoint range of the sampled values
+    auto sampleSlab = [&](ccmc::Interpolator& interpolator, size_t zBegin, size_t zEnd) {
+        for (size_t z = zBegin; z < zEnd; ++z) {
+            for (size_t y = 0; y < outDimensions.y; ++y) {
+                for (size_t x = 0; x < outDimensions.x; ++x) {
+                    const size_t index = x + y * outDimensions.x +
+                                         z * outDimensions.x * outDimensions.y;
+
+                    if (_gridType == GridType::Spherical) {
+                        // Put r in the [0..sqrt(3)] range
+                        const double rNorm = glm::root_three<double>() * x /
+                                             outDimensions.x - 1;
+
+                        // Put theta in the [0..PI] range
+                        const double thetaNorm =
+                            glm::pi<double>() * y / outDimensions.y - 1;
+
+                        // Put phi in the [0..2PI] range
+                        const double phiNorm = glm::two_pi<double>() * z /
+                                               outDimensions.z - 1;
+
+                        // Go to physical coordinates before sampling
+                        const double rPh = _min.x + rNorm * (_max.x - _min.x);
+                        const double thetaPh = thetaNorm;
+                        // phi range needs to be mapped to the slightly different model
+                        // range to avoid gaps in the data Subtract a small term to
+                        // avoid rounding errors when comparing to phiMax.
+                        const double phiPh = _min.z + phiNorm / glm::two_pi<double>() *
+                                             (_max.z - _min.z - 0.000001);
+
+                        double value = 0.0;
+                        // See if sample point is inside domain
+                        if (rPh < _min.x || rPh > _max.x || thetaPh < _min.y ||
+                            thetaPh > _max.y || phiPh < _min.z || phiPh > _max.z)
+                        {
+                            if (phiPh > _max.z) {
+                                LWARNING("Warning: There might be a gap in the data");
+                            }
+                            // Leave values at zero if outside domain
                         }
-                        // Leave values at zero if outside domain
+                        else { // if inside
+                            // ENLIL CDF specific hacks!
+                            // Convert from meters to AU for interpolator
+                            const double localRPh = rPh / ccmc::constants::AU_in_meters;
+                            // Convert from colatitude [0, pi] rad to [-90, 90] deg
+                            const double localThetaPh = -thetaPh * 180.f /
+                                                        glm::pi<double>() + 90.f;
+                            // Convert from [0, 2pi] rad to [0, 360] degrees
+                            const double localPhiPh = phiPh * 180.f / glm::pi<double>();
+                            // Sample
+                            value = interpolator.interpolate(
+                                var,
+                                static_cast<float>(localRPh),
+                                static_cast<float>(localThetaPh),
+                                static_cast<float>(localPhiPh)
+                            );
+                        }
+
+                        doubleData[index] = value;
                     }
-                    else { // if inside
-                        // ENLIL CDF specific hacks!
-                        // Convert from meters to AU for interpolator
-                        const double localRPh = rPh / ccmc::constants::AU_in_meters;
-                        // Convert from colatitude [0, pi] rad to latitude [-90, 90] deg
-                        const double localThetaPh = -thetaPh * 180.f /
-                                                    glm::pi<double>() + 90.f;
-                        // Convert from [0, 2pi] rad to [0, 360] degrees
-                        const double localPhiPh = phiPh * 180.f / glm::pi<double>();
-                        // Sample
-                        value = _interpolator->interpolate(
+                    else {
+                        // Assume cartesian for fallback purpose
+                        const double stepX = (_max.x - _min.x) /
+                                             (static_cast<double>(outDimensions.x));
+                        const double stepY = (_max.y - _min.y) /
+                                             (static_cast<double>(outDimensions.y));
+                        const double stepZ = (_max.z - _min.z) /
+                                             (static_cast<double>(outDimensions.z));
+
+                        const double xPos = _min.x + stepX * x;
+                        const double yPos = _min.y + stepY * y;
+                        const double zPos = _min.z + stepZ * z;
+
+                        // get interpolated data value for (xPos, yPos, zPos)
+                        // swap yPos and zPos because model has Z as up
+                        double value = interpolator.interpolate(
                             var,
-                            static_cast<float>(localRPh),
-                            static_cast<float>(localThetaPh),
-                            static_cast<float>(localPhiPh)
+                            static_cast<float>(xPos),
+                            static_cast<float>(zPos),
+                            static_cast<float>(yPos)
                         );
+                        doubleData[index] = value;
                     }
-
-                    doubleData[index] = value;
-                    histogram[mapToHistogram(value)]++;
-                }
-                else {
-                    // Assume cartesian for fallback purpose
-                    const double stepX = (_max.x - _min.x) /
-                                         (static_cast<double>(outDimensions.x));
-                    const double stepY = (_max.y - _min.y) /
-                                         (static_cast<double>(outDimensions.y));
-                    const double stepZ = (_max.z - _min.z) /
-                                         (static_cast<double>(outDimensions.z));
-
-                    const double xPos = _min.x + stepX * x;
-                    const double yPos = _min.y + stepY * y;
-                    const double zPos = _min.z + stepZ * z;
-
-                    // get interpolated data value for (xPos, yPos, zPos)
-                    // swap yPos and zPos because model has Z as up
-                    double value = _interpolator->interpolate(
-                        var,
-                        static_cast<float>(xPos),
-                        static_cast<float>(zPos),
-                        static_cast<float>(yPos)
-                    );
-                    doubleData[index] = value;
-                    histogram[mapToHistogram(value)]++;
                 }
             }
         }
+    };
+    forEachSlab(_model, outDimensions.z, sampleSlab);
+
+    for (double value : doubleData) {
+        histogram[mapToHistogram(value)]++;
     }
 
     int sum = 0;
@@ -360,18 +430,20 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
 
     float missingValue = _model->getMissingValue();
 
-    for (size_t x = 0; x < outDimensions.x; ++x) {
-        for (size_t y = 0; y < outDimensions.y; ++y) {
-            for (size_t z = 0; z < outDimensions.z; ++z) {
+    // Each slab writes to a disjoint range of the sampled values
+    auto sampleSlab = [&](ccmc::Interpolator& interpolator, size_t zBegin, size_t zEnd) {
+        for (size_t z = zBegin; z < zEnd; ++z) {
+            for (size_t y = 0; y < outDimensions.y; ++y) {
+                for (size_t x = 0; x < outDimensions.x; ++x) {
 
-                const float xi = (hasXSlice) ? slice : x;
-                const float yi = (hasYSlice) ? slice : y;
-                const float zi = (hasZSlice) ? slice : z;
+                    const float xi = (hasXSlice) ? slice : x;
+                    const float yi = (hasYSlice) ? slice : y;
+                    const float zi = (hasZSlice) ? slice : z;
 
-                double value = 0;
-                const size_t index = x + y * outDimensions.x +
-                                     z * outDimensions.x * outDimensions.y;
-                if (_gridType == GridType::Spherical) {
+                    double value = 0;
+                    const size_t index = x + y * outDimensions.x +
+                                         z * outDimensions.x * outDimensions.y;
+                    if (_gridType == GridType::Spherical) {
                         // int z = zSlice;
                         // Put r in the [0..sqrt(3)] range
                         const double rNorm = glm::root_three<double>() * xi / xDim;
@@ -411,39 +483,40 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
                             // Convert from [0, 2pi] rad to [0, 360] degrees
                             const double localPhiPh = phiPh * 180.f / glm::pi<double>();
                             // Sample
-                            value = _interpolator->interpolate(
+                            value = interpolator.interpolate(
                                 var,
                                 static_cast<float>(localRPh),
                                 static_cast<float>(localPhiPh),
                                 static_cast<float>(localThetaPh)
                             );
                         }
+                    }
+                    else {
+                        const double xPos = _min.x + stepX * xi;
+                        const double yPos = _min.y + stepY * yi;
+                        const double zPos = _min.z + stepZ * zi;
+
+                        // std::cout << zPos << ", " << zpos << std::endl;
+                        // Should y and z be flipped?
+                        value = interpolator.interpolate(
+                            var,
+                            static_cast<float>(xPos),
+                            static_cast<float>(zPos),
+                            static_cast<float>(yPos));
+                    }
 
-                }
-                else {
-                    const double xPos = _min.x + stepX * xi;
-                    const double yPos = _min.y + stepY * yi;
-                    const double zPos = _min.z + stepZ * zi;
-
-                    // std::cout << zPos << ", " << zpos << std::endl;
-                    // Should y and z be flipped?
-                    value = _interpolator->interpolate(
-                        var,
-                        static_cast<float>(xPos),
-                        static_cast<float>(zPos),
-                        static_cast<float>(yPos));
-                }
-
-                if (value != missingValue) {
-                    doubleData[index] = value;
-                    data[index] = static_cast<float>(value);
-                }
-                else {
-                    doubleData[index] = 0;
+                    if (value != missingValue) {
+                        doubleData[index] = value;
+                        data[index] = static_cast<float>(value);
+                    }
+                    else {
+                        doubleData[index] = 0;
+                    }
                 }
             }
         }
-    }
+    };
+    forEachSlab(_model, outDimensions.z, sampleSlab);
 
     return data;
 }
@@ -484,23 +557,36 @@ float* KameleonWrapper::uniformSampledVectorValues(const std::string& xVar,
     //LDEBUG(zVar << "Min: " << varZMin);
     //LDEBUG(zVar << "Max: " << varZMax);
 
-    //ProgressBar pb(static_cast<int>(outDimensions.x));
-    for (size_t x = 0; x < outDimensions.x; ++x) {
-        //pb.print(x);
-        for (size_t y = 0; y < outDimensions.y; ++y) {
-            for (size_t z = 0; z < outDimensions.z; ++z) {
-                const size_t index = x * NumChannels + y * NumChannels * outDimensions.x +
-                                     z * NumChannels * outDimensions.x * outDimensions.y;
+    if (_gridType != GridType::Cartesian) {
+        LERROR(
+            "Only cartesian grid supported for uniformSampledVectorValues (for now)"
+        );
+        return data;
+    }
+
+    // Load the variables up front as the interpolators would otherwise load them lazily
+    // from multiple threads at once
+    _model->loadVariable(xVar);
+    _model->loadVariable(yVar);
+    _model->loadVariable(zVar);
+
+    // Each slab writes to a disjoint range of the sampled values
+    auto sampleSlab = [&](ccmc::Interpolator& interpolator, size_t zBegin, size_t zEnd) {
+        for (size_t z = zBegin; z < zEnd; ++z) {
+            for (size_t y = 0; y < outDimensions.y; ++y) {
+                for (size_t x = 0; x < outDimensions.x; ++x) {
+                    const size_t index = x * NumChannels +
+                        y * NumChannels * outDimensions.x +
+                        z * NumChannels * outDimensions.x * outDimensions.y;
 
-                if (_gridType == GridType::Cartesian) {
                     const float xPos = _min.x + stepX * x;
                     const float yPos = _min.y + stepY * y;
                     const float zPos = _min.z + stepZ * z;
 
                     // get interpolated data value for (xPos, yPos, zPos)
-                    const float xVal = _interpolator->interpolate(xVar, xPos, yPos, zPos);
-                    const float yVal = _interpolator->interpolate(yVar, xPos, yPos, zPos);
-                    const float zVal = _interpolator->interpolate(zVar, xPos, yPos, zPos);
+                    const float xVal = interpolator.interpolate(xVar, xPos, yPos, zPos);
+                    const float yVal = interpolator.interpolate(yVar, xPos, yPos, zPos);
+                    const float zVal = interpolator.interpolate(zVar, xPos, yPos, zPos);
 
                     // scale to [0,1]
                     data[index]     = (xVal - varXMin) / (varXMax - varXMin); // R
@@ -509,16 +595,10 @@ float* KameleonWrapper::uniformSampledVectorValues(const std::string& xVar,
                     // GL_RGB refuses to work. Workaround doing a GL_RGBA  hardcoded alpha
                     data[index + 3] = 1.f;
                 }
-                else {
-                    LERROR(
-                        "Only cartesian grid supported for "
-                        "uniformSampledVectorValues (for now)"
-                    );
-                    return data;
-                }
             }
         }
-    }
+    };
+    forEachSlab(_model, outDimensions.z, sampleSlab);
 
     return data;
 }
@@ -538,24 +618,33 @@ KameleonWrapper::Fieldlines KameleonWrapper::classifiedFieldLines(const std::str
     std::vector<std::vector<LinePoint> > fieldLines;
 
     if (_type == Model::BATSRUS) {
-        fieldLines.reserve(seedPoints.size());
-        for (const glm::vec3& seedPoint : seedPoints) {
+        // Load the variables up front as the interpolators would otherwise load them
+        // lazily from multiple threads at once
+        _model->loadVariable(xVar);
+        _model->loadVariable(yVar);
+        _model->loadVariable(zVar);
+
+        // Each seed point writes only to its own line
+        fieldLines.resize(seedPoints.size());
+        auto trace = [&](ccmc::Interpolator& interpolator, size_t i) {
             FieldlineEnd forwardEnd;
             std::vector<glm::vec3> fLine = traceCartesianFieldline(
+                interpolator,
                 xVar,
                 yVar,
                 zVar,
-                seedPoint,
+                seedPoints[i],
                 stepSize,
                 TraceDirection::FORWARD,
                 forwardEnd
             );
             FieldlineEnd backEnd;
             std::vector<glm::vec3> bLine = traceCartesianFieldline(
+                interpolator,
                 xVar,
                 yVar,
                 zVar,
-                seedPoint,
+                seedPoints[i],
                 stepSize,
                 TraceDirection::BACK,
                 backEnd
@@ -568,13 +657,13 @@ KameleonWrapper::Fieldlines KameleonWrapper::classifiedFieldLines(const std::str
             glm::vec4 color = classifyFieldline(forwardEnd, backEnd);
 
             // write colors and convert positions to meter
-            std::vector<LinePoint> line;
+            std::vector<LinePoint>& line = fieldLines[i];
+            line.reserve(bLine.size());
             for (glm::vec3& position : bLine) {
                 line.push_back({ RE_TO_METER * std::move(position), color });
             }
-
-            fieldLines.push_back(line);
-        }
+        };
+        forEachSeedPoint(_model, seedPoints.size(), trace);
     }
     else {
         LERROR("Fieldlines are only supported for BATSRUS model");
@@ -600,24 +689,33 @@ KameleonWrapper::Fieldlines KameleonWrapper::fieldLines(const std::string& xVar,
     Fieldlines fieldLines;
 
     if (_type == Model::BATSRUS) {
-        fieldLines.reserve(seedPoints.size());
-        for (const glm::vec3& seedPoint : seedPoints) {
+        // Load the variables up front as the interpolators would otherwise load them
+        // lazily from multiple threads at once
+        _model->loadVariable(xVar);
+        _model->loadVariable(yVar);
+        _model->loadVariable(zVar);
+
+        // Each seed point writes only to its own line
+        fieldLines.resize(seedPoints.size());
+        auto trace = [&](ccmc::Interpolator& interpolator, size_t i) {
             FieldlineEnd forwardEnd;
             std::vector<glm::vec3> fLine = traceCartesianFieldline(
+                interpolator,
                 xVar,
                 yVar,
                 zVar,
-                seedPoint,
+                seedPoints[i],
                 stepSize,
                 TraceDirection::FORWARD,
                 forwardEnd
             );
             FieldlineEnd backEnd;
             std::vector<glm::vec3> bLine = traceCartesianFieldline(
+                interpolator,
                 xVar,
                 yVar,
                 zVar,
-                seedPoint,
+                seedPoints[i],
                 stepSize,
                 TraceDirection::BACK,
                 backEnd
@@ -627,13 +725,13 @@ KameleonWrapper::Fieldlines KameleonWrapper::fieldLines(const std::string& xVar,
             bLine.insert(bLine.begin(), fLine.rbegin(), fLine.rend());
 
             // write colors and convert positions to meter
-            std::vector<LinePoint> line;
+            std::vector<LinePoint>& line = fieldLines[i];
+            line.reserve(bLine.size());
             for (glm::vec3& position : bLine) {
                 line.push_back({ RE_TO_METER * std::move(position), color });
             }
-
-            fieldLines.push_back(line);
-        }
+        };
+        forEachSeedPoint(_model, seedPoints.size(), trace);
     }
     else {
         LERROR("Fieldlines are only supported for BATSRUS model");
@@ -649,16 +747,28 @@ KameleonWrapper::Fieldlines KameleonWrapper::lorentzTrajectories(
 {
     LINFO(std::format("Creating {} Lorentz force trajectories", seedPoints.size()));
 
-    Fieldlines trajectories;
+    // Load the variables up front as the interpolators would otherwise load them lazily
+    // from multiple threads at once
+    constexpr std::array<std::string_view, 9> Variables = {
+        "bx", "by", "bz", "jx", "jy", "jz", "ux", "uy", "uz"
+    };
+    for (std::string_view var : Variables) {
+        _model->loadVariable(std::string(var));
+    }
 
-    for (const glm::vec3& seedPoint : seedPoints) {
-        std::vector<glm::vec3> posTraj = traceLorentzTrajectory(seedPoint, step, 1.f);
-        std::vector<glm::vec3> negTraj = traceLorentzTrajectory(seedPoint, step, -1.f);
+    // Each seed point writes only to its own trajectory
+    Fieldlines trajectories(seedPoints.size());
+    auto trace = [&](ccmc::Interpolator& interpolator, size_t i) {
+        std::vector<glm::vec3> posTraj =
+            traceLorentzTrajectory(interpolator, seedPoints[i], step, 1.f);
+        std::vector<glm::vec3> negTraj =
+            traceLorentzTrajectory(interpolator, seedPoints[i], step, -1.f);
 
         negTraj.insert(negTraj.begin(), posTraj.rbegin(), posTraj.rend());
 
         // write colors and convert positions to meter
-        std::vector<LinePoint> trajectory;
+        std::vector<LinePoint>& trajectory = trajectories[i];
+        trajectory.reserve(negTraj.size());
         for (glm::vec3& position : negTraj) {
             if (trajectory.size() < posTraj.size()) {
                 // set positive trajectory to pink
@@ -675,8 +785,8 @@ KameleonWrapper::Fieldlines KameleonWrapper::lorentzTrajectories(
                 });
             }
         }
-        trajectories.push_back(trajectory);
-    }
+    };
+    forEachSeedPoint(_model, seedPoints.size(), trace);
 
     return trajectories;
 }
@@ -767,6 +877,7 @@ KameleonWrapper::GridType KameleonWrapper::gridType() const {
 }
 
 KameleonWrapper::TraceLine KameleonWrapper::traceCartesianFieldline(
+                                                         ccmc::Interpolator& interpolator,
                                                                   const std::string& xVar,
                                                                   const std::string& yVar,
                                                                   const std::string& zVar,
@@ -777,13 +888,10 @@ KameleonWrapper::TraceLine KameleonWrapper::traceCartesianFieldline(
 {
     constexpr int MaxSteps = 5000;
 
-    _model->loadVariable(xVar);
+    // The variables have been loaded by the caller, as this function is called from
+    // multiple threads at once
     const long int xID = _model->getVariableID(xVar);
-
-    _model->loadVariable(yVar);
     const long int yID = _model->getVariableID(yVar);
-
-    _model->loadVariable(zVar);
     const long int zID = _model->getVariableID(zVar);
 
     glm::vec3 pos = seedPoint;
@@ -804,9 +912,9 @@ KameleonWrapper::TraceLine KameleonWrapper::traceCartesianFieldline(
         float stepY;
         float stepZ;
         glm::vec3 k1 = glm::normalize(glm::vec3(
-            _interpolator->interpolate(xID, pos.x, pos.y, pos.z, stepX, stepY, stepZ),
-            _interpolator->interpolate(yID, pos.x, pos.y, pos.z),
-            _interpolator->interpolate(zID, pos.x, pos.y, pos.z)
+            interpolator.interpolate(xID, pos.x, pos.y, pos.z, stepX, stepY, stepZ),
+            interpolator.interpolate(yID, pos.x, pos.y, pos.z),
+            interpolator.interpolate(zID, pos.x, pos.y, pos.z)
         ));
         k1 = (direction == TraceDirection::FORWARD) ? k1 : -1.f * k1;
 
@@ -814,25 +922,25 @@ KameleonWrapper::TraceLine KameleonWrapper::traceCartesianFieldline(
 
         glm::vec3 k1Pos = pos + step / 2.f * k1;
         glm::vec3 k2 = glm::normalize(glm::vec3(
-            _interpolator->interpolate(xID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(yID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(zID, k1Pos.x, k1Pos.y, k1Pos.z)
+            interpolator.interpolate(xID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(yID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(zID, k1Pos.x, k1Pos.y, k1Pos.z)
         ));
         k2 = (direction == TraceDirection::FORWARD) ? k2 : -1.f * k2;
 
         glm::vec3 k2Pos = pos + step / 2.f * k2;
         glm::vec3 k3 = glm::normalize(glm::vec3(
-            _interpolator->interpolate(xID, k2Pos.x, k2Pos.y, k2Pos.z),
-            _interpolator->interpolate(yID, k2Pos.x, k2Pos.y, k2Pos.z),
-            _interpolator->interpolate(zID, k2Pos.x, k2Pos.y, k2Pos.z)
+            interpolator.interpolate(xID, k2Pos.x, k2Pos.y, k2Pos.z),
+            interpolator.interpolate(yID, k2Pos.x, k2Pos.y, k2Pos.z),
+            interpolator.interpolate(zID, k2Pos.x, k2Pos.y, k2Pos.z)
         ));
         k3 = (direction == TraceDirection::FORWARD) ? k3 : -1.f * k3;
 
         glm::vec3 k3Pos = pos + step / 2.f * k3;
         glm::vec3 k4 = glm::normalize(glm::vec3(
-            _interpolator->interpolate(xID, k3Pos.x, k3Pos.y, k3Pos.z),
-            _interpolator->interpolate(yID, k3Pos.x, k3Pos.y, k3Pos.z),
-            _interpolator->interpolate(zID, k3Pos.x, k3Pos.y, k3Pos.z)
+            interpolator.interpolate(xID, k3Pos.x, k3Pos.y, k3Pos.z),
+            interpolator.interpolate(yID, k3Pos.x, k3Pos.y, k3Pos.z),
+            interpolator.interpolate(zID, k3Pos.x, k3Pos.y, k3Pos.z)
         ));
         k4 = (direction == TraceDirection::FORWARD) ? k4 : -1.f * k4;
 
@@ -861,6 +969,7 @@ KameleonWrapper::TraceLine KameleonWrapper::traceCartesianFieldline(
 }
 
 KameleonWrapper::TraceLine KameleonWrapper::traceLorentzTrajectory(
+                                                         ccmc::Interpolator& interpolator,
                                                                const glm::vec3& seedPoint,
                                                                            float stepsize,
                                                                       float eCharge) const
@@ -879,9 +988,9 @@ KameleonWrapper::TraceLine KameleonWrapper::traceLorentzTrajectory(
     TraceLine trajectory;
     glm::vec3 pos = seedPoint;
     glm::vec3 v0 = glm::normalize(glm::vec3(
-        _interpolator->interpolate("ux", pos.x, pos.y, pos.z),
-        _interpolator->interpolate("uy", pos.x, pos.y, pos.z),
-        _interpolator->interpolate("uz", pos.x, pos.y, pos.z)
+        interpolator.interpolate("ux", pos.x, pos.y, pos.z),
+        interpolator.interpolate("uy", pos.x, pos.y, pos.z),
+        interpolator.interpolate("uz", pos.x, pos.y, pos.z)
     ));
 
     int numSteps = 0;
@@ -895,55 +1004,55 @@ KameleonWrapper::TraceLine KameleonWrapper::traceLorentzTrajectory(
 
         // Calculate new position with Lorentz force quation and Runge-Kutta 4th order
         glm::vec3 B = glm::vec3(
-            _interpolator->interpolate(bxID, pos.x, pos.y, pos.z),
-            _interpolator->interpolate(byID, pos.x, pos.y, pos.z),
-            _interpolator->interpolate(bzID, pos.x, pos.y, pos.z)
+            interpolator.interpolate(bxID, pos.x, pos.y, pos.z),
+            interpolator.interpolate(byID, pos.x, pos.y, pos.z),
+            interpolator.interpolate(bzID, pos.x, pos.y, pos.z)
         );
 
         glm::vec3 E = glm::vec3(
-            _interpolator->interpolate(jxID, pos.x, pos.y, pos.z),
-            _interpolator->interpolate(jyID, pos.x, pos.y, pos.z),
-            _interpolator->interpolate(jzID, pos.x, pos.y, pos.z)
+            interpolator.interpolate(jxID, pos.x, pos.y, pos.z),
+            interpolator.interpolate(jyID, pos.x, pos.y, pos.z),
+            interpolator.interpolate(jzID, pos.x, pos.y, pos.z)
         );
         const glm::vec3 k1 = glm::normalize(eCharge * (E + glm::cross(v0, B)));
         const glm::vec3 k1Pos = pos + step / 2.f * v0 + step * step / 8.f * k1;
 
         B = glm::vec3(
-            _interpolator->interpolate(bxID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(byID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(bzID, k1Pos.x, k1Pos.y, k1Pos.z)
+            interpolator.interpolate(bxID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(byID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(bzID, k1Pos.x, k1Pos.y, k1Pos.z)
         );
         E = glm::vec3(
-            _interpolator->interpolate(jxID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(jyID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(jzID, k1Pos.x, k1Pos.y, k1Pos.z)
+            interpolator.interpolate(jxID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(jyID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(jzID, k1Pos.x, k1Pos.y, k1Pos.z)
         );
         const glm::vec3 v1 = v0 + step / 2.f * k1;
         const glm::vec3 k2 = glm::normalize(eCharge * (E + glm::cross(v1, B)));
 
         B = glm::vec3(
-            _interpolator->interpolate(bxID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(byID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(bzID, k1Pos.x, k1Pos.y, k1Pos.z)
+            interpolator.interpolate(bxID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(byID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(bzID, k1Pos.x, k1Pos.y, k1Pos.z)
         );
         E = glm::vec3(
-            _interpolator->interpolate(jxID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(jyID, k1Pos.x, k1Pos.y, k1Pos.z),
-            _interpolator->interpolate(jzID, k1Pos.x, k1Pos.y, k1Pos.z)
+            interpolator.interpolate(jxID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(jyID, k1Pos.x, k1Pos.y, k1Pos.z),
+            interpolator.interpolate(jzID, k1Pos.x, k1Pos.y, k1Pos.z)
         );
         const glm::vec3 v2 = v0 + step / 2.f * k2;
         const glm::vec3 k3 = glm::normalize(eCharge * (E + glm::cross(v2, B)));
         const glm::vec3 k3Pos = pos + step * v0 + step * step / 2.f * k1;
 
         B = glm::vec3(
-            _interpolator->interpolate(bxID, k3Pos.x, k3Pos.y, k3Pos.z),
-            _interpolator->interpolate(byID, k3Pos.x, k3Pos.y, k3Pos.z),
-            _interpolator->interpolate(bzID, k3Pos.x, k3Pos.y, k3Pos.z)
+            interpolator.interpolate(bxID, k3Pos.x, k3Pos.y, k3Pos.z),
+            interpolator.interpolate(byID, k3Pos.x, k3Pos.y, k3Pos.z),
+            interpolator.interpolate(bzID, k3Pos.x, k3Pos.y, k3Pos.z)
         );
         E = glm::vec3(
-            _interpolator->interpolate(jxID, k3Pos.x, k3Pos.y, k3Pos.z),
-            _interpolator->interpolate(jyID, k3Pos.x, k3Pos.y, k3Pos.z),
-            _interpolator->interpolate(jzID, k3Pos.x, k3Pos.y, k3Pos.z)
+            interpolator.interpolate(jxID, k3Pos.x, k3Pos.y, k3Pos.z),
+            interpolator.interpolate(jyID, k3Pos.x, k3Pos.y, k3Pos.z),
+            interpolator.interpolate(jzID, k3Pos.x, k3Pos.y, k3Pos.z)
         );
         const glm::vec3 v3 = v0 + step * k3;
         const glm::vec3 k4 = glm::normalize(eCharge * (E + glm::cross(v3, B)));
@@ -26,10 +26,12 @@
 
 #include <modules/kameleon/include/kameleonwrapper.h>
 #include <modules/volume/rawvolume.h>
+#include <modules/volume/volumeutils.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/format.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
 #include <ghoul/misc/dictionary.h>
 #include <filesystem>
 
@@ -78,6 +80,7 @@ namespace openspace::kameleonvolume {
 
 KameleonVolumeReader::KameleonVolumeReader(std::filesystem::path path)
     : _path(std::move(path))
+    , _kameleon(std::make_unique<ccmc::Kameleon>())
 {
     if (!std::filesystem::is_regular_file(_path)) {
         throw ghoul::FileNotFoundError(_path);
@@ -127,27 +130,51 @@ std::unique_ptr<volume::RawVolume<float>> KameleonVolumeReader::readFloatVolume(
     maxValue = -std::numeric_limits<float>::max();
 
     auto volume = std::make_unique<volume::RawVolume<float>>(dimensions);
+    readFloatSlab(
+        dimensions,
+        variable,
+        lowerBound,
+        upperBound,
+        0,
+        dimensions.z,
+        std::span<float>(volume->data(), volume->nCells()),
+        minValue,
+        maxValue
+    );
+    return volume;
+}
 
-    const glm::vec3 dims = volume->dimensions();
+void KameleonVolumeReader::readFloatSlab(const glm::uvec3& dimensions,
+                                         const std::string& variable,
+                                         const glm::vec3& lowerBound,
+                                         const glm::vec3& upperBound,
+                                         unsigned int zBegin, unsigned int zEnd,
+                                         std::span<float> slab, float& minValue,
+                                         float& maxValue) const
+{
+    const size_t sliceSize = static_cast<size_t>(dimensions.x) * dimensions.y;
+    ghoul_assert(zBegin <= zEnd && zEnd <= dimensions.z, "Invalid slab");
+    ghoul_assert(slab.size() == sliceSize * (zEnd - zBegin), "Invalid slab size");
+
+    const glm::vec3 dims = dimensions;
     const glm::vec3 diff = upperBound - lowerBound;
 
     auto interpolate = [this](const std::string& var, const glm::vec3& coords) {
         return _interpolator->interpolate(var, coords[0], coords[1], coords[2]);
     };
 
-    float* data = volume->data();
-    for (size_t index = 0; index < volume->nCells(); index++) {
-        const glm::vec3 coords = volume->indexToCoords(index);
+    for (size_t index = 0; index < slab.size(); index++) {
+        const glm::vec3 coords = glm::vec3(
+            volume::indexToCoords(index + zBegin * sliceSize, dimensions)
+        );
         const glm::vec3 coordsZeroToOne = coords / dims;
         const glm::vec3 volumeCoords = lowerBound + diff * coordsZeroToOne;
 
-        data[index] = interpolate(variable, volumeCoords);
+        slab[index] = interpolate(variable, volumeCoords);
 
-        minValue = glm::min(minValue, data[index]);
-        maxValue = glm::max(maxValue, data[index]);
+        minValue = glm::min(minValue, slab[index]);
+        maxValue = glm::max(maxValue, slab[index]);
     }
-
-    return volume;
 }
 
 std::vector<std::string> KameleonVolumeReader::variableNames() const {
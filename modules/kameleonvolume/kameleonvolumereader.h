@@ -28,6 +28,7 @@
 #include <ghoul/glm.h>
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,18 @@ public:
         const glm::vec3& lowerBound, const glm::vec3& upperBound, float& minValue,
         float& maxValue) const;
 
+    /**
+     * Samples the z-slices [\p zBegin, \p zEnd) of a volume with the provided
+     * \p dimensions into \p slab, which must have room for exactly that many slices.
+     * This makes it possible to sample large volumes piece by piece without having to
+     * keep the entire volume in memory. \p minValue and \p maxValue are updated with
+     * the smallest and largest sampled value.
+     */
+    void readFloatSlab(const glm::uvec3& dimensions, const std::string& variable,
+        const glm::vec3& lowerBound, const glm::vec3& upperBound, unsigned int zBegin,
+        unsigned int zEnd, std::span<float> slab, float& minValue,
+        float& maxValue) const;
+
     ghoul::Dictionary readMetaData() const;
 
     std::string time() const;
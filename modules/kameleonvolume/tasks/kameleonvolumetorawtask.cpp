@@ -25,24 +25,42 @@
 #include <modules/kameleonvolume/tasks/kameleonvolumetorawtask.h>
 
 #include <modules/kameleonvolume/kameleonvolumereader.h>
-#include <modules/volume/rawvolumewriter.h>
 #include <openspace/documentation/verifier.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
 namespace {
+    constexpr std::string_view _loggerCat = "KameleonVolumeToRawTask";
+
+    // The maximum number of cells that are sampled before they are written to disk
+    constexpr size_t SlabCells = 1 << 22;
+
     struct [[codegen::Dictionary(KameleonVolumeToRawTask)]] Parameters {
-        // The cdf file to extract data from
+        // The cdf file to extract data from. If this is a directory, all cdf files in it
+        // are converted as separate time steps and the two outputs have to be
+        // directories instead, into which a raw volume and a dictionary file named
+        // after each cdf file are written
         std::filesystem::path input;
 
-        // The raw volume file to export data to
+        // The raw volume file to export data to, or the directory to export the raw
+        // volumes to if the input is a directory
         std::string rawVolumeOutput [[codegen::annotation("A valid filepath")]];
 
-        // The Lua dictionary file to export metadata to
+        // The Lua dictionary file to export metadata to, or the directory to export the
+        // dictionaries to if the input is a directory
         std::string dictionaryOutput [[codegen::annotation("A valid filepath")]];
 
         // The variable name to read from the kameleon dataset
@@ -62,6 +80,10 @@ namespace {
         // The unit of the data
         std::optional<std::string> visUnit
             [[codegen::annotation("A valid kameleon unit")]];
+
+        // The number of cdf files that are converted concurrently if the input is a
+        // directory. Defaults to the number of hardware threads
+        std::optional<int> threads [[codegen::greater(0)]];
     };
 #include "kameleonvolumetorawtask_codegen.cpp"
 } // namespace
@@ -94,6 +116,10 @@ KameleonVolumeToRawTask::KameleonVolumeToRawTask(const ghoul::Dictionary& dictio
     else {
         _autoDomainBounds = true;
     }
+
+    _nThreads = p.threads.has_value() ?
+        static_cast<unsigned int>(*p.threads) :
+        std::max(std::thread::hardware_concurrency(), 1u);
 }
 
 std::string KameleonVolumeToRawTask::description() {
@@ -105,37 +131,138 @@ std::string KameleonVolumeToRawTask::description() {
 }
 
 void KameleonVolumeToRawTask::perform(const Task::ProgressCallback& progressCallback) {
-    KameleonVolumeReader reader = KameleonVolumeReader(_inputPath);
+    if (!std::filesystem::is_directory(_inputPath)) {
+        convert(
+            _inputPath,
+            _rawVolumeOutputPath,
+            _dictionaryOutputPath,
+            progressCallback
+        );
+        return;
+    }
+
+    std::vector<std::filesystem::path> inputs;
+    for (const std::filesystem::directory_entry& e :
+         std::filesystem::directory_iterator(_inputPath))
+    {
+        if (e.is_regular_file() && e.path().extension() == ".cdf") {
+            inputs.push_back(e.path());
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+    if (inputs.empty()) {
+        LWARNING(std::format("No cdf files found in '{}'", _inputPath));
+        return;
+    }
+
+    std::filesystem::create_directories(_rawVolumeOutputPath);
+    std::filesystem::create_directories(_dictionaryOutputPath);
+
+    // Each thread converts one time step at a time with its own reader, picking the next
+    // unclaimed time step when it is done
+    std::atomic<size_t> nextInput = 0;
+    std::vector<float> progress(inputs.size(), 0.f);
+    std::mutex progressMutex;
+    auto convertInputs = [&]() {
+        for (size_t i = nextInput++; i < inputs.size(); i = nextInput++) {
+            auto onProgress = [&, i](float p) {
+                const std::lock_guard lock(progressMutex);
+                progress[i] = p;
+                float sum = 0.f;
+                for (float v : progress) {
+                    sum += v;
+                }
+                progressCallback(sum / static_cast<float>(progress.size()));
+            };
+
+            const std::string name = inputs[i].stem().string();
+            try {
+                convert(
+                    inputs[i],
+                    _rawVolumeOutputPath / (name + ".rawvolume"),
+                    _dictionaryOutputPath / (name + ".dictionary"),
+                    onProgress
+                );
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERROR(std::format("Failed to convert '{}': {}", inputs[i], e.message));
+                onProgress(1.f);
+            }
+        }
+    };
+
+    const size_t nThreads = std::clamp<size_t>(_nThreads, 1, inputs.size());
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (size_t i = 0; i < nThreads; i++) {
+        threads.emplace_back(convertInputs);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void KameleonVolumeToRawTask::convert(const std::filesystem::path& input,
+                                      const std::filesystem::path& rawVolumeOutput,
+                                      const std::filesystem::path& dictionaryOutput,
+                                      const std::function<void(float)>& onProgress) const
+{
+    KameleonVolumeReader reader = KameleonVolumeReader(input);
 
     std::array<std::string, 3> variables = reader.gridVariableNames();
 
+    glm::vec3 lowerDomainBound = _lowerDomainBound;
+    glm::vec3 upperDomainBound = _upperDomainBound;
     if (_autoDomainBounds) {
-        _lowerDomainBound = glm::vec3(
+        lowerDomainBound = glm::vec3(
             reader.minValue(variables[0]),
             reader.minValue(variables[1]),
             reader.minValue(variables[2])
         );
 
-        _upperDomainBound = glm::vec3(
+        upperDomainBound = glm::vec3(
             reader.maxValue(variables[0]),
             reader.maxValue(variables[1]),
             reader.maxValue(variables[2])
         );
     }
 
-    std::unique_ptr<volume::RawVolume<float>> rawVolume = reader.readFloatVolume(
-        _dimensions,
-        _variable,
-        _lowerDomainBound,
-        _upperDomainBound
-    );
-
-    progressCallback(0.5f);
-
-    volume::RawVolumeWriter<float> writer(_rawVolumeOutputPath);
-    writer.write(*rawVolume);
+    std::ofstream file = std::ofstream(rawVolumeOutput, std::ios::binary);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(std::format(
+            "Could not create file '{}'", rawVolumeOutput
+        ));
+    }
 
-    progressCallback(0.9f);
+    // Sample and write a slab of z-slices at a time to bound the memory usage
+    const size_t sliceSize = static_cast<size_t>(_dimensions.x) * _dimensions.y;
+    const unsigned int slicesPerSlab = static_cast<unsigned int>(
+        std::max<size_t>(SlabCells / std::max<size_t>(sliceSize, 1), 1)
+    );
+    std::vector<float> slab;
+    float minValue = std::numeric_limits<float>::max();
+    float maxValue = -std::numeric_limits<float>::max();
+    for (unsigned int z = 0; z < _dimensions.z; z += slicesPerSlab) {
+        const unsigned int zEnd = std::min(z + slicesPerSlab, _dimensions.z);
+        slab.resize(sliceSize * (zEnd - z));
+        reader.readFloatSlab(
+            _dimensions,
+            _variable,
+            lowerDomainBound,
+            upperDomainBound,
+            z,
+            zEnd,
+            slab,
+            minValue,
+            maxValue
+        );
+        file.write(
+            reinterpret_cast<const char*>(slab.data()),
+            slab.size() * sizeof(float)
+        );
+        onProgress(0.9f * static_cast<float>(zEnd) / static_cast<float>(_dimensions.z));
+    }
+    file.close();
 
     ghoul::Dictionary inputMetadata = reader.readMetaData();
     ghoul::Dictionary outputMetadata;
@@ -149,8 +276,8 @@ void KameleonVolumeToRawTask::perform(const Task::ProgressCallback& progressCall
 
     outputMetadata.setValue("Time", time);
     outputMetadata.setValue("Dimensions", glm::dvec3(_dimensions));
-    outputMetadata.setValue("LowerDomainBound", glm::dvec3(_lowerDomainBound));
-    outputMetadata.setValue("UpperDomainBound", glm::dvec3(_upperDomainBound));
+    outputMetadata.setValue("LowerDomainBound", glm::dvec3(lowerDomainBound));
+    outputMetadata.setValue("UpperDomainBound", glm::dvec3(upperDomainBound));
 
     outputMetadata.setValue("MinValue", reader.minValue(_variable));
     outputMetadata.setValue("MaxValue", reader.maxValue(_variable));
@@ -158,10 +285,10 @@ void KameleonVolumeToRawTask::perform(const Task::ProgressCallback& progressCall
 
     std::string metadataString = ghoul::formatLua(outputMetadata);
 
-    std::fstream f = std::fstream(_dictionaryOutputPath, std::ios::out);
+    std::fstream f = std::fstream(dictionaryOutput, std::ios::out);
     f << "return " << metadataString;
 
-    progressCallback(1.f);
+    onProgress(1.f);
 }
 
 } // namespace openspace::kameleonvolume
@@ -29,6 +29,7 @@
 
 #include <ghoul/glm.h>
 #include <filesystem>
+#include <functional>
 #include <string>
 
 namespace openspace::kameleonvolume {
@@ -43,6 +44,16 @@ public:
     static documentation::Documentation documentation();
 
 private:
+    /**
+     * Converts the CDF file at \p input into a raw volume at \p rawVolumeOutput and a
+     * metadata dictionary at \p dictionaryOutput. The volume is sampled and written in
+     * slabs of z-slices, so only one slab is kept in memory at any time.
+     */
+    void convert(const std::filesystem::path& input,
+        const std::filesystem::path& rawVolumeOutput,
+        const std::filesystem::path& dictionaryOutput,
+        const std::function<void(float)>& onProgress) const;
+
     std::filesystem::path _inputPath;
     std::filesystem::path _rawVolumeOutputPath;
     std::filesystem::path _dictionaryOutputPath;
@@ -53,6 +64,7 @@ private:
     bool _autoDomainBounds = false;
     glm::vec3 _lowerDomainBound = glm::vec3(0.f);
     glm::vec3 _upperDomainBound = glm::vec3(0.f);
+    unsigned int _nThreads = 1;
 };
 
 } // namespace openspace::kameleon
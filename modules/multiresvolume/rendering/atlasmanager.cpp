@@ -25,13 +25,20 @@
 #include <modules/multiresvolume/rendering/atlasmanager.h>
 
 #include <modules/multiresvolume/rendering/tsp.h>
+#include <modules/multiresvolume/rendering/tspbrickloader.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
 #include <cstring>
 
 namespace openspace {
 
-AtlasManager::AtlasManager(TSP* tsp) : _tsp(tsp) {}
+AtlasManager::AtlasManager(TSP* tsp, unsigned int maxBricksPerFrame)
+    : _tsp(tsp)
+    , _maxBricksPerFrame(std::max(maxBricksPerFrame, 1u))
+{}
+
+AtlasManager::~AtlasManager() = default;
 
 bool AtlasManager::initialize() {
     TSP::Header header = _tsp->header();
@@ -45,8 +52,8 @@ bool AtlasManager::initialize() {
     _atlasDim = _nBricksPerDim * _paddedBrickDim;
     _nBrickVals = _paddedBrickDim*_paddedBrickDim*_paddedBrickDim;
     _brickSize = _nBrickVals * sizeof(float);
-    _volumeSize = _brickSize * _nOtLeaves;
     _atlasMap = std::vector<unsigned int>(_nOtLeaves, NotUsedIndex);
+    _leafBricks = std::vector<unsigned int>(_nOtLeaves, NotUsedIndex);
     _nBricksInAtlas = _nBricksInMap;
 
     _freeAtlasCoords = std::vector<unsigned int>(_nBricksInAtlas, 0);
@@ -64,7 +71,20 @@ bool AtlasManager::initialize() {
     );
     _textureAtlas->uploadTexture();
 
+    // Each of the two PBOs can hold the bricks uploaded in one frame; alternating between
+    // them lets the bricks of the next frame be written while the previous upload is
+    // still in flight
     glGenBuffers(2, _pboHandle);
+    for (unsigned int pbo : _pboHandle) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        glBufferData(
+            GL_PIXEL_UNPACK_BUFFER,
+            static_cast<GLsizeiptr>(_maxBricksPerFrame) * _brickSize,
+            nullptr,
+            GL_STREAM_DRAW
+        );
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 
     glGenBuffers(1, &_atlasMapBuffer);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, _atlasMapBuffer);
@@ -76,6 +96,13 @@ bool AtlasManager::initialize() {
     );
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
+    _loader = std::make_unique<TspBrickLoader>(
+        _tsp->filename(),
+        TSP::dataPosition(),
+        _nBrickVals,
+        2 * _maxBricksPerFrame
+    );
+
     return true;
 }
 
@@ -87,64 +114,100 @@ unsigned int AtlasManager::atlasMapBuffer() const {
     return _atlasMapBuffer;
 }
 
-void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickIndices) {
-    size_t nBrickIndices = brickIndices.size();
-
+void AtlasManager::updateAtlas(std::vector<int>& brickIndices) {
     _requiredBricks.clear();
-    for (size_t i = 0; i < nBrickIndices; i++) {
-        _requiredBricks.insert(brickIndices[i]);
+    for (int brickIndex : brickIndices) {
+        _requiredBricks.insert(brickIndex);
     }
 
-    for (unsigned int it : _prevRequiredBricks) {
-        if (!_requiredBricks.count(it)) {
-            removeFromAtlas(it);
+    // Frees the bricks that are neither required nor used as a stand-in anymore
+    updateAtlasMap(brickIndices);
+
+    std::vector<TspBrickLoader::Brick> bricks = _loader->takeLoaded(_maxBricksPerFrame);
+    std::erase_if(
+        bricks,
+        [this](const TspBrickLoader::Brick& brick) {
+            return !_requiredBricks.contains(brick.index) ||
+                   _brickMap.contains(brick.index);
         }
+    );
+    if (bricks.size() > _freeAtlasCoords.size()) {
+        bricks = evictStandIns(std::move(bricks), brickIndices);
     }
 
     // Stats
     _nUsedBricks = static_cast<unsigned int>(_requiredBricks.size());
-    _nStreamedBricks = 0;
-    _nDiskReads = 0;
-
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pboHandle[bufferIndex]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, _volumeSize, nullptr, GL_STREAM_DRAW);
-    float* mappedBuffer = reinterpret_cast<float*>(
-        glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY)
-    );
+    _nStreamedBricks = static_cast<unsigned int>(bricks.size());
+    _nDiskReads = _loader->popNumDiskReads();
+
+    if (!bricks.empty()) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pboHandle[_pboIndex]);
+        float* mappedBuffer = reinterpret_cast<float*>(glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER,
+            0,
+            static_cast<GLsizeiptr>(bricks.size()) * _brickSize,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        ));
+
+        if (!mappedBuffer) {
+            LERRORC("AtlasManager", "Failed to map PBO");
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            return;
+        }
+        for (size_t i = 0; i < bricks.size(); i++) {
+            std::memcpy(
+                mappedBuffer + i * _nBrickVals,
+                bricks[i].data.data(),
+                _brickSize
+            );
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
 
-    if (!mappedBuffer) {
-        LERRORC("AtlasManager", "Failed to map PBO");
-        return;
-    }
+        glBindTexture(GL_TEXTURE_3D, *_textureAtlas);
+        for (size_t i = 0; i < bricks.size(); i++) {
+            const unsigned int brickIndex = bricks[i].index;
+            const unsigned int atlasCoords = _freeAtlasCoords.back();
+            _freeAtlasCoords.pop_back();
+            const int level = _nOtLevels - static_cast<int>(
+                floor(log1p((7.0 * (float(brickIndex % _nOtNodes))))/log(8)) - 1
+            );
+            ghoul_assert(atlasCoords <= 0x0FFFFFFF, "@MISSING");
+            const unsigned int atlasData = (level << 28) + atlasCoords;
+            _brickMap.emplace(brickIndex, atlasData);
 
-    for (auto itStart = _requiredBricks.begin(); itStart != _requiredBricks.end();) {
-        int firstBrick = *itStart;
-        int lastBrick = firstBrick;
-
-        auto itEnd = itStart;
-        for (itEnd++;
-            itEnd != _requiredBricks.end() &&
-            *itEnd == static_cast<unsigned int>(lastBrick) + 1;
-            itEnd++)
-        {
-            lastBrick = *itEnd;
+            const unsigned int x = atlasCoords % _nBricksPerDim;
+            const unsigned int y = (atlasCoords / _nBricksPerDim) % _nBricksPerDim;
+            const unsigned int z = atlasCoords / _nBricksPerDim / _nBricksPerDim;
+            glTexSubImage3D(
+                GL_TEXTURE_3D,
+                0,
+                static_cast<GLint>(x * _paddedBrickDim),
+                static_cast<GLint>(y * _paddedBrickDim),
+                static_cast<GLint>(z * _paddedBrickDim),
+                static_cast<GLsizei>(_paddedBrickDim),
+                static_cast<GLsizei>(_paddedBrickDim),
+                static_cast<GLsizei>(_paddedBrickDim),
+                GL_RED,
+                GL_FLOAT,
+                reinterpret_cast<const void*>(i * _brickSize)
+            );
         }
+        glBindTexture(GL_TEXTURE_3D, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        _pboIndex = 1 - _pboIndex;
 
-        addToAtlas(firstBrick, lastBrick, mappedBuffer);
-
-        itStart = itEnd;
+        updateAtlasMap(brickIndices);
     }
 
-    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-
-    for (size_t i = 0; i < nBrickIndices; i++) {
-        _atlasMap[i] = _brickMap[brickIndices[i]];
+    std::vector<std::pair<unsigned int, float>> requests;
+    for (unsigned int brickIndex : _requiredBricks) {
+        if (!_brickMap.contains(brickIndex)) {
+            const float error =
+                _tsp->spatialError(brickIndex) + _tsp->temporalError(brickIndex);
+            requests.emplace_back(brickIndex, error);
+        }
     }
-
-    std::swap(_prevRequiredBricks, _requiredBricks);
-
-    pboToAtlas(bufferIndex);
+    _loader->request(std::move(requests));
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, _atlasMapBuffer);
     GLint* to = reinterpret_cast<GLint*>(
@@ -155,105 +218,100 @@ void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickI
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
-void AtlasManager::addToAtlas(int firstBrickIndex, int lastBrickIndex,
-                              float* mappedBuffer)
-{
-    while (_brickMap.count(firstBrickIndex) && firstBrickIndex <= lastBrickIndex) {
-        firstBrickIndex++;
+void AtlasManager::updateAtlasMap(const std::vector<int>& brickIndices) {
+    for (size_t i = 0; i < brickIndices.size(); i++) {
+        const unsigned int brickIndex = static_cast<unsigned int>(brickIndices[i]);
+        if (_brickMap.contains(brickIndex)) {
+            _leafBricks[i] = brickIndex;
+        }
+        else if (!_brickMap.contains(_leafBricks[i])) {
+            _leafBricks[i] = NotUsedIndex;
+        }
+        _atlasMap[i] =
+            _leafBricks[i] == NotUsedIndex ? NotUsedIndex : _brickMap[_leafBricks[i]];
     }
-    while (_brickMap.count(lastBrickIndex) && lastBrickIndex >= firstBrickIndex) {
-        lastBrickIndex--;
+
+    const std::set<unsigned int> usedBricks(_leafBricks.begin(), _leafBricks.end());
+    std::vector<unsigned int> unusedBricks;
+    for (const std::pair<const unsigned int, unsigned int>& p : _brickMap) {
+        if (!usedBricks.contains(p.first)) {
+            unusedBricks.push_back(p.first);
+        }
     }
-    if (lastBrickIndex < firstBrickIndex) {
-        return;
+    for (unsigned int brickIndex : unusedBricks) {
+        removeFromAtlas(brickIndex);
     }
+}
 
-    int sequenceLength = lastBrickIndex - firstBrickIndex + 1;
-    float* sequenceBuffer = new float[sequenceLength*_nBrickVals];
-    size_t bufferSize = sequenceLength * _brickSize;
+std::vector<TspBrickLoader::Brick> AtlasManager::evictStandIns(
+                                                std::vector<TspBrickLoader::Brick> bricks,
+                                                     const std::vector<int>& brickIndices)
+{
+    // The number of leaves that use each brick and the leaves that are waiting for each
+    // brick while using a stand-in
+    std::map<unsigned int, unsigned int> nUsers;
+    std::map<unsigned int, std::vector<size_t>> waitingLeaves;
+    for (size_t i = 0; i < _leafBricks.size(); i++) {
+        const unsigned int brick = _leafBricks[i];
+        if (brick == NotUsedIndex) {
+            continue;
+        }
+        nUsers[brick]++;
+        if (brick != static_cast<unsigned int>(brickIndices[i])) {
+            waitingLeaves[static_cast<unsigned int>(brickIndices[i])].push_back(i);
+        }
+    }
 
-    long long offset = TSP::dataPosition() + static_cast<long long>(firstBrickIndex) *
-                       static_cast<long long>(_brickSize);
-    _tsp->file().seekg(offset);
-    _tsp->file().read(reinterpret_cast<char*>(sequenceBuffer), bufferSize);
-    _nDiskReads++;
+    size_t nFree = _freeAtlasCoords.size();
+    bool hasEvicted = false;
+    std::vector<TspBrickLoader::Brick> result;
+    for (TspBrickLoader::Brick& brick : bricks) {
+        std::vector<size_t>& leaves = waitingLeaves[brick.index];
+        if (nFree == 0) {
+            // Only evict the stand-ins if that frees a slot, as a stand-in can be shared
+            // with leaves that are waiting for bricks that have not been loaded yet
+            std::map<unsigned int, unsigned int> nRemoved;
+            for (size_t leaf : leaves) {
+                nRemoved[_leafBricks[leaf]]++;
+            }
+            for (const auto& [standIn, n] : nRemoved) {
+                nFree += (nUsers[standIn] == n) ? 1 : 0;
+            }
+            if (nFree == 0) {
+                // This brick is requested again once a slot has been freed
+                continue;
+            }
 
-    for (int brickIndex = firstBrickIndex; brickIndex <= lastBrickIndex; brickIndex++) {
-        if (!_brickMap.count(brickIndex)) {
-            unsigned int atlasCoords = _freeAtlasCoords.back();
-            _freeAtlasCoords.pop_back();
-            int level = _nOtLevels - static_cast<int>(
-                floor(log1p((7.0 * (float(brickIndex % _nOtNodes))))/log(8)) - 1
-            );
-            ghoul_assert(atlasCoords <= 0x0FFFFFFF, "@MISSING");
-            unsigned int atlasData = (level << 28) + atlasCoords;
-            _brickMap.emplace(brickIndex, atlasData);
-            _nStreamedBricks++;
-            fillVolume(
-                &sequenceBuffer[_nBrickVals*(brickIndex - firstBrickIndex)],
-                mappedBuffer,
-                atlasCoords
-            );
+            for (size_t leaf : leaves) {
+                nUsers[_leafBricks[leaf]]--;
+                _leafBricks[leaf] = NotUsedIndex;
+            }
+            leaves.clear();
+            hasEvicted = true;
         }
+        nFree--;
+        result.push_back(std::move(brick));
     }
 
-    delete[] sequenceBuffer;
+    // If the atlas is full, every slot is used by exactly one leaf, as there are as many
+    // slots as leaves. Evicting the stand-in of a leaf that is waiting for a loaded brick
+    // thus always frees a slot, so every update uploads at least one of the bricks
+    ghoul_assert(!result.empty(), "Updating the atlas must make progress");
+
+    if (hasEvicted) {
+        // Frees the slots of the evicted stand-ins
+        updateAtlasMap(brickIndices);
+    }
+    return result;
 }
 
-void AtlasManager::removeFromAtlas(int brickIndex) {
+void AtlasManager::removeFromAtlas(unsigned int brickIndex) {
     unsigned int atlasData = _brickMap[brickIndex];
     unsigned int atlasCoords = atlasData & 0x0FFFFFFF;
     _brickMap.erase(brickIndex);
     _freeAtlasCoords.push_back(atlasCoords);
 }
 
-void AtlasManager::fillVolume(float* in, float* out, unsigned int linearAtlasCoords) {
-    int x = linearAtlasCoords % _nBricksPerDim;
-    int y = (linearAtlasCoords / _nBricksPerDim) % _nBricksPerDim;
-    int z = linearAtlasCoords / _nBricksPerDim / _nBricksPerDim;
-
-    unsigned int xMin = x*_paddedBrickDim;
-    unsigned int yMin = y*_paddedBrickDim;
-    unsigned int zMin = z*_paddedBrickDim;
-    unsigned int xMax = xMin + _paddedBrickDim;
-    unsigned int yMax = yMin + _paddedBrickDim;
-    unsigned int zMax = zMin + _paddedBrickDim;
-
-    unsigned int from = 0;
-    for (unsigned int zValCoord = zMin; zValCoord<zMax; ++zValCoord) {
-        for (unsigned int yValCoord = yMin; yValCoord<yMax; ++yValCoord) {
-            for (unsigned int xValCoord = xMin; xValCoord<xMax; ++xValCoord) {
-                unsigned int idx = xValCoord + yValCoord * _atlasDim +
-                                   zValCoord * _atlasDim * _atlasDim;
-
-                out[idx] = in[from];
-                from++;
-            }
-        }
-    }
-}
-
-void AtlasManager::pboToAtlas(BufferIndex bufferIndex) {
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pboHandle[bufferIndex]);
-    glm::size3_t dim = _textureAtlas->dimensions();
-    glBindTexture(GL_TEXTURE_3D, *_textureAtlas);
-    glTexSubImage3D(
-        GL_TEXTURE_3D,
-        0,
-        0,
-        0,
-        0,
-        static_cast<GLsizei>(dim[0]),
-        static_cast<GLsizei>(dim[1]),
-        static_cast<GLsizei>(dim[2]),
-        GL_RED,
-        GL_FLOAT,
-        nullptr
-    );
-    glBindTexture(GL_TEXTURE_3D, 0);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-}
-
 ghoul::opengl::Texture& AtlasManager::textureAtlas() {
     ghoul_assert(_textureAtlas != nullptr, "Texture atlas is nullptr");
     return *_textureAtlas;
@@ -25,9 +25,11 @@
 #ifndef __OPENSPACE_MODULE_MULTIRESVOLUME___ATLASMANAGER___H__
 #define __OPENSPACE_MODULE_MULTIRESVOLUME___ATLASMANAGER___H__
 
+#include <modules/multiresvolume/rendering/tspbrickloader.h>
 #include <ghoul/glm.h>
 #include <glm/gtx/std_based_type.hpp>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -38,24 +40,36 @@ namespace openspace {
 
 class TSP;
 
+/**
+ * Keeps the bricks that are selected for rendering in a texture atlas. The bricks are
+ * read from the TSP file on a separate thread and are uploaded progressively with a
+ * limited number of bricks per frame, alternating between two pixel buffer objects. Until
+ * a selected brick has been uploaded, the octree leaves that it covers keep using the
+ * brick they used before, if it is still in the atlas.
+ */
 class AtlasManager {
 public:
-    enum BufferIndex {
-        EVEN = 0,
-        ODD = 1
-    };
-
-    AtlasManager(TSP* tsp);
-    ~AtlasManager() = default;
-
-    void updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickIndices);
-    void addToAtlas(int firstBrickIndex, int lastBrickIndex, float* mappedBuffer);
-    void removeFromAtlas(int brickIndex);
+    /**
+     * \param tsp The TSP whose bricks are stored in the atlas
+     * \param maxBricksPerFrame The maximum number of bricks that are uploaded to the
+     *        atlas in each call to #updateAtlas
+     */
+    AtlasManager(TSP* tsp, unsigned int maxBricksPerFrame = 64);
+    ~AtlasManager();
+
+    /**
+     * Uploads the bricks that have been read since the last call and requests the bricks
+     * in \p brickIndices that are not in the atlas yet. The bricks are requested in the
+     * order of their spatial and temporal error so that the coarse bricks, which cover
+     * the largest parts of the volume, arrive first.
+     *
+     * \param brickIndices The brick that should be used for each octree leaf
+     */
+    void updateAtlas(std::vector<int>& brickIndices);
     bool initialize();
     const std::vector<unsigned int>& atlasMap() const;
     unsigned int atlasMapBuffer() const;
 
-    void pboToAtlas(BufferIndex bufferIndex);
     ghoul::opengl::Texture& textureAtlas();
 
     unsigned int numDiskReads() const;
@@ -67,22 +81,42 @@ public:
 private:
     const unsigned int NotUsedIndex = std::numeric_limits<unsigned int>::max();
 
+    /**
+     * Points every octree leaf to its brick in \p brickIndices if that brick is in the
+     * atlas, or otherwise to the brick it used before. Bricks that are not used by any
+     * leaf afterwards are removed from the atlas.
+     */
+    void updateAtlasMap(const std::vector<int>& brickIndices);
+
+    /**
+     * Returns the subset of the loaded \p bricks for which a slot in the atlas is free.
+     * If there are not enough free slots, the stand-ins of the leaves that are waiting
+     * for one of the \p bricks are removed from the atlas to make room.
+     */
+    std::vector<TspBrickLoader::Brick> evictStandIns(
+        std::vector<TspBrickLoader::Brick> bricks, const std::vector<int>& brickIndices);
+    void removeFromAtlas(unsigned int brickIndex);
+
     TSP* _tsp;
+    std::unique_ptr<TspBrickLoader> _loader;
+    const unsigned int _maxBricksPerFrame;
     unsigned int _pboHandle[2];
+    unsigned int _pboIndex = 0;
     unsigned int _atlasMapBuffer;
 
     std::vector<unsigned int> _atlasMap;
+    // The brick that each octree leaf points to in _atlasMap, or NotUsedIndex
+    std::vector<unsigned int> _leafBricks;
     std::map<unsigned int, unsigned int> _brickMap;
     std::vector<unsigned int> _freeAtlasCoords;
     std::set<unsigned int> _requiredBricks;
-    std::set<unsigned int> _prevRequiredBricks;
 
     ghoul::opengl::Texture* _textureAtlas;
 
     // Stats
-    unsigned int _nUsedBricks;
-    unsigned int _nStreamedBricks;
-    unsigned int _nDiskReads;
+    unsigned int _nUsedBricks = 0;
+    unsigned int _nStreamedBricks = 0;
+    unsigned int _nDiskReads = 0;
 
     unsigned int _nBricksPerDim;
     unsigned int _nOtLeaves;
@@ -90,13 +124,10 @@ private:
     unsigned int _nOtLevels;
     unsigned int _brickSize;
     unsigned int _nBrickVals;
-    unsigned int _volumeSize;
     unsigned int _paddedBrickDim;
     unsigned int _nBricksInAtlas;
     unsigned int _nBricksInMap;
     unsigned int _atlasDim;
-
-    void fillVolume(float* in, float* out, unsigned int linearAtlasCoords);
 };
 
 } // namespace openspace
@@ -358,7 +358,27 @@ bool LocalTfBrickSelector::calculateBrickErrors() {
     }
 
     const unsigned int nHistograms = _tsp->numTotalNodes();
-    _brickErrors = std::vector<Error>(nHistograms);
+
+    // The errors of a brick are sums over all gradients, so if the errors have been
+    // computed before, only the range of gradients that have changed since then has to
+    // be reevaluated. Otherwise we start from zero, which evaluates the full range
+    if (_brickErrors.size() != nHistograms || _gradients.size() != gradients.size()) {
+        _brickErrors = std::vector<Error>(nHistograms, Error{ 0.f, 0.f });
+        _gradients = std::vector<float>(gradients.size(), 0.f);
+    }
+
+    size_t first = gradients.size();
+    size_t last = 0;
+    for (size_t i = 0; i < gradients.size(); i++) {
+        if (gradients[i] != _gradients[i]) {
+            first = std::min(first, i);
+            last = i + 1;
+        }
+    }
+    if (first >= last) {
+        // The change of the transfer function did not affect any of the brick errors
+        return true;
+    }
 
     for (unsigned int brickIndex = 0; brickIndex < nHistograms; brickIndex++) {
         if (_tsp->isOctreeLeaf(brickIndex)) {
@@ -368,15 +388,16 @@ bool LocalTfBrickSelector::calculateBrickErrors() {
             const Histogram* histogram = _histogramManager->spatialHistogram(
                 brickIndex
             );
-            float error = 0;
-            for (size_t i = 0; i < gradients.size(); i++) {
+            float deltaError = 0;
+            for (size_t i = first; i < last; i++) {
                 float x = (i + 0.5f) / tfWidth;
                 float sample = histogram->interpolate(x);
                 ghoul_assert(sample >= 0, "@MISSING");
                 ghoul_assert(gradients[i] >= 0, "@MISSING");
-                error += sample * gradients[i];
+                deltaError += sample * (gradients[i] - _gradients[i]);
             }
-            _brickErrors[brickIndex].spatial = error;
+            float& error = _brickErrors[brickIndex].spatial;
+            error = std::max(error + deltaError, 0.f);
         }
 
         if (_tsp->isBstLeaf(brickIndex)) {
@@ -386,18 +407,20 @@ bool LocalTfBrickSelector::calculateBrickErrors() {
             const Histogram* histogram = _histogramManager->temporalHistogram(
                 brickIndex
             );
-            float error = 0;
-            for (size_t i = 0; i < gradients.size(); i++) {
+            float deltaError = 0;
+            for (size_t i = first; i < last; i++) {
                 float x = (i + 0.5f) / tfWidth;
                 float sample = histogram->interpolate(x);
                 ghoul_assert(sample >= 0, "@MISSING");
                 ghoul_assert(gradients[i] >= 0, "@MISSING");
-                error += sample * gradients[i];
+                deltaError += sample * (gradients[i] - _gradients[i]);
             }
-            _brickErrors[brickIndex].temporal = error;
+            float& error = _brickErrors[brickIndex].temporal;
+            error = std::max(error + deltaError, 0.f);
         }
     }
 
+    _gradients = std::move(gradients);
     return true;
 }
 
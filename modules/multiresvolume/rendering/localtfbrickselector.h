@@ -59,6 +59,8 @@ private:
     LocalErrorHistogramManager* _histogramManager;
     TransferFunction* _transferFunction;
     std::vector<Error> _brickErrors;
+    /// The transfer function gradients that `_brickErrors` were computed for
+    std::vector<float> _gradients;
 
     float spatialSplitPoints(unsigned int brickIndex) const;
     float temporalSplitPoints(unsigned int brickIndex) const;
@@ -57,6 +57,7 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iterator>
 
 namespace {
@@ -264,9 +265,13 @@ RenderableMultiresVolume::RenderableMultiresVolume(const ghoul::Dictionary& dict
     addProperty(_rotation);
 }
 
-RenderableMultiresVolume::~RenderableMultiresVolume() {}
+RenderableMultiresVolume::~RenderableMultiresVolume() {
+    invalidateBrickSelection();
+}
 
 void RenderableMultiresVolume::setSelectorType(Selector selector) {
+    invalidateBrickSelection();
+
     // @TODO(abock): Can these if statements be simplified by checking if
     //               selector == _selector before and bailing out early?
     _selector = selector;
@@ -284,6 +289,7 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
                     _streamingBudget
                 );
                 _transferFunction->setCallback([this](const TransferFunction&) {
+                    invalidateBrickSelection();
                     _tfBrickSelector->calculateBrickErrors();
                 });
                 if (initializeSelector()) {
@@ -304,6 +310,7 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
                     _streamingBudget
                 );
                 _transferFunction->setCallback([this](const TransferFunction&) {
+                    invalidateBrickSelection();
                     _simpleTfBrickSelector->calculateBrickImportances();
                 });
                 if (initializeSelector()) {
@@ -325,6 +332,7 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
                     _streamingBudget
                 );
                 _transferFunction->setCallback([this](const TransferFunction&) {
+                    invalidateBrickSelection();
                     _localTfBrickSelector->calculateBrickErrors();
                 });
                 if (initializeSelector()) {
@@ -369,6 +377,7 @@ void RenderableMultiresVolume::initializeGL() {
 
     if (success) {
         _brickIndices.resize(maxNumBricks, 0);
+        _nextBrickIndices.resize(maxNumBricks, 0);
         setSelectorType(_selector);
     }
 
@@ -404,6 +413,7 @@ void RenderableMultiresVolume::initializeGL() {
 }
 
 void RenderableMultiresVolume::deinitializeGL() {
+    invalidateBrickSelection();
     _tsp = nullptr;
     _transferFunction = nullptr;
 }
@@ -624,44 +634,24 @@ void RenderableMultiresVolume::update(const UpdateData& data) {
     }
 
     if (visible) {
-        std::chrono::system_clock::time_point selectionStart;
-        if (_gatheringStats) {
-            selectionStart = std::chrono::system_clock::now();
-        }
-
-        switch (_selector) {
-            case Selector::TF:
-                if (_tfBrickSelector) {
-                    _tfBrickSelector->setMemoryBudget(_memoryBudget);
-                    _tfBrickSelector->setStreamingBudget(_streamingBudget);
-                    _tfBrickSelector->selectBricks(currentTimestep, _brickIndices);
-                }
-                break;
-            case Selector::SIMPLE:
-                if (_simpleTfBrickSelector) {
-                    _simpleTfBrickSelector->setMemoryBudget(_memoryBudget);
-                    _simpleTfBrickSelector->setStreamingBudget(_streamingBudget);
-                    _simpleTfBrickSelector->selectBricks(currentTimestep, _brickIndices);
-                }
-                break;
-            case Selector::LOCAL:
-                if (_localTfBrickSelector) {
-                    _localTfBrickSelector->setMemoryBudget(_memoryBudget);
-                    _localTfBrickSelector->setStreamingBudget(_streamingBudget);
-                    _localTfBrickSelector->selectBricks(currentTimestep, _brickIndices);
-                }
-                break;
+        // The bricks are selected on a worker thread and only for new inputs. Until a
+        // selection has finished, the volume is rendered with the previous selection
+        finishBrickSelection(false);
+        const BrickSelectionInput input = {
+            .timestep = currentTimestep,
+            .memoryBudget = _memoryBudget,
+            .streamingBudget = _streamingBudget
+        };
+        if (!_brickSelection.valid() && _brickSelectionInput != input) {
+            startBrickSelection(input);
         }
 
         std::chrono::system_clock::time_point uploadStart;
         if (_gatheringStats) {
-            std::chrono::system_clock::time_point selectionEnd =
-                std::chrono::system_clock::now();
-            _selectionDuration = selectionEnd - selectionStart;
-            uploadStart = selectionEnd;
+            uploadStart = std::chrono::system_clock::now();
         }
 
-        _atlasManager->updateAtlas(AtlasManager::EVEN, _brickIndices);
+        _atlasManager->updateAtlas(_brickIndices);
 
         if (_gatheringStats) {
             std::chrono::system_clock::time_point uploadEnd =
@@ -695,6 +685,68 @@ void RenderableMultiresVolume::update(const UpdateData& data) {
     }
 }
 
+void RenderableMultiresVolume::startBrickSelection(const BrickSelectionInput& input) {
+    BrickSelector* selector = nullptr;
+    switch (_selector) {
+        case Selector::TF:
+            if (_tfBrickSelector) {
+                _tfBrickSelector->setMemoryBudget(input.memoryBudget);
+                _tfBrickSelector->setStreamingBudget(input.streamingBudget);
+                selector = _tfBrickSelector.get();
+            }
+            break;
+        case Selector::SIMPLE:
+            if (_simpleTfBrickSelector) {
+                _simpleTfBrickSelector->setMemoryBudget(input.memoryBudget);
+                _simpleTfBrickSelector->setStreamingBudget(input.streamingBudget);
+                selector = _simpleTfBrickSelector.get();
+            }
+            break;
+        case Selector::LOCAL:
+            if (_localTfBrickSelector) {
+                _localTfBrickSelector->setMemoryBudget(input.memoryBudget);
+                _localTfBrickSelector->setStreamingBudget(input.streamingBudget);
+                selector = _localTfBrickSelector.get();
+            }
+            break;
+    }
+    if (!selector) {
+        return;
+    }
+
+    _brickSelectionInput = input;
+    _brickSelection = std::async(
+        std::launch::async,
+        [this, selector, timestep = input.timestep]() {
+            const std::chrono::system_clock::time_point start =
+                std::chrono::system_clock::now();
+            selector->selectBricks(timestep, _nextBrickIndices);
+            return std::chrono::duration<double>(
+                std::chrono::system_clock::now() - start
+            );
+        }
+    );
+}
+
+void RenderableMultiresVolume::finishBrickSelection(bool wait) {
+    if (!_brickSelection.valid()) {
+        return;
+    }
+
+    using namespace std::chrono_literals;
+    if (!wait && _brickSelection.wait_for(0s) != std::future_status::ready) {
+        return;
+    }
+
+    _selectionDuration = _brickSelection.get();
+    _brickIndices.swap(_nextBrickIndices);
+}
+
+void RenderableMultiresVolume::invalidateBrickSelection() {
+    finishBrickSelection(true);
+    _brickSelectionInput = std::nullopt;
+}
+
 void RenderableMultiresVolume::render(const RenderData& data, RendererTasks& tasks) {
     RaycasterTask task { _raycaster.get(), data };
     tasks.raycasterTasks.push_back(task);
@@ -34,6 +34,8 @@
 #include <openspace/properties/vector/vec3property.h>
 #include <chrono>
 #include <filesystem>
+#include <future>
+#include <optional>
 
 namespace ghoul { class Dictionary; }
 namespace ghoul::filesystem { class File; }
@@ -85,6 +87,34 @@ public:
     //virtual std::vector<unsigned int> getBuffers() override;
 
 private:
+    /// The values that the result of a brick selection depends on
+    struct BrickSelectionInput {
+        int timestep = 0;
+        int memoryBudget = 0;
+        int streamingBudget = 0;
+
+        bool operator==(const BrickSelectionInput&) const = default;
+    };
+
+    /**
+     * Starts selecting the bricks for the provided \p input on a worker thread. The
+     * result is written to `_nextBrickIndices` and picked up by #finishBrickSelection.
+     */
+    void startBrickSelection(const BrickSelectionInput& input);
+
+    /**
+     * Makes the result of a running brick selection the current selection. If
+     * \p wait is `false` the function returns immediately if the selection has not
+     * finished yet.
+     */
+    void finishBrickSelection(bool wait);
+
+    /**
+     * Waits for a running brick selection and marks the current selection as outdated.
+     * This has to be called before any of the data that the selectors use is changed.
+     */
+    void invalidateBrickSelection();
+
     properties::BoolProperty _useGlobalTime;
     properties::BoolProperty _loop;
     // used to vary time, if not using global time nor looping
@@ -130,6 +160,12 @@ private:
     std::shared_ptr<TSP> _tsp;
     std::vector<int> _brickIndices;
 
+    // The brick selection that is running on a worker thread, the buffer it writes to,
+    // and the input that the latest started selection was made with
+    std::future<std::chrono::duration<double>> _brickSelection;
+    std::vector<int> _nextBrickIndices;
+    std::optional<BrickSelectionInput> _brickSelectionInput;
+
     std::shared_ptr<AtlasManager> _atlasManager;
 
     std::unique_ptr<MultiresVolumeRaycaster> _raycaster;
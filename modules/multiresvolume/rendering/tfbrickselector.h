@@ -54,6 +54,8 @@ private:
     ErrorHistogramManager* _histogramManager;
     TransferFunction* _transferFunction;
     std::vector<float> _brickErrors;
+    /// The transfer function gradients that `_brickErrors` were computed for
+    std::vector<float> _gradients;
 
     float spatialSplitPoints(unsigned int brickIndex);
     float temporalSplitPoints(unsigned int brickIndex);
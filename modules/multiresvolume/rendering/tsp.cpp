@@ -24,18 +24,105 @@
 
 #include <modules/multiresvolume/rendering/tsp.h>
 
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/format.h>
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <filesystem>
 #include <numeric>
 #include <queue>
+#include <span>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "TSP";
+
+    // The TSP file from which the bricks are read during the error calculation. The file
+    // is memory mapped if possible, so that all threads can share it
+    struct BrickSource {
+        BrickSource(std::filesystem::path path_, unsigned int nBrickValues_)
+            : path(std::move(path_))
+            , nBrickValues(nBrickValues_)
+        {
+            try {
+                mappedFile = std::make_unique<openspace::MemoryMappedFile>(path);
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LWARNING(std::format(
+                    "Could not memory map '{}', falling back to file reads: {}",
+                    path, e.message
+                ));
+            }
+        }
+
+        std::filesystem::path path;
+        unsigned int nBrickValues;
+        std::unique_ptr<openspace::MemoryMappedFile> mappedFile;
+    };
+
+    // Reads bricks for a single thread. The returned values are only valid until the
+    // next call to read
+    class BrickReader {
+    public:
+        explicit BrickReader(const BrickSource& source) : _source(source) {
+            if (!_source.mappedFile) {
+                _file.open(_source.path, std::ios::in | std::ios::binary);
+                _buffer.resize(_source.nBrickValues);
+            }
+        }
+
+        std::span<const float> read(unsigned int brick) {
+            const size_t offset = openspace::TSP::dataPosition() +
+                static_cast<size_t>(brick) * _source.nBrickValues * sizeof(float);
+            if (_source.mappedFile) {
+                return std::span<const float>(
+                    reinterpret_cast<const float*>(_source.mappedFile->data() + offset),
+                    _source.nBrickValues
+                );
+            }
+            _file.seekg(offset);
+            _file.read(
+                reinterpret_cast<char*>(_buffer.data()),
+                static_cast<size_t>(_source.nBrickValues) * sizeof(float)
+            );
+            return _buffer;
+        }
+
+    private:
+        const BrickSource& _source;
+        std::ifstream _file;
+        std::vector<float> _buffer;
+    };
+
+    // Calls func(reader, brick) for all bricks in [0, nBricks), distributed over all
+    // hardware threads. Each thread has its own reader
+    template <typename Func>
+    void forEachBrick(const BrickSource& source, unsigned int nBricks, Func func) {
+        std::atomic<unsigned int> next = 0;
+        auto work = [&]() {
+            BrickReader reader = BrickReader(source);
+            for (unsigned int b = next++; b < nBricks; b = next++) {
+                func(reader, b);
+            }
+        };
+
+        const unsigned int nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads);
+        for (unsigned int i = 0; i < nThreads; i++) {
+            threads.emplace_back(work);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
 } // namespace
 
 namespace openspace {
@@ -226,6 +313,10 @@ std::ifstream& TSP::file() {
     return _file;
 }
 
+const std::filesystem::path& TSP::filename() const {
+    return _filename;
+}
+
 unsigned int TSP::numTotalNodes() const {
     return _numTotalNodes;
 }
@@ -273,31 +364,22 @@ bool TSP::calculateSpatialError() {
         return false;
     }
 
-    std::vector<float> buffer(numBrickVals);
+    const BrickSource source = BrickSource(_filename, numBrickVals);
     std::vector<float> averages(_numTotalNodes);
     std::vector<float> stdDevs(_numTotalNodes);
 
     // First pass: Calculate average color for each brick
     LDEBUG("Calculating spatial error, first pass");
-    for (unsigned int brick = 0; brick<_numTotalNodes; ++brick) {
-        // Offset in file
-        std::streampos offset = dataPosition() +
-                                static_cast<long long>(brick*numBrickVals*sizeof(float));
-        _file.seekg(offset);
-
-        _file.read(
-            reinterpret_cast<char*>(&buffer[0]),
-            static_cast<size_t>(numBrickVals) * sizeof(float)
-        );
-
-        double average = std::accumulate(
-            buffer.begin(),
-            buffer.end(),
+    forEachBrick(source, _numTotalNodes, [&](BrickReader& r, unsigned int brick) {
+        const std::span<const float> values = r.read(brick);
+        const double average = std::accumulate(
+            values.begin(),
+            values.end(),
             0.0,
             [](double a, float b) { return a + static_cast<double>(b); }
         );
         averages[brick] = static_cast<float>(average / static_cast<double>(numBrickVals));
-    }
+    });
 
     // Spatial SNR stats
     float minError = 1e20f;
@@ -307,12 +389,9 @@ bool TSP::calculateSpatialError() {
     // Second pass: For each brick, compare the covered leaf voxels with
     // the brick average
     LDEBUG("Calculating spatial error, second pass");
-    for (unsigned int brick = 0; brick < _numTotalNodes; ++brick) {
+    forEachBrick(source, _numTotalNodes, [&](BrickReader& r, unsigned int brick) {
         // Fetch mean intensity
-        float brickAvg = averages[brick];
-
-        // Sum  for std dev computation
-        float stdDev = 0.f;
+        const float brickAvg = averages[brick];
 
         // Get a list of leaf bricks that the current brick covers
         std::list<unsigned int> leafBricksCovered = coveredLeafBricks(brick);
@@ -321,39 +400,32 @@ bool TSP::calculateSpatialError() {
         // Ad hoc "hack" to distinguish leafs from other nodes that happens
         // to get a zero error due to rounding errors or other reasons.
         if (leafBricksCovered.size() == 1) {
-            stdDev = -0.1f;
+            stdDevs[brick] = -0.1f;
+            return;
         }
-        else {
-
-            // Calculate "standard deviation" corresponding to leaves
-            for (auto lb = leafBricksCovered.begin(); lb != leafBricksCovered.end(); ++lb)
-            {
-                // Read brick
-                std::streampos offset = dataPosition() +
-                                 static_cast<long long>((*lb)*numBrickVals*sizeof(float));
-                _file.seekg(offset);
-
-                _file.read(reinterpret_cast<char*>(&buffer[0]),
-                    static_cast<size_t>(numBrickVals)*sizeof(float));
 
-                // Add to sum
-                for (auto v = buffer.begin(); v != buffer.end(); ++v) {
-                    stdDev += pow(*v - brickAvg, 2.f);
-                }
+        // Calculate "standard deviation" corresponding to leaves
+        double sum = 0.0;
+        for (unsigned int leaf : leafBricksCovered) {
+            const std::span<const float> values = r.read(leaf);
+            float leafSum = 0.f;
+            for (float v : values) {
+                leafSum += (v - brickAvg) * (v - brickAvg);
             }
+            sum += leafSum;
+        }
+        sum /= static_cast<double>(leafBricksCovered.size() * numBrickVals);
+        stdDevs[brick] = static_cast<float>(std::sqrt(sum));
+    });
 
-            stdDev /= static_cast<float>(leafBricksCovered.size()*numBrickVals);
-            stdDev = sqrt(stdDev);
-        } // if not leaf
-
+    for (unsigned int brick = 0; brick < _numTotalNodes; ++brick) {
+        const float stdDev = stdDevs[brick];
         if (stdDev < minError) {
             minError = stdDev;
         }
         else if (stdDev > maxError) {
             maxError = stdDev;
         }
-
-        stdDevs[brick] = stdDev;
         medianArray[brick] = stdDev;
     }
 
@@ -399,6 +471,9 @@ bool TSP::calculateTemporalError() {
 
     LDEBUG("Calculating temporal error");
 
+    const unsigned int numBrickVals = _paddedBrickDim * _paddedBrickDim * _paddedBrickDim;
+    const BrickSource source = BrickSource(_filename, numBrickVals);
+
     // Statistics
     //float minErr = 1e20f;
     //float maxErr = 0.f;
@@ -408,25 +483,7 @@ bool TSP::calculateTemporalError() {
     std::vector<float> errors(_numTotalNodes);
 
     // Calculate temporal error for one brick at a time
-    for (unsigned int brick = 0; brick<_numTotalNodes; ++brick) {
-        unsigned int numBrickVals = _paddedBrickDim * _paddedBrickDim * _paddedBrickDim;
-
-        // Save the individual voxel's average over timesteps. Because the
-        // BSTs are built by averaging leaf nodes, we only need to sample
-        // the brick at the correct coordinate.
-        std::vector<float> voxelAverages(numBrickVals);
-        std::vector<float> voxelStdDevs(numBrickVals);
-
-        // Read the whole brick to fill the averages
-        std::streampos offset = dataPosition() +
-                                static_cast<long long>(brick*numBrickVals*sizeof(float));
-        _file.seekg(offset);
-
-        _file.read(
-            reinterpret_cast<char*>(voxelAverages.data()),
-            static_cast<size_t>(numBrickVals)*sizeof(float)
-        );
-
+    forEachBrick(source, _numTotalNodes, [&](BrickReader& r, unsigned int brick) {
         // Build a list of the BST leaf bricks (within the same octree level) that
         // this brick covers
         std::list<unsigned int> coveredBricks = coveredBSTLeafBricks(brick);
@@ -437,38 +494,38 @@ bool TSP::calculateTemporalError() {
         // 0.0 higher up in the tree
         if (coveredBricks.size() == 1) {
             errors[brick] = -0.1f;
+            return;
         }
-        else {
-            // Calculate standard deviation per voxel, average over brick
-            float avgStdDev = 0.f;
-            for (unsigned int voxel = 0; voxel<numBrickVals; ++voxel) {
-                float stdDev = 0.f;
-                for (auto leaf = coveredBricks.begin();
-                    leaf != coveredBricks.end(); ++leaf)
-                {
-                    // Sample the leaves at the corresponding voxel position
-                    _file.seekg(dataPosition() +
-                        static_cast<long long>(
-                            (*leaf * numBrickVals + voxel) * sizeof(float)
-                        )
-                    );
-
-                    float sample;
-                    _file.read(reinterpret_cast<char*>(&sample), sizeof(float));
-
-                    stdDev += pow(sample - voxelAverages[voxel], 2.f);
-                }
-                stdDev /= static_cast<float>(coveredBricks.size());
-                stdDev = sqrt(stdDev);
 
-                avgStdDev += stdDev;
-            } // for voxel
+        // Save the individual voxel's average over timesteps. Because the
+        // BSTs are built by averaging leaf nodes, we only need to sample
+        // the brick at the correct coordinate. The brick is copied as the reader's
+        // buffer is reused for the covered leaves
+        const std::span<const float> brickValues = r.read(brick);
+        const std::vector<float> voxelAverages(brickValues.begin(), brickValues.end());
+
+        // Accumulate the squared differences of all covered leaves one leaf at a time
+        // so that each leaf brick is read only once
+        std::vector<float> squaredDiffs(numBrickVals, 0.f);
+        for (unsigned int leaf : coveredBricks) {
+            const std::span<const float> samples = r.read(leaf);
+            for (unsigned int voxel = 0; voxel < numBrickVals; ++voxel) {
+                const float diff = samples[voxel] - voxelAverages[voxel];
+                squaredDiffs[voxel] += diff * diff;
+            }
+        }
 
-            avgStdDev /= static_cast<float>(numBrickVals);
-            meanArray[brick] = avgStdDev;
-            errors[brick] = avgStdDev;
+        // Calculate standard deviation per voxel, average over brick
+        const float nCovered = static_cast<float>(coveredBricks.size());
+        float avgStdDev = 0.f;
+        for (unsigned int voxel = 0; voxel < numBrickVals; ++voxel) {
+            avgStdDev += std::sqrt(squaredDiffs[voxel] / nCovered);
         }
-    } // for all bricks
+
+        avgStdDev /= static_cast<float>(numBrickVals);
+        meanArray[brick] = avgStdDev;
+        errors[brick] = avgStdDev;
+    });
 
     std::sort(meanArray.begin(), meanArray.end());
     //float medErr = meanArray[meanArray.size()/2];
@@ -72,6 +72,7 @@ public:
     const Header& header() const;
     static long long dataPosition();
     std::ifstream& file();
+    const std::filesystem::path& filename() const;
     unsigned int numTotalNodes() const;
     unsigned int numValuesPerNode() const;
     unsigned int numBSTNodes() const;
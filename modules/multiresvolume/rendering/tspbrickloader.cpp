@@ -0,0 +1,167 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/multiresvolume/rendering/tspbrickloader.h>
+
+#include <openspace/util/memorymappedfile.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr std::string_view _loggerCat = "TspBrickLoader";
+} // namespace
+
+namespace openspace {
+
+TspBrickLoader::TspBrickLoader(std::filesystem::path path, long long dataOffset,
+                               unsigned int nBrickValues, size_t maxLoadedBricks)
+    : _dataOffset(dataOffset)
+    , _nBrickValues(nBrickValues)
+    , _maxLoadedBricks(std::max<size_t>(maxLoadedBricks, 1))
+{
+    try {
+        _mappedFile = std::make_unique<MemoryMappedFile>(path);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LWARNING(std::format(
+            "Could not memory map '{}', falling back to file reads: {}", path, e.message
+        ));
+        _file.open(path, std::ios::in | std::ios::binary);
+    }
+
+    _thread = std::thread([this]() { work(); });
+}
+
+TspBrickLoader::~TspBrickLoader() {
+    {
+        std::unique_lock lock(_mutex);
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+    _thread.join();
+}
+
+void TspBrickLoader::request(std::vector<std::pair<unsigned int, float>> bricks) {
+    {
+        std::unique_lock lock(_mutex);
+        std::erase_if(
+            bricks,
+            [this](const std::pair<unsigned int, float>& b) {
+                return _inFlight.contains(b.first);
+            }
+        );
+        std::sort(
+            bricks.begin(),
+            bricks.end(),
+            [](const std::pair<unsigned int, float>& lhs,
+               const std::pair<unsigned int, float>& rhs)
+            {
+                return lhs.second < rhs.second;
+            }
+        );
+        _requests = std::move(bricks);
+    }
+    _wakeUp.notify_all();
+}
+
+std::vector<TspBrickLoader::Brick> TspBrickLoader::takeLoaded(size_t maxBricks) {
+    std::vector<Brick> result;
+    {
+        std::unique_lock lock(_mutex);
+        const size_t n = std::min(maxBricks, _loaded.size());
+        result.reserve(n);
+        std::move(_loaded.begin(), _loaded.begin() + n, std::back_inserter(result));
+        _loaded.erase(_loaded.begin(), _loaded.begin() + n);
+        for (const Brick& brick : result) {
+            _inFlight.erase(brick.index);
+        }
+    }
+    _wakeUp.notify_all();
+    return result;
+}
+
+unsigned int TspBrickLoader::popNumDiskReads() {
+    std::unique_lock lock(_mutex);
+    return std::exchange(_nDiskReads, 0);
+}
+
+bool TspBrickLoader::isMemoryMapped() const {
+    return _mappedFile != nullptr;
+}
+
+void TspBrickLoader::work() {
+    while (true) {
+        Brick brick;
+        {
+            std::unique_lock lock(_mutex);
+            _wakeUp.wait(lock, [this]() {
+                return _stop ||
+                    (!_requests.empty() && _loaded.size() < _maxLoadedBricks);
+            });
+
+            if (_stop) {
+                return;
+            }
+
+            brick.index = _requests.back().first;
+            _requests.pop_back();
+            _inFlight.insert(brick.index);
+        }
+
+        readBrick(brick.index, brick.data);
+
+        std::unique_lock lock(_mutex);
+        _nDiskReads++;
+        _loaded.push_back(std::move(brick));
+    }
+}
+
+void TspBrickLoader::readBrick(unsigned int brickIndex, std::vector<float>& data) {
+    const size_t size = static_cast<size_t>(_nBrickValues) * sizeof(float);
+    const size_t offset = static_cast<size_t>(_dataOffset) +
+                          static_cast<size_t>(brickIndex) * size;
+    data.resize(_nBrickValues);
+
+    if (_mappedFile) {
+        if (offset + size > _mappedFile->size()) {
+            LERROR(std::format("Brick {} is outside of the TSP file", brickIndex));
+            std::fill(data.begin(), data.end(), 0.f);
+            return;
+        }
+        std::memcpy(data.data(), _mappedFile->data() + offset, size);
+    }
+    else {
+        _file.seekg(offset);
+        _file.read(reinterpret_cast<char*>(data.data()), size);
+        if (!_file) {
+            LERROR(std::format("Could not read brick {} from the TSP file", brickIndex));
+            std::fill(data.begin(), data.end(), 0.f);
+            _file.clear();
+        }
+    }
+}
+
+} // namespace openspace
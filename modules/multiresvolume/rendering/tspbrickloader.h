@@ -0,0 +1,112 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_MULTIRESVOLUME___TSPBRICKLOADER___H__
+#define __OPENSPACE_MODULE_MULTIRESVOLUME___TSPBRICKLOADER___H__
+
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace openspace {
+
+class MemoryMappedFile;
+
+/**
+ * Reads the bricks of a TSP file on a separate IO thread so that the render loop does
+ * not block on the disk. The bricks that should be read are provided through #request
+ * together with a priority, and the waiting brick with the highest priority is read
+ * first. The TSP file is memory mapped if possible, otherwise it is read through a file
+ * stream that is owned by the IO thread.
+ */
+class TspBrickLoader {
+public:
+    struct Brick {
+        unsigned int index = 0;
+        std::vector<float> data;
+    };
+
+    /**
+     * \param path The path to the TSP file
+     * \param dataOffset The offset in bytes of the first brick in the file
+     * \param nBrickValues The number of values of a single padded brick
+     * \param maxLoadedBricks The maximum number of read bricks that are waiting to be
+     *        picked up by #takeLoaded before the IO thread pauses
+     */
+    TspBrickLoader(std::filesystem::path path, long long dataOffset,
+        unsigned int nBrickValues, size_t maxLoadedBricks);
+    ~TspBrickLoader();
+
+    /**
+     * Replaces all waiting requests with the \p bricks, which are pairs of the brick
+     * index and its priority. Bricks that are currently read or that are waiting to be
+     * picked up are not requested again.
+     */
+    void request(std::vector<std::pair<unsigned int, float>> bricks);
+
+    /**
+     * Returns at most \p maxBricks of the bricks that have been read, in the order in
+     * which they were read.
+     */
+    std::vector<Brick> takeLoaded(size_t maxBricks);
+
+    /// Returns the number of bricks that have been read since the last call
+    unsigned int popNumDiskReads();
+
+    bool isMemoryMapped() const;
+
+private:
+    void work();
+    void readBrick(unsigned int brickIndex, std::vector<float>& data);
+
+    const long long _dataOffset;
+    const unsigned int _nBrickValues;
+    const size_t _maxLoadedBricks;
+
+    std::unique_ptr<MemoryMappedFile> _mappedFile;
+    std::ifstream _file;
+
+    // Sorted by ascending priority so that the next brick is at the back
+    std::vector<std::pair<unsigned int, float>> _requests;
+    std::vector<Brick> _loaded;
+    // The bricks that are currently read or are waiting in _loaded
+    std::set<unsigned int> _inFlight;
+    unsigned int _nDiskReads = 0;
+
+    std::mutex _mutex;
+    /// Signals the IO thread that a request was made or that loaded bricks were taken
+    std::condition_variable _wakeUp;
+    bool _stop = false;
+    std::thread _thread;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_MULTIRESVOLUME___TSPBRICKLOADER___H__
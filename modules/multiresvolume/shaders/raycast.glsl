@@ -36,6 +36,9 @@ uniform ivec3 nBricksInAtlas_#{id};
 uniform ivec3 atlasSize_#{id};
 uniform float stepSizeCoefficient_#{id} = 1.0;
 
+// The value of octree leaves whose brick has not been streamed into the atlas yet
+const uint NotUsedIndex_#{id} = 0xFFFFFFFFu;
+
 
 void atlasMapDataFunction_#{id}(ivec3 brickCoords, inout uint atlasIntCoord,
                                 inout uint level)
@@ -90,6 +93,16 @@ void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
         if (gridType_#{id} == 1) {
             samplePos = multires_cartesianToSpherical(samplePos);
         }
+        ivec3 brickCoords = ivec3(samplePos * maxNumBricksPerAxis_#{id});
+        int linearBrickCoord = multires_intCoord(
+            brickCoords,
+            ivec3(maxNumBricksPerAxis_#{id})
+        );
+        if (atlasMap_#{id}[linearBrickCoord] == NotUsedIndex_#{id}) {
+            maxStepSize = stepSizeCoefficient_#{id}/float(maxNumBricksPerAxis_#{id})/float(paddedBrickDim_#{id});
+            return;
+        }
+
         vec3 sampleCoords = atlasCoordsFunction_#{id}(samplePos);
         //return vec4(sampleCoords, 1.0);
         //sampleCoords = vec3(1.0,0.0, 0.0);
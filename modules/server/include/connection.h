@@ -51,6 +51,17 @@ class Topic;
 // message doesn't go anywhere since noone is listening, but it's better than a crash.
 class Connection : public std::enable_shared_from_this<Connection> {
 public:
+    /**
+     * The encoding of the messages on a connection. All connections start with JSON
+     * text and can switch to MessagePack through the `encoding` topic. As the sockets
+     * transport text, the MessagePack data is sent base64 encoded, which is still much
+     * cheaper to produce and parse than formatted JSON numbers.
+     */
+    enum class Encoding {
+        Json,
+        MessagePack
+    };
+
     Connection(std::unique_ptr<ghoul::io::Socket> s, std::string address,
         bool authorized = false, const std::string& password = "");
 
@@ -62,6 +73,9 @@ public:
 
     bool isAuthorized() const;
 
+    void setEncoding(Encoding encoding);
+    Encoding encoding() const;
+
     ghoul::io::Socket* socket();
     std::thread& thread();
     void setThread(std::thread&& thread);
@@ -74,6 +88,7 @@ private:
 
     std::string _address;
     bool _isAuthorized = false;
+    Encoding _encoding = Encoding::Json;
     std::map<TopicId, std::string> _messageQueue;
     std::map<TopicId, std::chrono::system_clock::time_point> _sentMessages;
 };
@@ -0,0 +1,84 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SERVER___PROPERTYBATCHTOPIC___H__
+#define __OPENSPACE_MODULE_SERVER___PROPERTYBATCHTOPIC___H__
+
+#include <modules/server/include/topics/topic.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace openspace::properties { class Property; }
+
+namespace openspace {
+
+/**
+ * Gets, sets, or subscribes to many properties with a single topic. The properties are
+ * selected by a list of URIs in `properties` and/or by a URI with wildcards in `pattern`.
+ * The `event` is one of:
+ *   - `get`: Sends the values of all selected properties in a single message
+ *   - `set`: Sets the properties named in the `values` object, whose keys are the URIs
+ *   - `start_subscription`: Sends the values of all selected properties and afterwards
+ *     one combined message with the properties that have changed since the last
+ *     message, at most `maxRate` times per second if that is specified
+ *   - `stop_subscription`: Ends the subscription
+ */
+class PropertyBatchTopic : public Topic {
+public:
+    PropertyBatchTopic() = default;
+    ~PropertyBatchTopic() override;
+
+    void handleJson(const nlohmann::json& json) override;
+    bool isDone() const override;
+
+private:
+    struct Subscription {
+        properties::Property* property = nullptr;
+        int onChangeHandle = -1;
+        int onDeleteHandle = -1;
+        bool isDirty = true;
+    };
+
+    std::vector<properties::Property*> selectedProperties(
+        const nlohmann::json& json) const;
+    void subscribe(const nlohmann::json& json);
+    void unsubscribe();
+    void sendChangedValues();
+
+    static constexpr int UnsetCallbackHandle = -1;
+
+    bool _isDone = false;
+    std::vector<Subscription> _subscriptions;
+    int _preSyncHandle = UnsetCallbackHandle;
+
+    std::chrono::steady_clock::duration _minInterval =
+        std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::time_point _lastSendTime;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SERVER___PROPERTYBATCHTOPIC___H__
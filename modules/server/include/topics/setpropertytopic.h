@@ -27,6 +27,8 @@
 
 #include <modules/server/include/topics/topic.h>
 
+#include <string>
+
 namespace openspace {
 
 class SetPropertyTopic : public Topic {
@@ -36,6 +38,12 @@ public:
 
     void handleJson(const nlohmann::json& json) override;
     bool isDone() const override;
+
+    /**
+     * Returns the Lua literal that represents the JSON \p value, which is used to set
+     * property values through scripts.
+     */
+    static std::string luaLiteralFromJson(const nlohmann::json& value);
 };
 
 } // namespace
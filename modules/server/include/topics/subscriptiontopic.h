@@ -27,10 +27,19 @@
 
 #include <modules/server/include/topics/topic.h>
 
+#include <chrono>
+
 namespace openspace::properties { class Property; }
 
 namespace openspace {
 
+/**
+ * Sends the value of a property whenever it changes. Changes are only marked in the
+ * property's callback and sent from the pre-sync step, so that several changes in the
+ * same frame result in a single message. An optional `maxRate` in the subscription sets
+ * the maximum number of messages per second; changes in between are coalesced and the
+ * latest value is sent once the interval has passed.
+ */
 class SubscriptionTopic : public Topic {
 public:
     SubscriptionTopic() = default;
@@ -41,6 +50,7 @@ public:
 
 private:
     void resetCallbacks();
+    void sendValueIfChanged();
 
     const int UnsetCallbackHandle = -1;
 
@@ -48,7 +58,13 @@ private:
     bool _isSubscribedTo = false;
     int _onChangeHandle = UnsetCallbackHandle;
     int _onDeleteHandle = UnsetCallbackHandle;
+    int _preSyncHandle = UnsetCallbackHandle;
     properties::Property* _prop = nullptr;
+
+    bool _isDirty = false;
+    std::chrono::steady_clock::duration _minInterval =
+        std::chrono::steady_clock::duration::zero();
+    std::chrono::steady_clock::time_point _lastSendTime;
 };
 
 } // namespace openspace
@@ -215,22 +215,28 @@ void ServerModule::handleConnection(const std::shared_ptr<Connection>& connectio
     std::string messageString;
     messageString.reserve(256);
     while (connection->socket()->getMessage(messageString)) {
+        Message message = { connection, std::move(messageString) };
+        messageString.clear();
         const std::lock_guard lock(_messageQueueMutex);
-        _messageQueue.push_back({ connection, messageString });
+        _messageQueue.push_back(std::move(message));
     }
 }
 
 void ServerModule::consumeMessages() {
     ZoneScoped;
 
-    const std::lock_guard lock(_messageQueueMutex);
-    while (!_messageQueue.empty()) {
-        const Message& m = _messageQueue.front();
+    // The queued messages are taken out in one step so that the connection threads are
+    // not blocked while the messages are handled, which can take a while for scripts
+    {
+        const std::lock_guard lock(_messageQueueMutex);
+        std::swap(_messageQueue, _consumedMessages);
+    }
+    for (const Message& m : _consumedMessages) {
         if (const std::shared_ptr<Connection>& c = m.connection.lock()) {
             c->handleMessage(m.messageString);
         }
-        _messageQueue.pop_front();
     }
+    _consumedMessages.clear();
 }
 
 ServerModule::CallbackHandle ServerModule::addPreSyncCallback(CallbackFunction cb) {
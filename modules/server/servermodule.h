@@ -81,6 +81,9 @@ private:
 
     std::mutex _messageQueueMutex;
     std::deque<Message> _messageQueue;
+    // The messages that are handled in the current frame. Only accessed from the main
+    // thread
+    std::deque<Message> _consumedMessages;
 
     std::vector<ConnectionData> _connections;
     std::vector<std::unique_ptr<ServerInterface>> _interfaces;
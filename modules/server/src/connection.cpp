@@ -29,6 +29,7 @@
 #include <modules/server/include/topics/camerapathtopic.h>
 #include <modules/server/include/topics/cameratopic.h>
 #include <modules/server/include/topics/documentationtopic.h>
+#include <modules/server/include/topics/encodingtopic.h>
 #include <modules/server/include/topics/enginemodetopic.h>
 #include <modules/server/include/topics/errorlogtopic.h>
 #include <modules/server/include/topics/eventtopic.h>
@@ -36,6 +37,7 @@
 #include <modules/server/include/topics/getpropertytopic.h>
 #include <modules/server/include/topics/luascripttopic.h>
 #include <modules/server/include/topics/missiontopic.h>
+#include <modules/server/include/topics/propertybatchtopic.h>
 #include <modules/server/include/topics/sessionrecordingtopic.h>
 #include <modules/server/include/topics/setpropertytopic.h>
 #include <modules/server/include/topics/shortcuttopic.h>
@@ -53,6 +55,9 @@
 #include <ghoul/io/socket/tcpsocketserver.h>
 #include <ghoul/io/socket/websocketserver.h>
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
 
 namespace {
     constexpr std::string_view _loggerCat = "ServerModule: Connection";
@@ -61,6 +66,52 @@ namespace {
     constexpr std::string_view MessageKeyPayload = "payload";
     constexpr std::string_view MessageKeyTopic = "topic";
 
+    constexpr std::string_view Base64Characters =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string encodeBase64(const std::vector<uint8_t>& data) {
+        std::string result;
+        result.reserve((data.size() + 2) / 3 * 4);
+        for (size_t i = 0; i < data.size(); i += 3) {
+            const size_t n = std::min<size_t>(data.size() - i, 3);
+            uint32_t v = static_cast<uint32_t>(data[i]) << 16;
+            if (n > 1) {
+                v |= static_cast<uint32_t>(data[i + 1]) << 8;
+            }
+            if (n > 2) {
+                v |= static_cast<uint32_t>(data[i + 2]);
+            }
+            result += Base64Characters[(v >> 18) & 0x3F];
+            result += Base64Characters[(v >> 12) & 0x3F];
+            result += n > 1 ? Base64Characters[(v >> 6) & 0x3F] : '=';
+            result += n > 2 ? Base64Characters[v & 0x3F] : '=';
+        }
+        return result;
+    }
+
+    std::vector<uint8_t> decodeBase64(std::string_view text) {
+        std::vector<uint8_t> result;
+        result.reserve(text.size() / 4 * 3);
+        uint32_t v = 0;
+        int nBits = 0;
+        for (const char c : text) {
+            if (c == '=') {
+                break;
+            }
+            const size_t index = Base64Characters.find(c);
+            if (index == std::string_view::npos) {
+                throw std::invalid_argument("Invalid character in base64 message");
+            }
+            v = (v << 6) | static_cast<uint32_t>(index);
+            nBits += 6;
+            if (nBits >= 8) {
+                nBits -= 8;
+                result.push_back(static_cast<uint8_t>((v >> nBits) & 0xFF));
+            }
+        }
+        return result;
+    }
+
 } // namespace
 
 namespace openspace {
@@ -90,6 +141,7 @@ Connection::Connection(std::unique_ptr<ghoul::io::Socket> s, std::string address
     _topicFactory.registerClass<CameraTopic>("camera");
     _topicFactory.registerClass<CameraPathTopic>("cameraPath");
     _topicFactory.registerClass<DocumentationTopic>("documentation");
+    _topicFactory.registerClass<EncodingTopic>("encoding");
     _topicFactory.registerClass<EngineModeTopic>("engineMode");
     _topicFactory.registerClass<ErrorLogTopic>("errorLog");
     _topicFactory.registerClass<EventTopic>("event");
@@ -97,6 +149,7 @@ Connection::Connection(std::unique_ptr<ghoul::io::Socket> s, std::string address
     _topicFactory.registerClass<GetPropertyTopic>("get");
     _topicFactory.registerClass<LuaScriptTopic>("luascript");
     _topicFactory.registerClass<MissionTopic>("missions");
+    _topicFactory.registerClass<PropertyBatchTopic>("propertyBatch");
     _topicFactory.registerClass<SessionRecordingTopic>("sessionRecording");
     _topicFactory.registerClass<SetPropertyTopic>("set");
     _topicFactory.registerClass<ShortcutTopic>("shortcuts");
@@ -111,7 +164,14 @@ void Connection::handleMessage(const std::string& message) {
     ZoneScoped;
 
     try {
-        const nlohmann::json j = nlohmann::json::parse(message.c_str());
+        // JSON messages are accepted with either encoding, so that a client that has
+        // switched to MessagePack can still send hand-written messages
+        const size_t first = message.find_first_not_of(" \t\r\n");
+        const bool isJson = _encoding == Encoding::Json ||
+            (first != std::string::npos && message[first] == '{');
+        const nlohmann::json j = isJson ?
+            nlohmann::json::parse(message.c_str()) :
+            nlohmann::json::from_msgpack(decodeBase64(message));
         try {
             handleJson(j);
         }
@@ -218,7 +278,12 @@ void Connection::sendMessage(const std::string& message) {
 void Connection::sendJson(const nlohmann::json& json) {
     ZoneScoped;
 
-    sendMessage(json.dump());
+    if (_encoding == Encoding::MessagePack) {
+        sendMessage(encodeBase64(nlohmann::json::to_msgpack(json)));
+    }
+    else {
+        sendMessage(json.dump());
+    }
 }
 
 bool Connection::isAuthorized() const {
@@ -241,4 +306,12 @@ void Connection::setAuthorized(bool status) {
     _isAuthorized = status;
 }
 
+void Connection::setEncoding(Encoding encoding) {
+    _encoding = encoding;
+}
+
+Connection::Encoding Connection::encoding() const {
+    return _encoding;
+}
+
 } // namespace openspace
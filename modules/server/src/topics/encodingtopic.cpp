@@ -0,0 +1,70 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/server/include/topics/encodingtopic.h>
+
+#include <modules/server/include/connection.h>
+#include <ghoul/format.h>
+
+namespace {
+    constexpr std::string_view KeyEncoding = "encoding";
+    constexpr std::string_view Json = "json";
+    constexpr std::string_view MessagePack = "messagepack";
+} // namespace
+
+namespace openspace {
+
+void EncodingTopic::handleJson(const nlohmann::json& json) {
+    const auto it = json.find(KeyEncoding);
+    if (it == json.end() || !it->is_string()) {
+        _connection->sendJson(
+            wrappedError("Encoding must be specified as a string", 400)
+        );
+        return;
+    }
+
+    const std::string encoding = it->get<std::string>();
+    Connection::Encoding e;
+    if (encoding == Json) {
+        e = Connection::Encoding::Json;
+    }
+    else if (encoding == MessagePack) {
+        e = Connection::Encoding::MessagePack;
+    }
+    else {
+        _connection->sendJson(
+            wrappedError(std::format("Unknown encoding '{}'", encoding), 400)
+        );
+        return;
+    }
+
+    _connection->sendJson(wrappedPayload({ KeyEncoding, encoding }));
+    _connection->setEncoding(e);
+}
+
+bool EncodingTopic::isDone() const {
+    return true;
+}
+
+} // namespace openspace
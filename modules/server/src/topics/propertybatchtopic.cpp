@@ -0,0 +1,231 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/server/include/topics/propertybatchtopic.h>
+
+#include <modules/server/include/connection.h>
+#include <modules/server/include/jsonconverters.h>
+#include <modules/server/include/topics/setpropertytopic.h>
+#include <modules/server/servermodule.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
+#include <openspace/properties/property.h>
+#include <openspace/query/query.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scripting/scriptengine.h>
+#include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+
+namespace {
+    constexpr std::string_view _loggerCat = "PropertyBatchTopic";
+
+    constexpr std::string_view GetEvent = "get";
+    constexpr std::string_view SetEvent = "set";
+    constexpr std::string_view StartSubscription = "start_subscription";
+    constexpr std::string_view StopSubscription = "stop_subscription";
+} // namespace
+
+using nlohmann::json;
+
+namespace openspace {
+
+PropertyBatchTopic::~PropertyBatchTopic() {
+    unsubscribe();
+}
+
+bool PropertyBatchTopic::isDone() const {
+    return _isDone;
+}
+
+void PropertyBatchTopic::handleJson(const nlohmann::json& json) {
+    ZoneScoped;
+
+    const std::string event = json.at("event").get<std::string>();
+    if (event == GetEvent) {
+        json values = json::object();
+        for (properties::Property* prop : selectedProperties(json)) {
+            values[prop->uri()] = prop;
+        }
+        _connection->sendJson(wrappedPayload({ { "values", std::move(values) } }));
+        _isDone = true;
+    }
+    else if (event == SetEvent) {
+        const auto values = json.find("values");
+        if (values == json.end() || !values->is_object()) {
+            LERROR("Could not set properties -- 'values' must be an object");
+            _isDone = true;
+            return;
+        }
+
+        // All values are set with a single script so that they are applied in the same
+        // frame and only queued once
+        std::string script;
+        for (const auto& [uri, value] : values->items()) {
+            script += std::format(
+                "openspace.setPropertyValueSingle(\"{}\", {});",
+                uri, SetPropertyTopic::luaLiteralFromJson(value)
+            );
+        }
+        if (!script.empty()) {
+            global::scriptEngine->queueScript(script);
+        }
+        _isDone = true;
+    }
+    else if (event == StartSubscription) {
+        subscribe(json);
+    }
+    else if (event == StopSubscription) {
+        unsubscribe();
+        _isDone = true;
+    }
+    else {
+        LERROR(std::format("Unknown event '{}'", event));
+        _isDone = true;
+    }
+}
+
+std::vector<properties::Property*> PropertyBatchTopic::selectedProperties(
+                                                         const nlohmann::json& json) const
+{
+    std::vector<properties::Property*> result;
+
+    const auto uris = json.find("properties");
+    if (uris != json.end() && uris->is_array()) {
+        result.reserve(uris->size());
+        for (const nlohmann::json& uri : *uris) {
+            if (!uri.is_string()) {
+                continue;
+            }
+            const std::string key = uri.get<std::string>();
+            properties::Property* prop = property(key);
+            if (prop) {
+                result.push_back(prop);
+            }
+            else {
+                LWARNING(std::format("Property '{}' not found", key));
+            }
+        }
+    }
+
+    const auto pattern = json.find("pattern");
+    if (pattern != json.end() && pattern->is_string()) {
+        std::vector<properties::Property*> matches =
+            sceneGraph()->propertiesMatchingRegex(pattern->get<std::string>());
+        result.insert(result.end(), matches.begin(), matches.end());
+    }
+
+    // A property might be named explicitly and also match the pattern
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void PropertyBatchTopic::subscribe(const nlohmann::json& json) {
+    unsubscribe();
+
+    const auto maxRate = json.find("maxRate");
+    if (maxRate != json.end() && maxRate->is_number() && maxRate->get<double>() > 0.0)
+    {
+        _minInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / maxRate->get<double>())
+        );
+    }
+
+    const std::vector<properties::Property*> props = selectedProperties(json);
+    if (props.empty()) {
+        _isDone = true;
+        return;
+    }
+
+    // The callbacks refer to the subscriptions by index, so the vector must not be
+    // reallocated after this point
+    _subscriptions.resize(props.size());
+    for (size_t i = 0; i < props.size(); i++) {
+        Subscription& s = _subscriptions[i];
+        s.property = props[i];
+        s.onChangeHandle = s.property->onChange([this, i]() {
+            _subscriptions[i].isDirty = true;
+        });
+        s.onDeleteHandle = s.property->onDelete([this, i]() {
+            _subscriptions[i] = Subscription();
+            _subscriptions[i].isDirty = false;
+        });
+    }
+
+    ServerModule* module = global::moduleEngine->module<ServerModule>();
+    _preSyncHandle = module->addPreSyncCallback([this]() { sendChangedValues(); });
+
+    // Immediately send all values
+    _lastSendTime = std::chrono::steady_clock::time_point();
+    sendChangedValues();
+}
+
+void PropertyBatchTopic::unsubscribe() {
+    for (Subscription& s : _subscriptions) {
+        if (!s.property) {
+            continue;
+        }
+        if (s.onChangeHandle != UnsetCallbackHandle) {
+            s.property->removeOnChange(s.onChangeHandle);
+        }
+        if (s.onDeleteHandle != UnsetCallbackHandle) {
+            s.property->removeOnDelete(s.onDeleteHandle);
+        }
+    }
+    _subscriptions.clear();
+
+    if (_preSyncHandle != UnsetCallbackHandle) {
+        ServerModule* module = global::moduleEngine->module<ServerModule>();
+        if (module) {
+            module->removePreSyncCallback(_preSyncHandle);
+        }
+        _preSyncHandle = UnsetCallbackHandle;
+    }
+}
+
+void PropertyBatchTopic::sendChangedValues() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _lastSendTime < _minInterval) {
+        // The changes are coalesced until the interval has passed
+        return;
+    }
+
+    json values = json::object();
+    for (Subscription& s : _subscriptions) {
+        if (s.property && s.isDirty) {
+            values[s.property->uri()] = s.property;
+            s.isDirty = false;
+        }
+    }
+    if (values.empty()) {
+        return;
+    }
+
+    _connection->sendJson(wrappedPayload({ { "values", std::move(values) } }));
+    _lastSendTime = now;
+}
+
+} // namespace openspace
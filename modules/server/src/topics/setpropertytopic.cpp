@@ -64,50 +64,50 @@ namespace {
 
         return luaString;
     }
+} // namespace
 
-    std::string luaLiteralFromJson(nlohmann::json value) {
-        if (value.is_string()) {
-            return "'" + escapedLuaString(value.get<std::string>()) + "'";
-        }
-        else if (value.is_boolean()) {
-            return value.get<bool>() ? "true" : "false";
-        }
-        else if (value.is_number()) {
-            return std::to_string(value.get<double>());
-        }
-        else if (value.is_array()) {
-            if (value.empty()) {
-                return "{}";
-            }
+namespace openspace {
 
-            std::string literal = "{";
-            for (nlohmann::json::iterator it = value.begin(); it != value.end(); it++) {
-                literal += luaLiteralFromJson(it.value()) += ",";
-            }
-            literal.pop_back(); // remove last comma
-            literal += "}";
-            return literal;
+std::string SetPropertyTopic::luaLiteralFromJson(const nlohmann::json& value) {
+    if (value.is_string()) {
+        return "'" + escapedLuaString(value.get<std::string>()) + "'";
+    }
+    else if (value.is_boolean()) {
+        return value.get<bool>() ? "true" : "false";
+    }
+    else if (value.is_number()) {
+        return std::to_string(value.get<double>());
+    }
+    else if (value.is_array()) {
+        if (value.empty()) {
+            return "{}";
         }
-        else if (value.is_object()) {
-            if (value.empty()) {
-                return "{}";
-            }
 
-            std::string literal = "{";
-            for (nlohmann::json::iterator it = value.begin(); it != value.end(); it++) {
-                literal += it.key() + "=" + luaLiteralFromJson(it.value()) += ",";
-            }
-            literal.pop_back(); // remove last comma
-            literal += "}";
-            return literal;
-        }
-        else {
-            return "nil";
+        std::string literal = "{";
+        for (nlohmann::json::const_iterator it = value.begin(); it != value.end(); it++) {
+            literal += luaLiteralFromJson(it.value()) += ",";
         }
+        literal.pop_back(); // remove last comma
+        literal += "}";
+        return literal;
     }
-} // namespace
+    else if (value.is_object()) {
+        if (value.empty()) {
+            return "{}";
+        }
 
-namespace openspace {
+        std::string literal = "{";
+        for (nlohmann::json::const_iterator it = value.begin(); it != value.end(); it++) {
+            literal += it.key() + "=" + luaLiteralFromJson(it.value()) += ",";
+        }
+        literal.pop_back(); // remove last comma
+        literal += "}";
+        return literal;
+    }
+    else {
+        return "nil";
+    }
+}
 
 void SetPropertyTopic::handleJson(const nlohmann::json& json) {
     try {
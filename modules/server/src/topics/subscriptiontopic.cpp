@@ -26,6 +26,9 @@
 
 #include <modules/server/include/connection.h>
 #include <modules/server/include/jsonconverters.h>
+#include <modules/server/servermodule.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
 #include <openspace/properties/property.h>
 #include <openspace/query/query.h>
 #include <openspace/util/timemanager.h>
@@ -45,6 +48,13 @@ namespace openspace {
 
 SubscriptionTopic::~SubscriptionTopic() {
     resetCallbacks();
+
+    if (_preSyncHandle != UnsetCallbackHandle) {
+        ServerModule* module = global::moduleEngine->module<ServerModule>();
+        if (module) {
+            module->removePreSyncCallback(_preSyncHandle);
+        }
+    }
 }
 
 bool SubscriptionTopic::isDone() const {
@@ -65,6 +75,22 @@ void SubscriptionTopic::resetCallbacks() {
     }
 }
 
+void SubscriptionTopic::sendValueIfChanged() {
+    if (!_isDirty || !_isSubscribedTo || !_prop) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _lastSendTime < _minInterval) {
+        // The latest value is sent once the interval has passed
+        return;
+    }
+
+    _connection->sendJson(wrappedPayload(_prop));
+    _isDirty = false;
+    _lastSendTime = now;
+}
+
 void SubscriptionTopic::handleJson(const nlohmann::json& json) {
     const std::string& event = json.at("event").get<std::string>();
 
@@ -77,19 +103,34 @@ void SubscriptionTopic::handleJson(const nlohmann::json& json) {
         if (_prop) {
             _requestedResourceIsSubscribable = true;
             _isSubscribedTo = true;
-            auto onChange = [this, k = std::move(key)]() {
-                _connection->sendJson(wrappedPayload(_prop));
-            };
 
-            _onChangeHandle = _prop->onChange(onChange);
+            const auto maxRate = json.find("maxRate");
+            if (maxRate != json.end() && maxRate->is_number() &&
+                maxRate->get<double>() > 0.0)
+            {
+                _minInterval = std::chrono::duration_cast<
+                    std::chrono::steady_clock::duration
+                >(std::chrono::duration<double>(1.0 / maxRate->get<double>()));
+            }
+
+            _onChangeHandle = _prop->onChange([this]() { _isDirty = true; });
             _onDeleteHandle = _prop->onDelete([this]() {
                 _onChangeHandle = UnsetCallbackHandle;
                 _onDeleteHandle = UnsetCallbackHandle;
                 _isSubscribedTo = false;
             });
 
+            if (_preSyncHandle == UnsetCallbackHandle) {
+                ServerModule* module = global::moduleEngine->module<ServerModule>();
+                _preSyncHandle = module->addPreSyncCallback(
+                    [this]() { sendValueIfChanged(); }
+                );
+            }
+
             // immediately send the value
-            onChange();
+            _isDirty = true;
+            _lastSendTime = std::chrono::steady_clock::time_point();
+            sendValueIfChanged();
         }
         else {
             LWARNING(std::format("Could not subscribe. Property '{}' not found", key));
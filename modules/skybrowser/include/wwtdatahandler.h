@@ -26,8 +26,10 @@
 #define __OPENSPACE_MODULE_SKYBROWSER___WWTDATAHANDLER___H__
 
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace tinyxml2 { class XMLElement; }
 
@@ -56,11 +58,21 @@ public:
     std::optional<const ImageData> image(const std::string& imageUrl) const;
     const std::map<std::string, ImageData>& images() const;
 
+    /**
+     * Returns all images with celestial coordinates that are within \p radius degrees of
+     * the \p equatorial coordinates (right ascension and declination in degrees).
+     */
+    std::vector<const ImageData*> imagesNear(const glm::dvec2& equatorial,
+        double radius) const;
+
 private:
-    void saveImagesFromXml(const tinyxml2::XMLElement* root, std::string collection);
+    void saveImagesFromXml(const tinyxml2::XMLElement* root, std::string collection,
+        std::map<std::string, ImageData>& images);
 
     // Images
     std::map<std::string, ImageData> _images;
+    // The images in _images that have celestial coordinates, ordered by declination
+    std::vector<const ImageData*> _declinationIndex;
 };
 } // namespace openspace
 
@@ -140,7 +140,7 @@ ScreenSpaceSkyBrowser::ScreenSpaceSkyBrowser(const ghoul::Dictionary& dictionary
     , _isPointingSpacecraft(PointSpacecraftInfo, false)
     , _updateDuringTargetAnimation(UpdateDuringAnimationInfo, false)
 {
-    _identifier = makeUniqueIdentifier(_identifier);
+    setIdentifier(makeUniqueIdentifier(_identifier));
 
     // Handle target dimension property
     const Parameters p = codegen::bake<Parameters>(dictionary);
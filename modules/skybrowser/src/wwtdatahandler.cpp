@@ -27,6 +27,9 @@
 #include <modules/skybrowser/include/utility.h>
 #include <openspace/util/httprequest.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <array>
+#include <fstream>
 #include <string_view>
 #include <tinyxml2.h>
 
@@ -49,6 +52,11 @@ namespace {
     constexpr std::string_view DataSetType = "DataSetType";
     constexpr std::string_view Sky = "Sky";
 
+    // The binary cache of the parsed images that is stored next to the XML files
+    constexpr std::string_view CacheFile = "images.cache";
+    constexpr std::array<char, 4> CacheMagic = { 'W', 'W', 'T', 'C' };
+    constexpr uint8_t CacheVersion = 1;
+
     bool hasAttribute(const tinyxml2::XMLElement* element, std::string_view name) {
         const std::string n = std::string(name);
         return element->FindAttribute(n.c_str());
@@ -247,6 +255,132 @@ namespace {
             ""
         };
     }
+
+    // Combines the names and contents of all XML files in the directory, so that the
+    // cache is invalidated if any of the files is downloaded again with new content
+    uint64_t xmlFilesHash(const std::filesystem::path& directory) {
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.is_regular_file() && entry.path().filename() != CacheFile) {
+                files.push_back(entry.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        uint64_t hash = 0;
+        for (const std::filesystem::path& file : files) {
+            std::ifstream stream = std::ifstream(file, std::ifstream::binary);
+            const std::string content = std::string(
+                std::istreambuf_iterator<char>(stream),
+                std::istreambuf_iterator<char>()
+            );
+            const uint64_t h = std::hash<std::string>{}(
+                file.filename().string() + '\0' + content
+            );
+            // Same combination as boost::hash_combine
+            hash ^= h + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+
+    void writeString(std::ofstream& stream, const std::string& value) {
+        const uint32_t size = static_cast<uint32_t>(value.size());
+        stream.write(reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+        stream.write(value.data(), size);
+    }
+
+    std::string readString(std::ifstream& stream) {
+        uint32_t size = 0;
+        stream.read(reinterpret_cast<char*>(&size), sizeof(uint32_t));
+        std::string value = std::string(size, '\0');
+        stream.read(value.data(), size);
+        return value;
+    }
+
+    void saveImageCache(const std::filesystem::path& path, uint64_t hash,
+                        const std::map<std::string, openspace::ImageData>& images)
+    {
+        std::ofstream stream = std::ofstream(path, std::ofstream::binary);
+        stream.write(CacheMagic.data(), CacheMagic.size());
+        stream.write(reinterpret_cast<const char*>(&CacheVersion), sizeof(uint8_t));
+        stream.write(reinterpret_cast<const char*>(&hash), sizeof(uint64_t));
+        const uint32_t nImages = static_cast<uint32_t>(images.size());
+        stream.write(reinterpret_cast<const char*>(&nImages), sizeof(uint32_t));
+
+        // The images are written in the order of the map, which means that they can be
+        // inserted at the end of the map again when loading without any lookups
+        for (const auto& [url, image] : images) {
+            writeString(stream, image.name);
+            writeString(stream, image.thumbnailUrl);
+            writeString(stream, image.imageUrl);
+            writeString(stream, image.credits);
+            writeString(stream, image.creditsUrl);
+            writeString(stream, image.collection);
+            const uint8_t hasCoords = image.hasCelestialCoords ? 1 : 0;
+            stream.write(reinterpret_cast<const char*>(&hasCoords), sizeof(uint8_t));
+            stream.write(reinterpret_cast<const char*>(&image.fov), sizeof(float));
+            stream.write(
+                reinterpret_cast<const char*>(&image.equatorialSpherical),
+                sizeof(glm::dvec2)
+            );
+        }
+    }
+
+    bool loadImageCache(const std::filesystem::path& path, uint64_t hash,
+                        std::map<std::string, openspace::ImageData>& images)
+    {
+        using namespace openspace;
+
+        std::ifstream stream = std::ifstream(path, std::ifstream::binary);
+        if (!stream.good()) {
+            return false;
+        }
+
+        std::array<char, 4> magic = {};
+        stream.read(magic.data(), magic.size());
+        uint8_t version = 0;
+        stream.read(reinterpret_cast<char*>(&version), sizeof(uint8_t));
+        uint64_t cachedHash = 0;
+        stream.read(reinterpret_cast<char*>(&cachedHash), sizeof(uint64_t));
+        if (!stream.good() || magic != CacheMagic || version != CacheVersion ||
+            cachedHash != hash)
+        {
+            return false;
+        }
+
+        uint32_t nImages = 0;
+        stream.read(reinterpret_cast<char*>(&nImages), sizeof(uint32_t));
+        for (uint32_t i = 0; i < nImages && stream.good(); i++) {
+            ImageData image;
+            image.name = readString(stream);
+            image.thumbnailUrl = readString(stream);
+            image.imageUrl = readString(stream);
+            image.credits = readString(stream);
+            image.creditsUrl = readString(stream);
+            image.collection = readString(stream);
+            uint8_t hasCoords = 0;
+            stream.read(reinterpret_cast<char*>(&hasCoords), sizeof(uint8_t));
+            image.hasCelestialCoords = hasCoords == 1;
+            stream.read(reinterpret_cast<char*>(&image.fov), sizeof(float));
+            stream.read(
+                reinterpret_cast<char*>(&image.equatorialSpherical),
+                sizeof(glm::dvec2)
+            );
+            if (image.hasCelestialCoords) {
+                image.equatorialCartesian =
+                    skybrowser::sphericalToCartesian(image.equatorialSpherical);
+            }
+
+            std::string url = image.imageUrl;
+            images.emplace_hint(images.end(), std::move(url), std::move(image));
+        }
+
+        if (!stream.good()) {
+            images.clear();
+            return false;
+        }
+        return true;
+    }
 } //namespace
 
 namespace openspace {
@@ -311,19 +445,34 @@ void WwtDataHandler::loadImages(const std::string& root,
         std::ofstream(localHashFile) << remoteHash;
     }
 
-    // Finally, we can load the files that are now on disk
-    LINFO("Loading images from directory");
-    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
-        tinyxml2::XMLDocument document;
-        const std::string path = entry.path().string();
-        const tinyxml2::XMLError successCode = document.LoadFile(path.c_str());
-
-        if (successCode == tinyxml2::XMLError::XML_SUCCESS) {
-            tinyxml2::XMLElement* rootNode = document.FirstChildElement();
-            const std::string collectionName = attribute(rootNode, Name);
-            saveImagesFromXml(rootNode, collectionName);
+    // Finally, we can load the files that are now on disk. If the files have not changed
+    // since the last time they were parsed, the images are read from the binary cache
+    const std::filesystem::path cacheFile = directory / CacheFile;
+    const uint64_t hash = xmlFilesHash(directory);
+    std::map<std::string, ImageData> images;
+    if (loadImageCache(cacheFile, hash, images)) {
+        LINFO("Loading images from cache");
+    }
+    else {
+        LINFO("Loading images from directory");
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.path().filename() == CacheFile) {
+                continue;
+            }
+
+            tinyxml2::XMLDocument document;
+            const std::string path = entry.path().string();
+            const tinyxml2::XMLError successCode = document.LoadFile(path.c_str());
+
+            if (successCode == tinyxml2::XMLError::XML_SUCCESS) {
+                tinyxml2::XMLElement* rootNode = document.FirstChildElement();
+                const std::string collectionName = attribute(rootNode, Name);
+                saveImagesFromXml(rootNode, collectionName, images);
+            }
         }
+        saveImageCache(cacheFile, hash, images);
     }
+    _images.merge(images);
     // Sort images. Copy images to vector
     std::vector<ImageData> imageVector;
     imageVector.reserve(_images.size());
@@ -341,6 +490,21 @@ void WwtDataHandler::loadImages(const std::string& root,
         _images[imageVector[i].imageUrl].identifier = std::to_string(i);
     }
 
+    // Order all images with coordinates by their declination for spatial queries
+    _declinationIndex.clear();
+    for (const auto& [url, img] : _images) {
+        if (img.hasCelestialCoords) {
+            _declinationIndex.push_back(&img);
+        }
+    }
+    std::sort(
+        _declinationIndex.begin(),
+        _declinationIndex.end(),
+        [](const ImageData* lhs, const ImageData* rhs) {
+            return lhs->equatorialSpherical.y < rhs->equatorialSpherical.y;
+        }
+    );
+
     LINFO(std::format("Loaded {} WorldWide Telescope images", _images.size()));
 }
 
@@ -360,8 +524,41 @@ const std::map<std::string, ImageData>& WwtDataHandler::images() const {
     return _images;
 }
 
+std::vector<const ImageData*> WwtDataHandler::imagesNear(const glm::dvec2& equatorial,
+                                                         double radius) const
+{
+    // Only the images within the declination band can be within the radius, which are
+    // found by a binary search in the declination-ordered index
+    const double minDec = equatorial.y - radius;
+    const double maxDec = equatorial.y + radius;
+    auto begin = std::lower_bound(
+        _declinationIndex.begin(),
+        _declinationIndex.end(),
+        minDec,
+        [](const ImageData* img, double dec) { return img->equatorialSpherical.y < dec; }
+    );
+    auto end = std::upper_bound(
+        begin,
+        _declinationIndex.end(),
+        maxDec,
+        [](double dec, const ImageData* img) { return dec < img->equatorialSpherical.y; }
+    );
+
+    const glm::dvec3 target = skybrowser::sphericalToCartesian(equatorial);
+    const double minCosAngle = std::cos(glm::radians(radius));
+
+    std::vector<const ImageData*> result;
+    for (auto it = begin; it != end; it++) {
+        if (glm::dot((*it)->equatorialCartesian, target) >= minCosAngle) {
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
 void WwtDataHandler::saveImagesFromXml(const tinyxml2::XMLElement* root,
-                                       std::string collection)
+                                       std::string collection,
+                                       std::map<std::string, ImageData>& images)
 {
     // Get direct child of node called Place
     const tinyxml2::XMLElement* node = root->FirstChildElement();
@@ -376,7 +573,7 @@ void WwtDataHandler::saveImagesFromXml(const tinyxml2::XMLElement* root,
                 node, collection
             );
             if (image.has_value()) {
-                _images.insert({ image.value().imageUrl, std::move(*image) });
+                images.insert({ image.value().imageUrl, std::move(*image) });
             }
 
         }
@@ -386,7 +583,7 @@ void WwtDataHandler::saveImagesFromXml(const tinyxml2::XMLElement* root,
             const std::string newCollectionName = std::format(
                 "{}/{}", collection, nodeName
             );
-            saveImagesFromXml(node, newCollectionName);
+            saveImagesFromXml(node, newCollectionName, images);
         }
         node = node->NextSiblingElement();
     }
@@ -29,13 +29,20 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/stringhelper.h>
 #include <scn/scan.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
 #include <fstream>
+#include <future>
 #include <optional>
 #include <sstream>
+#include <string_view>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "Kepler";
-    constexpr int8_t CurrentCacheVersion = 1;
+    constexpr int8_t CurrentCacheVersion = 2;
 
     // The list of leap years only goes until 2056 as we need to touch this file then
     // again anyway ;)
@@ -239,6 +246,25 @@ namespace {
         return nSecondsSince2000 - nLeapSecondsOffset - nSecondsEpochOffset;
     }
 
+    double bstarFromSubstring(const std::string& bstar) {
+        // The BSTAR term is in the form:
+        // SMMMMMSE
+        // With S being the sign of the mantissa, MMMMM the digits of the mantissa with an
+        // assumed leading decimal point, and SE the signed exponent of base 10. For
+        // example " 12345-3" is 0.12345e-3
+        if (bstar.size() < 8) {
+            throw ghoul::RuntimeError(std::format("Error parsing BSTAR '{}'", bstar));
+        }
+        const std::string mantissa = std::format("{}0.{}", bstar[0], bstar.substr(1, 5));
+        const std::string exponent = bstar.substr(6, 2);
+        try {
+            return std::stod(mantissa) * std::pow(10.0, std::stoi(exponent));
+        }
+        catch (const std::logic_error&) {
+            throw ghoul::RuntimeError(std::format("Error parsing BSTAR '{}'", bstar));
+        }
+    }
+
     double epochFromYMDdSubstring(const std::string& epoch) {
         // The epochString can be in one of two forms:
         // YYYYMMDD.ddddddd
@@ -392,6 +418,72 @@ namespace {
         return
             nSecondsSince2000 + totalSeconds + nLeapSecondsOffset - offset + date.seconds;
     }
+
+    // Reads all lines of the provided file into memory so that they can be parsed in
+    // parallel afterwards
+    std::vector<std::string> readLines(const std::filesystem::path& file) {
+        std::ifstream f;
+        f.open(file);
+
+        std::vector<std::string> lines;
+        std::string line;
+        while (ghoul::getline(f, line)) {
+            lines.push_back(std::move(line));
+        }
+        return lines;
+    }
+
+    // Calls `parseRecord` for each index in [0, nRecords) and returns the results in
+    // order. Larger files are split into blocks of records that are parsed concurrently
+    // on all available hardware threads. Exceptions thrown while parsing a record are
+    // rethrown on the calling thread
+    template <typename Func>
+    std::vector<openspace::kepler::Parameters> parseRecords(size_t nRecords,
+                                                            Func parseRecord)
+    {
+        constexpr size_t BlockSize = 1024;
+
+        std::vector<openspace::kepler::Parameters> result(nRecords);
+
+        const size_t nBlocks = (nRecords + BlockSize - 1) / BlockSize;
+        const size_t nThreads = std::min<size_t>(
+            nBlocks,
+            std::max(std::thread::hardware_concurrency(), 1u)
+        );
+        if (nThreads <= 1) {
+            for (size_t i = 0; i < nRecords; i++) {
+                result[i] = parseRecord(i);
+            }
+            return result;
+        }
+
+        std::atomic<size_t> nextBlock = 0;
+        std::atomic_bool hasFailed = false;
+        auto work = [&]() {
+            for (size_t b = nextBlock++; b < nBlocks && !hasFailed; b = nextBlock++) {
+                const size_t end = std::min((b + 1) * BlockSize, nRecords);
+                try {
+                    for (size_t i = b * BlockSize; i < end; i++) {
+                        result[i] = parseRecord(i);
+                    }
+                }
+                catch (...) {
+                    hasFailed = true;
+                    throw;
+                }
+            }
+        };
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(nThreads);
+        for (size_t i = 0; i < nThreads; i++) {
+            futures.push_back(std::async(std::launch::async, work));
+        }
+        for (std::future<void>& f : futures) {
+            f.get();
+        }
+        return result;
+    }
 } // namespace
 
 namespace openspace::kepler {
@@ -399,19 +491,24 @@ namespace openspace::kepler {
 std::vector<Parameters> readTleFile(const std::filesystem::path& file) {
     ghoul_assert(std::filesystem::is_regular_file(file), "File must exist");
 
-    std::vector<Parameters> result;
+    const std::vector<std::string> lines = readLines(file);
 
-    std::ifstream f;
-    f.open(file);
+    // Each object is described by a header line followed by two lines of data
+    constexpr size_t LinesPerRecord = 3;
+    if (lines.size() % LinesPerRecord != 0) {
+        throw ghoul::RuntimeError(std::format(
+            "Malformed TLE file '{}' at line {}",
+            file, lines.size() - lines.size() % LinesPerRecord + 2
+        ));
+    }
 
-    int lineNum = 1;
+    auto parseRecord = [&file, &lines](size_t record) {
+        const size_t firstLineIdx = record * LinesPerRecord;
 
-    std::string header;
-    while (ghoul::getline(f, header)) {
         Parameters p;
 
         // Header
-        p.name = header;
+        p.name = lines[firstLineIdx];
 
         // First line
         // Field Columns   Content
@@ -429,11 +526,10 @@ std::vector<Parameters> readTleFile(const std::filesystem::path& file) {
         //    12   63-63   The "Ephemeris type"
         //    13   65-68   Element set  number.Incremented when a new TLE is generated
         //    14   69-69   Checksum (modulo 10)
-        std::string firstLine;
-        ghoul::getline(f, firstLine);
-        if (f.bad() || firstLine[0] != '1') {
+        const std::string& firstLine = lines[firstLineIdx + 1];
+        if (firstLine.empty() || firstLine[0] != '1') {
             throw ghoul::RuntimeError(std::format(
-                "Malformed TLE file '{}' at line {}", file, lineNum + 1
+                "Malformed TLE file '{}' at line {}", file, firstLineIdx + 2
             ));
         }
         // The id only contains the last two digits of the launch year, so we have to
@@ -447,6 +543,7 @@ std::vector<Parameters> readTleFile(const std::filesystem::path& file) {
             p.id = std::format("{}{}-{}", prefix, id.substr(0, 2), id.substr(3));
         }
         p.epoch = epochFromSubstring(firstLine.substr(18, 14)); // should be 13?
+        p.bstar = bstarFromSubstring(firstLine.substr(53, 8));
 
 
         // Second line
@@ -461,11 +558,10 @@ std::vector<Parameters> readTleFile(const std::filesystem::path& file) {
         //     8      53-63   Mean Motion (revolutions per day)
         //     9      64-68   Revolution number at epoch (revolutions)
         //    10      69-69   Checksum (modulo 10)
-        std::string secondLine;
-        ghoul::getline(f, secondLine);
-        if (f.bad() || secondLine[0] != '2') {
+        const std::string& secondLine = lines[firstLineIdx + 2];
+        if (secondLine.empty() || secondLine[0] != '2') {
             throw ghoul::RuntimeError(std::format(
-                "Malformed TLE file '{}' at line {}", file, lineNum + 1
+                "Malformed TLE file '{}' at line {}", file, firstLineIdx + 3
             ));
         }
 
@@ -499,110 +595,120 @@ std::vector<Parameters> readTleFile(const std::filesystem::path& file) {
 
         // Get mean motion
         stream.str(secondLine.substr(52, 11));
-        float meanMotion = 0.f;
+        double meanMotion = 0.0;
         stream >> meanMotion;
 
         p.semiMajorAxis = calculateSemiMajorAxis(meanMotion);
         p.period = std::chrono::seconds(std::chrono::hours(24)).count() / meanMotion;
 
-        result.push_back(p);
-
-        lineNum = lineNum + 3;
-    }
+        return p;
+    };
 
-    return result;
+    return parseRecords(lines.size() / LinesPerRecord, parseRecord);
 }
 
 std::vector<Parameters> readOmmFile(const std::filesystem::path& file) {
     ghoul_assert(std::filesystem::is_regular_file(file), "File must exist");
 
-    std::vector<Parameters> result;
-
-    std::ifstream f;
-    f.open(file);
+    const std::vector<std::string> lines = readLines(file);
 
-    int lineNum = 1;
-    std::optional<Parameters> current = std::nullopt;
-    std::string line;
-    while (ghoul::getline(f, line)) {
-        if (line.empty() || line == "\r") {
-            continue;
+    // Every object starts with a version line, so we first find the beginning of every
+    // record so that they can then be parsed independently of each other
+    std::vector<size_t> recordStarts;
+    for (size_t i = 0; i < lines.size(); i++) {
+        std::string_view key = std::string_view(lines[i]).substr(0, lines[i].find('='));
+        while (!key.empty() && std::isspace(static_cast<unsigned char>(key.back()))) {
+            key.remove_suffix(1);
         }
-
-        // Tokenize the line
-        std::vector<std::string> parts = ghoul::tokenizeString(line, '=');
-        for (std::string& p : parts) {
-            ghoul::trimWhitespace(p);
+        while (!key.empty() && std::isspace(static_cast<unsigned char>(key.front()))) {
+            key.remove_prefix(1);
         }
 
-        if (parts.size() != 2) {
+        if (key == "CCSDS_OMM_VERS") {
+            recordStarts.push_back(i);
+        }
+        else if (recordStarts.empty() && !key.empty()) {
             throw ghoul::RuntimeError(std::format(
-                "Malformed line '{}' at {}", line, lineNum
+                "Malformed OMM file '{}', expected 'CCSDS_OMM_VERS' before line {}",
+                file, i + 1
             ));
         }
-
-        if (parts[0] == "CCSDS_OMM_VERS") {
-            if (parts[1] != "2.0") {
-                LWARNINGC(
-                    "OMM",
-                    std::format(
-                        "Only version 2.0 is currently supported but found {}. "
-                        "Parsing might fail",
-                        parts[1]
-                    )
-                );
+    }
+    recordStarts.push_back(lines.size());
+
+    auto parseRecord = [&lines, &recordStarts](size_t record) {
+        Parameters current;
+        for (size_t i = recordStarts[record]; i < recordStarts[record + 1]; i++) {
+            const std::string& line = lines[i];
+            if (line.empty() || line == "\r") {
+                continue;
             }
 
-            // We start a new value so we need to store the last one...
-            if (current.has_value()) {
-                result.push_back(*current);
+            // Tokenize the line
+            std::vector<std::string> parts = ghoul::tokenizeString(line, '=');
+            for (std::string& p : parts) {
+                ghoul::trimWhitespace(p);
             }
 
-            // ... and start a new one
-            current = Parameters();
-        }
-
-        ghoul_assert(current.has_value(), "No current element");
+            if (parts.size() != 2) {
+                throw ghoul::RuntimeError(std::format(
+                    "Malformed line '{}' at {}", line, i + 1
+                ));
+            }
 
-        if (parts[0] == "OBJECT_NAME") {
-            current->name = parts[1];
-        }
-        else if (parts[0] == "OBJECT_ID") {
-            current->id = parts[1];
-        }
-        else if (parts[0] == "EPOCH") {
-            current->epoch = epochFromOmmString(parts[1]);
-        }
-        else if (parts[0] == "MEAN_MOTION") {
-            const float mm = std::stof(parts[1]);
-            current->semiMajorAxis = calculateSemiMajorAxis(mm);
-            current->period = std::chrono::seconds(std::chrono::hours(24)).count() / mm;
-        }
-        else if (parts[0] == "SEMI_MAJOR_AXIS") {
+            if (parts[0] == "CCSDS_OMM_VERS") {
+                if (parts[1] != "2.0") {
+                    LWARNINGC(
+                        "OMM",
+                        std::format(
+                            "Only version 2.0 is currently supported but found {}. "
+                            "Parsing might fail",
+                            parts[1]
+                        )
+                    );
+                }
+            }
+            else if (parts[0] == "OBJECT_NAME") {
+                current.name = parts[1];
+            }
+            else if (parts[0] == "OBJECT_ID") {
+                current.id = parts[1];
+            }
+            else if (parts[0] == "EPOCH") {
+                current.epoch = epochFromOmmString(parts[1]);
+            }
+            else if (parts[0] == "MEAN_MOTION") {
+                const double mm = std::stod(parts[1]);
+                current.semiMajorAxis = calculateSemiMajorAxis(mm);
+                current.period =
+                    std::chrono::seconds(std::chrono::hours(24)).count() / mm;
+            }
+            else if (parts[0] == "BSTAR") {
+                current.bstar = std::stod(parts[1]);
+            }
+            else if (parts[0] == "SEMI_MAJOR_AXIS") {
 
+            }
+            else if (parts[0] == "ECCENTRICITY") {
+                current.eccentricity = std::stof(parts[1]);
+            }
+            else if (parts[0] == "INCLINATION") {
+                current.inclination = std::stof(parts[1]);
+            }
+            else if (parts[0] == "RA_OF_ASC_NODE") {
+                current.ascendingNode = std::stof(parts[1]);
+            }
+            else if (parts[0] == "ARG_OF_PERICENTER") {
+                current.argumentOfPeriapsis = std::stof(parts[1]);
+            }
+            else if (parts[0] == "MEAN_ANOMALY") {
+                current.meanAnomaly = std::stof(parts[1]);
+            }
         }
-        else if (parts[0] == "ECCENTRICITY") {
-            current->eccentricity = std::stof(parts[1]);
-        }
-        else if (parts[0] == "INCLINATION") {
-            current->inclination = std::stof(parts[1]);
-        }
-        else if (parts[0] == "RA_OF_ASC_NODE") {
-            current->ascendingNode = std::stof(parts[1]);
-        }
-        else if (parts[0] == "ARG_OF_PERICENTER") {
-            current->argumentOfPeriapsis = std::stof(parts[1]);
-        }
-        else if (parts[0] == "MEAN_ANOMALY") {
-            current->meanAnomaly = std::stof(parts[1]);
-        }
-    }
-
-    if (current.has_value()) {
-        result.push_back(*current);
-    }
+        return current;
+    };
 
-    return result;
+    return parseRecords(recordStarts.size() - 1, parseRecord);
 }
 
 std::vector<Parameters> readSbdbFile(const std::filesystem::path& file) {
@@ -611,24 +717,24 @@ std::vector<Parameters> readSbdbFile(const std::filesystem::path& file) {
 
     ghoul_assert(std::filesystem::is_regular_file(file), "File must exist");
 
-    std::ifstream f;
-    f.open(file);
+    std::vector<std::string> lines = readLines(file);
 
-    std::string line;
-    ghoul::getline(f, line);
+    std::string header = lines.empty() ? "" : lines.front();
     // Newer versions downloaded from the JPL SBDB website have " around variables
-    line.erase(remove(line.begin(), line.end(), '\"'), line.end());
-    if (line != ExpectedHeader) {
+    header.erase(remove(header.begin(), header.end(), '\"'), header.end());
+    if (header != ExpectedHeader) {
         throw ghoul::RuntimeError(std::format(
             "Expected JPL SBDB file to start with '{}' but found '{}' instead",
-            ExpectedHeader, line.substr(0, 100)
+            ExpectedHeader, header.substr(0, 100)
         ));
     }
 
-    std::vector<Parameters> result;
-    while (ghoul::getline(f, line)) {
+    auto parseRecord = [&lines](size_t record) {
         constexpr double AuToKm = 1.496e8;
 
+        // The first line is the header
+        const std::string& line = lines[record + 1];
+
         std::vector<std::string> parts = ghoul::tokenizeString(line, ',');
         if (parts.size() != NDataFields) {
             throw ghoul::RuntimeError(std::format(
@@ -664,9 +770,10 @@ std::vector<Parameters> readSbdbFile(const std::filesystem::path& file) {
         p.period =
             std::stod(parts[8]) * std::chrono::seconds(std::chrono::hours(24)).count();
 
-        result.push_back(std::move(p));
-    }
-    return result;
+        return p;
+    };
+
+    return parseRecords(lines.empty() ? 0 : lines.size() - 1, parseRecord);
 }
 
 void saveCache(const std::vector<Parameters>& params, const std::filesystem::path& file) {
@@ -696,6 +803,7 @@ void saveCache(const std::vector<Parameters>& params, const std::filesystem::pat
         stream.write(reinterpret_cast<const char*>(&param.meanAnomaly), sizeof(double));
         stream.write(reinterpret_cast<const char*>(&param.epoch), sizeof(double));
         stream.write(reinterpret_cast<const char*>(&param.period), sizeof(double));
+        stream.write(reinterpret_cast<const char*>(&param.bstar), sizeof(double));
     }
 }
 
@@ -734,6 +842,7 @@ std::optional<std::vector<Parameters>> loadCache(const std::filesystem::path& fi
         stream.read(reinterpret_cast<char*>(&param.meanAnomaly), sizeof(double));
         stream.read(reinterpret_cast<char*>(&param.epoch), sizeof(double));
         stream.read(reinterpret_cast<char*>(&param.period), sizeof(double));
+        stream.read(reinterpret_cast<char*>(&param.bstar), sizeof(double));
 
         res.push_back(std::move(param));
     }
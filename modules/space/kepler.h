@@ -46,6 +46,10 @@ struct Parameters {
     double meanAnomaly = 0.0;
     double epoch = 0.0;
     double period = 0.0;
+
+    /// The drag term of general perturbation element sets in units of inverse Earth
+    /// radii. This value is 0 for element sets that were not loaded from a TLE or OMM
+    double bstar = 0.0;
 };
 
 /**
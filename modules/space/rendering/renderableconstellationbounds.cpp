@@ -32,6 +32,7 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/stringhelper.h>
 #include <ghoul/opengl/programobject.h>
+#include <cstddef>
 #include <fstream>
 #include <optional>
 #include "SpiceUsr.h"
@@ -144,21 +145,53 @@ void RenderableConstellationBounds::initializeGL() {
 
     glGenBuffers(1, &_vbo);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+
+    // in_position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+
+    // in_constellation
+    glEnableVertexAttribArray(1);
+    glVertexAttribIPointer(
+        1,
+        1,
+        GL_UNSIGNED_INT,
+        sizeof(Vertex),
+        reinterpret_cast<GLvoid*>(offsetof(Vertex, constellation))
+    );
+
+    glBindVertexArray(0);
+
+    initializeVisibilityBuffer();
+    createVertexBuffer();
+}
+
+void RenderableConstellationBounds::createVertexBuffer() {
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vertexValues.size() * 3 * sizeof(float),
+        _vertexValues.size() * sizeof(Vertex),
         _vertexValues.data(),
         GL_STATIC_DRAW
     );
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    const GLint positionAttrib = _program->attributeLocation("in_position");
-    glEnableVertexAttribArray(positionAttrib);
-    glVertexAttribPointer(positionAttrib, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    _drawFirst.clear();
+    _drawCount.clear();
+    for (const ConstellationBound& bound : _constellationBounds) {
+        _drawFirst.push_back(bound.startIndex);
+        _drawCount.push_back(bound.nVertices);
+    }
 
-    glBindVertexArray(0);
+    _dataIsDirty = false;
 }
 
 void RenderableConstellationBounds::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
+    deinitializeVisibilityBuffer();
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
     glDeleteVertexArrays(1, &_vao);
@@ -195,25 +228,38 @@ void RenderableConstellationBounds::render(const RenderData& data, RendererTasks
     _program->setUniform("color", _color);
     _program->setUniform("opacity", opacity());
 
+    bindVisibilityBuffer(*_program);
+
     glLineWidth(_lineWidth);
 
     glBindVertexArray(_vao);
-    for (const ConstellationBound& bound : _constellationBounds) {
-        if (bound.isEnabled) {
-            glDrawArrays(GL_LINE_LOOP, bound.startIndex, bound.nVertices);
-        }
-    }
+    glMultiDrawArrays(
+        GL_LINE_LOOP,
+        _drawFirst.data(),
+        _drawCount.data(),
+        static_cast<GLsizei>(_drawFirst.size())
+    );
     glBindVertexArray(0);
     _program->deactivate();
 
     RenderableConstellationsBase::render(data, tasks);
 }
 
+void RenderableConstellationBounds::update(const UpdateData&) {
+    if (_dataIsDirty && _vbo != 0) {
+        createVertexBuffer();
+    }
+}
+
 bool RenderableConstellationBounds::loadData() {
     const bool success = loadVertexFile();
     if (!success) {
         throw ghoul::RuntimeError("Error loading data");
     }
+
+    resetConstellationVisibility(_constellationBounds.size());
+    selectionPropertyHasChanged();
+    _dataIsDirty = true;
     return success;
 }
 
@@ -229,6 +275,9 @@ bool RenderableConstellationBounds::loadVertexFile() {
         return false;
     }
 
+    _constellationBounds.clear();
+    _vertexValues.clear();
+
     ConstellationBound currentBound;
     currentBound.constellationAbbreviation = "";
 
@@ -274,7 +323,6 @@ bool RenderableConstellationBounds::loadVertexFile() {
             // Store the constellation and start a new one
             _constellationBounds.push_back(currentBound);
             currentBound = ConstellationBound();
-            currentBound.isEnabled = true;
             currentBound.constellationAbbreviation = abbreviation;
             std::string name = constellationFullName(abbreviation);
             currentBound.constellationFullName =
@@ -295,11 +343,13 @@ bool RenderableConstellationBounds::loadVertexFile() {
         std::array<double, 3> rectangularValues;
         radrec_c(1.0, ra, dec, rectangularValues.data());
 
-        // Add the new vertex to our list of vertices
+        // Add the new vertex to our list of vertices. The first (empty) bound is removed
+        // after reading, so the current bound ends up at the index of the last one
         _vertexValues.push_back({
             static_cast<float>(rectangularValues[0]),
             static_cast<float>(rectangularValues[1]),
-            static_cast<float>(rectangularValues[2])
+            static_cast<float>(rectangularValues[2]),
+            static_cast<GLuint>(_constellationBounds.size() - 1)
         });
         ++currentLineNumber;
     }
@@ -319,16 +369,11 @@ bool RenderableConstellationBounds::loadVertexFile() {
 
 void RenderableConstellationBounds::selectionPropertyHasChanged() {
     // If no values are selected (the default), we want to show all constellations
-    if (!_selection.hasSelected()) {
-        for (ConstellationBound& b : _constellationBounds) {
-            b.isEnabled = true;
-        }
-    }
-    else {
-        // Enable all constellations that are selected
-        for (ConstellationBound& b : _constellationBounds) {
-            b.isEnabled = _selection.isSelected(b.constellationFullName);
-        }
+    // Otherwise, enable all constellations that are selected
+    const bool showAll = !_selection.hasSelected();
+    for (size_t i = 0; i < _constellationBounds.size(); i++) {
+        const std::string& name = _constellationBounds[i].constellationFullName;
+        setConstellationEnabled(i, showAll || _selection.isSelected(name));
     }
 }
 
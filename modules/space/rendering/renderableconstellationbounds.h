@@ -54,6 +54,7 @@ public:
     bool isReady() const override;
 
     void render(const RenderData& data, RendererTasks& tasks) override;
+    void update(const UpdateData& data) override;
 
     static documentation::Documentation Documentation();
 
@@ -65,7 +66,6 @@ private:
         /// The abbreviation of the constellation
         std::string constellationAbbreviation;
         std::string constellationFullName;
-        bool isEnabled = false;
         /// The index of the first vertex describing the bounds
         GLsizei startIndex;
         /// The number of vertices describing the bounds
@@ -82,6 +82,9 @@ private:
     bool loadVertexFile();
     bool loadData();
 
+    /// Uploads `_vertexValues` to the vertex buffer and rebuilds the draw lists
+    void createVertexBuffer();
+
     /**
      * Callback method that gets triggered when `_constellationSelection` changes.
      */
@@ -102,11 +105,18 @@ private:
         float x;
         float y;
         float z;
+        /// The index of the constellation in `_constellationBounds`
+        GLuint constellation;
     };
     std::vector<Vertex> _vertexValues; ///< A list of all vertices of all bounds
 
+    /// All bounds share one vertex buffer and are drawn with a single
+    /// glMultiDrawArrays call. Disabled constellations are culled in the vertex shader
     GLuint _vao = 0;
     GLuint _vbo = 0;
+    std::vector<GLint> _drawFirst;
+    std::vector<GLsizei> _drawCount;
+    bool _dataIsDirty = true;
 };
 
 } // namespace openspace
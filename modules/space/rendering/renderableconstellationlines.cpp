@@ -36,6 +36,7 @@
 #include <ghoul/opengl/programobject.h>
 #include <scn/scan.h>
 #include <array>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <optional>
@@ -43,8 +44,8 @@
 namespace {
     constexpr std::string_view _loggerCat = "RenderableConstellationLines";
 
-    constexpr std::array<const char*, 4> UniformNames = {
-        "modelViewTransform", "projectionTransform", "opacity", "color"
+    constexpr std::array<const char*, 3> UniformNames = {
+        "modelViewTransform", "projectionTransform", "opacity"
     };
 
     constexpr openspace::properties::Property::PropertyInfo FileInfo = {
@@ -148,8 +149,8 @@ void RenderableConstellationLines::selectionPropertyHasChanged() {
 
     // If no values are selected (the default), we want to show all constellations
     if (!_selection.hasSelected()) {
-        for (ConstellationKeyValuePair& pair : _renderingConstellationsMap) {
-            pair.second.isEnabled = true;
+        for (const ConstellationKeyValuePair& pair : _renderingConstellationsMap) {
+            setConstellationEnabled(pair.first, true);
         }
 
         if (_hasLabels) {
@@ -160,9 +161,9 @@ void RenderableConstellationLines::selectionPropertyHasChanged() {
     }
     else {
         // Enable all constellations that are selected
-        for (ConstellationKeyValuePair& pair : _renderingConstellationsMap) {
+        for (const ConstellationKeyValuePair& pair : _renderingConstellationsMap) {
             const bool isSelected = _selection.isSelected(pair.second.name);
-            pair.second.isEnabled = isSelected;
+            setConstellationEnabled(pair.first, isSelected);
 
             if (_hasLabels) {
                 for (dataloader::Labelset::Entry& e : _labels->labelSet().entries) {
@@ -232,17 +233,61 @@ void RenderableConstellationLines::initializeGL() {
 
     ghoul::opengl::updateUniformLocations(*_program, _uniformCache, UniformNames);
 
+    glGenVertexArrays(1, &_vao);
+    glBindVertexArray(_vao);
+
+    glGenBuffers(1, &_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+
+    // in_position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<GLvoid*>(offsetof(Vertex, position))
+    );
+
+    // in_color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<GLvoid*>(offsetof(Vertex, color))
+    );
+
+    // in_constellation
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(
+        2,
+        1,
+        GL_UNSIGNED_INT,
+        sizeof(Vertex),
+        reinterpret_cast<GLvoid*>(offsetof(Vertex, constellation))
+    );
+
+    glBindVertexArray(0);
+
+    initializeVisibilityBuffer();
     createConstellations();
 }
 
 void RenderableConstellationLines::deinitializeGL() {
-    using ConstellationKeyValuePair = std::pair<const int, ConstellationLine>;
-    for (const ConstellationKeyValuePair& pair : _renderingConstellationsMap)
-    {
-        glDeleteVertexArrays(1, &pair.second.vaoArray);
-        glDeleteBuffers(1, &pair.second.vboArray);
+    if (_hasLabels) {
+        _labels->deinitializeGL();
     }
 
+    deinitializeVisibilityBuffer();
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+
     if (_program) {
         global::renderEngine->removeRenderProgram(_program.get());
         _program = nullptr;
@@ -264,26 +309,19 @@ void RenderableConstellationLines::renderConstellations(const RenderData&,
     _program->setUniform(_uniformCache.projectionTransform, projectionMatrix);
     _program->setUniform(_uniformCache.opacity, opacity());
 
-    using ConstellationKeyValuePair = std::pair<const int, ConstellationLine>;
-    for (const ConstellationKeyValuePair& pair : _renderingConstellationsMap)
-    {
-        if (!pair.second.isEnabled) {
-            continue;
-        }
-
-        _program->setUniform(
-            _uniformCache.color,
-            _constellationColorMap[pair.second.colorIndex]
-        );
-
-        glBindVertexArray(pair.second.vaoArray);
-
-        glLineWidth(_lineWidth);
-        glDrawArrays(GL_LINE_STRIP, 0, pair.second.numV);
-        global::renderEngine->openglStateCache().resetLineState();
-    }
+    bindVisibilityBuffer(*_program);
 
+    glLineWidth(_lineWidth);
+    glBindVertexArray(_vao);
+    glMultiDrawArrays(
+        GL_LINE_STRIP,
+        _drawFirst.data(),
+        _drawCount.data(),
+        static_cast<GLsizei>(_drawFirst.size())
+    );
     glBindVertexArray(0);
+    global::renderEngine->openglStateCache().resetLineState();
+
     _program->deactivate();
 
     // Restores GL State
@@ -307,6 +345,10 @@ void RenderableConstellationLines::update(const UpdateData&) {
         _program->rebuildFromFile();
         ghoul::opengl::updateUniformLocations(*_program, _uniformCache, UniformNames);
     }
+
+    if (_dataIsDirty && _vbo != 0) {
+        createConstellations();
+    }
 }
 
 bool RenderableConstellationLines::loadData() {
@@ -314,6 +356,10 @@ bool RenderableConstellationLines::loadData() {
     if (!success) {
         throw ghoul::RuntimeError("Error loading data");
     }
+
+    resetConstellationVisibility(_renderingConstellationsMap.size());
+    selectionPropertyHasChanged();
+    _dataIsDirty = true;
     return success;
 }
 
@@ -330,6 +376,8 @@ bool RenderableConstellationLines::readSpeckFile() {
         return false;
     }
 
+    _renderingConstellationsMap.clear();
+
     const float scale = static_cast<float>(toMeter(_constellationUnit));
     double maxRadius = 0.0;
 
@@ -449,29 +497,35 @@ bool RenderableConstellationLines::readSpeckFile() {
 void RenderableConstellationLines::createConstellations() {
     LDEBUG("Creating constellations");
 
-    for (std::pair<const int, ConstellationLine>& p : _renderingConstellationsMap) {
-        GLuint vao = 0;
-        glGenVertexArrays(1, &vao);
-        p.second.vaoArray = vao;
-
-        GLuint vbo = 0;
-        glGenBuffers(1, &vbo);
-        p.second.vboArray = vbo;
-
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            p.second.vertices.size() * sizeof(GLfloat),
-            p.second.vertices.data(),
-            GL_STATIC_DRAW
-        );
-        // in_position
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    std::vector<Vertex> vertexData;
+    _drawFirst.clear();
+    _drawCount.clear();
+
+    for (const std::pair<const int, ConstellationLine>& p : _renderingConstellationsMap) {
+        const glm::vec3 color = _constellationColorMap[p.second.colorIndex];
+        const std::vector<GLfloat>& vertices = p.second.vertices;
+
+        _drawFirst.push_back(static_cast<GLint>(vertexData.size()));
+        _drawCount.push_back(static_cast<GLsizei>(vertices.size() / 3));
+        for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+            vertexData.push_back({
+                { vertices[i], vertices[i + 1], vertices[i + 2] },
+                { color.r, color.g, color.b },
+                static_cast<GLuint>(p.first)
+            });
+        }
     }
 
-    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        vertexData.size() * sizeof(Vertex),
+        vertexData.data(),
+        GL_STATIC_DRAW
+    );
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    _dataIsDirty = false;
 }
 
 } // namespace openspace
@@ -59,16 +59,20 @@ public:
 
 private:
     struct ConstellationLine {
-        bool isEnabled = true;
         std::string name;
         int lineIndex;
         int colorIndex;
         int numV;
-        GLuint vaoArray;
-        GLuint vboArray;
         std::vector<GLfloat> vertices;
     };
 
+    struct Vertex {
+        float position[3];
+        float color[3];
+        /// The line index of the constellation that this vertex belongs to
+        GLuint constellation;
+    };
+
     void createConstellations();
     void renderConstellations(const RenderData& data, const glm::dmat4& modelViewMatrix,
         const glm::dmat4& projectionMatrix);
@@ -85,8 +89,7 @@ private:
     properties::BoolProperty _drawElements;
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _program = nullptr;
-    UniformCache(modelViewTransform, projectionTransform, opacity,
-        color) _uniformCache;
+    UniformCache(modelViewTransform, projectionTransform, opacity) _uniformCache;
 
     DistanceUnit _constellationUnit = DistanceUnit::Parsec;
 
@@ -94,6 +97,14 @@ private:
 
     std::unordered_map<int, glm::vec3> _constellationColorMap;
     std::unordered_map<int, ConstellationLine> _renderingConstellationsMap;
+
+    /// All constellations share one vertex buffer and are drawn with a single
+    /// glMultiDrawArrays call. Disabled constellations are culled in the vertex shader
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    std::vector<GLint> _drawFirst;
+    std::vector<GLsizei> _drawCount;
+    bool _dataIsDirty = true;
 };
 } // namespace openspace
 
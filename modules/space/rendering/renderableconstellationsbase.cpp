@@ -31,8 +31,10 @@
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/glm.h>
+#include <ghoul/misc/assert.h>
 #include <ghoul/misc/stringhelper.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
 #include <fstream>
 #include <optional>
 
@@ -202,6 +204,61 @@ void RenderableConstellationsBase::initialize() {
     }
 }
 
+void RenderableConstellationsBase::resetConstellationVisibility(size_t nConstellations) {
+    _visibilityMask = std::vector<uint32_t>((nConstellations + 31) / 32, ~0u);
+    _visibilityIsDirty = true;
+}
+
+void RenderableConstellationsBase::setConstellationEnabled(size_t index, bool enabled) {
+    ghoul_assert(index / 32 < _visibilityMask.size(), "Constellation index out of range");
+
+    const uint32_t bit = 1u << (index % 32);
+    uint32_t& word = _visibilityMask[index / 32];
+    word = enabled ? (word | bit) : (word & ~bit);
+    _visibilityIsDirty = true;
+}
+
+void RenderableConstellationsBase::initializeVisibilityBuffer() {
+    glGenBuffers(1, &_visibilityBuffer);
+    _visibilityBinding = std::make_unique<ghoul::opengl::BufferBinding<
+        ghoul::opengl::bufferbinding::Buffer::ShaderStorage>>();
+    _visibilityIsDirty = true;
+}
+
+void RenderableConstellationsBase::deinitializeVisibilityBuffer() {
+    _visibilityBinding = nullptr;
+    glDeleteBuffers(1, &_visibilityBuffer);
+    _visibilityBuffer = 0;
+}
+
+void RenderableConstellationsBase::bindVisibilityBuffer(
+                                                    ghoul::opengl::ProgramObject& program)
+{
+    if (_visibilityIsDirty) {
+        // An empty shader storage buffer is not allowed, so there is always one word
+        const uint32_t empty = 0;
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _visibilityBuffer);
+        glBufferData(
+            GL_SHADER_STORAGE_BUFFER,
+            std::max<size_t>(_visibilityMask.size(), 1) * sizeof(uint32_t),
+            _visibilityMask.empty() ? &empty : _visibilityMask.data(),
+            GL_DYNAMIC_DRAW
+        );
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        _visibilityIsDirty = false;
+    }
+
+    glBindBufferBase(
+        GL_SHADER_STORAGE_BUFFER,
+        _visibilityBinding->bindingNumber(),
+        _visibilityBuffer
+    );
+    program.setSsboBinding(
+        "ConstellationVisibility",
+        _visibilityBinding->bindingNumber()
+    );
+}
+
 bool RenderableConstellationsBase::isReady() const {
     return _hasLabels ? _labels->isReady() : true;
 }
@@ -34,8 +34,11 @@
 #include <openspace/rendering/labelscomponent.h>
 #include <openspace/util/distanceconversion.h>
 #include <ghoul/misc/managedmemoryuniqueptr.h>
+#include <ghoul/opengl/bufferbinding.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace ghoul::opengl { class ProgramObject; }
@@ -74,6 +77,28 @@ protected:
      */
     std::string constellationFullName(const std::string& identifier) const;
 
+    /**
+     * Resets the visibility bitmask to contain \p nConstellations constellations that are
+     * all enabled.
+     */
+    void resetConstellationVisibility(size_t nConstellations);
+
+    /**
+     * Enables or disables the constellation with the provided \p index. The change is
+     * uploaded to the GPU the next time #bindVisibilityBuffer is called, so changing the
+     * selection never requires the vertex data to be rebuilt.
+     */
+    void setConstellationEnabled(size_t index, bool enabled);
+
+    void initializeVisibilityBuffer();
+    void deinitializeVisibilityBuffer();
+
+    /**
+     * Uploads the visibility bitmask if it has changed and binds it to the
+     * `ConstellationVisibility` shader storage block of the provided \p program.
+     */
+    void bindVisibilityBuffer(ghoul::opengl::ProgramObject& program);
+
     /// Width for the rendered lines
     properties::FloatProperty _lineWidth;
 
@@ -107,6 +132,13 @@ private:
 
     /// The file containing constellation names and abbreviations
     properties::StringProperty _namesFilename;
+
+    /// One bit per constellation, set if the constellation is enabled
+    std::vector<uint32_t> _visibilityMask;
+    bool _visibilityIsDirty = true;
+    GLuint _visibilityBuffer = 0;
+    std::unique_ptr<ghoul::opengl::BufferBinding<
+        ghoul::opengl::bufferbinding::Buffer::ShaderStorage>> _visibilityBinding;
 };
 
 } // namespace openspace
@@ -37,9 +37,11 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/logging/consolelog.h>
 #include <ghoul/logging/visualstudiooutputlog.h>
+#include <ghoul/misc/assert.h>
 #include <ghoul/misc/stringhelper.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <optional>
@@ -284,6 +286,16 @@ namespace {
 
         // [[codegen::verbatim(colorTableRangeInfo.description)]]
         std::optional<glm::vec2> colorTableRange;
+
+        // If this value is true, the states are not all loaded into memory at once.
+        // Instead, a bounded number of states is kept in memory and the states that come
+        // next in the direction of the playback are loaded in the background. This makes
+        // it possible to show datasets that do not fit into memory
+        std::optional<bool> streaming;
+
+        // The number of states that are kept in memory if 'Streaming' is enabled. This
+        // includes the active state and the states that are prefetched. Defaults to 8
+        std::optional<int> residentStates [[codegen::greater(1)]];
     };
 #include "renderablefluxnodes_codegen.cpp"
 
@@ -384,6 +396,9 @@ RenderableFluxNodes::RenderableFluxNodes(const ghoul::Dictionary& dictionary)
     _nodeskipMethod.addOption(static_cast<int>(NodeSkipMethod::Flux), "Flux");
     _nodeskipMethod.addOption(static_cast<int>(NodeSkipMethod::Radius), "Radius");
 
+    _isStreaming = p.streaming.value_or(_isStreaming);
+    _residentStates.resize(p.residentStates.value_or(8));
+
     if (p.energyBin.has_value()) {
         _goesEnergyBins.setValue(p.energyBin.value());
     }
@@ -399,6 +414,10 @@ void RenderableFluxNodes::initialize() {
     computeSequenceEndTime();
 }
 
+void RenderableFluxNodes::deinitialize() {
+    stopStreaming();
+}
+
 void RenderableFluxNodes::initializeGL() {
     // Setup shader program
     _shaderProgram = global::renderEngine->buildRenderProgram(
@@ -456,9 +475,15 @@ void RenderableFluxNodes::loadNodeData(int energybinOption) {
         "{}/radiuses{}", _binarySourceFolderPath, energybin
     );
 
+    // The background thread has to be stopped before the states that it loads into are
+    // resized for the new files
+    stopStreaming();
+    _uploadedStateIndex = -1;
+    _positionsFile = file;
+    _fluxesFile = file2;
+    _radiusesFile = file3;
+
     std::ifstream fileStream = std::ifstream(file, std::ifstream::binary);
-    std::ifstream fileStream2 = std::ifstream(file2, std::ifstream::binary);
-    std::ifstream fileStream3 = std::ifstream(file3, std::ifstream::binary);
 
     if (!fileStream.good()) {
         LERROR(std::format("Could not read file '{}'", file));
@@ -479,37 +504,166 @@ void RenderableFluxNodes::loadNodeData(int energybinOption) {
         );
         return;
     }
+    _nNodesPerTimestep = nNodesPerTimestep;
 
     _statesColor.clear();
     _statesPos.clear();
     _statesRadius.clear();
 
+    if (_isStreaming) {
+        // Only the header is read here, the states are loaded on demand
+        startStreaming();
+        return;
+    }
+
+    std::ifstream fileStream2 = std::ifstream(file2, std::ifstream::binary);
+    std::ifstream fileStream3 = std::ifstream(file3, std::ifstream::binary);
+
+    _statesPos.reserve(_nStates);
+    _statesColor.reserve(_nStates);
+    _statesRadius.reserve(_nStates);
     for (unsigned int i = 0; i < _nStates; i++) {
-        _vertexPositions.resize(nNodesPerTimestep);
-        fileStream.read(reinterpret_cast<char*>(
-            _vertexPositions.data()), nNodesPerTimestep * sizeof(glm::vec3)
+        std::vector<glm::vec3>& positions = _statesPos.emplace_back(nNodesPerTimestep);
+        fileStream.read(
+            reinterpret_cast<char*>(positions.data()),
+            nNodesPerTimestep * sizeof(glm::vec3)
         );
-
-        _statesPos.push_back(_vertexPositions);
-        _vertexPositions.clear();
     }
     for (unsigned int i = 0; i < _nStates; i++) {
-        _vertexColor.resize(nNodesPerTimestep);
-        fileStream2.read(reinterpret_cast<char*>(
-            _vertexColor.data()), nNodesPerTimestep * sizeof(float)
+        std::vector<float>& colors = _statesColor.emplace_back(nNodesPerTimestep);
+        fileStream2.read(
+            reinterpret_cast<char*>(colors.data()),
+            nNodesPerTimestep * sizeof(float)
         );
-
-        _statesColor.push_back(_vertexColor);
-        _vertexColor.clear();
     }
     for (unsigned int i = 0; i < _nStates; i++) {
-        _vertexRadius.resize(nNodesPerTimestep);
-        fileStream3.read(reinterpret_cast<char*>(
-            _vertexRadius.data()), nNodesPerTimestep * sizeof(float)
+        std::vector<float>& radii = _statesRadius.emplace_back(nNodesPerTimestep);
+        fileStream3.read(
+            reinterpret_cast<char*>(radii.data()),
+            nNodesPerTimestep * sizeof(float)
+        );
+    }
+}
+
+void RenderableFluxNodes::startStreaming() {
+    _shouldStopStreaming = false;
+    for (ResidentState& state : _residentStates) {
+        state.index = -1;
+        state.positions.resize(_nNodesPerTimestep);
+        state.colors.resize(_nNodesPerTimestep);
+        state.radii.resize(_nNodesPerTimestep);
+    }
+    _streamThread = std::thread([this]() { streamStates(); });
+}
+
+void RenderableFluxNodes::stopStreaming() {
+    {
+        const std::lock_guard lock(_streamMutex);
+        _shouldStopStreaming = true;
+    }
+    _streamCondition.notify_one();
+    if (_streamThread.joinable()) {
+        _streamThread.join();
+    }
+
+    for (ResidentState& state : _residentStates) {
+        state.index = -1;
+    }
+    _requestedStates.clear();
+    _requestedStateIndex = -1;
+}
+
+void RenderableFluxNodes::streamStates() {
+    std::ifstream positionsStream = std::ifstream(_positionsFile, std::ifstream::binary);
+    std::ifstream fluxesStream = std::ifstream(_fluxesFile, std::ifstream::binary);
+    std::ifstream radiusesStream = std::ifstream(_radiusesFile, std::ifstream::binary);
+
+    // The positions file starts with the number of nodes and the number of states
+    constexpr std::streamoff HeaderSize = 2 * sizeof(uint32_t);
+    const std::streamoff nNodes = _nNodesPerTimestep;
+
+    auto isResident = [this](int index) {
+        return std::any_of(
+            _residentStates.begin(),
+            _residentStates.end(),
+            [index](const ResidentState& state) { return state.index == index; }
+        );
+    };
+    auto nextMissingState = [this, &isResident]() {
+        return std::find_if(
+            _requestedStates.begin(),
+            _requestedStates.end(),
+            [&isResident](int index) { return !isResident(index); }
         );
+    };
 
-        _statesRadius.push_back(_vertexRadius);
-        _vertexRadius.clear();
+    while (true) {
+        int index = -1;
+        ResidentState* slot = nullptr;
+        {
+            std::unique_lock lock(_streamMutex);
+            _streamCondition.wait(
+                lock,
+                [this, &nextMissingState]() {
+                    return _shouldStopStreaming ||
+                        nextMissingState() != _requestedStates.end();
+                }
+            );
+            if (_shouldStopStreaming) {
+                return;
+            }
+            index = *nextMissingState();
+
+            // Since there are never more requested states than slots, there is always
+            // either an empty slot or one that holds a state that is no longer requested
+            auto it = std::find_if(
+                _residentStates.begin(),
+                _residentStates.end(),
+                [this](const ResidentState& state) {
+                    return state.index == -1 ||
+                        std::find(
+                            _requestedStates.begin(),
+                            _requestedStates.end(),
+                            state.index
+                        ) == _requestedStates.end();
+                }
+            );
+            ghoul_assert(it != _residentStates.end(), "No free slot for the state");
+            slot = &*it;
+
+            // Marking the slot as empty prevents the main thread from reading from it
+            // while it is being overwritten outside of the lock
+            slot->index = -1;
+        }
+
+        positionsStream.seekg(HeaderSize + index * nNodes * sizeof(glm::vec3));
+        positionsStream.read(
+            reinterpret_cast<char*>(slot->positions.data()),
+            nNodes * sizeof(glm::vec3)
+        );
+        fluxesStream.seekg(index * nNodes * sizeof(float));
+        fluxesStream.read(
+            reinterpret_cast<char*>(slot->colors.data()),
+            nNodes * sizeof(float)
+        );
+        radiusesStream.seekg(index * nNodes * sizeof(float));
+        radiusesStream.read(
+            reinterpret_cast<char*>(slot->radii.data()),
+            nNodes * sizeof(float)
+        );
+
+        const std::lock_guard lock(_streamMutex);
+        if (positionsStream.good() && fluxesStream.good() && radiusesStream.good()) {
+            slot->index = index;
+        }
+        else {
+            // The state is no longer requested so that it is not loaded over and over
+            LERROR(std::format("Could not read state {} from the binary files", index));
+            std::erase(_requestedStates, index);
+            positionsStream.clear();
+            fluxesStream.clear();
+            radiusesStream.clear();
+        }
     }
 }
 
@@ -670,7 +824,7 @@ void RenderableFluxNodes::updateActiveTriggerTimeIndex(double currentTime) {
     }
 }
 void RenderableFluxNodes::render(const RenderData& data, RendererTasks&) {
-    if (_activeTriggerTimeIndex == -1) {
+    if (_activeTriggerTimeIndex == -1 || _uploadedStateIndex == -1) {
         return;
     }
     _shaderProgram->activate();
@@ -761,11 +915,7 @@ void RenderableFluxNodes::render(const RenderData& data, RendererTasks&) {
 
     glBindVertexArray(_vertexArrayObject);
 
-    glDrawArrays(
-        GL_POINTS,
-        0,
-        static_cast<GLsizei>(_vertexPositions.size())
-    );
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_nAllocatedNodes));
 
     glBindVertexArray(0);
     _shaderProgram->deactivate();
@@ -819,13 +969,21 @@ void RenderableFluxNodes::update(const UpdateData& data) {
         needsUpdate = false;
     }
 
-    if (needsUpdate && !_statesPos[_activeTriggerTimeIndex].empty()) {
-        _vertexPositions = _statesPos[_activeTriggerTimeIndex];
-        _vertexColor = _statesColor[_activeTriggerTimeIndex];
-        _vertexRadius = _statesRadius[_activeTriggerTimeIndex];
-        updatePositionBuffer();
-        updateVertexColorBuffer();
-        updateVertexFilteringBuffer();
+    if (needsUpdate && _nAllocatedNodes != _nNodesPerTimestep) {
+        allocateBuffers();
+    }
+
+    // The buffers are only updated when the active state changes
+    if (needsUpdate && _isStreaming) {
+        updateStreamedState(currentTime >= data.previousFrameTime.j2000Seconds());
+    }
+    else if (needsUpdate && _activeTriggerTimeIndex != _uploadedStateIndex &&
+             _activeTriggerTimeIndex < static_cast<int>(_statesPos.size()))
+    {
+        updatePositionBuffer(_statesPos[_activeTriggerTimeIndex]);
+        updateVertexColorBuffer(_statesColor[_activeTriggerTimeIndex]);
+        updateVertexFilteringBuffer(_statesRadius[_activeTriggerTimeIndex]);
+        _uploadedStateIndex = _activeTriggerTimeIndex;
     }
 
     if (_shaderProgram->isDirty()) {
@@ -838,58 +996,106 @@ void RenderableFluxNodes::update(const UpdateData& data) {
     }
 }
 
-void RenderableFluxNodes::updatePositionBuffer() {
+void RenderableFluxNodes::updateStreamedState(bool isPlayingForward) {
+    if (_activeTriggerTimeIndex != _requestedStateIndex ||
+        isPlayingForward != _requestedForward)
+    {
+        {
+            // The active state is requested first, followed by the states that come next
+            // in the direction of the playback
+            const std::lock_guard lock(_streamMutex);
+            _requestedStates.clear();
+            const int step = isPlayingForward ? 1 : -1;
+            for (size_t i = 0; i < _residentStates.size(); i++) {
+                const int index = _activeTriggerTimeIndex + static_cast<int>(i) * step;
+                if (index < 0 || index >= static_cast<int>(_nStates)) {
+                    break;
+                }
+                _requestedStates.push_back(index);
+            }
+        }
+        _streamCondition.notify_one();
+        _requestedStateIndex = _activeTriggerTimeIndex;
+        _requestedForward = isPlayingForward;
+    }
+
+    if (_uploadedStateIndex == _activeTriggerTimeIndex) {
+        return;
+    }
+
+    // Until the active state has been loaded, the previously uploaded state is shown
+    const std::lock_guard lock(_streamMutex);
+    auto it = std::find_if(
+        _residentStates.begin(),
+        _residentStates.end(),
+        [this](const ResidentState& state) {
+            return state.index == _activeTriggerTimeIndex;
+        }
+    );
+    if (it != _residentStates.end()) {
+        updatePositionBuffer(it->positions);
+        updateVertexColorBuffer(it->colors);
+        updateVertexFilteringBuffer(it->radii);
+        _uploadedStateIndex = _activeTriggerTimeIndex;
+    }
+}
+
+void RenderableFluxNodes::allocateBuffers() {
     glBindVertexArray(_vertexArrayObject);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
 
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vertexPositions.size() * sizeof(glm::vec3),
-        _vertexPositions.data(),
-        GL_STATIC_DRAW
+        _nNodesPerTimestep * sizeof(glm::vec3),
+        nullptr,
+        GL_DYNAMIC_DRAW
     );
-
     glEnableVertexAttribArray(0);
     glEnable(GL_PROGRAM_POINT_SIZE);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-void RenderableFluxNodes::updateVertexColorBuffer() {
-    glBindVertexArray(_vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexColorBuffer);
-
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vertexColor.size() * sizeof(float),
-        _vertexColor.data(),
-        GL_STATIC_DRAW
+        _nNodesPerTimestep * sizeof(float),
+        nullptr,
+        GL_DYNAMIC_DRAW
     );
-
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-void RenderableFluxNodes::updateVertexFilteringBuffer() {
-    glBindVertexArray(_vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexFilteringBuffer);
-
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vertexRadius.size() * sizeof(float),
-        _vertexRadius.data(),
-        GL_STATIC_DRAW
+        _nNodesPerTimestep * sizeof(float),
+        nullptr,
+        GL_DYNAMIC_DRAW
     );
-
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+
+    _nAllocatedNodes = _nNodesPerTimestep;
+    _uploadedStateIndex = -1;
+}
+
+void RenderableFluxNodes::updatePositionBuffer(std::span<const glm::vec3> positions) {
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, positions.size_bytes(), positions.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderableFluxNodes::updateVertexColorBuffer(std::span<const float> colors) {
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexColorBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, colors.size_bytes(), colors.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderableFluxNodes::updateVertexFilteringBuffer(std::span<const float> radii) {
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexFilteringBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, radii.size_bytes(), radii.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 } // namespace openspace
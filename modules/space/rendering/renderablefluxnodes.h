@@ -36,7 +36,11 @@
 #include <openspace/rendering/transferfunction.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <atomic>
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
+#include <span>
+#include <thread>
 
 namespace openspace {
 
@@ -45,6 +49,7 @@ public:
     RenderableFluxNodes(const ghoul::Dictionary& dictionary);
 
     void initialize() override;
+    void deinitialize() override;
     void initializeGL() override;
     void deinitializeGL() override;
 
@@ -63,9 +68,30 @@ private:
     void updateActiveTriggerTimeIndex(double currentTime);
 
     void loadNodeData(int energybinOption);
-    void updatePositionBuffer();
-    void updateVertexColorBuffer();
-    void updateVertexFilteringBuffer();
+    void updatePositionBuffer(std::span<const glm::vec3> positions);
+    void updateVertexColorBuffer(std::span<const float> colors);
+    void updateVertexFilteringBuffer(std::span<const float> radii);
+
+    /**
+     * Allocates the vertex buffers for the current number of nodes per time step. The
+     * buffers are only allocated once per dataset and the states are then uploaded into
+     * the existing storage.
+     */
+    void allocateBuffers();
+
+    /**
+     * Uploads the active state from the resident states if it has been loaded by the
+     * background thread and requests the states that are needed next in the direction
+     * of the playback.
+     */
+    void updateStreamedState(bool isPlayingForward);
+
+    /// Starts the background thread that loads the requested states from disk
+    void startStreaming();
+    /// Stops the background thread and discards all resident states
+    void stopStreaming();
+    /// Loop of the background thread that loads the requested states
+    void streamStates();
 
     std::vector<GLsizei> _lineCount;
     std::vector<GLint> _lineStart;
@@ -133,12 +159,6 @@ private:
     std::vector<std::filesystem::path> _binarySourceFiles;
     // Contains the _triggerTimes for all streams in the sequence
     std::vector<double> _startTimes;
-    // Contains vertexPositions
-    std::vector<glm::vec3> _vertexPositions;
-    // Contains vertex flux values for color
-    std::vector<float> _vertexColor;
-    // Contains radius of vertices
-    std::vector<float> _vertexRadius;
     // Stores the states position
     std::vector<std::vector<glm::vec3>> _statesPos;
     // Stores the states color
@@ -146,6 +166,41 @@ private:
     // Stores the states radius
     std::vector<std::vector<float>> _statesRadius;
 
+    // The number of nodes in each of the states
+    uint32_t _nNodesPerTimestep = 0;
+    // The number of nodes for which the vertex buffers are allocated
+    uint32_t _nAllocatedNodes = 0;
+    // The index of the state that is currently stored in the vertex buffers
+    int _uploadedStateIndex = -1;
+
+    /// A single time step that has been loaded from disk in the streaming mode
+    struct ResidentState {
+        /// The index of the state, or -1 if the slot is empty or currently being loaded
+        int index = -1;
+        std::vector<glm::vec3> positions;
+        std::vector<float> colors;
+        std::vector<float> radii;
+    };
+
+    // If this is true, only a bounded number of states is kept in memory and the states
+    // are loaded on demand by a background thread
+    bool _isStreaming = false;
+    // The files from which the states of the current energy bin are streamed
+    std::filesystem::path _positionsFile;
+    std::filesystem::path _fluxesFile;
+    std::filesystem::path _radiusesFile;
+    // The fixed set of slots that hold the states that are resident in memory
+    std::vector<ResidentState> _residentStates;
+    // The states that should be resident, ordered by decreasing priority
+    std::vector<int> _requestedStates;
+    // The active state and playback direction for which the states were requested
+    int _requestedStateIndex = -1;
+    bool _requestedForward = true;
+    bool _shouldStopStreaming = false;
+    std::mutex _streamMutex;
+    std::condition_variable _streamCondition;
+    std::thread _streamThread;
+
     // Group to hold properties regarding distance to earth
     properties::PropertyOwner _earthdistGroup;
 
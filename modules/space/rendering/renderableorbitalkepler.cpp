@@ -38,9 +38,13 @@
 #include <ghoul/misc/csvreader.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/logging/logmanager.h>
+#include <glm/gtx/transform.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cmath>
 #include <fstream>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -177,6 +181,36 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo GpuPropagationInfo = {
+        "GpuPropagation",
+        "GPU Propagation",
+        "If enabled, only the Keplerian elements of each object are uploaded to the "
+        "graphics card, and both the orbits and the current positions of the objects "
+        "are computed in the shaders. This makes it possible to render much larger "
+        "datasets and to change the number of rendered objects without recomputing any "
+        "orbits. If disabled, the orbits are precomputed on the CPU.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo Sgp4Info = {
+        "Sgp4",
+        "SGP4",
+        "If enabled, the current positions of the objects are computed every frame using "
+        "the SGP4 model, which takes the Earth's oblateness and the atmospheric drag "
+        "into account. The trails are still rendered as unperturbed Kepler orbits, so "
+        "the points can drift away from their trails with increasing time since the "
+        "epoch of the elements. This value only has an effect for TLE and OMM files.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The layout is defined by the OpenGL specification of glMultiDrawArraysIndirect
+    struct DrawArraysIndirectCommand {
+        GLuint count = 0;
+        GLuint instanceCount = 0;
+        GLuint first = 0;
+        GLuint baseInstance = 0;
+    };
+
     struct [[codegen::Dictionary(RenderableOrbitalKepler)]] Parameters {
         // [[codegen::verbatim(PathInfo.description)]]
         std::filesystem::path path;
@@ -238,6 +272,12 @@ namespace {
 
         // [[codegen::verbatim(OutlineWidthInfo.description)]]
         std::optional<float> outlineWidth;
+
+        // [[codegen::verbatim(GpuPropagationInfo.description)]]
+        std::optional<bool> gpuPropagation;
+
+        // [[codegen::verbatim(Sgp4Info.description)]]
+        std::optional<bool> sgp4;
     };
 #include "renderableorbitalkepler_codegen.cpp"
 } // namespace
@@ -295,6 +335,8 @@ RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
     , _sizeRender(RenderSizeInfo, 1, 1, 2)
     , _path(PathInfo)
     , _contiguousMode(ContiguousModeInfo, false)
+    , _gpuPropagation(GpuPropagationInfo, false)
+    , _sgp4(Sgp4Info, false)
 {
     const Parameters p = codegen::bake<Parameters>(dict);
 
@@ -334,7 +376,10 @@ RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
     addPropertySubOwner(_appearance);
 
     _path = p.path.string();
-    _path.onChange([this]() { updateBuffers(); });
+    _path.onChange([this]() {
+        _parametersAreDirty = true;
+        updateBuffers();
+    });
     addProperty(_path);
 
     _format = codegen::map<kepler::Format>(p.format);
@@ -345,7 +390,7 @@ RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
             if ((_numObjects - _startRenderIdx) < _sizeRender) {
                 _sizeRender = static_cast<unsigned int>(_numObjects - _startRenderIdx);
             }
-            _updateDataBuffersAtNextRender = true;
+            _updateSubsetAtNextRender = true;
         }
     });
     addProperty(_startRenderIdx);
@@ -357,13 +402,21 @@ RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
                 _startRenderIdx = static_cast<unsigned int>(_numObjects - _sizeRender);
             }
         }
-        _updateDataBuffersAtNextRender = true;
+        _updateSubsetAtNextRender = true;
     });
     addProperty(_sizeRender);
 
     _contiguousMode = p.contiguousMode.value_or(false);
-    _contiguousMode.onChange([this]() { _updateDataBuffersAtNextRender = true; });
+    _contiguousMode.onChange([this]() { _updateSubsetAtNextRender = true; });
     addProperty(_contiguousMode);
+
+    _gpuPropagation = p.gpuPropagation.value_or(_gpuPropagation);
+    _gpuPropagation.onChange([this]() { _updateDataBuffersAtNextRender = true; });
+    addProperty(_gpuPropagation);
+
+    _sgp4 = p.sgp4.value_or(_sgp4);
+    _sgp4.onChange([this]() { _updateDataBuffersAtNextRender = true; });
+    addProperty(_sgp4);
 }
 
 void RenderableOrbitalKepler::initializeGL() {
@@ -371,6 +424,18 @@ void RenderableOrbitalKepler::initializeGL() {
     ghoul_assert(_vertexBuffer == 0, "Vertex buffer object already existed");
     glGenVertexArrays(1, &_vertexArray);
     glGenBuffers(1, &_vertexBuffer);
+    glGenVertexArrays(1, &_elementsVertexArray);
+    glGenBuffers(1, &_elementsBuffer);
+    glGenBuffers(1, &_indirectBuffer);
+    glGenBuffers(1, &_pointIndirectBuffer);
+
+    glGenVertexArrays(1, &_sgp4VertexArray);
+    glGenBuffers(1, &_sgp4Buffer);
+    glBindVertexArray(_sgp4VertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, _sgp4Buffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), nullptr);
+    glBindVertexArray(0);
 
     // Program for line rendering
     _trailProgram = SpaceModule::ProgramObjectManager.request(
@@ -398,44 +463,99 @@ void RenderableOrbitalKepler::initializeGL() {
         }
     );
 
+    // Programs for rendering with the orbits propagated on the GPU. They share the
+    // fragment shaders, and the trail geometry shader, with the programs above
+    _gpuTrailProgram = SpaceModule::ProgramObjectManager.request(
+        "OrbitalKeplerTrailsGpu",
+        []() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
+            return global::renderEngine->buildRenderProgram(
+                "OrbitalKeplerTrailsGpu",
+                absPath("${MODULE_SPACE}/shaders/debrisVizTrails_gpu_vs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisVizTrails_fs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisVizTrails_gs.glsl")
+            );
+        }
+    );
+
+    _gpuPointProgram = SpaceModule::ProgramObjectManager.request(
+        "OrbitalKeplerPointsGpu",
+        []() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
+            return global::renderEngine->buildRenderProgram(
+                "OrbitalKeplerPointsGpu",
+                absPath("${MODULE_SPACE}/shaders/debrisVizPoints_gpu_vs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisVizPoints_fs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisVizPoints_gpu_gs.glsl")
+            );
+        }
+    );
+
+    // Program for the points that are positioned with SGP4 on the CPU
+    _sgp4PointProgram = SpaceModule::ProgramObjectManager.request(
+        "OrbitalKeplerPointsSgp4",
+        []() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
+            return global::renderEngine->buildRenderProgram(
+                "OrbitalKeplerPointsSgp4",
+                absPath("${MODULE_SPACE}/shaders/debrisVizPoints_sgp4_vs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisVizPoints_fs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisVizPoints_gpu_gs.glsl")
+            );
+        }
+    );
+
+    updateUniformCaches();
+    updateBuffers();
+}
+
+void RenderableOrbitalKepler::updateUniformCaches() {
+    // The caches are used for whichever programs match the current propagation mode
+    ghoul::opengl::ProgramObject* trailProgram =
+        _gpuPropagation ? _gpuTrailProgram : _trailProgram;
+    ghoul::opengl::ProgramObject* pointProgram =
+        usesSgp4() ? _sgp4PointProgram :
+        _gpuPropagation ? _gpuPointProgram : _pointProgram;
+
     // Init cache for line rendering
     _uniformTrailCache.modelView =
-        _trailProgram->uniformLocation("modelViewTransform");
+        trailProgram->uniformLocation("modelViewTransform");
     _uniformTrailCache.projection =
-        _trailProgram->uniformLocation("projectionTransform");
+        trailProgram->uniformLocation("projectionTransform");
     _uniformTrailCache.colorFadeCutoffValue =
-        _trailProgram->uniformLocation("colorFadeCutoffValue");
+        trailProgram->uniformLocation("colorFadeCutoffValue");
     _uniformTrailCache.trailFadeExponent =
-        _trailProgram->uniformLocation("trailFadeExponent");
-    _uniformTrailCache.inGameTime = _trailProgram->uniformLocation("inGameTime");
-    _uniformTrailCache.color = _trailProgram->uniformLocation("color");
-    _uniformTrailCache.opacity = _trailProgram->uniformLocation("opacity");
+        trailProgram->uniformLocation("trailFadeExponent");
+    _uniformTrailCache.inGameTime = trailProgram->uniformLocation("inGameTime");
+    _uniformTrailCache.color = trailProgram->uniformLocation("color");
+    _uniformTrailCache.opacity = trailProgram->uniformLocation("opacity");
 
     // Init cache for point rendering
-    _uniformPointCache.modelTransform = _pointProgram->uniformLocation("modelTransform");
-    _uniformPointCache.viewTransform = _pointProgram->uniformLocation("viewTransform");
-    _uniformPointCache.cameraUpWorld = _pointProgram->uniformLocation("cameraUpWorld");
-    _uniformPointCache.inGameTime = _pointProgram->uniformLocation("inGameTime");
-    _uniformPointCache.color = _pointProgram->uniformLocation("color");
-    _uniformPointCache.enableMaxSize = _pointProgram->uniformLocation("enableMaxSize");
-    _uniformPointCache.maxSize = _pointProgram->uniformLocation("maxSize");
-    _uniformPointCache.enableOutline = _pointProgram->uniformLocation("enableOutline");
-    _uniformPointCache.outlineColor = _pointProgram->uniformLocation("outlineColor");
-    _uniformPointCache.outlineWeight = _pointProgram->uniformLocation("outlineWeight");
-    _uniformPointCache.opacity = _pointProgram->uniformLocation("opacity");
+    _uniformPointCache.modelTransform = pointProgram->uniformLocation("modelTransform");
+    _uniformPointCache.viewTransform = pointProgram->uniformLocation("viewTransform");
+    _uniformPointCache.cameraUpWorld = pointProgram->uniformLocation("cameraUpWorld");
+    _uniformPointCache.inGameTime = pointProgram->uniformLocation("inGameTime");
+    _uniformPointCache.color = pointProgram->uniformLocation("color");
+    _uniformPointCache.enableMaxSize = pointProgram->uniformLocation("enableMaxSize");
+    _uniformPointCache.maxSize = pointProgram->uniformLocation("maxSize");
+    _uniformPointCache.enableOutline = pointProgram->uniformLocation("enableOutline");
+    _uniformPointCache.outlineColor = pointProgram->uniformLocation("outlineColor");
+    _uniformPointCache.outlineWeight = pointProgram->uniformLocation("outlineWeight");
+    _uniformPointCache.opacity = pointProgram->uniformLocation("opacity");
     _uniformPointCache.projectionTransform =
-        _pointProgram->uniformLocation("projectionTransform");
+        pointProgram->uniformLocation("projectionTransform");
     _uniformPointCache.cameraPositionWorld =
-        _pointProgram->uniformLocation("cameraPositionWorld");
+        pointProgram->uniformLocation("cameraPositionWorld");
     _uniformPointCache.pointSizeExponent =
-        _pointProgram->uniformLocation("pointSizeExponent");
-
-    updateBuffers();
+        pointProgram->uniformLocation("pointSizeExponent");
 }
 
 void RenderableOrbitalKepler::deinitializeGL() {
     glDeleteBuffers(1, &_vertexBuffer);
     glDeleteVertexArrays(1, &_vertexArray);
+    glDeleteBuffers(1, &_elementsBuffer);
+    glDeleteBuffers(1, &_indirectBuffer);
+    glDeleteBuffers(1, &_pointIndirectBuffer);
+    glDeleteVertexArrays(1, &_elementsVertexArray);
+    glDeleteBuffers(1, &_sgp4Buffer);
+    glDeleteVertexArrays(1, &_sgp4VertexArray);
 
     SpaceModule::ProgramObjectManager.release(
         "OrbitalKeplerTrails",
@@ -451,23 +571,56 @@ void RenderableOrbitalKepler::deinitializeGL() {
         }
     );
 
+    SpaceModule::ProgramObjectManager.release(
+        "OrbitalKeplerTrailsGpu",
+        [](ghoul::opengl::ProgramObject* p) {
+            global::renderEngine->removeRenderProgram(p);
+        }
+    );
+
+    SpaceModule::ProgramObjectManager.release(
+        "OrbitalKeplerPointsGpu",
+        [](ghoul::opengl::ProgramObject* p) {
+            global::renderEngine->removeRenderProgram(p);
+        }
+    );
+
+    SpaceModule::ProgramObjectManager.release(
+        "OrbitalKeplerPointsSgp4",
+        [](ghoul::opengl::ProgramObject* p) {
+            global::renderEngine->removeRenderProgram(p);
+        }
+    );
+
     _pointProgram = nullptr;
     _trailProgram = nullptr;
+    _gpuPointProgram = nullptr;
+    _gpuTrailProgram = nullptr;
+    _sgp4PointProgram = nullptr;
 }
 
 bool RenderableOrbitalKepler::isReady() const {
-    return _pointProgram != nullptr && _trailProgram != nullptr;
+    return _pointProgram != nullptr && _trailProgram != nullptr &&
+        _gpuPointProgram != nullptr && _gpuTrailProgram != nullptr &&
+        _sgp4PointProgram != nullptr;
 }
 
 void RenderableOrbitalKepler::update(const UpdateData&) {
     if (_updateDataBuffersAtNextRender) {
         _updateDataBuffersAtNextRender = false;
+        _updateSubsetAtNextRender = false;
+        updateUniformCaches();
         updateBuffers();
     }
+    else if (_updateSubsetAtNextRender) {
+        _updateSubsetAtNextRender = false;
+        updateSubset();
+    }
 }
 
 void RenderableOrbitalKepler::render(const RenderData& data, RendererTasks&) {
-    if (_vertexBufferData.empty()) {
+    const bool hasData = _gpuPropagation ? _nElements > 0 : !_vertexBufferData.empty();
+    if (!hasData) {
         return;
     }
 
@@ -484,81 +637,105 @@ void RenderableOrbitalKepler::render(const RenderData& data, RendererTasks&) {
         selection == RenderingModePointTrail
     );
 
+    ghoul::opengl::ProgramObject* pointProgram =
+        usesSgp4() ? _sgp4PointProgram :
+        _gpuPropagation ? _gpuPointProgram : _pointProgram;
+    ghoul::opengl::ProgramObject* trailProgram =
+        _gpuPropagation ? _gpuTrailProgram : _trailProgram;
+
+    if (renderPoints && usesSgp4()) {
+        updateSgp4Positions(data.time.j2000Seconds());
+    }
+
     if (renderPoints) {
-        _pointProgram->activate();
-        _pointProgram->setUniform(
+        pointProgram->activate();
+        pointProgram->setUniform(
             _uniformPointCache.modelTransform,
             calcModelTransform(data)
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.viewTransform,
             data.camera.combinedViewMatrix()
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.projectionTransform,
             data.camera.projectionMatrix()
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.cameraPositionWorld,
             data.camera.positionVec3()
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.cameraUpWorld,
             static_cast<glm::vec3>(data.camera.lookUpVectorWorldSpace())
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.inGameTime,
             data.time.j2000Seconds()
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.pointSizeExponent,
             _appearance.pointSizeExponent
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.enableMaxSize,
             _appearance.enableMaxSize
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.enableOutline,
             _appearance.enableOutline
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.outlineColor,
             _appearance.outlineColor
         );
-        _pointProgram->setUniform(
+        pointProgram->setUniform(
             _uniformPointCache.outlineWeight,
             _appearance.outlineWidth
         );
-        _pointProgram->setUniform(_uniformPointCache.color, _appearance.color);
-        _pointProgram->setUniform(_uniformPointCache.maxSize, _appearance.maxSize);
-        _pointProgram->setUniform(_uniformPointCache.opacity, opacity());
-
-        glBindVertexArray(_vertexArray);
-        glMultiDrawArrays(
-            GL_LINE_STRIP,
-            _si,
-            _ss,
-            static_cast<GLsizei>(_startIndex.size())
-        );
+        pointProgram->setUniform(_uniformPointCache.color, _appearance.color);
+        pointProgram->setUniform(_uniformPointCache.maxSize, _appearance.maxSize);
+        pointProgram->setUniform(_uniformPointCache.opacity, opacity());
+
+        if (usesSgp4()) {
+            // A single point per object at the position that was propagated this frame
+            glBindVertexArray(_sgp4VertexArray);
+            glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_sgp4VertexData.size()));
+        }
+        else if (_gpuPropagation) {
+            // A single point per object, positioned by solving Kepler's equation
+            glBindVertexArray(_elementsVertexArray);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _pointIndirectBuffer);
+            glMultiDrawArraysIndirect(GL_POINTS, nullptr, _nElements, 0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+        else {
+            glBindVertexArray(_vertexArray);
+            glMultiDrawArrays(
+                GL_LINE_STRIP,
+                _si,
+                _ss,
+                static_cast<GLsizei>(_startIndex.size())
+            );
+        }
         glBindVertexArray(0);
 
-        _pointProgram->deactivate();
+        pointProgram->deactivate();
     }
 
     if (renderTrails) {
-        _trailProgram->activate();
-        _trailProgram->setUniform(_uniformTrailCache.opacity, opacity());
-        _trailProgram->setUniform(_uniformTrailCache.color, _appearance.color);
-        _trailProgram->setUniform(
+        trailProgram->activate();
+        trailProgram->setUniform(_uniformTrailCache.opacity, opacity());
+        trailProgram->setUniform(_uniformTrailCache.color, _appearance.color);
+        trailProgram->setUniform(
             _uniformTrailCache.inGameTime,
             data.time.j2000Seconds()
         );
-        _trailProgram->setUniform(
+        trailProgram->setUniform(
             _uniformTrailCache.modelView,
             calcModelViewTransform(data)
         );
-        _trailProgram->setUniform(
+        trailProgram->setUniform(
             _uniformTrailCache.projection,
             data.camera.projectionMatrix()
         );
@@ -567,111 +744,93 @@ void RenderableOrbitalKepler::render(const RenderData& data, RendererTasks&) {
         const float fade = pow(
             _appearance.trailFade.maxValue() - _appearance.trailFade, 2.f
         );
-        _trailProgram->setUniform(_uniformTrailCache.trailFadeExponent, fade);
+        trailProgram->setUniform(_uniformTrailCache.trailFadeExponent, fade);
 
         // 0.05 is the "alpha value" for which the trail should no longer be rendered.
         // The value that's compared to 0.05 is calculated in the shader and depends
         // on the distance from the head of the trail to the part that's being rendered.
         // Value is passed as uniform due to it being used in both geometry and fragment
         // shader.
-        _trailProgram->setUniform(_uniformTrailCache.colorFadeCutoffValue, 0.05f);
+        trailProgram->setUniform(_uniformTrailCache.colorFadeCutoffValue, 0.05f);
 
         glLineWidth(_appearance.trailWidth);
 
-        glBindVertexArray(_vertexArray);
-        glMultiDrawArrays(
-            GL_LINE_STRIP,
-            _si,
-            _ss,
-            static_cast<GLsizei>(_startIndex.size())
-        );
+        if (_gpuPropagation) {
+            // One draw command per orbit, where the base instance selects the elements
+            glBindVertexArray(_elementsVertexArray);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBuffer);
+            glMultiDrawArraysIndirect(GL_LINE_STRIP, nullptr, _nElements, 0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+        else {
+            glBindVertexArray(_vertexArray);
+            glMultiDrawArrays(
+                GL_LINE_STRIP,
+                _si,
+                _ss,
+                static_cast<GLsizei>(_startIndex.size())
+            );
+        }
         glBindVertexArray(0);
 
-        _trailProgram->deactivate();
+        trailProgram->deactivate();
     }
 }
 
 void RenderableOrbitalKepler::updateBuffers() {
-    std::vector<kepler::Parameters> parameters = kepler::readFile(
-       _path.value(),
-        _format
-    );
-
-    _numObjects = parameters.size();
-
-    if (_startRenderIdx >= _numObjects) {
-        throw ghoul::RuntimeError(std::format(
-            "Start index {} out of range [0, {}]", _startRenderIdx.value(), _numObjects
-        ));
-    }
-
-    long long endElement = _startRenderIdx + _sizeRender - 1;
-    endElement = (endElement >= _numObjects) ? _numObjects - 1 : endElement;
-    if (endElement < 0 || endElement >= _numObjects) {
-        throw ghoul::RuntimeError(std::format(
-            "End index {} out of range [0, {}]", endElement, _numObjects
-        ));
-    }
-
-    _startRenderIdx.setMaxValue(static_cast<unsigned int>(_numObjects - 1));
-    _sizeRender.setMaxValue(static_cast<unsigned int>(_numObjects));
-    if (_sizeRender == 0u) {
-        _sizeRender = static_cast<unsigned int>(_numObjects);
+    // The parsed file is kept around so that changing which subset of the objects is
+    // rendered does not require the file to be loaded again
+    if (_parametersAreDirty) {
+        _parameters = kepler::readFile(_path.value(), _format);
+        _parametersAreDirty = false;
+
+        // The random selection always uses the same permutation of the objects, so it
+        // only has to be computed once per file
+        _shuffledIndices = std::vector<size_t>(_parameters.size());
+        std::iota(_shuffledIndices.begin(), _shuffledIndices.end(), 0);
+        std::default_random_engine rng;
+        std::shuffle(_shuffledIndices.begin(), _shuffledIndices.end(), rng);
     }
 
-    if (_contiguousMode) {
-        if (_startRenderIdx >= parameters.size() ||
-            (_startRenderIdx + _sizeRender) >= parameters.size())
-        {
-            throw ghoul::RuntimeError(std::format(
-                "Tried to load {} objects but only {} are available",
-                _startRenderIdx + _sizeRender, parameters.size()
-            ));
-        }
+    _numObjects = _parameters.size();
 
-        // Extract subset that starts at _startRenderIdx and contains _sizeRender obejcts
-        parameters = std::vector<kepler::Parameters>(
-            parameters.begin() + _startRenderIdx,
-            parameters.begin() + _startRenderIdx + _sizeRender
-        );
-    }
-    else {
-        // First shuffle the whole array
-        std::default_random_engine rng;
-        std::shuffle(parameters.begin(), parameters.end(), rng);
-
-        // Then take the first _sizeRender values
-        parameters = std::vector<kepler::Parameters>(
-            parameters.begin(),
-            parameters.begin() + _sizeRender
-        );
+    // The buffers contain the orbits of all objects, of which the subset that is rendered
+    // is only selected through the draw commands in updateSubset
+    _objectSegmentSize.clear();
+    _objectStartIndex.clear();
+    _objectSegmentSize.reserve(_parameters.size());
+    _objectStartIndex.reserve(_parameters.size());
+    GLint startIndex = 0;
+    for (const kepler::Parameters& p : _parameters) {
+        const double scale = static_cast<double>(_segmentQuality) * 10.0;
+        const GLint segmentSize =
+            static_cast<GLint>(scale + (scale / pow(1.0 - p.eccentricity, 1.2)));
+        _objectSegmentSize.push_back(segmentSize);
+        _objectStartIndex.push_back(startIndex);
+        startIndex += segmentSize;
     }
 
-    _segmentSize.clear();
-    _startIndex.clear();
-    _startIndex.push_back(0);
-    for (size_t i = 0; i < parameters.size(); i++) {
-        const double scale = static_cast<double>(_segmentQuality) * 10.0;
-        const kepler::Parameters& p = parameters[i];
-        _segmentSize.push_back(
-            static_cast<int>(scale + (scale / pow(1.0 - p.eccentricity, 1.2)))
-        );
-        _startIndex.push_back(_startIndex[i] + static_cast<GLint>(_segmentSize[i]));
+    if (_gpuPropagation) {
+        // The positions are computed in the vertex shader, so only the orbital elements
+        // of each object have to be uploaded
+        _vertexBufferData.clear();
+        updateElementBuffers();
+        updateSubset();
+        return;
     }
-    _startIndex.pop_back();
 
     size_t nVerticesTotal = 0;
 
-    const int numOrbits = static_cast<int>(parameters.size());
+    const int numOrbits = static_cast<int>(_parameters.size());
     for (int i = 0; i < numOrbits; i++) {
-        nVerticesTotal += _segmentSize[i];
+        nVerticesTotal += _objectSegmentSize[i];
     }
     _vertexBufferData.resize(nVerticesTotal);
 
     size_t vertexBufIdx = 0;
     KeplerTranslation keplerTranslator;
     for (int orbitIdx = 0; orbitIdx < numOrbits; ++orbitIdx) {
-        const kepler::Parameters& orbit = parameters[orbitIdx];
+        const kepler::Parameters& orbit = _parameters[orbitIdx];
 
         keplerTranslator.setKeplerElements(
             orbit.eccentricity,
@@ -684,9 +843,9 @@ void RenderableOrbitalKepler::updateBuffers() {
             orbit.epoch
         );
 
-        for (GLint j = 0 ; j < (_segmentSize[orbitIdx]); j++) {
-            const double timeOffset = orbit.period *
-                static_cast<double>(j) / static_cast<double>(_segmentSize[orbitIdx] - 1);
+        for (GLint j = 0 ; j < (_objectSegmentSize[orbitIdx]); j++) {
+            const double timeOffset = orbit.period * static_cast<double>(j) /
+                static_cast<double>(_objectSegmentSize[orbitIdx] - 1);
 
             const glm::dvec3 position = keplerTranslator.position({
                 {},
@@ -730,13 +889,240 @@ void RenderableOrbitalKepler::updateBuffers() {
 
     glBindVertexArray(0);
 
-    double maxSemiMajorAxis = 0.0;
-    for (const kepler::Parameters& kp : parameters) {
-        if (kp.semiMajorAxis > maxSemiMajorAxis) {
-            maxSemiMajorAxis = kp.semiMajorAxis;
+    updateSubset();
+}
+
+void RenderableOrbitalKepler::updateSubset() {
+    if (_numObjects == 0) {
+        _segmentSize.clear();
+        _startIndex.clear();
+        _nElements = 0;
+        _sgp4Batch = sgp4::Batch();
+        _sgp4Positions.clear();
+        _sgp4VertexData.clear();
+        return;
+    }
+
+    if (_startRenderIdx >= _numObjects) {
+        throw ghoul::RuntimeError(std::format(
+            "Start index {} out of range [0, {}]", _startRenderIdx.value(), _numObjects
+        ));
+    }
+
+    long long endElement = _startRenderIdx + _sizeRender - 1;
+    endElement = (endElement >= _numObjects) ? _numObjects - 1 : endElement;
+    if (endElement < 0 || endElement >= _numObjects) {
+        throw ghoul::RuntimeError(std::format(
+            "End index {} out of range [0, {}]", endElement, _numObjects
+        ));
+    }
+
+    _startRenderIdx.setMaxValue(static_cast<unsigned int>(_numObjects - 1));
+    _sizeRender.setMaxValue(static_cast<unsigned int>(_numObjects));
+    if (_sizeRender == 0u) {
+        _sizeRender = static_cast<unsigned int>(_numObjects);
+    }
+
+    std::vector<size_t> selection;
+    selection.reserve(_sizeRender);
+    if (_contiguousMode) {
+        if (_startRenderIdx + _sizeRender > _parameters.size()) {
+            throw ghoul::RuntimeError(std::format(
+                "Tried to load {} objects but only {} are available",
+                _startRenderIdx + _sizeRender, _parameters.size()
+            ));
+        }
+
+        // The subset that starts at _startRenderIdx and contains _sizeRender objects
+        for (unsigned int i = 0; i < _sizeRender; i++) {
+            selection.push_back(_startRenderIdx + i);
         }
     }
+    else {
+        // The first _sizeRender values of the shuffled indices
+        selection.insert(
+            selection.end(),
+            _shuffledIndices.begin(),
+            _shuffledIndices.begin() +
+                std::min<size_t>(_sizeRender, _shuffledIndices.size())
+        );
+    }
+
+    double maxSemiMajorAxis = 0.0;
+    for (size_t i : selection) {
+        maxSemiMajorAxis = std::max(maxSemiMajorAxis, _parameters[i].semiMajorAxis);
+    }
     setBoundingSphere(maxSemiMajorAxis * 1000);
+
+    if (usesSgp4()) {
+        std::vector<kepler::Parameters> selected;
+        selected.reserve(selection.size());
+        for (size_t i : selection) {
+            selected.push_back(_parameters[i]);
+        }
+        _sgp4Batch = sgp4::createBatch(selected);
+        _sgp4Positions.resize(selected.size());
+        _sgp4VertexData.resize(selected.size());
+    }
+    else {
+        _sgp4Batch = sgp4::Batch();
+        _sgp4Positions.clear();
+        _sgp4VertexData.clear();
+    }
+
+    if (_gpuPropagation) {
+        // One command per object for the trails and a single vertex per object for the
+        // points, where the base instance selects the orbital elements
+        std::vector<DrawArraysIndirectCommand> trailCommands;
+        trailCommands.reserve(selection.size());
+        std::vector<DrawArraysIndirectCommand> pointCommands;
+        pointCommands.reserve(selection.size());
+        for (size_t i : selection) {
+            trailCommands.push_back({
+                .count = static_cast<GLuint>(_objectSegmentSize[i]),
+                .instanceCount = 1,
+                .first = 0,
+                .baseInstance = static_cast<GLuint>(i)
+            });
+            pointCommands.push_back({
+                .count = 1,
+                .instanceCount = 1,
+                .first = 0,
+                .baseInstance = static_cast<GLuint>(i)
+            });
+        }
+        _nElements = static_cast<GLsizei>(selection.size());
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _indirectBuffer);
+        glBufferData(
+            GL_DRAW_INDIRECT_BUFFER,
+            trailCommands.size() * sizeof(DrawArraysIndirectCommand),
+            trailCommands.data(),
+            GL_DYNAMIC_DRAW
+        );
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _pointIndirectBuffer);
+        glBufferData(
+            GL_DRAW_INDIRECT_BUFFER,
+            pointCommands.size() * sizeof(DrawArraysIndirectCommand),
+            pointCommands.data(),
+            GL_DYNAMIC_DRAW
+        );
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+    else {
+        _segmentSize.clear();
+        _startIndex.clear();
+        _segmentSize.reserve(selection.size());
+        _startIndex.reserve(selection.size());
+        for (size_t i : selection) {
+            _segmentSize.push_back(_objectSegmentSize[i]);
+            _startIndex.push_back(_objectStartIndex[i]);
+        }
+    }
+}
+
+bool RenderableOrbitalKepler::usesSgp4() const {
+    return _sgp4 && _format != kepler::Format::SBDB;
+}
+
+void RenderableOrbitalKepler::updateSgp4Positions(double time) {
+    sgp4::propagate(_sgp4Batch, time, _sgp4Positions);
+    for (size_t i = 0; i < _sgp4Positions.size(); i++) {
+        _sgp4VertexData[i] = glm::vec3(_sgp4Positions[i]);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _sgp4Buffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        _sgp4VertexData.size() * sizeof(glm::vec3),
+        _sgp4VertexData.data(),
+        GL_STREAM_DRAW
+    );
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void RenderableOrbitalKepler::updateElementBuffers() {
+    std::vector<KeplerElementsLayout> elements;
+    elements.reserve(_parameters.size());
+
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        const kepler::Parameters& p = _parameters[i];
+
+        // Same orientation as in KeplerTranslation::computeOrbitPlane; the semi-major
+        // and semi-minor axes of the ellipse span the orbit plane
+        const glm::dmat3 orbitPlane = glm::dmat3(
+            glm::rotate(glm::radians(p.ascendingNode), glm::dvec3(0.0, 0.0, 1.0)) *
+            glm::rotate(glm::radians(p.inclination), glm::dvec3(1.0, 0.0, 0.0)) *
+            glm::rotate(glm::radians(p.argumentOfPeriapsis), glm::dvec3(0.0, 0.0, 1.0))
+        );
+        const double a = p.semiMajorAxis * 1000.0;
+        const double b = a * std::sqrt(1.0 - p.eccentricity * p.eccentricity);
+
+        KeplerElementsLayout e;
+        e.epoch = p.epoch;
+        e.period = p.period;
+        e.periapsisAxis = glm::vec3(orbitPlane * glm::dvec3(a, 0.0, 0.0));
+        e.eccentricity = static_cast<float>(p.eccentricity);
+        e.semiMinorAxis = glm::vec3(orbitPlane * glm::dvec3(0.0, b, 0.0));
+        e.meanAnomaly = static_cast<float>(glm::radians(p.meanAnomaly));
+        e.nTrailVertices = _objectSegmentSize[i];
+        elements.push_back(e);
+    }
+
+    glBindVertexArray(_elementsVertexArray);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _elementsBuffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        elements.size() * sizeof(KeplerElementsLayout),
+        elements.data(),
+        GL_STATIC_DRAW
+    );
+
+    constexpr GLsizei Stride = sizeof(KeplerElementsLayout);
+    glEnableVertexAttribArray(0);
+    glVertexAttribLPointer(
+        0,
+        2,
+        GL_DOUBLE,
+        Stride,
+        reinterpret_cast<GLvoid*>(offsetof(KeplerElementsLayout, epoch))
+    );
+    glVertexAttribDivisor(0, 1);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        Stride,
+        reinterpret_cast<GLvoid*>(offsetof(KeplerElementsLayout, periapsisAxis))
+    );
+    glVertexAttribDivisor(1, 1);
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(
+        2,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        Stride,
+        reinterpret_cast<GLvoid*>(offsetof(KeplerElementsLayout, semiMinorAxis))
+    );
+    glVertexAttribDivisor(2, 1);
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(
+        3,
+        1,
+        GL_INT,
+        Stride,
+        reinterpret_cast<GLvoid*>(offsetof(KeplerElementsLayout, nTrailVertices))
+    );
+    glVertexAttribDivisor(3, 1);
+
+    glBindVertexArray(0);
 }
 
 } // namespace openspace
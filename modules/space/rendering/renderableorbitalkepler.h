@@ -29,6 +29,7 @@
 
 #include <modules/base/rendering/renderabletrail.h>
 #include <modules/space/kepler.h>
+#include <modules/space/sgp4.h>
 #include <modules/space/translation/keplertranslation.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/uintproperty.h>
@@ -79,9 +80,45 @@ private:
     };
 
     void updateBuffers();
+    void updateUniformCaches();
+
+    /**
+     * Selects the objects that are rendered based on the start index, the size and the
+     * contiguous mode. This only changes the draw commands, as the buffers always
+     * contain the orbits of all loaded objects.
+     */
+    void updateSubset();
+
+    /**
+     * Uploads the Keplerian elements of all loaded objects, from which the shaders
+     * compute the orbits and the current positions of the objects.
+     */
+    void updateElementBuffers();
+
+    /**
+     * Returns whether the points are positioned using SGP4, which requires that the
+     * objects were loaded from a TLE or an OMM file.
+     */
+    bool usesSgp4() const;
+
+    /**
+     * Propagates all rendered objects to the provided \p time using SGP4 and uploads
+     * their positions to the point buffer.
+     */
+    void updateSgp4Positions(double time);
 
     bool _updateDataBuffersAtNextRender = false;
+    bool _updateSubsetAtNextRender = false;
+    /// All objects loaded from the file, of which a subset is rendered
+    std::vector<kepler::Parameters> _parameters;
+    /// The fixed permutation of the objects used when not in contiguous mode
+    std::vector<size_t> _shuffledIndices;
+    bool _parametersAreDirty = true;
     std::streamoff _numObjects;
+    /// Number of trail vertices and the first vertex of each loaded object
+    std::vector<GLint> _objectSegmentSize;
+    std::vector<GLint> _objectStartIndex;
+    /// Number of trail vertices and the first vertex of each rendered object
     std::vector<GLint> _segmentSize;
     std::vector<GLint> _startIndex;
     properties::UIntProperty _segmentQuality;
@@ -104,10 +141,44 @@ private:
     GLuint _vertexArray;
     GLuint _vertexBuffer;
 
+    /// The layout of the per-object buffer when the orbits are propagated on the GPU. The
+    /// orbit plane is stored as two scaled axes, so that the shaders only have to solve
+    /// Kepler's equation to find a position
+    struct KeplerElementsLayout {
+        double epoch = 0.0;
+        double period = 0.0;
+        /// Direction towards the periapsis scaled by the semi-major axis in meters
+        glm::vec3 periapsisAxis = glm::vec3(0.f);
+        float eccentricity = 0.f;
+        /// Direction of the semi-minor axis scaled by its length in meters
+        glm::vec3 semiMinorAxis = glm::vec3(0.f);
+        /// Mean anomaly at the epoch in radians
+        float meanAnomaly = 0.f;
+        GLint nTrailVertices = 0;
+    };
+
+    GLuint _elementsVertexArray = 0;
+    GLuint _elementsBuffer = 0;
+    GLuint _indirectBuffer = 0;
+    GLuint _pointIndirectBuffer = 0;
+    GLsizei _nElements = 0;
+
+    /// The SGP4 coefficients of the rendered objects
+    sgp4::Batch _sgp4Batch;
+    std::vector<glm::dvec3> _sgp4Positions;
+    std::vector<glm::vec3> _sgp4VertexData;
+    GLuint _sgp4VertexArray = 0;
+    GLuint _sgp4Buffer = 0;
+
     ghoul::opengl::ProgramObject* _trailProgram;
     ghoul::opengl::ProgramObject* _pointProgram;
+    ghoul::opengl::ProgramObject* _gpuTrailProgram = nullptr;
+    ghoul::opengl::ProgramObject* _gpuPointProgram = nullptr;
+    ghoul::opengl::ProgramObject* _sgp4PointProgram = nullptr;
     properties::StringProperty _path;
     properties::BoolProperty _contiguousMode;
+    properties::BoolProperty _gpuPropagation;
+    properties::BoolProperty _sgp4;
     kepler::Format _format;
     RenderableOrbitalKepler::Appearance _appearance;
 
@@ -68,14 +68,10 @@ namespace {
 
     constexpr double PARSEC = 0.308567756E17;
 
-    struct ColorVBOLayout {
-        std::array<float, 3> position;
-        float value;
-        float luminance;
-        float absoluteMagnitude;
-    };
-
-    struct VelocityVBOLayout {
+    // Contains the values for all color options, so that the shader can choose between
+    // them and the buffer doesn't have to be recreated when the color option changes.
+    // The values of the other data column are stored in a separate buffer
+    struct StarVBOLayout {
         std::array<float, 3> position;
         float value;
         float luminance;
@@ -84,24 +80,10 @@ namespace {
         float vx; // v_x
         float vy; // v_y
         float vz; // v_z
-    };
-
-    struct SpeedVBOLayout {
-        std::array<float, 3> position;
-        float value;
-        float luminance;
-        float absoluteMagnitude;
 
         float speed;
     };
 
-    struct OtherDataLayout {
-        std::array<float, 3> position;
-        float value;
-        float luminance;
-        float absoluteMagnitude;
-    };
-
     constexpr openspace::properties::Property::PropertyInfo SpeckFileInfo = {
         "SpeckFile",
         "SPECK File",
@@ -563,12 +545,11 @@ RenderableStars::RenderableStars(const ghoul::Dictionary& dictionary)
                 break;
         }
     }
-    _colorOption.onChange([this]() { _dataIsDirty = true; });
     addProperty(_colorOption);
 
 
 
-    _otherDataOption.onChange([this]() { _dataIsDirty = true; });
+    _otherDataOption.onChange([this]() { _otherDataIsDirty = true; });
     addProperty(_otherDataOption);
 
 
@@ -669,6 +650,7 @@ void RenderableStars::initializeGL() {
 
     glGenVertexArrays(1, &_vao);
     glGenBuffers(1, &_vbo);
+    glGenBuffers(1, &_otherDataVbo);
 
     glBindVertexArray(_vao);
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -703,6 +685,9 @@ void RenderableStars::deinitializeGL() {
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
 
+    glDeleteBuffers(1, &_otherDataVbo);
+    _otherDataVbo = 0;
+
     _colorTexture = nullptr;
 
     if (_program) {
@@ -856,6 +841,7 @@ void RenderableStars::update(const UpdateData&) {
         loadData();
         _speckFileIsDirty = false;
         _dataIsDirty = true;
+        _otherDataIsDirty = true;
     }
 
     if (_dataset.entries.empty()) {
@@ -863,10 +849,9 @@ void RenderableStars::update(const UpdateData&) {
     }
 
     if (_dataIsDirty) {
-        const int value = _colorOption;
         LDEBUG("Regenerating data");
 
-        std::vector<float> slice = createDataSlice(ColorOption(value));
+        std::vector<float> slice = createDataSlice();
 
         glBindVertexArray(_vao);
         glBindBuffer(GL_ARRAY_BUFFER, _vbo);
@@ -880,11 +865,10 @@ void RenderableStars::update(const UpdateData&) {
         const GLint positionAttrib = _program->attributeLocation("in_position");
         // in_bvLumAbsMag = bv color, luminosity, abs magnitude
         const GLint bvLumAbsMagAttrib = _program->attributeLocation("in_bvLumAbsMag");
+        const GLint velocityAttrib = _program->attributeLocation("in_velocity");
+        const GLint speedAttrib = _program->attributeLocation("in_speed");
 
-        const size_t nStars = _dataset.entries.size();
-        const size_t nValues = slice.size() / nStars;
-
-        const GLsizei stride = static_cast<GLsizei>(sizeof(GLfloat) * nValues);
+        constexpr GLsizei Stride = sizeof(StarVBOLayout);
 
         glEnableVertexAttribArray(positionAttrib);
         glVertexAttribPointer(
@@ -892,89 +876,69 @@ void RenderableStars::update(const UpdateData&) {
             3,
             GL_FLOAT,
             GL_FALSE,
-            stride,
-            nullptr
+            Stride,
+            reinterpret_cast<void*>(offsetof(StarVBOLayout, position))
         );
 
         glEnableVertexAttribArray(bvLumAbsMagAttrib);
-        const int colorOption = _colorOption;
-        switch (colorOption) {
-            case ColorOption::Color:
-            case ColorOption::FixedColor:
-                glVertexAttribPointer(
-                    bvLumAbsMagAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    reinterpret_cast<void*>(offsetof(ColorVBOLayout, value))
-                );
+        glVertexAttribPointer(
+            bvLumAbsMagAttrib,
+            3,
+            GL_FLOAT,
+            GL_FALSE,
+            Stride,
+            reinterpret_cast<void*>(offsetof(StarVBOLayout, value))
+        );
 
-                break;
-            case ColorOption::Velocity:
-            {
-                glVertexAttribPointer(
-                    bvLumAbsMagAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    reinterpret_cast<void*>(offsetof(VelocityVBOLayout, value))
-                );
-
-                const GLint velocityAttrib = _program->attributeLocation("in_velocity");
-                glEnableVertexAttribArray(velocityAttrib);
-                glVertexAttribPointer(
-                    velocityAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_TRUE,
-                    stride,
-                    reinterpret_cast<void*>(offsetof(VelocityVBOLayout, vx))
-                );
+        glEnableVertexAttribArray(velocityAttrib);
+        glVertexAttribPointer(
+            velocityAttrib,
+            3,
+            GL_FLOAT,
+            GL_TRUE,
+            Stride,
+            reinterpret_cast<void*>(offsetof(StarVBOLayout, vx))
+        );
 
-                break;
-            }
-            case ColorOption::Speed:
-            {
-                glVertexAttribPointer(
-                    bvLumAbsMagAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    reinterpret_cast<void*>(offsetof(SpeedVBOLayout, value))
-                );
-
-                const GLint speedAttrib = _program->attributeLocation("in_speed");
-                glEnableVertexAttribArray(speedAttrib);
-                glVertexAttribPointer(
-                    speedAttrib,
-                    1,
-                    GL_FLOAT,
-                    GL_TRUE,
-                    stride,
-                    reinterpret_cast<void*>(offsetof(SpeedVBOLayout, speed))
-                );
-                break;
-            }
-            case ColorOption::OtherData:
-                glVertexAttribPointer(
-                    bvLumAbsMagAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    reinterpret_cast<void*>(offsetof(OtherDataLayout, value))
-                );
-                break;
-        }
+        glEnableVertexAttribArray(speedAttrib);
+        glVertexAttribPointer(
+            speedAttrib,
+            1,
+            GL_FLOAT,
+            GL_TRUE,
+            Stride,
+            reinterpret_cast<void*>(offsetof(StarVBOLayout, speed))
+        );
 
         glBindVertexArray(0);
 
         _dataIsDirty = false;
     }
 
+    if (_otherDataIsDirty) {
+        LDEBUG("Regenerating other data");
+
+        // Only the selected column is uploaded, which is a single value per star
+        std::vector<float> slice = createOtherDataSlice();
+
+        glBindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _otherDataVbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            slice.size() * sizeof(GLfloat),
+            slice.data(),
+            GL_STATIC_DRAW
+        );
+
+        const GLint otherDataAttrib = _program->attributeLocation("in_otherData");
+        glEnableVertexAttribArray(otherDataAttrib);
+        glVertexAttribPointer(otherDataAttrib, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+        glBindVertexArray(0);
+
+        _otherDataIsDirty = false;
+    }
+
     if (_pointSpreadFunctionTextureIsDirty) {
         LDEBUG("Reloading Point Spread Function texture");
         loadPSFTexture();
@@ -1050,7 +1014,7 @@ void RenderableStars::loadData() {
     }
 }
 
-std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
+std::vector<float> RenderableStars::createDataSlice() {
     const int bvIdx = std::max(_dataset.index(_dataMapping.bvColor), 0);
     const int lumIdx = std::max(_dataset.index(_dataMapping.luminance), 0);
     const int absMagIdx = std::max(_dataset.index(_dataMapping.absoluteMagnitude), 0);
@@ -1059,109 +1023,67 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
     const int vzIdx = std::max(_dataset.index(_dataMapping.vz), 0);
     const int speedIdx = std::max(_dataset.index(_dataMapping.speed), 0);
 
-    _otherDataRange = glm::vec2(
-        std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max()
-    );
-
     double maxRadius = 0.0;
 
+    constexpr size_t NValues = sizeof(StarVBOLayout) / sizeof(float);
     std::vector<float> result;
-    // 6 for the default Color option of 3 positions + bv + lum + abs
-    result.reserve(_dataset.entries.size() * 6);
-    for (const dataloader::Dataset::Entry& e : _dataset.entries) {
+    result.reserve(_dataset.entries.size() * NValues);
+    for (const dataloader::Dataset::EntryView e : _dataset.entries) {
         glm::dvec3 position = glm::dvec3(e.position) * distanceconstants::Parsec;
         glm::vec3 pos = position;
         maxRadius = std::max(maxRadius, glm::length(position));
 
-        switch (option) {
-            case ColorOption::Color:
-            case ColorOption::FixedColor:
-            {
-                union {
-                    ColorVBOLayout value;
-                    std::array<float, sizeof(ColorVBOLayout) / sizeof(float)> data;
-                } layout;
-
-                layout.value.position = { pos.x, pos.y, pos.z };
-                layout.value.value = e.data[bvIdx];
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-
-                result.insert(result.end(), layout.data.begin(), layout.data.end());
-                break;
-            }
-            case ColorOption::Velocity:
-            {
-                union {
-                    VelocityVBOLayout value;
-                    std::array<float, sizeof(VelocityVBOLayout) / sizeof(float)> data;
-                } layout;
-
-                layout.value.position = { pos.x, pos.y, pos.z };
-                layout.value.value = e.data[bvIdx];
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-
-                layout.value.vx = e.data[vxIdx];
-                layout.value.vy = e.data[vyIdx];
-                layout.value.vz = e.data[vzIdx];
-
-                result.insert(result.end(), layout.data.begin(), layout.data.end());
-                break;
-            }
-            case ColorOption::Speed:
-            {
-                union {
-                    SpeedVBOLayout value;
-                    std::array<float, sizeof(SpeedVBOLayout) / sizeof(float)> data;
-                } layout;
-
-                layout.value.position = { pos.x, pos.y, pos.z };
-                layout.value.value = e.data[bvIdx];
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-                layout.value.speed = e.data[speedIdx];
-
-                result.insert(result.end(), layout.data.begin(), layout.data.end());
-                break;
-            }
-            case ColorOption::OtherData:
-            {
-                union {
-                    OtherDataLayout value;
-                    std::array<float, sizeof(OtherDataLayout)> data;
-                } layout = {};
-
-                layout.value.position = { pos.x, pos.y, pos.z };
-
-                const int index = _otherDataOption.value();
-                // plus 3 because of the position
-                layout.value.value = e.data[index];
-
-                if (_staticFilterValue.has_value() && e.data[index] == _staticFilterValue)
-                {
-                    layout.value.value = _staticFilterReplacementValue;
-                }
-
-                glm::vec2 range = _otherDataRange;
-                range.x = std::min(range.x, layout.value.value);
-                range.y = std::max(range.y, layout.value.value);
-                _otherDataRange = range;
-                _otherDataRange.setMinValue(glm::vec2(range.x));
-                _otherDataRange.setMaxValue(glm::vec2(range.y));
-
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-
-                result.insert(result.end(), layout.data.begin(), layout.data.end());
-                break;
-            }
-        }
+        union {
+            StarVBOLayout value;
+            std::array<float, NValues> data;
+        } layout;
+
+        layout.value.position = { pos.x, pos.y, pos.z };
+        layout.value.value = e.data[bvIdx];
+        layout.value.luminance = e.data[lumIdx];
+        layout.value.absoluteMagnitude = e.data[absMagIdx];
+
+        layout.value.vx = e.data[vxIdx];
+        layout.value.vy = e.data[vyIdx];
+        layout.value.vz = e.data[vzIdx];
+
+        layout.value.speed = e.data[speedIdx];
+
+        result.insert(result.end(), layout.data.begin(), layout.data.end());
     }
 
     setBoundingSphere(maxRadius);
     return result;
 }
 
+std::vector<float> RenderableStars::createOtherDataSlice() {
+    if (_dataset.variables.empty()) {
+        return std::vector<float>(_dataset.entries.size(), 0.f);
+    }
+    const int index = std::max(_otherDataOption.value(), 0);
+
+    glm::vec2 range = glm::vec2(
+        std::numeric_limits<float>::max(),
+        -std::numeric_limits<float>::max()
+    );
+
+    std::vector<float> result;
+    result.reserve(_dataset.entries.size());
+    for (const dataloader::Dataset::EntryView e : _dataset.entries) {
+        float value = e.data[index];
+        if (_staticFilterValue.has_value() && value == _staticFilterValue) {
+            value = _staticFilterReplacementValue;
+        }
+
+        range.x = std::min(range.x, value);
+        range.y = std::max(range.y, value);
+        result.push_back(value);
+    }
+
+    _otherDataRange = range;
+    _otherDataRange.setMinValue(glm::vec2(range.x));
+    _otherDataRange.setMaxValue(glm::vec2(range.y));
+    return result;
+}
+
 } // namespace openspace
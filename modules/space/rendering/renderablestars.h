@@ -75,7 +75,19 @@ private:
 
     void loadPSFTexture();
     void loadData();
-    std::vector<float> createDataSlice(ColorOption option);
+
+    /**
+     * Creates the interleaved vertex data with the position and all values that are
+     * needed by the color options for all stars, so that the color option can be changed
+     * without updating the vertex buffer.
+     */
+    std::vector<float> createDataSlice();
+
+    /**
+     * Creates the values of the currently selected other data column for all stars and
+     * updates the range of values that are mapped onto the other data color map.
+     */
+    std::vector<float> createOtherDataSlice();
 
     properties::StringProperty _speckFile;
 
@@ -142,6 +154,7 @@ private:
     bool _pointSpreadFunctionTextureIsDirty = true;
     bool _colorTextureIsDirty = true;
     bool _dataIsDirty = true;
+    bool _otherDataIsDirty = true;
     bool _otherDataColorMapIsDirty = true;
 
     dataloader::Dataset _dataset;
@@ -153,6 +166,7 @@ private:
 
     GLuint _vao = 0;
     GLuint _vbo = 0;
+    GLuint _otherDataVbo = 0;
 };
 
 } // namespace openspace
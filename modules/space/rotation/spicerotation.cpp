@@ -124,7 +124,7 @@ SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
 }
 
 glm::dmat3 SpiceRotation::matrix(const UpdateData& data) const {
-    if (_timeFrame && !_timeFrame->isActive(data.time)) {
+    if (_timeFrame && !_timeFrame->isActiveCached(data.time)) {
         return glm::dmat3(1.0);
     }
     double time = data.time.j2000Seconds();
@@ -138,4 +138,9 @@ glm::dmat3 SpiceRotation::matrix(const UpdateData& data) const {
     );
 }
 
+bool SpiceRotation::supportsParallelUpdate() const {
+    // All accesses to the SpiceManager are serialized
+    return true;
+}
+
 } // namespace openspace
@@ -41,6 +41,7 @@ public:
 
     const glm::dmat3& matrix() const;
     glm::dmat3 matrix(const UpdateData& data) const override;
+    bool supportsParallelUpdate() const override;
 
     static documentation::Documentation Documentation();
 
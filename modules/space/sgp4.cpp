@@ -0,0 +1,367 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/sgp4.h>
+
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // WGS-72 constants that the general perturbation element sets are fitted with
+    constexpr double Mu = 398600.8; // km^3 / s^2
+    constexpr double EarthRadius = 6378.135; // km
+    constexpr double J2 = 0.001082616;
+    constexpr double J3 = -0.00000253881;
+    constexpr double J4 = -0.00000165597;
+    constexpr double J3OverJ2 = J3 / J2;
+    constexpr double TwoThirds = 2.0 / 3.0;
+    constexpr double TwoPi = glm::two_pi<double>();
+
+    // The element sets with a longer period (in minutes) require the deep-space model
+    constexpr double DeepSpacePeriod = 225.0;
+
+    // The number of Newton iterations that are used to solve Kepler's equation. The
+    // iterations are not stopped early so that all element sets execute the same code
+    constexpr int NewtonIterations = 10;
+
+    // Square root of Earth's gravitational parameter in units of Earth radii per minute
+    double xke() {
+        return 60.0 / std::sqrt(EarthRadius * EarthRadius * EarthRadius / Mu);
+    }
+
+    // Converts the mean motion to radians per minute
+    double meanMotionFromPeriod(double period) {
+        return TwoPi / (period / 60.0);
+    }
+} // namespace
+
+namespace openspace::sgp4 {
+
+size_t Batch::size() const {
+    return epoch.size();
+}
+
+bool isNearEarth(const kepler::Parameters& parameters) {
+    return parameters.period / 60.0 < DeepSpacePeriod;
+}
+
+Batch createBatch(std::span<const kepler::Parameters> parameters) {
+    const double XKE = xke();
+
+    Batch b;
+    const size_t n = parameters.size();
+    for (std::vector<double>* v : {
+            &b.epoch, &b.bstar, &b.inclination, &b.ascendingNode, &b.eccentricity,
+            &b.argumentOfPeriapsis, &b.meanAnomaly, &b.meanMotion, &b.cosInclination,
+            &b.sinInclination, &b.aycof, &b.con41, &b.cc1, &b.cc4, &b.cc5, &b.d2, &b.d3,
+            &b.d4, &b.delmo, &b.eta, &b.argpdot, &b.omgcof, &b.sinmao, &b.t2cof,
+            &b.t3cof, &b.t4cof, &b.t5cof, &b.x1mth2, &b.x7thm1, &b.mdot, &b.nodedot,
+            &b.xlcof, &b.xmcof, &b.nodecf
+        })
+    {
+        v->resize(n, 0.0);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        const kepler::Parameters& p = parameters[i];
+        if (!isNearEarth(p)) {
+            b.deepSpace.push_back(i);
+        }
+
+        const double ecco = p.eccentricity;
+        const double inclo = glm::radians(p.inclination);
+        const double argpo = glm::radians(p.argumentOfPeriapsis);
+        const double mo = glm::radians(p.meanAnomaly);
+        const double bstar = p.bstar;
+        const double noKozai = meanMotionFromPeriod(p.period);
+
+        // Recover the original mean motion and semi-major axis from the Kozai mean
+        // motion that is provided in the element sets
+        const double eccsq = ecco * ecco;
+        const double omeosq = 1.0 - eccsq;
+        const double rteosq = std::sqrt(omeosq);
+        const double cosio = std::cos(inclo);
+        const double sinio = std::sin(inclo);
+        const double cosio2 = cosio * cosio;
+
+        const double ak = std::pow(XKE / noKozai, TwoThirds);
+        const double d1 = 0.75 * J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+        double del = d1 / (ak * ak);
+        const double adel =
+            ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+        del = d1 / (adel * adel);
+        const double no = noKozai / (1.0 + del);
+        const double ao = std::pow(XKE / no, TwoThirds);
+        const double po = ao * omeosq;
+        const double con42 = 1.0 - 5.0 * cosio2;
+        const double con41 = -con42 - cosio2 - cosio2;
+        const double posq = po * po;
+        const double rp = ao * (1.0 - ecco);
+
+        // Orbits with a perigee of less than 220 km use a simplified drag model
+        const bool isSimple = rp < (220.0 / EarthRadius + 1.0);
+
+        // Adjust the atmospheric density parameters for low perigees
+        double sfour = 78.0 / EarthRadius + 1.0;
+        double qzms24 = std::pow((120.0 - 78.0) / EarthRadius, 4.0);
+        const double perigee = (rp - 1.0) * EarthRadius;
+        if (perigee < 156.0) {
+            sfour = perigee < 98.0 ? 20.0 : perigee - 78.0;
+            qzms24 = std::pow((120.0 - sfour) / EarthRadius, 4.0);
+            sfour = sfour / EarthRadius + 1.0;
+        }
+
+        const double pinvsq = 1.0 / posq;
+        const double tsi = 1.0 / (ao - sfour);
+        const double eta = ao * ecco * tsi;
+        const double etasq = eta * eta;
+        const double eeta = ecco * eta;
+        const double psisq = std::abs(1.0 - etasq);
+        const double coef = qzms24 * std::pow(tsi, 4.0);
+        const double coef1 = coef / std::pow(psisq, 3.5);
+        const double cc2 = coef1 * no * (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+            0.375 * J2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+        const double cc1 = bstar * cc2;
+        const double cc3 =
+            ecco > 1e-4 ? -2.0 * coef * tsi * J3OverJ2 * no * sinio / ecco : 0.0;
+        const double x1mth2 = 1.0 - cosio2;
+        const double cc4Drag =
+            -3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+            0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * std::cos(2.0 * argpo);
+        const double cc4 = 2.0 * no * coef1 * ao * omeosq *
+            (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+            J2 * tsi / (ao * psisq) * cc4Drag);
+        const double cc5 =
+            2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+        const double cosio4 = cosio2 * cosio2;
+        const double temp1 = 1.5 * J2 * pinvsq * no;
+        const double temp2 = 0.5 * temp1 * J2 * pinvsq;
+        const double temp3 = -0.46875 * J4 * pinvsq * pinvsq * no;
+        const double mdot = no + 0.5 * temp1 * rteosq * con41 +
+            0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+        const double argpdot = -0.5 * temp1 * con42 +
+            0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+            temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+        const double xhdot1 = -temp1 * cosio;
+        const double nodedot = xhdot1 +
+            (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) *
+            cosio;
+
+        // Avoid the division by zero for orbits with an inclination of 180 degrees
+        const double xlcofDenom = std::max(std::abs(1.0 + cosio), 1.5e-12);
+
+        b.epoch[i] = p.epoch;
+        b.bstar[i] = bstar;
+        b.inclination[i] = inclo;
+        b.ascendingNode[i] = glm::radians(p.ascendingNode);
+        b.eccentricity[i] = ecco;
+        b.argumentOfPeriapsis[i] = argpo;
+        b.meanAnomaly[i] = mo;
+        b.meanMotion[i] = no;
+        b.cosInclination[i] = cosio;
+        b.sinInclination[i] = sinio;
+        b.aycof[i] = -0.5 * J3OverJ2 * sinio;
+        b.con41[i] = con41;
+        b.cc1[i] = cc1;
+        b.cc4[i] = cc4;
+        b.eta[i] = eta;
+        b.argpdot[i] = argpdot;
+        b.sinmao[i] = std::sin(mo);
+        b.t2cof[i] = 1.5 * cc1;
+        b.x1mth2[i] = x1mth2;
+        b.x7thm1[i] = 7.0 * cosio2 - 1.0;
+        b.mdot[i] = mdot;
+        b.nodedot[i] = nodedot;
+        b.xlcof[i] = -0.25 * J3OverJ2 * sinio * (3.0 + 5.0 * cosio) / xlcofDenom;
+        b.nodecf[i] = 3.5 * omeosq * xhdot1 * cc1;
+
+        // The higher-order drag terms are left at 0 for the simplified drag model, which
+        // lets all element sets share the same propagation code
+        if (!isSimple) {
+            const double delmotemp = 1.0 + eta * std::cos(mo);
+            const double cc1sq = cc1 * cc1;
+            const double d2 = 4.0 * ao * tsi * cc1sq;
+            const double temp = d2 * tsi * cc1 / 3.0;
+            const double d3 = (17.0 * ao + sfour) * temp;
+            const double d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+
+            b.cc5[i] = cc5;
+            b.delmo[i] = delmotemp * delmotemp * delmotemp;
+            b.omgcof[i] = bstar * cc3 * std::cos(argpo);
+            b.xmcof[i] = ecco > 1e-4 ? -TwoThirds * coef * bstar / eeta : 0.0;
+            b.d2[i] = d2;
+            b.d3[i] = d3;
+            b.d4[i] = d4;
+            b.t3cof[i] = d2 + 2.0 * cc1sq;
+            b.t4cof[i] = 0.25 * (3.0 * d3 + cc1 * (12.0 * d2 + 10.0 * cc1sq));
+            b.t5cof[i] = 0.2 * (3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 +
+                15.0 * cc1sq * (2.0 * d2 + cc1sq));
+        }
+    }
+
+    return b;
+}
+
+void propagate(const Batch& b, double time, std::span<glm::dvec3> positions) {
+    ghoul_assert(positions.size() == b.size(), "Positions must match the batch size");
+
+    const double XKE = xke();
+    const size_t n = b.size();
+
+    for (size_t i = 0; i < n; i++) {
+        const double t = (time - b.epoch[i]) / 60.0;
+        const double t2 = t * t;
+        const double t3 = t2 * t;
+        const double t4 = t3 * t;
+
+        // Secular effects of the atmospheric drag and gravitation
+        const double xmdf = b.meanAnomaly[i] + b.mdot[i] * t;
+        const double argpdf = b.argumentOfPeriapsis[i] + b.argpdot[i] * t;
+        const double nodedf = b.ascendingNode[i] + b.nodedot[i] * t;
+        const double delmtemp = 1.0 + b.eta[i] * std::cos(xmdf);
+        const double delm =
+            b.xmcof[i] * (delmtemp * delmtemp * delmtemp - b.delmo[i]);
+        const double delta = b.omgcof[i] * t + delm;
+        double mm = xmdf + delta;
+        double argpm = argpdf - delta;
+        double nodem = nodedf + b.nodecf[i] * t2;
+
+        const double tempa =
+            1.0 - b.cc1[i] * t - b.d2[i] * t2 - b.d3[i] * t3 - b.d4[i] * t4;
+        const double tempe = b.bstar[i] * b.cc4[i] * t +
+            b.bstar[i] * b.cc5[i] * (std::sin(mm) - b.sinmao[i]);
+        const double templ = b.t2cof[i] * t2 + b.t3cof[i] * t3 +
+            t4 * (b.t4cof[i] + t * b.t5cof[i]);
+
+        const double am = std::pow(XKE / b.meanMotion[i], TwoThirds) * tempa * tempa;
+        const double emRaw = b.eccentricity[i] - tempe;
+        const double em = std::max(emRaw, 1e-6);
+        mm += b.meanMotion[i] * templ;
+        const double xlm = std::fmod(mm + argpm + nodem, TwoPi);
+        nodem = std::fmod(nodem, TwoPi);
+        argpm = std::fmod(argpm, TwoPi);
+        mm = std::fmod(xlm - argpm - nodem, TwoPi);
+
+        // Long period periodics
+        const double axnl = em * std::cos(argpm);
+        double temp = 1.0 / (am * (1.0 - em * em));
+        const double aynl = em * std::sin(argpm) + temp * b.aycof[i];
+        const double xl = mm + argpm + nodem + temp * b.xlcof[i] * axnl;
+
+        // Solve Kepler's equation
+        const double u = std::fmod(xl - nodem, TwoPi);
+        double eo1 = u;
+        for (int k = 0; k < NewtonIterations; k++) {
+            const double s = std::sin(eo1);
+            const double c = std::cos(eo1);
+            const double step = (u - aynl * c + axnl * s - eo1) /
+                (1.0 - c * axnl - s * aynl);
+            eo1 += std::clamp(step, -0.95, 0.95);
+        }
+        const double sineo1 = std::sin(eo1);
+        const double coseo1 = std::cos(eo1);
+
+        // Short period preliminary quantities
+        const double ecose = axnl * coseo1 + aynl * sineo1;
+        const double esine = axnl * sineo1 - aynl * coseo1;
+        const double el2 = axnl * axnl + aynl * aynl;
+        const double pl = am * (1.0 - el2);
+        const double rl = am * (1.0 - ecose);
+        const double betal = std::sqrt(std::max(1.0 - el2, 0.0));
+        temp = esine / (1.0 + betal);
+        const double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+        const double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+        double su = std::atan2(sinu, cosu);
+        const double sin2u = (cosu + cosu) * sinu;
+        const double cos2u = 1.0 - 2.0 * sinu * sinu;
+        temp = 1.0 / pl;
+        const double temp1 = 0.5 * J2 * temp;
+        const double temp2 = temp1 * temp;
+
+        // Update for the short period periodics
+        const double mrt = rl * (1.0 - 1.5 * temp2 * betal * b.con41[i]) +
+            0.5 * temp1 * b.x1mth2[i] * cos2u;
+        su -= 0.25 * temp2 * b.x7thm1[i] * sin2u;
+        const double xnode = nodem + 1.5 * temp2 * b.cosInclination[i] * sin2u;
+        const double xinc = b.inclination[i] +
+            1.5 * temp2 * b.cosInclination[i] * b.sinInclination[i] * cos2u;
+
+        // Orientation vectors
+        const double sinsu = std::sin(su);
+        const double cossu = std::cos(su);
+        const double snod = std::sin(xnode);
+        const double cnod = std::cos(xnode);
+        const double sini = std::sin(xinc);
+        const double cosi = std::cos(xinc);
+        const double xmx = -snod * cosi;
+        const double xmy = cnod * cosi;
+        const glm::dvec3 dir = glm::dvec3(
+            xmx * sinsu + cnod * cossu,
+            xmy * sinsu + snod * cossu,
+            sini * sinsu
+        );
+
+        // Satellites that have decayed or whose elements have become invalid are placed
+        // at the origin instead
+        const bool isValid = emRaw < 1.0 && emRaw >= -0.001 && pl >= 0.0 && mrt >= 1.0;
+        const double r = isValid ? mrt * EarthRadius * 1000.0 : 0.0;
+        positions[i] = dir * r;
+    }
+
+    // The element sets that require the deep-space model are propagated as unperturbed
+    // Kepler orbits instead
+    for (size_t i : b.deepSpace) {
+        const double t = (time - b.epoch[i]) / 60.0;
+        const double e = b.eccentricity[i];
+        const double a = std::pow(XKE / b.meanMotion[i], TwoThirds);
+        const double meanAnomaly =
+            std::fmod(b.meanAnomaly[i] + b.meanMotion[i] * t, TwoPi);
+
+        double ea = meanAnomaly;
+        for (int k = 0; k < NewtonIterations; k++) {
+            ea -= (ea - e * std::sin(ea) - meanAnomaly) / (1.0 - e * std::cos(ea));
+        }
+        const double x = a * (std::cos(ea) - e);
+        const double y = a * std::sqrt(1.0 - e * e) * std::sin(ea);
+
+        const double cw = std::cos(b.argumentOfPeriapsis[i]);
+        const double sw = std::sin(b.argumentOfPeriapsis[i]);
+        const double cn = std::cos(b.ascendingNode[i]);
+        const double sn = std::sin(b.ascendingNode[i]);
+        const double ci = b.cosInclination[i];
+        const double si = b.sinInclination[i];
+
+        const double xp = x * cw - y * sw;
+        const double yp = x * sw + y * cw;
+        positions[i] = glm::dvec3(
+            xp * cn - yp * ci * sn,
+            xp * sn + yp * ci * cn,
+            yp * si
+        ) * EarthRadius * 1000.0;
+    }
+}
+
+} // namespace openspace::sgp4
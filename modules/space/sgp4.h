@@ -0,0 +1,120 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___SGP4___H__
+#define __OPENSPACE_MODULE_SPACE___SGP4___H__
+
+#include <modules/space/kepler.h>
+
+#include <ghoul/glm.h>
+#include <span>
+#include <vector>
+
+namespace openspace::sgp4 {
+
+/**
+ * The precomputed SGP4 coefficients of a number of general perturbation element sets.
+ * Every coefficient is stored in its own array, so that the loop that propagates all
+ * element sets at once does not branch per element and can be vectorized by the
+ * compiler. The implementation follows the near-Earth part of the revised SGP4 model by
+ * Vallado et al. (2006) using the WGS-72 constants that the element sets are fitted with.
+ *
+ * Element sets with a period of 225 minutes or more would require the deep-space
+ * perturbations of SDP4. Those are instead propagated as unperturbed Kepler orbits.
+ */
+struct Batch {
+    std::vector<double> epoch;
+    std::vector<double> bstar;
+    std::vector<double> inclination;
+    std::vector<double> ascendingNode;
+    std::vector<double> eccentricity;
+    std::vector<double> argumentOfPeriapsis;
+    std::vector<double> meanAnomaly;
+    std::vector<double> meanMotion;
+    std::vector<double> cosInclination;
+    std::vector<double> sinInclination;
+
+    std::vector<double> aycof;
+    std::vector<double> con41;
+    std::vector<double> cc1;
+    std::vector<double> cc4;
+    std::vector<double> cc5;
+    std::vector<double> d2;
+    std::vector<double> d3;
+    std::vector<double> d4;
+    std::vector<double> delmo;
+    std::vector<double> eta;
+    std::vector<double> argpdot;
+    std::vector<double> omgcof;
+    std::vector<double> sinmao;
+    std::vector<double> t2cof;
+    std::vector<double> t3cof;
+    std::vector<double> t4cof;
+    std::vector<double> t5cof;
+    std::vector<double> x1mth2;
+    std::vector<double> x7thm1;
+    std::vector<double> mdot;
+    std::vector<double> nodedot;
+    std::vector<double> xlcof;
+    std::vector<double> xmcof;
+    std::vector<double> nodecf;
+
+    /// The indices of the element sets that are propagated as Kepler orbits
+    std::vector<size_t> deepSpace;
+
+    size_t size() const;
+};
+
+/**
+ * Returns whether the element set \p parameters can be propagated with the near-Earth
+ * SGP4 model, which is the case for all orbits with a period of less than 225 minutes.
+ */
+bool isNearEarth(const kepler::Parameters& parameters);
+
+/**
+ * Computes the SGP4 coefficients of all element sets in \p parameters.
+ *
+ * \param parameters The general perturbation element sets, usually loaded from a TLE or
+ *        an OMM file
+ * \return The coefficients of the element sets in the same order as \p parameters
+ */
+Batch createBatch(std::span<const kepler::Parameters> parameters);
+
+/**
+ * Propagates all element sets in the \p batch to the provided \p time and writes their
+ * positions in the TEME reference frame, in meters, into \p positions. Element sets that
+ * can not be propagated to the \p time, for example because the satellite has decayed,
+ * are placed at the origin.
+ *
+ * \param batch The coefficients of the element sets that are propagated
+ * \param time The time in seconds past the J2000 epoch
+ * \param positions The resulting positions in the same order as the element sets
+ *
+ * \pre \p positions must have the same size as the \p batch
+ */
+void propagate(const Batch& batch, double time, std::span<glm::dvec3> positions);
+
+} // namespace openspace::sgp4
+
+#endif // __OPENSPACE_MODULE_SPACE___SGP4___H__
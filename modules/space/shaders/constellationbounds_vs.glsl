@@ -27,13 +27,26 @@
 #include "PowerScaling/powerScaling_vs.hglsl"
 
 layout(location = 0) in vec3 in_position;
+layout(location = 1) in uint in_constellation;
 out vec4 vs_position;
 
 uniform mat4 ViewProjection;
 uniform mat4 ModelTransform;
 
+// One bit per constellation, set if the constellation is enabled
+layout(std430) readonly buffer ConstellationVisibility {
+  uint visibility[];
+};
+
 
 void main() {
+  if ((visibility[in_constellation / 32] & (1u << (in_constellation % 32))) == 0u) {
+    // Place the vertex outside the clip volume so that the whole line gets clipped
+    vs_position = vec4(0.0);
+    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    return;
+  }
+
   vec4 tmp = vec4(in_position, 0.0);
   vs_position = tmp;
 
@@ -24,10 +24,10 @@
 
 #include "fragment.glsl"
 
+in vec3 vs_color;
 in float vs_screenSpaceDepth;
 in vec4 vs_positionViewSpace;
 
-uniform vec3 color;
 uniform float opacity;
 
 
@@ -37,7 +37,7 @@ Fragment getFragment() {
     discard;
   }
 
-  frag.color = vec4(color, opacity);
+  frag.color = vec4(vs_color, opacity);
   frag.depth = vs_screenSpaceDepth;
 
   frag.gPosition = vs_positionViewSpace;
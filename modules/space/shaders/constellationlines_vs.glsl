@@ -26,16 +26,34 @@
 
 #include "PowerScaling/powerScaling_vs.hglsl"
 
-in vec3 in_position;
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_color;
+layout(location = 2) in uint in_constellation;
 
+out vec3 vs_color;
 out float vs_screenSpaceDepth;
 out vec4 vs_positionViewSpace;
 
 uniform dmat4 modelViewTransform;
 uniform dmat4 projectionTransform;
 
+// One bit per constellation, set if the constellation is enabled
+layout(std430) readonly buffer ConstellationVisibility {
+  uint visibility[];
+};
+
 
 void main() {
+  vs_color = in_color;
+
+  if ((visibility[in_constellation / 32] & (1u << (in_constellation % 32))) == 0u) {
+    // Place the vertex outside the clip volume so that the whole line gets clipped
+    vs_screenSpaceDepth = 0.0;
+    vs_positionViewSpace = vec4(0.0);
+    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    return;
+  }
+
   dvec4 positionViewSpace = modelViewTransform * dvec4(in_position, 1.0);
   vec4 positionClipSpace = vec4(projectionTransform * positionViewSpace);
   vec4 positionScreenSpace = vec4(z_normalization(positionClipSpace));
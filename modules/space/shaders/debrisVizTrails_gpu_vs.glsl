@@ -0,0 +1,48 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#version __CONTEXT__
+
+#include "PowerScaling/powerScalingMath.hglsl"
+#include <${MODULE_SPACE}/shaders/keplerPropagation.glsl>
+
+flat out float currentRevolutionFraction;
+flat out float vertexRevolutionFraction;
+flat out vec4 viewSpacePositions;
+
+uniform dmat4 modelViewTransform;
+uniform mat4 projectionTransform;
+uniform double inGameTime;
+
+void main() {
+  // Each orbit is drawn as its own indirect draw command, so the vertex id is the index
+  // of the vertex along the orbit. The vertices are evenly spaced in time over one
+  // revolution starting at the epoch, same as for the precomputed orbits
+  currentRevolutionFraction = revolutionFractionAt(inGameTime);
+  vertexRevolutionFraction = float(gl_VertexID) / float(max(nTrailVertices - 1, 1));
+
+  vec3 position = keplerPosition(vertexRevolutionFraction);
+  viewSpacePositions = vec4(modelViewTransform * dvec4(position, 1.0));
+  gl_Position = z_normalization(projectionTransform * viewSpacePositions);
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef KEPLER_PROPAGATION
+#define KEPLER_PROPAGATION
+
+// The Keplerian elements of one object, which are advanced once per instance. See the
+// KeplerElementsLayout in RenderableOrbitalKepler
+layout(location = 0) in dvec2 orbitTiming; // 1: epoch, 2: period
+// xyz: direction towards the periapsis scaled by the semi-major axis, w: eccentricity
+layout(location = 1) in vec4 periapsisAxis;
+// xyz: direction of the semi-minor axis scaled by its length, w: mean anomaly at epoch
+layout(location = 2) in vec4 semiMinorAxis;
+layout(location = 3) in int nTrailVertices;
+
+const float Pi = 3.14159265358979323846;
+const float TwoPi = 2.0 * Pi;
+
+// Solves Kepler's equation M = E - e * sin(E) for the eccentric anomaly E using Newton's
+// method. Starting at pi for high eccentricities makes the iteration converge for all
+// elliptical orbits
+float eccentricAnomaly(float meanAnomaly, float eccentricity) {
+  float m = mod(meanAnomaly, TwoPi);
+  float e = eccentricity > 0.8 ? Pi : m;
+  for (int i = 0; i < 8; i++) {
+    float f = e - eccentricity * sin(e) - m;
+    e -= f / (1.0 - eccentricity * cos(e));
+  }
+  return e;
+}
+
+// Returns the position of the object, in meters, after the fraction 'revolutionFraction'
+// of a full revolution has passed since the epoch
+vec3 keplerPosition(float revolutionFraction) {
+  float meanAnomaly = semiMinorAxis.w + TwoPi * revolutionFraction;
+  float e = eccentricAnomaly(meanAnomaly, periapsisAxis.w);
+  return periapsisAxis.xyz * (cos(e) - periapsisAxis.w) + semiMinorAxis.xyz * sin(e);
+}
+
+// Returns how far into its current revolution the object is at the provided time
+float revolutionFractionAt(double time) {
+  double nRevolutions = (time - orbitTiming.x) / orbitTiming.y;
+  return float(nRevolutions - floor(nRevolutions));
+}
+
+#endif // KEPLER_PROPAGATION
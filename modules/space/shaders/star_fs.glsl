@@ -29,6 +29,7 @@ in vec2 texCoords;
 flat in float ge_bv;
 flat in vec3 ge_velocity;
 flat in float ge_speed;
+flat in float ge_otherData;
 flat in float gs_screenSpaceDepth;
 
 uniform sampler1D colorTexture;
@@ -66,12 +67,12 @@ vec4 bv2rgb(float bv) {
 }
 
 bool isOtherDataValueInRange() {
-  float t = (ge_bv - otherDataRange.x) / (otherDataRange.y - otherDataRange.x);
+  float t = (ge_otherData - otherDataRange.x) / (otherDataRange.y - otherDataRange.x);
   return t >= 0.0 && t <= 1.0;
 }
 
 vec4 otherDataValue() {
-  float t = (ge_bv - otherDataRange.x) / (otherDataRange.y - otherDataRange.x);
+  float t = (ge_otherData - otherDataRange.x) / (otherDataRange.y - otherDataRange.x);
   t = clamp(t, 0.0, 1.0);
   return texture(otherDataTexture, t);
 }
@@ -28,16 +28,19 @@ in vec3 in_position;
 in vec3 in_bvLumAbsMag;
 in vec3 in_velocity;
 in float in_speed;
+in float in_otherData;
 
 out vec3 vs_bvLumAbsMag;
 out vec3 vs_velocity;
 out float vs_speed;
+out float vs_otherData;
 
 
 void main() {
   vs_bvLumAbsMag = in_bvLumAbsMag;
   vs_velocity = in_velocity;
   vs_speed = in_speed;
+  vs_otherData = in_otherData;
 
   gl_Position = vec4(in_position, 1.0);
 }
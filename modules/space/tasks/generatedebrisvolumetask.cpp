@@ -35,8 +35,11 @@
 #include <ghoul/misc/defer.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
 #include <ghoul/misc/stringhelper.h>
+#include <algorithm>
 #include <fstream>
-#include <queue>
+#include <future>
+#include <span>
+#include <thread>
 
 namespace {
     constexpr std::string_view ProgramName = "RenderableSatellites";
@@ -376,17 +379,16 @@ glm::dvec3 cartesianToSphericalCoord(glm::dvec3 position){
     return sphericalPosition;
 }
 
-std::vector<glm::dvec3> getPositionBuffer(std::vector<KeplerParameters> tleData,
-                                          double timeInSeconds, std::string gridType)
+std::vector<glm::dvec3> getPositionBuffer(std::span<const KeplerParameters> tleData,
+                                          double timeInSeconds,
+                                          const std::string& gridType)
 {
-    float minTheta = 0.0;
-    float minPhi = 0.0;
-    float maxTheta = 0.0;
-    float maxPhi = 0.0;
-
     std::vector<glm::dvec3> positionBuffer;
-    for(const auto& orbit : tleData) {
-        KeplerTranslation keplerTranslator;
+    positionBuffer.reserve(tleData.size());
+
+    // A single translation is reused for all orbits as constructing it is expensive
+    KeplerTranslation keplerTranslator;
+    for (const KeplerParameters& orbit : tleData) {
         keplerTranslator.setKeplerElements(
             orbit.eccentricity,
             orbit.semiMajorAxis,
@@ -403,38 +405,13 @@ std::vector<glm::dvec3> getPositionBuffer(std::vector<KeplerParameters> tleData,
             Time(0.0),
             false
         });
-        // LINFO(std::format("cart: {} ", position));
-        glm::dvec3 sphPos;
-        if (gridType == "Spherical"){
-            sphPos = cartesianToSphericalCoord(position);
-
-            if (sphPos.y < minTheta){
-                minTheta = sphPos.y;
-            }
-            if (sphPos.z < minPhi){
-                minPhi = sphPos.z;
-            }
-            if (sphPos.y > maxTheta){
-                maxTheta = sphPos.y;
-            }
-            if (sphPos.z > maxPhi){
-                maxPhi = sphPos.z;
-            }
-            // LINFO(std::format("pos: {} ", sphPos));
-            positionBuffer.push_back(sphPos);
-
+        if (gridType == "Spherical") {
+            positionBuffer.push_back(cartesianToSphericalCoord(position));
         }
-        else
-        {
+        else {
             positionBuffer.push_back(position);
         }
-
-
     }
-    LINFO(std::format("max theta: {} ", maxTheta));
-    LINFO(std::format("max phi: {} ", maxPhi));
-    LINFO(std::format("min theta: {} ", minTheta));
-    LINFO(std::format("min phi: {} ", minPhi));
 
     return positionBuffer;
 }
@@ -514,7 +491,9 @@ int getIndexFromPosition(glm::dvec3 position, glm::uvec3 dim, float maxApogee,
     return -1;
 }
 
-double getVoxelVolume(int index, RawVolume<float>& raw, glm::uvec3 dim, float maxApogee){
+double getVoxelVolume(int index, const RawVolume<float>& raw, glm::uvec3 dim,
+                      float maxApogee)
+{
     // get coords from index
     glm::uvec3 coords = raw.indexToCoords(index);
 
@@ -532,9 +511,9 @@ double getVoxelVolume(int index, RawVolume<float>& raw, glm::uvec3 dim, float ma
 
 }
 
-double* mapDensityToVoxels(double* densityArray, std::vector<glm::dvec3> positions,
-                           glm::uvec3 dim, float maxApogee, std::string gridType,
-                           RawVolume<float>& raw)
+double* mapDensityToVoxels(double* densityArray, const std::vector<glm::dvec3>& positions,
+                           glm::uvec3 dim, float maxApogee, const std::string& gridType,
+                           const RawVolume<float>& raw)
 {
 
     for (const glm::dvec3& position : positions) {
@@ -666,102 +645,100 @@ void GenerateDebrisVolumeTask::perform(const Task::ProgressCallback& progressCal
      int numberOfIterations = static_cast<int>(timeSpan/timeStep);
     LINFO(std::format("timestep: {} ", numberOfIterations));
 
-    std::queue<volume::RawVolume<float>> rawVolumeQueue = {};
     const int size = _dimensions.x *_dimensions.y *_dimensions.z;
     float minVal = std::numeric_limits<float>::max();
     float maxVal = std::numeric_limits<float>::min();
+
+    auto outputName = [](const std::string& path, int i, std::string_view extension) {
+        const size_t lastIndex = path.find_last_of(".");
+        return std::format("{}{}{}", path.substr(0, lastIndex), i, extension);
+    };
+
+    ghoul::filesystem::File file(outputName(_rawVolumeOutputPath, 0, ".rawvolume"));
+    const std::string directory = file.directoryName();
+    if (!FileSys.directoryExists(directory)) {
+        FileSys.createDirectory(directory, ghoul::filesystem::FileSystem::Recursive::Yes);
+    }
+
+    // The debris objects are split evenly between the threads, each of which bins its
+    // objects into its own partial density volume. The partial volumes are summed up
+    // once all threads are finished with the time step
+    const size_t nThreads = std::min<size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u),
+        std::max<size_t>(_TLEDataVector.size(), 1)
+    );
+    std::vector<std::vector<double>> partialDensities(
+        nThreads,
+        std::vector<double>(size)
+    );
+    const std::span<const KeplerParameters> orbits = _TLEDataVector;
+
     // 2.
-    for (int i=0 ; i<=numberOfIterations ; ++i) {
-        std::vector<glm::dvec3> startPositionBuffer = getPositionBuffer(
-            _TLEDataVector,
-            startTimeInSeconds + (i * timeStep),
-            _gridType
-        );   //+(i*timeStep)
-        //LINFO(std::format("pos: {} ", startPositionBuffer[4]));
-
-        double *densityArrayp = new double[size]();
-        //densityArrayp = mapDensityToVoxels(
-        //    densityArrayp,
-        //    generatedPositions,
-        //    _dimensions,
-        //    maxApogee
-        //);
+    for (int i = 0; i <= numberOfIterations; i++) {
+        const double time = startTimeInSeconds + (i * timeStep);
         volume::RawVolume<float> rawVolume(_dimensions);
 
-        densityArrayp = mapDensityToVoxels(
-            densityArrayp,
-            startPositionBuffer,
-            _dimensions,
-            _maxApogee,
-            _gridType,
-            rawVolume
-        );
-        /*std::vector<glm::dvec3> testBuffer;
-        testBuffer.push_back(glm::dvec3(0,0,0));
-        testBuffer.push_back(glm::dvec3(1,1.5,1.5));
-        testBuffer.push_back(glm::dvec3(1,3,3));
-        testBuffer.push_back(glm::dvec3(3,5,3));
-        //testBuffer.push_back(glm::dvec3(10000,1000000000,1000000000));
-
-
-        densityArrayp = mapDensityToVoxels(
-            densityArrayp,
-            testBuffer,
-            _dimensions,
-            _maxApogee,
-            _gridType
-        );
-        */
-        // create object rawVolume
-
-        //glm::vec3 domainSize = _upperDomainBound - _lowerDomainBound;
+        std::vector<std::future<void>> futures;
+        futures.reserve(nThreads);
+        for (size_t t = 0; t < nThreads; t++) {
+            const size_t begin = orbits.size() * t / nThreads;
+            const size_t end = orbits.size() * (t + 1) / nThreads;
+            futures.push_back(std::async(
+                std::launch::async,
+                [&, t, begin, end]() {
+                    std::vector<double>& density = partialDensities[t];
+                    std::fill(density.begin(), density.end(), 0.0);
+
+                    const std::vector<glm::dvec3> positions = getPositionBuffer(
+                        orbits.subspan(begin, end - begin),
+                        time,
+                        _gridType
+                    );
+                    mapDensityToVoxels(
+                        density.data(),
+                        positions,
+                        _dimensions,
+                        _maxApogee,
+                        _gridType,
+                        rawVolume
+                    );
+                }
+            ));
+        }
+        for (std::future<void>& f : futures) {
+            f.get();
+        }
 
-        // TODO: Create a forEachSatallite and set(cell, value) to combine
-        //       mapDensityToVoxel and forEachVoxel for less time complexity.
         rawVolume.forEachVoxel([&](glm::uvec3 cell, float) {
-        //     glm::vec3 coord = _lowerDomainBound +
-        //        glm::vec3(cell) / glm::vec3(_dimensions) * domainSize;
-            float value = getDensityAt(cell, densityArrayp, rawVolume);   // (coord)
+            const size_t index = rawVolume.coordsToIndex(cell);
+            double density = 0.0;
+            for (const std::vector<double>& partial : partialDensities) {
+                density += partial[index];
+            }
+            const float value = static_cast<float>(density);
 
             rawVolume.set(cell, value);
 
             minVal = std::min(minVal, value);
             maxVal = std::max(maxVal, value);
-            /*LINFO(std::format("min: {} ", minVal));
-            LINFO(std::format("max: {} ", maxVal));*/
         });
-        rawVolumeQueue.push(rawVolume);
-        delete[] densityArrayp;
-    }
 
-    // two loops is used to get a global min and max value for voxels.
-    for(int i=0 ; i<=numberOfIterations ; ++i){
-        // LINFO(std::format("raw file output name: {} ", _rawVolumeOutputPath));
-
-        size_t lastIndex = _rawVolumeOutputPath.find_last_of(".");
-        std::string rawOutputName = _rawVolumeOutputPath.substr(0, lastIndex);
-        rawOutputName += std::to_string(i) + ".rawvolume";
-
-        lastIndex = _dictionaryOutputPath.find_last_of(".");
-        std::string dictionaryOutputName = _dictionaryOutputPath.substr(0, lastIndex);
-        dictionaryOutputName += std::to_string(i) + ".dictionary";
-
-        ghoul::filesystem::File file(rawOutputName);
-        const std::string directory = file.directoryName();
-        if (!FileSys.directoryExists(directory)) {
-            FileSys.createDirectory(
-                directory,
-                ghoul::filesystem::FileSystem::Recursive::Yes
-            );
-        }
+        // Each volume is written to disk as soon as it is complete so that only a single
+        // time step has to be kept in memory
+        volume::RawVolumeWriter<float> writer(
+            outputName(_rawVolumeOutputPath, i, ".rawvolume")
+        );
+        writer.write(rawVolume);
 
-        volume::RawVolumeWriter<float> writer(rawOutputName);
-        writer.write(rawVolumeQueue.front());
-        rawVolumeQueue.pop();
+        progressCallback(static_cast<float>(i + 1) / (numberOfIterations + 1));
+    }
 
+    // The metadata is written separately as it contains the global min and max values of
+    // all time steps, which are only known once all volumes have been computed
+    for (int i = 0; i <= numberOfIterations; i++) {
         RawVolumeMetadata metadata;
         // alternatively metadata.hasTime = false;
-        metadata.time = Time::convertTime(_startTime)+(i*timeStep);
+        metadata.time = startTimeInSeconds + (i * timeStep);
         metadata.dimensions = _dimensions;
         metadata.hasDomainUnit = false;
         metadata.hasValueUnit = false;
@@ -773,14 +750,14 @@ void GenerateDebrisVolumeTask::perform(const Task::ProgressCallback& progressCal
         metadata.minValue = minVal;
         metadata.maxValue = maxVal;
 
-        /*LINFO(std::format("min2: {} ", minVal));
-        LINFO(std::format("max2: {} ", maxVal));*/
-
         ghoul::Dictionary outputDictionary = metadata.dictionary();
         ghoul::DictionaryLuaFormatter formatter;
         std::string metadataString = formatter.format(outputDictionary);
 
-        std::fstream f(dictionaryOutputName, std::ios::out);
+        std::fstream f(
+            outputName(_dictionaryOutputPath, i, ".dictionary"),
+            std::ios::out
+        );
         f << "return " << metadataString;
         f.close();
     }
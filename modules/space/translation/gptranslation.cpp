@@ -26,10 +26,23 @@
 
 #include <modules/space/kepler.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/updatestructures.h>
 #include <filesystem>
 #include <optional>
 
 namespace {
+    constexpr openspace::properties::Property::PropertyInfo UseSgp4Info = {
+        "UseSgp4",
+        "Use SGP4",
+        "If this value is enabled, the position is computed using the SGP4 model, which "
+        "takes the Earth's oblateness and the atmospheric drag into account. Otherwise, "
+        "the position is computed as an unperturbed Kepler orbit. This value only has an "
+        "effect for TLE and OMM files and for orbits with a period of less than 225 "
+        "minutes. Changes to the Keplerian elements are only reflected in the position "
+        "if this value is disabled.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(GPTranslation)]] Parameters {
         // Specifies the filename of the general pertubation file
         std::filesystem::path file;
@@ -48,6 +61,9 @@ namespace {
         // Specifies the element within the file that should be used in case the file
         // provides multiple general pertubation elements. Defaults to 1.
         std::optional<int> element [[codegen::greater(0)]];
+
+        // [[codegen::verbatim(UseSgp4Info.description)]]
+        std::optional<bool> useSgp4;
     };
 #include "gptranslation_codegen.cpp"
 } // namespace
@@ -58,11 +74,14 @@ documentation::Documentation GPTranslation::Documentation() {
     return codegen::doc<Parameters>("space_transform_gp");
 }
 
-GPTranslation::GPTranslation(const ghoul::Dictionary& dictionary) {
+GPTranslation::GPTranslation(const ghoul::Dictionary& dictionary)
+    : _useSgp4(UseSgp4Info, true)
+{
     const Parameters p = codegen::bake<Parameters>(dictionary);
     if (!std::filesystem::is_regular_file(p.file)) {
         throw ghoul::RuntimeError("The provided TLE file must exist");
     }
+    _file = p.file;
 
     int element = p.element.value_or(1);
 
@@ -88,6 +107,48 @@ GPTranslation::GPTranslation(const ghoul::Dictionary& dictionary) {
         param.period,
         param.epoch
     );
+
+    // The SBDB files describe heliocentric orbits for which SGP4 is not applicable
+    _hasSgp4 = p.format != Parameters::Format::SBDB && sgp4::isNearEarth(param);
+    if (_hasSgp4) {
+        _batch = sgp4::createBatch(std::span(&param, 1));
+    }
+
+    _useSgp4 = p.useSgp4.value_or(_useSgp4);
+    _useSgp4.onChange([this]() {
+        requireUpdate();
+        notifyObservers();
+    });
+    addProperty(_useSgp4);
+}
+
+std::vector<std::filesystem::path> GPTranslation::sourceFiles() const {
+    return { _file };
+}
+
+glm::dvec3 GPTranslation::position(const UpdateData& data) const {
+    if (!_hasSgp4 || !_useSgp4) {
+        return KeplerTranslation::position(data);
+    }
+
+    glm::dvec3 res = glm::dvec3(0.0);
+    sgp4::propagate(_batch, data.time.j2000Seconds(), std::span(&res, 1));
+    return res;
+}
+
+void GPTranslation::positions(std::span<const double> times,
+                              std::span<glm::dvec3> result) const
+{
+    ghoul_assert(times.size() == result.size(), "Times and results must have same size");
+
+    if (!_hasSgp4 || !_useSgp4) {
+        KeplerTranslation::positions(times, result);
+        return;
+    }
+
+    for (size_t i = 0; i < times.size(); i++) {
+        sgp4::propagate(_batch, times[i], result.subspan(i, 1));
+    }
 }
 
 } // namespace openspace
@@ -27,6 +27,9 @@
 
 #include <modules/space/translation/keplertranslation.h>
 
+#include <modules/space/sgp4.h>
+#include <openspace/properties/scalar/boolproperty.h>
+
 namespace openspace {
 
 /**
@@ -45,6 +48,25 @@ public:
      */
     explicit GPTranslation(const ghoul::Dictionary& dictionary);
 
+    /**
+     * Returns the position at the provided time. If the element set was provided as a
+     * TLE or OMM and can be propagated with the near-Earth SGP4 model, the position
+     * includes the perturbations due to the Earth's oblateness and atmospheric drag.
+     * Otherwise the position of the unperturbed Kepler orbit is returned.
+     *
+     * \param data Provides information from the engine about, for example, the time
+     */
+    glm::dvec3 position(const UpdateData& data) const override;
+
+    /**
+     * Computes the positions for all \p times, propagating the SGP4 coefficients that
+     * were computed when the element set was loaded.
+     */
+    void positions(std::span<const double> times,
+        std::span<glm::dvec3> result) const override;
+
+    std::vector<std::filesystem::path> sourceFiles() const override;
+
     /**
      * Method returning the openspace::Documentation that describes the ghoul::Dictionary
      * that can be passed to the constructor.
@@ -53,6 +75,17 @@ public:
      *         be passed to the constructor
      */
     static documentation::Documentation Documentation();
+
+private:
+    properties::BoolProperty _useSgp4;
+
+    /// The file that the element set was read from
+    std::filesystem::path _file;
+
+    /// Whether the element set can be propagated using SGP4
+    bool _hasSgp4 = false;
+    /// The SGP4 coefficients of the element set used by this translation
+    sgp4::Batch _batch;
 };
 
 } // namespace openspace
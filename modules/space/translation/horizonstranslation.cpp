@@ -33,13 +33,15 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/lua/lua_helper.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
-#include <type_traits>
 
 namespace {
     constexpr std::string_view _loggerCat = "HorizonsTranslation";
-    constexpr int8_t CurrentCacheVersion = 2;
+    constexpr int8_t CurrentCacheVersion = 3;
 } // namespace
 
 namespace {
@@ -111,41 +113,76 @@ HorizonsTranslation::HorizonsTranslation(const ghoul::Dictionary& dictionary)
     }
 }
 
-glm::dvec3 HorizonsTranslation::position(const UpdateData& data) const {
-    glm::dvec3 interpolatedPos = glm::dvec3(0.0);
-
-    const Keyframe<glm::dvec3>* lastBefore =
-        _timeline.lastKeyframeBefore(data.time.j2000Seconds(), true);
-    const Keyframe<glm::dvec3>* firstAfter =
-        _timeline.firstKeyframeAfter(data.time.j2000Seconds(), false);
-
-    if (lastBefore && firstAfter) {
-        // We're inbetween first and last value.
-        const double timelineDiff = firstAfter->timestamp - lastBefore->timestamp;
-        const double timeDiff = data.time.j2000Seconds() - lastBefore->timestamp;
-        const double diff = (timelineDiff > DBL_EPSILON) ? timeDiff / timelineDiff : 0.0;
+std::vector<std::filesystem::path> HorizonsTranslation::sourceFiles() const {
+    std::vector<std::filesystem::path> files;
+    for (const std::string& file : _horizonsTextFiles.value()) {
+        files.push_back(absPath(file));
+    }
+    return files;
+}
 
-        const glm::dvec3 dir = firstAfter->data - lastBefore->data;
-        interpolatedPos = lastBefore->data + dir * diff;
+glm::dvec3 HorizonsTranslation::position(const UpdateData& data) const {
+    if (_times.empty()) {
+        return glm::dvec3(0.0);
     }
-    else if (lastBefore) {
-        // Requesting a time after last value. Return last known position.
-        interpolatedPos = lastBefore->data;
+
+    const double time = data.time.j2000Seconds();
+    if (time <= _times.front()) {
+        // Requesting a time before first value. Return first known position
+        return _positions.front();
     }
-    else if (firstAfter) {
-        // Requesting a time before first value. Return last known position.
-        interpolatedPos = firstAfter->data;
+    if (time >= _times.back()) {
+        // Requesting a time after last value. Return last known position
+        return _positions.back();
     }
 
-    return interpolatedPos;
+    // We're inbetween the first and last value, so there is always a sample before and
+    // after the requested time
+    const size_t i1 = std::distance(
+        _times.begin(),
+        std::upper_bound(_times.begin(), _times.end(), time)
+    );
+    const size_t i0 = i1 - 1;
+
+    const double dt = _times[i1] - _times[i0];
+    const double t = (dt > DBL_EPSILON) ? (time - _times[i0]) / dt : 0.0;
+
+    // Cubic Hermite interpolation with velocities estimated from the neighboring samples,
+    // which are scaled to the length of the interval
+    const glm::dvec3 m0 = velocity(i0) * dt;
+    const glm::dvec3 m1 = velocity(i1) * dt;
+
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * _positions[i0] +
+        (t3 - 2.0 * t2 + t) * m0 +
+        (-2.0 * t3 + 3.0 * t2) * _positions[i1] +
+        (t3 - t2) * m1;
+}
+
+glm::dvec3 HorizonsTranslation::velocity(size_t i) const {
+    // Central differences for the interior samples and one-sided differences at the ends
+    const size_t prev = (i > 0) ? i - 1 : i;
+    const size_t next = (i + 1 < _times.size()) ? i + 1 : i;
+    const double dt = _times[next] - _times[prev];
+    if (dt < DBL_EPSILON) {
+        return glm::dvec3(0.0);
+    }
+    return (_positions[next] - _positions[prev]) / dt;
 }
 
 void HorizonsTranslation::loadData() {
+    _times = std::span<const double>();
+    _positions = std::span<const glm::dvec3>();
+    _timeData.clear();
+    _positionData.clear();
+    _mappedCaches.clear();
+
     for (const std::string& filePath : _horizonsTextFiles.value()) {
         std::filesystem::path file = absPath(filePath);
         if (!std::filesystem::is_regular_file(file)) {
             LWARNING(std::format("The Horizons text file '{}' could not be found", file));
-            return;
+            continue;
         }
 
         std::filesystem::path cachedFile = FileSys.cacheManager()->cachedFilename(file);
@@ -170,135 +207,213 @@ void HorizonsTranslation::loadData() {
         LINFO(std::format("Loading Horizon file '{}'", file));
 
         HorizonsFile horizonsFile(file);
-        if (!readHorizonsTextFile(horizonsFile)) {
+        std::vector<HorizonsKeyframe> keyframes;
+        if (!readHorizonsTextFile(horizonsFile, keyframes)) {
             LERROR(std::format("Could not read data from Horizons file '{}'", file));
-            return;
+            continue;
         }
 
         LINFO("Saving cache");
-        saveCachedFile(cachedFile);
+        saveCachedFile(cachedFile, keyframes);
+        if (!loadCachedFile(cachedFile)) {
+            // The cache could not be written or mapped, so the parsed data is used
+            std::vector<double> times;
+            std::vector<glm::dvec3> positions;
+            times.reserve(keyframes.size());
+            positions.reserve(keyframes.size());
+            for (const HorizonsKeyframe& keyframe : keyframes) {
+                times.push_back(keyframe.time);
+                positions.push_back(keyframe.position);
+            }
+            mergeSamples(times, positions);
+        }
     }
+
+    if (_mappedCaches.size() == 1 && _timeData.empty()) {
+        // With a single file, the samples are used directly from the mapped cache
+        const MemoryMappedFile& cache = *_mappedCaches.front();
+        const size_t n = cacheSize(cache);
+        _times = std::span<const double>(
+            reinterpret_cast<const double*>(cache.data() + CacheHeaderSize),
+            n
+        );
+        _positions = std::span<const glm::dvec3>(
+            reinterpret_cast<const glm::dvec3*>(
+                cache.data() + CacheHeaderSize + n * sizeof(double)
+            ),
+            n
+        );
+    }
+    else {
+        // Samples from multiple files have to be merged, after which the mappings are
+        // no longer needed
+        for (const std::unique_ptr<MemoryMappedFile>& cache : _mappedCaches) {
+            const size_t n = cacheSize(*cache);
+            const double* times =
+                reinterpret_cast<const double*>(cache->data() + CacheHeaderSize);
+            const glm::dvec3* positions = reinterpret_cast<const glm::dvec3*>(
+                cache->data() + CacheHeaderSize + n * sizeof(double)
+            );
+            mergeSamples({ times, n }, { positions, n });
+        }
+        _mappedCaches.clear();
+        _times = _timeData;
+        _positions = _positionData;
+    }
+}
+
+void HorizonsTranslation::mergeSamples(std::span<const double> times,
+                                       std::span<const glm::dvec3> positions)
+{
+    ghoul_assert(times.size() == positions.size(), "Mismatching number of samples");
+
+    // Both ranges are sorted, so they can be merged in linear time. If a time exists in
+    // both, the sample that was loaded first is kept to prevent duplicates
+    std::vector<double> mergedTimes;
+    std::vector<glm::dvec3> mergedPositions;
+    mergedTimes.reserve(_timeData.size() + times.size());
+    mergedPositions.reserve(_timeData.size() + times.size());
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < _timeData.size() || j < times.size()) {
+        const bool takeExisting =
+            j == times.size() || (i < _timeData.size() && _timeData[i] <= times[j]);
+        if (takeExisting) {
+            if (j < times.size() && _timeData[i] == times[j]) {
+                j++;
+            }
+            mergedTimes.push_back(_timeData[i]);
+            mergedPositions.push_back(_positionData[i]);
+            i++;
+        }
+        else {
+            mergedTimes.push_back(times[j]);
+            mergedPositions.push_back(positions[j]);
+            j++;
+        }
+    }
+
+    _timeData = std::move(mergedTimes);
+    _positionData = std::move(mergedPositions);
 }
 
-bool HorizonsTranslation::readHorizonsTextFile(HorizonsFile& horizonsFile) {
+bool HorizonsTranslation::readHorizonsTextFile(HorizonsFile& horizonsFile,
+                                               std::vector<HorizonsKeyframe>& keyframes)
+{
     HorizonsResult result = readHorizonsFile(horizonsFile.file());
     if (result.errorCode != HorizonsResultCode::Valid) {
         horizonsFile.displayErrorMessage(result.errorCode);
         return false;
     }
 
-    for (HorizonsKeyframe& keyframe : result.data) {
-        // Search if the keyframe already exist in the timeline
-        auto it = std::find_if(
-            _timeline.keyframes().begin(),
-            _timeline.keyframes().end(),
-            [keyframe](const Keyframe<glm::dvec3>& kf) {
-                return kf.timestamp == keyframe.time;
-            }
-        );
-
-        // If it doesn't exist in the timeline then add it, prevent duplicates
-        if (it == _timeline.keyframes().end()) {
-            _timeline.addKeyframe(keyframe.time, std::move(keyframe.position));
+    // Sort the keyframes by time and remove duplicates, keeping the first occurrence
+    keyframes = std::move(result.data);
+    std::stable_sort(
+        keyframes.begin(),
+        keyframes.end(),
+        [](const HorizonsKeyframe& lhs, const HorizonsKeyframe& rhs) {
+            return lhs.time < rhs.time;
         }
-    }
+    );
+    keyframes.erase(
+        std::unique(
+            keyframes.begin(),
+            keyframes.end(),
+            [](const HorizonsKeyframe& lhs, const HorizonsKeyframe& rhs) {
+                return lhs.time == rhs.time;
+            }
+        ),
+        keyframes.end()
+    );
     return true;
 }
 
+size_t HorizonsTranslation::cacheSize(const MemoryMappedFile& file) {
+    uint64_t nKeyframes = 0;
+    std::memcpy(&nKeyframes, file.data() + sizeof(uint64_t), sizeof(uint64_t));
+    return static_cast<size_t>(nKeyframes);
+}
+
 bool HorizonsTranslation::loadCachedFile(const std::filesystem::path& file) {
-    std::ifstream fileStream(file, std::ifstream::binary);
+    std::unique_ptr<MemoryMappedFile> cache;
+    try {
+        cache = std::make_unique<MemoryMappedFile>(file);
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(std::format(
+            "Error opening file '{}' for loading cache file: {}", file, e.message
+        ));
+        return false;
+    }
 
-    if (!fileStream.good()) {
-        LERROR(std::format("Error opening file '{}' for loading cache file", file));
+    if (cache->size() < CacheHeaderSize) {
         return false;
     }
 
     // Check the caching version
     int8_t version = 0;
-    fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    std::memcpy(&version, cache->data(), sizeof(int8_t));
     if (version != CurrentCacheVersion) {
         LINFO("The format of the cached file has changed: deleting old cache");
-        fileStream.close();
+        cache = nullptr;
         FileSys.cacheManager()->removeCacheFile(file);
         return false;
     }
 
-    // Read how many keyframes to read
-    int32_t nKeyframes = 0;
-
-    fileStream.read(reinterpret_cast<char*>(&nKeyframes), sizeof(int32_t));
-    if (nKeyframes == 0) {
-        throw ghoul::RuntimeError("Error reading cache: No values were loaded");
-    }
-
-    // Read all data in one go
-    std::vector<CacheKeyframe> cacheKeyframes;
-    cacheKeyframes.resize(nKeyframes);
-    fileStream.read(
-        reinterpret_cast<char*>(cacheKeyframes.data()),
-        sizeof(CacheKeyframe) * nKeyframes
-    );
-
-    // Extract the data from the cache Keyframe vector
-    for (int i = 0; i < nKeyframes; i++) {
-        // Add keyframe in timeline
-        _timeline.addKeyframe(
-            cacheKeyframes[i].timestamp,
-            {
-                cacheKeyframes[i].position[0],
-                cacheKeyframes[i].position[1],
-                cacheKeyframes[i].position[2]
-            }
-        );
+    // The header is followed by all timestamps and then all positions
+    const size_t nKeyframes = cacheSize(*cache);
+    const size_t expectedSize =
+        CacheHeaderSize + nKeyframes * (sizeof(double) + sizeof(glm::dvec3));
+    if (nKeyframes == 0 || cache->size() != expectedSize) {
+        LERROR(std::format("Error reading cache '{}': Unexpected file size", file));
+        return false;
     }
 
-    return fileStream.good();
+    _mappedCaches.push_back(std::move(cache));
+    return true;
 }
 
-void HorizonsTranslation::saveCachedFile(const std::filesystem::path& file) const {
+void HorizonsTranslation::saveCachedFile(const std::filesystem::path& file,
+                                     const std::vector<HorizonsKeyframe>& keyframes) const
+{
     std::ofstream fileStream(file, std::ofstream::binary);
     if (!fileStream.good()) {
         LERROR(std::format("Error opening file '{}' for save cache file", file));
         return;
     }
 
-    // Write which version of caching that is used
-    fileStream.write(
-        reinterpret_cast<const char*>(&CurrentCacheVersion),
-        sizeof(int8_t)
-    );
-
-    // Write how many keyframes are to be written
-    int32_t nKeyframes = static_cast<int32_t>(_timeline.nKeyframes());
-    if (nKeyframes == 0) {
+    if (keyframes.empty()) {
         throw ghoul::RuntimeError("Error writing cache: No values were loaded");
     }
-    fileStream.write(reinterpret_cast<const char*>(&nKeyframes), sizeof(int32_t));
-
-    // Transfer all data to a cache key frame vector, write it all in one go
-    std::deque<Keyframe<glm::dvec3>> keyframes = _timeline.keyframes();
-    std::vector<CacheKeyframe> cachKeyframes;
-    cachKeyframes.reserve(nKeyframes);
-    for (int i = 0; i < nKeyframes; i++) {
-        CacheKeyframe cacheKeyframe;
-        cacheKeyframe.timestamp = keyframes[i].timestamp;
-        cacheKeyframe.position[0] = keyframes[i].data.x;
-        cacheKeyframe.position[1] = keyframes[i].data.y;
-        cacheKeyframe.position[2] = keyframes[i].data.z;
-
-        cachKeyframes.push_back(cacheKeyframe);
-    }
 
-    // Write of entire vector will only work if the data is plain old data type,
-    // is_pod is depricated in C++20 and replaced with both is_trivial and
-    // is_standard_layout
-    static_assert(std::is_trivial_v<CacheKeyframe>);
-    static_assert(std::is_standard_layout_v<CacheKeyframe>);
+    // The header is padded so that the samples are aligned when the file is mapped
+    std::array<std::byte, CacheHeaderSize> header = {};
+    std::memcpy(header.data(), &CurrentCacheVersion, sizeof(int8_t));
+    const uint64_t nKeyframes = keyframes.size();
+    std::memcpy(header.data() + sizeof(uint64_t), &nKeyframes, sizeof(uint64_t));
+    fileStream.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    // Timestamps and positions are written as separate arrays, so that the lookup only
+    // has to touch the timestamps
+    std::vector<double> times;
+    std::vector<glm::dvec3> positions;
+    times.reserve(keyframes.size());
+    positions.reserve(keyframes.size());
+    for (const HorizonsKeyframe& keyframe : keyframes) {
+        times.push_back(keyframe.time);
+        positions.push_back(keyframe.position);
+    }
 
-    // Write data
+    static_assert(sizeof(glm::dvec3) == 3 * sizeof(double));
+    fileStream.write(
+        reinterpret_cast<const char*>(times.data()),
+        sizeof(double) * times.size()
+    );
     fileStream.write(
-        reinterpret_cast<const char*>(cachKeyframes.data()),
-        sizeof(CacheKeyframe) * nKeyframes
+        reinterpret_cast<const char*>(positions.data()),
+        sizeof(glm::dvec3) * positions.size()
     );
 }
+
 } // namespace openspace
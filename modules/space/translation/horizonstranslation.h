@@ -28,11 +28,13 @@
 #include <openspace/scene/translation.h>
 
 #include <openspace/properties/list/stringlistproperty.h>
-#include <openspace/util/timeline.h>
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/lua/luastate.h>
 #include <modules/space/horizonsfile.h>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace openspace {
 
@@ -74,22 +76,54 @@ public:
 
     glm::dvec3 position(const UpdateData& data) const override;
 
+    std::vector<std::filesystem::path> sourceFiles() const override;
+
     static documentation::Documentation Documentation();
 
 private:
-    struct CacheKeyframe {
-        double timestamp;
-        std::array<double, 3> position;
-    };
+    /// Size of the header of the cache file, which is padded to keep the samples aligned
+    static constexpr size_t CacheHeaderSize = 2 * sizeof(uint64_t);
+
+    /**
+     * Returns the velocity at the sample \p i, estimated from its neighboring samples.
+     */
+    glm::dvec3 velocity(size_t i) const;
 
     void loadData();
-    bool readHorizonsTextFile(HorizonsFile& horizonsFile);
+    bool readHorizonsTextFile(HorizonsFile& horizonsFile,
+        std::vector<HorizonsKeyframe>& keyframes);
+
+    /**
+     * Merges the sorted \p times and their \p positions into the owned samples,
+     * skipping times that already exist.
+     */
+    void mergeSamples(std::span<const double> times,
+        std::span<const glm::dvec3> positions);
+
+    /**
+     * Maps the cache \p file into memory and adds it to the list of mapped caches.
+     * Returns `false` if the file could not be mapped or is not a valid cache file.
+     */
     bool loadCachedFile(const std::filesystem::path& file);
-    void saveCachedFile(const std::filesystem::path& file) const;
+    void saveCachedFile(const std::filesystem::path& file,
+        const std::vector<HorizonsKeyframe>& keyframes) const;
+
+    /// Returns the number of samples that are stored in the mapped cache \p file
+    static size_t cacheSize(const MemoryMappedFile& file);
 
     properties::StringListProperty _horizonsTextFiles;
     ghoul::lua::LuaState _state;
-    Timeline<glm::dvec3> _timeline;
+
+    /// The sorted timestamps and the corresponding positions of all samples. These point
+    /// either into the mapped cache file or into the owned sample data
+    std::span<const double> _times;
+    std::span<const glm::dvec3> _positions;
+
+    /// Owned samples that are used if the samples of multiple files had to be merged
+    std::vector<double> _timeData;
+    std::vector<glm::dvec3> _positionData;
+
+    std::vector<std::unique_ptr<MemoryMappedFile>> _mappedCaches;
 };
 
 } // namespace openspace
@@ -256,6 +256,10 @@ double KeplerTranslation::eccentricAnomaly(double meanAnomaly) const {
     }
 }
 
+bool KeplerTranslation::supportsParallelUpdate() const {
+    return true;
+}
+
 glm::dvec3 KeplerTranslation::position(const UpdateData& data) const {
     if (_orbitPlaneDirty) {
         computeOrbitPlane();
@@ -276,6 +280,32 @@ glm::dvec3 KeplerTranslation::position(const UpdateData& data) const {
     return _orbitPlaneRotation * p;
 }
 
+void KeplerTranslation::positions(std::span<const double> times,
+                                  std::span<glm::dvec3> result) const
+{
+    ghoul_assert(times.size() == result.size(), "Times and results must have same size");
+
+    if (_orbitPlaneDirty) {
+        computeOrbitPlane();
+        _orbitPlaneDirty = false;
+    }
+
+    // All values that do not depend on the time are only computed once, which leaves the
+    // solution of Kepler's equation as the only nontrivial part of the loop
+    const double meanMotion = glm::two_pi<double>() / _period;
+    const double meanAnomalyAtEpoch = glm::radians(_meanAnomalyAtEpoch.value());
+    const double a = _semiMajorAxis * 1000.0;
+    const double b = a * sqrt(1.0 - _eccentricity * _eccentricity);
+    const glm::dvec3 periapsisAxis = _orbitPlaneRotation * glm::dvec3(a, 0.0, 0.0);
+    const glm::dvec3 semiMinorAxis = _orbitPlaneRotation * glm::dvec3(0.0, b, 0.0);
+
+    for (size_t i = 0; i < times.size(); i++) {
+        const double meanAnomaly = meanAnomalyAtEpoch + (times[i] - _epoch) * meanMotion;
+        const double e = eccentricAnomaly(meanAnomaly);
+        result[i] = periapsisAxis * (cos(e) - _eccentricity) + semiMinorAxis * sin(e);
+    }
+}
+
 void KeplerTranslation::computeOrbitPlane() const {
     // We assume the following coordinate system:
     // z = axis of rotation
@@ -70,6 +70,15 @@ public:
     */
     glm::dvec3 position(const UpdateData& data) const override;
 
+    /**
+     * Computes the positions for all \p times while computing the orbit plane and the
+     * constants of the orbit only once.
+     */
+    void positions(std::span<const double> times,
+        std::span<glm::dvec3> result) const override;
+
+    bool supportsParallelUpdate() const override;
+
     /**
      * Method returning the openspace::Documentation that describes the ghoul::Dictionary
      * that can be passed to the constructor.
@@ -33,6 +33,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
 #include <filesystem>
 #include <optional>
 #include <variant>
@@ -110,6 +111,7 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
 
     _target.onChange([this]() {
         _cachedTarget = _target;
+        updatePositionRequest();
         requireUpdate();
         notifyObservers();
     });
@@ -117,6 +119,7 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
 
     _observer.onChange([this]() {
         _cachedObserver = _observer;
+        updatePositionRequest();
         requireUpdate();
         notifyObservers();
     });
@@ -124,6 +127,7 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
 
     _frame.onChange([this]() {
         _cachedFrame = _frame;
+        updatePositionRequest();
         requireUpdate();
         notifyObservers();
     });
@@ -136,6 +140,7 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
         else {
             _fixedEphemerisTime = SpiceManager::ref().ephemerisTimeFromDate(_fixedDate);
         }
+        updatePositionRequest();
     });
     _fixedDate = p.fixedDate.value_or(_fixedDate);
     addProperty(_fixedDate);
@@ -157,6 +162,58 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
     _frame = p.frame.value_or(_frame);
 }
 
+SpiceTranslation::~SpiceTranslation() {
+    if (_positionRequest.has_value() && SpiceManager::isInitialized()) {
+        SpiceManager::ref().unregisterPositionRequest(*_positionRequest);
+    }
+}
+
+void SpiceTranslation::updatePositionRequest() {
+    if (_positionRequest.has_value()) {
+        SpiceManager::ref().unregisterPositionRequest(*_positionRequest);
+        _positionRequest = std::nullopt;
+    }
+
+    const bool hasValues =
+        !_cachedTarget.empty() && !_cachedObserver.empty() && !_cachedFrame.empty();
+    if (hasValues && !_fixedEphemerisTime.has_value()) {
+        _positionRequest = SpiceManager::ref().registerPositionRequest(
+            _cachedTarget,
+            _cachedObserver,
+            _cachedFrame
+        );
+    }
+}
+
+void SpiceTranslation::positions(std::span<const double> times,
+                                 std::span<glm::dvec3> result) const
+{
+    ghoul_assert(times.size() == result.size(), "Times and results must have same size");
+
+    if (_fixedEphemerisTime.has_value()) {
+        // All samples are evaluated at the same fixed time
+        if (!times.empty()) {
+            const glm::dvec3 p = position({ {}, Time(times.front()), Time(0.0) });
+            std::fill(result.begin(), result.end(), p);
+        }
+        return;
+    }
+
+    SpiceManager::ref().targetPositions(
+        _cachedTarget,
+        _cachedObserver,
+        _cachedFrame,
+        {},
+        times,
+        result
+    );
+
+    // Spice handles positions in KM, but we use meters in OpenSpace
+    for (glm::dvec3& p : result) {
+        p *= 1000.0;
+    }
+}
+
 glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
     double lightTime = 0.0;
 
@@ -171,4 +228,50 @@ glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
     ) * 1000.0;
 }
 
+Translation::PositionsFunction SpiceTranslation::positionsSnapshot() const {
+    return [target = _cachedTarget, observer = _cachedObserver, frame = _cachedFrame,
+            fixedEphemerisTime = _fixedEphemerisTime](std::span<const double> times,
+                                                      std::span<glm::dvec3> result)
+    {
+        ghoul_assert(
+            times.size() == result.size(),
+            "Times and results must have same size"
+        );
+
+        if (fixedEphemerisTime.has_value()) {
+            // All samples are evaluated at the same fixed time
+            double lightTime = 0.0;
+            const glm::dvec3 p = SpiceManager::ref().targetPosition(
+                target,
+                observer,
+                frame,
+                {},
+                *fixedEphemerisTime,
+                lightTime
+            );
+            std::fill(result.begin(), result.end(), p);
+        }
+        else {
+            SpiceManager::ref().targetPositions(
+                target,
+                observer,
+                frame,
+                {},
+                times,
+                result
+            );
+        }
+
+        // Spice handles positions in KM, but we use meters in OpenSpace
+        for (glm::dvec3& p : result) {
+            p *= 1000.0;
+        }
+    };
+}
+
+bool SpiceTranslation::supportsParallelUpdate() const {
+    // All accesses to the SpiceManager are serialized
+    return true;
+}
+
 } // namespace openspace
@@ -35,12 +35,34 @@ namespace openspace {
 class SpiceTranslation : public Translation {
 public:
     SpiceTranslation(const ghoul::Dictionary& dictionary);
+    ~SpiceTranslation() override;
 
     glm::dvec3 position(const UpdateData& data) const override;
 
+    /**
+     * Computes the positions for all \p times with a single request to the
+     * SpiceManager, which only has to resolve the objects and their coverage once.
+     */
+    void positions(std::span<const double> times,
+        std::span<glm::dvec3> result) const override;
+
+    /**
+     * Returns a function that requests the positions from the SpiceManager with copies of
+     * the current target, observer, frame, and fixed date.
+     */
+    PositionsFunction positionsSnapshot() const override;
+
+    bool supportsParallelUpdate() const override;
+
     static documentation::Documentation Documentation();
 
 private:
+    /**
+     * Updates the request with the SpiceManager that precomputes the position for every
+     * frame, which is not needed if a fixed date is used.
+     */
+    void updatePositionRequest();
+
     properties::StringProperty _target;
     properties::StringProperty _observer;
     properties::StringProperty _frame;
@@ -54,6 +76,7 @@ private:
     std::string _cachedObserver;
     std::string _cachedFrame;
     std::optional<double> _fixedEphemerisTime;
+    std::optional<int> _positionRequest;
 
     glm::dvec3 _position = glm::dvec3(0.0);
 };
@@ -251,6 +251,7 @@ RenderableFov::RenderableFov(const ghoul::Dictionary& dictionary)
     addProperty(_lineWidth);
 
     _standOffDistance = p.standOffDistance.value_or(_standOffDistance);
+    _standOffDistance.onChange([this]() { _geometryCache.isDirty = true; });
     addProperty(_standOffDistance);
 
     _alwaysDrawFov = p.alwaysDrawFov.value_or(_alwaysDrawFov);
@@ -431,6 +432,9 @@ void RenderableFov::initializeGL() {
     );
 
     glBindVertexArray(0);
+
+    // The buffers are empty, so the geometry has to be uploaded in the next update
+    _geometryCache.isDirty = true;
 }
 
 void RenderableFov::deinitializeGL() {
@@ -816,12 +820,19 @@ void RenderableFov::update(const UpdateData& data) {
         );
     }
 
-    // TODO: figure out if time has changed
-    if (_drawFOV /* && time changed */) {
-        const std::pair<std::string, bool>& t = determineTarget(data.time.j2000Seconds());
+    if (_drawFOV) {
+        // The target and the intercepts are only a function of the time, so if the time
+        // has not changed since the last computation, the cached geometry is still valid
+        const double time = data.time.j2000Seconds();
+        if (_geometryCache.isDirty || time != _geometryCache.time) {
+            const std::pair<std::string, bool>& t = determineTarget(time);
+
+            computeIntercepts(time, t.first, t.second);
+            updateGPU();
 
-        computeIntercepts(data.time.j2000Seconds(), t.first, t.second);
-        updateGPU();
+            _geometryCache.time = time;
+            _geometryCache.isDirty = false;
+        }
 
         const double t2 = ImageSequencer::ref().nextCaptureTime(data.time.j2000Seconds());
         const double diff = (t2 - data.time.j2000Seconds());
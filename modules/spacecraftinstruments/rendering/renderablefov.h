@@ -35,6 +35,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <limits>
 
 namespace ghoul::opengl {
     class ProgramObject;
@@ -90,6 +91,14 @@ private:
     std::string _previousTarget;
     bool _drawFOV = false;
 
+    /// The inputs for which the field-of-view geometry was last computed. The geometry
+    /// only depends on these, so it does not have to be recomputed while the time is
+    /// paused
+    struct {
+        double time = std::numeric_limits<double>::quiet_NaN();
+        bool isDirty = true;
+    } _geometryCache;
+
     struct {
         std::string spacecraft;
         std::string name;
@@ -151,7 +151,7 @@ void RenderableModelProjection::initializeGL() {
 
     ghoul::opengl::updateUniformLocations(*_programObject, _mainUniformCache);
 
-    _fboProgramObject = ghoul::opengl::ProgramObject::Build(
+    _fboProgramObject = global::renderEngine->buildCachedProgram(
         "ProjectionPass",
         absPath(
             "${MODULE_SPACECRAFTINSTRUMENTS}/shaders/renderableModelProjection_vs.glsl"
@@ -163,7 +163,7 @@ void RenderableModelProjection::initializeGL() {
 
     ghoul::opengl::updateUniformLocations(*_fboProgramObject, _fboUniformCache);
 
-    _depthFboProgramObject = ghoul::opengl::ProgramObject::Build(
+    _depthFboProgramObject = global::renderEngine->buildCachedProgram(
         "DepthPass",
         absPath("${MODULE_SPACECRAFTINSTRUMENTS}/shaders/renderableModelDepth_vs.glsl"),
         absPath("${MODULE_SPACECRAFTINSTRUMENTS}/shaders/renderableModelDepth_fs.glsl")
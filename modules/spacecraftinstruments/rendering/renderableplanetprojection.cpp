@@ -37,10 +37,15 @@
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureconversion.h>
 #include <ghoul/opengl/textureunit.h>
+#include <glm/gtc/constants.hpp>
 
 namespace {
     constexpr std::string_view NoImageText = "No Image";
 
+    // The number of frames, at the current simulation speed, that the decoding of
+    // instrument images is started ahead of their capture time
+    constexpr double PrefetchLookAheadFrames = 30.0;
+
     constexpr openspace::properties::Property::PropertyInfo ColorTexturePathsInfo = {
         "ColorTexturePaths",
         "Color Texture",
@@ -312,7 +317,7 @@ void RenderablePlanetProjection::initializeGL() {
     _fboProgramObject = SpacecraftInstrumentsModule::ProgramObjectManager.request(
         "FBOPassProgram",
         []() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
-            return ghoul::opengl::ProgramObject::Build(
+            return global::renderEngine->buildCachedProgram(
                 "FBOPassProgram",
                     absPath(
                         "${MODULE_SPACECRAFTINSTRUMENTS}/shaders/"
@@ -330,7 +335,7 @@ void RenderablePlanetProjection::initializeGL() {
 
     loadColorTexture();
     loadHeightTexture();
-    _projectionComponent.initializeGL();
+    _projectionComponent.initializeGL(ProjectionComponent::AllowSparseTexture::Yes);
     createSphere();
     const glm::vec3 radius = _radius;
     setBoundingSphere(std::max(std::max(radius[0], radius[1]), radius[2]));
@@ -384,8 +389,6 @@ void RenderablePlanetProjection::imageProjectGPU(
                                           const ghoul::opengl::Texture& projectionTexture,
                                                          const glm::mat4& projectorMatrix)
 {
-    _projectionComponent.imageProjectBegin();
-
     _fboProgramObject->activate();
 
     ghoul::opengl::TextureUnit unitFbo;
@@ -402,8 +405,6 @@ void RenderablePlanetProjection::imageProjectGPU(
     glBindVertexArray(_quad);
     glDrawArrays(GL_TRIANGLES, 0, 6);
     _fboProgramObject->deactivate();
-
-    _projectionComponent.imageProjectEnd();
     glBindVertexArray(0);
 }
 
@@ -445,6 +446,76 @@ glm::mat4 RenderablePlanetProjection::attitudeParameters(double time, const glm:
     );
 }
 
+void RenderablePlanetProjection::commitProjectedPages(const glm::mat4& projectorMatrix) {
+    const glm::vec3 radius = _radius;
+    const glm::mat4 transform = projectorMatrix * _transform;
+    const glm::vec3 boresight = glm::normalize(_boresight);
+
+    // This has to match the test in the renderablePlanetProjection_fs shader
+    auto isProjected = [&](const glm::vec2& uv) {
+        const float theta = (1.f - uv.y) * glm::pi<float>();
+        const float phi = uv.x * glm::two_pi<float>();
+        const glm::vec3 p = radius * glm::vec3(
+            std::sin(theta) * std::cos(phi),
+            std::sin(theta) * std::sin(phi),
+            std::cos(theta)
+        );
+
+        const glm::vec4 clip = transform * glm::vec4(p, 1.f);
+        const glm::vec2 projected = glm::vec2(clip) / clip.w * 0.5f + 0.5f;
+        if (glm::any(glm::lessThan(projected, glm::vec2(0.f))) ||
+            glm::any(glm::greaterThan(projected, glm::vec2(1.f))))
+        {
+            return false;
+        }
+
+        const glm::vec3 normal = glm::normalize(glm::mat3(_transform) * p);
+        return glm::dot(boresight, normal) < 0.f;
+    };
+
+    // Sampling the pages can miss images which are smaller than a page, so the points
+    // where the image corners and a grid inside it hit the planet are added as well
+    constexpr int GridSize = 8;
+    const glm::dmat4 inverse = glm::inverse(glm::dmat4(transform));
+    std::vector<glm::vec2> projectedPoints;
+    for (int j = 0; j <= GridSize; j++) {
+        for (int i = 0; i <= GridSize; i++) {
+            const glm::dvec2 ndc = glm::dvec2(i, j) / double(GridSize) * 2.0 - 1.0;
+            const glm::dvec4 front = inverse * glm::dvec4(ndc, -1.0, 1.0);
+            const glm::dvec4 back = inverse * glm::dvec4(ndc, 1.0, 1.0);
+
+            // Intersect the ray with the ellipsoid by scaling it to the unit sphere
+            const glm::dvec3 r = glm::dvec3(radius);
+            const glm::dvec3 origin = glm::dvec3(front) / front.w / r;
+            const glm::dvec3 dir = glm::dvec3(back) / back.w / r - origin;
+            const double a = glm::dot(dir, dir);
+            const double b = 2.0 * glm::dot(origin, dir);
+            const double c = glm::dot(origin, origin) - 1.0;
+            const double discriminant = b * b - 4.0 * a * c;
+            if (discriminant < 0.0 || a == 0.0) {
+                continue;
+            }
+            const double t0 = (-b - std::sqrt(discriminant)) / (2.0 * a);
+            const double t1 = (-b + std::sqrt(discriminant)) / (2.0 * a);
+            const double t = t0 >= 0.0 ? t0 : t1;
+            if (t < 0.0) {
+                continue;
+            }
+
+            const glm::dvec3 n = glm::normalize(origin + t * dir);
+            double u = std::atan2(n.y, n.x) / glm::two_pi<double>();
+            if (u < 0.0) {
+                u += 1.0;
+            }
+            const double theta = std::acos(glm::clamp(n.z, -1.0, 1.0));
+            const double v = 1.0 - theta / glm::pi<double>();
+            projectedPoints.emplace_back(u, v);
+        }
+    }
+
+    _projectionComponent.commitProjectedPages(isProjected, projectedPoints);
+}
+
 ghoul::opengl::Texture& RenderablePlanetProjection::baseTexture() const {
     return _projectionComponent.projectionTexture();
 }
@@ -462,15 +533,32 @@ void RenderablePlanetProjection::render(const RenderData& data, RendererTasks&)
 
     const glm::vec3 up = data.camera.lookUpVectorCameraSpace();
     if (_projectionComponent.doesPerformProjection()) {
+        // All images of this frame are accumulated in a single pass into the projection
+        // texture, which is only started if there is at least one image to project
+        bool isProjecting = false;
         int nProjections = 0;
         for (const Image& img : _imageTimes) {
             if (nProjections >= _maxProjectionsPerFrame) {
                 break;
             }
+            // Rather than stalling the frame on an image that is still being decoded in
+            // the background, it is deferred to a later frame. The first image is always
+            // projected to guarantee progress
+            const bool isReady = _projectionComponent.isProjectionTextureReady(img.path);
+            if (nProjections > 0 && !isReady) {
+                break;
+            }
             try {
                 const glm::mat4 projMatrix = attitudeParameters(img.timeRange.start, up);
                 const std::shared_ptr<ghoul::opengl::Texture> t =
                     _projectionComponent.loadProjectionTexture(img.path);
+                if (!isProjecting) {
+                    _projectionComponent.imageProjectBegin();
+                    isProjecting = true;
+                }
+                if (_projectionComponent.usesSparseTexture()) {
+                    commitProjectedPages(projMatrix);
+                }
                 imageProjectGPU(*t, projMatrix);
                 ++nProjections;
             }
@@ -478,6 +566,9 @@ void RenderablePlanetProjection::render(const RenderData& data, RendererTasks&)
                 LERRORC(e.component, e.what());
             }
         }
+        if (isProjecting) {
+            _projectionComponent.imageProjectEnd();
+        }
         _imageTimes.erase(_imageTimes.begin(), _imageTimes.begin() + nProjections);
         _projectionsInBuffer = static_cast<int>(_imageTimes.size());
     }
@@ -614,6 +705,29 @@ void RenderablePlanetProjection::update(const UpdateData& data) {
         }
     }
 
+    if (ImageSequencer::ref().isReady() && _projectionComponent.doesPerformProjection()) {
+        // Decode the images that are about to be projected on worker threads. These are
+        // the images that are already buffered, followed by the images that will be
+        // captured within the next frames
+        std::vector<std::filesystem::path> prefetch;
+        for (const Image& image : _imageTimes) {
+            prefetch.push_back(image.path);
+        }
+        if (time > integrateFromTime) {
+            const double lookAhead = (time - integrateFromTime) * PrefetchLookAheadFrames;
+            const std::vector<Image> upcoming = ImageSequencer::ref().upcomingImages(
+                _projectionComponent.projecteeId(),
+                _projectionComponent.instrumentId(),
+                time,
+                time + lookAhead
+            );
+            for (const Image& image : upcoming) {
+                prefetch.push_back(image.path);
+            }
+        }
+        _projectionComponent.prefetchProjectionTextures(prefetch);
+    }
+
     _transform = glm::mat4(data.modelTransform.rotation);
 }
 
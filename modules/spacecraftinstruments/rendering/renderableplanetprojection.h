@@ -67,6 +67,12 @@ private:
     void imageProjectGPU(const ghoul::opengl::Texture& projectionTexture,
         const glm::mat4& projectorMatrix);
 
+    /**
+     * Commits the pages of a sparse projection texture that will be covered by an image
+     * that is projected with the provided \p projectorMatrix.
+     */
+    void commitProjectedPages(const glm::mat4& projectorMatrix);
+
     ProjectionComponent _projectionComponent;
 
     properties::OptionProperty _colorTexturePaths;
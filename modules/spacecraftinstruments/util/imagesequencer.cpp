@@ -28,6 +28,8 @@
 #include <openspace/util/timemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <iterator>
 
 namespace {
     constexpr std::string_view _loggerCat = "ImageSequencer";
@@ -285,6 +287,35 @@ std::vector<Image> ImageSequencer::imagePaths(const std::string& projectee,
     return captures;
 }
 
+std::vector<Image> ImageSequencer::upcomingImages(const std::string& projectee,
+                                                  const std::string& instrument,
+                                                  double time, double untilTime) const
+{
+    const auto it = _subsetMap.find(projectee);
+    if (it == _subsetMap.end() || untilTime <= time) {
+        return std::vector<Image>();
+    }
+
+    const std::vector<Image>& subset = it->second._subset;
+    auto compareTime = [](const Image& image, double t) {
+        return image.timeRange.start < t;
+    };
+    const auto first = std::lower_bound(subset.begin(), subset.end(), time, compareTime);
+    const auto last = std::lower_bound(first, subset.end(), untilTime, compareTime);
+
+    std::vector<Image> images;
+    std::copy_if(
+        first,
+        last,
+        std::back_inserter(images),
+        [&instrument](const Image& image) {
+            return !image.isPlaceholder && !image.activeInstruments.empty() &&
+                   image.activeInstruments.front() == instrument;
+        }
+    );
+    return images;
+}
+
 void ImageSequencer::sortData() {
     std::sort(
         _targetTimes.begin(),
@@ -121,6 +121,15 @@ public:
     std::vector<Image> imagePaths(const std::string& projectee,
         const std::string& instrument, double time, double sinceTime);
 
+    /**
+     * Returns the non-placeholder images of the \p instrument for the \p projectee that
+     * will be captured in the range [\p time, \p untilTime). In contrast to
+     * #imagePaths, this function does not modify the state of the sequencer and can be
+     * used to look ahead in the schedule.
+     */
+    std::vector<Image> upcomingImages(const std::string& projectee,
+        const std::string& instrument, double time, double untilTime) const;
+
     /**
      * Returns true if instrumentID is within a capture range.
      */
@@ -30,6 +30,9 @@
 #include <modules/spacecraftinstruments/util/labelparser.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
@@ -39,6 +42,11 @@
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
 #include <optional>
 
 namespace {
@@ -89,6 +97,36 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo MaxPrefetchedImagesInfo = {
+        "MaxPrefetchedImages",
+        "Max Prefetched Images",
+        "The maximum number of upcoming instrument images that are decoded in the "
+        "background ahead of the time at which they are projected. A value of 0 disables "
+        "the prefetching and all images are decoded when they are projected.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The image file formats that can be decoded asynchronously. All other formats are
+    // decoded by the texture reader when they are needed
+    constexpr std::array<std::string_view, 5> AsyncDecodeExtensions = {
+        ".png", ".jpg", ".jpeg", ".tga", ".bmp"
+    };
+
+    bool canDecodeAsynchronously(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(
+            extension.begin(),
+            extension.end(),
+            extension.begin(),
+            [](char c) { return static_cast<char>(::tolower(c)); }
+        );
+        return std::find(
+            AsyncDecodeExtensions.begin(),
+            AsyncDecodeExtensions.end(),
+            extension
+        ) != AsyncDecodeExtensions.end();
+    }
+
     struct [[codegen::Dictionary(ProjectionComponent)]] Parameters {
         // This value specifies one or more directories from which images are being used
         // for image projections. If the sequence type is set to 'playbook', this value is
@@ -159,6 +197,13 @@ namespace {
         // non-planet objects (comets, asteroids, etc). The default value is '1.0'
         std::optional<float> aspectRatio;
 
+        // If this value is 'true', memory for the projection texture is only allocated
+        // for the parts that have received projections, which allows for a much larger
+        // texture size. This requires support for sparse textures by the graphics driver
+        // and is currently only available for planet projections. The default value is
+        // 'false'
+        std::optional<bool> sparseTexture;
+
         std::optional<ghoul::Dictionary> dataInputTranslation;
 
         std::optional<ghoul::Dictionary> timesDataInputTranslation;
@@ -179,6 +224,7 @@ ProjectionComponent::ProjectionComponent()
     , _projectionFading(FadingInfo, 1.f, 0.f, 1.f)
     , _textureSize(TextureSizeInfo, glm::ivec2(16), glm::ivec2(16), glm::ivec2(32768))
     , _applyTextureSize(ApplyTextureSizeInfo)
+    , _maxPrefetchedImages(MaxPrefetchedImagesInfo, 16, 0, 256)
 {
     addProperty(_performProjection);
     addProperty(_clearAllProjections);
@@ -187,6 +233,8 @@ ProjectionComponent::ProjectionComponent()
     addProperty(_textureSize);
     addProperty(_applyTextureSize);
     _applyTextureSize.onChange([this]() { _textureSizeDirty = true; });
+
+    addProperty(_maxPrefetchedImages);
 }
 
 void ProjectionComponent::initialize(const std::string& identifier,
@@ -206,6 +254,7 @@ void ProjectionComponent::initialize(const std::string& identifier,
     _dilation.isEnabled = p.textureMap.value_or(_dilation.isEnabled);
     _shadowing.isEnabled = p.shadowMap.value_or(_shadowing.isEnabled);
     _projectionTextureAspectRatio = p.aspectRatio.value_or(_projectionTextureAspectRatio);
+    _sparse.isRequested = p.sparseTexture.value_or(_sparse.isRequested);
 
     if (!p.sequence.has_value()) {
         // we are done here, the rest only applies if we do have a sequence
@@ -328,7 +377,19 @@ void ProjectionComponent::initialize(const std::string& identifier,
     parsers.clear();
 }
 
-bool ProjectionComponent::initializeGL() {
+bool ProjectionComponent::initializeGL(AllowSparseTexture allowSparseTexture) {
+    if (_sparse.isRequested) {
+        if (!allowSparseTexture) {
+            LWARNING("Sparse projection textures are not supported by this renderable");
+        }
+        else if (!SparseTextureStorage::isSupported()) {
+            LWARNING("Sparse textures are not supported, using a regular texture");
+        }
+        else {
+            _sparse.isEnabled = true;
+        }
+    }
+
     const int maxSize = OpenGLCap.max2DTextureSize();
 
     glm::ivec2 size;
@@ -342,10 +403,13 @@ bool ProjectionComponent::initializeGL() {
     }
 
     _textureSize.setMaxValue(size);
-    _textureSize = size / 2;
 
-    // We only want to use half the resolution per default:
-    size /= 2;
+    // We only want to use half the resolution per default, unless the texture is sparse
+    // in which case memory is only used for the parts that are actually projected onto
+    if (!_sparse.isEnabled) {
+        size /= 2;
+    }
+    _textureSize = size;
 
     bool success = generateProjectionLayerTexture(size);
     success &= generateDepthTexture(size);
@@ -366,7 +430,7 @@ bool ProjectionComponent::initializeGL() {
     _placeholderTexture = std::move(texture);
 
     if (_dilation.isEnabled) {
-        _dilation.program = ghoul::opengl::ProgramObject::Build(
+        _dilation.program = global::renderEngine->buildCachedProgram(
             "Dilation",
             absPath("${MODULE_SPACECRAFTINSTRUMENTS}/shaders/dilation_vs.glsl"),
             absPath("${MODULE_SPACECRAFTINSTRUMENTS}/shaders/dilation_fs.glsl")
@@ -396,6 +460,13 @@ bool ProjectionComponent::initializeGL() {
 }
 
 void ProjectionComponent::deinitialize() {
+    // The decoding tasks do not reference this component, so images that are still being
+    // decoded can be dropped without waiting for them
+    _prefetchedImages.clear();
+
+    _sparse.projection = nullptr;
+    _sparse.dilation = nullptr;
+    _sparse.stencil = nullptr;
     _projectionTexture = nullptr;
 
     glDeleteFramebuffers(1, &_fboID);
@@ -436,9 +507,32 @@ void ProjectionComponent::imageProjectBegin() {
         const std::unique_ptr<Texture> oldDilationTexture = std::move(_dilation.texture);
         const std::unique_ptr<Texture> oldDepthTexture = std::move(_shadowing.texture);
 
+        // A sparse texture only has memory in the pages that contain projections, so the
+        // same regions have to be committed in the new textures before the copy
+        std::vector<std::pair<glm::vec2, glm::vec2>> committedRegions;
+        if (_sparse.projection) {
+            const glm::uvec2 nPages = _sparse.projection->numberOfPages();
+            const glm::vec2 pageUv = 1.f / glm::vec2(nPages);
+            for (unsigned int y = 0; y < nPages.y; y++) {
+                for (unsigned int x = 0; x < nPages.x; x++) {
+                    const glm::uvec2 page = glm::uvec2(x, y);
+                    if (_sparse.projection->isCommitted(page)) {
+                        committedRegions.emplace_back(
+                            glm::vec2(page) * pageUv,
+                            glm::vec2(page + glm::uvec2(1)) * pageUv
+                        );
+                    }
+                }
+            }
+        }
+
         // Generate the new textures
         generateProjectionLayerTexture(_textureSize);
 
+        for (const auto& [uvMin, uvMax] : committedRegions) {
+            commitRegion(uvMin, uvMax);
+        }
+
         if (_shadowing.isEnabled) {
             generateDepthTexture(_textureSize);
         }
@@ -835,6 +929,17 @@ float ProjectionComponent::aspectRatio() const {
 }
 
 void ProjectionComponent::clearAllProjections() {
+    // Releasing the pages of a sparse texture discards their content and frees the memory
+    if (_sparse.projection) {
+        _sparse.projection->decommitAll();
+    }
+    if (_sparse.dilation) {
+        _sparse.dilation->decommitAll();
+    }
+    if (_sparse.stencil) {
+        _sparse.stencil->decommitAll();
+    }
+
     // keep handle to the current bound FBO
     GLint defaultFBO = 0;
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &defaultFBO);
@@ -871,6 +976,69 @@ void ProjectionComponent::generateMipMap() {
     _mipMapDirty = false;
 }
 
+bool ProjectionComponent::usesSparseTexture() const {
+    return _sparse.projection != nullptr;
+}
+
+void ProjectionComponent::commitProjectedPages(
+                                const std::function<bool(const glm::vec2&)>& isProjected,
+                                            const std::vector<glm::vec2>& projectedPoints)
+{
+    if (!_sparse.projection) {
+        return;
+    }
+
+    // The number of intervals into which each page is divided along each axis when it
+    // is sampled; the samples include the borders of the page
+    constexpr int SamplesPerPage = 4;
+
+    const glm::uvec2 nPages = _sparse.projection->numberOfPages();
+    const glm::vec2 pageUv = 1.f / glm::vec2(nPages);
+
+    std::vector<glm::uvec2> pages;
+    for (unsigned int y = 0; y < nPages.y; y++) {
+        for (unsigned int x = 0; x < nPages.x; x++) {
+            const glm::uvec2 page = glm::uvec2(x, y);
+            if (_sparse.projection->isCommitted(page)) {
+                continue;
+            }
+
+            bool isHit = false;
+            for (int j = 0; j <= SamplesPerPage && !isHit; j++) {
+                for (int i = 0; i <= SamplesPerPage && !isHit; i++) {
+                    const glm::vec2 offset = glm::vec2(i, j) / float(SamplesPerPage);
+                    isHit = isProjected((glm::vec2(page) + offset) * pageUv);
+                }
+            }
+            if (isHit) {
+                pages.push_back(page);
+            }
+        }
+    }
+
+    for (const glm::vec2& uv : projectedPoints) {
+        const glm::uvec2 page = glm::uvec2(glm::clamp(uv, 0.f, 1.f) / pageUv);
+        pages.push_back(glm::min(page, nPages - glm::uvec2(1)));
+    }
+
+    for (const glm::uvec2& page : pages) {
+        const glm::vec2 p = glm::vec2(page);
+        commitRegion((p - 1.f) * pageUv, (p + 2.f) * pageUv);
+    }
+}
+
+void ProjectionComponent::commitRegion(const glm::vec2& uvMin, const glm::vec2& uvMax) {
+    if (_sparse.projection) {
+        _sparse.projection->commit(uvMin, uvMax);
+    }
+    if (_sparse.dilation) {
+        _sparse.dilation->commit(uvMin, uvMax);
+    }
+    if (_sparse.stencil) {
+        _sparse.stencil->commit(uvMin, uvMax);
+    }
+}
+
 std::shared_ptr<ghoul::opengl::Texture> ProjectionComponent::loadProjectionTexture(
                                                  const std::filesystem::path& texturePath,
                                                            bool isPlaceholder)
@@ -881,6 +1049,55 @@ std::shared_ptr<ghoul::opengl::Texture> ProjectionComponent::loadProjectionTextu
         return _placeholderTexture;
     }
 
+    const auto it = _prefetchedImages.find(texturePath);
+    if (it != _prefetchedImages.end()) {
+        std::future<DecodedImage> decoding = std::move(it->second);
+        _prefetchedImages.erase(it);
+
+        try {
+            DecodedImage image = decoding.get();
+
+            Texture::Format format = Texture::Format::RGBA;
+            GLenum internalFormat = GL_RGBA;
+            if (image.nChannels == 2) {
+                format = Texture::Format::RG;
+                internalFormat = GL_RG;
+            }
+            else if (image.nChannels == 3) {
+                format = Texture::Format::RGB;
+                internalFormat = GL_RGB;
+            }
+
+            auto texture = std::make_shared<Texture>(
+                glm::uvec3(image.size, 1),
+                GL_TEXTURE_2D,
+                format,
+                internalFormat,
+                GL_UNSIGNED_BYTE,
+                Texture::FilterMode::Linear,
+                Texture::WrappingMode::Repeat,
+                Texture::AllocateData::No,
+                Texture::TakeOwnership::No
+            );
+            texture->setPixelData(image.pixels.data(), Texture::TakeOwnership::No);
+            texture->uploadTexture();
+            // The pixel data is only needed for the upload and is freed after this
+            texture->setPixelData(nullptr, Texture::TakeOwnership::No);
+            texture->setWrapping(
+                { Texture::WrappingMode::Repeat, Texture::WrappingMode::MirroredRepeat }
+            );
+            texture->setFilter(Texture::FilterMode::LinearMipMap);
+            return texture;
+        }
+        catch (const ghoul::RuntimeError& e) {
+            // Fall back to the synchronous loading, which will report a proper error
+            LWARNING(std::format(
+                "Failed to decode image '{}' in the background: {}",
+                texturePath, e.message
+            ));
+        }
+    }
+
     std::unique_ptr<Texture> texture = ghoul::io::TextureReader::ref().loadTexture(
         absPath(texturePath),
         2
@@ -898,7 +1115,91 @@ std::shared_ptr<ghoul::opengl::Texture> ProjectionComponent::loadProjectionTextu
     return texture;
 }
 
+void ProjectionComponent::prefetchProjectionTextures(
+                                          const std::vector<std::filesystem::path>& paths)
+{
+    // Discard the images that are no longer needed, for example after a time jump
+    for (auto it = _prefetchedImages.begin(); it != _prefetchedImages.end();) {
+        if (std::find(paths.begin(), paths.end(), it->first) == paths.end()) {
+            it = _prefetchedImages.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+
+    for (const std::filesystem::path& path : paths) {
+        if (std::ssize(_prefetchedImages) >= _maxPrefetchedImages) {
+            break;
+        }
+
+        if (_prefetchedImages.contains(path) || !canDecodeAsynchronously(path)) {
+            continue;
+        }
+
+        _prefetchedImages[path] = global::threadPool->submit(
+            [p = absPath(path)]() { return decodeImage(p); },
+            ThreadPool::Priority::Low
+        );
+    }
+}
+
+bool ProjectionComponent::isProjectionTextureReady(
+                                           const std::filesystem::path& texturePath) const
+{
+    const auto it = _prefetchedImages.find(texturePath);
+    if (it == _prefetchedImages.end()) {
+        return true;
+    }
+    using namespace std::chrono_literals;
+    return it->second.wait_for(0s) == std::future_status::ready;
+}
+
+ProjectionComponent::DecodedImage ProjectionComponent::decodeImage(
+                                                        const std::filesystem::path& path)
+{
+    // Match the orientation of the images that are loaded through the TextureReader.
+    // The thread-local version is used as other threads might be decoding images too
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    int width = 0;
+    int height = 0;
+    int nChannels = 0;
+    stbi_uc* data = stbi_load(path.string().c_str(), &width, &height, &nChannels, 0);
+    if (!data) {
+        throw ghoul::RuntimeError(std::format(
+            "Error decoding '{}': {}", path, stbi_failure_reason()
+        ));
+    }
+
+    DecodedImage image;
+    image.size = glm::uvec2(width, height);
+    const size_t nPixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (nChannels == 1) {
+        // Single channel images are converted to RGB, just as the synchronous loading
+        // does through ghoul::opengl::convertTextureFormat
+        image.nChannels = 3;
+        image.pixels.resize(nPixels * 3);
+        for (size_t i = 0; i < nPixels; i++) {
+            image.pixels[3 * i] = data[i];
+            image.pixels[3 * i + 1] = data[i];
+            image.pixels[3 * i + 2] = data[i];
+        }
+    }
+    else {
+        image.nChannels = nChannels;
+        image.pixels.assign(data, data + nPixels * nChannels);
+    }
+    stbi_image_free(data);
+
+    return image;
+}
+
 bool ProjectionComponent::generateProjectionLayerTexture(const glm::ivec2& size) {
+    if (_sparse.isEnabled) {
+        return generateSparseProjectionLayerTexture(size);
+    }
+
     LINFO(std::format("Creating projection texture of size ({}, {})", size.x, size.y));
 
     using namespace ghoul::opengl;
@@ -937,6 +1238,56 @@ bool ProjectionComponent::generateProjectionLayerTexture(const glm::ivec2& size)
     return _projectionTexture != nullptr;
 }
 
+bool ProjectionComponent::generateSparseProjectionLayerTexture(const glm::ivec2& size) {
+    using namespace ghoul::opengl;
+
+    // The dilation textures have the same size as the projection texture, so the size
+    // has to be a multiple of the page sizes of both formats
+    const glm::uvec2 rgba = SparseTextureStorage::pageSize(GL_RGBA8);
+    const glm::uvec2 red = SparseTextureStorage::pageSize(GL_R8);
+    const glm::uvec2 pageSize = glm::uvec2(
+        std::lcm(rgba.x, red.x),
+        std::lcm(rgba.y, red.y)
+    );
+    const glm::uvec2 s = glm::max(glm::uvec2(size) / pageSize, glm::uvec2(1)) * pageSize;
+    LINFO(std::format("Creating sparse projection texture of size ({}, {})", s.x, s.y));
+
+    auto createTexture = [&s](Texture::Format format, GLenum internalFormat) {
+        return std::make_unique<Texture>(
+            glm::uvec3(s, 1),
+            GL_TEXTURE_2D,
+            format,
+            internalFormat,
+            GL_UNSIGNED_BYTE,
+            Texture::FilterMode::Linear,
+            Texture::WrappingMode::Repeat,
+            Texture::AllocateData::No
+        );
+    };
+
+    _projectionTexture = createTexture(Texture::Format::RGBA, GL_RGBA8);
+    _sparse.projection = std::make_unique<SparseTextureStorage>(
+        *_projectionTexture,
+        GL_RGBA8
+    );
+
+    if (_dilation.isEnabled) {
+        _dilation.texture = createTexture(Texture::Format::RGBA, GL_RGBA8);
+        _sparse.dilation = std::make_unique<SparseTextureStorage>(
+            *_dilation.texture,
+            GL_RGBA8
+        );
+
+        _dilation.stencilTexture = createTexture(Texture::Format::Red, GL_R8);
+        _sparse.stencil = std::make_unique<SparseTextureStorage>(
+            *_dilation.stencilTexture,
+            GL_R8
+        );
+    }
+
+    return true;
+}
+
 bool ProjectionComponent::generateDepthTexture(const glm::ivec2& size) {
     LINFO(std::format("Creating depth texture of size ({}, {})", size.x, size.y));
 
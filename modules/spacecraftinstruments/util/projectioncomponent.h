@@ -27,12 +27,20 @@
 
 #include <openspace/properties/propertyowner.h>
 
+#include <modules/spacecraftinstruments/util/sparsetexturestorage.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/ivec2property.h>
 #include <openspace/util/spicemanager.h>
+#include <ghoul/misc/boolean.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <vector>
 
 namespace ghoul { class Dictionary; }
 namespace ghoul::opengl {
@@ -46,10 +54,19 @@ namespace documentation { struct Documentation; }
 
 class ProjectionComponent : public properties::PropertyOwner {
 public:
+    BooleanType(AllowSparseTexture);
+
     ProjectionComponent();
 
     void initialize(const std::string& identifier, const ghoul::Dictionary& dictionary);
-    bool initializeGL();
+
+    /**
+     * Creates the projection textures and render targets. If \p allowSparseTexture is
+     * `Yes`, the owner promises to call #commitProjectedPages before every projection,
+     * in which case the projection texture is a sparse texture if that was requested and
+     * is supported.
+     */
+    bool initializeGL(AllowSparseTexture allowSparseTexture = AllowSparseTexture::No);
     void deinitialize();
 
     bool isReady() const;
@@ -68,6 +85,21 @@ public:
     std::shared_ptr<ghoul::opengl::Texture> loadProjectionTexture(
         const std::filesystem::path& texturePath, bool isPlaceholder = false);
 
+    /**
+     * Starts decoding the images at the provided \p paths on the global thread pool, so
+     * that a later call to #loadProjectionTexture only has to upload the decoded image.
+     * The \p paths should be ordered by the time at which the images are needed. At most
+     * `MaxPrefetchedImages` images are kept and previously prefetched images that are
+     * not part of \p paths are discarded.
+     */
+    void prefetchProjectionTextures(const std::vector<std::filesystem::path>& paths);
+
+    /**
+     * Returns `false` if the image at \p texturePath is currently being decoded in the
+     * background, which means that #loadProjectionTexture would block until it is done.
+     */
+    bool isProjectionTextureReady(const std::filesystem::path& texturePath) const;
+
     glm::mat4 computeProjectorMatrix(const glm::vec3& loc, const glm::dvec3& aim,
         const glm::vec3& up, const glm::dmat3& instrumentMatrix, float fieldOfViewY,
         float aspectRatio, float nearPlane, float farPlane, glm::vec3& boreSight);
@@ -82,6 +114,25 @@ public:
     void clearAllProjections();
     void generateMipMap();
 
+    /**
+     * Returns `true` if memory for the projection texture is only allocated for the pages
+     * that have been committed through #commitProjectedPages.
+     */
+    bool usesSparseTexture() const;
+
+    /**
+     * Makes sure that the pages of a sparse projection texture that are written by the
+     * next projection are backed by memory. \p isProjected is evaluated on a grid of
+     * texture coordinates in each page that is not committed yet and has to return
+     * whether the texture coordinate receives the projection. The pages that contain
+     * any of the \p projectedPoints, texture coordinates known to receive the
+     * projection, are committed as well, which catches projections that are smaller than
+     * the sampling grid. Each page is committed together with its direct neighbors. This
+     * function does nothing if the projection texture is not sparse.
+     */
+    void commitProjectedPages(const std::function<bool(const glm::vec2&)>& isProjected,
+        const std::vector<glm::vec2>& projectedPoints);
+
     ghoul::opengl::Texture& projectionTexture() const;
 
     std::string projectorId() const;
@@ -95,7 +146,24 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /// The result of decoding an image file without uploading it to the GPU
+    struct DecodedImage {
+        std::vector<GLubyte> pixels;
+        glm::uvec2 size = glm::uvec2(0);
+        int nChannels = 0;
+    };
+
+    /**
+     * Decodes the image at \p path into memory. This function does not call any OpenGL
+     * functions and is thus safe to call from a worker thread.
+     *
+     * \throw ghoul::RuntimeError If the image could not be decoded
+     */
+    static DecodedImage decodeImage(const std::filesystem::path& path);
+
     bool generateProjectionLayerTexture(const glm::ivec2& size);
+    bool generateSparseProjectionLayerTexture(const glm::ivec2& size);
+    void commitRegion(const glm::vec2& uvMin, const glm::vec2& uvMax);
     bool generateDepthTexture(const glm::ivec2& size);
 
 protected:
@@ -105,12 +173,16 @@ protected:
 
     properties::IVec2Property _textureSize;
     properties::TriggerProperty _applyTextureSize;
+    properties::IntProperty _maxPrefetchedImages;
     bool _textureSizeDirty = false;
     bool _mipMapDirty = false;
 
     std::unique_ptr<ghoul::opengl::Texture> _projectionTexture;
     std::shared_ptr<ghoul::opengl::Texture> _placeholderTexture;
 
+    /// Images that are being decoded, or have been decoded, ahead of their use
+    std::map<std::filesystem::path, std::future<DecodedImage>> _prefetchedImages;
+
     float _projectionTextureAspectRatio = 1.f;
 
     std::string _instrumentID;
@@ -132,6 +204,14 @@ protected:
         std::unique_ptr<ghoul::opengl::Texture> texture;
     } _shadowing;
 
+    struct {
+        bool isRequested = false;
+        bool isEnabled = false;
+        std::unique_ptr<SparseTextureStorage> projection;
+        std::unique_ptr<SparseTextureStorage> dilation;
+        std::unique_ptr<SparseTextureStorage> stencil;
+    } _sparse;
+
     struct {
         bool isEnabled = false;
         GLuint fbo = 0;
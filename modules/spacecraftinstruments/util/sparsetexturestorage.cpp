@@ -0,0 +1,217 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/spacecraftinstruments/util/sparsetexturestorage.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/opengl/texture.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
+#include <bit>
+
+namespace {
+    size_t bytesPerTexel(GLenum internalFormat) {
+        switch (internalFormat) {
+            case GL_R8:
+                return 1;
+            case GL_RG8:
+                return 2;
+            case GL_RGBA16:
+            case GL_RGBA16F:
+                return 8;
+            case GL_RGBA32F:
+                return 16;
+            default:
+                return 4;
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+bool SparseTextureStorage::isSupported() {
+    return OpenGLCap.isExtensionSupported("GL_ARB_sparse_texture") &&
+           OpenGLCap.isExtensionSupported("GL_ARB_sparse_texture2");
+}
+
+glm::uvec2 SparseTextureStorage::pageSize(GLenum internalFormat) {
+    // The first page size is the one that is used unless a different page size index is
+    // selected for a texture
+    GLint x = 0;
+    glGetInternalformativ(
+        GL_TEXTURE_2D,
+        internalFormat,
+        GL_VIRTUAL_PAGE_SIZE_X_ARB,
+        1,
+        &x
+    );
+    GLint y = 0;
+    glGetInternalformativ(
+        GL_TEXTURE_2D,
+        internalFormat,
+        GL_VIRTUAL_PAGE_SIZE_Y_ARB,
+        1,
+        &y
+    );
+    return glm::uvec2(std::max(x, 1), std::max(y, 1));
+}
+
+SparseTextureStorage::SparseTextureStorage(ghoul::opengl::Texture& texture,
+                                           GLenum internalFormat)
+    : _texture(texture)
+    , _pageSize(pageSize(internalFormat))
+    , _bytesPerPage(
+        static_cast<size_t>(_pageSize.x) * _pageSize.y * bytesPerTexel(internalFormat)
+    )
+{
+    const glm::uvec2 size = glm::uvec2(texture.dimensions());
+    ghoul_assert(
+        size.x % _pageSize.x == 0 && size.y % _pageSize.y == 0,
+        "Texture size must be a multiple of the page size"
+    );
+
+    const int nLevels = std::bit_width(std::max(size.x, size.y));
+
+    _texture.bind();
+    // The sparseness has to be set before the immutable storage is allocated
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SPARSE_ARB, 1);
+    glTexStorage2D(
+        GL_TEXTURE_2D,
+        nLevels,
+        internalFormat,
+        static_cast<GLsizei>(size.x),
+        static_cast<GLsizei>(size.y)
+    );
+
+    GLint nSparseLevels = 0;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_NUM_SPARSE_LEVELS_ARB, &nSparseLevels);
+    nSparseLevels = std::min(nSparseLevels, nLevels);
+
+    for (int i = 0; i < nSparseLevels; i++) {
+        Level level;
+        level.size = glm::max(size >> glm::uvec2(i), glm::uvec2(1));
+        level.nPages = (level.size + _pageSize - glm::uvec2(1)) / _pageSize;
+        level.isCommitted.resize(static_cast<size_t>(level.nPages.x) * level.nPages.y);
+        _levels.push_back(std::move(level));
+    }
+
+    // The mipmap tail is always backed by memory, as it is neither large nor divisible
+    // into pages
+    for (int i = nSparseLevels; i < nLevels; i++) {
+        const glm::uvec2 s = glm::max(size >> glm::uvec2(i), glm::uvec2(1));
+        glTexPageCommitmentARB(
+            GL_TEXTURE_2D,
+            i,
+            0, 0, 0,
+            static_cast<GLsizei>(s.x), static_cast<GLsizei>(s.y), 1,
+            GL_TRUE
+        );
+    }
+}
+
+void SparseTextureStorage::commit(const glm::vec2& uvMin, const glm::vec2& uvMax) {
+    const glm::vec2 lower = glm::clamp(uvMin, glm::vec2(0.f), glm::vec2(1.f));
+    const glm::vec2 upper = glm::clamp(uvMax, glm::vec2(0.f), glm::vec2(1.f));
+
+    _texture.bind();
+    for (size_t i = 0; i < _levels.size(); i++) {
+        const Level& level = _levels[i];
+        const glm::uvec2 texelMin = glm::uvec2(glm::floor(lower * glm::vec2(level.size)));
+        const glm::uvec2 texelMax = glm::uvec2(glm::ceil(upper * glm::vec2(level.size)));
+        if (texelMax.x <= texelMin.x || texelMax.y <= texelMin.y) {
+            continue;
+        }
+
+        const glm::uvec2 pageMin = texelMin / _pageSize;
+        const glm::uvec2 pageMax = glm::min(
+            (texelMax - glm::uvec2(1)) / _pageSize,
+            level.nPages - glm::uvec2(1)
+        );
+        for (unsigned int y = pageMin.y; y <= pageMax.y; y++) {
+            for (unsigned int x = pageMin.x; x <= pageMax.x; x++) {
+                if (!level.isCommitted[y * level.nPages.x + x]) {
+                    setCommitment(static_cast<int>(i), glm::uvec2(x, y), true);
+                }
+            }
+        }
+    }
+}
+
+void SparseTextureStorage::decommitAll() {
+    _texture.bind();
+    for (size_t i = 0; i < _levels.size(); i++) {
+        const Level& level = _levels[i];
+        for (unsigned int y = 0; y < level.nPages.y; y++) {
+            for (unsigned int x = 0; x < level.nPages.x; x++) {
+                if (level.isCommitted[y * level.nPages.x + x]) {
+                    setCommitment(static_cast<int>(i), glm::uvec2(x, y), false);
+                }
+            }
+        }
+    }
+}
+
+bool SparseTextureStorage::isCommitted(const glm::uvec2& page) const {
+    if (_levels.empty()) {
+        // Without any sparse levels, the whole texture is part of the mipmap tail
+        return true;
+    }
+    const Level& level = _levels.front();
+    ghoul_assert(page.x < level.nPages.x && page.y < level.nPages.y, "Invalid page");
+    return level.isCommitted[page.y * level.nPages.x + page.x];
+}
+
+glm::uvec2 SparseTextureStorage::numberOfPages() const {
+    return _levels.empty() ? glm::uvec2(1) : _levels.front().nPages;
+}
+
+size_t SparseTextureStorage::committedBytes() const {
+    size_t nPages = 0;
+    for (const Level& level : _levels) {
+        nPages += static_cast<size_t>(
+            std::count(level.isCommitted.begin(), level.isCommitted.end(), true)
+        );
+    }
+    return nPages * _bytesPerPage;
+}
+
+void SparseTextureStorage::setCommitment(int level, const glm::uvec2& page, bool commit)
+{
+    Level& l = _levels[level];
+
+    // Pages at the border of a level can be smaller than a full page, in which case the
+    // committed region has to end at the border of the level instead
+    const glm::uvec2 offset = page * _pageSize;
+    const glm::uvec2 extent = glm::min(_pageSize, l.size - offset);
+    glTexPageCommitmentARB(
+        GL_TEXTURE_2D,
+        level,
+        static_cast<GLint>(offset.x), static_cast<GLint>(offset.y), 0,
+        static_cast<GLsizei>(extent.x), static_cast<GLsizei>(extent.y), 1,
+        commit ? GL_TRUE : GL_FALSE
+    );
+    l.isCommitted[page.y * l.nPages.x + page.x] = commit;
+}
+
+} // namespace openspace
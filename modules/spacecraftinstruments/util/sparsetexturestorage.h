@@ -0,0 +1,114 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACECRAFTINSTRUMENTS___SPARSETEXTURESTORAGE___H__
+#define __OPENSPACE_MODULE_SPACECRAFTINSTRUMENTS___SPARSETEXTURESTORAGE___H__
+
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <vector>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+/**
+ * The storage of a two-dimensional texture for which memory is only allocated for the
+ * pages that are actually used, based on the `GL_ARB_sparse_texture` extension. The
+ * storage contains a full mipmap chain, and committing a region of the texture commits
+ * the corresponding pages on all mipmap levels so that mipmaps can be generated as
+ * usual. Writes into pages that are not committed are discarded and reads from them
+ * return 0.
+ */
+class SparseTextureStorage {
+public:
+    /**
+     * Returns whether the current OpenGL context supports sparse textures. Both the
+     * `GL_ARB_sparse_texture` and the `GL_ARB_sparse_texture2` extensions are required,
+     * as only the latter guarantees that uncommitted pages read as 0.
+     */
+    static bool isSupported();
+
+    /**
+     * Returns the size of a page in texels for textures with the \p internalFormat. The
+     * dimensions of a sparse texture have to be multiples of this size.
+     */
+    static glm::uvec2 pageSize(GLenum internalFormat);
+
+    /**
+     * Allocates sparse storage for the \p texture with the provided \p internalFormat.
+     * The \p texture must not have any storage yet, must not be uploaded afterwards, and
+     * has to outlive this object. Only the mipmap levels that are smaller than a single
+     * page are committed by this constructor.
+     */
+    SparseTextureStorage(ghoul::opengl::Texture& texture, GLenum internalFormat);
+
+    /**
+     * Commits all pages, on all mipmap levels, that overlap the region between
+     * \p uvMin and \p uvMax in texture coordinates.
+     */
+    void commit(const glm::vec2& uvMin, const glm::vec2& uvMax);
+
+    /**
+     * Releases the memory of all pages that have previously been committed.
+     */
+    void decommitAll();
+
+    /**
+     * Returns whether the page at the index \p page of the largest mipmap level is
+     * committed.
+     */
+    bool isCommitted(const glm::uvec2& page) const;
+
+    /**
+     * Returns the number of pages of the largest mipmap level in each direction.
+     */
+    glm::uvec2 numberOfPages() const;
+
+    /**
+     * Returns the number of bytes that are currently committed, not counting the
+     * mipmap levels that are smaller than a page.
+     */
+    size_t committedBytes() const;
+
+private:
+    struct Level {
+        glm::uvec2 size = glm::uvec2(0);
+        glm::uvec2 nPages = glm::uvec2(0);
+        std::vector<bool> isCommitted;
+    };
+
+    void setCommitment(int level, const glm::uvec2& page, bool commit);
+
+    ghoul::opengl::Texture& _texture;
+    glm::uvec2 _pageSize = glm::uvec2(0);
+    size_t _bytesPerPage = 0;
+    // Only the levels that consist of individual pages, the remaining smaller levels
+    // form the mipmap tail that is committed as a whole
+    std::vector<Level> _levels;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACECRAFTINSTRUMENTS___SPARSETEXTURESTORAGE___H__
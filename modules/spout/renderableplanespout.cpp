@@ -94,7 +94,7 @@ void RenderablePlaneSpout::update(const UpdateData& data) {
 void RenderablePlaneSpout::bindTexture() {
     if (_spoutReceiver.isReceiving()) {
         _spoutReceiver.saveGLTextureState();
-        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(_spoutReceiver.spoutTexture()));
+        _spoutReceiver.bindReceivedTexture();
     }
     else {
         RenderablePlane::bindTexture();
@@ -103,6 +103,7 @@ void RenderablePlaneSpout::bindTexture() {
 
 void RenderablePlaneSpout::unbindTexture() {
     if (_spoutReceiver.isReceiving()) {
+        _spoutReceiver.unbindReceivedTexture();
         _spoutReceiver.restoreGLTextureState();
     }
     else {
@@ -110,6 +111,10 @@ void RenderablePlaneSpout::unbindTexture() {
     }
 }
 
+bool RenderablePlaneSpout::isTextureFlipped() const {
+    return _spoutReceiver.isUsingSharedTexture();
+}
+
 } // namespace openspace
 
 #endif // WIN32
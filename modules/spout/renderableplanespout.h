@@ -47,6 +47,7 @@ public:
 private:
     void bindTexture() override;
     void unbindTexture() override;
+    bool isTextureFlipped() const override;
 
     spout::SpoutReceiverPropertyProxy _spoutReceiver;
 };
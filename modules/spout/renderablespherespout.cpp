@@ -91,7 +91,7 @@ void RenderableSphereSpout::update(const UpdateData& data) {
 void RenderableSphereSpout::bindTexture() {
     if (_spoutReceiver.isReceiving()) {
         _spoutReceiver.saveGLTextureState();
-        glBindTexture(GL_TEXTURE_2D, _spoutReceiver.spoutTexture());
+        _spoutReceiver.bindReceivedTexture();
     }
     else {
         RenderableSphere::unbindTexture();
@@ -100,6 +100,7 @@ void RenderableSphereSpout::bindTexture() {
 
 void RenderableSphereSpout::unbindTexture() {
     if (_spoutReceiver.isReceiving()) {
+        _spoutReceiver.unbindReceivedTexture();
         _spoutReceiver.restoreGLTextureState();
     }
     else {
@@ -107,6 +108,10 @@ void RenderableSphereSpout::unbindTexture() {
     }
 }
 
+bool RenderableSphereSpout::isTextureFlipped() const {
+    return _spoutReceiver.isUsingSharedTexture();
+}
+
 } // namespace openspace
 
 #endif // WIN32
@@ -100,12 +100,23 @@ void ScreenSpaceSpout::update() {
     _spoutReceiver.updateReceiver();
 }
 
+glm::mat4 ScreenSpaceSpout::scaleMatrix() {
+    glm::mat4 scale = ScreenSpaceRenderable::scaleMatrix();
+    if (_spoutReceiver.isUsingSharedTexture()) {
+        // The shared texture is stored top-down. As the quad is rendered without face
+        // culling, it can be mirrored instead of flipping the texture coordinates
+        scale = glm::scale(scale, glm::vec3(1.f, -1.f, 1.f));
+    }
+    return scale;
+}
+
 void ScreenSpaceSpout::bindTexture() {
     _spoutReceiver.saveGLTextureState();
-    glBindTexture(GL_TEXTURE_2D, _spoutReceiver.spoutTexture());
+    _spoutReceiver.bindReceivedTexture();
 }
 
 void ScreenSpaceSpout::unbindTexture() {
+    _spoutReceiver.unbindReceivedTexture();
     _spoutReceiver.restoreGLTextureState();
 }
 
@@ -48,6 +48,7 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    glm::mat4 scaleMatrix() override;
     void bindTexture() override;
     void unbindTexture() override;
 
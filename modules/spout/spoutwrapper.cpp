@@ -176,10 +176,31 @@ bool SpoutReceiver::updateReceiver() {
     std::memcpy(currentSpoutName, _currentSpoutName.data(), _currentSpoutName.size());
     _spoutHandle->CheckReceiver(currentSpoutName, width, height, _isReceiving);
 
+    // In memory share mode there is no texture that could be shared, so the frames
+    // have to be copied
+    _isUsingSharedTexture = _isReceiving && !_spoutHandle->GetMemoryShareMode();
+
     // if spout is not connected a 10x10 texture is created
-    if (updateTexture(width, height) && _isReceiving) {
-        saveGLState();
+    if (!updateTexture(width, height) || !_isReceiving) {
+        return false;
+    }
 
+    saveGLState();
+
+    bool success = true;
+    if (_isUsingSharedTexture) {
+        // Without a texture, Spout only updates the connection to the sender and the
+        // frame is sampled directly from the shared texture
+        _spoutHandle->ReceiveTexture(currentSpoutName, width, height);
+
+        if (_onUpdateReceiverCallback && bindReceivedTexture()) {
+            GLint t = 0;
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &t);
+            success = _onUpdateReceiverCallback(width, height, static_cast<GLuint>(t));
+            unbindReceivedTexture();
+        }
+    }
+    else {
         _spoutHandle->ReceiveTexture(
             currentSpoutName,
             width,
@@ -191,17 +212,12 @@ bool SpoutReceiver::updateReceiver() {
 
         if (_onUpdateReceiverCallback) {
             const GLuint t = static_cast<GLuint>(*_spoutTexture);
-            if (!_onUpdateReceiverCallback(width, height, t)) {
-                restoreGLState();
-                return false;
-            }
+            success = _onUpdateReceiverCallback(width, height, t);
         }
-
-        restoreGLState();
-        return true;
     }
 
-    return false;
+    restoreGLState();
+    return success;
 }
 
 bool SpoutReceiver::updateReceiverName(const std::string& name) {
@@ -245,8 +261,10 @@ void SpoutReceiver::releaseReceiver() {
         return;
     }
 
+    unbindReceivedTexture();
     _isReceiving = false;
     _isCreated = false;
+    _isUsingSharedTexture = false;
     _isErrorMessageDisplayed = false;
     _currentSpoutName.clear();
     if (_onReleaseReceiverCallback) {
@@ -289,9 +307,40 @@ unsigned int SpoutReceiver::spoutTexture() const {
     return _spoutTexture ? static_cast<unsigned int>(*_spoutTexture) : 0;
 }
 
+bool SpoutReceiver::isUsingSharedTexture() const {
+    return _isUsingSharedTexture;
+}
+
+bool SpoutReceiver::bindReceivedTexture() {
+    if (_isUsingSharedTexture) {
+        if (!_isSharedTextureBound) {
+            _isSharedTextureBound = _spoutHandle->BindSharedTexture();
+        }
+        return _isSharedTextureBound;
+    }
+    if (_spoutTexture) {
+        _spoutTexture->bind();
+        return true;
+    }
+    return false;
+}
+
+void SpoutReceiver::unbindReceivedTexture() {
+    if (_isSharedTextureBound) {
+        _spoutHandle->UnBindSharedTexture();
+        _isSharedTextureBound = false;
+    }
+}
+
 bool SpoutReceiver::updateTexture(unsigned int width, unsigned int height) {
-    if (width != _spoutWidth || height != _spoutHeight) {
-        releaseTexture();
+    // The own texture is only needed if the frames are copied
+    const bool needsTexture = !_isUsingSharedTexture && !_spoutTexture;
+    if (width == _spoutWidth && height == _spoutHeight && !needsTexture) {
+        return true;
+    }
+
+    releaseTexture();
+    if (!_isUsingSharedTexture) {
         _spoutTexture = std::make_unique<ghoul::opengl::Texture>(
             glm::uvec3(width, height, 1),
             GL_TEXTURE_2D,
@@ -302,27 +351,18 @@ bool SpoutReceiver::updateTexture(unsigned int width, unsigned int height) {
             ghoul::opengl::Texture::AllocateData::No,
             ghoul::opengl::Texture::TakeOwnership::No
         );
+        _spoutTexture->uploadTexture();
+    }
 
-        if (_spoutTexture) {
-            _spoutTexture->uploadTexture();
-            if (_onUpdateTextureCallback && !_onUpdateTextureCallback(width, height)) {
-                LWARNING(std::format(
-                    "Could not create callback texture for {} -> {}x{}",
-                    _currentSpoutName, width, height
-                ));
-                return false;
-            }
-            _spoutWidth = width;
-            _spoutHeight = height;
-        }
-        else {
-            LWARNING(std::format(
-                "Could not create texture for {} -> {}x{}",
-                _currentSpoutName, width, height
-            ));
-            return false;
-        }
+    if (_onUpdateTextureCallback && !_onUpdateTextureCallback(width, height)) {
+        LWARNING(std::format(
+            "Could not create callback texture for {} -> {}x{}",
+            _currentSpoutName, width, height
+        ));
+        return false;
     }
+    _spoutWidth = width;
+    _spoutHeight = height;
     return true;
 }
 
@@ -332,7 +372,7 @@ void SpoutReceiver::releaseTexture() {
     if (_onReleaseTextureCallback) {
         _onReleaseTextureCallback();
     }
-    _spoutTexture.release();
+    _spoutTexture = nullptr;
 }
 
 const properties::Property::PropertyInfo& SpoutReceiverPropertyProxy::NameInfoProperty() {
@@ -469,6 +509,16 @@ bool SpoutSender::updateSenderStatus() {
             }
             return false;
         }
+
+        // With texture sharing, the frames are copied on the GPU into the texture that
+        // is shared with the receivers. In memory share mode, every frame has to be
+        // read back to the CPU instead, which is much slower
+        if (_spoutHandle->GetMemoryShareMode()) {
+            LWARNING(std::format(
+                "Spout is running in memory share mode, so the frames for {} are read "
+                "back through the CPU", _currentSpoutName
+            ));
+        }
     }
 
     _isErrorMessageDisplayed = false;
@@ -562,7 +612,7 @@ void SpoutSender::releaseSender() {
         _onReleaseSenderCallback();
     }
     if (_spoutHandle) {
-        _spoutHandle->ReleaseReceiver();
+        _spoutHandle->ReleaseSender();
     }
 }
 
@@ -92,6 +92,29 @@ public:
     bool isReceiving() const;
     unsigned int spoutTexture() const;
 
+    /**
+     * Returns `true` if the frames of the sender are sampled directly from the texture
+     * that Spout shares between the sender and all receivers, instead of being copied
+     * into a texture owned by this receiver every frame. This is the case unless
+     * Spout is running in memory share mode. The shared texture is stored top-down, so
+     * it has to be flipped vertically when it is sampled.
+     */
+    bool isUsingSharedTexture() const;
+
+    /**
+     * Binds the most recent frame to the `GL_TEXTURE_2D` target of the active texture
+     * unit. If the shared texture is used, it stays locked for the sender until
+     * #unbindReceivedTexture is called, so the two calls should be close together.
+     *
+     * \return `true` if a frame has been bound
+     */
+    bool bindReceivedTexture();
+
+    /**
+     * Releases the frame that was bound by #bindReceivedTexture.
+     */
+    void unbindReceivedTexture();
+
 private:
     bool updateTexture(unsigned int width, unsigned int height);
     void releaseTexture();
@@ -99,6 +122,8 @@ private:
     bool _isErrorMessageDisplayed = false;
     bool _isCreated = false;
     bool _isReceiving = false;
+    bool _isUsingSharedTexture = false;
+    bool _isSharedTextureBound = false;
     std::vector<std::string> _receiverList;
 
     std::unique_ptr<ghoul::opengl::Texture> _spoutTexture;
@@ -53,6 +53,23 @@ namespace {
 
         // The folder where all of the synchronizations are stored
         std::string synchronizationRoot;
+
+        // The URL of a peer cache, which is an HTTP server in the local network that
+        // serves the synchronization folder of another OpenSpace instance, for example
+        // the master node of a cluster. If this value is provided, files are first
+        // requested from the peer cache and only downloaded from the upstream servers
+        // if the peer does not provide them
+        std::optional<std::string> peerCache;
+
+        // The number of seconds that a synchronization waits for the peer cache to
+        // finish the same synchronization before it falls back to the upstream servers.
+        // The default is to not wait at all
+        std::optional<int> peerCacheWaitTime [[codegen::greaterequal(0)]];
+
+        // If this value is 'true', this instance's synchronization folder is served as a
+        // peer cache to other instances. Archives are then kept after they have been
+        // unzipped, so that peers can download them
+        std::optional<bool> servePeerCache;
     };
 #include "syncmodule_codegen.cpp"
 } // namespace
@@ -74,6 +91,10 @@ void SyncModule::internalInitialize(const ghoul::Dictionary& configuration) {
 
     _synchronizationRoot = absPath(p.synchronizationRoot);
 
+    _peerCache.url = p.peerCache.value_or(_peerCache.url);
+    _peerCache.waitTime = std::chrono::seconds(p.peerCacheWaitTime.value_or(0));
+    _peerCache.isServing = p.servePeerCache.value_or(_peerCache.isServing);
+
     ghoul::TemplateFactory<ResourceSynchronization>* fSynchronization =
         FactoryManager::ref().factory<ResourceSynchronization>();
     ghoul_assert(fSynchronization, "ResourceSynchronization factory was not created");
@@ -86,14 +107,16 @@ void SyncModule::internalInitialize(const ghoul::Dictionary& configuration) {
                 return new (ptr) HttpSynchronization(
                     dictionary,
                     _synchronizationRoot,
-                    _synchronizationRepositories
+                    _synchronizationRepositories,
+                    _peerCache
                 );
             }
             else {
                 return new HttpSynchronization(
                     dictionary,
                     _synchronizationRoot,
-                    _synchronizationRepositories
+                    _synchronizationRepositories,
+                    _peerCache
                 );
             }
         }
@@ -104,10 +127,18 @@ void SyncModule::internalInitialize(const ghoul::Dictionary& configuration) {
         [this](bool, const ghoul::Dictionary& dictionary, ghoul::MemoryPoolBase* pool) {
             if (pool) {
                 void* ptr = pool->allocate(sizeof(UrlSynchronization));
-                return new (ptr) UrlSynchronization(dictionary, _synchronizationRoot);
+                return new (ptr) UrlSynchronization(
+                    dictionary,
+                    _synchronizationRoot,
+                    _peerCache
+                );
             }
             else {
-                return new UrlSynchronization(dictionary, _synchronizationRoot);
+                return new UrlSynchronization(
+                    dictionary,
+                    _synchronizationRoot,
+                    _peerCache
+                );
             }
         }
     );
@@ -27,6 +27,7 @@
 
 #include <openspace/util/openspacemodule.h>
 
+#include <modules/sync/syncs/peercache.h>
 #include <filesystem>
 
 namespace openspace {
@@ -49,6 +50,7 @@ protected:
 private:
     std::vector<std::string> _synchronizationRepositories;
     std::filesystem::path _synchronizationRoot;
+    PeerCache _peerCache;
 };
 
 } // namespace openspace
@@ -26,11 +26,17 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/downloadmanager.h>
+#include <openspace/engine/globals.h>
 #include <openspace/util/httprequest.h>
 #include <ghoul/ext/assimp/contrib/zip/src/zip.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/stringhelper.h>
+#include <array>
+#include <charconv>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <unordered_map>
 
 namespace {
@@ -41,6 +47,83 @@ namespace {
     constexpr std::string_view OssyncVersionNumber = "1.0";
     constexpr std::string_view SynchronizationToken = "Synchronized";
 
+    constexpr int MaxDownloadRetries = 5;
+
+    // A single line of the file list returned by the synchronization server. Apart from
+    // the URL, the server can provide the size in bytes and the CRC-32 of the file as
+    // an 8 digit hexadecimal number, separated by whitespace
+    struct ManifestEntry {
+        std::string url;
+        std::optional<uintmax_t> size;
+        std::optional<uint32_t> crc;
+    };
+
+    std::optional<ManifestEntry> parseManifestLine(std::string_view line) {
+        std::istringstream ss = std::istringstream(std::string(line));
+        ManifestEntry entry;
+        ss >> entry.url;
+        if (entry.url.empty() || entry.url[0] == '#') {
+            // Skip all empty lines and commented out lines
+            return std::nullopt;
+        }
+
+        uintmax_t size = 0;
+        if (ss >> size) {
+            entry.size = size;
+
+            std::string crc;
+            if (ss >> crc) {
+                uint32_t value = 0;
+                const std::from_chars_result res =
+                    std::from_chars(crc.data(), crc.data() + crc.size(), value, 16);
+                if (res.ec == std::errc()) {
+                    entry.crc = value;
+                }
+            }
+        }
+        return entry;
+    }
+
+    uint32_t crc32OfFile(const std::filesystem::path& path) {
+        // Standard CRC-32 (IEEE 802.3) as it is used by zip and most hashing tools
+        static const std::array<uint32_t, 256> Table = []() {
+            std::array<uint32_t, 256> table;
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+                }
+                table[i] = c;
+            }
+            return table;
+        }();
+
+        std::ifstream file = std::ifstream(path, std::ifstream::binary);
+        std::vector<char> buffer = std::vector<char>(1 << 16);
+        uint32_t crc = 0xFFFFFFFF;
+        while (file) {
+            file.read(buffer.data(), buffer.size());
+            const std::streamsize n = file.gcount();
+            for (std::streamsize i = 0; i < n; i++) {
+                const uint8_t byte = static_cast<uint8_t>(buffer[i]);
+                crc = Table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+            }
+        }
+        return crc ^ 0xFFFFFFFF;
+    }
+
+    // Returns whether the file at `path` matches the size and hash from the manifest. If
+    // the manifest does not provide either, the file can not be verified and only the
+    // successful download is taken as a sign of validity
+    bool matchesManifest(const std::filesystem::path& path, const ManifestEntry& entry) {
+        std::error_code ec;
+        if (entry.size.has_value() && std::filesystem::file_size(path, ec) != *entry.size)
+        {
+            return false;
+        }
+        return !entry.crc.has_value() || crc32OfFile(path) == *entry.crc;
+    }
+
     struct [[codegen::Dictionary(HttpSynchronization)]] Parameters {
         // The unique identifier for this resource that is used to request a set of files
         // from the synchronization servers
@@ -70,10 +153,11 @@ documentation::Documentation HttpSynchronization::Documentation() {
 
 HttpSynchronization::HttpSynchronization(const ghoul::Dictionary& dict,
                                          std::filesystem::path synchronizationRoot,
-                                      std::vector<std::string> synchronizationRepositories
-)
+                                     std::vector<std::string> synchronizationRepositories,
+                                                                      PeerCache peerCache)
     : ResourceSynchronization(std::move(synchronizationRoot))
     , _syncRepositories(std::move(synchronizationRepositories))
+    , _peerCache(std::move(peerCache))
 {
     const Parameters p = codegen::bake<Parameters>(dict);
 
@@ -238,6 +322,63 @@ bool HttpSynchronization::isEachFileDownloaded() {
     return false;
 }
 
+bool HttpSynchronization::copyFromPreviousVersion(const std::string& url,
+                                                 const std::filesystem::path& destination,
+                                                       uintmax_t size, uint32_t crc) const
+{
+    const std::filesystem::path versionsFolder = directory().parent_path();
+    if (!std::filesystem::is_directory(versionsFolder)) {
+        return false;
+    }
+
+    const ManifestEntry entry = { .url = url, .size = size, .crc = crc };
+    for (const std::filesystem::directory_entry& e :
+         std::filesystem::directory_iterator(versionsFolder))
+    {
+        if (!e.is_directory() || e.path() == directory()) {
+            continue;
+        }
+
+        const std::filesystem::path candidate = e.path() / destination.filename();
+        if (std::filesystem::is_regular_file(candidate) &&
+            matchesManifest(candidate, entry))
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(destination.parent_path(), ec);
+            std::filesystem::copy_file(
+                candidate,
+                destination,
+                std::filesystem::copy_options::overwrite_existing,
+                ec
+            );
+            return !ec;
+        }
+    }
+    return false;
+}
+
+bool HttpSynchronization::isPeerCacheReady() const {
+    if (!_peerCache.isEnabled()) {
+        return false;
+    }
+
+    std::filesystem::path syncFile = directory();
+    syncFile.replace_extension("ossync");
+    const std::optional<std::string> contents =
+        _peerCache.waitForSyncFile(_synchronizationRoot, syncFile, _shouldCancel);
+    if (!contents.has_value()) {
+        return false;
+    }
+
+    // Only a peer that has all of the files is used, the second line of the sync file
+    // contains the synchronization status
+    std::istringstream ss = std::istringstream(*contents);
+    std::string line;
+    ghoul::getline(ss, line);
+    ghoul::getline(ss, line);
+    return line == SynchronizationToken;
+}
+
 HttpSynchronization::SynchronizationState
 HttpSynchronization::trySyncFromUrl(std::string url) {
     HttpMemoryDownload fileListDownload = HttpMemoryDownload(std::move(url));
@@ -264,28 +405,37 @@ HttpSynchronization::trySyncFromUrl(std::string url) {
         std::optional<int64_t> totalBytes;
     };
 
-    std::unordered_map<std::string, SizeData> sizeData;
-    std::mutex mutex;
-
-    std::atomic_bool startedAllDownloads = false;
-
-    // Yes, it should be possible to store this in a std::vector<HttpFileDownload> but
-    // C++ really doesn't like that even though all of the move constructors, move
-    // assignments and everything is automatically constructed
-    std::vector<std::unique_ptr<HttpFileDownload>> downloads;
+    // The state that is shared with the callbacks of the download manager. It is kept
+    // alive by the callbacks so that this function can return as soon as it is cancelled,
+    // even if some of the downloads have not reported back yet
+    struct SharedState {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::unordered_map<std::string, SizeData> sizeData;
+        int nUnfinished = 0;
+    };
+    auto state = std::make_shared<SharedState>();
+
+    struct Download {
+        ManifestEntry entry;
+        std::filesystem::path destination;
+        std::shared_ptr<DownloadManager::FileFuture> future;
+        int nTries = 0;
+        bool hasSucceeded = false;
+        bool useUpstream = true;
+    };
+    std::vector<Download> downloads;
+    std::vector<std::string> skippedFiles;
 
     std::string line;
-    while (fileList >> line) {
-        if (line.empty() || line[0] == '#') {
-            // Skip all empty lines and commented out lines
+    while (ghoul::getline(fileList, line)) {
+        std::optional<ManifestEntry> entry = parseManifestLine(line);
+        if (!entry.has_value()) {
             continue;
         }
 
-        const std::string filename = std::filesystem::path(line).filename().string();
-        const std::filesystem::path destination = directory() / (filename + ".tmp");
-
-        if (sizeData.find(line) != sizeData.end()) {
-            LWARNING(std::format("{}: Duplicate entry for {}", _identifier, line));
+        if (state->sizeData.find(entry->url) != state->sizeData.end()) {
+            LWARNING(std::format("{}: Duplicate entry for {}", _identifier, entry->url));
             continue;
         }
 
@@ -293,106 +443,178 @@ HttpSynchronization::trySyncFromUrl(std::string url) {
         auto it = std::find(
             _existingSyncedFiles.begin(),
             _existingSyncedFiles.end(),
-            line
+            entry->url
         );
-
         if (it != _existingSyncedFiles.end()) {
             // File has already been synced
             continue;
         }
 
-        auto download = std::make_unique<HttpFileDownload>(
-            line,
-            destination,
-            HttpFileDownload::Overwrite::Yes
-        );
-        HttpFileDownload* dl = download.get();
-        downloads.push_back(std::move(download));
+        const std::string filename =
+            std::filesystem::path(entry->url).filename().string();
+        std::filesystem::path destination = directory() / filename;
+
+        // Files that can be verified against the manifest don't need to be downloaded
+        // again if they already exist locally, either from an earlier run of this
+        // synchronization or, if unchanged, from a different version of it
+        if (entry->size.has_value() && entry->crc.has_value()) {
+            const bool isUpToDate =
+                (std::filesystem::is_regular_file(destination) &&
+                 matchesManifest(destination, *entry)) ||
+                copyFromPreviousVersion(
+                    entry->url,
+                    destination,
+                    *entry->size,
+                    *entry->crc
+                );
+            if (isUpToDate) {
+                LDEBUG(std::format("{}: Reusing unchanged {}", _identifier, filename));
+                skippedFiles.push_back(entry->url);
+                continue;
+            }
+        }
+
+        state->sizeData[entry->url] = SizeData();
+        downloads.push_back({
+            .entry = std::move(*entry),
+            .destination = std::move(destination)
+        });
+    }
+
+    std::filesystem::create_directories(directory());
 
-        sizeData[line] = SizeData();
+    // If the peer cache already has this synchronization, all files are requested from
+    // the peer first. Files that fail to download from the peer are requested upstream
+    const bool usePeerCache = !downloads.empty() && isPeerCacheReady();
+    if (usePeerCache) {
+        LDEBUG(std::format("{}: Downloading files from peer cache", _identifier));
+        for (Download& d : downloads) {
+            d.useUpstream = false;
+        }
+    }
 
-        dl->onProgress(
-            [this, line, &sizeData, &mutex, &startedAllDownloads](int64_t downloadedBytes,
-                                                        std::optional<int64_t> totalBytes)
+    auto submit = [this, &state](Download& d) {
         {
-            if (!totalBytes.has_value() || !startedAllDownloads) {
-                return !_shouldCancel;
+            const std::lock_guard lock(state->mutex);
+            state->nUnfinished++;
+        }
+        d.nTries++;
+        d.future = global::downloadManager->downloadFile(
+            d.useUpstream ?
+                d.entry.url :
+                _peerCache.urlFor(_synchronizationRoot, d.destination),
+            d.destination,
+            DownloadManager::OverrideFile::Yes,
+            DownloadManager::FailOnError::Yes,
+            0,
+            [state](const DownloadManager::FileFuture&) {
+                {
+                    const std::lock_guard lock(state->mutex);
+                    state->nUnfinished--;
+                }
+                state->condition.notify_all();
+            },
+            [state, u = d.entry.url](const DownloadManager::FileFuture& f) {
+                const std::lock_guard lock(state->mutex);
+                state->sizeData[u] = { f.currentSize, f.totalSize };
             }
+        );
+    };
 
-            const std::lock_guard guard(mutex);
+    // All downloads are handed to the download manager at once, which runs them
+    // concurrently with a bounded number of connections. A download that fails is
+    // resubmitted and resumes from the data that has already been written
+    for (Download& d : downloads) {
+        submit(d);
+    }
 
-            sizeData[line] = { downloadedBytes, totalBytes };
+    while (true) {
+        {
+            std::unique_lock lock(state->mutex);
+            state->condition.wait_for(
+                lock,
+                std::chrono::milliseconds(100),
+                [&state]() { return state->nUnfinished == 0; }
+            );
 
             _nTotalBytesKnown = true;
-            _nTotalBytes = 0;
-            _nSynchronizedBytes = 0;
-            for (const std::pair<const std::string, SizeData>& sd : sizeData) {
+            int64_t totalBytes = 0;
+            int64_t synchronizedBytes = 0;
+            for (const std::pair<const std::string, SizeData>& sd : state->sizeData) {
                 _nTotalBytesKnown = _nTotalBytesKnown && sd.second.totalBytes.has_value();
-                _nTotalBytes += sd.second.totalBytes.value_or(0);
-                _nSynchronizedBytes += sd.second.downloadedBytes;
+                totalBytes += sd.second.totalBytes.value_or(0);
+                synchronizedBytes += sd.second.downloadedBytes;
             }
+            _nTotalBytes = totalBytes;
+            _nSynchronizedBytes = synchronizedBytes;
 
-            return !_shouldCancel;
-        });
+            if (_shouldCancel) {
+                for (Download& d : downloads) {
+                    if (d.future) {
+                        d.future->abortDownload = true;
+                    }
+                }
+                return SynchronizationState::FileDownloadFail;
+            }
 
-        dl->start();
-    }
-    startedAllDownloads = true;
+            if (state->nUnfinished > 0) {
+                continue;
+            }
+        }
 
-    constexpr int MaxDownloadRetries = 5;
-    int downloadTry = 0;
-    // If a download has failed try to restart it
-    while (downloadTry < MaxDownloadRetries) {
-        bool downloadSucceeded = true;
+        // All submitted downloads have finished, so we can verify them and retry the
+        // ones that failed
+        bool hasResubmitted = false;
+        for (Download& d : downloads) {
+            if (d.hasSucceeded || !d.future) {
+                continue;
+            }
 
-        for (const std::unique_ptr<HttpFileDownload>& d : downloads) {
-            d->wait();
+            d.hasSucceeded =
+                d.future->isFinished && matchesManifest(d.destination, d.entry);
+            if (d.hasSucceeded) {
+                continue;
+            }
 
-            // If the user exits the program we don't want to start new downloads
-            if (_shouldCancel) {
-                break;
+            if (d.future->isFinished) {
+                LWARNING(std::format(
+                    "{}: File '{}' does not match the size or hash of the manifest",
+                    _identifier, d.destination
+                ));
+                std::filesystem::remove(d.destination);
             }
 
-            if (d->hasFailed()) {
-                d->start();
-                downloadSucceeded = false;
+            if (!d.useUpstream) {
+                // The peer cache failed to provide this file, so it is downloaded from
+                // the original URL instead with the full number of retries
+                d.useUpstream = true;
+                d.nTries = 0;
+            }
+
+            if (d.nTries < MaxDownloadRetries) {
+                submit(d);
+                hasResubmitted = true;
             }
         }
-        if (downloadSucceeded || _shouldCancel) {
+
+        if (!hasResubmitted) {
             break;
         }
-        else {
-            ++downloadTry;
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
     bool failed = false;
-    for (const std::unique_ptr<HttpFileDownload>& d : downloads) {
-        d->wait();
-        if (!d->hasSucceeded()) {
-            LERROR(std::format("Error downloading file from URL '{}'", d->url()));
+    for (Download& d : downloads) {
+        if (!d.hasSucceeded) {
+            LERROR(std::format(
+                "Error downloading file from URL '{}': {}",
+                d.entry.url, d.future ? d.future->errorMessage : "Could not start"
+            ));
             failed = true;
             continue;
         }
 
-        // If we are forcing the override, we download to a temporary file first, so when
-        // we are done here, we need to rename the file to the original name
-
-        std::filesystem::path tempName = d->destination();
-        std::filesystem::path originalName = tempName;
-        // Remove the .tmp extension
-        originalName.replace_extension("");
-
-        if (std::filesystem::is_regular_file(originalName)) {
-            std::filesystem::remove(originalName);
-        }
-        std::error_code ec;
-        std::filesystem::rename(tempName, originalName, ec);
-        if (ec) {
-            LERROR(std::format("Error renaming '{}' to '{}'", tempName, originalName));
-            failed = true;
-        }
+        std::filesystem::path originalName = d.destination;
 
         if (_unzipFiles && originalName.extension() == ".zip") {
             std::string source = originalName.string();
@@ -418,14 +640,17 @@ HttpSynchronization::trySyncFromUrl(std::string url) {
                 continue;
             }
 
-            std::filesystem::remove(source);
+            if (!_peerCache.isServing) {
+                std::filesystem::remove(source);
+            }
         }
     }
     if (failed) {
-        for (const std::unique_ptr<HttpFileDownload>& d : downloads) {
-            // Store all files that were synced to the ossync
-            if (d->hasSucceeded()) {
-                _newSyncedFiles.push_back(d->url());
+        // Store all files that were synced to the ossync
+        _newSyncedFiles = std::move(skippedFiles);
+        for (const Download& d : downloads) {
+            if (d.hasSucceeded) {
+                _newSyncedFiles.push_back(d.entry.url);
             }
         }
         return SynchronizationState::FileDownloadFail;
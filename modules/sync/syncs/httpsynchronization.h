@@ -27,6 +27,7 @@
 
 #include <openspace/util/resourcesynchronization.h>
 
+#include <modules/sync/syncs/peercache.h>
 #include <thread>
 #include <optional>
 #include <vector>
@@ -40,7 +41,10 @@ namespace openspace {
  * to return a flat list of files that can be then directly downloaded into the #directory
  * of this synchronization. That list of files can have empty lines and commented out
  * lines (starting with a #) that will be ignored. Every other line is URL that will be
- * downloaded into the #directory.
+ * downloaded into the #directory, optionally followed by the size of the file in bytes
+ * and its CRC-32 as a hexadecimal number. If these are provided, downloaded files are
+ * verified against them and files that already exist with the correct contents, either
+ * in this version or in another version of the same identifier, are not downloaded.
  *
  * Each requested set of files is identified by a triplet of (identifier, file version,
  * application version). The identifier is denoting the group of files that is requested,
@@ -63,10 +67,13 @@ public:
      *        path is constructed
      * \param synchronizationRepositories The list of repositories that will be asked to
      *        resolve the identifier request
+     * \param peerCache The peer cache from which the files are requested before they are
+     *        requested from the URLs provided by the repository
      */
     HttpSynchronization(const ghoul::Dictionary& dict,
         std::filesystem::path synchronizationRoot,
-        std::vector<std::string> synchronizationRepositories);
+        std::vector<std::string> synchronizationRepositories,
+        PeerCache peerCache = PeerCache());
 
     /**
      * Destructor that will close the asynchronous file transfer, if it is still ongoing.
@@ -124,6 +131,20 @@ private:
      */
     SynchronizationState trySyncFromUrl(std::string url);
 
+    /**
+     * Looks for a file with the same name in the other versions of this synchronization
+     * and copies it to \p destination if its size and CRC-32 match the provided values.
+     * Returns `true` if such a file was found and copied.
+     */
+    bool copyFromPreviousVersion(const std::string& url,
+        const std::filesystem::path& destination, uintmax_t size, uint32_t crc) const;
+
+    /**
+     * Returns `true` if the peer cache is enabled and has fully synchronized the same
+     * identifier and version.
+     */
+    bool isPeerCacheReady() const;
+
     /// Contains a flag whether the current transfer should be cancelled
     std::atomic_bool _shouldCancel = false;
 
@@ -136,6 +157,9 @@ private:
     // The list of all repositories that we'll try to sync from
     const std::vector<std::string> _syncRepositories;
 
+    // The peer that is asked for the files before the repositories' URLs are used
+    const PeerCache _peerCache;
+
     // The thread that will be doing the synchronization
     std::thread _syncThread;
 
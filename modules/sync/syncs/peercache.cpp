@@ -0,0 +1,104 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/sync/syncs/peercache.h>
+
+#include <openspace/util/httprequest.h>
+#include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "PeerCache";
+
+    // The time between two requests while waiting for the peer
+    constexpr std::chrono::seconds PollInterval = std::chrono::seconds(1);
+
+    std::string encodeUrlPath(std::string_view path) {
+        constexpr std::string_view Hex = "0123456789ABCDEF";
+
+        std::string res;
+        res.reserve(path.size());
+        for (const char c : path) {
+            const bool isUnreserved =
+                (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_' || c == '~' ||
+                c == '/';
+            if (isUnreserved) {
+                res += c;
+            }
+            else {
+                const unsigned char v = static_cast<unsigned char>(c);
+                res += '%';
+                res += Hex[v >> 4];
+                res += Hex[v & 0xF];
+            }
+        }
+        return res;
+    }
+} // namespace
+
+namespace openspace {
+
+bool PeerCache::isEnabled() const {
+    return !url.empty();
+}
+
+std::string PeerCache::urlFor(const std::filesystem::path& root,
+                              const std::filesystem::path& file) const
+{
+    const std::string relative = std::filesystem::relative(file, root).generic_string();
+    const bool hasSlash = !url.empty() && url.back() == '/';
+    return std::format("{}{}{}", url, hasSlash ? "" : "/", encodeUrlPath(relative));
+}
+
+std::optional<std::string> PeerCache::waitForSyncFile(const std::filesystem::path& root,
+                                                    const std::filesystem::path& syncFile,
+                                               const std::atomic_bool& shouldCancel) const
+{
+    const std::string fileUrl = urlFor(root, syncFile);
+    const auto start = std::chrono::steady_clock::now();
+
+    while (!shouldCancel) {
+        HttpMemoryDownload download = HttpMemoryDownload(fileUrl);
+        download.onProgress([&shouldCancel](int64_t, std::optional<int64_t>) {
+            return !shouldCancel;
+        });
+        download.start(std::chrono::seconds(5));
+        if (download.wait()) {
+            const std::vector<char>& data = download.downloadedData();
+            return std::string(data.begin(), data.end());
+        }
+
+        if (std::chrono::steady_clock::now() - start >= waitTime) {
+            break;
+        }
+        std::this_thread::sleep_for(PollInterval);
+    }
+
+    LDEBUG(std::format("'{}' is not available on the peer cache", fileUrl));
+    return std::nullopt;
+}
+
+} // namespace openspace
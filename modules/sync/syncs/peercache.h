@@ -0,0 +1,78 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SYNC___PEERCACHE___H__
+#define __OPENSPACE_MODULE_SYNC___PEERCACHE___H__
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace openspace {
+
+/**
+ * Describes a peer cache, which is the synchronization folder of another OpenSpace
+ * instance in the local network (typically the master node of a cluster) that is served
+ * through a plain HTTP file server. The files of a synchronization are stored at the same
+ * relative path on the peer as they are locally, so a synchronization can first try to
+ * download its files from the peer and only fall back to the upstream URLs if that
+ * fails.
+ */
+struct PeerCache {
+    /// Returns `true` if a peer cache URL has been provided
+    bool isEnabled() const;
+
+    /**
+     * Returns the URL on the peer cache for the local \p file, which has to be located in
+     * the synchronization \p root.
+     */
+    std::string urlFor(const std::filesystem::path& root,
+        const std::filesystem::path& file) const;
+
+    /**
+     * Requests the synchronization file \p syncFile from the peer until it is available
+     * or until the #waitTime has passed, and returns its contents. The file only exists
+     * on the peer once the peer has finished the synchronization. Returns `std::nullopt`
+     * if the file was not available in time or if \p shouldCancel was set.
+     */
+    std::optional<std::string> waitForSyncFile(const std::filesystem::path& root,
+        const std::filesystem::path& syncFile,
+        const std::atomic_bool& shouldCancel) const;
+
+    /// The URL that serves the synchronization folder of the peer
+    std::string url;
+
+    /// The maximum time to wait for the peer to finish a synchronization
+    std::chrono::seconds waitTime = std::chrono::seconds(0);
+
+    /// If this is `true`, this instance serves its own synchronization folder to other
+    /// peers, which means that downloaded archives are kept after unzipping them
+    bool isServing = false;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SYNC___PEERCACHE___H__
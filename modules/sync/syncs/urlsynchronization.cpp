@@ -85,8 +85,10 @@ documentation::Documentation UrlSynchronization::Documentation() {
 }
 
 UrlSynchronization::UrlSynchronization(const ghoul::Dictionary& dictionary,
-                                       std::filesystem::path synchronizationRoot)
+                                       std::filesystem::path synchronizationRoot,
+                                       PeerCache peerCache)
     : ResourceSynchronization(std::move(synchronizationRoot))
+    , _peerCache(std::move(peerCache))
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -302,6 +304,44 @@ bool UrlSynchronization::trySyncUrls() {
     std::mutex fileSizeMutex;
     std::atomic_bool startedAllDownloads = false;
     std::vector<std::unique_ptr<HttpFileDownload>> downloads;
+    // The original URL for each of the downloads
+    std::vector<std::string> upstreamUrls;
+
+    auto progressCallback = [this, &sizeData, &fileSizeMutex](std::string url) {
+        return [this, url, &sizeData, &fileSizeMutex](int64_t downloadedBytes,
+                                                      std::optional<int64_t> totalBytes)
+        {
+            if (!totalBytes.has_value()) {
+                return !_shouldCancel;
+            }
+
+            const std::lock_guard guard(fileSizeMutex);
+            sizeData[url] = { downloadedBytes, totalBytes };
+
+            _nTotalBytesKnown = true;
+            _nTotalBytes = 0;
+            _nSynchronizedBytes = 0;
+            for (const std::pair<const std::string, SizeData>& sd : sizeData) {
+                _nTotalBytesKnown = _nTotalBytesKnown &&
+                                    sd.second.totalBytes.has_value();
+                _nTotalBytes += sd.second.totalBytes.value_or(0);
+                _nSynchronizedBytes += sd.second.downloadedBytes;
+            }
+
+            return !_shouldCancel;
+        };
+    };
+
+    // The peer cache is only used if it has finished the same synchronization
+    std::filesystem::path syncFile = directory();
+    syncFile.replace_extension("ossync");
+    const bool usePeerCache =
+        _peerCache.isEnabled() &&
+        _peerCache.waitForSyncFile(
+            _synchronizationRoot,
+            syncFile,
+            _shouldCancel
+        ).has_value();
 
     for (const std::string& url : _urls) {
         if (_filename.empty() || _urls.size() > 1) {
@@ -325,48 +365,45 @@ bool UrlSynchronization::trySyncUrls() {
         }
 
         auto download = std::make_unique<HttpFileDownload>(
-            url,
+            usePeerCache ?
+                _peerCache.urlFor(_synchronizationRoot, directory() / _filename) :
+                url,
             std::move(destination),
             HttpFileDownload::Overwrite::Yes
         );
         HttpFileDownload* dl = download.get();
 
         downloads.push_back(std::move(download));
+        upstreamUrls.push_back(url);
 
         sizeData[url] = SizeData();
 
-        dl->onProgress(
-            [this, url, &sizeData, &fileSizeMutex](int64_t downloadedBytes,
-                                                std::optional<int64_t> totalBytes)
-            {
-                if (!totalBytes.has_value()) {
-                    return !_shouldCancel;
-                }
-
-                const std::lock_guard guard(fileSizeMutex);
-                sizeData[url] = { downloadedBytes, totalBytes };
-
-                _nTotalBytesKnown = true;
-                _nTotalBytes = 0;
-                _nSynchronizedBytes = 0;
-                for (const std::pair<const std::string, SizeData>& sd : sizeData) {
-                    _nTotalBytesKnown = _nTotalBytesKnown &&
-                                        sd.second.totalBytes.has_value();
-                    _nTotalBytes += sd.second.totalBytes.value_or(0);
-                    _nSynchronizedBytes += sd.second.downloadedBytes;
-                }
-
-                return !_shouldCancel;
-            });
-
+        dl->onProgress(progressCallback(url));
         dl->start();
     }
 
     startedAllDownloads = true;
 
     bool failed = false;
-    for (const std::unique_ptr<HttpFileDownload>& d : downloads) {
+    for (size_t i = 0; i < downloads.size(); i++) {
+        std::unique_ptr<HttpFileDownload>& d = downloads[i];
         d->wait();
+        if (!d->hasSucceeded() && usePeerCache && !_shouldCancel) {
+            // The peer cache did not provide this file, so we fall back to the original
+            LDEBUG(std::format(
+                "{}: Peer cache failed for '{}', using original URL",
+                _identifier, upstreamUrls[i]
+            ));
+            const std::filesystem::path destination = d->destination();
+            d = std::make_unique<HttpFileDownload>(
+                upstreamUrls[i],
+                destination,
+                HttpFileDownload::Overwrite::Yes
+            );
+            d->onProgress(progressCallback(upstreamUrls[i]));
+            d->start();
+            d->wait();
+        }
         if (!d->hasSucceeded()) {
             failed = true;
             LERROR(std::format("Error downloading file from URL: {}", d->url()));
@@ -27,6 +27,7 @@
 
 #include <openspace/util/resourcesynchronization.h>
 
+#include <modules/sync/syncs/peercache.h>
 #include <atomic>
 #include <filesystem>
 #include <string>
@@ -52,9 +53,11 @@ public:
      *        UrlSynchronization needs to download the provided files
      * \param synchronizationRoot The base location based off which the final placement
      *        is calculated
+     * \param peerCache The peer cache from which the files are requested before they are
+     *        requested from their original URLs
      */
     UrlSynchronization(const ghoul::Dictionary& dictionary,
-        std::filesystem::path synchronizationRoot);
+        std::filesystem::path synchronizationRoot, PeerCache peerCache = PeerCache());
 
     /**
      * Contructor that will terminate the synchronization thread if it is still running.
@@ -123,6 +126,9 @@ private:
     /// Determines how long the file is valid before it should be downloaded again
     double _secondsUntilResync = MaxDateAsJ2000;
 
+    /// The peer that is asked for the files before their original URLs are used
+    const PeerCache _peerCache;
+
     inline static std::mutex _mutex;
 };
 
@@ -26,7 +26,6 @@ OTHER DEALINGS IN THE SOFTWARE.
 #include <chrono>
 #include <modules/touch/ext/levmarq.h>
 #include <ghoul/logging/logmanager.h>
-#include <ghoul/misc/defer.h>
 
 namespace {
     std::chrono::milliseconds TimeLimit(200);
@@ -72,31 +71,22 @@ bool levmarq(int npar, double *par, int ny, double *dysq,
     std::string data;
     double lambda, up, down, mult, weight, err, newerr, derr, target_derr;
 
-    // allocate the arrays
-    double** h = new double*[npar];
-    double** ch = new double*[npar];
-    for (int i = 0; i < npar; i++) {
-        h[i] = new double[npar];
-        ch[i] = new double[npar];
+    // the arrays live in the workspace of lmstat, which only grows if it is used with
+    // more parameters than in any previous call
+    const size_t n = static_cast<size_t>(npar);
+    lmstat->workspace.resize(2 * n * n + 4 * n);
+    lmstat->rows.resize(2 * n);
+    double* w = lmstat->workspace.data();
+    double** h = lmstat->rows.data();
+    double** ch = lmstat->rows.data() + n;
+    for (size_t i = 0; i < n; i++) {
+        h[i] = w + i * n;
+        ch[i] = w + (n + i) * n;
     }
-    double* g = new double[npar];
-    double* d = new double[npar];
-    double* delta = new double[npar];
-    double* newpar = new double[npar];
-    
-    defer {
-        // deallocate the arrays
-        for (int i = 0; i < npar; i++) {
-            delete[] h[i];
-            delete[] ch[i];
-        }
-        delete[] h;
-        delete[] ch;
-        delete[] g;
-        delete[] d;
-        delete[] delta;
-        delete[] newpar;
-    };
+    double* g = w + 2 * n * n;
+    double* d = g + n;
+    double* delta = d + n;
+    double* newpar = delta + n;
 
     verbose = lmstat->verbose;
     nit = lmstat->max_it;
@@ -40,6 +40,9 @@ typedef struct {
     int final_it;
     double final_err;
     double final_derr;
+    // Workspace that is reused between calls to levmarq to avoid allocations
+    std::vector<double> workspace;
+    std::vector<double*> rows;
 } LMstat;
 
 /**
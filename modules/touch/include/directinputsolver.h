@@ -70,6 +70,10 @@ public:
 private:
     int _nDof = 0;
     LMstat _lmstat;
+
+    // Reused between calls to solve to avoid per-frame allocations
+    std::vector<glm::dvec3> _selectedPoints;
+    std::vector<glm::dvec2> _screenPoints;
 };
 
 } // openspace namespace
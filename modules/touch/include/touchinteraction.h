@@ -234,6 +234,13 @@ private:
     bool _zoomOutTap = false;
     std::vector<DirectInputSolver::SelectedBody> _selectedNodeSurfacePoints;
     DirectInputSolver _directInputSolver;
+    std::vector<double> _directInputParameters = std::vector<double>(6, 0.0);
+
+    // The anchor node for which the direct touch node was last looked up. The lookup is
+    // reused for as long as the anchor does not change during an interaction
+    const SceneGraphNode* _cachedAnchor = nullptr;
+    SceneGraphNode* _directTouchNode = nullptr;
+    bool _isDirectTouchType = false;
 
     glm::vec2 _centroid = glm::vec2(0.f);
 
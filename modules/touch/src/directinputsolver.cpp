@@ -26,16 +26,18 @@
 
 #include <openspace/camera/camera.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <algorithm>
+#include <array>
+#include <span>
 
 namespace {
     // Used in the LM algorithm
     struct FunctionData {
-        std::vector<glm::dvec3> selectedPoints;
-        std::vector<glm::dvec2> screenPoints;
+        std::span<const glm::dvec3> selectedPoints;
+        std::span<const glm::dvec2> screenPoints;
         int nDOF;
         const openspace::Camera* camera;
         openspace::SceneGraphNode* node;
-        LMstat stats;
     };
 } // namespace
 
@@ -133,12 +135,15 @@ double distToMinimize(double* par, int x, void* fdata, LMstat* lmstat) {
     // we now have a new position and orientation of camera, project surfacePoint to
     // the new screen to get distance to minimize
     glm::dvec2 newScreenPoint = castToNDC(
-        ptr->selectedPoints.at(x),
+        ptr->selectedPoints[x],
         cam,
         ptr->node
     );
-    lmstat->pos.push_back(newScreenPoint);
-    return glm::length(ptr->screenPoints.at(x) - newScreenPoint);
+    if (lmstat->verbose) {
+        // The projected points are only used for the verbose output
+        lmstat->pos.push_back(newScreenPoint);
+    }
+    return glm::length(ptr->screenPoints[x] - newScreenPoint);
 }
 
 // Gradient of distToMinimize w.r.t par (using forward difference)
@@ -147,8 +152,8 @@ void gradient(double* g, double* par, int x, void* fdata, LMstat* lmstat) {
     double f0 = distToMinimize(par, x, fdata, lmstat);
     // scale value to find minimum step size h, dependant on planet size
     double scale = log10(ptr->node->interactionSphere());
-    std::vector<double> dPar(ptr->nDOF, 0.0);
-    dPar.assign(par, par + ptr->nDOF);
+    std::array<double, 6> dPar = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    std::copy(par, par + ptr->nDOF, dPar.begin());
 
     for (int i = 0; i < ptr->nDOF; i++) {
         // Initial values
@@ -222,33 +227,32 @@ bool DirectInputSolver::solve(const std::vector<TouchInputHolder>& list,
     int nFingers = std::min(static_cast<int>(list.size()), 3);
     _nDof = std::min(nFingers * 2, 6);
 
-    // Parse input data to be used in the LM algorithm
-    std::vector<glm::dvec3> selectedPoints;
-    std::vector<glm::dvec2> screenPoints;
-
+    // Parse input data to be used in the LM algorithm. The vectors keep their capacity
+    // between frames, so this does not allocate after the first touch
+    _selectedPoints.clear();
+    _screenPoints.clear();
     for (int i = 0; i < nFingers; i++) {
         const SelectedBody& sb = selectedBodies.at(i);
-        selectedPoints.push_back(sb.coordinates);
-        screenPoints.emplace_back(
+        _selectedPoints.push_back(sb.coordinates);
+        _screenPoints.emplace_back(
             2.0 * (list[i].latestInput().x - 0.5),
             -2.0 * (list[i].latestInput().y - 0.5)
         );
     }
 
     FunctionData fData = {
-        .selectedPoints = selectedPoints,
-        .screenPoints = screenPoints,
+        .selectedPoints = _selectedPoints,
+        .screenPoints = _screenPoints,
         .nDOF = _nDof,
         .camera = &camera,
-        .node = selectedBodies.at(0).node,
-        .stats = _lmstat
+        .node = selectedBodies.at(0).node
     };
     void* dataPtr = reinterpret_cast<void*>(&fData);
 
     bool result = levmarq(
         _nDof,
         parameters->data(),
-        static_cast<int>(screenPoints.size()),
+        static_cast<int>(_screenPoints.size()),
         nullptr,
         distToMinimize,
         gradient,
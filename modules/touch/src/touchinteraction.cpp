@@ -466,7 +466,8 @@ void TouchInteraction::directControl(const std::vector<TouchInputHolder>& list)
 #endif
 
     // Find best transform values for the new camera state and store them in par
-    std::vector<double> par(6, 0.0);
+    std::vector<double>& par = _directInputParameters;
+    std::fill(par.begin(), par.end(), 0.0);
     par[0] = _lastVel.orbit.x; // use _lastVel for orbit
     par[1] = _lastVel.orbit.y;
     bool lmSuccess = _directInputSolver.solve(
@@ -511,29 +512,35 @@ void TouchInteraction::updateNodeSurfacePoints(const std::vector<TouchInputHolde
 
     const SceneGraphNode* anchor =
         global::navigationHandler->orbitalNavigator().anchorNode();
-    SceneGraphNode* node = sceneGraphNode(anchor->identifier());
+    if (anchor != _cachedAnchor) {
+        _cachedAnchor = anchor;
+        _directTouchNode = sceneGraphNode(anchor->identifier());
+
+        TouchModule* module = global::moduleEngine->module<TouchModule>();
+        _isDirectTouchType = _directTouchNode->renderable() &&
+            module->isDefaultDirectTouchType(
+                _directTouchNode->renderable()->typeAsString()
+            );
+    }
+    SceneGraphNode* node = _directTouchNode;
 
     // Check if current anchor is valid for direct touch
-    TouchModule* module = global::moduleEngine->module<TouchModule>();
-
-    bool isDirectTouchRenderable = node->renderable() &&
-        module->isDefaultDirectTouchType(node->renderable()->typeAsString());
-
-    if (!(node->supportsDirectInteraction() || isDirectTouchRenderable)) {
+    if (!(node->supportsDirectInteraction() || _isDirectTouchType)) {
         return;
     }
 
-    glm::dquat camToWorldSpace = _camera->rotationQuaternion();
-    glm::dvec3 camPos = _camera->positionVec3();
-    std::vector<DirectInputSolver::SelectedBody> surfacePoints;
+    const glm::dquat camToWorldSpace = _camera->rotationQuaternion();
+    const glm::dvec3 camPos = _camera->positionVec3();
+    const glm::dmat4 inverseProjection = glm::inverse(_camera->projectionMatrix());
+    const glm::dmat3 inverseNodeRotation = glm::inverse(node->worldRotationMatrix());
+    const glm::dvec3 nodePosition = node->worldPosition();
 
     for (const TouchInputHolder& inputHolder : list) {
         // Normalized -1 to 1 coordinates on screen
         double xCo = 2 * (inputHolder.latestInput().x - 0.5);
         double yCo = -2 * (inputHolder.latestInput().y - 0.5);
         glm::dvec3 cursorInWorldSpace = camToWorldSpace *
-            glm::dvec3(glm::inverse(_camera->projectionMatrix()) *
-            glm::dvec4(xCo, yCo, -1.0, 1.0));
+            glm::dvec3(inverseProjection * glm::dvec4(xCo, yCo, -1.0, 1.0));
         glm::dvec3 raytrace = glm::normalize(cursorInWorldSpace);
 
         size_t id = inputHolder.fingerId();
@@ -544,23 +551,21 @@ void TouchInteraction::updateNodeSurfacePoints(const std::vector<TouchInputHolde
         const bool intersected = glm::intersectRaySphere(
             camPos,
             raytrace,
-            node->worldPosition(),
+            nodePosition,
             node->interactionSphere() * node->interactionSphere(),
             intersectionDist
         );
 
         if (intersected) {
             glm::dvec3 intersectionPos = camPos + raytrace * intersectionDist;
-            glm::dvec3 pointInModelView = glm::inverse(node->worldRotationMatrix()) *
-                                            (intersectionPos - node->worldPosition());
+            glm::dvec3 pointInModelView =
+                inverseNodeRotation * (intersectionPos - nodePosition);
 
             // Note that node is saved as the direct input solver was initially
             // implemented to handle touch contact points on multiple nodes
-            surfacePoints.push_back({ id, node, pointInModelView });
+            _selectedNodeSurfacePoints.push_back({ id, node, pointInModelView });
         }
     }
-
-    _selectedNodeSurfacePoints = std::move(surfacePoints);
 }
 
 TouchInteraction::InteractionType
@@ -1163,6 +1168,10 @@ void TouchInteraction::resetAfterInput() {
     _pinchInputs[1].clearInputs();
 
     _selectedNodeSurfacePoints.clear();
+
+    // The anchor is looked up again for the next interaction, in case the node or the
+    // list of default direct touch renderables has changed in between
+    _cachedAnchor = nullptr;
 }
 
 // Reset all property values to default
@@ -85,6 +85,16 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo TargetRaycastTimeInfo = {
+        "TargetRaycastTime",
+        "Target Raycast Time",
+        "The GPU time in milliseconds that the volume rendering should take per frame. "
+        "If this value is larger than 0, the resolution of the volume is adapted to meet "
+        "it, lowering the resolution while the camera moves and refining it while the "
+        "camera is still, and the downscale factor is not used.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(RenderableToyVolume)]] Parameters {
         // [[codegen::verbatim(ScalingExponentInfo.description)]]
         std::optional<int> scalingExponent;
@@ -109,6 +119,9 @@ namespace {
 
         // [[codegen::verbatim(DownscaleVolumeRenderingInfo.description)]]
         std::optional<float> downscale;
+
+        // [[codegen::verbatim(TargetRaycastTimeInfo.description)]]
+        std::optional<float> targetRaycastTime [[codegen::greaterequal(0)]];
     };
 #include "renderabletoyvolume_codegen.cpp"
 } // namespace
@@ -129,6 +142,7 @@ RenderableToyVolume::RenderableToyVolume(const ghoul::Dictionary& dictionary)
     )
     , _color(ColorInfo, glm::vec3(1.f, 0.f, 0.f), glm::vec3(0.f), glm::vec3(1.f))
     , _downScaleVolumeRendering(DownscaleVolumeRenderingInfo, 1.f, 0.1f, 1.f)
+    , _targetRaycastTime(TargetRaycastTimeInfo, 0.f, 0.f, 100.f)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -142,6 +156,7 @@ RenderableToyVolume::RenderableToyVolume(const ghoul::Dictionary& dictionary)
 
     _downScaleVolumeRendering.setVisibility(properties::Property::Visibility::Developer);
     _downScaleVolumeRendering = p.downscale.value_or(_downScaleVolumeRendering);
+    _targetRaycastTime = p.targetRaycastTime.value_or(_targetRaycastTime);
 }
 
 RenderableToyVolume::~RenderableToyVolume() {}
@@ -172,6 +187,7 @@ void RenderableToyVolume::initializeGL() {
     addProperty(_color);
     addProperty(Fadeable::_opacity);
     addProperty(_downScaleVolumeRendering);
+    addProperty(_targetRaycastTime);
 }
 
 void RenderableToyVolume::deinitializeGL() {
@@ -211,6 +227,7 @@ void RenderableToyVolume::update(const UpdateData& data) {
         _raycaster->setModelTransform(transform);
         _raycaster->setTime(data.time.j2000Seconds());
         _raycaster->setDownscaleRender(_downScaleVolumeRendering);
+        _raycaster->setTargetRaycastTime(_targetRaycastTime);
         _raycaster->setMaxSteps(_rayCastSteps);
     }
 }
@@ -55,6 +55,7 @@ private:
     properties::Vec3Property _rotation;
     properties::Vec3Property _color;
     properties::FloatProperty _downScaleVolumeRendering;
+    properties::FloatProperty _targetRaycastTime;
 
     std::unique_ptr<ToyVolumeRaycaster> _raycaster;
 
@@ -29,8 +29,11 @@
 #include <openspace/util/syncable.h>
 
 #include <openspace/documentation/documentation.h>
+#include <openspace/properties/optionproperty.h>
+#include <openspace/properties/stringproperty.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <ghoul/glm.h>
 #include <ghoul/misc/boolean.h>
 #include <ghoul/opengl/texture.h>
@@ -51,6 +54,12 @@ class VideoPlayer : public properties::PropertyOwner, public Syncable {
 BooleanType(PauseAfterSeek);
 
 public:
+    enum class HardwareDecoding {
+        Interop = 0,
+        Copy,
+        Disabled
+    };
+
     VideoPlayer(const ghoul::Dictionary& dictionary);
     ~VideoPlayer() override;
 
@@ -92,7 +101,9 @@ private:
         Mute,
         Command,
         Seek,
-        Loop
+        Loop,
+        Hwdec,
+        HwdecCurrent
     };
     // Framebuffer
     void createTexture(glm::ivec2 size);
@@ -119,6 +130,10 @@ private:
     bool isWithingStartEndTime() const;
     void updateFrameDuration();
 
+    // Frame synchronization functions
+    void updateTargetPresentationTime(); // Called on the master in preSync
+    void presentFrame(double presentationTime); // Called on all nodes in postSync
+
     // Properties for user interaction
     properties::TriggerProperty _play;
     properties::TriggerProperty _pause;
@@ -126,6 +141,10 @@ private:
     properties::TriggerProperty _reload;
     properties::BoolProperty _playAudio;
     properties::BoolProperty _loopVideo;
+    properties::OptionProperty _hardwareDecoding;
+    properties::StringProperty _activeDecoder;
+    properties::IntProperty _decoderQueueSize;
+    properties::BoolProperty _frameSynchronization;
 
     // Video properties. Try to read all these values from the video
     std::filesystem::path _videoFile;
@@ -142,6 +161,10 @@ private:
 
     // Syncing with multiple nodes
     double _correctPlaybackTime = 0.0;
+    // Presentation time that all nodes should show when using frame synchronization
+    double _targetPresentationTime = 0.0;
+    int64_t _presentedFrame = -1; // Index of the frame that was last presented
+    bool _isFrameSyncPlaying = false; // Replaces the libmpv pause state when syncing
 
     // Video stretching: map to simulation time animation mode
     double _startJ200Time = 0.0;
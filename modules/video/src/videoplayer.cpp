@@ -99,6 +99,46 @@ namespace {
         "end of the video."
     };
 
+    constexpr openspace::properties::Property::PropertyInfo HardwareDecodingInfo = {
+        "HardwareDecoding",
+        "Hardware Decoding",
+        "Determines how the video is decoded. 'Interop' decodes on the GPU (VAAPI, "
+        "NVDEC, D3D11, or VideoToolbox) directly into OpenGL textures without any copy "
+        "through main memory, 'Copy' decodes on the GPU but copies the frames back to "
+        "main memory, and 'Disabled' decodes on the CPU. If the requested hardware "
+        "decoder is not available, libmpv falls back to software decoding."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ActiveDecoderInfo = {
+        "ActiveDecoder",
+        "Active Decoder",
+        "The hardware decoder that libmpv is currently using for the video. This value "
+        "is 'no' if the video is decoded in software."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DecoderQueueSizeInfo = {
+        "DecoderQueueSize",
+        "Decoder Queue Size",
+        "The number of decoded frames that libmpv keeps ready ahead of the rendering. "
+        "If this value is larger than 0, the video is decoded on a separate thread so "
+        "that a slow frame does not stall the rendering. Changing this value reloads "
+        "the video."
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrameSynchronizationInfo = {
+        "FrameSynchronization",
+        "Frame Synchronization",
+        "If checked, the master node distributes the presentation time of the video "
+        "every frame and all nodes step their decoder to exactly the matching frame, "
+        "instead of playing back independently and seeking whenever they drift apart. "
+        "This should be enabled for videos that span multiple nodes of a cluster, for "
+        "example on a dome."
+    };
+
+    // If a node has fallen behind by more than this number of frames, it seeks to the
+    // target frame instead of stepping to it
+    constexpr int MaxFrameSteps = 4;
+
     struct [[codegen::Dictionary(VideoPlayer)]] Parameters {
         // [[codegen::verbatim(VideoInfo.description)]]
         std::filesystem::path video;
@@ -123,6 +163,20 @@ namespace {
         // The mode of how the video should be played back.
         // Default is video is played back according to the set start and end times.
         std::optional<PlaybackMode> playbackMode;
+
+        enum class HardwareDecoding {
+            Interop,
+            Copy,
+            Disabled
+        };
+        // [[codegen::verbatim(HardwareDecodingInfo.description)]]
+        std::optional<HardwareDecoding> hardwareDecoding;
+
+        // [[codegen::verbatim(DecoderQueueSizeInfo.description)]]
+        std::optional<int> decoderQueueSize [[codegen::inrange(0, 64)]];
+
+        // [[codegen::verbatim(FrameSynchronizationInfo.description)]]
+        std::optional<bool> frameSynchronization;
     };
 #include "videoplayer_codegen.cpp"
 } // namespace
@@ -144,6 +198,21 @@ void* getOpenGLProcAddress(void*, const char* name) {
         global::windowDelegate->openGLProcedureAddress(name)
     );
 }
+
+const char* hwdecValue(VideoPlayer::HardwareDecoding decoding) {
+    // https://mpv.io/manual/master/#options-hwdec
+    switch (decoding) {
+        case VideoPlayer::HardwareDecoding::Interop:
+            // Only the decoders that can hand their frames to OpenGL without copying
+            return "vaapi,nvdec,d3d11va,videotoolbox";
+        case VideoPlayer::HardwareDecoding::Copy:
+            return "auto-copy";
+        case VideoPlayer::HardwareDecoding::Disabled:
+            return "no";
+        default:
+            throw ghoul::MissingCaseException();
+    }
+}
 } // namespace
 
 void VideoPlayer::onMpvRenderUpdate(void* ctx) {
@@ -251,6 +320,10 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
     , _reload(ReloadInfo)
     , _playAudio(AudioInfo, false)
     , _loopVideo(LoopVideoInfo, true)
+    , _hardwareDecoding(HardwareDecodingInfo)
+    , _activeDecoder(ActiveDecoderInfo, "no")
+    , _decoderQueueSize(DecoderQueueSizeInfo, 8, 0, 64)
+    , _frameSynchronization(FrameSynchronizationInfo, false)
 {
     ZoneScoped;
 
@@ -262,6 +335,60 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
     _reload.onChange([this]() { reload(); });
     addProperty(_reload);
 
+    _hardwareDecoding.addOptions({
+        { static_cast<int>(HardwareDecoding::Interop), "Interop" },
+        { static_cast<int>(HardwareDecoding::Copy), "Copy" },
+        { static_cast<int>(HardwareDecoding::Disabled), "Disabled" }
+    });
+    if (p.hardwareDecoding.has_value()) {
+        switch (*p.hardwareDecoding) {
+            case Parameters::HardwareDecoding::Interop:
+                _hardwareDecoding = static_cast<int>(HardwareDecoding::Interop);
+                break;
+            case Parameters::HardwareDecoding::Copy:
+                _hardwareDecoding = static_cast<int>(HardwareDecoding::Copy);
+                break;
+            case Parameters::HardwareDecoding::Disabled:
+                _hardwareDecoding = static_cast<int>(HardwareDecoding::Disabled);
+                break;
+        }
+    }
+    _hardwareDecoding.onChange([this]() {
+        setPropertyAsyncMpv(
+            hwdecValue(static_cast<HardwareDecoding>(_hardwareDecoding.value())),
+            MpvKey::Hwdec
+        );
+    });
+    addProperty(_hardwareDecoding);
+
+    _activeDecoder.setReadOnly(true);
+    addProperty(_activeDecoder);
+
+    _decoderQueueSize = p.decoderQueueSize.value_or(_decoderQueueSize);
+    _decoderQueueSize.onChange([this]() {
+        if (_isInitialized) {
+            reload();
+        }
+    });
+    addProperty(_decoderQueueSize);
+
+    _frameSynchronization = p.frameSynchronization.value_or(_frameSynchronization);
+    _frameSynchronization.onChange([this]() {
+        if (_frameSynchronization) {
+            // The decoder is only ever advanced by frame steps from now on, so it has
+            // to stay paused while we keep track of whether the video is playing
+            _isFrameSyncPlaying = !_isPaused;
+            _targetPresentationTime = _currentVideoTime;
+            _presentedFrame = -1;
+            constexpr int IsPaused = 1;
+            setPropertyAsyncMpv(IsPaused, MpvKey::Pause);
+        }
+        else if (_isFrameSyncPlaying) {
+            play();
+        }
+    });
+    addProperty(_frameSynchronization);
+
     if (p.playbackMode.has_value()) {
         switch (*p.playbackMode) {
             case Parameters::PlaybackMode::RealTimeLoop:
@@ -315,7 +442,9 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
         { MpvKey::IsSeeking, "seeking" },
         { MpvKey::Mute, "mute" },
         { MpvKey::Seek, "seek" },
-        { MpvKey::Loop, "loop-file" }
+        { MpvKey::Loop, "loop-file" },
+        { MpvKey::Hwdec, "hwdec" },
+        { MpvKey::HwdecCurrent, "hwdec-current" }
     };
 
     formats = {
@@ -328,7 +457,9 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
         { MpvKey::Fps, MPV_FORMAT_DOUBLE },
         { MpvKey::IsSeeking, MPV_FORMAT_FLAG },
         { MpvKey::Mute, MPV_FORMAT_STRING },
-        { MpvKey::Loop, MPV_FORMAT_STRING }
+        { MpvKey::Loop, MPV_FORMAT_STRING },
+        { MpvKey::Hwdec, MPV_FORMAT_STRING },
+        { MpvKey::HwdecCurrent, MPV_FORMAT_STRING }
     };
 }
 
@@ -338,16 +469,28 @@ VideoPlayer::~VideoPlayer() {
 }
 
 void VideoPlayer::pause() {
+    if (_frameSynchronization) {
+        _isFrameSyncPlaying = false;
+        return;
+    }
     constexpr int IsPaused = 1;
     setPropertyAsyncMpv(IsPaused, MpvKey::Pause);
 }
 
 void VideoPlayer::play() {
+    if (_frameSynchronization) {
+        _isFrameSyncPlaying = true;
+        return;
+    }
     constexpr int IsPaused = 0;
     setPropertyAsyncMpv(IsPaused, MpvKey::Pause);
 }
 
 void VideoPlayer::goToStart() {
+    if (_frameSynchronization) {
+        _targetPresentationTime = 0.0;
+        return;
+    }
     seekToTime(0.0);
 }
 
@@ -380,9 +523,23 @@ void VideoPlayer::initializeMpv() {
     // https://mpv.io/manual/stable/#options-keep-open
     setPropertyStringMpv("keep-open", "yes");
 
-    // Enable hardware decoding
+    // Enable hardware decoding. With the interop decoders the frames stay on the GPU
+    // and are mapped into OpenGL textures by the render context
     // https://mpv.io/manual/master/#options-hwdec
-    setPropertyStringMpv("hwdec", "auto");
+    setPropertyStringMpv(
+        "hwdec",
+        hwdecValue(static_cast<HardwareDecoding>(_hardwareDecoding.value()))
+    );
+
+    // Decode into a queue on a separate thread so that the decoding of a frame, which
+    // can be slow for large videos, is decoupled from the frame rendering. The render
+    // context then only has to pick up the next queued frame
+    // https://mpv.io/manual/master/#options-vd-queue-enable
+    if (_decoderQueueSize > 0) {
+        const std::string queueSize = std::to_string(_decoderQueueSize);
+        setPropertyStringMpv("vd-queue-enable", "yes");
+        setPropertyStringMpv("vd-queue-max-samples", queueSize.c_str());
+    }
 
     // Enable direct rendering (default: auto). If this is set to yes, the video will be
     // decoded directly to GPU video memory (or staging buffers).
@@ -467,9 +624,11 @@ void VideoPlayer::initializeMpv() {
     observePropertyMpv(MpvKey::Fps);
     observePropertyMpv(MpvKey::Time);
     observePropertyMpv(MpvKey::IsSeeking);
+    observePropertyMpv(MpvKey::HwdecCurrent);
 
     // Render the first frame so we can see the video
     renderFrame();
+    _presentedFrame = -1;
 
     _isInitialized = true;
 }
@@ -516,7 +675,7 @@ void VideoPlayer::update() {
         return;
     }
 
-    if (_playbackMode == PlaybackMode::MapToSimulationTime) {
+    if (_playbackMode == PlaybackMode::MapToSimulationTime && !_frameSynchronization) {
         seekToTime(correctVideoPlaybackTime());
     }
     if (_mpvRenderContext && _mpvHandle) {
@@ -762,6 +921,18 @@ void VideoPlayer::handleMpvProperties(mpv_event* event) {
             _isPaused = (* videoIsPaused == 1);
             break;
         }
+        case MpvKey::HwdecCurrent: {
+            if (!prop) {
+                break;
+            }
+            char** decoder = reinterpret_cast<char**>(prop->data);
+            if (!decoder || !*decoder) {
+                break;
+            }
+            _activeDecoder = std::string(*decoder);
+            LINFO(std::format("Active decoder: {}", *decoder));
+            break;
+        }
         case MpvKey::Meta: {
             LINFO("Printing meta data reply");
             if (node.format == MPV_FORMAT_NODE_MAP) {
@@ -794,17 +965,29 @@ void VideoPlayer::destroy() {
 
 void VideoPlayer::preSync(bool isMaster) {
     _correctPlaybackTime = isMaster ? _currentVideoTime : -1.0;
+
+    if (isMaster && _frameSynchronization) {
+        updateTargetPresentationTime();
+    }
 }
 
 void VideoPlayer::encode(SyncBuffer* syncBuffer) {
     syncBuffer->encode(_correctPlaybackTime);
+    syncBuffer->encode(_targetPresentationTime);
 }
 
 void VideoPlayer::decode(SyncBuffer* syncBuffer) {
     syncBuffer->decode(_correctPlaybackTime);
+    syncBuffer->decode(_targetPresentationTime);
 }
 
 void VideoPlayer::postSync(bool isMaster) {
+    if (_frameSynchronization) {
+        // All nodes, including the master, present the frame that the master decided on
+        presentFrame(_targetPresentationTime);
+        return;
+    }
+
     if (_correctPlaybackTime < 0.0) {
         return;
     }
@@ -834,6 +1017,56 @@ bool VideoPlayer::isInitialized() const {
     return _isInitialized;
 }
 
+void VideoPlayer::updateTargetPresentationTime() {
+    if (_playbackMode == PlaybackMode::MapToSimulationTime) {
+        _targetPresentationTime = correctVideoPlaybackTime();
+        return;
+    }
+
+    if (!_isFrameSyncPlaying || _videoDuration <= 0.0) {
+        return;
+    }
+
+    _targetPresentationTime += global::windowDelegate->deltaTime();
+    if (_targetPresentationTime >= _videoDuration) {
+        _targetPresentationTime = _loopVideo ?
+            std::fmod(_targetPresentationTime, _videoDuration) :
+            std::max(_videoDuration - 1.0 / _fps, 0.0);
+    }
+}
+
+void VideoPlayer::presentFrame(double presentationTime) {
+    if (!_isInitialized || _isDestroying) {
+        return;
+    }
+
+    const int64_t frame = static_cast<int64_t>(std::floor(presentationTime * _fps));
+    const int64_t difference = frame - _presentedFrame;
+    if (difference == 0) {
+        return;
+    }
+
+    if (_presentedFrame >= 0 && difference > 0 && difference <= MaxFrameSteps) {
+        // Stepping takes the next frames out of the decoder queue which is much cheaper
+        // than a seek that requires flushing the decoder
+        // https://mpv.io/manual/master/#command-interface-frame-step
+        const char* cmd[] = { "frame-step", nullptr };
+        for (int64_t i = 0; i < difference; i++) {
+            commandAsyncMpv(cmd);
+        }
+    }
+    else {
+        // https://mpv.io/manual/master/#command-interface-seek
+        const std::string time = std::to_string(static_cast<double>(frame) / _fps);
+        const char* cmd[] = { "seek", time.c_str(), "absolute+exact", nullptr };
+        commandAsyncMpv(cmd, MpvKey::Seek);
+    }
+
+    // We keep track of the presented frame ourselves as the time reported by libmpv
+    // arrives asynchronously and would cause frames to be stepped twice
+    _presentedFrame = frame;
+}
+
 bool VideoPlayer::isWithingStartEndTime() const {
     const double now = global::timeManager->time().j2000Seconds();
     return now <= _endJ200Time && now >= _startJ200Time;
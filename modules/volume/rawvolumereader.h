@@ -25,8 +25,11 @@
 #ifndef __OPENSPACE_MODULE_VOLUME___RAWVOLUMEREADER___H__
 #define __OPENSPACE_MODULE_VOLUME___RAWVOLUMEREADER___H__
 
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/glm.h>
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <string>
 
 namespace openspace::volume {
@@ -48,11 +51,35 @@ public:
     //VoxelType get(const size_t index) const; // TODO: Implement this
     std::unique_ptr<RawVolume<VoxelType>> read(bool invertZ = false);
 
+    /**
+     * Reads the z-slices [\p zBegin, \p zEnd) of the volume into \p slab, which must
+     * have room for exactly that many slices. If \p invertZ is `true`, the slices are
+     * counted from the other end of the volume and are stored in reverse order, which
+     * matches the slices of the volume returned by `read(true)`.
+     *
+     * \throw ghoul::FileNotFoundError If the volume file could not be opened
+     * \throw ghoul::RuntimeError If the slices could not be read
+     */
+    void readSlab(unsigned int zBegin, unsigned int zEnd, std::span<VoxelType> slab,
+        bool invertZ = false) const;
+
+    /**
+     * Maps the volume file into memory and returns its voxels in place, without reading
+     * or copying them. The voxels are paged in by the operating system as they are
+     * accessed. The returned span stays valid until the path is changed or this reader
+     * is destroyed.
+     *
+     * \throw ghoul::RuntimeError If the file could not be mapped or is too small for the
+     *        dimensions of the volume
+     */
+    std::span<const VoxelType> map();
+
 private:
     size_t coordsToIndex(const glm::uvec3& cartesian) const;
     glm::uvec3 indexToCoords(size_t linear) const;
     glm::uvec3 _dimensions;
     std::filesystem::path _path;
+    std::unique_ptr<MemoryMappedFile> _mappedFile;
 };
 
 } // namespace openspace::volume
@@ -22,6 +22,8 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+#include <ghoul/format.h>
+#include <ghoul/misc/assert.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/profiling.h>
 #include <fstream>
@@ -53,6 +55,7 @@ std::filesystem::path RawVolumeReader<VoxelType>::path() const {
 template <typename VoxelType>
 void RawVolumeReader<VoxelType>::setPath(std::filesystem::path path) {
     _path = std::move(path);
+    _mappedFile = nullptr;
 }
 
 /*
@@ -82,45 +85,67 @@ template <typename VoxelType>
 std::unique_ptr<RawVolume<VoxelType>> RawVolumeReader<VoxelType>::read(bool invertZ) {
     ZoneScoped;
 
+    const glm::uvec3 dims = dimensions();
+    auto volume = std::make_unique<RawVolume<VoxelType>>(dims);
+    readSlab(0, dims.z, std::span<VoxelType>(volume->data(), volume->nCells()), invertZ);
+    return volume;
+}
+
+template <typename VoxelType>
+void RawVolumeReader<VoxelType>::readSlab(unsigned int zBegin, unsigned int zEnd,
+                                          std::span<VoxelType> slab, bool invertZ) const
+{
+    ZoneScoped;
+
+    const glm::uvec3 dims = dimensions();
+    const size_t sliceSize = static_cast<size_t>(dims.x) * dims.y;
+    ghoul_assert(zBegin <= zEnd && zEnd <= dims.z, "Invalid slab");
+    ghoul_assert(slab.size() == sliceSize * (zEnd - zBegin), "Invalid slab size");
+
     std::ifstream file = std::ifstream(_path, std::ios::binary);
     if (file.fail()) {
         throw ghoul::FileNotFoundError("Volume file not found");
     }
 
-    glm::uvec3 dims = dimensions();
-    auto volume = std::make_unique<RawVolume<VoxelType>>(dims);
-
-    char* buffer = reinterpret_cast<char*>(volume->data());
-    size_t length = glm::compMul(dims) * sizeof(VoxelType);
-    {
-        ZoneScopedN("read");
-        file.read(buffer, length);
+    const size_t sliceBytes = sliceSize * sizeof(VoxelType);
+    if (!invertZ) {
+        // The slices are stored contiguously, so the slab can be read in one go
+        file.seekg(zBegin * sliceBytes);
+        file.read(reinterpret_cast<char*>(slab.data()), slab.size_bytes());
+    }
+    else {
+        for (unsigned int z = zBegin; z < zEnd; z++) {
+            file.seekg((dims.z - z - 1) * sliceBytes);
+            file.read(
+                reinterpret_cast<char*>(slab.data() + (z - zBegin) * sliceSize),
+                sliceBytes
+            );
+        }
     }
 
     if (file.fail()) {
         throw ghoul::RuntimeError("Error reading volume file");
     }
+}
 
-    if (invertZ) {
-        std::unique_ptr<RawVolume<VoxelType>> newVolume =
-            std::make_unique<RawVolume<VoxelType>>(dims);
-
-        for (size_t i = 0; i < volume->nCells(); i++) {
-            const glm::uvec3& coords = volume->indexToCoords(i);
-            glm::uvec3 newcoords = glm::uvec3(coords.x, coords.y, dims.z - coords.z - 1);
-
-            // @TODO (emmbr, 2022-02-10) Not sure why they are here, but commented them
-            // out for now as they aren't used
-            //size_t newIndex = volume->coordsToIndex(newcoords);
-            //size_t oldIndex = volume->coordsToIndex(coords);
-
-            newVolume->set(newcoords, volume->get(coords));
-        }
-        return newVolume;
+template <typename VoxelType>
+std::span<const VoxelType> RawVolumeReader<VoxelType>::map() {
+    if (!_mappedFile) {
+        _mappedFile = std::make_unique<MemoryMappedFile>(_path);
     }
-    else {
-        return volume;
+
+    const glm::uvec3 dims = dimensions();
+    const size_t nCells = static_cast<size_t>(dims.x) * dims.y * dims.z;
+    if (_mappedFile->size() < nCells * sizeof(VoxelType)) {
+        _mappedFile = nullptr;
+        throw ghoul::RuntimeError(std::format(
+            "Volume file '{}' is too small for its dimensions", _path
+        ));
     }
+    return std::span<const VoxelType>(
+        reinterpret_cast<const VoxelType*>(_mappedFile->data()),
+        nCells
+    );
 }
 
 } // namespace openspace::volume
@@ -35,6 +35,8 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 namespace {
@@ -62,7 +64,10 @@ void BasicVolumeRaycaster::initialize() {
     _boundingBox.initialize();
 }
 
-void BasicVolumeRaycaster::deinitialize() {}
+void BasicVolumeRaycaster::deinitialize() {
+    _occupancyTexture = nullptr;
+    _occupancyGrid = nullptr;
+}
 
 void BasicVolumeRaycaster::renderEntryPoints(const RenderData& data,
                                              ghoul::opengl::ProgramObject& program)
@@ -118,6 +123,8 @@ void BasicVolumeRaycaster::preRaycast(const RaycastData& data,
     const std::string id = std::to_string(data.id);
 
     _transferFunction->update();
+    updateOccupancy();
+
     _tfUnit = std::make_unique<ghoul::opengl::TextureUnit>();
     _tfUnit->activate();
     _transferFunction->texture().bind();
@@ -140,12 +147,95 @@ void BasicVolumeRaycaster::preRaycast(const RaycastData& data,
     program.setUniform("brightness_" + id, brightness());
     program.setUniform("rNormalization_" + id, _rNormalization);
     program.setUniform("rUpperBound_" + id, _rUpperBound);
+
+    // The radius normalization changes the sampled values after the lookup in the brick
+    // grid, so the occupancy cannot be used for it
+    const bool useOccupancy = _occupancyTexture && _occupancyGrid &&
+        !(_gridType == VolumeGridType::Spherical && _rNormalization > 0.f);
+    program.setUniform("useOccupancy_" + id, useOccupancy);
+    if (useOccupancy) {
+        _occupancyUnit = std::make_unique<ghoul::opengl::TextureUnit>();
+        _occupancyUnit->activate();
+        _occupancyTexture->bind();
+        program.setUniform("occupancyTexture_" + id, _occupancyUnit->unitNumber());
+        program.setUniform("nBricks_" + id, glm::ivec3(_occupancyGrid->nBricks));
+        program.setUniform("brickExtent_" + id, _occupancyGrid->brickExtent);
+    }
+}
+
+void BasicVolumeRaycaster::updateOccupancy() {
+    if (!_brickGrid) {
+        _occupancyGrid = nullptr;
+        return;
+    }
+
+    // A texel of the transfer function contributes if either its color or its alpha is
+    // non-zero, as the color is accumulated separately from the alpha
+    const size_t width = _transferFunction->width();
+    std::vector<bool> visible(width);
+    for (size_t i = 0; i < width; i++) {
+        const glm::vec4 color = _transferFunction->sample(i);
+        visible[i] = glm::any(glm::greaterThan(color, glm::vec4(0.f)));
+    }
+
+    if (_brickGrid == _occupancyGrid && visible == _visibleTexels) {
+        return;
+    }
+    _visibleTexels = std::move(visible);
+    _occupancyGrid = _brickGrid;
+
+    // Prefix sum over the visible texels so that each brick's range is tested at once
+    std::vector<size_t> nVisible(width + 1, 0);
+    for (size_t i = 0; i < width; i++) {
+        nVisible[i + 1] = nVisible[i] + (_visibleTexels[i] ? 1 : 0);
+    }
+
+    const float w = static_cast<float>(width);
+    const int lastTexel = static_cast<int>(width) - 1;
+    _occupancy.resize(_occupancyGrid->ranges.size());
+    for (size_t i = 0; i < _occupancyGrid->ranges.size(); i++) {
+        const glm::vec2 range = _occupancyGrid->ranges[i];
+        if (!(range.x <= range.y)) {
+            _occupancy[i] = 0;
+            continue;
+        }
+
+        // The linear filtering of the transfer function reads the two closest texels
+        const int lo = std::clamp(
+            static_cast<int>(std::floor(range.x * w - 0.5f)), 0, lastTexel
+        );
+        const int hi = std::clamp(
+            static_cast<int>(std::ceil(range.y * w - 0.5f)), 0, lastTexel
+        );
+        _occupancy[i] = nVisible[hi + 1] > nVisible[lo] ? 255 : 0;
+    }
+
+    const glm::uvec3 nBricks = _occupancyGrid->nBricks;
+    if (!_occupancyTexture || glm::uvec3(_occupancyTexture->dimensions()) != nBricks) {
+        _occupancyTexture = std::make_unique<ghoul::opengl::Texture>(
+            nBricks,
+            GL_TEXTURE_3D,
+            ghoul::opengl::Texture::Format::Red,
+            GL_R8,
+            GL_UNSIGNED_BYTE,
+            ghoul::opengl::Texture::FilterMode::Nearest,
+            ghoul::opengl::Texture::WrappingMode::ClampToEdge,
+            ghoul::opengl::Texture::AllocateData::No,
+            ghoul::opengl::Texture::TakeOwnership::No
+        );
+    }
+    _occupancyTexture->setPixelData(
+        _occupancy.data(),
+        ghoul::opengl::Texture::TakeOwnership::No
+    );
+    _occupancyTexture->uploadTexture();
 }
 
 void BasicVolumeRaycaster::postRaycast(const RaycastData&, ghoul::opengl::ProgramObject&)
 {
     _textureUnit = nullptr;
     _tfUnit = nullptr;
+    _occupancyUnit = nullptr;
 }
 
 bool BasicVolumeRaycaster::isCameraInside(const RenderData& data,
@@ -193,6 +283,10 @@ std::shared_ptr<ghoul::opengl::Texture> BasicVolumeRaycaster::volumeTexture() co
     return _volumeTexture;
 }
 
+void BasicVolumeRaycaster::setBrickGrid(std::shared_ptr<const BrickGrid> brickGrid) {
+    _brickGrid = std::move(brickGrid);
+}
+
 void BasicVolumeRaycaster::setStepSize(float stepSize) {
     _stepSize = stepSize;
 }
@@ -29,6 +29,7 @@
 
 #include <openspace/util/boxgeometry.h>
 #include <modules/volume/volumegridtype.h>
+#include <vector>
 
 namespace ghoul::opengl {
     class Texture;
@@ -49,6 +50,21 @@ class VolumeClipPlanes;
 
 class BasicVolumeRaycaster : public VolumeRaycaster {
 public:
+    /**
+     * A coarse subdivision of the volume into bricks that stores the range of normalized
+     * values that can be sampled inside each brick. The ranges include a one voxel border
+     * around each brick so that they stay conservative under trilinear filtering.
+     */
+    struct BrickGrid {
+        /// The number of bricks along each axis
+        glm::uvec3 nBricks = glm::uvec3(0);
+        /// The size of a single brick in texture coordinates
+        glm::vec3 brickExtent = glm::vec3(1.f);
+        /// The (min, max) values of each brick, with x varying fastest. A brick that
+        /// has a minimum larger than its maximum does not contain any values
+        std::vector<glm::vec2> ranges;
+    };
+
     BasicVolumeRaycaster(
         std::shared_ptr<ghoul::opengl::Texture> texture,
         std::shared_ptr<openspace::TransferFunction> transferFunction,
@@ -76,6 +92,13 @@ public:
 
     void setVolumeTexture(std::shared_ptr<ghoul::opengl::Texture> texture);
     std::shared_ptr<ghoul::opengl::Texture> volumeTexture() const;
+
+    /**
+     * Sets the brick grid of the current volume texture that is used to skip bricks that
+     * are fully transparent under the current transfer function. If \p brickGrid is
+     * `nullptr`, the entire volume is sampled.
+     */
+    void setBrickGrid(std::shared_ptr<const BrickGrid> brickGrid);
     void setTransferFunction(std::shared_ptr<openspace::TransferFunction>
         transferFunction);
 
@@ -93,6 +116,12 @@ public:
 private:
     glm::dmat4 modelViewTransform(const RenderData& data);
 
+    /**
+     * Rebuilds the occupancy texture if the brick grid or the visible parts of the
+     * transfer function have changed since it was last built.
+     */
+    void updateOccupancy();
+
     std::shared_ptr<VolumeClipPlanes> _clipPlanes;
     std::shared_ptr<ghoul::opengl::Texture> _volumeTexture;
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
@@ -106,6 +135,15 @@ private:
     std::unique_ptr<ghoul::opengl::TextureUnit> _tfUnit;
     std::unique_ptr<ghoul::opengl::TextureUnit> _textureUnit;
     float _stepSize = 0.f;
+
+    std::shared_ptr<const BrickGrid> _brickGrid;
+    // The brick grid that the current occupancy texture was built from
+    std::shared_ptr<const BrickGrid> _occupancyGrid;
+    // Whether each texel of the transfer function contributes to the image
+    std::vector<bool> _visibleTexels;
+    std::vector<uint8_t> _occupancy;
+    std::unique_ptr<ghoul::opengl::Texture> _occupancyTexture;
+    std::unique_ptr<ghoul::opengl::TextureUnit> _occupancyUnit;
 };
 
 } // namespace openspace::volume
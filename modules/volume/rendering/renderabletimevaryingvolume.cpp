@@ -27,7 +27,6 @@
 #include <modules/volume/rendering/basicvolumeraycaster.h>
 #include <modules/volume/rendering/volumeclipplanes.h>
 #include <modules/volume/transferfunctionhandler.h>
-#include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumereader.h>
 #include <modules/volume/volumegridtype.h>
 #include <openspace/documentation/documentation.h>
@@ -35,8 +34,10 @@
 #include <openspace/engine/globals.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/rendering/renderengine.h>
+#include <openspace/rendering/uploadscheduler.h>
 #include <openspace/util/histogram.h>
 #include <openspace/rendering/transferfunction.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/time.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/updatestructures.h>
@@ -44,14 +45,55 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <limits>
 #include <optional>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderableTimeVaryingVolume";
 
+    // The maximum number of voxels that are uploaded to a texture at once
+    constexpr size_t SlabCells = 1 << 20;
+
+    // The number of voxels along each axis of the bricks used for empty space skipping
+    constexpr unsigned int BrickSize = 16;
+
     const float SecondsInOneDay = 60 * 60 * 24;
 
+    // Adds the normalized z-slice \p slice to the value ranges of all bricks whose
+    // voxels, including a one voxel border, contain it
+    void addSliceToBricks(openspace::volume::BasicVolumeRaycaster::BrickGrid& grid,
+                          const glm::uvec3& dims, unsigned int z, const float* slice)
+    {
+        const glm::uvec3 n = grid.nBricks;
+        auto brickRange = [](unsigned int v, unsigned int nBricks) {
+            const unsigned int first = v == 0 ? 0 : (v - 1) / BrickSize;
+            const unsigned int last = std::min((v + 1) / BrickSize, nBricks - 1);
+            return std::pair(first, last);
+        };
+
+        const auto [bz0, bz1] = brickRange(z, n.z);
+        for (unsigned int y = 0; y < dims.y; y++) {
+            const float* row = slice + static_cast<size_t>(y) * dims.x;
+            const auto [by0, by1] = brickRange(y, n.y);
+            for (unsigned int bx = 0; bx < n.x; bx++) {
+                const unsigned int x0 = bx == 0 ? 0 : bx * BrickSize - 1;
+                const unsigned int x1 = std::min((bx + 1) * BrickSize + 1, dims.x);
+                const auto [lo, hi] = std::minmax_element(row + x0, row + x1);
+                for (unsigned int bz = bz0; bz <= bz1; bz++) {
+                    for (unsigned int by = by0; by <= by1; by++) {
+                        const size_t i = (static_cast<size_t>(bz) * n.y + by) * n.x + bx;
+                        glm::vec2& range = grid.ranges[i];
+                        range.x = std::min(range.x, *lo);
+                        range.y = std::max(range.y, *hi);
+                    }
+                }
+            }
+        }
+    }
+
     constexpr openspace::properties::Property::PropertyInfo StepSizeInfo = {
         "StepSize",
         "Step Size",
@@ -109,6 +151,15 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo PrefetchedTimestepsInfo = {
+        "PrefetchedTimesteps",
+        "Prefetched Timesteps",
+        "The number of timesteps after the current one, in the direction in which time "
+        "is moving, that are loaded ahead of time. Together with the current and the "
+        "previous timestep, these are the only timesteps that are kept on the GPU.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo BrightnessInfo = {
         "Brightness",
         "Brightness",
@@ -152,6 +203,9 @@ namespace {
         // [[codegen::verbatim(StepSizeInfo.description)]]
         std::optional<float> stepSize;
 
+        // [[codegen::verbatim(PrefetchedTimestepsInfo.description)]]
+        std::optional<int> prefetchedTimesteps [[codegen::inrange(0, 16)]];
+
         // [[codegen::verbatim(GridTypeInfo.description)]]
         std::optional<std::string> gridType [[codegen::inlist("Spherical", "Cartesian")]];
 
@@ -181,6 +235,7 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     , _transferFunctionPath(TransferFunctionInfo)
     , _triggerTimeJump(TriggerTimeJumpInfo)
     , _jumpToTimestep(JumpToTimestepInfo, 0, 0, 256)
+    , _nPrefetchedTimesteps(PrefetchedTimestepsInfo, 2, 0, 16)
     , _invertDataAtZ(false)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
@@ -205,6 +260,7 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     _brightness = p.brightness.value_or(_brightness);
     _secondsBefore = p.secondsBefore.value_or(_secondsBefore);
     _secondsAfter = p.secondsAfter;
+    _nPrefetchedTimesteps = p.prefetchedTimesteps.value_or(_nPrefetchedTimesteps);
 
     const ghoul::Dictionary clipPlanesDict = p.clipPlanes.value_or(ghoul::Dictionary());
     _clipPlanes = std::make_shared<volume::VolumeClipPlanes>(clipPlanesDict);
@@ -237,43 +293,13 @@ void RenderableTimeVaryingVolume::initializeGL() {
         }
     }
 
-    // TODO: defer loading of data to later (separate thread or at least not when loading)
+    // The volumes are only read once their timesteps are about to be shown, and only the
+    // timesteps around the current time are kept on the GPU
     for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
-        Timestep& t = p.second;
-        const std::string path = std::format(
-            "{}/{}.rawvolume", _sourceDirectory.value(), t.baseName
-        );
-        RawVolumeReader<float> reader(path, t.metadata.dimensions);
-        t.rawVolume = reader.read(_invertDataAtZ);
-
-        const float min = t.metadata.minValue;
-        const float diff = t.metadata.maxValue - t.metadata.minValue;
-        float* data = t.rawVolume->data();
-        for (size_t i = 0; i < t.rawVolume->nCells(); i++) {
-            data[i] = glm::clamp((data[i] - min) / diff, 0.f, 1.f);
+        if (glm::compMul(p.second.metadata.dimensions) == 0) {
+            LWARNING(std::format("Volume '{}' is empty", p.second.baseName));
+            p.second.hasFailed = true;
         }
-
-        t.histogram = std::make_shared<Histogram>(0.f, 1.f, 100);
-        for (size_t i = 0; i < t.rawVolume->nCells(); i++) {
-            t.histogram->add(data[i]);
-        }
-        // TODO: handle normalization properly for different timesteps + transfer function
-
-        t.texture = std::make_shared<ghoul::opengl::Texture>(
-            t.metadata.dimensions,
-            GL_TEXTURE_3D,
-            ghoul::opengl::Texture::Format::Red,
-            GL_RED,
-            GL_FLOAT,
-            ghoul::opengl::Texture::FilterMode::Linear,
-            ghoul::opengl::Texture::WrappingMode::Clamp
-        );
-
-        t.texture->setPixelData(
-            reinterpret_cast<void*>(data),
-            ghoul::opengl::Texture::TakeOwnership::No
-        );
-        t.texture->uploadTexture();
     }
 
     _clipPlanes->initialize();
@@ -311,6 +337,7 @@ void RenderableTimeVaryingVolume::initializeGL() {
 
     addProperty(_triggerTimeJump);
     addProperty(_jumpToTimestep);
+    addProperty(_nPrefetchedTimesteps);
     addProperty(_rNormalization);
     addProperty(_rUpperBound);
     addProperty(_gridType);
@@ -422,11 +449,243 @@ void RenderableTimeVaryingVolume::jumpToTimestep(int target) {
     }
 }
 
-void RenderableTimeVaryingVolume::update(const UpdateData&) {
+std::vector<int> RenderableTimeVaryingVolume::residentTimesteps(double currentTime,
+                                                               double timeStep) const
+{
+    if (_volumeTimesteps.empty()) {
+        return {};
+    }
+
+    // The timestep that is shown at the current time, or the closest timestep if the
+    // current time is outside of the sequence
+    const auto it = _volumeTimesteps.upper_bound(currentTime);
+    const int current = std::max(
+        static_cast<int>(std::distance(_volumeTimesteps.begin(), it)) - 1,
+        0
+    );
+    const int nTimesteps = static_cast<int>(_volumeTimesteps.size());
+    const int direction = timeStep < 0.0 ? -1 : 1;
+
+    std::vector<int> indices = { current };
+    for (int i = 1; i <= _nPrefetchedTimesteps; i++) {
+        const int index = current + i * direction;
+        if (index < 0 || index >= nTimesteps) {
+            break;
+        }
+        indices.push_back(index);
+    }
+    // The previous timestep is kept so that it can be shown while the current one is
+    // uploaded and so that stepping back does not have to wait for it
+    const int previous = current - direction;
+    if (previous >= 0 && previous < nTimesteps) {
+        indices.push_back(previous);
+    }
+    return indices;
+}
+
+void RenderableTimeVaryingVolume::startLoading(Timestep& t) {
+    if (t.hasFailed || t.onGpu || t.volume || t.loading.valid()) {
+        return;
+    }
+
+    const std::string path = std::format(
+        "{}/{}.rawvolume", _sourceDirectory.value(), t.baseName
+    );
+    auto load = [path, metadata = t.metadata, invertDataAtZ = _invertDataAtZ]() {
+        // The volume file is mapped, so the disk is only read while the voxels are
+        // normalized here rather than on the main thread
+        RawVolumeReader<float> reader(path, metadata.dimensions);
+        const std::span<const float> voxels = reader.map();
+
+        const glm::uvec3 dims = metadata.dimensions;
+        const size_t sliceSize = static_cast<size_t>(dims.x) * dims.y;
+        const float min = metadata.minValue;
+        const float diff = metadata.maxValue - metadata.minValue;
+
+        auto volume = std::make_shared<LoadedVolume>();
+        volume->voxels.resize(sliceSize * dims.z);
+
+        volume->bricks = std::make_shared<BasicVolumeRaycaster::BrickGrid>();
+        BasicVolumeRaycaster::BrickGrid& bricks = *volume->bricks;
+        bricks.nBricks = (dims + glm::uvec3(BrickSize - 1)) / BrickSize;
+        bricks.brickExtent = glm::vec3(static_cast<float>(BrickSize)) / glm::vec3(dims);
+        bricks.ranges.resize(
+            static_cast<size_t>(bricks.nBricks.x) * bricks.nBricks.y * bricks.nBricks.z,
+            glm::vec2(
+                std::numeric_limits<float>::max(),
+                std::numeric_limits<float>::lowest()
+            )
+        );
+
+        for (unsigned int z = 0; z < dims.z; z++) {
+            const size_t sourceZ = invertDataAtZ ? dims.z - z - 1 : z;
+            const std::span<const float> source =
+                voxels.subspan(sourceZ * sliceSize, sliceSize);
+            float* destination = volume->voxels.data() + z * sliceSize;
+            for (size_t i = 0; i < sliceSize; i++) {
+                destination[i] = glm::clamp((source[i] - min) / diff, 0.f, 1.f);
+            }
+            addSliceToBricks(bricks, dims, z, destination);
+        }
+
+        volume->histogram = std::make_shared<Histogram>(0.f, 1.f, 100);
+        // TODO: handle normalization properly for different timesteps + transfer function
+        volume->histogram->add(volume->voxels);
+        return volume;
+    };
+    t.loading = global::threadPool->submit(std::move(load), ThreadPool::Priority::Low);
+}
+
+void RenderableTimeVaryingVolume::finishLoading(Timestep& t) {
+    using namespace std::chrono_literals;
+
+    if (!t.loading.valid() || t.loading.wait_for(0s) != std::future_status::ready) {
+        return;
+    }
+
+    try {
+        t.volume = t.loading.get();
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        t.hasFailed = true;
+        return;
+    }
+    t.histogram = t.volume->histogram;
+    t.bricks = t.volume->bricks;
+    t.nUploadedSlices = 0;
+    t.inRam = true;
+
+    // The texture of an evicted timestep is reused if it has the same size, so that
+    // playing back a sequence does not allocate a new texture for every timestep
+    const auto it = std::find_if(
+        _freeTextures.begin(),
+        _freeTextures.end(),
+        [&t](const std::shared_ptr<ghoul::opengl::Texture>& texture) {
+            return texture->dimensions() == t.metadata.dimensions;
+        }
+    );
+    if (it != _freeTextures.end()) {
+        t.texture = std::move(*it);
+        _freeTextures.erase(it);
+    }
+    else {
+        t.texture = std::make_shared<ghoul::opengl::Texture>(
+            t.metadata.dimensions,
+            GL_TEXTURE_3D,
+            ghoul::opengl::Texture::Format::Red,
+            GL_RED,
+            GL_FLOAT,
+            ghoul::opengl::Texture::FilterMode::Linear,
+            ghoul::opengl::Texture::WrappingMode::Clamp,
+            ghoul::opengl::Texture::AllocateData::No,
+            ghoul::opengl::Texture::TakeOwnership::No
+        );
+        t.texture->uploadTexture();
+    }
+
+    // Slices that have not been uploaded yet are shown as empty
+    constexpr float Zero = 0.f;
+    glClearTexImage(*t.texture, 0, GL_RED, GL_FLOAT, &Zero);
+}
+
+void RenderableTimeVaryingVolume::evict(Timestep& t) {
+    if (t.texture) {
+        _freeTextures.push_back(std::move(t.texture));
+        t.texture = nullptr;
+    }
+    // A reading that is still in progress finishes on the thread pool, but its result
+    // is discarded
+    t.loading = std::future<std::shared_ptr<LoadedVolume>>();
+    t.volume = nullptr;
+    t.histogram = nullptr;
+    t.bricks = nullptr;
+    t.nUploadedSlices = 0;
+    t.inRam = false;
+    t.onGpu = false;
+}
+
+void RenderableTimeVaryingVolume::uploadSlabs(Timestep& t) {
+    if (!t.volume || !t.texture) {
+        return;
+    }
+
+    UploadScheduler& scheduler = global::renderEngine->uploadScheduler();
+
+    const glm::uvec3 dims = t.metadata.dimensions;
+    const size_t sliceSize = static_cast<size_t>(dims.x) * dims.y;
+    const unsigned int slicesPerSlab = static_cast<unsigned int>(
+        std::clamp<size_t>(SlabCells / sliceSize, 1, dims.z)
+    );
+
+    while (t.volume && scheduler.hasBudget()) {
+        const unsigned int zBegin = t.nUploadedSlices;
+        const unsigned int zEnd = std::min(zBegin + slicesPerSlab, dims.z);
+        const std::span<const float> slab = std::span(t.volume->voxels).subspan(
+            zBegin * sliceSize,
+            (zEnd - zBegin) * sliceSize
+        );
+
+        scheduler.uploadTextureSlices(
+            *t.texture,
+            zBegin,
+            zEnd - zBegin,
+            reinterpret_cast<const std::byte*>(slab.data()),
+            slab.size_bytes()
+        );
+
+        t.nUploadedSlices = zEnd;
+        if (t.nUploadedSlices == dims.z) {
+            t.volume = nullptr;
+            t.inRam = false;
+            t.onGpu = true;
+        }
+    }
+}
+
+void RenderableTimeVaryingVolume::update(const UpdateData& data) {
     _transferFunction->update();
 
+    const double currentTime = data.time.j2000Seconds();
+    const double timeStep = currentTime - data.previousFrameTime.j2000Seconds();
+    const std::vector<int> resident = residentTimesteps(currentTime, timeStep);
+
+    int index = 0;
+    for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
+        if (std::find(resident.begin(), resident.end(), index) == resident.end()) {
+            evict(p.second);
+        }
+        index++;
+    }
+
+    // The current timestep is uploaded first so that it is shown as soon as possible and
+    // the following timesteps are uploaded in order with the budget that is left
+    for (const int i : resident) {
+        Timestep* t = timestepFromIndex(i);
+        startLoading(*t);
+        finishLoading(*t);
+        uploadSlabs(*t);
+    }
+    if (_freeTextures.size() > resident.size()) {
+        _freeTextures.resize(resident.size());
+    }
+
     if (_raycaster) {
         Timestep* t = currentTimestep();
+        if (t && !t->onGpu) {
+            // Until all slices of the current timestep have been uploaded, the closest
+            // timestep that is completely on the GPU is shown instead. The previous
+            // timestep is last in the list, so it wins against the next one
+            const int current = timestepIndex(t);
+            int closest = std::numeric_limits<int>::max();
+            for (auto it = resident.rbegin(); it != resident.rend(); it++) {
+                Timestep* candidate = timestepFromIndex(*it);
+                if (candidate->onGpu && std::abs(*it - current) < closest) {
+                    t = candidate;
+                    closest = std::abs(*it - current);
+                }
+            }
+        }
 
         // Set scale and translation matrices:
         // The original data cube is a unit cube centered in 0
@@ -454,9 +713,12 @@ void RenderableTimeVaryingVolume::update(const UpdateData&) {
                 );
             }
             _raycaster->setVolumeTexture(t->texture);
+            // The brick grid is only complete once all slices have been uploaded
+            _raycaster->setBrickGrid(t->onGpu ? t->bricks : nullptr);
         }
         else {
             _raycaster->setVolumeTexture(nullptr);
+            _raycaster->setBrickGrid(nullptr);
         }
         _raycaster->setStepSize(_stepSize);
         _raycaster->setBrightness(_brightness * opacity());
@@ -480,6 +742,10 @@ void RenderableTimeVaryingVolume::deinitializeGL() {
         global::raycasterManager->detachRaycaster(*_raycaster);
         _raycaster = nullptr;
     }
+    for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
+        evict(p.second);
+    }
+    _freeTextures.clear();
 }
 
 } // namespace openspace::volume
@@ -28,12 +28,15 @@
 #include <openspace/rendering/renderable.h>
 
 #include <modules/volume/rawvolumemetadata.h>
+#include <modules/volume/rendering/basicvolumeraycaster.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/rendering/transferfunction.h>
+#include <future>
+#include <vector>
 
 namespace openspace {
     class Histogram;
@@ -42,8 +45,6 @@ namespace openspace {
 
 namespace openspace::volume {
 
-class BasicVolumeRaycaster;
-template <typename T> class RawVolume;
 class VolumeClipPlanes;
 
 class RenderableTimeVaryingVolume : public Renderable {
@@ -60,14 +61,29 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /// The normalized voxels of a timestep that were read on a worker thread
+    struct LoadedVolume {
+        std::vector<float> voxels;
+        std::shared_ptr<Histogram> histogram;
+        std::shared_ptr<BasicVolumeRaycaster::BrickGrid> bricks;
+    };
+
     struct Timestep {
         std::filesystem::path baseName;
         bool inRam;
         bool onGpu;
+        /// `true` if the volume file could not be read, so that it is not tried again
+        bool hasFailed = false;
         RawVolumeMetadata metadata;
-        std::shared_ptr<RawVolume<float>> rawVolume;
+        /// The reading of the volume file, while it is running on the thread pool
+        std::future<std::shared_ptr<LoadedVolume>> loading;
+        /// The voxels that are uploaded, kept until all slices have been uploaded
+        std::shared_ptr<LoadedVolume> volume;
+        /// The number of z-slices that have been uploaded to the texture so far
+        unsigned int nUploadedSlices = 0;
         std::shared_ptr<ghoul::opengl::Texture> texture;
         std::shared_ptr<Histogram> histogram;
+        std::shared_ptr<BasicVolumeRaycaster::BrickGrid> bricks;
     };
 
     Timestep* currentTimestep();
@@ -77,6 +93,35 @@ private:
 
     void loadTimestepMetadata(const std::filesystem::path& path);
 
+    /**
+     * Returns the indices of the timesteps that should be resident on the GPU, starting
+     * with the timestep closest to the \p currentTime, followed by the next timesteps
+     * in the direction of the \p timeStep and the timestep before it.
+     */
+    std::vector<int> residentTimesteps(double currentTime, double timeStep) const;
+
+    /**
+     * Reads and normalizes the volume of the timestep \p t on the thread pool, unless
+     * that has already been done or is in progress.
+     */
+    void startLoading(Timestep& t);
+
+    /**
+     * Picks up the volume of the timestep \p t if its reading has finished and
+     * provides a texture for it, reusing a released texture if possible.
+     */
+    void finishLoading(Timestep& t);
+
+    /// Releases the texture and all loaded data of the timestep \p t
+    void evict(Timestep& t);
+
+    /**
+     * Uploads the next slabs of z-slices of the timestep \p t into its texture, for as
+     * long as there is budget left in the current frame. The loaded voxels are released
+     * as soon as all slices have been uploaded.
+     */
+    void uploadSlabs(Timestep& t);
+
     properties::OptionProperty _gridType;
     std::shared_ptr<VolumeClipPlanes> _clipPlanes;
 
@@ -91,10 +136,13 @@ private:
 
     properties::TriggerProperty _triggerTimeJump;
     properties::IntProperty _jumpToTimestep;
+    properties::IntProperty _nPrefetchedTimesteps;
 
     std::map<double, Timestep> _volumeTimesteps;
     std::unique_ptr<BasicVolumeRaycaster> _raycaster;
     bool _invertDataAtZ;
+    /// Textures of evicted timesteps that can be reused for other timesteps
+    std::vector<std::shared_ptr<ghoul::opengl::Texture>> _freeTextures;
 
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
 };
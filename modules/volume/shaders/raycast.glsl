@@ -43,6 +43,26 @@ uniform float rNormalization_#{id} = 0.0;
 
 uniform float rUpperBound_#{id} = 1.0;
 
+// Bricks that are fully transparent under the current transfer function have a value of
+// 0 in the occupancy texture and are skipped
+uniform bool useOccupancy_#{id} = false;
+uniform sampler3D occupancyTexture_#{id};
+uniform ivec3 nBricks_#{id} = ivec3(1);
+uniform vec3 brickExtent_#{id} = vec3(1.0);
+
+bool isBrickOccupied#{id}(vec3 pos) {
+  ivec3 brick = clamp(ivec3(floor(pos / brickExtent_#{id})), ivec3(0), nBricks_#{id} - 1);
+  return texelFetch(occupancyTexture_#{id}, brick, 0).r > 0.0;
+}
+
+// Returns the distance along dir from pos to the boundary of the brick containing pos
+float brickExitDistance#{id}(vec3 pos, vec3 dir) {
+  vec3 brick = floor(pos / brickExtent_#{id});
+  vec3 boundary = (brick + step(0.0, dir)) * brickExtent_#{id};
+  vec3 distances = abs(boundary - pos) / max(abs(dir), vec3(1e-6));
+  return min(distances.x, min(distances.y, distances.z));
+}
+
 
 void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
                  inout vec3 accumulatedAlpha, inout float stepSize)
@@ -55,6 +75,18 @@ void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
     }
   }
 
+  if (useOccupancy_#{id} && !isBrickOccupied#{id}(transformedPos)) {
+    if (gridType_#{id} == 0) {
+      // The sampling position is jittered by at most half of the current step size, so
+      // subtracting the full step keeps the next sample inside of the current brick
+      stepSize = max(brickExitDistance#{id}(samplePos, dir) - stepSize, maxStepSize#{id});
+    }
+    else {
+      stepSize = maxStepSize#{id};
+    }
+    return;
+  }
+
   float clipAlpha = 1.0;
   vec3 centerToPos = transformedPos - vec3(0.5);
 
@@ -79,8 +111,11 @@ void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
     vec3 backColor = color.rgb;
     vec3 backAlpha = color.aaa;
 
-    backColor *= stepSize * brightness_#{id} * SamplingIntervalReferenceFactor * clipAlpha;
-    backAlpha *= stepSize * brightness_#{id} * SamplingIntervalReferenceFactor * clipAlpha;
+    // The step size that led to this sample is larger than the maximum step size after a
+    // skipped brick, but the empty region does not contribute to the sample
+    float interval = min(stepSize, maxStepSize#{id});
+    backColor *= interval * brightness_#{id} * SamplingIntervalReferenceFactor * clipAlpha;
+    backAlpha *= interval * brightness_#{id} * SamplingIntervalReferenceFactor * clipAlpha;
 
     backColor = clamp(backColor, 0.0, 1.0);
     backAlpha = clamp(backAlpha, 0.0, 1.0);
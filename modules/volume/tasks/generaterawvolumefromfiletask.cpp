@@ -108,17 +108,16 @@ void GenerateRawVolumeFromFileTask::perform(const ProgressCallback& progressCall
     }
 
     // Get min/max x, y, z position - ie. domain bounds of the volume
-    for (const dataloader::Dataset::Entry& p : data.entries)
-    {
+    for (const glm::vec3& p : data.entries.positions()) {
         _lowerDomainBound = glm::vec3(
-            std::min(_lowerDomainBound.x, p.position.x),
-            std::min(_lowerDomainBound.y, p.position.y),
-            std::min(_lowerDomainBound.z, p.position.z)
+            std::min(_lowerDomainBound.x, p.x),
+            std::min(_lowerDomainBound.y, p.y),
+            std::min(_lowerDomainBound.z, p.z)
         );
         _upperDomainBound = glm::vec3(
-            std::max(_upperDomainBound.x, p.position.x),
-            std::max(_upperDomainBound.y, p.position.y),
-            std::max(_upperDomainBound.z, p.position.z)
+            std::max(_upperDomainBound.x, p.x),
+            std::max(_upperDomainBound.y, p.y),
+            std::max(_upperDomainBound.z, p.z)
         );
     }
     progressCallback(0.4f);
@@ -146,7 +145,7 @@ void GenerateRawVolumeFromFileTask::perform(const ProgressCallback& progressCall
 
     // Write data into volume data structure
     int k = 0;
-    for (auto& entry : data.entries) {
+    for (const dataloader::Dataset::EntryView entry : data.entries) {
         // Get the closest i, j , k voxel that should contain this data
         glm::vec3 normalizedPos{ (entry.position - _lowerDomainBound) /
             (_upperDomainBound - _lowerDomainBound) };
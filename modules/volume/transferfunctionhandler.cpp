@@ -27,6 +27,7 @@
 #include <openspace/rendering/transferfunction.h>
 #include <openspace/util/histogram.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
 
 namespace {
     constexpr openspace::properties::Property::PropertyInfo TransferFunctionInfo = {
@@ -110,9 +111,49 @@ void TransferFunctionHandler::initialize() {
 }
 
 void TransferFunctionHandler::setTexture() {
-    if (_transferFunctionProperty.value().createTexture(*_texture)) {
+    if (!_transferFunctionProperty.value().createTexture(*_texture)) {
+        return;
+    }
+
+    const float* texels = reinterpret_cast<const float*>(_texture->pixelData());
+    const size_t nValues = 4 * static_cast<size_t>(_texture->width());
+    if (_uploadedTexels.size() != nValues) {
+        // Nothing was uploaded before, or the size has changed, so we need a full upload
         uploadTexture();
+        _uploadedTexels.assign(texels, texels + nValues);
+        return;
+    }
+
+    // Find the range of texels that have changed since the last upload. Editing a
+    // transfer function usually only modifies a single envelope, so only a small part of
+    // the texture has to be updated
+    size_t first = nValues;
+    size_t last = 0;
+    for (size_t i = 0; i < nValues; i++) {
+        if (texels[i] != _uploadedTexels[i]) {
+            first = std::min(first, i / 4);
+            last = i / 4;
+        }
+    }
+    if (first == nValues) {
+        return;
     }
+
+    _texture->bind();
+    glTexSubImage1D(
+        GL_TEXTURE_1D,
+        0,
+        static_cast<GLint>(first),
+        static_cast<GLsizei>(last - first + 1),
+        GL_RGBA,
+        GL_FLOAT,
+        texels + 4 * first
+    );
+    std::copy(
+        texels + 4 * first,
+        texels + 4 * (last + 1),
+        _uploadedTexels.begin() + 4 * first
+    );
 }
 
 void TransferFunctionHandler::setUnit(std::string unit) {
@@ -32,6 +32,7 @@
 #include <openspace/properties/triggerproperty.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace openspace {
     class Histogram;
@@ -71,6 +72,9 @@ private:
     properties::TransferFunctionProperty _transferFunctionProperty;
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
     std::shared_ptr<ghoul::opengl::Texture> _texture;
+    /// The texels that were last uploaded to `_texture`, used to only upload the range
+    /// of texels that is changed by an edit of the transfer function
+    std::vector<float> _uploadedTexels;
 };
 
 } //namespace openspace::volume
@@ -98,8 +98,8 @@ private:
     bool _needsRepaint = true;
     bool _textureSizeIsDirty = true;
     bool _textureIsDirty = true;
-    glm::ivec2 _lowerDirtyRectBound = glm::ivec2(0);
-    glm::ivec2 _upperDirtyRectBound = glm::ivec2(0);
+    // Regions (x, y, width, height) of the browser buffer that have to be uploaded
+    std::vector<glm::ivec4> _dirtyRects;
 
     IMPLEMENT_REFCOUNTING(WebRenderHandler);
 };
@@ -27,6 +27,12 @@
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
 
+namespace {
+    // If more than this number of separate rectangles changed between two uploads, they
+    // are combined into a single upload of their bounding box
+    constexpr size_t MaxDirtyRects = 8;
+} // namespace
+
 namespace openspace {
 
 WebRenderHandler::WebRenderHandler(bool accelerate)
@@ -64,50 +70,58 @@ void WebRenderHandler::OnPaint(CefRefPtr<CefBrowser>, CefRenderHandler::PaintEle
 
     const size_t bufferSize = static_cast<size_t>(w * h);
 
-    glm::ivec2 upperUpdatingRectBound = glm::ivec2(0, 0);
-    glm::ivec2 lowerUpdatingRectBound = glm::ivec2(w, h);
-
     if (_needsRepaint || _browserBuffer.size() != bufferSize) {
         _browserBufferSize = glm::ivec2(w, h);
         _browserBuffer.resize(w * h, Pixel(0));
         _textureSizeIsDirty = true;
-        _upperDirtyRectBound = upperUpdatingRectBound = glm::ivec2(w, h);
-        _lowerDirtyRectBound = lowerUpdatingRectBound = glm::ivec2(0, 0);
     }
 
     for (const CefRect& r : dirtyRects) {
-        lowerUpdatingRectBound = glm::min(lowerUpdatingRectBound, glm::ivec2(r.x, r.y));
-        upperUpdatingRectBound = glm::max(
-            upperUpdatingRectBound,
-            glm::ivec2(r.x + r.width, r.y + r.height)
+        const glm::ivec2 lower = glm::clamp(
+            glm::ivec2(r.x, r.y),
+            glm::ivec2(0),
+            glm::ivec2(w, h)
+        );
+        const glm::ivec2 upper = glm::clamp(
+            glm::ivec2(r.x + r.width, r.y + r.height),
+            glm::ivec2(0),
+            glm::ivec2(w, h)
         );
+        const int rectWidth = upper.x - lower.x;
+        if (rectWidth <= 0 || upper.y <= lower.y) {
+            continue;
+        }
 
-    }
+        // Copy the updated rectangle line by line
+        for (int y = lower.y; y < upper.y; y++) {
+            const int lineOffset = y * w + lower.x;
+            // Chromium stores image upside down compared to OpenGL, so we flip it:
+            const int invLineOffset = (h - y - 1) * w + lower.x;
+            std::copy(
+                reinterpret_cast<const Pixel*>(buffer) + lineOffset,
+                reinterpret_cast<const Pixel*>(buffer) + lineOffset + rectWidth,
+                _browserBuffer.data() + invLineOffset
+            );
+        }
 
-    const glm::ivec2 rectSize = upperUpdatingRectBound - lowerUpdatingRectBound;
-    if (rectSize.x > 0 && rectSize.y > 0) {
+        // Store the rectangle in the flipped coordinates of the texture
+        _dirtyRects.emplace_back(lower.x, h - upper.y, rectWidth, upper.y - lower.y);
         _textureIsDirty = true;
     }
-    else {
-        return;
-    }
 
-    // Copy the updated rectangle line by line.
-    for (int y = lowerUpdatingRectBound.y; y < upperUpdatingRectBound.y; ++y) {
-        const int lineOffset = y * w + lowerUpdatingRectBound.x;
-        // Chromium stores image upside down compared to OpenGL, so we flip it:
-        const int invLineOffset = (h - y - 1) * w + lowerUpdatingRectBound.x;
-        const int rectWidth = upperUpdatingRectBound.x - lowerUpdatingRectBound.x;
-        std::copy(
-            reinterpret_cast<const Pixel*>(buffer) + lineOffset,
-            reinterpret_cast<const Pixel*>(buffer) + lineOffset + rectWidth,
-            _browserBuffer.data() + invLineOffset
-        );
+    if (_dirtyRects.size() > MaxDirtyRects) {
+        // Uploading many small rectangles is slower than a single upload of their
+        // bounding box, so we collapse them
+        glm::ivec2 lower = glm::ivec2(w, h);
+        glm::ivec2 upper = glm::ivec2(0);
+        for (const glm::ivec4& r : _dirtyRects) {
+            lower = glm::min(lower, glm::ivec2(r.x, r.y));
+            upper = glm::max(upper, glm::ivec2(r.x + r.z, r.y + r.w));
+        }
+        _dirtyRects.clear();
+        _dirtyRects.emplace_back(lower, upper - lower);
     }
 
-    // Add the dirty rect bounds to the GPU texture dirty rect.
-    _lowerDirtyRectBound = glm::min(lowerUpdatingRectBound, _lowerDirtyRectBound);
-    _upperDirtyRectBound = glm::max(upperUpdatingRectBound, _upperDirtyRectBound);
     _needsRepaint = false;
 }
 
@@ -200,31 +214,31 @@ void WebRenderHandler::updateTexture() {
         glBindTexture(GL_TEXTURE_2D, 0);
     }
     else if (_textureIsDirty) {
+        // Only upload the regions that CEF reported as changed since the last upload
         glBindTexture(GL_TEXTURE_2D, _texture);
         glPixelStorei(GL_UNPACK_ROW_LENGTH, _browserBufferSize.x);
 
-        glTexSubImage2D(
-            GL_TEXTURE_2D,
-            0,
-            _lowerDirtyRectBound.x,
-            _browserBufferSize.y - _upperDirtyRectBound.y,
-            _upperDirtyRectBound.x - _lowerDirtyRectBound.x,
-            _upperDirtyRectBound.y - _lowerDirtyRectBound.y,
-            GL_BGRA_EXT,
-            GL_UNSIGNED_BYTE,
-            reinterpret_cast<char*>(
-                _browserBuffer.data() +
-                (_browserBufferSize.y - _upperDirtyRectBound.y) *
-                _browserBufferSize.x + _lowerDirtyRectBound.x
-            )
-        );
+        for (const glm::ivec4& r : _dirtyRects) {
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                r.x,
+                r.y,
+                r.z,
+                r.w,
+                GL_BGRA_EXT,
+                GL_UNSIGNED_BYTE,
+                reinterpret_cast<char*>(
+                    _browserBuffer.data() + r.y * _browserBufferSize.x + r.x
+                )
+            );
+        }
 
         glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
-    _upperDirtyRectBound = glm::ivec2(0, 0);
-    _lowerDirtyRectBound = glm::ivec2(_browserBufferSize.x, _browserBufferSize.y);
+    _dirtyRects.clear();
     _textureSizeIsDirty = false;
     _textureIsDirty = false;
 }
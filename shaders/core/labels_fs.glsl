@@ -0,0 +1,55 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "fragment.glsl"
+
+in float depth;
+in vec2 vs_texCoords;
+in vec2 vs_outlineTexCoords;
+
+uniform sampler2D fontTexture;
+uniform vec4 color;
+uniform vec4 outlineColor;
+uniform bool hasOutline;
+
+Fragment getFragment() {
+  Fragment frag;
+
+  float inside = texture(fontTexture, vs_texCoords).r;
+  if (hasOutline) {
+    float outline = texture(fontTexture, vs_outlineTexCoords).r;
+    vec4 blend = mix(outlineColor, color, inside);
+    frag.color = vec4(blend.rgb, blend.a * max(inside, outline));
+  }
+  else {
+    frag.color = vec4(color.rgb, color.a * inside);
+  }
+
+  if (frag.color.a < 0.001) {
+    discard;
+  }
+
+  frag.depth = depth;
+  return frag;
+}
@@ -0,0 +1,86 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#version __CONTEXT__
+
+layout(location = 0) in vec3 in_anchor;
+// Lower left and upper right corner of the glyph relative to the start of the label
+layout(location = 1) in vec4 in_glyphRect;
+layout(location = 2) in vec4 in_texCoordRect;
+layout(location = 3) in vec4 in_outlineTexCoordRect;
+
+out float depth;
+out vec2 vs_texCoords;
+out vec2 vs_outlineTexCoords;
+
+uniform mat4 modelViewProjection;
+uniform vec3 orthoRight;
+uniform vec3 orthoUp;
+uniform vec3 cameraPosition;
+uniform vec3 cameraLookUp;
+uniform int renderOption;
+uniform float scale;
+uniform float fontHeight;
+uniform vec2 minMaxSize;
+uniform vec2 viewportSize;
+
+const int RenderOptionPositionNormal = 1;
+
+void main() {
+  vec3 right = orthoRight;
+  vec3 up = orthoUp;
+  if (renderOption == RenderOptionPositionNormal) {
+    vec3 normal = normalize(cameraPosition - in_anchor);
+    right = normalize(cross(cameraLookUp, normal));
+    up = normalize(cross(normal, right));
+  }
+
+  // Find the size of the label on screen to be able to limit it. Labels that are smaller
+  // than the minimum size are hidden, and larger ones are scaled down to the maximum
+  vec4 projectedAnchor = modelViewProjection * vec4(in_anchor, 1.0);
+  vec4 projectedTop =
+    modelViewProjection * vec4(in_anchor + up * scale * fontHeight, 1.0);
+  vec2 screenAnchor = projectedAnchor.xy / projectedAnchor.w;
+  vec2 screenTop = projectedTop.xy / projectedTop.w;
+  float pixelSize = length((screenTop - screenAnchor) * 0.5 * viewportSize);
+
+  if (projectedAnchor.w <= 0.0 || pixelSize < minMaxSize.x) {
+    // Move the vertex outside of the clip volume to discard the whole glyph
+    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+    depth = 1.0;
+    return;
+  }
+  float sizeScale = pixelSize > minMaxSize.y ? minMaxSize.y / pixelSize : 1.0;
+
+  // The vertices of the triangle strip are the corners of the glyph quad
+  vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+  vec2 offset = mix(in_glyphRect.xy, in_glyphRect.zw, corner);
+  vs_texCoords = mix(in_texCoordRect.xy, in_texCoordRect.zw, corner);
+  vs_outlineTexCoords = mix(in_outlineTexCoordRect.xy, in_outlineTexCoordRect.zw, corner);
+
+  vec3 position = in_anchor + (offset.x * right + offset.y * up) * scale * sizeScale;
+  vec4 p = modelViewProjection * vec4(position, 1.0);
+  gl_Position = p;
+  depth = p.w;
+}
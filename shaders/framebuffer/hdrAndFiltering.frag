@@ -41,6 +41,8 @@ uniform float Value;
 uniform float Lightness;
 uniform vec4 Viewport;
 uniform vec2 Resolution;
+// The fraction of the resolution that the scene has been rendered with
+uniform float RenderScale;
 
 uniform sampler2D hdrFeedingTexture;
 
@@ -56,6 +58,13 @@ void main() {
   st.x = st.x / (Resolution.x / Viewport[2]) + (Viewport[0] / Resolution.x);
   st.y = st.y / (Resolution.y / Viewport[3]) + (Viewport[1] / Resolution.y);
 
+  // The scene has been rendered into the lower left part of the feeding texture, so it
+  // is upscaled here. The coordinates are clamped so that the linear filtering does not
+  // pick up any texels outside of the rendered part
+  st *= RenderScale;
+  vec2 maxSt = ((Viewport.xy + Viewport.zw) * RenderScale - 0.5) / Resolution;
+  st = min(st, maxSt);
+
   vec4 color = texture(hdrFeedingTexture, st);
   color.rgb *= blackoutFactor;
 
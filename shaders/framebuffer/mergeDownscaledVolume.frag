@@ -31,6 +31,9 @@ uniform sampler2D downscaledRenderedVolume;
 uniform sampler2D downscaledRenderedVolumeDepth;
 uniform vec4 viewport;
 uniform vec2 resolution;
+// The part of the textures that contains the rendered volume
+uniform float colorScale = 1.0;
+uniform float depthScale = 1.0;
 
 void main() {
   // Modify the texCoord based on the Viewport and Resolution. This modification is
@@ -44,6 +47,6 @@ void main() {
   st.x = st.x / (resolution.x / viewport[2]) + (viewport[0] / resolution.x);
   st.y = st.y / (resolution.y / viewport[3]) + (viewport[1] / resolution.y);
 
-  finalColor = texture(downscaledRenderedVolume, st);
-  gl_FragDepth = texture(downscaledRenderedVolumeDepth, st).r;
+  finalColor = texture(downscaledRenderedVolume, st * colorScale);
+  gl_FragDepth = texture(downscaledRenderedVolumeDepth, st * depthScale).r;
 }
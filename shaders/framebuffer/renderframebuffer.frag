@@ -27,13 +27,30 @@
 
 #define exposure #{rendererData.hdrExposure}
 #define disableHDRPipeline #{rendererData.disableHDR}
+#define compactFormats #{rendererData.compactFormats}
 #define DeltaError 0.013f
 #define MaxValueColorBuffer 1E10
+// The largest finite value of a half precision floating point number
+#define MaxValueCompactColorBuffer 65504.0
 
 layout(location = 0) out vec4 _out_color_;
 layout(location = 1) out vec4 gPosition;
 layout(location = 2) out vec4 gNormal;
 
+// If this is true, the fragment is written to the weighted blended order-independent
+// transparency buffers of the FramebufferRenderer instead. Location 0 then contains the
+// weighted accumulation of the premultiplied color, and the red channel of location 1
+// contains the alpha that is used to compute the revealage
+uniform bool useOrderIndependentTransparency;
+
+// The weight that is used for a fragment in the order-independent transparency. This is
+// equation 10 in McGuire & Bavoil 2013, but based on the logarithm of the distance, as
+// the distances in the scene span many orders of magnitude
+float transparencyWeight(float depth, float alpha) {
+  float d = clamp(log(max(depth, 1.0)) / log(1E27), 0.0, 1.0);
+  return alpha * max(1E-2, 3E3 * pow(1.0 - d, 3.0));
+}
+
 void main() {
   Fragment f  = getFragment();
 
@@ -49,8 +66,26 @@ void main() {
   _out_color_.y = isnan(_out_color_.y) ? MaxValueColorBuffer : _out_color_.y;
   _out_color_.z = isnan(_out_color_.z) ? MaxValueColorBuffer : _out_color_.z;
 
-  gPosition = f.gPosition;
-  gNormal = f.gNormal;
+  if (useOrderIndependentTransparency) {
+    float alpha = clamp(_out_color_.a, 0.0, 1.0);
+    float weight = transparencyWeight(f.depth, alpha);
+    _out_color_ = vec4(_out_color_.rgb * alpha, alpha) * weight;
+    gPosition = vec4(alpha);
+    gNormal = vec4(0.0);
+  }
+  else {
+    if (compactFormats == 1) {
+      // Values outside of the half precision range would turn into infinities, which
+      // then produce NaNs when they are blended
+      _out_color_ = clamp(
+        _out_color_,
+        vec4(-MaxValueCompactColorBuffer),
+        vec4(MaxValueCompactColorBuffer)
+      );
+    }
+    gPosition = f.gPosition;
+    gNormal = f.gNormal;
+  }
 
   gl_FragDepth = normalizeFloat(f.depth);
 }
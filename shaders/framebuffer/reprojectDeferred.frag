@@ -0,0 +1,104 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#version __CONTEXT__
+
+in vec2 texCoord;
+layout (location = 0) out vec4 finalColor;
+
+uniform sampler2D mainPositionTexture;
+uniform sampler2D previousColorTexture;
+uniform sampler2D previousPositionTexture;
+// Transforms from the current into the previous view space
+uniform mat4 currentToPrevious;
+uniform mat4 previousProjection;
+uniform mat4 inverseProjection;
+// Selects which half of the checkerboard is reprojected in this frame
+uniform int parity;
+// The part of the textures that is rendered into
+uniform vec4 viewport;
+uniform vec2 resolution;
+
+// The G-buffer is cleared to this value where nothing has been rendered
+const float EmptyPosition = 1e30;
+// The relative difference between the reprojected and the stored position above which
+// a pixel is considered to have been occluded in the previous frame
+const float DisocclusionThreshold = 0.01;
+
+bool isEmpty(vec4 position) {
+  return position.x > EmptyPosition;
+}
+
+void main() {
+  ivec2 pixel = ivec2(gl_FragCoord.xy);
+  if ((pixel.x + pixel.y + parity) % 2 == 0) {
+    // This pixel is evaluated by the deferredcaster in this frame
+    discard;
+  }
+
+  vec4 position = texelFetch(mainPositionTexture, pixel, 0);
+  bool isBackground = isEmpty(position);
+
+  vec4 previousView;
+  if (isBackground) {
+    // Nothing has been rendered into this pixel, so only its direction is reprojected
+    vec4 view = inverseProjection * vec4(texCoord * 2.0 - 1.0, 1.0, 1.0);
+    previousView = currentToPrevious * vec4(view.xyz / view.w, 0.0);
+  }
+  else {
+    previousView = currentToPrevious * vec4(position.xyz, 1.0);
+  }
+
+  vec4 previousClip = previousProjection * previousView;
+  if (previousClip.w <= 0.0) {
+    discard;
+  }
+  vec2 previousTexCoord = previousClip.xy / previousClip.w * 0.5 + 0.5;
+  if (any(lessThan(previousTexCoord, vec2(0.0))) ||
+      any(greaterThan(previousTexCoord, vec2(1.0))))
+  {
+    // The pixel was outside the view in the previous frame
+    discard;
+  }
+
+  ivec2 previousPixel = min(
+    ivec2(viewport.xy + previousTexCoord * viewport.zw),
+    ivec2(resolution) - 1
+  );
+  vec4 previousPosition = texelFetch(previousPositionTexture, previousPixel, 0);
+  if (isEmpty(previousPosition) != isBackground) {
+    discard;
+  }
+  if (!isBackground) {
+    float difference = distance(previousView.xyz, previousPosition.xyz);
+    if (difference > DisocclusionThreshold * length(previousView.xyz)) {
+      // Something else was visible at this location in the previous frame
+      discard;
+    }
+  }
+
+  finalColor = texelFetch(previousColorTexture, previousPixel, 0);
+  // Marks the pixel as reprojected so that the deferredcaster is not evaluated for it
+  gl_FragDepth = 0.0;
+}
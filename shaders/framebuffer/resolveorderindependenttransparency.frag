@@ -0,0 +1,54 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#version __CONTEXT__
+
+layout(location = 0) out vec4 finalColor;
+
+uniform sampler2D accumulationTexture;
+uniform sampler2D revealageTexture;
+
+// Composites the weighted blended order-independent transparency buffers onto the
+// scene. See McGuire & Bavoil, "Weighted Blended Order-Independent Transparency", JCGT
+// 2013. The result is blended with (SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+
+void main() {
+  ivec2 coord = ivec2(gl_FragCoord.xy);
+
+  // The revealage is the product of (1 - alpha) of all fragments, so a value of 1 means
+  // that nothing was drawn in this pixel
+  float revealage = texelFetch(revealageTexture, coord, 0).r;
+  if (revealage >= 1.0) {
+    discard;
+  }
+
+  vec4 accumulation = texelFetch(accumulationTexture, coord, 0);
+  // Guard against an overflow of the accumulated values for very dense regions
+  if (isinf(max(max(abs(accumulation.r), abs(accumulation.g)), abs(accumulation.b)))) {
+    accumulation.rgb = vec3(accumulation.a);
+  }
+
+  vec3 averageColor = accumulation.rgb / max(accumulation.a, 1e-5);
+  finalColor = vec4(averageColor, 1.0 - revealage);
+}
@@ -1,2 +1,5 @@
 #version __CONTEXT__
+#ifdef GL_ARB_bindless_texture
+#extension GL_ARB_bindless_texture : enable
+#endif // GL_ARB_bindless_texture
 #include <#{rendererData.fragmentRendererPath}>
\ No newline at end of file
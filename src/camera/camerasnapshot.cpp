@@ -0,0 +1,76 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/camera/camerasnapshot.h>
+
+#include <openspace/camera/camera.h>
+#include <cmath>
+
+namespace openspace {
+
+CameraSnapshot::CameraSnapshot(const Camera& camera)
+    : position(camera.positionVec3())
+    , eyePosition(camera.eyePositionVec3())
+    , viewDirectionWorldSpace(camera.viewDirectionWorldSpace())
+    , lookUpVectorWorldSpace(camera.lookUpVectorWorldSpace())
+    , rotation(camera.rotationQuaternion())
+    , viewRotationMatrix(camera.viewRotationMatrix())
+    , viewScaleMatrix(camera.viewScaleMatrix())
+    , combinedViewMatrix(camera.combinedViewMatrix())
+    , sceneMatrix(camera.sgctInternal.sceneMatrix())
+    , viewMatrix(camera.sgctInternal.viewMatrix())
+    , projectionMatrix(camera.sgctInternal.projectionMatrix())
+    , viewProjectionMatrix(camera.sgctInternal.viewProjectionMatrix())
+    , combinedViewProjectionMatrix(glm::dmat4(projectionMatrix) * combinedViewMatrix)
+    , maxFov(camera.maxFov())
+    , sinMaxFov(std::sin(maxFov))
+    , cosMaxFov(std::cos(maxFov))
+    , scaling(camera.scaling())
+    , atmosphereDimmingFactor(camera.atmosphereDimmingFactor())
+    , parent(camera.parent())
+{
+    // Extract the side planes from the rows of the view-projection matrix
+    auto row = [this](int i) {
+        return glm::dvec4(
+            combinedViewProjectionMatrix[0][i],
+            combinedViewProjectionMatrix[1][i],
+            combinedViewProjectionMatrix[2][i],
+            combinedViewProjectionMatrix[3][i]
+        );
+    };
+    const glm::dvec4 row0 = row(0);
+    const glm::dvec4 row1 = row(1);
+    const glm::dvec4 row3 = row(3);
+    frustumPlanes = {
+        row3 + row0,
+        row3 - row0,
+        row3 + row1,
+        row3 - row1
+    };
+    for (glm::dvec4& plane : frustumPlanes) {
+        plane /= glm::length(glm::dvec3(plane));
+    }
+}
+
+} // namespace openspace
@@ -25,6 +25,7 @@
 #include <openspace/data/csvloader.h>
 
 #include <openspace/data/datamapping.h>
+#include <openspace/util/memorymappedfile.h>
 #include <openspace/util/progressbar.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/file.h>
@@ -35,23 +36,98 @@
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/stringhelper.h>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <sstream>
 #include <string_view>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "DataLoader: CSV";
-} // namespace
 
-namespace openspace::dataloader::csv {
+    // Files that are smaller than this are parsed on the calling thread, larger files
+    // are split into chunks of at least this size that are parsed concurrently
+    constexpr size_t MinChunkSize = 4 * 1024 * 1024;
+
+    // The role that each of the columns in the CSV file has for the dataset
+    enum class ColumnRole {
+        Data = 0,
+        Skip,
+        X,
+        Y,
+        Z,
+        Name
+    };
 
-Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> specs) {
-    ghoul_assert(std::filesystem::exists(filePath), "File must exist");
+    // Calls the function `callback` with the index and the contents of each of the
+    // fields in the `line`. Fields can be enclosed in double quotes, in which case they
+    // may contain commas and a pair of quotes represents a single quote character
+    template <typename F>
+    void forEachField(std::string_view line, std::string& scratch, F&& callback) {
+        size_t fieldIndex = 0;
+        size_t pos = 0;
+        while (true) {
+            if (pos < line.size() && line[pos] == '"') {
+                scratch.clear();
+                pos++;
+                while (pos < line.size()) {
+                    if (line[pos] == '"') {
+                        if (pos + 1 < line.size() && line[pos + 1] == '"') {
+                            scratch += '"';
+                            pos += 2;
+                            continue;
+                        }
+                        pos++;
+                        break;
+                    }
+                    scratch += line[pos];
+                    pos++;
+                }
+                // Skip everything between the closing quote and the next delimiter
+                const size_t next = line.find(',', pos);
+                callback(fieldIndex, std::string_view(scratch));
+                if (next == std::string_view::npos) {
+                    return;
+                }
+                pos = next + 1;
+            }
+            else {
+                const size_t next = line.find(',', pos);
+                const size_t end = (next == std::string_view::npos) ? line.size() : next;
+                callback(fieldIndex, line.substr(pos, end - pos));
+                if (next == std::string_view::npos) {
+                    return;
+                }
+                pos = next + 1;
+            }
+            fieldIndex++;
+        }
+    }
 
-    auto readFloatData = [](const std::string& str) -> float {
+    // Returns the line starting at `begin` without the line ending and sets `next` to
+    // the beginning of the following line
+    std::string_view nextLine(const char* begin, const char* end, const char*& next) {
+        const char* newline = std::find(begin, end, '\n');
+        next = (newline == end) ? end : newline + 1;
+        std::string_view line = std::string_view(
+            begin,
+            static_cast<size_t>(newline - begin)
+        );
+        // Guard against wrong line endings (copying files from Windows to Mac) causes
+        // lines to have a final \r
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+    float readFloatData(std::string_view str) {
         float result = 0.f;
 #ifdef WIN32
         auto [p, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
@@ -60,22 +136,151 @@ Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> s
         }
         return std::numeric_limits<float>::quiet_NaN();
 #else // ^^^^ WIN32 // !WIN32 vvvv
-        // clang is missing float support for std::from_chars
-        try {
-            result = std::stof(str, nullptr);
-            if (std::isfinite(result)) {
-                return result;
-            }
+        // clang is missing float support for std::from_chars. std::strtof requires a
+        // null-terminated string, so short values are copied to the stack first
+        std::array<char, 64> buffer;
+        std::string longValue;
+        const char* value = nullptr;
+        if (str.size() < buffer.size()) {
+            std::memcpy(buffer.data(), str.data(), str.size());
+            buffer[str.size()] = '\0';
+            value = buffer.data();
+        }
+        else {
+            longValue = std::string(str);
+            value = longValue.c_str();
         }
-        catch (const std::invalid_argument&) {}
-        return NAN;
+
+        char* end = nullptr;
+        result = std::strtof(value, &end);
+        if (end != value && std::isfinite(result)) {
+            return result;
+        }
+        return std::numeric_limits<float>::quiet_NaN();
 #endif // WIN32
+    }
+
+    struct ChunkResult {
+        openspace::dataloader::Dataset::Entries entries;
+        float maxPositionComponent = 0.f;
+        std::set<int> textureIndices;
     };
 
+    // Parses all rows between [begin, end) and converts the values directly into the
+    // columns of the dataset
+    ChunkResult parseRows(const char* begin, const char* end,
+                          const std::vector<ColumnRole>& roles, int nDataColumns,
+                          int textureColumn)
+    {
+        using namespace openspace::dataloader;
+
+        ChunkResult res;
+        res.entries.reserve(static_cast<size_t>(end - begin) / (8 * roles.size() + 1));
+
+        // The entry and the scratch buffer are reused for all rows to prevent
+        // reallocating the memory
+        Dataset::Entry entry;
+        entry.data.reserve(nDataColumns);
+        std::string scratch;
+
+        const char* lineBegin = begin;
+        while (lineBegin < end) {
+            const std::string_view line = nextLine(lineBegin, end, lineBegin);
+            if (line.empty()) {
+                continue;
+            }
+
+            entry.position = glm::vec3(0.f);
+            entry.data.clear();
+            entry.comment = std::nullopt;
+
+            forEachField(
+                line,
+                scratch,
+                [&](size_t i, std::string_view strValue) {
+                    const ColumnRole role =
+                        i < roles.size() ? roles[i] : ColumnRole::Data;
+                    if (role == ColumnRole::Skip) {
+                        return;
+                    }
+                    if (role == ColumnRole::Name) {
+                        // Note that were we use the original string value, rather than
+                        // the converted one
+                        entry.comment = std::string(strValue);
+                        return;
+                    }
+
+                    // For now, all values are converted to float
+                    const float value = readFloatData(strValue);
+                    switch (role) {
+                        case ColumnRole::X:
+                            entry.position.x = value;
+                            break;
+                        case ColumnRole::Y:
+                            entry.position.y = value;
+                            break;
+                        case ColumnRole::Z:
+                            entry.position.z = value;
+                            break;
+                        default:
+                            entry.data.push_back(value);
+                            break;
+                    }
+
+                    if (static_cast<int>(i) == textureColumn) {
+                        res.textureIndices.emplace(static_cast<int>(value));
+                    }
+                }
+            );
+
+            const glm::vec3 positive = glm::abs(entry.position);
+            const float max = glm::compMax(positive);
+            if (max > res.maxPositionComponent) {
+                res.maxPositionComponent = max;
+            }
+
+            res.entries.push_back(entry);
+        }
+
+        return res;
+    }
+} // namespace
+
+namespace openspace::dataloader::csv {
+
+Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> specs) {
+    ghoul_assert(std::filesystem::exists(filePath), "File must exist");
+
     LDEBUG("Parsing CSV file");
 
-    std::vector<std::vector<std::string>> rows = ghoul::loadCSVFile(filePath, true);
-    if (rows.size() < 2) {
+    // The file is mapped into memory and converted directly into the columns of the
+    // dataset, so we never have to hold all of its values as strings
+    const MemoryMappedFile file = MemoryMappedFile(filePath);
+    const char* fileBegin = reinterpret_cast<const char*>(file.data());
+    const char* fileEnd = fileBegin + file.size();
+
+    // First row is the column names
+    const char* dataBegin = fileBegin;
+    std::vector<std::string> columns;
+    while (columns.empty() && dataBegin < fileEnd) {
+        const std::string_view line = nextLine(dataBegin, fileEnd, dataBegin);
+        if (line.empty()) {
+            continue;
+        }
+        std::string scratch;
+        forEachField(
+            line,
+            scratch,
+            [&columns](size_t, std::string_view name) { columns.emplace_back(name); }
+        );
+    }
+
+    const bool hasRows = std::any_of(
+        dataBegin,
+        fileEnd,
+        [](char c) { return !std::isspace(static_cast<unsigned char>(c)); }
+    );
+    if (columns.empty() || !hasRows) {
         LWARNING(std::format(
             "Error loading data file '{}'. No data items read", filePath
         ));
@@ -83,10 +288,6 @@ Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> s
     }
 
     Dataset res;
-    res.entries.reserve(rows.size() - 1);
-
-    // First row is the column names
-    const std::vector<std::string>& columns = rows.front();
 
     int xColumn = -1;
     int yColumn = -1;
@@ -96,10 +297,7 @@ Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> s
 
     int nDataColumns = 0;
     const bool hasExcludeColumns = specs.has_value() && specs->hasExcludeColumns();
-    std::vector<size_t> skipColumns;
-    if (hasExcludeColumns) {
-        skipColumns.reserve((*specs).excludeColumns.size());
-    }
+    std::vector<ColumnRole> roles = std::vector<ColumnRole>(columns.size());
 
     for (size_t i = 0; i < columns.size(); i++) {
         const std::string& col = columns[i];
@@ -119,8 +317,7 @@ Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> s
             nameColumn = static_cast<int>(i);
         }
         else if (hasExcludeColumns && specs->isExcludeColumn(col)) {
-            skipColumns.push_back(i);
-            continue;
+            roles[i] = ColumnRole::Skip;
         }
         else {
             // Note that the texture column is also a regular column. Just save the index
@@ -137,6 +334,21 @@ Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> s
         }
     }
 
+    // If a column was assigned multiple roles, the position takes precedence over the
+    // name. Assigning the roles in reverse order lets the more important ones win
+    if (nameColumn >= 0) {
+        roles[nameColumn] = ColumnRole::Name;
+    }
+    if (zColumn >= 0) {
+        roles[zColumn] = ColumnRole::Z;
+    }
+    if (yColumn >= 0) {
+        roles[yColumn] = ColumnRole::Y;
+    }
+    if (xColumn >= 0) {
+        roles[xColumn] = ColumnRole::X;
+    }
+
     // Some errors / warnings
     if (specs.has_value()) {
         bool hasAllProvided = specs->checkIfAllProvidedColumnsExist(columns);
@@ -171,64 +383,51 @@ Dataset loadCsvFile(std::filesystem::path filePath, std::optional<DataMapping> s
         ));
     }
 
-    LINFO(std::format("Loading {} rows with {} columns", rows.size(), columns.size()));
-    ProgressBar progress = ProgressBar(static_cast<int>(rows.size()));
-
-    std::set<int> uniqueTextureIndicesInData;
-
-    // Skip first row (column names)
-    for (size_t rowIdx = 1; rowIdx < rows.size(); ++rowIdx) {
-        const std::vector<std::string>& row = rows[rowIdx];
-
-        Dataset::Entry entry;
-        entry.data.reserve(nDataColumns);
-
-        for (size_t i = 0; i < row.size(); i++) {
-            // Check if column should be exluded. Note that list of indices is sorted
-            // so we can do a binary search
-            if (hasExcludeColumns &&
-                std::binary_search(skipColumns.begin(), skipColumns.end(), i))
-            {
-                continue;
-            }
-
-            const std::string& strValue = row[i];
-
-            // For now, all values are converted to float
-            const float value = readFloatData(strValue);
+    // Split the rows into chunks on line boundaries that are parsed concurrently
+    const size_t size = static_cast<size_t>(fileEnd - dataBegin);
+    const size_t nThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t nChunks = std::clamp<size_t>(size / MinChunkSize, 1, nThreads);
 
-            if (i == xColumn) {
-                entry.position.x = value;
-            }
-            else if (i == yColumn) {
-                entry.position.y = value;
-            }
-            else if (i == zColumn) {
-                entry.position.z = value;
-            }
-            else if (i == nameColumn) {
-                // Note that were we use the original stirng value, rather than the
-                // converted one
-                entry.comment = strValue;
-            }
-            else {
-                entry.data.push_back(value);
-            }
-
-            if (i == textureColumn) {
-                uniqueTextureIndicesInData.emplace(static_cast<int>(value));
-            }
-        }
-
-        const glm::vec3 positive = glm::abs(entry.position);
-        const float max = glm::compMax(positive);
-        if (max > res.maxPositionComponent) {
-            res.maxPositionComponent = max;
-        }
+    std::vector<const char*> boundaries = { dataBegin };
+    for (size_t i = 1; i < nChunks; i += 1) {
+        const char* begin = std::max(dataBegin + i * size / nChunks, boundaries.back());
+        const char* newline = std::find(begin, fileEnd, '\n');
+        boundaries.push_back(newline == fileEnd ? fileEnd : newline + 1);
+    }
+    boundaries.push_back(fileEnd);
+
+    LINFO(std::format(
+        "Loading {} MB with {} columns using {} threads",
+        size / (1024 * 1024), columns.size(), nChunks
+    ));
+
+    std::vector<std::future<ChunkResult>> futures;
+    for (size_t i = 1; i < nChunks; i += 1) {
+        futures.push_back(std::async(
+            std::launch::async,
+            &parseRows,
+            boundaries[i],
+            boundaries[i + 1],
+            std::cref(roles),
+            nDataColumns,
+            textureColumn
+        ));
+    }
 
-        res.entries.push_back(entry);
+    ProgressBar progress = ProgressBar(static_cast<int>(nChunks));
+    std::set<int> uniqueTextureIndicesInData;
+    auto addChunk = [&](ChunkResult chunk) {
+        res.maxPositionComponent =
+            std::max(res.maxPositionComponent, chunk.maxPositionComponent);
+        res.entries.append(std::move(chunk.entries));
+        uniqueTextureIndicesInData.merge(chunk.textureIndices);
+    };
 
-        progress.print(static_cast<int>(rowIdx + 1));
+    addChunk(parseRows(boundaries[0], boundaries[1], roles, nDataColumns, textureColumn));
+    progress.print(1);
+    for (size_t i = 0; i < futures.size(); i++) {
+        addChunk(futures[i].get());
+        progress.print(static_cast<int>(i + 2));
     }
 
     // Load the textures. Skip textures that are not included in the dataset
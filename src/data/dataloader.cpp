@@ -26,6 +26,7 @@
 
 #include <openspace/data/csvloader.h>
 #include <openspace/data/speckloader.h>
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -34,16 +35,68 @@
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/stringhelper.h>
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <mutex>
 #include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 namespace {
-    constexpr int8_t DataCacheFileVersion = 13;
+    constexpr int8_t DataCacheFileVersion = 16;
     constexpr int8_t LabelCacheFileVersion = 11;
     constexpr int8_t ColorCacheFileVersion = 11;
 
+    // The dataset cache files are laid out so that they can be memory-mapped. A fixed
+    // size header describes where each of the sections of the file starts, and each of
+    // the sections begins at an offset that is aligned to this value, which means that
+    // the position and data columns can be accessed in place
+    constexpr uint64_t DataCacheAlignment = 16;
+
+    struct DataCacheHeader {
+        int8_t version = 0;
+        uint8_t padding0[3] = {};
+        float maxPositionComponent = 0.f;
+        uint64_t nEntries = 0;
+        uint16_t nValues = 0;
+        uint16_t nVariables = 0;
+        uint16_t nTextures = 0;
+        int16_t textureDataIndex = -1;
+        int16_t orientationDataIndex = -1;
+        uint16_t padding1[3] = {};
+
+        // Each variable and texture is stored as (int16 index, uint16 length, chars)
+        uint64_t variablesOffset = 0;
+        uint64_t texturesOffset = 0;
+        // nEntries * glm::vec3
+        uint64_t positionsOffset = 0;
+        // nValues columns of nEntries floats, each starting columnStride bytes apart
+        uint64_t valuesOffset = 0;
+        uint64_t columnStride = 0;
+        // nEntries * uint16 followed by all comments back to back
+        uint64_t commentLengthsOffset = 0;
+        uint64_t commentsOffset = 0;
+        uint64_t commentsSize = 0;
+        // nValues * Dataset::ColumnStatistics
+        uint64_t statisticsOffset = 0;
+        uint64_t fileSize = 0;
+    };
+    static_assert(sizeof(DataCacheHeader) == 112);
+    static_assert(
+        std::is_trivially_copyable_v<openspace::dataloader::Dataset::ColumnStatistics>
+    );
+    static_assert(std::is_trivially_copyable_v<DataCacheHeader>);
+
+    constexpr uint64_t alignOffset(uint64_t offset) {
+        constexpr uint64_t A = DataCacheAlignment;
+        return (offset + A - 1) / A * A;
+    }
+
     template <typename T, typename U>
     void checkSize(U value, std::string_view message) {
         if (value > std::numeric_limits<U>::max()) {
@@ -51,6 +104,75 @@ namespace {
         }
     }
 
+    // The number of independent accumulators that are used when computing the column
+    // statistics. Keeping the lanes independent lets the compiler vectorize the loop
+    constexpr size_t NLanes = 8;
+
+    openspace::dataloader::Dataset::ColumnStatistics computeColumnStatistics(
+                                                         const std::vector<float>& values)
+    {
+        using Statistics = openspace::dataloader::Dataset::ColumnStatistics;
+
+        std::array<float, NLanes> minValues;
+        minValues.fill(std::numeric_limits<float>::max());
+        std::array<float, NLanes> maxValues;
+        maxValues.fill(-std::numeric_limits<float>::max());
+        std::array<double, NLanes> sums = {};
+        std::array<uint64_t, NLanes> counts = {};
+
+        // All comparisons with NaN are false, which means that missing values are skipped
+        // by the min/max without any branches
+        const size_t nBlocks = values.size() / NLanes;
+        for (size_t b = 0; b < nBlocks; b++) {
+            const float* block = values.data() + b * NLanes;
+            for (size_t l = 0; l < NLanes; l++) {
+                const float v = block[l];
+                const bool isValid = v == v;
+                minValues[l] = v < minValues[l] ? v : minValues[l];
+                maxValues[l] = v > maxValues[l] ? v : maxValues[l];
+                sums[l] += isValid ? v : 0.0;
+                counts[l] += isValid ? 1 : 0;
+            }
+        }
+        for (size_t i = nBlocks * NLanes; i < values.size(); i++) {
+            const float v = values[i];
+            const bool isValid = v == v;
+            minValues[0] = v < minValues[0] ? v : minValues[0];
+            maxValues[0] = v > maxValues[0] ? v : maxValues[0];
+            sums[0] += isValid ? v : 0.0;
+            counts[0] += isValid ? 1 : 0;
+        }
+
+        Statistics result;
+        double sum = 0.0;
+        for (size_t l = 0; l < NLanes; l++) {
+            result.min = std::min(result.min, minValues[l]);
+            result.max = std::max(result.max, maxValues[l]);
+            sum += sums[l];
+            result.nValidValues += counts[l];
+        }
+
+        if (result.nValidValues == 0) {
+            return result;
+        }
+        result.mean = static_cast<float>(sum / result.nValidValues);
+
+        const float range = result.max - result.min;
+        const float scale = range > 0.f ? Statistics::NHistogramBins / range : 0.f;
+        for (const float v : values) {
+            if (std::isnan(v)) {
+                continue;
+            }
+            const int bin = std::min(
+                static_cast<int>((v - result.min) * scale),
+                Statistics::NHistogramBins - 1
+            );
+            result.histogram[bin]++;
+        }
+
+        return result;
+    }
+
     template <typename T>
     using LoadCacheFunc = std::function<std::optional<T>(std::filesystem::path)>;
 
@@ -144,266 +266,293 @@ Dataset loadFile(std::filesystem::path path, std::optional<DataMapping> specs) {
         ));
     }
 
+    res.computeStatistics();
     return res;
 }
 
 std::optional<Dataset> loadCachedFile(const std::filesystem::path& path) {
     ZoneScoped;
 
-    std::ifstream file = std::ifstream(path, std::ios::binary);
-    if (!file.good()) {
+    std::optional<MemoryMappedFile> mappedFile;
+    try {
+        mappedFile.emplace(path);
+    }
+    catch (const ghoul::RuntimeError&) {
         return std::nullopt;
     }
+    const std::byte* data = mappedFile->data();
+    const size_t size = mappedFile->size();
 
-    Dataset result;
-
-    int8_t fileVersion = 0;
-    file.read(reinterpret_cast<char*>(&fileVersion), sizeof(int8_t));
-    if (fileVersion != DataCacheFileVersion) {
-        // Incompatible version and we won't be able to read the file
+    if (size < sizeof(DataCacheHeader)) {
         return std::nullopt;
     }
 
-    //
-    // Read variables
-    uint16_t nVariables = 0;
-    file.read(reinterpret_cast<char*>(&nVariables), sizeof(uint16_t));
-    result.variables.resize(nVariables);
-    for (int i = 0; i < nVariables; i += 1) {
-        ZoneScopedN("Variable");
-
-        Dataset::Variable var;
-
-        int16_t idx = 0;
-        file.read(reinterpret_cast<char*>(&idx), sizeof(int16_t));
-        var.index = idx;
-
-        uint16_t len = 0;
-        file.read(reinterpret_cast<char*>(&len), sizeof(uint16_t));
-        var.name.resize(len);
-        file.read(var.name.data(), len);
-
-        result.variables[i] = std::move(var);
+    DataCacheHeader header;
+    std::memcpy(&header, data, sizeof(DataCacheHeader));
+    if (header.version != DataCacheFileVersion || header.fileSize != size) {
+        // Incompatible version or a truncated file and we won't be able to read it
+        return std::nullopt;
     }
 
-    //
-    // Read textures
-    uint16_t nTextures = 0;
-    file.read(reinterpret_cast<char*>(&nTextures), sizeof(uint16_t));
-    result.textures.resize(nTextures);
-    for (int i = 0; i < nTextures; i += 1) {
-        ZoneScopedN("Texture");
-
-        Dataset::Texture tex;
-
-        int16_t idx = 0;
-        file.read(reinterpret_cast<char*>(&idx), sizeof(int16_t));
-        tex.index = idx;
+    // Returns whether the `length` bytes starting at `offset` lie inside the file
+    auto isInFile = [size](uint64_t offset, uint64_t length) {
+        return offset <= size && length <= size - offset;
+    };
+
+    const uint64_t positionsSize = header.nEntries * sizeof(glm::vec3);
+    const uint64_t commentLengthsSize = header.nEntries * sizeof(uint16_t);
+    const uint64_t statisticsSize = header.nValues * sizeof(Dataset::ColumnStatistics);
+    if (header.columnStride < header.nEntries * sizeof(float) ||
+        !isInFile(header.positionsOffset, positionsSize) ||
+        !isInFile(header.valuesOffset, header.nValues * header.columnStride) ||
+        !isInFile(header.commentLengthsOffset, commentLengthsSize) ||
+        !isInFile(header.commentsOffset, header.commentsSize) ||
+        !isInFile(header.statisticsOffset, statisticsSize))
+    {
+        return std::nullopt;
+    }
 
-        uint16_t len = 0;
-        file.read(reinterpret_cast<char*>(&len), sizeof(uint16_t));
-        tex.file.resize(len);
-        file.read(tex.file.data(), len);
+    // Reads a list of (index, name) pairs, which is used for variables and textures
+    auto readNames = [&](uint64_t offset, uint16_t count,
+                         std::vector<std::pair<int, std::string>>& result)
+    {
+        result.reserve(count);
+        for (uint16_t i = 0; i < count; i += 1) {
+            if (!isInFile(offset, sizeof(int16_t) + sizeof(uint16_t))) {
+                return false;
+            }
+            int16_t idx = 0;
+            std::memcpy(&idx, data + offset, sizeof(int16_t));
+            uint16_t len = 0;
+            std::memcpy(&len, data + offset + sizeof(int16_t), sizeof(uint16_t));
+            offset += sizeof(int16_t) + sizeof(uint16_t);
+
+            if (!isInFile(offset, len)) {
+                return false;
+            }
+            result.emplace_back(
+                idx,
+                std::string(reinterpret_cast<const char*>(data + offset), len)
+            );
+            offset += len;
+        }
+        return true;
+    };
 
-        result.textures[i] = std::move(tex);
-    }
+    Dataset result;
 
     //
-    // Read indices
-    int16_t texDataIdx = 0;
-    file.read(reinterpret_cast<char*>(&texDataIdx), sizeof(int16_t));
-    result.textureDataIndex = texDataIdx;
+    // Read variables and textures
+    std::vector<std::pair<int, std::string>> variables;
+    if (!readNames(header.variablesOffset, header.nVariables, variables)) {
+        return std::nullopt;
+    }
+    result.variables.reserve(variables.size());
+    for (auto& [index, name] : variables) {
+        result.variables.push_back({ .index = index, .name = std::move(name) });
+    }
 
-    int16_t oriDataIdx = 0;
-    file.read(reinterpret_cast<char*>(&oriDataIdx), sizeof(int16_t));
-    result.orientationDataIndex = oriDataIdx;
+    std::vector<std::pair<int, std::string>> textures;
+    if (!readNames(header.texturesOffset, header.nTextures, textures)) {
+        return std::nullopt;
+    }
+    result.textures.reserve(textures.size());
+    for (auto& [index, file] : textures) {
+        result.textures.push_back({ .index = index, .file = std::move(file) });
+    }
 
-    //
-    // Read entries
-    uint64_t nEntries = 0;
-    file.read(reinterpret_cast<char*>(&nEntries), sizeof(uint64_t));
-    result.entries.reserve(nEntries);
-    for (uint64_t i = 0; i < nEntries; i += 1) {
-        Dataset::Entry e;
-        file.read(reinterpret_cast<char*>(&e.position.x), 3 * sizeof(float));
+    result.textureDataIndex = header.textureDataIndex;
+    result.orientationDataIndex = header.orientationDataIndex;
+    result.maxPositionComponent = header.maxPositionComponent;
 
-        // For now we just store the length of the comment. Since the comments are stored
-        // in one block after the data entries, we can use the length later to extract the
-        // contents of this entries comment out of the big block
-        uint16_t len = 0;
-        file.read(reinterpret_cast<char*>(&len), sizeof(uint16_t));
-        if (len > 0) {
-            // If there is a comment, we already allocate the space for it here. This way
-            // we don't need to separately store the length of it, but can use the size of
-            // the vector instead
-            std::string comment;
-            comment.resize(len);
-            e.comment = std::move(comment);
-        }
+    result.statistics.resize(header.nValues);
+    std::memcpy(result.statistics.data(), data + header.statisticsOffset, statisticsSize);
 
-        result.entries.push_back(std::move(e));
+    if (header.nEntries == 0) {
+        return result;
     }
 
     //
-    // Read the data values next
-    uint16_t nValues = 0;
-    file.read(reinterpret_cast<char*>(&nValues), sizeof(uint16_t));
-    std::vector<float> entriesBuffer;
-    entriesBuffer.resize(nEntries * nValues);
-    file.read(
-        reinterpret_cast<char*>(entriesBuffer.data()),
-        nEntries * nValues * sizeof(float)
+    // Copy the positions and each of the data columns in one block each
+    result.entries.resize(header.nEntries, header.nValues);
+    std::memcpy(
+        result.entries.positions().data(),
+        data + header.positionsOffset,
+        positionsSize
     );
-
-    //
-    // Read comments in one block and then assign them to the data entries
-    uint64_t totalCommentLength = 0;
-    file.read(reinterpret_cast<char*>(&totalCommentLength), sizeof(uint64_t));
-    std::vector<char> commentBuffer;
-    commentBuffer.resize(totalCommentLength);
-    file.read(commentBuffer.data(), totalCommentLength);
-
-    //
-    // Now we have the comments and the data values, we need to implant them into the
-    // data entries
-
-    // commentIdx is the running index into the total comment buffer
-    int commentIdx = 0;
-    int valuesIdx = 0;
-    for (Dataset::Entry& e : result.entries) {
-        e.data.resize(nValues);
+    for (uint16_t i = 0; i < header.nValues; i += 1) {
         std::memcpy(
-            e.data.data(),
-            entriesBuffer.data() + valuesIdx,
-            nValues * sizeof(float)
+            result.entries.column(i).data(),
+            data + header.valuesOffset + i * header.columnStride,
+            header.nEntries * sizeof(float)
         );
-        valuesIdx += nValues;
-
-        if (e.comment.has_value()) {
-            ghoul_assert(commentIdx < commentBuffer.size(), "Index too large");
+    }
 
-            // If we have a comment, we need to extract its length's worth of characters
-            // from the buffer
-            std::memcpy(e.comment->data(), &commentBuffer[commentIdx], e.comment->size());
+    //
+    // Extract the comments out of the comment block using the stored lengths
+    const std::byte* lengths = data + header.commentLengthsOffset;
+    const char* comments = reinterpret_cast<const char*>(data + header.commentsOffset);
+    uint64_t commentIdx = 0;
+    for (uint64_t i = 0; i < header.nEntries; i += 1) {
+        uint16_t len = 0;
+        std::memcpy(&len, lengths + i * sizeof(uint16_t), sizeof(uint16_t));
+        if (len == 0) {
+            continue;
+        }
 
-            // and then advance the index
-            commentIdx += static_cast<int>(e.comment->size());
+        if (commentIdx + len > header.commentsSize) {
+            // The file is corrupted
+            return std::nullopt;
         }
+        result.entries.setComment(i, std::string(comments + commentIdx, len));
+        commentIdx += len;
     }
 
-    //
-    // Read max data point variable
-    float max = 0.f;
-    file.read(reinterpret_cast<char*>(&max), sizeof(float));
-    result.maxPositionComponent = max;
-
     return result;
 }
 
 void saveCachedFile(const Dataset& dataset, const std::filesystem::path& path) {
     ZoneScoped;
 
-    std::ofstream file = std::ofstream(path, std::ofstream::binary);
+    checkSize<uint16_t>(dataset.variables.size(), "Too many variables");
+    checkSize<uint16_t>(dataset.textures.size(), "Too many textures");
+    checkSize<int16_t>(dataset.textureDataIndex, "Texture index too large");
+    checkSize<int16_t>(dataset.orientationDataIndex, "Orientation index too large");
+    checkSize<uint16_t>(dataset.entries.nValues(), "Too many data variables");
 
-    file.write(reinterpret_cast<const char*>(&DataCacheFileVersion), sizeof(int8_t));
+    const uint64_t nEntries = static_cast<uint64_t>(dataset.entries.size());
 
     //
-    // Store variables
-    checkSize<uint16_t>(dataset.variables.size(), "Too many variables");
-    uint16_t nVariables = static_cast<uint16_t>(dataset.variables.size());
-    file.write(reinterpret_cast<const char*>(&nVariables), sizeof(uint16_t));
+    // Compute the layout of the file first, so that the header can be written upfront
+    DataCacheHeader header = {};
+    header.version = DataCacheFileVersion;
+    header.maxPositionComponent = dataset.maxPositionComponent;
+    header.nEntries = nEntries;
+    header.nValues = static_cast<uint16_t>(dataset.entries.nValues());
+    header.nVariables = static_cast<uint16_t>(dataset.variables.size());
+    header.nTextures = static_cast<uint16_t>(dataset.textures.size());
+    header.textureDataIndex = static_cast<int16_t>(dataset.textureDataIndex);
+    header.orientationDataIndex = static_cast<int16_t>(dataset.orientationDataIndex);
+
+    uint64_t offset = alignOffset(sizeof(DataCacheHeader));
+    header.variablesOffset = offset;
     for (const Dataset::Variable& var : dataset.variables) {
         checkSize<int16_t>(var.index, "Variable index too large");
-        int16_t idx = static_cast<int16_t>(var.index);
-        file.write(reinterpret_cast<const char*>(&idx), sizeof(int16_t));
-
         checkSize<uint16_t>(var.name.size(), "Variable name too long");
-        uint16_t len = static_cast<uint16_t>(var.name.size());
-        file.write(reinterpret_cast<const char*>(&len), sizeof(uint16_t));
-        file.write(var.name.data(), len);
+        offset += sizeof(int16_t) + sizeof(uint16_t) + var.name.size();
     }
 
-    //
-    // Store textures
-    checkSize<uint16_t>(dataset.textures.size(), "Too many textures");
-    uint16_t nTextures = static_cast<uint16_t>(dataset.textures.size());
-    file.write(reinterpret_cast<const char*>(&nTextures), sizeof(uint16_t));
+    offset = alignOffset(offset);
+    header.texturesOffset = offset;
     for (const Dataset::Texture& tex : dataset.textures) {
         checkSize<int16_t>(tex.index, "Texture index too large");
-        int16_t idx = static_cast<int16_t>(tex.index);
-        file.write(reinterpret_cast<const char*>(&idx), sizeof(int16_t));
-
-
         checkSize<uint16_t>(tex.file.size(), "Texture file too long");
-        uint16_t len = static_cast<uint16_t>(tex.file.size());
-        file.write(reinterpret_cast<const char*>(&len), sizeof(uint16_t));
-        file.write(tex.file.data(), len);
+        offset += sizeof(int16_t) + sizeof(uint16_t) + tex.file.size();
     }
 
-    //
-    // Store indices
-    checkSize<int16_t>(dataset.textureDataIndex, "Texture index too large");
-    int16_t texIdx = static_cast<int16_t>(dataset.textureDataIndex);
-    file.write(reinterpret_cast<const char*>(&texIdx), sizeof(int16_t));
+    offset = alignOffset(offset);
+    header.positionsOffset = offset;
+    offset += nEntries * sizeof(glm::vec3);
+
+    offset = alignOffset(offset);
+    header.valuesOffset = offset;
+    header.columnStride = alignOffset(nEntries * sizeof(float));
+    offset += header.nValues * header.columnStride;
+
+    std::vector<uint16_t> commentLengths;
+    commentLengths.reserve(nEntries);
+    for (size_t i = 0; i < dataset.entries.size(); i++) {
+        const std::optional<std::string>& comment = dataset.entries.comment(i);
+        if (comment.has_value()) {
+            checkSize<uint16_t>(comment->size(), "Comment too long");
+        }
+        const uint16_t len =
+            comment.has_value() ? static_cast<uint16_t>(comment->size()) : 0;
+        commentLengths.push_back(len);
+        header.commentsSize += len;
+    }
 
-    checkSize<int16_t>(dataset.orientationDataIndex, "Orientation index too large");
-    int16_t orientationIdx = static_cast<int16_t>(dataset.orientationDataIndex);
-    file.write(reinterpret_cast<const char*>(&orientationIdx), sizeof(int16_t));
+    offset = alignOffset(offset);
+    header.commentLengthsOffset = offset;
+    offset += nEntries * sizeof(uint16_t);
 
-    //
-    // Store entries
-    checkSize<uint64_t>(dataset.entries.size(), "Too many entries");
-    uint64_t nEntries = static_cast<uint64_t>(dataset.entries.size());
-    file.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
-
-    // We assume the number of values for each dataset to be the same, so we can store
-    // them upfront
-    size_t nValuesF = dataset.entries.empty() ? 0 : dataset.entries[0].data.size();
-    checkSize<uint16_t>(nValuesF, "Too many data variables");
-    uint16_t nValues = static_cast<uint16_t>(nValuesF);
-    std::vector<float> valuesBuffer;
-    valuesBuffer.reserve(dataset.entries.size() * nValues);
-
-    uint64_t totalCommentLength = 0;
-    for (const Dataset::Entry& e : dataset.entries) {
-        file.write(reinterpret_cast<const char*>(&e.position.x), 3 * sizeof(float));
-
-        valuesBuffer.insert(valuesBuffer.end(), e.data.begin(), e.data.end());
-
-        if (e.comment.has_value()) {
-            checkSize<uint16_t>(e.comment->size(), "Comment too long");
-        }
-        uint16_t commentLen = e.comment.has_value() ?
-            static_cast<uint16_t>(e.comment->size()) :
-            0;
-        file.write(reinterpret_cast<const char*>(&commentLen), sizeof(uint16_t));
-        totalCommentLength += commentLen;
-    }
-
-    // Write all of the datavalues next
-    file.write(reinterpret_cast<const char*>(&nValues), sizeof(uint16_t));
-    file.write(
-        reinterpret_cast<const char*>(valuesBuffer.data()),
-        valuesBuffer.size() * sizeof(float)
-    );
+    offset = alignOffset(offset);
+    header.commentsOffset = offset;
+    offset += header.commentsSize;
+
+    offset = alignOffset(offset);
+    header.statisticsOffset = offset;
+    offset += header.nValues * sizeof(Dataset::ColumnStatistics);
+    header.fileSize = offset;
 
     //
-    // Write all of the comments next. We don't have to store the individual comment
-    // lengths as the data values written before already have those stored. And since we
-    // are reading the comments in the same order as the dataset entries, we're good
-    file.write(reinterpret_cast<const char*>(&totalCommentLength), sizeof(uint64_t));
-    for (const Dataset::Entry& e : dataset.entries) {
-        if (e.comment.has_value()) {
-            file.write(e.comment->data(), e.comment->size());
+    // Write the file in the order of the computed layout
+    std::ofstream file = std::ofstream(path, std::ofstream::binary);
+    uint64_t position = 0;
+    auto write = [&file, &position](const void* d, uint64_t length) {
+        file.write(reinterpret_cast<const char*>(d), length);
+        position += length;
+    };
+    auto padTo = [&file, &position](uint64_t target) {
+        ghoul_assert(
+            target >= position && target - position < DataCacheAlignment,
+            "Inconsistent file layout"
+        );
+        constexpr std::array<char, DataCacheAlignment> Zeros = {};
+        file.write(Zeros.data(), target - position);
+        position = target;
+    };
+
+    write(&header, sizeof(DataCacheHeader));
+
+    padTo(header.variablesOffset);
+    for (const Dataset::Variable& var : dataset.variables) {
+        const int16_t idx = static_cast<int16_t>(var.index);
+        const uint16_t len = static_cast<uint16_t>(var.name.size());
+        write(&idx, sizeof(int16_t));
+        write(&len, sizeof(uint16_t));
+        write(var.name.data(), len);
+    }
+
+    padTo(header.texturesOffset);
+    for (const Dataset::Texture& tex : dataset.textures) {
+        const int16_t idx = static_cast<int16_t>(tex.index);
+        const uint16_t len = static_cast<uint16_t>(tex.file.size());
+        write(&idx, sizeof(int16_t));
+        write(&len, sizeof(uint16_t));
+        write(tex.file.data(), len);
+    }
+
+    padTo(header.positionsOffset);
+    write(dataset.entries.positions().data(), nEntries * sizeof(glm::vec3));
+
+    for (uint16_t i = 0; i < header.nValues; i += 1) {
+        padTo(header.valuesOffset + i * header.columnStride);
+        write(dataset.entries.column(i).data(), nEntries * sizeof(float));
+    }
+
+    padTo(header.commentLengthsOffset);
+    write(commentLengths.data(), commentLengths.size() * sizeof(uint16_t));
+
+    padTo(header.commentsOffset);
+    for (size_t i = 0; i < dataset.entries.size(); i++) {
+        const std::optional<std::string>& comment = dataset.entries.comment(i);
+        if (comment.has_value()) {
+            write(comment->data(), comment->size());
         }
     }
 
-    //
-    // Store max data point variable
-    file.write(
-        reinterpret_cast<const char*>(&dataset.maxPositionComponent),
-        sizeof(float)
-    );
+    padTo(header.statisticsOffset);
+    for (uint16_t i = 0; i < header.nValues; i += 1) {
+        // Always store the statistics for all columns, even if they were not computed
+        const Dataset::ColumnStatistics stats =
+            i < dataset.statistics.size() ?
+            dataset.statistics[i] :
+            computeColumnStatistics(dataset.entries.column(i));
+        write(&stats, sizeof(Dataset::ColumnStatistics));
+    }
+
+    ghoul_assert(position == header.fileSize, "Inconsistent file layout");
 }
 
 Dataset loadFileWithCache(std::filesystem::path path, std::optional<DataMapping> specs) {
@@ -416,6 +565,70 @@ Dataset loadFileWithCache(std::filesystem::path path, std::optional<DataMapping>
     );
 }
 
+std::shared_ptr<const Dataset> loadSharedFile(std::filesystem::path path,
+                                              std::optional<DataMapping> specs,
+                                              bool useCache)
+{
+    ZoneScoped;
+
+    struct Slot {
+        std::weak_ptr<const Dataset> dataset;
+        // Held while the dataset is loaded so that concurrent requests for the same
+        // dataset wait for that load rather than starting their own
+        std::shared_ptr<std::mutex> loadMutex = std::make_shared<std::mutex>();
+    };
+    static std::mutex registryMutex;
+    static std::unordered_map<std::string, Slot> registry;
+
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    std::string key = std::format(
+        "{}|{}|{}",
+        ec ? path.string() : canonical.string(),
+        specs.has_value() ? generateHashString(*specs) : "",
+        useCache
+    );
+
+    std::shared_ptr<std::mutex> loadMutex;
+    {
+        std::lock_guard lock(registryMutex);
+
+        // Remove the datasets that are no longer used by anyone
+        std::erase_if(
+            registry,
+            [](const std::pair<const std::string, Slot>& p) {
+                return p.second.dataset.expired() && p.second.loadMutex.use_count() == 1;
+            }
+        );
+
+        Slot& slot = registry[key];
+        std::shared_ptr<const Dataset> dataset = slot.dataset.lock();
+        if (dataset) {
+            return dataset;
+        }
+        loadMutex = slot.loadMutex;
+    }
+
+    std::lock_guard loadLock(*loadMutex);
+
+    // Another thread might have finished loading the dataset while we were waiting
+    {
+        std::lock_guard lock(registryMutex);
+        std::shared_ptr<const Dataset> dataset = registry[key].dataset.lock();
+        if (dataset) {
+            return dataset;
+        }
+    }
+
+    std::shared_ptr<const Dataset> dataset = std::make_shared<const Dataset>(
+        useCache ? loadFileWithCache(path, specs) : loadFile(path, specs)
+    );
+
+    std::lock_guard lock(registryMutex);
+    registry[key].dataset = dataset;
+    return dataset;
+}
+
 } // namespace data
 
 namespace label {
@@ -542,7 +755,7 @@ Labelset loadFromDataset(const Dataset& dataset) {
     res.entries.reserve(dataset.entries.size());
 
     int count = 0;
-    for (const Dataset::Entry& entry : dataset.entries) {
+    for (const Dataset::EntryView entry : dataset.entries) {
         Labelset::Entry label;
         label.position = entry.position;
         label.text = entry.comment.value_or("MISSING LABEL");
@@ -698,6 +911,231 @@ ColorMap loadFileWithCache(std::filesystem::path path) {
 
 } // namespace color
 
+float Dataset::EntryView::Values::operator[](size_t index) const {
+    ghoul_assert(columns, "No columns provided");
+    ghoul_assert(index < columns->size(), "Index out of range");
+    return (*columns)[index][row];
+}
+
+size_t Dataset::EntryView::Values::size() const {
+    return columns ? columns->size() : 0;
+}
+
+bool Dataset::EntryView::Values::empty() const {
+    return size() == 0;
+}
+
+Dataset::Entries::Iterator::Iterator(const Entries* entries, size_t row)
+    : _entries(entries)
+    , _row(row)
+{}
+
+Dataset::EntryView Dataset::Entries::Iterator::operator*() const {
+    return (*_entries)[_row];
+}
+
+Dataset::Entries::Iterator& Dataset::Entries::Iterator::operator++() {
+    _row++;
+    return *this;
+}
+
+Dataset::Entries::Iterator Dataset::Entries::Iterator::operator++(int) {
+    Iterator it = *this;
+    _row++;
+    return it;
+}
+
+void Dataset::Entries::push_back(const Entry& entry) {
+    addRow(entry.position, entry.data, entry.comment);
+}
+
+void Dataset::Entries::push_back(Entry&& entry) {
+    addRow(entry.position, entry.data, std::move(entry.comment));
+}
+
+void Dataset::Entries::append(Entries&& other) {
+    if (empty()) {
+        *this = std::move(other);
+        return;
+    }
+
+    constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
+    const size_t nRows = size();
+    const size_t nOtherRows = other.size();
+    _positions.insert(_positions.end(), other._positions.begin(), other._positions.end());
+
+    const size_t nColumns = std::max(_columns.size(), other._columns.size());
+    _columns.resize(nColumns, std::vector<float>(nRows, NaN));
+    for (size_t i = 0; i < nColumns; i++) {
+        if (i < other._columns.size()) {
+            const std::vector<float>& col = other._columns[i];
+            _columns[i].insert(_columns[i].end(), col.begin(), col.end());
+        }
+        else {
+            _columns[i].resize(nRows + nOtherRows, NaN);
+        }
+    }
+
+    if (!other._comments.empty()) {
+        _comments.resize(nRows);
+        _comments.insert(
+            _comments.end(),
+            std::make_move_iterator(other._comments.begin()),
+            std::make_move_iterator(other._comments.end())
+        );
+    }
+    if (!_comments.empty()) {
+        _comments.resize(nRows + nOtherRows);
+    }
+
+    other.clear();
+}
+
+void Dataset::Entries::erase(Iterator it) {
+    ghoul_assert(it._entries == this, "Iterator belongs to a different dataset");
+    ghoul_assert(it._row < size(), "Iterator out of range");
+
+    const ptrdiff_t offset = static_cast<ptrdiff_t>(it._row);
+    _positions.erase(_positions.begin() + offset);
+    for (std::vector<float>& column : _columns) {
+        column.erase(column.begin() + offset);
+    }
+    if (it._row < _comments.size()) {
+        _comments.erase(_comments.begin() + offset);
+    }
+}
+
+void Dataset::Entries::reserve(size_t nEntries) {
+    _positions.reserve(nEntries);
+    for (std::vector<float>& column : _columns) {
+        column.reserve(nEntries);
+    }
+}
+
+void Dataset::Entries::addRow(const glm::vec3& position, const std::vector<float>& data,
+                              std::optional<std::string> comment)
+{
+    const size_t row = _positions.size();
+    _positions.push_back(position);
+
+    if (data.size() > _columns.size()) {
+        // New columns have to be backfilled for all of the previous rows
+        _columns.resize(
+            data.size(),
+            std::vector<float>(row, std::numeric_limits<float>::quiet_NaN())
+        );
+    }
+    for (size_t i = 0; i < _columns.size(); i++) {
+        const float value = i < data.size() ?
+            data[i] :
+            std::numeric_limits<float>::quiet_NaN();
+        _columns[i].push_back(value);
+    }
+
+    if (comment.has_value() || !_comments.empty()) {
+        _comments.resize(row + 1);
+        _comments[row] = std::move(comment);
+    }
+}
+
+void Dataset::Entries::clear() {
+    _positions.clear();
+    _columns.clear();
+    _comments.clear();
+}
+
+void Dataset::Entries::shrink_to_fit() {
+    _positions.shrink_to_fit();
+    for (std::vector<float>& column : _columns) {
+        column.shrink_to_fit();
+    }
+    _comments.shrink_to_fit();
+}
+
+void Dataset::Entries::resize(size_t nEntries, size_t nValues) {
+    _positions.resize(nEntries, glm::vec3(0.f));
+    _columns.resize(nValues);
+    for (std::vector<float>& column : _columns) {
+        column.resize(nEntries, std::numeric_limits<float>::quiet_NaN());
+    }
+    if (_comments.size() > nEntries) {
+        _comments.resize(nEntries);
+    }
+}
+
+size_t Dataset::Entries::size() const {
+    return _positions.size();
+}
+
+bool Dataset::Entries::empty() const {
+    return _positions.empty();
+}
+
+size_t Dataset::Entries::nValues() const {
+    return _columns.size();
+}
+
+Dataset::EntryView Dataset::Entries::operator[](size_t row) const {
+    ghoul_assert(row < size(), "Row out of range");
+    return EntryView {
+        .position = _positions[row],
+        .data = EntryView::Values {.columns = &_columns, .row = row },
+        .comment = comment(row)
+    };
+}
+
+Dataset::Entries::Iterator Dataset::Entries::begin() const {
+    return Iterator(this, 0);
+}
+
+Dataset::Entries::Iterator Dataset::Entries::end() const {
+    return Iterator(this, size());
+}
+
+const std::vector<glm::vec3>& Dataset::Entries::positions() const {
+    return _positions;
+}
+
+std::vector<glm::vec3>& Dataset::Entries::positions() {
+    return _positions;
+}
+
+const std::vector<float>& Dataset::Entries::column(size_t valueIndex) const {
+    ghoul_assert(valueIndex < _columns.size(), "Value index out of range");
+    return _columns[valueIndex];
+}
+
+std::vector<float>& Dataset::Entries::column(size_t valueIndex) {
+    ghoul_assert(valueIndex < _columns.size(), "Value index out of range");
+    return _columns[valueIndex];
+}
+
+const std::optional<std::string>& Dataset::Entries::comment(size_t row) const {
+    static const std::optional<std::string> NoComment;
+    return row < _comments.size() ? _comments[row] : NoComment;
+}
+
+void Dataset::Entries::setComment(size_t row, std::optional<std::string> comment) {
+    ghoul_assert(row < size(), "Row out of range");
+    if (!comment.has_value() && row >= _comments.size()) {
+        return;
+    }
+    if (_comments.size() < size()) {
+        _comments.resize(size());
+    }
+    _comments[row] = std::move(comment);
+}
+
+void Dataset::computeStatistics() {
+    ZoneScoped;
+
+    statistics.clear();
+    statistics.reserve(entries.nValues());
+    for (size_t i = 0; i < entries.nValues(); i++) {
+        statistics.push_back(computeColumnStatistics(entries.column(i)));
+    }
+}
+
 bool Dataset::isEmpty() const {
     return variables.empty() || entries.empty();
 }
@@ -719,23 +1157,21 @@ bool Dataset::normalizeVariable(std::string_view variableName) {
         return false;
     }
 
-    float minValue = std::numeric_limits<float>::max();
-    float maxValue = -std::numeric_limits<float>::max();
-    for (Dataset::Entry& e : entries) {
-        const float value = e.data[idx];
+    std::vector<float>& values = entries.column(idx);
+
+    const glm::vec2 range = findValueRange(idx);
+    const float minValue = range.x;
+    const float maxValue = range.y;
+    for (float& value : values) {
         if (std::isnan(value)) {
             continue;
         }
-        minValue = std::min(minValue, value);
-        maxValue = std::max(maxValue, value);
+        value = (value - minValue) / (maxValue - minValue);
     }
 
-    for (Dataset::Entry& e : entries) {
-        const float value = e.data[idx];
-        if (std::isnan(value)) {
-            continue;
-        }
-        e.data[idx] = (value - minValue) / (maxValue - minValue);
+    // Keep the statistics in sync with the modified values
+    if (static_cast<size_t>(idx) < statistics.size()) {
+        statistics[idx] = computeColumnStatistics(values);
     }
 
     return true;
@@ -747,29 +1183,16 @@ glm::vec2 Dataset::findValueRange(int variableIndex) const {
         return glm::vec2(0.f);
     }
 
-    if (variableIndex >= entries[0].data.size()) {
+    if (variableIndex < 0 || variableIndex >= static_cast<int>(entries.nValues())) {
         // The index is not a valid variable index
         return glm::vec2(0.f);
     }
 
-    float minValue = std::numeric_limits<float>::max();
-    float maxValue = -std::numeric_limits<float>::max();
-    for (const Dataset::Entry& e : entries) {
-        if (!e.data.empty()) {
-            const float value = e.data[variableIndex];
-            if (std::isnan(value)) {
-                continue;
-            }
-            minValue = std::min(value, minValue);
-            maxValue = std::max(value, maxValue);
-        }
-        else {
-            minValue = 0.f;
-            maxValue = 0.f;
-        }
-    }
-
-    return glm::vec2(minValue, maxValue);
+    const ColumnStatistics stats =
+        static_cast<size_t>(variableIndex) < statistics.size() ?
+        statistics[variableIndex] :
+        computeColumnStatistics(entries.column(variableIndex));
+    return glm::vec2(stats.min, stats.max);
 }
 
 glm::vec2 Dataset::findValueRange(std::string_view variableName) const {
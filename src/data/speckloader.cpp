@@ -31,11 +31,23 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/stringhelper.h>
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <sstream>
 #include <string_view>
+#include <thread>
+
+#ifdef WIN32
+#include <charconv>
+#endif // WIN32
 
 
 namespace {
@@ -67,311 +79,661 @@ namespace {
         }
     }
 
-} // namespace
-
-namespace openspace::dataloader::speck {
-
-Dataset loadSpeckFile(std::filesystem::path path, std::optional<DataMapping> specs) {
-    ghoul_assert(std::filesystem::exists(path), "File must exist");
+    // Files that are smaller than this are parsed on the calling thread, larger files
+    // are split into chunks of at least this size that are parsed concurrently
+    constexpr size_t MinChunkSize = 4 * 1024 * 1024;
 
-    std::ifstream file(path);
-    if (!file.good()) {
-        throw ghoul::RuntimeError(std::format("Failed to open speck file '{}'", path));
+    bool isSpace(char c) noexcept {
+        return std::isspace(static_cast<unsigned char>(c));
     }
 
-    Dataset res;
+    std::string_view strip(std::string_view line) noexcept {
+        // Same as `strip` above, but without modifying the string
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+            line.remove_prefix(1);
+        }
 
-    int nDataValues = 0;
-    int currentLineNumber = 0;
+        if (!line.empty() && line.front() == '#') {
+            line.remove_prefix(1);
+        }
 
-    std::string line;
-    // First phase: Loading the header information
-    while (ghoul::getline(file, line)) {
-        currentLineNumber++;
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+            line.remove_prefix(1);
+        }
 
-        // Guard against wrong line endings (copying files from Windows to Mac) causes
-        // lines to have a final \r
-        if (!line.empty() && line.back() == '\r') {
-            line = line.substr(0, line.length() - 1);
+        while (!line.empty() && (line.back() == ' ' || line.back() == '\t')) {
+            line.remove_suffix(1);
         }
+        return line;
+    }
 
-        // Ignore empty line or commented-out lines
-        if (line.empty() || line[0] == '#') {
-            continue;
+    // Parses a floating point number at the beginning of the range [begin, end) and
+    // returns a pointer past the last character of the number, or `nullptr` if the range
+    // does not start with a number. The accepted syntax is the same as for the stream
+    // extraction operator, that is an optional sign, digits with an optional decimal
+    // point, and an optional exponent. Leading whitespace is not skipped
+    const char* parseFloat(const char* begin, const char* end, float& value) noexcept {
+        const char* p = begin;
+        if (p != end && (*p == '+' || *p == '-')) {
+            p++;
+        }
+        bool hasDigits = false;
+        while (p != end && std::isdigit(static_cast<unsigned char>(*p))) {
+            p++;
+            hasDigits = true;
+        }
+        if (p != end && *p == '.') {
+            p++;
+            while (p != end && std::isdigit(static_cast<unsigned char>(*p))) {
+                p++;
+                hasDigits = true;
+            }
+        }
+        if (!hasDigits) {
+            return nullptr;
+        }
+        if (p != end && (*p == 'e' || *p == 'E')) {
+            p++;
+            if (p != end && (*p == '+' || *p == '-')) {
+                p++;
+            }
+            const char* exponent = p;
+            while (p != end && std::isdigit(static_cast<unsigned char>(*p))) {
+                p++;
+            }
+            if (p == exponent) {
+                return nullptr;
+            }
         }
 
-        strip(line);
+#ifdef WIN32
+        // std::from_chars does not accept a leading '+'
+        const char* first = (*begin == '+') ? begin + 1 : begin;
+        auto [ptr, ec] = std::from_chars(first, p, value);
+        if (ec != std::errc() || ptr != p) {
+            return nullptr;
+        }
+#else // ^^^ WIN32 / !WIN32 vvv
+        // clang is missing float support for std::from_chars. std::strtof requires a
+        // null-terminated string, so we have to copy the number first
+        std::array<char, 64> buffer;
+        const size_t length = static_cast<size_t>(p - begin);
+        if (length >= buffer.size()) {
+            return nullptr;
+        }
+        std::memcpy(buffer.data(), begin, length);
+        buffer[length] = '\0';
+        char* ptr = nullptr;
+        errno = 0;
+        value = std::strtof(buffer.data(), &ptr);
+        if (ptr != buffer.data() + length || (errno == ERANGE && std::isinf(value))) {
+            return nullptr;
+        }
+#endif // WIN32
+        return p;
+    }
 
-        // If the first character is a digit, we have left the preamble and are in the
-        // data section of the file
-        if (std::isdigit(line[0]) || line[0] == '-') {
-            break;
-        }
+    struct ParseError {
+        enum class Type {
+            Intermixed,
+            Position,
+            Value
+        };
+        Type type;
+        // The index of the line inside the chunk that contained the error
+        int line = 0;
+        // The index of the data value that could not be read
+        int valueIndex = 0;
+    };
+
+    struct ChunkResult {
+        openspace::dataloader::Dataset::Entries entries;
+        float maxPositionComponent = 0.f;
+        // The number of lines in this chunk
+        int nLines = 0;
+        std::optional<ParseError> error;
+    };
+
+    // Parses all lines in the data section of a SPECK file between [begin, end). This
+    // function must produce the same results as the previous stream-based parsing, so
+    // that the cache files remain the same
+    ChunkResult parseDataChunk(const char* begin, const char* end, int nDataValues,
+                          const std::optional<openspace::dataloader::DataMapping>& specs)
+    {
+        using namespace openspace::dataloader;
+
+        ChunkResult res;
+        res.entries.reserve(static_cast<size_t>(end - begin) / 64);
+
+        const std::optional<float> missingDataValue =
+            specs.has_value() ? specs->missingDataValue : std::nullopt;
+
+        // This entry is reused for all lines to prevent reallocating the data values
+        Dataset::Entry entry;
+        entry.data.resize(nDataValues);
 
+        const char* lineBegin = begin;
+        while (lineBegin < end) {
+            const char* lineEnd = std::find(lineBegin, end, '\n');
+            std::string_view line = std::string_view(
+                lineBegin,
+                static_cast<size_t>(lineEnd - lineBegin)
+            );
+            const int lineIndex = res.nLines;
+            res.nLines++;
+            lineBegin = (lineEnd == end) ? end : lineEnd + 1;
 
-        if (startsWith(line, "datavar")) {
-            // each datavar line is following the form:
-            // datavar <idx> <description>
-            // with <idx> being the index of the data variable
+            // Ignore empty line or commented-out lines
+            if (line.empty() || line.front() == '#') {
+                continue;
+            }
 
-            std::stringstream str(line);
-            std::string dummy;
-            Dataset::Variable v;
-            str >> dummy >> v.index >> v.name;
+            // Guard against wrong line endings (copying files from Windows to Mac)
+            // causes lines to have a final \r
+            if (line.back() == '\r') {
+                line.remove_suffix(1);
+            }
 
-            nDataValues += 1;
-            res.variables.push_back(v);
-            continue;
-        }
+            line = strip(line);
 
-        if (startsWith(line, "texturevar")) {
-            // each texturevar line is following the form:
-            // texturevar <idx>
-            // where <idx> is the data value index where the texture index is stored
-            if (res.textureDataIndex != -1) {
-                throw ghoul::RuntimeError(std::format(
-                    "Error loading speck file '{}': Texturevar defined twice", path
-                ));
+            if (line.empty()) {
+                continue;
             }
 
-            std::stringstream str(line);
-            std::string dummy;
-            str >> dummy >> res.textureDataIndex;
+            if (!std::isdigit(static_cast<unsigned char>(line.front())) &&
+                line.front() != '-')
+            {
+                res.error = ParseError { ParseError::Type::Intermixed, lineIndex };
+                return res;
+            }
 
-            continue;
-        }
+            const char* p = line.data();
+            const char* e = line.data() + line.size();
+            bool allZero = true;
 
-        if (startsWith(line, "polyorivar")) {
-            // each polyorivar line is following the form:
-            // texturevar <idx>
-            // where <idx> is the data value index where the orientation index storage
-            // starts. There are 6 values stored in total, xyz + uvw
+            // For SPECK we know that the first 3 values are the position
+            for (int i = 0; i < 3; i += 1) {
+                while (p != e && isSpace(*p)) {
+                    p++;
+                }
+                p = parseFloat(p, e, entry.position[i]);
+                if (!p) {
+                    break;
+                }
+            }
+            // The stream-based parser considered it an error if the line ended directly
+            // after the position
+            if (!p || p == e) {
+                res.error = ParseError { ParseError::Type::Position, lineIndex };
+                return res;
+            }
+            allZero &= (entry.position == glm::vec3(0.0));
 
-            if (res.orientationDataIndex != -1) {
-                throw ghoul::RuntimeError(std::format(
-                    "Error loading speck file '{}': Orientation index defined twice", path
-                ));
+            const glm::vec3 positive = glm::abs(entry.position);
+            const float max = glm::compMax(positive);
+            if (max > res.maxPositionComponent) {
+                res.maxPositionComponent = max;
             }
 
-            std::stringstream str(line);
-            std::string dummy;
-            str >> dummy >> res.orientationDataIndex;
-
-            // Ok.. this is kind of weird.  Speck unfortunately doesn't tell us in the
-            // specification how many values a datavar has. Usually this is 1 value per
-            // datavar, unless it is a polygon orientation thing. Now, the datavar name
-            // for these can be anything (have seen 'orientation' and 'ori' before, so we
-            // can't really check by name for these or we will miss some if they are
-            // mispelled or whatever. So we have to go the roundabout way of adding the
-            // 5 remaining values (the 6th nDataValue was already added in the
-            // corresponding 'datavar' section) here
-            nDataValues += 5;
+            for (int i = 0; i < nDataValues; i += 1) {
+                while (p != e && isSpace(*p)) {
+                    p++;
+                }
+                const char* tokenBegin = p;
+                while (p != e && !isSpace(*p)) {
+                    p++;
+                }
+                const std::string_view value = std::string_view(
+                    tokenBegin,
+                    static_cast<size_t>(p - tokenBegin)
+                );
+
+                if (value == "nan" || value == "NaN") {
+                    entry.data[i] = std::numeric_limits<float>::quiet_NaN();
+                    continue;
+                }
 
-            continue;
-        }
+                if (!parseFloat(tokenBegin, p, entry.data[i])) {
+                    res.error = ParseError { ParseError::Type::Value, lineIndex, i };
+                    return res;
+                }
 
-        if (startsWith(line, "texture")) {
-            // each texture line is following one of two forms:
-            // 1:   texture -M 1 halo.sgi
-            // 2:   texture 1 M1.sgi
-            // The parameter in #1 is currently being ignored
+                // Check if value corresponds to a missing value
+                if (missingDataValue.has_value()) {
+                    const float diff = std::abs(entry.data[i] - *missingDataValue);
+                    if (diff < std::numeric_limits<float>::epsilon()) {
+                        entry.data[i] = std::numeric_limits<float>::quiet_NaN();
+                    }
+                }
 
-            std::vector<std::string> tokens = ghoul::tokenizeString(line, ' ');
-            int nNonEmptyTokens = static_cast<int>(std::count_if(
-                tokens.begin(),
-                tokens.end(),
-                [](const std::string& t) { return !t.empty(); }
-            ));
+                allZero &= (entry.data[i] == 0.0);
+            }
 
-            if (nNonEmptyTokens > 4) {
-                throw ghoul::RuntimeError(std::format(
-                    "Error loading speck file {}: Too many arguments for texture on line "
-                    "{}",
-                    path, currentLineNumber
-                ));
+            if (allZero) {
+                continue;
             }
 
-            bool hasExtraParameter = nNonEmptyTokens > 3;
+            entry.comment = std::nullopt;
+            if (p != e) {
+                entry.comment = std::string(p, e);
+                strip(*entry.comment);
+            }
 
-            std::stringstream str(line);
+            res.entries.push_back(entry);
+        }
 
-            std::string dummy;
-            str >> dummy;
-            if (hasExtraParameter) {
-                str >> dummy;
+        return res;
+    }
+
+    struct Header {
+        int nDataValues = 0;
+        // The number of lines that were read while reading the header
+        int nLines = 0;
+        // The position of the first line of the data section, which we need to rewind the
+        // file to once the header has been read
+        std::optional<std::streampos> dataStart;
+        // The last line that was read. If we didn't find the beginning of the data
+        // section, this line is treated as data, which is what the previous parser did
+        std::string lastLine;
+    };
+
+    // Reads the header of the SPECK \p file into the variables and textures of \p res
+    Header readHeader(std::ifstream& file, const std::filesystem::path& path,
+                      openspace::dataloader::Dataset& res)
+    {
+        using namespace openspace::dataloader;
+
+        int nDataValues = 0;
+        int currentLineNumber = 0;
+
+        std::string line;
+        std::optional<std::streampos> dataStart;
+        for (std::streampos lineStart = file.tellg();
+             ghoul::getline(file, line);
+             lineStart = file.tellg())
+        {
+            currentLineNumber++;
+
+            // Guard against wrong line endings (copying files from Windows to Mac) causes
+            // lines to have a final \r
+            if (!line.empty() && line.back() == '\r') {
+                line = line.substr(0, line.length() - 1);
+            }
+
+            // Ignore empty line or commented-out lines
+            if (line.empty() || line[0] == '#') {
+                continue;
             }
 
-            Dataset::Texture texture;
-            str >> texture.index >> texture.file;
+            strip(line);
+
+            // If the first character is a digit, we have left the preamble and are in the
+            // data section of the file
+            if (std::isdigit(line[0]) || line[0] == '-') {
+                dataStart = lineStart;
+                break;
+            }
 
-            for (const Dataset::Texture& t : res.textures) {
-                if (t.index == texture.index) {
+
+            if (startsWith(line, "datavar")) {
+                // each datavar line is following the form:
+                // datavar <idx> <description>
+                // with <idx> being the index of the data variable
+
+                std::stringstream str(line);
+                std::string dummy;
+                Dataset::Variable v;
+                str >> dummy >> v.index >> v.name;
+
+                nDataValues += 1;
+                res.variables.push_back(v);
+                continue;
+            }
+
+            if (startsWith(line, "texturevar")) {
+                // each texturevar line is following the form:
+                // texturevar <idx>
+                // where <idx> is the data value index where the texture index is stored
+                if (res.textureDataIndex != -1) {
                     throw ghoul::RuntimeError(std::format(
-                        "Error loading speck file '{}': Texture index '{}' defined twice",
-                        path, texture.index
+                        "Error loading speck file '{}': Texturevar defined twice", path
                     ));
                 }
-            }
 
-            res.textures.push_back(texture);
-            continue;
-        }
+                std::stringstream str(line);
+                std::string dummy;
+                str >> dummy >> res.textureDataIndex;
 
-        if (startsWith(line, "maxcomment")) {
-            // ignoring this comment as we don't need it
-            continue;
-        }
+                continue;
+            }
 
-        // If we get this far, we had an illegal header as it wasn't an empty line and
-        // didn't start with either '#' denoting a comment line, and didn't start with
-        // either the 'datavar', 'texturevar', 'polyorivar', or 'texture' keywords
-        throw ghoul::RuntimeError(std::format(
-            "Error in line {} while reading the header information of file '{}'. Line is "
-            "neither a comment line, nor starts with one of the supported keywords for "
-            "SPECK files",
-            currentLineNumber, path
-        ));
-    }
+            if (startsWith(line, "polyorivar")) {
+                // each polyorivar line is following the form:
+                // texturevar <idx>
+                // where <idx> is the data value index where the orientation index storage
+                // starts. There are 6 values stored in total, xyz + uvw
 
-    std::sort(
-        res.variables.begin(), res.variables.end(),
-        [](const Dataset::Variable& lhs, const Dataset::Variable& rhs) {
-            return lhs.index < rhs.index;
-        }
-    );
+                if (res.orientationDataIndex != -1) {
+                    throw ghoul::RuntimeError(std::format(
+                        "Error loading speck file '{}': Orientation index defined twice",
+                        path
+                    ));
+                }
 
-    std::sort(
-        res.textures.begin(), res.textures.end(),
-        [](const Dataset::Texture& lhs, const Dataset::Texture& rhs) {
-            return lhs.index < rhs.index;
-        }
-    );
+                std::stringstream str(line);
+                std::string dummy;
+                str >> dummy >> res.orientationDataIndex;
+
+                // Ok.. this is kind of weird.  Speck unfortunately doesn't tell us in
+                // the specification how many values a datavar has. Usually this is 1
+                // value per datavar, unless it is a polygon orientation thing. Now, the
+                // datavar name for these can be anything (have seen 'orientation' and
+                // 'ori' before, so we can't really check by name for these or we will
+                // miss some if they are mispelled or whatever. So we have to go the
+                // roundabout way of adding the 5 remaining values (the 6th nDataValue was
+                // already added in the corresponding 'datavar' section) here
+                nDataValues += 5;
+
+                continue;
+            }
 
-    // For the first line, we already loaded it and rejected it above, so if we do another
-    // ghoul::getline, we'd miss the first data value line
-    bool isFirst = true;
-    while (isFirst || ghoul::getline(file, line)) {
-        currentLineNumber++;
-        isFirst = false;
+            if (startsWith(line, "texture")) {
+                // each texture line is following one of two forms:
+                // 1:   texture -M 1 halo.sgi
+                // 2:   texture 1 M1.sgi
+                // The parameter in #1 is currently being ignored
+
+                std::vector<std::string> tokens = ghoul::tokenizeString(line, ' ');
+                int nNonEmptyTokens = static_cast<int>(std::count_if(
+                    tokens.begin(),
+                    tokens.end(),
+                    [](const std::string& t) { return !t.empty(); }
+                ));
 
-        // Ignore empty line or commented-out lines
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
+                if (nNonEmptyTokens > 4) {
+                    throw ghoul::RuntimeError(std::format(
+                        "Error loading speck file {}: Too many arguments for texture on "
+                        "line {}",
+                        path, currentLineNumber
+                    ));
+                }
 
-        // Guard against wrong line endings (copying files from Windows to Mac) causes
-        // lines to have a final \r
-        if (line.back() == '\r') {
-            line = line.substr(0, line.length() - 1);
-        }
+                bool hasExtraParameter = nNonEmptyTokens > 3;
 
-        strip(line);
+                std::stringstream str(line);
 
-        if (line.empty()) {
-            continue;
-        }
+                std::string dummy;
+                str >> dummy;
+                if (hasExtraParameter) {
+                    str >> dummy;
+                }
 
-        // If the first character is a digit, we have left the preamble and are in the
-        // data section of the file
-        if (!std::isdigit(line[0]) && line[0] != '-') {
-            throw ghoul::RuntimeError(std::format(
-                "Error loading speck file '{}': Header information and datasegment "
-                "intermixed", path
-            ));
-        }
+                Dataset::Texture texture;
+                str >> texture.index >> texture.file;
 
-        bool allZero = true;
+                for (const Dataset::Texture& t : res.textures) {
+                    if (t.index == texture.index) {
+                        throw ghoul::RuntimeError(std::format(
+                            "Error loading speck file '{}': Texture index '{}' defined "
+                            "twice",
+                            path, texture.index
+                        ));
+                    }
+                }
 
-        // For SPECK we know that the first 3 values are the position, so no need to
-        // check agains data mapping
-        std::stringstream str(line);
-        Dataset::Entry entry;
-        str >> entry.position.x >> entry.position.y >> entry.position.z;
-        allZero &= (entry.position == glm::vec3(0.0));
+                res.textures.push_back(texture);
+                continue;
+            }
 
-        const glm::vec3 positive = glm::abs(entry.position);
-        const float max = glm::compMax(positive);
-        if (max > res.maxPositionComponent) {
-            res.maxPositionComponent = max;
-        }
+            if (startsWith(line, "maxcomment")) {
+                // ignoring this comment as we don't need it
+                continue;
+            }
 
-        if (!str.good()) {
-            // Need to subtract one of the line number here as we increase the current
-            // line count in the beginning of the while loop we are currently in
+            // If we get this far, we had an illegal header as it wasn't an empty line and
+            // didn't start with either '#' denoting a comment line, and didn't start with
+            // either the 'datavar', 'texturevar', 'polyorivar', or 'texture' keywords
             throw ghoul::RuntimeError(std::format(
-                "Error loading position information out of data line {} in file '{}'. "
-                "Value was not a number",
-                currentLineNumber - 1, path
+                "Error in line {} while reading the header information of file '{}'. "
+                "Line is neither a comment line, nor starts with one of the supported "
+                "keywords for SPECK files",
+                currentLineNumber, path
             ));
         }
 
-        entry.data.resize(nDataValues);
-        std::stringstream valueStream;
-        for (int i = 0; i < nDataValues; i += 1) {
-            std::string value;
-            str >> value;
-            if (value == "nan" || value == "NaN") {
-                entry.data[i] = std::numeric_limits<float>::quiet_NaN();
+        std::sort(
+            res.variables.begin(), res.variables.end(),
+            [](const Dataset::Variable& lhs, const Dataset::Variable& rhs) {
+                return lhs.index < rhs.index;
             }
-            else {
-                valueStream.clear();
-                valueStream.str(value);
-                valueStream >> entry.data[i];
+        );
 
-                // Check if value corresponds to a missing value
-                if (specs.has_value() && specs->missingDataValue.has_value()) {
-                    const float missingDataValue = specs->missingDataValue.value();
-                    const float diff = std::abs(entry.data[i] - missingDataValue);
-                    if (diff < std::numeric_limits<float>::epsilon()) {
-                        entry.data[i] = std::numeric_limits<float>::quiet_NaN();
-                    }
-                }
-
-                allZero &= (entry.data[i] == 0.0);
-                if (valueStream.fail()) {
-                    // Need to subtract one of the line number here as we increase the
-                    // current line count in the beginning of the while loop we are
-                    // currently in
-                    throw ghoul::RuntimeError(std::format(
-                        "Error loading data value {} out of data line {} in file '{}'. "
-                        "Value was not a number",
-                        i, currentLineNumber - 1, path
-                    ));
-                }
+        std::sort(
+            res.textures.begin(), res.textures.end(),
+            [](const Dataset::Texture& lhs, const Dataset::Texture& rhs) {
+                return lhs.index < rhs.index;
             }
-        }
+        );
 
-        if (allZero) {
-            continue;
+        return { nDataValues, currentLineNumber, dataStart, std::move(line) };
+    }
+
+    [[noreturn]] void throwParseError(const ParseError& error, int lineNumber,
+                                      const std::filesystem::path& path)
+    {
+        switch (error.type) {
+            case ParseError::Type::Intermixed:
+                throw ghoul::RuntimeError(std::format(
+                    "Error loading speck file '{}': Header information and "
+                    "datasegment intermixed", path
+                ));
+            case ParseError::Type::Position:
+                throw ghoul::RuntimeError(std::format(
+                    "Error loading position information out of data line {} in file "
+                    "'{}'. Value was not a number",
+                    lineNumber, path
+                ));
+            case ParseError::Type::Value:
+                throw ghoul::RuntimeError(std::format(
+                    "Error loading data value {} out of data line {} in file '{}'. "
+                    "Value was not a number",
+                    error.valueIndex, lineNumber, path
+                ));
         }
+        throw ghoul::MissingCaseException();
+    }
 
-        std::string rest;
-        ghoul::getline(str, rest);
-        if (!rest.empty()) {
+} // namespace
+
+namespace openspace::dataloader::speck {
+
+Dataset loadSpeckFile(std::filesystem::path path, std::optional<DataMapping> specs) {
+    ghoul_assert(std::filesystem::exists(path), "File must exist");
+
+    std::ifstream file(path);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(std::format("Failed to open speck file '{}'", path));
+    }
+
+    Dataset res;
+
+    // First phase: Loading the header information
+    const Header header = readHeader(file, path, res);
+
+    // Second phase: Loading the data section. The entire data section is read into
+    // memory at once and then split into chunks on line boundaries that are parsed
+    // concurrently
+    std::string buffer;
+    if (header.dataStart.has_value()) {
+        file.clear();
+        file.seekg(0, std::ios::end);
+        const std::streamoff size = file.tellg() - *header.dataStart;
+        file.seekg(*header.dataStart);
+        buffer.resize(static_cast<size_t>(size));
+        file.read(buffer.data(), size);
+        buffer.resize(static_cast<size_t>(file.gcount()));
+    }
+    else {
+        // If we didn't find the beginning of the data section, the last line that was
+        // read is treated as data, which is what the previous parser did
+        buffer = header.lastLine;
+    }
+
+    const size_t nThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t nChunks = std::clamp<size_t>(buffer.size() / MinChunkSize, 1, nThreads);
 
-            strip(rest);
-            entry.comment = rest;
+    std::vector<const char*> boundaries = { buffer.data() };
+    for (size_t i = 1; i < nChunks; i += 1) {
+        const char* begin = buffer.data() + i * buffer.size() / nChunks;
+        begin = std::max(begin, boundaries.back());
+        const char* end = buffer.data() + buffer.size();
+        const char* newline = std::find(begin, end, '\n');
+        boundaries.push_back(newline == end ? end : newline + 1);
+    }
+    boundaries.push_back(buffer.data() + buffer.size());
+
+    std::vector<std::future<ChunkResult>> futures;
+    for (size_t i = 1; i < nChunks; i += 1) {
+        futures.push_back(std::async(
+            std::launch::async,
+            &parseDataChunk,
+            boundaries[i],
+            boundaries[i + 1],
+            header.nDataValues,
+            std::cref(specs)
+        ));
+    }
+    std::vector<ChunkResult> results;
+    results.reserve(nChunks);
+    results.push_back(
+        parseDataChunk(boundaries[0], boundaries[1], header.nDataValues, specs)
+    );
+    for (std::future<ChunkResult>& future : futures) {
+        results.push_back(future.get());
+    }
+
+    // Combine the chunks in order. If any of them failed, the first failure is the one
+    // that would have been reported when parsing the file line by line
+    int lineOffset = header.nLines;
+    for (ChunkResult& result : results) {
+        if (result.error.has_value()) {
+            const int lineNumber = lineOffset + result.error->line;
+            throwParseError(*result.error, lineNumber, path);
         }
 
-        res.entries.push_back(std::move(entry));
+        lineOffset += result.nLines;
+        res.maxPositionComponent =
+            std::max(res.maxPositionComponent, result.maxPositionComponent);
+        res.entries.append(std::move(result.entries));
     }
 
 #ifdef _DEBUG
     if (!res.entries.empty()) {
-        size_t nValues = res.entries[0].data.size();
-        ghoul_assert(nDataValues == nValues, "nDataValues calculation went wrong");
-        for (const Dataset::Entry& e : res.entries) {
-            ghoul_assert(
-                e.data.size() == nDataValues,
-                "Row had different number of data values"
-            );
-        }
+        size_t nValues = res.entries.nValues();
+        ghoul_assert(header.nDataValues == nValues, "nDataValues calculation went wrong");
     }
 #endif
 
     return res;
 }
 
+void streamSpeckFile(std::filesystem::path path, std::optional<DataMapping> specs,
+                     size_t chunkSize,
+                     const std::function<bool(const Dataset&, size_t)>& onHeader,
+                     const std::function<bool(Dataset::Entries)>& onChunk)
+{
+    ghoul_assert(std::filesystem::exists(path), "File must exist");
+    ghoul_assert(chunkSize > 0, "Chunk size must be positive");
+
+    std::ifstream file(path);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(std::format("Failed to open speck file '{}'", path));
+    }
+
+    Dataset res;
+    const Header header = readHeader(file, path, res);
+
+    if (!header.dataStart.has_value()) {
+        // Same as in `loadSpeckFile`, the last line that was read is treated as data
+        if (!onHeader(res, 1)) {
+            return;
+        }
+        const std::string& line = header.lastLine;
+        ChunkResult result = parseDataChunk(
+            line.data(),
+            line.data() + line.size(),
+            header.nDataValues,
+            specs
+        );
+        if (result.error.has_value()) {
+            throwParseError(*result.error, header.nLines + result.error->line, path);
+        }
+        onChunk(std::move(result.entries));
+        return;
+    }
+
+    // Count the lines in the data section without parsing them, which gives an upper
+    // bound for the number of points in the file
+    file.clear();
+    file.seekg(*header.dataStart);
+    size_t nLines = 0;
+    bool endsWithNewline = true;
+    std::vector<char> block(64 * 1024);
+    const std::streamsize blockSize = static_cast<std::streamsize>(block.size());
+    while (file.read(block.data(), blockSize) || file.gcount() > 0) {
+        const std::streamsize nRead = file.gcount();
+        const char* end = block.data() + nRead;
+        nLines += static_cast<size_t>(std::count(block.data(), end, '\n'));
+        endsWithNewline = block[nRead - 1] == '\n';
+    }
+    if (!endsWithNewline) {
+        nLines += 1;
+    }
+
+    if (!onHeader(res, nLines)) {
+        return;
+    }
+
+    file.clear();
+    file.seekg(*header.dataStart);
+
+    // Only a single chunk of the data section is kept in memory at any point
+    int lineOffset = header.nLines;
+    std::string buffer;
+    std::string line;
+    bool isAtEnd = false;
+    while (!isAtEnd) {
+        buffer.clear();
+        for (size_t i = 0; i < chunkSize; i += 1) {
+            if (!ghoul::getline(file, line)) {
+                isAtEnd = true;
+                break;
+            }
+            buffer.append(line);
+            buffer.push_back('\n');
+        }
+        if (buffer.empty()) {
+            break;
+        }
+
+        ChunkResult result = parseDataChunk(
+            buffer.data(),
+            buffer.data() + buffer.size(),
+            header.nDataValues,
+            specs
+        );
+        if (result.error.has_value()) {
+            throwParseError(*result.error, lineOffset + result.error->line, path);
+        }
+        lineOffset += result.nLines;
+
+        if (!onChunk(std::move(result.entries))) {
+            return;
+        }
+    }
+}
+
+
 Labelset loadLabelFile(std::filesystem::path path) {
     ghoul_assert(std::filesystem::exists(path), "File must exist");
 
@@ -25,12 +25,48 @@
 #include <openspace/documentation/documentation.h>
 
 #include <openspace/documentation/verifier.h>
+#include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/defer.h>
+#include <ghoul/misc/dictionaryluaformatter.h>
 #include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
 #include <set>
+#include <unordered_set>
 
 namespace {
 
+constexpr std::string_view _loggerCat = "Documentation";
+
+// The dictionaries that have passed a test without warnings, identified by the hash of
+// their contents and of the Documentation they were tested against
+struct VerificationSnapshot {
+    std::atomic_bool isEnabled = false;
+
+    std::mutex mutex;
+    std::filesystem::path file;
+    std::string version;
+    /// The dictionaries that passed in a previous run
+    std::unordered_set<uint64_t> previous;
+    /// The dictionaries that passed in this run, which are the ones that are stored
+    std::unordered_set<uint64_t> current;
+};
+VerificationSnapshot Snapshot;
+
+// The number of tests that are currently running on this thread. Only the outermost
+// test is looked up in the snapshot, as it covers all nested tables
+thread_local int VerificationDepth = 0;
+
+uint64_t snapshotHash(const openspace::documentation::Documentation& documentation,
+                      const ghoul::Dictionary& dictionary)
+{
+    return std::hash<std::string>{}(std::format(
+        "{}|{}|{}", documentation.id, documentation.name, ghoul::formatLua(dictionary)
+    ));
+}
+
 // Structure used to make offenses unique
 struct OffenseCompare {
     using Offense = openspace::documentation::TestResult::Offense;
@@ -195,14 +231,16 @@ DocumentationEntry::DocumentationEntry(std::string k, Verifier* v, Optional opt,
                          std::move(doc))
 {}
 
-TestResult testSpecification(const Documentation& documentation,
-                             const ghoul::Dictionary& dictionary)
+namespace {
+
+TestResult verifyDictionary(const std::vector<DocumentationEntry>& entries,
+                            const ghoul::Dictionary& dictionary)
 {
     TestResult result;
     result.success = true;
 
-    auto applyVerifier = [dictionary, &result](const Verifier& verifier,
-                                               const std::string& key)
+    auto applyVerifier = [&dictionary, &result](const Verifier& verifier,
+                                                const std::string& key)
     {
         TestResult res = verifier(dictionary, key);
         if (!res.success) {
@@ -220,7 +258,7 @@ TestResult testSpecification(const Documentation& documentation,
         );
     };
 
-    for (const auto& p : documentation.entries) {
+    for (const DocumentationEntry& p : entries) {
         if (p.key == DocumentationEntry::Wildcard) {
             for (const std::string_view key : dictionary.keys()) {
                 applyVerifier(*(p.verifier), std::string(key));
@@ -246,23 +284,64 @@ TestResult testSpecification(const Documentation& documentation,
 
     // Remove duplicate offenders that might occur if multiple rules apply to a single
     // key and more than one of these rules are broken
-    const std::set<TestResult::Offense, OffenseCompare> uniqueOffenders(
-        result.offenses.begin(), result.offenses.end()
-    );
-    result.offenses = std::vector<TestResult::Offense>(
-        uniqueOffenders.begin(), uniqueOffenders.end()
-    );
+    if (result.offenses.size() > 1) {
+        const std::set<TestResult::Offense, OffenseCompare> uniqueOffenders(
+            result.offenses.begin(), result.offenses.end()
+        );
+        result.offenses = std::vector<TestResult::Offense>(
+            uniqueOffenders.begin(), uniqueOffenders.end()
+        );
+    }
     // Remove duplicate warnings. This should normally not happen, but we want to be sure
-    const std::set<TestResult::Warning, WarningCompare> uniqueWarnings(
-        result.warnings.begin(), result.warnings.end()
-    );
-    result.warnings = std::vector<TestResult::Warning>(
-        uniqueWarnings.begin(), uniqueWarnings.end()
-    );
+    if (result.warnings.size() > 1) {
+        const std::set<TestResult::Warning, WarningCompare> uniqueWarnings(
+            result.warnings.begin(), result.warnings.end()
+        );
+        result.warnings = std::vector<TestResult::Warning>(
+            uniqueWarnings.begin(), uniqueWarnings.end()
+        );
+    }
+
+    return result;
+}
+
+} // namespace
+
+TestResult testSpecification(const Documentation& documentation,
+                             const ghoul::Dictionary& dictionary)
+{
+    if (!Snapshot.isEnabled || VerificationDepth > 0) {
+        return verifyDictionary(documentation.entries, dictionary);
+    }
+
+    const uint64_t hash = snapshotHash(documentation, dictionary);
+    {
+        std::lock_guard lock(Snapshot.mutex);
+        if (Snapshot.previous.contains(hash)) {
+            Snapshot.current.insert(hash);
+            TestResult result;
+            result.success = true;
+            return result;
+        }
+    }
+
+    VerificationDepth++;
+    defer { VerificationDepth--; };
+    TestResult result = verifyDictionary(documentation.entries, dictionary);
 
+    if (result.success && result.warnings.empty()) {
+        std::lock_guard lock(Snapshot.mutex);
+        Snapshot.current.insert(hash);
+    }
     return result;
 }
 
+TestResult testSpecification(const std::vector<DocumentationEntry>& entries,
+                             const ghoul::Dictionary& dictionary)
+{
+    return verifyDictionary(entries, dictionary);
+}
+
 void testSpecificationAndThrow(const Documentation& documentation,
                                const ghoul::Dictionary& dictionary, std::string component)
 {
@@ -273,4 +352,72 @@ void testSpecificationAndThrow(const Documentation& documentation,
     }
 }
 
+void loadVerificationSnapshot(std::filesystem::path file, std::string version) {
+    std::lock_guard lock(Snapshot.mutex);
+    Snapshot.previous.clear();
+    Snapshot.current.clear();
+
+    std::ifstream stream(file, std::ios::binary);
+    if (stream) {
+        uint32_t versionLength = 0;
+        stream.read(reinterpret_cast<char*>(&versionLength), sizeof(uint32_t));
+        std::string fileVersion(versionLength, '\0');
+        stream.read(fileVersion.data(), versionLength);
+
+        uint64_t nHashes = 0;
+        stream.read(reinterpret_cast<char*>(&nHashes), sizeof(uint64_t));
+
+        if (stream && fileVersion == version) {
+            std::vector<uint64_t> hashes(nHashes);
+            stream.read(
+                reinterpret_cast<char*>(hashes.data()),
+                nHashes * sizeof(uint64_t)
+            );
+            if (stream) {
+                Snapshot.previous.insert(hashes.begin(), hashes.end());
+                LDEBUG(std::format(
+                    "Loaded {} verified dictionaries from '{}'", nHashes, file
+                ));
+            }
+        }
+        else {
+            LDEBUG(std::format("Ignoring outdated verification snapshot '{}'", file));
+        }
+    }
+
+    Snapshot.file = std::move(file);
+    Snapshot.version = std::move(version);
+    Snapshot.isEnabled = true;
+}
+
+void saveVerificationSnapshot() {
+    if (!Snapshot.isEnabled) {
+        return;
+    }
+
+    std::lock_guard lock(Snapshot.mutex);
+    std::ofstream stream(Snapshot.file, std::ios::binary);
+    if (!stream) {
+        LWARNING(std::format(
+            "Could not write verification snapshot '{}'", Snapshot.file
+        ));
+        return;
+    }
+
+    const uint32_t versionLength = static_cast<uint32_t>(Snapshot.version.size());
+    stream.write(reinterpret_cast<const char*>(&versionLength), sizeof(uint32_t));
+    stream.write(Snapshot.version.data(), versionLength);
+
+    const std::vector<uint64_t> hashes = std::vector<uint64_t>(
+        Snapshot.current.begin(),
+        Snapshot.current.end()
+    );
+    const uint64_t nHashes = hashes.size();
+    stream.write(reinterpret_cast<const char*>(&nHashes), sizeof(uint64_t));
+    stream.write(
+        reinterpret_cast<const char*>(hashes.data()),
+        nHashes * sizeof(uint64_t)
+    );
+}
+
 } // namespace openspace::documentation
@@ -444,14 +444,19 @@ nlohmann::json DocumentationEngine::generateLicenseListJson() const {
 
 nlohmann::json DocumentationEngine::generateEventJson() const {
     using Type = events::Event::Type;
-    const std::unordered_map<Type, std::vector<EventEngine::ActionInfo>>& eventActions =
-        global::eventEngine->eventActions();
+    const EventEngine::EventActions& eventActions = global::eventEngine->eventActions();
     nlohmann::json events;
 
     nlohmann::json data = nlohmann::json::array();
 
     // Group actions by events
-    for (const auto& [eventType, actions] : eventActions) {
+    for (size_t i = 0; i < eventActions.size(); i++) {
+        const std::vector<EventEngine::ActionInfo>& actions = eventActions[i];
+        if (actions.empty()) {
+            continue;
+        }
+        const Type eventType = static_cast<Type>(i);
+
         nlohmann::json eventJson;
 
         eventJson[NameKey] = std::string(events::toString(eventType));
@@ -702,22 +707,20 @@ void DocumentationEngine::addDocumentation(Documentation documentation) {
         _documentations.push_back(std::move(documentation));
     }
     else {
-        auto it = std::find_if(
-            _documentations.begin(),
-            _documentations.end(),
-            [documentation](const Documentation& d) { return documentation.id == d.id; }
-        );
-
-        if (it != _documentations.end()) {
+        if (_documentationIndices.contains(documentation.id)) {
             throw DuplicateDocumentationException(std::move(documentation));
         }
-        else {
-            _documentations.push_back(std::move(documentation));
-        }
+        _documentationIndices[documentation.id] = _documentations.size();
+        _documentations.push_back(std::move(documentation));
     }
 }
 
-std::vector<Documentation> DocumentationEngine::documentations() const {
+const std::vector<Documentation>& DocumentationEngine::documentations() const {
     return _documentations;
 }
+
+const Documentation* DocumentationEngine::documentation(std::string_view id) const {
+    const auto it = _documentationIndices.find(id);
+    return it != _documentationIndices.end() ? &_documentations[it->second] : nullptr;
+}
 } // namespace openspace::documentation
@@ -633,8 +633,7 @@ TestResult TableVerifier::operator()(const ghoul::Dictionary& dictionary,
 {
     if (dictionary.hasValue<Type>(key)) {
         const ghoul::Dictionary d = dictionary.value<ghoul::Dictionary>(key);
-        const Documentation doc = { .entries = documentations };
-        TestResult res = testSpecification(doc, d);
+        TestResult res = testSpecification(documentations, d);
 
         // Add the 'key' as a prefix to make the new offender a fully qualified identifer
         for (TestResult::Offense& o : res.offenses) {
@@ -730,15 +729,8 @@ TestResult ReferencingVerifier::operator()(const ghoul::Dictionary& dictionary,
 {
     TestResult res = TableVerifier::operator()(dictionary, key);
     if (res.success) {
-        std::vector<Documentation> docs = DocEng.documentations();
-
-        auto it = std::find_if(
-            docs.begin(),
-            docs.end(),
-            [this](const Documentation& doc) { return doc.id == identifier; }
-        );
-
-        if (it == docs.end()) {
+        const Documentation* doc = DocEng.documentation(identifier);
+        if (!doc) {
             res.success = false;
             TestResult::Offense o = {
                 .offender = key,
@@ -749,7 +741,7 @@ TestResult ReferencingVerifier::operator()(const ghoul::Dictionary& dictionary,
         }
 
         const ghoul::Dictionary d = dictionary.value<ghoul::Dictionary>(key);
-        TestResult r = testSpecification(*it, d);
+        TestResult r = testSpecification(*doc, d);
 
         // Add the 'key' as a prefix to make the offender a fully qualified identifer
         for (TestResult::Offense& s : r.offenses) {
@@ -789,22 +781,16 @@ OrVerifier::OrVerifier(
 TestResult OrVerifier::operator()(const ghoul::Dictionary& dictionary,
                                   const std::string& key) const
 {
-    std::vector<TestResult> res(values.size());
-    std::transform(
+    // The results of the individual verifiers are not reported, so we can stop at the
+    // first one that succeeds
+    const bool success = std::any_of(
         values.cbegin(),
         values.cend(),
-        res.begin(),
-        [dictionary, key](const std::shared_ptr<Verifier>& v) {
-            return v->operator()(dictionary, key);
+        [&dictionary, &key](const std::shared_ptr<Verifier>& v) {
+            return v->operator()(dictionary, key).success;
         }
     );
 
-    const bool success = std::any_of(
-        res.cbegin(),
-        res.cend(),
-        std::mem_fn(&TestResult::success)
-    );
-
     if (success) {
         TestResult r = {
             .success = true
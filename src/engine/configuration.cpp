@@ -165,6 +165,14 @@ namespace {
         // should be retained. This value defaults to 'false'
         std::optional<bool> perProfileCache;
 
+        // If this is set to 'true', the dictionaries that passed their specification
+        // test are remembered in the cache directory, and they are not tested again on
+        // the next startup of the same version of OpenSpace unless they have changed.
+        // This speeds up restarting large profiles, but verifiers that check the
+        // existence of files are not reevaluated for unchanged dictionaries. This value
+        // defaults to 'false'
+        std::optional<bool> verificationSnapshot;
+
         // The method for scaling the onscreen text in the window. As the resolution of
         // the rendering can be different from the size of the window, the onscreen text
         // can either be scaled according to the window size ('window'), or the rendering
@@ -298,6 +306,12 @@ namespace {
         // debugging support
         std::optional<bool> useMultithreadedInitialization;
 
+        // If this value is set to 'true', the synchronization data that is sent to the
+        // nodes of a cluster only contains the state that changed since the previous
+        // frame, with a full keyframe being sent in regular intervals. This value has to
+        // be the same on all nodes and defaults to 'false'
+        std::optional<bool> useDeltaSynchronization;
+
         // If this value is set to 'true', the launcher will not be shown and OpenSpace
         // will start with the provided configuration options directly. Useful in
         // multiprojector setups where a launcher window would be undesired
@@ -422,7 +436,9 @@ ghoul::Dictionary Configuration::createDictionary() {
     res.setValue("sandboxedLua", sandboxedLua);
     res.setValue("OnScreenTextScaling", onScreenTextScaling);
     res.setValue("UsePerProfileCache", usePerProfileCache);
+    res.setValue("UseVerificationSnapshot", useVerificationSnapshot);
     res.setValue("IsRenderingOnMasterDisabled", isRenderingOnMasterDisabled);
+    res.setValue("UseDeltaSynchronization", useDeltaSynchronization);
     res.setValue("GlobalRotation", static_cast<glm::dvec3>(globalRotation));
     res.setValue("ScreenSpaceRotation", static_cast<glm::dvec3>(screenSpaceRotation));
     res.setValue("MasterRotation", static_cast<glm::dvec3>(masterRotation));
@@ -579,8 +595,12 @@ void parseLuaState(Configuration& configuration) {
     c.sandboxedLua = p.sandboxedLua.value_or(c.sandboxedLua);
     c.onScreenTextScaling = p.onScreenTextScaling.value_or(c.onScreenTextScaling);
     c.usePerProfileCache = p.perProfileCache.value_or(c.usePerProfileCache);
+    c.useVerificationSnapshot =
+        p.verificationSnapshot.value_or(c.useVerificationSnapshot);
     c.isRenderingOnMasterDisabled =
         p.disableRenderingOnMaster.value_or(c.isRenderingOnMasterDisabled);
+    c.useDeltaSynchronization =
+        p.useDeltaSynchronization.value_or(c.useDeltaSynchronization);
     c.globalRotation = p.globalRotation.value_or(c.globalRotation);
     c.masterRotation = p.masterRotation.value_or(c.masterRotation);
     c.screenSpaceRotation = p.screenSpaceRotation.value_or(c.screenSpaceRotation);
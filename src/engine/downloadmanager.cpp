@@ -40,15 +40,67 @@
 namespace {
     constexpr std::string_view _loggerCat = "DownloadManager";
 
+    // Extension of the file into which a download is written until it has finished
+    constexpr std::string_view PartialExtension = ".download";
+
     struct ProgressInformation {
         std::shared_ptr<openspace::DownloadManager::FileFuture> future;
         std::chrono::system_clock::time_point startTime;
         const openspace::DownloadManager::DownloadProgressCallback* callback;
+        /// The number of bytes that were already present when resuming a download
+        curl_off_t resumeOffset = 0;
+        const std::atomic_bool* shouldStop = nullptr;
+    };
+
+    struct WriteTarget {
+        FILE* fp = nullptr;
+        CURL* curl = nullptr;
+        std::filesystem::path path;
+        bool isResuming = false;
+        bool hasCheckedResponse = false;
     };
 
-    size_t writeData(void* ptr, size_t size, size_t nmemb, FILE* stream) {
-        const size_t written = fwrite(ptr, size, nmemb, stream);
-        return written;
+    FILE* openFile(const std::filesystem::path& path, const char* mode) {
+        errno = 0;
+        const std::string f = path.string();
+#ifdef WIN32
+        FILE* fp = nullptr;
+        const errno_t error = fopen_s(&fp, f.c_str(), mode);
+        if (error != 0) {
+            return nullptr;
+        }
+        return fp;
+#else
+        return fopen(f.c_str(), mode);
+#endif // WIN32
+    }
+
+    size_t writeData(void* ptr, size_t size, size_t nmemb, WriteTarget* target) {
+        if (target->isResuming && !target->hasCheckedResponse) {
+            // A server that does not support range requests answers with the entire
+            // file, in which case the partial data on disk has to be discarded
+            long code = 0;
+            curl_easy_getinfo(target->curl, CURLINFO_RESPONSE_CODE, &code);
+            if (code != 206) {
+                fclose(target->fp);
+                target->fp = openFile(target->path, "wb");
+                target->isResuming = false;
+                if (!target->fp) {
+                    return 0;
+                }
+            }
+            target->hasCheckedResponse = true;
+        }
+
+        const size_t written = fwrite(ptr, size, nmemb, target->fp);
+        return written * size;
+    }
+
+    std::string hostFromUrl(std::string_view url) {
+        const size_t schemeEnd = url.find("://");
+        const size_t begin = schemeEnd == std::string_view::npos ? 0 : schemeEnd + 3;
+        const size_t end = url.find_first_of("/?#", begin);
+        return std::string(url.substr(begin, end - begin));
     }
 
     size_t writeMemoryCallback(void* contents, size_t size, size_t nmemb, void* userp) {
@@ -67,22 +119,53 @@ namespace {
         return realsize;
     }
 
-    int xferinfo(void* p, curl_off_t dltotal, curl_off_t dlnow, curl_off_t, curl_off_t) {
-        if (dltotal == 0) {
-            return 0;
+    size_t headerCallback(char* buffer, size_t size, size_t nitems, void* userp) {
+        const size_t realsize = size * nitems;
+        auto* mem = static_cast<openspace::DownloadManager::MemoryFile*>(userp);
+
+        const std::string_view line = std::string_view(buffer, realsize);
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            return realsize;
         }
 
+        const std::string name = ghoul::toLowerCase(std::string(line.substr(0, colon)));
+        std::string_view value = line.substr(colon + 1);
+        const size_t begin = value.find_first_not_of(" \t\r\n");
+        const size_t end = value.find_last_not_of(" \t\r\n");
+        value = begin == std::string_view::npos ?
+            std::string_view() :
+            value.substr(begin, end - begin + 1);
+
+        // If the request was redirected, the headers of the last response are kept
+        if (name == "etag") {
+            mem->etag = std::string(value);
+        }
+        else if (name == "last-modified") {
+            mem->lastModified = std::string(value);
+        }
+        return realsize;
+    }
+
+    int xferinfo(void* p, curl_off_t dltotal, curl_off_t dlnow, curl_off_t, curl_off_t) {
         ghoul_assert(p, "Passed progress information is nullptr");
         ProgressInformation* i = static_cast<ProgressInformation*>(p);
         ghoul_assert(i, "Passed pointer is not a ProgressInformation");
         ghoul_assert(i && i->future, "FileFuture is not initialized");
         ghoul_assert(i && i->callback, "Callback pointer is nullptr");
 
-        if (i->future->abortDownload) {
+        if (i->future->abortDownload || (i->shouldStop && *i->shouldStop)) {
             i->future->isAborted = true;
             return 1;
         }
 
+        if (dltotal == 0) {
+            return 0;
+        }
+
+        dltotal += i->resumeOffset;
+        dlnow += i->resumeOffset;
+
         i->future->currentSize = dlnow;
         i->future->totalSize = dltotal;
         i->future->progress = static_cast<float>(dlnow) / static_cast<float>(dltotal);
@@ -116,10 +199,45 @@ DownloadManager::FileFuture::FileFuture(std::filesystem::path file)
     : filePath(std::move(file))
 {}
 
-DownloadManager::DownloadManager(UseMultipleThreads useMultipleThreads)
+DownloadManager::DownloadManager(UseMultipleThreads useMultipleThreads,
+                                 int maxConnections, int maxConnectionsPerHost)
     : _useMultithreadedDownload(useMultipleThreads)
+    , _maxConnectionsPerHost(maxConnectionsPerHost)
 {
+    ghoul_assert(maxConnections > 0, "Need at least one connection");
+    ghoul_assert(maxConnectionsPerHost > 0, "Need at least one connection per host");
+
     curl_global_init(CURL_GLOBAL_ALL);
+
+    if (_useMultithreadedDownload) {
+        _workers.reserve(maxConnections);
+        for (int i = 0; i < maxConnections; i++) {
+            std::thread& t = _workers.emplace_back([this]() { workerLoop(); });
+            ghoul::thread::setPriority(
+                t,
+                ghoul::thread::ThreadPriorityClass::Idle,
+                ghoul::thread::ThreadPriorityLevel::Lowest
+            );
+        }
+    }
+}
+
+DownloadManager::~DownloadManager() {
+    {
+        const std::lock_guard lock(_mutex);
+        _shouldStop = true;
+    }
+    _condition.notify_all();
+    for (std::thread& t : _workers) {
+        t.join();
+    }
+
+    // Downloads that were never started are marked as aborted. Their partial files, if
+    // any, stay on disk so that the download can be resumed the next time
+    for (const Job& job : _queue) {
+        job.future->isAborted = true;
+        job.future->errorMessage = "Download manager was shut down";
+    }
 }
 
 std::shared_ptr<DownloadManager::FileFuture> DownloadManager::downloadFile(
@@ -129,111 +247,232 @@ std::shared_ptr<DownloadManager::FileFuture> DownloadManager::downloadFile(
                                                                   FailOnError failOnError,
                                                                 unsigned int timeout_secs,
                                                 DownloadFinishedCallback finishedCallback,
-                                          DownloadProgressCallback progressCallback) const
+                                                DownloadProgressCallback progressCallback,
+                                                                        Priority priority)
 {
     if (!overrideFile && std::filesystem::is_regular_file(file)) {
         return nullptr;
     }
 
-    auto future = std::make_shared<FileFuture>(file.filename());
-    errno = 0;
-#ifdef WIN32
-    FILE* fp;
-    const std::string f = file.string();
-    errno_t error = fopen_s(&fp, f.c_str(), "wb");
-    if (error != 0) {
-        LERROR(std::format(
-            "Could not open/create file: {}. Errno: {}", file, errno
-        ));
-    }
-#else
-    const std::string f = file.string();
-    FILE* fp = fopen(f.c_str(), "wb"); // write binary
-#endif // WIN32
-    if (!fp) {
-        LERROR(std::format(
-            "Could not open/create file: {}. Errno: {}", file, errno
-        ));
-    }
+    Job job = {
+        .url = url,
+        .host = hostFromUrl(url),
+        .file = file,
+        .failOnError = failOnError,
+        .timeout = timeout_secs,
+        .finishedCallback = std::move(finishedCallback),
+        .progressCallback = std::move(progressCallback),
+        .future = std::make_shared<FileFuture>(file.filename()),
+        .priority = priority,
+        .sequence = 0
+    };
+    std::shared_ptr<FileFuture> future = job.future;
 
-    auto downloadFunction = [url, failOnError, timeout_secs,
-                             finishedCb = std::move(finishedCallback),
-                             progressCb = std::move(progressCallback), future, fp]()
-    {
+    if (_useMultithreadedDownload) {
+        {
+            const std::lock_guard lock(_mutex);
+            job.sequence = _nextSequence++;
+            _queue.push_back(std::move(job));
+        }
+        _condition.notify_one();
+    }
+    else {
         CURL* curl = curl_easy_init();
         if (curl) {
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
-            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeData);
-            if (timeout_secs) {
-                curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_secs);
-            }
-            if (failOnError) {
-                curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
-            }
-
-            ProgressInformation p = {
-                .future = future,
-                .startTime = std::chrono::system_clock::now(),
-                .callback = &progressCb
-            };
-            #if LIBCURL_VERSION_NUM >= 0x072000
-            // xferinfo was introduced in 7.32.0, if a lower curl version is used the
-            // progress will not be shown for downloads on the splash screen
-            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, xferinfo);
-            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &p);
-            #endif
-            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
-
-            const CURLcode res = curl_easy_perform(curl);
+            performDownload(curl, job);
             curl_easy_cleanup(curl);
-            fclose(fp);
+        }
+    }
 
-            if (res == CURLE_OK) {
-                future->isFinished = true;
-            }
-            else {
-                long rescode = 0;
-                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &rescode);
-                future->errorMessage = std::format(
-                    "{}. HTTP code: {}", curl_easy_strerror(res), rescode
-                );
+    return future;
+}
+
+void DownloadManager::workerLoop() {
+    // Each worker keeps its own handle for its entire lifetime. cURL keeps the
+    // connections of a handle alive between transfers, so consecutive downloads from
+    // the same host reuse the connection instead of opening a new socket each time
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        LERROR("Error initializing cURL");
+        return;
+    }
+
+    while (true) {
+        std::optional<Job> job;
+        {
+            std::unique_lock lock(_mutex);
+            _condition.wait(lock, [this, &job]() {
+                if (_shouldStop) {
+                    return true;
+                }
+                job = popNextJob();
+                return job.has_value();
+            });
+            if (_shouldStop) {
+                break;
             }
+            _activeConnectionsPerHost[job->host]++;
+        }
+
+        performDownload(curl, *job);
 
-            if (finishedCb) {
-                finishedCb(*future);
+        {
+            const std::lock_guard lock(_mutex);
+            auto it = _activeConnectionsPerHost.find(job->host);
+            it->second--;
+            if (it->second == 0) {
+                _activeConnectionsPerHost.erase(it);
             }
         }
-    };
+        // A job that was blocked by the per-host limit might be able to start now
+        _condition.notify_all();
+    }
 
-    if (_useMultithreadedDownload) {
-        std::thread t = std::thread(downloadFunction);
-        ghoul::thread::setPriority(
-            t,
-            ghoul::thread::ThreadPriorityClass::Idle,
-            ghoul::thread::ThreadPriorityLevel::Lowest
+    curl_easy_cleanup(curl);
+}
+
+std::optional<DownloadManager::Job> DownloadManager::popNextJob() {
+    auto best = _queue.end();
+    for (auto it = _queue.begin(); it != _queue.end(); it++) {
+        auto active = _activeConnectionsPerHost.find(it->host);
+        if (active != _activeConnectionsPerHost.end() &&
+            active->second >= _maxConnectionsPerHost)
+        {
+            continue;
+        }
+
+        if (best == _queue.end() || it->priority > best->priority ||
+            (it->priority == best->priority && it->sequence < best->sequence))
+        {
+            best = it;
+        }
+    }
+
+    if (best == _queue.end()) {
+        return std::nullopt;
+    }
+
+    Job job = std::move(*best);
+    _queue.erase(best);
+    return job;
+}
+
+void DownloadManager::performDownload(void* handle, Job& job) const {
+    CURL* curl = reinterpret_cast<CURL*>(handle);
+    FileFuture& future = *job.future;
+
+    std::filesystem::path partial = job.file;
+    partial += PartialExtension;
+
+    curl_off_t resumeOffset = 0;
+    if (std::filesystem::is_regular_file(partial)) {
+        resumeOffset = static_cast<curl_off_t>(std::filesystem::file_size(partial));
+    }
+
+    WriteTarget target = {
+        .fp = openFile(partial, resumeOffset > 0 ? "ab" : "wb"),
+        .curl = curl,
+        .path = partial,
+        .isResuming = resumeOffset > 0,
+        .hasCheckedResponse = false
+    };
+    if (!target.fp) {
+        future.errorMessage = std::format(
+            "Could not open/create file: {}. Errno: {}", partial, errno
         );
+        LERROR(future.errorMessage);
+        if (job.finishedCallback) {
+            job.finishedCallback(future);
+        }
+        return;
+    }
 
-        t.detach();
+    // Resetting the handle keeps its connection cache intact
+    curl_easy_reset(curl);
+    curl_easy_setopt(curl, CURLOPT_URL, job.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &target);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeData);
+    if (resumeOffset > 0) {
+        curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, resumeOffset);
+    }
+    if (job.timeout) {
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, job.timeout);
+    }
+    if (job.failOnError) {
+        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+    }
+
+    ProgressInformation p = {
+        .future = job.future,
+        .startTime = std::chrono::system_clock::now(),
+        .callback = &job.progressCallback,
+        .resumeOffset = resumeOffset,
+        .shouldStop = &_shouldStop
+    };
+    #if LIBCURL_VERSION_NUM >= 0x072000
+    // xferinfo was introduced in 7.32.0, if a lower curl version is used the
+    // progress will not be shown for downloads on the splash screen
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, xferinfo);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &p);
+    #endif
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+
+    CURLcode res = curl_easy_perform(curl);
+    long rescode = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &rescode);
+    if (target.fp) {
+        fclose(target.fp);
+    }
+
+    if (res != CURLE_OK && resumeOffset > 0 && rescode == 416) {
+        // The partial file does not match the file on the server anymore, so we start
+        // over with a complete download
+        std::filesystem::remove(partial);
+        performDownload(handle, job);
+        return;
+    }
+
+    if (res == CURLE_OK) {
+        std::error_code ec;
+        std::filesystem::rename(partial, job.file, ec);
+        if (ec) {
+            future.errorMessage = std::format(
+                "Could not move downloaded file to {}: {}", job.file, ec.message()
+            );
+        }
+        else {
+            future.isFinished = true;
+        }
     }
     else {
-        downloadFunction();
+        future.errorMessage = std::format(
+            "{}. HTTP code: {}", curl_easy_strerror(res), rescode
+        );
+        if (rescode >= 400) {
+            // The server responded with an error, so there is nothing to resume from
+            std::filesystem::remove(partial);
+        }
     }
 
-    return future;
+    if (job.finishedCallback) {
+        job.finishedCallback(future);
+    }
 }
 
 std::future<DownloadManager::MemoryFile> DownloadManager::fetchFile(
                                                                    const std::string& url,
                                                           SuccessCallback successCallback,
-                                                              ErrorCallback errorCallback)
+                                                              ErrorCallback errorCallback,
+                                                         std::vector<std::string> headers)
 {
     LDEBUG(std::format("Start downloading file '{}' into memory", url));
 
     auto downloadFunction = [url, successCb = std::move(successCallback),
-                             errorCb = std::move(errorCallback)]()
+                             errorCb = std::move(errorCallback),
+                             headers = std::move(headers)]()
     {
         DownloadManager::MemoryFile file;
         file.buffer = reinterpret_cast<char*>(malloc(1));
@@ -250,28 +489,45 @@ std::future<DownloadManager::MemoryFile> DownloadManager::fetchFile(
         curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
         curl_easy_setopt(curl, CURLOPT_WRITEDATA, reinterpret_cast<void*>(&file));
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeMemoryCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, reinterpret_cast<void*>(&file));
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
         curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
 
+        curl_slist* headerList = nullptr;
+        for (const std::string& header : headers) {
+            headerList = curl_slist_append(headerList, header.c_str());
+        }
+        if (headerList) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
+        }
+
         // Will fail when response status is 400 or above
         curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
 
         CURLcode res = curl_easy_perform(curl);
+        curl_slist_free_all(headerList);
         if (res == CURLE_OK) {
+            long code = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+            file.isNotModified = code == 304;
+
             // ask for the content-type
             char* ct = nullptr;
             res = curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &ct);
-            if (res == CURLE_OK) {
+            if (res == CURLE_OK && ct) {
                 std::string extension = std::string(ct);
                 std::stringstream ss(extension);
                 ghoul::getline(ss, extension ,'/');
                 ghoul::getline(ss, extension);
                 file.format = extension;
             }
-            else {
+            else if (!file.isNotModified) {
                 LWARNING("Could not get extension from file downloaded from: " + url);
             }
-            successCb(file);
+            if (successCb) {
+                successCb(file);
+            }
             curl_easy_cleanup(curl);
             return file;
         }
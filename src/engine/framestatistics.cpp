@@ -0,0 +1,163 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/engine/framestatistics.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/engine/windowdelegate.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/format.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+
+namespace {
+    constexpr std::string_view _loggerCat = "FrameStatistics";
+
+    // Weight of the newest frame in the smoothed average
+    constexpr double AverageWeight = 0.05;
+
+    constexpr openspace::properties::Property::PropertyInfo LogToFileInfo = {
+        "LogToFile",
+        "Log to File",
+        "If this value is enabled, the timing of every frame is written to a CSV file "
+        "in the log folder. Each node of a cluster writes its own file that contains its "
+        "node index in the name, and the files can be joined on the frame number.",
+        openspace::properties::Property::Visibility::Developer
+    };
+} // namespace
+
+namespace openspace {
+
+FrameStatistics::FrameStatistics()
+    : properties::PropertyOwner({ "FrameStatistics", "Frame Statistics" })
+    , _logToFile(LogToFileInfo, false)
+{
+    _logToFile.onChange([this]() {
+        if (!_logToFile) {
+            _logFile.close();
+            return;
+        }
+
+        const std::filesystem::path file = absPath(std::format(
+            "${{LOGS}}/framestatistics-{}.csv", global::windowDelegate->currentNode()
+        ));
+        _logFile.open(file, std::ofstream::out | std::ofstream::trunc);
+        if (!_logFile.good()) {
+            LERROR(std::format("Could not open frame statistics file '{}'", file));
+            _logToFile = false;
+            return;
+        }
+
+        _logFile << "Frame,ApplicationTime";
+        for (int i = 0; i < NStages; i++) {
+            _logFile << ',' << nameForStage(static_cast<Stage>(i));
+        }
+        _logFile << ",SyncBytes\n";
+    });
+    addProperty(_logToFile);
+}
+
+FrameStatistics::~FrameStatistics() {}
+
+void FrameStatistics::beginStage(Stage stage) {
+    const int i = static_cast<int>(stage);
+    _stageBegin[i] = std::chrono::steady_clock::now();
+    _isStageActive[i] = true;
+}
+
+void FrameStatistics::endStage(Stage stage) {
+    const int i = static_cast<int>(stage);
+    if (!_isStageActive[i]) {
+        // This happens for the swap wait in the very first frame
+        return;
+    }
+
+    using namespace std::chrono;
+    const duration<double, std::milli> d = steady_clock::now() - _stageBegin[i];
+    _currentFrame.durations[i] += d.count();
+    _isStageActive[i] = false;
+}
+
+void FrameStatistics::setSyncBytes(uint64_t bytes) {
+    _currentFrame.syncBytes = bytes;
+}
+
+void FrameStatistics::finishFrame() {
+    _lastFrame = _currentFrame;
+
+    if (_lastFrame.frameNumber == 0) {
+        _averageFrame = _lastFrame;
+    }
+    else {
+        for (int i = 0; i < NStages; i++) {
+            _averageFrame.durations[i] +=
+                AverageWeight * (_lastFrame.durations[i] - _averageFrame.durations[i]);
+        }
+        _averageFrame.syncBytes = static_cast<uint64_t>(
+            static_cast<double>(_averageFrame.syncBytes) + AverageWeight *
+            (static_cast<double>(_lastFrame.syncBytes) -
+             static_cast<double>(_averageFrame.syncBytes))
+        );
+        _averageFrame.frameNumber = _lastFrame.frameNumber;
+    }
+
+    if (_logFile.is_open()) {
+        writeFrame(_lastFrame);
+    }
+
+    const uint64_t nextFrame = _currentFrame.frameNumber + 1;
+    _currentFrame = Frame();
+    _currentFrame.frameNumber = nextFrame;
+}
+
+const FrameStatistics::Frame& FrameStatistics::lastFrame() const {
+    return _lastFrame;
+}
+
+const FrameStatistics::Frame& FrameStatistics::averageFrame() const {
+    return _averageFrame;
+}
+
+std::string_view FrameStatistics::nameForStage(Stage stage) {
+    switch (stage) {
+        case Stage::PreSynchronization:         return "PreSynchronization";
+        case Stage::Encode:                     return "Encode";
+        case Stage::Decode:                     return "Decode";
+        case Stage::PostSynchronizationPreDraw: return "PostSynchronizationPreDraw";
+        case Stage::Render:                     return "Render";
+        case Stage::SwapWait:                   return "SwapWait";
+    }
+    throw ghoul::MissingCaseException();
+}
+
+void FrameStatistics::writeFrame(const Frame& frame) {
+    _logFile << frame.frameNumber << ',' << global::windowDelegate->applicationTime();
+    for (const double d : frame.durations) {
+        _logFile << ',' << d;
+    }
+    _logFile << ',' << frame.syncBytes << '\n';
+}
+
+} // namespace openspace
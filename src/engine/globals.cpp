@@ -53,6 +53,7 @@
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/scripting/scriptscheduler.h>
 #include <openspace/util/memorymanager.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/versionchecker.h>
 #include <ghoul/misc/assert.h>
@@ -87,6 +88,7 @@ namespace {
         sizeof(RenderEngine) +
         sizeof(std::vector<std::unique_ptr<ScreenSpaceRenderable>>) +
         sizeof(SyncEngine) +
+        sizeof(ThreadPool) +
         sizeof(TimeManager) +
         sizeof(VersionChecker) +
         sizeof(WindowDelegate) +
@@ -384,10 +386,18 @@ void create() {
 #ifdef WIN32
     profile = new (currentPos) Profile;
     ghoul_assert(profile, "No profile");
-    //currentPos += sizeof(Profile);
+    currentPos += sizeof(Profile);
 #else // ^^^ WIN32 / !WIN32 vvv
     profile = new Profile;
 #endif // WIN32
+
+#ifdef WIN32
+    threadPool = new (currentPos) ThreadPool(ThreadPool::defaultNumberOfThreads());
+    ghoul_assert(threadPool, "No threadPool");
+    //currentPos += sizeof(ThreadPool);
+#else // ^^^ WIN32 / !WIN32 vvv
+    threadPool = new ThreadPool(ThreadPool::defaultNumberOfThreads());
+#endif // WIN32
 }
 
 void initialize() {
@@ -421,6 +431,15 @@ void initializeGL() {
 }
 
 void destroy() {
+    // The thread pool is destroyed first as its remaining tasks might still access any
+    // of the other globals
+    LDEBUGC("Globals", "Destroying 'ThreadPool'");
+#ifdef WIN32
+    threadPool->~ThreadPool();
+#else // ^^^ WIN32 / !WIN32 vvv
+    delete threadPool;
+#endif // WIN32
+
     LDEBUGC("Globals", "Destroying 'Profile'");
 #ifdef WIN32
     profile->~Profile();
@@ -26,6 +26,7 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/asynclog.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/loglevel.h>
 #include <ghoul/logging/htmllog.h>
@@ -85,6 +86,25 @@ namespace {
         };
         // The log level for this specific text-based log
         std::optional<LogLevel> logLevel;
+
+        // If this value is true, the messages are written to the file by a background
+        // thread so that the threads that log messages never wait for the file access.
+        // The default value is false
+        std::optional<bool> asynchronous;
+
+        // The number of messages that can wait to be written by the background thread
+        // of an asynchronous log before the 'Overflow' setting applies
+        std::optional<int> queueSize [[codegen::greater(0)]];
+
+        enum class [[codegen::map(openspace::AsyncLog::OverflowPolicy)]] Overflow {
+            Block,
+            Drop
+        };
+        // Determines what happens to a message that is logged while the queue of an
+        // asynchronous log is full. 'Block' waits until there is space in the queue and
+        // 'Drop' discards the message. The number of discarded messages is written to
+        // the log once the background thread caught up. The default value is 'Block'
+        std::optional<Overflow> overflow;
     };
 #include "logfactory_codegen.cpp"
 } // namespace
@@ -109,6 +129,7 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
         p.logLevel.value_or(Parameters::LogLevel::AllLogging)
     );
 
+    std::unique_ptr<ghoul::logging::Log> log;
     switch (p.type) {
         case Parameters::Type::Html:
         {
@@ -118,7 +139,7 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
             };
             const std::vector<std::filesystem::path> jsFiles = { absPath(JsPath) };
 
-            return std::make_unique<ghoul::logging::HTMLLog>(
+            log = std::make_unique<ghoul::logging::HTMLLog>(
                 filename,
                 nLogRotation,
                 ghoul::logging::Log::TimeStamping(timeStamp),
@@ -129,9 +150,10 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
                 jsFiles,
                 level
             );
+            break;
         }
         case Parameters::Type::Text:
-            return std::make_unique<ghoul::logging::TextLog>(
+            log = std::make_unique<ghoul::logging::TextLog>(
                 filename,
                 nLogRotation,
                 ghoul::logging::TextLog::Append(append),
@@ -141,9 +163,21 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
                 ghoul::logging::Log::LogLevelStamping(logLevelStamp),
                 level
             );
+            break;
         default:
             throw ghoul::MissingCaseException();
     }
+
+    if (p.asynchronous.value_or(false)) {
+        return std::make_unique<AsyncLog>(
+            std::move(log),
+            p.queueSize.value_or(8192),
+            codegen::map<AsyncLog::OverflowPolicy>(
+                p.overflow.value_or(Parameters::Overflow::Block)
+            )
+        );
+    }
+    return log;
 }
 
 } // namespace openspace
@@ -0,0 +1,242 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/engine/memorytracker.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <ghoul/format.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <limits>
+#include <utility>
+
+namespace {
+    constexpr double BytesToMegaBytes = 1.0 / (1024.0 * 1024.0);
+
+    constexpr openspace::properties::Property::PropertyInfo TotalRamInfo = {
+        "TotalRam",
+        "Total RAM (MB)",
+        "The amount of system memory in megabytes that is used by all tracked "
+        "allocations.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TotalVramInfo = {
+        "TotalVram",
+        "Total VRAM (MB)",
+        "The amount of video memory in megabytes that is used by all tracked "
+        "allocations.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo RamInfo = {
+        "Ram",
+        "RAM (MB)",
+        "The amount of system memory in megabytes that is used by the tracked "
+        "allocations of this scene graph node or module.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo VramInfo = {
+        "Vram",
+        "VRAM (MB)",
+        "The amount of video memory in megabytes that is used by the tracked "
+        "allocations of this scene graph node or module.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr double MaxValue = std::numeric_limits<double>::max();
+
+    double toMegaBytes(uint64_t bytes) {
+        return static_cast<double>(bytes) * BytesToMegaBytes;
+    }
+} // namespace
+
+namespace openspace {
+
+MemoryTracker::Allocation::Allocation(std::string node, std::string module, Type type)
+    : _tracker(&global::openSpaceEngine->memoryTracker())
+    , _id(_tracker->add(std::move(node), std::move(module), type))
+{}
+
+MemoryTracker::Allocation::Allocation(Allocation&& other) noexcept
+    : _tracker(std::exchange(other._tracker, nullptr))
+    , _id(std::exchange(other._id, -1))
+{}
+
+MemoryTracker::Allocation& MemoryTracker::Allocation::operator=(
+                                                              Allocation&& other) noexcept
+{
+    if (this != &other) {
+        if (_tracker) {
+            _tracker->remove(_id);
+        }
+        _tracker = std::exchange(other._tracker, nullptr);
+        _id = std::exchange(other._id, -1);
+    }
+    return *this;
+}
+
+MemoryTracker::Allocation::~Allocation() {
+    if (_tracker) {
+        _tracker->remove(_id);
+    }
+}
+
+void MemoryTracker::Allocation::setSize(uint64_t bytes) {
+    ghoul_assert(_tracker, "Allocation must have been registered");
+    _tracker->setSize(_id, bytes);
+}
+
+MemoryTracker::UsageProperties::UsageProperties(const std::string& identifier)
+    : properties::PropertyOwner({ identifier, identifier })
+    , ram(RamInfo, 0.0, 0.0, MaxValue)
+    , vram(VramInfo, 0.0, 0.0, MaxValue)
+{
+    ram.setReadOnly(true);
+    addProperty(ram);
+    vram.setReadOnly(true);
+    addProperty(vram);
+}
+
+MemoryTracker::MemoryTracker()
+    : properties::PropertyOwner({ "MemoryTracker", "Memory Tracker" })
+    , _totalRam(TotalRamInfo, 0.0, 0.0, MaxValue)
+    , _totalVram(TotalVramInfo, 0.0, 0.0, MaxValue)
+    , _nodes({ "Nodes", "Nodes" })
+    , _modules({ "Modules", "Modules" })
+{
+    _totalRam.setReadOnly(true);
+    addProperty(_totalRam);
+    _totalVram.setReadOnly(true);
+    addProperty(_totalVram);
+    addPropertySubOwner(_nodes);
+    addPropertySubOwner(_modules);
+}
+
+int MemoryTracker::add(std::string node, std::string module, Type type) {
+    ghoul_assert(!module.empty(), "Module must not be empty");
+
+    const std::lock_guard lock(_mutex);
+    const int id = _nextId++;
+    _allocations[id] = { std::move(node), std::move(module), type, 0 };
+    return id;
+}
+
+void MemoryTracker::setSize(int id, uint64_t bytes) {
+    const std::lock_guard lock(_mutex);
+    const auto it = _allocations.find(id);
+    ghoul_assert(it != _allocations.end(), "Allocation must be registered");
+    it->second.bytes = bytes;
+}
+
+void MemoryTracker::remove(int id) {
+    const std::lock_guard lock(_mutex);
+    _allocations.erase(id);
+}
+
+MemoryTracker::Usage MemoryTracker::total() const {
+    const std::lock_guard lock(_mutex);
+    Usage res;
+    for (const std::pair<const int, Entry>& p : _allocations) {
+        (p.second.type == Type::Ram ? res.ram : res.vram) += p.second.bytes;
+    }
+    return res;
+}
+
+std::map<std::string, MemoryTracker::Usage> MemoryTracker::usagePerNode() const {
+    const std::lock_guard lock(_mutex);
+    std::map<std::string, Usage> res;
+    for (const std::pair<const int, Entry>& p : _allocations) {
+        if (p.second.node.empty()) {
+            continue;
+        }
+        Usage& usage = res[p.second.node];
+        (p.second.type == Type::Ram ? usage.ram : usage.vram) += p.second.bytes;
+    }
+    return res;
+}
+
+std::map<std::string, MemoryTracker::Usage> MemoryTracker::usagePerModule() const {
+    const std::lock_guard lock(_mutex);
+    std::map<std::string, Usage> res;
+    for (const std::pair<const int, Entry>& p : _allocations) {
+        Usage& usage = res[p.second.module];
+        (p.second.type == Type::Ram ? usage.ram : usage.vram) += p.second.bytes;
+    }
+    return res;
+}
+
+void MemoryTracker::update() {
+    ZoneScoped;
+
+    const Usage totalUsage = total();
+    _totalRam = toMegaBytes(totalUsage.ram);
+    _totalVram = toMegaBytes(totalUsage.vram);
+
+    updateProperties(usagePerNode(), _nodes, _nodeProperties);
+    const std::map<std::string, Usage> modules = usagePerModule();
+    updateProperties(modules, _modules, _moduleProperties);
+
+#ifdef TRACY_ENABLE
+    TracyPlot("Tracked RAM", static_cast<int64_t>(totalUsage.ram));
+    TracyPlot("Tracked VRAM", static_cast<int64_t>(totalUsage.vram));
+    for (const std::pair<const std::string, Usage>& p : modules) {
+        const char* ram =
+            _plotNames.insert(std::format("RAM {}", p.first)).first->c_str();
+        TracyPlot(ram, static_cast<int64_t>(p.second.ram));
+        const char* vram =
+            _plotNames.insert(std::format("VRAM {}", p.first)).first->c_str();
+        TracyPlot(vram, static_cast<int64_t>(p.second.vram));
+    }
+#endif // TRACY_ENABLE
+}
+
+void MemoryTracker::updateProperties(const std::map<std::string, Usage>& usage,
+                                     properties::PropertyOwner& parent,
+                                     PropertyMap& properties)
+{
+    for (auto it = properties.begin(); it != properties.end();) {
+        if (usage.contains(it->first)) {
+            it++;
+        }
+        else {
+            parent.removePropertySubOwner(*it->second);
+            it = properties.erase(it);
+        }
+    }
+
+    for (const std::pair<const std::string, Usage>& p : usage) {
+        std::unique_ptr<UsageProperties>& props = properties[p.first];
+        if (!props) {
+            props = std::make_unique<UsageProperties>(p.first);
+            parent.addPropertySubOwner(*props);
+        }
+        props->ram = toMegaBytes(p.second.ram);
+        props->vram = toMegaBytes(p.second.vram);
+    }
+}
+
+} // namespace openspace
@@ -27,6 +27,7 @@
 #include <openspace/openspace.h>
 #include <openspace/camera/camera.h>
 #include <openspace/documentation/core_registration.h>
+#include <openspace/documentation/documentation.h>
 #include <openspace/documentation/documentationengine.h>
 #include <openspace/engine/configuration.h>
 #include <openspace/engine/downloadmanager.h>
@@ -42,11 +43,13 @@
 #include <openspace/interaction/keybindingmanager.h>
 #include <openspace/interaction/sessionrecordinghandler.h>
 #include <openspace/interaction/tasks/convertrecformattask.h>
+#include <openspace/json.h>
 #include <openspace/navigation/navigationhandler.h>
 #include <openspace/navigation/orbitalnavigator.h>
 #include <openspace/navigation/waypoint.h>
 #include <openspace/network/parallelpeer.h>
 #include <openspace/rendering/dashboard.h>
+#include <openspace/rendering/gputimerpool.h>
 #include <openspace/rendering/helper.h>
 #include <openspace/rendering/loadingscreen.h>
 #include <openspace/rendering/luaconsole.h>
@@ -87,7 +90,9 @@
 #include <glbinding/glbinding.h>
 #include <glbinding-aux/types_to_string.h>
 #include <filesystem>
+#include <fstream>
 #include <future>
+#include <limits>
 #include <numeric>
 #include <sstream>
 
@@ -134,6 +139,25 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo TemporaryMemoryUsageInfo = {
+        "TemporaryMemoryUsage",
+        "Temporary Memory Usage (bytes)",
+        "The number of bytes of frame-based temporary memory that were used in the "
+        "previous frame.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo
+        TemporaryMemoryHighWaterMarkInfo =
+    {
+        "TemporaryMemoryHighWaterMark",
+        "Temporary Memory High-Water Mark (bytes)",
+        "The largest number of bytes of frame-based temporary memory that were used in "
+        "any frame since the application started. This value can be used to determine "
+        "the amount of temporary memory that a specific installation requires.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     constexpr openspace::properties::Property::PropertyInfo VisibilityInfo = {
         "PropertyVisibility",
         "Property Visibility",
@@ -212,11 +236,24 @@ OpenSpaceEngine::OpenSpaceEngine()
     , _visibility(VisibilityInfo)
     , _fadeOnEnableDuration(FadeDurationInfo, 1.f, 0.f, 5.f)
     , _disableAllMouseInputs(DisableMouseInputInfo, false)
+    , _temporaryMemoryUsage(
+        TemporaryMemoryUsageInfo,
+        0,
+        0,
+        std::numeric_limits<int>::max()
+    )
+    , _temporaryMemoryHighWaterMark(
+        TemporaryMemoryHighWaterMarkInfo,
+        0,
+        0,
+        std::numeric_limits<int>::max()
+    )
 {
     FactoryManager::initialize();
     SpiceManager::initialize();
     TransformationManager::initialize();
 
+    addPropertySubOwner(SpiceManager::ref());
     addProperty(_printEvents);
 
     using Visibility = openspace::properties::Property::Visibility;
@@ -231,6 +268,12 @@ OpenSpaceEngine::OpenSpaceEngine()
 
     addProperty(_fadeOnEnableDuration);
     addProperty(_disableAllMouseInputs);
+    _temporaryMemoryUsage.setReadOnly(true);
+    addProperty(_temporaryMemoryUsage);
+    _temporaryMemoryHighWaterMark.setReadOnly(true);
+    addProperty(_temporaryMemoryHighWaterMark);
+    addPropertySubOwner(_frameStatistics);
+    addPropertySubOwner(_memoryTracker);
 
 
     ghoul::TemplateFactory<Task>* fTask = FactoryManager::ref().factory<Task>();
@@ -325,6 +368,13 @@ void OpenSpaceEngine::initialize() {
         LFATALC(e.component, e.message);
     }
 
+    if (global::configuration->useVerificationSnapshot) {
+        documentation::loadVerificationSnapshot(
+            cacheFolder / "verificationsnapshot.bin",
+            std::format("{}|{}", OPENSPACE_VERSION_STRING_FULL, OPENSPACE_GIT_FULL)
+        );
+    }
+
 
 
     // Initialize the requested logs from the configuration file
@@ -802,11 +852,7 @@ void OpenSpaceEngine::loadAssets() {
 
     std::unique_ptr<SceneInitializer> sceneInitializer;
     if (global::configuration->useMultithreadedInitialization) {
-        const unsigned int nThreads = std::max(
-            std::thread::hardware_concurrency() / 4,
-            4u
-        );
-        sceneInitializer = std::make_unique<MultiThreadedSceneInitializer>(nThreads);
+        sceneInitializer = std::make_unique<MultiThreadedSceneInitializer>();
     }
     else {
         sceneInitializer = std::make_unique<SingleThreadedSceneInitializer>();
@@ -839,6 +885,7 @@ void OpenSpaceEngine::loadAssets() {
 
     global::renderEngine->updateScene();
 
+    global::syncEngine->setDeltaEncoding(global::configuration->useDeltaSynchronization);
     global::syncEngine->addSyncables(global::timeManager->syncables());
     global::syncEngine->addSyncables(
         global::navigationHandler->orbitalNavigator().syncables()
@@ -885,10 +932,13 @@ void OpenSpaceEngine::deinitialize() {
 
     _assetManager = nullptr;
 
+    documentation::saveVerificationSnapshot();
+
     global::deinitialize();
 
     FactoryManager::deinitialize();
     TransformationManager::deinitialize();
+    removePropertySubOwner(SpiceManager::ref());
     SpiceManager::deinitialize();
 
     if (_printEvents) {
@@ -996,6 +1046,14 @@ uint64_t OpenSpaceEngine::vramInUse() const {
 #endif
 }
 
+const FrameStatistics& OpenSpaceEngine::frameStatistics() const {
+    return _frameStatistics;
+}
+
+MemoryTracker& OpenSpaceEngine::memoryTracker() {
+    return _memoryTracker;
+}
+
 void OpenSpaceEngine::runGlobalCustomizationScripts() {
     ZoneScoped;
 
@@ -1063,10 +1121,19 @@ void OpenSpaceEngine::preSynchronization() {
 
     LTRACE("OpenSpaceEngine::preSynchronization(begin)");
 
-    FileSys.triggerFilesystemEvents();
+    // The time between the end of the last frame's postDraw and this point is spent in
+    // SGCT, which is mostly the buffer swap and waiting on the swap barrier
+    _frameStatistics.endStage(FrameStatistics::Stage::SwapWait);
+    _frameStatistics.finishFrame();
+    if (global::configuration->benchmark.has_value() &&
+        _frameStatistics.lastFrame().frameNumber > 0)
+    {
+        // The first frame is spent loading the profile and is not part of the benchmark
+        recordBenchmarkFrame();
+    }
+    _frameStatistics.beginStage(FrameStatistics::Stage::PreSynchronization);
 
-    // Reset the temporary, frame-based storage
-    global::memoryManager->TemporaryMemory.reset();
+    FileSys.triggerFilesystemEvents();
 
     if (_isRenderingFirstFrame) {
         global::profile->ignoreUpdates = true;
@@ -1087,10 +1154,15 @@ void OpenSpaceEngine::preSynchronization() {
 
     global::syncEngine->preSynchronization(SyncEngine::IsMaster(master));
     if (master) {
-        const double dt =
-            global::sessionRecordingHandler->isSavingFramesDuringPlayback() ?
-            global::sessionRecordingHandler->fixedDeltaTimeDuringFrameOutput() :
-            global::windowDelegate->deltaTime();
+        double dt = global::windowDelegate->deltaTime();
+        if (global::sessionRecordingHandler->isSavingFramesDuringPlayback()) {
+            dt = global::sessionRecordingHandler->fixedDeltaTimeDuringFrameOutput();
+        }
+        else if (global::configuration->benchmark.has_value()) {
+            // A fixed step makes the simulated content of each frame independent of how
+            // long the previous frames took to render
+            dt = global::configuration->benchmark->deltaTime;
+        }
 
         global::timeManager->preSynchronization(dt);
 
@@ -1136,6 +1208,9 @@ void OpenSpaceEngine::preSynchronization() {
     if (_isRenderingFirstFrame) {
         setCameraFromProfile(*global::profile);
         setAdditionalScriptsFromProfile(*global::profile);
+        if (global::configuration->benchmark.has_value()) {
+            startBenchmark();
+        }
     }
 
     // Handle callback(s) for change in engine mode
@@ -1148,6 +1223,7 @@ void OpenSpaceEngine::preSynchronization() {
     }
     _modeLastFrame = _currentMode;
 
+    _frameStatistics.endStage(FrameStatistics::Stage::PreSynchronization);
     LTRACE("OpenSpaceEngine::preSynchronization(end)");
 }
 
@@ -1160,6 +1236,8 @@ void OpenSpaceEngine::postSynchronizationPreDraw() {
     TracyPlot("VRAM", static_cast<int64_t>(vramInUse()));
 #endif // TRACY_ENABLE
 
+    _frameStatistics.beginStage(FrameStatistics::Stage::PostSynchronizationPreDraw);
+
     const bool master = global::windowDelegate->isMaster();
     global::syncEngine->postSynchronization(SyncEngine::IsMaster(master));
 
@@ -1176,6 +1254,10 @@ void OpenSpaceEngine::postSynchronizationPreDraw() {
 
     _assetManager->update();
 
+    SpiceManager::ref().updateEphemerisCache(
+        global::timeManager->time().j2000Seconds()
+    );
+
     global::renderEngine->updateScene();
     global::renderEngine->updateRenderer();
     global::renderEngine->updateScreenSpaceRenderables();
@@ -1197,6 +1279,12 @@ void OpenSpaceEngine::postSynchronizationPreDraw() {
         func();
     }
 
+    // Nothing is allowed to change the scene graph until the end of the frame, so the
+    // transforms for the next frame can now be computed alongside the rendering
+    if (_scene) {
+        _scene->startPipelinedUpdate();
+    }
+
     // Testing this every frame has minimal impact on the performance --- abock
     // Debug build: 1-2 us ; Release build: <= 1 us
     using ghoul::logging::LogManager;
@@ -1216,6 +1304,7 @@ void OpenSpaceEngine::postSynchronizationPreDraw() {
 
     LogMgr.resetMessageCounters();
 
+    _frameStatistics.endStage(FrameStatistics::Stage::PostSynchronizationPreDraw);
     LTRACE("OpenSpaceEngine::postSynchronizationPreDraw(end)");
 }
 
@@ -1231,6 +1320,8 @@ void OpenSpaceEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& view
     TracyPlot("VRAM", static_cast<int64_t>(vramInUse()));
 #endif // TRACY_ENABLE
 
+    _frameStatistics.beginStage(FrameStatistics::Stage::Render);
+
     viewportChanged();
 
     global::renderEngine->render(sceneMatrix, viewMatrix, projectionMatrix);
@@ -1245,6 +1336,7 @@ void OpenSpaceEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& view
         func();
     }
 
+    _frameStatistics.endStage(FrameStatistics::Stage::Render);
     LTRACE("OpenSpaceEngine::render(end)");
 }
 
@@ -1283,6 +1375,104 @@ void OpenSpaceEngine::drawOverlays() {
     LTRACE("OpenSpaceEngine::drawOverlays(end)");
 }
 
+void OpenSpaceEngine::startBenchmark() {
+    const Configuration::Benchmark& benchmark = *global::configuration->benchmark;
+    LINFO(std::format("Starting benchmark of {} frames", benchmark.nFrames));
+
+    global::scriptEngine->queueScript(
+        "openspace.setPropertyValueSingle('RenderEngine.GpuTiming.Enabled', true)"
+    );
+
+    if (!benchmark.script.empty()) {
+        const std::filesystem::path script = absPath(benchmark.script);
+        std::ifstream file = std::ifstream(script);
+        if (file.good()) {
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            global::scriptEngine->queueScript(buffer.str());
+        }
+        else {
+            LERROR(std::format("Could not open benchmark script '{}'", script));
+        }
+    }
+
+    if (!benchmark.sessionRecording.empty()) {
+        const std::filesystem::path recording = absPath(benchmark.sessionRecording);
+        global::scriptEngine->queueScript(std::format(
+            "openspace.sessionRecording.startPlayback([[{}]], false, true)",
+            recording.generic_string()
+        ));
+    }
+}
+
+void OpenSpaceEngine::recordBenchmarkFrame() {
+    const Configuration::Benchmark& benchmark = *global::configuration->benchmark;
+
+    BenchmarkSample sample;
+    sample.frame = _frameStatistics.lastFrame();
+    // The GPU results are only available after GpuTimerPool::Latency frames, so these
+    // times belong to an earlier frame than the CPU times of this sample
+    const std::vector<GpuTimerPool::Timing> timings =
+        global::renderEngine->gpuTimerPool().timings();
+    sample.gpuTimes.reserve(timings.size());
+    for (const GpuTimerPool::Timing& timing : timings) {
+        sample.gpuTimes.emplace_back(timing.name, timing.time);
+    }
+    sample.ram = ramInUse();
+    sample.vram = vramInUse();
+    _benchmarkSamples.push_back(std::move(sample));
+
+    if (std::ssize(_benchmarkSamples) == benchmark.nFrames) {
+        writeBenchmarkResults();
+        global::windowDelegate->terminate();
+    }
+}
+
+void OpenSpaceEngine::writeBenchmarkResults() const {
+    const Configuration::Benchmark& benchmark = *global::configuration->benchmark;
+
+    nlohmann::json frames = nlohmann::json::array();
+    for (const BenchmarkSample& sample : _benchmarkSamples) {
+        nlohmann::json cpu = nlohmann::json::object();
+        for (int i = 0; i < FrameStatistics::NStages; i++) {
+            const FrameStatistics::Stage stage = static_cast<FrameStatistics::Stage>(i);
+            cpu[std::string(FrameStatistics::nameForStage(stage))] =
+                sample.frame.durations[i];
+        }
+
+        nlohmann::json gpu = nlohmann::json::object();
+        for (const std::pair<std::string, float>& time : sample.gpuTimes) {
+            gpu[time.first] = time.second;
+        }
+
+        nlohmann::json frame = nlohmann::json::object();
+        frame["frame"] = sample.frame.frameNumber;
+        frame["cpu"] = std::move(cpu);
+        frame["gpu"] = std::move(gpu);
+        frame["syncBytes"] = sample.frame.syncBytes;
+        frame["ram"] = sample.ram;
+        frame["vram"] = sample.vram;
+        frames.push_back(std::move(frame));
+    }
+
+    nlohmann::json json = nlohmann::json::object();
+    json["profile"] = global::configuration->profile;
+    json["sessionRecording"] = benchmark.sessionRecording;
+    json["script"] = benchmark.script;
+    json["deltaTime"] = benchmark.deltaTime;
+    json["gpuLatency"] = GpuTimerPool::Latency;
+    json["frames"] = std::move(frames);
+
+    const std::filesystem::path output = absPath(benchmark.output);
+    std::ofstream file = std::ofstream(output);
+    if (!file.good()) {
+        LERROR(std::format("Could not write benchmark results to '{}'", output));
+        return;
+    }
+    file << json.dump(2);
+    LINFO(std::format("Wrote benchmark results to '{}'", output));
+}
+
 void OpenSpaceEngine::postDraw() {
     ZoneScoped;
     TracyGpuZone("postDraw");
@@ -1292,6 +1482,10 @@ void OpenSpaceEngine::postDraw() {
 #endif // TRACY_ENABLE
     LTRACE("OpenSpaceEngine::postDraw(begin)");
 
+    if (_scene) {
+        _scene->finishPipelinedUpdate();
+    }
+
     global::renderEngine->postDraw();
 
     for (const std::function<void()>& func : *global::callback::postDraw) {
@@ -1317,12 +1511,28 @@ void OpenSpaceEngine::postDraw() {
     if (_printEvents) {
         events::logAllEvents(e);
     }
+    global::luaConsole->handleEvents(e);
     global::eventEngine->triggerActions();
     global::eventEngine->triggerTopics();
 
     global::eventEngine->postFrameCleanup();
     global::memoryManager->PersistentMemory.housekeeping();
+    global::memoryManager->SceneGraphMemory.housekeeping();
+    _memoryTracker.update();
+
+    // Reset the temporary, frame-based storage
+    FrameArena& temporaryMemory = global::memoryManager->TemporaryMemory;
+    temporaryMemory.reset();
+    _temporaryMemoryUsage = static_cast<int>(temporaryMemory.lastFrameUsage());
+    _temporaryMemoryHighWaterMark = static_cast<int>(temporaryMemory.highWaterMark());
+#ifdef TRACY_ENABLE
+    TracyPlot(
+        "Temporary Memory",
+        static_cast<int64_t>(temporaryMemory.lastFrameUsage())
+    );
+#endif // TRACY_ENABLE
 
+    _frameStatistics.beginStage(FrameStatistics::Stage::SwapWait);
     LTRACE("OpenSpaceEngine::postDraw(end)");
 }
 
@@ -1566,13 +1776,20 @@ void OpenSpaceEngine::handleDragDrop(std::filesystem::path file) {
 std::vector<std::byte> OpenSpaceEngine::encode() {
     ZoneScoped;
 
-    return global::syncEngine->encodeSyncables();
+    _frameStatistics.beginStage(FrameStatistics::Stage::Encode);
+    std::vector<std::byte> data = global::syncEngine->encodeSyncables();
+    _frameStatistics.setSyncBytes(data.size());
+    _frameStatistics.endStage(FrameStatistics::Stage::Encode);
+    return data;
 }
 
-void OpenSpaceEngine::decode(std::vector<std::byte> data) {
+void OpenSpaceEngine::decode(std::span<const std::byte> data) {
     ZoneScoped;
 
-    global::syncEngine->decodeSyncables(std::move(data));
+    _frameStatistics.beginStage(FrameStatistics::Stage::Decode);
+    global::syncEngine->decodeSyncables(data);
+    _frameStatistics.setSyncBytes(data.size());
+    _frameStatistics.endStage(FrameStatistics::Stage::Decode);
 }
 
 properties::Property::Visibility OpenSpaceEngine::visibility() const {
@@ -1675,7 +1892,8 @@ scripting::LuaLibrary OpenSpaceEngine::luaLibrary() {
             codegen::lua::LoadJson,
             codegen::lua::ResolveShortcut,
             codegen::lua::VramInUse,
-            codegen::lua::RamInUse
+            codegen::lua::RamInUse,
+            codegen::lua::MemoryUsage
         },
         {
             absPath("${SCRIPTS}/core_scripts.lua")
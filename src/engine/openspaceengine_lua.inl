@@ -324,4 +324,37 @@ namespace {
     return static_cast<double>(openspace::global::openSpaceEngine->ramInUse());
 }
 
+/**
+ * Returns the number of bytes that are used by the allocations registered with the
+ * memory tracker. The returned table contains the `Total` usage, the usage of each scene
+ * graph node in `Nodes`, and the usage of each module in `Modules`. Each usage is a table
+ * with the `Ram` and `Vram` keys.
+ */
+[[codegen::luawrap]] ghoul::Dictionary memoryUsage() {
+    using namespace openspace;
+
+    auto toDictionary = [](const MemoryTracker::Usage& usage) {
+        ghoul::Dictionary res;
+        res.setValue("Ram", static_cast<double>(usage.ram));
+        res.setValue("Vram", static_cast<double>(usage.vram));
+        return res;
+    };
+
+    const MemoryTracker& tracker = global::openSpaceEngine->memoryTracker();
+    ghoul::Dictionary nodes;
+    for (const auto& [node, usage] : tracker.usagePerNode()) {
+        nodes.setValue(node, toDictionary(usage));
+    }
+    ghoul::Dictionary modules;
+    for (const auto& [module, usage] : tracker.usagePerModule()) {
+        modules.setValue(module, toDictionary(usage));
+    }
+
+    ghoul::Dictionary res;
+    res.setValue("Total", toDictionary(tracker.total()));
+    res.setValue("Nodes", std::move(nodes));
+    res.setValue("Modules", std::move(modules));
+    return res;
+}
+
 #include "openspaceengine_lua_codegen.cpp"
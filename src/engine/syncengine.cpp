@@ -25,32 +25,51 @@
 #include <openspace/engine/syncengine.h>
 
 #include <openspace/util/syncdata.h>
+#include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
 #include <ghoul/misc/profiling.h>
 #include <algorithm>
+#include <format>
+
+namespace {
+    constexpr std::string_view _loggerCat = "SyncEngine";
+} // namespace
 
 namespace openspace {
 
 SyncEngine::SyncEngine(unsigned int syncBufferSize)
     : _syncBuffer(syncBufferSize)
+    , _syncableBuffer(syncBufferSize)
 {
     ghoul_assert(syncBufferSize > 0, "syncBufferSize must be bigger than 0");
 }
 
 // Should be called on sgct master
 std::vector<std::byte> SyncEngine::encodeSyncables() {
+    if (_useDeltaEncoding) {
+        return encodeDelta();
+    }
+
     for (Syncable* syncable : _syncables) {
         syncable->encode(&_syncBuffer);
     }
 
-    std::vector<std::byte> data = _syncBuffer.data();
+    // SGCT takes ownership of the returned vector, so this is the only copy
+    const std::span<const std::byte> encoded = _syncBuffer.encodedData();
+    std::vector<std::byte> data = std::vector<std::byte>(encoded.begin(), encoded.end());
     _syncBuffer.reset();
     return data;
 }
 
 // Should be called on sgct clients
-void SyncEngine::decodeSyncables(std::vector<std::byte> data) {
-    _syncBuffer.setData(std::move(data));
+void SyncEngine::decodeSyncables(std::span<const std::byte> data) {
+    if (_useDeltaEncoding) {
+        decodeDelta(data);
+        return;
+    }
+
+    _syncBuffer.setData(data);
     for (Syncable* syncable : _syncables) {
         syncable->decode(&_syncBuffer);
     }
@@ -58,6 +77,109 @@ void SyncEngine::decodeSyncables(std::vector<std::byte> data) {
     _syncBuffer.reset();
 }
 
+void SyncEngine::setDeltaEncoding(bool enabled) {
+    _useDeltaEncoding = enabled;
+    invalidateDeltaState();
+}
+
+void SyncEngine::requestKeyframe() {
+    _isKeyframeRequested = true;
+}
+
+std::vector<std::byte> SyncEngine::encodeDelta() {
+    ZoneScoped;
+
+    const bool isKeyframe = _isKeyframeRequested ||
+                            _framesSinceKeyframe >= KeyframeInterval ||
+                            _deltaState.size() != _syncables.size();
+    _deltaState.resize(_syncables.size());
+
+    // Layout: keyframe flag, number of syncables, and then for each syncable a flag
+    // whether it changed followed by its encoded state if it did
+    _syncBuffer.encode(isKeyframe);
+    _syncBuffer.encode(static_cast<uint32_t>(_syncables.size()));
+    for (size_t i = 0; i < _syncables.size(); i++) {
+        _syncables[i]->encode(&_syncableBuffer);
+        const std::span<const std::byte> state = _syncableBuffer.encodedData();
+
+        const bool hasChanged = isKeyframe ||
+            !std::equal(state.begin(), state.end(), _deltaState[i].begin(),
+                _deltaState[i].end());
+        _syncBuffer.encode(hasChanged);
+        if (hasChanged) {
+            _syncBuffer.encode(state);
+            // Assigning reuses the memory of the previous state
+            _deltaState[i].assign(state.begin(), state.end());
+        }
+        _syncableBuffer.reset();
+    }
+
+    _framesSinceKeyframe = isKeyframe ? 0 : _framesSinceKeyframe + 1;
+    _isKeyframeRequested = false;
+
+    const std::span<const std::byte> encoded = _syncBuffer.encodedData();
+    std::vector<std::byte> data = std::vector<std::byte>(encoded.begin(), encoded.end());
+    _syncBuffer.reset();
+    return data;
+}
+
+void SyncEngine::decodeDelta(std::span<const std::byte> data) {
+    ZoneScoped;
+
+    _syncBuffer.setData(data);
+    try {
+        const bool isKeyframe = _syncBuffer.decode<bool>();
+        const uint32_t nSyncables = _syncBuffer.decode<uint32_t>();
+        if (nSyncables != _syncables.size()) {
+            throw ghoul::RuntimeError(std::format(
+                "Received state for {} syncables, but {} are registered",
+                nSyncables, _syncables.size()
+            ));
+        }
+
+        if (!isKeyframe && _isAwaitingKeyframe) {
+            // We don't have a complete state to apply the delta to, so we have to skip
+            // frames until the next keyframe arrives
+            _syncBuffer.reset();
+            return;
+        }
+
+        _deltaState.resize(_syncables.size());
+        for (std::vector<std::byte>& state : _deltaState) {
+            const bool hasChanged = _syncBuffer.decode<bool>();
+            if (hasChanged) {
+                _syncBuffer.decode(state);
+            }
+        }
+        _isAwaitingKeyframe = false;
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LWARNING(std::format(
+            "Failed to decode synchronization data, waiting for next keyframe: {}",
+            e.message
+        ));
+        invalidateDeltaState();
+        _syncBuffer.reset();
+        return;
+    }
+    _syncBuffer.reset();
+
+    // Unchanged syncables are decoded from their last known state so that every
+    // syncable sees the same sequence of decode calls as in the full encoding
+    for (size_t i = 0; i < _syncables.size(); i++) {
+        _syncableBuffer.setData(_deltaState[i]);
+        _syncables[i]->decode(&_syncableBuffer);
+        _syncableBuffer.reset();
+    }
+}
+
+void SyncEngine::invalidateDeltaState() {
+    _deltaState.clear();
+    _isKeyframeRequested = true;
+    _isAwaitingKeyframe = true;
+    _framesSinceKeyframe = 0;
+}
+
 void SyncEngine::preSynchronization(IsMaster isMaster) {
     ZoneScoped;
 
@@ -82,6 +204,7 @@ void SyncEngine::addSyncable(Syncable* syncable) {
     ghoul_assert(syncable, "Syncable must not be nullptr");
 
     _syncables.push_back(syncable);
+    invalidateDeltaState();
 }
 
 void SyncEngine::addSyncables(const std::vector<Syncable*>& syncables) {
@@ -96,6 +219,7 @@ void SyncEngine::removeSyncable(Syncable* syncable) {
         std::remove(_syncables.begin(), _syncables.end(), syncable),
         _syncables.end()
     );
+    invalidateDeltaState();
 }
 
 void SyncEngine::removeSyncables(const std::vector<Syncable*>& syncables) {
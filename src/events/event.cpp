@@ -504,6 +504,19 @@ ghoul::Dictionary toParameter(const Event& e) {
     return d;
 }
 
+std::string_view nodeParameter(const Event& e) {
+    switch (e.type) {
+        case Event::Type::CameraFocusTransition:
+            return static_cast<const EventCameraFocusTransition&>(e).node;
+        case Event::Type::RenderableEnabled:
+            return static_cast<const EventRenderableEnabled&>(e).node;
+        case Event::Type::RenderableDisabled:
+            return static_cast<const EventRenderableDisabled&>(e).node;
+        default:
+            return "";
+    }
+}
+
 void logAllEvents(const Event* e) {
     int i = 0;
     while (e) {
@@ -26,6 +26,8 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/interaction/actionmanager.h>
+#include <algorithm>
+#include <functional>
 
 #include "eventengine_lua.inl"
 
@@ -62,14 +64,13 @@ void EventEngine::registerEventAction(events::Event::Type type, std::string iden
     ai.isEnabled = true;
     ai.type = type;
     ai.action = std::move(identifier);
-    ai.filter = std::move(filter);
-    const auto it = _eventActions.find(type);
-    if (it != _eventActions.end()) {
-        it->second.push_back(ai);
-    }
-    else {
-        _eventActions[type] = { std::move(ai) };
+    if (filter.has_value() && filter->hasValue<std::string>("Node")) {
+        ai.nodeFilterHash = std::hash<std::string_view>()(
+            filter->value<std::string>("Node")
+        );
     }
+    ai.filter = std::move(filter);
+    _eventActions[static_cast<size_t>(type)].push_back(std::move(ai));
 
     nextRegisteredEventId++;
 }
@@ -81,44 +82,38 @@ void EventEngine::registerEventTopic(size_t topicId, events::Event::Type type,
     ti.id = static_cast<uint32_t>(topicId);
     ti.callback = std::move(callback);
 
-    _eventTopics[type].push_back(ti);
+    _eventTopics[static_cast<size_t>(type)].push_back(ti);
 }
 
 void EventEngine::unregisterEventAction(events::Event::Type type,
                                         const std::string& identifier,
                                         const std::optional<ghoul::Dictionary>& filter)
 {
-    const auto it = _eventActions.find(type);
-    if (it != _eventActions.end()) {
-        const auto jt = std::find_if(
-            it->second.begin(), it->second.end(),
-            [identifier, filter](const ActionInfo& ai) {
-                const bool a = ai.action == identifier;
-                const bool f = !filter.has_value() || *filter == ai.filter;
-                return a && f;
-            }
-        );
-        if (jt != it->second.end()) {
-            it->second.erase(jt);
+    std::vector<ActionInfo>& actions = _eventActions[static_cast<size_t>(type)];
+    const auto it = std::find_if(
+        actions.begin(), actions.end(),
+        [identifier, filter](const ActionInfo& ai) {
+            const bool a = ai.action == identifier;
+            const bool f = !filter.has_value() || *filter == ai.filter;
+            return a && f;
         }
+    );
+    if (it != actions.end()) {
+        actions.erase(it);
     }
 }
 
 void EventEngine::unregisterEventAction(uint32_t identifier) {
-    for (auto it = _eventActions.begin(); it != _eventActions.end(); it++) {
-        for (auto jt = it->second.begin(); jt != it->second.end(); jt++) {
-            if (jt->id == identifier) {
-                it->second.erase(jt);
-
-                // This might have been the last action so we might need to remove the
-                // entry alltogether
-                if (it->second.empty()) {
-                    _eventActions.erase(it);
-                }
+    for (std::vector<ActionInfo>& actions : _eventActions) {
+        const auto it = std::find_if(
+            actions.begin(), actions.end(),
+            [identifier](const ActionInfo& ai) { return ai.id == identifier; }
+        );
+        if (it != actions.end()) {
+            actions.erase(it);
 
-                // The identifier is unique so we can stop after this
-                return;
-            }
+            // The identifier is unique so we can stop after this
+            return;
         }
     }
 
@@ -129,100 +124,102 @@ void EventEngine::unregisterEventAction(uint32_t identifier) {
 }
 
 void EventEngine::unregisterEventTopic(size_t topicId, events::Event::Type type) {
-    const auto it = _eventTopics.find(type);
-    if (it != _eventTopics.end()) {
-        const auto jt = std::find_if(
-            it->second.begin(), it->second.end(),
-            [topicId](const TopicInfo& ti) {
-                return ti.id == topicId;
-            }
+    std::vector<TopicInfo>& topics = _eventTopics[static_cast<size_t>(type)];
+    if (topics.empty()) {
+        LWARNING(std::format("Could not find registered event '{}'",
+            events::toString(type))
         );
-        if (jt != it->second.end()) {
-            it->second.erase(jt);
+        return;
+    }
 
-            // This might have been the last action so we might need to remove the
-            // entry alltogether
-            if (it->second.empty()) {
-                _eventTopics.erase(it);
-            }
-        }
-        else {
-            LWARNING(std::format("Could not find registered event '{}' with topicId: {}",
-                events::toString(type), topicId)
-            );
+    const auto it = std::find_if(
+        topics.begin(), topics.end(),
+        [topicId](const TopicInfo& ti) {
+            return ti.id == topicId;
         }
+    );
+    if (it != topics.end()) {
+        topics.erase(it);
     }
     else {
-        LWARNING(std::format("Could not find registered event '{}'",
-            events::toString(type))
+        LWARNING(std::format("Could not find registered event '{}' with topicId: {}",
+            events::toString(type), topicId)
         );
     }
 }
 
 std::vector<EventEngine::ActionInfo> EventEngine::registeredActions() const {
     std::vector<EventEngine::ActionInfo> result;
-    result.reserve(_eventActions.size());
-    using Type = events::Event::Type;
-    for (const std::pair<const Type, std::vector<ActionInfo>>& p : _eventActions) {
-        result.insert(result.end(), p.second.begin(), p.second.end());
+    for (const std::vector<ActionInfo>& actions : _eventActions) {
+        result.insert(result.end(), actions.begin(), actions.end());
     }
     return result;
 }
 
-const std::unordered_map<events::Event::Type, std::vector<EventEngine::ActionInfo>>&
-EventEngine::eventActions() const
-{
+const EventEngine::EventActions& EventEngine::eventActions() const {
     return _eventActions;
 }
 
 void EventEngine::enableEvent(uint32_t identifier) {
-    using Type = events::Event::Type;
-    for (std::pair<const Type, std::vector<ActionInfo>>& p : _eventActions) {
-        for (ActionInfo& ai : p.second) {
+    for (std::vector<ActionInfo>& actions : _eventActions) {
+        for (ActionInfo& ai : actions) {
             if (ai.id == identifier) {
                 ai.isEnabled = true;
-                break;
+                return;
             }
         }
     }
 }
 
 void EventEngine::disableEvent(uint32_t identifier) {
-    using Type = events::Event::Type;
-    for (std::pair<const Type, std::vector<ActionInfo>>& p : _eventActions) {
-        for (ActionInfo& ai : p.second) {
+    for (std::vector<ActionInfo>& actions : _eventActions) {
+        for (ActionInfo& ai : actions) {
             if (ai.id == identifier) {
                 ai.isEnabled = false;
-                break;
+                return;
             }
         }
     }
 }
 
 void EventEngine::triggerActions() const {
-    if (_eventActions.empty()) {
-        // Nothing to do here
-        return;
-    }
-
     const events::Event* e = _firstEvent;
     while (e) {
-        const auto it = _eventActions.find(e->type);
-        if (it != _eventActions.end()) {
-            const ghoul::Dictionary params = toParameter(*e);
-            for (const ActionInfo& ai : it->second) {
-                if (ai.isEnabled &&
-                    (!ai.filter.has_value() || params.isSubset(*ai.filter)))
-                {
-                    // No sync because events are always synced and sent to the connected
-                    // nodes and peers
-                    global::actionManager->triggerAction(
-                        ai.action,
-                        params,
-                        interaction::ActionManager::ShouldBeSynchronized::No
-                    );
+        const std::vector<ActionInfo>& actions =
+            _eventActions[static_cast<size_t>(e->type)];
+
+        // The parameters and the hash of the node are only created once they are needed
+        // by the first action that is registered for this event
+        std::optional<ghoul::Dictionary> params;
+        std::optional<size_t> nodeHash;
+        for (const ActionInfo& ai : actions) {
+            if (!ai.isEnabled) {
+                continue;
+            }
+
+            if (ai.nodeFilterHash.has_value()) {
+                if (!nodeHash.has_value()) {
+                    nodeHash = std::hash<std::string_view>()(events::nodeParameter(*e));
                 }
+                if (*nodeHash != *ai.nodeFilterHash) {
+                    continue;
+                }
+            }
+
+            if (!params.has_value()) {
+                params = toParameter(*e);
             }
+            if (ai.filter.has_value() && !params->isSubset(*ai.filter)) {
+                continue;
+            }
+
+            // No sync because events are always synced and sent to the connected nodes
+            // and peers
+            global::actionManager->triggerAction(
+                ai.action,
+                *params,
+                interaction::ActionManager::ShouldBeSynchronized::No
+            );
         }
 
         e = e->next;
@@ -230,18 +227,14 @@ void EventEngine::triggerActions() const {
 }
 
 void EventEngine::triggerTopics() const {
-    if (_eventTopics.empty()) {
-        // Nothing to do here
-        return;
-    }
-
     const events::Event* e = _firstEvent;
     while (e) {
-        const auto it = _eventTopics.find(e->type);
+        const std::vector<TopicInfo>& topics =
+            _eventTopics[static_cast<size_t>(e->type)];
 
-        if (it != _eventTopics.end()) {
+        if (!topics.empty()) {
             const ghoul::Dictionary params = toParameter(*e);
-            for (const TopicInfo& ti : it->second) {
+            for (const TopicInfo& ti : topics) {
                 ti.callback(params);
             }
         }
@@ -24,10 +24,13 @@
 
 #include <openspace/interaction/sessionrecording.h>
 
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/glm.h>
 #include <ghoul/misc/assert.h>
 #include <array>
+#include <cstring>
 #include <format>
+#include <fstream>
 #include <optional>
 
 namespace {
@@ -75,12 +78,23 @@ namespace {
     constexpr std::string_view FrameTypeCommentAscii = "#";
     constexpr char FrameTypeCameraBinary = 'c';
     constexpr char FrameTypeScriptBinary = 's';
+    constexpr char FrameTypeIndexBinary = 'i';
 
     // Mapping for version numbers in session recording files
-    constexpr std::array<std::pair<std::string_view, int>, 3> Versions = {
+    constexpr std::array<std::pair<std::string_view, int>, 4> Versions = {
         std::pair("00.85", 0),
         std::pair("01.00", 1),
-        std::pair("02.00", 2)
+        std::pair("02.00", 2),
+        std::pair("03.00", 3)
+    };
+
+    // Starting with version 3, binary files end with an index block that lists the
+    // timestamp and file offset of every entry, followed by this trailer
+    constexpr int FirstIndexedVersion = 3;
+    constexpr std::array<char, 4> IndexTrailerMagic = { 'S', 'R', 'I', 'X' };
+    struct IndexTrailer {
+        uint64_t indexOffset = 0;
+        std::array<char, 4> magic = {};
     };
 
 
@@ -583,6 +597,149 @@ namespace {
     }
 
 
+    //
+    // Indexed binary files
+    //
+
+    // Reads values from a memory-mapped file, making sure that no read goes past the end
+    // of its range
+    class MemoryReader {
+    public:
+        MemoryReader(const std::byte* begin, const std::byte* end)
+            : _ptr(begin)
+            , _end(end)
+        {}
+
+        template <typename T>
+        T read() {
+            T value;
+            std::memcpy(&value, advance(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        std::string readString(size_t length) {
+            const char* data = reinterpret_cast<const char*>(advance(length));
+            return std::string(data, length);
+        }
+
+    private:
+        const std::byte* advance(size_t size) {
+            if (static_cast<size_t>(_end - _ptr) < size) {
+                throw LoadingError("Unexpected end of entry");
+            }
+            const std::byte* result = _ptr;
+            _ptr += size;
+            return result;
+        }
+
+        const std::byte* _ptr;
+        const std::byte* _end;
+    };
+
+    SessionRecording::Entry readIndexedEntry(MemoryReader& reader) {
+        const char frameType = reader.read<char>();
+        SessionRecording::Entry entry = {
+            .timestamp = reader.read<double>(),
+            .simulationTime = reader.read<double>()
+        };
+
+        switch (frameType) {
+            case FrameTypeCameraBinary:
+            {
+                SessionRecording::Entry::Camera camera;
+                const double x = reader.read<double>();
+                const double y = reader.read<double>();
+                const double z = reader.read<double>();
+                camera.position = glm::dvec3(x, y, z);
+
+                std::array<float, 4> r = {};
+                for (float& v : r) {
+                    v = reader.read<float>();
+                }
+                camera.rotation = glm::quat(r[3], r[0], r[1], r[2]);
+
+                camera.followFocusNodeRotation = (reader.read<char>() == 1);
+                const int32_t nodeNameLength = reader.read<int32_t>();
+                if (nodeNameLength < 0) {
+                    throw LoadingError("Negative focus node name length");
+                }
+                camera.focusNode = reader.readString(nodeNameLength);
+                camera.scale = reader.read<float>();
+                entry.value = std::move(camera);
+                break;
+            }
+            case FrameTypeScriptBinary:
+            {
+                const uint32_t scriptLength = reader.read<uint32_t>();
+                entry.value = reader.readString(scriptLength);
+                break;
+            }
+            default:
+                throw LoadingError(std::format("Unrecognized frame '{}'", frameType));
+        }
+        return entry;
+    }
+
+    // Loads all entries of a binary file with an index block. The file is mapped into
+    // memory and every entry is decoded directly from the mapped memory at the offset
+    // that the index provides for it
+    SessionRecording loadIndexedSessionRecording(const std::filesystem::path& filename,
+                                                 size_t headerSize)
+    {
+        const openspace::MemoryMappedFile file = openspace::MemoryMappedFile(filename);
+        const std::byte* begin = file.data();
+        const std::byte* end = begin + file.size();
+
+        if (file.size() < headerSize + sizeof(uint64_t) + IndexTrailerMagic.size()) {
+            throw LoadingError("File too small for an index", filename);
+        }
+
+        MemoryReader trailerReader = MemoryReader(
+            end - sizeof(uint64_t) - IndexTrailerMagic.size(),
+            end
+        );
+        IndexTrailer trailer;
+        trailer.indexOffset = trailerReader.read<uint64_t>();
+        trailer.magic = trailerReader.read<std::array<char, 4>>();
+        if (trailer.magic != IndexTrailerMagic) {
+            throw LoadingError("Missing index trailer", filename);
+        }
+        if (trailer.indexOffset < headerSize || trailer.indexOffset >= file.size()) {
+            throw LoadingError("Index offset out of range", filename);
+        }
+
+        const std::byte* entriesEnd = begin + trailer.indexOffset;
+        MemoryReader indexReader = MemoryReader(entriesEnd, end);
+        if (indexReader.read<char>() != FrameTypeIndexBinary) {
+            throw LoadingError("Index block not found", filename);
+        }
+        const uint64_t nEntries = indexReader.read<uint64_t>();
+
+        SessionRecording sessionRecording;
+        sessionRecording.entries.reserve(nEntries);
+        for (uint64_t i = 0; i < nEntries; i++) {
+            // The timestamp is stored in the index to make it possible to search the
+            // index without decoding entries; here we only need the offset
+            indexReader.read<double>();
+            const uint64_t offset = indexReader.read<uint64_t>();
+            if (offset < headerSize || offset >= trailer.indexOffset) {
+                throw LoadingError(
+                    "Entry offset out of range", filename, static_cast<int>(i + 1)
+                );
+            }
+
+            MemoryReader entryReader = MemoryReader(begin + offset, entriesEnd);
+            try {
+                sessionRecording.entries.push_back(readIndexedEntry(entryReader));
+            }
+            catch (const LoadingError& e) {
+                throw LoadingError(e.error, filename, static_cast<int>(i + 1));
+            }
+        }
+        return sessionRecording;
+    }
+
+
 } // namespace
 
 namespace openspace::interaction {
@@ -607,6 +764,12 @@ SessionRecording loadSessionRecording(const std::filesystem::path& filename) {
     SessionRecording sessionRecording;
 
     Header header = readHeader(file, filename);
+    if (header.dataMode == DataMode::Binary && header.version >= FirstIndexedVersion) {
+        const size_t headerSize = static_cast<size_t>(file.tellg());
+        file.close();
+        return loadIndexedSessionRecording(filename, headerSize);
+    }
+
     while (true) {
         std::optional<SessionRecording::Entry> entry;
         try {
@@ -651,13 +814,45 @@ void saveSessionRecording(const std::filesystem::path& filename,
     };
     writeHeader(file, header);
 
+    // The file offset of each entry in binary files
+    std::vector<uint64_t> offsets;
+    if (dataMode == DataMode::Binary) {
+        offsets.reserve(sessionRecording.entries.size());
+    }
+
     for (const SessionRecording::Entry& entry : sessionRecording.entries) {
+        if (dataMode == DataMode::Binary) {
+            offsets.push_back(static_cast<uint64_t>(file.tellp()));
+        }
+
         writeEntry(file, entry, dataMode);
 
         if (dataMode == DataMode::Ascii) {
             file.write("\n", sizeof(char));
         }
     }
+
+    if (dataMode == DataMode::Binary) {
+        const IndexTrailer trailer = {
+            .indexOffset = static_cast<uint64_t>(file.tellp()),
+            .magic = IndexTrailerMagic
+        };
+
+        file.write(&FrameTypeIndexBinary, sizeof(char));
+        const uint64_t nEntries = offsets.size();
+        file.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
+        for (size_t i = 0; i < offsets.size(); i++) {
+            const double timestamp = sessionRecording.entries[i].timestamp;
+            file.write(reinterpret_cast<const char*>(&timestamp), sizeof(double));
+            file.write(reinterpret_cast<const char*>(&offsets[i]), sizeof(uint64_t));
+        }
+
+        file.write(
+            reinterpret_cast<const char*>(&trailer.indexOffset),
+            sizeof(uint64_t)
+        );
+        file.write(trailer.magic.data(), trailer.magic.size());
+    }
 }
 
 std::vector<ghoul::Dictionary> sessionRecordingToDictionary(
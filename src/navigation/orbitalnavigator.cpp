@@ -243,6 +243,26 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo
+        ApproximateSurfaceQueriesInfo =
+    {
+        "ApproximateSurfaceQueries",
+        "Approximate Surface Queries",
+        "If this value is enabled, the position of the surface below the camera is not "
+        "recomputed while the camera moves quickly compared to its height above the "
+        "surface, as long as the camera stays above approximately the same point. This "
+        "reduces the number of height lookups for globes during fast zooming motions.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The camera is considered to move quickly if it moved by more than this fraction of
+    // its height above the surface of the anchor node in the previous frame
+    constexpr double FastMotionFraction = 0.05;
+
+    // The angle (in radians) by which the direction to the camera may change before the
+    // surface position is recomputed while the camera moves quickly
+    constexpr double ApproximateSurfaceTolerance = 1e-4;
+
     constexpr openspace::properties::Property::PropertyInfo ApplyIdleBehaviorInfo = {
         "ApplyIdleBehavior",
         "Apply Idle Behavior",
@@ -399,7 +419,8 @@ namespace {
      */
     openspace::SurfacePositionHandle calculateSurfacePositionHandle(
                                                     const openspace::SceneGraphNode& node,
-                                               const glm::dvec3& cameraPositionWorldSpace)
+                                               const glm::dvec3& cameraPositionWorldSpace,
+                                                          double directionTolerance = 0.0)
     {
         ghoul_assert(
             glm::length(cameraPositionWorldSpace) > 0.0,
@@ -410,7 +431,10 @@ namespace {
         const glm::dvec3 cameraPositionModelSpace =
             glm::dvec3(inverseModelTransform * glm::dvec4(cameraPositionWorldSpace, 1.0));
         const openspace::SurfacePositionHandle posHandle =
-            node.calculateSurfacePositionHandle(cameraPositionModelSpace);
+            node.calculateSurfacePositionHandle(
+                cameraPositionModelSpace,
+                directionTolerance
+            );
 
         return posHandle;
     }
@@ -513,6 +537,7 @@ OrbitalNavigator::OrbitalNavigator()
     )
     , _staticViewScaleExponent(StaticViewScaleExponentInfo, 0.f, -30, 10)
     , _constantVelocityFlight(ConstantVelocityFlight, false)
+    , _approximateSurfaceQueries(ApproximateSurfaceQueriesInfo, false)
     , _retargetInterpolationTime(RetargetInterpolationTimeInfo, 2.0, 0.0, 10.0)
     , _stereoInterpolationTime(StereoInterpolationTimeInfo, 8.0, 0.0, 10.0)
     , _followRotationInterpolationTime(FollowRotationInterpTimeInfo, 1.0, 0.0, 10.0)
@@ -675,6 +700,7 @@ OrbitalNavigator::OrbitalNavigator()
     addProperty(_useAdaptiveStereoscopicDepth);
     addProperty(_staticViewScaleExponent);
     addProperty(_constantVelocityFlight);
+    addProperty(_approximateSurfaceQueries);
     _stereoscopicDepthOfFocusSurface.setExponent(3.f);
     addProperty(_stereoscopicDepthOfFocusSurface);
 
@@ -862,9 +888,20 @@ void OrbitalNavigator::updateCameraStateFromStates(double deltaTime) {
 
     _previousAnchorNodePosition = _anchorNode->worldPosition();
 
+    // While the camera moves quickly, surface positions from previous frames are good
+    // enough as long as the camera stays above approximately the same point
+    const bool isFastMotion =
+        _previousCameraStep > FastMotionFraction * _previousCameraAltitude;
+    _surfaceQueryTolerance = (_approximateSurfaceQueries && isFastMotion) ?
+        ApproximateSurfaceTolerance :
+        0.0;
+
     // Calculate a position handle based on the camera position in world space
-    SurfacePositionHandle posHandle =
-        calculateSurfacePositionHandle(*_anchorNode, pose.position);
+    SurfacePositionHandle posHandle = calculateSurfacePositionHandle(
+        *_anchorNode,
+        pose.position,
+        _surfaceQueryTolerance
+    );
 
     // Decompose camera rotation so that we can handle global and local rotation
     // individually. Then we combine them again when finished.
@@ -942,7 +979,11 @@ void OrbitalNavigator::updateCameraStateFromStates(double deltaTime) {
     );
 
     // Recalculate posHandle since horizontal position changed
-    posHandle = calculateSurfacePositionHandle(*_anchorNode, pose.position);
+    posHandle = calculateSurfacePositionHandle(
+        *_anchorNode,
+        pose.position,
+        _surfaceQueryTolerance
+    );
 
     // Rotate globally to keep camera rotation fixed
     // in the rotating reference frame of the anchor object
@@ -979,6 +1020,11 @@ void OrbitalNavigator::updateCameraStateFromStates(double deltaTime) {
 
     pose.rotation = composeCameraRotation(camRot);
 
+    _previousCameraStep = glm::distance(pose.position, prevCameraPosition);
+    _previousCameraAltitude = glm::length(
+        cameraToSurfaceVector(pose.position, anchorPos, posHandle)
+    );
+
     _camera->setPose(pose);
 }
 
@@ -994,7 +1040,8 @@ void OrbitalNavigator::updateCameraScalingFromAnchor(double deltaTime) {
 
         const SurfacePositionHandle posHandle = calculateSurfacePositionHandle(
             *_anchorNode,
-            cameraPos
+            cameraPos,
+            _surfaceQueryTolerance
         );
 
         double targetCameraToSurfaceDistance = glm::length(
@@ -1316,8 +1363,10 @@ OrbitalNavigator::CameraRotationDecomposition
     const glm::dvec3 cameraPositionModelSpace = glm::dvec3(inverseModelTransform *
                                                 glm::dvec4(cameraPose.position, 1));
 
-    const SurfacePositionHandle posHandle =
-        reference.calculateSurfacePositionHandle(cameraPositionModelSpace);
+    const SurfacePositionHandle posHandle = reference.calculateSurfacePositionHandle(
+        cameraPositionModelSpace,
+        _surfaceQueryTolerance
+    );
 
     const glm::dvec3 directionFromSurfaceToCameraModelSpace =
         posHandle.referenceSurfaceOutDirection;
@@ -1947,7 +1996,8 @@ void OrbitalNavigator::applyIdleBehavior(double deltaTime, glm::dvec3& position,
 
     const SurfacePositionHandle posHandle = calculateSurfacePositionHandle(
         *_anchorNode,
-        position
+        position,
+        _surfaceQueryTolerance
     );
 
     // Same speed scale as horizontal translation
@@ -225,6 +225,29 @@ CameraPose Path::traversePath(double dt, float speedScale) {
     return newPose;
 }
 
+glm::dvec3 Path::predictedPosition(double dt, float speedScale) const {
+    if (std::isinf(_speedFactorFromDuration) || _shouldQuit) {
+        return _end.position();
+    }
+
+    const double speed = speedAlongPath(_traveledDistance) * speedScale;
+    const double displacement = dt * speed;
+
+    if (_type == Type::Linear) {
+        // Same special handling of linear paths as in traversePath
+        const glm::dvec3 prevPosToEnd = _prevPose.position - _end.position();
+        const double remainingDistance = glm::length(prevPosToEnd);
+        if (displacement >= remainingDistance) {
+            return _end.position();
+        }
+        return _prevPose.position - displacement * glm::normalize(prevPosToEnd);
+    }
+    else {
+        const double distance = std::min(_traveledDistance + displacement, pathLength());
+        return interpolatedPose(distance).position;
+    }
+}
+
 void Path::quitPath() {
     _traveledDistance = pathLength();
     _shouldQuit = true;
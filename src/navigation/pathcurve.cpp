@@ -71,65 +71,66 @@ void PathCurve::initializeParameterData() {
     _lengthSums.clear();
     _parameterSamples.clear();
 
-    const double max = static_cast<double>(_nSegments);
-
     // Evenly space out parameter intervals
     _curveParameterSteps.reserve(_nSegments + 1);
     for (unsigned int i = 0; i <= _nSegments; i++) {
         _curveParameterSteps.push_back(static_cast<double>(i));
     }
 
-    // Arc lengths
-    _lengthSums.reserve(_nSegments + 1);
-    _lengthSums.push_back(0.0);
-    for (unsigned int i = 1; i <= _nSegments; i++) {
-        const double u = _curveParameterSteps[i];
-        const double uPrev = _curveParameterSteps[i - 1];
-        const double length = arcLength(uPrev, u);
-        _lengthSums.push_back(_lengthSums[i - 1] + length);
-    }
-    _totalLength = _lengthSums.back();
-
-    if (_totalLength < LengthEpsilon) {
-        throw TooShortPathError("Path too short");
-    }
-
-    // Compute a map of arc lengths s and curve parameters u, for reparameterization
+    // Compute a map of arc lengths s and curve parameters u, for reparameterization.
+    // Each sample is integrated from the previous one, so the arc length of a sample
+    // and of the segments are sums over short intervals and are as accurate as the
+    // lookups that are based on them in `curveParameter`
     constexpr int Steps = 100;
     const double uStep = 1.0 / static_cast<double>(Steps);
     _parameterSamples.reserve(Steps * _nSegments + 1);
+    _lengthSums.reserve(_nSegments + 1);
+    _lengthSums.push_back(0.0);
+    _parameterSamples.push_back({ 0.0, 0.0 });
 
+    bool hasInsufficientPrecision = false;
     for (unsigned int i = 0; i < _nSegments; i++) {
         const double uStart = _curveParameterSteps[i];
-        const double sStart = _lengthSums[i];
-        _parameterSamples.push_back({ uStart, sStart });
-        // Intermediate sampels
+        double uPrev = uStart;
+        double s = _lengthSums[i];
+        // Intermediate samples
         for (int j = 1; j < Steps; j++) {
             const double u = uStart + j * uStep;
-            const double s = sStart + arcLength(uStart, u);
+            const double sPrev = s;
+            s += arcLength(uPrev, u);
+            uPrev = u;
             // Identify samples that are indistinguishable due to precision limitations
-            if (std::abs(s - _parameterSamples.back().s) < LengthEpsilon) {
-                throw InsufficientPrecisionError(
-                    "Insufficient precision due to path length"
-                );
-            }
+            hasInsufficientPrecision |= std::abs(s - sPrev) < LengthEpsilon;
             _parameterSamples.push_back({ u, s });
         }
-    }
 
-    // Remove the very last sample if indistinguishable from the final one
-    const double diff = std::abs(_totalLength - _parameterSamples.back().s);
-    if (diff < LengthEpsilon) {
-        _parameterSamples.pop_back();
+        s += arcLength(uPrev, _curveParameterSteps[i + 1]);
+        // Replace the last intermediate sample if it is indistinguishable from the end
+        // of the segment
+        if (std::abs(s - _parameterSamples.back().s) < LengthEpsilon) {
+            _parameterSamples.pop_back();
+        }
+        _lengthSums.push_back(s);
+        _parameterSamples.push_back({ _curveParameterSteps[i + 1], s });
     }
+    _totalLength = _lengthSums.back();
 
-    _parameterSamples.push_back({ max, _totalLength });
+    if (_totalLength < LengthEpsilon) {
+        throw TooShortPathError("Path too short");
+    }
+    if (hasInsufficientPrecision) {
+        throw InsufficientPrecisionError("Insufficient precision due to path length");
+    }
     _parameterSamples.shrink_to_fit();
 }
 
 // Compute the curve parameter from an arc length value, using a combination of
 // Newton's method and bisection. Source:
 // https://www.geometrictools.com/Documentation/MovingAlongCurveSpecifiedSpeed.pdf
+// The precomputed samples are used to find the interval that contains the parameter,
+// and the root is only searched within that interval, starting from the linearly
+// interpolated guess. As the interval is short, the arc length integrals are cheap to
+// evaluate and the method usually converges within one or two iterations.
 // Input s is a length value, in the range [0, _totalLength]
 // Returns curve parameter in range [0, _nSegments]
 double PathCurve::curveParameter(double s) const {
@@ -140,40 +141,18 @@ double PathCurve::curveParameter(double s) const {
         return _curveParameterSteps.back();
     }
 
-    unsigned int segmentIndex = 1;
-    while (s > _lengthSums[segmentIndex]) {
-        segmentIndex++;
-    }
-
-    const double segmentS = s - _lengthSums[segmentIndex - 1];
-    const double uMin = _curveParameterSteps[segmentIndex - 1];
-    const double uMax = _curveParameterSteps[segmentIndex];
-
-    // Find sample indices corresponding to the selected sample
-    auto findIndexOfFirstEqualOrLarger_u = [&samples = _parameterSamples](double value) {
-        auto it = std::lower_bound(
-            samples.begin(),
-            samples.end(),
-            ParameterPair{ value, 0.0 }, // 0.0 is a dummy value for s
-            [](const ParameterPair& lhs, const ParameterPair& rhs) {
-                return lhs.u < rhs.u;
-            }
-        );
-        return std::distance(samples.begin(), it);
-    };
-
-    const size_t startIndex = findIndexOfFirstEqualOrLarger_u(uMin);
-    const size_t endIndex = findIndexOfFirstEqualOrLarger_u(uMax);
-
-    // Use samples to find an initial guess for Newton's method
-    // Find first sample with s larger than input s
+    // Find first sample with s larger than input s. The first sample is at s = 0 and the
+    // last one at the total length, so the sample and its predecessor always exist
     auto sampleIterator = std::upper_bound(
-        _parameterSamples.begin() + startIndex,
-        _parameterSamples.begin() + endIndex,
-        ParameterPair{ 0.0 , s }, // 0.0 is a dummy value for u
-        [](const ParameterPair& lhs, const ParameterPair& rhs) {
-            return lhs.s < rhs.s;
-        }
+        _parameterSamples.begin(),
+        _parameterSamples.end(),
+        s,
+        [](double value, const ParameterPair& sample) { return value < sample.s; }
+    );
+    ghoul_assert(
+        sampleIterator != _parameterSamples.begin() &&
+        sampleIterator != _parameterSamples.end(),
+        "Arc length outside of sampled range"
     );
 
     const ParameterPair& sample = *sampleIterator;
@@ -186,11 +165,11 @@ double PathCurve::curveParameter(double s) const {
     constexpr int maxIterations = 50;
 
     // Initialize root bounding limits for bisection
-    double lower = uMin;
-    double upper = uMax;
+    double lower = uPrev;
+    double upper = sample.u;
 
     for (int i = 0; i < maxIterations; i++) {
-        const double F = arcLength(uMin, u) - segmentS;
+        const double F = sPrev + arcLength(uPrev, u) - s;
 
         // The error we tolerate, in meters. Note that distances are very large
         constexpr double tolerance = 0.5;
@@ -214,7 +193,7 @@ double PathCurve::curveParameter(double s) const {
     }
 
     // No root was found based on the number of iterations and tolerance. However, it is
-    // safe to report the last computed u value, since it is within the segment interval
+    // safe to report the last computed u value, since it is within the sample interval
     return u;
 }
 
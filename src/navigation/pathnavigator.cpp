@@ -214,6 +214,13 @@ float PathNavigator::estimatedRemainingTimeInPath() const {
     return hasCurrentPath() ? _currentPath->estimatedRemainingTime(_speedScale) : 0.f;
 }
 
+std::optional<glm::dvec3> PathNavigator::predictedCameraPosition(double dt) const {
+    if (!isPlayingPath() || hasFinished()) {
+        return std::nullopt;
+    }
+    return _currentPath->predictedPosition(dt, _speedScale);
+}
+
 void PathNavigator::updateCamera(double deltaTime) {
     ghoul_assert(camera() != nullptr, "Camera must not be nullptr");
 
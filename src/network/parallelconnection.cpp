@@ -29,6 +29,7 @@
 #include <ghoul/format.h>
 #include <ghoul/io/socket/tcpsocket.h>
 #include <ghoul/logging/logmanager.h>
+#include <array>
 
 namespace {
     constexpr std::string_view _loggerCat = "ParallelConnection";
@@ -43,10 +44,10 @@ ParallelConnection::Message::Message(MessageType t, std::vector<char> c)
 
 ParallelConnection::DataMessage::DataMessage(datamessagestructures::Type t,
                                              double time,
-                                             std::vector<char> c)
+                                             std::span<const char> c)
     : type(t)
     , timestamp(time)
-    , content(std::move(c))
+    , content(c)
 {}
 
 ParallelConnection::ConnectionLostError::ConnectionLostError(bool shouldLogError_)
@@ -66,57 +67,45 @@ void ParallelConnection::sendDataMessage(const DataMessage& dataMessage) {
     const uint8_t dataMessageTypeOut = static_cast<uint8_t>(dataMessage.type);
     const double dataMessageTimestamp = dataMessage.timestamp;
 
-    std::vector<char> messageContent;
-    messageContent.insert(
-        messageContent.end(),
-        reinterpret_cast<const char*>(&dataMessageTypeOut),
-        reinterpret_cast<const char*>(&dataMessageTypeOut) + sizeof(uint8_t)
-    );
-
-    messageContent.insert(
-        messageContent.end(),
-        reinterpret_cast<const char*>(&dataMessageTimestamp),
-        reinterpret_cast<const char*>(&dataMessageTimestamp) + sizeof(double)
-    );
-
-    messageContent.insert(messageContent.end(),
-        dataMessage.content.begin(),
-        dataMessage.content.end()
-    );
+    // The data type and timestamp are written directly in front of the payload, so the
+    // whole message is assembled in the send buffer without any intermediate copies
+    const size_t contentSize =
+        sizeof(uint8_t) + sizeof(double) + dataMessage.content.size();
+    beginMessage(MessageType::Data, static_cast<uint32_t>(contentSize));
+    appendToMessage(&dataMessageTypeOut, sizeof(uint8_t));
+    appendToMessage(&dataMessageTimestamp, sizeof(double));
+    appendToMessage(dataMessage.content.data(), dataMessage.content.size());
 
-    sendMessage(Message(MessageType::Data, messageContent));
+    _socket->put<char>(_sendBuffer.data(), _sendBuffer.size());
 }
 
 bool ParallelConnection::sendMessage(const Message& message) {
-    const uint8_t messageTypeOut = static_cast<uint8_t>(message.type);
-    const uint32_t messageSizeOut = static_cast<uint32_t>(message.content.size());
-    std::vector<char> header;
-
-    //insert header into buffer
-    header.push_back('O');
-    header.push_back('S');
+    beginMessage(message.type, static_cast<uint32_t>(message.content.size()));
+    appendToMessage(message.content.data(), message.content.size());
+    return _socket->put<char>(_sendBuffer.data(), _sendBuffer.size());
+}
 
-    header.insert(header.end(),
-        reinterpret_cast<const char*>(&ProtocolVersion),
-        reinterpret_cast<const char*>(&ProtocolVersion) + sizeof(uint8_t)
-    );
+void ParallelConnection::beginMessage(MessageType type, uint32_t contentSize) {
+    const uint8_t messageTypeOut = static_cast<uint8_t>(type);
 
-    header.insert(header.end(),
-        reinterpret_cast<const char*>(&messageTypeOut),
-        reinterpret_cast<const char*>(&messageTypeOut) + sizeof(uint8_t)
+    // clear() keeps the capacity, so this only allocates if the message is bigger than
+    // any message that has been sent before
+    _sendBuffer.clear();
+    _sendBuffer.reserve(
+        2 * sizeof(char) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint32_t) +
+        contentSize
     );
 
-    header.insert(header.end(),
-        reinterpret_cast<const char*>(&messageSizeOut),
-        reinterpret_cast<const char*>(&messageSizeOut) + sizeof(uint32_t)
-    );
+    _sendBuffer.push_back('O');
+    _sendBuffer.push_back('S');
+    appendToMessage(&ProtocolVersion, sizeof(uint8_t));
+    appendToMessage(&messageTypeOut, sizeof(uint8_t));
+    appendToMessage(&contentSize, sizeof(uint32_t));
+}
 
-    const bool res = _socket->put<char>(header.data(), header.size());
-    if (!res) {
-        return false;
-    }
-    const bool res2 = _socket->put<char>(message.content.data(), message.content.size());
-    return res2;
+void ParallelConnection::appendToMessage(const void* data, size_t size) {
+    const char* begin = reinterpret_cast<const char*>(data);
+    _sendBuffer.insert(_sendBuffer.end(), begin, begin + size);
 }
 
 void ParallelConnection::disconnect() {
@@ -139,7 +128,7 @@ ParallelConnection::Message ParallelConnection::receiveMessage() {
         sizeof(uint32_t);  // message size
 
     // Create basic buffer for receiving first part of messages
-    std::vector<char> headerBuffer(HeaderSize);
+    std::array<char, HeaderSize> headerBuffer;
     std::vector<char> messageBuffer;
 
     // Receive the header data
@@ -193,7 +182,7 @@ ParallelConnection::Message ParallelConnection::receiveMessage() {
     }
 
     // And delegate decoding depending on type
-    return Message(static_cast<MessageType>(messageTypeIn), messageBuffer);
+    return Message(static_cast<MessageType>(messageTypeIn), std::move(messageBuffer));
 }
 
 } // namespace openspace
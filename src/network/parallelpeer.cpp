@@ -44,6 +44,20 @@
 
 namespace {
     constexpr size_t MaxLatencyDiffs = 64;
+
+    // The camera movement relative to its distance to the focus node and the rotation in
+    // radians below which the adaptive camera keyframes are skipped
+    constexpr double MinCameraMovement = 1e-5;
+    constexpr double MinCameraRotation = 1e-4;
+    // The movement and rotation per keyframe above which the camera is considered to
+    // move fast, in which case keyframes are sent more often
+    constexpr double FastCameraMovement = 0.01;
+    constexpr double FastCameraRotation = 0.02;
+    constexpr float FastCameraRateFactor = 4.f;
+    // Even a still camera is sent this often (in seconds), so that the clients that join
+    // the session get the camera position, as is the focus node
+    constexpr double MaxCameraKeyframeInterval = 1.0;
+    constexpr double FocusNodeInterval = 5.0;
     constexpr std::string_view _loggerCat = "ParallelPeer";
 
     constexpr openspace::properties::Property::PropertyInfo PasswordInfo = {
@@ -119,6 +133,34 @@ namespace {
         "time, but also more internet traffic.",
         openspace::properties::Property::Visibility::AdvancedUser
     };
+
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveCameraKeyframesInfo =
+    {
+        "AdaptiveCameraKeyframes",
+        "Adaptive Camera Keyframes",
+        "If enabled, camera keyframes are skipped while the camera is not moving and are "
+        "sent more often than the keyframe interval while it moves fast. The keyframes "
+        "also use a compact encoding that quantizes the rotation and only contains the "
+        "focus node when it has changed.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    struct CameraMovement {
+        double movement = 0.0;
+        double rotation = 0.0;
+    };
+
+    using openspace::datamessagestructures::CameraKeyframe;
+    CameraMovement cameraMovement(const CameraKeyframe& a, const CameraKeyframe& b) {
+        const double distance = std::max(glm::length(a._position), 1.0);
+        const double dot = std::min(std::abs(glm::dot(a._rotation, b._rotation)), 1.0);
+        const double scale = std::abs(a._scale - b._scale) / std::max(a._scale, 1e-30f);
+        const double movement = glm::distance(a._position, b._position) / distance;
+        return {
+            .movement = std::max(movement, scale),
+            .rotation = 2.0 * std::acos(dot)
+        };
+    }
 } // namespace
 
 namespace openspace {
@@ -134,6 +176,7 @@ ParallelPeer::ParallelPeer()
     , _bufferTime(BufferTimeInfo, 0.2f, 0.01f, 5.0f)
     , _timeKeyframeInterval(TimeKeyFrameInfo, 0.1f, 0.f, 1.f)
     , _cameraKeyframeInterval(CameraKeyFrameInfo, 0.1f, 0.f, 1.f)
+    , _adaptiveCameraKeyframes(AdaptiveCameraKeyframesInfo, true)
     , _connectionEvent(std::make_shared<ghoul::Event<>>())
     , _connection(nullptr)
 {
@@ -148,6 +191,7 @@ ParallelPeer::ParallelPeer()
 
     addProperty(_timeKeyframeInterval);
     addProperty(_cameraKeyframeInterval);
+    addProperty(_adaptiveCameraKeyframes);
 }
 
 ParallelPeer::~ParallelPeer() {
@@ -269,8 +313,7 @@ void ParallelPeer::sendAuthentication() {
 }
 
 void ParallelPeer::queueInMessage(const ParallelConnection::Message& message) {
-    const std::lock_guard unqlock(_receiveBufferMutex);
-    _receiveBuffer.push_back(message);
+    _receiveBuffer.push(message);
 }
 
 void ParallelPeer::handleMessage(const ParallelConnection::Message& message) {
@@ -343,8 +386,30 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message) {
 
     const std::vector<char> buffer(message.begin() + offset, message.end());
     switch (static_cast<datamessagestructures::Type>(type)) {
-        case datamessagestructures::Type::CameraData: {
-            const datamessagestructures::CameraKeyframe kf(buffer);
+        case datamessagestructures::Type::CameraData:
+        case datamessagestructures::Type::CompactCameraData: {
+            datamessagestructures::CameraKeyframe kf;
+            if (static_cast<datamessagestructures::Type>(type) ==
+                datamessagestructures::Type::CameraData)
+            {
+                kf = datamessagestructures::CameraKeyframe(buffer);
+            }
+            else {
+                const datamessagestructures::CompactCameraKeyframe compact(buffer);
+                if (!compact._focusNode.empty()) {
+                    _receivedFocusNode = compact._focusNode;
+                }
+                if (_receivedFocusNode.empty()) {
+                    // The keyframes cannot be used until the focus node has arrived
+                    break;
+                }
+                kf._position = compact._position;
+                kf._rotation = compact._rotation;
+                kf._followNodeRotation = compact._followNodeRotation;
+                kf._focusNode = _receivedFocusNode;
+                kf._scale = compact._scale;
+                kf._timestamp = compact._timestamp;
+            }
             const double convertedTimestamp = convertTimestamp(kf._timestamp);
 
             global::navigationHandler->keyframeNavigator().removeKeyframesAfter(
@@ -562,14 +627,14 @@ void ParallelPeer::sendScript(std::string script) {
     datamessagestructures::ScriptMessage sm;
     sm._script = std::move(script);
 
-    std::vector<char> buffer;
-    sm.serialize(buffer);
+    _sendBuffer.clear();
+    sm.serialize(_sendBuffer);
 
     const double timestamp = global::windowDelegate->applicationTime();
     const ParallelConnection::DataMessage message = ParallelConnection::DataMessage(
         datamessagestructures::Type::ScriptData,
         timestamp,
-        buffer
+        _sendBuffer
     );
     _connection.sendDataMessage(message);
 }
@@ -584,17 +649,17 @@ void ParallelPeer::resetTimeOffset() {
 void ParallelPeer::preSynchronization() {
     ZoneScoped;
 
-    const std::unique_lock unlock(_receiveBufferMutex);
-    while (!_receiveBuffer.empty()) {
-        const ParallelConnection::Message& message = _receiveBuffer.front();
-        handleMessage(message);
-        _receiveBuffer.pop_front();
+    while (std::optional<ParallelConnection::Message> message = _receiveBuffer.pop()) {
+        handleMessage(*message);
     }
 
     if (isHost()) {
         const double now = global::windowDelegate->applicationTime();
 
-        if (_lastCameraKeyframeTimestamp + _cameraKeyframeInterval < now) {
+        const float interval = _isCameraMovingFast ?
+            _cameraKeyframeInterval / FastCameraRateFactor :
+            _cameraKeyframeInterval;
+        if (_lastCameraKeyframeTimestamp + interval < now) {
             sendCameraKeyframe();
             _lastCameraKeyframeTimestamp = now;
         }
@@ -619,6 +684,11 @@ void ParallelPeer::setStatus(ParallelConnection::Status status) {
         _timeJumped = true;
         _connectionEvent->publish("statusChanged");
 
+        // The adaptive camera keyframes start over with a full keyframe
+        _lastSentCameraKeyframe = std::nullopt;
+        _skippedCameraKeyframe = std::nullopt;
+        _receivedFocusNode.clear();
+
 
         EventEngine* ee = global::eventEngine;
         const bool isConnected =
@@ -691,6 +761,9 @@ void ParallelPeer::setNConnections(size_t nConnections) {
     if (_nConnections != nConnections) {
         _nConnections = nConnections;
         _connectionEvent->publish("nConnectionsChanged");
+
+        // A peer that has just joined needs the focus node with the next keyframe
+        _lastSentCameraKeyframe = std::nullopt;
     }
 }
 
@@ -741,18 +814,72 @@ void ParallelPeer::sendCameraKeyframe() {
     // Timestamp as current runtime of OpenSpace instance
     kf._timestamp = global::windowDelegate->applicationTime();
 
-    // Create a buffer for the keyframe
-    std::vector<char> buffer;
+    if (_adaptiveCameraKeyframes) {
+        const datamessagestructures::CameraKeyframe* last =
+            _lastSentCameraKeyframe.has_value() ? &*_lastSentCameraKeyframe : nullptr;
+        const bool hasFocusChanged = !last || last->_focusNode != kf._focusNode ||
+            last->_followNodeRotation != kf._followNodeRotation;
+        const CameraMovement m = last ? cameraMovement(*last, kf) : CameraMovement();
+
+        if (last && !hasFocusChanged && m.movement < MinCameraMovement &&
+            m.rotation < MinCameraRotation &&
+            kf._timestamp - last->_timestamp < MaxCameraKeyframeInterval)
+        {
+            // The keyframe is only remembered, so that the clients can be given the
+            // time at which the camera started to move again
+            _skippedCameraKeyframe = kf;
+            _isCameraMovingFast = false;
+            return;
+        }
+
+        if (_skippedCameraKeyframe.has_value()) {
+            sendCompactCameraKeyframe(*_skippedCameraKeyframe);
+            _skippedCameraKeyframe = std::nullopt;
+        }
+        _isCameraMovingFast = !hasFocusChanged &&
+            (m.movement > FastCameraMovement || m.rotation > FastCameraRotation);
+        sendCompactCameraKeyframe(kf);
+        return;
+    }
 
-    // Fill the keyframe buffer
-    kf.serialize(buffer);
+    // Reuse the send buffer; clear() keeps its capacity from the previous keyframe
+    _sendBuffer.clear();
+    kf.serialize(_sendBuffer);
 
     const double timestamp = global::windowDelegate->applicationTime();
     // Send message
     _connection.sendDataMessage(ParallelConnection::DataMessage(
         datamessagestructures::Type::CameraData,
         timestamp,
-        buffer
+        _sendBuffer
+    ));
+}
+
+void ParallelPeer::sendCompactCameraKeyframe(
+                                          const datamessagestructures::CameraKeyframe& kf)
+{
+    datamessagestructures::CompactCameraKeyframe compact;
+    compact._position = kf._position;
+    compact._rotation = kf._rotation;
+    compact._followNodeRotation = kf._followNodeRotation;
+    compact._scale = kf._scale;
+    compact._timestamp = kf._timestamp;
+
+    const bool hasFocusChanged = !_lastSentCameraKeyframe.has_value() ||
+        _lastSentCameraKeyframe->_focusNode != kf._focusNode;
+    if (hasFocusChanged || kf._timestamp - _lastFocusNodeTimestamp > FocusNodeInterval) {
+        compact._focusNode = kf._focusNode;
+        _lastFocusNodeTimestamp = kf._timestamp;
+    }
+    _lastSentCameraKeyframe = kf;
+
+    _sendBuffer.clear();
+    compact.serialize(_sendBuffer);
+
+    _connection.sendDataMessage(ParallelConnection::DataMessage(
+        datamessagestructures::Type::CompactCameraData,
+        global::windowDelegate->applicationTime(),
+        _sendBuffer
     ));
 }
 
@@ -791,18 +918,16 @@ void ParallelPeer::sendTimeTimeline() {
         kfMessage._requiresTimeJump = _timeJumped;
         timelineMessage._keyframes.push_back(kfMessage);
     }
-    // Create a buffer for the keyframe
-    std::vector<char> buffer;
-
-    // Fill the timeline buffer
-    timelineMessage.serialize(buffer);
+    // Fill the reused send buffer with the timeline
+    _sendBuffer.clear();
+    timelineMessage.serialize(_sendBuffer);
 
     const double timestamp = global::windowDelegate->applicationTime();
     // Send message
     _connection.sendDataMessage(ParallelConnection::DataMessage(
         datamessagestructures::Type::TimelineData,
         timestamp,
-        buffer
+        _sendBuffer
     ));
 }
 
@@ -30,6 +30,7 @@
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/misc/dictionaryjsonformatter.h>
 #include <algorithm>
+#include <deque>
 
 namespace {
     constexpr std::string_view MetaDataKeyGroup = "Group";
@@ -43,6 +44,11 @@ namespace {
     constexpr std::string_view TypeKey = "Type";
     constexpr std::string_view MetaDataKey = "MetaData";
     constexpr std::string_view AdditionalDataKey = "AdditionalData";
+
+    // The number of active batches of property changes and the Propertys whose change
+    // notifications were deferred by them, in the order in which they first changed
+    thread_local int ChangeBatchDepth = 0;
+    thread_local std::deque<openspace::properties::Property*> PendingNotifications;
 } // namespace
 
 namespace openspace::properties {
@@ -69,6 +75,9 @@ Property::Property(PropertyInfo info)
 }
 
 Property::~Property() {
+    if (_hasPendingNotification) {
+        std::erase(PendingNotifications, this);
+    }
     notifyDeleteListeners();
 }
 
@@ -239,11 +248,50 @@ void Property::setPropertyOwner(PropertyOwner* owner) {
 }
 
 void Property::notifyChangeListeners() {
+    if (ChangeBatchDepth > 0) {
+        if (!_hasPendingNotification && !_onChangeCallbacks.empty()) {
+            _hasPendingNotification = true;
+            PendingNotifications.push_back(this);
+        }
+        return;
+    }
+
+    invokeChangeListeners();
+}
+
+void Property::invokeChangeListeners() {
     for (const std::pair<OnChangeHandle, std::function<void()>>& p : _onChangeCallbacks) {
         p.second();
     }
 }
 
+void Property::beginChangeBatch() {
+    ChangeBatchDepth++;
+}
+
+void Property::endChangeBatch() {
+    ghoul_precondition(ChangeBatchDepth > 0, "No batch of property changes is active");
+
+    ChangeBatchDepth--;
+    if (ChangeBatchDepth > 0) {
+        return;
+    }
+
+    // The callbacks might change other Propertys, which will inform their listeners
+    // immediately, or destroy Propertys that are still pending, which will remove them
+    // from the list
+    while (!PendingNotifications.empty()) {
+        Property* prop = PendingNotifications.front();
+        PendingNotifications.pop_front();
+        prop->_hasPendingNotification = false;
+        prop->invokeChangeListeners();
+    }
+}
+
+int Property::changeBatchDepth() {
+    return ChangeBatchDepth;
+}
+
 void Property::notifyDeleteListeners() {
     for (const std::pair<OnDeleteHandle, std::function<void()>>& p : _onDeleteCallbacks) {
         p.second();
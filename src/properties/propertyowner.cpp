@@ -34,6 +34,7 @@
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/invariants.h>
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 
 namespace {
@@ -57,6 +58,10 @@ namespace {
             global::eventEngine->publishEvent<events::EventPropertyTreePruned>(uri);
         }
     }
+
+    // Incremented whenever the property tree changes in a way that can change the result
+    // of a URI or tag search
+    std::atomic<uint64_t> StructureGeneration = 0;
 } // namespace
 
 namespace openspace::properties {
@@ -77,8 +82,11 @@ PropertyOwner::PropertyOwner(PropertyOwnerInfo info)
 }
 
 PropertyOwner::~PropertyOwner() {
+    StructureGeneration++;
     _properties.clear();
     _subOwners.clear();
+    _propertyIndex.clear();
+    _subOwnerIndex.clear();
 }
 
 const std::vector<Property*>& PropertyOwner::properties() const {
@@ -96,59 +104,52 @@ std::vector<Property*> PropertyOwner::propertiesRecursive() const {
     return props;
 }
 
-Property* PropertyOwner::property(const std::string& uri) const {
-    auto it = std::find_if(
-        _properties.begin(),
-        _properties.end(),
-        [&uri](Property* prop) { return prop->identifier() == uri; }
-    );
+Property* PropertyOwner::property(std::string_view uri) const {
+    const PropertyOwner* owner = this;
+    while (true) {
+        auto it = owner->_propertyIndex.find(uri);
+        if (it != owner->_propertyIndex.end()) {
+            return it->second;
+        }
 
-    if (it == _properties.end() || (*it)->identifier() != uri) {
         // if we do not own the searched property, it must consist of a concatenated
         // name and we can delegate it to a subowner
         const size_t ownerSeparator = uri.find(URISeparator);
-        if (ownerSeparator == std::string::npos) {
+        if (ownerSeparator == std::string_view::npos) {
             // if we do not own the property and there is no separator, it does not exist
             return nullptr;
         }
-        else {
-            const std::string ownerName = uri.substr(0, ownerSeparator);
-            const std::string propertyName = uri.substr(ownerSeparator + 1);
-
-            PropertyOwner* owner = propertySubOwner(ownerName);
-            if (!owner) {
-                return nullptr;
-            }
-            else {
-                // Recurse into the subOwner
-                return owner->property(propertyName);
-            }
+
+        owner = owner->propertySubOwner(uri.substr(0, ownerSeparator));
+        if (!owner) {
+            return nullptr;
         }
-    }
-    else {
-        return *it;
+        uri.remove_prefix(ownerSeparator + 1);
     }
 }
 
-PropertyOwner* PropertyOwner::propertyOwner(const std::string& uri) const {
-    PropertyOwner* directChild = propertySubOwner(uri);
-    if (directChild) {
-        return directChild;
-    }
+PropertyOwner* PropertyOwner::propertyOwner(std::string_view uri) const {
+    const PropertyOwner* owner = this;
+    while (true) {
+        PropertyOwner* directChild = owner->propertySubOwner(uri);
+        if (directChild) {
+            return directChild;
+        }
 
-    // If we do not own the searched PropertyOwner, it must consist of a concatenated
-    // name and we can delegate it to a subowner
-    const size_t ownerSeparator = uri.find(URISeparator);
-    if (ownerSeparator == std::string::npos) {
-        // if we do not own the PropertyOwner and there is no separator, it does not exist
-        return nullptr;
-    }
-    else {
-        const std::string parentName = uri.substr(0, ownerSeparator);
-        const std::string ownerName = uri.substr(ownerSeparator + 1);
+        // If we do not own the searched PropertyOwner, it must consist of a concatenated
+        // name and we can delegate it to a subowner
+        const size_t ownerSeparator = uri.find(URISeparator);
+        if (ownerSeparator == std::string_view::npos) {
+            // if we do not own the PropertyOwner and there is no separator, it does not
+            // exist
+            return nullptr;
+        }
 
-        PropertyOwner* owner = propertySubOwner(parentName);
-        return owner ? owner->propertyOwner(ownerName) : nullptr;
+        owner = owner->propertySubOwner(uri.substr(0, ownerSeparator));
+        if (!owner) {
+            return nullptr;
+        }
+        uri.remove_prefix(ownerSeparator + 1);
     }
 }
 
@@ -170,40 +171,27 @@ std::string PropertyOwner::uri() const {
     return "";
 }
 
-bool PropertyOwner::hasProperty(const std::string& uri) const {
+bool PropertyOwner::hasProperty(std::string_view uri) const {
     return property(uri) != nullptr;
 }
 
 bool PropertyOwner::hasProperty(const Property* prop) const {
     ghoul_precondition(prop != nullptr, "prop must not be nullptr");
 
-    std::vector<Property*>::const_iterator it = std::find(
-        _properties.begin(), _properties.end(), prop
-    );
-
-    return it != _properties.end();
+    auto it = _propertyIndex.find(prop->identifier());
+    return it != _propertyIndex.end() && it->second == prop;
 }
 
 const std::vector<PropertyOwner*>& PropertyOwner::propertySubOwners() const {
     return _subOwners;
 }
 
-PropertyOwner* PropertyOwner::propertySubOwner(const std::string& identifier) const {
-    std::vector<PropertyOwner*>::const_iterator it = std::find_if(
-        _subOwners.begin(),
-        _subOwners.end(),
-        [&identifier](PropertyOwner* owner) { return owner->identifier() == identifier; }
-    );
-
-    if (it == _subOwners.end() || (*it)->identifier() != identifier) {
-        return nullptr;
-    }
-    else {
-        return *it;
-    }
+PropertyOwner* PropertyOwner::propertySubOwner(std::string_view identifier) const {
+    auto it = _subOwnerIndex.find(identifier);
+    return it != _subOwnerIndex.end() ? it->second : nullptr;
 }
 
-bool PropertyOwner::hasPropertySubOwner(const std::string& identifier) const {
+bool PropertyOwner::hasPropertySubOwner(std::string_view identifier) const {
     return propertySubOwner(identifier) != nullptr;
 }
 
@@ -230,15 +218,8 @@ void PropertyOwner::addProperty(Property* prop) {
         LERROR("No property identifier specified");
         return;
     }
-    // See if we can find the identifier of the property to add in the properties list
-    std::vector<Property*>::const_iterator it = std::find_if(
-        _properties.begin(),
-        _properties.end(),
-        [id = prop->identifier()](Property* p) { return p->identifier() == id; }
-    );
-
     // If we found the property identifier, we need to bail out
-    if (it != _properties.end() && (*it)->identifier() == prop->identifier()) {
+    if (_propertyIndex.contains(prop->identifier())) {
         LERROR(std::format(
             "Property identifier '{}' already present in PropertyOwner '{}'",
             prop->identifier(),
@@ -258,6 +239,8 @@ void PropertyOwner::addProperty(Property* prop) {
         }
         else {
             _properties.push_back(prop);
+            _propertyIndex[prop->identifier()] = prop;
+            StructureGeneration++;
             prop->setPropertyOwner(this);
 
             // Notify change so we can update the UI
@@ -279,17 +262,8 @@ void PropertyOwner::addPropertySubOwner(openspace::properties::PropertyOwner* ow
         "PropertyOwner must have an identifier"
     );
 
-    // See if we can find the name of the propertyowner to add using the lower bound
-    std::vector<PropertyOwner*>::const_iterator it = std::find_if(
-        _subOwners.begin(),
-        _subOwners.end(),
-        [identifier = owner->identifier()](PropertyOwner* o) {
-            return o->identifier() == identifier;
-        }
-    );
-
     // If we found the propertyowner's name, we need to bail out
-    if (it != _subOwners.end() && (*it)->identifier() == owner->identifier()) {
+    if (_subOwnerIndex.contains(owner->identifier())) {
         LERROR(std::format(
             "PropertyOwner '{}' already present in PropertyOwner '{}'",
             owner->identifier(),
@@ -308,6 +282,8 @@ void PropertyOwner::addPropertySubOwner(openspace::properties::PropertyOwner* ow
         }
         else {
             _subOwners.push_back(owner);
+            _subOwnerIndex[owner->identifier()] = owner;
+            StructureGeneration++;
             owner->setPropertyOwner(this);
 
             // Notify change so UI gets updated
@@ -323,20 +299,18 @@ void PropertyOwner::addPropertySubOwner(openspace::properties::PropertyOwner& ow
 void PropertyOwner::removeProperty(Property* prop) {
     ghoul_precondition(prop != nullptr, "prop must not be nullptr");
 
-    // See if we can find the identifier of the property to add in the properties list
-    std::vector<Property*>::const_iterator it = std::find_if(
-        _properties.begin(),
-        _properties.end(),
-        [id = prop->identifier()](Property* p) { return p->identifier() == id; }
-    );
-
     // If we found the property identifier, we can delete it
-    if (it != _properties.end() && (*it)->identifier() == prop->identifier()) {
+    auto it = _propertyIndex.find(prop->identifier());
+    if (it != _propertyIndex.end()) {
+        Property* p = it->second;
+
         // Notify change so we can update the UI
-        publishPropertyTreePrunedEvent(prop->uri());
+        publishPropertyTreePrunedEvent(p->uri());
 
-        (*it)->setPropertyOwner(nullptr);
-        _properties.erase(it);
+        p->setPropertyOwner(nullptr);
+        _properties.erase(std::find(_properties.begin(), _properties.end(), p));
+        _propertyIndex.erase(it);
+        StructureGeneration++;
     }
     else {
         LERROR(std::format(
@@ -352,20 +326,16 @@ void PropertyOwner::removeProperty(Property& prop) {
 void PropertyOwner::removePropertySubOwner(openspace::properties::PropertyOwner* owner) {
     ghoul_precondition(owner != nullptr, "owner must not be nullptr");
 
-    // See if we can find the name of the propertyowner to add
-    std::vector<PropertyOwner*>::const_iterator it = std::find_if(
-        _subOwners.begin(),
-        _subOwners.end(),
-        [identifier = owner->identifier()](PropertyOwner* o) {
-            return o->identifier() == identifier;
-        }
-    );
-
     // If we found the propertyowner, we can delete it
-    if (it != _subOwners.end() && (*it)->identifier() == owner->identifier()) {
+    auto it = _subOwnerIndex.find(owner->identifier());
+    if (it != _subOwnerIndex.end()) {
+        PropertyOwner* o = it->second;
+
         // Notify the change so the UI can update
-        publishPropertyTreePrunedEvent(owner->uri());
-        _subOwners.erase(it);
+        publishPropertyTreePrunedEvent(o->uri());
+        _subOwners.erase(std::find(_subOwners.begin(), _subOwners.end(), o));
+        _subOwnerIndex.erase(it);
+        StructureGeneration++;
     }
     else {
         LERROR(std::format(
@@ -382,7 +352,34 @@ void PropertyOwner::setIdentifier(std::string identifier) {
     if (identifier.find_first_of(". \t\n") != std::string::npos) {
         throw ghoul::RuntimeError("Identifier must not contain any dots or whitespaces");
     }
+
+    // The owner indexes its sub-owners by identifier, so the index has to follow the
+    // rename
+    if (_owner && identifier != _identifier) {
+        // Same as in addPropertySubOwner, a sibling that already uses the identifier
+        // keeps it
+        if (_owner->_subOwnerIndex.contains(identifier)) {
+            LERROR(std::format(
+                "PropertyOwner '{}' already present in PropertyOwner '{}'",
+                identifier, _owner->identifier()
+            ));
+            return;
+        }
+        if (_owner->hasProperty(identifier)) {
+            LERROR(std::format(
+                "PropertyOwner '{}'s name already names a Property", identifier
+            ));
+            return;
+        }
+
+        auto it = _owner->_subOwnerIndex.find(_identifier);
+        if (it != _owner->_subOwnerIndex.end() && it->second == this) {
+            _owner->_subOwnerIndex.erase(it);
+            _owner->_subOwnerIndex[identifier] = this;
+        }
+    }
     _identifier = std::move(identifier);
+    StructureGeneration++;
 }
 
 const std::string& PropertyOwner::identifier() const {
@@ -415,10 +412,16 @@ const std::vector<std::string>& PropertyOwner::tags() const {
 
 void PropertyOwner::addTag(std::string tag) {
     _tags.push_back(std::move(tag));
+    StructureGeneration++;
 }
 
 void PropertyOwner::removeTag(const std::string& tag) {
     _tags.erase(std::remove(_tags.begin(), _tags.end(), tag), _tags.end());
+    StructureGeneration++;
+}
+
+uint64_t PropertyOwner::structureGeneration() {
+    return StructureGeneration;
 }
 
 } // namespace openspace::properties
@@ -0,0 +1,175 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/drawlist.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/opengl/openglstatecache.h>
+#include <ghoul/opengl/programobject.h>
+#include <algorithm>
+#include <optional>
+#include <tuple>
+
+namespace {
+    void applyBlendMode(openspace::DrawPacket::BlendMode mode) {
+        using BlendMode = openspace::DrawPacket::BlendMode;
+        switch (mode) {
+            case BlendMode::Disabled:
+                glDisablei(GL_BLEND, 0);
+                break;
+            case BlendMode::Normal:
+                glEnablei(GL_BLEND, 0);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            case BlendMode::Additive:
+                glEnablei(GL_BLEND, 0);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+                break;
+        }
+    }
+
+    void applyDepthMode(openspace::DrawPacket::DepthMode mode) {
+        using DepthMode = openspace::DrawPacket::DepthMode;
+        switch (mode) {
+            case DepthMode::Disabled:
+                glDisable(GL_DEPTH_TEST);
+                break;
+            case DepthMode::Test:
+                glEnable(GL_DEPTH_TEST);
+                glDepthMask(false);
+                break;
+            case DepthMode::TestAndWrite:
+                glEnable(GL_DEPTH_TEST);
+                glDepthMask(true);
+                break;
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+void DrawList::submit(DrawPacket packet) {
+    ghoul_assert(packet.program, "Program must not be nullptr");
+
+    _packets.push_back(std::move(packet));
+}
+
+void DrawList::execute() {
+    ZoneScoped;
+
+    if (_packets.empty()) {
+        return;
+    }
+
+    // A stable sort keeps the submission order for packets with identical state, which
+    // matters for renderables that submit multiple packets that overlap each other
+    std::stable_sort(
+        _packets.begin(),
+        _packets.end(),
+        [](const DrawPacket& lhs, const DrawPacket& rhs) {
+            return std::tie(lhs.program, lhs.blendMode, lhs.depthMode, lhs.vao) <
+                   std::tie(rhs.program, rhs.blendMode, rhs.depthMode, rhs.vao);
+        }
+    );
+
+    ghoul::opengl::ProgramObject* program = nullptr;
+    std::optional<DrawPacket::BlendMode> blendMode;
+    std::optional<DrawPacket::DepthMode> depthMode;
+    std::optional<float> lineWidth;
+    std::optional<bool> lineSmooth;
+    std::optional<bool> programPointSize;
+    std::optional<GLuint> vao;
+    for (const DrawPacket& packet : _packets) {
+        if (packet.program != program) {
+            program = packet.program;
+            program->activate();
+        }
+        if (packet.blendMode != blendMode) {
+            blendMode = packet.blendMode;
+            applyBlendMode(packet.blendMode);
+        }
+        if (packet.depthMode != depthMode) {
+            depthMode = packet.depthMode;
+            applyDepthMode(packet.depthMode);
+        }
+        if (packet.lineWidth != lineWidth) {
+            lineWidth = packet.lineWidth;
+#ifndef __APPLE__
+            glLineWidth(packet.lineWidth);
+#else
+            glLineWidth(1.f);
+#endif
+        }
+        if (packet.lineSmooth != lineSmooth) {
+            lineSmooth = packet.lineSmooth;
+            packet.lineSmooth ? glEnable(GL_LINE_SMOOTH) : glDisable(GL_LINE_SMOOTH);
+        }
+        if (packet.programPointSize != programPointSize) {
+            programPointSize = packet.programPointSize;
+            packet.programPointSize ?
+                glEnable(GL_PROGRAM_POINT_SIZE) :
+                glDisable(GL_PROGRAM_POINT_SIZE);
+        }
+        if (packet.vao != vao) {
+            vao = packet.vao;
+            glBindVertexArray(packet.vao);
+        }
+
+        if (packet.setUniforms) {
+            packet.setUniforms(*program);
+        }
+
+        if (packet.indexType == GL_NONE) {
+            glDrawArrays(packet.mode, packet.first, packet.count);
+        }
+        else {
+            glDrawElements(
+                packet.mode,
+                packet.count,
+                packet.indexType,
+                reinterpret_cast<const void*>(static_cast<intptr_t>(packet.first))
+            );
+        }
+    }
+
+    glBindVertexArray(0);
+    program->deactivate();
+    global::renderEngine->openglStateCache().resetBlendState();
+    global::renderEngine->openglStateCache().resetDepthState();
+    global::renderEngine->openglStateCache().resetLineState();
+    if (programPointSize.value_or(false)) {
+        glDisable(GL_PROGRAM_POINT_SIZE);
+    }
+
+    _packets.clear();
+}
+
+size_t DrawList::size() const {
+    return _packets.size();
+}
+
+} // namespace openspace
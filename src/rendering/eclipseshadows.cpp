@@ -0,0 +1,136 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/eclipseshadows.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/spicemanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+
+namespace {
+    constexpr double KM_TO_M = 1000.0;
+} // namespace
+
+namespace openspace {
+
+const glm::dvec3& EclipseShadows::position(const std::string& target, double time) {
+    setTime(time);
+
+    auto it = _positions.find(target);
+    if (it == _positions.end()) {
+        double lt = 0.0;
+        const glm::dvec3 p = SpiceManager::ref().targetPosition(
+            target,
+            "SSB",
+            "GALACTIC",
+            {},
+            time,
+            lt
+        );
+        it = _positions.emplace(target, p * KM_TO_M).first;
+    }
+    return it->second;
+}
+
+std::optional<EclipseShadows::Shadow> EclipseShadows::shadow(
+                                                                       const Body& source,
+                                                                       const Body& caster,
+                                                       const glm::dvec3& receiverPosition,
+                                                                    double receiverRadius,
+                                                            const glm::dvec3& sunPosition,
+                                                                              double time)
+{
+    ZoneScoped;
+
+    setTime(time);
+    const std::optional<double> sourceScale = radiusScale(source.first);
+    const std::optional<double> casterScale = radiusScale(caster.first);
+    if (!sourceScale.has_value() || !casterScale.has_value()) {
+        return std::nullopt;
+    }
+
+    const glm::dvec3& sourcePos = position(source.first, time);
+    const glm::dvec3& casterPos = position(caster.first, time);
+    const double actualSourceRadius = source.second * *sourceScale;
+    const double actualCasterRadius = caster.second * *casterScale;
+
+    // First we determine if the caster is shadowing the receiver (all calculations in
+    // world coordinates)
+    const glm::dvec3 receiverCasterVec = casterPos - receiverPosition;
+    const glm::dvec3 sourceCasterVec = casterPos - sourcePos;
+    const double scLength = glm::length(sourceCasterVec);
+    const glm::dvec3 receiverCasterProj =
+        (glm::dot(receiverCasterVec, sourceCasterVec) / (scLength * scLength)) *
+        sourceCasterVec;
+    const double dTest = glm::length(receiverCasterVec - receiverCasterProj);
+    const double xpTest = actualCasterRadius * scLength /
+        (actualSourceRadius + actualCasterRadius);
+    const double rpTest = actualCasterRadius *
+        (glm::length(receiverCasterProj) + xpTest) / xpTest;
+
+    const double casterDistSun = glm::length(casterPos - sunPosition);
+    const double receiverDistSun = glm::length(receiverPosition - sunPosition);
+
+    Shadow res;
+    // Eclipse shadows considers planets and moons as spheres
+    if ((dTest - rpTest) < receiverRadius && casterDistSun < receiverDistSun) {
+        res.isShadowing = true;
+        res.radiusSource = actualSourceRadius;
+        res.radiusCaster = actualCasterRadius;
+        res.sourceCasterVec = glm::normalize(sourceCasterVec);
+        res.penumbra = xpTest;
+        res.umbra = res.radiusCaster * scLength / (res.radiusSource - res.radiusCaster);
+        res.casterPositionVec = casterPos;
+    }
+    return res;
+}
+
+void EclipseShadows::setTime(double time) {
+    if (_hasTime && time == _time) {
+        return;
+    }
+
+    _time = time;
+    _hasTime = true;
+    _positions.clear();
+    _radiusScales.clear();
+}
+
+std::optional<double> EclipseShadows::radiusScale(const std::string& name) {
+    auto it = _radiusScales.find(name);
+    if (it == _radiusScales.end()) {
+        const SceneGraphNode* node = global::renderEngine->scene()->sceneGraphNode(name);
+        std::optional<double> scale = node ?
+            std::optional<double>(std::max(glm::compMax(node->scale()), 1.0)) :
+            std::nullopt;
+        it = _radiusScales.emplace(name, scale).first;
+    }
+    return it->second;
+}
+
+} // namespace openspace
@@ -25,10 +25,12 @@
 #include <openspace/rendering/framebufferrenderer.h>
 
 #include <openspace/camera/camera.h>
+#include <openspace/camera/camerasnapshot.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/rendering/deferredcaster.h>
 #include <openspace/rendering/deferredcastermanager.h>
+#include <openspace/rendering/gputimerpool.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/rendering/renderable.h>
 #include <openspace/rendering/renderengine.h>
@@ -44,6 +46,8 @@
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/textureunit.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -63,6 +67,20 @@ namespace {
     constexpr std::string_view RenderFragmentShaderPath =
         "${SHADERS}/framebuffer/renderframebuffer.frag";
 
+    // The lowest scale that the adaptive volume resolution can reach
+    constexpr float AdaptiveMinScale = 0.25f;
+    // The number of discrete scales that the adaptive volume resolution can choose from
+    constexpr float AdaptiveScaleSteps = 32.f;
+    // The number of frames that the camera has to be still before the volume resolution
+    // is refined, and by how much it is refined in each of the following frames
+    constexpr int AdaptiveStillFrames = 10;
+    constexpr float AdaptiveRefineFactor = 1.1f;
+    // The number of frames over which a new volume resolution is blended in
+    constexpr int AdaptiveAccumulationFrames = 8;
+
+    // The number of discrete scales that the dynamic scene resolution can choose from
+    constexpr float DynamicScaleSteps = 64.f;
+
     constexpr std::array<GLenum, 4> ColorAttachmentArray = {
        GL_COLOR_ATTACHMENT0,
        GL_COLOR_ATTACHMENT1,
@@ -337,6 +355,8 @@ void FramebufferRenderer::initialize() {
     updateFXAA();
     updateDeferredcastData();
     updateDownscaledVolume();
+    updateTemporalReprojection();
+    updateOrderIndependentTransparency();
 
     // Sets back to default FBO
     glBindFramebuffer(GL_FRAMEBUFFER, _defaultFBO);
@@ -347,6 +367,18 @@ void FramebufferRenderer::initialize() {
         *_downscaledVolumeProgram,
         _writeDownscaledVolumeUniformCache
     );
+    ghoul::opengl::updateUniformLocations(
+        *_accumulateVolumeProgram,
+        _accumulateVolumeUniformCache
+    );
+    ghoul::opengl::updateUniformLocations(
+        *_reprojectDeferredProgram,
+        _reprojectDeferredUniformCache
+    );
+    ghoul::opengl::updateUniformLocations(
+        *_transparencyResolveProgram,
+        _transparencyUniformCache
+    );
 
     global::raycasterManager->addListener(*this);
     global::deferredcasterManager->addListener(*this);
@@ -383,6 +415,7 @@ void FramebufferRenderer::deinitialize() {
     glDeleteFramebuffers(1, &_fxaaBuffers.fxaaFramebuffer);
     glDeleteFramebuffers(1, &_pingPongBuffers.framebuffer);
     glDeleteFramebuffers(1, &_downscaleVolumeRendering.framebuffer);
+    glDeleteFramebuffers(1, &_transparencyBuffers.framebuffer);
 
     glDeleteTextures(1, &_gBuffers.colorTexture);
     glDeleteTextures(1, &_gBuffers.depthTexture);
@@ -398,9 +431,27 @@ void FramebufferRenderer::deinitialize() {
     glDeleteTextures(1, &_exitColorTexture);
     glDeleteTextures(1, &_exitDepthTexture);
 
+    glDeleteTextures(1, &_transparencyBuffers.accumulationTexture);
+    glDeleteTextures(1, &_transparencyBuffers.revealageTexture);
+
     glDeleteBuffers(1, &_vertexPositionBuffer);
     glDeleteVertexArrays(1, &_screenQuad);
 
+    for (auto& [raycaster, adaptive] : _adaptiveResolutions) {
+        releaseAdaptiveResolution(adaptive);
+    }
+    _adaptiveResolutions.clear();
+
+    for (auto& [deferredcaster, temporal] : _temporalReprojections) {
+        releaseTemporalReprojection(temporal);
+    }
+    _temporalReprojections.clear();
+
+    if (_dynamicResolution.queries[0] != 0) {
+        glDeleteQueries(4, _dynamicResolution.queries.data());
+        _dynamicResolution.queries = { 0, 0, 0, 0 };
+    }
+
     global::raycasterManager->removeListener(*this);
     global::deferredcasterManager->removeListener(*this);
 }
@@ -417,7 +468,9 @@ void FramebufferRenderer::deferredcastersChanged(Deferredcaster&,
     _dirtyDeferredcastData = true;
 }
 
-void FramebufferRenderer::applyTMO(float blackoutFactor, const glm::ivec4& viewport) {
+void FramebufferRenderer::applyTMO(float blackoutFactor, const glm::ivec4& viewport,
+                                   float renderScale)
+{
     ZoneScoped;
     TracyGpuZone("applyTMO");
 
@@ -440,6 +493,7 @@ void FramebufferRenderer::applyTMO(float blackoutFactor, const glm::ivec4& viewp
     _hdrFilteringProgram->setUniform(_hdrUniformCache.Value, _value);
     _hdrFilteringProgram->setUniform(_hdrUniformCache.Viewport, glm::vec4(viewport));
     _hdrFilteringProgram->setUniform(_hdrUniformCache.Resolution, glm::vec2(_resolution));
+    _hdrFilteringProgram->setUniform(_hdrUniformCache.RenderScale, renderScale);
 
     glDepthMask(false);
     glDisable(GL_DEPTH_TEST);
@@ -487,51 +541,15 @@ void FramebufferRenderer::applyFXAA(const glm::ivec4& viewport) {
     _fxaaProgram->deactivate();
 }
 
-void FramebufferRenderer::updateDownscaleTextures() const {
-    const float cdf = _downscaleVolumeRendering.currentDownscaleFactor;
-
-    glBindTexture(GL_TEXTURE_2D, _downscaleVolumeRendering.colorTexture);
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        GL_RGBA32F,
-        static_cast<GLsizei>(glm::max(_resolution.x * cdf, 1.f)),
-        static_cast<GLsizei>(glm::max(_resolution.y * cdf, 1.f)),
-        0,
-        GL_RGBA,
-        GL_FLOAT,
-        nullptr
-    );
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    constexpr float VolumeBorderColor[] = { 0.f, 0.f, 0.f, 1.f };
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, VolumeBorderColor);
-
-    glBindTexture(GL_TEXTURE_2D, _downscaleVolumeRendering.depthbuffer);
-    glTexImage2D(
-        GL_TEXTURE_2D,
-        0,
-        GL_DEPTH_COMPONENT32F,
-        static_cast<GLsizei>(glm::max(_resolution.x * cdf, 1.f)),
-        static_cast<GLsizei>(glm::max(_resolution.y * cdf, 1.f)),
-        0,
-        GL_DEPTH_COMPONENT,
-        GL_FLOAT,
-        nullptr
-    );
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-}
-
-void FramebufferRenderer::writeDownscaledVolume(const glm::ivec4& viewport) {
+void FramebufferRenderer::writeDownscaledVolume(const glm::ivec4& viewport,
+                                                 GLuint colorTexture, float colorScale,
+                                                 float depthScale)
+{
     _downscaledVolumeProgram->activate();
 
     ghoul::opengl::TextureUnit downscaledTextureUnit;
     downscaledTextureUnit.activate();
-    glBindTexture(
-        GL_TEXTURE_2D,
-        _downscaleVolumeRendering.colorTexture
-    );
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
 
     _downscaledVolumeProgram->setUniform(
         _writeDownscaledVolumeUniformCache.downscaledRenderedVolume,
@@ -561,6 +579,14 @@ void FramebufferRenderer::writeDownscaledVolume(const glm::ivec4& viewport) {
         _writeDownscaledVolumeUniformCache.resolution,
         glm::vec2(_resolution)
     );
+    _downscaledVolumeProgram->setUniform(
+        _writeDownscaledVolumeUniformCache.colorScale,
+        colorScale
+    );
+    _downscaledVolumeProgram->setUniform(
+        _writeDownscaledVolumeUniformCache.depthScale,
+        depthScale
+    );
 
 
     glEnablei(GL_BLEND, 0);
@@ -620,6 +646,33 @@ void FramebufferRenderer::update() {
         );
     }
 
+    if (_accumulateVolumeProgram->isDirty()) {
+        _accumulateVolumeProgram->rebuildFromFile();
+
+        ghoul::opengl::updateUniformLocations(
+            *_accumulateVolumeProgram,
+            _accumulateVolumeUniformCache
+        );
+    }
+
+    if (_reprojectDeferredProgram->isDirty()) {
+        _reprojectDeferredProgram->rebuildFromFile();
+
+        ghoul::opengl::updateUniformLocations(
+            *_reprojectDeferredProgram,
+            _reprojectDeferredUniformCache
+        );
+    }
+
+    if (_transparencyResolveProgram->isDirty()) {
+        _transparencyResolveProgram->rebuildFromFile();
+
+        ghoul::opengl::updateUniformLocations(
+            *_transparencyResolveProgram,
+            _transparencyUniformCache
+        );
+    }
+
     using K = VolumeRaycaster*;
     using V = std::unique_ptr<ghoul::opengl::ProgramObject>;
     for (const std::pair<const K, V>& program : _exitPrograms) {
@@ -675,11 +728,16 @@ void FramebufferRenderer::updateResolution() {
     ZoneScoped;
     TracyGpuZone("Renderer updateResolution");
 
+    // The compact formats are only used for the color and normal buffers. The position
+    // buffer stores view space positions in meters, which can not be represented with
+    // half precision, so it always uses single precision
+    const GLenum colorFormat = _useCompactFormats ? GL_RGBA16F : GL_RGBA32F;
+
     glBindTexture(GL_TEXTURE_2D, _gBuffers.colorTexture);
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
-        GL_RGBA32F,
+        colorFormat,
         _resolution.x,
         _resolution.y,
         0,
@@ -719,7 +777,7 @@ void FramebufferRenderer::updateResolution() {
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
-        GL_RGBA32F,
+        colorFormat,
         _resolution.x,
         _resolution.y,
         0,
@@ -759,7 +817,7 @@ void FramebufferRenderer::updateResolution() {
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
-        GL_RGBA32F,
+        colorFormat,
         _resolution.x,
         _resolution.y,
         0,
@@ -801,16 +859,16 @@ void FramebufferRenderer::updateResolution() {
         glObjectLabel(GL_TEXTURE, _fxaaBuffers.fxaaTexture, -1, "FXAA");
     }
 
-    const float cdf = _downscaleVolumeRendering.currentDownscaleFactor;
-
-    // Downscale Volume Rendering
+    // Downscale Volume Rendering. The textures have the full resolution and the volume is
+    // rendered into their lower left part, so that the scale can change without
+    // reallocating them
     glBindTexture(GL_TEXTURE_2D, _downscaleVolumeRendering.colorTexture);
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
-        GL_RGBA32F,
-        static_cast<GLsizei>(glm::max(_resolution.x * cdf, 1.f)),
-        static_cast<GLsizei>(glm::max(_resolution.y * cdf, 1.f)),
+        colorFormat,
+        _resolution.x,
+        _resolution.y,
         0,
         GL_RGBA,
         GL_FLOAT,
@@ -837,8 +895,8 @@ void FramebufferRenderer::updateResolution() {
         GL_TEXTURE_2D,
         0,
         GL_DEPTH_COMPONENT32F,
-        static_cast<GLsizei>(glm::max(_resolution.x * cdf, 1.f)),
-        static_cast<GLsizei>(glm::max(_resolution.y * cdf, 1.f)),
+        _resolution.x,
+        _resolution.y,
         0,
         GL_DEPTH_COMPONENT,
         GL_FLOAT,
@@ -898,9 +956,69 @@ void FramebufferRenderer::updateResolution() {
         glObjectLabel(GL_TEXTURE, _exitDepthTexture, -1, "Exit depth");
     }
 
+    // The order-independent transparency buffers are only resized if they are in use
+    if (_transparencyBuffers.framebuffer != 0) {
+        updateOrderIndependentTransparencyTextures();
+    }
+
     _dirtyResolution = false;
 }
 
+void FramebufferRenderer::updateOrderIndependentTransparencyTextures() {
+    // The accumulation is stored in full floating point precision, since the weighted
+    // sum over many overlapping points would overflow a half precision texture
+    glBindTexture(GL_TEXTURE_2D, _transparencyBuffers.accumulationTexture);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_RGBA32F,
+        _resolution.x,
+        _resolution.y,
+        0,
+        GL_RGBA,
+        GL_FLOAT,
+        nullptr
+    );
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    if (glbinding::Binding::ObjectLabel.isResolved()) {
+        glObjectLabel(
+            GL_TEXTURE,
+            _transparencyBuffers.accumulationTexture,
+            -1,
+            "Transparency accumulation"
+        );
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _transparencyBuffers.revealageTexture);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_R16F,
+        _resolution.x,
+        _resolution.y,
+        0,
+        GL_RED,
+        GL_FLOAT,
+        nullptr
+    );
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    if (glbinding::Binding::ObjectLabel.isResolved()) {
+        glObjectLabel(
+            GL_TEXTURE,
+            _transparencyBuffers.revealageTexture,
+            -1,
+            "Transparency revealage"
+        );
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 void FramebufferRenderer::updateRaycastData() {
     ZoneScoped;
 
@@ -912,6 +1030,18 @@ void FramebufferRenderer::updateRaycastData() {
     const std::vector<VolumeRaycaster*>& raycasters =
         global::raycasterManager->raycasters();
 
+    for (auto it = _adaptiveResolutions.begin(); it != _adaptiveResolutions.end();) {
+        if (std::find(raycasters.begin(), raycasters.end(), it->first) ==
+            raycasters.end())
+        {
+            releaseAdaptiveResolution(it->second);
+            it = _adaptiveResolutions.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
     int nextId = 0;
     for (VolumeRaycaster* raycaster : raycasters) {
         ZoneScopedN("raycaster");
@@ -937,7 +1067,7 @@ void FramebufferRenderer::updateRaycastData() {
         _raycastData[raycaster] = data;
 
         try {
-            _exitPrograms[raycaster] = ghoul::opengl::ProgramObject::Build(
+            _exitPrograms[raycaster] = global::renderEngine->buildCachedProgram(
                 std::format("Volume {} exit", data.id),
                 absPath(vsPath),
                 absPath(ExitFragmentShaderPath),
@@ -950,7 +1080,7 @@ void FramebufferRenderer::updateRaycastData() {
         try {
             ghoul::Dictionary outsideDict = dict;
             outsideDict.setValue("getEntryPath", std::string(GetEntryOutsidePath));
-            _raycastPrograms[raycaster] = ghoul::opengl::ProgramObject::Build(
+            _raycastPrograms[raycaster] = global::renderEngine->buildCachedProgram(
                 std::format("Volume {} raycast", data.id),
                 absPath(vsPath),
                 absPath(RaycastFragmentShaderPath),
@@ -963,7 +1093,7 @@ void FramebufferRenderer::updateRaycastData() {
         try {
             ghoul::Dictionary insideDict = dict;
             insideDict.setValue("getEntryPath", std::string(GetEntryInsidePath));
-            _insideRaycastPrograms[raycaster] = ghoul::opengl::ProgramObject::Build(
+            _insideRaycastPrograms[raycaster] = global::renderEngine->buildCachedProgram(
                 std::format("Volume {} inside raycast", data.id),
                 absPath("${SHADERS}/framebuffer/resolveframebuffer.vert"),
                 absPath(RaycastFragmentShaderPath),
@@ -983,6 +1113,18 @@ void FramebufferRenderer::updateDeferredcastData() {
 
     const std::vector<Deferredcaster*>& deferredcasters =
         global::deferredcasterManager->deferredcasters();
+    for (auto it = _temporalReprojections.begin(); it != _temporalReprojections.end();) {
+        if (std::find(deferredcasters.begin(), deferredcasters.end(), it->first) ==
+            deferredcasters.end())
+        {
+            releaseTemporalReprojection(it->second);
+            it = _temporalReprojections.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
     int nextId = 0;
     for (Deferredcaster* caster : deferredcasters) {
         DeferredcastData data = { .id = nextId++, .namespaceName = "HELPER" };
@@ -1004,7 +1146,7 @@ void FramebufferRenderer::updateDeferredcastData() {
         _deferredcastData[caster] = data;
 
         try {
-            _deferredcastPrograms[caster] = ghoul::opengl::ProgramObject::Build(
+            _deferredcastPrograms[caster] = global::renderEngine->buildCachedProgram(
                 std::format("Deferred {} raycast", data.id),
                 vsPath,
                 fsPath,
@@ -1024,7 +1166,7 @@ void FramebufferRenderer::updateDeferredcastData() {
 void FramebufferRenderer::updateHDRAndFiltering() {
     ZoneScoped;
 
-    _hdrFilteringProgram = ghoul::opengl::ProgramObject::Build(
+    _hdrFilteringProgram = global::renderEngine->buildCachedProgram(
         "HDR and Filtering Program",
         absPath("${SHADERS}/framebuffer/hdrAndFiltering.vert"),
         absPath("${SHADERS}/framebuffer/hdrAndFiltering.frag")
@@ -1034,7 +1176,7 @@ void FramebufferRenderer::updateHDRAndFiltering() {
 void FramebufferRenderer::updateFXAA() {
     ZoneScoped;
 
-    _fxaaProgram = ghoul::opengl::ProgramObject::Build(
+    _fxaaProgram = global::renderEngine->buildCachedProgram(
         "FXAA Program",
         absPath("${SHADERS}/framebuffer/fxaa.vert"),
         absPath("${SHADERS}/framebuffer/fxaa.frag")
@@ -1044,11 +1186,36 @@ void FramebufferRenderer::updateFXAA() {
 void FramebufferRenderer::updateDownscaledVolume() {
     ZoneScoped;
 
-    _downscaledVolumeProgram = ghoul::opengl::ProgramObject::Build(
+    _downscaledVolumeProgram = global::renderEngine->buildCachedProgram(
         "Write Downscaled Volume Program",
         absPath("${SHADERS}/framebuffer/mergeDownscaledVolume.vert"),
         absPath("${SHADERS}/framebuffer/mergeDownscaledVolume.frag")
     );
+    _accumulateVolumeProgram = global::renderEngine->buildCachedProgram(
+        "Accumulate Volume Program",
+        absPath("${SHADERS}/framebuffer/mergeDownscaledVolume.vert"),
+        absPath("${SHADERS}/framebuffer/accumulateVolume.frag")
+    );
+}
+
+void FramebufferRenderer::updateTemporalReprojection() {
+    ZoneScoped;
+
+    _reprojectDeferredProgram = global::renderEngine->buildCachedProgram(
+        "Reproject Deferredcast Program",
+        absPath("${SHADERS}/framebuffer/mergeDownscaledVolume.vert"),
+        absPath("${SHADERS}/framebuffer/reprojectDeferred.frag")
+    );
+}
+
+void FramebufferRenderer::updateOrderIndependentTransparency() {
+    ZoneScoped;
+
+    _transparencyResolveProgram = global::renderEngine->buildCachedProgram(
+        "Resolve Order-Independent Transparency Program",
+        absPath("${SHADERS}/framebuffer/resolveframebuffer.vert"),
+        absPath("${SHADERS}/framebuffer/resolveorderindependenttransparency.frag")
+    );
 }
 
 void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFactor) {
@@ -1072,10 +1239,30 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
         return;
     }
 
+    GpuTimerPool& timers = global::renderEngine->gpuTimerPool();
+    const GpuTimerPool::Scope frameTimer(timers, "Renderer");
+
+    // With the dynamic resolution, the scene is rendered into the lower left part of the
+    // textures and is upscaled to the full viewport when the TMO is applied
+    const float renderScale = updateDynamicScale();
+    const glm::ivec4 sceneViewport = glm::ivec4(glm::vec4(viewport) * renderScale);
+    if (renderScale < 1.f) {
+        global::renderEngine->openglStateCache().setViewportState(
+            glm::value_ptr(sceneViewport)
+        );
+    }
+    if (_dynamicResolution.isEnabled) {
+        glQueryCounter(
+            _dynamicResolution.queries[2 * _dynamicResolution.queryIndex],
+            GL_TIMESTAMP
+        );
+    }
+
     {
         // deferred g-buffer
         ZoneScopedN("Deferred G-Buffer");
         TracyGpuZone("Deferred G-Buffer");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Deferred G-Buffer");
 
         glBindFramebuffer(GL_FRAMEBUFFER, _gBuffers.framebuffer);
         glDrawBuffers(3, ColorAttachmentArray.data());
@@ -1083,46 +1270,63 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
         glClearBufferfv(GL_COLOR, 1, glm::value_ptr(PosBufferClearVal));
     }
 
+    // All derived camera values are computed once for this viewport, so that the
+    // renderables don't have to go through the camera's lazily updated caches
+    const CameraSnapshot cameraSnapshot = CameraSnapshot(*camera);
     RenderData data = {
         .camera = *camera,
+        .cameraSnapshot = cameraSnapshot,
         .time = global::timeManager->time(),
         .renderBinMask = 0
     };
     RendererTasks tasks;
+    if (_useDrawLists) {
+        tasks.drawList = &_drawList;
+    }
+
+    scene->cullNodes(cameraSnapshot);
 
     {
         TracyGpuZone("Background")
         const ghoul::GLDebugGroup group("Background");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Background");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Background);
         scene->render(data, tasks);
+        _drawList.execute();
     }
 
     {
         TracyGpuZone("Opaque")
         const ghoul::GLDebugGroup group("Opaque");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Opaque");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Opaque);
         scene->render(data, tasks);
+        _drawList.execute();
     }
 
     {
         TracyGpuZone("PreDeferredTransparent")
         const ghoul::GLDebugGroup group("PreDeferredTransparent");
+        const GpuTimerPool::Scope timer(timers, "Renderer/PreDeferredTransparent");
         data.renderBinMask = static_cast<int>(
             Renderable::RenderBin::PreDeferredTransparent
         );
         scene->render(data, tasks);
+        _drawList.execute();
     }
 
     // Run Volume Tasks
     {
         TracyGpuZone("Raycaster Tasks")
         const ghoul::GLDebugGroup group("Raycaster Tasks");
-        performRaycasterTasks(tasks.raycasterTasks, viewport);
+        const GpuTimerPool::Scope timer(timers, "Renderer/Raycaster Tasks");
+        performRaycasterTasks(tasks.raycasterTasks, sceneViewport);
     }
 
     if (!tasks.deferredcasterTasks.empty()) {
         TracyGpuZone("Deferred Caster Tasks")
         const ghoul::GLDebugGroup group("Deferred Caster Tasks");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Deferred Caster Tasks");
 
         // We use ping pong rendering in order to be able to render multiple deferred
         // tasks at same time (e.g. more than 1 ATM being seen at once) to the same final
@@ -1130,7 +1334,7 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
         glBindFramebuffer(GL_FRAMEBUFFER, _pingPongBuffers.framebuffer);
         glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
 
-        performDeferredTasks(tasks.deferredcasterTasks, viewport);
+        performDeferredTasks(tasks.deferredcasterTasks, sceneViewport);
     }
 
     glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
@@ -1139,26 +1343,42 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
     {
         TracyGpuZone("Overlay")
         const ghoul::GLDebugGroup group("Overlay");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Overlay");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Overlay);
         scene->render(data, tasks);
+        _drawList.execute();
     }
 
     {
         TracyGpuZone("PostDeferredTransparent")
         const ghoul::GLDebugGroup group("PostDeferredTransparent");
+        const GpuTimerPool::Scope timer(timers, "Renderer/PostDeferredTransparent");
         data.renderBinMask = static_cast<int>(
             Renderable::RenderBin::PostDeferredTransparent
         );
         scene->render(data, tasks);
+        _drawList.execute();
+    }
+
+    if (!tasks.orderIndependentTransparencyTasks.empty()) {
+        TracyGpuZone("Order-Independent Transparency")
+        const ghoul::GLDebugGroup group("Order-Independent Transparency");
+        const GpuTimerPool::Scope timer(
+            timers,
+            "Renderer/Order-Independent Transparency"
+        );
+        performOrderIndependentTransparencyTasks(tasks.orderIndependentTransparencyTasks);
     }
 
     {
         TracyGpuZone("Sticker")
         const ghoul::GLDebugGroup group("Sticker");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Sticker");
         data.renderBinMask = static_cast<int>(
             Renderable::RenderBin::Sticker
         );
         scene->render(data, tasks);
+        _drawList.execute();
     }
 
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
@@ -1166,6 +1386,10 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
     // Disabling depth test for filtering and hdr
     glDisable(GL_DEPTH_TEST);
 
+    if (renderScale < 1.f) {
+        global::renderEngine->openglStateCache().setViewportState(vp.data());
+    }
+
     if (_enableFXAA) {
         glBindFramebuffer(GL_FRAMEBUFFER, _fxaaBuffers.fxaaFramebuffer);
         glDrawBuffers(1, ColorAttachmentArray.data());
@@ -1182,16 +1406,79 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
         // Apply the selected TMO on the results and resolve the result to the default FBO
         TracyGpuZone("Apply TMO");
         const ghoul::GLDebugGroup group("Apply TMO");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Apply TMO");
 
-        applyTMO(blackoutFactor, viewport);
+        applyTMO(blackoutFactor, viewport, renderScale);
     }
 
     if (_enableFXAA) {
         TracyGpuZone("Apply FXAA")
         const ghoul::GLDebugGroup group("Apply FXAA");
+        const GpuTimerPool::Scope timer(timers, "Renderer/Apply FXAA");
         glBindFramebuffer(GL_FRAMEBUFFER, _defaultFBO);
         applyFXAA(viewport);
     }
+
+    if (_dynamicResolution.isEnabled) {
+        const unsigned int index = _dynamicResolution.queryIndex;
+        glQueryCounter(_dynamicResolution.queries[2 * index + 1], GL_TIMESTAMP);
+        _dynamicResolution.isQueryIssued[index] = true;
+        _dynamicResolution.queryIndex = 1 - index;
+    }
+}
+
+float FramebufferRenderer::updateDynamicScale() {
+    DynamicResolution& state = _dynamicResolution;
+    if (!state.isEnabled) {
+        state.scale = 1.f;
+        return 1.f;
+    }
+
+    if (state.queries[0] == 0) {
+        glGenQueries(4, state.queries.data());
+    }
+
+    // The queries that are reused in this frame were issued two frames ago, so their
+    // results are usually available by now. If they are not, the measurement is skipped
+    const unsigned int index = state.queryIndex;
+    if (state.isQueryIssued[index]) {
+        GLuint isAvailable = 0;
+        glGetQueryObjectuiv(
+            state.queries[2 * index + 1],
+            GL_QUERY_RESULT_AVAILABLE,
+            &isAvailable
+        );
+        if (isAvailable) {
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(state.queries[2 * index], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(state.queries[2 * index + 1], GL_QUERY_RESULT, &end);
+            state.gpuTime = static_cast<float>(end - begin) / 1e6f;
+        }
+        state.isQueryIssued[index] = false;
+    }
+
+    float scale = state.scale;
+    if (state.gpuTime > 0.f) {
+        // Most of the frame time is proportional to the number of pixels, and the change
+        // per frame is limited as the measurement lags behind by two frames
+        const float ratio = std::sqrt(state.targetFrameTime / state.gpuTime);
+        scale *= std::clamp(ratio, 0.9f, 1.05f);
+    }
+    // The quantization keeps small fluctuations of the measured time from changing the
+    // resolution in every frame
+    scale = std::round(scale * DynamicScaleSteps) / DynamicScaleSteps;
+    scale = std::clamp(scale, state.minScale, state.maxScale);
+
+    if (scale != state.scale) {
+        // The volume histories were rendered into a differently sized part of the
+        // textures and can no longer be blended with the new frames
+        for (auto& [raycaster, adaptive] : _adaptiveResolutions) {
+            adaptive.hasHistory = false;
+        }
+    }
+    state.scale = scale;
+    return scale;
 }
 
 void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>& tasks,
@@ -1215,9 +1502,18 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             exitProgram->deactivate();
         }
 
-        if (raycaster->downscaleRender() < 1.f) {
+        // Raycasters with a target time always use the offscreen pass so that their
+        // history for the temporal accumulation stays valid, even at full resolution
+        AdaptiveResolution* adaptive = nullptr;
+        float s = raycaster->downscaleRender();
+        if (raycaster->targetRaycastTime() > 0.f) {
+            adaptive = &_adaptiveResolutions[raycaster];
+            s = updateAdaptiveScale(*adaptive, *raycaster, raycasterTask.renderData);
+        }
+        const bool isDownscaled = adaptive || s < 1.f;
+
+        if (isDownscaled) {
             glBindFramebuffer(GL_FRAMEBUFFER, _downscaleVolumeRendering.framebuffer);
-            const float s = raycaster->downscaleRender();
             const std::array<GLint, 4> newVP = {
                 static_cast<GLint>(viewport[0] * s),
                 static_cast<GLint>(viewport[1] * s),
@@ -1225,11 +1521,6 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
                 static_cast<GLint>(viewport[3] * s)
             };
             global::renderEngine->openglStateCache().setViewportState(newVP.data());
-
-            if (_downscaleVolumeRendering.currentDownscaleFactor != s) {
-                _downscaleVolumeRendering.currentDownscaleFactor = s;
-                updateDownscaleTextures();
-            }
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         }
         else {
@@ -1286,11 +1577,10 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             glBindTexture(GL_TEXTURE_2D, _gBuffers.depthTexture);
             raycastProgram->setUniform("mainDepthTexture", mainDepthTextureUnit);
 
-            if (raycaster->downscaleRender() < 1.f) {
-                const float scaleDown = raycaster->downscaleRender();
+            if (isDownscaled) {
                 raycastProgram->setUniform(
                     "windowSize",
-                    glm::vec2(_resolution.x * scaleDown, _resolution.y * scaleDown)
+                    glm::vec2(_resolution.x * s, _resolution.y * s)
                 );
             }
             else {
@@ -1300,6 +1590,10 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
                 );
             }
 
+            if (adaptive) {
+                glBeginQuery(GL_TIME_ELAPSED, adaptive->queries[adaptive->queryIndex]);
+            }
+
             glDisable(GL_DEPTH_TEST);
             glDepthMask(false);
             if (isCameraInside) {
@@ -1313,6 +1607,12 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             glDepthMask(true);
             glEnable(GL_DEPTH_TEST);
 
+            if (adaptive) {
+                glEndQuery(GL_TIME_ELAPSED);
+                adaptive->isQueryIssued[adaptive->queryIndex] = true;
+                adaptive->queryIndex = 1 - adaptive->queryIndex;
+            }
+
             raycaster->postRaycast(_raycastData[raycaster], *raycastProgram);
             raycastProgram->deactivate();
         }
@@ -1320,16 +1620,397 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             LWARNING("Raycaster is not attached when trying to perform raycaster task");
         }
 
-        if (raycaster->downscaleRender() < 1.f) {
+        if (isDownscaled) {
             global::renderEngine->openglStateCache().setViewportState(
                 glm::value_ptr(viewport)
             );
-            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _gBuffers.framebuffer);
-            writeDownscaledVolume(viewport);
+            if (adaptive) {
+                const GLuint history = accumulateVolume(*adaptive, s, viewport);
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _gBuffers.framebuffer);
+                writeDownscaledVolume(viewport, history, 1.f, s);
+            }
+            else {
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _gBuffers.framebuffer);
+                writeDownscaledVolume(
+                    viewport,
+                    _downscaleVolumeRendering.colorTexture,
+                    s,
+                    s
+                );
+            }
         }
     }
 }
 
+float FramebufferRenderer::updateAdaptiveScale(AdaptiveResolution& state,
+                                               const VolumeRaycaster& raycaster,
+                                               const RenderData& data)
+{
+    if (state.queries[0] == 0) {
+        glGenQueries(2, state.queries.data());
+    }
+
+    // The query that is reused in this frame was issued two frames ago, so its result is
+    // usually available by now. If it is not, the measurement is skipped
+    const GLuint query = state.queries[state.queryIndex];
+    if (state.isQueryIssued[state.queryIndex]) {
+        GLuint isAvailable = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable) {
+            GLuint64 nanoseconds = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+            state.gpuTime = static_cast<float>(nanoseconds) / 1e6f;
+        }
+        state.isQueryIssued[state.queryIndex] = false;
+    }
+
+    const glm::dmat4 viewProjection =
+        glm::dmat4(data.camera.projectionMatrix()) * data.camera.combinedViewMatrix();
+    const bool isMoving = viewProjection != state.viewProjection;
+    state.viewProjection = viewProjection;
+    state.nStillFrames = isMoving ? 0 : state.nStillFrames + 1;
+
+    float scale = state.scale;
+    if (state.nStillFrames >= AdaptiveStillFrames) {
+        // Refine towards the full resolution while the camera is still
+        scale = std::min(scale * AdaptiveRefineFactor, 1.f);
+    }
+    else if (state.gpuTime > 0.f) {
+        // The cost of the raycasting is proportional to the number of pixels, and the
+        // change per frame is limited as the measurement lags behind by two frames
+        const float ratio = std::sqrt(raycaster.targetRaycastTime() / state.gpuTime);
+        scale *= std::clamp(ratio, 0.75f, 1.1f);
+    }
+    // The quantization keeps small fluctuations of the measured time from changing the
+    // resolution in every frame
+    scale = std::round(scale * AdaptiveScaleSteps) / AdaptiveScaleSteps;
+    scale = std::clamp(scale, AdaptiveMinScale, 1.f);
+
+    state.nFramesSinceSwitch = scale == state.scale ? state.nFramesSinceSwitch + 1 : 0;
+    state.scale = scale;
+    return scale;
+}
+
+GLuint FramebufferRenderer::accumulateVolume(AdaptiveResolution& state, float scale,
+                                             const glm::ivec4& viewport)
+{
+    if (state.historySize != _resolution) {
+        if (state.historyFramebuffer == 0) {
+            glGenFramebuffers(1, &state.historyFramebuffer);
+            glGenTextures(2, state.historyTextures.data());
+        }
+        for (GLuint texture : state.historyTextures) {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                GL_RGBA32F,
+                _resolution.x,
+                _resolution.y,
+                0,
+                GL_RGBA,
+                GL_FLOAT,
+                nullptr
+            );
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        state.historySize = _resolution;
+        state.hasHistory = false;
+    }
+
+    // Blend in the new resolution over a few frames after a change while the camera is
+    // still. A moving camera would leave trails, so the history is not used then
+    float weight = 1.f;
+    if (state.hasHistory && state.nStillFrames > 0 &&
+        state.nFramesSinceSwitch < AdaptiveAccumulationFrames)
+    {
+        weight = static_cast<float>(state.nFramesSinceSwitch + 1) /
+                 static_cast<float>(AdaptiveAccumulationFrames);
+    }
+
+    const GLuint previous = state.historyTextures[state.historyIndex];
+    state.historyIndex = 1 - state.historyIndex;
+    const GLuint next = state.historyTextures[state.historyIndex];
+
+    glBindFramebuffer(GL_FRAMEBUFFER, state.historyFramebuffer);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, next, 0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+    _accumulateVolumeProgram->activate();
+
+    ghoul::opengl::TextureUnit currentUnit;
+    currentUnit.activate();
+    glBindTexture(GL_TEXTURE_2D, _downscaleVolumeRendering.colorTexture);
+    _accumulateVolumeProgram->setUniform(
+        _accumulateVolumeUniformCache.currentVolume,
+        currentUnit
+    );
+
+    ghoul::opengl::TextureUnit previousUnit;
+    previousUnit.activate();
+    glBindTexture(GL_TEXTURE_2D, previous);
+    _accumulateVolumeProgram->setUniform(
+        _accumulateVolumeUniformCache.previousVolume,
+        previousUnit
+    );
+
+    _accumulateVolumeProgram->setUniform(
+        _accumulateVolumeUniformCache.currentScale,
+        scale
+    );
+    _accumulateVolumeProgram->setUniform(_accumulateVolumeUniformCache.weight, weight);
+    _accumulateVolumeProgram->setUniform(
+        _accumulateVolumeUniformCache.viewport,
+        static_cast<float>(viewport[0]),
+        static_cast<float>(viewport[1]),
+        static_cast<float>(viewport[2]),
+        static_cast<float>(viewport[3])
+    );
+    _accumulateVolumeProgram->setUniform(
+        _accumulateVolumeUniformCache.resolution,
+        glm::vec2(_resolution)
+    );
+
+    glDisablei(GL_BLEND, 0);
+    glDisable(GL_DEPTH_TEST);
+
+    glBindVertexArray(_screenQuad);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+
+    _accumulateVolumeProgram->deactivate();
+
+    global::renderEngine->openglStateCache().resetBlendState();
+    global::renderEngine->openglStateCache().resetDepthState();
+
+    state.hasHistory = true;
+    return next;
+}
+
+void FramebufferRenderer::releaseAdaptiveResolution(AdaptiveResolution& state) {
+    if (state.queries[0] != 0) {
+        glDeleteQueries(2, state.queries.data());
+    }
+    if (state.historyFramebuffer != 0) {
+        glDeleteFramebuffers(1, &state.historyFramebuffer);
+        glDeleteTextures(2, state.historyTextures.data());
+    }
+    state = AdaptiveResolution();
+}
+
+void FramebufferRenderer::reprojectDeferredcast(TemporalReprojection& state,
+                                                GLuint target, const RenderData& data,
+                                                const glm::ivec4& viewport)
+{
+    if (state.historySize != _resolution) {
+        if (state.framebuffer == 0) {
+            glGenFramebuffers(1, &state.framebuffer);
+            glGenRenderbuffers(1, &state.maskDepthbuffer);
+            glGenFramebuffers(1, &state.historyFramebuffer);
+            glGenTextures(1, &state.historyColorTexture);
+            glGenTextures(1, &state.historyPositionTexture);
+        }
+
+        glBindRenderbuffer(GL_RENDERBUFFER, state.maskDepthbuffer);
+        glRenderbufferStorage(
+            GL_RENDERBUFFER,
+            GL_DEPTH_COMPONENT32F,
+            _resolution.x,
+            _resolution.y
+        );
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        for (GLuint texture : { state.historyColorTexture, state.historyPositionTexture })
+        {
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                GL_RGBA32F,
+                _resolution.x,
+                _resolution.y,
+                0,
+                GL_RGBA,
+                GL_FLOAT,
+                nullptr
+            );
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, state.framebuffer);
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER,
+            GL_DEPTH_ATTACHMENT,
+            GL_RENDERBUFFER,
+            state.maskDepthbuffer
+        );
+        glBindFramebuffer(GL_FRAMEBUFFER, state.historyFramebuffer);
+        glFramebufferTexture(
+            GL_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            state.historyColorTexture,
+            0
+        );
+        glFramebufferTexture(
+            GL_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT1,
+            state.historyPositionTexture,
+            0
+        );
+
+        state.historySize = _resolution;
+        state.hasHistory = false;
+    }
+    if (state.historyViewport != viewport) {
+        // The history was rendered into a different part of the textures
+        state.hasHistory = false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, state.framebuffer);
+    glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, 0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glDepthMask(true);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    if (state.hasHistory) {
+        // The difference between the view matrices is computed in double precision as
+        // they contain the camera position in world coordinates
+        const glm::dmat4 currentToPrevious =
+            state.viewMatrix * glm::inverse(data.camera.combinedViewMatrix());
+
+        _reprojectDeferredProgram->activate();
+
+        ghoul::opengl::TextureUnit positionUnit;
+        positionUnit.activate();
+        glBindTexture(GL_TEXTURE_2D, _gBuffers.positionTexture);
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.mainPositionTexture,
+            positionUnit
+        );
+
+        ghoul::opengl::TextureUnit previousColorUnit;
+        previousColorUnit.activate();
+        glBindTexture(GL_TEXTURE_2D, state.historyColorTexture);
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.previousColorTexture,
+            previousColorUnit
+        );
+
+        ghoul::opengl::TextureUnit previousPositionUnit;
+        previousPositionUnit.activate();
+        glBindTexture(GL_TEXTURE_2D, state.historyPositionTexture);
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.previousPositionTexture,
+            previousPositionUnit
+        );
+
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.currentToPrevious,
+            glm::mat4(currentToPrevious)
+        );
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.previousProjection,
+            state.projectionMatrix
+        );
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.inverseProjection,
+            glm::inverse(data.camera.projectionMatrix())
+        );
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.parity,
+            static_cast<int>(state.parity)
+        );
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.viewport,
+            static_cast<float>(viewport[0]),
+            static_cast<float>(viewport[1]),
+            static_cast<float>(viewport[2]),
+            static_cast<float>(viewport[3])
+        );
+        _reprojectDeferredProgram->setUniform(
+            _reprojectDeferredUniformCache.resolution,
+            glm::vec2(_resolution)
+        );
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_ALWAYS);
+
+        glBindVertexArray(_screenQuad);
+        glDrawArrays(GL_TRIANGLES, 0, 6);
+        glBindVertexArray(0);
+
+        _reprojectDeferredProgram->deactivate();
+    }
+
+    // The reprojected pixels have a depth of 0 and all others keep the cleared depth of
+    // 1, so only the latter pass the depth test with the screen quad at a depth of 0.5
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(false);
+}
+
+void FramebufferRenderer::storeDeferredcastHistory(TemporalReprojection& state,
+                                                   const RenderData& data,
+                                                   const glm::ivec4& viewport)
+{
+    const glm::ivec4 rect = glm::ivec4(
+        viewport.x,
+        viewport.y,
+        viewport.x + viewport.z,
+        viewport.y + viewport.w
+    );
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, state.framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, state.historyFramebuffer);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glBlitFramebuffer(
+        rect.x, rect.y, rect.z, rect.w,
+        rect.x, rect.y, rect.z, rect.w,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST
+    );
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _gBuffers.framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    glDrawBuffer(GL_COLOR_ATTACHMENT1);
+    glBlitFramebuffer(
+        rect.x, rect.y, rect.z, rect.w,
+        rect.x, rect.y, rect.z, rect.w,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST
+    );
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+    state.viewMatrix = data.camera.combinedViewMatrix();
+    state.projectionMatrix = data.camera.projectionMatrix();
+    state.historyViewport = viewport;
+    state.hasHistory = true;
+    state.parity = 1 - state.parity;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, _pingPongBuffers.framebuffer);
+    global::renderEngine->openglStateCache().resetDepthState();
+}
+
+void FramebufferRenderer::releaseTemporalReprojection(TemporalReprojection& state) {
+    if (state.framebuffer != 0) {
+        glDeleteFramebuffers(1, &state.framebuffer);
+        glDeleteRenderbuffers(1, &state.maskDepthbuffer);
+        glDeleteFramebuffers(1, &state.historyFramebuffer);
+        glDeleteTextures(1, &state.historyColorTexture);
+        glDeleteTextures(1, &state.historyPositionTexture);
+    }
+    state = TemporalReprojection();
+}
+
 void FramebufferRenderer::performDeferredTasks(
                                              const std::vector<DeferredcasterTask>& tasks,
                                                                const glm::ivec4& viewport)
@@ -1347,10 +2028,28 @@ void FramebufferRenderer::performDeferredTasks(
         if (deferredcastProgram) {
             _pingPongIndex = _pingPongIndex == 0 ? 1 : 0;
             const int fromIndex = _pingPongIndex == 0 ? 1 : 0;
-            glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
             glDisablei(GL_BLEND, 0);
             glDisablei(GL_BLEND, 1);
 
+            TemporalReprojection* temporal = nullptr;
+            if (deferredcaster->hasTemporalReprojection()) {
+                temporal = &_temporalReprojections[deferredcaster];
+                reprojectDeferredcast(
+                    *temporal,
+                    _pingPongBuffers.colorTexture[_pingPongIndex],
+                    deferredcasterTask.renderData,
+                    viewport
+                );
+            }
+            else {
+                auto it = _temporalReprojections.find(deferredcaster);
+                if (it != _temporalReprojections.end()) {
+                    releaseTemporalReprojection(it->second);
+                    _temporalReprojections.erase(it);
+                }
+                glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
+            }
+
             deferredcastProgram->activate();
 
             // adding G-Buffer
@@ -1397,8 +2096,12 @@ void FramebufferRenderer::performDeferredTasks(
                 *deferredcastProgram
             );
 
-            glDisable(GL_DEPTH_TEST);
-            glDepthMask(false);
+            if (!temporal) {
+                // With the temporal reprojection, the depth test rejects the pixels that
+                // have been reprojected
+                glDisable(GL_DEPTH_TEST);
+                glDepthMask(false);
+            }
 
             glBindVertexArray(_screenQuad);
             glDrawArrays(GL_TRIANGLES, 0, 6);
@@ -1414,6 +2117,14 @@ void FramebufferRenderer::performDeferredTasks(
             );
 
             deferredcastProgram->deactivate();
+
+            if (temporal) {
+                storeDeferredcastHistory(
+                    *temporal,
+                    deferredcasterTask.renderData,
+                    viewport
+                );
+            }
         }
         else {
             LWARNING(
@@ -1423,6 +2134,117 @@ void FramebufferRenderer::performDeferredTasks(
     }
 }
 
+void FramebufferRenderer::performOrderIndependentTransparencyTasks(
+                                          const std::vector<std::function<void()>>& tasks)
+{
+    ZoneScoped;
+
+    if (_transparencyBuffers.framebuffer == 0) {
+        LDEBUG("Creating order-independent transparency buffers");
+        glGenTextures(1, &_transparencyBuffers.accumulationTexture);
+        glGenTextures(1, &_transparencyBuffers.revealageTexture);
+        updateOrderIndependentTransparencyTextures();
+
+        glGenFramebuffers(1, &_transparencyBuffers.framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, _transparencyBuffers.framebuffer);
+        glFramebufferTexture(
+            GL_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            _transparencyBuffers.accumulationTexture,
+            0
+        );
+        glFramebufferTexture(
+            GL_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT1,
+            _transparencyBuffers.revealageTexture,
+            0
+        );
+        glFramebufferTexture(
+            GL_FRAMEBUFFER,
+            GL_DEPTH_ATTACHMENT,
+            _gBuffers.depthTexture,
+            0
+        );
+        if (glbinding::Binding::ObjectLabel.isResolved()) {
+            glObjectLabel(
+                GL_FRAMEBUFFER,
+                _transparencyBuffers.framebuffer,
+                -1,
+                "Order-Independent Transparency"
+            );
+        }
+
+        const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            LERROR("Order-independent transparency framebuffer is not complete");
+        }
+    }
+
+    // Remember where the scene is currently rendered to, so that we can composite the
+    // transparent objects onto it afterwards
+    GLint sceneFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &sceneFramebuffer);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, _transparencyBuffers.framebuffer);
+    glDrawBuffers(2, ColorAttachmentArray.data());
+    constexpr glm::vec4 AccumulationClearValue = glm::vec4(0.f);
+    constexpr glm::vec4 RevealageClearValue = glm::vec4(1.f);
+    glClearBufferfv(GL_COLOR, 0, glm::value_ptr(AccumulationClearValue));
+    glClearBufferfv(GL_COLOR, 1, glm::value_ptr(RevealageClearValue));
+
+    for (const std::function<void()>& task : tasks) {
+        // The state is set for each task, since the renderables might reset the blending
+        // and depth state after they are done
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(false);
+        glEnablei(GL_BLEND, 0);
+        glEnablei(GL_BLEND, 1);
+        glBlendFunci(0, GL_ONE, GL_ONE);
+        glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+
+        task();
+    }
+
+    // Composite the average color of the transparent fragments onto the scene
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFramebuffer);
+    glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
+
+    _transparencyResolveProgram->activate();
+
+    ghoul::opengl::TextureUnit accumulationUnit;
+    accumulationUnit.activate();
+    glBindTexture(GL_TEXTURE_2D, _transparencyBuffers.accumulationTexture);
+    _transparencyResolveProgram->setUniform(
+        _transparencyUniformCache.accumulationTexture,
+        accumulationUnit
+    );
+
+    ghoul::opengl::TextureUnit revealageUnit;
+    revealageUnit.activate();
+    glBindTexture(GL_TEXTURE_2D, _transparencyBuffers.revealageTexture);
+    _transparencyResolveProgram->setUniform(
+        _transparencyUniformCache.revealageTexture,
+        revealageUnit
+    );
+
+    glDisablei(GL_BLEND, 1);
+    glEnablei(GL_BLEND, 0);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(false);
+    glDisable(GL_DEPTH_TEST);
+
+    glBindVertexArray(_screenQuad);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glBindVertexArray(0);
+
+    glDepthMask(true);
+    glEnable(GL_DEPTH_TEST);
+
+    _transparencyResolveProgram->deactivate();
+
+    global::renderEngine->openglStateCache().resetBlendState();
+}
+
 void FramebufferRenderer::setResolution(glm::ivec2 res) {
     _resolution = std::move(res);
     _dirtyResolution = true;
@@ -1454,6 +2276,38 @@ void FramebufferRenderer::enableFXAA(bool enable) {
     _enableFXAA = enable;
 }
 
+void FramebufferRenderer::setUseDrawLists(bool enable) {
+    _useDrawLists = enable;
+}
+
+void FramebufferRenderer::setCompactFormats(bool enable) {
+    if (enable == _useCompactFormats) {
+        return;
+    }
+
+    _useCompactFormats = enable;
+    _dirtyResolution = true;
+    updateRendererData();
+}
+
+void FramebufferRenderer::enableDynamicResolution(bool enable) {
+    _dynamicResolution.isEnabled = enable;
+    _dynamicResolution.isQueryIssued = { false, false };
+    _dynamicResolution.gpuTime = 0.f;
+}
+
+void FramebufferRenderer::setTargetFrameTime(float milliseconds) {
+    ghoul_assert(milliseconds > 0.f, "Target frame time must be greater than zero");
+    _dynamicResolution.targetFrameTime = milliseconds;
+}
+
+void FramebufferRenderer::setDynamicResolutionBounds(float minScale, float maxScale) {
+    ghoul_assert(minScale > 0.f, "Minimum scale must be greater than zero");
+    ghoul_assert(maxScale <= 1.f, "Maximum scale must be at most one");
+    _dynamicResolution.minScale = std::min(minScale, maxScale);
+    _dynamicResolution.maxScale = maxScale;
+}
+
 void FramebufferRenderer::updateRendererData() {
     ZoneScoped;
 
@@ -1461,6 +2315,7 @@ void FramebufferRenderer::updateRendererData() {
     dict.setValue("fragmentRendererPath", std::string(RenderFragmentShaderPath));
     dict.setValue("hdrExposure", std::to_string(_hdrExposure));
     dict.setValue("disableHDR", std::to_string(_disableHDR));
+    dict.setValue("compactFormats", std::to_string(_useCompactFormats));
     _rendererData = dict;
     global::renderEngine->setRendererData(dict);
 }
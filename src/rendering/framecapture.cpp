@@ -0,0 +1,342 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/framecapture.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/engine/windowdelegate.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <stb_image_write.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef WIN32
+#define popen _popen
+#define pclose _pclose
+#endif // WIN32
+
+namespace {
+    constexpr std::string_view _loggerCat = "FrameCapture";
+
+    enum class Format {
+        PNG = 0,
+        JPEG,
+        TGA
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
+        "Enabled",
+        "Enabled",
+        "If this value is enabled, screenshots are read back asynchronously and encoded "
+        "on background threads, which makes it possible to render image sequences at a "
+        "much higher rate. The back buffer of the window that is current at the end of "
+        "the frame is captured. If this value is disabled, screenshots are taken by the "
+        "windowing framework, which supports multiple windows and unwarped images.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FormatInfo = {
+        "Format",
+        "Format",
+        "The image format in which the captured frames are stored.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo JpegQualityInfo = {
+        "JpegQuality",
+        "JPEG Quality",
+        "The quality between 1 and 100 that is used when frames are stored as JPEG.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo VideoEncoderCommandInfo = {
+        "VideoEncoderCommand",
+        "Video Encoder Command",
+        "If this value is not empty, the captured frames are not stored as images but "
+        "are written as raw, top-to-bottom RGBA data to the standard input of the "
+        "process started with this command. The process is started with the first "
+        "captured frame, for example 'ffmpeg -f rawvideo -pix_fmt rgba -s 1920x1080 "
+        "-r 30 -i - output.mp4', and it is closed when the command is changed.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    void encodeImage(const std::filesystem::path& path,
+                     const std::vector<std::byte>& data, glm::ivec2 size, Format format,
+                     int jpegQuality)
+    {
+        const std::string file = path.string();
+        int res = 0;
+        switch (format) {
+            case Format::PNG:
+                res = stbi_write_png(
+                    file.c_str(), size.x, size.y, 4, data.data(), size.x * 4
+                );
+                break;
+            case Format::JPEG:
+                res = stbi_write_jpg(
+                    file.c_str(), size.x, size.y, 4, data.data(), jpegQuality
+                );
+                break;
+            case Format::TGA:
+                res = stbi_write_tga(file.c_str(), size.x, size.y, 4, data.data());
+                break;
+        }
+
+        if (res == 0) {
+            LERROR(std::format("Error writing frame '{}'", file));
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+FrameCapture::FrameCapture()
+    : properties::PropertyOwner({ "FrameCapture", "Frame Capture" })
+    , _isEnabled(EnabledInfo, false)
+    , _format(FormatInfo)
+    , _jpegQuality(JpegQualityInfo, 90, 1, 100)
+    , _videoEncoderCommand(VideoEncoderCommandInfo)
+{
+    addProperty(_isEnabled);
+
+    _format.addOptions({
+        { static_cast<int>(Format::PNG), "PNG" },
+        { static_cast<int>(Format::JPEG), "JPEG" },
+        { static_cast<int>(Format::TGA), "TGA" }
+    });
+    _format = static_cast<int>(Format::PNG);
+    addProperty(_format);
+
+    addProperty(_jpegQuality);
+
+    _videoEncoderCommand.onChange([this]() { closeEncoder(); });
+    addProperty(_videoEncoderCommand);
+}
+
+void FrameCapture::deinitializeGL() {
+    for (int i = 0; i < NumberOfBuffers; i++) {
+        Buffer& buffer = _buffers[(_nextBuffer + i) % NumberOfBuffers];
+        if (buffer.fence) {
+            finishFrame(buffer, true);
+        }
+        if (buffer.pbo != 0) {
+            glDeleteBuffers(1, &buffer.pbo);
+        }
+        buffer = Buffer();
+    }
+
+    for (std::future<void>& encoding : _encodings) {
+        encoding.wait();
+    }
+    _encodings.clear();
+    closeEncoder();
+}
+
+bool FrameCapture::isEnabled() const {
+    return _isEnabled;
+}
+
+void FrameCapture::capture(std::filesystem::path path) {
+    const std::string_view extension = [this]() {
+        switch (static_cast<Format>(_format.value())) {
+            case Format::PNG:  return ".png";
+            case Format::JPEG: return ".jpg";
+            case Format::TGA:  return ".tga";
+        }
+        throw ghoul::MissingCaseException();
+    }();
+    path.replace_extension(extension);
+    _requestedCapture = std::move(path);
+}
+
+void FrameCapture::nextFrame() {
+    ZoneScoped;
+
+    // First hand over all finished reads in the order in which they were issued so that
+    // frames reach the video encoder in the correct order
+    for (int i = 0; i < NumberOfBuffers; i++) {
+        Buffer& buffer = _buffers[(_nextBuffer + i) % NumberOfBuffers];
+        if (buffer.fence && !finishFrame(buffer, false)) {
+            break;
+        }
+    }
+
+    if (_requestedCapture.has_value()) {
+        readFrame(std::move(*_requestedCapture));
+        _requestedCapture = std::nullopt;
+    }
+
+    std::erase_if(
+        _encodings,
+        [](const std::future<void>& f) {
+            return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+    );
+}
+
+void FrameCapture::readFrame(std::filesystem::path path) {
+    ZoneScoped;
+
+    Buffer& buffer = _buffers[_nextBuffer];
+    _nextBuffer = (_nextBuffer + 1) % NumberOfBuffers;
+    if (buffer.fence) {
+        // The ring is full as the GPU has fallen behind, so we have to wait for the
+        // oldest read to finish before we can reuse its buffer
+        finishFrame(buffer, true);
+    }
+
+    const glm::ivec2 size = global::windowDelegate->currentWindowSize();
+    const GLsizeiptr nBytes = static_cast<GLsizeiptr>(size.x) * size.y * 4;
+    if (buffer.pbo == 0) {
+        glGenBuffers(1, &buffer.pbo);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+    if (buffer.size != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, nBytes, nullptr, GL_STREAM_READ);
+    }
+
+    GLint readFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+    GLint readBuffer = 0;
+    glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+    GLint packAlignment = 0;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    glReadBuffer(static_cast<GLenum>(readBuffer));
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    buffer.size = size;
+    buffer.path = std::move(path);
+}
+
+bool FrameCapture::finishFrame(Buffer& buffer, bool wait) {
+    ZoneScoped;
+
+    ghoul_assert(buffer.fence, "No read to finish");
+
+    if (wait) {
+        constexpr GLuint64 Timeout = 1'000'000'000; // 1s in nanoseconds
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, Timeout);
+        }
+        if (status == GL_WAIT_FAILED) {
+            LERROR(std::format("Error waiting for frame '{}'", buffer.path));
+        }
+    }
+    else {
+        const GLenum status = glClientWaitSync(buffer.fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            return false;
+        }
+    }
+    glDeleteSync(buffer.fence);
+    buffer.fence = nullptr;
+
+    // Copy the pixels out of the mapped buffer and flip them, as OpenGL stores the
+    // bottom row first, while all image formats and video encoders expect the top row
+    const size_t rowSize = static_cast<size_t>(buffer.size.x) * 4;
+    std::vector<std::byte> pixels = std::vector<std::byte>(rowSize * buffer.size.y);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.pbo);
+    const std::byte* data = reinterpret_cast<const std::byte*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, pixels.size(), GL_MAP_READ_BIT)
+    );
+    if (!data) {
+        LERROR(std::format("Error mapping frame '{}'", buffer.path));
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return true;
+    }
+    for (int y = 0; y < buffer.size.y; y++) {
+        std::memcpy(
+            pixels.data() + (buffer.size.y - 1 - y) * rowSize,
+            data + y * rowSize,
+            rowSize
+        );
+    }
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!_videoEncoderCommand.value().empty()) {
+        writeToEncoder(pixels, buffer.size);
+        return true;
+    }
+
+    _encodings.push_back(global::threadPool->submit(
+        [path = std::move(buffer.path), pixels = std::move(pixels), size = buffer.size,
+         format = static_cast<Format>(_format.value()), quality = _jpegQuality.value()]
+        () {
+            encodeImage(path, pixels, size, format, quality);
+        },
+        ThreadPool::Priority::Low
+    ));
+    return true;
+}
+
+void FrameCapture::writeToEncoder(const std::vector<std::byte>& pixels,
+                                  const glm::ivec2& size)
+{
+    if (_encoder && size != _encoderSize) {
+        LWARNING("Window size changed, restarting the video encoder");
+        closeEncoder();
+    }
+
+    if (!_encoder) {
+        _encoder = popen(_videoEncoderCommand.value().c_str(), "wb");
+        if (!_encoder) {
+            LERROR(std::format(
+                "Error starting video encoder '{}'", _videoEncoderCommand.value()
+            ));
+            return;
+        }
+        _encoderSize = size;
+    }
+
+    const size_t written = std::fwrite(pixels.data(), 1, pixels.size(), _encoder);
+    if (written != pixels.size()) {
+        LERROR("Error writing frame to the video encoder");
+        closeEncoder();
+    }
+}
+
+void FrameCapture::closeEncoder() {
+    if (_encoder) {
+        pclose(_encoder);
+        _encoder = nullptr;
+        _encoderSize = glm::ivec2(0);
+    }
+}
+
+} // namespace openspace
@@ -0,0 +1,194 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/gputimerpool.h>
+
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <limits>
+
+namespace {
+    constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
+        "Enabled",
+        "Enabled",
+        "If this value is enabled, the GPU time of each render pass and each rendered "
+        "scene graph node is measured. The measurement requires two timestamp queries "
+        "per measured section and should only be enabled while investigating the "
+        "performance of a scene.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrameTimeInfo = {
+        "FrameTime",
+        "Frame Time (ms)",
+        "The GPU time in milliseconds between the start of the first and the end of the "
+        "last measured section of the latest frame whose results are available.",
+        openspace::properties::Property::Visibility::Developer
+    };
+} // namespace
+
+namespace openspace {
+
+GpuTimerPool::Scope::Scope(GpuTimerPool& pool, std::string_view name)
+    : _pool(pool)
+    , _section(pool.begin(name))
+{}
+
+GpuTimerPool::Scope::~Scope() {
+    _pool.end(_section);
+}
+
+GpuTimerPool::GpuTimerPool()
+    : properties::PropertyOwner({ "GpuTiming", "GPU Timing" })
+    , _isEnabled(EnabledInfo, false)
+    , _frameTime(FrameTimeInfo, 0.f, 0.f, std::numeric_limits<float>::max())
+{
+    _isEnabled.onChange([this]() {
+        if (!_isEnabled) {
+            _times.clear();
+            _frameTime = 0.f;
+        }
+    });
+    addProperty(_isEnabled);
+    _frameTime.setReadOnly(true);
+    addProperty(_frameTime);
+}
+
+void GpuTimerPool::deinitializeGL() {
+    for (Frame& frame : _frames) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries(
+                static_cast<GLsizei>(frame.queries.size()),
+                frame.queries.data()
+            );
+        }
+        frame = Frame();
+    }
+}
+
+bool GpuTimerPool::isEnabled() const {
+    return _isEnabled;
+}
+
+void GpuTimerPool::nextFrame() {
+    ZoneScoped;
+
+    _currentFrame = (_currentFrame + 1) % Latency;
+    Frame& frame = _frames[_currentFrame];
+    if (frame.sections.empty()) {
+        frame.nUsedQueries = 0;
+        return;
+    }
+
+    // The queries are finished in order, so if the last one is available, all of them
+    // are. If the GPU has fallen behind by more than the latency, the results of this
+    // frame are dropped instead of waiting for them
+    GLint isAvailable = GL_FALSE;
+    glGetQueryObjectiv(
+        frame.queries[frame.nUsedQueries - 1],
+        GL_QUERY_RESULT_AVAILABLE,
+        &isAvailable
+    );
+    if (isAvailable == GL_TRUE) {
+        std::vector<GLuint64> timestamps(frame.nUsedQueries);
+        for (int i = 0; i < frame.nUsedQueries; i++) {
+            glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+        }
+
+        _times.clear();
+        GLuint64 first = std::numeric_limits<GLuint64>::max();
+        GLuint64 last = 0;
+        for (const Section& section : frame.sections) {
+            const GLuint64 begin = timestamps[section.beginQuery];
+            const GLuint64 end = timestamps[section.endQuery];
+            first = std::min(first, begin);
+            last = std::max(last, end);
+            // Timestamps are in nanoseconds
+            const float ms = static_cast<float>(end - begin) / 1'000'000.f;
+            _times[section.name] += ms;
+        }
+        _frameTime = static_cast<float>(last - first) / 1'000'000.f;
+    }
+
+    frame.nUsedQueries = 0;
+    frame.sections.clear();
+}
+
+int GpuTimerPool::begin(std::string_view name) {
+    if (!_isEnabled) {
+        return -1;
+    }
+
+    Frame& frame = _frames[_currentFrame];
+    const int query = nextQuery();
+    glQueryCounter(frame.queries[query], GL_TIMESTAMP);
+    frame.sections.push_back({
+        .name = std::string(name),
+        .beginQuery = query,
+        .endQuery = query
+    });
+    return static_cast<int>(frame.sections.size()) - 1;
+}
+
+void GpuTimerPool::end(int section) {
+    Frame& frame = _frames[_currentFrame];
+    // If the timing was disabled or enabled in between, the section might not exist
+    if (section < 0 || section >= static_cast<int>(frame.sections.size())) {
+        return;
+    }
+
+    const int query = nextQuery();
+    glQueryCounter(frame.queries[query], GL_TIMESTAMP);
+    frame.sections[section].endQuery = query;
+}
+
+float GpuTimerPool::time(std::string_view name) const {
+    const auto it = _times.find(name);
+    return it != _times.end() ? it->second : -1.f;
+}
+
+std::vector<GpuTimerPool::Timing> GpuTimerPool::timings() const {
+    std::vector<Timing> res;
+    res.reserve(_times.size());
+    for (const auto& [name, time] : _times) {
+        res.push_back({ .name = name, .time = time });
+    }
+    return res;
+}
+
+int GpuTimerPool::nextQuery() {
+    Frame& frame = _frames[_currentFrame];
+    if (frame.nUsedQueries == static_cast<int>(frame.queries.size())) {
+        // Grow the pool in chunks to not have to create queries every frame while a
+        // scene is loading
+        constexpr int ChunkSize = 64;
+        frame.queries.resize(frame.queries.size() + ChunkSize);
+        glGenQueries(ChunkSize, frame.queries.data() + frame.nUsedQueries);
+    }
+    const int query = frame.nUsedQueries;
+    frame.nUsedQueries++;
+    return query;
+}
+
+} // namespace openspace
@@ -26,6 +26,7 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
+#include <openspace/rendering/renderengine.h>
 #include <openspace/scene/lightsource.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/misc/assert.h>
@@ -169,7 +170,7 @@ void initialize() {
         fragmentFile.open(xyuvrgbaFragmentFile, std::fstream::out);
         fragmentFile << XyuvrgbaFragmentCode;
     }
-    shaders.xyuvrgba.program = ghoul::opengl::ProgramObject::Build(
+    shaders.xyuvrgba.program = global::renderEngine->buildCachedProgram(
         "xyuvrgba",
         xyuvrgbaVertexFile,
         xyuvrgbaFragmentFile
@@ -198,7 +199,7 @@ void initialize() {
         fragmentFile << XyuvrgbaFragmentCode;
     }
 
-    shaders.screenfilling.program = ghoul::opengl::ProgramObject::Build(
+    shaders.screenfilling.program = global::renderEngine->buildCachedProgram(
         "screenfilling",
         xyuvrgbaVertexFile,
         xyuvrgbaFragmentFile
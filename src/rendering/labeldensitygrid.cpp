@@ -0,0 +1,63 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/labeldensitygrid.h>
+
+#include <algorithm>
+
+namespace openspace {
+
+void LabelDensityGrid::reset(const glm::ivec2& resolution, int maxLabelsPerRegion) {
+    _resolution = resolution;
+    _maxLabelsPerRegion = maxLabelsPerRegion;
+    _nRegions = (resolution + RegionSize - 1) / RegionSize;
+    _counts.assign(static_cast<size_t>(std::max(_nRegions.x * _nRegions.y, 0)), 0);
+}
+
+bool LabelDensityGrid::tryAdd(const glm::dvec4& clipPosition) {
+    if (_maxLabelsPerRegion <= 0 || clipPosition.w <= 0.0) {
+        return true;
+    }
+
+    const glm::dvec2 ndc = glm::dvec2(clipPosition) / clipPosition.w;
+    if (ndc.x < -1.0 || ndc.x > 1.0 || ndc.y < -1.0 || ndc.y > 1.0) {
+        return true;
+    }
+
+    const glm::dvec2 pixel = (ndc * 0.5 + 0.5) * glm::dvec2(_resolution);
+    const glm::ivec2 region = glm::clamp(
+        glm::ivec2(pixel) / RegionSize,
+        glm::ivec2(0),
+        _nRegions - 1
+    );
+
+    int& count = _counts[region.y * _nRegions.x + region.x];
+    if (count >= _maxLabelsPerRegion) {
+        return false;
+    }
+    count++;
+    return true;
+}
+
+} // namespace openspace
@@ -27,11 +27,23 @@
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/documentation/documentation.h>
+#include <openspace/rendering/renderengine.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
+#include <ghoul/font/font.h>
 #include <ghoul/font/fontmanager.h>
 #include <ghoul/font/fontrenderer.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/opengl/openglstatecache.h>
+#include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/textureatlas.h>
+#include <ghoul/opengl/textureunit.h>
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
 #include <optional>
+#include <vector>
 
 namespace {
     constexpr std::string_view _loggerCat = "LabelsComponent";
@@ -39,6 +51,48 @@ namespace {
     constexpr int RenderOptionFaceCamera = 0;
     constexpr int RenderOptionPositionNormal = 1;
 
+    // Anchor position, glyph rectangle, texture and outline texture coordinate rectangle
+    constexpr int NFloatsPerGlyph = 3 + 4 + 4 + 4;
+
+    // Nodes of the octree are split until they contain at most this many labels
+    constexpr uint32_t OctreeLeafSize = 64;
+    constexpr int OctreeMaxDepth = 16;
+
+    // The size of the labels on screen is only estimated for the octree nodes, so only
+    // nodes that are well below the minimum size are culled
+    constexpr double SizeCullingMargin = 0.25;
+
+    // Tests the box against the side planes of the view frustum and returns the smallest
+    // clip-space w of its corners, or std::nullopt if the box is not visible
+    std::optional<double> cullBox(const glm::dmat4& mvp, const glm::vec3& boundsMin,
+                                  const glm::vec3& boundsMax)
+    {
+        std::array<int, 5> nOutside = {};
+        double minW = std::numeric_limits<double>::max();
+        for (int i = 0; i < 8; i++) {
+            const glm::dvec3 corner = glm::dvec3(
+                (i & 1) ? boundsMax.x : boundsMin.x,
+                (i & 2) ? boundsMax.y : boundsMin.y,
+                (i & 4) ? boundsMax.z : boundsMin.z
+            );
+            const glm::dvec4 c = mvp * glm::dvec4(corner, 1.0);
+            nOutside[0] += c.x < -c.w ? 1 : 0;
+            nOutside[1] += c.x > c.w ? 1 : 0;
+            nOutside[2] += c.y < -c.w ? 1 : 0;
+            nOutside[3] += c.y > c.w ? 1 : 0;
+            nOutside[4] += c.w <= 0.0 ? 1 : 0;
+            minW = std::min(minW, c.w);
+        }
+
+        // If all corners are on the outside of the same plane, the box is not visible
+        const bool isOutside = std::any_of(
+            nOutside.begin(),
+            nOutside.end(),
+            [](int n) { return n == 8; }
+        );
+        return isOutside ? std::nullopt : std::optional<double>(minW);
+    }
+
     constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
         "Enabled",
         "Enabled",
@@ -90,6 +144,25 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseBatchedRenderingInfo = {
+        "UseBatchedRendering",
+        "Use Batched Rendering",
+        "If enabled, the glyphs of all labels are stored on the GPU and all labels are "
+        "rendered in a single draw call, rather than laying out and drawing each label "
+        "separately every frame. This is much faster for large label sets, but labels "
+        "that are smaller than the minimum size are hidden rather than drawn.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MaxLabelsPerRegionInfo = {
+        "MaxLabelsPerRegion",
+        "Max Labels per Region",
+        "The maximum number of labels that are drawn in each 64 by 64 pixel region of "
+        "the screen. Labels that are closer to the camera are given priority. A value of "
+        "0 means that the number of labels is not limited.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo TransformationMatrixInfo = {
         "TransformationMatrix",
         "Transformation Matrix",
@@ -139,6 +212,12 @@ namespace {
         // [[codegen::verbatim(FaceCameraInfo.description)]]
         std::optional<bool> faceCamera;
 
+        // [[codegen::verbatim(UseBatchedRenderingInfo.description)]]
+        std::optional<bool> useBatchedRendering;
+
+        // [[codegen::verbatim(MaxLabelsPerRegionInfo.description)]]
+        std::optional<int> maxLabelsPerRegion [[codegen::greaterequal(0)]];
+
         // [[codegen::verbatim(TransformationMatrixInfo.description)]]
         std::optional<glm::dmat4x4> transformationMatrix;
     };
@@ -147,6 +226,8 @@ namespace {
 
 namespace openspace {
 
+ghoul::opengl::ProgramObject* LabelsComponent::_batchedProgram = nullptr;
+
 documentation::Documentation LabelsComponent::Documentation() {
     return codegen::doc<Parameters>("labelscomponent");
 }
@@ -164,6 +245,8 @@ LabelsComponent::LabelsComponent(const ghoul::Dictionary& dictionary)
         glm::ivec2(1000)
     )
     , _faceCamera(FaceCameraInfo, true)
+    , _useBatchedRendering(UseBatchedRenderingInfo, false)
+    , _maxLabelsPerRegion(MaxLabelsPerRegionInfo, 0, 0, 100)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -217,10 +300,20 @@ LabelsComponent::LabelsComponent(const ghoul::Dictionary& dictionary)
     }
     addProperty(_faceCamera);
 
+    _useBatchedRendering = p.useBatchedRendering.value_or(_useBatchedRendering);
+    addProperty(_useBatchedRendering);
+
+    _maxLabelsPerRegion = p.maxLabelsPerRegion.value_or(_maxLabelsPerRegion);
+    addProperty(_maxLabelsPerRegion);
+
     _transformationMatrix = p.transformationMatrix.value_or(_transformationMatrix);
 }
 
 dataloader::Labelset& LabelsComponent::labelSet() {
+    // The caller might change the labels, so we have to regenerate the batched glyphs
+    // and the octree
+    _batchIsDirty = true;
+    _octreeIsDirty = true;
     return _labelset;
 }
 
@@ -237,10 +330,20 @@ void LabelsComponent::initialize() {
         ghoul::fontrendering::FontManager::Outline::Yes,
         ghoul::fontrendering::FontManager::LoadGlyphs::No
     );
+    _batchIsDirty = true;
 
     loadLabels();
 }
 
+void LabelsComponent::deinitializeGL() {
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+    _nGlyphs = 0;
+    _batchIsDirty = true;
+}
+
 void LabelsComponent::loadLabelsFromDataset(const dataloader::Dataset& dataset,
                                             DistanceUnit unit)
 {
@@ -255,6 +358,8 @@ void LabelsComponent::loadLabelsFromDataset(const dataloader::Dataset& dataset,
     // Load the labelset directly based on the dataset, and keep track of that it has
     // already been loaded this way
     _labelset = dataloader::label::loadFromDataset(dataset);
+    _batchIsDirty = true;
+    _octreeIsDirty = true;
 
     _createdFromDataset = true;
 }
@@ -275,6 +380,8 @@ void LabelsComponent::loadLabels() {
     else {
         _labelset = dataloader::label::loadFile(_labelFile);
     }
+    _batchIsDirty = true;
+    _octreeIsDirty = true;
 }
 
 bool LabelsComponent::isReady() const {
@@ -293,7 +400,25 @@ void LabelsComponent::render(const RenderData& data,
     if (!_enabled) {
         return;
     }
-    const float scale = static_cast<float>(toMeter(_unit));
+
+    if (_useBatchedRendering) {
+        renderBatched(
+            data,
+            modelViewProjectionMatrix,
+            orthoRight,
+            orthoUp,
+            fadeInVariable
+        );
+        return;
+    }
+
+    if (_octreeIsDirty) {
+        updateOctree();
+    }
+
+    if (_octree.empty()) {
+        return;
+    }
 
     const int renderOption =
         _faceCamera ? RenderOptionFaceCamera : RenderOptionPositionNormal;
@@ -313,25 +438,337 @@ void LabelsComponent::render(const RenderData& data,
 
     const glm::vec4 textColor = glm::vec4(glm::vec3(_color), opacity() * fadeInVariable);
 
+    const glm::ivec2 resolution = global::renderEngine->renderingResolution();
+    _densityGrid.reset(resolution, _maxLabelsPerRegion);
+
+    // The offset in clip space between the bottom and the top of a label, which is used
+    // to estimate the size of the labels in an octree node on screen
+    const double labelHeight = labelInfo.scale * _font->height();
+    const glm::dvec2 clipUp = glm::dvec2(
+        modelViewProjectionMatrix * glm::dvec4(glm::dvec3(orthoUp) * labelHeight, 0.0)
+    );
+    const double minSize = SizeCullingMargin * _minMaxSize.value().x;
+
+    // Traverse the octree from near to far, so that the closest labels get priority in
+    // the density limit
+    std::vector<int> stack = { 0 };
+    while (!stack.empty()) {
+        const OctreeNode& node = _octree[stack.back()];
+        stack.pop_back();
+
+        if (node.nLabels == 0) {
+            continue;
+        }
+
+        const std::optional<double> minW =
+            cullBox(modelViewProjectionMatrix, node.boundsMin, node.boundsMax);
+        if (!minW.has_value()) {
+            continue;
+        }
+        if (*minW > 0.0 && glm::length(clipUp) / *minW * 0.5 * resolution.y < minSize) {
+            continue;
+        }
+
+        if (node.firstChild != -1) {
+            std::array<std::pair<double, int>, 8> children;
+            for (int i = 0; i < 8; i++) {
+                const OctreeNode& child = _octree[node.firstChild + i];
+                const glm::dvec3 center =
+                    glm::dvec3(child.boundsMin + child.boundsMax) * 0.5;
+                const double w = (modelViewProjectionMatrix * glm::dvec4(center, 1.0)).w;
+                children[i] = { w, node.firstChild + i };
+            }
+            // Push the farthest child first, so that the nearest one is visited next
+            std::sort(children.begin(), children.end(), std::greater<>());
+            for (const std::pair<double, int>& child : children) {
+                stack.push_back(child.second);
+            }
+            continue;
+        }
+
+        for (uint32_t i = 0; i < node.nLabels; i++) {
+            const uint32_t index = _octreeLabels[node.firstLabel + i];
+            const glm::vec3& position = _labelPositions[index];
+
+            const glm::dvec4 clipPosition =
+                modelViewProjectionMatrix * glm::dvec4(position, 1.0);
+            if (!_densityGrid.tryAdd(clipPosition)) {
+                continue;
+            }
+
+            ghoul::fontrendering::FontRenderer::defaultProjectionRenderer().render(
+                *_font,
+                position,
+                _labelset.entries[index].text,
+                textColor,
+                labelInfo
+            );
+        }
+    }
+}
+
+void LabelsComponent::updateOctree() {
+    ZoneScoped;
+
+    const float scale = static_cast<float>(toMeter(_unit));
+
+    _labelPositions.clear();
+    _labelPositions.reserve(_labelset.entries.size());
+    _octreeLabels.clear();
+    for (size_t i = 0; i < _labelset.entries.size(); i++) {
+        const dataloader::Labelset::Entry& e = _labelset.entries[i];
+
+        // Transform and scale the labels
+        const glm::vec3 transformedPos = glm::vec3(
+            _transformationMatrix * glm::dvec4(e.position, 1.0)
+        );
+        _labelPositions.push_back(transformedPos * scale);
+
+        if (e.isEnabled) {
+            _octreeLabels.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    _octree.clear();
+    _octreeIsDirty = false;
+    if (_octreeLabels.empty()) {
+        return;
+    }
+
+    OctreeNode root;
+    root.nLabels = static_cast<uint32_t>(_octreeLabels.size());
+    _octree.push_back(root);
+    std::vector<int> depths = { 0 };
+
+    // The nodes are split in breadth-first order, with the new children being appended
+    // to the list of nodes that are still to be processed
+    for (size_t n = 0; n < _octree.size(); n++) {
+        const uint32_t firstLabel = _octree[n].firstLabel;
+        const uint32_t nLabels = _octree[n].nLabels;
+        if (nLabels == 0) {
+            continue;
+        }
+
+        const auto begin = _octreeLabels.begin() + firstLabel;
+        const auto end = begin + nLabels;
+
+        glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+        for (auto it = begin; it != end; it++) {
+            boundsMin = glm::min(boundsMin, _labelPositions[*it]);
+            boundsMax = glm::max(boundsMax, _labelPositions[*it]);
+        }
+        _octree[n].boundsMin = boundsMin;
+        _octree[n].boundsMax = boundsMax;
+
+        if (nLabels <= OctreeLeafSize || depths[n] >= OctreeMaxDepth) {
+            continue;
+        }
+
+        const glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        auto octant = [this, center](uint32_t index) {
+            const glm::vec3& p = _labelPositions[index];
+            return (p.x >= center.x ? 1 : 0) | (p.y >= center.y ? 2 : 0) |
+                (p.z >= center.z ? 4 : 0);
+        };
+        std::sort(
+            begin,
+            end,
+            [&octant](uint32_t lhs, uint32_t rhs) { return octant(lhs) < octant(rhs); }
+        );
+
+        _octree[n].firstChild = static_cast<int>(_octree.size());
+        auto childBegin = begin;
+        for (int o = 0; o < 8; o++) {
+            const auto childEnd = std::partition_point(
+                childBegin,
+                end,
+                [&octant, o](uint32_t index) { return octant(index) <= o; }
+            );
+
+            OctreeNode child;
+            child.firstLabel = static_cast<uint32_t>(childBegin - _octreeLabels.begin());
+            child.nLabels = static_cast<uint32_t>(childEnd - childBegin);
+            _octree.push_back(child);
+            depths.push_back(depths[n] + 1);
+
+            childBegin = childEnd;
+        }
+    }
+}
+
+void LabelsComponent::renderBatched(const RenderData& data,
+                                    const glm::dmat4& modelViewProjectionMatrix,
+                                    const glm::vec3& orthoRight,
+                                    const glm::vec3& orthoUp, float fadeInVariable)
+{
+    ZoneScoped;
+
+    if (!_batchedProgram) {
+        // Just as the debug sphere program of the scene graph nodes, this program is
+        // shared between all labels and lives for the remainder of the application
+        std::unique_ptr<ghoul::opengl::ProgramObject> program =
+            global::renderEngine->buildRenderProgram(
+                "Labels",
+                absPath("${SHADERS}/core/labels_vs.glsl"),
+                absPath("${SHADERS}/core/labels_fs.glsl")
+            );
+        _batchedProgram = program.release();
+        _batchedProgram->setIgnoreUniformLocationError(
+            ghoul::opengl::ProgramObject::IgnoreError::Yes
+        );
+    }
+
+    if (_batchIsDirty) {
+        updateBatchedData();
+    }
+
+    if (_nGlyphs == 0) {
+        return;
+    }
+
+    const int renderOption =
+        _faceCamera ? RenderOptionFaceCamera : RenderOptionPositionNormal;
+    const float opacity = this->opacity() * fadeInVariable;
+
+    _batchedProgram->activate();
+    _batchedProgram->setUniform(
+        "modelViewProjection",
+        glm::mat4(modelViewProjectionMatrix)
+    );
+    _batchedProgram->setUniform("orthoRight", orthoRight);
+    _batchedProgram->setUniform("orthoUp", orthoUp);
+    _batchedProgram->setUniform(
+        "cameraPosition",
+        glm::vec3(data.camera.positionVec3())
+    );
+    _batchedProgram->setUniform(
+        "cameraLookUp",
+        glm::vec3(data.camera.lookUpVectorWorldSpace())
+    );
+    _batchedProgram->setUniform("renderOption", renderOption);
+    _batchedProgram->setUniform("scale", std::pow(10.f, _size.value()));
+    _batchedProgram->setUniform("fontHeight", _font->height());
+    _batchedProgram->setUniform("minMaxSize", glm::vec2(_minMaxSize.value()));
+    _batchedProgram->setUniform(
+        "viewportSize",
+        glm::vec2(global::renderEngine->renderingResolution())
+    );
+    _batchedProgram->setUniform("color", glm::vec4(glm::vec3(_color), opacity));
+    _batchedProgram->setUniform("outlineColor", glm::vec4(0.f, 0.f, 0.f, opacity));
+    _batchedProgram->setUniform("hasOutline", _font->hasOutline());
+
+    ghoul::opengl::TextureUnit unit;
+    unit.activate();
+    _font->atlas().texture().bind();
+    _batchedProgram->setUniform("fontTexture", unit);
+
+    // The glyphs of overlapping labels should not occlude each other
+    glDepthMask(false);
+
+    glBindVertexArray(_vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, _nGlyphs);
+    glBindVertexArray(0);
+
+    _batchedProgram->deactivate();
+    global::renderEngine->openglStateCache().resetDepthState();
+}
+
+void LabelsComponent::updateBatchedData() {
+    ZoneScoped;
+
+    using Glyph = ghoul::fontrendering::Font::Glyph;
+
+    const float scale = static_cast<float>(toMeter(_unit));
+    const float lineHeight = _font->height();
+
+    std::vector<float> data;
     for (const dataloader::Labelset::Entry& e : _labelset.entries) {
         if (!e.isEnabled) {
             continue;
         }
 
-        // Transform and scale the labels
         const glm::vec3 transformedPos = glm::vec3(
             _transformationMatrix * glm::dvec4(e.position, 1.0)
         );
-        const glm::vec3 scaledPos = glm::vec3(transformedPos * scale);
-
-        ghoul::fontrendering::FontRenderer::defaultProjectionRenderer().render(
-            *_font,
-            scaledPos,
-            e.text,
-            textColor,
-            labelInfo
+        const glm::vec3 anchor = transformedPos * scale;
+
+        // Lay out the glyphs the same way as the font renderer, starting at the label
+        // position and moving down one line height for each line break
+        glm::vec2 pen = glm::vec2(0.f);
+        for (const char c : e.text) {
+            if (c == '\n') {
+                pen = glm::vec2(0.f, pen.y - lineHeight);
+                continue;
+            }
+
+            const Glyph* glyph = _font->glyph(
+                static_cast<wchar_t>(static_cast<unsigned char>(c))
+            );
+            if (!glyph) {
+                continue;
+            }
+
+            const float x0 = pen.x + glyph->leftBearing;
+            const float y0 = pen.y + glyph->topBearing;
+            const float x1 = x0 + glyph->width;
+            const float y1 = y0 - glyph->height;
+            pen.x += glyph->advanceX;
+
+            if (glyph->width == 0.f || glyph->height == 0.f) {
+                // Whitespace only advances the position
+                continue;
+            }
+
+            data.insert(data.end(), {
+                anchor.x, anchor.y, anchor.z,
+                x0, y1, x1, y0,
+                glyph->topLeft.x, glyph->bottomRight.y,
+                glyph->bottomRight.x, glyph->topLeft.y,
+                glyph->outlineTopLeft.x, glyph->outlineBottomRight.y,
+                glyph->outlineBottomRight.x, glyph->outlineTopLeft.y
+            });
+        }
+    }
+
+    if (_vao == 0) {
+        glGenVertexArrays(1, &_vao);
+    }
+    if (_vbo == 0) {
+        glGenBuffers(1, &_vbo);
+    }
+
+    glBindVertexArray(_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        data.size() * sizeof(float),
+        data.data(),
+        GL_STATIC_DRAW
+    );
+
+    // Each glyph is one instance, with the corners of the quad generated in the shader
+    constexpr GLsizei Stride = NFloatsPerGlyph * sizeof(float);
+    constexpr std::array<GLint, 4> Sizes = { 3, 4, 4, 4 };
+    size_t offset = 0;
+    for (GLuint i = 0; i < Sizes.size(); i++) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribPointer(
+            i,
+            Sizes[i],
+            GL_FLOAT,
+            GL_FALSE,
+            Stride,
+            reinterpret_cast<void*>(offset * sizeof(float))
         );
+        glVertexAttribDivisor(i, 1);
+        offset += Sizes[i];
     }
+
+    glBindVertexArray(0);
+
+    _nGlyphs = static_cast<GLsizei>(data.size() / NFloatsPerGlyph);
+    _batchIsDirty = false;
 }
 
 } // namespace openspace
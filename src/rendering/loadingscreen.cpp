@@ -74,7 +74,13 @@ namespace {
 
     constexpr std::chrono::milliseconds TTL(5000);
 
-    constexpr std::chrono::milliseconds RefreshRate(16);
+    // The loading screen is redrawn at most this often, which leaves the CPU to the
+    // threads that are loading and initializing the scene
+    constexpr std::chrono::milliseconds MinFrameInterval(33);
+
+    // If nothing changes on screen, a new frame is still rendered this often to keep the
+    // window responsive and to show new log messages
+    constexpr std::chrono::milliseconds MaxFrameInterval(250);
 
     bool rectOverlaps(glm::vec2 lhsLl, glm::vec2 lhsUr, glm::vec2 rhsLl, glm::vec2 rhsUr)
     {
@@ -177,8 +183,13 @@ void LoadingScreen::exec(AssetManager& manager, Scene& scene) {
     postMessage("Loading assets");
 
     std::unordered_set<const ResourceSynchronization*> finishedSynchronizations;
+    size_t nFinishedAssets = 0;
+    bool madeProgress = true;
     while (true) {
-        render();
+        // As long as assets are finishing, the next one is handled right away. Otherwise
+        // we are waiting for synchronizations or for the initialization threads, so we
+        // sleep until one of them reports a change or until the next frame is due
+        renderIfNeeded(waitForChange(!madeProgress));
         manager.update();
 
         std::vector<const Asset*> allAssets = manager.allAssets();
@@ -257,23 +268,29 @@ void LoadingScreen::exec(AssetManager& manager, Scene& scene) {
             return;
         }
 
-        const bool finishedLoading = std::all_of(
+        const size_t nFinished = static_cast<size_t>(std::count_if(
             allAssets.begin(),
             allAssets.end(),
             [](const Asset* asset) { return asset->isInitialized() || asset->isFailed(); }
-        );
-
-        if (finishedLoading) {
+        ));
+        if (nFinished == allAssets.size()) {
             break;
         }
+        madeProgress = nFinished != nFinishedAssets;
+        nFinishedAssets = nFinished;
     } // while(true)
 
     setPhase(LoadingScreen::Phase::Initialization);
 
     postMessage("Initializing scene");
     while (scene.isInitializing()) {
-        render();
+        // The initialization threads notify us whenever a node has finished, so there is
+        // no need to poll the scene in between
+        const bool hasChanged = waitForChange(true);
+        scene.initializeGLOfInitializedNodes();
+        renderIfNeeded(hasChanged);
     }
+    scene.initializeGLOfInitializedNodes();
 
     postMessage("Initializing OpenGL");
     finalize();
@@ -553,6 +570,11 @@ void LoadingScreen::render() {
             ),
             _items.end()
         );
+        _hasFadingItems = std::any_of(
+            _items.begin(),
+            _items.end(),
+            [](const Item& i) { return i.status == ItemStatus::Finished; }
+        );
 
     }
 
@@ -564,11 +586,54 @@ void LoadingScreen::render() {
     glEnable(GL_CULL_FACE);
     glEnable(GL_DEPTH_TEST);
 
-    std::this_thread::sleep_for(RefreshRate);
+    _lastFrameTime = std::chrono::steady_clock::now();
+    _hasPendingChange = false;
     global::windowDelegate->swapBuffer();
     FrameMarkEnd("Loading");
 }
 
+void LoadingScreen::notifyChange() {
+    {
+        const std::lock_guard guard(_changeMutex);
+        _hasChanged = true;
+    }
+    _changeCondition.notify_one();
+}
+
+bool LoadingScreen::waitForChange(bool block) {
+    std::unique_lock lock(_changeMutex);
+    if (block) {
+        if (_hasPendingChange || _hasFadingItems) {
+            // A frame is going to be rendered soon anyway, so rather than waking up for
+            // every download progress update, all changes are collected until then
+            lock.unlock();
+            std::this_thread::sleep_until(_lastFrameTime + MinFrameInterval);
+            lock.lock();
+        }
+        else {
+            _changeCondition.wait_until(
+                lock,
+                _lastFrameTime + MaxFrameInterval,
+                [this]() { return _hasChanged; }
+            );
+        }
+    }
+    const bool hasChanged = _hasChanged;
+    _hasChanged = false;
+    return hasChanged;
+}
+
+void LoadingScreen::renderIfNeeded(bool hasChanged) {
+    _hasPendingChange = _hasPendingChange || hasChanged;
+
+    const std::chrono::steady_clock::duration sinceLastFrame =
+        std::chrono::steady_clock::now() - _lastFrameTime;
+    const bool isAnimating = _hasPendingChange || _hasFadingItems;
+    if (sinceLastFrame >= (isAnimating ? MinFrameInterval : MaxFrameInterval)) {
+        render();
+    }
+}
+
 void LoadingScreen::renderLogMessages() const {
     ZoneScoped;
 
@@ -647,12 +712,16 @@ void LoadingScreen::renderLogMessages() const {
 }
 
 void LoadingScreen::postMessage(std::string message) {
-    const std::lock_guard guard(_messageMutex);
-    _message = std::move(message);
+    {
+        const std::lock_guard guard(_messageMutex);
+        _message = std::move(message);
+    }
+    notifyChange();
 }
 
 void LoadingScreen::setCatastrophicError(CatastrophicError catastrophicError) {
     _hasCatastrophicErrorOccurred = catastrophicError;
+    notifyChange();
 }
 
 void LoadingScreen::finalize() {
@@ -681,11 +750,30 @@ void LoadingScreen::updateItem(const std::string& itemIdentifier,
 {
     if (!_showNodeNames) {
         // If we don't want to show the node names, we can disable the updating which
-        // also would create any of the text information
+        // also would create any of the text information. The loading still has to be
+        // informed about items that are done though, as it is waiting for them
+        if (newStatus == ItemStatus::Finished || newStatus == ItemStatus::Failed) {
+            notifyChange();
+        }
         return;
     }
-    const std::lock_guard guard(_itemsMutex);
 
+    // Synchronizations report their status repeatedly, so we only wake up the loading
+    // screen if something is actually different
+    bool hasChanged = true;
+    {
+        const std::lock_guard guard(_itemsMutex);
+        hasChanged = updateItemLocked(itemIdentifier, itemName, newStatus, progressInfo);
+    }
+    if (hasChanged) {
+        notifyChange();
+    }
+}
+
+bool LoadingScreen::updateItemLocked(const std::string& itemIdentifier,
+                                     const std::string& itemName, ItemStatus newStatus,
+                                     ProgressInfo progressInfo)
+{
     auto it = std::find_if(
         _items.begin(),
         _items.end(),
@@ -694,11 +782,17 @@ void LoadingScreen::updateItem(const std::string& itemIdentifier,
         }
     );
     if (it != _items.end()) {
+        const bool hasChanged = it->status != newStatus ||
+            it->progress.progress != progressInfo.progress ||
+            it->progress.currentSize != progressInfo.currentSize ||
+            it->progress.totalSize != progressInfo.totalSize;
+
         it->status = newStatus;
         it->progress = std::move(progressInfo);
         if (newStatus == ItemStatus::Finished) {
             it->finishedTime = std::chrono::system_clock::now();
         }
+        return hasChanged;
     }
     else {
         // We are not computing the location in here since doing it this way might stall
@@ -719,6 +813,7 @@ void LoadingScreen::updateItem(const std::string& itemIdentifier,
         }
 
         _items.push_back(std::move(item));
+        return true;
     }
 }
 
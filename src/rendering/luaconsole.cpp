@@ -26,7 +26,10 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
+#include <openspace/events/event.h>
 #include <openspace/network/parallelpeer.h>
+#include <openspace/properties/property.h>
+#include <openspace/query/query.h>
 #include <openspace/rendering/helper.h>
 #include <openspace/scripting/scriptengine.h>
 #include <ghoul/filesystem/cachemanager.h>
@@ -40,6 +43,7 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -246,6 +250,9 @@ void LuaConsole::initialize() {
             parallelConnectionChanged(status);
         }
     );
+
+    // Everything that is added to the property tree from now on is announced by events
+    indexProperties(*global::rootPropertyOwner);
 }
 
 void LuaConsole::deinitialize() {
@@ -286,6 +293,53 @@ void LuaConsole::deinitialize() {
     }
 
     global::parallelPeer->connectionEvent().unsubscribe("luaConsole");
+    _propertyIndex.clear();
+}
+
+void LuaConsole::handleEvents(const events::Event* e) {
+    ZoneScoped;
+
+    while (e) {
+        if (e->type == events::Event::Type::PropertyTreeUpdated) {
+            const std::string uri = std::string(
+                static_cast<const events::EventPropertyTreeUpdated*>(e)->uri
+            );
+
+            // If a property owner was added, all of the properties that it already has
+            // are part of the property tree now, too. The free functions are used as the
+            // member functions would only look within the console itself
+            const properties::PropertyOwner* owner = openspace::propertyOwner(uri);
+            if (owner) {
+                indexProperties(*owner);
+            }
+            else if (openspace::property(uri)) {
+                _propertyIndex.insert(uri);
+            }
+        }
+        else if (e->type == events::Event::Type::PropertyTreePruned) {
+            const std::string uri = std::string(
+                static_cast<const events::EventPropertyTreePruned*>(e)->uri
+            );
+
+            // The uri is either that of a property or that of a property owner, in
+            // which case all of the properties below it are removed, too
+            _propertyIndex.remove(uri);
+            _propertyIndex.removePrefix(uri + '.');
+        }
+        e = e->next;
+    }
+}
+
+void LuaConsole::indexProperties(const properties::PropertyOwner& owner) {
+    for (const properties::Property* prop : owner.properties()) {
+        const std::string uri = prop->uri();
+        if (!uri.empty()) {
+            _propertyIndex.insert(uri);
+        }
+    }
+    for (const properties::PropertyOwner* subOwner : owner.propertySubOwners()) {
+        indexProperties(*subOwner);
+    }
 }
 
 bool LuaConsole::keyboardCallback(Key key, KeyModifier modifier, KeyAction action) {
@@ -478,19 +532,17 @@ bool LuaConsole::keyboardCallback(Key key, KeyModifier modifier, KeyAction actio
     }
 
     if (key == Key::Tab) {
-        // We get a list of all the available commands and initially find the first
-        // command that starts with how much we typed sofar. We store the index so
-        // that in subsequent "tab" presses, we will discard previous commands. This
-        // implements the 'hop-over' behavior. As soon as another key is pressed,
-        // everything is set back to normal
+        // We get a list of all the available completions of what we typed so far and
+        // initially pick the first one. We store the index so that in subsequent "tab"
+        // presses, we will discard previous completions. This implements the
+        // 'hop-over' behavior. As soon as another key is pressed, everything is set back
+        // to normal
 
         // If the shift key is pressed, we decrement the current index so that we will
         // find the value before the one that was previously found
         if (_autoCompleteInfo.lastIndex != NoAutoComplete && modifierShift) {
             _autoCompleteInfo.lastIndex -= 2;
         }
-        std::vector<std::string> allCommands = global::scriptEngine->allLuaFunctions();
-        std::sort(allCommands.begin(), allCommands.end());
 
         const std::string currentCommand = _commands.at(_activeCommand);
 
@@ -502,65 +554,74 @@ bool LuaConsole::keyboardCallback(Key key, KeyModifier modifier, KeyAction actio
             _autoCompleteInfo.initialValue = currentCommand;
             _autoCompleteInfo.hasInitialValue = true;
         }
+        const std::string& initialValue = _autoCompleteInfo.initialValue;
+
+        // If the command ends inside of a string, the string is completed as a property
+        // URI. Otherwise, the command is completed as the name of a Lua function
+        char quote = '\0';
+        size_t stringBegin = 0;
+        for (size_t i = 0; i < initialValue.size(); i++) {
+            const char c = initialValue[i];
+            if (quote == '\0' && (c == '"' || c == '\'')) {
+                quote = c;
+                stringBegin = i + 1;
+            }
+            else if (c == quote) {
+                quote = '\0';
+            }
+        }
+        const bool isInString = quote != '\0';
+
+        // We only want to auto-complete until the next separator "." so the completions
+        // end after the first separator that follows what we typed so far
+        const std::string head = isInString ? initialValue.substr(0, stringBegin) : "";
+        const std::vector<std::string> completions = isInString ?
+            _propertyIndex.completions(initialValue.substr(stringBegin), '.') :
+            global::scriptEngine->luaFunctionIndex().completions(initialValue, '.');
+
+        for (int i = std::max(_autoCompleteInfo.lastIndex + 1, 0);
+             i < static_cast<int>(completions.size());
+             i++)
+        {
+            const std::string& completion = completions[i];
+            const bool isGroup = completion.back() == '.';
+
+            std::string command;
+            if (isGroup) {
+                command = head + completion;
+            }
+            else if (isInString) {
+                // We found a full property URI, so the string is closed
+                command = head + completion + quote;
+            }
+            else {
+                // We found a full function name, so the call is added
+                command = completion + "();";
+            }
 
-        for (int i = 0; i < static_cast<int>(allCommands.size()); i++) {
-            const std::string& command = allCommands[i];
-
-            // Check if the command has enough length (we don't want crashes here)
-            // Then check if the iterator-command's start is equal to what we want
-            // then check if we need to skip the first found values as the user has
-            // pressed TAB repeatedly
-            const size_t fullLength = _autoCompleteInfo.initialValue.length();
-            const bool correctLength = command.length() >= fullLength;
-
-            const std::string commandLowerCase = ghoul::toLowerCase(command);
-
-            const std::string initialValueLowerCase = ghoul::toLowerCase(
-                _autoCompleteInfo.initialValue
-            );
-
-            const bool correctCommand =
-                commandLowerCase.substr(0, fullLength) == initialValueLowerCase;
-
-            if (correctLength && correctCommand && (i > _autoCompleteInfo.lastIndex)) {
-                // We found our index, so store it
-                _autoCompleteInfo.lastIndex = i;
-
-                // We only want to auto-complete until the next separator "."
-                const size_t pos = command.find('.', fullLength);
-                if (pos == std::string::npos) {
-                    // If we don't find a separator, we autocomplete until the end
-                    // Set the found command as active command
-                    _commands.at(_activeCommand) = command + "();";
-                    // Set the cursor position to be between the brackets
-                    _inputPosition = _commands.at(_activeCommand).size() - 2;
-                }
-                else {
-                    // If we find a separator, we autocomplete until and including the
-                    // separator unless the autocompletion would be the same that we
-                    // already have (the case if there are multiple commands in the
-                    // same group
-                    const std::string subCommand = command.substr(0, pos + 1);
-                    if (subCommand == _commands.at(_activeCommand)) {
-                        continue;
-                    }
-                    else {
-                        _commands.at(_activeCommand) = command.substr(0, pos + 1);
-                        _inputPosition = _commands.at(_activeCommand).length();
-                        // We only want to remove the autocomplete info if we just
-                        // entered the 'default' openspace namespace
-                        if (command.substr(0, pos + 1) == "openspace.") {
-                            _autoCompleteInfo = {
-                                .lastIndex = NoAutoComplete,
-                                .hasInitialValue = false,
-                                .initialValue = ""
-                            };
-                        }
-                    }
-                }
+            // We don't want to autocomplete to the command that we already have
+            if (isGroup && command == _commands.at(_activeCommand)) {
+                continue;
+            }
 
-                break;
+            // We found our index, so store it
+            _autoCompleteInfo.lastIndex = i;
+            _commands.at(_activeCommand) = command;
+
+            // For functions, the cursor is placed between the brackets
+            const bool isFunction = !isGroup && !isInString;
+            _inputPosition = isFunction ? command.size() - 2 : command.size();
+
+            // We only want to remove the autocomplete info if we just entered the
+            // 'default' openspace namespace
+            if (!isInString && command == "openspace.") {
+                _autoCompleteInfo = {
+                    .lastIndex = NoAutoComplete,
+                    .hasInitialValue = false,
+                    .initialValue = ""
+                };
             }
+            break;
         }
         return true;
     }
@@ -146,6 +146,8 @@ Renderable::Renderable(const ghoul::Dictionary& dictionary, RenderableSettings s
     , _renderableType(RenderableTypeInfo, "Renderable")
     , _dimInAtmosphere(DimInAtmosphereInfo, false)
     , _shouldUpdateIfDisabled(settings.shouldUpdateIfDisabled)
+    , _supportsParallelUpdate(settings.supportsParallelUpdate)
+    , _updatePolicy(settings.updatePolicy)
     , _automaticallyUpdateRenderBin(settings.automaticallyUpdateRenderBin)
 {
     ZoneScoped;
@@ -203,6 +205,16 @@ Renderable::Renderable(const ghoul::Dictionary& dictionary, RenderableSettings s
     addProperty(_dimInAtmosphere);
 }
 
+Renderable::~Renderable() {
+    // The properties of subclasses are already destroyed at this point and removed
+    // themselves from the list, but our own properties and subowners that outlive us
+    // would otherwise call back into a destroyed object
+    for (const auto& [property, watch] : _watchedProperties) {
+        property->removeOnChange(watch.onChange);
+        property->removeOnDelete(watch.onDelete);
+    }
+}
+
 void Renderable::initialize() {}
 
 void Renderable::initializeGL() {}
@@ -287,6 +299,66 @@ bool Renderable::shouldUpdateIfDisabled() const noexcept {
     return _shouldUpdateIfDisabled;
 }
 
+bool Renderable::supportsParallelUpdate() const noexcept {
+    return _supportsParallelUpdate;
+}
+
+UpdatePolicy Renderable::updatePolicy() const noexcept {
+    return _updatePolicy;
+}
+
+bool Renderable::needsUpdate(const UpdateData& data, bool wasRendered) {
+    if (_updatePolicy == UpdatePolicy::Always) {
+        return true;
+    }
+
+    if (hasUpdatePolicy(_updatePolicy, UpdatePolicy::OnPropertyChange)) {
+        watchPropertyChanges();
+    }
+
+    const double time = data.time.j2000Seconds();
+    const bool isWoken =
+        _hasPendingUpdate ||
+        (hasUpdatePolicy(_updatePolicy, UpdatePolicy::WhenVisible) &&
+            wasRendered && isVisible()) ||
+        (hasUpdatePolicy(_updatePolicy, UpdatePolicy::OnTimeChange) &&
+            _lastUpdateTime != time);
+
+    if (isWoken) {
+        _hasPendingUpdate = false;
+        _lastUpdateTime = time;
+    }
+    return isWoken;
+}
+
+void Renderable::requestUpdate() {
+    _hasPendingUpdate = true;
+}
+
+void Renderable::watchPropertyChanges() {
+    // Properties can be added to and removed from us at any time, for example when
+    // layers are added, so the watched set has to follow the property tree
+    const uint64_t generation = PropertyOwner::structureGeneration();
+    if (generation == _watchedStructureGeneration) {
+        return;
+    }
+    _watchedStructureGeneration = generation;
+
+    for (properties::Property* property : propertiesRecursive()) {
+        if (_watchedProperties.contains(property)) {
+            continue;
+        }
+
+        PropertyWatch watch = {
+            .onChange = property->onChange([this]() { _hasPendingUpdate = true; }),
+            .onDelete = property->onDelete([this, property]() {
+                _watchedProperties.erase(property);
+            })
+        };
+        _watchedProperties[property] = watch;
+    }
+}
+
 void Renderable::onEnabledChange(std::function<void(bool)> callback) {
     _enabled.onChange([this, c = std::move(callback)]() {
         c(isEnabled());
@@ -328,6 +400,16 @@ SceneGraphNode* Renderable::parent() const noexcept {
     return static_cast<SceneGraphNode*>(owner());
 }
 
+MemoryTracker::Allocation Renderable::trackedAllocation(std::string module,
+                                                       MemoryTracker::Type type) const
+{
+    return MemoryTracker::Allocation(
+        owner() ? owner()->identifier() : "",
+        std::move(module),
+        type
+    );
+}
+
 bool Renderable::automaticallyUpdatesRenderBin() const noexcept {
     return _automaticallyUpdateRenderBin;
 }
@@ -353,16 +435,14 @@ glm::dmat4 Renderable::calcModelViewTransform(const RenderData& data,
                                     const std::optional<glm::dmat4>& modelTransform) const
 {
     const glm::dmat4 modelMatrix = modelTransform.value_or(calcModelTransform(data));
-    return data.camera.combinedViewMatrix() * modelMatrix;
+    return data.cameraSnapshot.combinedViewMatrix * modelMatrix;
 }
 
 glm::dmat4 Renderable::calcModelViewProjectionTransform(const RenderData& data,
                                     const std::optional<glm::dmat4>& modelTransform) const
 {
     const glm::dmat4& modelMatrix = modelTransform.value_or(calcModelTransform(data));
-    const glm::dmat4 viewMatrix = data.camera.combinedViewMatrix();
-    const glm::dmat4 projectionMatrix = data.camera.projectionMatrix();
-    return glm::dmat4(projectionMatrix * viewMatrix * modelMatrix);
+    return data.cameraSnapshot.combinedViewProjectionMatrix * modelMatrix;
 }
 
 std::tuple<glm::dmat4, glm::dmat4, glm::dmat4> Renderable::calcAllTransforms(
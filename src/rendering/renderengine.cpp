@@ -49,6 +49,7 @@
 #include <openspace/util/screenlog.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/util/versionchecker.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/font/font.h>
 #include <ghoul/font/fontmanager.h>
@@ -62,13 +63,17 @@
 #include <ghoul/io/texture/texturewriter.h>
 #include <ghoul/io/texture/texturewriterstb.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/dictionaryjsonformatter.h>
 #include <ghoul/misc/easing.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/misc/stringconversion.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/shaderobject.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <fstream>
+#include <map>
 
 #include "renderengine_lua.inl"
 
@@ -273,6 +278,62 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseDrawListsInfo = {
+        "UseDrawLists",
+        "Use Draw Lists",
+        "If this value is enabled, renderables that support it submit their draw calls "
+        "to a list that is sorted by the required OpenGL state and executed at the end "
+        "of each render bin. This reduces the number of redundant state changes, but "
+        "changes the order in which objects within the same render bin are drawn.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CompactFramebufferInfo = {
+        "CompactFramebufferFormats",
+        "Compact Framebuffer Formats",
+        "If this value is enabled, the color and normal buffers of the renderer use half "
+        "precision floating point values instead of single precision. This halves the "
+        "memory and bandwidth that these buffers require, which is significant for very "
+        "high resolutions, at the cost of limiting the color values to the range that "
+        "can be represented with half precision. The position buffer always uses single "
+        "precision as it has to represent distances on astronomical scales.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DynamicResolutionInfo = {
+        "DynamicResolution",
+        "Dynamic Resolution",
+        "If this value is enabled, the scene is rendered with a lower resolution "
+        "whenever the GPU time of a frame exceeds the target frame time. The resolution "
+        "is adjusted every frame within the minimum and maximum scale and the image is "
+        "upscaled to the full resolution when the tone mapping is applied.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TargetFrameTimeInfo = {
+        "TargetFrameTime",
+        "Target Frame Time",
+        "The GPU time in milliseconds that the rendering of a frame should take if the "
+        "dynamic resolution is enabled.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DynamicMinScaleInfo = {
+        "DynamicResolutionMinScale",
+        "Dynamic Resolution Minimum Scale",
+        "The lowest fraction of the full resolution that the dynamic resolution renders "
+        "the scene with.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DynamicMaxScaleInfo = {
+        "DynamicResolutionMaxScale",
+        "Dynamic Resolution Maximum Scale",
+        "The highest fraction of the full resolution that the dynamic resolution renders "
+        "the scene with.",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo EnabledFontColorInfo = {
         "EnabledFontColor",
         "Enabled Font Color",
@@ -286,6 +347,83 @@ namespace {
         "The font color used for disabled options.",
         openspace::properties::Property::Visibility::AdvancedUser
     };
+
+    // Version of the format in which program binaries are stored on disk
+    constexpr int8_t ProgramBinaryCacheVersion = 2;
+
+    // Returns the source that has been handed to OpenGL for the shader, that is after all
+    // #include directives have been resolved and all preprocessor values inserted. Any
+    // change to one of the shader files that went into it therefore changes the source
+    std::string shaderSource(GLuint shader) {
+        GLint length = 0;
+        glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &length);
+        std::string source;
+        source.resize(length);
+        glGetShaderSource(shader, length, nullptr, source.data());
+        return source;
+    }
+
+    std::string glString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+
+    bool loadProgramBinary(const std::filesystem::path& file, const std::string& key,
+                           GLenum& format, std::vector<std::byte>& data)
+    {
+        std::ifstream f = std::ifstream(file, std::ios::binary);
+        if (!f.good()) {
+            return false;
+        }
+
+        int8_t version = 0;
+        f.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+        if (version != ProgramBinaryCacheVersion) {
+            return false;
+        }
+
+        // The full key is stored alongside the binary to guard against hash collisions
+        uint64_t keySize = 0;
+        f.read(reinterpret_cast<char*>(&keySize), sizeof(uint64_t));
+        if (keySize != key.size()) {
+            return false;
+        }
+        std::string storedKey;
+        storedKey.resize(keySize);
+        f.read(storedKey.data(), keySize);
+        if (storedKey != key) {
+            return false;
+        }
+
+        uint64_t size = 0;
+        f.read(reinterpret_cast<char*>(&format), sizeof(GLenum));
+        f.read(reinterpret_cast<char*>(&size), sizeof(uint64_t));
+        data.resize(size);
+        f.read(reinterpret_cast<char*>(data.data()), size);
+        return f.good() && size > 0;
+    }
+
+    void saveProgramBinary(const std::filesystem::path& file, const std::string& key,
+                           GLenum format, const std::vector<std::byte>& data)
+    {
+        std::ofstream f = std::ofstream(file, std::ios::binary);
+        if (!f.good()) {
+            LWARNING(std::format("Could not write program binary to '{}'", file));
+            return;
+        }
+
+        f.write(
+            reinterpret_cast<const char*>(&ProgramBinaryCacheVersion),
+            sizeof(int8_t)
+        );
+        const uint64_t keySize = key.size();
+        f.write(reinterpret_cast<const char*>(&keySize), sizeof(uint64_t));
+        f.write(key.data(), keySize);
+        const uint64_t size = data.size();
+        f.write(reinterpret_cast<const char*>(&format), sizeof(GLenum));
+        f.write(reinterpret_cast<const char*>(&size), sizeof(uint64_t));
+        f.write(reinterpret_cast<const char*>(data.data()), size);
+    }
 } // namespace
 
 namespace openspace {
@@ -304,6 +442,12 @@ RenderEngine::RenderEngine()
     , _globalBlackOutFactor(GlobalBlackoutFactorInfo, 1.f, 0.f, 1.f)
     , _applyBlackoutToMaster(ApplyBlackoutToMasterInfo, true)
     , _enableFXAA(FXAAInfo, true)
+    , _useDrawLists(UseDrawListsInfo, false)
+    , _compactFramebufferFormats(CompactFramebufferInfo, false)
+    , _dynamicResolution(DynamicResolutionInfo, false)
+    , _targetFrameTime(TargetFrameTimeInfo, 16.6f, 1.f, 100.f)
+    , _dynamicResolutionMinScale(DynamicMinScaleInfo, 0.5f, 0.25f, 1.f)
+    , _dynamicResolutionMaxScale(DynamicMaxScaleInfo, 1.f, 0.25f, 1.f)
     , _disableHDRPipeline(DisableHDRPipelineInfo, false)
     , _hdrExposure(HDRExposureInfo, 3.7f, 0.01f, 10.f)
     , _gamma(GammaInfo, 0.95f, 0.01f, 5.f)
@@ -342,6 +486,36 @@ RenderEngine::RenderEngine()
     _enableFXAA.onChange([this]() { _renderer.enableFXAA(_enableFXAA); });
     addProperty(_enableFXAA);
 
+    _useDrawLists.onChange([this]() { _renderer.setUseDrawLists(_useDrawLists); });
+    addProperty(_useDrawLists);
+
+    _compactFramebufferFormats.onChange([this]() {
+        _renderer.setCompactFormats(_compactFramebufferFormats);
+    });
+    addProperty(_compactFramebufferFormats);
+
+    _dynamicResolution.onChange([this]() {
+        _renderer.enableDynamicResolution(_dynamicResolution);
+    });
+    addProperty(_dynamicResolution);
+
+    _targetFrameTime.onChange([this]() {
+        _renderer.setTargetFrameTime(_targetFrameTime);
+    });
+    addProperty(_targetFrameTime);
+
+    auto setDynamicResolutionBounds = [this]() {
+        _renderer.setDynamicResolutionBounds(
+            _dynamicResolutionMinScale,
+            _dynamicResolutionMaxScale
+        );
+    };
+    _dynamicResolutionMinScale.onChange(setDynamicResolutionBounds);
+    addProperty(_dynamicResolutionMinScale);
+
+    _dynamicResolutionMaxScale.onChange(setDynamicResolutionBounds);
+    addProperty(_dynamicResolutionMaxScale);
+
     _disableHDRPipeline.onChange([this]() {
         _renderer.setDisableHDR(_disableHDRPipeline);
     });
@@ -427,6 +601,10 @@ RenderEngine::RenderEngine()
 
     _disabledFontColor.setViewOption(properties::Property::ViewOptions::Color);
     addProperty(_disabledFontColor);
+
+    addPropertySubOwner(_uploadScheduler);
+    addPropertySubOwner(_gpuTimerPool);
+    addPropertySubOwner(_frameCapture);
 }
 
 RenderEngine::~RenderEngine() {}
@@ -474,9 +652,19 @@ void RenderEngine::initializeGL() {
 
     _renderer.setResolution(renderingResolution());
     _renderer.enableFXAA(_enableFXAA);
+    _renderer.setUseDrawLists(_useDrawLists);
+    _renderer.setCompactFormats(_compactFramebufferFormats);
+    _renderer.enableDynamicResolution(_dynamicResolution);
+    _renderer.setTargetFrameTime(_targetFrameTime);
+    _renderer.setDynamicResolutionBounds(
+        _dynamicResolutionMinScale,
+        _dynamicResolutionMaxScale
+    );
     _renderer.setHDRExposure(_hdrExposure);
     _renderer.initialize();
 
+    _uploadScheduler.initializeGL();
+
     // set the close clip plane and the far clip plane to extreme values while in
     // development
     global::windowDelegate->setNearFarClippingPlane(0.001f, 1000.f);
@@ -510,6 +698,9 @@ void RenderEngine::initializeGL() {
 void RenderEngine::deinitializeGL() {
     ZoneScoped;
 
+    _uploadScheduler.deinitializeGL();
+    _gpuTimerPool.deinitializeGL();
+    _frameCapture.deinitializeGL();
     _renderer.deinitialize();
 }
 
@@ -709,6 +900,7 @@ void RenderEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& viewMat
             .saturation = _saturation,
             .gamma = _gamma
         };
+        ScreenSpaceRenderable::beginBatch();
         for (ScreenSpaceRenderable* ssr : ssrs) {
 #ifdef TRACY_ENABLE
             TracyPlot("RAM", static_cast<int64_t>(global::openSpaceEngine->ramInUse()));
@@ -716,6 +908,7 @@ void RenderEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& viewMat
 #endif // TRACY_ENABLE
             ssr->render(data);
         }
+        ScreenSpaceRenderable::endBatch();
         glDisable(GL_BLEND);
     }
     LTRACE("RenderEngine::render(end)");
@@ -864,6 +1057,9 @@ float RenderEngine::combinedBlackoutFactor() const {
 void RenderEngine::postDraw() {
     ZoneScoped;
 
+    _uploadScheduler.resetBudget();
+    _gpuTimerPool.nextFrame();
+    _frameCapture.nextFrame();
     ++_frameNumber;
 }
 
@@ -886,6 +1082,18 @@ ghoul::opengl::OpenGLStateCache& RenderEngine::openglStateCache() {
     return *_openglStateCache;
 }
 
+UploadScheduler& RenderEngine::uploadScheduler() {
+    return _uploadScheduler;
+}
+
+GpuTimerPool& RenderEngine::gpuTimerPool() {
+    return _gpuTimerPool;
+}
+
+EclipseShadows& RenderEngine::eclipseShadows() {
+    return _eclipseShadows;
+}
+
 float RenderEngine::hdrExposure() const {
     return _hdrExposure;
 }
@@ -912,8 +1120,7 @@ std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildRenderProgram(
     // instead of a void main() setting glFragColor, glFragDepth, etc.
     dict.setValue("fragmentPath", fsPath);
 
-    using namespace ghoul::opengl;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
+    std::unique_ptr<ghoul::opengl::ProgramObject> program = buildCachedProgram(
         name,
         vsPath,
         absPath(RenderFsPath),
@@ -926,6 +1133,131 @@ std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildRenderProgram(
     return program;
 }
 
+std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildCachedProgram(
+                                                                  const std::string& name,
+                                                      const std::filesystem::path& vsPath,
+                                                      const std::filesystem::path& fsPath,
+                                                                   ghoul::Dictionary data)
+{
+    return buildCachedProgram(name, vsPath, fsPath, "", std::move(data));
+}
+
+std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildCachedProgram(
+                                                                  const std::string& name,
+                                                      const std::filesystem::path& vsPath,
+                                                      const std::filesystem::path& fsPath,
+                                                      const std::filesystem::path& gsPath,
+                                                                   ghoul::Dictionary data)
+{
+    ZoneScoped;
+
+    using namespace ghoul::opengl;
+    std::unique_ptr<ProgramObject> program = std::make_unique<ProgramObject>(name);
+    program->setDictionary(data);
+
+    // The sources are collected after preprocessing, as that is where the contents of
+    // the included files and the preprocessor values end up
+    std::string sources;
+    auto attach = [&](ShaderObject::ShaderType type, const std::filesystem::path& path,
+                      std::string_view suffix)
+    {
+        auto shader = std::make_unique<ShaderObject>(
+            type,
+            path,
+            std::format("{} {}", name, suffix),
+            data
+        );
+        sources += shaderSource(*shader);
+        program->attachObject(std::move(shader));
+    };
+    attach(ShaderObject::ShaderType::Vertex, vsPath, "Vertex");
+    attach(ShaderObject::ShaderType::Fragment, fsPath, "Fragment");
+    if (!gsPath.empty()) {
+        attach(ShaderObject::ShaderType::Geometry, gsPath, "Geometry");
+    }
+
+    GLint nBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &nBinaryFormats);
+    if (nBinaryFormats == 0 || !FileSys.cacheManager()) {
+        // The driver can't hand out program binaries, so there is nothing to cache
+        program->compileShaderObjects();
+        program->linkProgramObject();
+        return program;
+    }
+
+    // Everything that influences the linked program has to be part of the key: the
+    // preprocessed shader sources and the driver that produced the binary
+    const std::string key = std::format(
+        "{}|{}|{}|{}|{}",
+        name, std::hash<std::string>{}(sources),
+        glString(GL_VENDOR), glString(GL_RENDERER), glString(GL_VERSION)
+    );
+
+    // The file only depends on which program this is, so that a binary that has become
+    // outdated is replaced rather than left behind in the cache
+    const std::filesystem::path cacheFile = FileSys.cacheManager()->cachedFilename(
+        vsPath,
+        std::format(
+            "ProgramBinary|{}",
+            std::hash<std::string>{}(std::format(
+                "{}|{}|{}|{}|{}",
+                name, vsPath, fsPath, gsPath, ghoul::formatJson(data)
+            ))
+        )
+    );
+
+    // Check the binaries of this session first and fall back to the ones on disk
+    auto it = _programBinaries.find(key);
+    if (it == _programBinaries.end()) {
+        ProgramBinary binary;
+        if (loadProgramBinary(cacheFile, key, binary.format, binary.data)) {
+            it = _programBinaries.emplace(key, std::move(binary)).first;
+        }
+    }
+
+    bool isLinked = false;
+    if (it != _programBinaries.end()) {
+        glProgramBinary(
+            *program,
+            it->second.format,
+            it->second.data.data(),
+            static_cast<GLsizei>(it->second.data.size())
+        );
+        GLint status = GL_FALSE;
+        glGetProgramiv(*program, GL_LINK_STATUS, &status);
+        isLinked = (status == GL_TRUE);
+        if (!isLinked) {
+            // Happens when the driver was updated without changing its version string
+            LDEBUG(std::format("Stored program binary for '{}' was rejected", name));
+            _programBinaries.erase(it);
+        }
+    }
+
+    if (!isLinked) {
+        glProgramParameteri(*program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        program->compileShaderObjects();
+        program->linkProgramObject();
+
+        GLint length = 0;
+        glGetProgramiv(*program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length > 0) {
+            ProgramBinary binary;
+            binary.data.resize(length);
+            glGetProgramBinary(
+                *program,
+                length,
+                nullptr,
+                &binary.format,
+                binary.data.data()
+            );
+            saveProgramBinary(cacheFile, key, binary.format, binary.data);
+            _programBinaries[key] = std::move(binary);
+        }
+    }
+
+    return program;
+}
+
 /**
 * Build a program object for rendering with the used renderer
 */
@@ -944,8 +1276,7 @@ std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildRenderProgram(
     // instead of a void main() setting glFragColor, glFragDepth, etc.
     dict.setValue("fragmentPath", fsPath);
 
-    using namespace ghoul::opengl;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
+    std::unique_ptr<ghoul::opengl::ProgramObject> program = buildCachedProgram(
         name,
         vsPath,
         absPath(RenderFsPath),
@@ -997,6 +1328,17 @@ void RenderEngine::takeScreenshot() {
         std::filesystem::create_directories(absPath("${SCREENSHOTS}"));
     }
 
+    if (_frameCapture.isEnabled()) {
+        // Using the same file names as the window framework so that image sequences
+        // don't depend on which way they were captured
+        _latestScreenshotNumber++;
+        _frameCapture.capture(
+            absPath("${SCREENSHOTS}") /
+            std::format("OpenSpace_{:06}", _latestScreenshotNumber)
+        );
+        return;
+    }
+
     _latestScreenshotNumber = global::windowDelegate->takeScreenshot(
         _applyWarping,
         _screenshotWindowIds
@@ -1023,7 +1365,8 @@ scripting::LuaLibrary RenderEngine::luaLibrary() {
             codegen::lua::RemoveScreenSpaceRenderable,
             codegen::lua::TakeScreenshot,
             codegen::lua::DpiScaling,
-            codegen::lua::ResetScreenshotNumber
+            codegen::lua::ResetScreenshotNumber,
+            codegen::lua::GpuTimes
         }
     };
 }
@@ -81,6 +81,21 @@ namespace {
     return openspace::global::windowDelegate->osDpiScaling();
 }
 
+/**
+ * Returns a table with the GPU times in milliseconds of the render passes and scene graph
+ * nodes that were measured in a recent frame. The render passes are prefixed with
+ * 'Renderer/', all other keys are the identifiers of scene graph nodes. The table is
+ * empty unless the GPU timing has been enabled in the RenderEngine.
+ */
+[[codegen::luawrap]] std::map<std::string, float> gpuTimes() {
+    using namespace openspace;
+    std::map<std::string, float> res;
+    for (const GpuTimerPool::Timing& t : global::renderEngine->gpuTimerPool().timings()) {
+        res[t.name] = t.time;
+    }
+    return res;
+}
+
 #include "renderengine_lua_codegen.cpp"
 
 } // namespace
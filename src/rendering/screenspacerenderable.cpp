@@ -260,6 +260,19 @@ namespace {
         std::optional<std::variant<std::string, std::vector<std::string>>> tag;
     };
 #include "screenspacerenderable_codegen.cpp"
+
+    // State that is shared between the screen space renderables that are drawn between
+    // calls to ScreenSpaceRenderable::beginBatch and ScreenSpaceRenderable::endBatch.
+    // Consecutive renderables that are drawn through the default render function and use
+    // the same program skip the program activation and the per-frame uniforms
+    struct {
+        bool isActive = false;
+        // 'true' while a renderable is drawn through ScreenSpaceRenderable::render
+        bool isDefaultRender = false;
+        // The program that is currently active with the per-frame uniforms set
+        ghoul::opengl::ProgramObject* program = nullptr;
+        glm::mat4 viewProjectionMatrix = glm::mat4(1.f);
+    } Batch;
 } // namespace
 
 namespace openspace {
@@ -482,7 +495,30 @@ void ScreenSpaceRenderable::render(const RenderData& renderData) {
         translationMatrix() *
         localRotationMatrix() *
         scaleMatrix();
+
+    Batch.isDefaultRender = true;
     draw(mat, renderData);
+    Batch.isDefaultRender = false;
+}
+
+void ScreenSpaceRenderable::beginBatch() {
+    ghoul_assert(!Batch.isActive, "Screen space batch already started");
+
+    Batch.isActive = true;
+    Batch.program = nullptr;
+    Batch.viewProjectionMatrix =
+        global::renderEngine->scene()->camera()->viewProjectionMatrix();
+}
+
+void ScreenSpaceRenderable::endBatch() {
+    ghoul_assert(Batch.isActive, "No screen space batch was started");
+
+    if (Batch.program) {
+        Batch.program->deactivate();
+        glEnable(GL_CULL_FACE);
+    }
+    Batch.isActive = false;
+    Batch.program = nullptr;
 }
 
 bool ScreenSpaceRenderable::isReady() const {
@@ -537,7 +573,7 @@ void ScreenSpaceRenderable::createShaders(ghoul::Dictionary dict) {
         "fragmentPath",
         std::string("${MODULE_BASE}/shaders/screenspace_fs.glsl")
     );
-    _shader = ghoul::opengl::ProgramObject::Build(
+    _shader = global::renderEngine->buildCachedProgram(
         "ScreenSpaceProgram",
         absPath("${MODULE_BASE}/shaders/screenspace_vs.glsl"),
         absPath("${SHADERS}/render.frag"),
@@ -663,9 +699,23 @@ void ScreenSpaceRenderable::draw(const glm::mat4& modelTransform,
                                  const RenderData& renderData,
                                  bool useAcceleratedRendering)
 {
-    glDisable(GL_CULL_FACE);
+    // Renderables with their own render function might have used other programs or
+    // changed the state since the last renderable was drawn, so they can't be batched
+    const bool isBatched = Batch.isActive && Batch.isDefaultRender;
+    if (!isBatched || Batch.program != _shader.get()) {
+        glDisable(GL_CULL_FACE);
+        _shader->activate();
+
+        _shader->setUniform(_uniformCache.hue, renderData.hue);
+        _shader->setUniform(_uniformCache.value, renderData.value);
+        _shader->setUniform(_uniformCache.saturation, renderData.saturation);
+        glBindVertexArray(rendering::helper::vertexObjects.square.vao);
+
+        if (isBatched) {
+            Batch.program = _shader.get();
+        }
+    }
 
-    _shader->activate();
     // Calculate the border from pixels to UV coordinates
     const glm::vec2 borderUV = glm::vec2(
         _borderWidth / static_cast<float>(_objectSize.x),
@@ -678,32 +728,37 @@ void ScreenSpaceRenderable::draw(const glm::mat4& modelTransform,
         _uniformCache.blackoutFactor,
         _renderDuringBlackout ? 1.f : renderData.blackoutFactor
     );
-    _shader->setUniform(_uniformCache.hue, renderData.hue);
-    _shader->setUniform(_uniformCache.value, renderData.value);
-    _shader->setUniform(_uniformCache.saturation, renderData.saturation);
     _shader->setUniform(_uniformCache.gamma, renderData.gamma + _gammaOffset);
     _shader->setUniform(_uniformCache.backgroundColor, _backgroundColor);
     _shader->setUniform(_uniformCache.borderWidth, borderUV);
     _shader->setUniform(_uniformCache.borderColor, _borderColor);
     _shader->setUniform(_uniformCache.borderFeather, _borderFeather);
     _shader->setUniform(_uniformCache.useAcceleratedRendering, useAcceleratedRendering);
-    _shader->setUniform(
-        _uniformCache.mvpMatrix,
-        global::renderEngine->scene()->camera()->viewProjectionMatrix() * modelTransform
-    );
+    const glm::mat4 viewProjection = Batch.isActive ?
+        Batch.viewProjectionMatrix :
+        global::renderEngine->scene()->camera()->viewProjectionMatrix();
+    _shader->setUniform(_uniformCache.mvpMatrix, viewProjection * modelTransform);
 
     ghoul::opengl::TextureUnit unit;
     unit.activate();
     bindTexture();
     _shader->setUniform(_uniformCache.tex, unit);
 
-    glBindVertexArray(rendering::helper::vertexObjects.square.vao);
     glDrawArrays(GL_TRIANGLES, 0, 6);
+    unbindTexture();
 
-    glEnable(GL_CULL_FACE);
+    if (isBatched) {
+        // The program stays active for the next renderable in the batch
+        return;
+    }
 
+    glEnable(GL_CULL_FACE);
     _shader->deactivate();
-    unbindTexture();
+
+    if (Batch.isActive) {
+        // Any following renderable has to restore the state for the batch again
+        Batch.program = nullptr;
+    }
 }
 
 void ScreenSpaceRenderable::unbindTexture() {
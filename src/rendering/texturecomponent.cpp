@@ -24,17 +24,53 @@
 
 #include <openspace/rendering/texturecomponent.h>
 
+#include <openspace/engine/globals.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
+#include <array>
+#include <chrono>
+#include <tuple>
+#include <vector>
+#include <stb_image.h>
 
 namespace {
     constexpr std::string_view _loggerCat = "TextureComponent";
+
+    // Textures are shared between components that load the same file with the same
+    // number of dimensions, filter mode, and wrapping mode
+    using TextureKey = std::tuple<std::filesystem::path, int, int, int>;
+
+    TextureKey textureKey(const std::filesystem::path& path, int nDimensions,
+                          ghoul::opengl::Texture::FilterMode filterMode,
+                          ghoul::opengl::Texture::WrappingMode wrappingMode)
+    {
+        return {
+            path,
+            nDimensions,
+            static_cast<int>(filterMode),
+            static_cast<int>(wrappingMode)
+        };
+    }
+
+    // The textures are only referenced weakly, so that they are deleted as soon as the
+    // last component that uses them is gone. Only accessed from the main thread
+    std::map<TextureKey, std::weak_ptr<ghoul::opengl::Texture>>& sharedTextures() {
+        static std::map<TextureKey, std::weak_ptr<ghoul::opengl::Texture>> Textures;
+        return Textures;
+    }
 } // namespace
 
 namespace openspace {
 
+struct TextureComponent::DecodedImage {
+    glm::uvec2 size = glm::uvec2(0);
+    int nChannels = 0;
+    std::vector<unsigned char> pixels;
+};
+
 TextureComponent::TextureComponent(int nDimensions)
     : _nDimensions(nDimensions)
 {
@@ -52,6 +88,10 @@ ghoul::opengl::Texture* TextureComponent::texture() {
     return _texture.get();
 }
 
+bool TextureComponent::isReady() const {
+    return _texture && !_isPlaceholder && !_decoding.valid() && !_textureIsDirty;
+}
+
 void TextureComponent::setFilterMode(ghoul::opengl::Texture::FilterMode filterMode) {
     _filterMode = filterMode;
 }
@@ -74,16 +114,31 @@ void TextureComponent::bind() {
 }
 
 void TextureComponent::uploadToGpu() {
+    if (_decoding.valid()) {
+        // The image is uploaded as soon as it has been decoded
+        finishDecoding();
+        return;
+    }
+
     if (!_texture) {
         LERROR("Could not upload texture to GPU. Texture not loaded");
         return;
     }
+    if (!_textureIsDirty) {
+        // The texture is shared with another component that has already uploaded it
+        return;
+    }
+
     _texture->uploadTexture();
     _texture->setFilter(_filterMode);
     _texture->setWrapping(_wrappingMode);
     if (_shouldPurgeFromRAM) {
         _texture->purgeFromRAM();
     }
+    _textureIsDirty = false;
+
+    const TextureKey key = textureKey(_path, _nDimensions, _filterMode, _wrappingMode);
+    sharedTextures()[key] = _texture;
 }
 
 void TextureComponent::loadFromFile(const std::filesystem::path& path) {
@@ -91,38 +146,242 @@ void TextureComponent::loadFromFile(const std::filesystem::path& path) {
         return;
     }
 
+    std::filesystem::path absolutePath = absPath(path);
+    watchFile(absolutePath);
+    _fileIsDirty = false;
+    _path = absolutePath;
+    _decoding = DecodingFuture();
+
+    const TextureKey key = textureKey(_path, _nDimensions, _filterMode, _wrappingMode);
+    const auto it = sharedTextures().find(key);
+    if (it != sharedTextures().end()) {
+        std::shared_ptr<ghoul::opengl::Texture> texture = it->second.lock();
+        if (texture) {
+            _texture = std::move(texture);
+            _isPlaceholder = false;
+            _textureIsDirty = false;
+            return;
+        }
+        sharedTextures().erase(it);
+    }
+
+    if (_nDimensions != 2 || !global::threadPool) {
+        loadFromFileSynchronously(absolutePath);
+        return;
+    }
+
+    // Other components that are waiting for the same file share the decoding
+    std::map<std::filesystem::path, DecodingFuture>& pending = decodings();
+    auto decoding = pending.find(absolutePath);
+    if (decoding == pending.end()) {
+        DecodingFuture future = global::threadPool->submit(
+            [absolutePath]() { return decodeImage(absolutePath); },
+            ThreadPool::Priority::Low
+        ).share();
+        decoding = pending.emplace(absolutePath, std::move(future)).first;
+    }
+    _decoding = decoding->second;
+}
+
+void TextureComponent::update() {
+    if (_fileIsDirty) {
+        // The file has changed, so neither the shared texture nor a decoding that was
+        // started earlier can be used anymore
+        sharedTextures().erase(
+            textureKey(_path, _nDimensions, _filterMode, _wrappingMode)
+        );
+        decodings().erase(_path);
+        loadFromFile(_textureFile->path());
+    }
+
+    if (_decoding.valid()) {
+        finishDecoding();
+    }
+
+    if (_textureIsDirty) {
+        uploadToGpu();
+    }
+}
+
+void TextureComponent::watchFile(const std::filesystem::path& path) {
+    _textureFile = std::make_unique<ghoul::filesystem::File>(path);
+    if (_shouldWatchFile) {
+        _textureFile->setCallback([this]() { _fileIsDirty = true; });
+    }
+}
+
+void TextureComponent::loadFromFileSynchronously(const std::filesystem::path& path) {
     using namespace ghoul::io;
     using namespace ghoul::opengl;
 
-    std::filesystem::path absolutePath = absPath(path);
-
     std::unique_ptr<Texture> texture = TextureReader::ref().loadTexture(
-        absolutePath,
+        path,
         _nDimensions
     );
 
     if (texture) {
-        LDEBUG(std::format("Loaded texture from '{}'", absolutePath));
+        LDEBUG(std::format("Loaded texture from '{}'", path));
         _texture = std::move(texture);
+        _isPlaceholder = false;
+        _textureIsDirty = true;
+    }
+}
 
-        _textureFile = std::make_unique<ghoul::filesystem::File>(absolutePath);
-        if (_shouldWatchFile) {
-            _textureFile->setCallback([this]() { _fileIsDirty = true; });
+void TextureComponent::finishDecoding() {
+    using namespace ghoul::opengl;
+    using namespace std::chrono_literals;
+
+    if (_decoding.wait_for(0s) != std::future_status::ready) {
+        if (!_texture) {
+            createPlaceholder();
         }
+        return;
+    }
 
-        _fileIsDirty = false;
-        _textureIsDirty = true;
+    std::shared_ptr<const DecodedImage> image;
+    try {
+        image = _decoding.get();
     }
-}
+    catch (const std::exception& e) {
+        LWARNING(std::format("Failed to decode image '{}': {}", _path, e.what()));
+    }
+    // If other components are still waiting for this file, they have their own copy of
+    // the future
+    _decoding = DecodingFuture();
+    decodings().erase(_path);
 
-void TextureComponent::update() {
-    if (_fileIsDirty) {
-        loadFromFile(_textureFile->path());
+    const TextureKey key = textureKey(_path, _nDimensions, _filterMode, _wrappingMode);
+    const auto it = sharedTextures().find(key);
+    if (it != sharedTextures().end()) {
+        // Another component has created a texture from the same image in the meantime
+        std::shared_ptr<Texture> texture = it->second.lock();
+        if (texture) {
+            _texture = std::move(texture);
+            _isPlaceholder = false;
+            _textureIsDirty = false;
+            return;
+        }
     }
 
-    if (_textureIsDirty) {
-        uploadToGpu();
-        _textureIsDirty = false;
+    if (!image) {
+        // Fall back to the synchronous loading, which supports more file formats and
+        // reports a proper error if the file can not be read at all
+        loadFromFileSynchronously(_path);
+        if (_textureIsDirty) {
+            uploadToGpu();
+        }
+        return;
+    }
+
+    Texture::Format format = Texture::Format::RGBA;
+    GLenum internalFormat = GL_RGBA;
+    switch (image->nChannels) {
+        case 1:
+            format = Texture::Format::Red;
+            internalFormat = GL_RED;
+            break;
+        case 2:
+            format = Texture::Format::RG;
+            internalFormat = GL_RG;
+            break;
+        case 3:
+            format = Texture::Format::RGB;
+            internalFormat = GL_RGB;
+            break;
+        default:
+            break;
+    }
+
+    auto texture = std::make_shared<Texture>(
+        glm::uvec3(image->size, 1),
+        GL_TEXTURE_2D,
+        format,
+        internalFormat,
+        GL_UNSIGNED_BYTE,
+        _filterMode,
+        _wrappingMode,
+        Texture::AllocateData::No,
+        Texture::TakeOwnership::No
+    );
+    // The decoded image might be shared with other components, so the texture must
+    // neither take ownership of the pixels nor keep referencing them after the upload
+    texture->setPixelData(
+        const_cast<unsigned char*>(image->pixels.data()),
+        Texture::TakeOwnership::No
+    );
+    texture->uploadTexture();
+    texture->setPixelData(nullptr, Texture::TakeOwnership::No);
+    texture->setFilter(_filterMode);
+    texture->setWrapping(_wrappingMode);
+    LDEBUG(std::format("Loaded texture from '{}'", _path));
+
+    _texture = texture;
+    _isPlaceholder = false;
+    _textureIsDirty = false;
+    sharedTextures()[key] = std::move(texture);
+}
+
+void TextureComponent::createPlaceholder() {
+    using namespace ghoul::opengl;
+
+    // A single transparent texel, so that everything that is rendered with the texture
+    // is invisible until the actual image is available
+    constexpr std::array<unsigned char, 4> Transparent = { 0, 0, 0, 0 };
+
+    auto texture = std::make_shared<Texture>(
+        glm::uvec3(1),
+        GL_TEXTURE_2D,
+        Texture::Format::RGBA,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        Texture::FilterMode::Linear,
+        Texture::WrappingMode::ClampToEdge,
+        Texture::AllocateData::No,
+        Texture::TakeOwnership::No
+    );
+    texture->setPixelData(
+        const_cast<unsigned char*>(Transparent.data()),
+        Texture::TakeOwnership::No
+    );
+    texture->uploadTexture();
+    texture->setPixelData(nullptr, Texture::TakeOwnership::No);
+
+    _texture = std::move(texture);
+    _isPlaceholder = true;
+}
+
+std::shared_ptr<const TextureComponent::DecodedImage> TextureComponent::decodeImage(
+                                                              std::filesystem::path path)
+{
+    // Match the orientation of the images that are loaded through the TextureReader.
+    // The thread-local version is used as other threads might be decoding images too
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    int width = 0;
+    int height = 0;
+    int nChannels = 0;
+    stbi_uc* data = stbi_load(path.string().c_str(), &width, &height, &nChannels, 0);
+    if (!data) {
+        // Not necessarily an error, as the TextureReader supports more file formats
+        return nullptr;
     }
+
+    auto image = std::make_shared<DecodedImage>();
+    image->size = glm::uvec2(width, height);
+    image->nChannels = nChannels;
+    const size_t nBytes =
+        static_cast<size_t>(width) * static_cast<size_t>(height) * nChannels;
+    image->pixels.assign(data, data + nBytes);
+    stbi_image_free(data);
+    return image;
 }
+
+std::map<std::filesystem::path, TextureComponent::DecodingFuture>&
+TextureComponent::decodings()
+{
+    // Only accessed from the main thread
+    static std::map<std::filesystem::path, DecodingFuture> Decodings;
+    return Decodings;
+}
+
 } // namespace openspace
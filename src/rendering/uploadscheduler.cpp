@@ -0,0 +1,326 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/uploadscheduler.h>
+
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/opengl/texture.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+    constexpr std::string_view _loggerCat = "UploadScheduler";
+
+    // The maximum time we are willing to wait for the GPU to finish reading from a pixel
+    // buffer before we reuse it. If this time is exceeded, something has gone very wrong
+    constexpr GLuint64 FenceTimeout = 1'000'000'000; // 1s in nanoseconds
+
+    constexpr openspace::properties::Property::PropertyInfo ByteBudgetInfo = {
+        "ByteBudget",
+        "Byte Budget (KiB)",
+        "The maximum number of kibibytes that should be uploaded to the GPU in a single "
+        "frame by components that support staggered uploads. The first upload of each "
+        "frame is always allowed, regardless of its size.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TimeBudgetInfo = {
+        "TimeBudget",
+        "Time Budget (ms)",
+        "The maximum amount of time in milliseconds that should be spent on uploading "
+        "data to the GPU in a single frame by components that support staggered uploads.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo RingSegmentSizeInfo = {
+        "RingSegmentSize",
+        "Ring Segment Size (KiB)",
+        "The size of each of the persistently mapped pixel buffers that are used for "
+        "uploads. Uploads that are larger than this are performed directly from RAM. "
+        "This value can only be changed before the rendering has been initialized.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo UploadedBytesInfo = {
+        "UploadedBytes",
+        "Uploaded Bytes (KiB)",
+        "The number of kibibytes that were uploaded in the previous frame.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo NumberUploadsInfo = {
+        "NumberOfUploads",
+        "Number of Uploads",
+        "The number of uploads that were performed in the previous frame.",
+        openspace::properties::Property::Visibility::Developer
+    };
+} // namespace
+
+namespace openspace {
+
+UploadScheduler::UploadScheduler()
+    : properties::PropertyOwner({ "UploadScheduler", "Upload Scheduler" })
+    , _byteBudget(ByteBudgetInfo, 16 * 1024, 256, 1024 * 1024)
+    , _timeBudget(TimeBudgetInfo, 2.f, 0.1f, 50.f)
+    , _ringSegmentSize(RingSegmentSizeInfo, 16 * 1024, 1024, 256 * 1024)
+    , _uploadedBytes(UploadedBytesInfo, 0, 0, std::numeric_limits<int>::max())
+    , _nUploads(NumberUploadsInfo, 0, 0, std::numeric_limits<int>::max())
+{
+    addProperty(_byteBudget);
+    addProperty(_timeBudget);
+    addProperty(_ringSegmentSize);
+    _uploadedBytes.setReadOnly(true);
+    addProperty(_uploadedBytes);
+    _nUploads.setReadOnly(true);
+    addProperty(_nUploads);
+}
+
+void UploadScheduler::initializeGL() {
+    ZoneScoped;
+
+    // Persistently mapped buffers were introduced in OpenGL 4.4
+    using Version = ghoul::systemcapabilities::Version;
+    constexpr Version PersistentMappingVersion = { .major = 4, .minor = 4, .release = 0 };
+    if (OpenGLCap.openGLVersion() < PersistentMappingVersion) {
+        LINFO("Persistent mapping is not supported, uploading textures directly");
+        _isUsingPersistentMapping = false;
+        return;
+    }
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>(_ringSegmentSize) * 1024;
+    constexpr GLbitfield Flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    for (Segment& segment : _ring) {
+        glGenBuffers(1, &segment.pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.pbo);
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, Flags);
+        segment.mappedData = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, Flags);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _ringSegmentSize.setReadOnly(true);
+    _isUsingPersistentMapping = true;
+}
+
+void UploadScheduler::deinitializeGL() {
+    for (Segment& segment : _ring) {
+        if (segment.fence) {
+            glDeleteSync(segment.fence);
+            segment.fence = nullptr;
+        }
+        if (segment.pbo != 0) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment.pbo);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &segment.pbo);
+            segment.pbo = 0;
+            segment.mappedData = nullptr;
+        }
+    }
+    _isUsingPersistentMapping = false;
+}
+
+void UploadScheduler::resetBudget() {
+    _uploadedBytes = static_cast<int>(_nBytesThisFrame / 1024);
+    _nUploads = _nUploadsThisFrame;
+
+    _nUploadsThisFrame = 0;
+    _nBytesThisFrame = 0;
+    _timeThisFrame = std::chrono::nanoseconds(0);
+}
+
+bool UploadScheduler::hasBudget() const {
+    if (_nUploadsThisFrame == 0) {
+        return true;
+    }
+
+    const size_t byteBudget = static_cast<size_t>(_byteBudget) * 1024;
+    const std::chrono::duration<float, std::milli> timeBudget =
+        std::chrono::duration<float, std::milli>(_timeBudget);
+    return _nBytesThisFrame < byteBudget && _timeThisFrame < timeBudget;
+}
+
+uint64_t UploadScheduler::totalUploadedBytes() const {
+    return _nTotalBytes;
+}
+
+void UploadScheduler::uploadTexture(ghoul::opengl::Texture& texture) {
+    ZoneScoped;
+
+    ghoul_assert(texture.pixelData(), "Texture must have pixel data");
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t size = texture.expectedPixelDataSize();
+
+    Segment* segment = acquireSegment(size);
+    if (segment) {
+        std::memcpy(segment->mappedData, texture.pixelData(), size);
+        texture.reUploadTextureFromPBO(segment->pbo);
+        segment->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    else {
+        texture.reUploadTexture();
+    }
+
+    _nUploadsThisFrame++;
+    _nBytesThisFrame += size;
+    _nTotalBytes += size;
+    _timeThisFrame += std::chrono::steady_clock::now() - start;
+}
+
+void UploadScheduler::uploadExternal(const std::function<void()>& upload, size_t size) {
+    ZoneScoped;
+
+    const auto start = std::chrono::steady_clock::now();
+    upload();
+
+    _nUploadsThisFrame++;
+    _nBytesThisFrame += size;
+    _nTotalBytes += size;
+    _timeThisFrame += std::chrono::steady_clock::now() - start;
+}
+
+void UploadScheduler::uploadCompressedTexture(ghoul::opengl::Texture& texture,
+                                              GLenum internalFormat,
+                                              const std::byte* data,
+                                              const std::vector<size_t>& levelSizes)
+{
+    ZoneScoped;
+
+    ghoul_assert(data, "Data must not be nullptr");
+    ghoul_assert(!levelSizes.empty(), "There must be at least one mip level");
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t size = std::accumulate(levelSizes.begin(), levelSizes.end(), size_t(0));
+
+    // If the data is in the pixel buffer, the pointers passed to OpenGL are interpreted
+    // as offsets into that buffer instead
+    Segment* segment = acquireSegment(size);
+    if (segment) {
+        std::memcpy(segment->mappedData, data, size);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment->pbo);
+    }
+
+    texture.bind();
+    const glm::uvec3& dimensions = texture.dimensions();
+    size_t offset = 0;
+    for (size_t level = 0; level < levelSizes.size(); level++) {
+        const GLsizei width = static_cast<GLsizei>(std::max(dimensions.x >> level, 1u));
+        const GLsizei height = static_cast<GLsizei>(std::max(dimensions.y >> level, 1u));
+        const void* source =
+            segment ? reinterpret_cast<const void*>(offset) : data + offset;
+        glCompressedTexSubImage2D(
+            GL_TEXTURE_2D,
+            static_cast<GLint>(level),
+            0,
+            0,
+            width,
+            height,
+            internalFormat,
+            static_cast<GLsizei>(levelSizes[level]),
+            source
+        );
+        offset += levelSizes[level];
+    }
+
+    if (segment) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        segment->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    _nUploadsThisFrame++;
+    _nBytesThisFrame += size;
+    _nTotalBytes += size;
+    _timeThisFrame += std::chrono::steady_clock::now() - start;
+}
+
+void UploadScheduler::uploadTextureSlices(ghoul::opengl::Texture& texture,
+                                          unsigned int zOffset, unsigned int depth,
+                                          const std::byte* data, size_t size)
+{
+    ZoneScoped;
+
+    ghoul_assert(data, "Data must not be nullptr");
+    ghoul_assert(
+        zOffset + depth <= texture.dimensions().z,
+        "Slices must be inside the texture"
+    );
+
+    const auto start = std::chrono::steady_clock::now();
+
+    Segment* segment = acquireSegment(size);
+    if (segment) {
+        std::memcpy(segment->mappedData, data, size);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, segment->pbo);
+    }
+
+    texture.bind();
+    const glm::uvec3& dimensions = texture.dimensions();
+    glTexSubImage3D(
+        GL_TEXTURE_3D,
+        0,
+        0,
+        0,
+        static_cast<GLint>(zOffset),
+        static_cast<GLsizei>(dimensions.x),
+        static_cast<GLsizei>(dimensions.y),
+        static_cast<GLsizei>(depth),
+        static_cast<GLenum>(texture.format()),
+        texture.dataType(),
+        segment ? nullptr : data
+    );
+
+    if (segment) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        segment->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    _nUploadsThisFrame++;
+    _nBytesThisFrame += size;
+    _nTotalBytes += size;
+    _timeThisFrame += std::chrono::steady_clock::now() - start;
+}
+
+UploadScheduler::Segment* UploadScheduler::acquireSegment(size_t size) {
+    const size_t segmentSize = static_cast<size_t>(_ringSegmentSize) * 1024;
+    if (!_isUsingPersistentMapping || size > segmentSize) {
+        return nullptr;
+    }
+
+    Segment& segment = _ring[_nextSegment];
+    _nextSegment = (_nextSegment + 1) % NSegments;
+
+    // Make sure that the GPU has finished reading the previous data in this segment
+    if (segment.fence) {
+        glClientWaitSync(segment.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+        glDeleteSync(segment.fence);
+        segment.fence = nullptr;
+    }
+    return &segment;
+}
+
+} // namespace openspace
@@ -49,4 +49,12 @@ float VolumeRaycaster::downscaleRender() const {
     return _downscaleRenderConst;
 }
 
+void VolumeRaycaster::setTargetRaycastTime(float milliseconds) {
+    _targetRaycastTime = milliseconds;
+}
+
+float VolumeRaycaster::targetRaycastTime() const {
+    return _targetRaycastTime;
+}
+
 } // namespace openspace
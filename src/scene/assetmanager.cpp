@@ -31,9 +31,16 @@
 #include <openspace/events/eventengine.h>
 #include <openspace/scene/asset.h>
 #include <openspace/scripting/lualibrary.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/lua_helper.h>
+#include <ghoul/misc/defer.h>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <iterator>
 
 #include "assetmanager_lua.inl"
 
@@ -52,6 +59,157 @@ namespace {
         Tokenized ///< Specified as a path that starts with a token
     };
 
+    std::string readFileContents(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), {});
+    }
+
+    // Returns the bytecode of the function on the top of the stack
+    std::string dumpChunk(lua_State* L) {
+        std::string bytecode;
+        lua_dump(
+            L,
+            [](lua_State*, const void* p, size_t size, void* data) {
+                static_cast<std::string*>(data)->append(
+                    static_cast<const char*>(p),
+                    size
+                );
+                return 0;
+            },
+            &bytecode,
+            0
+        );
+        return bytecode;
+    }
+
+    // Compiles the `source` in a separate Lua state so that this function can be called
+    // from any thread. Returns an empty string if the source does not compile
+    std::string compileChunk(const std::string& source, const std::string& chunkName) {
+        ZoneScoped;
+
+        lua_State* L = luaL_newstate();
+        defer { lua_close(L); };
+
+        const int status = luaL_loadbufferx(
+            L,
+            source.data(),
+            source.size(),
+            chunkName.c_str(),
+            "t"
+        );
+        return status == LUA_OK ? dumpChunk(L) : "";
+    }
+
+    // Returns the names of all assets that are required with a literal string in the
+    // `source`. Names that are only computed at runtime are missed, which is fine as
+    // this is only used to start loading the files early
+    std::vector<std::string> requiredAssetNames(std::string_view source) {
+        constexpr std::string_view Require = "asset.require(";
+
+        std::vector<std::string> res;
+        size_t pos = source.find(Require);
+        while (pos != std::string_view::npos) {
+            pos += Require.size();
+            while (pos < source.size() &&
+                   std::isspace(static_cast<unsigned char>(source[pos])))
+            {
+                pos++;
+            }
+            if (pos < source.size() && (source[pos] == '"' || source[pos] == '\'')) {
+                const char quote = source[pos];
+                const size_t end = source.find(quote, pos + 1);
+                if (end != std::string_view::npos) {
+                    res.emplace_back(source.substr(pos + 1, end - pos - 1));
+                }
+            }
+            pos = source.find(Require, pos);
+        }
+        return res;
+    }
+
+    // Pushes the compiled chunk of the asset file at `path` onto the stack. The bytecode
+    // is cached, keyed by the hash of the file's contents, so that unchanged assets do
+    // not have to be parsed again on the next startup. If the file has been prefetched,
+    // its `prefetchedSource` and `prefetchedBytecode` are used instead of reading and
+    // compiling the file
+    void loadAssetChunk(lua_State* L, const std::filesystem::path& path,
+                        std::optional<std::string> prefetchedSource = std::nullopt,
+                        std::string_view prefetchedBytecode = "")
+    {
+        ZoneScoped;
+
+        const std::string source =
+            prefetchedSource.has_value() ?
+            std::move(*prefetchedSource) :
+            readFileContents(path);
+        const std::string chunkName = std::format("@{}", path);
+
+        std::filesystem::path cached;
+        if (FileSys.cacheManager()) {
+            cached = FileSys.cacheManager()->cachedFilename(
+                path,
+                std::format(
+                    "LuaBytecode|{}|{}", LUA_VERSION_NUM, std::hash<std::string>{}(source)
+                )
+            );
+        }
+
+        if (!prefetchedBytecode.empty()) {
+            const int status = luaL_loadbufferx(
+                L,
+                prefetchedBytecode.data(),
+                prefetchedBytecode.size(),
+                chunkName.c_str(),
+                "b"
+            );
+            if (status == LUA_OK) {
+                if (!cached.empty() && !std::filesystem::is_regular_file(cached)) {
+                    std::ofstream file(cached, std::ios::binary);
+                    file.write(prefetchedBytecode.data(), prefetchedBytecode.size());
+                }
+                return;
+            }
+            lua_pop(L, 1);
+        }
+
+        if (!cached.empty() && std::filesystem::is_regular_file(cached)) {
+            const std::string bytecode = readFileContents(cached);
+            const int status = luaL_loadbufferx(
+                L,
+                bytecode.data(),
+                bytecode.size(),
+                chunkName.c_str(),
+                "b"
+            );
+            if (status == LUA_OK) {
+                return;
+            }
+
+            // The cached file is corrupt, so we fall back to the source file
+            lua_pop(L, 1);
+            FileSys.cacheManager()->removeCacheFile(cached);
+        }
+
+        const int status = luaL_loadbufferx(
+            L,
+            source.data(),
+            source.size(),
+            chunkName.c_str(),
+            "t"
+        );
+        if (status != LUA_OK) {
+            std::string error = lua_tostring(L, -1);
+            lua_pop(L, 1);
+            throw ghoul::lua::LuaRuntimeException(std::move(error));
+        }
+
+        if (!cached.empty()) {
+            const std::string bytecode = dumpChunk(L);
+            std::ofstream file(cached, std::ios::binary);
+            file.write(bytecode.data(), bytecode.size());
+        }
+    }
+
     PathType classifyPath(const std::string& path) {
         if (path.size() > 2 && path[0] == '.' && path[1] == '/') {
             return PathType::RelativeToAsset;
@@ -123,6 +281,7 @@ AssetManager::AssetManager(ghoul::lua::LuaState* state,
 }
 
 AssetManager::~AssetManager() {
+    waitForPrefetches();
     _assets.clear();
     luaL_unref(*_luaState, LUA_REGISTRYINDEX, _assetsTableRef);
 }
@@ -187,6 +346,13 @@ void AssetManager::update() {
         break;
     }
 
+    // Start reading and compiling all queued assets and their dependencies in the
+    // background. The assets are still executed one by one below, but by the time the
+    // execution reaches a required asset, its file has most likely been compiled already
+    for (const std::string& asset : _assetAddQueue) {
+        prefetchAsset(generateAssetPath(_assetRootDirectory, asset));
+    }
+
     // Add all assets that have been queued for loading since the last `update` call
     for (const std::string& asset : _assetAddQueue) {
         ZoneScopedN("Adding queued assets");
@@ -217,13 +383,30 @@ void AssetManager::update() {
             continue;
         }
         _rootAssets.push_back(a);
-        a->startSynchronizations();
+        if (_automaticSynchronization) {
+            a->startSynchronizations();
+        }
 
         _toBeInitialized.push_back(a);
         global::profile->addAsset(asset);
     }
     _assetAddQueue.clear();
 
+    {
+        // Every asset that was requested by the loaded assets has been taken out of the
+        // prefetched assets by now, so the rest was requested by code paths that were
+        // not executed. The prefetches that are still running are removed in a later
+        // update call once they have finished
+        std::lock_guard lock(_prefetchMutex);
+        std::erase_if(
+            _prefetchedAssets,
+            [](const auto& p) {
+                using namespace std::chrono_literals;
+                return p.second.wait_for(0s) == std::future_status::ready;
+            }
+        );
+    }
+
     // Remove assets
     for (const std::string& asset : _assetRemoveQueue) {
         ZoneScopedN("Removing queued assets");
@@ -346,6 +529,21 @@ std::vector<const ResourceSynchronization*> AssetManager::allSynchronizations()
     return res;
 }
 
+std::vector<ResourceSynchronization*> AssetManager::allSynchronizations() {
+    std::vector<ResourceSynchronization*> res;
+    res.reserve(_synchronizations.size());
+    using K = std::string;
+    using V = std::unique_ptr<SyncItem>;
+    for (const std::pair<const K, V>& p : _synchronizations) {
+        res.push_back(p.second->synchronization.get());
+    }
+    return res;
+}
+
+void AssetManager::setAutomaticSynchronization(bool enabled) {
+    _automaticSynchronization = enabled;
+}
+
 bool AssetManager::isRootAsset(const Asset* asset) const {
     auto it = std::find(_rootAssets.begin(), _rootAssets.end(), asset);
     return it != _rootAssets.end();
@@ -370,7 +568,23 @@ bool AssetManager::loadAsset(Asset* asset, Asset* parent) {
     }
 
     try {
-        ghoul::lua::runScriptFile(*_luaState, asset->path());
+        std::optional<PrefetchedAsset> prefetched = takePrefetchedAsset(asset->path());
+        if (prefetched.has_value()) {
+            loadAssetChunk(
+                *_luaState,
+                asset->path(),
+                std::move(prefetched->source),
+                prefetched->bytecode
+            );
+        }
+        else {
+            loadAssetChunk(*_luaState, asset->path());
+        }
+        if (lua_pcall(*_luaState, 0, 0, 0) != LUA_OK) {
+            throw ghoul::lua::LuaRuntimeException(
+                ghoul::lua::value<std::string>(*_luaState, -1)
+            );
+        }
     }
     catch (const ghoul::lua::LuaRuntimeException& e) {
         LERROR(std::format("Could not load asset '{}': {}", asset->path(), e.message));
@@ -1036,6 +1250,85 @@ std::filesystem::path AssetManager::generateAssetPath(
     return absPath(fullAssetPath);
 }
 
+void AssetManager::prefetchAsset(std::filesystem::path path) {
+    std::string key = path.string();
+
+    std::lock_guard lock(_prefetchMutex);
+    if (_prefetchedAssets.contains(key)) {
+        return;
+    }
+
+    std::future<PrefetchedAsset> f = global::threadPool->submit(
+        [this, path = std::move(path)]() {
+            ZoneScopedN("Prefetch asset");
+
+            PrefetchedAsset res;
+            if (!std::filesystem::is_regular_file(path)) {
+                // The error is reported when the asset is actually loaded
+                return res;
+            }
+            res.source = readFileContents(path);
+
+            // Start with the dependencies so that they are compiled in parallel with
+            // this file
+            for (const std::string& name : requiredAssetNames(res.source)) {
+                prefetchAsset(generateAssetPath(path.parent_path(), name));
+            }
+
+            res.bytecode = compileChunk(res.source, std::format("@{}", path));
+            return res;
+        },
+        ThreadPool::Priority::High
+    );
+    _prefetchedAssets.emplace(std::move(key), f.share());
+}
+
+std::optional<AssetManager::PrefetchedAsset> AssetManager::takePrefetchedAsset(
+                                                        const std::filesystem::path& path)
+{
+    std::lock_guard lock(_prefetchMutex);
+    const auto it = _prefetchedAssets.find(path.string());
+    if (it == _prefetchedAssets.end()) {
+        return std::nullopt;
+    }
+
+    using namespace std::chrono_literals;
+    if (it->second.wait_for(0s) != std::future_status::ready) {
+        // Loading the file on the main thread is faster than waiting for a worker that
+        // might be busy with unrelated tasks in the meantime
+        return std::nullopt;
+    }
+
+    PrefetchedAsset res = it->second.get();
+    _prefetchedAssets.erase(it);
+    return res;
+}
+
+void AssetManager::waitForPrefetches() {
+    // A running prefetch can start new prefetches for the assets that it requires, so
+    // we have to repeat until no new prefetches have been added while we were waiting
+    while (true) {
+        std::vector<std::shared_future<PrefetchedAsset>> prefetches;
+        {
+            std::lock_guard lock(_prefetchMutex);
+            prefetches.reserve(_prefetchedAssets.size());
+            for (const auto& [path, prefetch] : _prefetchedAssets) {
+                prefetches.push_back(prefetch);
+            }
+        }
+
+        for (const std::shared_future<PrefetchedAsset>& prefetch : prefetches) {
+            prefetch.wait();
+        }
+
+        std::lock_guard lock(_prefetchMutex);
+        if (_prefetchedAssets.size() == prefetches.size()) {
+            _prefetchedAssets.clear();
+            return;
+        }
+    }
+}
+
 scripting::LuaLibrary AssetManager::luaLibrary() {
     return {
         "asset",
@@ -61,7 +61,7 @@ ghoul::mm_unique_ptr<Rotation> Rotation::createFromDictionary(
     Rotation* result = FactoryManager::ref().factory<Rotation>()->create(
         p.type,
         dictionary,
-        &global::memoryManager->PersistentMemory
+        &global::memoryManager->SceneGraphMemory
     );
     result->_type = p.type;
     return ghoul::mm_unique_ptr<Rotation>(result);
@@ -81,15 +81,26 @@ const glm::dmat3& Rotation::matrix() const {
     return _cachedMatrix;
 }
 
+bool Rotation::supportsParallelUpdate() const {
+    return false;
+}
+
 void Rotation::update(const UpdateData& data) {
     ZoneScoped;
 
     if (!_needsUpdate && (data.time.j2000Seconds() == _cachedTime)) {
+        _hasChanged = false;
         return;
     }
+    const glm::dmat3 oldMatrix = _cachedMatrix;
     _cachedMatrix = matrix(data);
     _cachedTime = data.time.j2000Seconds();
     _needsUpdate = false;
+    _hasChanged = oldMatrix != _cachedMatrix;
+}
+
+bool Rotation::hasChanged() const {
+    return _hasChanged;
 }
 
 } // namespace openspace
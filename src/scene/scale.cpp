@@ -60,7 +60,7 @@ ghoul::mm_unique_ptr<Scale> Scale::createFromDictionary(
     Scale* result = FactoryManager::ref().factory<Scale>()->create(
         p.type,
         dictionary,
-        &global::memoryManager->PersistentMemory
+        &global::memoryManager->SceneGraphMemory
     );
     result->setIdentifier("Scale");
     result->_type = p.type;
@@ -82,15 +82,26 @@ glm::dvec3 Scale::scaleValue() const {
     return _cachedScale;
 }
 
+bool Scale::supportsParallelUpdate() const {
+    return false;
+}
+
 void Scale::update(const UpdateData& data) {
     ZoneScoped;
 
     if (!_needsUpdate && data.time.j2000Seconds() == _cachedTime) {
+        _hasChanged = false;
         return;
     }
+    const glm::dvec3 oldScale = _cachedScale;
     _cachedScale = scaleValue(data);
     _cachedTime = data.time.j2000Seconds();
     _needsUpdate = false;
+    _hasChanged = oldScale != _cachedScale;
+}
+
+bool Scale::hasChanged() const {
+    return _hasChanged;
 }
 
 } // namespace openspace
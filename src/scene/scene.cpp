@@ -25,6 +25,7 @@
 #include <openspace/scene/scene.h>
 
 #include <openspace/camera/camera.h>
+#include <openspace/camera/camerasnapshot.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/globalscallbacks.h>
@@ -41,6 +42,7 @@
 #include <openspace/scene/sceneinitializer.h>
 #include <openspace/scripting/lualibrary.h>
 #include <openspace/scripting/scriptengine.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/logging/logmanager.h>
@@ -50,9 +52,14 @@
 #include <ghoul/misc/easing.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/misc/stringhelper.h>
-#include <ghoul/opengl/ghoul_gl.h>
+#include <algorithm>
+#include <bit>
+#include <latch>
+#include <optional>
 #include <string>
 #include <stack>
+#include <thread>
+#include <unordered_set>
 
 #include "scene_lua.inl"
 
@@ -62,6 +69,48 @@ namespace {
     constexpr std::string_view KeyParent = "Parent";
     constexpr const char* RootNodeIdentifier = "Root";
 
+    // The minimum number of nodes in a single dependency level that can be updated in
+    // parallel before it is worth to distribute the work to the worker threads
+    constexpr size_t MinNodesForParallelUpdate = 32;
+
+    unsigned int numberOfUpdateThreads() {
+        return std::max(std::thread::hardware_concurrency() / 2, 2u);
+    }
+
+    constexpr openspace::properties::Property::PropertyInfo ParallelUpdateInfo = {
+        "ParallelUpdate",
+        "Parallel Update",
+        "If this value is enabled, scene graph nodes that only depend on nodes that have "
+        "already been updated are updated concurrently on multiple threads. Only nodes "
+        "whose transformations and renderable have declared that they support a parallel "
+        "update are affected, all other nodes are still updated on the main thread.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PipelinedUpdateInfo = {
+        "PipelinedUpdate",
+        "Pipelined Update",
+        "If this value is enabled, the world transforms of the scene graph nodes for the "
+        "next frame are computed on a worker thread while the current frame is being "
+        "rendered. This reduces the frame time if both the update and the rendering are "
+        "expensive, but every object is drawn at the position of the previous frame. "
+        "This should therefore be disabled for VR and other latency-sensitive setups. "
+        "Nodes with transformations that do not support a parallel update, and their "
+        "children, are still updated on the main thread. Such a node still inherits "
+        "the one frame of latency if any of its ancestors is updated on the worker.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrustumCullingInfo = {
+        "FrustumCulling",
+        "Frustum Culling",
+        "If this value is enabled, the bounding sphere of each scene graph node is "
+        "tested against the view frustum once per camera and frame, and nodes that are "
+        "entirely outside of it are not visited in any of the render bins. Nodes "
+        "without a bounding sphere are always rendered.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
 #ifdef TRACY_ENABLE
     constexpr const char* renderBinToString(int renderBin) {
         // Synced with Renderable::RenderBin
@@ -101,6 +150,40 @@ namespace {
 
     template <class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
     template <class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
+
+    // Calls \p func for each property below the \p owner, together with the URI of the
+    // property. This is the same as calling Property::uri for each property, but the
+    // URIs of the owners are only assembled once rather than for every property
+    template <typename Func>
+    void forEachPropertyWithUri(const openspace::properties::PropertyOwner& owner,
+                                const std::string& ownerUri, const Func& func)
+    {
+        using namespace openspace::properties;
+
+        for (Property* prop : owner.properties()) {
+            func(prop, std::format("{}.{}", ownerUri, prop->identifier()));
+        }
+        for (const PropertyOwner* subOwner : owner.propertySubOwners()) {
+            forEachPropertyWithUri(
+                *subOwner,
+                std::format("{}.{}", ownerUri, subOwner->identifier()),
+                func
+            );
+        }
+    }
+
+    // The properties of the root itself have no valid URI, so only the properties of its
+    // sub-owners are visited
+    template <typename Func>
+    void forEachPropertyWithUri(const openspace::properties::PropertyOwner& root,
+                                const Func& func)
+    {
+        for (const openspace::properties::PropertyOwner* owner :
+             root.propertySubOwners())
+        {
+            forEachPropertyWithUri(*owner, owner->identifier(), func);
+        }
+    }
 } // namespace
 
 namespace openspace {
@@ -113,7 +196,22 @@ Scene::Scene(std::unique_ptr<SceneInitializer> initializer)
     : properties::PropertyOwner({"Scene", "Scene"})
     , _camera(std::make_unique<Camera>())
     , _initializer(std::move(initializer))
+    , _parallelUpdate(ParallelUpdateInfo, false)
+    , _pipelinedUpdate(PipelinedUpdateInfo, false)
+    , _frustumCulling(FrustumCullingInfo, false)
 {
+    auto createThreadPool = [this]() {
+        if ((_parallelUpdate || _pipelinedUpdate) && !_updateThreadPool) {
+            _updateThreadPool = std::make_unique<ThreadPool>(numberOfUpdateThreads());
+        }
+    };
+    _parallelUpdate.onChange(createThreadPool);
+    addProperty(_parallelUpdate);
+    _pipelinedUpdate.onChange(createThreadPool);
+    addProperty(_pipelinedUpdate);
+    _frustumCulling.onChange([this]() { _hasRenderBinNodes = false; });
+    addProperty(_frustumCulling);
+
     _rootNode.setIdentifier(RootNodeIdentifier);
     _rootNode.setScene(this);
     _rootNode.setGuiHintHidden(true);
@@ -122,6 +220,8 @@ Scene::Scene(std::unique_ptr<SceneInitializer> initializer)
 }
 
 Scene::~Scene() {
+    finishPipelinedUpdate();
+
     LINFO("Clearing current scene graph");
     for (SceneGraphNode* node : _topologicallySortedNodes) {
         if (node->identifier() == "Root") {
@@ -207,6 +307,9 @@ void Scene::sortTopologically() {
         std::make_move_iterator(_circularNodes.end())
     );
     _circularNodes.clear();
+    _dependencyLevels.clear();
+    _pipelinedNodes.clear();
+    _hasRenderBinNodes = false;
 
     ghoul_assert(
         _topologicallySortedNodes.size() == _nodesByIdentifier.size(),
@@ -271,6 +374,43 @@ void Scene::sortTopologically() {
     }
 
     _topologicallySortedNodes = nodes;
+
+    // Group the sorted nodes into levels. As each node is only visited after its parent
+    // and dependencies, their levels are already known when we get to it
+    std::unordered_map<SceneGraphNode*, size_t> levels;
+    for (SceneGraphNode* node : _topologicallySortedNodes) {
+        size_t level = 0;
+        if (node->parent()) {
+            level = levels[node->parent()] + 1;
+        }
+        for (SceneGraphNode* dependency : node->dependencies()) {
+            level = std::max(level, levels[dependency] + 1);
+        }
+        levels[node] = level;
+
+        if (level >= _dependencyLevels.size()) {
+            _dependencyLevels.resize(level + 1);
+        }
+        _dependencyLevels[level].push_back(node);
+    }
+
+    // A node can only be part of the pipelined update if the nodes that its transform is
+    // computed from are computed on the same worker thread beforehand
+    std::unordered_set<const SceneGraphNode*> pipelined;
+    for (SceneGraphNode* node : _topologicallySortedNodes) {
+        const bool canPipeline =
+            node->supportsParallelTransformUpdate() &&
+            (!node->parent() || pipelined.contains(node->parent())) &&
+            std::all_of(
+                node->dependencies().begin(),
+                node->dependencies().end(),
+                [&pipelined](const SceneGraphNode* n) { return pipelined.contains(n); }
+            );
+        if (canPipeline) {
+            pipelined.insert(node);
+            _pipelinedNodes.push_back(node);
+        }
+    }
 }
 
 void Scene::initializeNode(SceneGraphNode* node) {
@@ -283,7 +423,7 @@ bool Scene::isInitializing() const {
     return _initializer->isInitializing();
 }
 
-void Scene::update(const UpdateData& data) {
+void Scene::initializeGLOfInitializedNodes() {
     ZoneScoped;
 
     const std::vector<SceneGraphNode*> initialized = _initializer->takeInitializedNodes();
@@ -295,10 +435,49 @@ void Scene::update(const UpdateData& data) {
             LERRORC(e.component, e.message);
         }
     }
+}
+
+void Scene::update(const UpdateData& data) {
+    ZoneScoped;
+
+    // The culling results of the last frame are invalid as soon as the nodes move
+    _hasRenderBinNodes = false;
+    initializeGLOfInitializedNodes();
     if (_dirtyNodeRegistry) {
         updateNodeRegistry();
     }
     _camera->setAtmosphereDimmingFactor(1.f);
+
+    if (_pipelinedUpdate && _updateThreadPool) {
+        finishPipelinedUpdate();
+
+        // All nodes that were not computed in the last pipelined update, either because
+        // they are not part of it or because they were added or initialized since it
+        // ran, are brought up to date here. The renderables are then updated with the
+        // transforms of the previous frame that they will also be rendered with
+        for (SceneGraphNode* node : _topologicallySortedNodes) {
+            try {
+                if (!node->hasCurrentTransform()) {
+                    node->updateTransform(data);
+                }
+                node->publishTransform();
+                node->updateRenderable(data);
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.what());
+            }
+        }
+        _pipelinedUpdateData = std::make_unique<UpdateData>(data);
+        return;
+    }
+
+    if (_parallelUpdate && _updateThreadPool) {
+        for (const std::vector<SceneGraphNode*>& level : _dependencyLevels) {
+            updateLevel(level, data);
+        }
+        return;
+    }
+
     for (SceneGraphNode* node : _topologicallySortedNodes) {
         try {
             node->update(data);
@@ -309,6 +488,132 @@ void Scene::update(const UpdateData& data) {
     }
 }
 
+void Scene::updateLevel(const std::vector<SceneGraphNode*>& nodes,
+                        const UpdateData& data)
+{
+    ZoneScoped;
+
+    auto updateNode = [&data](SceneGraphNode* node) {
+        try {
+            node->update(data);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERRORC(e.component, e.what());
+        }
+    };
+
+    std::vector<SceneGraphNode*> parallelNodes;
+    std::vector<SceneGraphNode*> serialNodes;
+    for (SceneGraphNode* node : nodes) {
+        if (node->supportsParallelUpdate()) {
+            parallelNodes.push_back(node);
+        }
+        else {
+            serialNodes.push_back(node);
+        }
+    }
+
+    if (parallelNodes.size() < MinNodesForParallelUpdate) {
+        serialNodes.insert(serialNodes.end(), parallelNodes.begin(), parallelNodes.end());
+        parallelNodes.clear();
+    }
+
+    if (!parallelNodes.empty()) {
+        // The main thread takes part in the update, so we create one more batch than
+        // there are worker threads
+        const size_t nBatches = numberOfUpdateThreads() + 1;
+        const size_t batchSize = (parallelNodes.size() + nBatches - 1) / nBatches;
+        const size_t nWorkerBatches = (parallelNodes.size() - 1) / batchSize;
+
+        std::latch done(static_cast<std::ptrdiff_t>(nWorkerBatches));
+        for (size_t i = 0; i < nWorkerBatches; i++) {
+            const size_t begin = (i + 1) * batchSize;
+            const size_t end = std::min(begin + batchSize, parallelNodes.size());
+            auto batch = [&parallelNodes, &updateNode, &done, begin, end]() {
+                ZoneScopedN("ParallelUpdate");
+                for (size_t j = begin; j < end; j++) {
+                    updateNode(parallelNodes[j]);
+                }
+                done.count_down();
+            };
+            _updateThreadPool->enqueue(std::move(batch));
+        }
+        for (size_t j = 0; j < std::min(batchSize, parallelNodes.size()); j++) {
+            updateNode(parallelNodes[j]);
+        }
+        done.wait();
+    }
+
+    // The remaining nodes have to be updated on the main thread. Since they are in the
+    // same dependency level as the parallel nodes, the order between them doesn't matter
+    for (SceneGraphNode* node : serialNodes) {
+        updateNode(node);
+    }
+}
+
+void Scene::startPipelinedUpdate() {
+    ZoneScoped;
+
+    if (!_pipelinedUpdateData || _pipelinedUpdateResult.valid()) {
+        return;
+    }
+
+    // The update data is consumed here so that a pipelined update is only started once
+    // for every call to update
+    _pipelinedUpdateResult = _updateThreadPool->submit(
+        [this, data = *_pipelinedUpdateData]() {
+            ZoneScopedN("PipelinedUpdate");
+            for (SceneGraphNode* node : _pipelinedNodes) {
+                try {
+                    node->updateTransform(data);
+                }
+                catch (const ghoul::RuntimeError& e) {
+                    LERRORC(e.component, e.what());
+                }
+            }
+        },
+        ThreadPool::Priority::High
+    );
+    _pipelinedUpdateData = nullptr;
+}
+
+void Scene::finishPipelinedUpdate() {
+    ZoneScoped;
+
+    if (!_pipelinedUpdateResult.valid()) {
+        return;
+    }
+
+    try {
+        _pipelinedUpdateResult.get();
+    }
+    catch (const std::exception& e) {
+        LERROR(std::format("Error in pipelined update: {}", e.what()));
+    }
+}
+
+void Scene::cullNodes(const CameraSnapshot& camera) {
+    ZoneScoped;
+
+    if (!_frustumCulling) {
+        return;
+    }
+
+    const std::array<glm::dvec4, 4>& planes = camera.frustumPlanes;
+    for (std::vector<SceneGraphNode*>& nodes : _renderBinNodes) {
+        nodes.clear();
+    }
+    for (SceneGraphNode* node : _topologicallySortedNodes) {
+        const int bins = node->visibleRenderBins(planes);
+        for (size_t i = 0; i < _renderBinNodes.size(); i++) {
+            if (bins & (1 << i)) {
+                _renderBinNodes[i].push_back(node);
+            }
+        }
+    }
+    _hasRenderBinNodes = true;
+}
+
 void Scene::render(const RenderData& data, RendererTasks& tasks) {
     ZoneScoped;
     ZoneText(
@@ -316,7 +621,14 @@ void Scene::render(const RenderData& data, RendererTasks& tasks) {
         strlen(renderBinToString(data.renderBinMask))
     );
 
-    for (SceneGraphNode* node : _topologicallySortedNodes) {
+    // Use the culled list if there is one for this specific render bin
+    const bool useCulledNodes = _hasRenderBinNodes &&
+        std::has_single_bit(static_cast<unsigned int>(data.renderBinMask));
+    const std::vector<SceneGraphNode*>& nodes = useCulledNodes ?
+        _renderBinNodes[std::countr_zero(static_cast<unsigned int>(data.renderBinMask))] :
+        _topologicallySortedNodes;
+
+    for (SceneGraphNode* node : nodes) {
         try {
             node->render(data, tasks);
         }
@@ -327,19 +639,6 @@ void Scene::render(const RenderData& data, RendererTasks& tasks) {
             (*global::callback::webBrowserPerformanceHotfix)();
         }
     }
-
-    {
-        ZoneScopedN("Get Error Hack");
-
-        // @TODO(abock 2019-08-19) This glGetError call is a hack to prevent the GPU
-        // thread and the CPU thread from diverging too much, particularly the uploading
-        // of a lot of textures for the globebrowsing planets can cause a hard stuttering
-        // effect. Asking for a glGetError after every rendering call will force the
-        // threads to implicitly synchronize and thus prevent the stuttering.  The better
-        // solution would be to reduce the number of uploads per frame, use a staggered
-        // buffer, or something else like that preventing a large spike in uploads
-        glGetError();
-    }
 }
 
 const std::unordered_map<std::string, SceneGraphNode*>& Scene::nodesByIdentifier() const {
@@ -471,18 +770,18 @@ void Scene::addPropertyInterpolation(properties::Property* prop, float durationS
         nullptr :
         ghoul::easingFunction<float>(easingFunction);
 
-    // First check if the current property already has an interpolation information
+    // First check if the current property already has an interpolation information. If
+    // so, it is removed and added again at the end so that it ends up next to the other
+    // interpolations that are started at the same time
     const std::chrono::steady_clock::time_point now = currentTimeForInterpolation();
-    for (PropertyInterpolationInfo& info : _propertyInterpolationInfos) {
-        if (info.prop == prop) {
-            info.beginTime = now;
-            info.durationSeconds = durationSeconds;
-            info.postScript = std::move(postScript);
-            info.easingFunction = func;
-            // If we found it, we can break since we make sure that each property is only
-            // represented once in this
-            return;
-        }
+    const auto it = std::find_if(
+        _propertyInterpolationInfos.begin(),
+        _propertyInterpolationInfos.end(),
+        [prop](const PropertyInterpolationInfo& info) { return info.prop == prop; }
+    );
+    // We make sure that each property is only represented once in the list
+    if (it != _propertyInterpolationInfos.end()) {
+        _propertyInterpolationInfos.erase(it);
     }
 
     PropertyInterpolationInfo i = {
@@ -523,20 +822,46 @@ void Scene::updateInterpolations() {
 
     using namespace std::chrono;
 
+    if (_propertyInterpolationInfos.empty()) {
+        return;
+    }
+
+    // All properties are updated before any of their listeners are informed, so that
+    // objects depending on multiple interpolated properties only update once
+    const properties::Property::ChangeBatch batch;
+
     const steady_clock::time_point now = currentTimeForInterpolation();
+
+    // Interpolations that were started by the same script share their begin time,
+    // duration, and easing function and are stored next to each other. For those, the
+    // interpolation parameter and the easing function are only evaluated once
+    const PropertyInterpolationInfo* group = nullptr;
+    float t = 0.f;
+    float easedT = 0.f;
+
     // First, let's update the properties
     for (PropertyInterpolationInfo& i : _propertyInterpolationInfos) {
-        const long long us =
-            duration_cast<std::chrono::microseconds>(now - i.beginTime).count();
-
-        const float t = glm::clamp(
-            static_cast<float>(
-                static_cast<double>(us) /
-                static_cast<double>(i.durationSeconds * 1000000)
-            ),
-            0.f,
-            1.f
-        );
+        const bool isSameGroup =
+            group &&
+            group->beginTime == i.beginTime &&
+            group->durationSeconds == i.durationSeconds &&
+            group->easingFunction == i.easingFunction;
+
+        if (!isSameGroup) {
+            const long long us =
+                duration_cast<std::chrono::microseconds>(now - i.beginTime).count();
+
+            t = glm::clamp(
+                static_cast<float>(
+                    static_cast<double>(us) /
+                    static_cast<double>(i.durationSeconds * 1000000)
+                ),
+                0.f,
+                1.f
+            );
+            easedT = i.easingFunction ? i.easingFunction(t) : t;
+            group = &i;
+        }
 
         // @FRAGILE(abock): This method might crash if someone deleted the property
         //                  underneath us. We take care of removing entire PropertyOwners,
@@ -544,7 +869,7 @@ void Scene::updateInterpolations() {
         //                  SceneGraphNodes. This is true in general, but if Propertys are
         //                  created and destroyed often by the SceneGraphNode, this might
         //                  become a problem.
-        i.prop->interpolateValue(t, i.easingFunction);
+        i.prop->interpolateValue(easedT, nullptr);
 
         i.isExpired = (t == 1.f);
 
@@ -577,39 +902,134 @@ void Scene::updateInterpolations() {
 }
 
 void Scene::setPropertiesFromProfile(const Profile& p) {
+    ZoneScoped;
+
     ghoul::lua::LuaState L;
 
+    // The value of each entry is only converted once and is stored in this table, from
+    // where it is applied to every property that the entry matches
+    lua_newtable(L);
+    const int valuesIndex = lua_gettop(L);
+
+    struct Entry {
+        std::string uriOrRegex;
+        std::optional<PropertyMatcher> matcher;
+        std::vector<properties::Property*> matches;
+        int luaType = LUA_TNIL;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(p.properties.size());
+    std::vector<size_t> wildcardEntries;
+
     for (const Profile::Property& prop : p.properties) {
         if (prop.name.empty()) {
             LWARNING("Property name in profile was empty");
             continue;
         }
-        std::string uriOrRegex = prop.name;
+        Entry entry;
+        entry.uriOrRegex = prop.name;
         std::string groupName;
-        if (doesUriContainGroupTag(uriOrRegex, groupName)) {
+        if (doesUriContainGroupTag(entry.uriOrRegex, groupName)) {
             // Remove group name from start of regex and replace with '*'
-            uriOrRegex = removeGroupNameFromUri(uriOrRegex);
+            entry.uriOrRegex = removeGroupNameFromUri(entry.uriOrRegex);
         }
-        _profilePropertyName = uriOrRegex;
-        ghoul::lua::push(L, uriOrRegex);
-        ghoul::lua::push(L, 0.0);
+        _profilePropertyName = entry.uriOrRegex;
 
         std::string workingValue = prop.value;
         ghoul::trimSurroundingCharacters(workingValue, ' ');
-        // Later functions expect the value to be at the last position on the stack
         propertyPushProfileValueToLua(L, workingValue);
+        if (lua_gettop(L) == valuesIndex) {
+            // The value could not be converted, which has already been reported
+            lua_pushnil(L);
+        }
+        entry.luaType = lua_type(L, -1);
+        lua_rawseti(L, valuesIndex, static_cast<int>(entries.size() + 1));
+
+        const bool isLiteral = groupName.empty() &&
+            entry.uriOrRegex.find('*') == std::string::npos;
+        if (isLiteral) {
+            properties::Property* match =
+                global::rootPropertyOwner->property(entry.uriOrRegex);
+            if (match) {
+                entry.matches.push_back(match);
+            }
+        }
+        else {
+            entry.matcher = PropertyMatcher(entry.uriOrRegex, std::move(groupName));
+            if (entry.matcher->isValid) {
+                wildcardEntries.push_back(entries.size());
+            }
+        }
+        entries.push_back(std::move(entry));
+    }
 
-        applyRegularExpression(
-            L,
-            uriOrRegex,
-            allProperties(),
-            0.0,
-            groupName,
-            ghoul::EasingFunction::Linear,
-            ""
+    // All wildcard and tag entries are matched in a single pass over the property tree,
+    // in which the URI of each property is only assembled once
+    if (!wildcardEntries.empty()) {
+        forEachPropertyWithUri(
+            *global::rootPropertyOwner,
+            [&entries, &wildcardEntries](properties::Property* prop,
+                                         const std::string& uri)
+            {
+                for (const size_t i : wildcardEntries) {
+                    if (entries[i].matcher->matches(prop, uri)) {
+                        entries[i].matches.push_back(prop);
+                    }
+                }
+            }
         );
-        // Clear lua state stack
-        lua_settop(L, 0);
+    }
+
+    // If multiple entries set the same property, only the last one is applied to it as
+    // it would overwrite the values of all previous entries anyway
+    std::unordered_map<properties::Property*, size_t> lastEntries;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const Entry& entry = entries[i];
+
+        // Stores whether we found at least one matching property. If this is false at
+        // the end of the loop, the property name regex was probably misspelled
+        bool foundMatching = false;
+        for (properties::Property* prop : entry.matches) {
+            if (entry.luaType != prop->typeLua()) {
+                LERROR(std::format(
+                    "Property '{}' does not accept input of type '{}'. Requested type: "
+                    "{}",
+                    prop->uri(), ghoul::lua::luaTypeToString(entry.luaType),
+                    ghoul::lua::luaTypeToString(prop->typeLua())
+                ));
+            }
+            else {
+                foundMatching = true;
+                lastEntries[prop] = i;
+            }
+        }
+
+        if (!foundMatching) {
+            LERROR(std::format(
+                "No property matched the requested URI '{}'", entry.uriOrRegex
+            ));
+        }
+    }
+
+    // Profiles can set a large number of properties, so the objects that depend on them
+    // are only informed once all values have been set
+    const properties::Property::ChangeBatch batch;
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        for (properties::Property* prop : entries[i].matches) {
+            const auto it = lastEntries.find(prop);
+            if (it == lastEntries.end() || it->second != i) {
+                continue;
+            }
+
+            if (global::sessionRecordingHandler->isRecording()) {
+                global::sessionRecordingHandler->savePropertyBaseline(*prop);
+            }
+            removePropertyInterpolation(prop);
+            lua_rawgeti(L, valuesIndex, static_cast<int>(i + 1));
+            prop->setLuaValue(L);
+            lua_settop(L, valuesIndex);
+        }
     }
 }
 
@@ -775,9 +1195,51 @@ PropertyValueType Scene::propertyValueType(const std::string& value) {
 }
 
 std::vector<properties::Property*> Scene::propertiesMatchingRegex(
-                                                          std::string_view propertyString)
+                                                          std::string_view propertyString,
+                                                             const std::string& groupName)
 {
-    return findMatchesInAllProperties(propertyString, allProperties(), "");
+    // A literal URI can be resolved directly through the property tree
+    const bool isLiteral =
+        groupName.empty() && propertyString.find('*') == std::string_view::npos;
+    if (isLiteral) {
+        properties::Property* prop = global::rootPropertyOwner->property(propertyString);
+        return prop ? std::vector<properties::Property*>{ prop } :
+                      std::vector<properties::Property*>();
+    }
+
+    std::string key =
+        groupName.empty() ?
+        std::string(propertyString) :
+        std::format("{{{}}}{}", groupName, propertyString);
+
+    std::lock_guard lock(_propertyMatchCacheMutex);
+    const uint64_t generation = properties::PropertyOwner::structureGeneration();
+    if (_propertyMatchCacheGeneration != generation ||
+        _propertyMatchCache.size() >= MaxPropertyMatchCacheSize)
+    {
+        _propertyMatchCache.clear();
+        _propertyMatchCacheGeneration = generation;
+    }
+
+    auto it = _propertyMatchCache.find(key);
+    if (it != _propertyMatchCache.end()) {
+        return it->second;
+    }
+
+    const PropertyMatcher matcher = PropertyMatcher(propertyString, groupName);
+    if (!matcher.isValid) {
+        // Invalid patterns are not cached so that the error is reported every time
+        return std::vector<properties::Property*>();
+    }
+
+    std::vector<properties::Property*> matches;
+    for (properties::Property* prop : allProperties()) {
+        if (matcher.matches(prop)) {
+            matches.push_back(prop);
+        }
+    }
+    _propertyMatchCache[std::move(key)] = matches;
+    return matches;
 }
 
 std::vector<std::string> Scene::allTags() const {
@@ -876,6 +1338,8 @@ scripting::LuaLibrary Scene::luaLibrary() {
                 "Deprecated in favor of the 'propertyValue' function",
                 {}
             },
+            codegen::lua::BeginPropertyChangeBatch,
+            codegen::lua::EndPropertyChangeBatch,
             codegen::lua::HasProperty,
             codegen::lua::PropertyDeprecated,
             codegen::lua::Property,
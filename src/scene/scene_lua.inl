@@ -86,20 +86,31 @@ openspace::properties::PropertyOwner* findPropertyOwnerWithMatchingGroupTag(T* p
     return tagMatchOwner;
 }
 
-std::vector<openspace::properties::Property*> findMatchesInAllProperties(
-                                                                   std::string_view regex,
-                          const std::vector<openspace::properties::Property*>& properties,
-                                                             const std::string& groupName)
-{
-    using namespace openspace;
+// A property URI pattern that has been parsed once so that it can be matched against
+// any number of properties. A pattern is either a literal URI or contains a single '*'
+// that separates the node name from the property name. If a group name is provided, only
+// properties that have an owner with a matching tag are matched
+struct PropertyMatcher {
+    PropertyMatcher(std::string_view regex, std::string groupName_);
 
-    std::vector<properties::Property*> matches;
-    const bool isGroupMode = !groupName.empty();
-    bool isLiteral = false;
+    bool matches(openspace::properties::Property* prop) const;
 
-    // Extract the property and node name to be searched for from regex
+    // Same as above, but with \p uri being the already known URI of the \p prop
+    bool matches(openspace::properties::Property* prop, std::string_view uri) const;
+
+    bool isValid = true;
+    bool isGroupMode = false;
+    bool isLiteral = false;
     std::string propertyName;
     std::string nodeName;
+    std::string groupName;
+};
+
+PropertyMatcher::PropertyMatcher(std::string_view regex, std::string groupName_)
+    : isGroupMode(!groupName_.empty())
+    , groupName(std::move(groupName_))
+{
+    // Extract the property and node name to be searched for from regex
     size_t wildPos = regex.find_first_of("*");
     if (wildPos != std::string::npos) {
         nodeName = regex.substr(0, wildPos);
@@ -114,7 +125,8 @@ std::vector<openspace::properties::Property*> findMatchesInAllProperties(
                     regex
                 )
             );
-            return matches;
+            isValid = false;
+            return;
         }
 
         // Currently do not support several wildcards
@@ -126,7 +138,8 @@ std::vector<openspace::properties::Property*> findMatchesInAllProperties(
                     "supported", regex
                 )
             );
-            return matches;
+            isValid = false;
+            return;
         }
     }
     // Literal or tag
@@ -136,71 +149,98 @@ std::vector<openspace::properties::Property*> findMatchesInAllProperties(
             isLiteral = true;
         }
     }
+}
 
-    // Stores whether we found at least one matching property. If this is false at the end
-    // of the loop, the property name regex was probably misspelled.
-    for (properties::Property* prop : properties) {
-        // Check the regular expression for all properties
-        const std::string id = prop->uri();
+bool PropertyMatcher::matches(openspace::properties::Property* prop) const {
+    return matches(prop, prop->uri());
+}
 
-        if (isLiteral && id != propertyName) {
-            continue;
-        }
-        else if (!propertyName.empty()) {
-            size_t propertyPos = id.find(propertyName);
-            if (propertyPos != std::string::npos) {
-                // Check that the propertyName fully matches the property in id
-                if ((propertyPos + propertyName.length() + 1) < id.length()) {
-                    continue;
-                }
+bool PropertyMatcher::matches(openspace::properties::Property* prop,
+                              std::string_view id) const
+{
+    using namespace openspace;
 
-                // Match node name
-                if (!nodeName.empty() && id.find(nodeName) == std::string::npos) {
-                    continue;
-                }
+    if (!isValid) {
+        return false;
+    }
 
-                // Check tag
-                if (isGroupMode) {
-                    properties::PropertyOwner* matchingTaggedOwner =
-                        findPropertyOwnerWithMatchingGroupTag(prop, groupName);
-                    if (!matchingTaggedOwner) {
-                        continue;
-                    }
-                }
+    // Check the regular expression for the property
+    if (isLiteral && id != propertyName) {
+        return false;
+    }
+    else if (!propertyName.empty()) {
+        size_t propertyPos = id.find(propertyName);
+        if (propertyPos != std::string::npos) {
+            // Check that the propertyName fully matches the property in id
+            if ((propertyPos + propertyName.length() + 1) < id.length()) {
+                return false;
             }
-            else {
-                continue;
+
+            // Match node name
+            if (!nodeName.empty() && id.find(nodeName) == std::string::npos) {
+                return false;
             }
-        }
-        else if (!nodeName.empty()) {
-            size_t nodePos = id.find(nodeName);
-            if (nodePos != std::string::npos) {
-                // Check tag
-                if (isGroupMode) {
-                    properties::PropertyOwner* matchingTaggedOwner =
-                        findPropertyOwnerWithMatchingGroupTag(prop, groupName);
-                    if (!matchingTaggedOwner) {
-                        continue;
-                    }
+
+            // Check tag
+            if (isGroupMode) {
+                properties::PropertyOwner* matchingTaggedOwner =
+                    findPropertyOwnerWithMatchingGroupTag(prop, groupName);
+                if (!matchingTaggedOwner) {
+                    return false;
                 }
-                // Check that the nodeName fully matches the node in id
-                else if (nodePos != 0) {
-                    continue;
+            }
+        }
+        else {
+            return false;
+        }
+    }
+    else if (!nodeName.empty()) {
+        size_t nodePos = id.find(nodeName);
+        if (nodePos != std::string::npos) {
+            // Check tag
+            if (isGroupMode) {
+                properties::PropertyOwner* matchingTaggedOwner =
+                    findPropertyOwnerWithMatchingGroupTag(prop, groupName);
+                if (!matchingTaggedOwner) {
+                    return false;
                 }
             }
-            else {
-                continue;
+            // Check that the nodeName fully matches the node in id
+            else if (nodePos != 0) {
+                return false;
             }
         }
-        matches.push_back(prop);
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<openspace::properties::Property*> findMatchesInAllProperties(
+                                                                   std::string_view regex,
+                          const std::vector<openspace::properties::Property*>& properties,
+                                                             const std::string& groupName)
+{
+    using namespace openspace;
+
+    std::vector<properties::Property*> matches;
+    const PropertyMatcher matcher = PropertyMatcher(regex, groupName);
+    if (!matcher.isValid) {
+        return matches;
+    }
+
+    for (properties::Property* prop : properties) {
+        if (matcher.matches(prop)) {
+            matches.push_back(prop);
+        }
     }
     return matches;
 }
 
 void applyRegularExpression(lua_State* L, const std::string& regex,
-                          const std::vector<openspace::properties::Property*>& properties,
+                       const std::vector<openspace::properties::Property*>& matchingProps,
                                                              double interpolationDuration,
-                                                             const std::string& groupName,
                                                      ghoul::EasingFunction easingFunction,
                                                                    std::string postScript)
 {
@@ -210,12 +250,6 @@ void applyRegularExpression(lua_State* L, const std::string& regex,
 
     const int type = lua_type(L, -1);
 
-    std::vector<properties::Property*> matchingProps = findMatchesInAllProperties(
-        regex,
-        properties,
-        groupName
-    );
-
     // Stores whether we found at least one matching property. If this is false at the
     // end of the loop, the property name regex was probably misspelled.
     bool foundMatching = false;
@@ -438,12 +472,14 @@ int propertySetValue(lua_State* L) {
             uriOrRegex = removeGroupNameFromUri(uriOrRegex);
         }
 
+        Scene* scene = global::renderEngine->scene();
         applyRegularExpression(
             L,
             uriOrRegex,
-            allProperties(),
+            scene ?
+                scene->propertiesMatchingRegex(uriOrRegex, groupName) :
+                findMatchesInAllProperties(uriOrRegex, allProperties(), groupName),
             interpolationDuration,
-            groupName,
             easingMethod,
             std::move(postScript)
         );
@@ -486,6 +522,31 @@ int propertyGetValueDeprecated(lua_State* L) {
 
 namespace {
 
+/**
+ * Starts a batch of property changes. Until the matching `endPropertyChangeBatch` call,
+ * properties that are changed do not inform their listeners immediately. Instead, every
+ * changed property informs its listeners once when the batch ends, so that dependent
+ * objects only update once even if many properties were set. Batches can be nested, and
+ * batches that are still active when a script finishes are ended automatically.
+ */
+[[codegen::luawrap]] void beginPropertyChangeBatch() {
+    openspace::properties::Property::beginChangeBatch();
+}
+
+/**
+ * Ends the batch of property changes that was started by the last call to
+ * `beginPropertyChangeBatch`. If it was the outermost batch, all properties that changed
+ * during the batch inform their listeners.
+ */
+[[codegen::luawrap]] void endPropertyChangeBatch() {
+    using namespace openspace;
+
+    if (properties::Property::changeBatchDepth() == 0) {
+        throw ghoul::lua::LuaError("No batch of property changes is active");
+    }
+    properties::Property::endChangeBatch();
+}
+
 /**
  * Returns whether a property with the given URI exists
  */
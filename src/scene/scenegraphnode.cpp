@@ -40,6 +40,7 @@
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <limits>
 
 namespace {
     constexpr std::string_view _loggerCat = "SceneGraphNode";
@@ -203,6 +204,17 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo GpuTimeInfo = {
+        "GpuTime",
+        "GPU Time (ms)",
+        "The GPU time in milliseconds that the rendering of this scene graph node took "
+        "in all render bins of a recent frame. This value is only updated while the GPU "
+        "timing of the RenderEngine is enabled and is -1 if the node was not rendered. "
+        "If draw lists are used, only the part of the rendering that is not deferred to "
+        "the draw list is included.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     constexpr openspace::properties::Property::PropertyInfo
         SupportsDirectInteractionInfo =
     {
@@ -357,7 +369,11 @@ ghoul::mm_unique_ptr<SceneGraphNode> SceneGraphNode::createFromDictionary(
 
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
-    SceneGraphNode* n = global::memoryManager->PersistentMemory.alloc<SceneGraphNode>();
+    // The transform components are created below so that the node is followed by its
+    // own components in memory instead of by default components that are replaced
+    SceneGraphNode* n = global::memoryManager->SceneGraphMemory.alloc<SceneGraphNode>(
+        CreateDefaultTransform::No
+    );
     ghoul::mm_unique_ptr<SceneGraphNode> result = ghoul::mm_unique_ptr<SceneGraphNode>(n);
 
 #ifdef Debugging_Core_SceneGraphNode_Indices
@@ -433,6 +449,22 @@ ghoul::mm_unique_ptr<SceneGraphNode> SceneGraphNode::createFromDictionary(
             ));
         }
     }
+    ghoul::MemoryPool<4 * 1024 * 1024>& memory = global::memoryManager->SceneGraphMemory;
+    if (!result->_transform.translation) {
+        result->_transform.translation = ghoul::mm_unique_ptr<Translation>(
+            memory.alloc<StaticTranslation>()
+        );
+    }
+    if (!result->_transform.rotation) {
+        result->_transform.rotation = ghoul::mm_unique_ptr<Rotation>(
+            memory.alloc<StaticRotation>()
+        );
+    }
+    if (!result->_transform.scale) {
+        result->_transform.scale = ghoul::mm_unique_ptr<Scale>(
+            memory.alloc<StaticScale>()
+        );
+    }
     result->addPropertySubOwner(result->_transform.translation.get());
     result->addPropertySubOwner(result->_transform.rotation.get());
     result->addPropertySubOwner(result->_transform.scale.get());
@@ -532,7 +564,7 @@ documentation::Documentation SceneGraphNode::Documentation() {
 
 ghoul::opengl::ProgramObject* SceneGraphNode::_debugSphereProgram = nullptr;
 
-SceneGraphNode::SceneGraphNode()
+SceneGraphNode::SceneGraphNode(CreateDefaultTransform createDefaultTransform)
     : properties::PropertyOwner({ "" })
     , _guiHidden(GuiHiddenInfo, false)
     , _guiPath(GuiPathInfo, "/")
@@ -540,17 +572,6 @@ SceneGraphNode::SceneGraphNode()
     , _guiDescription(GuiDescriptionInfo)
     , _useGuiOrdering(UseGuiOrderInfo, false)
     , _guiOrderingNumber(GuiOrderInfo, 0.f)
-    , _transform {
-        ghoul::mm_unique_ptr<Translation>(
-            global::memoryManager->PersistentMemory.alloc<StaticTranslation>()
-        ),
-        ghoul::mm_unique_ptr<Rotation>(
-            global::memoryManager->PersistentMemory.alloc<StaticRotation>()
-        ),
-        ghoul::mm_unique_ptr<Scale>(
-            global::memoryManager->PersistentMemory.alloc<StaticScale>()
-        )
-    }
     , _boundingSphere(BoundingSphereInfo, -1.0, -1.0, 1e12)
     , _evaluatedBoundingSphere(EvalBoundingSphereInfo)
     , _interactionSphere(InteractionSphereInfo, -1.0, -1.0, 1e12)
@@ -565,7 +586,20 @@ SceneGraphNode::SceneGraphNode()
     , _visibilityDistance(VisibilityDistanceInfo, 6e10f)
     , _supportsDirectInteraction(SupportsDirectInteractionInfo, false)
     , _showDebugSphere(ShowDebugSphereInfo, false)
+    , _gpuTime(GpuTimeInfo, -1.f, -1.f, std::numeric_limits<float>::max())
 {
+    if (createDefaultTransform) {
+        ghoul::MemoryPool<4 * 1024 * 1024>& memory =
+            global::memoryManager->SceneGraphMemory;
+        _transform.translation = ghoul::mm_unique_ptr<Translation>(
+            memory.alloc<StaticTranslation>()
+        );
+        _transform.rotation = ghoul::mm_unique_ptr<Rotation>(
+            memory.alloc<StaticRotation>()
+        );
+        _transform.scale = ghoul::mm_unique_ptr<Scale>(memory.alloc<StaticScale>());
+    }
+
     addProperty(_computeScreenSpaceValues);
     addProperty(_screenSpacePosition);
     _screenVisibility.setReadOnly(true);
@@ -615,6 +649,9 @@ SceneGraphNode::SceneGraphNode()
 
     addProperty(_showDebugSphere);
 
+    _gpuTime.setReadOnly(true);
+    addProperty(_gpuTime);
+
     addProperty(_supportsDirectInteraction);
 
     addProperty(_guiDisplayName);
@@ -651,12 +688,13 @@ void SceneGraphNode::initialize() {
     if (_transform.scale) {
         _transform.scale->initialize();
     }
-    _state = State::Initialized;
-
     // Want this computed after the renderable and transforms have been initialized
     _evaluatedBoundingSphere = boundingSphere();
     _evaluatedInteractionSphere = interactionSphere();
 
+    // Set last as other threads might start using the node as soon as they see the state
+    _state = State::Initialized;
+
     LDEBUG(std::format("Finished initializing: {}", identifier()));
 }
 
@@ -742,55 +780,149 @@ void SceneGraphNode::traversePostOrder(const std::function<void(SceneGraphNode*)
     fn(this);
 }
 
+bool SceneGraphNode::supportsParallelUpdate() const {
+    if (!supportsParallelTransformUpdate()) {
+        return false;
+    }
+    if (_renderable && !_renderable->supportsParallelUpdate()) {
+        return false;
+    }
+    return true;
+}
+
+bool SceneGraphNode::supportsParallelTransformUpdate() const {
+    if (_transform.translation && !_transform.translation->supportsParallelUpdate()) {
+        return false;
+    }
+    if (_transform.rotation && !_transform.rotation->supportsParallelUpdate()) {
+        return false;
+    }
+    if (_transform.scale && !_transform.scale->supportsParallelUpdate()) {
+        return false;
+    }
+    return true;
+}
+
 void SceneGraphNode::update(const UpdateData& data) {
+    updateTransform(data);
+    publishTransform();
+    updateRenderable(data);
+}
+
+void SceneGraphNode::updateTransform(const UpdateData& data) {
     ZoneScoped;
     ZoneName(identifier().c_str(), identifier().size());
-#ifdef TRACY_ENABLE
-    TracyPlot("RAM", static_cast<int64_t>(global::openSpaceEngine->ramInUse()));
-    TracyPlot("VRAM", static_cast<int64_t>(global::openSpaceEngine->vramInUse()));
-#endif // TRACY_ENABLE
+
+    // The parent and the dependencies are always updated before this node, so their
+    // results for this frame are already available
+    WorldTransform& next = _nextWorldTransform;
+    next.isTimeFrameActive = !_timeFrame || _timeFrame->isActiveCached(data.time);
+    if (_parent && !_parent->_nextWorldTransform.isTimeFrameActive) {
+        next.isTimeFrameActive = false;
+    }
+    for (const SceneGraphNode* dep : _dependencies) {
+        if (!dep->_nextWorldTransform.isTimeFrameActive) {
+            next.isTimeFrameActive = false;
+            break;
+        }
+    }
 
     if (_state != State::Initialized && _state != State::GLInitialized) {
+        _isWorldTransformDirty = true;
         return;
     }
-    if (!isTimeFrameActive(data.time)) {
+    if (!next.isTimeFrameActive) {
+        // Our parent might change while we are inactive, so we have to recompute the
+        // world transform as soon as we become active again
+        _isWorldTransformDirty = true;
+        next.isCurrent = true;
         return;
     }
 
+    bool hasLocalTransformChanged = false;
     if (_transform.translation) {
         _transform.translation->update(data);
+        hasLocalTransformChanged |= _transform.translation->hasChanged();
     }
 
     if (_transform.rotation) {
         _transform.rotation->update(data);
+        hasLocalTransformChanged |= _transform.rotation->hasChanged();
     }
 
     if (_transform.scale) {
         _transform.scale->update(data);
+        hasLocalTransformChanged |= _transform.scale->hasChanged();
     }
-    UpdateData newUpdateData = data;
 
-    // Assumes _worldRotationCached and _worldScaleCached have been calculated for parent
-    _worldPositionCached = calculateWorldPosition();
-    _worldRotationCached = calculateWorldRotation();
-    _worldScaleCached = calculateWorldScale();
+    // The parent has always been updated before us, so its flag reflects this frame
+    const bool hasParentChanged = _parent && _parent->_hasWorldTransformChanged;
+    _hasWorldTransformChanged =
+        _isWorldTransformDirty || hasLocalTransformChanged || hasParentChanged;
+
+    if (_hasWorldTransformChanged) {
+        // Assumes the rotation and scale have been calculated for the parent
+        next.position = calculateWorldPosition();
+        next.rotation = calculateWorldRotation();
+        next.scale = calculateWorldScale();
+
+        const glm::dmat4 translation = glm::translate(glm::dmat4(1.0), next.position);
+        const glm::dmat4 rotation = glm::dmat4(next.rotation);
+        const glm::dmat4 scaling = glm::scale(glm::dmat4(1.0), next.scale);
+
+        next.modelTransform = translation * rotation * scaling;
+        _isWorldTransformDirty = false;
+    }
+    next.isCurrent = true;
+}
+
+bool SceneGraphNode::hasCurrentTransform() const {
+    return _nextWorldTransform.isCurrent;
+}
 
+void SceneGraphNode::publishTransform() {
+    _nextWorldTransform.isCurrent = false;
+
+    _isTimeFrameActive = _nextWorldTransform.isTimeFrameActive;
+    _worldPositionCached = _nextWorldTransform.position;
+    _worldRotationCached = _nextWorldTransform.rotation;
+    _worldScaleCached = _nextWorldTransform.scale;
+    _modelTransformCached = _nextWorldTransform.modelTransform;
+
+    // The surface below a position may change from frame to frame, for example when new
+    // height tiles have been loaded or the interaction sphere has changed
+    std::lock_guard lock(_surfaceHandleCacheMutex);
+    if (_surfaceHandleCache.has_value()) {
+        _surfaceHandleCache->isCurrent = false;
+    }
+}
+
+void SceneGraphNode::updateRenderable(const UpdateData& data) {
+    ZoneScoped;
+    ZoneName(identifier().c_str(), identifier().size());
+#ifdef TRACY_ENABLE
+    TracyPlot("RAM", static_cast<int64_t>(global::openSpaceEngine->ramInUse()));
+    TracyPlot("VRAM", static_cast<int64_t>(global::openSpaceEngine->vramInUse()));
+#endif // TRACY_ENABLE
+
+    if (_state != State::Initialized && _state != State::GLInitialized) {
+        return;
+    }
+    if (!_isTimeFrameActive) {
+        return;
+    }
+
+    UpdateData newUpdateData = data;
     newUpdateData.modelTransform.translation = _worldPositionCached;
     newUpdateData.modelTransform.rotation = _worldRotationCached;
     newUpdateData.modelTransform.scale = _worldScaleCached;
 
-    const glm::dmat4 translation = glm::translate(
-        glm::dmat4(1.0),
-        newUpdateData.modelTransform.translation
-    );
-    const glm::dmat4 rotation = glm::dmat4(newUpdateData.modelTransform.rotation);
-    const glm::dmat4 scaling =
-        glm::scale(glm::dmat4(1.0), newUpdateData.modelTransform.scale);
-
-    _modelTransformCached = translation * rotation * scaling;
+    const bool wasRendered = _wasRenderedSinceUpdate;
+    _wasRenderedSinceUpdate = false;
 
     if (_renderable && _renderable->isReady() &&
-        (_renderable->isEnabled() || _renderable->shouldUpdateIfDisabled()))
+        (_renderable->isEnabled() || _renderable->shouldUpdateIfDisabled()) &&
+        _renderable->needsUpdate(newUpdateData, wasRendered))
     {
         _renderable->update(newUpdateData);
     }
@@ -815,12 +947,13 @@ void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
         return;
     }
 
-    if (!isTimeFrameActive(data.time)) {
+    if (!_isTimeFrameActive) {
         return;
     }
 
     RenderData newData = {
         .camera = data.camera,
+        .cameraSnapshot = data.cameraSnapshot,
         .time = data.time,
         .renderBinMask = data.renderBinMask,
         .modelTransform = {
@@ -830,15 +963,33 @@ void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
         }
     };
 
+    GpuTimerPool& timers = global::renderEngine->gpuTimerPool();
+    if (timers.isEnabled()) {
+        const float gpuTime = timers.time(identifier());
+        if (gpuTime != _gpuTime) {
+            _gpuTime = gpuTime;
+        }
+    }
+
+    if (_renderable->matchesSecondaryRenderBin(data.renderBinMask) ||
+        _renderable->matchesRenderBinMask(data.renderBinMask))
+    {
+        _wasRenderedSinceUpdate = true;
+    }
+
     if (_renderable->matchesSecondaryRenderBin(data.renderBinMask)) {
         TracyGpuZone("Render Secondary Bin")
+        const GpuTimerPool::Scope timer(timers, identifier());
         _renderable->renderSecondary(newData, tasks);
     }
 
     if (_renderable->matchesRenderBinMask(data.renderBinMask)) {
         TracyGpuZone("Render")
 
-        _renderable->render(newData, tasks);
+        {
+            const GpuTimerPool::Scope timer(timers, identifier());
+            _renderable->render(newData, tasks);
+        }
 
         if (_computeScreenSpaceValues) {
             computeScreenSpaceData(newData);
@@ -859,6 +1010,48 @@ void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
     }
 }
 
+int SceneGraphNode::visibleRenderBins(
+                                  const std::array<glm::dvec4, 4>& frustumPlanes) const
+{
+    if (_state != State::GLInitialized || !_renderable || !_renderable->isVisible() ||
+        !_renderable->isReady() || !_isTimeFrameActive)
+    {
+        return 0;
+    }
+
+    int bins = 0;
+    constexpr int LastBin = static_cast<int>(Renderable::RenderBin::Sticker);
+    for (int bin = 1; bin <= LastBin; bin <<= 1) {
+        if (_renderable->matchesRenderBinMask(bin) ||
+            _renderable->matchesSecondaryRenderBin(bin))
+        {
+            bins |= bin;
+        }
+    }
+    if (_showDebugSphere) {
+        bins |= static_cast<int>(Renderable::RenderBin::Sticker);
+    }
+
+    double radius = _overrideBoundingSphere.value_or(_renderable->boundingSphere());
+    if (_showDebugSphere) {
+        radius = std::max(
+            radius,
+            _overrideInteractionSphere.value_or(_renderable->interactionSphere())
+        );
+    }
+    if (radius <= 0.0) {
+        return bins;
+    }
+    radius *= glm::compMax(_worldScaleCached);
+
+    for (const glm::dvec4& plane : frustumPlanes) {
+        if (glm::dot(glm::dvec3(plane), _worldPositionCached) + plane.w < -radius) {
+            return 0;
+        }
+    }
+    return bins;
+}
+
 void SceneGraphNode::renderDebugSphere(const Camera& camera, double size,
                                        const glm::vec4& color)
 {
@@ -910,6 +1103,7 @@ void SceneGraphNode::attachChild(ghoul::mm_unique_ptr<SceneGraphNode> child) {
 
     // Create link between parent and child
     child->_parent = this;
+    child->_isWorldTransformDirty = true;
     SceneGraphNode* childRaw = child.get();
     _children.push_back(std::move(child));
 
@@ -1034,10 +1228,10 @@ void SceneGraphNode::computeScreenSpaceData(RenderData& newData) {
     _lastScreenSpaceUpdateTime = now;
 
     // Calculate ndc
-    const Camera& cam = newData.camera;
+    const CameraSnapshot& cam = newData.cameraSnapshot;
     const glm::dvec3& worldPos = _worldPositionCached;
-    const glm::dvec4 clipSpace = glm::dmat4(cam.projectionMatrix()) *
-                                 cam.combinedViewMatrix() * glm::vec4(worldPos, 1.0);
+    const glm::dvec4 clipSpace =
+        cam.combinedViewProjectionMatrix * glm::dvec4(worldPos, 1.0);
     const glm::dvec2 worldPosNDC = glm::dvec2(clipSpace / clipSpace.w);
 
     const bool visible = worldPosNDC.x >= -1.0 && worldPosNDC.x <= 1.0 &&
@@ -1056,7 +1250,7 @@ void SceneGraphNode::computeScreenSpaceData(RenderData& newData) {
 
     // Distance from the camera to the node
     const double distFromCamToNode =
-        glm::distance(cam.positionVec3(), worldPos) - nodeRadius;
+        glm::distance(cam.position, worldPos) - nodeRadius;
 
     // Fix to limit the update of properties
     if (distFromCamToNode >= _visibilityDistance) {
@@ -1067,10 +1261,10 @@ void SceneGraphNode::computeScreenSpaceData(RenderData& newData) {
     _screenVisibility = true;
 
     // Calculate the node radius to screensize pixels
-    const glm::dvec3 lookUp = normalize(cam.lookUpVectorWorldSpace());
+    const glm::dvec3 lookUp = normalize(cam.lookUpVectorWorldSpace);
     const glm::dvec3 radiusPos = worldPos + (nodeRadius * lookUp);
-    const glm::dvec4 clipSpaceRadius = glm::dmat4(cam.projectionMatrix()) *
-                                    cam.combinedViewMatrix() * glm::vec4(radiusPos, 1.0);
+    const glm::dvec4 clipSpaceRadius =
+        cam.combinedViewProjectionMatrix * glm::dvec4(radiusPos, 1.0);
     const glm::dvec3 radiusNDC = clipSpaceRadius / clipSpaceRadius.w;
 
     const glm::ivec2 centerScreenSpace = glm::ivec2(
@@ -1106,21 +1300,59 @@ void SceneGraphNode::computeScreenSpaceData(RenderData& newData) {
 }
 
 SurfacePositionHandle SceneGraphNode::calculateSurfacePositionHandle(
-                                                 const glm::dvec3& targetModelSpace) const
+                                                 const glm::dvec3& targetModelSpace,
+                                                        double directionTolerance) const
 {
     ghoul_assert(glm::length(targetModelSpace) > 0.0, "Cannot have degenerate vector");
 
+    const glm::dvec3 directionFromCenterToTarget = glm::normalize(targetModelSpace);
+
+    std::lock_guard lock(_surfaceHandleCacheMutex);
+    if (_surfaceHandleCache.has_value()) {
+        const SurfacePositionHandle cached = {
+            _surfaceHandleCache->centerToReferenceSurface,
+            _surfaceHandleCache->referenceSurfaceOutDirection,
+            _surfaceHandleCache->heightToSurface
+        };
+
+        if (_surfaceHandleCache->isCurrent &&
+            _surfaceHandleCache->target == targetModelSpace)
+        {
+            return cached;
+        }
+
+        if (directionTolerance > 0.0) {
+            const double cosAngle = glm::dot(
+                _surfaceHandleCache->direction,
+                directionFromCenterToTarget
+            );
+            if (cosAngle >= std::cos(directionTolerance)) {
+                return cached;
+            }
+        }
+    }
+
+    SurfacePositionHandle handle;
     if (_renderable) {
-        return _renderable->calculateSurfacePositionHandle(targetModelSpace);
+        handle = _renderable->calculateSurfacePositionHandle(targetModelSpace);
     }
     else {
-        const glm::dvec3 directionFromCenterToTarget = glm::normalize(targetModelSpace);
-        return {
+        handle = {
             directionFromCenterToTarget * interactionSphere(),
             directionFromCenterToTarget,
             0.0
         };
     }
+
+    _surfaceHandleCache = SurfaceHandleCache {
+        .target = targetModelSpace,
+        .direction = directionFromCenterToTarget,
+        .centerToReferenceSurface = handle.centerToReferenceSurface,
+        .referenceSurfaceOutDirection = handle.referenceSurfaceOutDirection,
+        .heightToSurface = handle.heightToSurface,
+        .isCurrent = true
+    };
+    return handle;
 }
 
 const std::vector<SceneGraphNode*>& SceneGraphNode::dependencies() const {
@@ -1174,9 +1406,9 @@ void SceneGraphNode::setGuiHintHidden(bool value) {
 glm::dvec3 SceneGraphNode::calculateWorldPosition() const {
     // recursive up the hierarchy if there are parents available
     if (_parent) {
-        const glm::dvec3 wp = _parent->worldPosition();
-        const glm::dmat3 wrot = _parent->worldRotationMatrix();
-        const glm::dvec3 ws = _parent->worldScale();
+        const glm::dvec3 wp = _parent->_nextWorldTransform.position;
+        const glm::dmat3 wrot = _parent->_nextWorldTransform.rotation;
+        const glm::dvec3 ws = _parent->_nextWorldTransform.scale;
         const glm::dvec3 p = position();
 
         return wp + wrot * (ws * p);
@@ -1200,10 +1432,14 @@ bool SceneGraphNode::isTimeFrameActive(const Time& time) const {
     return !_timeFrame || _timeFrame->isActive(time);
 }
 
+bool SceneGraphNode::isTimeFrameActive() const {
+    return _isTimeFrameActive;
+}
+
 glm::dmat3 SceneGraphNode::calculateWorldRotation() const {
     // recursive up the hierarchy if there are parents available
     if (_parent) {
-        return _parent->worldRotationMatrix() * rotationMatrix();
+        return _parent->_nextWorldTransform.rotation * rotationMatrix();
     }
     else {
         return rotationMatrix();
@@ -1213,7 +1449,7 @@ glm::dmat3 SceneGraphNode::calculateWorldRotation() const {
 glm::dvec3 SceneGraphNode::calculateWorldScale() const {
     // recursive up the hierarchy if there are parents available
     if (_parent) {
-        return _parent->worldScale() * scale();
+        return _parent->_nextWorldTransform.scale * scale();
     }
     else {
         return scale();
@@ -28,6 +28,7 @@
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/rendering/loadingscreen.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/logging/logmanager.h>
 
 namespace openspace {
@@ -46,9 +47,12 @@ bool SingleThreadedSceneInitializer::isInitializing() const {
     return false;
 }
 
-MultiThreadedSceneInitializer::MultiThreadedSceneInitializer(unsigned int nThreads)
-    : _threadPool(nThreads)
-{}
+MultiThreadedSceneInitializer::~MultiThreadedSceneInitializer() {
+    // The tasks in the thread pool reference this object, so we can't leave before all
+    // of them are finished
+    std::unique_lock lock(_mutex);
+    _initializingNodesEmpty.wait(lock, [this]() { return _initializingNodes.empty(); });
+}
 
 void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
     ZoneScoped;
@@ -75,10 +79,6 @@ void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
         catch (const ghoul::RuntimeError& e) {
             LERRORC(e.component, e.message);
         }
-        const std::lock_guard g(_mutex);
-        _initializedNodes.push_back(node);
-        _initializingNodes.erase(node);
-
         if (loadingScreen) {
             loadingScreen->updateItem(
                 node->identifier(),
@@ -87,6 +87,15 @@ void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
                 progressInfo
             );
         }
+
+        // This has to be the last access to `this` as the destructor might be waiting
+        // for the last node to finish
+        const std::lock_guard g(_mutex);
+        _initializedNodes.push_back(node);
+        _initializingNodes.erase(node);
+        if (_initializingNodes.empty()) {
+            _initializingNodesEmpty.notify_all();
+        }
     };
 
     LoadingScreen::ProgressInfo progressInfo;
@@ -102,19 +111,17 @@ void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
         );
     }
 
-    const std::lock_guard g(_mutex);
-    _initializingNodes.insert(node);
-    _threadPool.enqueue(initFunction);
+    {
+        const std::lock_guard g(_mutex);
+        _initializingNodes.insert(node);
+    }
+    global::threadPool->enqueue(std::move(initFunction));
 }
 
 std::vector<SceneGraphNode*> MultiThreadedSceneInitializer::takeInitializedNodes() {
-    // Some of the scene graph nodes might still be in the initialization queue and we
-    // should wait for those to finish or we end up in some half-initialized state since
-    // other parts of the application already know about their existence
-    while (_threadPool.hasOutstandingTasks()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-    }
-
+    // Nodes that are still initializing are not returned here. They are skipped by the
+    // update and render passes until their state changes, so we don't have to wait for
+    // them and can hand out the finished ones right away
     const std::lock_guard g(_mutex);
     std::vector<SceneGraphNode*> nodes = std::move(_initializedNodes);
     return nodes;
@@ -29,6 +29,7 @@
 #include <openspace/engine/globals.h>
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/memorymanager.h>
+#include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
@@ -46,6 +47,9 @@ namespace {
 
 namespace openspace {
 
+// Starts at 1 so that no time frame has a valid cached activity initially
+std::atomic<uint64_t> TimeFrame::_cacheGeneration = 1;
+
 documentation::Documentation TimeFrame::Documentation() {
     return codegen::doc<Parameters>("core_time_frame");
 }
@@ -57,7 +61,11 @@ ghoul::mm_unique_ptr<TimeFrame> TimeFrame::createFromDictionary(
 
     const Parameters p = codegen::bake<Parameters>(dict);
 
-    TimeFrame* result = FactoryManager::ref().factory<TimeFrame>()->create(p.type, dict);
+    TimeFrame* result = FactoryManager::ref().factory<TimeFrame>()->create(
+        p.type,
+        dict,
+        &global::memoryManager->SceneGraphMemory
+    );
     result->setIdentifier("TimeFrame");
     result->_type = p.type;
 
@@ -70,4 +78,28 @@ bool TimeFrame::initialize() {
     return true;
 }
 
+TimeFrame::Activity TimeFrame::activity(double time) const {
+    return {
+        .isActive = isActive(Time(time)),
+        .validFrom = time,
+        .validUntil = time
+    };
+}
+
+bool TimeFrame::isActiveCached(const Time& time) const {
+    const double t = time.j2000Seconds();
+    const uint64_t generation = _cacheGeneration;
+    if (_cachedGeneration != generation || t < _cachedActivity.validFrom ||
+        t >= _cachedActivity.validUntil)
+    {
+        _cachedActivity = activity(t);
+        _cachedGeneration = generation;
+    }
+    return _cachedActivity.isActive;
+}
+
+void TimeFrame::invalidateCaches() {
+    _cacheGeneration++;
+}
+
 } // namespace openspace
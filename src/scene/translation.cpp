@@ -28,6 +28,7 @@
 #include <openspace/engine/globals.h>
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/memorymanager.h>
+#include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
@@ -59,7 +60,7 @@ ghoul::mm_unique_ptr<Translation> Translation::createFromDictionary(
     Translation* result = FactoryManager::ref().factory<Translation>()->create(
         p.type,
         dictionary,
-        &global::memoryManager->PersistentMemory
+        &global::memoryManager->SceneGraphMemory
     );
     result->_type = p.type;
     return ghoul::mm_unique_ptr<Translation>(result);
@@ -75,18 +76,46 @@ void Translation::update(const UpdateData& data) {
     ZoneScoped;
 
     if (!_needsUpdate && data.time.j2000Seconds() == _cachedTime) {
+        _hasChanged = false;
         return;
     }
     const glm::dvec3 oldPosition = _cachedPosition;
     _cachedPosition = position(data);
     _cachedTime = data.time.j2000Seconds();
     _needsUpdate = false;
+    _hasChanged = oldPosition != _cachedPosition;
 
-    if (oldPosition != _cachedPosition) {
+    if (_hasChanged) {
         notifyObservers();
     }
 }
 
+void Translation::positions(std::span<const double> times,
+                            std::span<glm::dvec3> result) const
+{
+    ghoul_assert(times.size() == result.size(), "Times and results must have same size");
+
+    for (size_t i = 0; i < times.size(); i++) {
+        result[i] = position({ {}, Time(times[i]), Time(0.0) });
+    }
+}
+
+bool Translation::hasChanged() const {
+    return _hasChanged;
+}
+
+Translation::PositionsFunction Translation::positionsSnapshot() const {
+    return PositionsFunction();
+}
+
+std::vector<std::filesystem::path> Translation::sourceFiles() const {
+    return {};
+}
+
+bool Translation::supportsParallelUpdate() const {
+    return false;
+}
+
 glm::dvec3 Translation::position() const {
     return _cachedPosition;
 }
@@ -31,12 +31,14 @@
 #include <openspace/interaction/sessionrecording.h>
 #include <openspace/interaction/sessionrecordinghandler.h>
 #include <openspace/network/parallelpeer.h>
+#include <openspace/properties/property.h>
 #include <openspace/util/syncbuffer.h>
 #include <openspace/documentation/documentation.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/lua_helper.h>
+#include <ghoul/misc/defer.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/ext/assimp/contrib/zip/src/zip.h>
 #include <filesystem>
@@ -104,7 +106,9 @@ void ScriptEngine::initialize() {
 void ScriptEngine::deinitialize() {
     ZoneScoped;
 
+    clearCompiledScripts();
     _registeredLibraries.clear();
+    _luaFunctionIndex.clear();
     for (const RepeatedScriptInfo& info : _repeatedScripts) {
         if (info.postScript.empty()) {
             queueScript(info.postScript);
@@ -158,6 +162,9 @@ void ScriptEngine::addLibrary(LuaLibrary library) {
 
     // If not, we can add it after we sorted it
     std::sort(library.functions.begin(), library.functions.end(), sortFunc);
+    for (const std::string& function : luaFunctions(library, "openspace.")) {
+        _luaFunctionIndex.insert(function);
+    }
     _registeredLibraries.push_back(std::move(library));
     std::sort(_registeredLibraries.begin(), _registeredLibraries.end());
 }
@@ -199,6 +206,15 @@ bool ScriptEngine::runScript(const Script& script) {
         }
     }
 
+    // End all batches of property changes that the script started but did not end, even
+    // if the script failed before it reached the end of the batch
+    const int batchDepth = properties::Property::changeBatchDepth();
+    defer {
+        while (properties::Property::changeBatchDepth() > batchDepth) {
+            properties::Property::endChangeBatch();
+        }
+    };
+
     try {
         if (script.callback) {
             ghoul::Dictionary returnValue =
@@ -206,7 +222,7 @@ bool ScriptEngine::runScript(const Script& script) {
             script.callback(std::move(returnValue));
         }
         else {
-            ghoul::lua::runScript(_state, script.code);
+            runCompiledScript(script.code);
         }
     }
     catch (const ghoul::lua::LuaLoadingException& e) {
@@ -242,6 +258,60 @@ bool ScriptEngine::runScript(const Script& script) {
     return true;
 }
 
+void ScriptEngine::runCompiledScript(const std::string& code) {
+    ZoneScoped;
+
+    const int top = lua_gettop(_state);
+    defer { lua_settop(_state, top); };
+
+    auto it = _compiledScriptIndex.find(code);
+    if (it != _compiledScriptIndex.end()) {
+        // Move the script to the front as it is now the most recently used one
+        _compiledScripts.splice(_compiledScripts.begin(), _compiledScripts, it->second);
+        lua_rawgeti(_state, LUA_REGISTRYINDEX, it->second->second);
+    }
+    else {
+        const int status =
+            luaL_loadbuffer(_state, code.data(), code.size(), code.c_str());
+        if (status != LUA_OK) {
+            throw ghoul::lua::LuaRuntimeException(std::format(
+                "Error loading script: {}", lua_tostring(_state, -1)
+            ));
+        }
+
+        // Long scripts are usually one-offs that would only push the frequently used
+        // scripts out of the cache
+        if (code.size() <= MaxCompiledScriptLength) {
+            if (_compiledScripts.size() >= MaxCompiledScripts) {
+                const std::pair<std::string, int>& lru = _compiledScripts.back();
+                luaL_unref(_state, LUA_REGISTRYINDEX, lru.second);
+                _compiledScriptIndex.erase(lru.first);
+                _compiledScripts.pop_back();
+            }
+
+            lua_pushvalue(_state, -1);
+            const int reference = luaL_ref(_state, LUA_REGISTRYINDEX);
+            _compiledScripts.emplace_front(code, reference);
+            _compiledScriptIndex[_compiledScripts.front().first] =
+                _compiledScripts.begin();
+        }
+    }
+
+    if (lua_pcall(_state, 0, 0, 0) != LUA_OK) {
+        throw ghoul::lua::LuaRuntimeException(std::format(
+            "Error executing script: {}", lua_tostring(_state, -1)
+        ));
+    }
+}
+
+void ScriptEngine::clearCompiledScripts() {
+    for (const std::pair<std::string, int>& script : _compiledScripts) {
+        luaL_unref(_state, LUA_REGISTRYINDEX, script.second);
+    }
+    _compiledScriptIndex.clear();
+    _compiledScripts.clear();
+}
+
 bool ScriptEngine::isLibraryNameAllowed(lua_State* state, const std::string& name) {
     bool result = false;
     lua_getglobal(state, OpenSpaceLibraryName.data());
@@ -415,6 +485,12 @@ bool ScriptEngine::registerLuaLibrary(lua_State* state, LuaLibrary& library) {
     }
 
     lua_settop(state, top);
+
+    // The functions that are defined in the scripts of the library are only known after
+    // they have been added to the state
+    for (const std::string& function : luaFunctions(library, "openspace.")) {
+        _luaFunctionIndex.insert(function);
+    }
     return true;
 }
 
@@ -433,6 +509,10 @@ const std::vector<LuaLibrary>& ScriptEngine::allLuaLibraries() const {
     return _registeredLibraries;
 }
 
+const PrefixTrie& ScriptEngine::luaFunctionIndex() const {
+    return _luaFunctionIndex;
+}
+
 void ScriptEngine::writeLog(const std::string& script) {
     ZoneScoped;
 
@@ -30,6 +30,8 @@
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/util/time.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <iterator>
 
 #include "scriptscheduler_lua.inl"
 
@@ -110,31 +112,28 @@ ScriptScheduler::ScheduledScript::ScheduledScript(const ghoul::Dictionary& dict)
 void ScriptScheduler::loadScripts(std::vector<ScheduledScript> scheduledScripts) {
     // Sort scripts by time; use a stable_sort as the user might have had an intention
     // specifying multiple scripts for the same time in a specific order
-    std::stable_sort(
-        scheduledScripts.begin(),
-        scheduledScripts.end(),
-        [](const ScheduledScript& lhs, const ScheduledScript& rhs) {
-            return lhs.time < rhs.time;
-        }
-    );
+    auto compare = [](const ScheduledScript& lhs, const ScheduledScript& rhs) {
+        return lhs.time < rhs.time;
+    };
+    std::stable_sort(scheduledScripts.begin(), scheduledScripts.end(), compare);
 
-    for (ScheduledScript& script : scheduledScripts) {
-        _scripts.push_back(std::move(script));
-    }
+    const ptrdiff_t nExisting = static_cast<ptrdiff_t>(_scripts.size());
+    _scripts.insert(
+        _scripts.end(),
+        std::make_move_iterator(scheduledScripts.begin()),
+        std::make_move_iterator(scheduledScripts.end())
+    );
 
-    // Re-sort so it is always in sorted order in regards to time
-    std::stable_sort(
+    // Merge the two sorted ranges so it is always in sorted order in regards to time.
+    // The merge is stable, so already loaded scripts stay in front of new scripts that
+    // are scheduled for the same time
+    std::inplace_merge(
         _scripts.begin(),
+        _scripts.begin() + nExisting,
         _scripts.end(),
-        [](const ScheduledScript& lhs, const ScheduledScript& rhs) {
-            return lhs.time < rhs.time;
-        }
+        compare
     );
-
-    // Ensure _currentIndex and _currentTime is accurate after new scripts was added
-    const double lastTime = _currentTime;
-    rewind();
-    progressTo(lastTime);
+    updateTimes();
 }
 
 void ScriptScheduler::rewind() {
@@ -144,104 +143,93 @@ void ScriptScheduler::rewind() {
 
 void ScriptScheduler::clearSchedule(std::optional<int> group) {
     if (group.has_value()) {
-        for (auto it = _scripts.begin(); it < _scripts.end();) {
-            if (it->group == *group) {
-                it = _scripts.erase(it);
-            }
-            else {
-                it++;
-            }
-        }
-
-        // Ensure _currentIndex and _currentTime is accurate after scripts was removed
-        const double lastTime = _currentTime;
-        rewind();
-        progressTo(lastTime);
+        std::erase_if(
+            _scripts,
+            [g = *group](const ScheduledScript& script) { return script.group == g; }
+        );
+        updateTimes();
     }
     else {
         rewind();
         _scripts.clear();
+        _times.clear();
     }
 }
 
-std::vector<std::string> ScriptScheduler::progressTo(double newTime) {
-    std::vector<std::string> result;
-    if (!_enabled || newTime == _currentTime || _scripts.empty()) {
-        // Update the new time
-        _currentTime = newTime;
-        return result;
+void ScriptScheduler::updateTimes() {
+    _times.clear();
+    _times.reserve(_scripts.size());
+    for (const ScheduledScript& script : _scripts) {
+        _times.push_back(script.time);
     }
 
+    // Ensure _currentIndex is accurate after scripts were added or removed. This is the
+    // same position that a forward progression from the beginning would end up in
+    const auto it = std::upper_bound(_times.begin(), _times.end(), _currentTime);
+    _currentIndex = static_cast<size_t>(std::distance(_times.begin(), it));
+}
+
+std::pair<size_t, size_t> ScriptScheduler::advanceTo(double newTime) {
+    const size_t prevIndex = _currentIndex;
     if (newTime > _currentTime) {
-        // Moving forward in time; we need to find the highest entry in the timings
-        // vector that is still smaller than the newTime
-        const size_t prevIndex = _currentIndex;
+        // Moving forward in time; we need to find the first entry that is bigger than
+        // the newTime. We only need to start searching at the previous time
         const auto it = std::upper_bound(
-            _scripts.begin() + prevIndex, // We only need to start at the previous time
-            _scripts.end(),
-            newTime,
-            [](const double value, const ScheduledScript& item) {
-                return value < item.time;
-            }
-         );
-
-        // How many values did we pass over?
-        const ptrdiff_t n = std::distance(_scripts.begin() + prevIndex, it);
-        _currentIndex = static_cast<int>(prevIndex + n);
-
-        // Update the new time
-        _currentTime = newTime;
-
-        // Construct result
-        for (auto iter = _scripts.begin() + prevIndex;
-            iter < (_scripts.begin() + _currentIndex);
-            iter++)
-        {
-            std::string script = iter->universalScript.empty() ?
-                iter->forwardScript :
-                iter->universalScript + "; " + iter->forwardScript;
-            result.push_back(std::move(script));
-        }
-
-        return result;
+            _times.begin() + prevIndex,
+            _times.end(),
+            newTime
+        );
+        _currentIndex = static_cast<size_t>(std::distance(_times.begin(), it));
     }
     else {
-        // Moving backward in time; the need to find the lowest entry that is still bigger
-        // than the newTime
-        const size_t prevIndex = _currentIndex;
+        // Moving backward in time; we need to find the lowest entry that is still bigger
+        // than or equal to the newTime. We can stop at the previous time
         const auto it = std::lower_bound(
-            _scripts.begin(),
-            _scripts.begin() + prevIndex, // We can stop at the previous time
-            newTime,
-            [](const ScheduledScript& item, const double value) {
-                return item.time < value;
-            }
+            _times.begin(),
+            _times.begin() + prevIndex,
+            newTime
         );
+        _currentIndex = static_cast<size_t>(std::distance(_times.begin(), it));
+    }
 
-        // How many values did we pass over?
-        const ptrdiff_t n = std::distance(it, _scripts.begin() + prevIndex);
-        _currentIndex = static_cast<int>(prevIndex - n);
+    // Update the new time
+    _currentTime = newTime;
+    return { prevIndex, _currentIndex };
+}
 
+std::vector<std::string> ScriptScheduler::progressTo(double newTime) {
+    std::vector<std::string> result;
+    if (!_enabled || newTime == _currentTime || _scripts.empty()) {
         // Update the new time
         _currentTime = newTime;
+        return result;
+    }
 
-        // Construct result
-        const size_t startOffset = prevIndex == 0 ? prevIndex : prevIndex - 1;
-        auto start = _scripts.begin() + startOffset;
-        auto end = it;
-        for (auto iter = start; iter != _scripts.end() && iter >= end; --iter) {
-            std::string script = iter->universalScript.empty() ?
-                iter->backwardScript :
-                iter->universalScript + "; " + iter->backwardScript;
+    const auto [prevIndex, newIndex] = advanceTo(newTime);
+    if (newIndex > prevIndex) {
+        // We passed over the scripts [prevIndex, newIndex) in a forward direction
+        result.reserve(newIndex - prevIndex);
+        for (size_t i = prevIndex; i < newIndex; i++) {
+            const ScheduledScript& s = _scripts[i];
+            std::string script = s.universalScript.empty() ?
+                s.forwardScript :
+                s.universalScript + "; " + s.forwardScript;
+            result.push_back(std::move(script));
+        }
+    }
+    else {
+        // We passed over the scripts [newIndex, prevIndex) in a backward direction, so
+        // they have to be returned in reverse order
+        result.reserve(prevIndex - newIndex);
+        for (size_t i = prevIndex; i > newIndex; i--) {
+            const ScheduledScript& s = _scripts[i - 1];
+            std::string script = s.universalScript.empty() ?
+                s.backwardScript :
+                s.universalScript + "; " + s.backwardScript;
             result.push_back(std::move(script));
-
-            if (iter == _scripts.begin()) {
-                break;
-            }
         }
-
-        return result;
     }
+    return result;
 }
 
 double ScriptScheduler::currentTime() const {
@@ -249,12 +237,17 @@ double ScriptScheduler::currentTime() const {
 }
 
 void ScriptScheduler::setCurrentTime(double time) {
-    // Ensure _currentIndex and _currentTime is accurate after time jump
-    const std::vector<std::string> scheduledScripts = progressTo(time);
+    if (!_shouldRunAllTimeJump) {
+        // Ensure _currentIndex and _currentTime is accurate after time jump without
+        // creating scripts that would not be run anyway
+        advanceTo(time);
+        return;
+    }
 
-    if (_shouldRunAllTimeJump) {
-        // Queue all scripts for the time jump
-        for (const std::string& script : scheduledScripts) {
+    // Queue all scripts for the time jump
+    const std::vector<std::string> scheduledScripts = progressTo(time);
+    for (const std::string& script : scheduledScripts) {
+        if (!script.empty()) {
             global::scriptEngine->queueScript(script);
         }
     }
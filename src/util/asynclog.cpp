@@ -0,0 +1,146 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/asynclog.h>
+
+#include <ghoul/format.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <vector>
+
+namespace {
+    // The category of the message that reports dropped messages
+    constexpr std::string_view Category = "AsyncLog";
+} // namespace
+
+namespace openspace {
+
+AsyncLog::AsyncLog(std::unique_ptr<ghoul::logging::Log> log, size_t capacity,
+                   OverflowPolicy overflowPolicy)
+    : _log(std::move(log))
+    , _queue(capacity)
+    , _overflowPolicy(overflowPolicy)
+{
+    ghoul_precondition(_log, "Log must not be nullptr");
+
+    _writerThread = std::thread(&AsyncLog::writeMessages, this);
+}
+
+AsyncLog::~AsyncLog() {
+    _shouldStop = true;
+    _wakeUp.fetch_add(1, std::memory_order_release);
+    _wakeUp.notify_one();
+    if (_writerThread.joinable()) {
+        _writerThread.join();
+    }
+}
+
+void AsyncLog::log(LogLevel level, std::string_view category, std::string_view message)
+{
+    if (level < _log->logLevel()) {
+        return;
+    }
+
+    // The entry is created for each attempt as a failed push consumes its argument
+    bool success = _queue.tryPush({ level, std::string(category), std::string(message) });
+    while (!success && _overflowPolicy == OverflowPolicy::Block) {
+        // The writer thread might be waiting for the wake up of an earlier message
+        _wakeUp.fetch_add(1, std::memory_order_release);
+        _wakeUp.notify_one();
+        std::this_thread::yield();
+        success = _queue.tryPush({ level, std::string(category), std::string(message) });
+    }
+
+    if (success) {
+        _nQueued.fetch_add(1, std::memory_order_release);
+        _wakeUp.fetch_add(1, std::memory_order_release);
+        _wakeUp.notify_one();
+    }
+    else {
+        _nDropped.fetch_add(1, std::memory_order_relaxed);
+        _nUnreportedDrops.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AsyncLog::flush() {
+    ZoneScoped;
+
+    if (std::this_thread::get_id() == _writerThread.get_id()) {
+        // The wrapped log might be flushed from its own thread
+        return;
+    }
+
+    const uint64_t target = _nQueued.load(std::memory_order_acquire);
+    uint64_t written = _nWritten.load(std::memory_order_acquire);
+    while (written < target && _writerThread.joinable()) {
+        _wakeUp.fetch_add(1, std::memory_order_release);
+        _wakeUp.notify_one();
+        _nWritten.wait(written, std::memory_order_acquire);
+        written = _nWritten.load(std::memory_order_acquire);
+    }
+}
+
+uint64_t AsyncLog::nDroppedMessages() const {
+    return _nDropped.load(std::memory_order_relaxed);
+}
+
+void AsyncLog::writeMessages() {
+    std::vector<Entry> entries;
+    entries.reserve(_queue.capacity());
+    while (true) {
+        // Any message that is queued after this point changes the value, so the wait
+        // below returns immediately instead of missing it
+        const uint32_t wakeUp = _wakeUp.load(std::memory_order_acquire);
+
+        entries.clear();
+        const size_t n = _queue.popAll(entries);
+        for (const Entry& e : entries) {
+            _log->log(e.level, e.category, e.message);
+        }
+
+        const uint64_t nDrops = _nUnreportedDrops.exchange(0, std::memory_order_relaxed);
+        if (nDrops > 0) {
+            _log->log(
+                LogLevel::Warning,
+                Category,
+                std::format("Dropped {} log messages as the queue was full", nDrops)
+            );
+        }
+
+        if (n > 0 || nDrops > 0) {
+            _log->flush();
+            _nWritten.fetch_add(n, std::memory_order_release);
+            _nWritten.notify_all();
+        }
+
+        if (_shouldStop && _queue.empty()) {
+            break;
+        }
+        if (n == 0) {
+            _wakeUp.wait(wakeUp, std::memory_order_acquire);
+        }
+    }
+}
+
+} // namespace openspace
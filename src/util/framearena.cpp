@@ -0,0 +1,127 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/framearena.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+namespace openspace {
+
+FrameArena::FrameArena(size_t blockSize)
+    : _blockSize(blockSize)
+{
+    ghoul_assert(blockSize > 0, "blockSize must be bigger than 0");
+
+    _blocks.push_back({ std::make_unique<std::byte[]>(blockSize), blockSize });
+}
+
+void FrameArena::reset() {
+    ZoneScoped;
+
+    const std::lock_guard lock(_mutex);
+
+    _lastFrameUsage = _usedBytes;
+    _highWaterMark = std::max(_highWaterMark, _usedBytes);
+
+    if (_blocks.size() > 1) {
+        // The last frame did not fit into a single block, so we replace all of them with
+        // a single block that is big enough to hold everything
+        const size_t total = std::accumulate(
+            _blocks.begin(),
+            _blocks.end(),
+            size_t(0),
+            [](size_t sum, const Block& b) { return sum + b.size; }
+        );
+        _blocks.clear();
+        _blocks.push_back({ std::make_unique<std::byte[]>(total), total });
+    }
+
+    _currentBlock = 0;
+    _offset = 0;
+    _usedBytes = 0;
+}
+
+size_t FrameArena::usedBytes() const {
+    const std::lock_guard lock(_mutex);
+    return _usedBytes;
+}
+
+size_t FrameArena::lastFrameUsage() const {
+    const std::lock_guard lock(_mutex);
+    return _lastFrameUsage;
+}
+
+size_t FrameArena::highWaterMark() const {
+    const std::lock_guard lock(_mutex);
+    return std::max(_highWaterMark, _usedBytes);
+}
+
+size_t FrameArena::capacity() const {
+    const std::lock_guard lock(_mutex);
+    size_t total = 0;
+    for (const Block& b : _blocks) {
+        total += b.size;
+    }
+    return total;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    const std::lock_guard lock(_mutex);
+
+    while (true) {
+        Block& block = _blocks[_currentBlock];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+        const uintptr_t aligned = (base + _offset + alignment - 1) & ~(alignment - 1);
+        const size_t start = aligned - base;
+        if (start + bytes <= block.size) {
+            _usedBytes += start + bytes - _offset;
+            _offset = start + bytes;
+            return block.memory.get() + start;
+        }
+
+        // The allocation does not fit into the current block, so we have to move on to
+        // the next one, creating it if necessary
+        _usedBytes += block.size - _offset;
+        _currentBlock++;
+        _offset = 0;
+        if (_currentBlock == _blocks.size()) {
+            const size_t size = std::max(_blockSize, bytes + alignment);
+            _blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+        }
+    }
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t) {
+    // Individual allocations are never released, all memory is reclaimed in `reset`
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace openspace
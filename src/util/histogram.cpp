@@ -26,10 +26,62 @@
 
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <future>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "Histogram";
+
+    // The number of values whose bins are computed at once before they are counted
+    constexpr size_t BlockSize = 256;
+
+    // Inputs smaller than this number of values per thread are binned on the calling
+    // thread as the thread creation would take longer than the binning itself
+    constexpr size_t MinValuesPerThread = size_t(1) << 18;
+
+    // Counts the values into the provided bins and returns the number of values that
+    // were inside the range. The computation of the bin indices is kept free of branches
+    // so that it can be vectorized; values outside the range are assigned index -1
+    uint64_t countValues(std::span<const float> values, float minValue, float maxValue,
+                         int numBins, std::vector<uint64_t>& counts)
+    {
+        const float range = maxValue - minValue;
+        const float nBins = static_cast<float>(numBins);
+        const float lastBin = nBins - 1.f;
+
+        uint64_t nInRange = 0;
+        std::array<int, BlockSize> indices;
+        for (size_t offset = 0; offset < values.size(); offset += BlockSize) {
+            const size_t n = std::min(BlockSize, values.size() - offset);
+            const float* v = values.data() + offset;
+
+            // Same computation as in Histogram::add to end up in the same bin. The bin
+            // is clamped before the conversion as values that are out of range (or NaN)
+            // would otherwise overflow the integer. For the non-negative values that are
+            // left, the truncation of the conversion is the same as std::floor, which
+            // would prevent the vectorization
+            for (size_t i = 0; i < n; i++) {
+                const float value = v[i];
+                const float normalizedValue = (value - minValue) / range;
+                const float b = std::min(lastBin, normalizedValue * nBins);
+                const int bin = static_cast<int>(std::max(0.f, b));
+                const bool isInRange = (value >= minValue) & (value <= maxValue);
+                indices[i] = isInRange ? bin : -1;
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                if (indices[i] >= 0) {
+                    counts[indices[i]]++;
+                    nInRange++;
+                }
+            }
+        }
+        return nInRange;
+    }
 } // namespace
 
 namespace openspace {
@@ -86,34 +138,93 @@ bool Histogram::add(float value, float repeat) {
     return true;
 }
 
+int Histogram::add(std::span<const float> values) {
+    if (values.empty()) {
+        return 0;
+    }
+
+    const size_t nThreads = std::clamp<size_t>(
+        values.size() / MinValuesPerThread,
+        1,
+        std::max(std::thread::hardware_concurrency(), 1u)
+    );
+
+    // The counts are kept as integers until the end as a float stops incrementing by 1
+    // once it reaches 2^24
+    std::vector<uint64_t> counts = std::vector<uint64_t>(_numBins, 0);
+    uint64_t nInRange = 0;
+    if (nThreads == 1) {
+        nInRange = countValues(values, _minValue, _maxValue, _numBins, counts);
+    }
+    else {
+        const size_t chunkSize = (values.size() + nThreads - 1) / nThreads;
+        std::vector<std::vector<uint64_t>> threadCounts(
+            nThreads - 1,
+            std::vector<uint64_t>(_numBins, 0)
+        );
+        std::vector<std::future<uint64_t>> jobs;
+        jobs.reserve(nThreads - 1);
+        for (size_t t = 1; t < nThreads; t++) {
+            const size_t begin = std::min(t * chunkSize, values.size());
+            const size_t size = std::min(chunkSize, values.size() - begin);
+            jobs.push_back(std::async(
+                std::launch::async,
+                [this, chunk = values.subspan(begin, size), &c = threadCounts[t - 1]]() {
+                    return countValues(chunk, _minValue, _maxValue, _numBins, c);
+                }
+            ));
+        }
+        nInRange = countValues(
+            values.subspan(0, chunkSize),
+            _minValue,
+            _maxValue,
+            _numBins,
+            counts
+        );
+
+        for (size_t t = 0; t < jobs.size(); t++) {
+            nInRange += jobs[t].get();
+            for (int i = 0; i < _numBins; i++) {
+                counts[i] += threadCounts[t][i];
+            }
+        }
+    }
+
+    for (int i = 0; i < _numBins; i++) {
+        _data[i] += static_cast<float>(counts[i]);
+    }
+    _numValues += static_cast<int>(nInRange);
+    return static_cast<int>(nInRange);
+}
+
 void Histogram::changeRange(float minValue, float maxValue) {
     if (minValue > _minValue && maxValue < _maxValue) {
         return;
     }
 
-    float* oldData = _data;
     const float oldMin = _minValue;
-    const float oldMax = _maxValue;
+    const float oldWidth = binWidth();
+    _minValue = minValue;
+    _maxValue = maxValue;
+    const float range = _maxValue - _minValue;
 
-    float* newData = new float[_numBins]{0.0};
+    // Each old bin is moved into the new bin that contains its center. Bins that are
+    // outside the new range are collected in the first or last bin
+    float* newData = new float[_numBins]{0.f};
     for (int i = 0; i < _numBins; i++) {
-        const float unNormalizedValue = i * (oldMax - oldMin) + oldMin;
-        const float normalizedValue = (unNormalizedValue - _minValue) /
-                                      (_maxValue - _minValue);      // [0.0, 1.0]
-        const int binIndex = static_cast<int>(std::min(
-            static_cast<float>(std::floor(normalizedValue * _numBins)),
-            _numBins - 1.f
-        )); // [0, _numBins - 1]
-
-        newData[binIndex] = oldData[i];
+        const float center = oldMin + (i + 0.5f) * oldWidth;
+        const float normalizedValue = (center - _minValue) / range; // [0.0, 1.0]
+        const int binIndex = std::clamp(
+            static_cast<int>(std::floor(normalizedValue * _numBins)),
+            0,
+            _numBins - 1
+        ); // [0, _numBins - 1]
+
+        newData[binIndex] += _data[i];
     }
 
+    delete[] _data;
     _data = newData;
-    delete oldData;
-
-    _minValue = minValue;
-    _maxValue = maxValue;
-
 }
 
 bool Histogram::add(const Histogram& histogram) {
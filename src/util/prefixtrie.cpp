@@ -0,0 +1,277 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/prefixtrie.h>
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    // The children of a node are sorted by the first character of their labels, which
+    // are compared in the same way as std::string compares characters, so that the
+    // completions are found in lexicographical order
+    constexpr auto IsBeforeCharacter = [](const auto& child, char c) {
+        return static_cast<unsigned char>(child->label.front()) <
+               static_cast<unsigned char>(c);
+    };
+
+    size_t commonPrefixLength(std::string_view lhs, std::string_view rhs) {
+        const auto [l, r] = std::mismatch(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        return static_cast<size_t>(std::distance(lhs.begin(), l));
+    }
+
+    bool equalsIgnoringCase(std::string_view lhs, std::string_view rhs) {
+        return std::equal(
+            lhs.begin(), lhs.end(),
+            rhs.begin(), rhs.end(),
+            [](char l, char r) {
+                return std::tolower(static_cast<unsigned char>(l)) ==
+                       std::tolower(static_cast<unsigned char>(r));
+            }
+        );
+    }
+} // namespace
+
+namespace openspace {
+
+void PrefixTrie::insert(std::string_view word) {
+    Node* node = &_root;
+    while (!word.empty()) {
+        auto it = findChild(*node, word.front());
+        if (it == node->children.end() || (*it)->label.front() != word.front()) {
+            // No child shares a prefix with the rest of the word, so it gets its own
+            auto child = std::make_unique<Node>();
+            child->label = std::string(word);
+            child->isWord = true;
+            node->children.insert(it, std::move(child));
+            _size++;
+            return;
+        }
+
+        Node& child = **it;
+        const size_t n = commonPrefixLength(child.label, word);
+        if (n < child.label.size()) {
+            // The word diverges from the child within its label, so the child has to be
+            // split at that point
+            auto split = std::make_unique<Node>();
+            split->label = child.label.substr(0, n);
+            child.label.erase(0, n);
+            split->children.push_back(std::move(*it));
+            *it = std::move(split);
+        }
+        node = it->get();
+        word.remove_prefix(n);
+    }
+
+    if (!node->isWord) {
+        node->isWord = true;
+        _size++;
+    }
+}
+
+bool PrefixTrie::remove(std::string_view word) {
+    std::vector<Node*> path = { &_root };
+    while (!word.empty()) {
+        Node& node = *path.back();
+        auto it = findChild(node, word.front());
+        if (it == node.children.end() || !word.starts_with((*it)->label)) {
+            return false;
+        }
+        word.remove_prefix((*it)->label.size());
+        path.push_back(it->get());
+    }
+
+    Node& node = *path.back();
+    if (!node.isWord) {
+        return false;
+    }
+    node.isWord = false;
+    _size--;
+    compact(path);
+    return true;
+}
+
+size_t PrefixTrie::removePrefix(std::string_view prefix) {
+    if (prefix.empty()) {
+        const size_t n = _size;
+        clear();
+        return n;
+    }
+
+    std::vector<Node*> path = { &_root };
+    while (true) {
+        Node& node = *path.back();
+        auto it = findChild(node, prefix.front());
+        if (it == node.children.end() || (*it)->label.front() != prefix.front()) {
+            return 0;
+        }
+
+        const size_t n = commonPrefixLength((*it)->label, prefix);
+        if (n == prefix.size()) {
+            // The prefix ends within the label of the child, so all of the words in its
+            // subtree start with the prefix
+            const size_t nRemoved = nWords(**it);
+            node.children.erase(it);
+            _size -= nRemoved;
+            compact(path);
+            return nRemoved;
+        }
+        if (n < (*it)->label.size()) {
+            // The prefix diverges from the child within its label
+            return 0;
+        }
+        path.push_back(it->get());
+        prefix.remove_prefix(n);
+    }
+}
+
+bool PrefixTrie::contains(std::string_view word) const {
+    const Node* node = &_root;
+    while (!word.empty()) {
+        auto it = std::lower_bound(
+            node->children.begin(),
+            node->children.end(),
+            word.front(),
+            IsBeforeCharacter
+        );
+        if (it == node->children.end() || !word.starts_with((*it)->label)) {
+            return false;
+        }
+        word.remove_prefix((*it)->label.size());
+        node = it->get();
+    }
+    return node->isWord;
+}
+
+std::vector<std::string> PrefixTrie::completions(std::string_view prefix,
+                                                 char separator) const
+{
+    std::vector<std::string> result;
+    if (prefix.empty() && _root.isWord) {
+        result.emplace_back();
+    }
+    std::string word;
+    collectCompletions(_root, word, prefix, separator, result);
+    return result;
+}
+
+size_t PrefixTrie::size() const {
+    return _size;
+}
+
+bool PrefixTrie::empty() const {
+    return _size == 0;
+}
+
+void PrefixTrie::clear() {
+    _root = Node();
+    _size = 0;
+}
+
+std::vector<std::unique_ptr<PrefixTrie::Node>>::iterator PrefixTrie::findChild(
+                                                                       Node& node,
+                                                                       char character)
+{
+    return std::lower_bound(
+        node.children.begin(),
+        node.children.end(),
+        character,
+        IsBeforeCharacter
+    );
+}
+
+void PrefixTrie::compact(std::vector<Node*>& path) {
+    // Apart from the root, a node that is not a word is only needed if it separates at
+    // least two children
+    while (path.size() > 1) {
+        Node& node = *path.back();
+        if (node.isWord || node.children.size() > 1) {
+            return;
+        }
+
+        if (node.children.size() == 1) {
+            std::unique_ptr<Node> child = std::move(node.children.front());
+            node.label += child->label;
+            node.isWord = child->isWord;
+            node.children = std::move(child->children);
+            return;
+        }
+
+        path.pop_back();
+        Node& parent = *path.back();
+        parent.children.erase(findChild(parent, node.label.front()));
+    }
+}
+
+size_t PrefixTrie::nWords(const Node& node) {
+    size_t n = node.isWord ? 1 : 0;
+    for (const std::unique_ptr<Node>& child : node.children) {
+        n += nWords(*child);
+    }
+    return n;
+}
+
+void PrefixTrie::collectCompletions(const Node& node, std::string& word,
+                                    std::string_view prefix, char separator,
+                                    std::vector<std::string>& result)
+{
+    // The `word` is spelled by the path to the `node` and the `prefix` is the part of
+    // the requested prefix that is not covered by the `word` yet
+    for (const std::unique_ptr<Node>& child : node.children) {
+        const std::string_view label = child->label;
+        const size_t n = std::min(label.size(), prefix.size());
+        if (!equalsIgnoringCase(label.substr(0, n), prefix.substr(0, n))) {
+            continue;
+        }
+
+        const size_t length = word.size();
+        if (n < label.size()) {
+            // The prefix has been matched completely, so the completion of all words in
+            // this subtree ends at the first separator after the prefix
+            const size_t pos =
+                separator != '\0' ? label.find(separator, n) : std::string_view::npos;
+            if (pos != std::string_view::npos) {
+                result.push_back(word + std::string(label.substr(0, pos + 1)));
+                continue;
+            }
+
+            word += label;
+            if (child->isWord) {
+                result.push_back(word);
+            }
+            collectCompletions(*child, word, std::string_view(), separator, result);
+        }
+        else {
+            word += label;
+            const std::string_view rest = prefix.substr(n);
+            if (rest.empty() && child->isWord) {
+                result.push_back(word);
+            }
+            collectCompletions(*child, word, rest, separator, result);
+        }
+        word.resize(length);
+    }
+}
+
+} // namespace openspace
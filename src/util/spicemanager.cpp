@@ -34,6 +34,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <format>
+#include <optional>
 #include "SpiceUsr.h"
 #include "SpiceZpr.h"
 
@@ -45,6 +46,50 @@ namespace {
     // as the maximum message length
     constexpr unsigned SpiceErrorBufferSize = 1841;
 
+    constexpr openspace::properties::Property::PropertyInfo UseEphemerisCacheInfo = {
+        "UseEphemerisCache",
+        "Use Ephemeris Cache",
+        "If this value is enabled, positions and transformation matrices that are "
+        "requested for the current simulation time are cached until the time changes. "
+        "This avoids calling into SPICE repeatedly if the same value is requested by "
+        "multiple components in the same frame.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheHitsInfo = {
+        "CacheHits",
+        "Cache Hits",
+        "The number of requests in the last frame that were served from the ephemeris "
+        "cache.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheMissesInfo = {
+        "CacheMisses",
+        "Cache Misses",
+        "The number of requests in the last frame for the current simulation time that "
+        "were not found in the ephemeris cache and were forwarded to SPICE.",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    // Creates a key for the ephemeris cache from the passed components. The key is
+    // written into the passed string to reuse its memory between lookups
+    void buildCacheKey(std::string& key, char type, const std::string& a,
+                       const std::string& b, const std::string& c = "",
+                       const char* d = "")
+    {
+        // The individual components can't contain newlines as they are NAIF names
+        key.clear();
+        key += type;
+        key += a;
+        key += '\n';
+        key += b;
+        key += '\n';
+        key += c;
+        key += '\n';
+        key += d;
+    }
+
     const char* toString(openspace::SpiceManager::FieldOfViewMethod m) {
         using SM = openspace::SpiceManager;
         switch (m) {
@@ -149,7 +194,19 @@ SpiceManager::TerminatorType SpiceManager::terminatorTypeFromString(
     return Mapping.at(type);
 }
 
-SpiceManager::SpiceManager() {
+SpiceManager::SpiceManager()
+    : properties::PropertyOwner({ "SpiceManager", "SPICE Manager" })
+    , _useEphemerisCache(UseEphemerisCacheInfo, true)
+    , _cacheHits(CacheHitsInfo, 0, 0, std::numeric_limits<int>::max())
+    , _cacheMisses(CacheMissesInfo, 0, 0, std::numeric_limits<int>::max())
+{
+    _useEphemerisCache.onChange([this]() { clearEphemerisCache(); });
+    addProperty(_useEphemerisCache);
+    _cacheHits.setReadOnly(true);
+    addProperty(_cacheHits);
+    _cacheMisses.setReadOnly(true);
+    addProperty(_cacheMisses);
+
     // The third parameter for the erract_c function is a SpiceChar*, not ConstSpiceChar*
     // so we have to do this weird memory copying trick
     std::array<char, 7> buffer;
@@ -216,6 +273,7 @@ void throwSpiceError(const std::string& errorMessage) {
 }
 
 SpiceManager::KernelHandle SpiceManager::loadKernel(std::filesystem::path filePath) {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!filePath.empty(), "Empty file path");
     ghoul_assert(
         std::filesystem::is_regular_file(filePath),
@@ -276,6 +334,9 @@ SpiceManager::KernelHandle SpiceManager::loadKernel(std::filesystem::path filePa
             findSpkCoverage(filePath); // spk kernel
     }
 
+    // The new kernel might change the results for already cached values
+    clearEphemerisCache();
+
     const KernelHandle kernelId = ++_lastAssignedKernel;
     ghoul_assert(kernelId != 0, "Kernel Handle wrapped around to 0");
     _loadedKernels.push_back({ std::move(filePath), kernelId, 1 });
@@ -283,6 +344,7 @@ SpiceManager::KernelHandle SpiceManager::loadKernel(std::filesystem::path filePa
 }
 
 void SpiceManager::unloadKernel(KernelHandle kernelId) {
+    std::lock_guard lock(_mutex);
     ghoul_assert(kernelId <= _lastAssignedKernel, "Invalid unassigned kernel");
     ghoul_assert(kernelId != KernelHandle(0), "Invalid zero handle");
 
@@ -300,6 +362,7 @@ void SpiceManager::unloadKernel(KernelHandle kernelId) {
             const std::string p = it->path.string();
             unload_c(p.c_str());
             _loadedKernels.erase(it);
+            clearEphemerisCache();
         }
         // Otherwise, we hold on to it, but reduce the reference counter by 1
         else {
@@ -310,6 +373,7 @@ void SpiceManager::unloadKernel(KernelHandle kernelId) {
 }
 
 void SpiceManager::unloadKernel(std::filesystem::path filePath) {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!filePath.empty(), "Empty filename");
 
     const auto it = std::find_if(
@@ -335,6 +399,7 @@ void SpiceManager::unloadKernel(std::filesystem::path filePath) {
             const std::string p = filePath.string();
             unload_c(p.c_str());
             _loadedKernels.erase(it);
+            clearEphemerisCache();
         }
         else {
             // Otherwise, we hold on to it, but reduce the reference counter by 1
@@ -345,6 +410,7 @@ void SpiceManager::unloadKernel(std::filesystem::path filePath) {
 }
 
 std::vector<std::filesystem::path> SpiceManager::loadedKernels() const {
+    std::lock_guard lock(_mutex);
     std::vector<std::filesystem::path> res;
     res.reserve(_loadedKernels.size());
     for (const KernelInformation& info : _loadedKernels) {
@@ -354,6 +420,7 @@ std::vector<std::filesystem::path> SpiceManager::loadedKernels() const {
 }
 
 bool SpiceManager::hasSpkCoverage(const std::string& target, double et) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Empty target");
 
     const int id = naifId(target);
@@ -377,6 +444,7 @@ bool SpiceManager::hasSpkCoverage(const std::string& target, double et) const {
 std::vector<std::pair<double, double>> SpiceManager::spkCoverage(
                                                           const std::string& target) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Empty target");
 
     const int id = naifId(target);
@@ -392,6 +460,7 @@ std::vector<std::pair<double, double>> SpiceManager::spkCoverage(
 
 
 bool SpiceManager::hasCkCoverage(const std::string& frame, double et) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!frame.empty(), "Empty target");
 
     const int id = frameId(frame);
@@ -410,6 +479,7 @@ bool SpiceManager::hasCkCoverage(const std::string& frame, double et) const {
 std::vector<std::pair<double, double>> SpiceManager::ckCoverage(
                                                           const std::string& target) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Empty target");
 
     int id = naifId(target);
@@ -433,6 +503,7 @@ std::vector<std::pair<double, double>> SpiceManager::ckCoverage(
 std::vector<std::pair<int, std::string>> SpiceManager::spiceBodies(
                                                                  bool builtInFrames) const
 {
+    std::lock_guard lock(_mutex);
     std::vector<std::pair<int, std::string>> bodies;
 
     static std::array<SpiceInt, SPICE_CELL_CTRLSZ + 8192> idsetBuffer;
@@ -485,10 +556,12 @@ std::vector<std::pair<int, std::string>> SpiceManager::spiceBodies(
 }
 
 bool SpiceManager::hasValue(int naifId, const std::string& item) const {
+    std::lock_guard lock(_mutex);
     return bodfnd_c(naifId, item.c_str());
 }
 
 bool SpiceManager::hasValue(const std::string& body, const std::string& item) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!body.empty(), "Empty body");
     ghoul_assert(!item.empty(), "Empty item");
 
@@ -497,6 +570,7 @@ bool SpiceManager::hasValue(const std::string& body, const std::string& item) co
 }
 
 int SpiceManager::naifId(const std::string& body) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!body.empty(), "Empty body");
 
     SpiceBoolean success = SPICEFALSE;
@@ -509,6 +583,7 @@ int SpiceManager::naifId(const std::string& body) const {
 }
 
 bool SpiceManager::hasNaifId(const std::string& body) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!body.empty(), "Empty body");
 
     SpiceBoolean success = SPICEFALSE;
@@ -519,6 +594,7 @@ bool SpiceManager::hasNaifId(const std::string& body) const {
 }
 
 int SpiceManager::frameId(const std::string& frame) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!frame.empty(), "Empty frame");
 
     SpiceInt id = 0;
@@ -530,6 +606,7 @@ int SpiceManager::frameId(const std::string& frame) const {
 }
 
 bool SpiceManager::hasFrameId(const std::string& frame) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!frame.empty(), "Empty frame");
 
     SpiceInt id = 0;
@@ -557,30 +634,35 @@ void getValueInternal(const std::string& body, const std::string& value, int siz
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             double& v) const
 {
+    std::lock_guard lock(_mutex);
     getValueInternal(body, value, 1, &v);
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             glm::dvec2& v) const
 {
+    std::lock_guard lock(_mutex);
     getValueInternal(body, value, 2, glm::value_ptr(v));
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             glm::dvec3& v) const
 {
+    std::lock_guard lock(_mutex);
     getValueInternal(body, value, 3, glm::value_ptr(v));
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             glm::dvec4& v) const
 {
+    std::lock_guard lock(_mutex);
     getValueInternal(body, value, 4, glm::value_ptr(v));
 }
 
 void SpiceManager::getValue(const std::string& body, const std::string& value,
                             std::vector<double>& v) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!v.empty(), "Array for values has to be preallocaed");
 
     getValueInternal(body, value, static_cast<int>(v.size()), v.data());
@@ -589,6 +671,7 @@ void SpiceManager::getValue(const std::string& body, const std::string& value,
 double SpiceManager::spacecraftClockToET(const std::string& craft,
                                          double craftTicks) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!craft.empty(), "Empty craft");
 
     const int craftId = naifId(craft);
@@ -603,12 +686,14 @@ double SpiceManager::spacecraftClockToET(const std::string& craft,
 }
 
 double SpiceManager::ephemerisTimeFromDate(const std::string& timeString) const {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!timeString.empty(), "Empty timeString");
 
     return ephemerisTimeFromDate(timeString.c_str());
 }
 
 double SpiceManager::ephemerisTimeFromDate(const char* timeString) const {
+    std::lock_guard lock(_mutex);
     double et = 0.0;
     str2et_c(timeString, &et);
     if (failed_c()) {
@@ -619,6 +704,7 @@ double SpiceManager::ephemerisTimeFromDate(const char* timeString) const {
 
 std::string SpiceManager::dateFromEphemerisTime(double ephemerisTime, const char* format)
 {
+    std::lock_guard lock(_mutex);
     constexpr int BufferSize = 128;
     std::array<char, BufferSize> Buffer;
     std::memset(Buffer.data(), char(0), BufferSize);
@@ -645,6 +731,48 @@ glm::dvec3 SpiceManager::targetPosition(const std::string& target,
                                         const std::string& referenceFrame,
                                         AberrationCorrection aberrationCorrection,
                                         double ephemerisTime, double& lightTime) const
+{
+    std::lock_guard lock(_mutex);
+    if (!isCacheable(ephemerisTime)) {
+        return computeTargetPosition(
+            target,
+            observer,
+            referenceFrame,
+            aberrationCorrection,
+            ephemerisTime,
+            lightTime
+        );
+    }
+
+    buildCacheKey(_cacheKey, 'P', target, observer, referenceFrame, aberrationCorrection);
+    const auto it = _positionCache.find(_cacheKey);
+    if (it != _positionCache.end()) {
+        _nCacheHits++;
+        lightTime = it->second.lightTime;
+        return it->second.position;
+    }
+    _nCacheMisses++;
+
+    CachedPosition res;
+    res.position = computeTargetPosition(
+        target,
+        observer,
+        referenceFrame,
+        aberrationCorrection,
+        ephemerisTime,
+        res.lightTime
+    );
+    lightTime = res.lightTime;
+    _positionCache[_cacheKey] = res;
+    return res.position;
+}
+
+glm::dvec3 SpiceManager::computeTargetPosition(const std::string& target,
+                                               const std::string& observer,
+                                               const std::string& referenceFrame,
+                                               AberrationCorrection aberrationCorrection,
+                                               double ephemerisTime,
+                                               double& lightTime) const
 {
     ghoul_assert(!target.empty(), "Target is not empty");
     ghoul_assert(!observer.empty(), "Observer is not empty");
@@ -716,6 +844,7 @@ glm::dvec3 SpiceManager::targetPosition(const std::string& target,
                                         AberrationCorrection aberrationCorrection,
                                         double ephemerisTime) const
 {
+    std::lock_guard lock(_mutex);
     double unused = 0.0;
     return targetPosition(
         target,
@@ -727,9 +856,122 @@ glm::dvec3 SpiceManager::targetPosition(const std::string& target,
     );
 }
 
+void SpiceManager::targetPositions(const std::string& target,
+                                   const std::string& observer,
+                                   const std::string& referenceFrame,
+                                   AberrationCorrection aberrationCorrection,
+                                   std::span<const double> ephemerisTimes,
+                                   std::span<glm::dvec3> positions) const
+{
+    ghoul_assert(!target.empty(), "Target is not empty");
+    ghoul_assert(!observer.empty(), "Observer is not empty");
+    ghoul_assert(!referenceFrame.empty(), "Reference frame is not empty");
+    ghoul_assert(
+        ephemerisTimes.size() == positions.size(),
+        "Times and positions must have the same size"
+    );
+
+    if (ephemerisTimes.empty()) {
+        return;
+    }
+
+    // The lock is only held for individual samples, so that other threads are not
+    // blocked for the duration of large batches
+    std::unique_lock lock(_mutex);
+
+    const auto [minTime, maxTime] = std::minmax_element(
+        ephemerisTimes.begin(),
+        ephemerisTimes.end()
+    );
+
+    // Returns whether a single SPK interval of the body covers all requested times
+    auto coversRange = [this, minTime, maxTime](int id) {
+        // SOLAR SYSTEM BARYCENTER special case, implicitly included by Spice
+        if (id == 0) {
+            return true;
+        }
+        const auto it = _spkIntervals.find(id);
+        if (it == _spkIntervals.end()) {
+            return false;
+        }
+        return std::any_of(
+            it->second.begin(),
+            it->second.end(),
+            [minTime, maxTime](const std::pair<double, double>& interval) {
+                return interval.first < *minTime && interval.second > *maxTime;
+            }
+        );
+    };
+
+    const int targetId = naifId(target);
+    const int observerId = naifId(observer);
+    const bool coversTimes = coversRange(targetId) && coversRange(observerId);
+    lock.unlock();
+
+    if (!coversTimes) {
+        // At least one of the samples might require an estimated position, so every
+        // time has to go through the regular path
+        for (size_t i = 0; i < ephemerisTimes.size(); i++) {
+            const std::lock_guard sampleLock(_mutex);
+            double lightTime = 0.0;
+            positions[i] = computeTargetPosition(
+                target,
+                observer,
+                referenceFrame,
+                aberrationCorrection,
+                ephemerisTimes[i],
+                lightTime
+            );
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < ephemerisTimes.size(); i++) {
+        const std::lock_guard sampleLock(_mutex);
+        double lightTime = 0.0;
+        spkezp_c(
+            static_cast<SpiceInt>(targetId),
+            ephemerisTimes[i],
+            referenceFrame.c_str(),
+            aberrationCorrection,
+            static_cast<SpiceInt>(observerId),
+            glm::value_ptr(positions[i]),
+            &lightTime
+        );
+        if (failed_c()) {
+            throwSpiceError(std::format(
+                "Error getting position from '{}' to '{}' in frame '{}' at time '{}'",
+                target, observer, referenceFrame, ephemerisTimes[i]
+            ));
+        }
+    }
+}
+
 glm::dmat3 SpiceManager::frameTransformationMatrix(const std::string& from,
                                                    const std::string& to,
                                                    double ephemerisTime) const
+{
+    std::lock_guard lock(_mutex);
+    if (!isCacheable(ephemerisTime)) {
+        return computeFrameTransformationMatrix(from, to, ephemerisTime);
+    }
+
+    buildCacheKey(_cacheKey, 'F', from, to);
+    const auto it = _matrixCache.find(_cacheKey);
+    if (it != _matrixCache.end()) {
+        _nCacheHits++;
+        return it->second;
+    }
+    _nCacheMisses++;
+
+    const glm::dmat3 res = computeFrameTransformationMatrix(from, to, ephemerisTime);
+    _matrixCache[_cacheKey] = res;
+    return res;
+}
+
+glm::dmat3 SpiceManager::computeFrameTransformationMatrix(const std::string& from,
+                                                          const std::string& to,
+                                                          double ephemerisTime) const
 {
     ghoul_assert(!from.empty(), "From must not be empty");
     ghoul_assert(!to.empty(), "To must not be empty");
@@ -765,6 +1007,7 @@ SpiceManager::SurfaceInterceptResult SpiceManager::surfaceIntercept(
                                                                      double ephemerisTime,
                                                   const glm::dvec3& directionVector) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Target must not be empty");
     ghoul_assert(!observer.empty(), "Observer must not be empty");
     ghoul_assert(target != observer, "Target and observer must be different");
@@ -811,6 +1054,7 @@ bool SpiceManager::isTargetInFieldOfView(const std::string& target,
                                          AberrationCorrection aberrationCorrection,
                                          double& ephemerisTime) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Target must not be empty");
     ghoul_assert(!observer.empty(), "Observer must not be empty");
     ghoul_assert(target != observer, "Target and observer must be different");
@@ -845,6 +1089,7 @@ SpiceManager::TargetStateResult SpiceManager::targetState(const std::string& tar
                                                 AberrationCorrection aberrationCorrection,
                                                                double ephemerisTime) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Target must not be empty");
     ghoul_assert(!observer.empty(), "Observer must not be empty");
     ghoul_assert(!referenceFrame.empty(), "Reference frame must not be empty");
@@ -882,6 +1127,7 @@ SpiceManager::TransformMatrix SpiceManager::stateTransformMatrix(
                                                       const std::string& destinationFrame,
                                                                double ephemerisTime) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "toFrame must not be empty");
 
@@ -905,6 +1151,39 @@ SpiceManager::TransformMatrix SpiceManager::stateTransformMatrix(
 glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
                                                  const std::string& destinationFrame,
                                                  double ephemerisTime) const
+{
+    std::lock_guard lock(_mutex);
+    if (!isCacheable(ephemerisTime)) {
+        return computePositionTransformMatrix(
+            sourceFrame,
+            destinationFrame,
+            ephemerisTime
+        );
+    }
+
+    // The position transform matrix uses an estimation in case of missing coverage, so
+    // the values can differ from the frame transformation matrix
+    buildCacheKey(_cacheKey, 'T', sourceFrame, destinationFrame);
+    const auto it = _matrixCache.find(_cacheKey);
+    if (it != _matrixCache.end()) {
+        _nCacheHits++;
+        return it->second;
+    }
+    _nCacheMisses++;
+
+    const glm::dmat3 res = computePositionTransformMatrix(
+        sourceFrame,
+        destinationFrame,
+        ephemerisTime
+    );
+    _matrixCache[_cacheKey] = res;
+    return res;
+}
+
+glm::dmat3 SpiceManager::computePositionTransformMatrix(
+                                                     const std::string& sourceFrame,
+                                                     const std::string& destinationFrame,
+                                                     double ephemerisTime) const
 {
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "destinationFrame must not be empty");
@@ -938,6 +1217,7 @@ glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
                                                  double ephemerisTimeFrom,
                                                  double ephemerisTimeTo) const
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "destinationFrame must not be empty");
 
@@ -968,6 +1248,7 @@ SpiceManager::fieldOfView(const std::string& instrument) const
 }
 
 SpiceManager::FieldOfViewResult SpiceManager::fieldOfView(int instrument) const {
+    std::lock_guard lock(_mutex);
     constexpr int MaxBoundsSize = 64;
     constexpr int BufferSize = 128;
 
@@ -1023,6 +1304,7 @@ SpiceManager::TerminatorEllipseResult SpiceManager::terminatorEllipse(
                                                                      double ephemerisTime,
                                                              int numberOfTerminatorPoints)
 {
+    std::lock_guard lock(_mutex);
     ghoul_assert(!target.empty(), "Target must not be empty");
     ghoul_assert(!observer.empty(), "Observer must not be empty");
     ghoul_assert(!frame.empty(), "Frame must not be empty");
@@ -1683,13 +1965,145 @@ References:
 }
 
 void SpiceManager::setExceptionHandling(UseException useException) {
+    std::lock_guard lock(_mutex);
     _useExceptions = useException;
 }
 
 SpiceManager::UseException SpiceManager::exceptionHandling() const {
+    std::lock_guard lock(_mutex);
     return _useExceptions;
 }
 
+void SpiceManager::updateEphemerisCache(double ephemerisTime) {
+    std::lock_guard lock(_mutex);
+    _cacheHits = _nCacheHits;
+    _cacheMisses = _nCacheMisses;
+    _nCacheHits = 0;
+    _nCacheMisses = 0;
+
+    if (ephemerisTime != _cacheEphemerisTime) {
+        clearEphemerisCache();
+        _cacheEphemerisTime = ephemerisTime;
+
+        if (_useEphemerisCache) {
+            evaluatePositionRequests(ephemerisTime);
+        }
+    }
+}
+
+int SpiceManager::registerPositionRequest(std::string target, std::string observer,
+                                          std::string referenceFrame)
+{
+    std::lock_guard lock(_mutex);
+    ghoul_assert(!target.empty(), "Target is not empty");
+    ghoul_assert(!observer.empty(), "Observer is not empty");
+    ghoul_assert(!referenceFrame.empty(), "Reference frame is not empty");
+
+    const int handle = _nextPositionRequest;
+    _nextPositionRequest++;
+    _positionRequests[handle] = {
+        std::move(target),
+        std::move(observer),
+        std::move(referenceFrame)
+    };
+    return handle;
+}
+
+void SpiceManager::unregisterPositionRequest(int handle) {
+    std::lock_guard lock(_mutex);
+    _positionRequests.erase(handle);
+}
+
+void SpiceManager::evaluatePositionRequests(double ephemerisTime) {
+    ZoneScoped;
+
+    // The positions of all involved bodies relative to the solar system barycenter,
+    // keyed by the reference frame and the NAIF ID of the body. Bodies for which the
+    // position could not be computed are stored as empty values
+    std::map<std::pair<std::string_view, int>, std::optional<glm::dvec3>> positions;
+
+    auto barycentricPosition = [this, &positions, ephemerisTime](
+                                  const std::string& body, const std::string& frame)
+        -> std::optional<glm::dvec3>
+    {
+        if (!hasNaifId(body)) {
+            return std::nullopt;
+        }
+        const int id = naifId(body);
+        const auto key = std::pair<std::string_view, int>(frame, id);
+        const auto it = positions.find(key);
+        if (it != positions.end()) {
+            return it->second;
+        }
+
+        std::optional<glm::dvec3> result;
+        if (id == 0) {
+            result = glm::dvec3(0.0);
+        }
+        else if (hasSpkCoverage(body, ephemerisTime)) {
+            glm::dvec3 position = glm::dvec3(0.0);
+            double lightTime = 0.0;
+            spkezp_c(
+                static_cast<SpiceInt>(id),
+                ephemerisTime,
+                frame.c_str(),
+                "NONE",
+                0,
+                glm::value_ptr(position),
+                &lightTime
+            );
+            if (failed_c()) {
+                // The request is computed through the regular path instead, which will
+                // report the error
+                reset_c();
+            }
+            else {
+                result = position;
+            }
+        }
+        positions[key] = result;
+        return result;
+    };
+
+    for (const std::pair<const int, PositionRequest>& p : _positionRequests) {
+        const PositionRequest& request = p.second;
+        const std::optional<glm::dvec3> target =
+            barycentricPosition(request.target, request.referenceFrame);
+        const std::optional<glm::dvec3> observer =
+            barycentricPosition(request.observer, request.referenceFrame);
+        if (!target.has_value() || !observer.has_value()) {
+            continue;
+        }
+
+        buildCacheKey(
+            _cacheKey,
+            'P',
+            request.target,
+            request.observer,
+            request.referenceFrame,
+            AberrationCorrection()
+        );
+        // Only uncorrected positions are batched, for which SPICE reports the one-way
+        // light time along the geometric distance. The positions are in km and the
+        // speed of light returned by clight_c is in km/s
+        const glm::dvec3 position = *target - *observer;
+        _positionCache[_cacheKey] = {
+            .position = position,
+            .lightTime = glm::length(position) / clight_c()
+        };
+    }
+}
+
+void SpiceManager::clearEphemerisCache() {
+    std::lock_guard lock(_mutex);
+    _positionCache.clear();
+    _matrixCache.clear();
+}
+
+bool SpiceManager::isCacheable(double ephemerisTime) const {
+    return _useEphemerisCache && ephemerisTime == _cacheEphemerisTime;
+}
+
 scripting::LuaLibrary SpiceManager::luaLibrary() {
     return {
         "spice",
@@ -24,7 +24,10 @@
 
 #include <openspace/util/syncbuffer.h>
 
+#include <ghoul/misc/exception.h>
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <format>
 
 namespace openspace {
 
@@ -37,12 +40,7 @@ SyncBuffer::SyncBuffer(size_t n)
 void SyncBuffer::encode(const std::string& s) {
     ZoneScoped;
 
-    const int32_t anticpatedBufferSize = static_cast<int32_t>(
-        _encodeOffset + (sizeof(char) * s.size()) + sizeof(int32_t)
-    );
-    if (anticpatedBufferSize >= static_cast<int32_t>(_n)) {
-        _dataStream.resize(anticpatedBufferSize);
-    }
+    ensureEncodeCapacity(sizeof(char) * s.size() + sizeof(int32_t));
 
     int32_t length = static_cast<int32_t>(s.size() * sizeof(char));
     memcpy(
@@ -55,6 +53,22 @@ void SyncBuffer::encode(const std::string& s) {
     _encodeOffset += length;
 }
 
+void SyncBuffer::encode(std::span<const std::byte> data) {
+    ZoneScoped;
+
+    ensureEncodeCapacity(data.size() + sizeof(uint32_t));
+
+    const uint32_t length = static_cast<uint32_t>(data.size());
+    std::memcpy(_dataStream.data() + _encodeOffset, &length, sizeof(uint32_t));
+    _encodeOffset += sizeof(uint32_t);
+    std::memcpy(_dataStream.data() + _encodeOffset, data.data(), length);
+    _encodeOffset += length;
+}
+
+void SyncBuffer::encode(const std::vector<std::byte>& data) {
+    encode(std::span<const std::byte>(data));
+}
+
 std::string SyncBuffer::decode() {
     ZoneScoped;
 
@@ -64,12 +78,12 @@ std::string SyncBuffer::decode() {
         _dataStream.data() + _decodeOffset,
         sizeof(int32_t)
     );
-    std::vector<char> tmp(length + 1);
     _decodeOffset += sizeof(int32_t);
-    memcpy(tmp.data(), _dataStream.data() + _decodeOffset, length);
+    std::string ret(
+        reinterpret_cast<const char*>(_dataStream.data() + _decodeOffset),
+        length
+    );
     _decodeOffset += length;
-    tmp[length] = '\0';
-    std::string ret(tmp.data());
     return ret;
 }
 
@@ -77,36 +91,54 @@ void SyncBuffer::decode(std::string& s) {
     s = decode();
 }
 
+void SyncBuffer::decode(std::vector<std::byte>& data) {
+    ZoneScoped;
+
+    uint32_t length = 0;
+    std::memcpy(&length, _dataStream.data() + _decodeOffset, sizeof(uint32_t));
+    _decodeOffset += sizeof(uint32_t);
+    if (_decodeOffset + length > _dataStream.size()) {
+        throw ghoul::RuntimeError(std::format(
+            "Block of {} bytes exceeds the {} remaining bytes in the buffer",
+            length, _dataStream.size() - _decodeOffset
+        ));
+    }
+
+    data.resize(length);
+    std::memcpy(data.data(), _dataStream.data() + _decodeOffset, length);
+    _decodeOffset += length;
+}
+
 void SyncBuffer::decode(glm::quat& value) {
     const size_t size = sizeof(glm::quat);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _dataStream.size(), "Buffer overrun");
     std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
 void SyncBuffer::decode(glm::dquat& value) {
     const size_t size = sizeof(glm::dquat);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _dataStream.size(), "Buffer overrun");
     std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
 void SyncBuffer::decode(glm::vec3& value) {
     const size_t size = sizeof(glm::vec3);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _dataStream.size(), "Buffer overrun");
     std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
 void SyncBuffer::decode(glm::dvec3& value) {
     const size_t size = sizeof(glm::dvec3);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _dataStream.size(), "Buffer overrun");
     std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
-void SyncBuffer::setData(std::vector<std::byte> data) {
-    _dataStream = std::move(data);
+void SyncBuffer::setData(std::span<const std::byte> data) {
+    _dataStream.assign(data.begin(), data.end());
 }
 
 std::vector<std::byte> SyncBuffer::data() {
@@ -115,6 +147,17 @@ std::vector<std::byte> SyncBuffer::data() {
     return _dataStream;
 }
 
+std::span<const std::byte> SyncBuffer::encodedData() const {
+    return std::span<const std::byte>(_dataStream.data(), _encodeOffset);
+}
+
+void SyncBuffer::ensureEncodeCapacity(size_t size) {
+    const size_t required = _encodeOffset + size;
+    if (required > _dataStream.size()) {
+        _dataStream.resize(std::max(required, 2 * _dataStream.size()));
+    }
+}
+
 void SyncBuffer::reset() {
     _dataStream.resize(_n);
     _encodeOffset = 0;
@@ -45,6 +45,15 @@ namespace {
         // valid Tasks that are available for creation (see the FactoryDocumentation for a
         // list of possible Tasks), which depends on the configration of the application
         std::string type [[codegen::annotation("A valid Task created by a factory")]];
+
+        // An identifier that other tasks can use in their 'DependsOn' list to make sure
+        // that this task is performed before them
+        std::optional<std::string> identifier [[codegen::identifier()]];
+
+        // The identifiers of the tasks that have to be performed successfully before
+        // this task can start. Tasks that do not depend on each other can be performed
+        // concurrently if the TaskRunner is started with more than one thread
+        std::optional<std::vector<std::string>> dependsOn;
     };
 #include "task_codegen.cpp"
 } // namespace
@@ -55,11 +64,23 @@ documentation::Documentation Task::documentation() {
     return codegen::doc<Parameters>("core_task");
 }
 
+const std::string& Task::identifier() const {
+    return _identifier;
+}
+
+const std::vector<std::string>& Task::dependencies() const {
+    return _dependencies;
+}
+
 std::unique_ptr<Task> Task::createFromDictionary(const ghoul::Dictionary& dictionary) {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
     ghoul::TemplateFactory<Task>* factory = FactoryManager::ref().factory<Task>();
     Task* task = factory->create(p.type, dictionary);
+    if (task) {
+        task->_identifier = p.identifier.value_or(task->_identifier);
+        task->_dependencies = p.dependsOn.value_or(task->_dependencies);
+    }
     return std::unique_ptr<Task>(task);
 }
 
@@ -24,79 +24,135 @@
 
 #include <openspace/util/threadpool.h>
 
-namespace openspace {
+#include <ghoul/misc/assert.h>
+#include <algorithm>
 
-Worker::Worker(ThreadPool& p) : pool(p) {}
+namespace {
+    // The pool and worker index of the current thread, if it is one of the workers
+    thread_local const openspace::ThreadPool* CurrentPool = nullptr;
+    thread_local size_t CurrentWorker = 0;
+} // namespace
 
-void Worker::operator()() {
-    std::function<void()> task;
-    while (true) {
-        {
-            std::unique_lock lock(pool.queue_mutex);
-
-            // look for a work item
-            while (!pool.stop && pool.tasks.empty()) {
-                // if there are none wait for notification
-                pool.condition.wait(lock);
-            }
-
-            if (pool.stop) { // exit if the pool is stopped
-                return;
-            }
+namespace openspace {
 
-            // get the task from the queue
-            task = pool.tasks.front();
-            pool.tasks.pop_front();
-        }
+ThreadPool::ThreadPool(size_t numThreads) {
+    ghoul_assert(numThreads > 0, "numThreads must be bigger than 0");
 
-        // execute the task
-        task();
+    _queues.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; i++) {
+        _queues.push_back(std::make_unique<Queue>());
     }
-}
 
-ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
+    _workers.reserve(numThreads);
     for (size_t i = 0; i < numThreads; i++) {
-        workers.emplace_back(Worker(*this));
+        _workers.emplace_back(&ThreadPool::workerLoop, this, i);
     }
 }
 
-ThreadPool::ThreadPool(const ThreadPool& toCopy) : ThreadPool(toCopy.workers.size()) {}
+ThreadPool::ThreadPool(const ThreadPool& toCopy) : ThreadPool(toCopy._workers.size()) {}
 
-// the destructor joins all threads
 ThreadPool::~ThreadPool() {
-    // stop all threads
     {
-        const std::unique_lock lock(queue_mutex);
-        stop = true;
+        const std::lock_guard lock(_sleepMutex);
+        _stop = true;
     }
-    condition.notify_all();
+    _condition.notify_all();
 
-    // join them
-    for (std::thread& w : workers) {
+    for (std::thread& w : _workers) {
         w.join();
     }
 }
 
-// add new work item to the pool
-void ThreadPool::enqueue(std::function<void()> f) {
-    {
-        const std::unique_lock lock(queue_mutex);
+size_t ThreadPool::defaultNumberOfThreads() {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+}
 
-        // add the task
-        tasks.push_back(std::move(f));
-    }
+void ThreadPool::enqueue(std::function<void()> f, Priority priority) {
+    // Tasks that are created by one of our own workers stay with that worker, since they
+    // are likely to work on the same data
+    const size_t index = (CurrentPool == this) ?
+        CurrentWorker :
+        _nextQueue++ % _queues.size();
 
-    // wake up one thread
-    condition.notify_one();
+    _nUnfinishedTasks++;
+    {
+        Queue& queue = *_queues[index];
+        const std::lock_guard lock(queue.mutex);
+        queue.tasks[static_cast<size_t>(priority)].push_back(std::move(f));
+    }
+    {
+        const std::lock_guard lock(_sleepMutex);
+        _nQueuedTasks++;
+    }
+    _condition.notify_one();
 }
 
 void ThreadPool::clearTasks() {
-    const std::unique_lock lock(queue_mutex);
-    tasks.clear();
+    for (const std::unique_ptr<Queue>& queue : _queues) {
+        const std::lock_guard lock(queue->mutex);
+        for (std::deque<std::function<void()>>& tasks : queue->tasks) {
+            const int n = static_cast<int>(tasks.size());
+            _nQueuedTasks -= n;
+            _nUnfinishedTasks -= n;
+            tasks.clear();
+        }
+    }
 }
 
 bool ThreadPool::hasOutstandingTasks() const {
-    return !tasks.empty();
+    return _nUnfinishedTasks > 0;
+}
+
+size_t ThreadPool::numberOfThreads() const {
+    return _workers.size();
+}
+
+bool ThreadPool::popTask(size_t index, std::function<void()>& task) {
+    // Higher priorities take precedence over the locality of the tasks, so for each
+    // priority we first look in our own queue before stealing from the other workers
+    for (size_t p = NumPriorities; p > 0; p--) {
+        const size_t priority = p - 1;
+        for (size_t i = 0; i < _queues.size(); i++) {
+            const bool isOwnQueue = (i == 0);
+            Queue& queue = *_queues[(index + i) % _queues.size()];
+            const std::lock_guard lock(queue.mutex);
+            std::deque<std::function<void()>>& tasks = queue.tasks[priority];
+            if (tasks.empty()) {
+                continue;
+            }
+
+            // The owner processes its tasks in order, thieves take the newest ones
+            if (isOwnQueue) {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            else {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+            }
+            _nQueuedTasks--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    CurrentPool = this;
+    CurrentWorker = index;
+
+    std::function<void()> task;
+    while (!_stop) {
+        if (popTask(index, task)) {
+            task();
+            task = nullptr;
+            _nUnfinishedTasks--;
+            continue;
+        }
+
+        std::unique_lock lock(_sleepMutex);
+        _condition.wait(lock, [this]() { return _stop || _nQueuedTasks > 0; });
+    }
 }
 
 } // namespace openspace
@@ -26,24 +26,27 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/util/memorymanager.h>
+#include <cstring>
 
 namespace openspace {
 
 tstring temporaryString(const std::string& str) {
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(str.size(), 8);
+    void* ptr = global::memoryManager->TemporaryMemory.allocate(str.size() + 1, 8);
     std::strcpy(reinterpret_cast<char*>(ptr), str.data());
     return tstring(reinterpret_cast<char*>(ptr), str.size());
 }
 
 tstring temporaryString(std::string_view str) {
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(str.size(), 8);
-    std::strcpy(reinterpret_cast<char*>(ptr), str.data());
+    void* ptr = global::memoryManager->TemporaryMemory.allocate(str.size() + 1, 8);
+    // A string_view is not necessarily null-terminated
+    std::memcpy(ptr, str.data(), str.size());
+    reinterpret_cast<char*>(ptr)[str.size()] = '\0';
     return tstring(reinterpret_cast<char*>(ptr), str.size());
 }
 
 tstring temporaryString(const char str[]) {
     const size_t size = strlen(str);
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(size, 8);
+    void* ptr = global::memoryManager->TemporaryMemory.allocate(size + 1, 8);
     std::strcpy(reinterpret_cast<char*>(ptr), str);
     return tstring(reinterpret_cast<char*>(ptr), size);
 }
@@ -0,0 +1,62 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/concurrentqueue.h>
+#include <thread>
+
+TEST_CASE("ConcurrentQueue: Push and Pop", "[!benchmark][concurrentqueue]") {
+    using namespace openspace;
+
+    constexpr int NItems = 10000;
+
+    BENCHMARK("Single thread") {
+        ConcurrentQueue<int> queue;
+        for (int i = 0; i < NItems; i++) {
+            queue.push(i);
+        }
+        int sum = 0;
+        for (int i = 0; i < NItems; i++) {
+            sum += queue.pop();
+        }
+        return sum;
+    };
+
+    BENCHMARK("Producer and consumer") {
+        ConcurrentQueue<int> queue;
+        std::thread producer([&queue]() {
+            for (int i = 0; i < NItems; i++) {
+                queue.push(i);
+            }
+        });
+        int sum = 0;
+        for (int i = 0; i < NItems; i++) {
+            sum += queue.pop();
+        }
+        producer.join();
+        return sum;
+    };
+}
@@ -0,0 +1,103 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/data/csvloader.h>
+#include <openspace/data/dataloader.h>
+#include <openspace/data/speckloader.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+    constexpr int NRows = 50000;
+
+    // The files are generated with a fixed seed so that all runs use the same data
+    std::filesystem::path createSpeckFile() {
+        std::filesystem::path path =
+            std::filesystem::temp_directory_path() / "openspace_benchmark.speck";
+        std::ofstream file(path);
+        file << "datavar 0 lum\n" << "datavar 1 colorb_v\n";
+
+        std::mt19937 gen(1337);
+        std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+        for (int i = 0; i < NRows; i++) {
+            file << dist(gen) << ' ' << dist(gen) << ' ' << dist(gen) << ' '
+                 << dist(gen) << ' ' << dist(gen) << " # Star " << i << '\n';
+        }
+        return path;
+    }
+
+    std::filesystem::path createCsvFile() {
+        std::filesystem::path path =
+            std::filesystem::temp_directory_path() / "openspace_benchmark.csv";
+        std::ofstream file(path);
+        file << "x,y,z,lum,colorb_v\n";
+
+        std::mt19937 gen(1337);
+        std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+        for (int i = 0; i < NRows; i++) {
+            file << dist(gen) << ',' << dist(gen) << ',' << dist(gen) << ','
+                 << dist(gen) << ',' << dist(gen) << '\n';
+        }
+        return path;
+    }
+} // namespace
+
+TEST_CASE("Dataset: Load Files", "[!benchmark][dataloader]") {
+    using namespace openspace::dataloader;
+
+    const std::filesystem::path speck = createSpeckFile();
+    const std::filesystem::path csv = createCsvFile();
+
+    BENCHMARK("Load speck") {
+        return speck::loadSpeckFile(speck).entries.size();
+    };
+
+    BENCHMARK("Load CSV") {
+        return csv::loadCsvFile(csv).entries.size();
+    };
+
+    std::filesystem::remove(speck);
+    std::filesystem::remove(csv);
+}
+
+TEST_CASE("Dataset: Find Value Range", "[!benchmark][dataloader]") {
+    using namespace openspace::dataloader;
+
+    const std::filesystem::path speck = createSpeckFile();
+    const Dataset dataset = speck::loadSpeckFile(speck);
+    std::filesystem::remove(speck);
+    REQUIRE(dataset.entries.size() == NRows);
+
+    BENCHMARK("By index") {
+        return dataset.findValueRange(0);
+    };
+
+    BENCHMARK("By name") {
+        return dataset.findValueRange("colorb_v");
+    };
+}
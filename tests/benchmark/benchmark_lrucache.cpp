@@ -0,0 +1,68 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <modules/globebrowsing/src/lrucache.h>
+
+namespace {
+    constexpr int CacheSize = 512;
+
+    struct DefaultHasher {
+        unsigned long long operator()(int var) const {
+            return static_cast<unsigned long long>(var);
+        }
+    };
+
+    using Cache = openspace::globebrowsing::cache::LRUCache<int, double, DefaultHasher>;
+} // namespace
+
+TEST_CASE("LRUCache: Put", "[!benchmark][lrucache]") {
+    BENCHMARK_ADVANCED("Put with eviction")(Catch::Benchmark::Chronometer meter) {
+        Cache cache(CacheSize);
+        meter.measure([&cache](int i) {
+            cache.put(i, static_cast<double>(i));
+        });
+    };
+}
+
+TEST_CASE("LRUCache: Get", "[!benchmark][lrucache]") {
+    Cache cache(CacheSize);
+    for (int i = 0; i < CacheSize; i++) {
+        cache.put(i, static_cast<double>(i));
+    }
+
+    BENCHMARK_ADVANCED("Get existing")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&cache](int i) {
+            return cache.get(i % CacheSize);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Exist missing")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&cache](int i) {
+            return cache.exist(CacheSize + i);
+        });
+    };
+}
@@ -0,0 +1,104 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/properties/propertyowner.h>
+#include <openspace/properties/scalar/floatproperty.h>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int NOwners = 20;
+    constexpr int NSubOwners = 20;
+    constexpr int NProperties = 10;
+
+    struct PropertyTree {
+        PropertyTree() : root({ "Root" }) {
+            identifiers.reserve(NProperties);
+            for (int i = 0; i < NProperties; i++) {
+                identifiers.push_back(std::format("Value{}", i));
+            }
+
+            for (int i = 0; i < NOwners; i++) {
+                auto owner = std::make_unique<openspace::properties::PropertyOwner>(
+                    openspace::properties::PropertyOwner::PropertyOwnerInfo{
+                        std::format("Owner{}", i)
+                    }
+                );
+                for (int j = 0; j < NSubOwners; j++) {
+                    auto sub = std::make_unique<openspace::properties::PropertyOwner>(
+                        openspace::properties::PropertyOwner::PropertyOwnerInfo{
+                            std::format("Sub{}", j)
+                        }
+                    );
+                    for (int k = 0; k < NProperties; k++) {
+                        auto p = std::make_unique<openspace::properties::FloatProperty>(
+                            openspace::properties::Property::PropertyInfo(
+                                identifiers[k].c_str(),
+                                identifiers[k].c_str(),
+                                ""
+                            ),
+                            static_cast<float>(k)
+                        );
+                        sub->addProperty(p.get());
+                        properties.push_back(std::move(p));
+                    }
+                    owner->addPropertySubOwner(sub.get());
+                    owners.push_back(std::move(sub));
+                }
+                root.addPropertySubOwner(owner.get());
+                owners.push_back(std::move(owner));
+            }
+        }
+
+        // The properties and owners have to be destroyed before the root owner
+        std::vector<std::string> identifiers;
+        openspace::properties::PropertyOwner root;
+        std::vector<std::unique_ptr<openspace::properties::PropertyOwner>> owners;
+        std::vector<std::unique_ptr<openspace::properties::FloatProperty>> properties;
+    };
+} // namespace
+
+TEST_CASE("PropertyOwner: Property URI", "[!benchmark][propertyowner]") {
+    const PropertyTree tree;
+
+    std::vector<std::string> uris;
+    for (int i = 0; i < NOwners; i++) {
+        uris.push_back(std::format("Owner{}.Sub{}.Value{}", i, i, i % NProperties));
+    }
+
+    BENCHMARK_ADVANCED("Resolve existing")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return tree.root.property(uris[i % uris.size()]);
+        });
+    };
+
+    BENCHMARK("Resolve missing") {
+        return tree.root.property("Owner10.Sub10.DoesNotExist");
+    };
+}
@@ -0,0 +1,84 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/spicemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include "SpiceUsr.h"
+
+TEST_CASE("SpiceManager: Target Position", "[!benchmark][spicemanager]") {
+    using namespace openspace;
+
+    SpiceManager::initialize();
+    const int kernel = SpiceManager::ref().loadKernel(
+        absPath("${TESTDIR}/SpiceTest/spicekernels/981005_PLTEPH-DE405S.bsp")
+    );
+    REQUIRE(kernel > 0);
+
+    double et = 0.0;
+    str2et_c("2004 JUN 11 19:32:00", &et);
+
+    const SpiceManager::AberrationCorrection none = {
+        SpiceManager::AberrationCorrection::Type::None,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+    const SpiceManager::AberrationCorrection lightTime = {
+        SpiceManager::AberrationCorrection::Type::LightTimeStellar,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+
+    BENCHMARK_ADVANCED("Same time")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&]() {
+            return SpiceManager::ref().targetPosition("MOON", "EARTH", "J2000", none, et);
+        });
+    };
+
+    BENCHMARK_ADVANCED("Changing time")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return SpiceManager::ref().targetPosition(
+                "MOON",
+                "EARTH",
+                "J2000",
+                none,
+                et + 60.0 * i
+            );
+        });
+    };
+
+    BENCHMARK_ADVANCED("Light time correction")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&](int i) {
+            return SpiceManager::ref().targetPosition(
+                "MOON",
+                "EARTH",
+                "J2000",
+                lightTime,
+                et + 60.0 * i
+            );
+        });
+    };
+
+    SpiceManager::deinitialize();
+}
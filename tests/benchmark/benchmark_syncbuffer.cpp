@@ -0,0 +1,72 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/syncbuffer.h>
+#include <vector>
+
+namespace {
+    constexpr int NValues = 256;
+
+    // Encodes a mix of values that is similar to what is synchronized every frame
+    void encodeFrame(openspace::SyncBuffer& buffer) {
+        for (int i = 0; i < NValues; i++) {
+            buffer.encode(glm::dvec3(i, 2.0 * i, 3.0 * i));
+            buffer.encode(glm::dquat(1.0, 0.0, 0.0, 0.0));
+            buffer.encode(static_cast<double>(i));
+        }
+        buffer.encode(std::string("openspace.time.setTime('2024-01-01T00:00:00')"));
+    }
+} // namespace
+
+TEST_CASE("SyncBuffer: Encode", "[!benchmark][syncbuffer]") {
+    openspace::SyncBuffer buffer(1024);
+
+    BENCHMARK("Encode frame") {
+        buffer.reset();
+        encodeFrame(buffer);
+        return buffer.encodedData().size();
+    };
+}
+
+TEST_CASE("SyncBuffer: Decode", "[!benchmark][syncbuffer]") {
+    openspace::SyncBuffer source(1024);
+    encodeFrame(source);
+    const std::vector<std::byte> data = source.data();
+
+    openspace::SyncBuffer buffer(1024);
+    BENCHMARK("Decode frame") {
+        buffer.reset();
+        buffer.setData(data);
+        double sum = 0.0;
+        for (int i = 0; i < NValues; i++) {
+            sum += buffer.decode<glm::dvec3>().x;
+            sum += buffer.decode<glm::dquat>().w;
+            sum += buffer.decode<double>();
+        }
+        return sum + static_cast<double>(buffer.decode().size());
+    };
+}
@@ -0,0 +1,61 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/timeline.h>
+
+TEST_CASE("Timeline: Lookup", "[!benchmark][timeline]") {
+    constexpr int NKeyframes = 10000;
+
+    openspace::Timeline<float> timeline;
+    for (int i = 0; i < NKeyframes; i++) {
+        timeline.addKeyframe(static_cast<double>(i), static_cast<float>(i));
+    }
+
+    BENCHMARK_ADVANCED("Last keyframe before")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&timeline](int i) {
+            const double t = static_cast<double>(i % NKeyframes) + 0.5;
+            return timeline.lastKeyframeBefore(t)->data;
+        });
+    };
+
+    BENCHMARK_ADVANCED("First keyframe after")(Catch::Benchmark::Chronometer meter) {
+        meter.measure([&timeline](int i) {
+            const double t = static_cast<double>(i % (NKeyframes - 1)) + 0.5;
+            return timeline.firstKeyframeAfter(t)->data;
+        });
+    };
+}
+
+TEST_CASE("Timeline: Add Keyframes", "[!benchmark][timeline]") {
+    BENCHMARK("Add in order") {
+        openspace::Timeline<float> timeline;
+        for (int i = 0; i < 1000; i++) {
+            timeline.addKeyframe(static_cast<double>(i), static_cast<float>(i));
+        }
+        return timeline.nKeyframes();
+    };
+}
@@ -0,0 +1,104 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/histogram.h>
+#include <random>
+#include <vector>
+
+using namespace openspace;
+
+namespace {
+    std::vector<float> randomValues(size_t n, float min, float max) {
+        std::mt19937 gen(1337);
+        std::uniform_real_distribution<float> dist(min, max);
+        std::vector<float> values(n);
+        for (float& v : values) {
+            v = dist(gen);
+        }
+        return values;
+    }
+
+    void requireEqualBins(const Histogram& lhs, const Histogram& rhs) {
+        REQUIRE(lhs.numBins() == rhs.numBins());
+        for (int i = 0; i < lhs.numBins(); i++) {
+            CHECK(lhs.sample(i) == rhs.sample(i));
+        }
+    }
+} // namespace
+
+TEST_CASE("Histogram: Bulk Add Matches Single Add", "[histogram]") {
+    // Includes values outside of the range and the boundaries
+    std::vector<float> values = randomValues(10000, -0.5f, 1.5f);
+    values.push_back(0.f);
+    values.push_back(1.f);
+
+    Histogram single(0.f, 1.f, 64);
+    int nAdded = 0;
+    for (float v : values) {
+        nAdded += single.add(v) ? 1 : 0;
+    }
+
+    Histogram bulk(0.f, 1.f, 64);
+    CHECK(bulk.add(values) == nAdded);
+    requireEqualBins(single, bulk);
+}
+
+TEST_CASE("Histogram: Bulk Add Multithreaded", "[histogram]") {
+    // Large enough to be split between multiple threads
+    const std::vector<float> values = randomValues(2'000'000, -1.f, 1.f);
+
+    Histogram single(-1.f, 1.f, 512);
+    for (float v : values) {
+        single.add(v);
+    }
+
+    Histogram bulk(-1.f, 1.f, 512);
+    CHECK(bulk.add(values) == static_cast<int>(values.size()));
+    requireEqualBins(single, bulk);
+}
+
+TEST_CASE("Histogram: Bulk Add Empty", "[histogram]") {
+    Histogram histogram(0.f, 1.f, 16);
+    CHECK(histogram.add(std::vector<float>()) == 0);
+    for (int i = 0; i < histogram.numBins(); i++) {
+        CHECK(histogram.sample(i) == 0.f);
+    }
+}
+
+TEST_CASE("Histogram: Change Range", "[histogram]") {
+    Histogram histogram(0.f, 1.f, 4);
+    histogram.add(0.1f);
+    histogram.add(0.6f);
+    histogram.add(0.9f);
+
+    histogram.changeRange(0.f, 2.f);
+    CHECK(histogram.minValue() == 0.f);
+    CHECK(histogram.maxValue() == 2.f);
+    CHECK(histogram.sample(0) == 1.f);
+    CHECK(histogram.sample(1) == 2.f);
+    CHECK(histogram.sample(2) == 0.f);
+    CHECK(histogram.sample(3) == 0.f);
+}
@@ -96,3 +96,101 @@ TEST_CASE("LRUCache: StructKey", "[lrucache]") {
     CHECK(lru.get(key1) == val2);
     CHECK(lru.get(key2) == val2);
 }
+
+TEST_CASE("LRUCache: PutLRU", "[lrucache]") {
+    openspace::globebrowsing::cache::LRUCache<int, double, DefaultHasher> lru(3);
+    lru.put(1, 1.2);
+    lru.put(12, 2.3);
+
+    // Values put at the back are the first ones to be popped
+    CHECK(lru.putLRU(123, 3.4));
+    CHECK_FALSE(lru.putLRU(12, 4.5));
+    CHECK(lru.popLRU().first == 123);
+    CHECK(lru.popMRU().first == 12);
+
+    // Values are never put at the back of a full cache
+    lru.put(123, 3.4);
+    lru.put(1234, 4.5);
+    CHECK_FALSE(lru.putLRU(12345, 5.6));
+    CHECK_FALSE(lru.exist(12345));
+    CHECK(lru.size() == 3);
+}
+
+TEST_CASE("LRUCache: PopHighestPriority", "[lrucache]") {
+    openspace::globebrowsing::cache::LRUCache<int, double, DefaultHasher> lru(4);
+    lru.put(1, 1.2);
+    lru.put(12, 2.3);
+    lru.put(123, 3.4);
+    lru.put(1234, 4.5);
+
+    auto priority = [](int key) { return key == 12 ? 1.f : 0.f; };
+    CHECK(lru.popHighestPriority(priority).first == 12);
+    CHECK_FALSE(lru.exist(12));
+
+    // With equal priorities, the most recently used item is popped
+    CHECK(lru.popHighestPriority(priority).first == 1234);
+    CHECK(lru.size() == 2);
+}
+
+TEST_CASE("LRUCache: PopLRUIf", "[lrucache]") {
+    openspace::globebrowsing::cache::LRUCache<int, double, DefaultHasher> lru(4);
+    lru.put(1, 1.2);
+    lru.put(12, 2.3);
+    lru.put(123, 3.4);
+    lru.put(1234, 4.5);
+
+    // The least recently used of the matching items is popped
+    auto isLarge = [](int key) { return key > 10; };
+    std::optional<std::pair<int, double>> item = lru.popLRUIf(isLarge);
+    REQUIRE(item.has_value());
+    CHECK(item->first == 12);
+    CHECK(item->second == 2.3);
+    CHECK_FALSE(lru.exist(12));
+    CHECK(lru.size() == 3);
+
+    // Touching an item makes it the most recently used one
+    lru.touch(123);
+    item = lru.popLRUIf(isLarge);
+    REQUIRE(item.has_value());
+    CHECK(item->first == 1234);
+
+    auto isNegative = [](int key) { return key < 0; };
+    CHECK_FALSE(lru.popLRUIf(isNegative).has_value());
+    CHECK(lru.size() == 2);
+}
+
+TEST_CASE("LRUCache: ReuseAfterPop", "[lrucache]") {
+    openspace::globebrowsing::cache::LRUCache<int, int, DefaultHasher> lru(8);
+    lru.reserve(8);
+
+    // Keys that collide in the hash table, interleaved with pops from both ends of the
+    // queue, exercise the reuse of freed items and the removal from the probe sequences
+    for (int i = 1; i < 1000; i++) {
+        lru.put(i * 16, i);
+        if (i > 990) {
+            continue;
+        }
+
+        if (i % 3 == 0) {
+            const std::pair<int, int> item = lru.popLRU();
+            CHECK_FALSE(lru.exist(item.first));
+        }
+        if (i % 7 == 0) {
+            const std::pair<int, int> item = lru.popMRU();
+            CHECK(item.first == i * 16);
+        }
+        REQUIRE(lru.size() <= 8);
+    }
+
+    // The remaining items are the most recently inserted ones and are all reachable
+    CHECK(lru.size() == 8);
+    for (int i = 992; i < 1000; i++) {
+        CHECK(lru.exist(i * 16));
+        CHECK(lru.get(i * 16) == i);
+    }
+    CHECK(lru.popLRU().first == 992 * 16);
+
+    lru.clear();
+    CHECK(lru.isEmpty());
+    CHECK_FALSE(lru.exist(999 * 16));
+}
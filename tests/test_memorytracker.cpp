@@ -0,0 +1,79 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/engine/globals.h>
+#include <openspace/engine/memorytracker.h>
+#include <openspace/engine/openspaceengine.h>
+
+TEST_CASE("MemoryTracker: Node and Module", "[memorytracker]") {
+    using namespace openspace;
+
+    const MemoryTracker& tracker = global::openSpaceEngine->memoryTracker();
+    const MemoryTracker::Usage before = tracker.total();
+    {
+        MemoryTracker::Allocation a("TestNode", "TestModule", MemoryTracker::Type::Ram);
+        a.setSize(100);
+        MemoryTracker::Allocation b("TestNode", "TestModule", MemoryTracker::Type::Vram);
+        b.setSize(200);
+        MemoryTracker::Allocation c("", "TestModule", MemoryTracker::Type::Vram);
+        c.setSize(50);
+
+        const MemoryTracker::Usage node = tracker.usagePerNode().at("TestNode");
+        CHECK(node.ram == 100);
+        CHECK(node.vram == 200);
+
+        const MemoryTracker::Usage module = tracker.usagePerModule().at("TestModule");
+        CHECK(module.ram == 100);
+        CHECK(module.vram == 250);
+
+        const MemoryTracker::Usage total = tracker.total();
+        CHECK(total.ram == before.ram + 100);
+        CHECK(total.vram == before.vram + 250);
+
+        // Resizing replaces the previous size
+        a.setSize(10);
+        CHECK(tracker.usagePerNode().at("TestNode").ram == 10);
+    }
+
+    CHECK_FALSE(tracker.usagePerNode().contains("TestNode"));
+    CHECK_FALSE(tracker.usagePerModule().contains("TestModule"));
+    CHECK(tracker.total().ram == before.ram);
+    CHECK(tracker.total().vram == before.vram);
+}
+
+TEST_CASE("MemoryTracker: Move", "[memorytracker]") {
+    using namespace openspace;
+
+    const MemoryTracker& tracker = global::openSpaceEngine->memoryTracker();
+    MemoryTracker::Allocation a("TestNode", "TestModule", MemoryTracker::Type::Ram);
+    a.setSize(100);
+
+    MemoryTracker::Allocation b = std::move(a);
+    CHECK(tracker.usagePerNode().at("TestNode").ram == 100);
+
+    b = MemoryTracker::Allocation();
+    CHECK_FALSE(tracker.usagePerNode().contains("TestNode"));
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/mpmcqueue.h>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MpmcQueue: Bounded", "[mpmcqueue]") {
+    using namespace openspace;
+
+    MpmcQueue<int> queue(3);
+    CHECK(queue.capacity() == 4);
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.tryPop().has_value());
+
+    for (int i = 0; i < 4; i++) {
+        CHECK(queue.tryPush(i));
+    }
+    CHECK_FALSE(queue.tryPush(4));
+    CHECK(queue.size() == 4);
+
+    CHECK(queue.tryPop() == 0);
+    CHECK(queue.tryPush(4));
+
+    std::vector<int> items;
+    CHECK(queue.popAll(items) == 4);
+    const std::vector<int> expected = { 1, 2, 3, 4 };
+    CHECK(items == expected);
+    CHECK(queue.empty());
+}
+
+TEST_CASE("MpmcQueue: Multiple Producers", "[mpmcqueue]") {
+    using namespace openspace;
+
+    constexpr int NProducers = 4;
+    constexpr int NItems = 10000;
+
+    MpmcQueue<int> queue(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NProducers; p++) {
+        producers.emplace_back([&queue]() {
+            for (int i = 1; i <= NItems; i++) {
+                while (!queue.tryPush(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every producer pushes the numbers 1 to NItems, so the sum is known
+    long long sum = 0;
+    size_t nPopped = 0;
+    std::vector<int> items;
+    while (nPopped < NProducers * NItems) {
+        items.clear();
+        nPopped += queue.popAll(items);
+        for (int item : items) {
+            sum += item;
+        }
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    CHECK(sum == NProducers * (static_cast<long long>(NItems) * (NItems + 1) / 2));
+    CHECK(queue.empty());
+}
@@ -0,0 +1,132 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/prefixtrie.h>
+#include <string>
+#include <vector>
+
+using namespace openspace;
+
+TEST_CASE("PrefixTrie: Insert and Contains", "[prefixtrie]") {
+    PrefixTrie trie;
+    CHECK(trie.empty());
+
+    trie.insert("Scene.Earth.Renderable.Enabled");
+    trie.insert("Scene.Earth.Renderable.Opacity");
+    trie.insert("Scene.Earth");
+    trie.insert("Scene.Earth");
+    CHECK(trie.size() == 3);
+
+    CHECK(trie.contains("Scene.Earth"));
+    CHECK(trie.contains("Scene.Earth.Renderable.Enabled"));
+    CHECK(trie.contains("Scene.Earth.Renderable.Opacity"));
+    CHECK_FALSE(trie.contains("Scene"));
+    CHECK_FALSE(trie.contains("Scene.Earth.Renderable"));
+    CHECK_FALSE(trie.contains("Scene.Earth.Renderable.EnabledX"));
+    CHECK_FALSE(trie.contains("scene.earth"));
+}
+
+TEST_CASE("PrefixTrie: Remove", "[prefixtrie]") {
+    PrefixTrie trie;
+    trie.insert("Scene.Earth");
+    trie.insert("Scene.Earth.Renderable.Enabled");
+    trie.insert("Scene.Mars.Renderable.Enabled");
+
+    CHECK_FALSE(trie.remove("Scene.Ea"));
+    CHECK(trie.remove("Scene.Earth"));
+    CHECK_FALSE(trie.remove("Scene.Earth"));
+    CHECK(trie.size() == 2);
+    CHECK(trie.contains("Scene.Earth.Renderable.Enabled"));
+    CHECK(trie.contains("Scene.Mars.Renderable.Enabled"));
+
+    CHECK(trie.remove("Scene.Mars.Renderable.Enabled"));
+    CHECK(trie.size() == 1);
+    CHECK(trie.contains("Scene.Earth.Renderable.Enabled"));
+
+    trie.insert("Scene.Mars.Renderable.Enabled");
+    CHECK(trie.contains("Scene.Mars.Renderable.Enabled"));
+    CHECK(trie.size() == 2);
+}
+
+TEST_CASE("PrefixTrie: Remove Prefix", "[prefixtrie]") {
+    PrefixTrie trie;
+    trie.insert("Scene.Earth.Renderable.Enabled");
+    trie.insert("Scene.Earth.Renderable.Opacity");
+    trie.insert("Scene.EarthTrail.Renderable.Enabled");
+    trie.insert("Scene.Mars.Renderable.Enabled");
+
+    CHECK(trie.removePrefix("Scene.Venus.") == 0);
+    CHECK(trie.removePrefix("Scene.Earth.") == 2);
+    CHECK(trie.size() == 2);
+    CHECK(trie.contains("Scene.EarthTrail.Renderable.Enabled"));
+    CHECK(trie.contains("Scene.Mars.Renderable.Enabled"));
+
+    CHECK(trie.removePrefix("Scene.") == 2);
+    CHECK(trie.empty());
+}
+
+TEST_CASE("PrefixTrie: Completions", "[prefixtrie]") {
+    PrefixTrie trie;
+    trie.insert("openspace.time.setTime");
+    trie.insert("openspace.time.setDeltaTime");
+    trie.insert("openspace.setPropertyValue");
+    trie.insert("openspace.setPropertyValueSingle");
+    trie.insert("openspace.absPath");
+
+    SECTION("Full Words") {
+        const std::vector<std::string> res = trie.completions("openspace.time.set");
+        const std::vector<std::string> expected = {
+            "openspace.time.setDeltaTime",
+            "openspace.time.setTime"
+        };
+        CHECK(res == expected);
+    }
+
+    SECTION("Until Separator") {
+        const std::vector<std::string> res = trie.completions("openspace.", '.');
+        const std::vector<std::string> expected = {
+            "openspace.absPath",
+            "openspace.setPropertyValue",
+            "openspace.setPropertyValueSingle",
+            "openspace.time."
+        };
+        CHECK(res == expected);
+    }
+
+    SECTION("Ignoring Case") {
+        const std::vector<std::string> res = trie.completions("OPENSPACE.SETP", '.');
+        const std::vector<std::string> expected = {
+            "openspace.setPropertyValue",
+            "openspace.setPropertyValueSingle"
+        };
+        CHECK(res == expected);
+    }
+
+    SECTION("No Match") {
+        CHECK(trie.completions("openspace.foo").empty());
+        CHECK(trie.completions("openspace.time.setTimeX").empty());
+    }
+}
@@ -0,0 +1,135 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+#include <modules/space/sgp4.h>
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
+
+#include <ghoul/glm.h>
+#include <array>
+#include <vector>
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+
+using namespace openspace;
+
+namespace {
+    // The element set of the test satellite 00005 from Vallado et al. (2006), "Revisiting
+    // Spacetrack Report #3", with the epoch moved to 0:
+    // 1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753
+    // 2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667
+    kepler::Parameters satellite00005() {
+        kepler::Parameters p;
+        p.inclination = 34.2682;
+        p.ascendingNode = 348.7242;
+        p.eccentricity = 0.1859667;
+        p.argumentOfPeriapsis = 331.7664;
+        p.meanAnomaly = 19.3264;
+        p.period = 86400.0 / 10.82419157;
+        p.bstar = 0.28098e-4;
+        p.epoch = 0.0;
+        return p;
+    }
+
+    glm::dvec3 propagate(const kepler::Parameters& parameters, double time) {
+        const sgp4::Batch batch = sgp4::createBatch(std::span(&parameters, 1));
+        glm::dvec3 position = glm::dvec3(0.0);
+        sgp4::propagate(batch, time, std::span(&position, 1));
+        return position;
+    }
+} // namespace
+
+TEST_CASE("SGP4: Near-Earth reference vectors", "[sgp4]") {
+    struct Reference {
+        double minutes;
+        glm::dvec3 position;
+    };
+    // The published TEME positions in km of the verification output for 00005
+    constexpr std::array<Reference, 6> References = {
+        Reference{ 0.0, glm::dvec3(7022.46529266, -1400.08296755, 0.03995155) },
+        Reference{ 360.0, glm::dvec3(-7154.03120202, -3783.17682504, -3536.19412294) },
+        Reference{ 720.0, glm::dvec3(-7134.59340119, 6531.68641334, 3260.27186483) },
+        Reference{ 1080.0, glm::dvec3(5568.53901181, 4492.06992591, 3863.87641983) },
+        Reference{ 1440.0, glm::dvec3(-938.55923943, -6268.18748831, -4294.02924751) },
+        Reference{ 4320.0, glm::dvec3(-9060.47373569, 4658.70952502, 813.68673153) }
+    };
+
+    const kepler::Parameters p = satellite00005();
+    REQUIRE(sgp4::isNearEarth(p));
+
+    for (const Reference& ref : References) {
+        const glm::dvec3 position = propagate(p, ref.minutes * 60.0);
+
+        // The reference values are given with a precision of 0.01 mm. The default
+        // relative epsilon would allow errors of about 100 m at these distances
+        const glm::dvec3 expected = ref.position * 1000.0;
+        CHECK(position.x == Catch::Approx(expected.x).epsilon(0.0).margin(1e-2));
+        CHECK(position.y == Catch::Approx(expected.y).epsilon(0.0).margin(1e-2));
+        CHECK(position.z == Catch::Approx(expected.z).epsilon(0.0).margin(1e-2));
+    }
+}
+
+TEST_CASE("SGP4: Deep-space elements use a Kepler orbit", "[sgp4]") {
+    // A Molniya-type orbit with a period of about 12 hours, which is too long for the
+    // near-Earth model
+    kepler::Parameters p;
+    p.inclination = 63.4;
+    p.ascendingNode = 40.0;
+    p.eccentricity = 0.7;
+    p.argumentOfPeriapsis = 270.0;
+    p.meanAnomaly = 0.0;
+    p.period = 43082.0;
+    p.bstar = 1e-4;
+    p.epoch = 0.0;
+
+    REQUIRE_FALSE(sgp4::isNearEarth(p));
+    const sgp4::Batch batch = sgp4::createBatch(std::span(&p, 1));
+    REQUIRE(batch.deepSpace == std::vector<size_t>{ 0 });
+
+    // At the epoch, the satellite is at the periapsis, whose direction only depends on
+    // the orientation of the orbit
+    const glm::dvec3 periapsis = propagate(p, 0.0);
+    const double i = glm::radians(p.inclination);
+    const double node = glm::radians(p.ascendingNode);
+    const glm::dvec3 direction = glm::dvec3(
+        std::sin(node) * std::cos(i),
+        -std::cos(node) * std::cos(i),
+        -std::sin(i)
+    );
+    const glm::dvec3 expected = direction * glm::length(periapsis);
+    CHECK(periapsis.x == Catch::Approx(expected.x));
+    CHECK(periapsis.y == Catch::Approx(expected.y));
+    CHECK(periapsis.z == Catch::Approx(expected.z));
+
+    // Without any perturbations, the ratio of the apoapsis and periapsis distances only
+    // depends on the eccentricity. The mean anomaly is close to pi after half a period
+    const glm::dvec3 apoapsis = propagate(p, p.period / 2.0);
+    const double ratio = glm::length(apoapsis) / glm::length(periapsis);
+    CHECK(ratio == Catch::Approx((1.0 + p.eccentricity) / (1.0 - p.eccentricity)));
+}
+
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
@@ -206,6 +206,58 @@ TEST_CASE("SpiceManager: Get Target Position", "[spicemanager]") {
     SpiceManager::deinitialize();
 }
 
+TEST_CASE("SpiceManager: Cached Target Position", "[spicemanager]") {
+    SpiceManager::initialize();
+
+    loadMetaKernel();
+
+    double et = 0.0;
+    str2et_c("2004 JUN 11 19:32:00", &et);
+
+    std::array<double, 3> pos = { 0.0, 0.0, 0.0 };
+    double lt = 0.0;
+    spkpos_c("EARTH", et, "J2000", "LT+S", "CASSINI", pos.data(), &lt);
+
+    const SpiceManager::AberrationCorrection corr = {
+        SpiceManager::AberrationCorrection::Type::LightTimeStellar,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+
+    SpiceManager::ref().updateEphemerisCache(et);
+
+    // The first request populates the cache and the second one should be served from it
+    for (int i = 0; i < 2; i++) {
+        double lightTime = 0.0;
+        const glm::dvec3 targetPosition = SpiceManager::ref().targetPosition(
+            "EARTH",
+            "CASSINI",
+            "J2000",
+            corr,
+            et,
+            lightTime
+        );
+        CHECK(pos[0] == Catch::Approx(targetPosition[0]));
+        CHECK(pos[1] == Catch::Approx(targetPosition[1]));
+        CHECK(pos[2] == Catch::Approx(targetPosition[2]));
+        CHECK(lt == Catch::Approx(lightTime));
+    }
+
+    // Requests for a different time must not be affected by the cache
+    spkpos_c("EARTH", et + 3600.0, "J2000", "LT+S", "CASSINI", pos.data(), &lt);
+    const glm::dvec3 otherPosition = SpiceManager::ref().targetPosition(
+        "EARTH",
+        "CASSINI",
+        "J2000",
+        corr,
+        et + 3600.0
+    );
+    CHECK(pos[0] == Catch::Approx(otherPosition[0]));
+    CHECK(pos[1] == Catch::Approx(otherPosition[1]));
+    CHECK(pos[2] == Catch::Approx(otherPosition[2]));
+
+    SpiceManager::deinitialize();
+}
+
 TEST_CASE("SpiceManager: Get Target State", "[spicemanager]") {
     SpiceManager::initialize();
 
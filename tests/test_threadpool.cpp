@@ -0,0 +1,73 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2024                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/threadpool.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("ThreadPool: Future", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(2);
+    std::future<int> f = pool.submit([]() { return 4; });
+    CHECK(f.get() == 4);
+}
+
+TEST_CASE("ThreadPool: Exception", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(2);
+    std::future<void> f = pool.submit([]() { throw std::runtime_error("error"); });
+    CHECK_THROWS_AS(f.get(), std::runtime_error);
+}
+
+TEST_CASE("ThreadPool: Continuation", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(2);
+    std::future<int> f = pool.submit(
+        []() { return 2; },
+        [](int v) { return v * 3; },
+        ThreadPool::Priority::High
+    );
+    CHECK(f.get() == 6);
+}
+
+TEST_CASE("ThreadPool: Many Tasks", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(4);
+    std::atomic_int counter = 0;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 1000; i++) {
+        futures.push_back(pool.submit([&counter]() { counter++; }));
+    }
+    for (std::future<void>& f : futures) {
+        f.get();
+    }
+    CHECK(counter == 1000);
+}